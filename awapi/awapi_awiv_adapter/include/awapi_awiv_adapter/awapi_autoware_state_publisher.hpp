@@ -30,7 +30,8 @@ namespace autoware_api
 class AutowareIvAutowareStatePublisher
 {
 public:
-  explicit AutowareIvAutowareStatePublisher(rclcpp::Node & node);
+  AutowareIvAutowareStatePublisher(
+    rclcpp::Node & node, const double min_interval, const double max_interval);
   void statePublisher(const AutowareInfo & aw_info);
 
 private:
@@ -38,6 +39,11 @@ private:
   rclcpp::Clock::SharedPtr clock_;
   // publisher
   rclcpp::Publisher<autoware_api_msgs::msg::AwapiAutowareStatus>::SharedPtr pub_state_;
+  ChangeDrivenThrottle throttle_;
+
+  // status kept across cycles, only the fields of the updated inputs are refreshed
+  autoware_api_msgs::msg::AwapiAutowareStatus status_;
+  AutowareInfo prev_aw_info_;
 
   // parameter
 
@@ -45,31 +51,31 @@ private:
   bool arrived_goal_;
   autoware_system_msgs::msg::AutowareState::_state_type prev_state_;
 
-  void getAutowareStateInfo(
+  bool getAutowareStateInfo(
     const autoware_system_msgs::msg::AutowareState::ConstSharedPtr & autoware_state_ptr,
     autoware_api_msgs::msg::AwapiAutowareStatus * status);
-  void getControlModeInfo(
+  bool getControlModeInfo(
     const autoware_vehicle_msgs::msg::ControlMode::ConstSharedPtr & control_mode_ptr,
     autoware_api_msgs::msg::AwapiAutowareStatus * status);
-  void getGateModeInfo(
+  bool getGateModeInfo(
     const autoware_control_msgs::msg::GateMode::ConstSharedPtr & gate_mode_ptr,
     autoware_api_msgs::msg::AwapiAutowareStatus * status);
-  void getEmergencyStateInfo(
+  bool getEmergencyStateInfo(
     const autoware_system_msgs::msg::EmergencyStateStamped::ConstSharedPtr & emergency_state_ptr,
     autoware_api_msgs::msg::AwapiAutowareStatus * status);
-  void getCurrentMaxVelInfo(
+  bool getCurrentMaxVelInfo(
     const autoware_planning_msgs::msg::VelocityLimit::ConstSharedPtr & current_max_velocity_ptr,
     autoware_api_msgs::msg::AwapiAutowareStatus * status);
-  void getHazardStatusInfo(
+  bool getHazardStatusInfo(
     const AutowareInfo & aw_info, autoware_api_msgs::msg::AwapiAutowareStatus * status);
-  void getStopReasonInfo(
+  bool getStopReasonInfo(
     const autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr & stop_reason_ptr,
     autoware_api_msgs::msg::AwapiAutowareStatus * status);
-  void getDiagInfo(
+  bool getDiagInfo(
     const AutowareInfo & aw_info, autoware_api_msgs::msg::AwapiAutowareStatus * status);
-  void getErrorDiagInfo(
+  bool getErrorDiagInfo(
     const AutowareInfo & aw_info, autoware_api_msgs::msg::AwapiAutowareStatus * status);
-  void getGlobalRptInfo(
+  bool getGlobalRptInfo(
     const pacmod_msgs::msg::GlobalRpt::ConstSharedPtr & global_rpt_ptr,
     autoware_api_msgs::msg::AwapiAutowareStatus * status);
 
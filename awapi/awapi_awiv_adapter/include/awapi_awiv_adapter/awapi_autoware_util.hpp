@@ -48,7 +48,9 @@
 #include <tf2_ros/transform_broadcaster.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <cmath>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace autoware_api
@@ -112,6 +114,48 @@ T waitForParam(
 
 double lowpass_filter(const double current_value, const double prev_value, const double gain);
 
+/**
+ * @brief update a field of a status and return true if its value has changed
+ */
+template <class T, class U>
+bool updateField(T * field, const U & value)
+{
+  // converted before the comparison so that a value narrowed on assignment is not always changed
+  const T & converted_value = static_cast<const T &>(value);
+  if (*field == converted_value) {
+    return false;
+  }
+  *field = converted_value;
+  return true;
+}
+
+/**
+ * @brief update a field of a status and return true if its value has changed more than threshold
+ */
+inline bool updateField(double * field, const double value, const double threshold)
+{
+  const bool is_changed = std::abs(*field - value) > threshold;
+  *field = value;
+  return is_changed;
+}
+
+/**
+ * @brief judge whether to publish a status checked periodically. A changed status is published
+ * at most once in min_interval, and an unchanged status is republished every max_interval.
+ */
+class ChangeDrivenThrottle
+{
+public:
+  explicit ChangeDrivenThrottle(const double min_interval = 0.0, const double max_interval = 0.0);
+  bool isPublishable(const rclcpp::Time & now, const bool is_changed);
+
+private:
+  double min_interval_;
+  double max_interval_;
+  bool is_pending_;
+  std::optional<rclcpp::Time> last_publish_time_;
+};
+
 namespace planning_util
 {
 bool calcClosestIndex(
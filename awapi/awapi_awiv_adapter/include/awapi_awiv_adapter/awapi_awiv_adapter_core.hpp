@@ -103,6 +103,14 @@ private:
   rclcpp::Publisher<autoware_v2x_msgs::msg::VirtualTrafficLightStateArray>::SharedPtr
     pub_v2x_state_;
 
+  // change-driven publication of the door status and v2x
+  ChangeDrivenThrottle door_status_throttle_;
+  ChangeDrivenThrottle v2x_command_throttle_;
+  ChangeDrivenThrottle v2x_state_throttle_;
+  autoware_api_msgs::msg::DoorStatus prev_door_status_;
+  autoware_v2x_msgs::msg::InfrastructureCommandArray::ConstSharedPtr prev_v2x_command_ptr_;
+  autoware_v2x_msgs::msg::VirtualTrafficLightStateArray::ConstSharedPtr prev_v2x_state_ptr_;
+
   // timer
   rclcpp::TimerBase::SharedPtr timer_;
 
@@ -170,6 +178,8 @@ private:
   std::unique_ptr<AutowareIvObstacleAvoidanceStatePublisher> obstacle_avoidance_state_publisher_;
   std::unique_ptr<AutowareIvMaxVelocityPublisher> max_velocity_publisher_;
   double status_pub_hz_;
+  double status_min_interval_;
+  double status_max_interval_;
   double stop_reason_timeout_;
   double stop_reason_thresh_dist_;
 };
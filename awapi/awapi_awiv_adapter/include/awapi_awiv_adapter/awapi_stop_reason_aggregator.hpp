@@ -19,7 +19,9 @@
 
 #include <rclcpp/rclcpp.hpp>
 
-#include <vector>
+#include <map>
+#include <string>
+#include <unordered_map>
 
 namespace autoware_api
 {
@@ -28,35 +30,29 @@ class AutowareIvStopReasonAggregator
 public:
   AutowareIvStopReasonAggregator(
     rclcpp::Node & node, const double timeout, const double thresh_dist_to_stop_pose);
-  autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr updateStopReasonArray(
-    const autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr & msg_ptr,
+  void updateStopReasonArray(
+    const autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr & msg_ptr);
+  autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr makeStopReasonArray(
     const AutowareInfo & aw_info);
 
 private:
-  void applyUpdate(
-    const autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr & msg_ptr,
-    const AutowareInfo & aw_info);
-  bool checkMatchingReason(
-    const autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr & msg_stop_reason_array,
-    const autoware_planning_msgs::msg::StopReasonArray & stop_reason_array);
+  void removeStopReasonArray(const size_t id);
   void applyTimeOut();
   void appendStopReasonToArray(
     const autoware_planning_msgs::msg::StopReason & stop_reason,
     autoware_planning_msgs::msg::StopReasonArray * stop_reason_array, const AutowareInfo & aw_info);
-  autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr makeStopReasonArray(
-    const AutowareInfo & aw_info);
-  autoware_planning_msgs::msg::StopReason inputStopDistToStopReason(
-    const autoware_planning_msgs::msg::StopReason & stop_reason, const AutowareInfo & aw_info);
-  double calcStopDistToStopFactor(
-    const autoware_planning_msgs::msg::StopFactor & stop_factor, const AutowareInfo & aw_info);
-  autoware_planning_msgs::msg::StopReason getNearStopReason(
-    const autoware_planning_msgs::msg::StopReason & stop_reason, const AutowareInfo & aw_info);
 
   rclcpp::Logger logger_;
   rclcpp::Clock::SharedPtr clock_;
   double timeout_;
   double thresh_dist_to_stop_pose_;
-  std::vector<autoware_planning_msgs::msg::StopReasonArray> stop_reason_array_vec_;
+
+  // latest stop reason arrays in the received order, keyed by the received count
+  std::map<size_t, autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr>
+    stop_reason_arrays_;
+  // id of the stop reason array which contains each reason
+  std::unordered_map<std::string, size_t> reason_to_id_;
+  size_t next_id_;
 };
 
 }  // namespace autoware_api
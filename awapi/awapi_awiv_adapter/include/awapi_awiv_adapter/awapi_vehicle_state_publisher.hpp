@@ -28,36 +28,42 @@ namespace autoware_api
 class AutowareIvVehicleStatePublisher
 {
 public:
-  explicit AutowareIvVehicleStatePublisher(rclcpp::Node & node);
+  AutowareIvVehicleStatePublisher(
+    rclcpp::Node & node, const double min_interval, const double max_interval);
   void statePublisher(const AutowareInfo & aw_info);
 
 private:
   // publisher
   rclcpp::Publisher<autoware_api_msgs::msg::AwapiVehicleStatus>::SharedPtr pub_state_;
+  ChangeDrivenThrottle throttle_;
+
+  // status kept across cycles, only the fields of the updated inputs are refreshed
+  autoware_api_msgs::msg::AwapiVehicleStatus status_;
+  AutowareInfo prev_aw_info_;
 
   autoware_api_msgs::msg::AwapiVehicleStatus initVehicleStatus();
-  void getPoseInfo(
+  bool getPoseInfo(
     const std::shared_ptr<geometry_msgs::msg::PoseStamped> & pose_ptr,
     autoware_api_msgs::msg::AwapiVehicleStatus * status);
-  void getSteerInfo(
+  bool getSteerInfo(
     const autoware_vehicle_msgs::msg::Steering::ConstSharedPtr & steer_ptr,
     autoware_api_msgs::msg::AwapiVehicleStatus * status);
-  void getVehicleCmdInfo(
+  bool getVehicleCmdInfo(
     const autoware_vehicle_msgs::msg::VehicleCommand::ConstSharedPtr & vehicle_cmd_ptr,
     autoware_api_msgs::msg::AwapiVehicleStatus * status);
-  void getTurnSignalInfo(
+  bool getTurnSignalInfo(
     const autoware_vehicle_msgs::msg::TurnSignal::ConstSharedPtr & turn_signal_ptr,
     autoware_api_msgs::msg::AwapiVehicleStatus * status);
-  void getTwistInfo(
+  bool getTwistInfo(
     const geometry_msgs::msg::TwistStamped::ConstSharedPtr & twist_ptr,
     autoware_api_msgs::msg::AwapiVehicleStatus * status);
-  void getGearInfo(
+  bool getGearInfo(
     const autoware_vehicle_msgs::msg::ShiftStamped::ConstSharedPtr & gear_ptr,
     autoware_api_msgs::msg::AwapiVehicleStatus * status);
-  void getBatteryInfo(
+  bool getBatteryInfo(
     const autoware_vehicle_msgs::msg::BatteryStatus::ConstSharedPtr & battery_ptr,
     autoware_api_msgs::msg::AwapiVehicleStatus * status);
-  void getGpsInfo(
+  bool getGpsInfo(
     const sensor_msgs::msg::NavSatFix::ConstSharedPtr & nav_sat_ptr,
     autoware_api_msgs::msg::AwapiVehicleStatus * status);
 
@@ -73,6 +79,8 @@ private:
   // defined value
   const double accel_lowpass_gain_ = 0.2;
   const double steer_vel_lowpass_gain_ = 0.2;
+  // the filtered values decaying to zero are not a change below this
+  const double filter_change_threshold_ = 1e-3;
 };
 
 }  // namespace autoware_api
@@ -22,97 +22,134 @@
 
 namespace autoware_api
 {
-AutowareIvAutowareStatePublisher::AutowareIvAutowareStatePublisher(rclcpp::Node & node)
+AutowareIvAutowareStatePublisher::AutowareIvAutowareStatePublisher(
+  rclcpp::Node & node, const double min_interval, const double max_interval)
 : logger_(node.get_logger().get_child("awapi_awiv_autoware_state_publisher")),
   clock_(node.get_clock()),
+  throttle_(min_interval, max_interval),
   arrived_goal_(false)
 {
   // publisher
   pub_state_ =
     node.create_publisher<autoware_api_msgs::msg::AwapiAutowareStatus>("output/autoware_status", 1);
+
+  // input header
+  status_.header.frame_id = "base_link";
 }
 
 void AutowareIvAutowareStatePublisher::statePublisher(const AutowareInfo & aw_info)
 {
-  autoware_api_msgs::msg::AwapiAutowareStatus status;
-
-  // input header
-  status.header.frame_id = "base_link";
-  status.header.stamp = clock_->now();
-
-  // get all info
-  getAutowareStateInfo(aw_info.autoware_state_ptr, &status);
-  getControlModeInfo(aw_info.control_mode_ptr, &status);
-  getGateModeInfo(aw_info.gate_mode_ptr, &status);
-  getEmergencyStateInfo(aw_info.emergency_state_ptr, &status);
-  getCurrentMaxVelInfo(aw_info.current_max_velocity_ptr, &status);
-  getHazardStatusInfo(aw_info, &status);
-  getStopReasonInfo(aw_info.stop_reason_ptr, &status);
-  getDiagInfo(aw_info, &status);
-  getErrorDiagInfo(aw_info, &status);
-  getGlobalRptInfo(aw_info.global_rpt_ptr, &status);
+  const auto & prev = prev_aw_info_;
+  const bool is_autoware_state_updated = aw_info.autoware_state_ptr != prev.autoware_state_ptr;
+  const bool is_control_mode_updated = aw_info.control_mode_ptr != prev.control_mode_ptr;
+  const bool is_hazard_status_updated = aw_info.hazard_status_ptr != prev.hazard_status_ptr;
+  const bool is_diagnostic_updated = aw_info.diagnostic_ptr != prev.diagnostic_ptr;
+
+  // get info of the updated inputs
+  bool is_changed = false;
+  if (is_autoware_state_updated) {
+    is_changed |= getAutowareStateInfo(aw_info.autoware_state_ptr, &status_);
+  }
+  if (is_control_mode_updated) {
+    is_changed |= getControlModeInfo(aw_info.control_mode_ptr, &status_);
+  }
+  if (aw_info.gate_mode_ptr != prev.gate_mode_ptr) {
+    is_changed |= getGateModeInfo(aw_info.gate_mode_ptr, &status_);
+  }
+  if (aw_info.emergency_state_ptr != prev.emergency_state_ptr) {
+    is_changed |= getEmergencyStateInfo(aw_info.emergency_state_ptr, &status_);
+  }
+  if (aw_info.current_max_velocity_ptr != prev.current_max_velocity_ptr) {
+    is_changed |= getCurrentMaxVelInfo(aw_info.current_max_velocity_ptr, &status_);
+  }
+  if (is_autoware_state_updated || is_control_mode_updated || is_hazard_status_updated) {
+    is_changed |= getHazardStatusInfo(aw_info, &status_);
+  }
+  if (aw_info.stop_reason_ptr != prev.stop_reason_ptr) {
+    is_changed |= getStopReasonInfo(aw_info.stop_reason_ptr, &status_);
+  }
+  if (is_diagnostic_updated) {
+    is_changed |= getDiagInfo(aw_info, &status_);
+  }
+  if (
+    is_autoware_state_updated || is_control_mode_updated || is_hazard_status_updated ||
+    is_diagnostic_updated) {
+    is_changed |= getErrorDiagInfo(aw_info, &status_);
+  }
+  if (aw_info.global_rpt_ptr != prev.global_rpt_ptr) {
+    is_changed |= getGlobalRptInfo(aw_info.global_rpt_ptr, &status_);
+  }
+  prev_aw_info_ = aw_info;
 
   // publish info
-  pub_state_->publish(status);
+  const auto now = clock_->now();
+  if (!throttle_.isPublishable(now, is_changed)) {
+    return;
+  }
+  status_.header.stamp = now;
+  pub_state_->publish(status_);
 }
 
-void AutowareIvAutowareStatePublisher::getAutowareStateInfo(
+bool AutowareIvAutowareStatePublisher::getAutowareStateInfo(
   const autoware_system_msgs::msg::AutowareState::ConstSharedPtr & autoware_state_ptr,
   autoware_api_msgs::msg::AwapiAutowareStatus * status)
 {
   if (!autoware_state_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "autoware_state is nullptr");
-    return;
+    return false;
   }
 
   // get autoware_state
-  status->autoware_state = autoware_state_ptr->state;
-  status->arrived_goal = isGoal(autoware_state_ptr);
+  bool is_changed = updateField(&status->autoware_state, autoware_state_ptr->state);
+  is_changed |= updateField(&status->arrived_goal, isGoal(autoware_state_ptr));
+  return is_changed;
 }
 
-void AutowareIvAutowareStatePublisher::getControlModeInfo(
+bool AutowareIvAutowareStatePublisher::getControlModeInfo(
   const autoware_vehicle_msgs::msg::ControlMode::ConstSharedPtr & control_mode_ptr,
   autoware_api_msgs::msg::AwapiAutowareStatus * status)
 {
   if (!control_mode_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "control mode is nullptr");
-    return;
+    return false;
   }
 
   // get control mode
-  status->control_mode = control_mode_ptr->data;
+  return updateField(&status->control_mode, control_mode_ptr->data);
 }
 
-void AutowareIvAutowareStatePublisher::getGateModeInfo(
+bool AutowareIvAutowareStatePublisher::getGateModeInfo(
   const autoware_control_msgs::msg::GateMode::ConstSharedPtr & gate_mode_ptr,
   autoware_api_msgs::msg::AwapiAutowareStatus * status)
 {
   if (!gate_mode_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "gate mode is nullptr");
-    return;
+    return false;
   }
 
   // get control mode
-  status->gate_mode = gate_mode_ptr->data;
+  return updateField(&status->gate_mode, gate_mode_ptr->data);
 }
 
-void AutowareIvAutowareStatePublisher::getEmergencyStateInfo(
+bool AutowareIvAutowareStatePublisher::getEmergencyStateInfo(
   const autoware_system_msgs::msg::EmergencyStateStamped::ConstSharedPtr & emergency_state_ptr,
   autoware_api_msgs::msg::AwapiAutowareStatus * status)
 {
   if (!emergency_state_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "emergency_state is nullptr");
-    return;
+    return false;
   }
 
   // get emergency
   using autoware_system_msgs::msg::EmergencyState;
-  status->emergency_stopped = (emergency_state_ptr->state.state == EmergencyState::MRM_OPERATING) ||
-                              (emergency_state_ptr->state.state == EmergencyState::MRM_SUCCEEDED) ||
-                              (emergency_state_ptr->state.state == EmergencyState::MRM_FAILED);
+  const bool emergency_stopped =
+    (emergency_state_ptr->state.state == EmergencyState::MRM_OPERATING) ||
+    (emergency_state_ptr->state.state == EmergencyState::MRM_SUCCEEDED) ||
+    (emergency_state_ptr->state.state == EmergencyState::MRM_FAILED);
+  return updateField(&status->emergency_stopped, emergency_stopped);
 }
 
-void AutowareIvAutowareStatePublisher::getCurrentMaxVelInfo(
+bool AutowareIvAutowareStatePublisher::getCurrentMaxVelInfo(
   const autoware_planning_msgs::msg::VelocityLimit::ConstSharedPtr & current_max_velocity_ptr,
   autoware_api_msgs::msg::AwapiAutowareStatus * status)
 {
@@ -120,79 +157,87 @@ void AutowareIvAutowareStatePublisher::getCurrentMaxVelInfo(
     RCLCPP_DEBUG_STREAM_THROTTLE(
       logger_, *clock_, 5000 /* ms */,
       "[AutowareIvAutowareStatePublisher] current_max_velocity is nullptr");
-    return;
+    return false;
   }
 
   // get current max velocity
-  status->current_max_velocity = current_max_velocity_ptr->max_velocity;
+  return updateField(&status->current_max_velocity, current_max_velocity_ptr->max_velocity);
 }
 
-void AutowareIvAutowareStatePublisher::getHazardStatusInfo(
+bool AutowareIvAutowareStatePublisher::getHazardStatusInfo(
   const AutowareInfo & aw_info, autoware_api_msgs::msg::AwapiAutowareStatus * status)
 {
   if (!aw_info.autoware_state_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(
       logger_, *clock_, 5000 /* ms */,
       "[AutowareIvAutowareStatePublisher] autoware_state is nullptr");
-    return;
+    return false;
   }
 
   if (!aw_info.control_mode_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(
       logger_, *clock_, 5000 /* ms */,
       "[AutowareIvAutowareStatePublisher] control_mode is nullptr");
-    return;
+    return false;
   }
 
   if (!aw_info.hazard_status_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(
       logger_, *clock_, 5000 /* ms */,
       "[AutowareIvAutowareStatePublisher] hazard_status is nullptr");
-    return;
+    return false;
   }
 
   // get emergency
-  status->hazard_status = *aw_info.hazard_status_ptr;
+  auto hazard_status = aw_info.hazard_status_ptr->status;
 
   // filter leaf diagnostics
-  status->hazard_status.status.diagnostics_spf =
-    diagnostics_filter::extractLeafDiagnostics(status->hazard_status.status.diagnostics_spf);
-  status->hazard_status.status.diagnostics_lf =
-    diagnostics_filter::extractLeafDiagnostics(status->hazard_status.status.diagnostics_lf);
-  status->hazard_status.status.diagnostics_sf =
-    diagnostics_filter::extractLeafDiagnostics(status->hazard_status.status.diagnostics_sf);
-  status->hazard_status.status.diagnostics_nf =
-    diagnostics_filter::extractLeafDiagnostics(status->hazard_status.status.diagnostics_nf);
+  hazard_status.diagnostics_spf =
+    diagnostics_filter::extractLeafDiagnostics(hazard_status.diagnostics_spf);
+  hazard_status.diagnostics_lf =
+    diagnostics_filter::extractLeafDiagnostics(hazard_status.diagnostics_lf);
+  hazard_status.diagnostics_sf =
+    diagnostics_filter::extractLeafDiagnostics(hazard_status.diagnostics_sf);
+  hazard_status.diagnostics_nf =
+    diagnostics_filter::extractLeafDiagnostics(hazard_status.diagnostics_nf);
+
+  // the stamp alone is not a change
+  status->hazard_status.header = aw_info.hazard_status_ptr->header;
+  return updateField(&status->hazard_status.status, hazard_status);
 }
 
-void AutowareIvAutowareStatePublisher::getStopReasonInfo(
+bool AutowareIvAutowareStatePublisher::getStopReasonInfo(
   const autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr & stop_reason_ptr,
   autoware_api_msgs::msg::AwapiAutowareStatus * status)
 {
   if (!stop_reason_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "stop reason is nullptr");
-    return;
+    return false;
   }
 
-  status->stop_reason = *stop_reason_ptr;
+  // the stamp alone is not a change
+  status->stop_reason.header = stop_reason_ptr->header;
+  return updateField(&status->stop_reason.stop_reasons, stop_reason_ptr->stop_reasons);
 }
 
-void AutowareIvAutowareStatePublisher::getDiagInfo(
+bool AutowareIvAutowareStatePublisher::getDiagInfo(
   const AutowareInfo & aw_info, autoware_api_msgs::msg::AwapiAutowareStatus * status)
 {
   if (!aw_info.diagnostic_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(
       logger_, *clock_, 5000 /* ms */, "[AutowareIvAutowareStatePublisher] diagnostics is nullptr");
-    return;
+    return false;
   }
 
   // get diag
-  status->diagnostics = diagnostics_filter::extractLeafDiagnostics(aw_info.diagnostic_ptr->status);
+  return updateField(
+    &status->diagnostics,
+    diagnostics_filter::extractLeafDiagnostics(aw_info.diagnostic_ptr->status));
 }
 
 // This function is tentative and should be replaced with getHazardStatusInfo.
 // TODO(Kenji Miyake): Make getErrorDiagInfo users to use getHazardStatusInfo.
-void AutowareIvAutowareStatePublisher::getErrorDiagInfo(
+bool AutowareIvAutowareStatePublisher::getErrorDiagInfo(
   const AutowareInfo & aw_info, autoware_api_msgs::msg::AwapiAutowareStatus * status)
 {
   using autoware_system_msgs::msg::AutowareState;
@@ -202,27 +247,27 @@ void AutowareIvAutowareStatePublisher::getErrorDiagInfo(
     RCLCPP_DEBUG_STREAM_THROTTLE(
       logger_, *clock_, 5000 /* ms */,
       "[AutowareIvAutowareStatePublisher] autoware_state is nullptr");
-    return;
+    return false;
   }
 
   if (!aw_info.control_mode_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(
       logger_, *clock_, 5000 /* ms */,
       "[AutowareIvAutowareStatePublisher] control mode is nullptr");
-    return;
+    return false;
   }
 
   if (!aw_info.diagnostic_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(
       logger_, *clock_, 5000 /* ms */, "[AutowareIvAutowareStatePublisher] diagnostics is nullptr");
-    return;
+    return false;
   }
 
   if (!aw_info.hazard_status_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(
       logger_, *clock_, 5000 /* ms */,
       "[AutowareIvAutowareStatePublisher] hazard_status is nullptr");
-    return;
+    return false;
   }
 
   // get diag
@@ -253,20 +298,21 @@ void AutowareIvAutowareStatePublisher::getErrorDiagInfo(
   }
 
   // filter leaf diag
-  status->error_diagnostics = diagnostics_filter::extractLeafDiagnostics(error_diagnostics);
+  return updateField(
+    &status->error_diagnostics, diagnostics_filter::extractLeafDiagnostics(error_diagnostics));
 }
 
-void AutowareIvAutowareStatePublisher::getGlobalRptInfo(
+bool AutowareIvAutowareStatePublisher::getGlobalRptInfo(
   const pacmod_msgs::msg::GlobalRpt::ConstSharedPtr & global_rpt_ptr,
   autoware_api_msgs::msg::AwapiAutowareStatus * status)
 {
   if (!global_rpt_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "global_rpt is nullptr");
-    return;
+    return false;
   }
 
   // get global_rpt
-  status->autonomous_overridden = global_rpt_ptr->override_active;
+  return updateField(&status->autonomous_overridden, global_rpt_ptr->override_active);
 }
 
 bool AutowareIvAutowareStatePublisher::isGoal(
@@ -23,6 +23,32 @@ double lowpass_filter(const double current_value, const double prev_value, const
   return gain * prev_value + (1.0 - gain) * current_value;
 }
 
+ChangeDrivenThrottle::ChangeDrivenThrottle(const double min_interval, const double max_interval)
+: min_interval_(min_interval), max_interval_(max_interval), is_pending_(false)
+{
+}
+
+bool ChangeDrivenThrottle::isPublishable(const rclcpp::Time & now, const bool is_changed)
+{
+  // keep the change until it is published
+  is_pending_ = is_pending_ || is_changed;
+
+  if (last_publish_time_) {
+    // publish immediately if the clock has jumped back
+    const double elapsed = (now - *last_publish_time_).seconds();
+    if (0.0 <= elapsed && elapsed < min_interval_) {
+      return false;
+    }
+    if (!is_pending_ && 0.0 <= elapsed && elapsed < max_interval_) {
+      return false;
+    }
+  }
+
+  is_pending_ = false;
+  last_publish_time_ = now;
+  return true;
+}
+
 namespace planning_util
 {
 bool calcClosestIndex(
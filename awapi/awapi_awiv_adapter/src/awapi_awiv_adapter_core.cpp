@@ -27,6 +27,8 @@ AutowareIvAdapter::AutowareIvAdapter()
 {
   // get param
   status_pub_hz_ = this->declare_parameter("status_pub_hz", 5.0);
+  status_min_interval_ = this->declare_parameter("status_min_interval", 0.0);
+  status_max_interval_ = this->declare_parameter("status_max_interval", 1.0);
   stop_reason_timeout_ = this->declare_parameter("stop_reason_timeout", 0.5);
   stop_reason_thresh_dist_ = this->declare_parameter("stop_reason_thresh_dist", 100.0);
   const double default_max_velocity = waitForParam<double>(
@@ -37,8 +39,10 @@ AutowareIvAdapter::AutowareIvAdapter()
   emergencyParamCheck(em_stop_param);
 
   // setup instance
-  vehicle_state_publisher_ = std::make_unique<AutowareIvVehicleStatePublisher>(*this);
-  autoware_state_publisher_ = std::make_unique<AutowareIvAutowareStatePublisher>(*this);
+  vehicle_state_publisher_ = std::make_unique<AutowareIvVehicleStatePublisher>(
+    *this, status_min_interval_, status_max_interval_);
+  autoware_state_publisher_ = std::make_unique<AutowareIvAutowareStatePublisher>(
+    *this, status_min_interval_, status_max_interval_);
   stop_reason_aggregator_ = std::make_unique<AutowareIvStopReasonAggregator>(
     *this, stop_reason_timeout_, stop_reason_thresh_dist_);
   v2x_aggregator_ = std::make_unique<AutowareIvV2XAggregator>(*this);
@@ -47,6 +51,9 @@ AutowareIvAdapter::AutowareIvAdapter()
     std::make_unique<AutowareIvObstacleAvoidanceStatePublisher>(*this);
   max_velocity_publisher_ =
     std::make_unique<AutowareIvMaxVelocityPublisher>(*this, default_max_velocity);
+  door_status_throttle_ = ChangeDrivenThrottle(status_min_interval_, status_max_interval_);
+  v2x_command_throttle_ = ChangeDrivenThrottle(status_min_interval_, status_max_interval_);
+  v2x_state_throttle_ = ChangeDrivenThrottle(status_min_interval_, status_max_interval_);
 
   // publisher
   pub_door_control_ =
@@ -151,6 +158,9 @@ void AutowareIvAdapter::timerCallback()
   // get current pose
   getCurrentPose();
 
+  // aggregate stop reasons
+  aw_info_.stop_reason_ptr = stop_reason_aggregator_->makeStopReasonArray(aw_info_);
+
   // publish vehicle state
   vehicle_state_publisher_->statePublisher(aw_info_);
 
@@ -163,15 +173,31 @@ void AutowareIvAdapter::timerCallback()
   // publish obstacle_avoidance state
   obstacle_avoidance_state_publisher_->statePublisher(aw_info_);
 
+  const auto now = this->now();
+
   // publish pacmod door status
-  pub_door_status_->publish(pacmod_util::getDoorStatusMsg(aw_info_.door_state_ptr));
+  const auto door_status = pacmod_util::getDoorStatusMsg(aw_info_.door_state_ptr);
+  if (door_status_throttle_.isPublishable(now, door_status != prev_door_status_)) {
+    pub_door_status_->publish(door_status);
+  }
+  prev_door_status_ = door_status;
 
-  // publish v2x command and state
+  // publish v2x command and state, the stamp alone is not a change
   if (aw_info_.v2x_command_ptr) {
-    pub_v2x_command_->publish(*aw_info_.v2x_command_ptr);
+    const bool is_changed = !prev_v2x_command_ptr_ ||
+                            aw_info_.v2x_command_ptr->commands != prev_v2x_command_ptr_->commands;
+    if (v2x_command_throttle_.isPublishable(now, is_changed)) {
+      pub_v2x_command_->publish(*aw_info_.v2x_command_ptr);
+    }
+    prev_v2x_command_ptr_ = aw_info_.v2x_command_ptr;
   }
   if (aw_info_.v2x_state_ptr) {
-    pub_v2x_state_->publish(*aw_info_.v2x_state_ptr);
+    const bool is_changed =
+      !prev_v2x_state_ptr_ || aw_info_.v2x_state_ptr->states != prev_v2x_state_ptr_->states;
+    if (v2x_state_throttle_.isPublishable(now, is_changed)) {
+      pub_v2x_state_->publish(*aw_info_.v2x_state_ptr);
+    }
+    prev_v2x_state_ptr_ = aw_info_.v2x_state_ptr;
   }
 }
 
@@ -265,7 +291,7 @@ void AutowareIvAdapter::callbackHazardStatus(
 void AutowareIvAdapter::callbackStopReason(
   const autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr msg_ptr)
 {
-  aw_info_.stop_reason_ptr = stop_reason_aggregator_->updateStopReasonArray(msg_ptr, aw_info_);
+  stop_reason_aggregator_->updateStopReasonArray(msg_ptr);
 }
 
 void AutowareIvAdapter::callbackV2XCommand(
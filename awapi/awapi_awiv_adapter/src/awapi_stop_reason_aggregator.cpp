@@ -15,7 +15,6 @@
 #include "awapi_awiv_adapter/awapi_stop_reason_aggregator.hpp"
 
 #include <memory>
-#include <vector>
 
 namespace autoware_api
 {
@@ -24,163 +23,116 @@ AutowareIvStopReasonAggregator::AutowareIvStopReasonAggregator(
 : logger_(node.get_logger().get_child("awapi_awiv_stop_reason_aggregator")),
   clock_(node.get_clock()),
   timeout_(timeout),
-  thresh_dist_to_stop_pose_(thresh_dist_to_stop_pose)
+  thresh_dist_to_stop_pose_(thresh_dist_to_stop_pose),
+  next_id_(0)
 {
 }
 
-autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr
-AutowareIvStopReasonAggregator::updateStopReasonArray(
-  const autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr & msg_ptr,
-  const AutowareInfo & aw_info)
-{
-  applyUpdate(msg_ptr, aw_info);
-  applyTimeOut();
-  return makeStopReasonArray(aw_info);
-}
-
-void AutowareIvStopReasonAggregator::applyUpdate(
-  const autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr & msg_ptr,
-  [[maybe_unused]] const AutowareInfo & aw_info)
+void AutowareIvStopReasonAggregator::updateStopReasonArray(
+  const autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr & msg_ptr)
 {
-  /* remove old stop_reason that matches reason with received msg */
-  // make reason-matching msg list
-
-  std::vector<size_t> remove_idx;
-  if (!stop_reason_array_vec_.empty()) {
-    for (int i = stop_reason_array_vec_.size() - 1; i >= 0; i--) {
-      if (checkMatchingReason(msg_ptr, stop_reason_array_vec_.at(i))) {
-        remove_idx.emplace_back(i);
-      }
+  /* remove old stop_reason_array that matches reason with received msg */
+  for (const auto & stop_reason : msg_ptr->stop_reasons) {
+    const auto itr = reason_to_id_.find(stop_reason.reason);
+    if (itr != reason_to_id_.end()) {
+      removeStopReasonArray(itr->second);
     }
   }
 
-  // remove reason matching msg
-  for (const auto idx : remove_idx) {
-    stop_reason_array_vec_.erase(stop_reason_array_vec_.begin() + idx);
-  }
-
   // add new reason msg
-  stop_reason_array_vec_.emplace_back(*msg_ptr);
+  const size_t id = next_id_++;
+  stop_reason_arrays_.emplace(id, msg_ptr);
+  for (const auto & stop_reason : msg_ptr->stop_reasons) {
+    reason_to_id_[stop_reason.reason] = id;
+  }
 }
 
-bool AutowareIvStopReasonAggregator::checkMatchingReason(
-  const autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr & msg_stop_reason_array,
-  const autoware_planning_msgs::msg::StopReasonArray & stop_reason_array)
+void AutowareIvStopReasonAggregator::removeStopReasonArray(const size_t id)
 {
-  for (const auto & msg_stop_reason : msg_stop_reason_array->stop_reasons) {
-    for (const auto & stop_reason : stop_reason_array.stop_reasons) {
-      if (msg_stop_reason.reason == stop_reason.reason) {
-        // find matching reason
-        return true;
-      }
-    }
+  const auto itr = stop_reason_arrays_.find(id);
+  if (itr == stop_reason_arrays_.end()) {
+    return;
+  }
+
+  for (const auto & stop_reason : itr->second->stop_reasons) {
+    reason_to_id_.erase(stop_reason.reason);
   }
-  // cannot find matching reason
-  return false;
+  stop_reason_arrays_.erase(itr);
 }
 
 void AutowareIvStopReasonAggregator::applyTimeOut()
 {
   const auto current_time = clock_->now();
 
-  // make timeout-msg list
-  std::vector<size_t> remove_idx;
-  if (!stop_reason_array_vec_.empty()) {
-    for (int i = stop_reason_array_vec_.size() - 1; i >= 0; i--) {
-      if (
-        (current_time - rclcpp::Time(stop_reason_array_vec_.at(i).header.stamp)).seconds() >
-        timeout_) {
-        remove_idx.emplace_back(i);
-      }
+  for (auto itr = stop_reason_arrays_.begin(); itr != stop_reason_arrays_.end();) {
+    const auto id = itr->first;
+    const auto & stamp = itr->second->header.stamp;
+    ++itr;
+    if ((current_time - rclcpp::Time(stamp)).seconds() > timeout_) {
+      removeStopReasonArray(id);
     }
   }
-  // remove timeout-msg
-  for (const auto idx : remove_idx) {
-    stop_reason_array_vec_.erase(stop_reason_array_vec_.begin() + idx);
-  }
 }
 
 void AutowareIvStopReasonAggregator::appendStopReasonToArray(
   const autoware_planning_msgs::msg::StopReason & stop_reason,
   autoware_planning_msgs::msg::StopReasonArray * stop_reason_array, const AutowareInfo & aw_info)
 {
-  // calculate dist_to_stop_pose
-  const auto stop_reason_with_dist = inputStopDistToStopReason(stop_reason, aw_info);
+  // pass through all stop factors if the distance cannot be calculated
+  const bool is_dist_available = aw_info.autoware_planning_traj_ptr && aw_info.current_pose_ptr;
 
-  // cut stop reason
-  const auto near_stop_reason = getNearStopReason(stop_reason_with_dist, aw_info);
+  autoware_planning_msgs::msg::StopReason * base_stop_reason = nullptr;
+  for (const auto & stop_factor : stop_reason.stop_factors) {
+    // calculate dist_to_stop_pose and cut far stop factor
+    double dist_to_stop_pose = stop_factor.dist_to_stop_pose;
+    if (is_dist_available) {
+      dist_to_stop_pose = planning_util::calcDistanceAlongTrajectory(
+        *aw_info.autoware_planning_traj_ptr, aw_info.current_pose_ptr->pose,
+        stop_factor.stop_pose);
+      if (dist_to_stop_pose >= thresh_dist_to_stop_pose_) {
+        continue;
+      }
+    }
 
-  // if stop factors is empty, not append
-  if (near_stop_reason.stop_factors.empty()) {
-    return;
-  }
+    // if already exists same reason msg in stop_reason_array_msg, append stop_factors to there
+    if (!base_stop_reason) {
+      for (auto & stop_reason_in_array : stop_reason_array->stop_reasons) {
+        if (stop_reason_in_array.reason == stop_reason.reason) {
+          base_stop_reason = &stop_reason_in_array;
+          break;
+        }
+      }
+    }
 
-  // if already exists same reason msg in stop_reason_array_msg, append stop_factors to there
-  for (auto & base_stop_reasons : stop_reason_array->stop_reasons) {
-    if (base_stop_reasons.reason == near_stop_reason.reason) {
-      base_stop_reasons.stop_factors.insert(
-        base_stop_reasons.stop_factors.end(), near_stop_reason.stop_factors.begin(),
-        near_stop_reason.stop_factors.end());
-      return;
+    // if not exist same reason msg, append new stop reason
+    if (!base_stop_reason) {
+      stop_reason_array->stop_reasons.emplace_back();
+      base_stop_reason = &stop_reason_array->stop_reasons.back();
+      base_stop_reason->reason = stop_reason.reason;
     }
-  }
 
-  // if not exist same reason msg, append new stop reason
-  stop_reason_array->stop_reasons.emplace_back(near_stop_reason);
+    base_stop_reason->stop_factors.push_back(stop_factor);
+    base_stop_reason->stop_factors.back().dist_to_stop_pose = dist_to_stop_pose;
+  }
 }
 
 autoware_planning_msgs::msg::StopReasonArray::ConstSharedPtr
 AutowareIvStopReasonAggregator::makeStopReasonArray(const AutowareInfo & aw_info)
 {
-  autoware_planning_msgs::msg::StopReasonArray stop_reason_array_msg;
+  applyTimeOut();
+
+  auto stop_reason_array_msg = std::make_shared<autoware_planning_msgs::msg::StopReasonArray>();
   // input header
-  stop_reason_array_msg.header.frame_id = "map";
-  stop_reason_array_msg.header.stamp = clock_->now();
+  stop_reason_array_msg->header.frame_id = "map";
+  stop_reason_array_msg->header.stamp = clock_->now();
 
   // input stop reason
-  for (const auto & stop_reason_array : stop_reason_array_vec_) {
-    for (const auto & stop_reason : stop_reason_array.stop_reasons) {
-      appendStopReasonToArray(stop_reason, &stop_reason_array_msg, aw_info);
-    }
-  }
-  return std::make_shared<autoware_planning_msgs::msg::StopReasonArray>(stop_reason_array_msg);
-}
-
-autoware_planning_msgs::msg::StopReason AutowareIvStopReasonAggregator::inputStopDistToStopReason(
-  const autoware_planning_msgs::msg::StopReason & stop_reason, const AutowareInfo & aw_info)
-{
-  if (!aw_info.autoware_planning_traj_ptr || !aw_info.current_pose_ptr) {
-    // pass through all stop reason
-    return stop_reason;
-  }
-
-  auto stop_reason_with_dist = stop_reason;
-  for (auto & stop_factor : stop_reason_with_dist.stop_factors) {
-    const auto & trajectory = *aw_info.autoware_planning_traj_ptr;
-    const auto & current_pose = aw_info.current_pose_ptr->pose;
-    stop_factor.dist_to_stop_pose =
-      planning_util::calcDistanceAlongTrajectory(trajectory, current_pose, stop_factor.stop_pose);
-  }
-  return stop_reason_with_dist;
-}
-
-autoware_planning_msgs::msg::StopReason AutowareIvStopReasonAggregator::getNearStopReason(
-  const autoware_planning_msgs::msg::StopReason & stop_reason, const AutowareInfo & aw_info)
-{
-  if (!aw_info.autoware_planning_traj_ptr || !aw_info.current_pose_ptr) {
-    // pass through all stop reason
-    return stop_reason;
-  }
-
-  autoware_planning_msgs::msg::StopReason near_stop_reason;
-  near_stop_reason.reason = stop_reason.reason;
-  for (const auto & stop_factor : stop_reason.stop_factors) {
-    if (stop_factor.dist_to_stop_pose < thresh_dist_to_stop_pose_) {
-      // append only near stop factor
-      near_stop_reason.stop_factors.emplace_back(stop_factor);
+  for (const auto & id_and_stop_reason_array : stop_reason_arrays_) {
+    for (const auto & stop_reason : id_and_stop_reason_array.second->stop_reasons) {
+      appendStopReasonToArray(stop_reason, stop_reason_array_msg.get(), aw_info);
     }
   }
-  return near_stop_reason;
+  return stop_reason_array_msg;
 }
 
 }  // namespace autoware_api
@@ -19,36 +19,60 @@
 
 namespace autoware_api
 {
-AutowareIvVehicleStatePublisher::AutowareIvVehicleStatePublisher(rclcpp::Node & node)
-: logger_(node.get_logger().get_child("awapi_awiv_vehicle_state_publisher")),
+AutowareIvVehicleStatePublisher::AutowareIvVehicleStatePublisher(
+  rclcpp::Node & node, const double min_interval, const double max_interval)
+: throttle_(min_interval, max_interval),
+  status_(initVehicleStatus()),
+  logger_(node.get_logger().get_child("awapi_awiv_vehicle_state_publisher")),
   clock_(node.get_clock()),
-  prev_accel_(0.0)
+  prev_accel_(0.0),
+  prev_steer_vel_(0.0)
 {
   // publisher
   pub_state_ =
     node.create_publisher<autoware_api_msgs::msg::AwapiVehicleStatus>("output/vehicle_status", 1);
+
+  // input header
+  status_.header.frame_id = "base_link";
 }
 
 void AutowareIvVehicleStatePublisher::statePublisher(const AutowareInfo & aw_info)
 {
-  autoware_api_msgs::msg::AwapiVehicleStatus status = initVehicleStatus();
-
-  // input header
-  status.header.frame_id = "base_link";
-  status.header.stamp = clock_->now();
-
-  // get all info
-  getPoseInfo(aw_info.current_pose_ptr, &status);
-  getSteerInfo(aw_info.steer_ptr, &status);
-  getVehicleCmdInfo(aw_info.vehicle_cmd_ptr, &status);
-  getTurnSignalInfo(aw_info.turn_signal_ptr, &status);
-  getTwistInfo(aw_info.twist_ptr, &status);
-  getGearInfo(aw_info.gear_ptr, &status);
-  getBatteryInfo(aw_info.battery_ptr, &status);
-  getGpsInfo(aw_info.nav_sat_ptr, &status);
+  // get info of the updated inputs
+  bool is_changed = false;
+  if (aw_info.current_pose_ptr != prev_aw_info_.current_pose_ptr) {
+    is_changed |= getPoseInfo(aw_info.current_pose_ptr, &status_);
+  }
+  if (aw_info.steer_ptr != prev_aw_info_.steer_ptr) {
+    is_changed |= getSteerInfo(aw_info.steer_ptr, &status_);
+  }
+  if (aw_info.vehicle_cmd_ptr != prev_aw_info_.vehicle_cmd_ptr) {
+    is_changed |= getVehicleCmdInfo(aw_info.vehicle_cmd_ptr, &status_);
+  }
+  if (aw_info.turn_signal_ptr != prev_aw_info_.turn_signal_ptr) {
+    is_changed |= getTurnSignalInfo(aw_info.turn_signal_ptr, &status_);
+  }
+  if (aw_info.twist_ptr != prev_aw_info_.twist_ptr) {
+    is_changed |= getTwistInfo(aw_info.twist_ptr, &status_);
+  }
+  if (aw_info.gear_ptr != prev_aw_info_.gear_ptr) {
+    is_changed |= getGearInfo(aw_info.gear_ptr, &status_);
+  }
+  if (aw_info.battery_ptr != prev_aw_info_.battery_ptr) {
+    is_changed |= getBatteryInfo(aw_info.battery_ptr, &status_);
+  }
+  if (aw_info.nav_sat_ptr != prev_aw_info_.nav_sat_ptr) {
+    is_changed |= getGpsInfo(aw_info.nav_sat_ptr, &status_);
+  }
+  prev_aw_info_ = aw_info;
 
   // publish info
-  pub_state_->publish(status);
+  const auto now = clock_->now();
+  if (!throttle_.isPublishable(now, is_changed)) {
+    return;
+  }
+  status_.header.stamp = now;
+  pub_state_->publish(status_);
 }
 
 autoware_api_msgs::msg::AwapiVehicleStatus AutowareIvVehicleStatePublisher::initVehicleStatus()
@@ -61,37 +85,38 @@ autoware_api_msgs::msg::AwapiVehicleStatus AutowareIvVehicleStatePublisher::init
   return status;
 }
 
-void AutowareIvVehicleStatePublisher::getPoseInfo(
+bool AutowareIvVehicleStatePublisher::getPoseInfo(
   const std::shared_ptr<geometry_msgs::msg::PoseStamped> & pose_ptr,
   autoware_api_msgs::msg::AwapiVehicleStatus * status)
 {
   if (!pose_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "current pose is nullptr");
-    return;
+    return false;
   }
 
   // get pose
-  status->pose = pose_ptr->pose;
+  bool is_changed = updateField(&status->pose, pose_ptr->pose);
 
   // convert quaternion to euler
   double yaw, pitch, roll;
   tf2::getEulerYPR(pose_ptr->pose.orientation, yaw, pitch, roll);
-  status->eulerangle.yaw = yaw;
-  status->eulerangle.pitch = pitch;
-  status->eulerangle.roll = roll;
+  is_changed |= updateField(&status->eulerangle.yaw, yaw);
+  is_changed |= updateField(&status->eulerangle.pitch, pitch);
+  is_changed |= updateField(&status->eulerangle.roll, roll);
+  return is_changed;
 }
 
-void AutowareIvVehicleStatePublisher::getSteerInfo(
+bool AutowareIvVehicleStatePublisher::getSteerInfo(
   const autoware_vehicle_msgs::msg::Steering::ConstSharedPtr & steer_ptr,
   autoware_api_msgs::msg::AwapiVehicleStatus * status)
 {
   if (!steer_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "steer is nullptr");
-    return;
+    return false;
   }
 
   // get steer
-  status->steering = steer_ptr->data;
+  bool is_changed = updateField(&status->steering, steer_ptr->data);
 
   // get steer vel
   if (previous_steer_ptr_) {
@@ -107,51 +132,54 @@ void AutowareIvVehicleStatePublisher::getSteerInfo(
     const double lowpass_steer =
       lowpass_filter(steer_vel, prev_steer_vel_, steer_vel_lowpass_gain_);
     prev_steer_vel_ = lowpass_steer;
-    status->steering_velocity = lowpass_steer;
+    is_changed |= updateField(&status->steering_velocity, lowpass_steer, filter_change_threshold_);
   }
   previous_steer_ptr_ = steer_ptr;
+  return is_changed;
 }
-void AutowareIvVehicleStatePublisher::getVehicleCmdInfo(
+bool AutowareIvVehicleStatePublisher::getVehicleCmdInfo(
   const autoware_vehicle_msgs::msg::VehicleCommand::ConstSharedPtr & vehicle_cmd_ptr,
   autoware_api_msgs::msg::AwapiVehicleStatus * status)
 {
   if (!vehicle_cmd_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "vehicle cmd is nullptr");
-    return;
+    return false;
   }
 
   // get command
-  status->target_acceleration = vehicle_cmd_ptr->control.acceleration;
-  status->target_velocity = vehicle_cmd_ptr->control.velocity;
-  status->target_steering = vehicle_cmd_ptr->control.steering_angle;
-  status->target_steering_velocity = vehicle_cmd_ptr->control.steering_angle_velocity;
+  const auto & control = vehicle_cmd_ptr->control;
+  bool is_changed = updateField(&status->target_acceleration, control.acceleration);
+  is_changed |= updateField(&status->target_velocity, control.velocity);
+  is_changed |= updateField(&status->target_steering, control.steering_angle);
+  is_changed |= updateField(&status->target_steering_velocity, control.steering_angle_velocity);
+  return is_changed;
 }
 
-void AutowareIvVehicleStatePublisher::getTurnSignalInfo(
+bool AutowareIvVehicleStatePublisher::getTurnSignalInfo(
   const autoware_vehicle_msgs::msg::TurnSignal::ConstSharedPtr & turn_signal_ptr,
   autoware_api_msgs::msg::AwapiVehicleStatus * status)
 {
   if (!turn_signal_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "turn signal is nullptr");
-    return;
+    return false;
   }
 
   // get turn signal
-  status->turn_signal = turn_signal_ptr->data;
+  return updateField(&status->turn_signal, turn_signal_ptr->data);
 }
 
-void AutowareIvVehicleStatePublisher::getTwistInfo(
+bool AutowareIvVehicleStatePublisher::getTwistInfo(
   const geometry_msgs::msg::TwistStamped::ConstSharedPtr & twist_ptr,
   autoware_api_msgs::msg::AwapiVehicleStatus * status)
 {
   if (!twist_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "twist is nullptr");
-    return;
+    return false;
   }
 
   // get twist
-  status->velocity = twist_ptr->twist.linear.x;
-  status->angular_velocity = twist_ptr->twist.angular.z;
+  bool is_changed = updateField(&status->velocity, twist_ptr->twist.linear.x);
+  is_changed |= updateField(&status->angular_velocity, twist_ptr->twist.angular.z);
 
   // get accel
   if (previous_twist_ptr_) {
@@ -166,50 +194,52 @@ void AutowareIvVehicleStatePublisher::getTwistInfo(
     // apply lowpass filter
     const double lowpass_accel = lowpass_filter(accel, prev_accel_, accel_lowpass_gain_);
     prev_accel_ = lowpass_accel;
-    status->acceleration = lowpass_accel;
+    is_changed |= updateField(&status->acceleration, lowpass_accel, filter_change_threshold_);
   }
   previous_twist_ptr_ = twist_ptr;
+  return is_changed;
 }
 
-void AutowareIvVehicleStatePublisher::getGearInfo(
+bool AutowareIvVehicleStatePublisher::getGearInfo(
   const autoware_vehicle_msgs::msg::ShiftStamped::ConstSharedPtr & gear_ptr,
   autoware_api_msgs::msg::AwapiVehicleStatus * status)
 {
   if (!gear_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "gear is nullptr");
-    return;
+    return false;
   }
 
   // get gear (shift)
-  status->gear = gear_ptr->shift.data;
+  return updateField(&status->gear, gear_ptr->shift.data);
 }
 
-void AutowareIvVehicleStatePublisher::getBatteryInfo(
+bool AutowareIvVehicleStatePublisher::getBatteryInfo(
   const autoware_vehicle_msgs::msg::BatteryStatus::ConstSharedPtr & battery_ptr,
   autoware_api_msgs::msg::AwapiVehicleStatus * status)
 {
   if (!battery_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "battery is nullptr");
-    return;
+    return false;
   }
 
   // get battery
-  status->energy_level = battery_ptr->energy_level;
+  return updateField(&status->energy_level, battery_ptr->energy_level);
 }
 
-void AutowareIvVehicleStatePublisher::getGpsInfo(
+bool AutowareIvVehicleStatePublisher::getGpsInfo(
   const sensor_msgs::msg::NavSatFix::ConstSharedPtr & nav_sat_ptr,
   autoware_api_msgs::msg::AwapiVehicleStatus * status)
 {
   if (!nav_sat_ptr) {
     RCLCPP_DEBUG_STREAM_THROTTLE(logger_, *clock_, 5000 /* ms */, "nav_sat(gps) is nullptr");
-    return;
+    return false;
   }
 
   // get geo_point
-  status->geo_point.latitude = nav_sat_ptr->latitude;
-  status->geo_point.longitude = nav_sat_ptr->longitude;
-  status->geo_point.altitude = nav_sat_ptr->altitude;
+  bool is_changed = updateField(&status->geo_point.latitude, nav_sat_ptr->latitude);
+  is_changed |= updateField(&status->geo_point.longitude, nav_sat_ptr->longitude);
+  is_changed |= updateField(&status->geo_point.altitude, nav_sat_ptr->altitude);
+  return is_changed;
 }
 
 }  // namespace autoware_api
@@ -0,0 +1,71 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Resamples x, y, z and yaw of a path, as the planners and the MPC do every cycle, from base
+// points at 1 m interval to query points at 0.1 m interval.
+
+#include "interpolation/linear_interpolation.hpp"
+#include "interpolation/spline_interpolation.hpp"
+
+#include <autoware_replay_benchmark/micro_benchmark.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+int main(int argc, char ** argv)
+{
+  using autoware_replay_benchmark::doNotOptimize;
+  autoware_replay_benchmark::MicroBenchmark benchmark("interpolation", argc, argv);
+
+  for (const size_t num_base : {100, 300, 1000}) {
+    std::vector<double> base_keys;
+    std::vector<std::vector<double>> base_values(4);
+    for (size_t i = 0; i < num_base; ++i) {
+      const double s = static_cast<double>(i);
+      base_keys.push_back(s);
+      base_values.at(0).push_back(50.0 * std::sin(s / 50.0));
+      base_values.at(1).push_back(50.0 * (1.0 - std::cos(s / 50.0)));
+      base_values.at(2).push_back(0.01 * s);
+      base_values.at(3).push_back(s / 50.0);
+    }
+    std::vector<double> query_keys;
+    for (double s = 0.0; s < base_keys.back(); s += 0.1) {
+      query_keys.push_back(s);
+    }
+
+    const std::string suffix = "/N=" + std::to_string(num_base);
+
+    benchmark.run("lerp" + suffix, [&]() {
+      for (const auto & values : base_values) {
+        doNotOptimize(interpolation::lerp(base_keys, values, query_keys));
+      }
+    });
+
+    benchmark.run("slerp" + suffix, [&]() {
+      for (const auto & values : base_values) {
+        doNotOptimize(interpolation::slerp(base_keys, values, query_keys));
+      }
+    });
+
+    std::vector<std::vector<double>> query_values;
+    benchmark.run("MultiChannelSpline" + suffix, [&]() {
+      const interpolation::MultiChannelSpline spline(base_keys, base_values);
+      spline.interpolate(query_keys, query_values);
+      doNotOptimize(query_values);
+    });
+  }
+
+  return benchmark.finish();
+}
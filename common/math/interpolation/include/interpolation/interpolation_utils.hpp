@@ -17,6 +17,7 @@
 
 #include <array>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace interpolation_utils
@@ -82,6 +83,31 @@ inline void validateInput(
     throw std::invalid_argument("The size of base_keys and base_values are not the same.");
   }
 }
+
+inline void validateKeys(
+  const std::vector<double> & base_keys, const std::vector<double> & query_keys)
+{
+  // when vectors are empty
+  if (base_keys.empty() || query_keys.empty()) {
+    throw std::invalid_argument("Points is empty.");
+  }
+
+  // when size of vectors are less than 2
+  if (base_keys.size() < 2) {
+    throw std::invalid_argument(
+      "The size of points is less than 2. base_keys.size() = " + std::to_string(base_keys.size()));
+  }
+
+  // when indices are not sorted
+  if (!isIncreasing(base_keys) || !isNotDecreasing(query_keys)) {
+    throw std::invalid_argument("Either base_keys or query_keys is not sorted.");
+  }
+
+  // when query_keys is out of base_keys (This function does not allow exterior division.)
+  if (query_keys.front() < base_keys.front() || base_keys.back() < query_keys.back()) {
+    throw std::invalid_argument("query_keys is out of base_keys");
+  }
+}
 }  // namespace interpolation_utils
 
 #endif  // INTERPOLATION__INTERPOLATION_UTILS_HPP_
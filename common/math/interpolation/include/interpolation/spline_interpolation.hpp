@@ -43,6 +43,33 @@ struct MultiSplineCoef
 std::vector<double> slerp(
   const std::vector<double> & base_keys, const std::vector<double> & base_values,
   const std::vector<double> & query_keys);
+
+/**
+ * @brief spline interpolation of several channels of values which share base_keys, such as x, y,
+ * z and yaw of a path. The coefficients are calculated once in the constructor, and all the
+ * channels are evaluated in one pass over query_keys. The result is the same as slerp of each
+ * channel.
+ */
+class MultiChannelSpline
+{
+public:
+  MultiChannelSpline(
+    const std::vector<double> & base_keys, const std::vector<std::vector<double>> & base_values);
+
+  /**
+   * @brief interpolate all the channels at query_keys into query_values[channel], whose buffers are
+   * reused
+   */
+  void interpolate(
+    const std::vector<double> & query_keys, std::vector<std::vector<double>> & query_values) const;
+
+  size_t getNumChannels() const { return num_channels_; }
+
+private:
+  std::vector<double> base_keys_;
+  size_t num_channels_;
+  std::vector<double> coefs_;  //!< @brief a, b, c and d of each segment and channel, in this order
+};
 }  // namespace interpolation
 
 #endif  // INTERPOLATION__SPLINE_INTERPOLATION_HPP_
@@ -16,112 +16,106 @@
 
 #include "interpolation/interpolation_utils.hpp"
 
+#include <stdexcept>
 #include <vector>
 
 namespace
 {
-// solve Ax = d
-// where A is tridiagonal matrix
+// The second derivatives v_1, ..., v_N-1 of the spline satisfy Av = w,
+// where A is tridiagonal matrix which depends only on the keys
 //     [b_0 c_0 ...                       ]
 //     [a_0 b_1 c_1 ...               O   ]
 // A = [            ...                   ]
 //     [   O         ... a_N-3 b_N-2 c_N-2]
 //     [                   ... a_N-2 b_N-1]
-struct TDMACoef
+// with b_i = 2 (h_i + h_i+1) and a_i = c_i = h_i+1.
+// SplineFactor keeps the forward elimination of A by tridiagonal matrix algorithm, so that the
+// channels sharing the keys only need the substitutions.
+struct SplineFactor
 {
-  explicit TDMACoef(const size_t num_row)
+  explicit SplineFactor(const std::vector<double> & base_keys)
   {
-    a.resize(num_row - 1);
-    b.resize(num_row);
-    c.resize(num_row - 1);
-    d.resize(num_row);
+    const size_t num_base = base_keys.size();  // N+1
+
+    diff_keys.resize(num_base - 1);  // N
+    for (size_t i = 0; i < num_base - 1; ++i) {
+      diff_keys[i] = base_keys[i + 1] - base_keys[i];
+    }
+
+    if (num_base > 2) {
+      const size_t num_row = num_base - 2;  // N-1
+      p.resize(num_row);
+      inv_den.resize(num_row);
+
+      inv_den[0] = 1.0 / (2.0 * (diff_keys[0] + diff_keys[1]));
+      p[0] = -diff_keys[1] * inv_den[0];
+      for (size_t i = 1; i < num_row; ++i) {
+        const double den = 2.0 * (diff_keys[i] + diff_keys[i + 1]) + diff_keys[i] * p[i - 1];
+        inv_den[i] = 1.0 / den;
+        p[i] = -diff_keys[i] * inv_den[i];
+      }
+    }
   }
 
-  std::vector<double> a;
-  std::vector<double> b;
-  std::vector<double> c;
-  std::vector<double> d;
+  std::vector<double> diff_keys;  // h
+  std::vector<double> p;
+  std::vector<double> inv_den;
 };
 
-std::vector<double> solveTridiagonalMatrixAlgorithm(const TDMACoef & tdma_coef)
+// calculate v_0, ..., v_N where v_0 = v_N = 0
+void calcSecondDerivatives(
+  const SplineFactor & factor, const std::vector<double> & base_values, std::vector<double> & v)
 {
-  const auto & a = tdma_coef.a;
-  const auto & b = tdma_coef.b;
-  const auto & c = tdma_coef.c;
-  const auto & d = tdma_coef.d;
-
-  const size_t num_row = b.size();
-
-  std::vector<double> x(num_row);
-  if (num_row != 1) {
-    // calculate p and q
-    std::vector<double> p;
-    std::vector<double> q;
-    p.push_back(-c[0] / b[0]);
-    q.push_back(d[0] / b[0]);
-
-    for (size_t i = 1; i < num_row; ++i) {
-      const double den = b[i] + a[i - 1] * p[i - 1];
-      p.push_back(-c[i - 1] / den);
-      q.push_back((d[i] - a[i - 1] * q[i - 1]) / den);
-    }
+  const auto & h = factor.diff_keys;
+  const auto & p = factor.p;
+  const auto & inv_den = factor.inv_den;
+  const size_t num_row = p.size();  // N-1
+
+  v.assign(num_row + 2, 0.0);
+  if (num_row == 0) {
+    return;
+  }
 
-    // calculate solution
-    x[num_row - 1] = q[num_row - 1];
+  // forward substitution
+  for (size_t i = 0; i < num_row; ++i) {
+    const double w = 6.0 * ((base_values[i + 2] - base_values[i + 1]) / h[i + 1] -
+                            (base_values[i + 1] - base_values[i]) / h[i]);
+    v[i + 1] = i == 0 ? w * inv_den[0] : (w - h[i] * v[i]) * inv_den[i];
+  }
 
-    for (size_t i = 1; i < num_row; ++i) {
-      const size_t j = num_row - 1 - i;
-      x[j] = p[j] * x[j + 1] + q[j];
-    }
-  } else {
-    x.push_back(d[0] / b[0]);
+  // backward substitution
+  for (size_t i = num_row - 1; i > 0; --i) {
+    v[i] += p[i - 1] * v[i + 1];
   }
+}
 
-  return x;
+// calculate a, b, c, d of spline coefficients of the i-th segment
+inline void calcSegmentCoefficients(
+  const std::vector<double> & h, const std::vector<double> & base_values,
+  const std::vector<double> & v, const size_t i, double & a, double & b, double & c, double & d)
+{
+  const double diff_value = base_values[i + 1] - base_values[i];
+  a = (v[i + 1] - v[i]) / 6.0 / h[i];
+  b = v[i] / 2.0;
+  c = diff_value / h[i] - h[i] * (2 * v[i] + v[i + 1]) / 6.0;
+  d = base_values[i];
 }
 
 interpolation::MultiSplineCoef generateSplineCoefficients(
   const std::vector<double> & base_keys, const std::vector<double> & base_values)
 {
-  const size_t num_base = base_keys.size();  // N+1
+  const SplineFactor factor(base_keys);
 
-  std::vector<double> diff_keys;    // N
-  std::vector<double> diff_values;  // N
-  for (size_t i = 0; i < num_base - 1; ++i) {
-    diff_keys.push_back(base_keys.at(i + 1) - base_keys.at(i));
-    diff_values.push_back(base_values.at(i + 1) - base_values.at(i));
-  }
-
-  std::vector<double> v = {0.0};
-  if (num_base > 2) {
-    // solve tridiagonal matrix algorithm
-    TDMACoef tdma_coef(num_base - 2);  // N-1
-
-    for (size_t i = 0; i < num_base - 2; ++i) {
-      tdma_coef.b[i] = 2 * (diff_keys[i] + diff_keys[i + 1]);
-      if (i != num_base - 3) {
-        tdma_coef.a[i] = diff_keys[i + 1];
-        tdma_coef.c[i] = diff_keys[i + 1];
-      }
-      tdma_coef.d[i] =
-        6.0 * (diff_values[i + 1] / diff_keys[i + 1] - diff_values[i] / diff_keys[i]);
-    }
-
-    const std::vector<double> tdma_res = solveTridiagonalMatrixAlgorithm(tdma_coef);
-
-    // calculate v
-    v.insert(v.end(), tdma_res.begin(), tdma_res.end());
-  }
-  v.push_back(0.0);
+  std::vector<double> v;
+  calcSecondDerivatives(factor, base_values, v);
 
   // calculate a, b, c, d of spline coefficients
-  interpolation::MultiSplineCoef multi_spline_coef(num_base - 1);  // N
-  for (size_t i = 0; i < num_base - 1; ++i) {
-    multi_spline_coef.a[i] = (v[i + 1] - v[i]) / 6.0 / diff_keys[i];
-    multi_spline_coef.b[i] = v[i] / 2.0;
-    multi_spline_coef.c[i] =
-      diff_values[i] / diff_keys[i] - diff_keys[i] * (2 * v[i] + v[i + 1]) / 6.0;
-    multi_spline_coef.d[i] = base_values[i];
+  const size_t num_spline = base_keys.size() - 1;  // N
+  interpolation::MultiSplineCoef multi_spline_coef(num_spline);
+  for (size_t i = 0; i < num_spline; ++i) {
+    calcSegmentCoefficients(
+      factor.diff_keys, base_values, v, i, multi_spline_coef.a[i], multi_spline_coef.b[i],
+      multi_spline_coef.c[i], multi_spline_coef.d[i]);
   }
 
   return multi_spline_coef;
@@ -137,14 +131,15 @@ std::vector<double> getSplineInterpolatedValues(
   const auto & d = multi_spline_coef.d;
 
   std::vector<double> res;
+  res.reserve(query_keys.size());
   size_t j = 0;
   for (const auto & query_key : query_keys) {
-    while (base_keys.at(j + 1) < query_key) {
+    while (base_keys[j + 1] < query_key) {
       ++j;
     }
 
-    const double ds = query_key - base_keys.at(j);
-    res.push_back(d.at(j) + (c.at(j) + (b.at(j) + a.at(j) * ds) * ds) * ds);
+    const double ds = query_key - base_keys[j];
+    res.push_back(d[j] + (c[j] + (b[j] + a[j] * ds) * ds) * ds);
   }
 
   return res;
@@ -167,3 +162,61 @@ std::vector<double> slerp(
   return getSplineInterpolatedValues(base_keys, query_keys, multi_spline_coef);
 }
 }  // namespace interpolation
+
+namespace interpolation
+{
+MultiChannelSpline::MultiChannelSpline(
+  const std::vector<double> & base_keys, const std::vector<std::vector<double>> & base_values)
+: base_keys_(base_keys), num_channels_(base_values.size())
+{
+  // throw exceptions for invalid arguments
+  if (base_values.empty()) {
+    throw std::invalid_argument("base_values is empty.");
+  }
+  for (const auto & values : base_values) {
+    interpolation_utils::validateInput(base_keys, values, base_keys);
+  }
+
+  const SplineFactor factor(base_keys);
+
+  // calculate spline coefficients of each channel, interleaved per segment so that evaluating all
+  // the channels at a query key reads one contiguous block
+  const size_t num_spline = base_keys.size() - 1;  // N
+  coefs_.resize(num_spline * num_channels_ * 4);
+  std::vector<double> v;
+  for (size_t ch = 0; ch < num_channels_; ++ch) {
+    calcSecondDerivatives(factor, base_values[ch], v);
+    for (size_t i = 0; i < num_spline; ++i) {
+      double * coef = &coefs_[(i * num_channels_ + ch) * 4];
+      calcSegmentCoefficients(
+        factor.diff_keys, base_values[ch], v, i, coef[0], coef[1], coef[2], coef[3]);
+    }
+  }
+}
+
+void MultiChannelSpline::interpolate(
+  const std::vector<double> & query_keys, std::vector<std::vector<double>> & query_values) const
+{
+  // throw exceptions for invalid arguments
+  interpolation_utils::validateKeys(base_keys_, query_keys);
+
+  query_values.resize(num_channels_);
+  for (auto & values : query_values) {
+    values.resize(query_keys.size());
+  }
+
+  // query_keys are sorted, so the segment is searched from the previous one
+  size_t j = 0;
+  for (size_t i = 0; i < query_keys.size(); ++i) {
+    while (base_keys_[j + 1] < query_keys[i]) {
+      ++j;
+    }
+
+    const double ds = query_keys[i] - base_keys_[j];
+    const double * coef = &coefs_[j * num_channels_ * 4];
+    for (size_t ch = 0; ch < num_channels_; ++ch, coef += 4) {
+      query_values[ch][i] = coef[3] + (coef[2] + (coef[1] + coef[0] * ds) * ds) * ds;
+    }
+  }
+}
+}  // namespace interpolation
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 
 #include <limits>
+#include <stdexcept>
 #include <vector>
 
 constexpr double epsilon = 1e-6;
@@ -95,3 +96,59 @@ TEST(spline_interpolation, slerp)
     }
   }
 }
+
+TEST(spline_interpolation, MultiChannelSpline)
+{
+  {  // same as slerp of each channel
+    const std::vector<double> base_keys{-1.5, 1.0, 5.0, 10.0, 15.0, 20.0};
+    const std::vector<std::vector<double>> base_values{
+      {-1.2, 0.5, 1.0, 1.2, 2.0, 1.0}, {3.0, 1.0, 4.0, 1.0, 5.0, 9.0}};
+    const std::vector<double> query_keys{-1.5, 0.0, 8.0, 8.0, 18.0, 20.0};
+
+    const interpolation::MultiChannelSpline spline(base_keys, base_values);
+    EXPECT_EQ(spline.getNumChannels(), 2U);
+
+    std::vector<std::vector<double>> query_values;
+    spline.interpolate(query_keys, query_values);
+    ASSERT_EQ(query_values.size(), 2U);
+    for (size_t ch = 0; ch < base_values.size(); ++ch) {
+      const auto ans = interpolation::slerp(base_keys, base_values.at(ch), query_keys);
+      ASSERT_EQ(query_values.at(ch).size(), ans.size());
+      for (size_t i = 0; i < ans.size(); ++i) {
+        EXPECT_NEAR(query_values.at(ch).at(i), ans.at(i), epsilon);
+      }
+    }
+
+    // buffers are resized for the next query
+    spline.interpolate({10.0}, query_values);
+    ASSERT_EQ(query_values.size(), 2U);
+    EXPECT_EQ(query_values.at(0).size(), 1U);
+    EXPECT_NEAR(query_values.at(0).at(0), 1.2, epsilon);
+    EXPECT_NEAR(query_values.at(1).at(0), 1.0, epsilon);
+  }
+
+  {  // curve: size of base_keys is 3
+    const std::vector<double> base_keys{0.0, 1.0, 3.0};
+    const std::vector<std::vector<double>> base_values{{0.0, 2.0, 1.0}};
+    const std::vector<double> query_keys{0.0, 0.5, 1.0, 2.0, 3.0};
+    const std::vector<double> ans{0.0, 1.15625, 2.0, 2.125, 1.0};
+
+    std::vector<std::vector<double>> query_values;
+    interpolation::MultiChannelSpline(base_keys, base_values).interpolate(query_keys, query_values);
+    for (size_t i = 0; i < ans.size(); ++i) {
+      EXPECT_NEAR(query_values.at(0).at(i), ans.at(i), epsilon);
+    }
+  }
+
+  {  // invalid arguments
+    const std::vector<double> base_keys{0.0, 1.0, 2.0};
+    EXPECT_THROW(interpolation::MultiChannelSpline(base_keys, {}), std::invalid_argument);
+    EXPECT_THROW(
+      interpolation::MultiChannelSpline(base_keys, {{0.0, 1.0}}), std::invalid_argument);
+
+    const interpolation::MultiChannelSpline spline(base_keys, {{0.0, 1.0, 0.0}});
+    std::vector<std::vector<double>> query_values;
+    EXPECT_THROW(spline.interpolate({1.0, 0.5}, query_values), std::invalid_argument);
+    EXPECT_THROW(spline.interpolate({0.0, 3.0}, query_values), std::invalid_argument);
+  }
+}
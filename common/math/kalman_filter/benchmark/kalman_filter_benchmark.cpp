@@ -0,0 +1,97 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares KalmanFilter and FixedSizeKalmanFilter on the predict/update cycle of the
+// multi_object_tracker vehicle models (5 states, 3 measurements) over 200 tracked objects.
+
+#include "kalman_filter/fixed_size_kalman_filter.hpp"
+#include "kalman_filter/kalman_filter.hpp"
+
+#include <autoware_replay_benchmark/micro_benchmark.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+constexpr int DIM_X = 5;
+constexpr int DIM_Y = 3;
+constexpr int NUM_OBJECTS = 200;
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  autoware_replay_benchmark::MicroBenchmark benchmark("kalman_filter", argc, argv);
+  const double dt = 0.1;
+
+  // dynamic size filter, as used by the trackers today
+  std::vector<KalmanFilter> dynamic_filters(NUM_OBJECTS);
+  for (auto & filter : dynamic_filters) {
+    filter.init(
+      Eigen::MatrixXd::Zero(DIM_X, 1), Eigen::MatrixXd::Identity(DIM_X, DIM_X));
+  }
+  benchmark.run("KalmanFilter/predict_update/objects=200", [&]() {
+    for (auto & filter : dynamic_filters) {
+      Eigen::MatrixXd A = Eigen::MatrixXd::Identity(DIM_X, DIM_X);
+      A(0, 3) = dt;
+      A(2, 4) = dt;
+      const Eigen::MatrixXd Q = 0.01 * Eigen::MatrixXd::Identity(DIM_X, DIM_X);
+      const Eigen::MatrixXd B = Eigen::MatrixXd::Zero(DIM_X, DIM_X);
+      const Eigen::MatrixXd u = Eigen::MatrixXd::Zero(DIM_X, 1);
+      filter.predict(u, A, B, Q);
+
+      Eigen::MatrixXd C = Eigen::MatrixXd::Zero(DIM_Y, DIM_X);
+      C(0, 0) = C(1, 1) = C(2, 2) = 1.0;
+      const Eigen::MatrixXd R = 0.1 * Eigen::MatrixXd::Identity(DIM_Y, DIM_Y);
+      const Eigen::MatrixXd Y = Eigen::MatrixXd::Constant(DIM_Y, 1, 1.0);
+      filter.update(Y, C, R);
+    }
+  });
+
+  // fixed size filter with fixed size matrices
+  std::vector<FixedSizeKalmanFilter<DIM_X>, Eigen::aligned_allocator<FixedSizeKalmanFilter<DIM_X>>>
+    fixed_filters(NUM_OBJECTS);
+  for (auto & filter : fixed_filters) {
+    filter.init(
+      Eigen::Matrix<double, DIM_X, 1>::Zero(), Eigen::Matrix<double, DIM_X, DIM_X>::Identity());
+  }
+  benchmark.run("FixedSizeKalmanFilter/predict_update/objects=200", [&]() {
+    for (auto & filter : fixed_filters) {
+      Eigen::Matrix<double, DIM_X, DIM_X> A = Eigen::Matrix<double, DIM_X, DIM_X>::Identity();
+      A(0, 3) = dt;
+      A(2, 4) = dt;
+      const Eigen::Matrix<double, DIM_X, DIM_X> Q =
+        0.01 * Eigen::Matrix<double, DIM_X, DIM_X>::Identity();
+      filter.predict(A * filter.getX(), A, Q);
+
+      Eigen::Matrix<double, DIM_Y, DIM_X> C = Eigen::Matrix<double, DIM_Y, DIM_X>::Zero();
+      C(0, 0) = C(1, 1) = C(2, 2) = 1.0;
+      const Eigen::Matrix<double, DIM_Y, DIM_Y> R =
+        0.1 * Eigen::Matrix<double, DIM_Y, DIM_Y>::Identity();
+      const Eigen::Matrix<double, DIM_Y, 1> Y = Eigen::Matrix<double, DIM_Y, 1>::Ones();
+      filter.update(Y, C, R);
+    }
+  });
+
+  // both filters have converged to the measurement after the benchmark, as a sanity check
+  if (!dynamic_filters.empty() && !fixed_filters.empty()) {
+    Eigen::MatrixXd x;
+    dynamic_filters.front().getX(x);
+    const double diff = (x - fixed_filters.front().getX()).cwiseAbs().maxCoeff();
+    std::fprintf(stderr, "state difference of the first object %g\n", diff);
+  }
+
+  return benchmark.finish();
+}
@@ -0,0 +1,343 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KALMAN_FILTER__FIXED_SIZE_KALMAN_FILTER_HPP_
+#define KALMAN_FILTER__FIXED_SIZE_KALMAN_FILTER_HPP_
+
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/LU>
+
+#include <iostream>
+
+/**
+ * @file fixed_size_kalman_filter.hpp
+ * @brief kalman filter with the state dimension fixed at compile time
+ *
+ * Same interface as KalmanFilter, but all matrices have fixed sizes, so predict and update do
+ * not allocate and small products are unrolled and vectorized by Eigen. Matrices passed as
+ * Eigen::MatrixXd are accepted too and copied into fixed-size storage, which lets existing
+ * callers switch the filter type first and their own matrices later.
+ */
+
+template <int DimX>
+class FixedSizeKalmanFilter
+{
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  using StateVector = Eigen::Matrix<double, DimX, 1>;
+  using StateMatrix = Eigen::Matrix<double, DimX, DimX>;
+  template <int DimY>
+  using MeasurementVector = Eigen::Matrix<double, DimY, 1>;
+  template <int DimY>
+  using MeasurementMatrix = Eigen::Matrix<double, DimY, DimX>;
+  template <int DimY>
+  using MeasurementCovariance = Eigen::Matrix<double, DimY, DimY>;
+
+  /**
+   * @brief No initialization constructor.
+   */
+  FixedSizeKalmanFilter() : x_(StateVector::Zero()), P_(StateMatrix::Zero()) {}
+
+  /**
+   * @brief initialization of kalman filter
+   * @param x initial state
+   * @param P initial covariance of estimated state
+   */
+  template <typename DerivedX, typename DerivedP>
+  bool init(const Eigen::MatrixBase<DerivedX> & x, const Eigen::MatrixBase<DerivedP> & P0)
+  {
+    if (x.rows() != DimX || x.cols() != 1 || P0.rows() != DimX || P0.cols() != DimX) {
+      return false;
+    }
+    x_ = x;
+    P_ = P0;
+    return true;
+  }
+
+  /**
+   * @brief get current kalman filter state
+   * @param x kalman filter state
+   */
+  template <typename Derived>
+  void getX(Eigen::PlainObjectBase<Derived> & x) const
+  {
+    x = x_;
+  }
+
+  /**
+   * @brief get current kalman filter covariance
+   * @param P kalman filter covariance
+   */
+  template <typename Derived>
+  void getP(Eigen::PlainObjectBase<Derived> & P) const
+  {
+    P = P_;
+  }
+
+  const StateVector & getX() const { return x_; }
+  const StateMatrix & getP() const { return P_; }
+
+  /**
+   * @brief get component of current kalman filter state
+   * @param i index of kalman filter state
+   * @return value of i's component of the kalman filter state x[i]
+   */
+  double getXelement(unsigned int i) const { return x_(i); }
+
+  /**
+   * @brief calculate kalman filter covariance with prediction model with x, A, Q matrix.
+   * @param x_next predicted state
+   * @param A coefficient matrix of x for process model
+   * @param Q covariance matrix for process model
+   * @return bool to check matrix operations are being performed properly
+   */
+  bool predict(const StateVector & x_next, const StateMatrix & A, const StateMatrix & Q)
+  {
+    x_ = x_next;
+    P_ = A * P_ * A.transpose() + Q;
+    return true;
+  }
+
+  /**
+   * @brief calculate kalman filter state and covariance by prediction model with A, B, Q matrix.
+   * @param u input for model
+   * @param A coefficient matrix of x for process model
+   * @param B coefficient matrix of u for process model
+   * @param Q covariance matrix for process model
+   * @return bool to check matrix operations are being performed properly
+   */
+  template <int DimU>
+  bool predict(
+    const Eigen::Matrix<double, DimU, 1> & u, const StateMatrix & A,
+    const Eigen::Matrix<double, DimX, DimU> & B, const StateMatrix & Q)
+  {
+    const StateVector x_next = A * x_ + B * u;
+    return predict(x_next, A, Q);
+  }
+
+  /**
+   * @brief predict with dynamic size matrices, e.g. Eigen::MatrixXd.
+   */
+  bool predict(
+    const Eigen::MatrixXd & u, const Eigen::MatrixXd & A, const Eigen::MatrixXd & B,
+    const Eigen::MatrixXd & Q)
+  {
+    if (
+      A.rows() != DimX || A.cols() != DimX || B.rows() != DimX || B.cols() != u.rows() ||
+      Q.rows() != DimX || Q.cols() != DimX) {
+      return false;
+    }
+    const StateMatrix A_fixed = A;
+    const StateVector x_next = A_fixed * x_ + B * u;
+    return predict(x_next, A_fixed, Q);
+  }
+
+  /**
+   * @brief calculate kalman filter state by measurement model with y_pred, C and R matrix.
+   * @param y measured values
+   * @param y_pred output values expected from measurement model
+   * @param C coefficient matrix of x for measurement model
+   * @param R covariance matrix for measurement model
+   * @return bool to check matrix operations are being performed properly
+   */
+  template <int DimY>
+  bool update(
+    const MeasurementVector<DimY> & y, const MeasurementVector<DimY> & y_pred,
+    const MeasurementMatrix<DimY> & C, const MeasurementCovariance<DimY> & R)
+  {
+    const Eigen::Matrix<double, DimX, DimY> PCT = P_ * C.transpose();
+    const Eigen::Matrix<double, DimX, DimY> K = PCT * ((R + C * PCT).inverse());
+
+    if (isnan(K.array()).any() || isinf(K.array()).any()) {
+      return false;
+    }
+
+    x_ += K * (y - y_pred);
+    P_ -= K * (C * P_);
+    return true;
+  }
+
+  /**
+   * @brief calculate kalman filter state by measurement model with C and R matrix.
+   * @param y measured values
+   * @param C coefficient matrix of x for measurement model
+   * @param R covariance matrix for measurement model
+   * @return bool to check matrix operations are being performed properly
+   */
+  template <int DimY>
+  bool update(
+    const MeasurementVector<DimY> & y, const MeasurementMatrix<DimY> & C,
+    const MeasurementCovariance<DimY> & R)
+  {
+    const MeasurementVector<DimY> y_pred = C * x_;
+    return update<DimY>(y, y_pred, C, R);
+  }
+
+  /**
+   * @brief update with dynamic size matrices, e.g. Eigen::MatrixXd. The measurement dimension is
+   * only known at run time, so the gain is computed with dynamic size temporaries.
+   */
+  bool update(const Eigen::MatrixXd & y, const Eigen::MatrixXd & C, const Eigen::MatrixXd & R)
+  {
+    if (
+      C.cols() != DimX || R.rows() != R.cols() || R.rows() != C.rows() || y.rows() != C.rows() ||
+      y.cols() != 1) {
+      return false;
+    }
+    const Eigen::MatrixXd PCT = P_ * C.transpose();
+    const Eigen::MatrixXd K = PCT * ((R + C * PCT).inverse());
+
+    if (isnan(K.array()).any() || isinf(K.array()).any()) {
+      return false;
+    }
+
+    x_ += K * (y - C * x_);
+    P_ -= K * (C * P_);
+    return true;
+  }
+
+protected:
+  StateVector x_;  //!< @brief current estimated state
+  StateMatrix P_;  //!< @brief covariance of estimated state
+};
+
+/**
+ * @brief kalman filter with delayed measurement, with the state dimension fixed at compile time
+ *
+ * The extended state holds max_delay_step states, so its size is only known at run time and is
+ * allocated once in init(). The extended state and covariance are ring buffers of fixed-size
+ * blocks, as in TimeDelayKalmanFilter.
+ */
+template <int DimX>
+class FixedSizeTimeDelayKalmanFilter
+{
+public:
+  using StateVector = Eigen::Matrix<double, DimX, 1>;
+  using StateMatrix = Eigen::Matrix<double, DimX, DimX>;
+
+  /**
+   * @brief initialization of kalman filter
+   * @param x initial state
+   * @param P0 initial covariance of estimated state
+   * @param max_delay_step Maximum number of delay steps
+   */
+  void init(const StateVector & x, const StateMatrix & P0, const int max_delay_step)
+  {
+    max_delay_step_ = max_delay_step;
+    latest_block_ = 0;
+    x_ = Eigen::VectorXd::Zero(DimX * max_delay_step_);
+    P_ = Eigen::MatrixXd::Zero(DimX * max_delay_step_, DimX * max_delay_step_);
+    A_P_ = Eigen::Matrix<double, DimX, Eigen::Dynamic>::Zero(DimX, DimX * max_delay_step_);
+    for (int i = 0; i < max_delay_step_; ++i) {
+      x_.template segment<DimX>(i * DimX) = x;
+      P_.template block<DimX, DimX>(i * DimX, i * DimX) = P0;
+    }
+  }
+
+  /**
+   * @brief get latest time estimated state
+   * @param x latest time estimated state
+   */
+  StateVector getLatestX() const { return x_.template segment<DimX>(blockIndex(0)); }
+
+  /**
+   * @brief get latest time estimation covariance
+   * @param P latest time estimation covariance
+   */
+  StateMatrix getLatestP() const
+  {
+    return P_.template block<DimX, DimX>(blockIndex(0), blockIndex(0));
+  }
+
+  /**
+   * @brief get element of the extended state
+   * @param i index of the element, where delay_step * DimX + j is element j of the state
+   * delay_step steps before the latest one
+   */
+  double getXelement(unsigned int i) const { return x_(blockIndex(i / DimX) + i % DimX); }
+
+  /**
+   * @brief calculate kalman filter covariance by precision model with time delay.
+   * @param x_next predicted state by prediction model
+   * @param A coefficient matrix of x for process model
+   * @param Q covariance matrix for process model
+   */
+  bool predictWithDelay(const StateVector & x_next, const StateMatrix & A, const StateMatrix & Q)
+  {
+    const int prev = blockIndex(0);
+    latest_block_ = (latest_block_ + max_delay_step_ - 1) % max_delay_step_;
+    const int next = blockIndex(0);
+
+    x_.template segment<DimX>(next) = x_next;
+
+    A_P_.noalias() = A * P_.middleRows(prev, DimX);
+    const StateMatrix P11 = A_P_.template middleCols<DimX>(prev) * A.transpose() + Q;
+    P_.middleRows(next, DimX) = A_P_;
+    P_.middleCols(next, DimX) = A_P_.transpose();
+    P_.template block<DimX, DimX>(next, next) = P11;
+    return true;
+  }
+
+  /**
+   * @brief calculate kalman filter covariance by measurement model with time delay.
+   * @param y measured values
+   * @param C coefficient matrix of x for measurement model
+   * @param R covariance matrix for measurement model
+   * @param delay_step measurement delay
+   */
+  template <int DimY>
+  bool updateWithDelay(
+    const Eigen::Matrix<double, DimY, 1> & y, const Eigen::Matrix<double, DimY, DimX> & C,
+    const Eigen::Matrix<double, DimY, DimY> & R, const int delay_step)
+  {
+    if (delay_step >= max_delay_step_) {
+      std::cerr << "delay step is larger than max_delay_step. ignore update." << std::endl;
+      return false;
+    }
+
+    const int block = blockIndex(delay_step);
+    PCT_.resize(P_.rows(), DimY);
+    PCT_.noalias() = P_.middleCols(block, DimX) * C.transpose();
+    const Eigen::Matrix<double, DimY, DimY> S =
+      R + C * PCT_.template middleRows<DimX>(block);
+    K_.resize(P_.rows(), DimY);
+    K_.noalias() = PCT_ * S.inverse();
+
+    if (isnan(K_.array()).any() || isinf(K_.array()).any()) {
+      return false;
+    }
+
+    const Eigen::Matrix<double, DimY, 1> residual = y - C * x_.template segment<DimX>(block);
+    x_.noalias() += K_ * residual;
+    P_.noalias() -= K_ * PCT_.transpose();
+    return true;
+  }
+
+private:
+  int blockIndex(const int delay_step) const
+  {
+    return ((latest_block_ + delay_step) % max_delay_step_) * DimX;
+  }
+
+  int max_delay_step_{1};  //!< @brief maximum number of delay steps
+  int latest_block_{0};    //!< @brief block holding the latest state in x_ and P_
+  Eigen::VectorXd x_;      //!< @brief extended state
+  Eigen::MatrixXd P_;      //!< @brief covariance of extended state
+  Eigen::Matrix<double, DimX, Eigen::Dynamic> A_P_;  //!< @brief buffer of A * (latest rows of P)
+  Eigen::MatrixXd PCT_;                              //!< @brief buffer of P * C_ex'
+  Eigen::MatrixXd K_;                                //!< @brief buffer of the kalman gain
+};
+
+#endif  // KALMAN_FILTER__FIXED_SIZE_KALMAN_FILTER_HPP_
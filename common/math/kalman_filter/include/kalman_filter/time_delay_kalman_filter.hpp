@@ -58,6 +58,26 @@ public:
    */
   void getLatestP(Eigen::MatrixXd & P);
 
+  /**
+   * @brief get extended state with the latest state first
+   * @param x extended state
+   */
+  void getX(Eigen::MatrixXd & x);
+
+  /**
+   * @brief get covariance of the extended state with the latest state first
+   * @param P extended covariance
+   */
+  void getP(Eigen::MatrixXd & P);
+
+  /**
+   * @brief get element of the extended state
+   * @param i index of the element, where delay_step * dim_x + j is element j of the state
+   * delay_step steps before the latest one
+   * @return value of i'th element
+   */
+  double getXelement(unsigned int i);
+
   /**
    * @brief calculate kalman filter covariance by precision model with time delay. This is mainly
    * for EKF of nonlinear process model.
@@ -81,8 +101,21 @@ public:
     const int delay_step);
 
 private:
+  /**
+   * @brief index of the first row of the given delay step in x_ and P_
+   * @param delay_step delay step from the latest state
+   */
+  int blockIndex(const int delay_step) const;
+
   int max_delay_step_;  //!< @brief maximum number of delay steps
   int dim_x_;           //!< @brief dimension of latest state
   int dim_x_ex_;        //!< @brief dimension of extended state with dime delay
+
+  /**
+   * @brief block holding the latest state. x_ and P_ are ring buffers of max_delay_step blocks,
+   * so a prediction only writes the block of the new state instead of shifting all blocks.
+   */
+  int latest_block_;
+  Eigen::MatrixXd A_P_;  //!< @brief buffer of A * (rows of the latest state in P_)
 };
 #endif  // KALMAN_FILTER__TIME_DELAY_KALMAN_FILTER_HPP_
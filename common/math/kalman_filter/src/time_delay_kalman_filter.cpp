@@ -22,9 +22,11 @@ void TimeDelayKalmanFilter::init(
   max_delay_step_ = max_delay_step;
   dim_x_ = x.rows();
   dim_x_ex_ = dim_x_ * max_delay_step;
+  latest_block_ = 0;
 
   x_ = Eigen::MatrixXd::Zero(dim_x_ex_, 1);
   P_ = Eigen::MatrixXd::Zero(dim_x_ex_, dim_x_ex_);
+  A_P_ = Eigen::MatrixXd::Zero(dim_x_, dim_x_ex_);
 
   for (int i = 0; i < max_delay_step_; ++i) {
     x_.block(i * dim_x_, 0, dim_x_, 1) = x;
@@ -32,8 +34,43 @@ void TimeDelayKalmanFilter::init(
   }
 }
 
-void TimeDelayKalmanFilter::getLatestX(Eigen::MatrixXd & x) { x = x_.block(0, 0, dim_x_, 1); }
-void TimeDelayKalmanFilter::getLatestP(Eigen::MatrixXd & P) { P = P_.block(0, 0, dim_x_, dim_x_); }
+int TimeDelayKalmanFilter::blockIndex(const int delay_step) const
+{
+  return ((latest_block_ + delay_step) % max_delay_step_) * dim_x_;
+}
+
+void TimeDelayKalmanFilter::getLatestX(Eigen::MatrixXd & x)
+{
+  x = x_.block(blockIndex(0), 0, dim_x_, 1);
+}
+void TimeDelayKalmanFilter::getLatestP(Eigen::MatrixXd & P)
+{
+  P = P_.block(blockIndex(0), blockIndex(0), dim_x_, dim_x_);
+}
+
+void TimeDelayKalmanFilter::getX(Eigen::MatrixXd & x)
+{
+  x.resize(dim_x_ex_, 1);
+  for (int i = 0; i < max_delay_step_; ++i) {
+    x.block(i * dim_x_, 0, dim_x_, 1) = x_.block(blockIndex(i), 0, dim_x_, 1);
+  }
+}
+
+void TimeDelayKalmanFilter::getP(Eigen::MatrixXd & P)
+{
+  P.resize(dim_x_ex_, dim_x_ex_);
+  for (int i = 0; i < max_delay_step_; ++i) {
+    for (int j = 0; j < max_delay_step_; ++j) {
+      P.block(i * dim_x_, j * dim_x_, dim_x_, dim_x_) =
+        P_.block(blockIndex(i), blockIndex(j), dim_x_, dim_x_);
+    }
+  }
+}
+
+double TimeDelayKalmanFilter::getXelement(unsigned int i)
+{
+  return x_(blockIndex(i / dim_x_) + i % dim_x_);
+}
 
 bool TimeDelayKalmanFilter::predictWithDelay(
   const Eigen::MatrixXd & x_next, const Eigen::MatrixXd & A, const Eigen::MatrixXd & Q)
@@ -50,23 +87,22 @@ bool TimeDelayKalmanFilter::predictWithDelay(
    *     [A*P11*A'*+Q  A*P11  A*P12]
    * P = [     P11*A'    P11    P12]
    *     [     P21*A'    P21    P22]
+   *
+   * Only the first block row and column are new. With x_ and P_ as ring buffers, the other blocks
+   * stay where they are and the block of the oldest state is overwritten by the new state.
    */
 
-  const int d_dim_x = dim_x_ex_ - dim_x_;
+  const int prev = blockIndex(0);
+  latest_block_ = (latest_block_ + max_delay_step_ - 1) % max_delay_step_;
+  const int next = blockIndex(0);
 
-  /* slide states in the time direction */
-  Eigen::MatrixXd x_tmp = Eigen::MatrixXd::Zero(dim_x_ex_, 1);
-  x_tmp.block(0, 0, dim_x_, 1) = x_next;
-  x_tmp.block(dim_x_, 0, d_dim_x, 1) = x_.block(0, 0, d_dim_x, 1);
-  x_ = x_tmp;
+  x_.block(next, 0, dim_x_, 1) = x_next;
 
-  /* update P with delayed measurement A matrix structure */
-  Eigen::MatrixXd P_tmp = Eigen::MatrixXd::Zero(dim_x_ex_, dim_x_ex_);
-  P_tmp.block(0, 0, dim_x_, dim_x_) = A * P_.block(0, 0, dim_x_, dim_x_) * A.transpose() + Q;
-  P_tmp.block(0, dim_x_, dim_x_, d_dim_x) = A * P_.block(0, 0, dim_x_, d_dim_x);
-  P_tmp.block(dim_x_, 0, d_dim_x, dim_x_) = P_.block(0, 0, d_dim_x, dim_x_) * A.transpose();
-  P_tmp.block(dim_x_, dim_x_, d_dim_x, d_dim_x) = P_.block(0, 0, d_dim_x, d_dim_x);
-  P_ = P_tmp;
+  A_P_.noalias() = A * P_.middleRows(prev, dim_x_);
+  const Eigen::MatrixXd P11 = A_P_.middleCols(prev, dim_x_) * A.transpose() + Q;
+  P_.middleRows(next, dim_x_) = A_P_;
+  P_.middleCols(next, dim_x_) = A_P_.transpose();
+  P_.block(next, next, dim_x_, dim_x_) = P11;
 
   return true;
 }
@@ -80,16 +116,26 @@ bool TimeDelayKalmanFilter::updateWithDelay(
     return false;
   }
 
-  const int dim_y = y.rows();
+  if (
+    C.cols() != dim_x_ || R.rows() != R.cols() || R.rows() != C.rows() || y.rows() != C.rows()) {
+    return false;
+  }
 
-  /* set measurement matrix */
-  Eigen::MatrixXd C_ex = Eigen::MatrixXd::Zero(dim_y, dim_x_ex_);
-  C_ex.block(0, dim_x_ * delay_step, dim_y, dim_x_) = C;
+  /*
+   * The extended measurement matrix C_ex = [0 .. C .. 0] only selects the block of the delayed
+   * state, so P * C_ex' is P's block column times C', and C_ex * P is its transpose since P is
+   * symmetric. This replaces the dense products with C_ex of KalmanFilter::update.
+   */
+  const int block = blockIndex(delay_step);
+  const Eigen::MatrixXd PCT = P_.middleCols(block, dim_x_) * C.transpose();
+  const Eigen::MatrixXd K = PCT * ((R + C * PCT.middleRows(block, dim_x_)).inverse());
 
-  /* update */
-  if (!update(y, C_ex, R)) {
+  if (isnan(K.array()).any() || isinf(K.array()).any()) {
     return false;
   }
 
+  x_ += K * (y - C * x_.block(block, 0, dim_x_, 1));
+  P_.noalias() -= K * PCT.transpose();
+
   return true;
 }
@@ -0,0 +1,102 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Solves a QP shaped like the velocity smoothers: minimize the jerk and the deviation from a
+// reference over N points, with bounds on the values and on their differences. It is solved with
+// a new workspace per call, and with the workspace reused by updateProblem as the nodes do.
+
+#include "osqp_interface/csc_matrix_conv.hpp"
+#include "osqp_interface/osqp_interface.hpp"
+
+#include <autoware_replay_benchmark/micro_benchmark.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Problem
+{
+  Eigen::MatrixXd P;
+  Eigen::MatrixXd A;
+  std::vector<double> q;
+  std::vector<double> l;
+  std::vector<double> u;
+};
+
+Problem createProblem(const int num_points)
+{
+  // second difference for the jerk and first difference for the constraints
+  Eigen::MatrixXd D2 = Eigen::MatrixXd::Zero(num_points - 2, num_points);
+  Eigen::MatrixXd D1 = Eigen::MatrixXd::Zero(num_points - 1, num_points);
+  for (int i = 0; i < num_points - 2; ++i) {
+    D2(i, i) = 1.0;
+    D2(i, i + 1) = -2.0;
+    D2(i, i + 2) = 1.0;
+  }
+  for (int i = 0; i < num_points - 1; ++i) {
+    D1(i, i) = -1.0;
+    D1(i, i + 1) = 1.0;
+  }
+
+  Problem problem;
+  problem.P = 100.0 * D2.transpose() * D2 + Eigen::MatrixXd::Identity(num_points, num_points);
+  problem.A = Eigen::MatrixXd::Zero(2 * num_points - 1, num_points);
+  problem.A.topRows(num_points) = Eigen::MatrixXd::Identity(num_points, num_points);
+  problem.A.bottomRows(num_points - 1) = D1;
+
+  // reference velocity of 10 m/s with a stop at the end
+  for (int i = 0; i < num_points; ++i) {
+    problem.q.push_back(i + 1 < num_points ? -10.0 : 0.0);
+    problem.l.push_back(0.0);
+    problem.u.push_back(i + 1 < num_points ? 10.0 : 0.0);
+  }
+  for (int i = 0; i < num_points - 1; ++i) {
+    problem.l.push_back(-0.3);
+    problem.u.push_back(0.2);
+  }
+  return problem;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  using autoware_replay_benchmark::doNotOptimize;
+  autoware_replay_benchmark::MicroBenchmark benchmark("osqp_interface", argc, argv);
+
+  for (const int num_points : {50, 100, 200}) {
+    const auto problem = createProblem(num_points);
+    const std::string suffix = "/N=" + std::to_string(num_points);
+
+    benchmark.run("calCSCMatrix" + suffix, [&]() {
+      doNotOptimize(osqp::calCSCMatrixTrapezoidal(problem.P));
+      doNotOptimize(osqp::calCSCMatrix(problem.A));
+    });
+
+    benchmark.run("optimize/new_workspace" + suffix, [&]() {
+      osqp::OSQPInterface solver(1.0e-4);
+      solver.updateMaxIter(4000);
+      doNotOptimize(solver.optimize(problem.P, problem.A, problem.q, problem.l, problem.u));
+    });
+
+    osqp::OSQPInterface solver(1.0e-4);
+    solver.updateMaxIter(4000);
+    benchmark.run("optimize/update_problem" + suffix, [&]() {
+      solver.updateProblem(problem.P, problem.A, problem.q, problem.l, problem.u);
+      doNotOptimize(solver.optimize());
+    });
+  }
+
+  return benchmark.finish();
+}
@@ -15,6 +15,7 @@
 #define OSQP_INTERFACE__CSC_MATRIX_CONV_HPP_
 
 #include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/SparseCore>
 
 #include <osqp/types.h>  // for 'c_int' type ('long' or 'long long')
 
@@ -37,6 +38,9 @@ struct CSC_Matrix
 
 CSC_Matrix calCSCMatrix(const Eigen::MatrixXd & mat);
 CSC_Matrix calCSCMatrixTrapezoidal(const Eigen::MatrixXd & mat);
+// Same as above for a sparse matrix, which is converted without scanning the zero elements.
+CSC_Matrix calCSCMatrix(const Eigen::SparseMatrix<double> & mat);
+CSC_Matrix calCSCMatrixTrapezoidal(const Eigen::SparseMatrix<double> & mat);
 
 void printCSCMatrix(CSC_Matrix & csc_mat);
 
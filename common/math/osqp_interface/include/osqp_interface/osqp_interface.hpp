@@ -68,6 +68,14 @@ namespace osqp
  *          osqp_interface.optimize();
  *        }
  *
+ *   4. SOLVE A NEW PROBLEM EVERY CYCLE, reusing the workspace when only the values change.
+ *        osqp_interface = OSQPInterface();
+ *        while()
+ *        {
+ *          osqp_interface.updateProblem(P, A, q, l, u);
+ *          osqp_interface.optimize();
+ *        }
+ *
  * Ref: https://osqp.org/docs/solver/index.html
  */
 class OSQPInterface
@@ -86,6 +94,15 @@ private:
   // Number of parameters to optimize
   c_int param_n;
 
+  // Sparsity pattern of the problem in the workspace, to know if it can be updated in place.
+  std::vector<c_int> P_row_idxs;
+  std::vector<c_int> P_col_idxs;
+  std::vector<c_int> A_row_idxs;
+  std::vector<c_int> A_col_idxs;
+
+  // False after a failed solve, so that the next problem is not warm started from its iterate
+  bool is_workspace_reusable = false;
+
   // For destructor to know if matrices P, A are in
   bool problem_in_memory = false;
 
@@ -180,6 +197,9 @@ public:
 
   // Solves convex quadratic programs (QPs) using the OSQP solver.
   //
+  // The problem is loaded with updateProblem(), so the workspace of the previous call is reused
+  // and warm started when the sparsity pattern of P and A is unchanged.
+  //
   // The function returns a tuple containing the solution as two float vectors.
   // The first element of the tuple contains the 'primal' solution.
   // The second element contains the 'lagrange multiplier' solution.
@@ -216,6 +236,24 @@ public:
     const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
     const std::vector<double> & l, const std::vector<double> & u);
 
+  // Same as above with P (upper triangular part only) and A given as CSC matrices.
+  c_int initializeProblem(
+    const CSC_Matrix & P, const CSC_Matrix & A, const std::vector<double> & q,
+    const std::vector<double> & l, const std::vector<double> & u);
+
+  // Loads a new problem, keeping the workspace if P and A have the same size and sparsity
+  // pattern as the stored problem. Only the values are updated then, so the factorization is
+  // not set up again and the next solve is warm started from the previous solution. Otherwise
+  // the workspace is set up with initializeProblem().
+  //
+  // Args: See initializeProblem().
+  c_int updateProblem(
+    const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
+    const std::vector<double> & l, const std::vector<double> & u);
+  c_int updateProblem(
+    const CSC_Matrix & P, const CSC_Matrix & A, const std::vector<double> & q,
+    const std::vector<double> & l, const std::vector<double> & u);
+
   // Updates problem parameters while keeping solution in memory.
   //
   // Args:
@@ -238,6 +276,14 @@ public:
   void updateRho(const double rho);
   void updateAlpha(const double alpha);
 
+  // Sets the initial primal solution of the next solve instead of the previous solution, e.g. the
+  // previous solution shifted by one step for a receding horizon problem. To be called after the
+  // problem is loaded. Ignored if the size is not the number of parameters.
+  //
+  // Args:
+  //   x: (n) vector of the initial guess.
+  void setWarmStart(const std::vector<double> & x);
+
   int getTakenIter() { return static_cast<int>(latest_work_info.iter); }
   std::string getStatusMessage() { return static_cast<std::string>(latest_work_info.status); }
   int getStatus() { return static_cast<int>(latest_work_info.status_val); }
@@ -110,6 +110,50 @@ CSC_Matrix calCSCMatrixTrapezoidal(const Eigen::MatrixXd & mat)
   return csc_matrix;
 }
 
+CSC_Matrix calCSCMatrix(const Eigen::SparseMatrix<double> & mat)
+{
+  CSC_Matrix csc_matrix;
+  csc_matrix.vals.reserve(mat.nonZeros());
+  csc_matrix.row_idxs.reserve(mat.nonZeros());
+  csc_matrix.col_idxs.reserve(mat.outerSize() + 1);
+
+  // Stored elements are kept even if they are zero, so that the sparsity pattern only depends on
+  // how the matrix is built
+  csc_matrix.col_idxs.push_back(0);
+  for (int j = 0; j < mat.outerSize(); j++) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(mat, j); it; ++it) {
+      csc_matrix.vals.push_back(it.value());
+      csc_matrix.row_idxs.push_back(it.row());
+    }
+    csc_matrix.col_idxs.push_back(csc_matrix.vals.size());
+  }
+
+  return csc_matrix;
+}
+
+CSC_Matrix calCSCMatrixTrapezoidal(const Eigen::SparseMatrix<double> & mat)
+{
+  if (mat.rows() != mat.cols()) {
+    throw std::invalid_argument("Matrix must be square (n, n)");
+  }
+
+  CSC_Matrix csc_matrix;
+  csc_matrix.vals.reserve(mat.nonZeros());
+  csc_matrix.row_idxs.reserve(mat.nonZeros());
+  csc_matrix.col_idxs.reserve(mat.outerSize() + 1);
+
+  csc_matrix.col_idxs.push_back(0);
+  for (int j = 0; j < mat.outerSize(); j++) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(mat, j); it && it.row() <= j; ++it) {
+      csc_matrix.vals.push_back(it.value());
+      csc_matrix.row_idxs.push_back(it.row());
+    }
+    csc_matrix.col_idxs.push_back(csc_matrix.vals.size());
+  }
+
+  return csc_matrix;
+}
+
 void printCSCMatrix(CSC_Matrix & csc_mat)
 {
   std::cout << "[";
@@ -24,10 +24,77 @@
 #include <chrono>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <vector>
 
+namespace
+{
+void checkProblemSize(
+  const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
+  const std::vector<double> & l, const std::vector<double> & u)
+{
+  // check if arguments are valid
+  std::stringstream ss;
+  if (P.rows() != P.cols()) {
+    ss << "P.rows() and P.cols() are not the same. P.rows() = " << P.rows()
+       << ", P.cols() = " << P.cols();
+    throw std::invalid_argument(ss.str());
+  }
+  if (P.rows() != q.size()) {
+    ss << "P.rows() and q.size() are not the same. P.rows() = " << P.rows()
+       << ", q.size() = " << q.size();
+    throw std::invalid_argument(ss.str());
+  }
+  if (P.rows() != A.cols()) {
+    ss << "P.rows() and A.cols() are not the same. P.rows() = " << P.rows()
+       << ", A.cols() = " << A.cols();
+    throw std::invalid_argument(ss.str());
+  }
+  if (A.rows() != l.size()) {
+    ss << "A.rows() and l.size() are not the same. A.rows() = " << A.rows()
+       << ", l.size() = " << l.size();
+    throw std::invalid_argument(ss.str());
+  }
+  if (A.rows() != u.size()) {
+    ss << "A.rows() and u.size() are not the same. A.rows() = " << A.rows()
+       << ", u.size() = " << u.size();
+    throw std::invalid_argument(ss.str());
+  }
+}
+
+void checkProblemSize(
+  const osqp::CSC_Matrix & P, const osqp::CSC_Matrix & A, const std::vector<double> & q,
+  const std::vector<double> & l, const std::vector<double> & u)
+{
+  // check if arguments are valid
+  std::stringstream ss;
+  if (P.col_idxs.empty() || A.col_idxs.size() != P.col_idxs.size()) {
+    ss << "P and A do not have the same number of columns. P.col_idxs.size() = "
+       << P.col_idxs.size() << ", A.col_idxs.size() = " << A.col_idxs.size();
+    throw std::invalid_argument(ss.str());
+  }
+  if (P.col_idxs.size() != q.size() + 1) {
+    ss << "P.cols() and q.size() are not the same. P.col_idxs.size() = " << P.col_idxs.size()
+       << ", q.size() = " << q.size();
+    throw std::invalid_argument(ss.str());
+  }
+  if (l.size() != u.size()) {
+    ss << "l.size() and u.size() are not the same. l.size() = " << l.size()
+       << ", u.size() = " << u.size();
+    throw std::invalid_argument(ss.str());
+  }
+  for (const auto row_idx : A.row_idxs) {
+    if (row_idx < 0 || static_cast<size_t>(row_idx) >= l.size()) {
+      ss << "A has an element in row " << row_idx << ", but l.size() = " << l.size();
+      throw std::invalid_argument(ss.str());
+    }
+  }
+}
+}  // namespace
+
 namespace osqp
 {
 void OSQPInterface::OSQPWorkspaceDeleter(OSQPWorkspace * ptr) noexcept
@@ -77,39 +144,22 @@ c_int OSQPInterface::initializeProblem(
   const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
   const std::vector<double> & l, const std::vector<double> & u)
 {
-  // check if arguments are valid
-  std::stringstream ss;
-  if (P.rows() != P.cols()) {
-    ss << "P.rows() and P.cols() are not the same. P.rows() = " << P.rows()
-       << ", P.cols() = " << P.cols();
-    throw std::invalid_argument(ss.str());
-  }
-  if (P.rows() != q.size()) {
-    ss << "P.rows() and q.size() are not the same. P.rows() = " << P.rows()
-       << ", q.size() = " << q.size();
-    throw std::invalid_argument(ss.str());
-  }
-  if (P.rows() != A.cols()) {
-    ss << "P.rows() and A.cols() are not the same. P.rows() = " << P.rows()
-       << ", A.cols() = " << A.cols();
-    throw std::invalid_argument(ss.str());
-  }
-  if (A.rows() != l.size()) {
-    ss << "A.rows() and l.size() are not the same. A.rows() = " << A.rows()
-       << ", l.size() = " << l.size();
-    throw std::invalid_argument(ss.str());
-  }
-  if (A.rows() != u.size()) {
-    ss << "A.rows() and u.size() are not the same. A.rows() = " << A.rows()
-       << ", u.size() = " << u.size();
-    throw std::invalid_argument(ss.str());
-  }
+  checkProblemSize(P, A, q, l, u);
+  return initializeProblem(calCSCMatrixTrapezoidal(P), calCSCMatrix(A), q, l, u);
+}
+
+c_int OSQPInterface::initializeProblem(
+  const CSC_Matrix & P, const CSC_Matrix & A, const std::vector<double> & q,
+  const std::vector<double> & l, const std::vector<double> & u)
+{
+  checkProblemSize(P, A, q, l, u);
 
   /*******************
    * SET UP MATRICES
    *******************/
-  CSC_Matrix P_csc = calCSCMatrixTrapezoidal(P);
-  CSC_Matrix A_csc = calCSCMatrix(A);
+  // osqp_setup() copies the data, it does not have to outlive this function
+  CSC_Matrix P_csc = P;
+  CSC_Matrix A_csc = A;
   // Dynamic float arrays
   std::vector<double> q_tmp(q.begin(), q.end());
   std::vector<double> l_tmp(l.begin(), l.end());
@@ -122,9 +172,9 @@ c_int OSQPInterface::initializeProblem(
    * OBJECTIVE FUNCTION
    **********************/
   // Number of constraints
-  c_int constr_m = A.rows();
+  c_int constr_m = l.size();
   // Number of parameters
-  param_n = P.rows();
+  param_n = q.size();
 
   /*****************
    * POPULATE DATA
@@ -150,6 +200,47 @@ c_int OSQPInterface::initializeProblem(
   work.reset(workspace);
   work_initialized = true;
 
+  P_row_idxs = P.row_idxs;
+  P_col_idxs = P.col_idxs;
+  A_row_idxs = A.row_idxs;
+  A_col_idxs = A.col_idxs;
+  is_workspace_reusable = exitflag == 0;
+
+  return exitflag;
+}
+
+c_int OSQPInterface::updateProblem(
+  const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
+  const std::vector<double> & l, const std::vector<double> & u)
+{
+  checkProblemSize(P, A, q, l, u);
+  return updateProblem(calCSCMatrixTrapezoidal(P), calCSCMatrix(A), q, l, u);
+}
+
+c_int OSQPInterface::updateProblem(
+  const CSC_Matrix & P, const CSC_Matrix & A, const std::vector<double> & q,
+  const std::vector<double> & l, const std::vector<double> & u)
+{
+  const bool is_same_pattern = static_cast<c_int>(l.size()) == data->m &&
+                               P.row_idxs == P_row_idxs && P.col_idxs == P_col_idxs &&
+                               A.row_idxs == A_row_idxs && A.col_idxs == A_col_idxs;
+  if (!work_initialized || !is_workspace_reusable || !is_same_pattern) {
+    return initializeProblem(P, A, q, l, u);
+  }
+  checkProblemSize(P, A, q, l, u);
+
+  // the solution of the previous problem stays in the workspace as the warm start
+  exitflag = osqp_update_P_A(
+    work.get(), P.vals.data(), OSQP_NULL, P.vals.size(), A.vals.data(), OSQP_NULL,
+    A.vals.size());
+  if (exitflag == 0) {
+    exitflag = osqp_update_lin_cost(work.get(), q.data());
+  }
+  if (exitflag == 0) {
+    exitflag = osqp_update_bounds(work.get(), l.data(), u.data());
+  }
+  is_workspace_reusable = exitflag == 0;
+
   return exitflag;
 }
 
@@ -267,6 +358,13 @@ void OSQPInterface::updateAlpha(const double alpha)
   }
 }
 
+void OSQPInterface::setWarmStart(const std::vector<double> & x)
+{
+  if (work_initialized && static_cast<c_int>(x.size()) == data->n) {
+    osqp_warm_start_x(work.get(), x.data());
+  }
+}
+
 std::tuple<std::vector<double>, std::vector<double>, int, int> OSQPInterface::solve()
 {
   // Solve Problem
@@ -289,6 +387,10 @@ std::tuple<std::vector<double>, std::vector<double>, int, int> OSQPInterface::so
 
   latest_work_info = *(work->info);
 
+  // a failed solve leaves a poor iterate to warm start from
+  is_workspace_reusable =
+    status_solution == OSQP_SOLVED || status_solution == OSQP_SOLVED_INACCURATE;
+
   return result;
 }
 
@@ -303,15 +405,11 @@ std::tuple<std::vector<double>, std::vector<double>, int, int> OSQPInterface::op
   const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
   const std::vector<double> & l, const std::vector<double> & u)
 {
-  // Allocate memory for problem
-  initializeProblem(P, A, q, l, u);
+  // Load the problem, keeping the workspace of the previous call if possible
+  updateProblem(P, A, q, l, u);
 
   // Run the solver on the stored problem representation.
   std::tuple<std::vector<double>, std::vector<double>, int, int> result = solve();
-
-  // Free allocated memory for problem
-  work.reset();
-  work_initialized = false;
   return result;
 }
 
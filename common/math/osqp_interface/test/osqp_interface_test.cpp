@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "osqp_interface/csc_matrix_conv.hpp"
 #include "osqp_interface/osqp_interface.hpp"
 
 #include <gtest/gtest.h>
@@ -42,6 +43,118 @@ TEST(OSQPInterface, Solve)
   EXPECT_LE(std::fabs(x_optimal[1]), tolerance);
 }
 
+TEST(OSQPInterface, UpdateProblem)
+{
+  // minimize x'x + [q0 q1]x
+  // subject to -1 <= x <= 1
+  // The answer is expected to -q/2
+  osqp::OSQPInterface solver;
+  constexpr int num_vars = 2;
+  Eigen::MatrixXd P = Eigen::MatrixXd::Identity(num_vars, num_vars) * 2.0;
+  Eigen::MatrixXd A = Eigen::MatrixXd::Identity(num_vars, num_vars);
+  std::vector<double> l(num_vars, -1.0);
+  std::vector<double> u(num_vars, 1.0);
+
+  // the second problem has the same sparsity pattern and reuses the workspace
+  for (const double q_val : {1.0, -1.0}) {
+    std::vector<double> q(num_vars, q_val);
+    EXPECT_EQ(solver.updateProblem(P, A, q, l, u), 0);
+    const auto result = solver.optimize();
+    std::vector<double> x_optimal = std::get<0>(result);
+    EXPECT_EQ(std::get<3>(result), 1);
+    EXPECT_NEAR(x_optimal[0], -0.5 * q_val, tolerance);
+    EXPECT_NEAR(x_optimal[1], -0.5 * q_val, tolerance);
+  }
+
+  // a different number of variables sets the workspace up again
+  {
+    constexpr int num_vars_new = 3;
+    Eigen::MatrixXd P_new = Eigen::MatrixXd::Identity(num_vars_new, num_vars_new) * 2.0;
+    Eigen::MatrixXd A_new = Eigen::MatrixXd::Identity(num_vars_new, num_vars_new);
+    std::vector<double> q(num_vars_new, 1.0);
+    std::vector<double> l_new(num_vars_new, -1.0);
+    std::vector<double> u_new(num_vars_new, 1.0);
+    const auto result = solver.optimize(P_new, A_new, q, l_new, u_new);
+    std::vector<double> x_optimal = std::get<0>(result);
+    ASSERT_EQ(x_optimal.size(), static_cast<size_t>(num_vars_new));
+    for (const double x : x_optimal) {
+      EXPECT_NEAR(x, -0.5, tolerance);
+    }
+  }
+
+  // inconsistent sizes are rejected like in initializeProblem()
+  {
+    std::vector<double> q(num_vars + 1, 1.0);
+    EXPECT_THROW(solver.updateProblem(P, A, q, l, u), std::invalid_argument);
+  }
+}
+
+TEST(OSQPInterface, WarmStart)
+{
+  // minimize x'x + [1 -1]x
+  // subject to -1 <= x <= 1
+  // The answer is expected to [-0.5 0.5]'
+  constexpr int num_vars = 2;
+  Eigen::MatrixXd P = Eigen::MatrixXd::Identity(num_vars, num_vars) * 2.0;
+  Eigen::MatrixXd A = Eigen::MatrixXd::Identity(num_vars, num_vars);
+  std::vector<double> q{1.0, -1.0};
+  std::vector<double> l(num_vars, -1.0);
+  std::vector<double> u(num_vars, 1.0);
+
+  osqp::OSQPInterface cold_solver;
+  const auto cold_result = cold_solver.optimize(P, A, q, l, u);
+  const std::vector<double> x_optimal = std::get<0>(cold_result);
+
+  // starting from the answer does not take more iterations
+  osqp::OSQPInterface warm_solver;
+  EXPECT_EQ(warm_solver.updateProblem(P, A, q, l, u), 0);
+  warm_solver.setWarmStart(x_optimal);
+  const auto warm_result = warm_solver.optimize();
+  EXPECT_EQ(std::get<3>(warm_result), 1);
+  EXPECT_LE(warm_solver.getTakenIter(), cold_solver.getTakenIter());
+  EXPECT_NEAR(std::get<0>(warm_result)[0], -0.5, tolerance);
+  EXPECT_NEAR(std::get<0>(warm_result)[1], 0.5, tolerance);
+
+  // an initial guess of another size is ignored
+  EXPECT_NO_THROW(warm_solver.setWarmStart(std::vector<double>(num_vars + 1, 0.0)));
+}
+
+TEST(OSQPInterface, SparseMatrix)
+{
+  Eigen::MatrixXd dense(3, 3);
+  dense << 4.0, 1.0, 0.0, 1.0, 2.0, 0.0, 0.0, 0.0, 3.0;
+  const Eigen::SparseMatrix<double> sparse = dense.sparseView();
+
+  const auto expect_same = [](const osqp::CSC_Matrix & a, const osqp::CSC_Matrix & b) {
+    EXPECT_EQ(a.vals, b.vals);
+    EXPECT_EQ(a.row_idxs, b.row_idxs);
+    EXPECT_EQ(a.col_idxs, b.col_idxs);
+  };
+  expect_same(osqp::calCSCMatrix(sparse), osqp::calCSCMatrix(dense));
+  expect_same(osqp::calCSCMatrixTrapezoidal(sparse), osqp::calCSCMatrixTrapezoidal(dense));
+
+  // the pattern of a sparse matrix keeps its explicit zeros
+  std::vector<Eigen::Triplet<double>> triplets{{0, 0, 1.0}, {1, 0, 0.0}, {1, 1, 1.0}};
+  Eigen::SparseMatrix<double> with_zero(2, 2);
+  with_zero.setFromTriplets(triplets.begin(), triplets.end());
+  const auto csc = osqp::calCSCMatrix(with_zero);
+  EXPECT_EQ(csc.row_idxs, (std::vector<c_int>{0, 1, 1}));
+  EXPECT_EQ(csc.col_idxs, (std::vector<c_int>{0, 2, 3}));
+
+  // the problem can be given as CSC matrices
+  osqp::OSQPInterface solver;
+  const Eigen::SparseMatrix<double> P = 2.0 * sparse;
+  Eigen::SparseMatrix<double> A(3, 3);
+  A.setIdentity();
+  std::vector<double> q(3, 1.0);
+  std::vector<double> l(3, -osqp::INF);
+  std::vector<double> u(3, osqp::INF);
+  EXPECT_EQ(
+    solver.updateProblem(osqp::calCSCMatrixTrapezoidal(P), osqp::calCSCMatrix(A), q, l, u), 0);
+  const auto result = solver.optimize();
+  EXPECT_EQ(std::get<3>(result), 1);
+}
+
 TEST(OSQPInterface, Exception)
 {
   constexpr int num_vars = 2;
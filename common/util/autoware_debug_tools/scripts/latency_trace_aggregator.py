@@ -0,0 +1,174 @@
+#! /usr/bin/env python3
+
+# Copyright 2021 Tier IV, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import argparse
+from collections import deque
+import sys
+
+from diagnostic_msgs.msg import DiagnosticStatus
+import rclpy
+from rclpy.node import Node
+
+PLANNING_STAGES = [
+    "/planning/scenario_planning/lane_driving/behavior_planning/behavior_path_planner",
+    "/planning/scenario_planning/lane_driving/behavior_planning/behavior_velocity_planner",
+    "/planning/scenario_planning/lane_driving/motion_planning/obstacle_avoidance_planner",
+    "/planning/scenario_planning/lane_driving/motion_planning/obstacle_stop_planner",
+    "/planning/scenario_planning/motion_velocity_smoother",
+    "/planning/scenario_planning/scenario_selector",
+]
+
+
+def percentile(sorted_values, p):
+    if not sorted_values:
+        return float("nan")
+    idx = min(int(round(p / 100.0 * (len(sorted_values) - 1))), len(sorted_values) - 1)
+    return sorted_values[idx]
+
+
+class LatencyTraceAggregator(Node):
+    """
+    Link the records of autoware_utils::LatencyTracer of a chain of nodes.
+
+    A record of a stage is linked to the record of the previous stage whose output stamp is its
+    input stamp. When the last stage publishes, the whole chain is resolved and the time spent in
+    each stage (processing) and between the stages (waiting for the input) is accumulated.
+    """
+
+    def __init__(self, options):
+        super().__init__("latency_trace_aggregator")
+        self._options = options
+        self._stages = options.stages
+        # output stamp -> record, for the stages except the last one
+        self._records = [dict() for _ in self._stages]
+        self._record_stamps = [deque() for _ in self._stages]
+        self._processing_ms = [[] for _ in self._stages]
+        self._waiting_ms = [[] for _ in self._stages]
+        self._end_to_end_ms = []
+        self._broken_chain_num = 0
+
+        self._subs = []
+        for i, stage in enumerate(self._stages):
+            self._subs.append(
+                self.create_subscription(
+                    DiagnosticStatus,
+                    stage + "/debug/latency_trace",
+                    lambda msg, i=i: self._on_trace(i, msg),
+                    10,
+                )
+            )
+        self._timer = self.create_timer(options.period, self._on_timer)
+
+    @staticmethod
+    def _to_record(msg):
+        values = {kv.key: kv.value for kv in msg.values}
+        return {
+            "input_stamp": values["input_stamp"],
+            "output_stamp": values["output_stamp"],
+            "receive_time": float(values["receive_time"]),
+            "publish_time": float(values["publish_time"]),
+        }
+
+    def _on_trace(self, stage_idx, msg):
+        record = LatencyTraceAggregator._to_record(msg)
+        if stage_idx + 1 < len(self._stages):
+            # the stages keep the last records only, the chain is resolved within a few cycles
+            self._records[stage_idx][record["output_stamp"]] = record
+            self._record_stamps[stage_idx].append(record["output_stamp"])
+            if len(self._record_stamps[stage_idx]) > self._options.buffer_size:
+                old_stamp = self._record_stamps[stage_idx].popleft()
+                if old_stamp not in self._record_stamps[stage_idx]:
+                    self._records[stage_idx].pop(old_stamp, None)
+            return
+        self._resolve_chain(record)
+
+    def _resolve_chain(self, last_record):
+        chain = [last_record]
+        for stage_idx in reversed(range(len(self._stages) - 1)):
+            record = self._records[stage_idx].get(chain[-1]["input_stamp"])
+            if record is None:
+                self._broken_chain_num += 1
+                return
+            chain.append(record)
+        chain.reverse()
+
+        for stage_idx, record in enumerate(chain):
+            self._processing_ms[stage_idx].append(
+                (record["publish_time"] - record["receive_time"]) * 1e3
+            )
+            if stage_idx > 0:
+                self._waiting_ms[stage_idx].append(
+                    (record["receive_time"] - chain[stage_idx - 1]["publish_time"]) * 1e3
+                )
+        self._end_to_end_ms.append(
+            (last_record["publish_time"] - float(chain[0]["input_stamp"])) * 1e3
+        )
+
+    def _on_timer(self):
+        def to_row(name, values):
+            values = sorted(values)
+            return "{:<40} {:>7d} {:>9.2f} {:>9.2f} {:>9.2f} {:>9.2f}".format(
+                name[-40:],
+                len(values),
+                percentile(values, 50),
+                percentile(values, 90),
+                percentile(values, 99),
+                values[-1] if values else float("nan"),
+            )
+
+        lines = [
+            "{:<40} {:>7} {:>9} {:>9} {:>9} {:>9}".format(
+                "[ms]", "count", "p50", "p90", "p99", "max"
+            )
+        ]
+        for stage_idx, stage in enumerate(self._stages):
+            name = stage.split("/")[-1]
+            if stage_idx > 0:
+                lines.append(to_row("  (wait) " + name, self._waiting_ms[stage_idx]))
+            lines.append(to_row(name, self._processing_ms[stage_idx]))
+        lines.append(to_row("end to end", self._end_to_end_ms))
+        lines.append("broken chains: {}".format(self._broken_chain_num))
+        print("\n".join(lines) + "\n")
+
+
+def main(args):
+    parser = argparse.ArgumentParser(
+        description="percentiles of the latency of each stage of a chain of LatencyTracer"
+    )
+    parser.add_argument(
+        "--stages",
+        nargs="+",
+        default=PLANNING_STAGES,
+        help="fully qualified node names, in the order of the chain",
+    )
+    parser.add_argument("--period", type=float, default=5.0, help="print period [s]")
+    parser.add_argument(
+        "--buffer-size", type=int, default=100, help="records kept for each stage to link the chain"
+    )
+    ns = parser.parse_args(args)
+
+    rclpy.init()
+    node = LatencyTraceAggregator(ns)
+    try:
+        rclpy.spin(node)
+    except KeyboardInterrupt:
+        node._on_timer()
+    node.destroy_node()
+    rclpy.shutdown()
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
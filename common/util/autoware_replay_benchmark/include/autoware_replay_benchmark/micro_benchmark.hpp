@@ -0,0 +1,175 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_REPLAY_BENCHMARK__MICRO_BENCHMARK_HPP_
+#define AUTOWARE_REPLAY_BENCHMARK__MICRO_BENCHMARK_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware_replay_benchmark
+{
+/**
+ * @brief keep the compiler from optimizing away a value only computed for a benchmark
+ */
+template <class T>
+inline void doNotOptimize(const T & value)
+{
+  __asm__ __volatile__("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief Header-only harness of the benchmark executables of the libraries. Each benchmark is a
+ * function called repeatedly in batches of at least min_sample_time, until min_time has passed.
+ * The time per call of the batches is written as JSON, which compare_benchmark_reports.py compares
+ * with the report of another build.
+ *
+ * Command line: [--report <path>] [--min-time <s>] [--filter <substring of the names>]
+ */
+class MicroBenchmark
+{
+public:
+  MicroBenchmark(const std::string & suite, int argc, char ** argv) : suite_(suite)
+  {
+    for (int i = 1; i + 1 < argc; i += 2) {
+      const std::string key = argv[i];
+      if (key == "--report") {
+        report_path_ = argv[i + 1];
+      } else if (key == "--min-time") {
+        min_time_s_ = std::atof(argv[i + 1]);
+      } else if (key == "--filter") {
+        filter_ = argv[i + 1];
+      } else {
+        std::cerr << "unknown option " << key << std::endl;
+      }
+    }
+  }
+
+  /**
+   * @brief measure the time per call of func, which must not depend on the previous calls
+   */
+  template <class Func>
+  void run(const std::string & name, Func && func)
+  {
+    if (name.find(filter_) == std::string::npos) {
+      return;
+    }
+
+    // the first call warms up the caches and lazily initialized state
+    func();
+
+    // batch the calls of short functions so that the clock resolution doesn't matter
+    size_t batch_size = 1;
+    while (measureSeconds(func, batch_size) < min_sample_time_s_ && batch_size < (1U << 30)) {
+      batch_size *= 2;
+    }
+
+    Result result;
+    result.name = name;
+    double elapsed_s = 0.0;
+    while (elapsed_s < min_time_s_ || result.samples_us.size() < min_samples_) {
+      const double sample_s = measureSeconds(func, batch_size);
+      result.samples_us.push_back(sample_s * 1e6 / batch_size);
+      elapsed_s += sample_s;
+    }
+    result.iterations = result.samples_us.size() * batch_size;
+
+    std::sort(result.samples_us.begin(), result.samples_us.end());
+    std::fprintf(
+      stderr, "%-56s %10.3f us (p50) %10.3f us (p99) %10zu calls\n", name.c_str(),
+      percentile(result.samples_us, 0.50), percentile(result.samples_us, 0.99), result.iterations);
+    results_.push_back(std::move(result));
+  }
+
+  /**
+   * @brief write the report to the report path, or stdout if it is empty
+   * @return exit code of the executable
+   */
+  int finish() const
+  {
+    std::ostringstream oss;
+    oss << "{\n  \"suite\": \"" << suite_ << "\",\n  \"benchmarks\": {";
+    for (size_t i = 0; i < results_.size(); ++i) {
+      const auto & samples = results_.at(i).samples_us;
+      const double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+      oss << (i == 0 ? "\n" : ",\n") << "    \"" << results_.at(i).name
+          << "\": {\"samples\": " << samples.size()
+          << ", \"iterations\": " << results_.at(i).iterations << ", \"time_us\": {\"mean\": "
+          << mean << ", \"p50\": " << percentile(samples, 0.50)
+          << ", \"p90\": " << percentile(samples, 0.90)
+          << ", \"p99\": " << percentile(samples, 0.99) << ", \"max\": " << samples.back()
+          << "}}";
+    }
+    oss << "\n  }\n}\n";
+
+    if (report_path_.empty()) {
+      std::cout << oss.str();
+      return 0;
+    }
+    std::ofstream ofs(report_path_);
+    ofs << oss.str();
+    if (!ofs) {
+      std::cerr << "failed to write " << report_path_ << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+
+private:
+  struct Result
+  {
+    std::string name;
+    std::vector<double> samples_us;  //!< @brief time per call of each batch
+    size_t iterations = 0;
+  };
+
+  std::string suite_;
+  std::string report_path_;
+  std::string filter_;
+  double min_time_s_ = 0.5;
+  double min_sample_time_s_ = 1e-3;
+  size_t min_samples_ = 10;
+  std::vector<Result> results_;
+
+  template <class Func>
+  static double measureSeconds(Func && func, const size_t batch_size)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < batch_size; ++i) {
+      func();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+  }
+
+  // Nearest-rank percentile of sorted samples, same as the replay benchmark
+  static double percentile(const std::vector<double> & sorted, const double p)
+  {
+    const size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted.at(std::max<size_t>(rank, 1) - 1);
+  }
+};
+}  // namespace autoware_replay_benchmark
+
+#endif  // AUTOWARE_REPLAY_BENCHMARK__MICRO_BENCHMARK_HPP_
@@ -0,0 +1,121 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_REPLAY_BENCHMARK__REPLAY_BENCHMARK_HPP_
+#define AUTOWARE_REPLAY_BENCHMARK__REPLAY_BENCHMARK_HPP_
+
+#include <class_loader/class_loader.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp_components/node_factory.hpp>
+#include <rosbag2_cpp/reader.hpp>
+
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+#include <rosgraph_msgs/msg/clock.hpp>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace autoware_replay_benchmark
+{
+/**
+ * @brief samples of a duration and their summary
+ */
+class LatencyStatistics
+{
+public:
+  void add(const double latency_ms) { samples_ms_.push_back(latency_ms); }
+  size_t size() const { return samples_ms_.size(); }
+
+  /**
+   * @brief JSON object with count, mean, percentiles, max and a histogram on fixed bucket bounds
+   */
+  std::string toJson() const;
+
+private:
+  std::vector<double> samples_ms_;
+};
+
+/**
+ * @brief Loads a component in-process, replays a bag to it on a single thread and reports the
+ * latency of its outputs, the execution time of its callbacks, the throughput and the peak RSS.
+ */
+class ReplayBenchmark : public rclcpp::Node
+{
+public:
+  explicit ReplayBenchmark(const rclcpp::NodeOptions & node_options);
+
+  /**
+   * @brief replay the whole bag and write the report
+   * @return false if the component or the bag could not be opened
+   */
+  bool run();
+
+private:
+  struct OutputTopic
+  {
+    rclcpp::GenericSubscription::SharedPtr sub;
+    size_t count = 0;
+    bool is_received = false;  //!< @brief received since the latest trigger message
+    LatencyStatistics latency;
+  };
+
+  /* Parameters */
+  std::string bag_path_;
+  std::string storage_id_;
+  std::string component_package_;
+  std::string component_plugin_;
+  std::vector<std::string> component_arguments_;
+  std::string trigger_topic_;
+  std::vector<std::string> output_topics_;
+  double rate_;  //!< @brief playback rate, non-positive to replay as fast as the component runs
+  double output_timeout_;
+  double discovery_wait_;
+  std::vector<std::string> transient_local_topics_;
+  std::string report_path_;
+
+  /* Component, destroyed before its library is unloaded */
+  std::unique_ptr<class_loader::ClassLoader> class_loader_;
+  rclcpp_components::NodeInstanceWrapper component_;
+  rclcpp::executors::SingleThreadedExecutor executor_;
+
+  /* Replay */
+  rosbag2_cpp::Reader reader_;
+  rclcpp::Publisher<rosgraph_msgs::msg::Clock>::SharedPtr pub_clock_;
+  std::map<std::string, rclcpp::GenericPublisher::SharedPtr> pub_topics_;
+  std::map<std::string, OutputTopic> output_topics_state_;
+  rclcpp::Subscription<diagnostic_msgs::msg::DiagnosticStatus>::SharedPtr sub_callback_timing_;
+  std::map<std::string, LatencyStatistics> callback_durations_;
+  std::chrono::steady_clock::time_point trigger_time_;
+  size_t num_triggers_ = 0;
+  size_t num_timeouts_ = 0;
+
+  bool loadComponent();
+  bool openBag();
+  void onOutput(const std::string & topic);
+  void onCallbackTiming(const diagnostic_msgs::msg::DiagnosticStatus::ConstSharedPtr msg);
+
+  /**
+   * @brief spin until every output topic has been received after the trigger message
+   * @return false on timeout
+   */
+  bool waitForOutputs();
+  void spinUntil(const std::chrono::steady_clock::time_point & time);
+  void writeReport(const double elapsed_s, const size_t num_messages) const;
+};
+}  // namespace autoware_replay_benchmark
+
+#endif  // AUTOWARE_REPLAY_BENCHMARK__REPLAY_BENCHMARK_HPP_
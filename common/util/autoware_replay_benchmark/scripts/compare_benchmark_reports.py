@@ -0,0 +1,85 @@
+#! /usr/bin/env python3
+
+# Copyright 2021 Tier IV, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import argparse
+import json
+import sys
+
+
+def load_report(path):
+    with open(path) as f:
+        return json.load(f)
+
+
+def collect_metrics(report, percentile):
+    """Flatten a benchmark report into (name, value, is_higher_better)."""
+    if "benchmarks" in report:
+        return [
+            (name + " " + percentile, benchmark["time_us"][percentile], False)
+            for name, benchmark in report["benchmarks"].items()
+        ]
+
+    metrics = [
+        ("throughput_hz", report["throughput_hz"], True),
+        ("peak_rss_kib", report["peak_rss_kib"], False),
+    ]
+    for topic, output in report["outputs"].items():
+        latency = output["latency_ms"]
+        if latency["count"] > 0:
+            metrics.append((topic + " latency " + percentile, latency[percentile], False))
+    for callback, duration in report["callbacks_ms"].items():
+        if duration["count"] > 0:
+            metrics.append((callback + " " + percentile, duration[percentile], False))
+    return metrics
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare two benchmark reports and fail on regressions."
+    )
+    parser.add_argument("baseline", help="report of the reference build")
+    parser.add_argument("current", help="report of the build under test")
+    parser.add_argument(
+        "--tolerance", type=float, default=0.1, help="allowed relative regression (default: 0.1)"
+    )
+    parser.add_argument(
+        "--percentile", choices=["p50", "p90", "p99", "max"], default="p99", help="latency to gate"
+    )
+    args = parser.parse_args()
+
+    baseline_metrics = collect_metrics(load_report(args.baseline), args.percentile)
+    current_metrics = collect_metrics(load_report(args.current), args.percentile)
+    baseline = {name: value for name, value, _ in baseline_metrics}
+
+    regressions = 0
+    for name, value, is_higher_better in current_metrics:
+        if name not in baseline or baseline[name] == 0:
+            print("{:<80} {:>12.3f} (new)".format(name, value))
+            continue
+        change = (value - baseline[name]) / baseline[name]
+        is_regression = change < -args.tolerance if is_higher_better else change > args.tolerance
+        regressions += is_regression
+        print(
+            "{:<80} {:>12.3f} {:>+8.1f}% {}".format(
+                name, value, change * 1e2, "REGRESSION" if is_regression else ""
+            )
+        )
+
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
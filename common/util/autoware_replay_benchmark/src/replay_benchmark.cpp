@@ -0,0 +1,390 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_replay_benchmark/replay_benchmark.hpp"
+
+#include <ament_index_cpp/get_resource.hpp>
+#include <rosbag2_cpp/converter_options.hpp>
+#include <rosbag2_storage/storage_options.hpp>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Upper bounds of the histogram buckets, the last bucket counts the rest
+const std::vector<double> histogram_bounds_ms = {0.1, 0.2, 0.5, 1.0,   2.0,   5.0,   10.0,
+                                                 20.0, 50.0, 100.0, 200.0, 500.0, 1000.0};
+
+std::vector<std::string> split(const std::string & str, const char delimiter)
+{
+  std::vector<std::string> tokens;
+  std::istringstream iss(str);
+  std::string token;
+  while (std::getline(iss, token, delimiter)) {
+    tokens.push_back(token);
+  }
+  return tokens;
+}
+
+double toSeconds(const struct timeval & tv) { return tv.tv_sec + tv.tv_usec * 1e-6; }
+}  // namespace
+
+namespace autoware_replay_benchmark
+{
+std::string LatencyStatistics::toJson() const
+{
+  std::ostringstream oss;
+  oss << "{\"count\": " << samples_ms_.size();
+  if (samples_ms_.empty()) {
+    oss << "}";
+    return oss.str();
+  }
+
+  std::vector<double> sorted = samples_ms_;
+  std::sort(sorted.begin(), sorted.end());
+  // Nearest-rank percentile
+  const auto percentile = [&sorted](const double p) {
+    const size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted.at(std::max<size_t>(rank, 1) - 1);
+  };
+  const double mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+
+  std::vector<size_t> counts(histogram_bounds_ms.size() + 1, 0);
+  for (const auto sample : sorted) {
+    const auto itr =
+      std::lower_bound(histogram_bounds_ms.begin(), histogram_bounds_ms.end(), sample);
+    ++counts.at(std::distance(histogram_bounds_ms.begin(), itr));
+  }
+
+  oss << ", \"mean\": " << mean << ", \"p50\": " << percentile(0.50)
+      << ", \"p90\": " << percentile(0.90) << ", \"p99\": " << percentile(0.99)
+      << ", \"max\": " << sorted.back() << ", \"histogram\": {\"bounds\": [";
+  for (size_t i = 0; i < histogram_bounds_ms.size(); ++i) {
+    oss << (i == 0 ? "" : ", ") << histogram_bounds_ms.at(i);
+  }
+  oss << "], \"counts\": [";
+  for (size_t i = 0; i < counts.size(); ++i) {
+    oss << (i == 0 ? "" : ", ") << counts.at(i);
+  }
+  oss << "]}}";
+  return oss.str();
+}
+
+ReplayBenchmark::ReplayBenchmark(const rclcpp::NodeOptions & node_options)
+: Node("replay_benchmark", node_options)
+{
+  bag_path_ = declare_parameter("bag_path", std::string(""));
+  storage_id_ = declare_parameter("storage_id", std::string("sqlite3"));
+  component_package_ = declare_parameter("component_package", std::string(""));
+  component_plugin_ = declare_parameter("component_plugin", std::string(""));
+  component_arguments_ =
+    declare_parameter("component_arguments", std::vector<std::string>{"--ros-args"});
+  trigger_topic_ = declare_parameter("trigger_topic", std::string(""));
+  output_topics_ = declare_parameter("output_topics", std::vector<std::string>{});
+  rate_ = declare_parameter("rate", 0.0);
+  output_timeout_ = declare_parameter("output_timeout", 1.0);
+  discovery_wait_ = declare_parameter("discovery_wait", 1.0);
+  transient_local_topics_ =
+    declare_parameter("transient_local_topics", std::vector<std::string>{"/tf_static"});
+  report_path_ = declare_parameter("report_path", std::string(""));
+
+  pub_clock_ = create_publisher<rosgraph_msgs::msg::Clock>("/clock", rclcpp::QoS(1));
+  sub_callback_timing_ = create_subscription<diagnostic_msgs::msg::DiagnosticStatus>(
+    "/system/callback_timing", rclcpp::QoS(100),
+    std::bind(&ReplayBenchmark::onCallbackTiming, this, std::placeholders::_1));
+}
+
+bool ReplayBenchmark::run()
+{
+  if (!loadComponent() || !openBag()) {
+    return false;
+  }
+  executor_.add_node(component_.get_node_base_interface());
+  executor_.add_node(get_node_base_interface());
+
+  // Let the publishers of the bag topics match the subscriptions of the component
+  spinUntil(
+    std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::duration<double>(discovery_wait_)));
+
+  for (const auto & topic : output_topics_) {
+    const auto infos = get_publishers_info_by_topic(topic);
+    if (infos.empty()) {
+      RCLCPP_ERROR(get_logger(), "no publisher of the output topic %s", topic.c_str());
+      return false;
+    }
+    rclcpp::QoS qos(10);
+    qos.reliability(infos.front().qos_profile().get_rmw_qos_profile().reliability);
+    output_topics_state_[topic].sub = create_generic_subscription(
+      topic, infos.front().topic_type(), qos,
+      [this, topic](std::shared_ptr<rclcpp::SerializedMessage>) { onOutput(topic); });
+  }
+
+  size_t num_messages = 0;
+  rcutils_time_point_value_t first_bag_time = 0;
+  const auto start_time = std::chrono::steady_clock::now();
+  while (rclcpp::ok() && reader_.has_next()) {
+    const auto msg = reader_.read_next();
+    const auto itr = pub_topics_.find(msg->topic_name);
+    if (itr == pub_topics_.end()) {
+      continue;
+    }
+
+    if (num_messages == 0) {
+      first_bag_time = msg->time_stamp;
+    }
+    if (rate_ > 0.0) {
+      spinUntil(
+        start_time + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::nanoseconds(msg->time_stamp - first_bag_time) / rate_));
+    }
+
+    rosgraph_msgs::msg::Clock clock;
+    clock.clock = rclcpp::Time(msg->time_stamp);
+    pub_clock_->publish(clock);
+
+    const bool is_trigger = msg->topic_name == trigger_topic_;
+    if (is_trigger) {
+      for (auto & output_topic : output_topics_state_) {
+        output_topic.second.is_received = false;
+      }
+      trigger_time_ = std::chrono::steady_clock::now();
+      ++num_triggers_;
+    }
+
+    itr->second->publish(msg->serialized_data);
+    ++num_messages;
+
+    if (is_trigger && rate_ <= 0.0) {
+      if (!waitForOutputs()) {
+        ++num_timeouts_;
+      }
+    } else {
+      executor_.spin_some();
+    }
+  }
+  const double elapsed_s =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+  // Outputs of the last messages
+  waitForOutputs();
+
+  writeReport(elapsed_s, num_messages);
+  return true;
+}
+
+bool ReplayBenchmark::loadComponent()
+{
+  std::string content;
+  std::string base_path;
+  if (!ament_index_cpp::get_resource(
+        "rclcpp_components", component_package_, content, &base_path)) {
+    RCLCPP_ERROR(get_logger(), "package %s has no components", component_package_.c_str());
+    return false;
+  }
+
+  // Each line is "<plugin>;<library path>"
+  std::string library_path;
+  for (const auto & line : split(content, '\n')) {
+    const auto parts = split(line, ';');
+    if (parts.size() == 2 && parts.at(0) == component_plugin_) {
+      library_path = parts.at(1);
+      if (!library_path.empty() && library_path.front() != '/') {
+        library_path = base_path + "/" + library_path;
+      }
+      break;
+    }
+  }
+  if (library_path.empty()) {
+    RCLCPP_ERROR(
+      get_logger(), "component %s is not found in %s", component_plugin_.c_str(),
+      component_package_.c_str());
+    return false;
+  }
+
+  try {
+    class_loader_ = std::make_unique<class_loader::ClassLoader>(library_path);
+    const auto factory = class_loader_->createInstance<rclcpp_components::NodeFactory>(
+      "rclcpp_components::NodeFactoryTemplate<" + component_plugin_ + ">");
+
+    // The arguments of the benchmark are not forwarded, the component runs on the bag time
+    std::vector<std::string> arguments = component_arguments_;
+    arguments.insert(arguments.end(), {"-p", "use_sim_time:=true"});
+    const auto options =
+      rclcpp::NodeOptions().use_global_arguments(false).arguments(arguments);
+    component_ = factory->create_node_instance(options);
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR(get_logger(), "failed to load %s: %s", component_plugin_.c_str(), e.what());
+    return false;
+  }
+  return true;
+}
+
+bool ReplayBenchmark::openBag()
+{
+  rosbag2_storage::StorageOptions storage_options;
+  storage_options.uri = bag_path_;
+  storage_options.storage_id = storage_id_;
+  rosbag2_cpp::ConverterOptions converter_options;
+  converter_options.input_serialization_format = "cdr";
+  converter_options.output_serialization_format = "cdr";
+  try {
+    reader_.open(storage_options, converter_options);
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR(get_logger(), "failed to open %s: %s", bag_path_.c_str(), e.what());
+    return false;
+  }
+
+  for (const auto & topic : reader_.get_all_topics_and_types()) {
+    // The clock is driven by the bag itself, and the recorded outputs would be mistaken for the
+    // outputs of the component
+    const bool is_output =
+      std::find(output_topics_.begin(), output_topics_.end(), topic.name) != output_topics_.end();
+    if (topic.name == "/clock" || is_output) {
+      continue;
+    }
+    rclcpp::QoS qos(10);
+    if (
+      std::find(transient_local_topics_.begin(), transient_local_topics_.end(), topic.name) !=
+      transient_local_topics_.end()) {
+      qos.keep_last(100).transient_local();
+    }
+    pub_topics_[topic.name] = create_generic_publisher(topic.name, topic.type, qos);
+  }
+
+  if (pub_topics_.count(trigger_topic_) == 0) {
+    RCLCPP_ERROR(get_logger(), "trigger topic %s is not in the bag", trigger_topic_.c_str());
+    return false;
+  }
+  return true;
+}
+
+void ReplayBenchmark::onOutput(const std::string & topic)
+{
+  auto & output_topic = output_topics_state_.at(topic);
+  ++output_topic.count;
+
+  // Only the first output after a trigger message is its response
+  if (!output_topic.is_received && num_triggers_ > 0) {
+    output_topic.is_received = true;
+    output_topic.latency.add(
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - trigger_time_)
+        .count());
+  }
+}
+
+void ReplayBenchmark::onCallbackTiming(
+  const diagnostic_msgs::msg::DiagnosticStatus::ConstSharedPtr msg)
+{
+  if (msg->name != component_.get_node_base_interface()->get_fully_qualified_name()) {
+    return;
+  }
+
+  for (const auto & value : msg->values) {
+    if (value.key == "pid" || value.key == "tids") {
+      continue;
+    }
+    std::istringstream iss(value.value);
+    double duration;
+    while (iss >> duration) {
+      callback_durations_[value.key].add(duration);
+    }
+  }
+}
+
+bool ReplayBenchmark::waitForOutputs()
+{
+  const auto is_all_received = [this]() {
+    return std::all_of(
+      output_topics_state_.begin(), output_topics_state_.end(),
+      [](const auto & output_topic) { return output_topic.second.is_received; });
+  };
+
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::duration<double>(output_timeout_));
+  while (rclcpp::ok() && !is_all_received()) {
+    const auto now = std::chrono::steady_clock::now();
+    if (deadline <= now) {
+      return false;
+    }
+    executor_.spin_once(deadline - now);
+  }
+  return true;
+}
+
+void ReplayBenchmark::spinUntil(const std::chrono::steady_clock::time_point & time)
+{
+  while (rclcpp::ok()) {
+    const auto now = std::chrono::steady_clock::now();
+    if (time <= now) {
+      return;
+    }
+    executor_.spin_once(time - now);
+  }
+}
+
+void ReplayBenchmark::writeReport(const double elapsed_s, const size_t num_messages) const
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+
+  std::ostringstream oss;
+  oss << "{\n";
+  oss << "  \"component\": \"" << component_plugin_ << "\",\n";
+  oss << "  \"bag\": \"" << bag_path_ << "\",\n";
+  oss << "  \"rate\": " << rate_ << ",\n";
+  oss << "  \"elapsed_s\": " << elapsed_s << ",\n";
+  oss << "  \"messages\": " << num_messages << ",\n";
+  oss << "  \"triggers\": " << num_triggers_ << ",\n";
+  oss << "  \"timeouts\": " << num_timeouts_ << ",\n";
+  oss << "  \"throughput_hz\": " << (elapsed_s > 0.0 ? num_triggers_ / elapsed_s : 0.0) << ",\n";
+  oss << "  \"peak_rss_kib\": " << usage.ru_maxrss << ",\n";
+  oss << "  \"cpu_time_s\": " << toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime) << ",\n";
+
+  oss << "  \"outputs\": {";
+  for (auto itr = output_topics_state_.begin(); itr != output_topics_state_.end(); ++itr) {
+    oss << (itr == output_topics_state_.begin() ? "\n" : ",\n");
+    oss << "    \"" << itr->first << "\": {\"count\": " << itr->second.count
+        << ", \"latency_ms\": " << itr->second.latency.toJson() << "}";
+  }
+  oss << "\n  },\n";
+
+  oss << "  \"callbacks_ms\": {";
+  for (auto itr = callback_durations_.begin(); itr != callback_durations_.end(); ++itr) {
+    oss << (itr == callback_durations_.begin() ? "\n" : ",\n");
+    oss << "    \"" << itr->first << "\": " << itr->second.toJson();
+  }
+  oss << "\n  }\n";
+  oss << "}\n";
+
+  if (report_path_.empty()) {
+    std::cout << oss.str();
+    return;
+  }
+  std::ofstream ofs(report_path_);
+  ofs << oss.str();
+  RCLCPP_INFO(get_logger(), "report is written to %s", report_path_.c_str());
+}
+}  // namespace autoware_replay_benchmark
@@ -1,4 +1,4 @@
-// Copyright 2015-2019 Autoware Foundation
+// Copyright 2021 Tier IV, Inc.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,7 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include "gyro_odometer/gyro_odometer_core.hpp"
+#include "autoware_replay_benchmark/replay_benchmark.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -21,9 +21,12 @@
 int main(int argc, char ** argv)
 {
   rclcpp::init(argc, argv);
-  auto node = std::make_shared<GyroOdometer>();
-  rclcpp::spin(node);
+  bool is_succeeded = false;
+  {
+    const auto node =
+      std::make_shared<autoware_replay_benchmark::ReplayBenchmark>(rclcpp::NodeOptions());
+    is_succeeded = node->run();
+  }
   rclcpp::shutdown();
-
-  return 0;
+  return is_succeeded ? 0 : 1;
 }
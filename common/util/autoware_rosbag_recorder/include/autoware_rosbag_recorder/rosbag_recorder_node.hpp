@@ -0,0 +1,145 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_ROSBAG_RECORDER__ROSBAG_RECORDER_NODE_HPP_
+#define AUTOWARE_ROSBAG_RECORDER__ROSBAG_RECORDER_NODE_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+#include <rosbag2_cpp/writer.hpp>
+#include <rosbag2_storage/serialized_bag_message.hpp>
+
+#include <autoware_system_msgs/msg/emergency_state_stamped.hpp>
+#include <autoware_vehicle_msgs/msg/control_mode.hpp>
+#include <std_srvs/srv/trigger.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace autoware_rosbag_recorder
+{
+struct TopicParam
+{
+  std::string topic;
+  double max_rate;  //!< @brief [Hz], non-positive to record all messages
+};
+
+struct NodeParam
+{
+  std::string output_dir;
+  std::string storage_id;
+  std::string compression_format;  //!< @brief empty not to compress
+  std::string compression_mode;    //!< @brief "file" or "message"
+  int compression_threads;
+  uint64_t max_bagfile_size;      //!< @brief [byte], 0 not to split by size
+  uint64_t max_bagfile_duration;  //!< @brief [s], 0 not to split by duration
+  int max_queue_size;             //!< @brief messages waiting for the writer thread
+  bool use_trigger;               //!< @brief record only around triggers instead of always
+  double pre_trigger_duration;    //!< @brief [s]
+  double post_trigger_duration;   //!< @brief [s]
+  bool trigger_on_emergency;
+  bool trigger_on_disengagement;
+};
+
+/**
+ * @brief Records topics into rosbag2 bags. The subscriptions only hand the serialized messages over
+ * to a writer thread, so that the disk and the compression never block the executor.
+ */
+class RosbagRecorderNode : public rclcpp::Node
+{
+public:
+  explicit RosbagRecorderNode(const rclcpp::NodeOptions & node_options);
+  ~RosbagRecorderNode();
+
+private:
+  struct TopicState
+  {
+    TopicParam param;
+    rclcpp::GenericSubscription::SharedPtr sub;
+    std::string type;
+    rclcpp::Time last_record_time;
+  };
+
+  /**
+   * @brief request to the writer thread, a bag is opened if uri is set and closed if msg is null
+   */
+  struct WriteRequest
+  {
+    std::shared_ptr<rosbag2_storage::SerializedBagMessage> msg;
+    std::string type;
+    std::string uri;
+  };
+
+  // Parameter
+  NodeParam node_param_;
+
+  // Subscriber
+  std::map<std::string, TopicState> topic_states_;
+  rclcpp::Subscription<autoware_system_msgs::msg::EmergencyStateStamped>::SharedPtr
+    sub_emergency_state_;
+  rclcpp::Subscription<autoware_vehicle_msgs::msg::ControlMode>::SharedPtr sub_control_mode_;
+
+  void onTopic(TopicState * topic_state, std::shared_ptr<rclcpp::SerializedMessage> msg);
+  void onEmergencyState(autoware_system_msgs::msg::EmergencyStateStamped::ConstSharedPtr msg);
+  void onControlMode(autoware_vehicle_msgs::msg::ControlMode::ConstSharedPtr msg);
+
+  uint8_t prev_emergency_state_;
+  uint8_t prev_control_mode_;
+
+  // Service
+  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr srv_trigger_;
+
+  void onTriggerService(
+    const std::shared_ptr<std_srvs::srv::Trigger::Request> request,
+    const std::shared_ptr<std_srvs::srv::Trigger::Response> response);
+
+  // Timer
+  rclcpp::TimerBase::SharedPtr timer_;
+
+  void onTimer();
+  void subscribeTopics();
+
+  // Trigger
+  std::deque<WriteRequest> pre_trigger_buffer_;
+  bool is_recording_;
+  rclcpp::Time recording_end_time_;
+
+  void trigger(const std::string & reason);
+
+  // Writer thread
+  std::thread writer_thread_;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::deque<WriteRequest> write_queue_;
+  bool is_stopping_;
+  size_t num_dropped_;
+
+  /**
+   * @brief pass a request to the writer thread, dropped if the queue is full unless forced
+   */
+  void enqueue(WriteRequest && request, const bool force = false);
+  std::string createBagUri(const std::string & suffix) const;
+  void runWriter();
+  std::unique_ptr<rosbag2_cpp::Writer> openWriter(const std::string & uri) const;
+};
+}  // namespace autoware_rosbag_recorder
+
+#endif  // AUTOWARE_ROSBAG_RECORDER__ROSBAG_RECORDER_NODE_HPP_
@@ -0,0 +1,374 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_rosbag_recorder/rosbag_recorder_node.hpp"
+
+#include <rosbag2_compression/compression_options.hpp>
+#include <rosbag2_compression/sequential_compression_writer.hpp>
+#include <rosbag2_cpp/converter_options.hpp>
+#include <rosbag2_storage/storage_options.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware_rosbag_recorder
+{
+RosbagRecorderNode::RosbagRecorderNode(const rclcpp::NodeOptions & node_options)
+: Node("rosbag_recorder", node_options),
+  prev_emergency_state_(autoware_system_msgs::msg::EmergencyState::NORMAL),
+  prev_control_mode_(autoware_vehicle_msgs::msg::ControlMode::MANUAL),
+  is_recording_(false),
+  recording_end_time_(0, 0, get_clock()->get_clock_type()),
+  is_stopping_(false),
+  num_dropped_(0)
+{
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+
+  // Parameter
+  node_param_.output_dir = declare_parameter("output_dir", std::string("rosbag"));
+  node_param_.storage_id = declare_parameter("storage_id", std::string("sqlite3"));
+  node_param_.compression_format = declare_parameter("compression_format", std::string("zstd"));
+  node_param_.compression_mode = declare_parameter("compression_mode", std::string("file"));
+  node_param_.compression_threads = declare_parameter("compression_threads", 1);
+  node_param_.max_bagfile_size = declare_parameter("max_bagfile_size", 0);
+  node_param_.max_bagfile_duration = declare_parameter("max_bagfile_duration", 60);
+  node_param_.max_queue_size = declare_parameter("max_queue_size", 1000);
+  node_param_.use_trigger = declare_parameter("use_trigger", false);
+  node_param_.pre_trigger_duration = declare_parameter("pre_trigger_duration", 30.0);
+  node_param_.post_trigger_duration = declare_parameter("post_trigger_duration", 30.0);
+  node_param_.trigger_on_emergency = declare_parameter("trigger_on_emergency", true);
+  node_param_.trigger_on_disengagement = declare_parameter("trigger_on_disengagement", true);
+
+  const auto topic_keys = declare_parameter<std::vector<std::string>>("topics");
+  for (const auto & topic_key : topic_keys) {
+    TopicParam param;
+    param.topic = declare_parameter<std::string>(topic_key + ".topic");
+    param.max_rate = declare_parameter(topic_key + ".max_rate", 0.0);
+
+    auto & topic_state = topic_states_[param.topic];
+    topic_state.param = param;
+    topic_state.last_record_time = rclcpp::Time(0, 0, get_clock()->get_clock_type());
+  }
+
+  // Subscriber
+  if (node_param_.use_trigger && node_param_.trigger_on_emergency) {
+    sub_emergency_state_ = create_subscription<autoware_system_msgs::msg::EmergencyStateStamped>(
+      "~/input/emergency_state", rclcpp::QoS{1},
+      std::bind(&RosbagRecorderNode::onEmergencyState, this, _1));
+  }
+  if (node_param_.use_trigger && node_param_.trigger_on_disengagement) {
+    sub_control_mode_ = create_subscription<autoware_vehicle_msgs::msg::ControlMode>(
+      "~/input/control_mode", rclcpp::QoS{1},
+      std::bind(&RosbagRecorderNode::onControlMode, this, _1));
+  }
+
+  // Service
+  srv_trigger_ = create_service<std_srvs::srv::Trigger>(
+    "~/service/trigger", std::bind(&RosbagRecorderNode::onTriggerService, this, _1, _2));
+
+  // Writer thread
+  writer_thread_ = std::thread(&RosbagRecorderNode::runWriter, this);
+  if (!node_param_.use_trigger) {
+    enqueue({nullptr, "", createBagUri("")}, true);
+  }
+
+  // Timer
+  auto timer_callback = std::bind(&RosbagRecorderNode::onTimer, this);
+  auto period = std::chrono::milliseconds(100);
+  timer_ = std::make_shared<rclcpp::GenericTimer<decltype(timer_callback)>>(
+    this->get_clock(), period, std::move(timer_callback),
+    this->get_node_base_interface()->get_context());
+  this->get_node_timers_interface()->add_timer(timer_, nullptr);
+
+  subscribeTopics();
+}
+
+RosbagRecorderNode::~RosbagRecorderNode()
+{
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    is_stopping_ = true;
+  }
+  queue_cv_.notify_all();
+  // The queued messages are written before the bag is closed
+  writer_thread_.join();
+}
+
+void RosbagRecorderNode::onTopic(
+  TopicState * topic_state, std::shared_ptr<rclcpp::SerializedMessage> msg)
+{
+  const auto now = this->now();
+
+  // Decimation
+  if (topic_state->param.max_rate > 0.0) {
+    if ((now - topic_state->last_record_time).seconds() < 1.0 / topic_state->param.max_rate) {
+      return;
+    }
+  }
+  topic_state->last_record_time = now;
+
+  // Take over the buffer of the message instead of copying it
+  WriteRequest request;
+  request.type = topic_state->type;
+  request.msg = std::make_shared<rosbag2_storage::SerializedBagMessage>();
+  request.msg->topic_name = topic_state->param.topic;
+  request.msg->time_stamp = now.nanoseconds();
+  request.msg->serialized_data = std::shared_ptr<rcutils_uint8_array_t>(
+    new rcutils_uint8_array_t(msg->release_rcl_serialized_message()),
+    [](rcutils_uint8_array_t * data) {
+      rcutils_uint8_array_fini(data);
+      delete data;
+    });
+
+  if (!node_param_.use_trigger || is_recording_) {
+    enqueue(std::move(request));
+    return;
+  }
+
+  // Keep the latest messages until a trigger
+  pre_trigger_buffer_.push_back(std::move(request));
+  const auto oldest_time = now.nanoseconds() - static_cast<rcutils_time_point_value_t>(
+                                                  node_param_.pre_trigger_duration * 1e9);
+  while (!pre_trigger_buffer_.empty() &&
+         pre_trigger_buffer_.front().msg->time_stamp < oldest_time) {
+    pre_trigger_buffer_.pop_front();
+  }
+}
+
+void RosbagRecorderNode::onEmergencyState(
+  autoware_system_msgs::msg::EmergencyStateStamped::ConstSharedPtr msg)
+{
+  using autoware_system_msgs::msg::EmergencyState;
+
+  const auto state = msg->state.state;
+  if (state == EmergencyState::MRM_OPERATING && prev_emergency_state_ != state) {
+    trigger("emergency");
+  }
+  prev_emergency_state_ = state;
+}
+
+void RosbagRecorderNode::onControlMode(autoware_vehicle_msgs::msg::ControlMode::ConstSharedPtr msg)
+{
+  using autoware_vehicle_msgs::msg::ControlMode;
+
+  if (prev_control_mode_ == ControlMode::AUTO && msg->data != ControlMode::AUTO) {
+    trigger("disengagement");
+  }
+  prev_control_mode_ = msg->data;
+}
+
+void RosbagRecorderNode::onTriggerService(
+  const std::shared_ptr<std_srvs::srv::Trigger::Request> /*request*/,
+  const std::shared_ptr<std_srvs::srv::Trigger::Response> response)
+{
+  if (!node_param_.use_trigger) {
+    response->success = false;
+    response->message = "always recording";
+    return;
+  }
+
+  trigger("manual");
+  response->success = true;
+}
+
+void RosbagRecorderNode::onTimer()
+{
+  subscribeTopics();
+
+  if (is_recording_ && recording_end_time_ <= this->now()) {
+    is_recording_ = false;
+    enqueue({nullptr, "", ""}, true);
+    RCLCPP_INFO(get_logger(), "stop recording");
+  }
+
+  size_t num_dropped;
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    num_dropped = num_dropped_;
+  }
+  if (num_dropped > 0) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 5000, "%zu messages are dropped since the writer is behind",
+      num_dropped);
+  }
+}
+
+void RosbagRecorderNode::subscribeTopics()
+{
+  for (auto & topic_state : topic_states_) {
+    if (topic_state.second.sub) {
+      continue;
+    }
+
+    const auto infos = get_publishers_info_by_topic(topic_state.first);
+    if (infos.empty()) {
+      continue;
+    }
+
+    // Match the publishers so that no message is lost and latched messages are recorded
+    const auto is_all = [&infos](const auto & predicate) {
+      return std::all_of(infos.begin(), infos.end(), predicate);
+    };
+    rclcpp::QoS qos{100};
+    if (!is_all([](const rclcpp::TopicEndpointInfo & info) {
+          return info.qos_profile().get_rmw_qos_profile().reliability ==
+                 RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+        })) {
+      qos.best_effort();
+    }
+    if (is_all([](const rclcpp::TopicEndpointInfo & info) {
+          return info.qos_profile().get_rmw_qos_profile().durability ==
+                 RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL;
+        })) {
+      qos.transient_local();
+    }
+
+    auto * topic_state_ptr = &topic_state.second;
+    topic_state_ptr->type = infos.front().topic_type();
+    topic_state_ptr->sub = create_generic_subscription(
+      topic_state.first, topic_state_ptr->type, qos,
+      [this, topic_state_ptr](std::shared_ptr<rclcpp::SerializedMessage> msg) {
+        onTopic(topic_state_ptr, msg);
+      });
+    RCLCPP_INFO(get_logger(), "subscribed %s", topic_state.first.c_str());
+  }
+}
+
+void RosbagRecorderNode::trigger(const std::string & reason)
+{
+  recording_end_time_ =
+    this->now() + rclcpp::Duration::from_seconds(node_param_.post_trigger_duration);
+  if (is_recording_) {
+    RCLCPP_INFO(get_logger(), "recording is extended by %s", reason.c_str());
+    return;
+  }
+
+  RCLCPP_INFO(get_logger(), "start recording by %s", reason.c_str());
+  is_recording_ = true;
+  enqueue({nullptr, "", createBagUri(reason)}, true);
+  for (auto & request : pre_trigger_buffer_) {
+    enqueue(std::move(request), true);
+  }
+  pre_trigger_buffer_.clear();
+}
+
+void RosbagRecorderNode::enqueue(WriteRequest && request, const bool force)
+{
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (!force && write_queue_.size() >= static_cast<size_t>(node_param_.max_queue_size)) {
+      ++num_dropped_;
+      return;
+    }
+    write_queue_.push_back(std::move(request));
+  }
+  queue_cv_.notify_one();
+}
+
+std::string RosbagRecorderNode::createBagUri(const std::string & suffix) const
+{
+  const auto time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  struct tm local_time;
+  localtime_r(&time, &local_time);
+
+  std::ostringstream oss;
+  oss << node_param_.output_dir << "/" << std::put_time(&local_time, "%Y%m%d-%H%M%S");
+  if (!suffix.empty()) {
+    oss << "_" << suffix;
+  }
+  return oss.str();
+}
+
+void RosbagRecorderNode::runWriter()
+{
+  std::unique_ptr<rosbag2_cpp::Writer> writer;
+  std::set<std::string> created_topics;
+
+  while (true) {
+    WriteRequest request;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [this]() { return is_stopping_ || !write_queue_.empty(); });
+      if (write_queue_.empty()) {
+        break;
+      }
+      request = std::move(write_queue_.front());
+      write_queue_.pop_front();
+    }
+
+    try {
+      if (!request.uri.empty()) {
+        writer = openWriter(request.uri);
+        created_topics.clear();
+        RCLCPP_INFO(get_logger(), "opened %s", request.uri.c_str());
+      } else if (!request.msg) {
+        // Finishes the compression of the last file as well
+        writer.reset();
+      } else if (writer) {
+        if (created_topics.insert(request.msg->topic_name).second) {
+          writer->create_topic({request.msg->topic_name, request.type, "cdr", ""});
+        }
+        writer->write(request.msg);
+      }
+    } catch (const std::exception & e) {
+      RCLCPP_ERROR(get_logger(), "failed to write the bag: %s", e.what());
+      writer.reset();
+    }
+  }
+}
+
+std::unique_ptr<rosbag2_cpp::Writer> RosbagRecorderNode::openWriter(const std::string & uri) const
+{
+  rosbag2_storage::StorageOptions storage_options;
+  storage_options.uri = uri;
+  storage_options.storage_id = node_param_.storage_id;
+  storage_options.max_bagfile_size = node_param_.max_bagfile_size;
+  storage_options.max_bagfile_duration = node_param_.max_bagfile_duration;
+
+  rosbag2_cpp::ConverterOptions converter_options;
+  converter_options.input_serialization_format = "cdr";
+  converter_options.output_serialization_format = "cdr";
+
+  std::unique_ptr<rosbag2_cpp::Writer> writer;
+  if (node_param_.compression_format.empty()) {
+    writer = std::make_unique<rosbag2_cpp::Writer>();
+  } else {
+    // Files or messages are compressed by the threads of the writer
+    std::string compression_mode = node_param_.compression_mode;
+    std::transform(
+      compression_mode.begin(), compression_mode.end(), compression_mode.begin(), ::toupper);
+    rosbag2_compression::CompressionOptions compression_options;
+    compression_options.compression_format = node_param_.compression_format;
+    compression_options.compression_mode =
+      rosbag2_compression::compression_mode_from_string(compression_mode);
+    compression_options.compression_threads = node_param_.compression_threads;
+    writer = std::make_unique<rosbag2_cpp::Writer>(
+      std::make_unique<rosbag2_compression::SequentialCompressionWriter>(compression_options));
+  }
+  writer->open(storage_options, converter_options);
+  return writer;
+}
+}  // namespace autoware_rosbag_recorder
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(autoware_rosbag_recorder::RosbagRecorderNode)
@@ -0,0 +1,166 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the trajectory functions as a planner uses them in a cycle, on the message points and
+// on PointSpan2d and ArcLengthTable, and the collision check of a swept footprint against a
+// pointcloud.
+
+#include "autoware_utils/geometry/point_grid.hpp"
+#include "autoware_utils/geometry/swept_footprint.hpp"
+#include "autoware_utils/trajectory/arc_length_table.hpp"
+#include "autoware_utils/trajectory/point_span.hpp"
+#include "autoware_utils/trajectory/trajectory.hpp"
+
+#include <autoware_replay_benchmark/micro_benchmark.hpp>
+
+#include <autoware_planning_msgs/msg/trajectory.hpp>
+
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr size_t NUM_TARGETS = 20;
+
+struct Point
+{
+  double x;
+  double y;
+};
+
+autoware_planning_msgs::msg::Trajectory createTrajectory(
+  const size_t num_points, const double interval)
+{
+  autoware_planning_msgs::msg::Trajectory traj;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = i * interval * 1e-3;
+    autoware_planning_msgs::msg::TrajectoryPoint p;
+    p.pose.position = autoware_utils::createPoint(
+      i * interval * std::cos(theta), i * interval * std::sin(theta), 0.0);
+    p.pose.orientation = autoware_utils::createQuaternionFromYaw(2.0 * theta);
+    traj.points.push_back(p);
+  }
+  return traj;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  using autoware_replay_benchmark::doNotOptimize;
+  autoware_replay_benchmark::MicroBenchmark benchmark("autoware_utils", argc, argv);
+
+  for (const size_t num_points : {200, 1000}) {
+    const auto traj = createTrajectory(num_points, 1.0);
+    const std::string suffix = "/N=" + std::to_string(num_points);
+
+    const auto & ego = traj.points.at(num_points / 3).pose.position;
+    const auto ego_msg = autoware_utils::createPoint(ego.x + 0.2, ego.y + 0.1, 0.0);
+    std::vector<geometry_msgs::msg::Point> targets;
+    for (size_t i = 0; i < NUM_TARGETS; ++i) {
+      const auto & p = traj.points.at((i + 1) * num_points / (NUM_TARGETS + 1)).pose.position;
+      targets.push_back(autoware_utils::createPoint(p.x + 0.3, p.y - 0.2, 0.0));
+    }
+
+    // message points, as the planners use them today
+    benchmark.run("trajectory/messages" + suffix, [&]() {
+      doNotOptimize(autoware_utils::findNearestIndex(traj.points, ego_msg));
+      doNotOptimize(autoware_utils::calcArcLength(traj.points));
+      for (const auto & target : targets) {
+        doNotOptimize(autoware_utils::calcSignedArcLength(traj.points, ego_msg, target));
+      }
+    });
+
+    // points converted once per cycle, with the cumulative arc length
+    std::vector<autoware_utils::Point2d> points;
+    std::vector<double> arc_lengths;
+    const autoware_utils::Point2d ego_2d(ego_msg.x, ego_msg.y);
+    std::vector<autoware_utils::Point2d> targets_2d;
+    for (const auto & target : targets) {
+      targets_2d.emplace_back(target.x, target.y);
+    }
+    benchmark.run("trajectory/PointSpan2d" + suffix, [&]() {
+      autoware_utils::toPoint2dArray(traj.points, points);
+      autoware_utils::calcCumulativeArcLength(points, arc_lengths);
+      doNotOptimize(autoware_utils::findNearestIndex(points, ego_2d));
+      doNotOptimize(arc_lengths.back());
+      for (const auto & target : targets_2d) {
+        doNotOptimize(autoware_utils::calcSignedArcLength(points, arc_lengths, ego_2d, target));
+      }
+    });
+
+    // table built once per trajectory, queried from the nearest index of the previous cycle
+    const autoware_utils::ArcLengthTable table(traj.points);
+    const size_t ego_idx = num_points / 3;
+    benchmark.run("trajectory/ArcLengthTable" + suffix, [&]() {
+      const double ego_arc_length = table.calcArcLength(ego_2d, ego_idx);
+      for (const auto & target : targets_2d) {
+        doNotOptimize(table.calcArcLength(target) - ego_arc_length);
+      }
+    });
+  }
+
+  // footprint of a vehicle along 100 m of trajectory among the points of an urban pointcloud
+  const auto traj = createTrajectory(200, 0.5);
+  std::vector<geometry_msgs::msg::Pose> poses;
+  for (const auto & p : traj.points) {
+    poses.push_back(p.pose);
+  }
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> dist_x(-10.0, 110.0);
+  std::uniform_real_distribution<double> dist_y(-60.0, 60.0);
+  std::vector<Point> cloud(50000);
+  for (auto & p : cloud) {
+    p.x = dist_x(engine);
+    p.y = dist_y(engine);
+  }
+
+  benchmark.run("SweptFootprint/construct/poses=200", [&]() {
+    doNotOptimize(autoware_utils::SweptFootprint(poses, -1.0, 4.0, -1.0, 1.0));
+  });
+  benchmark.run("PointGrid2d/construct/points=50000", [&]() {
+    doNotOptimize(autoware_utils::PointGrid2d(cloud, 1.0));
+  });
+
+  const autoware_utils::SweptFootprint footprint(poses, -1.0, 4.0, -1.0, 1.0);
+  const autoware_utils::PointGrid2d grid(cloud, 1.0);
+  std::vector<size_t> indices;
+  benchmark.run("SweptFootprint/findPointsInStep/points=50000", [&]() {
+    for (size_t step = 0; step < footprint.size(); ++step) {
+      footprint.findPointsInStep(step, grid, indices);
+      doNotOptimize(indices);
+    }
+  });
+
+  // boost::geometry on the polygons of the steps over the points, without the grid
+  std::vector<autoware_utils::LinearRing2d> step_polygons;
+  for (size_t step = 0; step < footprint.size(); ++step) {
+    step_polygons.push_back(footprint.getStepPolygon(step));
+  }
+  const std::vector<Point> sub_cloud(cloud.begin(), cloud.begin() + 1000);
+  benchmark.run("boost_geometry/within/points=1000", [&]() {
+    for (const auto & polygon : step_polygons) {
+      size_t num_inside = 0;
+      for (const auto & p : sub_cloud) {
+        num_inside += boost::geometry::within(autoware_utils::Point2d(p.x, p.y), polygon);
+      }
+      doNotOptimize(num_inside);
+    }
+  });
+
+  return benchmark.finish();
+}
@@ -17,21 +17,28 @@
 
 #include "autoware_utils/geometry/boost_geometry.hpp"
 #include "autoware_utils/geometry/geometry.hpp"
+#include "autoware_utils/geometry/point_grid.hpp"
 #include "autoware_utils/geometry/pose_deviation.hpp"
+#include "autoware_utils/geometry/swept_footprint.hpp"
 #include "autoware_utils/math/constants.hpp"
 #include "autoware_utils/math/normalization.hpp"
 #include "autoware_utils/math/range.hpp"
 #include "autoware_utils/math/unit_conversion.hpp"
 #include "autoware_utils/planning/planning_marker_helper.hpp"
+#include "autoware_utils/ros/callback_timing_publisher.hpp"
 #include "autoware_utils/ros/debug_publisher.hpp"
 #include "autoware_utils/ros/debug_traits.hpp"
+#include "autoware_utils/ros/latency_tracer.hpp"
 #include "autoware_utils/ros/marker_helper.hpp"
 #include "autoware_utils/ros/processing_time_publisher.hpp"
 #include "autoware_utils/ros/self_pose_listener.hpp"
 #include "autoware_utils/ros/transform_listener.hpp"
 #include "autoware_utils/ros/update_param.hpp"
 #include "autoware_utils/ros/wait_for_param.hpp"
+#include "autoware_utils/system/realtime.hpp"
 #include "autoware_utils/system/stop_watch.hpp"
+#include "autoware_utils/trajectory/arc_length_table.hpp"
+#include "autoware_utils/trajectory/point_span.hpp"
 #include "autoware_utils/trajectory/trajectory.hpp"
 
 #endif  // AUTOWARE_UTILS__AUTOWARE_UTILS_HPP_
@@ -49,6 +49,18 @@ inline geometry_msgs::msg::Point getPoint(const geometry_msgs::msg::Point & p)
   return p;
 }
 
+template <>
+inline geometry_msgs::msg::Point getPoint(const Point2d & p)
+{
+  return geometry_msgs::build<geometry_msgs::msg::Point>().x(p.x()).y(p.y()).z(0.0);
+}
+
+template <>
+inline geometry_msgs::msg::Point getPoint(const Point3d & p)
+{
+  return geometry_msgs::build<geometry_msgs::msg::Point>().x(p.x()).y(p.y()).z(p.z());
+}
+
 template <>
 inline geometry_msgs::msg::Point getPoint(const geometry_msgs::msg::Pose & p)
 {
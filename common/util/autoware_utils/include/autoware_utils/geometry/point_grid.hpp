@@ -0,0 +1,138 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef AUTOWARE_UTILS__GEOMETRY__POINT_GRID_HPP_
+#define AUTOWARE_UTILS__GEOMETRY__POINT_GRID_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace autoware_utils
+{
+/**
+ * @brief xy grid of a pointcloud. The points are stored cell by cell, so that the points of a cell
+ * are contiguous in getX() and getY().
+ */
+class PointGrid2d
+{
+public:
+  /**
+   * @param points container of points with x and y members, e.g. pcl::PointCloud
+   * @param cell_size [m]
+   */
+  template <class PointContainer>
+  PointGrid2d(const PointContainer & points, const double cell_size) : cell_size_(cell_size)
+  {
+    std::vector<uint64_t> keys;
+    std::vector<size_t> valid_indices;
+    keys.reserve(points.size());
+    valid_indices.reserve(points.size());
+    size_t index = 0;
+    for (const auto & p : points) {
+      if (std::isfinite(p.x) && std::isfinite(p.y)) {
+        const uint64_t key = getKey(getCell(p.x), getCell(p.y));
+        keys.push_back(key);
+        valid_indices.push_back(index);
+        ++cells_[key].second;
+      }
+      ++index;
+    }
+
+    // the cell ranges, then the points in place
+    size_t begin = 0;
+    for (auto & cell : cells_) {
+      cell.second.first = begin;
+      begin += cell.second.second;
+      cell.second.second = cell.second.first;
+    }
+    xs_.resize(valid_indices.size());
+    ys_.resize(valid_indices.size());
+    indices_.resize(valid_indices.size());
+    index = 0;
+    size_t i = 0;
+    for (const auto & p : points) {
+      if (i < valid_indices.size() && valid_indices.at(i) == index) {
+        const size_t slot = cells_.at(keys.at(i)).second++;
+        xs_.at(slot) = p.x;
+        ys_.at(slot) = p.y;
+        indices_.at(slot) = index;
+        ++i;
+      }
+      ++index;
+    }
+  }
+
+  double getCellSize() const { return cell_size_; }
+  size_t size() const { return indices_.size(); }
+  const std::vector<double> & getX() const { return xs_; }
+  const std::vector<double> & getY() const { return ys_; }
+  /** @brief index in the input container of each stored point */
+  const std::vector<size_t> & getIndices() const { return indices_; }
+
+  /**
+   * @brief Call func(begin, end) with the range of stored points of each cell overlapping the box
+   */
+  template <class F>
+  void forEachCell(
+    const double min_x, const double min_y, const double max_x, const double max_y,
+    F && func) const
+  {
+    const int64_t max_cell_x = getCell(max_x);
+    const int64_t max_cell_y = getCell(max_y);
+    for (int64_t cell_x = getCell(min_x); cell_x <= max_cell_x; ++cell_x) {
+      for (int64_t cell_y = getCell(min_y); cell_y <= max_cell_y; ++cell_y) {
+        const auto itr = cells_.find(getKey(cell_x, cell_y));
+        if (itr != cells_.end()) {
+          func(itr->second.first, itr->second.second);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Input indices of the points in the cells overlapping the box, in ascending order
+   */
+  void query(
+    const double min_x, const double min_y, const double max_x, const double max_y,
+    std::vector<size_t> & indices) const
+  {
+    indices.clear();
+    forEachCell(min_x, min_y, max_x, max_y, [this, &indices](const size_t begin, const size_t end) {
+      indices.insert(indices.end(), indices_.begin() + begin, indices_.begin() + end);
+    });
+    std::sort(indices.begin(), indices.end());
+  }
+
+private:
+  int64_t getCell(const double x) const { return static_cast<int64_t>(std::floor(x / cell_size_)); }
+  static uint64_t getKey(const int64_t cell_x, const int64_t cell_y)
+  {
+    return (static_cast<uint64_t>(cell_x) << 32) ^ (static_cast<uint64_t>(cell_y) & 0xffffffff);
+  }
+
+  double cell_size_;
+  // begin and end of the points of a cell
+  std::unordered_map<uint64_t, std::pair<size_t, size_t>> cells_;
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+  std::vector<size_t> indices_;
+};
+}  // namespace autoware_utils
+
+#endif  // AUTOWARE_UTILS__GEOMETRY__POINT_GRID_HPP_
@@ -0,0 +1,278 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef AUTOWARE_UTILS__GEOMETRY__SWEPT_FOOTPRINT_HPP_
+#define AUTOWARE_UTILS__GEOMETRY__SWEPT_FOOTPRINT_HPP_
+
+#include "autoware_utils/geometry/boost_geometry.hpp"
+#include "autoware_utils/geometry/geometry.hpp"
+#include "autoware_utils/geometry/point_grid.hpp"
+
+#include <boost/optional.hpp>
+
+#include <geometry_msgs/msg/pose.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace autoware_utils
+{
+/**
+ * @brief Box of a footprint at a pose. The offsets are in the frame of the pose, e.g.
+ * -rear_overhang_m and max_longitudinal_offset_m for a vehicle at base_link.
+ */
+class OrientedBox2d
+{
+public:
+  OrientedBox2d(
+    const geometry_msgs::msg::Pose & pose, const double min_longitudinal_offset,
+    const double max_longitudinal_offset, const double min_lateral_offset,
+    const double max_lateral_offset)
+  : x_(pose.position.x),
+    y_(pose.position.y),
+    min_lon_(min_longitudinal_offset),
+    max_lon_(max_longitudinal_offset),
+    min_lat_(min_lateral_offset),
+    max_lat_(max_lateral_offset)
+  {
+    const double yaw = getRPY(pose).z;
+    cos_ = std::cos(yaw);
+    sin_ = std::sin(yaw);
+  }
+
+  /** @brief front left, front right, rear right and rear left corners */
+  std::array<Point2d, 4> getCorners() const
+  {
+    return {
+      toGlobal(max_lon_, max_lat_), toGlobal(max_lon_, min_lat_), toGlobal(min_lon_, min_lat_),
+      toGlobal(min_lon_, max_lat_)};
+  }
+
+  /** @brief squared distance from the point to the box, 0 inside */
+  double calcSquaredDistance(const double x, const double y) const
+  {
+    const double lon = cos_ * (x - x_) + sin_ * (y - y_);
+    const double lat = -sin_ * (x - x_) + cos_ * (y - y_);
+    const double d_lon = std::max({min_lon_ - lon, 0.0, lon - max_lon_});
+    const double d_lat = std::max({min_lat_ - lat, 0.0, lat - max_lat_});
+    return d_lon * d_lon + d_lat * d_lat;
+  }
+
+  bool contains(const double x, const double y) const { return calcSquaredDistance(x, y) == 0.0; }
+
+private:
+  Point2d toGlobal(const double lon, const double lat) const
+  {
+    return Point2d(x_ + cos_ * lon - sin_ * lat, y_ + sin_ * lon + cos_ * lat);
+  }
+
+  double x_;
+  double y_;
+  double cos_;
+  double sin_;
+  double min_lon_;
+  double max_lon_;
+  double min_lat_;
+  double max_lat_;
+};
+
+/**
+ * @brief Area swept by a footprint along a sequence of poses. The step i is the convex hull of
+ * the boxes at the poses i and i + 1, kept as the half planes of its edges so that the points of
+ * a grid cell are tested against it in tight loops.
+ */
+class SweptFootprint
+{
+public:
+  SweptFootprint(
+    const std::vector<geometry_msgs::msg::Pose> & poses, const double min_longitudinal_offset,
+    const double max_longitudinal_offset, const double min_lateral_offset,
+    const double max_lateral_offset)
+  {
+    if (poses.size() < 2) {
+      edge_begins_.push_back(0);
+      return;
+    }
+    std::vector<std::array<Point2d, 4>> corners;
+    corners.reserve(poses.size());
+    for (const auto & pose : poses) {
+      corners.push_back(OrientedBox2d(
+                          pose, min_longitudinal_offset, max_longitudinal_offset,
+                          min_lateral_offset, max_lateral_offset)
+                          .getCorners());
+    }
+
+    std::vector<Point2d> points;
+    std::vector<Point2d> hull;
+    edge_begins_.push_back(0);
+    for (size_t i = 0; i + 1 < corners.size(); ++i) {
+      points.assign(corners.at(i).begin(), corners.at(i).end());
+      points.insert(points.end(), corners.at(i + 1).begin(), corners.at(i + 1).end());
+      calcConvexHull(points, hull);
+
+      Box box;
+      box.min_x = box.min_y = std::numeric_limits<double>::max();
+      box.max_x = box.max_y = std::numeric_limits<double>::lowest();
+      for (size_t j = 0; j < hull.size(); ++j) {
+        const auto & p0 = hull.at(j);
+        const auto & p1 = hull.at((j + 1) % hull.size());
+        // left of the edge, as the hull is counter clockwise
+        a_.push_back(p0.y() - p1.y());
+        b_.push_back(p1.x() - p0.x());
+        c_.push_back(p0.x() * p1.y() - p1.x() * p0.y());
+        hull_x_.push_back(p0.x());
+        hull_y_.push_back(p0.y());
+        box.min_x = std::min(box.min_x, p0.x());
+        box.min_y = std::min(box.min_y, p0.y());
+        box.max_x = std::max(box.max_x, p0.x());
+        box.max_y = std::max(box.max_y, p0.y());
+      }
+      edge_begins_.push_back(a_.size());
+      boxes_.push_back(box);
+    }
+  }
+
+  /** @brief number of steps, one less than the poses */
+  size_t size() const { return boxes_.size(); }
+
+  /** @brief counter clockwise polygon of a step, closed */
+  LinearRing2d getStepPolygon(const size_t step) const
+  {
+    LinearRing2d ring;
+    for (size_t j = edge_begins_.at(step); j < edge_begins_.at(step + 1); ++j) {
+      ring.emplace_back(hull_x_.at(j), hull_y_.at(j));
+    }
+    if (!ring.empty()) {
+      ring.push_back(ring.front());
+    }
+    return ring;
+  }
+
+  /** @brief whether the point is strictly inside the step */
+  bool isInStep(const size_t step, const double x, const double y) const
+  {
+    for (size_t j = edge_begins_.at(step); j < edge_begins_.at(step + 1); ++j) {
+      if (!(a_[j] * x + b_[j] * y + c_[j] > 0.0)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Input indices of the points of the grid strictly inside the step, in ascending order
+   */
+  void findPointsInStep(
+    const size_t step, const PointGrid2d & grid, std::vector<size_t> & indices) const
+  {
+    indices.clear();
+    const auto & box = boxes_.at(step);
+    const auto & xs = grid.getX();
+    const auto & ys = grid.getY();
+    const auto & grid_indices = grid.getIndices();
+    std::vector<uint8_t> mask;
+    grid.forEachCell(
+      box.min_x, box.min_y, box.max_x, box.max_y, [&](const size_t begin, const size_t end) {
+        const size_t n = end - begin;
+        const double * x = xs.data() + begin;
+        const double * y = ys.data() + begin;
+        mask.assign(n, 1);
+        uint8_t * m = mask.data();
+        for (size_t j = edge_begins_[step]; j < edge_begins_[step + 1]; ++j) {
+          const double a = a_[j];
+          const double b = b_[j];
+          const double c = c_[j];
+          for (size_t k = 0; k < n; ++k) {
+            m[k] &= static_cast<uint8_t>(a * x[k] + b * y[k] + c > 0.0);
+          }
+        }
+        for (size_t k = 0; k < n; ++k) {
+          if (m[k]) {
+            indices.push_back(grid_indices[begin + k]);
+          }
+        }
+      });
+    std::sort(indices.begin(), indices.end());
+  }
+
+  /**
+   * @brief First step with a point of the grid inside, whose points are returned in indices. The
+   * steps after it are not searched.
+   */
+  boost::optional<size_t> findFirstCollisionStep(
+    const PointGrid2d & grid, std::vector<size_t> & indices) const
+  {
+    for (size_t step = 0; step < size(); ++step) {
+      findPointsInStep(step, grid, indices);
+      if (!indices.empty()) {
+        return step;
+      }
+    }
+    return {};
+  }
+
+private:
+  struct Box
+  {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+  };
+
+  /** @brief Andrew's monotone chain, counter clockwise without the closing point */
+  static void calcConvexHull(std::vector<Point2d> & points, std::vector<Point2d> & hull)
+  {
+    std::sort(points.begin(), points.end(), [](const Point2d & p, const Point2d & q) {
+      return p.x() < q.x() || (p.x() == q.x() && p.y() < q.y());
+    });
+    const auto cross = [](const Point2d & o, const Point2d & p, const Point2d & q) {
+      return (p.x() - o.x()) * (q.y() - o.y()) - (p.y() - o.y()) * (q.x() - o.x());
+    };
+    hull.resize(2 * points.size());
+    size_t k = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+      while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.0) {
+        --k;
+      }
+      hull[k++] = points[i];
+    }
+    for (size_t i = points.size() - 1, t = k + 1; i > 0; --i) {
+      while (k >= t && cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0.0) {
+        --k;
+      }
+      hull[k++] = points[i - 1];
+    }
+    hull.resize(k - 1);
+  }
+
+  // index of the first edge of each step, and the end of the last one
+  std::vector<size_t> edge_begins_;
+  // a * x + b * y + c > 0 inside, with the start point of each edge
+  std::vector<double> a_;
+  std::vector<double> b_;
+  std::vector<double> c_;
+  std::vector<double> hull_x_;
+  std::vector<double> hull_y_;
+  std::vector<Box> boxes_;
+};
+}  // namespace autoware_utils
+
+#endif  // AUTOWARE_UTILS__GEOMETRY__SWEPT_FOOTPRINT_HPP_
@@ -0,0 +1,147 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_UTILS__ROS__CALLBACK_TIMING_PUBLISHER_HPP_
+#define AUTOWARE_UTILS__ROS__CALLBACK_TIMING_PUBLISHER_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace autoware_utils
+{
+/**
+ * @brief Publishes the execution time of the callbacks of a node, batched over a period, so that
+ * system_monitor can attribute the CPU time of threads to the node and report percentiles.
+ * A message holds the process id and the thread ids that ran the callbacks in the values "pid" and
+ * "tids", and one value per callback with the durations in milliseconds separated by spaces.
+ */
+class CallbackTimingPublisher
+{
+public:
+  /**
+   * @brief measures a callback from construction to destruction, to be held as a local variable
+   * for the whole callback
+   */
+  class Scope
+  {
+  public:
+    Scope(CallbackTimingPublisher * publisher, const std::string & callback_name)
+    : publisher_(publisher), callback_name_(callback_name), start_(std::chrono::steady_clock::now())
+    {
+    }
+    Scope(const Scope &) = delete;
+    Scope & operator=(const Scope &) = delete;
+    ~Scope()
+    {
+      const auto duration = std::chrono::steady_clock::now() - start_;
+      publisher_->record(
+        callback_name_, std::chrono::duration<double, std::milli>(duration).count());
+    }
+
+  private:
+    CallbackTimingPublisher * publisher_;
+    std::string callback_name_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  explicit CallbackTimingPublisher(
+    rclcpp::Node * node, const std::string & name = "/system/callback_timing",
+    const std::chrono::milliseconds & period = std::chrono::milliseconds(1000),
+    const rclcpp::QoS & qos = rclcpp::QoS(10))
+  : node_name_(node->get_fully_qualified_name()), period_(period), pid_(getpid())
+  {
+    pub_callback_timing_ =
+      node->create_publisher<diagnostic_msgs::msg::DiagnosticStatus>(name, qos);
+    last_publish_time_ = std::chrono::steady_clock::now();
+  }
+
+  void record(const std::string & callback_name, const double duration_ms)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    tids_.insert(static_cast<pid_t>(syscall(SYS_gettid)));
+    durations_[callback_name].push_back(duration_ms);
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_publish_time_ < period_) {
+      return;
+    }
+    last_publish_time_ = now;
+
+    if (pub_callback_timing_->get_subscription_count() > 0) {
+      pub_callback_timing_->publish(toStatus());
+    }
+    // threads are kept since an executor reuses them
+    durations_.clear();
+  }
+
+private:
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticStatus>::SharedPtr pub_callback_timing_;
+  std::string node_name_;
+  std::chrono::milliseconds period_;
+  pid_t pid_;
+
+  std::mutex mutex_;
+  std::chrono::steady_clock::time_point last_publish_time_;
+  std::set<pid_t> tids_;
+  std::map<std::string, std::vector<double>> durations_;
+
+  diagnostic_msgs::msg::DiagnosticStatus toStatus() const
+  {
+    diagnostic_msgs::msg::DiagnosticStatus status;
+    status.name = node_name_;
+    status.values.push_back(toKeyValue("pid", std::to_string(pid_)));
+
+    std::string tids;
+    for (const auto tid : tids_) {
+      tids += (tids.empty() ? "" : " ") + std::to_string(tid);
+    }
+    status.values.push_back(toKeyValue("tids", tids));
+
+    for (const auto & callback : durations_) {
+      std::string durations;
+      char value[32];
+      for (const auto duration : callback.second) {
+        std::snprintf(value, sizeof(value), durations.empty() ? "%.3f" : " %.3f", duration);
+        durations += value;
+      }
+      status.values.push_back(toKeyValue(callback.first, durations));
+    }
+    return status;
+  }
+
+  static diagnostic_msgs::msg::KeyValue toKeyValue(
+    const std::string & key, const std::string & value)
+  {
+    diagnostic_msgs::msg::KeyValue key_value;
+    key_value.key = key;
+    key_value.value = value;
+    return key_value;
+  }
+};
+}  // namespace autoware_utils
+
+#endif  // AUTOWARE_UTILS__ROS__CALLBACK_TIMING_PUBLISHER_HPP_
@@ -45,18 +45,24 @@ T_msg toDebugMsg(const T & data, const rclcpp::Time & stamp)
 class DebugPublisher
 {
 public:
-  explicit DebugPublisher(rclcpp::Node * node, const char * ns) : node_(node), ns_(ns) {}
+  explicit DebugPublisher(rclcpp::Node * node, const char * ns)
+  : node_(node), ns_(ns), is_enabled_(true)
+  {
+  }
+
+  /** \brief When disabled, nothing is published and no publisher is created. */
+  void setEnabled(const bool is_enabled) { is_enabled_ = is_enabled; }
+  bool isEnabled() const { return is_enabled_; }
 
   template <
     class T,
     std::enable_if_t<rosidl_generator_traits::is_message<T>::value, std::nullptr_t> = nullptr>
   void publish(const std::string & name, const T & data, const rclcpp::QoS & qos = rclcpp::QoS(1))
   {
-    if (pub_map_.count(name) == 0) {
-      pub_map_[name] = node_->create_publisher<T>(std::string(ns_) + "/" + name, qos);
+    if (!is_enabled_) {
+      return;
     }
-
-    std::dynamic_pointer_cast<rclcpp::Publisher<T>>(pub_map_.at(name))->publish(data);
+    getPublisher<T>(name, qos)->publish(data);
   }
 
   template <
@@ -67,9 +73,45 @@ public:
     publish(name, debug_publisher::toDebugMsg<T_msg>(data, node_->now()), qos);
   }
 
+  /** \brief Whether the topic has a subscriber. The publisher is created by the first call, so that
+   * subscribers can find the topic. */
+  template <
+    class T,
+    std::enable_if_t<rosidl_generator_traits::is_message<T>::value, std::nullptr_t> = nullptr>
+  bool hasSubscribers(const std::string & name, const rclcpp::QoS & qos = rclcpp::QoS(1))
+  {
+    if (!is_enabled_) {
+      return false;
+    }
+    const auto pub = getPublisher<T>(name, qos);
+    return 0 < pub->get_subscription_count() + pub->get_intra_process_subscription_count();
+  }
+
+  /** \brief Publish create_msg(), which is only called when the topic has a subscriber. */
+  template <class T, class F>
+  void publishLazy(
+    const std::string & name, F && create_msg, const rclcpp::QoS & qos = rclcpp::QoS(1))
+  {
+    if (!hasSubscribers<T>(name, qos)) {
+      return;
+    }
+    getPublisher<T>(name, qos)->publish(create_msg());
+  }
+
 private:
+  template <class T>
+  std::shared_ptr<rclcpp::Publisher<T>> getPublisher(
+    const std::string & name, const rclcpp::QoS & qos)
+  {
+    if (pub_map_.count(name) == 0) {
+      pub_map_[name] = node_->create_publisher<T>(std::string(ns_) + "/" + name, qos);
+    }
+    return std::dynamic_pointer_cast<rclcpp::Publisher<T>>(pub_map_.at(name));
+  }
+
   rclcpp::Node * node_;
   const char * ns_;
+  bool is_enabled_;
   std::unordered_map<std::string, std::shared_ptr<rclcpp::PublisherBase>> pub_map_;
 };
 }  // namespace autoware_utils
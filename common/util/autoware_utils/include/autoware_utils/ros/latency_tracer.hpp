@@ -0,0 +1,95 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_UTILS__ROS__LATENCY_TRACER_HPP_
+#define AUTOWARE_UTILS__ROS__LATENCY_TRACER_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <builtin_interfaces/msg/time.hpp>
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+
+#include <cstdio>
+#include <string>
+
+namespace autoware_utils
+{
+/**
+ * @brief Publishes the receive and publish time of a node in a processing chain, so that the
+ * latency of the chain can be attributed to each node offline.
+ * A record holds the stamp of the input and of the output message. The stages of a chain are linked
+ * by the output stamp of a node being the input stamp of the next one, the input stamp of the first
+ * node being the stamp of the sensor data it started from.
+ */
+class LatencyTracer
+{
+public:
+  explicit LatencyTracer(
+    rclcpp::Node * node, const std::string & name = "~/debug/latency_trace",
+    const rclcpp::QoS & qos = rclcpp::QoS(10))
+  : clock_(node->get_clock()), stage_name_(node->get_fully_qualified_name())
+  {
+    pub_latency_trace_ = node->create_publisher<diagnostic_msgs::msg::DiagnosticStatus>(name, qos);
+  }
+
+  // to be called when the input message of a cycle is taken
+  void onReceive(const builtin_interfaces::msg::Time & input_stamp)
+  {
+    input_stamp_ = input_stamp;
+    receive_time_ = clock_->now();
+    has_received_ = true;
+  }
+
+  // to be called right after the output message of the cycle is published
+  void onPublish(const builtin_interfaces::msg::Time & output_stamp)
+  {
+    if (!has_received_ || pub_latency_trace_->get_subscription_count() == 0) {
+      return;
+    }
+    has_received_ = false;
+
+    const auto publish_time = clock_->now();
+    diagnostic_msgs::msg::DiagnosticStatus status;
+    status.name = stage_name_;
+    status.values.push_back(toKeyValue("input_stamp", input_stamp_));
+    status.values.push_back(toKeyValue("output_stamp", output_stamp));
+    status.values.push_back(toKeyValue("receive_time", receive_time_));
+    status.values.push_back(toKeyValue("publish_time", publish_time));
+    pub_latency_trace_->publish(status);
+  }
+
+private:
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticStatus>::SharedPtr pub_latency_trace_;
+  rclcpp::Clock::SharedPtr clock_;
+  std::string stage_name_;
+
+  bool has_received_ = false;
+  builtin_interfaces::msg::Time input_stamp_;
+  rclcpp::Time receive_time_;
+
+  static diagnostic_msgs::msg::KeyValue toKeyValue(
+    const std::string & key, const builtin_interfaces::msg::Time & stamp)
+  {
+    // exact to the nanosecond, a double would not be to match the stamps between the stages
+    char value[32];
+    std::snprintf(value, sizeof(value), "%d.%09u", stamp.sec, stamp.nanosec);
+    diagnostic_msgs::msg::KeyValue key_value;
+    key_value.key = key;
+    key_value.value = value;
+    return key_value;
+  }
+};
+}  // namespace autoware_utils
+
+#endif  // AUTOWARE_UTILS__ROS__LATENCY_TRACER_HPP_
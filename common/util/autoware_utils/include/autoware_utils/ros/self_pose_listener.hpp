@@ -21,6 +21,7 @@
 #include <rclcpp/rclcpp.hpp>
 
 #include <memory>
+#include <utility>
 
 namespace autoware_utils
 {
@@ -47,11 +48,23 @@ public:
       return {};
     }
 
-    return std::make_shared<const geometry_msgs::msg::PoseStamped>(transform2pose(*tf));
+    // the pose is converted once per transform, and shared by the callers until it changes
+    const auto latest_pose = std::atomic_load(&latest_pose_);
+    if (latest_pose && latest_pose->first == tf) {
+      return latest_pose->second;
+    }
+    const auto pose = std::make_shared<const geometry_msgs::msg::PoseStamped>(transform2pose(*tf));
+    std::atomic_store(&latest_pose_, std::make_shared<const LatestPose>(tf, pose));
+    return pose;
   }
 
 private:
   TransformListener transform_listener_;
+
+  using LatestPose = std::pair<
+    geometry_msgs::msg::TransformStamped::ConstSharedPtr,
+    geometry_msgs::msg::PoseStamped::ConstSharedPtr>;
+  std::shared_ptr<const LatestPose> latest_pose_;
 };
 }  // namespace autoware_utils
 
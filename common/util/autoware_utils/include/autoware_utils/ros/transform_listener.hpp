@@ -18,42 +18,99 @@
 #include <rclcpp/rclcpp.hpp>
 
 #include <geometry_msgs/msg/transform_stamped.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
 
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/create_timer_ros.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <atomic>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 
 namespace autoware_utils
 {
+/**
+ * @brief tf buffer shared by the TransformListeners of a process. /tf and /tf_static are received
+ * once per process by a dedicated node and thread, as tf2_ros::TransformListener does per buffer,
+ * and a version counter tells the listeners when the transforms have changed.
+ */
+class SharedTransformBuffer
+{
+public:
+  /**
+   * @brief the buffer of the process, created with the clock of the first node asking for it
+   */
+  static std::shared_ptr<SharedTransformBuffer> getInstance(rclcpp::Node * node);
+
+  ~SharedTransformBuffer();
+
+  tf2_ros::Buffer & getBuffer() { return *tf_buffer_; }
+
+  /**
+   * @brief incremented after each message of /tf or /tf_static
+   */
+  uint64_t getVersion() const { return version_.load(std::memory_order_acquire); }
+
+private:
+  explicit SharedTransformBuffer(rclcpp::Node * node);
+
+  void onTransforms(const tf2_msgs::msg::TFMessage::ConstSharedPtr msg, const bool is_static);
+
+  std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
+  rclcpp::Node::SharedPtr node_;
+  rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr sub_tf_;
+  rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr sub_tf_static_;
+  rclcpp::executors::SingleThreadedExecutor::SharedPtr executor_;
+  std::thread thread_;
+  std::atomic<uint64_t> version_{0};
+};
+
 class TransformListener
 {
 public:
   explicit TransformListener(rclcpp::Node * node)
-  : clock_(node->get_clock()), logger_(node->get_logger())
+  : clock_(node->get_clock()),
+    logger_(node->get_logger()),
+    shared_buffer_(SharedTransformBuffer::getInstance(node))
   {
-    tf_buffer_ = std::make_shared<tf2_ros::Buffer>(clock_);
-    auto timer_interface = std::make_shared<tf2_ros::CreateTimerROS>(
-      node->get_node_base_interface(), node->get_node_timers_interface());
-    tf_buffer_->setCreateTimerInterface(timer_interface);
-    tf_listener_ = std::make_shared<tf2_ros::TransformListener>(*tf_buffer_);
   }
 
+  /**
+   * @brief latest transform, looked up again only when the buffer has changed since the last call
+   */
   geometry_msgs::msg::TransformStamped::ConstSharedPtr getLatestTransform(
     const std::string & from, const std::string & to)
   {
+    const auto version = shared_buffer_->getVersion();
+    const auto key = std::make_pair(from, to);
+    {
+      std::lock_guard<std::mutex> lock(latest_transforms_mutex_);
+      const auto itr = latest_transforms_.find(key);
+      if (itr != latest_transforms_.end() && itr->second.first == version) {
+        return itr->second.second;
+      }
+    }
+
     geometry_msgs::msg::TransformStamped tf;
     try {
-      tf = tf_buffer_->lookupTransform(from, to, tf2::TimePointZero);
+      tf = shared_buffer_->getBuffer().lookupTransform(from, to, tf2::TimePointZero);
     } catch (tf2::TransformException & ex) {
       RCLCPP_WARN(
         logger_, "failed to get transform from %s to %s: %s", from.c_str(), to.c_str(), ex.what());
       return {};
     }
 
-    return std::make_shared<const geometry_msgs::msg::TransformStamped>(tf);
+    // stored with the version read before the lookup, so that a change during it isn't missed
+    const auto tf_ptr = std::make_shared<const geometry_msgs::msg::TransformStamped>(tf);
+    std::lock_guard<std::mutex> lock(latest_transforms_mutex_);
+    latest_transforms_[key] = std::make_pair(version, tf_ptr);
+    return tf_ptr;
   }
 
   geometry_msgs::msg::TransformStamped::ConstSharedPtr getTransform(
@@ -62,7 +119,7 @@ public:
   {
     geometry_msgs::msg::TransformStamped tf;
     try {
-      tf = tf_buffer_->lookupTransform(from, to, time, duration);
+      tf = shared_buffer_->getBuffer().lookupTransform(from, to, time, duration);
     } catch (tf2::TransformException & ex) {
       RCLCPP_WARN(
         logger_, "failed to get transform from %s to %s: %s", from.c_str(), to.c_str(), ex.what());
@@ -77,8 +134,11 @@ public:
 private:
   rclcpp::Clock::SharedPtr clock_;
   rclcpp::Logger logger_;
-  std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
-  std::shared_ptr<tf2_ros::TransformListener> tf_listener_;
+  std::shared_ptr<SharedTransformBuffer> shared_buffer_;
+
+  using LatestTransform = std::pair<uint64_t, geometry_msgs::msg::TransformStamped::ConstSharedPtr>;
+  std::mutex latest_transforms_mutex_;
+  std::map<std::pair<std::string, std::string>, LatestTransform> latest_transforms_;
 };
 }  // namespace autoware_utils
 
@@ -0,0 +1,132 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_UTILS__SYSTEM__REALTIME_HPP_
+#define AUTOWARE_UTILS__SYSTEM__REALTIME_HPP_
+
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+namespace autoware_utils
+{
+/**
+ * @brief Lock the pages of the process in RAM, so that a page fault does not stall a real-time
+ * thread. The freed memory is kept in the heap, which is then prefaulted by prefault_heap_size
+ * bytes, so that the allocations of the following cycles reuse locked pages without a system call.
+ * @return false if not permitted, e.g. without CAP_IPC_LOCK or with a small RLIMIT_MEMLOCK
+ */
+inline bool lockMemory(const size_t prefault_heap_size = 0)
+{
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    return false;
+  }
+  mallopt(M_TRIM_THRESHOLD, -1);
+  mallopt(M_MMAP_MAX, 0);
+
+  if (prefault_heap_size > 0) {
+    auto buffer = static_cast<volatile char *>(std::malloc(prefault_heap_size));
+    if (!buffer) {
+      return false;
+    }
+    const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t i = 0; i < prefault_heap_size; i += page_size) {
+      buffer[i] = 0;
+    }
+    std::free(const_cast<char *>(buffer));
+  }
+  return true;
+}
+
+/**
+ * @brief Schedule the calling thread with SCHED_FIFO. A node calls it from its constructor, which
+ * runs on the executor thread of the component container and of the standalone executable.
+ * @return false if not permitted, e.g. without CAP_SYS_NICE or with a small RLIMIT_RTPRIO
+ */
+inline bool setRealtimePriority(const int priority)
+{
+  sched_param param{};
+  param.sched_priority = priority;
+  return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+}
+
+/**
+ * @brief Count the executions of a callback that take longer than a deadline, measured with the
+ * steady clock between start() and stop().
+ */
+class DeadlineMonitor
+{
+public:
+  explicit DeadlineMonitor(const double deadline = 0.0) : deadline_(deadline) {}
+
+  void setDeadline(const double deadline) { deadline_ = deadline; }
+  double getDeadline() const { return deadline_; }
+
+  void start() { t_start_ = std::chrono::steady_clock::now(); }
+
+  void stop()
+  {
+    const double duration =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start_).count();
+    ++call_count_;
+    if (duration > deadline_) {
+      ++miss_count_;
+    }
+    max_duration_ = std::max(max_duration_, duration);
+  }
+
+  size_t getCallCount() const { return call_count_; }
+  size_t getMissCount() const { return miss_count_; }
+  double getMaxDuration() const { return max_duration_; }
+
+  /**
+   * @brief Task of diagnostic_updater::Updater, WARN when a deadline was missed since the previous
+   * call. The status wrapper is a template parameter not to depend on diagnostic_updater.
+   */
+  template <class DiagnosticStatusWrapper>
+  void diagnose(DiagnosticStatusWrapper & stat)
+  {
+    using diagnostic_msgs::msg::DiagnosticStatus;
+
+    stat.add("deadline [s]", deadline_);
+    stat.add("call count", call_count_);
+    stat.add("miss count", miss_count_);
+    stat.add("max duration [s]", max_duration_);
+    if (miss_count_ > reported_miss_count_) {
+      stat.summary(DiagnosticStatus::WARN, "deadline missed");
+    } else {
+      stat.summary(DiagnosticStatus::OK, "OK");
+    }
+    reported_miss_count_ = miss_count_;
+  }
+
+private:
+  double deadline_;
+  std::chrono::steady_clock::time_point t_start_;
+  size_t call_count_ = 0;
+  size_t miss_count_ = 0;
+  size_t reported_miss_count_ = 0;
+  double max_duration_ = 0.0;
+};
+}  // namespace autoware_utils
+
+#endif  // AUTOWARE_UTILS__SYSTEM__REALTIME_HPP_
@@ -0,0 +1,206 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_UTILS__TRAJECTORY__ARC_LENGTH_TABLE_HPP_
+#define AUTOWARE_UTILS__TRAJECTORY__ARC_LENGTH_TABLE_HPP_
+
+#include "autoware_utils/geometry/boost_geometry.hpp"
+#include "autoware_utils/trajectory/point_span.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace autoware_utils
+{
+/**
+ * @brief Arc length queries on a trajectory which is received once and queried many times, e.g.
+ * by a controller in every cycle until the next trajectory. The xy of the points, the cumulative
+ * arc length and the unit direction of each segment are computed in update(), so that the arc
+ * length between indices is a subtraction and the offset on a segment is a dot product.
+ *
+ * The queries with a hint search the nearest point from the hint towards the closer neighbors, in
+ * amortized O(1) for a point moving along the trajectory. The hint is usually the nearest index of
+ * the previous query or of a search with a yaw condition. Without a hint, the whole trajectory is
+ * searched as findNearestSegmentIndex.
+ */
+class ArcLengthTable
+{
+public:
+  ArcLengthTable() = default;
+
+  template <class T>
+  explicit ArcLengthTable(const T & points)
+  {
+    update(points);
+  }
+
+  /**
+   * @brief rebuild the table for points of trajectory, path, ..., reusing the allocated memory
+   */
+  template <class T>
+  void update(const T & points)
+  {
+    toPoint2dArray(points, points_);
+    calcCumulativeArcLength(points_, arc_lengths_);
+
+    directions_.resize(points_.size() - 1);
+    for (size_t i = 0; i < directions_.size(); ++i) {
+      const double length = arc_lengths_[i + 1] - arc_lengths_[i];
+      if (length == 0.0) {
+        directions_[i] = Point2d(0.0, 0.0);
+        continue;
+      }
+      directions_[i] = Point2d(
+        (points_[i + 1].x() - points_[i].x()) / length,
+        (points_[i + 1].y() - points_[i].y()) / length);
+    }
+  }
+
+  size_t size() const { return points_.size(); }
+  bool empty() const { return points_.empty(); }
+
+  const std::vector<Point2d> & getPoints() const { return points_; }
+  const std::vector<double> & getArcLengths() const { return arc_lengths_; }
+
+  /**
+   * @brief arc length from the first point to the last point
+   */
+  double getLength() const { return arc_lengths_.at(arc_lengths_.size() - 1); }
+
+  double getSegmentLength(const size_t seg_idx) const
+  {
+    return arc_lengths_.at(seg_idx + 1) - arc_lengths_.at(seg_idx);
+  }
+
+  double calcSignedArcLength(const size_t src_idx, const size_t dst_idx) const
+  {
+    return arc_lengths_.at(dst_idx) - arc_lengths_.at(src_idx);
+  }
+
+  /**
+   * @brief same as calcLongitudinalOffsetToSegment, with the direction of the segment in the table
+   */
+  double calcLongitudinalOffsetToSegment(const size_t seg_idx, const Point2d & point) const
+  {
+    const Point2d & direction = directions_.at(seg_idx);
+    if (direction.x() == 0.0 && direction.y() == 0.0) {
+      throw std::runtime_error("Same points are given.");
+    }
+
+    const Point2d & p_front = points_[seg_idx];
+    return direction.x() * (point.x() - p_front.x()) + direction.y() * (point.y() - p_front.y());
+  }
+
+  size_t findNearestSegmentIndex(const Point2d & point) const
+  {
+    return toSegmentIndex(findNearestIndex(points_, point), point);
+  }
+
+  size_t findNearestSegmentIndex(const Point2d & point, const size_t hint_idx) const
+  {
+    return toSegmentIndex(findNearestIndexFrom(point, hint_idx), point);
+  }
+
+  /**
+   * @brief arc length from the first point to the projection of the point on its nearest segment,
+   * negative before the first point and longer than getLength() after the last point
+   */
+  double calcArcLength(const Point2d & point) const
+  {
+    const size_t seg_idx = findNearestSegmentIndex(point);
+    return arc_lengths_[seg_idx] + calcLongitudinalOffsetToSegment(seg_idx, point);
+  }
+
+  double calcArcLength(const Point2d & point, const size_t hint_idx) const
+  {
+    const size_t seg_idx = findNearestSegmentIndex(point, hint_idx);
+    return arc_lengths_[seg_idx] + calcLongitudinalOffsetToSegment(seg_idx, point);
+  }
+
+  /**
+   * @brief same as calcSignedArcLength from point to index of the message points
+   */
+  double calcSignedArcLength(const Point2d & src_point, const size_t dst_idx) const
+  {
+    return arc_lengths_.at(dst_idx) - calcArcLength(src_point);
+  }
+
+  double calcSignedArcLength(
+    const Point2d & src_point, const size_t dst_idx, const size_t hint_idx) const
+  {
+    return arc_lengths_.at(dst_idx) - calcArcLength(src_point, hint_idx);
+  }
+
+private:
+  std::vector<Point2d> points_;
+  std::vector<double> arc_lengths_;
+  std::vector<Point2d> directions_;  //!< @brief unit vector of each segment, zero if degenerate
+
+  double calcSquaredDistance(const size_t idx, const Point2d & point) const
+  {
+    const double dx = points_[idx].x() - point.x();
+    const double dy = points_[idx].y() - point.y();
+    return dx * dx + dy * dy;
+  }
+
+  // Descend from the hint to the nearest point of the neighborhood, which is the nearest point of
+  // the trajectory unless the trajectory comes back close to the point elsewhere
+  size_t findNearestIndexFrom(const Point2d & point, const size_t hint_idx) const
+  {
+    validateNonEmpty(points_);
+
+    size_t idx = std::min(hint_idx, points_.size() - 1);
+    double min_dist = calcSquaredDistance(idx, point);
+    while (idx + 1 < points_.size()) {
+      const double dist = calcSquaredDistance(idx + 1, point);
+      if (dist >= min_dist) {
+        break;
+      }
+      min_dist = dist;
+      ++idx;
+    }
+    while (idx > 0) {
+      const double dist = calcSquaredDistance(idx - 1, point);
+      if (dist > min_dist) {
+        break;
+      }
+      min_dist = dist;
+      --idx;
+    }
+    return idx;
+  }
+
+  // Same as findNearestSegmentIndex from the nearest index
+  size_t toSegmentIndex(const size_t nearest_idx, const Point2d & point) const
+  {
+    if (points_.size() < 2) {
+      throw std::invalid_argument("The table needs at least two points for a segment.");
+    }
+    if (nearest_idx == 0) {
+      return 0;
+    }
+    if (nearest_idx == points_.size() - 1) {
+      return points_.size() - 2;
+    }
+    if (calcLongitudinalOffsetToSegment(nearest_idx, point) <= 0) {
+      return nearest_idx - 1;
+    }
+    return nearest_idx;
+  }
+};
+}  // namespace autoware_utils
+
+#endif  // AUTOWARE_UTILS__TRAJECTORY__ARC_LENGTH_TABLE_HPP_
@@ -0,0 +1,239 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_UTILS__TRAJECTORY__POINT_SPAN_HPP_
+#define AUTOWARE_UTILS__TRAJECTORY__POINT_SPAN_HPP_
+
+#include "autoware_utils/geometry/boost_geometry.hpp"
+#include "autoware_utils/geometry/geometry.hpp"
+#include "autoware_utils/trajectory/trajectory.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace autoware_utils
+{
+/**
+ * @brief read-only view of contiguous points such as std::vector<Point2d> and LineString2d, until
+ * std::span of C++20. The overloads below taking PointSpan2d work on the xy of the points directly,
+ * while the overloads for trajectory messages convert each point through getPoint on every access.
+ */
+template <class PointT>
+class PointSpan
+{
+public:
+  PointSpan(const PointT * data, const size_t size) : data_(data), size_(size) {}
+
+  template <class Allocator>
+  PointSpan(const std::vector<PointT, Allocator> & points)  // NOLINT
+  : data_(points.data()), size_(points.size())
+  {
+  }
+
+  const PointT * data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const PointT * begin() const { return data_; }
+  const PointT * end() const { return data_ + size_; }
+
+  const PointT & operator[](const size_t i) const { return data_[i]; }
+  const PointT & at(const size_t i) const
+  {
+    if (i >= size_) {
+      throw std::out_of_range("PointSpan index is out of range.");
+    }
+    return data_[i];
+  }
+
+  const PointT & front() const { return data_[0]; }
+  const PointT & back() const { return data_[size_ - 1]; }
+
+private:
+  const PointT * data_;
+  size_t size_;
+};
+
+using PointSpan2d = PointSpan<Point2d>;
+
+/**
+ * @brief convert points of trajectory, path, ... into xy points once, so that the following queries
+ * work on PointSpan2d
+ */
+template <class T>
+void toPoint2dArray(const T & points, std::vector<Point2d> & points_2d)
+{
+  points_2d.resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto p = getPoint(points[i]);
+    points_2d[i] = Point2d(p.x, p.y);
+  }
+}
+
+template <class T>
+std::vector<Point2d> toPoint2dArray(const T & points)
+{
+  std::vector<Point2d> points_2d;
+  toPoint2dArray(points, points_2d);
+  return points_2d;
+}
+
+/**
+ * @brief calculate the length of each segment, segment_lengths[i] is between point i and i + 1.
+ * The loop has no branch, so that it can be vectorized.
+ */
+inline void calcSegmentLengths(const PointSpan2d & points, std::vector<double> & segment_lengths)
+{
+  validateNonEmpty(points);
+
+  const size_t num_segments = points.size() - 1;
+  segment_lengths.resize(num_segments);
+  const Point2d * p = points.data();
+  double * length = segment_lengths.data();
+  for (size_t i = 0; i < num_segments; ++i) {
+    const double dx = p[i + 1].x() - p[i].x();
+    const double dy = p[i + 1].y() - p[i].y();
+    length[i] = std::sqrt(dx * dx + dy * dy);
+  }
+}
+
+/**
+ * @brief calculate the arc length from the first point to each point, so that the arc length
+ * between any two indices is a subtraction
+ */
+inline void calcCumulativeArcLength(const PointSpan2d & points, std::vector<double> & arc_lengths)
+{
+  calcSegmentLengths(points, arc_lengths);
+
+  arc_lengths.insert(arc_lengths.begin(), 0.0);
+  for (size_t i = 1; i < arc_lengths.size(); ++i) {
+    arc_lengths[i] += arc_lengths[i - 1];
+  }
+}
+
+inline size_t findNearestIndex(const PointSpan2d & points, const Point2d & point)
+{
+  validateNonEmpty(points);
+
+  double min_dist = std::numeric_limits<double>::max();
+  size_t min_idx = 0;
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    const double dx = points[i].x() - point.x();
+    const double dy = points[i].y() - point.y();
+    const double dist = dx * dx + dy * dy;
+    if (dist < min_dist) {
+      min_dist = dist;
+      min_idx = i;
+    }
+  }
+  return min_idx;
+}
+
+inline double calcLongitudinalOffsetToSegment(
+  const PointSpan2d & points, const size_t seg_idx, const Point2d & p_target)
+{
+  validateNonEmpty(points);
+
+  const Point2d & p_front = points.at(seg_idx);
+  const Point2d & p_back = points.at(seg_idx + 1);
+
+  const double segment_x = p_back.x() - p_front.x();
+  const double segment_y = p_back.y() - p_front.y();
+  const double segment_length = std::hypot(segment_x, segment_y);
+
+  if (segment_length == 0.0) {
+    throw std::runtime_error("Same points are given.");
+  }
+
+  const double target_x = p_target.x() - p_front.x();
+  const double target_y = p_target.y() - p_front.y();
+  return (segment_x * target_x + segment_y * target_y) / segment_length;
+}
+
+inline size_t findNearestSegmentIndex(const PointSpan2d & points, const Point2d & point)
+{
+  const size_t nearest_idx = findNearestIndex(points, point);
+
+  if (nearest_idx == 0) {
+    return 0;
+  }
+  if (nearest_idx == points.size() - 1) {
+    return points.size() - 2;
+  }
+
+  const double signed_length = calcLongitudinalOffsetToSegment(points, nearest_idx, point);
+
+  if (signed_length <= 0) {
+    return nearest_idx - 1;
+  }
+
+  return nearest_idx;
+}
+
+inline double calcSignedArcLength(
+  const PointSpan2d & points, const size_t src_idx, const size_t dst_idx)
+{
+  validateNonEmpty(points);
+
+  if (src_idx > dst_idx) {
+    return -calcSignedArcLength(points, dst_idx, src_idx);
+  }
+
+  double dist_sum = 0.0;
+  for (size_t i = src_idx; i < dst_idx; ++i) {
+    const double dx = points[i + 1].x() - points[i].x();
+    const double dy = points[i + 1].y() - points[i].y();
+    dist_sum += std::sqrt(dx * dx + dy * dy);
+  }
+  return dist_sum;
+}
+
+inline double calcArcLength(const PointSpan2d & points)
+{
+  validateNonEmpty(points);
+
+  return calcSignedArcLength(points, 0, points.size() - 1);
+}
+
+/**
+ * @brief calcSignedArcLength from point to point, with arc_lengths of calcCumulativeArcLength
+ */
+inline double calcSignedArcLength(
+  const PointSpan2d & points, const std::vector<double> & arc_lengths, const Point2d & src_point,
+  const Point2d & dst_point)
+{
+  validateNonEmpty(points);
+
+  if (arc_lengths.size() != points.size()) {
+    throw std::invalid_argument("The size of points and arc_lengths are not the same.");
+  }
+
+  const size_t src_seg_idx = findNearestSegmentIndex(points, src_point);
+  const size_t dst_seg_idx = findNearestSegmentIndex(points, dst_point);
+
+  const double signed_length_on_traj = arc_lengths[dst_seg_idx] - arc_lengths[src_seg_idx];
+  const double signed_length_src_offset =
+    calcLongitudinalOffsetToSegment(points, src_seg_idx, src_point);
+  const double signed_length_dst_offset =
+    calcLongitudinalOffsetToSegment(points, dst_seg_idx, dst_point);
+
+  return signed_length_on_traj - signed_length_src_offset + signed_length_dst_offset;
+}
+}  // namespace autoware_utils
+
+#endif  // AUTOWARE_UTILS__TRAJECTORY__POINT_SPAN_HPP_
@@ -74,6 +74,49 @@ size_t findNearestIndex(const T & points, const geometry_msgs::msg::Point & poin
   return min_idx;
 }
 
+/**
+ * @brief find nearest index searching only around hint_idx, e.g. the result of the previous cycle
+ *        A minimum inside [hint_idx - search_range, hint_idx + search_range] is returned as is.
+ *        If the hint is out of range or the minimum is on the window edge, search the whole points.
+ * @param points points of trajectory, path, ...
+ * @param point target point
+ * @param hint_idx index expected to be near the nearest index
+ * @param search_range number of points searched on each side of hint_idx
+ * @return nearest index
+ */
+template <class T>
+size_t findNearestIndex(
+  const T & points, const geometry_msgs::msg::Point & point, const size_t hint_idx,
+  const size_t search_range)
+{
+  validateNonEmpty(points);
+
+  if (hint_idx >= points.size()) {
+    return findNearestIndex(points, point);
+  }
+
+  const size_t begin_idx = hint_idx > search_range ? hint_idx - search_range : 0;
+  const size_t end_idx = std::min(hint_idx + search_range, points.size() - 1);
+
+  double min_dist = std::numeric_limits<double>::max();
+  size_t min_idx = begin_idx;
+
+  for (size_t i = begin_idx; i <= end_idx; ++i) {
+    const auto dist = calcSquaredDistance2d(points.at(i), point);
+    if (dist < min_dist) {
+      min_dist = dist;
+      min_idx = i;
+    }
+  }
+
+  const bool is_on_begin_edge = min_idx == begin_idx && begin_idx != 0;
+  const bool is_on_end_edge = min_idx == end_idx && end_idx != points.size() - 1;
+  if (is_on_begin_edge || is_on_end_edge) {
+    return findNearestIndex(points, point);
+  }
+  return min_idx;
+}
+
 template <class T>
 boost::optional<size_t> findNearestIndex(
   const T & points, const geometry_msgs::msg::Pose & pose,
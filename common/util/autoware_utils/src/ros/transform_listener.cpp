@@ -0,0 +1,92 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_utils/ros/transform_listener.hpp"
+
+#include <tf2_ros/qos.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace autoware_utils
+{
+std::shared_ptr<SharedTransformBuffer> SharedTransformBuffer::getInstance(rclcpp::Node * node)
+{
+  // defined in the library so that the nodes of the process loaded from different libraries share
+  // the same instance, released with the last listener
+  static std::mutex mutex;
+  static std::weak_ptr<SharedTransformBuffer> instance;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto shared_buffer = instance.lock();
+  if (!shared_buffer) {
+    shared_buffer = std::shared_ptr<SharedTransformBuffer>(new SharedTransformBuffer(node));
+    instance = shared_buffer;
+  }
+  return shared_buffer;
+}
+
+SharedTransformBuffer::SharedTransformBuffer(rclcpp::Node * node)
+{
+  tf_buffer_ = std::make_shared<tf2_ros::Buffer>(node->get_clock());
+
+  // same as the node of tf2_ros::TransformListener, spun by its own thread
+  const auto options = rclcpp::NodeOptions()
+                         .start_parameter_services(false)
+                         .start_parameter_event_publisher(false)
+                         .use_global_arguments(false);
+  node_ = rclcpp::Node::make_shared(
+    "shared_transform_listener_impl_" + std::to_string(reinterpret_cast<uintptr_t>(this)),
+    options);
+  tf_buffer_->setCreateTimerInterface(std::make_shared<tf2_ros::CreateTimerROS>(
+    node_->get_node_base_interface(), node_->get_node_timers_interface()));
+
+  using std::placeholders::_1;
+  sub_tf_ = node_->create_subscription<tf2_msgs::msg::TFMessage>(
+    "/tf", tf2_ros::DynamicListenerQoS(),
+    std::bind(&SharedTransformBuffer::onTransforms, this, _1, false));
+  sub_tf_static_ = node_->create_subscription<tf2_msgs::msg::TFMessage>(
+    "/tf_static", tf2_ros::StaticListenerQoS(),
+    std::bind(&SharedTransformBuffer::onTransforms, this, _1, true));
+
+  executor_ = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  executor_->add_node(node_);
+  thread_ = std::thread([this]() { executor_->spin(); });
+}
+
+SharedTransformBuffer::~SharedTransformBuffer()
+{
+  executor_->cancel();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void SharedTransformBuffer::onTransforms(
+  const tf2_msgs::msg::TFMessage::ConstSharedPtr msg, const bool is_static)
+{
+  const std::string authority = "Authority undetectable";
+  for (const auto & transform : msg->transforms) {
+    try {
+      tf_buffer_->setTransform(transform, authority, is_static);
+    } catch (const tf2::TransformException & ex) {
+      RCLCPP_ERROR(node_->get_logger(), "failed to set transform: %s", ex.what());
+    }
+  }
+  version_.fetch_add(1, std::memory_order_release);
+}
+}  // namespace autoware_utils
@@ -0,0 +1,109 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "autoware_utils/geometry/swept_footprint.hpp"
+#include "autoware_utils/math/unit_conversion.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+struct Point
+{
+  double x;
+  double y;
+};
+
+geometry_msgs::msg::Pose createPose(const double x, const double y, const double yaw)
+{
+  geometry_msgs::msg::Pose pose;
+  pose.position = autoware_utils::createPoint(x, y, 0.0);
+  pose.orientation = autoware_utils::createQuaternionFromYaw(yaw);
+  return pose;
+}
+}  // namespace
+
+TEST(swept_footprint, oriented_box)
+{
+  using autoware_utils::deg2rad;
+  using autoware_utils::OrientedBox2d;
+
+  const OrientedBox2d box(createPose(1.0, 1.0, deg2rad(90)), -1.0, 3.0, -1.0, 1.0);
+
+  const auto corners = box.getCorners();
+  EXPECT_NEAR(corners.at(0).x(), 0.0, 1e-9);
+  EXPECT_NEAR(corners.at(0).y(), 4.0, 1e-9);
+  EXPECT_NEAR(corners.at(2).x(), 2.0, 1e-9);
+  EXPECT_NEAR(corners.at(2).y(), 0.0, 1e-9);
+
+  EXPECT_TRUE(box.contains(1.5, 3.5));
+  EXPECT_FALSE(box.contains(3.0, 1.0));
+  EXPECT_DOUBLE_EQ(box.calcSquaredDistance(1.0, 2.0), 0.0);
+  EXPECT_NEAR(box.calcSquaredDistance(4.0, 1.0), 4.0, 1e-9);
+  EXPECT_NEAR(box.calcSquaredDistance(3.0, 6.0), 5.0, 1e-9);
+}
+
+TEST(swept_footprint, point_grid)
+{
+  using autoware_utils::PointGrid2d;
+
+  const std::vector<Point> points = {{0.5, 0.5}, {5.5, 0.5}, {0.2, 0.8}, {-0.5, 0.5}};
+  const PointGrid2d grid(points, 1.0);
+  EXPECT_EQ(grid.size(), 4u);
+
+  std::vector<size_t> indices;
+  grid.query(0.1, 0.1, 0.9, 0.9, indices);
+  EXPECT_EQ(indices, (std::vector<size_t>{0, 2}));
+  grid.query(-0.9, 0.1, 0.9, 0.9, indices);
+  EXPECT_EQ(indices, (std::vector<size_t>{0, 2, 3}));
+  grid.query(2.0, 2.0, 3.0, 3.0, indices);
+  EXPECT_TRUE(indices.empty());
+}
+
+TEST(swept_footprint, find_first_collision_step)
+{
+  using autoware_utils::PointGrid2d;
+  using autoware_utils::SweptFootprint;
+
+  // straight along x, box of 4m x 2m
+  std::vector<geometry_msgs::msg::Pose> poses;
+  for (int i = 0; i < 5; ++i) {
+    poses.push_back(createPose(2.0 * i, 0.0, 0.0));
+  }
+  const SweptFootprint footprint(poses, -1.0, 3.0, -1.0, 1.0);
+  ASSERT_EQ(footprint.size(), 4u);
+  EXPECT_EQ(footprint.getStepPolygon(0).size(), 5u);
+
+  EXPECT_TRUE(footprint.isInStep(0, 4.0, 0.5));
+  EXPECT_FALSE(footprint.isInStep(0, 5.5, 0.0));
+  EXPECT_FALSE(footprint.isInStep(0, 1.0, 1.5));
+
+  const std::vector<Point> points = {{9.5, 0.0}, {5.5, 2.0}, {7.5, -0.5}, {8.0, 0.9}};
+  const PointGrid2d grid(points, 1.0);
+
+  std::vector<size_t> indices;
+  footprint.findPointsInStep(3, grid, indices);
+  EXPECT_EQ(indices, (std::vector<size_t>{0, 2, 3}));
+
+  const auto step = footprint.findFirstCollisionStep(grid, indices);
+  ASSERT_TRUE(step);
+  EXPECT_EQ(*step, 2u);
+  EXPECT_EQ(indices, (std::vector<size_t>{2, 3}));
+
+  const PointGrid2d far_grid(std::vector<Point>{{0.0, 5.0}}, 1.0);
+  EXPECT_FALSE(footprint.findFirstCollisionStep(far_grid, indices));
+}
@@ -0,0 +1,74 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_utils/system/realtime.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+struct StatusWrapper
+{
+  template <class T>
+  void add(const std::string & key, const T & value)
+  {
+    std::ostringstream oss;
+    oss << value;
+    values[key] = oss.str();
+  }
+  void summary(const unsigned char lvl, const std::string & msg)
+  {
+    level = lvl;
+    message = msg;
+  }
+
+  std::map<std::string, std::string> values;
+  unsigned char level = 255;
+  std::string message;
+};
+}  // namespace
+
+TEST(system, DeadlineMonitor)
+{
+  using autoware_utils::DeadlineMonitor;
+  using diagnostic_msgs::msg::DiagnosticStatus;
+
+  DeadlineMonitor monitor(0.05);
+
+  monitor.start();
+  monitor.stop();
+  EXPECT_EQ(monitor.getCallCount(), 1U);
+  EXPECT_EQ(monitor.getMissCount(), 0U);
+
+  monitor.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  monitor.stop();
+  EXPECT_EQ(monitor.getCallCount(), 2U);
+  EXPECT_EQ(monitor.getMissCount(), 1U);
+  EXPECT_GE(monitor.getMaxDuration(), 0.1);
+
+  // WARN only for the misses since the previous report
+  StatusWrapper stat;
+  monitor.diagnose(stat);
+  EXPECT_EQ(stat.level, DiagnosticStatus::WARN);
+  EXPECT_EQ(stat.values.at("miss count"), "1");
+  monitor.diagnose(stat);
+  EXPECT_EQ(stat.level, DiagnosticStatus::OK);
+}
@@ -0,0 +1,128 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_utils/trajectory/arc_length_table.hpp"
+#include "autoware_utils/trajectory/trajectory.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+using autoware_planning_msgs::msg::Trajectory;
+using autoware_utils::ArcLengthTable;
+using autoware_utils::createPoint;
+using autoware_utils::Point2d;
+
+constexpr double epsilon = 1e-6;
+
+Trajectory generateCurvedTrajectory(const size_t num_points, const double point_interval)
+{
+  Trajectory traj;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = i * 0.05;
+    autoware_planning_msgs::msg::TrajectoryPoint p;
+    p.pose.position = createPoint(
+      i * point_interval * std::cos(theta), i * point_interval * std::sin(theta), 0.0);
+    traj.points.push_back(p);
+  }
+  return traj;
+}
+}  // namespace
+
+TEST(arc_length_table, update)
+{
+  ArcLengthTable table;
+  EXPECT_THROW(table.update(Trajectory{}.points), std::invalid_argument);
+
+  const auto traj = generateCurvedTrajectory(20, 1.5);
+  table.update(traj.points);
+  ASSERT_EQ(table.size(), traj.points.size());
+  EXPECT_NEAR(table.getLength(), autoware_utils::calcArcLength(traj.points), epsilon);
+  EXPECT_NEAR(
+    table.calcSignedArcLength(15, 3), autoware_utils::calcSignedArcLength(traj.points, 15, 3),
+    epsilon);
+
+  // Rebuilt for a shorter trajectory
+  const auto short_traj = generateCurvedTrajectory(5, 1.0);
+  table.update(short_traj.points);
+  ASSERT_EQ(table.size(), short_traj.points.size());
+  EXPECT_NEAR(table.getLength(), autoware_utils::calcArcLength(short_traj.points), epsilon);
+}
+
+TEST(arc_length_table, sameAsMessageFunctions)
+{
+  const auto traj = generateCurvedTrajectory(20, 1.5);
+  const ArcLengthTable table(traj.points);
+
+  const std::vector<Point2d> targets{
+    Point2d(-1.0, 0.0), Point2d(3.2, 1.0), Point2d(10.0, 5.0), Point2d(25.0, 15.0)};
+  for (const auto & target : targets) {
+    const auto target_msg = createPoint(target.x(), target.y(), 0.0);
+    const size_t seg_idx = autoware_utils::findNearestSegmentIndex(traj.points, target_msg);
+
+    EXPECT_EQ(table.findNearestSegmentIndex(target), seg_idx);
+    EXPECT_NEAR(
+      table.calcLongitudinalOffsetToSegment(5, target),
+      autoware_utils::calcLongitudinalOffsetToSegment(traj.points, 5, target_msg), epsilon);
+    EXPECT_NEAR(
+      table.calcSignedArcLength(target, 7),
+      autoware_utils::calcSignedArcLength(traj.points, target_msg, 7), epsilon);
+
+    // Any hint finds the same segment, since the trajectory doesn't come back
+    for (const size_t hint_idx : {size_t{0}, size_t{10}, size_t{19}, size_t{100}}) {
+      EXPECT_EQ(table.findNearestSegmentIndex(target, hint_idx), seg_idx);
+      EXPECT_NEAR(
+        table.calcSignedArcLength(target, 7, hint_idx),
+        autoware_utils::calcSignedArcLength(traj.points, target_msg, 7), epsilon);
+    }
+  }
+}
+
+TEST(arc_length_table, hintOnLoop)
+{
+  // Loop passing near the start point again at the end
+  Trajectory traj;
+  for (size_t i = 0; i <= 36; ++i) {
+    const double theta = i * 10.0 * M_PI / 180.0;
+    autoware_planning_msgs::msg::TrajectoryPoint p;
+    p.pose.position = createPoint(10.0 * std::sin(theta), 10.0 - 10.0 * std::cos(theta), 0.0);
+    traj.points.push_back(p);
+  }
+  const ArcLengthTable table(traj.points);
+
+  // Near the start, the hint selects which pass of the loop is searched
+  const Point2d point(0.5, 0.1);
+  EXPECT_EQ(table.findNearestSegmentIndex(point, 0), 0U);
+  EXPECT_EQ(table.findNearestSegmentIndex(point, 34), 35U);
+  EXPECT_NEAR(table.calcArcLength(point, 0), 0.5, 0.1);
+  EXPECT_NEAR(table.calcArcLength(point, 34), table.getLength() + 0.5, 0.1);
+}
+
+TEST(arc_length_table, samePoints)
+{
+  Trajectory traj;
+  for (const double x : {0.0, 1.0, 1.0, 2.0}) {
+    autoware_planning_msgs::msg::TrajectoryPoint p;
+    p.pose.position = createPoint(x, 0.0, 0.0);
+    traj.points.push_back(p);
+  }
+  const ArcLengthTable table(traj.points);
+
+  EXPECT_DOUBLE_EQ(table.getLength(), 2.0);
+  EXPECT_THROW(table.calcLongitudinalOffsetToSegment(1, Point2d(1.5, 0.0)), std::runtime_error);
+}
@@ -0,0 +1,129 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_utils/trajectory/point_span.hpp"
+#include "autoware_utils/trajectory/trajectory.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+using autoware_planning_msgs::msg::Trajectory;
+using autoware_utils::createPoint;
+using autoware_utils::Point2d;
+using autoware_utils::PointSpan2d;
+
+constexpr double epsilon = 1e-6;
+
+Trajectory generateCurvedTrajectory(const size_t num_points, const double point_interval)
+{
+  Trajectory traj;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = i * 0.05;
+    autoware_planning_msgs::msg::TrajectoryPoint p;
+    p.pose.position = createPoint(
+      i * point_interval * std::cos(theta), i * point_interval * std::sin(theta), 0.0);
+    traj.points.push_back(p);
+  }
+  return traj;
+}
+}  // namespace
+
+TEST(point_span, toPoint2dArray)
+{
+  const auto traj = generateCurvedTrajectory(10, 1.0);
+  const auto points = autoware_utils::toPoint2dArray(traj.points);
+
+  ASSERT_EQ(points.size(), traj.points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_DOUBLE_EQ(points.at(i).x(), traj.points.at(i).pose.position.x);
+    EXPECT_DOUBLE_EQ(points.at(i).y(), traj.points.at(i).pose.position.y);
+  }
+}
+
+TEST(point_span, calcCumulativeArcLength)
+{
+  using autoware_utils::calcCumulativeArcLength;
+
+  // Empty
+  std::vector<double> arc_lengths;
+  EXPECT_THROW(calcCumulativeArcLength(std::vector<Point2d>{}, arc_lengths), std::invalid_argument);
+
+  // Single point
+  calcCumulativeArcLength(std::vector<Point2d>{Point2d(1.0, 1.0)}, arc_lengths);
+  ASSERT_EQ(arc_lengths.size(), 1U);
+  EXPECT_DOUBLE_EQ(arc_lengths.front(), 0.0);
+
+  // Same as calcSignedArcLength of the message
+  const auto traj = generateCurvedTrajectory(20, 1.5);
+  const auto points = autoware_utils::toPoint2dArray(traj.points);
+  calcCumulativeArcLength(points, arc_lengths);
+  ASSERT_EQ(arc_lengths.size(), points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_NEAR(arc_lengths.at(i), autoware_utils::calcSignedArcLength(traj.points, 0, i), epsilon);
+  }
+}
+
+TEST(point_span, sameAsMessageOverloads)
+{
+  const auto traj = generateCurvedTrajectory(20, 1.5);
+  const auto points_2d = autoware_utils::toPoint2dArray(traj.points);
+  const PointSpan2d points(points_2d);
+
+  std::vector<double> arc_lengths;
+  autoware_utils::calcCumulativeArcLength(points, arc_lengths);
+
+  EXPECT_NEAR(
+    autoware_utils::calcArcLength(points), autoware_utils::calcArcLength(traj.points), epsilon);
+  EXPECT_NEAR(
+    autoware_utils::calcSignedArcLength(points, 15, 3),
+    autoware_utils::calcSignedArcLength(traj.points, 15, 3), epsilon);
+
+  const std::vector<Point2d> targets{
+    Point2d(-1.0, 0.0), Point2d(3.2, 1.0), Point2d(10.0, 5.0), Point2d(25.0, 15.0)};
+  for (const auto & src : targets) {
+    const auto src_msg = createPoint(src.x(), src.y(), 0.0);
+
+    EXPECT_EQ(
+      autoware_utils::findNearestIndex(points, src),
+      autoware_utils::findNearestIndex(traj.points, src_msg));
+    EXPECT_EQ(
+      autoware_utils::findNearestSegmentIndex(points, src),
+      autoware_utils::findNearestSegmentIndex(traj.points, src_msg));
+    EXPECT_NEAR(
+      autoware_utils::calcLongitudinalOffsetToSegment(points, 5, src),
+      autoware_utils::calcLongitudinalOffsetToSegment(traj.points, 5, src_msg), epsilon);
+
+    for (const auto & dst : targets) {
+      const auto dst_msg = createPoint(dst.x(), dst.y(), 0.0);
+      EXPECT_NEAR(
+        autoware_utils::calcSignedArcLength(points, arc_lengths, src, dst),
+        autoware_utils::calcSignedArcLength(traj.points, src_msg, dst_msg), epsilon);
+    }
+  }
+
+  // The message overloads also accept Point2d arrays
+  EXPECT_NEAR(
+    autoware_utils::calcArcLength(points_2d), autoware_utils::calcArcLength(traj.points), epsilon);
+
+  // Size of arc_lengths is different
+  arc_lengths.pop_back();
+  EXPECT_THROW(
+    autoware_utils::calcSignedArcLength(points, arc_lengths, targets.front(), targets.back()),
+    std::invalid_argument);
+}
@@ -200,6 +200,34 @@ TEST(trajectory, findNearestIndex_Pos_CurvedTrajectory)
   EXPECT_EQ(findNearestIndex(traj.points, createPoint(5.1, 3.4, 0.0)), 6U);
 }
 
+TEST(trajectory, findNearestIndex_Pos_Hint)
+{
+  using autoware_utils::findNearestIndex;
+
+  const auto traj = generateTestTrajectory<Trajectory>(10, 1.0);
+
+  // Empty
+  EXPECT_THROW(
+    findNearestIndex(Trajectory{}.points, geometry_msgs::msg::Point{}, 0, 2),
+    std::invalid_argument);
+
+  // Nearest inside the window
+  EXPECT_EQ(findNearestIndex(traj.points, createPoint(4.0, 0.0, 0.0), 3, 2), 4U);
+  EXPECT_EQ(findNearestIndex(traj.points, createPoint(0.0, 0.0, 0.0), 1, 2), 0U);
+  EXPECT_EQ(findNearestIndex(traj.points, createPoint(100.0, -3.0, 0.0), 8, 2), 9U);
+
+  // Nearest outside the window
+  EXPECT_EQ(findNearestIndex(traj.points, createPoint(8.0, 0.0, 0.0), 2, 2), 8U);
+  EXPECT_EQ(findNearestIndex(traj.points, createPoint(1.0, 0.0, 0.0), 7, 2), 1U);
+
+  // Hint out of range
+  EXPECT_EQ(findNearestIndex(traj.points, createPoint(5.0, 0.0, 0.0), 20, 2), 5U);
+
+  // Zero search range
+  EXPECT_EQ(findNearestIndex(traj.points, createPoint(5.0, 0.0, 0.0), 5, 0), 5U);
+  EXPECT_EQ(findNearestIndex(traj.points, createPoint(6.0, 0.0, 0.0), 5, 0), 6U);
+}
+
 TEST(trajectory, findNearestIndex_Pose_NoThreshold)
 {
   using autoware_utils::findNearestIndex;
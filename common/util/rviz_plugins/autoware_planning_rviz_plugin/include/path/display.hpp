@@ -24,6 +24,7 @@
 #include <rviz_common/properties/float_property.hpp>
 #include <rviz_common/properties/parse_color.hpp>
 #include <rviz_common/validate_floats.hpp>
+#include <tools/incremental_rendering.hpp>
 
 #include <autoware_planning_msgs/msg/path.hpp>
 
@@ -35,6 +36,7 @@
 
 #include <deque>
 #include <memory>
+#include <vector>
 
 namespace rviz_plugins
 {
@@ -49,6 +51,7 @@ public:
 
   void onInitialize() override;
   void reset() override;
+  void update(float wall_dt, float ros_dt) override;
 
 private Q_SLOTS:
   void updateVisualization();
@@ -72,9 +75,12 @@ protected:
   rviz_common::properties::BoolProperty * property_path_color_view_;
   rviz_common::properties::BoolProperty * property_velocity_color_view_;
   rviz_common::properties::FloatProperty * property_vel_max_;
+  rviz_common::properties::FloatProperty * property_decimation_;
 
 private:
-  autoware_planning_msgs::msg::Path::ConstSharedPtr last_msg_ptr_;
+  RebuildScheduler<autoware_planning_msgs::msg::Path> rebuild_scheduler_;
+  void updateGeometry(
+    const autoware_planning_msgs::msg::Path & msg, const std::vector<size_t> & indices);
   bool validateFloats(const autoware_planning_msgs::msg::Path::ConstSharedPtr & msg_ptr);
 };
 
@@ -24,6 +24,7 @@
 #include <rviz_common/properties/float_property.hpp>
 #include <rviz_common/properties/parse_color.hpp>
 #include <rviz_common/validate_floats.hpp>
+#include <tools/incremental_rendering.hpp>
 
 #include <autoware_planning_msgs/msg/path.hpp>
 
@@ -34,6 +35,7 @@
 #include <OgreSceneNode.h>
 
 #include <memory>
+#include <vector>
 
 namespace rviz_plugins
 {
@@ -48,6 +50,7 @@ public:
 
   void onInitialize() override;
   void reset() override;
+  void update(float wall_dt, float ros_dt) override;
 
 private Q_SLOTS:
   void updateVisualization();
@@ -62,6 +65,7 @@ protected:
   rviz_common::properties::FloatProperty * property_vehicle_length_;
   rviz_common::properties::FloatProperty * property_vehicle_width_;
   rviz_common::properties::FloatProperty * property_rear_overhang_;
+  rviz_common::properties::FloatProperty * property_decimation_;
 
   struct VehicleFootprintInfo
   {
@@ -74,7 +78,9 @@ protected:
   std::shared_ptr<VehicleFootprintInfo> vehicle_footprint_info_;
 
 private:
-  autoware_planning_msgs::msg::Path::ConstSharedPtr last_msg_ptr_;
+  RebuildScheduler<autoware_planning_msgs::msg::Path> rebuild_scheduler_;
+  void updateGeometry(
+    const autoware_planning_msgs::msg::Path & msg, const std::vector<size_t> & indices);
   bool validateFloats(const autoware_planning_msgs::msg::Path::ConstSharedPtr & msg_ptr);
 };
 
@@ -0,0 +1,151 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOOLS__INCREMENTAL_RENDERING_HPP_
+#define TOOLS__INCREMENTAL_RENDERING_HPP_
+
+#include <rviz_common/display_context.hpp>
+
+#include <OgreCamera.h>
+#include <OgreManualObject.h>
+#include <OgreSceneNode.h>
+#include <OgreVector3.h>
+
+#include <vector>
+
+namespace rviz_plugins
+{
+/**
+ * @brief start to write the vertices of a manual object. The section and its hardware buffer are
+ * kept across the updates, and the buffer grows by powers of two so that it is rarely reallocated.
+ */
+void beginManualObject(
+  Ogre::ManualObject * manual_object, const size_t vertex_count,
+  const Ogre::RenderOperation::OperationType operation_type);
+
+/**
+ * @brief camera of the current view, or nullptr
+ */
+const Ogre::Camera * getCurrentCamera(rviz_common::DisplayContext * context);
+
+/**
+ * @brief size(m) of a pixel at a position in the world frame, or 0 if it is unknown
+ */
+double calcPixelSize(const Ogre::Camera * camera, const Ogre::Vector3 & world_position);
+
+/**
+ * @brief indices of the points to render, skipping the points which are closer than min_pixels on
+ * the screen to the previously rendered one. The first and the last points are always rendered.
+ */
+template <class PointT>
+std::vector<size_t> decimateByScreenDistance(
+  const std::vector<PointT> & points, Ogre::SceneNode * scene_node, const Ogre::Camera * camera,
+  const double min_pixels)
+{
+  std::vector<size_t> indices;
+  indices.reserve(points.size());
+
+  Ogre::Vector3 prev_world_position;
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto & position = points.at(i).pose.position;
+    const auto world_position =
+      scene_node->convertLocalToWorldPosition(Ogre::Vector3(position.x, position.y, position.z));
+
+    const bool is_end = i == 0 || i + 1 == points.size();
+    if (!is_end && min_pixels > 0.0) {
+      const double pixel_size = calcPixelSize(camera, world_position);
+      if (world_position.distance(prev_world_position) < min_pixels * pixel_size) {
+        continue;
+      }
+    }
+
+    indices.push_back(i);
+    prev_world_position = world_position;
+  }
+
+  return indices;
+}
+
+/**
+ * @brief Decides when to rebuild the geometry of a display. Messages and property changes are
+ * coalesced into one rebuild per frame. A message whose points are equal to the built ones is not
+ * rebuilt, unless the camera has zoomed enough to change the decimation.
+ */
+template <class MsgT>
+class RebuildScheduler
+{
+public:
+  void setMessage(const typename MsgT::ConstSharedPtr & msg_ptr)
+  {
+    latest_msg_ptr_ = msg_ptr;
+    is_msg_updated_ = true;
+  }
+
+  void requestRebuild() { is_rebuild_requested_ = true; }
+
+  void reset()
+  {
+    latest_msg_ptr_ = nullptr;
+    built_msg_ptr_ = nullptr;
+    is_msg_updated_ = false;
+    is_rebuild_requested_ = false;
+    built_pixel_size_ = 0.0;
+  }
+
+  const typename MsgT::ConstSharedPtr & getLatestMessage() const { return latest_msg_ptr_; }
+
+  /**
+   * @brief judge whether to rebuild the latest message in this frame
+   * @param pixel_size size(m) of a pixel at the geometry, 0 if the decimation is disabled
+   */
+  bool isRebuildNeeded(const double pixel_size)
+  {
+    if (!latest_msg_ptr_) {
+      return false;
+    }
+
+    bool is_needed = is_rebuild_requested_ || !built_msg_ptr_;
+    if (!is_needed && is_msg_updated_) {
+      is_needed = latest_msg_ptr_->points != built_msg_ptr_->points;
+    }
+    if (!is_needed && pixel_size > 0.0) {
+      is_needed = built_pixel_size_ <= 0.0 || pixel_size > built_pixel_size_ * zoom_ratio_ ||
+                  pixel_size * zoom_ratio_ < built_pixel_size_;
+    }
+    is_msg_updated_ = false;
+
+    if (!is_needed) {
+      return false;
+    }
+
+    built_msg_ptr_ = latest_msg_ptr_;
+    built_pixel_size_ = pixel_size;
+    is_rebuild_requested_ = false;
+    return true;
+  }
+
+private:
+  typename MsgT::ConstSharedPtr latest_msg_ptr_;
+  typename MsgT::ConstSharedPtr built_msg_ptr_;
+  bool is_msg_updated_ = false;
+  bool is_rebuild_requested_ = false;
+  double built_pixel_size_ = 0.0;
+
+  // zoom to rebuild the decimated geometry
+  const double zoom_ratio_ = 1.5;
+};
+
+}  // namespace rviz_plugins
+
+#endif  // TOOLS__INCREMENTAL_RENDERING_HPP_
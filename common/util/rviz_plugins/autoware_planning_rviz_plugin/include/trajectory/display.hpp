@@ -25,6 +25,7 @@
 #include <rviz_common/properties/parse_color.hpp>
 #include <rviz_common/validate_floats.hpp>
 #include <rviz_rendering/objects/movable_text.hpp>
+#include <tools/incremental_rendering.hpp>
 
 #include <autoware_planning_msgs/msg/trajectory.hpp>
 
@@ -51,6 +52,7 @@ public:
 
   void onInitialize() override;
   void reset() override;
+  void update(float wall_dt, float ros_dt) override;
 
 private Q_SLOTS:
   void updateVisualization();
@@ -79,9 +81,12 @@ protected:
   rviz_common::properties::BoolProperty * property_path_color_view_;
   rviz_common::properties::BoolProperty * property_velocity_color_view_;
   rviz_common::properties::FloatProperty * property_vel_max_;
+  rviz_common::properties::FloatProperty * property_decimation_;
 
 private:
-  autoware_planning_msgs::msg::Trajectory::ConstSharedPtr last_msg_ptr_;
+  RebuildScheduler<autoware_planning_msgs::msg::Trajectory> rebuild_scheduler_;
+  void updateGeometry(
+    const autoware_planning_msgs::msg::Trajectory & msg, const std::vector<size_t> & indices);
   bool validateFloats(const autoware_planning_msgs::msg::Trajectory::ConstSharedPtr & msg_ptr);
 };
 
@@ -24,6 +24,7 @@
 #include <rviz_common/properties/float_property.hpp>
 #include <rviz_common/properties/parse_color.hpp>
 #include <rviz_common/validate_floats.hpp>
+#include <tools/incremental_rendering.hpp>
 
 #include <autoware_planning_msgs/msg/trajectory.hpp>
 
@@ -34,6 +35,7 @@
 #include <OgreSceneNode.h>
 
 #include <memory>
+#include <vector>
 
 namespace rviz_plugins
 {
@@ -48,6 +50,7 @@ public:
 
   void onInitialize() override;
   void reset() override;
+  void update(float wall_dt, float ros_dt) override;
 
 private Q_SLOTS:
   void updateVisualization();
@@ -71,6 +74,8 @@ protected:
   rviz_common::properties::FloatProperty * property_trajectory_point_radius_;
   rviz_common::properties::FloatProperty * property_trajectory_point_offset_;
 
+  rviz_common::properties::FloatProperty * property_decimation_;
+
   struct VehicleFootprintInfo
   {
     VehicleFootprintInfo(const float l, const float w, const float r)
@@ -82,7 +87,9 @@ protected:
   std::shared_ptr<VehicleFootprintInfo> vehicle_footprint_info_;
 
 private:
-  autoware_planning_msgs::msg::Trajectory::ConstSharedPtr last_msg_ptr_;
+  RebuildScheduler<autoware_planning_msgs::msg::Trajectory> rebuild_scheduler_;
+  void updateGeometry(
+    const autoware_planning_msgs::msg::Trajectory & msg, const std::vector<size_t> & indices);
   bool validateFloats(const autoware_planning_msgs::msg::Trajectory::ConstSharedPtr & msg_ptr);
 };
 
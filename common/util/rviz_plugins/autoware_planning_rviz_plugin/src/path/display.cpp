@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include <path/display.hpp>
+#include <tools/incremental_rendering.hpp>
 
 #include <memory>
+#include <vector>
 #define EIGEN_MPL2_ONLY
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Geometry>
@@ -88,6 +90,10 @@ AutowarePathDisplay::AutowarePathDisplay()
   property_vel_max_ = new rviz_common::properties::FloatProperty(
     "Color Border Vel Max", 3.0, "[m/s]", this, SLOT(updateVisualization()), this);
   property_vel_max_->setMin(0.0);
+  property_decimation_ = new rviz_common::properties::FloatProperty(
+    "Decimation", 1.0, "minimum distance [px] between the rendered points, 0 to render all", this,
+    SLOT(updateVisualization()), this);
+  property_decimation_->setMin(0.0);
 }
 
 AutowarePathDisplay::~AutowarePathDisplay()
@@ -108,6 +114,11 @@ void AutowarePathDisplay::onInitialize()
   velocity_manual_object_->setDynamic(true);
   scene_node_->attachObject(path_manual_object_);
   scene_node_->attachObject(velocity_manual_object_);
+
+  Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
+    "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+  material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
+  material->setDepthWriteEnabled(false);
 }
 
 void AutowarePathDisplay::reset()
@@ -115,6 +126,7 @@ void AutowarePathDisplay::reset()
   MFDClass::reset();
   path_manual_object_->clear();
   velocity_manual_object_->clear();
+  rebuild_scheduler_.reset();
 }
 
 bool AutowarePathDisplay::validateFloats(
@@ -151,105 +163,116 @@ void AutowarePathDisplay::processMessage(
   scene_node_->setPosition(position);
   scene_node_->setOrientation(orientation);
 
-  path_manual_object_->clear();
-  velocity_manual_object_->clear();
+  // the geometry is rebuilt in update() at most once a frame
+  rebuild_scheduler_.setMessage(msg_ptr);
+}
 
-  Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
-    "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-  material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
-  material->setDepthWriteEnabled(false);
+void AutowarePathDisplay::update(float wall_dt, float ros_dt)
+{
+  MFDClass::update(wall_dt, ros_dt);
 
-  if (!msg_ptr->points.empty()) {
-    path_manual_object_->estimateVertexCount(msg_ptr->points.size() * 2);
-    velocity_manual_object_->estimateVertexCount(msg_ptr->points.size());
-    path_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_TRIANGLE_STRIP);
-    // path_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_TRIANGLE_STRIP);
-    velocity_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_STRIP);
-
-    for (auto && path_point : msg_ptr->points) {
-      /*
-       * Path
-       */
-      if (property_path_view_->getBool()) {
-        Ogre::ColourValue color;
-        if (property_path_color_view_->getBool()) {
-          color = rviz_common::properties::qtToOgre(property_path_color_->getColor());
-        } else {
-          /* color change depending on velocity */
-          std::unique_ptr<Ogre::ColourValue> dynamic_color_ptr =
-            setColorDependsOnVelocity(property_vel_max_->getFloat(), path_point.twist.linear.x);
-          color = *dynamic_color_ptr;
-        }
-        color.a = property_path_alpha_->getFloat();
-        Eigen::Vector3f vec_in, vec_out;
-        Eigen::Quaternionf quat_yaw_reverse(0, 0, 0, 1);
-        {
-          vec_in << 0, (property_path_width_->getFloat() / 2.0), 0;
-          Eigen::Quaternionf quat(
-            path_point.pose.orientation.w, path_point.pose.orientation.x,
-            path_point.pose.orientation.y, path_point.pose.orientation.z);
-          if (path_point.twist.linear.x < 0) {
-            quat *= quat_yaw_reverse;
-            vec_in = -vec_in;
-          }
-          vec_out = quat * vec_in;
-          path_manual_object_->position(
-            path_point.pose.position.x + vec_out.x(), path_point.pose.position.y + vec_out.y(),
-            path_point.pose.position.z + vec_out.z());
-          path_manual_object_->colour(color);
-        }
-        {
-          vec_in << 0, -(property_path_width_->getFloat() / 2.0), 0;
-          Eigen::Quaternionf quat(
-            path_point.pose.orientation.w, path_point.pose.orientation.x,
-            path_point.pose.orientation.y, path_point.pose.orientation.z);
-          if (path_point.twist.linear.x < 0) {
-            quat *= quat_yaw_reverse;
-            vec_in = -vec_in;
-          }
-          vec_out = quat * vec_in;
-          path_manual_object_->position(
-            path_point.pose.position.x + vec_out.x(), path_point.pose.position.y + vec_out.y(),
-            path_point.pose.position.z + vec_out.z());
-          path_manual_object_->colour(color);
-        }
-      }
-      /*
-       * Velocity
-       */
-      if (property_velocity_view_->getBool()) {
-        Ogre::ColourValue color;
-        if (property_velocity_color_view_->getBool()) {
-          color = rviz_common::properties::qtToOgre(property_velocity_color_->getColor());
-        } else {
-          /* color change depending on velocity */
-          std::unique_ptr<Ogre::ColourValue> dynamic_color_ptr =
-            setColorDependsOnVelocity(property_vel_max_->getFloat(), path_point.twist.linear.x);
-          color = *dynamic_color_ptr;
-        }
-        color.a = property_velocity_alpha_->getFloat();
-
-        velocity_manual_object_->position(
-          path_point.pose.position.x, path_point.pose.position.y,
-          path_point.pose.position.z +
-            path_point.twist.linear.x * property_velocity_scale_->getFloat());
-        velocity_manual_object_->colour(color);
-      }
-    }
+  const auto msg_ptr = rebuild_scheduler_.getLatestMessage();
+  if (!msg_ptr) {
+    return;
+  }
 
-    path_manual_object_->end();
-    velocity_manual_object_->end();
+  const auto camera = getCurrentCamera(context_);
+  const double min_pixels = property_decimation_->getFloat();
+  double pixel_size = 0.0;
+  if (min_pixels > 0.0 && !msg_ptr->points.empty()) {
+    const auto & position = msg_ptr->points.front().pose.position;
+    pixel_size = calcPixelSize(
+      camera,
+      scene_node_->convertLocalToWorldPosition(Ogre::Vector3(position.x, position.y, position.z)));
   }
-  last_msg_ptr_ = msg_ptr;
+
+  if (!rebuild_scheduler_.isRebuildNeeded(pixel_size)) {
+    return;
+  }
+
+  const auto indices = decimateByScreenDistance(msg_ptr->points, scene_node_, camera, min_pixels);
+  updateGeometry(*msg_ptr, indices);
 }
 
-void AutowarePathDisplay::updateVisualization()
+void AutowarePathDisplay::updateGeometry(
+  const autoware_planning_msgs::msg::Path & msg, const std::vector<size_t> & indices)
 {
-  if (last_msg_ptr_ != nullptr) {
-    processMessage(last_msg_ptr_);
+  const bool is_path_view = property_path_view_->getBool();
+  const bool is_velocity_view = property_velocity_view_->getBool();
+
+  beginManualObject(
+    path_manual_object_, is_path_view ? indices.size() * 2 : 0,
+    Ogre::RenderOperation::OT_TRIANGLE_STRIP);
+  beginManualObject(
+    velocity_manual_object_, is_velocity_view ? indices.size() : 0,
+    Ogre::RenderOperation::OT_LINE_STRIP);
+
+  const float half_width = property_path_width_->getFloat() / 2.0;
+  const float vel_max = property_vel_max_->getFloat();
+  const Eigen::Quaternionf quat_yaw_reverse(0, 0, 0, 1);
+
+  for (size_t point_idx = 0; point_idx < indices.size(); point_idx++) {
+    const auto & path_point = msg.points.at(indices.at(point_idx));
+    const auto & position = path_point.pose.position;
+    const double velocity = path_point.twist.linear.x;
+
+    /* color change depending on velocity */
+    Ogre::ColourValue velocity_color;
+    if (
+      (is_path_view && !property_path_color_view_->getBool()) ||
+      (is_velocity_view && !property_velocity_color_view_->getBool())) {
+      velocity_color = *setColorDependsOnVelocity(vel_max, velocity);
+    }
+
+    /*
+     * Path
+     */
+    if (is_path_view) {
+      Ogre::ColourValue color =
+        property_path_color_view_->getBool()
+          ? rviz_common::properties::qtToOgre(property_path_color_->getColor())
+          : velocity_color;
+      color.a = property_path_alpha_->getFloat();
+
+      Eigen::Quaternionf quat(
+        path_point.pose.orientation.w, path_point.pose.orientation.x,
+        path_point.pose.orientation.y, path_point.pose.orientation.z);
+      Eigen::Vector3f vec_in(0, half_width, 0);
+      if (velocity < 0) {
+        quat *= quat_yaw_reverse;
+        vec_in = -vec_in;
+      }
+      const Eigen::Vector3f vec_out = quat * vec_in;
+
+      path_manual_object_->position(
+        position.x + vec_out.x(), position.y + vec_out.y(), position.z + vec_out.z());
+      path_manual_object_->colour(color);
+      path_manual_object_->position(
+        position.x - vec_out.x(), position.y - vec_out.y(), position.z - vec_out.z());
+      path_manual_object_->colour(color);
+    }
+    /*
+     * Velocity
+     */
+    if (is_velocity_view) {
+      Ogre::ColourValue color =
+        property_velocity_color_view_->getBool()
+          ? rviz_common::properties::qtToOgre(property_velocity_color_->getColor())
+          : velocity_color;
+      color.a = property_velocity_alpha_->getFloat();
+
+      velocity_manual_object_->position(
+        position.x, position.y, position.z + velocity * property_velocity_scale_->getFloat());
+      velocity_manual_object_->colour(color);
+    }
   }
+
+  path_manual_object_->end();
+  velocity_manual_object_->end();
 }
 
+void AutowarePathDisplay::updateVisualization() { rebuild_scheduler_.requestRebuild(); }
+
 }  // namespace rviz_plugins
 
 #include <pluginlib/class_list_macros.hpp>
@@ -12,12 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
 #include <memory>
+#include <vector>
 
 #define EIGEN_MPL2_ONLY
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Geometry>
 #include <path_footprint/display.hpp>
+#include <tools/incremental_rendering.hpp>
 
 namespace rviz_plugins
 {
@@ -42,6 +45,11 @@ AutowarePathFootprintDisplay::AutowarePathFootprintDisplay()
   property_vehicle_width_->setMin(0.0);
   property_rear_overhang_->setMin(0.0);
 
+  property_decimation_ = new rviz_common::properties::FloatProperty(
+    "Decimation", 1.0, "minimum distance [px] between the rendered points, 0 to render all", this,
+    SLOT(updateVisualization()), this);
+  property_decimation_->setMin(0.0);
+
   updateVehicleInfo();
 }
 
@@ -59,12 +67,18 @@ void AutowarePathFootprintDisplay::onInitialize()
   path_footprint_manual_object_ = scene_manager_->createManualObject();
   path_footprint_manual_object_->setDynamic(true);
   scene_node_->attachObject(path_footprint_manual_object_);
+
+  Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
+    "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+  material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
+  material->setDepthWriteEnabled(false);
 }
 
 void AutowarePathFootprintDisplay::reset()
 {
   MFDClass::reset();
   path_footprint_manual_object_->clear();
+  rebuild_scheduler_.reset();
 }
 
 bool AutowarePathFootprintDisplay::validateFloats(
@@ -102,76 +116,96 @@ void AutowarePathFootprintDisplay::processMessage(
   scene_node_->setPosition(position);
   scene_node_->setOrientation(orientation);
 
-  path_footprint_manual_object_->clear();
+  // the geometry is rebuilt in update() at most once a frame
+  rebuild_scheduler_.setMessage(msg_ptr);
+}
 
-  Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
-    "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-  material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
-  material->setDepthWriteEnabled(false);
+void AutowarePathFootprintDisplay::update(float wall_dt, float ros_dt)
+{
+  MFDClass::update(wall_dt, ros_dt);
 
-  if (!msg_ptr->points.empty()) {
-    path_footprint_manual_object_->estimateVertexCount(msg_ptr->points.size() * 4 * 2);
-    path_footprint_manual_object_->begin(
-      "BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_LIST);
-
-    for (size_t point_idx = 0; point_idx < msg_ptr->points.size(); point_idx++) {
-      const auto & path_point = msg_ptr->points.at(point_idx);
-      /*
-       * Footprint
-       */
-      if (property_path_footprint_view_->getBool()) {
-        Ogre::ColourValue color;
-        color = rviz_common::properties::qtToOgre(property_path_footprint_color_->getColor());
-        color.a = property_path_footprint_alpha_->getFloat();
-
-        const auto info = vehicle_footprint_info_;
-        const float top = info->length - info->rear_overhang;
-        const float bottom = -info->rear_overhang;
-        const float left = -info->width / 2.0;
-        const float right = info->width / 2.0;
-
-        const std::array<float, 4> lon_offset_vec{top, top, bottom, bottom};
-        const std::array<float, 4> lat_offset_vec{left, right, right, left};
-
-        for (int f_idx = 0; f_idx < 4; ++f_idx) {
-          const Eigen::Quaternionf quat(
-            path_point.pose.orientation.w, path_point.pose.orientation.x,
-            path_point.pose.orientation.y, path_point.pose.orientation.z);
-
-          {
-            const Eigen::Vector3f offset_vec{
-              lon_offset_vec.at(f_idx), lat_offset_vec.at(f_idx), 0.0};
-            const auto offset_to_edge = quat * offset_vec;
-            path_footprint_manual_object_->position(
-              path_point.pose.position.x + offset_to_edge.x(),
-              path_point.pose.position.y + offset_to_edge.y(), path_point.pose.position.z);
-            path_footprint_manual_object_->colour(color);
-          }
-          {
-            const Eigen::Vector3f offset_vec{
-              lon_offset_vec.at((f_idx + 1) % 4), lat_offset_vec.at((f_idx + 1) % 4), 0.0};
-            const auto offset_to_edge = quat * offset_vec;
-            path_footprint_manual_object_->position(
-              path_point.pose.position.x + offset_to_edge.x(),
-              path_point.pose.position.y + offset_to_edge.y(), path_point.pose.position.z);
-            path_footprint_manual_object_->colour(color);
-          }
-        }
-      }
-    }
+  const auto msg_ptr = rebuild_scheduler_.getLatestMessage();
+  if (!msg_ptr) {
+    return;
+  }
 
-    path_footprint_manual_object_->end();
+  const auto camera = getCurrentCamera(context_);
+  const double min_pixels = property_decimation_->getFloat();
+  double pixel_size = 0.0;
+  if (min_pixels > 0.0 && !msg_ptr->points.empty()) {
+    const auto & position = msg_ptr->points.front().pose.position;
+    pixel_size = calcPixelSize(
+      camera,
+      scene_node_->convertLocalToWorldPosition(Ogre::Vector3(position.x, position.y, position.z)));
   }
-  last_msg_ptr_ = msg_ptr;
+
+  if (!rebuild_scheduler_.isRebuildNeeded(pixel_size)) {
+    return;
+  }
+
+  const auto indices = decimateByScreenDistance(msg_ptr->points, scene_node_, camera, min_pixels);
+  updateGeometry(*msg_ptr, indices);
 }
 
-void AutowarePathFootprintDisplay::updateVisualization()
+void AutowarePathFootprintDisplay::updateGeometry(
+  const autoware_planning_msgs::msg::Path & msg, const std::vector<size_t> & indices)
 {
-  if (last_msg_ptr_ != nullptr) {
-    processMessage(last_msg_ptr_);
+  const bool is_footprint_view = property_path_footprint_view_->getBool();
+
+  beginManualObject(
+    path_footprint_manual_object_, is_footprint_view ? indices.size() * 4 * 2 : 0,
+    Ogre::RenderOperation::OT_LINE_LIST);
+
+  Ogre::ColourValue footprint_color =
+    rviz_common::properties::qtToOgre(property_path_footprint_color_->getColor());
+  footprint_color.a = property_path_footprint_alpha_->getFloat();
+
+  const auto info = vehicle_footprint_info_;
+  const float top = info->length - info->rear_overhang;
+  const float bottom = -info->rear_overhang;
+  const float left = -info->width / 2.0;
+  const float right = info->width / 2.0;
+  const std::array<Eigen::Vector3f, 4> footprint_corners{
+    Eigen::Vector3f{top, left, 0.0}, Eigen::Vector3f{top, right, 0.0},
+    Eigen::Vector3f{bottom, right, 0.0}, Eigen::Vector3f{bottom, left, 0.0}};
+
+  for (const auto point_idx : indices) {
+    const auto & path_point = msg.points.at(point_idx);
+    /*
+     * Footprint
+     */
+    if (is_footprint_view) {
+      const Eigen::Quaternionf quat(
+        path_point.pose.orientation.w, path_point.pose.orientation.x,
+        path_point.pose.orientation.y, path_point.pose.orientation.z);
+
+      std::array<Eigen::Vector3f, 4> offsets_to_edge;
+      for (size_t f_idx = 0; f_idx < 4; ++f_idx) {
+        offsets_to_edge.at(f_idx) = quat * footprint_corners.at(f_idx);
+      }
+
+      for (size_t f_idx = 0; f_idx < 4; ++f_idx) {
+        const auto & offset_to_edge = offsets_to_edge.at(f_idx);
+        path_footprint_manual_object_->position(
+          path_point.pose.position.x + offset_to_edge.x(),
+          path_point.pose.position.y + offset_to_edge.y(), path_point.pose.position.z);
+        path_footprint_manual_object_->colour(footprint_color);
+
+        const auto & offset_to_next_edge = offsets_to_edge.at((f_idx + 1) % 4);
+        path_footprint_manual_object_->position(
+          path_point.pose.position.x + offset_to_next_edge.x(),
+          path_point.pose.position.y + offset_to_next_edge.y(), path_point.pose.position.z);
+        path_footprint_manual_object_->colour(footprint_color);
+      }
+    }
+
   }
+
+  path_footprint_manual_object_->end();
 }
 
+void AutowarePathFootprintDisplay::updateVisualization() { rebuild_scheduler_.requestRebuild(); }
+
 void AutowarePathFootprintDisplay::updateVehicleInfo()
 {
   float length{property_vehicle_length_->getFloat()};
@@ -179,6 +213,7 @@ void AutowarePathFootprintDisplay::updateVehicleInfo()
   float rear_overhang{property_rear_overhang_->getFloat()};
 
   vehicle_footprint_info_ = std::make_shared<VehicleFootprintInfo>(length, width, rear_overhang);
+  rebuild_scheduler_.requestRebuild();
 }
 
 }  // namespace rviz_plugins
@@ -0,0 +1,67 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rviz_common/view_controller.hpp>
+#include <rviz_common/view_manager.hpp>
+#include <tools/incremental_rendering.hpp>
+
+#include <OgreViewport.h>
+
+#include <cmath>
+
+namespace rviz_plugins
+{
+void beginManualObject(
+  Ogre::ManualObject * manual_object, const size_t vertex_count,
+  const Ogre::RenderOperation::OperationType operation_type)
+{
+  // the buffer is reallocated only when the vertices exceed it
+  size_t buffer_size = 64;
+  while (buffer_size < vertex_count) {
+    buffer_size *= 2;
+  }
+  manual_object->estimateVertexCount(buffer_size);
+
+  if (manual_object->getNumSections() > 0) {
+    manual_object->beginUpdate(0);
+  } else {
+    manual_object->begin("BaseWhiteNoLighting", operation_type);
+  }
+}
+
+const Ogre::Camera * getCurrentCamera(rviz_common::DisplayContext * context)
+{
+  const auto view_manager = context->getViewManager();
+  if (!view_manager || !view_manager->getCurrent()) {
+    return nullptr;
+  }
+  return view_manager->getCurrent()->getCamera();
+}
+
+double calcPixelSize(const Ogre::Camera * camera, const Ogre::Vector3 & world_position)
+{
+  if (!camera || !camera->getViewport() || camera->getViewport()->getActualHeight() <= 0) {
+    return 0.0;
+  }
+  const double height = camera->getViewport()->getActualHeight();
+
+  if (camera->getProjectionType() == Ogre::PT_ORTHOGRAPHIC) {
+    return camera->getOrthoWindowHeight() / height;
+  }
+
+  const double distance = camera->getDerivedPosition().distance(world_position);
+  return 2.0 * distance * std::tan(camera->getFOVy().valueRadians() / 2.0) / height;
+}
+
+}  // namespace rviz_plugins
@@ -12,9 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <tools/incremental_rendering.hpp>
 #include <trajectory/display.hpp>
 
 #include <memory>
+#include <string>
+#include <vector>
 #define EIGEN_MPL2_ONLY
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Geometry>
@@ -91,6 +94,10 @@ AutowareTrajectoryDisplay::AutowareTrajectoryDisplay()
   property_vel_max_ = new rviz_common::properties::FloatProperty(
     "Color Border Vel Max", 3.0, "[m/s]", this, SLOT(updateVisualization()), this);
   property_vel_max_->setMin(0.0);
+  property_decimation_ = new rviz_common::properties::FloatProperty(
+    "Decimation", 1.0, "minimum distance [px] between the rendered points, 0 to render all", this,
+    SLOT(updateVisualization()), this);
+  property_decimation_->setMin(0.0);
 }
 
 AutowareTrajectoryDisplay::~AutowareTrajectoryDisplay()
@@ -117,6 +124,11 @@ void AutowareTrajectoryDisplay::onInitialize()
   velocity_manual_object_->setDynamic(true);
   scene_node_->attachObject(path_manual_object_);
   scene_node_->attachObject(velocity_manual_object_);
+
+  Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
+    "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+  material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
+  material->setDepthWriteEnabled(false);
 }
 
 void AutowareTrajectoryDisplay::reset()
@@ -132,6 +144,7 @@ void AutowareTrajectoryDisplay::reset()
   }
   velocity_text_nodes_.clear();
   velocity_texts_.clear();
+  rebuild_scheduler_.reset();
 }
 
 bool AutowareTrajectoryDisplay::validateFloats(
@@ -169,150 +182,156 @@ void AutowareTrajectoryDisplay::processMessage(
   scene_node_->setPosition(position);
   scene_node_->setOrientation(orientation);
 
-  path_manual_object_->clear();
-  velocity_manual_object_->clear();
+  // the geometry is rebuilt in update() at most once a frame
+  rebuild_scheduler_.setMessage(msg_ptr);
+}
 
-  Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
-    "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-  material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
-  material->setDepthWriteEnabled(false);
+void AutowareTrajectoryDisplay::update(float wall_dt, float ros_dt)
+{
+  MFDClass::update(wall_dt, ros_dt);
 
-  if (!msg_ptr->points.empty()) {
-    path_manual_object_->estimateVertexCount(msg_ptr->points.size() * 2);
-    velocity_manual_object_->estimateVertexCount(msg_ptr->points.size());
-    path_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_TRIANGLE_STRIP);
-    velocity_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_STRIP);
-
-    if (msg_ptr->points.size() > velocity_texts_.size()) {
-      for (size_t i = velocity_texts_.size(); i < msg_ptr->points.size(); i++) {
-        Ogre::SceneNode * node = scene_node_->createChildSceneNode();
-        rviz_rendering::MovableText * text =
-          new rviz_rendering::MovableText("not initialized", "Liberation Sans", 0.1);
-        text->setVisible(false);
-        text->setTextAlignment(
-          rviz_rendering::MovableText::H_CENTER, rviz_rendering::MovableText::V_ABOVE);
-        node->attachObject(text);
-        velocity_texts_.push_back(text);
-        velocity_text_nodes_.push_back(node);
-      }
-    } else if (msg_ptr->points.size() < velocity_texts_.size()) {
-      for (size_t i = velocity_texts_.size() - 1; i >= msg_ptr->points.size(); i--) {
-        Ogre::SceneNode * node = velocity_text_nodes_.at(i);
-        node->detachAllObjects();
-        node->removeAndDestroyAllChildren();
-        scene_manager_->destroySceneNode(node);
-      }
-      velocity_texts_.resize(msg_ptr->points.size());
-      velocity_text_nodes_.resize(msg_ptr->points.size());
-    }
+  const auto msg_ptr = rebuild_scheduler_.getLatestMessage();
+  if (!msg_ptr) {
+    return;
+  }
 
-    for (size_t point_idx = 0; point_idx < msg_ptr->points.size(); point_idx++) {
-      const auto & path_point = msg_ptr->points.at(point_idx);
-      /*
-       * Path
-       */
-      if (property_path_view_->getBool()) {
-        Ogre::ColourValue color;
-        if (property_path_color_view_->getBool()) {
-          color = rviz_common::properties::qtToOgre(property_path_color_->getColor());
-        } else {
-          /* color change depending on velocity */
-          std::unique_ptr<Ogre::ColourValue> dynamic_color_ptr =
-            setColorDependsOnVelocity(property_vel_max_->getFloat(), path_point.twist.linear.x);
-          color = *dynamic_color_ptr;
-        }
-        color.a = property_path_alpha_->getFloat();
-        Eigen::Vector3f vec_in, vec_out;
-        Eigen::Quaternionf quat_yaw_reverse(0, 0, 0, 1);
-        {
-          vec_in << 0, (property_path_width_->getFloat() / 2.0), 0;
-          Eigen::Quaternionf quat(
-            path_point.pose.orientation.w, path_point.pose.orientation.x,
-            path_point.pose.orientation.y, path_point.pose.orientation.z);
-          if (path_point.twist.linear.x < 0) {
-            quat *= quat_yaw_reverse;
-            vec_in = -vec_in;
-          }
-          vec_out = quat * vec_in;
-          path_manual_object_->position(
-            path_point.pose.position.x + vec_out.x(), path_point.pose.position.y + vec_out.y(),
-            path_point.pose.position.z + vec_out.z());
-          path_manual_object_->colour(color);
-        }
-        {
-          vec_in << 0, -(property_path_width_->getFloat() / 2.0), 0;
-          Eigen::Quaternionf quat(
-            path_point.pose.orientation.w, path_point.pose.orientation.x,
-            path_point.pose.orientation.y, path_point.pose.orientation.z);
-          if (path_point.twist.linear.x < 0) {
-            quat *= quat_yaw_reverse;
-            vec_in = -vec_in;
-          }
-          vec_out = quat * vec_in;
-          path_manual_object_->position(
-            path_point.pose.position.x + vec_out.x(), path_point.pose.position.y + vec_out.y(),
-            path_point.pose.position.z + vec_out.z());
-          path_manual_object_->colour(color);
-        }
-      }
-      /*
-       * Velocity
-       */
-      if (property_velocity_view_->getBool()) {
-        Ogre::ColourValue color;
-        if (property_velocity_color_view_->getBool()) {
-          color = rviz_common::properties::qtToOgre(property_velocity_color_->getColor());
-        } else {
-          /* color change depending on velocity */
-          std::unique_ptr<Ogre::ColourValue> dynamic_color_ptr =
-            setColorDependsOnVelocity(property_vel_max_->getFloat(), path_point.twist.linear.x);
-          color = *dynamic_color_ptr;
-        }
-        color.a = property_velocity_alpha_->getFloat();
-
-        velocity_manual_object_->position(
-          path_point.pose.position.x, path_point.pose.position.y,
-          path_point.pose.position.z +
-            path_point.twist.linear.x * property_velocity_scale_->getFloat());
-        velocity_manual_object_->colour(color);
-      }
-      /*
-       * Velocity Text
-       */
-      if (property_velocity_text_view_->getBool()) {
-        Ogre::Vector3 position;
-        position.x = path_point.pose.position.x;
-        position.y = path_point.pose.position.y;
-        position.z = path_point.pose.position.z;
-        Ogre::SceneNode * node = velocity_text_nodes_.at(point_idx);
-        node->setPosition(position);
-
-        rviz_rendering::MovableText * text = velocity_texts_.at(point_idx);
-        double vel = path_point.twist.linear.x;
-        text->setCaption(
-          std::to_string(static_cast<int>(std::floor(vel))) + "." +
-          std::to_string(static_cast<int>(std::floor(vel * 100))));
-        text->setCharacterHeight(property_velocity_text_scale_->getFloat());
-        text->setVisible(true);
-      } else {
-        rviz_rendering::MovableText * text = velocity_texts_.at(point_idx);
-        text->setVisible(false);
-      }
-    }
+  const auto camera = getCurrentCamera(context_);
+  const double min_pixels = property_decimation_->getFloat();
+  double pixel_size = 0.0;
+  if (min_pixels > 0.0 && !msg_ptr->points.empty()) {
+    const auto & position = msg_ptr->points.front().pose.position;
+    pixel_size = calcPixelSize(
+      camera,
+      scene_node_->convertLocalToWorldPosition(Ogre::Vector3(position.x, position.y, position.z)));
+  }
 
-    path_manual_object_->end();
-    velocity_manual_object_->end();
+  if (!rebuild_scheduler_.isRebuildNeeded(pixel_size)) {
+    return;
   }
-  last_msg_ptr_ = msg_ptr;
+
+  const auto indices = decimateByScreenDistance(msg_ptr->points, scene_node_, camera, min_pixels);
+  updateGeometry(*msg_ptr, indices);
 }
 
-void AutowareTrajectoryDisplay::updateVisualization()
+void AutowareTrajectoryDisplay::updateGeometry(
+  const autoware_planning_msgs::msg::Trajectory & msg, const std::vector<size_t> & indices)
 {
-  if (last_msg_ptr_ != nullptr) {
-    processMessage(last_msg_ptr_);
+  const bool is_path_view = property_path_view_->getBool();
+  const bool is_velocity_view = property_velocity_view_->getBool();
+  const bool is_velocity_text_view = property_velocity_text_view_->getBool();
+
+  beginManualObject(
+    path_manual_object_, is_path_view ? indices.size() * 2 : 0,
+    Ogre::RenderOperation::OT_TRIANGLE_STRIP);
+  beginManualObject(
+    velocity_manual_object_, is_velocity_view ? indices.size() : 0,
+    Ogre::RenderOperation::OT_LINE_STRIP);
+
+  if (indices.size() > velocity_texts_.size()) {
+    for (size_t i = velocity_texts_.size(); i < indices.size(); i++) {
+      Ogre::SceneNode * node = scene_node_->createChildSceneNode();
+      rviz_rendering::MovableText * text =
+        new rviz_rendering::MovableText("not initialized", "Liberation Sans", 0.1);
+      text->setVisible(false);
+      text->setTextAlignment(
+        rviz_rendering::MovableText::H_CENTER, rviz_rendering::MovableText::V_ABOVE);
+      node->attachObject(text);
+      velocity_texts_.push_back(text);
+      velocity_text_nodes_.push_back(node);
+    }
+  } else if (indices.size() < velocity_texts_.size()) {
+    for (size_t i = indices.size(); i < velocity_texts_.size(); i++) {
+      Ogre::SceneNode * node = velocity_text_nodes_.at(i);
+      node->detachAllObjects();
+      node->removeAndDestroyAllChildren();
+      scene_manager_->destroySceneNode(node);
+    }
+    velocity_texts_.resize(indices.size());
+    velocity_text_nodes_.resize(indices.size());
   }
+
+  const float half_width = property_path_width_->getFloat() / 2.0;
+  const float vel_max = property_vel_max_->getFloat();
+  const Eigen::Quaternionf quat_yaw_reverse(0, 0, 0, 1);
+
+  for (size_t point_idx = 0; point_idx < indices.size(); point_idx++) {
+    const auto & path_point = msg.points.at(indices.at(point_idx));
+    const auto & position = path_point.pose.position;
+    const double velocity = path_point.twist.linear.x;
+
+    /* color change depending on velocity */
+    Ogre::ColourValue velocity_color;
+    if (
+      (is_path_view && !property_path_color_view_->getBool()) ||
+      (is_velocity_view && !property_velocity_color_view_->getBool())) {
+      velocity_color = *setColorDependsOnVelocity(vel_max, velocity);
+    }
+
+    /*
+     * Path
+     */
+    if (is_path_view) {
+      Ogre::ColourValue color =
+        property_path_color_view_->getBool()
+          ? rviz_common::properties::qtToOgre(property_path_color_->getColor())
+          : velocity_color;
+      color.a = property_path_alpha_->getFloat();
+
+      Eigen::Quaternionf quat(
+        path_point.pose.orientation.w, path_point.pose.orientation.x,
+        path_point.pose.orientation.y, path_point.pose.orientation.z);
+      Eigen::Vector3f vec_in(0, half_width, 0);
+      if (velocity < 0) {
+        quat *= quat_yaw_reverse;
+        vec_in = -vec_in;
+      }
+      const Eigen::Vector3f vec_out = quat * vec_in;
+
+      path_manual_object_->position(
+        position.x + vec_out.x(), position.y + vec_out.y(), position.z + vec_out.z());
+      path_manual_object_->colour(color);
+      path_manual_object_->position(
+        position.x - vec_out.x(), position.y - vec_out.y(), position.z - vec_out.z());
+      path_manual_object_->colour(color);
+    }
+    /*
+     * Velocity
+     */
+    if (is_velocity_view) {
+      Ogre::ColourValue color =
+        property_velocity_color_view_->getBool()
+          ? rviz_common::properties::qtToOgre(property_velocity_color_->getColor())
+          : velocity_color;
+      color.a = property_velocity_alpha_->getFloat();
+
+      velocity_manual_object_->position(
+        position.x, position.y, position.z + velocity * property_velocity_scale_->getFloat());
+      velocity_manual_object_->colour(color);
+    }
+    /*
+     * Velocity Text
+     */
+    rviz_rendering::MovableText * text = velocity_texts_.at(point_idx);
+    if (is_velocity_text_view) {
+      Ogre::SceneNode * node = velocity_text_nodes_.at(point_idx);
+      node->setPosition(Ogre::Vector3(position.x, position.y, position.z));
+
+      text->setCaption(
+        std::to_string(static_cast<int>(std::floor(velocity))) + "." +
+        std::to_string(static_cast<int>(std::floor(velocity * 100))));
+      text->setCharacterHeight(property_velocity_text_scale_->getFloat());
+      text->setVisible(true);
+    } else {
+      text->setVisible(false);
+    }
+  }
+
+  path_manual_object_->end();
+  velocity_manual_object_->end();
 }
 
+void AutowareTrajectoryDisplay::updateVisualization() { rebuild_scheduler_.requestRebuild(); }
+
 }  // namespace rviz_plugins
 
 #include <pluginlib/class_list_macros.hpp>
@@ -12,11 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
 #include <memory>
+#include <vector>
 
 #define EIGEN_MPL2_ONLY
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Geometry>
+#include <tools/incremental_rendering.hpp>
 #include <trajectory_footprint/display.hpp>
 
 #include <tf2/utils.h>
@@ -63,6 +66,11 @@ AutowareTrajectoryFootprintDisplay::AutowareTrajectoryFootprintDisplay()
   property_trajectory_point_offset_ = new rviz_common::properties::FloatProperty(
     "Offset", 0.0, "", property_trajectory_point_view_, SLOT(updateVisualization()), this);
 
+  property_decimation_ = new rviz_common::properties::FloatProperty(
+    "Decimation", 1.0, "minimum distance [px] between the rendered points, 0 to render all", this,
+    SLOT(updateVisualization()), this);
+  property_decimation_->setMin(0.0);
+
   updateVehicleInfo();
 }
 
@@ -85,6 +93,11 @@ void AutowareTrajectoryFootprintDisplay::onInitialize()
   trajectory_point_manual_object_ = scene_manager_->createManualObject();
   trajectory_point_manual_object_->setDynamic(true);
   scene_node_->attachObject(trajectory_point_manual_object_);
+
+  Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
+    "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+  material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
+  material->setDepthWriteEnabled(false);
 }
 
 void AutowareTrajectoryFootprintDisplay::reset()
@@ -92,6 +105,7 @@ void AutowareTrajectoryFootprintDisplay::reset()
   MFDClass::reset();
   trajectory_footprint_manual_object_->clear();
   trajectory_point_manual_object_->clear();
+  rebuild_scheduler_.reset();
 }
 
 bool AutowareTrajectoryFootprintDisplay::validateFloats(
@@ -129,112 +143,137 @@ void AutowareTrajectoryFootprintDisplay::processMessage(
   scene_node_->setPosition(position);
   scene_node_->setOrientation(orientation);
 
-  trajectory_footprint_manual_object_->clear();
-  trajectory_point_manual_object_->clear();
+  // the geometry is rebuilt in update() at most once a frame
+  rebuild_scheduler_.setMessage(msg_ptr);
+}
 
-  Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
-    "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-  material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
-  material->setDepthWriteEnabled(false);
+void AutowareTrajectoryFootprintDisplay::update(float wall_dt, float ros_dt)
+{
+  MFDClass::update(wall_dt, ros_dt);
+
+  const auto msg_ptr = rebuild_scheduler_.getLatestMessage();
+  if (!msg_ptr) {
+    return;
+  }
+
+  const auto camera = getCurrentCamera(context_);
+  const double min_pixels = property_decimation_->getFloat();
+  double pixel_size = 0.0;
+  if (min_pixels > 0.0 && !msg_ptr->points.empty()) {
+    const auto & position = msg_ptr->points.front().pose.position;
+    pixel_size = calcPixelSize(
+      camera,
+      scene_node_->convertLocalToWorldPosition(Ogre::Vector3(position.x, position.y, position.z)));
+  }
+
+  if (!rebuild_scheduler_.isRebuildNeeded(pixel_size)) {
+    return;
+  }
+
+  const auto indices = decimateByScreenDistance(msg_ptr->points, scene_node_, camera, min_pixels);
+  updateGeometry(*msg_ptr, indices);
+}
+
+void AutowareTrajectoryFootprintDisplay::updateGeometry(
+  const autoware_planning_msgs::msg::Trajectory & msg, const std::vector<size_t> & indices)
+{
+  const bool is_footprint_view = property_trajectory_footprint_view_->getBool();
+  const bool is_point_view = property_trajectory_point_view_->getBool();
+
+  beginManualObject(
+    trajectory_footprint_manual_object_, is_footprint_view ? indices.size() * 4 * 2 : 0,
+    Ogre::RenderOperation::OT_LINE_LIST);
+  beginManualObject(
+    trajectory_point_manual_object_, is_point_view ? indices.size() * 3 * 8 : 0,
+    Ogre::RenderOperation::OT_TRIANGLE_LIST);
+
+  Ogre::ColourValue footprint_color =
+    rviz_common::properties::qtToOgre(property_trajectory_footprint_color_->getColor());
+  footprint_color.a = property_trajectory_footprint_alpha_->getFloat();
+
+  const auto info = vehicle_footprint_info_;
+  const float top = info->length - info->rear_overhang;
+  const float bottom = -info->rear_overhang;
+  const float left = -info->width / 2.0;
+  const float right = info->width / 2.0;
+  const std::array<Eigen::Vector3f, 4> footprint_corners{
+    Eigen::Vector3f{top, left, 0.0}, Eigen::Vector3f{top, right, 0.0},
+    Eigen::Vector3f{bottom, right, 0.0}, Eigen::Vector3f{bottom, left, 0.0}};
+
+  Ogre::ColourValue point_color =
+    rviz_common::properties::qtToOgre(property_trajectory_point_color_->getColor());
+  point_color.a = property_trajectory_point_alpha_->getFloat();
+
+  const double offset = property_trajectory_point_offset_->getFloat();
+  const double radius = property_trajectory_point_radius_->getFloat();
+  std::array<double, 9> circle_x, circle_y;
+  for (size_t s_idx = 0; s_idx < circle_x.size(); ++s_idx) {
+    const double angle = static_cast<double>(s_idx) / 8.0 * 2.0 * M_PI;
+    circle_x.at(s_idx) = radius * std::cos(angle);
+    circle_y.at(s_idx) = radius * std::sin(angle);
+  }
 
-  if (!msg_ptr->points.empty()) {
-    trajectory_footprint_manual_object_->estimateVertexCount(msg_ptr->points.size() * 4 * 2);
-    trajectory_footprint_manual_object_->begin(
-      "BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_LIST);
-
-    trajectory_point_manual_object_->estimateVertexCount(msg_ptr->points.size() * 3 * 8);
-    trajectory_point_manual_object_->begin(
-      "BaseWhiteNoLighting", Ogre::RenderOperation::OT_TRIANGLE_LIST);
-
-    for (size_t point_idx = 0; point_idx < msg_ptr->points.size(); point_idx++) {
-      const auto & path_point = msg_ptr->points.at(point_idx);
-      /*
-       * Footprint
-       */
-      if (property_trajectory_footprint_view_->getBool()) {
-        Ogre::ColourValue color;
-        color = rviz_common::properties::qtToOgre(property_trajectory_footprint_color_->getColor());
-        color.a = property_trajectory_footprint_alpha_->getFloat();
-
-        const auto info = vehicle_footprint_info_;
-        const float top = info->length - info->rear_overhang;
-        const float bottom = -info->rear_overhang;
-        const float left = -info->width / 2.0;
-        const float right = info->width / 2.0;
-
-        const std::array<float, 4> lon_offset_vec{top, top, bottom, bottom};
-        const std::array<float, 4> lat_offset_vec{left, right, right, left};
-
-        for (int f_idx = 0; f_idx < 4; ++f_idx) {
-          const Eigen::Quaternionf quat(
-            path_point.pose.orientation.w, path_point.pose.orientation.x,
-            path_point.pose.orientation.y, path_point.pose.orientation.z);
-
-          {
-            const Eigen::Vector3f offset_vec{
-              lon_offset_vec.at(f_idx), lat_offset_vec.at(f_idx), 0.0};
-            const auto offset_to_edge = quat * offset_vec;
-            trajectory_footprint_manual_object_->position(
-              path_point.pose.position.x + offset_to_edge.x(),
-              path_point.pose.position.y + offset_to_edge.y(), path_point.pose.position.z);
-            trajectory_footprint_manual_object_->colour(color);
-          }
-          {
-            const Eigen::Vector3f offset_vec{
-              lon_offset_vec.at((f_idx + 1) % 4), lat_offset_vec.at((f_idx + 1) % 4), 0.0};
-            const auto offset_to_edge = quat * offset_vec;
-            trajectory_footprint_manual_object_->position(
-              path_point.pose.position.x + offset_to_edge.x(),
-              path_point.pose.position.y + offset_to_edge.y(), path_point.pose.position.z);
-            trajectory_footprint_manual_object_->colour(color);
-          }
-        }
+  for (const auto point_idx : indices) {
+    const auto & path_point = msg.points.at(point_idx);
+    /*
+     * Footprint
+     */
+    if (is_footprint_view) {
+      const Eigen::Quaternionf quat(
+        path_point.pose.orientation.w, path_point.pose.orientation.x,
+        path_point.pose.orientation.y, path_point.pose.orientation.z);
+
+      std::array<Eigen::Vector3f, 4> offsets_to_edge;
+      for (size_t f_idx = 0; f_idx < 4; ++f_idx) {
+        offsets_to_edge.at(f_idx) = quat * footprint_corners.at(f_idx);
       }
 
-      /*
-       * Point
-       */
-      if (property_trajectory_point_view_->getBool()) {
-        Ogre::ColourValue color;
-        color = rviz_common::properties::qtToOgre(property_trajectory_point_color_->getColor());
-        color.a = property_trajectory_point_alpha_->getFloat();
-
-        const double offset = property_trajectory_point_offset_->getFloat();
-        const double yaw = tf2::getYaw(path_point.pose.orientation);
-        const double base_x = path_point.pose.position.x + offset * std::cos(yaw);
-        const double base_y = path_point.pose.position.y + offset * std::sin(yaw);
-        const double base_z = path_point.pose.position.z;
-
-        const double radius = property_trajectory_point_radius_->getFloat();
-        for (size_t s_idx = 0; s_idx < 8; ++s_idx) {
-          const double current_angle = static_cast<double>(s_idx) / 8.0 * 2.0 * M_PI;
-          const double next_angle = static_cast<double>(s_idx + 1) / 8.0 * 2.0 * M_PI;
-          trajectory_point_manual_object_->position(
-            base_x + radius * std::cos(current_angle), base_y + radius * std::sin(current_angle),
-            base_z);
-          trajectory_point_manual_object_->colour(color);
-
-          trajectory_point_manual_object_->position(
-            base_x + radius * std::cos(next_angle), base_y + radius * std::sin(next_angle), base_z);
-          trajectory_point_manual_object_->colour(color);
-
-          trajectory_point_manual_object_->position(base_x, base_y, base_z);
-          trajectory_point_manual_object_->colour(color);
-        }
+      for (size_t f_idx = 0; f_idx < 4; ++f_idx) {
+        const auto & offset_to_edge = offsets_to_edge.at(f_idx);
+        trajectory_footprint_manual_object_->position(
+          path_point.pose.position.x + offset_to_edge.x(),
+          path_point.pose.position.y + offset_to_edge.y(), path_point.pose.position.z);
+        trajectory_footprint_manual_object_->colour(footprint_color);
+
+        const auto & offset_to_next_edge = offsets_to_edge.at((f_idx + 1) % 4);
+        trajectory_footprint_manual_object_->position(
+          path_point.pose.position.x + offset_to_next_edge.x(),
+          path_point.pose.position.y + offset_to_next_edge.y(), path_point.pose.position.z);
+        trajectory_footprint_manual_object_->colour(footprint_color);
       }
     }
 
-    trajectory_footprint_manual_object_->end();
-    trajectory_point_manual_object_->end();
+    /*
+     * Point
+     */
+    if (is_point_view) {
+      const double yaw = tf2::getYaw(path_point.pose.orientation);
+      const double base_x = path_point.pose.position.x + offset * std::cos(yaw);
+      const double base_y = path_point.pose.position.y + offset * std::sin(yaw);
+      const double base_z = path_point.pose.position.z;
+
+      for (size_t s_idx = 0; s_idx < 8; ++s_idx) {
+        trajectory_point_manual_object_->position(
+          base_x + circle_x.at(s_idx), base_y + circle_y.at(s_idx), base_z);
+        trajectory_point_manual_object_->colour(point_color);
+
+        trajectory_point_manual_object_->position(
+          base_x + circle_x.at(s_idx + 1), base_y + circle_y.at(s_idx + 1), base_z);
+        trajectory_point_manual_object_->colour(point_color);
+
+        trajectory_point_manual_object_->position(base_x, base_y, base_z);
+        trajectory_point_manual_object_->colour(point_color);
+      }
+    }
   }
-  last_msg_ptr_ = msg_ptr;
+
+  trajectory_footprint_manual_object_->end();
+  trajectory_point_manual_object_->end();
 }
 
 void AutowareTrajectoryFootprintDisplay::updateVisualization()
 {
-  if (last_msg_ptr_ != nullptr) {
-    processMessage(last_msg_ptr_);
-  }
+  rebuild_scheduler_.requestRebuild();
 }
 
 void AutowareTrajectoryFootprintDisplay::updateVehicleInfo()
@@ -244,6 +283,7 @@ void AutowareTrajectoryFootprintDisplay::updateVehicleInfo()
   float rear_overhang{property_rear_overhang_->getFloat()};
 
   vehicle_footprint_info_ = std::make_shared<VehicleFootprintInfo>(length, width, rear_overhang);
+  rebuild_scheduler_.requestRebuild();
 }
 
 }  // namespace rviz_plugins
@@ -48,6 +48,7 @@ struct TargetPerformanceMsgVars
   double curvature_estimate_pp;
   double lateral_error_velocity;
   double lateral_error_acceleration;
+  double velocity_error;
 };
 
 class ControlPerformanceAnalysisCore
@@ -77,11 +78,15 @@ public:
   std::pair<bool, Pose> calculateClosestPose();
 
 private:
+  std::pair<int32_t, double> searchPrevWayPointIdx(int32_t begin_idx, int32_t end_idx) const;
+
   double wheelbase_;
   double curvature_interval_length_;
 
   // Variables Received Outside
   std::shared_ptr<PoseArray> current_waypoints_ptr_;
+  std::vector<double> current_waypoint_velocities_;
+  bool is_new_waypoints_{true};  // the search of the previous waypoint is not seeded
   std::shared_ptr<Pose> current_vec_pose_ptr_;
   std::shared_ptr<std::vector<double>> current_velocities_ptr_;  // [Vx, Heading rate]
   std::shared_ptr<ControlCommandStamped> current_control_ptr_;
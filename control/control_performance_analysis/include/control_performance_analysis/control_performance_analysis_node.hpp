@@ -16,7 +16,9 @@
 #define CONTROL_PERFORMANCE_ANALYSIS__CONTROL_PERFORMANCE_ANALYSIS_NODE_HPP_
 
 #include "control_performance_analysis/control_performance_analysis_core.hpp"
+#include "control_performance_analysis/error_statistics.hpp"
 #include "control_performance_analysis/msg/error_stamped.hpp"
+#include "control_performance_analysis/msg/error_statistics_stamped.hpp"
 
 #include <autoware_utils/ros/self_pose_listener.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -37,6 +39,7 @@ using autoware_control_msgs::msg::ControlCommandStamped;
 using autoware_planning_msgs::msg::Trajectory;
 using autoware_vehicle_msgs::msg::Steering;
 using control_performance_analysis::msg::ErrorStamped;
+using control_performance_analysis::msg::ErrorStatisticsStamped;
 using geometry_msgs::msg::PoseStamped;
 using geometry_msgs::msg::TwistStamped;
 
@@ -49,6 +52,10 @@ struct Param
 
   // Control Method Parameters
   double control_period;
+
+  // Statistics Parameters
+  double statistics_publish_period;
+  double stop_velocity_threshold;  // the driving segment ends below this velocity
 };
 
 class ControlPerformanceAnalysisNode : public rclcpp::Node
@@ -69,6 +76,7 @@ private:
 
   // Publishers
   rclcpp::Publisher<ErrorStamped>::SharedPtr pub_error_msg_;  // publish error message
+  rclcpp::Publisher<ErrorStatisticsStamped>::SharedPtr pub_error_statistics_;
 
   // Node Methods
   bool isDataReady() const;  // check if data arrive
@@ -81,11 +89,17 @@ private:
   void onControlRaw(const ControlCommandStamped::ConstSharedPtr control_msg);
   void onVecSteeringMeasured(const Steering::ConstSharedPtr meas_steer_msg);
   void onVelocity(const TwistStamped::ConstSharedPtr msg);
+  void updateStatistics(const TargetPerformanceMsgVars & control_performance_vars);
+  void publishStatistics(const bool is_segment_finished);
 
   // Timer - To Publish In Control Period
   rclcpp::TimerBase::SharedPtr timer_publish_;
   void onTimer();
 
+  // Timer - To Publish The Statistics Of The Driving Segment
+  rclcpp::TimerBase::SharedPtr timer_statistics_;
+  void onStatisticsTimer();
+
   // Parameters
   Param param_{};  // wheelbase, control period and feedback coefficients.
   TargetPerformanceMsgVars target_error_vars_{};
@@ -99,6 +113,13 @@ private:
 
   // Algorithm
   std::unique_ptr<ControlPerformanceAnalysisCore> control_performance_core_ptr_;
+
+  // Statistics of the errors while the vehicle is moving, reset when it stops.
+  bool is_driving_{false};
+  uint32_t segment_id_{0};
+  ErrorStatistics lateral_error_statistics_;
+  ErrorStatistics heading_error_statistics_;
+  ErrorStatistics velocity_error_statistics_;
 };
 }  // namespace control_performance_analysis
 
@@ -0,0 +1,83 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONTROL_PERFORMANCE_ANALYSIS__ERROR_STATISTICS_HPP_
+#define CONTROL_PERFORMANCE_ANALYSIS__ERROR_STATISTICS_HPP_
+
+#include <array>
+#include <cstdint>
+
+namespace control_performance_analysis
+{
+/*
+ *  Streaming estimate of a quantile with the P-square algorithm (R. Jain and I. Chlamtac, 1985).
+ *  Five markers are kept whatever the number of samples, instead of the samples themselves.
+ * */
+class QuantileEstimator
+{
+public:
+  explicit QuantileEstimator(double quantile);
+
+  void add(double value);
+  void reset();
+  double getQuantile() const;
+
+private:
+  static constexpr int num_markers = 5;
+
+  double quantile_;
+  int64_t count_{0};
+  std::array<double, num_markers> heights_{};
+  std::array<double, num_markers> positions_{};
+  std::array<double, num_markers> desired_positions_{};
+  std::array<double, num_markers> increments_{};  // of the desired positions per sample
+
+  double parabolic(int i, double d) const;
+  double linear(int i, double d) const;
+};
+
+struct ErrorStatisticsVars
+{
+  int64_t count;
+  double min;
+  double max;
+  double mean;
+  double p95;  // of the absolute value
+  double p99;  // of the absolute value
+};
+
+/*
+ *  Min, max and mean of an error, and the 95th and 99th percentiles of its absolute value, updated
+ *  sample by sample in constant memory.
+ * */
+class ErrorStatistics
+{
+public:
+  ErrorStatistics();
+
+  void add(double value);
+  void reset();
+  ErrorStatisticsVars getStatistics() const;
+
+private:
+  int64_t count_{0};
+  double min_{0.0};
+  double max_{0.0};
+  double mean_{0.0};
+  QuantileEstimator p95_estimator_;
+  QuantileEstimator p99_estimator_;
+};
+}  // namespace control_performance_analysis
+
+#endif  // CONTROL_PERFORMANCE_ANALYSIS__ERROR_STATISTICS_HPP_
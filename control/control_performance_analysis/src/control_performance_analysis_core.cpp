@@ -24,6 +24,13 @@ namespace control_performance_analysis
 {
 using geometry_msgs::msg::Quaternion;
 
+namespace
+{
+// Intervals searched around the previous waypoint, as long as the trajectory is the same.
+constexpr int32_t SEARCH_WINDOW_BACKWARD = 5;
+constexpr int32_t SEARCH_WINDOW_FORWARD = 50;
+}  // namespace
+
 ControlPerformanceAnalysisCore::ControlPerformanceAnalysisCore() : wheelbase_{2.74}
 {
   prev_target_vars_ = std::make_unique<TargetPerformanceMsgVars>(TargetPerformanceMsgVars{});
@@ -42,10 +49,14 @@ ControlPerformanceAnalysisCore::ControlPerformanceAnalysisCore(
 void ControlPerformanceAnalysisCore::setCurrentWaypoints(const Trajectory & trajectory)
 {
   current_waypoints_ptr_ = std::make_shared<PoseArray>();
+  current_waypoint_velocities_.clear();
 
   for (const auto & point : trajectory.points) {
     current_waypoints_ptr_->poses.emplace_back(point.pose);
+    current_waypoint_velocities_.emplace_back(point.twist.linear.x);
   }
+
+  is_new_waypoints_ = true;
 }
 
 void ControlPerformanceAnalysisCore::setCurrentPose(const Pose & msg)
@@ -68,59 +79,27 @@ std::pair<bool, int32_t> ControlPerformanceAnalysisCore::findClosestPrevWayPoint
   double acceptable_min_distance = 2.0;
 
   /*
-   *   Create Vectors of Path Directions for each interval
-   *   interval_vector_xy = {waypoint_1 - waypoint_0}_xy
+   *   The vehicle moves a few waypoints at most in a control period, so that the waypoint is
+   *   searched around the previous one on the same trajectory. The whole trajectory is searched
+   *   for a new trajectory, or when no waypoint close enough is found around the previous one.
    * */
+  const int32_t num_of_intervals = static_cast<int32_t>(current_waypoints_ptr_->poses.size()) - 1;
 
-  // Prepare vector of projection distance values; projection of vehicle vectors onto the intervals
-  std::vector<double> projection_distances_ds;  //
-
-  auto f_projection_dist = [this](auto pose_1, auto pose_0) {
-    // Vector of intervals.
-    std::vector<double> int_vec{
-      pose_1.position.x - pose_0.position.x, pose_1.position.y - pose_0.position.y};
-
-    // Compute the magnitude of path interval vector
-    double ds_mag = std::hypot(int_vec[0], int_vec[1]);
-
-    // Vector to vehicle from the origin waypoints.
-    std::vector<double> vehicle_vec{
-      this->current_vec_pose_ptr_->position.x - pose_0.position.x,
-      this->current_vec_pose_ptr_->position.y - pose_0.position.y};
-
-    double projection_distance_onto_interval;
-    projection_distance_onto_interval =
-      (int_vec[0] * vehicle_vec[0] + int_vec[1] * vehicle_vec[1]) / ds_mag;
-
-    return projection_distance_onto_interval;
-  };
-
-  // Fill the projection_distances vector.
-  std::transform(
-    current_waypoints_ptr_->poses.cbegin() + 1, current_waypoints_ptr_->poses.cend(),
-    current_waypoints_ptr_->poses.cbegin(), std::back_inserter(projection_distances_ds),
-    f_projection_dist);
-
-  // Lambda function to replace negative numbers with a large number.
-  auto fnc_check_if_negative = [](auto x) {
-    return x < 0 ? std::numeric_limits<double>::max() : x;
-  };
-
-  std::vector<double> projections_distances_all_positive;
-  std::transform(
-    projection_distances_ds.cbegin(), projection_distances_ds.cend(),
-    std::back_inserter(projections_distances_all_positive), fnc_check_if_negative);
-
-  // Minimum of all positive distances and the index of the next waypoint.
-  auto it = std::min_element(
-    projections_distances_all_positive.cbegin(), projections_distances_all_positive.cend());
+  std::pair<int32_t, double> idx_and_distance{0, std::numeric_limits<double>::max()};
+  if (!is_new_waypoints_ && idx_prev_wp_) {
+    const int32_t begin_idx = std::max(*idx_prev_wp_ - SEARCH_WINDOW_BACKWARD, 0);
+    const int32_t end_idx = std::min(*idx_prev_wp_ + SEARCH_WINDOW_FORWARD, num_of_intervals);
+    idx_and_distance = searchPrevWayPointIdx(begin_idx, end_idx);
+  }
+  if (idx_and_distance.second > acceptable_min_distance) {
+    idx_and_distance = searchPrevWayPointIdx(0, num_of_intervals);
+  }
+  is_new_waypoints_ = false;
 
-  // Extract the location of iterator idx and store in the class.
-  int32_t && temp_idx_prev_wp_ = std::distance(projections_distances_all_positive.cbegin(), it);
-  idx_prev_wp_ = std::make_unique<int32_t>(temp_idx_prev_wp_);
+  idx_prev_wp_ = std::make_unique<int32_t>(idx_and_distance.first);
 
   // Distance of next waypoint to the vehicle, for anomaly detection.
-  double min_distance_ds = projections_distances_all_positive[*idx_prev_wp_];
+  double min_distance_ds = idx_and_distance.second;
   int32_t length_of_trajectory =
     std::distance(current_waypoints_ptr_->poses.cbegin(), current_waypoints_ptr_->poses.cend());
 
@@ -133,6 +112,38 @@ std::pair<bool, int32_t> ControlPerformanceAnalysisCore::findClosestPrevWayPoint
            : std::make_pair(false, std::numeric_limits<int32_t>::quiet_NaN());
 }
 
+std::pair<int32_t, double> ControlPerformanceAnalysisCore::searchPrevWayPointIdx(
+  int32_t begin_idx, int32_t end_idx) const
+{
+  // Projection of the vehicle vector onto each interval from its origin waypoint. The interval
+  // with the smallest positive projection is the one the vehicle is on.
+  int32_t min_idx = begin_idx;
+  double min_distance = std::numeric_limits<double>::max();
+
+  for (int32_t idx = begin_idx; idx < end_idx; ++idx) {
+    const auto & pose_0 = current_waypoints_ptr_->poses.at(idx);
+    const auto & pose_1 = current_waypoints_ptr_->poses.at(idx + 1);
+
+    // Vector of intervals.
+    const double int_vec_x = pose_1.position.x - pose_0.position.x;
+    const double int_vec_y = pose_1.position.y - pose_0.position.y;
+
+    // Vector to vehicle from the origin waypoints.
+    const double vehicle_vec_x = current_vec_pose_ptr_->position.x - pose_0.position.x;
+    const double vehicle_vec_y = current_vec_pose_ptr_->position.y - pose_0.position.y;
+
+    const double projection_distance =
+      (int_vec_x * vehicle_vec_x + int_vec_y * vehicle_vec_y) / std::hypot(int_vec_x, int_vec_y);
+
+    if (projection_distance >= 0 && projection_distance < min_distance) {
+      min_distance = projection_distance;
+      min_idx = idx;
+    }
+  }
+
+  return std::make_pair(min_idx, min_distance);
+}
+
 bool ControlPerformanceAnalysisCore::isDataReady() const
 {
   rclcpp::Clock clock{RCL_ROS_TIME};
@@ -235,6 +246,21 @@ std::pair<bool, TargetPerformanceMsgVars> ControlPerformanceAnalysisCore::getPer
   target_vars.lateral_error_velocity = Vx * sin(heading_yaw_error);
   target_vars.lateral_error_acceleration = Vx * tan(steering_val) / wheelbase_ - curvature_est * Vx;
 
+  // Velocity error to the reference velocity interpolated at the closest pose.
+  const auto & prev_wp_position = current_waypoints_ptr_->poses.at(*idx_prev_wp_).position;
+  const auto & next_wp_position = current_waypoints_ptr_->poses.at(*idx_next_wp_).position;
+  const double interval_length = std::hypot(
+    next_wp_position.x - prev_wp_position.x, next_wp_position.y - prev_wp_position.y);
+  const double distance_to_interp_wp = std::hypot(
+    pose_interp_wp_.position.x - prev_wp_position.x,
+    pose_interp_wp_.position.y - prev_wp_position.y);
+  const double ratio_t =
+    interval_length > EPS ? std::min(distance_to_interp_wp / interval_length, 1.0) : 0.0;
+  const double prev_wp_velocity = current_waypoint_velocities_.at(*idx_prev_wp_);
+  const double next_wp_velocity = current_waypoint_velocities_.at(*idx_next_wp_);
+  const double target_velocity = prev_wp_velocity + ratio_t * (next_wp_velocity - prev_wp_velocity);
+  target_vars.velocity_error = target_velocity - Vx;
+
   prev_target_vars_ = std::move(std::make_unique<TargetPerformanceMsgVars>(target_vars));
 
   return std::make_pair(true, target_vars);
@@ -15,16 +15,20 @@
 #include "control_performance_analysis/control_performance_analysis_node.hpp"
 
 #include "control_performance_analysis/msg/error_stamped.hpp"
+#include "control_performance_analysis/msg/error_statistics_stamped.hpp"
 
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
+#include <cmath>
 #include <memory>
 #include <utility>
 
 namespace
 {
+using control_performance_analysis::ErrorStatisticsVars;
 using control_performance_analysis::TargetPerformanceMsgVars;
 using control_performance_analysis::msg::ErrorStamped;
+using control_performance_analysis::msg::ErrorStatistics;
 
 ErrorStamped createPerformanceMsgVars(const TargetPerformanceMsgVars & target_performance_vars)
 {
@@ -39,9 +43,24 @@ ErrorStamped createPerformanceMsgVars(const TargetPerformanceMsgVars & target_pe
   error_msgs.error.curvature_estimate_pp = target_performance_vars.curvature_estimate_pp;
   error_msgs.error.lateral_error_velocity = target_performance_vars.lateral_error_velocity;
   error_msgs.error.lateral_error_acceleration = target_performance_vars.lateral_error_acceleration;
+  error_msgs.error.velocity_error = target_performance_vars.velocity_error;
 
   return error_msgs;
 }
+
+ErrorStatistics createErrorStatisticsMsg(const ErrorStatisticsVars & statistics_vars)
+{
+  ErrorStatistics statistics_msg{};
+
+  statistics_msg.count = statistics_vars.count;
+  statistics_msg.min = statistics_vars.min;
+  statistics_msg.max = statistics_vars.max;
+  statistics_msg.mean = statistics_vars.mean;
+  statistics_msg.p95 = statistics_vars.p95;
+  statistics_msg.p99 = statistics_vars.p99;
+
+  return statistics_msg;
+}
 }  // namespace
 
 namespace control_performance_analysis
@@ -61,6 +80,8 @@ ControlPerformanceAnalysisNode::ControlPerformanceAnalysisNode(
   // Node Parameters.
   param_.control_period = declare_parameter("control_period", 0.033);
   param_.curvature_interval_length = declare_parameter("curvature_interval_length", 10.0);
+  param_.statistics_publish_period = declare_parameter("statistics_publish_period", 1.0);
+  param_.stop_velocity_threshold = declare_parameter("stop_velocity_threshold", 0.1);
 
   // Prepare error computation class with the wheelbase parameter.
   control_performance_core_ptr_ = std::make_unique<ControlPerformanceAnalysisCore>(
@@ -84,6 +105,8 @@ ControlPerformanceAnalysisNode::ControlPerformanceAnalysisNode(
 
   // Publishers
   pub_error_msg_ = create_publisher<ErrorStamped>("~/output/error_stamped", 1);
+  pub_error_statistics_ =
+    create_publisher<ErrorStatisticsStamped>("~/output/error_statistics_stamped", 1);
 
   // Timer
   {
@@ -95,6 +118,15 @@ ControlPerformanceAnalysisNode::ControlPerformanceAnalysisNode(
       this->get_node_base_interface()->get_context());
     this->get_node_timers_interface()->add_timer(timer_publish_, nullptr);
   }
+  {
+    auto on_timer = std::bind(&ControlPerformanceAnalysisNode::onStatisticsTimer, this);
+    auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(param_.statistics_publish_period));
+    timer_statistics_ = std::make_shared<rclcpp::GenericTimer<decltype(on_timer)>>(
+      this->get_clock(), period, std::move(on_timer),
+      this->get_node_base_interface()->get_context());
+    this->get_node_timers_interface()->add_timer(timer_statistics_, nullptr);
+  }
 
   // Wait for first self pose
   self_pose_listener_.waitForFirstPose();
@@ -113,6 +145,9 @@ void ControlPerformanceAnalysisNode::onTrajectory(const Trajectory::ConstSharedP
   }
 
   current_trajectory_ptr_ = msg;
+
+  // The waypoints are set once per trajectory, the closest one being searched from the previous.
+  control_performance_core_ptr_->setCurrentWaypoints(*msg);
 }
 
 void ControlPerformanceAnalysisNode::onControlRaw(
@@ -152,6 +187,18 @@ void ControlPerformanceAnalysisNode::onTimer()
     return;
   }
 
+  // The driving segment ends when the vehicle stops.
+  const bool is_driving =
+    std::fabs(current_velocity_ptr_->twist.linear.x) > param_.stop_velocity_threshold;
+  if (is_driving_ && !is_driving) {
+    publishStatistics(true);
+    lateral_error_statistics_.reset();
+    heading_error_statistics_.reset();
+    velocity_error_statistics_.reset();
+    ++segment_id_;
+  }
+  is_driving_ = is_driving;
+
   // Compute Control Performance Variables.
   auto performanceVars = computeTargetPerformanceMsgVars();
   if (!performanceVars) {
@@ -161,6 +208,14 @@ void ControlPerformanceAnalysisNode::onTimer()
 
   // If successful publish.
   publishErrorMsg(*performanceVars);
+  updateStatistics(*performanceVars);
+}
+
+void ControlPerformanceAnalysisNode::onStatisticsTimer()
+{
+  if (is_driving_) {
+    publishStatistics(false);
+  }
 }
 
 void ControlPerformanceAnalysisNode::publishErrorMsg(
@@ -172,6 +227,38 @@ void ControlPerformanceAnalysisNode::publishErrorMsg(
   pub_error_msg_->publish(error_msgs);
 }
 
+void ControlPerformanceAnalysisNode::updateStatistics(
+  const TargetPerformanceMsgVars & control_performance_vars)
+{
+  if (!is_driving_) {
+    return;
+  }
+
+  lateral_error_statistics_.add(control_performance_vars.lateral_error);
+  heading_error_statistics_.add(control_performance_vars.heading_error);
+  velocity_error_statistics_.add(control_performance_vars.velocity_error);
+}
+
+void ControlPerformanceAnalysisNode::publishStatistics(const bool is_segment_finished)
+{
+  const auto lateral_error_statistics = lateral_error_statistics_.getStatistics();
+  if (lateral_error_statistics.count == 0) {
+    return;
+  }
+
+  ErrorStatisticsStamped statistics_msg{};
+  statistics_msg.header.stamp = now();
+  statistics_msg.segment_id = segment_id_;
+  statistics_msg.is_segment_finished = is_segment_finished;
+  statistics_msg.lateral_error = createErrorStatisticsMsg(lateral_error_statistics);
+  statistics_msg.heading_error =
+    createErrorStatisticsMsg(heading_error_statistics_.getStatistics());
+  statistics_msg.velocity_error =
+    createErrorStatisticsMsg(velocity_error_statistics_.getStatistics());
+
+  pub_error_statistics_->publish(statistics_msg);
+}
+
 bool ControlPerformanceAnalysisNode::isDataReady() const
 {
   rclcpp::Clock clock{RCL_ROS_TIME};
@@ -208,8 +295,7 @@ bool ControlPerformanceAnalysisNode::isDataReady() const
 boost::optional<TargetPerformanceMsgVars>
 ControlPerformanceAnalysisNode::computeTargetPerformanceMsgVars() const
 {
-  // Set trajectory and current pose of controller_performance_core.
-  control_performance_core_ptr_->setCurrentWaypoints(*current_trajectory_ptr_);
+  // Set current pose of controller_performance_core.
   control_performance_core_ptr_->setCurrentPose(current_pose_->pose);
   control_performance_core_ptr_->setCurrentVelocities(current_velocity_ptr_->twist);
   control_performance_core_ptr_->setCurrentControlValue(*current_control_msg_ptr_);
@@ -0,0 +1,151 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "control_performance_analysis/error_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace control_performance_analysis
+{
+constexpr int QuantileEstimator::num_markers;
+
+QuantileEstimator::QuantileEstimator(double quantile) : quantile_{quantile} { reset(); }
+
+void QuantileEstimator::reset()
+{
+  count_ = 0;
+  increments_ = {0.0, quantile_ / 2.0, quantile_, (1.0 + quantile_) / 2.0, 1.0};
+}
+
+void QuantileEstimator::add(double value)
+{
+  // The first samples are the initial marker heights.
+  if (count_ < num_markers) {
+    heights_[count_] = value;
+    ++count_;
+    if (count_ == num_markers) {
+      std::sort(heights_.begin(), heights_.end());
+      for (int i = 0; i < num_markers; ++i) {
+        positions_[i] = i + 1;
+        desired_positions_[i] = 1.0 + 4.0 * increments_[i];
+      }
+    }
+    return;
+  }
+  ++count_;
+
+  // Find the cell of the sample, extending the extreme markers if needed.
+  int k;
+  if (value < heights_[0]) {
+    heights_[0] = value;
+    k = 0;
+  } else if (value >= heights_[num_markers - 1]) {
+    heights_[num_markers - 1] = value;
+    k = num_markers - 2;
+  } else {
+    k = 0;
+    while (value >= heights_[k + 1]) {
+      ++k;
+    }
+  }
+
+  for (int i = k + 1; i < num_markers; ++i) {
+    positions_[i] += 1.0;
+  }
+  for (int i = 0; i < num_markers; ++i) {
+    desired_positions_[i] += increments_[i];
+  }
+
+  // Move the middle markers toward their desired positions by one at most.
+  for (int i = 1; i < num_markers - 1; ++i) {
+    const double diff = desired_positions_[i] - positions_[i];
+    if (
+      (diff >= 1.0 && positions_[i + 1] - positions_[i] > 1.0) ||
+      (diff <= -1.0 && positions_[i - 1] - positions_[i] < -1.0)) {
+      const double d = diff > 0.0 ? 1.0 : -1.0;
+      const double height = parabolic(i, d);
+      heights_[i] = heights_[i - 1] < height && height < heights_[i + 1] ? height : linear(i, d);
+      positions_[i] += d;
+    }
+  }
+}
+
+double QuantileEstimator::getQuantile() const
+{
+  if (count_ == 0) {
+    return 0.0;
+  }
+
+  if (count_ < num_markers) {
+    std::array<double, num_markers> samples = heights_;
+    std::sort(samples.begin(), samples.begin() + count_);
+    const auto idx = static_cast<int64_t>(std::round(quantile_ * (count_ - 1)));
+    return samples[idx];
+  }
+
+  return heights_[2];
+}
+
+double QuantileEstimator::parabolic(int i, double d) const
+{
+  const double n_prev = positions_[i - 1];
+  const double n = positions_[i];
+  const double n_next = positions_[i + 1];
+  return heights_[i] +
+         d / (n_next - n_prev) *
+           ((n - n_prev + d) * (heights_[i + 1] - heights_[i]) / (n_next - n) +
+            (n_next - n - d) * (heights_[i] - heights_[i - 1]) / (n - n_prev));
+}
+
+double QuantileEstimator::linear(int i, double d) const
+{
+  const int j = i + static_cast<int>(d);
+  return heights_[i] + d * (heights_[j] - heights_[i]) / (positions_[j] - positions_[i]);
+}
+
+ErrorStatistics::ErrorStatistics() : p95_estimator_{0.95}, p99_estimator_{0.99} {}
+
+void ErrorStatistics::add(double value)
+{
+  if (count_ == 0) {
+    min_ = value;
+    max_ = value;
+  } else {
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+  ++count_;
+  mean_ += (value - mean_) / count_;
+
+  p95_estimator_.add(std::fabs(value));
+  p99_estimator_.add(std::fabs(value));
+}
+
+void ErrorStatistics::reset()
+{
+  count_ = 0;
+  min_ = 0.0;
+  max_ = 0.0;
+  mean_ = 0.0;
+  p95_estimator_.reset();
+  p99_estimator_.reset();
+}
+
+ErrorStatisticsVars ErrorStatistics::getStatistics() const
+{
+  return ErrorStatisticsVars{
+    count_, min_, max_, mean_, p95_estimator_.getQuantile(), p99_estimator_.getQuantile()};
+}
+}  // namespace control_performance_analysis
@@ -32,6 +32,7 @@ private:
   void lonCtrlCmdCallback(const autoware_control_msgs::msg::ControlCommandStamped::SharedPtr msg);
   void publishCmd();
   bool checkTimeout();
+  void onTimer();
 
   rclcpp::Publisher<autoware_control_msgs::msg::ControlCommandStamped>::SharedPtr control_cmd_pub_;
   rclcpp::Subscription<autoware_control_msgs::msg::ControlCommandStamped>::SharedPtr
@@ -42,6 +43,15 @@ private:
   std::shared_ptr<autoware_control_msgs::msg::ControlCommandStamped> lat_cmd_;
   std::shared_ptr<autoware_control_msgs::msg::ControlCommandStamped> lon_cmd_;
   double timeout_thr_sec_;
+
+  // publish once per control cycle, when both the commands of the cycle are received
+  bool wait_for_both_commands_;
+  // the latest commands are published anyway when the other one is not received within it
+  double wait_timeout_sec_;
+  bool is_lat_cmd_updated_ = false;
+  bool is_lon_cmd_updated_ = false;
+  rclcpp::Time first_update_time_;
+  rclcpp::TimerBase::SharedPtr timer_;
 };
 
 #endif  // LATLON_MUXER__NODE_HPP_
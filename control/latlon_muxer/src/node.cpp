@@ -17,14 +17,21 @@
 #include <rclcpp/time.hpp>
 #include <rclcpp_components/register_node_macro.hpp>
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 
 LatLonMuxer::LatLonMuxer(const rclcpp::NodeOptions & node_options)
 : rclcpp::Node("latlon_muxer", node_options)
 {
+  // the intra-process communication only supports the volatile durability
+  rclcpp::QoS control_cmd_qos{1};
+  if (!get_node_options().use_intra_process_comms()) {
+    control_cmd_qos.transient_local();
+  }
   control_cmd_pub_ = create_publisher<autoware_control_msgs::msg::ControlCommandStamped>(
-    "output/control_cmd", rclcpp::QoS{1}.transient_local());
+    "output/control_cmd", control_cmd_qos);
   lat_control_cmd_sub_ = create_subscription<autoware_control_msgs::msg::ControlCommandStamped>(
     "input/lateral/control_cmd", rclcpp::QoS{1},
     std::bind(&LatLonMuxer::latCtrlCmdCallback, this, std::placeholders::_1));
@@ -32,6 +39,15 @@ LatLonMuxer::LatLonMuxer(const rclcpp::NodeOptions & node_options)
     "input/longitudinal/control_cmd", rclcpp::QoS{1},
     std::bind(&LatLonMuxer::lonCtrlCmdCallback, this, std::placeholders::_1));
   timeout_thr_sec_ = declare_parameter("timeout_thr_sec", 0.5);
+  wait_for_both_commands_ = declare_parameter("wait_for_both_commands", false);
+  wait_timeout_sec_ = declare_parameter("wait_timeout_sec", 0.02);
+
+  if (wait_for_both_commands_) {
+    const auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(wait_timeout_sec_));
+    timer_ =
+      rclcpp::create_timer(this, get_clock(), period, std::bind(&LatLonMuxer::onTimer, this));
+  }
 }
 
 bool LatLonMuxer::checkTimeout()
@@ -53,6 +69,8 @@ void LatLonMuxer::publishCmd()
   if (!lat_cmd_ || !lon_cmd_) {
     return;
   }
+  is_lat_cmd_updated_ = false;
+  is_lon_cmd_updated_ = false;
   if (!checkTimeout()) {
     RCLCPP_ERROR_THROTTLE(
       get_logger(), *get_clock(), 1000 /*ms*/, "timeout failed. stop publish command.");
@@ -74,14 +92,38 @@ void LatLonMuxer::latCtrlCmdCallback(
   const autoware_control_msgs::msg::ControlCommandStamped::SharedPtr input_msg)
 {
   lat_cmd_ = std::make_shared<autoware_control_msgs::msg::ControlCommandStamped>(*input_msg);
-  publishCmd();
+  if (!is_lat_cmd_updated_ && !is_lon_cmd_updated_) {
+    first_update_time_ = this->now();
+  }
+  is_lat_cmd_updated_ = true;
+  if (!wait_for_both_commands_ || is_lon_cmd_updated_) {
+    publishCmd();
+  }
 }
 
 void LatLonMuxer::lonCtrlCmdCallback(
   const autoware_control_msgs::msg::ControlCommandStamped::SharedPtr input_msg)
 {
   lon_cmd_ = std::make_shared<autoware_control_msgs::msg::ControlCommandStamped>(*input_msg);
-  publishCmd();
+  if (!is_lat_cmd_updated_ && !is_lon_cmd_updated_) {
+    first_update_time_ = this->now();
+  }
+  is_lon_cmd_updated_ = true;
+  if (!wait_for_both_commands_ || is_lat_cmd_updated_) {
+    publishCmd();
+  }
+}
+
+void LatLonMuxer::onTimer()
+{
+  // watchdog for a controller that has stopped or runs at a different rate, the timer does not
+  // delay the commands received in time
+  if (!is_lat_cmd_updated_ && !is_lon_cmd_updated_) {
+    return;
+  }
+  if ((this->now() - first_update_time_).seconds() >= wait_timeout_sec_) {
+    publishCmd();
+  }
 }
 
 RCLCPP_COMPONENTS_REGISTER_NODE(LatLonMuxer)
@@ -27,11 +27,14 @@
 #include "mpc_follower/mpc_trajectory.hpp"
 #include "mpc_follower/mpc_utils.hpp"
 #include "mpc_follower/qp_solver/qp_solver_osqp.hpp"
+#include "mpc_follower/qp_solver/qp_solver_osqp_sparse.hpp"
 #include "mpc_follower/qp_solver/qp_solver_unconstr_fast.hpp"
 #include "mpc_follower/vehicle_model/vehicle_model_bicycle_dynamics.hpp"
 #include "mpc_follower/vehicle_model/vehicle_model_bicycle_kinematics.hpp"
 #include "mpc_follower/vehicle_model/vehicle_model_bicycle_kinematics_no_delay.hpp"
 
+#include <autoware_utils/system/realtime.hpp>
+#include <diagnostic_updater/diagnostic_updater.hpp>
 #include <osqp_interface/osqp_interface.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
@@ -99,6 +102,8 @@ private:
 
   rclcpp::TimerBase::SharedPtr timer_;  //!< @brief timer to update after a given interval
   void initTimer(double period_s);  //!< initialize timer to work in real, simulation, and replay
+  autoware_utils::DeadlineMonitor timer_deadline_monitor_;  //!< @brief timer duration counter
+  std::unique_ptr<diagnostic_updater::Updater> updater_;    //!< @brief diagnostics in RT mode
 
   MPCTrajectory ref_traj_;                 //!< @brief reference trajectory to be followed
   Butterworth2dFilter lpf_steering_cmd_;   //!< @brief lowpass filter for steering command
@@ -107,6 +112,7 @@ private:
   std::string vehicle_model_type_;         //!< @brief vehicle model type for MPC
   std::shared_ptr<VehicleModelInterface> vehicle_model_ptr_;  //!< @brief vehicle model for MPC
   std::shared_ptr<QPSolverInterface> qpsolver_ptr_;           //!< @brief qp solver for MPC
+  std::shared_ptr<QPSolverOSQPSparse> sparse_qpsolver_ptr_;   //!< @brief sparse qp solver for MPC
   std::deque<double> input_buffer_;  //!< @brief mpc_output buffer for delay time compensation
 
   /* parameters for control*/
@@ -132,6 +138,12 @@ private:
   double stop_state_entry_ego_speed_;
   double stop_state_entry_target_speed_;
 
+  /* parameters for the reuse of the previous cycle */
+  bool enable_linearization_cache_;  //!< @brief flag to reuse the discrete matrices of each step
+  double linearization_cache_velocity_threshold_;   //!< @brief velocity change to relinearize [m/s]
+  double linearization_cache_curvature_threshold_;  //!< @brief curvature change to relinearize
+  bool enable_shifted_warm_start_;  //!< @brief flag to warm start with the shifted last solution
+
   struct MPCParam
   {
     int prediction_horizon;  //!< @brief prediction horizon step
@@ -190,6 +202,13 @@ private:
     Eigen::MatrixXd R1ex;
     Eigen::MatrixXd R2ex;
     Eigen::MatrixXd Uref_ex;
+
+    // matrices of each step for the non-condensed QP, Aex, Bex, Wex, Cex and Qex are empty then
+    // x(i) = Ad_vec[i] * x(i-1) + Bd_vec[i] * u(i) + Wd_vec[i]
+    std::vector<Eigen::MatrixXd> Ad_vec;
+    std::vector<Eigen::MatrixXd> Bd_vec;
+    std::vector<Eigen::MatrixXd> Wd_vec;
+    std::vector<Eigen::MatrixXd> CQC_vec;  //!< @brief weight of state, Cd' * Q * Cd
   };
 
   geometry_msgs::msg::PoseStamped::SharedPtr current_pose_ptr_;        //!< @brief measured pose
@@ -208,6 +227,20 @@ private:
   rclcpp::Time time_prev_ = rclcpp::Time(0, 0, RCL_ROS_TIME);
   double sign_vx_ = 0.0;  //!< @brief sign of previous target speed to calculate curvature when the
                           //!< target speed is 0.  //NOLINT
+
+  struct LinearizedModel
+  {
+    double vx;
+    double k;
+    Eigen::MatrixXd Ad;
+    Eigen::MatrixXd Bd;
+    Eigen::MatrixXd Cd;
+    Eigen::MatrixXd Wd;
+  };
+  std::vector<LinearizedModel> linearization_cache_;  //!< @brief discrete matrices of each step
+  MPCMatrix mpc_matrix_;  //!< @brief MPC matrix, reused over the periods to avoid reallocation
+  Eigen::VectorXd prev_Uex_;  //!< @brief optimal input of the previous period, empty if failed
+  Eigen::VectorXd prev_Xex_;  //!< @brief predicted state of the previous period, empty if failed
   std::vector<autoware_control_msgs::msg::ControlCommandStamped>
     ctrl_cmd_vec_;  //!< buffer of send command
 
@@ -292,15 +325,36 @@ private:
   /**
    * @brief generate MPC matrix with trajectory and vehicle model
    * @param [in] reference_trajectory used for linearization around reference trajectory
+   * @param [out] m MPC matrix, filled in place to reuse the memory of the previous period
    */
-  MPCMatrix generateMPCMatrix(const MPCTrajectory & reference_trajectory);
+  void generateMPCMatrix(const MPCTrajectory & reference_trajectory, MPCMatrix * m);
 
   /**
    * @brief generate MPC matrix with trajectory and vehicle model
-   * @param [out] Uex optimized input vector
+   * @param [in,out] Uex optimized input vector, the initial guess if it has the size of the inputs
+   * @param [in,out] Xex predicted state vector with the optimized input, the initial guess of the
+   * sparse solver if it has the size of the states
    */
   bool executeOptimization(
-    const MPCMatrix & mpc_matrix, const Eigen::VectorXd & x0, Eigen::VectorXd * Uex);
+    const MPCMatrix & mpc_matrix, const Eigen::VectorXd & x0, Eigen::VectorXd * Uex,
+    Eigen::VectorXd * Xex);
+
+  /**
+   * @brief solve the non-condensed QP, where the states are variables constrained by the dynamics
+   * @param [in,out] Uex optimized input vector, same as executeOptimization()
+   * @param [in,out] Xex predicted state vector with the optimized input, same as
+   * executeOptimization()
+   */
+  bool executeSparseOptimization(
+    const MPCMatrix & mpc_matrix, const Eigen::VectorXd & x0, Eigen::VectorXd * Uex,
+    Eigen::VectorXd * Xex);
+
+  /**
+   * @brief shift a solution of the previous period by the control period, the last step is held
+   * @param [in] prev_ex stacked vector of prev_ex.size() / dim steps of the prediction dt
+   * @param [in] dim dimension of a step
+   */
+  Eigen::VectorXd shiftPreviousSolution(const Eigen::VectorXd & prev_ex, const int dim) const;
 
   /**
    * @brief get stop command
@@ -43,7 +43,8 @@ public:
    * @param [in] up parameter matrix for constraint lb < U < ub
    * @param [in] lbA parameter matrix for constraint lbA < A*U < ubA
    * @param [in] ubA parameter matrix for constraint lbA < A*U < ubA
-   * @param [out] U optimal variable vector
+   * @param [in,out] U optimal variable vector, used as the initial guess by the solvers with warm
+   * start if it has the size of the variables on input
    * @return bool to check the problem is solved
    */
   virtual bool solve(
@@ -50,7 +50,7 @@ public:
    * @param [in] up parameter matrix for constraint lb < U < ub (not used here)
    * @param [in] lbA parameter matrix for constraint lbA < A*U < ubA (not used here)
    * @param [in] ubA parameter matrix for constraint lbA < A*U < ubA (not used here)
-   * @param [out] U optimal variable vector
+   * @param [in,out] U optimal variable vector, the initial guess if it has the variable size
    * @return bool to check the problem is solved
    */
   bool solve(
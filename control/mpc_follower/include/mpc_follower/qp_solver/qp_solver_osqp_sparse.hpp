@@ -0,0 +1,60 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file qp_solver_osqp_sparse.h
+ * @brief sparse qp solver with osqp
+ */
+
+#ifndef MPC_FOLLOWER__QP_SOLVER__QP_SOLVER_OSQP_SPARSE_HPP_
+#define MPC_FOLLOWER__QP_SOLVER__QP_SOLVER_OSQP_SPARSE_HPP_
+
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/SparseCore>
+#include <osqp_interface/osqp_interface.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+/**
+ * @brief QP solver for the non-condensed MPC problem, where the states are optimization variables
+ * with the dynamics as equality constraints. The matrices are sparse, so the cost grows linearly
+ * with the prediction horizon. The osqp workspace is kept while the sparsity pattern is the same.
+ */
+class QPSolverOSQPSparse
+{
+public:
+  /**
+   * @brief constructor
+   */
+  explicit QPSolverOSQPSparse(const rclcpp::Logger & logger);
+
+  /**
+   * @brief solve QP problem : minimize J = 1/2 * z' * P * z + q' * z subject to l < A * z < u
+   * @param [in] P parameter matrix in object function, only the upper triangular part is used
+   * @param [in] A parameter matrix for constraint l < A * z < u
+   * @param [in] q parameter vector in object function
+   * @param [in] l lower bound of the constraint, equal to u for the equality constraints
+   * @param [in] u upper bound of the constraint
+   * @param [in,out] z optimal variable vector, the initial guess if it has the variable size
+   * @return bool to check the problem is solved
+   */
+  bool solve(
+    const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+    const Eigen::VectorXd & q, const Eigen::VectorXd & l, const Eigen::VectorXd & u,
+    Eigen::VectorXd & z);
+
+private:
+  osqp::OSQPInterface osqpsolver_;
+  rclcpp::Logger logger_;
+};
+#endif  // MPC_FOLLOWER__QP_SOLVER__QP_SOLVER_OSQP_SPARSE_HPP_
@@ -102,9 +102,17 @@ MPCFollower::MPCFollower(const rclcpp::NodeOptions & node_options)
     qpsolver_ptr_ = std::make_shared<QPSolverEigenLeastSquareLLT>();
   } else if (qp_solver_type == "osqp") {
     qpsolver_ptr_ = std::make_shared<QPSolverOSQP>(get_logger());
+  } else if (qp_solver_type == "osqp_sparse") {
+    sparse_qpsolver_ptr_ = std::make_shared<QPSolverOSQPSparse>(get_logger());
   } else {
     RCLCPP_ERROR(get_logger(), "qp_solver_type is undefined");
   }
+  enable_shifted_warm_start_ = declare_parameter("enable_shifted_warm_start", false);
+  enable_linearization_cache_ = declare_parameter("enable_linearization_cache", false);
+  linearization_cache_velocity_threshold_ =
+    declare_parameter("linearization_cache_velocity_threshold", 0.1);
+  linearization_cache_curvature_threshold_ =
+    declare_parameter("linearization_cache_curvature_threshold", 0.001);
 
   /* delay compensation */
   {
@@ -126,6 +134,22 @@ MPCFollower::MPCFollower(const rclcpp::NodeOptions & node_options)
   /* set up ros system */
   initTimer(ctrl_period_);
 
+  /* real-time mode */
+  if (declare_parameter("use_realtime_mode", false)) {
+    const int realtime_priority = declare_parameter("realtime_priority", 80);
+    const int prefault_heap_size_mb = declare_parameter("prefault_heap_size_mb", 64);
+    if (!autoware_utils::lockMemory(static_cast<size_t>(prefault_heap_size_mb) << 20)) {
+      RCLCPP_WARN(get_logger(), "failed to lock the memory, CAP_IPC_LOCK is required.");
+    }
+    if (!autoware_utils::setRealtimePriority(realtime_priority)) {
+      RCLCPP_WARN(get_logger(), "failed to set SCHED_FIFO, CAP_SYS_NICE is required.");
+    }
+    updater_ = std::make_unique<diagnostic_updater::Updater>(this);
+    updater_->setHardwareID("mpc_follower");
+    updater_->add(
+      "control_timer_deadline", [this](auto & stat) { timer_deadline_monitor_.diagnose(stat); });
+  }
+
   pub_ctrl_cmd_ =
     create_publisher<autoware_control_msgs::msg::ControlCommandStamped>("~/output/control_raw", 1);
   pub_predicted_traj_ =
@@ -203,10 +227,10 @@ void MPCFollower::onTimer()
 
 bool MPCFollower::checkData()
 {
-  if (!vehicle_model_ptr_ || !qpsolver_ptr_) {
+  if (!vehicle_model_ptr_ || (!qpsolver_ptr_ && !sparse_qpsolver_ptr_)) {
     RCLCPP_DEBUG(
       get_logger(), "vehicle_model = %d, qp_solver = %d", vehicle_model_ptr_ != nullptr,
-      qpsolver_ptr_ != nullptr);
+      qpsolver_ptr_ != nullptr || sparse_qpsolver_ptr_ != nullptr);
     return false;
   }
 
@@ -267,11 +291,20 @@ bool MPCFollower::calculateMPC(autoware_control_msgs::msg::ControlCommand * ctrl
   }
 
   /* generate mpc matrix : predict equation Xec = Aex * x0 + Bex * Uex + Wex */
-  MPCMatrix mpc_matrix = generateMPCMatrix(mpc_resampled_ref_traj);
+  generateMPCMatrix(mpc_resampled_ref_traj, &mpc_matrix_);
+  const MPCMatrix & mpc_matrix = mpc_matrix_;
 
   /* solve quadratic optimization */
   Eigen::VectorXd Uex;
-  if (!executeOptimization(mpc_matrix, x0, &Uex)) {
+  Eigen::VectorXd Xex;
+  if (enable_shifted_warm_start_) {
+    Uex = shiftPreviousSolution(prev_Uex_, vehicle_model_ptr_->getDimU());
+    Xex = shiftPreviousSolution(prev_Xex_, vehicle_model_ptr_->getDimX());
+  }
+  const bool is_optimized = executeOptimization(mpc_matrix, x0, &Uex, &Xex);
+  prev_Uex_ = is_optimized ? Uex : Eigen::VectorXd();
+  prev_Xex_ = is_optimized ? Xex : Eigen::VectorXd();
+  if (!is_optimized) {
     RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), (1000ms).count(), "optimization failed.");
     return false;
   }
@@ -303,7 +336,6 @@ bool MPCFollower::calculateMPC(autoware_control_msgs::msg::ControlCommand * ctrl
 
   /* publish predicted trajectory */
   {
-    Eigen::VectorXd Xex = mpc_matrix.Aex * x0 + mpc_matrix.Bex * Uex + mpc_matrix.Wex;
     MPCTrajectory mpc_predicted_traj;
     const auto & traj = mpc_resampled_ref_traj;
     for (int i = 0; i < mpc_param_.prediction_horizon; ++i) {
@@ -578,6 +610,7 @@ bool MPCFollower::updateStateForDelayCompensation(
   Eigen::MatrixXd Cd(DIM_Y, DIM_X);
 
   Eigen::MatrixXd x_curr = *x;
+  Eigen::MatrixXd ud = Eigen::MatrixXd::Zero(DIM_U, 1);
   double mpc_curr_time = start_time;
   for (unsigned int i = 0; i < input_buffer_.size(); ++i) {
     double k = 0.0;
@@ -595,7 +628,6 @@ bool MPCFollower::updateStateForDelayCompensation(
     vehicle_model_ptr_->setVelocity(v);
     vehicle_model_ptr_->setCurvature(k);
     vehicle_model_ptr_->calculateDiscreteMatrix(Ad, Bd, Cd, Wd, ctrl_period_);
-    Eigen::MatrixXd ud = Eigen::MatrixXd::Zero(DIM_U, 1);
     ud(0, 0) = input_buffer_.at(i);  // for steering input delay
     x_curr = Ad * x_curr + Bd * ud + Wd;
     mpc_curr_time += ctrl_period_;
@@ -631,7 +663,7 @@ MPCTrajectory MPCFollower::applyVelocityDynamicsFilter(const MPCTrajectory & inp
  * cost function: J = Xex' * Qex * Xex + (Uex - Uref)' * R1ex * (Uex - Uref_ex) + Uex' * R2ex * Uex
  * Qex = diag([Q,Q,...]), R1ex = diag([R,R,...])
  */
-MPCFollower::MPCMatrix MPCFollower::generateMPCMatrix(const MPCTrajectory & reference_trajectory)
+void MPCFollower::generateMPCMatrix(const MPCTrajectory & reference_trajectory, MPCMatrix * m_ptr)
 {
   using Eigen::MatrixXd;
 
@@ -641,15 +673,26 @@ MPCFollower::MPCMatrix MPCFollower::generateMPCMatrix(const MPCTrajectory & refe
   const int DIM_U = vehicle_model_ptr_->getDimU();
   const int DIM_Y = vehicle_model_ptr_->getDimY();
 
-  MPCMatrix m;
-  m.Aex = MatrixXd::Zero(DIM_X * N, DIM_X);
-  m.Bex = MatrixXd::Zero(DIM_X * N, DIM_U * N);
-  m.Wex = MatrixXd::Zero(DIM_X * N, 1);
-  m.Cex = MatrixXd::Zero(DIM_Y * N, DIM_X * N);
-  m.Qex = MatrixXd::Zero(DIM_Y * N, DIM_Y * N);
-  m.R1ex = MatrixXd::Zero(DIM_U * N, DIM_U * N);
-  m.R2ex = MatrixXd::Zero(DIM_U * N, DIM_U * N);
-  m.Uref_ex = MatrixXd::Zero(DIM_U * N, 1);
+  // the condensed matrices have O(N^2) elements, they are only built for the dense solvers
+  const bool is_condensed = !sparse_qpsolver_ptr_;
+
+  // setZero only reallocates when the horizon or the model changes
+  MPCMatrix & m = *m_ptr;
+  if (is_condensed) {
+    m.Aex.setZero(DIM_X * N, DIM_X);
+    m.Bex.setZero(DIM_X * N, DIM_U * N);
+    m.Wex.setZero(DIM_X * N, 1);
+    m.Cex.setZero(DIM_Y * N, DIM_X * N);
+    m.Qex.setZero(DIM_Y * N, DIM_Y * N);
+  } else {
+    m.Ad_vec.resize(N);
+    m.Bd_vec.resize(N);
+    m.Wd_vec.resize(N);
+    m.CQC_vec.resize(N);
+  }
+  m.R1ex.setZero(DIM_U * N, DIM_U * N);
+  m.R2ex.setZero(DIM_U * N, DIM_U * N);
+  m.Uref_ex.setZero(DIM_U * N, 1);
 
   /* weight matrix depends on the vehicle model */
   MatrixXd Q = MatrixXd::Zero(DIM_Y, DIM_Y);
@@ -662,6 +705,7 @@ MPCFollower::MPCMatrix MPCFollower::generateMPCMatrix(const MPCTrajectory & refe
   MatrixXd Wd(DIM_X, 1);
   MatrixXd Cd(DIM_Y, DIM_X);
   MatrixXd Uref(DIM_U, 1);
+  MatrixXd QC(DIM_Y, DIM_X);
 
   constexpr double ep = 1.0e-3;  // large enough to ignore velocity noise
 
@@ -675,12 +719,38 @@ MPCFollower::MPCMatrix MPCFollower::generateMPCMatrix(const MPCTrajectory & refe
     const double ref_smooth_k = reference_trajectory.smooth_k[i] * sign_vx_;
 
     /* get discrete state matrix A, B, C, W */
+    // the cache follows the reference of the step, which only shifts by the control period while
+    // the trajectory and the velocity do not change
     vehicle_model_ptr_->setVelocity(ref_vx);
     vehicle_model_ptr_->setCurvature(ref_k);
-    vehicle_model_ptr_->calculateDiscreteMatrix(Ad, Bd, Cd, Wd, DT);
+    const bool is_cached =
+      enable_linearization_cache_ && i < static_cast<int>(linearization_cache_.size()) &&
+      std::fabs(linearization_cache_.at(i).vx - ref_vx) <
+        linearization_cache_velocity_threshold_ &&
+      std::fabs(linearization_cache_.at(i).k - ref_k) < linearization_cache_curvature_threshold_;
+    if (is_cached) {
+      const auto & cache = linearization_cache_.at(i);
+      Ad = cache.Ad;
+      Bd = cache.Bd;
+      Cd = cache.Cd;
+      Wd = cache.Wd;
+    } else {
+      vehicle_model_ptr_->calculateDiscreteMatrix(Ad, Bd, Cd, Wd, DT);
+      if (enable_linearization_cache_) {
+        linearization_cache_.resize(std::max(static_cast<int>(linearization_cache_.size()), i + 1));
+        // assigned member by member to reuse the matrices of the entry
+        auto & cache = linearization_cache_.at(i);
+        cache.vx = ref_vx;
+        cache.k = ref_k;
+        cache.Ad = Ad;
+        cache.Bd = Bd;
+        cache.Cd = Cd;
+        cache.Wd = Wd;
+      }
+    }
 
-    Q = Eigen::MatrixXd::Zero(DIM_Y, DIM_Y);
-    R = Eigen::MatrixXd::Zero(DIM_U, DIM_U);
+    Q.setZero();
+    R.setZero();
     Q(0, 0) = getWeightLatError(ref_k);
     Q(1, 1) = getWeightHeadingError(ref_k);
     R(0, 0) = getWeightSteerInput(ref_k);
@@ -699,23 +769,34 @@ MPCFollower::MPCMatrix MPCFollower::generateMPCMatrix(const MPCTrajectory & refe
     int idx_x_i_prev = (i - 1) * DIM_X;
     int idx_u_i = i * DIM_U;
     int idx_y_i = i * DIM_Y;
-    if (i == 0) {
-      m.Aex.block(0, 0, DIM_X, DIM_X) = Ad;
-      m.Bex.block(0, 0, DIM_X, DIM_U) = Bd;
-      m.Wex.block(0, 0, DIM_X, 1) = Wd;
-    } else {
-      m.Aex.block(idx_x_i, 0, DIM_X, DIM_X) = Ad * m.Aex.block(idx_x_i_prev, 0, DIM_X, DIM_X);
-      for (int j = 0; j < i; ++j) {
-        int idx_u_j = j * DIM_U;
-        m.Bex.block(idx_x_i, idx_u_j, DIM_X, DIM_U) =
-          Ad * m.Bex.block(idx_x_i_prev, idx_u_j, DIM_X, DIM_U);
+    m.R1ex.block(idx_u_i, idx_u_i, DIM_U, DIM_U) = R_adaptive;
+    if (is_condensed) {
+      if (i == 0) {
+        m.Aex.block(0, 0, DIM_X, DIM_X) = Ad;
+        m.Bex.block(0, 0, DIM_X, DIM_U) = Bd;
+        m.Wex.block(0, 0, DIM_X, 1) = Wd;
+      } else {
+        // the blocks of the previous step don't overlap, so the products need no temporary
+        m.Aex.block(idx_x_i, 0, DIM_X, DIM_X).noalias() =
+          Ad * m.Aex.block(idx_x_i_prev, 0, DIM_X, DIM_X);
+        for (int j = 0; j < i; ++j) {
+          int idx_u_j = j * DIM_U;
+          m.Bex.block(idx_x_i, idx_u_j, DIM_X, DIM_U).noalias() =
+            Ad * m.Bex.block(idx_x_i_prev, idx_u_j, DIM_X, DIM_U);
+        }
+        m.Wex.block(idx_x_i, 0, DIM_X, 1).noalias() = Ad * m.Wex.block(idx_x_i_prev, 0, DIM_X, 1);
+        m.Wex.block(idx_x_i, 0, DIM_X, 1) += Wd;
       }
-      m.Wex.block(idx_x_i, 0, DIM_X, 1) = Ad * m.Wex.block(idx_x_i_prev, 0, DIM_X, 1) + Wd;
+      m.Bex.block(idx_x_i, idx_u_i, DIM_X, DIM_U) = Bd;
+      m.Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X) = Cd;
+      m.Qex.block(idx_y_i, idx_y_i, DIM_Y, DIM_Y) = Q_adaptive;
+    } else {
+      m.Ad_vec.at(i) = Ad;
+      m.Bd_vec.at(i) = Bd;
+      m.Wd_vec.at(i) = Wd;
+      QC.noalias() = Q_adaptive * Cd;
+      m.CQC_vec.at(i).noalias() = Cd.transpose() * QC;
     }
-    m.Bex.block(idx_x_i, idx_u_i, DIM_X, DIM_U) = Bd;
-    m.Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X) = Cd;
-    m.Qex.block(idx_y_i, idx_y_i, DIM_Y, DIM_Y) = Q_adaptive;
-    m.R1ex.block(idx_u_i, idx_u_i, DIM_U, DIM_U) = R_adaptive;
 
     /* get reference input (feed-forward) */
     vehicle_model_ptr_->setCurvature(ref_smooth_k);
@@ -737,8 +818,6 @@ MPCFollower::MPCMatrix MPCFollower::generateMPCMatrix(const MPCTrajectory & refe
   }
 
   addSteerWeightR(&m.R1ex);
-
-  return m;
 }
 
 /*
@@ -764,7 +843,7 @@ MPCFollower::MPCMatrix MPCFollower::generateMPCMatrix(const MPCTrajectory & refe
  * [    -au_lim * dt    ] < [uN-uN-1] < [     au_lim * dt    ] (*N... DIM_U)
  */
 bool MPCFollower::executeOptimization(
-  const MPCMatrix & m, const Eigen::VectorXd & x0, Eigen::VectorXd * Uex)
+  const MPCMatrix & m, const Eigen::VectorXd & x0, Eigen::VectorXd * Uex, Eigen::VectorXd * Xex)
 {
   using Eigen::MatrixXd;
   using Eigen::VectorXd;
@@ -775,6 +854,10 @@ bool MPCFollower::executeOptimization(
     return false;
   }
 
+  if (sparse_qpsolver_ptr_) {
+    return executeSparseOptimization(m, x0, Uex, Xex);
+  }
+
   const int DIM_U_N = mpc_param_.prediction_horizon * vehicle_model_ptr_->getDimU();
 
   // cost function: 1/2 * Uex' * H * Uex + f' * Uex,  H = B' * C' * Q * C * B + R
@@ -819,6 +902,133 @@ bool MPCFollower::executeOptimization(
       get_logger(), *get_clock(), (1000ms).count(), "model Uex includes NaN, stop MPC.");
     return false;
   }
+
+  *Xex = m.Aex * x0 + m.Bex * *Uex + m.Wex;
+  return true;
+}
+
+/*
+ * solve the quadratic optimization without condensing the states.
+ * variables: z = [Uex; Xex], Xex = [x(0); x(1); ...; x(N-1)]
+ * cost function: J = 1/2 * z' * P * z + q' * z
+ *                , P = diag([R1ex + R2ex, C'QC(0), C'QC(1), ...]), q = [-R1ex * Uref_ex; 0]
+ * constraint matrix : [Wex; lb; lbA] < [-Bd, Sx; I, 0; A, 0] z < [Wex; ub; ubA]
+ *  - dynamics : x(i) - Ad(i) * x(i-1) - Bd(i) * u(i) = Wd(i), x(-1) = x0
+ *  - steering limit, steering rate limit : same as executeOptimization()
+ * all the matrices are block banded, so the cost is linear in the prediction horizon.
+ */
+bool MPCFollower::executeSparseOptimization(
+  const MPCMatrix & m, const Eigen::VectorXd & x0, Eigen::VectorXd * Uex, Eigen::VectorXd * Xex)
+{
+  using Eigen::MatrixXd;
+  using Eigen::VectorXd;
+
+  const int N = mpc_param_.prediction_horizon;
+  const int DIM_X = vehicle_model_ptr_->getDimX();
+  const int DIM_U = vehicle_model_ptr_->getDimU();
+  const int DIM_U_N = N * DIM_U;
+  const int DIM_X_N = N * DIM_X;
+
+  // every element of the bands is inserted even if it is zero, to keep the sparsity pattern
+  std::vector<Eigen::Triplet<double>> P_triplets;
+  std::vector<Eigen::Triplet<double>> A_triplets;
+
+  /* cost function */
+  // R1ex + R2ex with the steering weights has a bandwidth of 2 inputs
+  const MatrixXd R = m.R1ex + m.R2ex;
+  for (int i = 0; i < DIM_U_N; ++i) {
+    for (int j = i; j < std::min(i + 3 * DIM_U, DIM_U_N); ++j) {
+      P_triplets.emplace_back(i, j, R(i, j));
+    }
+  }
+  for (int i = 0; i < N; ++i) {
+    const int idx_x_i = DIM_U_N + i * DIM_X;
+    for (int r = 0; r < DIM_X; ++r) {
+      for (int c = r; c < DIM_X; ++c) {
+        P_triplets.emplace_back(idx_x_i + r, idx_x_i + c, m.CQC_vec.at(i)(r, c));
+      }
+    }
+  }
+
+  MatrixXd f = -m.Uref_ex.transpose() * m.R1ex;
+  addSteerWeightF(&f);
+  VectorXd q = VectorXd::Zero(DIM_U_N + DIM_X_N);
+  q.head(DIM_U_N) = f.transpose();
+
+  /* constraint */
+  VectorXd l(DIM_X_N + 2 * DIM_U_N);
+  VectorXd u(DIM_X_N + 2 * DIM_U_N);
+
+  // dynamics
+  for (int i = 0; i < N; ++i) {
+    const int idx_x_i = i * DIM_X;
+    const int idx_u_i = i * DIM_U;
+    for (int r = 0; r < DIM_X; ++r) {
+      A_triplets.emplace_back(idx_x_i + r, DIM_U_N + idx_x_i + r, 1.0);
+      for (int c = 0; c < DIM_U; ++c) {
+        A_triplets.emplace_back(idx_x_i + r, idx_u_i + c, -m.Bd_vec.at(i)(r, c));
+      }
+      if (i > 0) {
+        for (int c = 0; c < DIM_X; ++c) {
+          A_triplets.emplace_back(
+            idx_x_i + r, DIM_U_N + idx_x_i - DIM_X + c, -m.Ad_vec.at(i)(r, c));
+        }
+      }
+    }
+    VectorXd w = m.Wd_vec.at(i);
+    if (i == 0) {
+      w += m.Ad_vec.at(0) * x0;
+    }
+    l.segment(idx_x_i, DIM_X) = w;
+    u.segment(idx_x_i, DIM_X) = w;
+  }
+
+  // steering angle and steering rate
+  for (int i = 0; i < DIM_U_N; ++i) {
+    A_triplets.emplace_back(DIM_X_N + i, i, 1.0);
+    A_triplets.emplace_back(DIM_X_N + DIM_U_N + i, i, 1.0);
+    if (i > 0) {
+      A_triplets.emplace_back(DIM_X_N + DIM_U_N + i, i - 1, -1.0);
+    }
+  }
+  l.segment(DIM_X_N, DIM_U_N).setConstant(-steer_lim_);
+  u.segment(DIM_X_N, DIM_U_N).setConstant(steer_lim_);
+  l.segment(DIM_X_N + DIM_U_N, DIM_U_N).setConstant(-steer_rate_lim_ * mpc_param_.prediction_dt);
+  u.segment(DIM_X_N + DIM_U_N, DIM_U_N).setConstant(steer_rate_lim_ * mpc_param_.prediction_dt);
+  l(DIM_X_N + DIM_U_N) = raw_steer_cmd_prev_ - steer_rate_lim_ * ctrl_period_;
+  u(DIM_X_N + DIM_U_N) = raw_steer_cmd_prev_ + steer_rate_lim_ * ctrl_period_;
+
+  Eigen::SparseMatrix<double> P(DIM_U_N + DIM_X_N, DIM_U_N + DIM_X_N);
+  P.setFromTriplets(P_triplets.begin(), P_triplets.end());
+  Eigen::SparseMatrix<double> A(DIM_X_N + 2 * DIM_U_N, DIM_U_N + DIM_X_N);
+  A.setFromTriplets(A_triplets.begin(), A_triplets.end());
+
+  auto t_start = std::chrono::system_clock::now();
+  VectorXd z;
+  if (Uex->size() == DIM_U_N && Xex->size() == DIM_X_N) {
+    z.resize(DIM_U_N + DIM_X_N);
+    z << *Uex, *Xex;
+  }
+  bool solve_result = sparse_qpsolver_ptr_->solve(P, A, q, l, u, z);
+  auto t_end = std::chrono::system_clock::now();
+  if (!solve_result) {
+    RCLCPP_WARN_SKIPFIRST_THROTTLE(get_logger(), *get_clock(), (1000ms).count(), "qp solver error");
+    return false;
+  }
+
+  {
+    auto t = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start).count() * 1.0e-6;
+    RCLCPP_DEBUG(get_logger(), "qp solver calculation time = %f [ms]", t);
+  }
+
+  if (z.size() != DIM_U_N + DIM_X_N || z.array().isNaN().any()) {
+    RCLCPP_WARN_SKIPFIRST_THROTTLE(
+      get_logger(), *get_clock(), (1000ms).count(), "model Uex includes NaN, stop MPC.");
+    return false;
+  }
+
+  *Uex = z.head(DIM_U_N);
+  *Xex = z.tail(DIM_X_N);
   return true;
 }
 
@@ -899,6 +1109,27 @@ double MPCFollower::getPredictionTime() const
          ctrl_period_;
 }
 
+Eigen::VectorXd MPCFollower::shiftPreviousSolution(
+  const Eigen::VectorXd & prev_ex, const int dim) const
+{
+  const int N = mpc_param_.prediction_horizon;
+  if (prev_ex.size() != N * dim) {
+    return Eigen::VectorXd();
+  }
+
+  // the horizon of this period starts ctrl_period later than the previous one
+  const double shift = ctrl_period_ / mpc_param_.prediction_dt;
+  Eigen::VectorXd ex(N * dim);
+  for (int i = 0; i < N; ++i) {
+    const double t = std::min(i + shift, static_cast<double>(N - 1));
+    const int idx = std::min(static_cast<int>(t), std::max(N - 2, 0));
+    const double ratio = N > 1 ? t - idx : 0.0;
+    ex.segment(i * dim, dim) = (1.0 - ratio) * prev_ex.segment(idx * dim, dim) +
+                               ratio * prev_ex.segment(std::min(idx + 1, N - 1) * dim, dim);
+  }
+  return ex;
+}
+
 bool MPCFollower::isValid(const MPCMatrix & m) const
 {
   if (
@@ -915,6 +1146,14 @@ bool MPCFollower::isValid(const MPCMatrix & m) const
     return false;
   }
 
+  for (const auto * stage_matrices : {&m.Ad_vec, &m.Bd_vec, &m.Wd_vec, &m.CQC_vec}) {
+    for (const auto & stage_matrix : *stage_matrices) {
+      if (!stage_matrix.allFinite()) {
+        return false;
+      }
+    }
+  }
+
   return true;
 }
 void MPCFollower::onTrajectory(const autoware_planning_msgs::msg::Trajectory::SharedPtr msg)
@@ -924,6 +1163,7 @@ void MPCFollower::onTrajectory(const autoware_planning_msgs::msg::Trajectory::Sh
   }
 
   current_trajectory_ptr_ = msg;
+  linearization_cache_.clear();
 
   if (msg->points.size() < 3) {
     RCLCPP_DEBUG(get_logger(), "received path size is < 3, not enough.");
@@ -1133,7 +1373,12 @@ void MPCFollower::publishCtrlCmd(const autoware_control_msgs::msg::ControlComman
 
 void MPCFollower::initTimer(double period_s)
 {
-  auto timer_callback = std::bind(&MPCFollower::onTimer, this);
+  timer_deadline_monitor_.setDeadline(period_s);
+  auto timer_callback = [this]() {
+    timer_deadline_monitor_.start();
+    onTimer();
+    timer_deadline_monitor_.stop();
+  };
   const auto period_ns =
     std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(period_s));
   timer_ = std::make_shared<rclcpp::GenericTimer<decltype(timer_callback)>>(
@@ -1248,6 +1493,13 @@ rcl_interfaces::msg::SetParametersResult MPCFollower::paramCallback(
     }
 
     // transaction succeeds, now assign values
+    if (
+      param.prediction_horizon != mpc_param_.prediction_horizon ||
+      param.prediction_dt != mpc_param_.prediction_dt) {
+      linearization_cache_.clear();
+      prev_Uex_ = Eigen::VectorXd();
+      prev_Xex_ = Eigen::VectorXd();
+    }
     mpc_param_ = param;
   } catch (const rclcpp::exceptions::InvalidParameterTypeException & e) {
     result.successful = false;
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 geometry_msgs::msg::Quaternion MPCUtils::getQuaternionFromYaw(const double & yaw)
@@ -133,13 +134,17 @@ bool MPCUtils::resampleMPCTrajectoryByDistance(
 
   LinearInterpolate linear_interp;
 
-  output->x = interpolation::slerp(input_arclength, input.x, output_arclength);
-  output->y = interpolation::slerp(input_arclength, input.y, output_arclength);
-  output->z = interpolation::slerp(input_arclength, input.z, output_arclength);
-  output->yaw = interpolation::slerp(input_arclength, input.yaw, output_arclength);
+  const interpolation::MultiChannelSpline spline(
+    input_arclength, {input.x, input.y, input.z, input.yaw, input.k, input.smooth_k});
+  std::vector<std::vector<double>> splined_values;
+  spline.interpolate(output_arclength, splined_values);
+  output->x = std::move(splined_values.at(0));
+  output->y = std::move(splined_values.at(1));
+  output->z = std::move(splined_values.at(2));
+  output->yaw = std::move(splined_values.at(3));
   output->vx = interpolation::lerp(input_arclength, input.vx, output_arclength);
-  output->k = interpolation::slerp(input_arclength, input.k, output_arclength);
-  output->smooth_k = interpolation::slerp(input_arclength, input.smooth_k, output_arclength);
+  output->k = std::move(splined_values.at(4));
+  output->smooth_k = std::move(splined_values.at(5));
   output->relative_time =
     interpolation::lerp(input_arclength, input.relative_time, output_arclength);
 
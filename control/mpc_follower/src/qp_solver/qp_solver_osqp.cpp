@@ -48,7 +48,11 @@ bool QPSolverOSQP::solve(
   osqpA << I, A;
 
   /* execute optimization */
-  auto result = osqpsolver_.optimize(Hmat, osqpA, f, lower_bound, upper_bound);
+  osqpsolver_.updateProblem(Hmat, osqpA, f, lower_bound, upper_bound);
+  if (U.size() == DIM_U) {
+    osqpsolver_.setWarmStart(std::vector<double>(U.data(), U.data() + U.size()));
+  }
+  auto result = osqpsolver_.optimize();
 
   std::vector<double> U_osqp = std::get<0>(result);
   U = Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, 1>>(&U_osqp[0], U_osqp.size(), 1);
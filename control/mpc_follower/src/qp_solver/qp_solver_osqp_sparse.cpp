@@ -0,0 +1,60 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpc_follower/qp_solver/qp_solver_osqp_sparse.hpp"
+
+#include <osqp_interface/csc_matrix_conv.hpp>
+
+#include <vector>
+
+QPSolverOSQPSparse::QPSolverOSQPSparse(const rclcpp::Logger & logger) : logger_{logger} {}
+
+bool QPSolverOSQPSparse::solve(
+  const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+  const Eigen::VectorXd & q, const Eigen::VectorXd & l, const Eigen::VectorXd & u,
+  Eigen::VectorXd & z)
+{
+  const std::vector<double> q_vec(q.data(), q.data() + q.size());
+  const std::vector<double> l_vec(l.data(), l.data() + l.size());
+  const std::vector<double> u_vec(u.data(), u.data() + u.size());
+
+  // the pattern only depends on the horizon, so the factorization is set up once
+  osqpsolver_.updateProblem(
+    osqp::calCSCMatrixTrapezoidal(P), osqp::calCSCMatrix(A), q_vec, l_vec, u_vec);
+  if (z.size() == q.size()) {
+    osqpsolver_.setWarmStart(std::vector<double>(z.data(), z.data() + z.size()));
+  }
+
+  /* execute optimization */
+  auto result = osqpsolver_.optimize();
+
+  std::vector<double> z_osqp = std::get<0>(result);
+  z = Eigen::Map<Eigen::VectorXd>(z_osqp.data(), z_osqp.size());
+
+  const int status_val = std::get<3>(result);
+  if (status_val != 1) {
+    RCLCPP_WARN(logger_, "optimization failed : %s", osqpsolver_.getStatusMessage().c_str());
+  }
+
+  // polish status: successful (1), unperformed (0), (-1) unsuccessful
+  const int status_polish = std::get<2>(result);
+  if (status_polish == -1) {
+    RCLCPP_WARN(logger_, "osqp status_polish = %d (unsuccessful)", status_polish);
+    return false;
+  }
+  if (status_polish == 0) {
+    RCLCPP_WARN(logger_, "osqp status_polish = %d (unperformed)", status_polish);
+  }
+  return true;
+}
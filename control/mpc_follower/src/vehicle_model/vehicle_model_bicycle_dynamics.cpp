@@ -44,35 +44,36 @@ void DynamicsBicycleModel::calculateDiscreteMatrix(
 
   const double vel = std::max(velocity_, 0.01);
 
-  Ad = Eigen::MatrixXd::Zero(dim_x_, dim_x_);
-  Ad(0, 1) = 1.0;
-  Ad(1, 1) = -(cf_ + cr_) / (mass_ * vel);
-  Ad(1, 2) = (cf_ + cr_) / mass_;
-  Ad(1, 3) = (lr_ * cr_ - lf_ * cf_) / (mass_ * vel);
-  Ad(2, 3) = 1.0;
-  Ad(3, 1) = (lr_ * cr_ - lf_ * cf_) / (iz_ * vel);
-  Ad(3, 2) = (lf_ * cf_ - lr_ * cr_) / iz_;
-  Ad(3, 3) = -(lf_ * lf_ * cf_ + lr_ * lr_ * cr_) / (iz_ * vel);
+  // fixed-size, so that the discretization in each step of the horizon does not allocate
+  Eigen::Matrix4d A = Eigen::Matrix4d::Zero();
+  A(0, 1) = 1.0;
+  A(1, 1) = -(cf_ + cr_) / (mass_ * vel);
+  A(1, 2) = (cf_ + cr_) / mass_;
+  A(1, 3) = (lr_ * cr_ - lf_ * cf_) / (mass_ * vel);
+  A(2, 3) = 1.0;
+  A(3, 1) = (lr_ * cr_ - lf_ * cf_) / (iz_ * vel);
+  A(3, 2) = (lf_ * cf_ - lr_ * cr_) / iz_;
+  A(3, 3) = -(lf_ * lf_ * cf_ + lr_ * lr_ * cr_) / (iz_ * vel);
 
-  Eigen::MatrixXd I = Eigen::MatrixXd::Identity(dim_x_, dim_x_);
-  Eigen::MatrixXd Ad_inverse = (I - dt * 0.5 * Ad).inverse();
+  const Eigen::Matrix4d I = Eigen::Matrix4d::Identity();
+  const Eigen::Matrix4d Ad_inverse = (I - dt * 0.5 * A).inverse();
 
-  Ad = Ad_inverse * (I + dt * 0.5 * Ad);  // bilinear discretization
+  Ad = Ad_inverse * (I + dt * 0.5 * A);  // bilinear discretization
 
-  Bd = Eigen::MatrixXd::Zero(dim_x_, dim_u_);
-  Bd(0, 0) = 0.0;
-  Bd(1, 0) = cf_ / mass_;
-  Bd(2, 0) = 0.0;
-  Bd(3, 0) = lf_ * cf_ / iz_;
+  Eigen::Vector4d B;
+  B(0) = 0.0;
+  B(1) = cf_ / mass_;
+  B(2) = 0.0;
+  B(3) = lf_ * cf_ / iz_;
 
-  Wd = Eigen::MatrixXd::Zero(dim_x_, 1);
-  Wd(0, 0) = 0.0;
-  Wd(1, 0) = (lr_ * cr_ - lf_ * cf_) / (mass_ * vel) - vel;
-  Wd(2, 0) = 0.0;
-  Wd(3, 0) = -(lf_ * lf_ * cf_ + lr_ * lr_ * cr_) / (iz_ * vel);
+  Eigen::Vector4d W;
+  W(0) = 0.0;
+  W(1) = (lr_ * cr_ - lf_ * cf_) / (mass_ * vel) - vel;
+  W(2) = 0.0;
+  W(3) = -(lf_ * lf_ * cf_ + lr_ * lr_ * cr_) / (iz_ * vel);
 
-  Bd = (Ad_inverse * dt) * Bd;
-  Wd = (Ad_inverse * dt * curvature_ * vel) * Wd;
+  Bd = (Ad_inverse * dt) * B;
+  Wd = (Ad_inverse * dt * curvature_ * vel) * W;
 
   Cd = Eigen::MatrixXd::Zero(dim_y_, dim_x_);
   Cd(0, 0) = 1.0;
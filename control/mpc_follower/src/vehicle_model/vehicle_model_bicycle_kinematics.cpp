@@ -42,10 +42,12 @@ void KinematicsBicycleModel::calculateDiscreteMatrix(
     velocity = 1e-04 * (velocity_ >= 0 ? 1 : -1);
   }
 
-  Ad << 0.0, velocity, 0.0, 0.0, 0.0, velocity / wheelbase_ * cos_delta_r_squared_inv, 0.0, 0.0,
+  // fixed-size, so that the discretization in each step of the horizon does not allocate
+  Eigen::Matrix3d A;
+  A << 0.0, velocity, 0.0, 0.0, 0.0, velocity / wheelbase_ * cos_delta_r_squared_inv, 0.0, 0.0,
     -1.0 / steer_tau_;
-  Eigen::MatrixXd I = Eigen::MatrixXd::Identity(dim_x_, dim_x_);
-  Ad = (I - dt * 0.5 * Ad).inverse() * (I + dt * 0.5 * Ad);  // bilinear discretization
+  const Eigen::Matrix3d I = Eigen::Matrix3d::Identity();
+  Ad = (I - dt * 0.5 * A).inverse() * (I + dt * 0.5 * A);  // bilinear discretization
 
   Bd << 0.0, 0.0, 1.0 / steer_tau_;
   Bd *= dt;
@@ -35,9 +35,7 @@ void KinematicsBicycleModelNoDelay::calculateDiscreteMatrix(
   }
   double cos_delta_r_squared_inv = 1 / (cos(delta_r) * cos(delta_r));
 
-  Ad << 0.0, velocity_, 0.0, 0.0;
-  Eigen::MatrixXd I = Eigen::MatrixXd::Identity(dim_x_, dim_x_);
-  Ad = I + Ad * dt;
+  Ad << 1.0, velocity_ * dt, 0.0, 1.0;
 
   Bd << 0.0, velocity_ / wheelbase_ * cos_delta_r_squared_inv;
   Bd *= dt;
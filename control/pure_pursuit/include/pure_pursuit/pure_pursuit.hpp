@@ -47,7 +47,14 @@ namespace planning_utils
 class PurePursuit
 {
 public:
-  PurePursuit() : lookahead_distance_(0.0), clst_thr_dist_(3.0), clst_thr_ang_(M_PI / 4) {}
+  PurePursuit()
+  : lookahead_distance_(0.0),
+    clst_thr_dist_(3.0),
+    clst_thr_ang_(M_PI / 4),
+    clst_search_range_(20),
+    prev_clst_idx_(-1)
+  {
+  }
   ~PurePursuit() = default;
 
   rclcpp::Logger logger = rclcpp::get_logger("pure_pursuit");
@@ -75,9 +82,13 @@ private:
 
   // variables got from outside
   double lookahead_distance_, clst_thr_dist_, clst_thr_ang_;
+  int32_t clst_search_range_;
   std::shared_ptr<std::vector<geometry_msgs::msg::Pose>> curr_wps_ptr_;
   std::shared_ptr<geometry_msgs::msg::Pose> curr_pose_ptr_;
 
+  // closest index of the previous run, used as a search hint while the waypoints are unchanged
+  int32_t prev_clst_idx_;
+
   // functions
   int32_t findNextPointIdx(int32_t search_start_idx);
   std::pair<bool, geometry_msgs::msg::Point> lerpNextTarget(int32_t next_wp_idx);
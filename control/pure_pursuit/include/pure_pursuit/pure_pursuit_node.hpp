@@ -85,6 +85,8 @@ private:
   rclcpp::Subscription<geometry_msgs::msg::TwistStamped>::SharedPtr sub_current_velocity_;
 
   autoware_planning_msgs::msg::Trajectory::ConstSharedPtr trajectory_;
+  std::vector<geometry_msgs::msg::Pose> trajectory_poses_;
+  int32_t prev_target_idx_ = -1;
   geometry_msgs::msg::TwistStamped::ConstSharedPtr current_velocity_;
 
   bool isDataReady();
@@ -118,7 +120,7 @@ private:
   std::unique_ptr<planning_utils::PurePursuit> pure_pursuit_;
 
   boost::optional<TargetValues> calcTargetValues();
-  boost::optional<autoware_planning_msgs::msg::TrajectoryPoint> calcTargetPoint() const;
+  boost::optional<autoware_planning_msgs::msg::TrajectoryPoint> calcTargetPoint();
 
   // Debug
   mutable DebugData debug_data_;
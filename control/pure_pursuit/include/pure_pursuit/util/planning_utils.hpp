@@ -61,6 +61,13 @@ std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
   const geometry_msgs::msg::Pose & current_pose, const double th_dist = 3.0,
   const double th_yaw = M_PI_2);
 
+// search only around hint_idx, falling back to the whole poses when the hint is invalid, nothing
+// is found in the window or the closest point is on the window edge
+std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
+  const std::vector<geometry_msgs::msg::Pose> & poses,
+  const geometry_msgs::msg::Pose & current_pose, const double th_dist, const double th_yaw,
+  const int32_t hint_idx, const int32_t search_range);
+
 int8_t getLaneDirection(const std::vector<geometry_msgs::msg::Pose> & poses, double th_dist = 0.5);
 bool isDirectionForward(
   const geometry_msgs::msg::Pose & prev, const geometry_msgs::msg::Pose & next);
@@ -139,6 +139,9 @@ void PurePursuitNode::onTrajectory(
   const autoware_planning_msgs::msg::Trajectory::ConstSharedPtr msg)
 {
   trajectory_ = msg;
+  trajectory_poses_ = planning_utils::extractPoses(*msg);
+  prev_target_idx_ = -1;
+  pure_pursuit_->setWaypoints(trajectory_poses_);
 }
 
 void PurePursuitNode::onTimer()
@@ -206,7 +209,6 @@ boost::optional<TargetValues> PurePursuitNode::calcTargetValues()
 
   // Set PurePursuit data
   pure_pursuit_->setCurrentPose(current_pose_->pose);
-  pure_pursuit_->setWaypoints(planning_utils::extractPoses(*trajectory_));
   pure_pursuit_->setLookaheadDistance(lookahead_distance);
 
   // Run PurePursuit
@@ -224,10 +226,11 @@ boost::optional<TargetValues> PurePursuitNode::calcTargetValues()
 }
 
 boost::optional<autoware_planning_msgs::msg::TrajectoryPoint> PurePursuitNode::calcTargetPoint()
-  const
 {
+  constexpr int32_t search_range = 20;
   const auto closest_idx_result = planning_utils::findClosestIdxWithDistAngThr(
-    planning_utils::extractPoses(*trajectory_), current_pose_->pose, 3.0, M_PI_4);
+    trajectory_poses_, current_pose_->pose, 3.0, M_PI_4, prev_target_idx_, search_range);
+  prev_target_idx_ = closest_idx_result.second;
 
   if (!closest_idx_result.first) {
     RCLCPP_ERROR(get_logger(), "cannot find closest waypoint");
@@ -14,6 +14,7 @@
 
 #include "pure_pursuit/util/planning_utils.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <utility>
 #include <vector>
@@ -125,6 +126,50 @@ std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
   return (idx_min >= 0) ? std::make_pair(true, idx_min) : std::make_pair(false, idx_min);
 }
 
+std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
+  const std::vector<geometry_msgs::msg::Pose> & poses,
+  const geometry_msgs::msg::Pose & current_pose, double th_dist, double th_yaw, int32_t hint_idx,
+  int32_t search_range)
+{
+  const int32_t size = static_cast<int32_t>(poses.size());
+  if (hint_idx < 0 || hint_idx >= size) {
+    return findClosestIdxWithDistAngThr(poses, current_pose, th_dist, th_yaw);
+  }
+
+  const int32_t begin_idx = std::max(hint_idx - search_range, 0);
+  const int32_t end_idx = std::min(hint_idx + search_range, size - 1);
+  const double yaw_pose = tf2::getYaw(current_pose.orientation);
+
+  double dist_squared_min = std::numeric_limits<double>::max();
+  int32_t idx_min = -1;
+
+  for (int32_t i = begin_idx; i <= end_idx; ++i) {
+    const double ds = calcDistSquared2D(poses.at(i).position, current_pose.position);
+    if (ds > th_dist * th_dist) {
+      continue;
+    }
+
+    const double yaw_ps = tf2::getYaw(poses.at(i).orientation);
+    const double yaw_diff = normalizeEulerAngle(yaw_pose - yaw_ps);
+    if (fabs(yaw_diff) > th_yaw) {
+      continue;
+    }
+
+    if (ds < dist_squared_min) {
+      dist_squared_min = ds;
+      idx_min = i;
+    }
+  }
+
+  const bool is_on_edge =
+    (idx_min == begin_idx && begin_idx != 0) || (idx_min == end_idx && end_idx != size - 1);
+  if (idx_min < 0 || is_on_edge) {
+    return findClosestIdxWithDistAngThr(poses, current_pose, th_dist, th_yaw);
+  }
+
+  return std::make_pair(true, idx_min);
+}
+
 int8_t getLaneDirection(const std::vector<geometry_msgs::msg::Pose> & poses, double th_dist)
 {
   if (poses.size() < 2) {
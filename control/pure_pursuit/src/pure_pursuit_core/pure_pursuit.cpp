@@ -55,8 +55,10 @@ std::pair<bool, double> PurePursuit::run()
     return std::make_pair(false, std::numeric_limits<double>::quiet_NaN());
   }
 
-  auto clst_pair =
-    findClosestIdxWithDistAngThr(*curr_wps_ptr_, *curr_pose_ptr_, clst_thr_dist_, clst_thr_ang_);
+  auto clst_pair = findClosestIdxWithDistAngThr(
+    *curr_wps_ptr_, *curr_pose_ptr_, clst_thr_dist_, clst_thr_ang_, prev_clst_idx_,
+    clst_search_range_);
+  prev_clst_idx_ = clst_pair.second;
 
   if (!clst_pair.first) {
     RCLCPP_WARN(
@@ -153,6 +155,9 @@ int32_t PurePursuit::findNextPointIdx(int32_t search_start_idx)
     return -1;
   }
 
+  // if waypoint direction is forward
+  const auto gld = planning_utils::getLaneDirection(*curr_wps_ptr_, 0.05);
+
   // look for the next waypoint.
   for (int32_t i = search_start_idx; i < (int32_t)curr_wps_ptr_->size(); i++) {
     // if search waypoint is the last
@@ -160,8 +165,6 @@ int32_t PurePursuit::findNextPointIdx(int32_t search_start_idx)
       return i;
     }
 
-    // if waypoint direction is forward
-    const auto gld = planning_utils::getLaneDirection(*curr_wps_ptr_, 0.05);
     if (gld == 0) {
       // if waypoint is not in front of ego, skip
       auto ret = planning_utils::transformToRelativeCoordinate2D(
@@ -205,6 +208,7 @@ void PurePursuit::setWaypoints(const std::vector<geometry_msgs::msg::Pose> & msg
 {
   curr_wps_ptr_ = std::make_shared<std::vector<geometry_msgs::msg::Pose>>();
   *curr_wps_ptr_ = msg;
+  prev_clst_idx_ = -1;
 }
 
 }  // namespace planning_utils
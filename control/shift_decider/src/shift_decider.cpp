@@ -30,8 +30,12 @@ ShiftDecider::ShiftDecider(const rclcpp::NodeOptions & node_options)
   rclcpp::QoS durable_qos(queue_size);
   durable_qos.transient_local();
 
-  pub_shift_cmd_ =
-    create_publisher<autoware_vehicle_msgs::msg::ShiftStamped>("output/shift_cmd", durable_qos);
+  // the latched topic is not supported by the intra-process communication
+  rclcpp::PublisherOptions durable_pub_options;
+  durable_pub_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+
+  pub_shift_cmd_ = create_publisher<autoware_vehicle_msgs::msg::ShiftStamped>(
+    "output/shift_cmd", durable_qos, durable_pub_options);
   sub_control_cmd_ = create_subscription<autoware_control_msgs::msg::ControlCommandStamped>(
     "input/control_cmd", queue_size, std::bind(&ShiftDecider::onControlCmd, this, _1));
 
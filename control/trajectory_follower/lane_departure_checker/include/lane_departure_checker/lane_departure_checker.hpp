@@ -26,6 +26,7 @@
 #include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
 #include <geometry_msgs/msg/twist_stamped.hpp>
 
+#include <boost/geometry/index/rtree.hpp>
 #include <boost/optional.hpp>
 
 #include <lanelet2_core/LaneletMap.h>
@@ -33,10 +34,12 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace lane_departure_checker
 {
+using autoware_utils::Box2d;
 using autoware_utils::LinearRing2d;
 using autoware_utils::PoseDeviation;
 
@@ -92,6 +95,28 @@ private:
   Param param_;
   std::shared_ptr<vehicle_info_util::VehicleInfo> vehicle_info_ptr_;
 
+  struct RouteLanelet
+  {
+    lanelet::ConstLanelet lanelet;
+    lanelet::BasicPolygon2d polygon;
+    Box2d box;
+  };
+  using RouteLaneletRtree = boost::geometry::index::rtree<
+    std::pair<Box2d, size_t>, boost::geometry::index::rstar<16>>;
+
+  // polygons of the route lanelets and their R-tree, built once per route
+  autoware_planning_msgs::msg::Route::ConstSharedPtr indexed_route_;
+  std::vector<RouteLanelet> route_lanelets_;
+  RouteLaneletRtree route_lanelet_rtree_;
+
+  void updateRouteLaneletIndex(
+    const autoware_planning_msgs::msg::Route::ConstSharedPtr & route,
+    const lanelet::ConstLanelets & route_lanelets);
+
+  //! indices of the route lanelets overlapping the convex hull of the footprints
+  std::vector<size_t> getCandidateLanelets(
+    const std::vector<LinearRing2d> & vehicle_footprints) const;
+
   static PoseDeviation calcTrajectoryDeviation(
     const autoware_planning_msgs::msg::Trajectory & trajectory,
     const geometry_msgs::msg::Pose & pose);
@@ -110,12 +135,15 @@ private:
   static std::vector<LinearRing2d> createVehiclePassingAreas(
     const std::vector<LinearRing2d> & vehicle_footprints);
 
-  static bool willLeaveLane(
-    const lanelet::ConstLanelets & candidate_lanelets,
-    const std::vector<LinearRing2d> & vehicle_footprints);
+  bool willLeaveLane(
+    const std::vector<size_t> & candidate_lanelets,
+    const std::vector<LinearRing2d> & vehicle_footprints) const;
+
+  bool isOutOfLane(
+    const std::vector<size_t> & candidate_lanelets, const LinearRing2d & vehicle_footprint) const;
 
-  static bool isOutOfLane(
-    const lanelet::ConstLanelets & candidate_lanelets, const LinearRing2d & vehicle_footprint);
+  bool isInAnyLane(
+    const std::vector<size_t> & candidate_lanelets, const autoware_utils::Point2d & point) const;
 };
 }  // namespace lane_departure_checker
 
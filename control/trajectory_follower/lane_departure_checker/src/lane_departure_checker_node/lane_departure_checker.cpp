@@ -27,8 +27,12 @@
 #include <tf2/utils.h>
 
 #include <algorithm>
+#include <iterator>
+#include <limits>
+#include <utility>
 #include <vector>
 
+using autoware_utils::Box2d;
 using autoware_utils::LinearRing2d;
 using autoware_utils::MultiPoint2d;
 using autoware_utils::Point2d;
@@ -41,15 +45,23 @@ double calcBrakingDistance(
   return (abs_velocity * abs_velocity) / (2.0 * max_deceleration) + delay_time * abs_velocity;
 }
 
-bool isInAnyLane(const lanelet::ConstLanelets & candidate_lanelets, const Point2d & point)
+Box2d calcBoundingBox(const lanelet::BasicPolygon2d & polygon)
 {
-  for (const auto & ll : candidate_lanelets) {
-    if (boost::geometry::within(point, ll.polygon2d().basicPolygon())) {
-      return true;
-    }
+  constexpr double max = std::numeric_limits<double>::max();
+  Box2d box{{max, max}, {-max, -max}};
+  for (const auto & p : polygon) {
+    box.min_corner().x() = std::min(box.min_corner().x(), p.x());
+    box.min_corner().y() = std::min(box.min_corner().y(), p.y());
+    box.max_corner().x() = std::max(box.max_corner().x(), p.x());
+    box.max_corner().y() = std::max(box.max_corner().y(), p.y());
   }
+  return box;
+}
 
-  return false;
+bool isInBox(const Box2d & box, const Point2d & point)
+{
+  return box.min_corner().x() <= point.x() && point.x() <= box.max_corner().x() &&
+         box.min_corner().y() <= point.y() && point.y() <= box.max_corner().y();
 }
 
 size_t findNearestIndex(
@@ -85,24 +97,6 @@ LinearRing2d createHullFromFootprints(const std::vector<LinearRing2d> & footprin
 
   return hull;
 }
-
-lanelet::ConstLanelets getCandidateLanelets(
-  const lanelet::ConstLanelets & route_lanelets,
-  const std::vector<LinearRing2d> & vehicle_footprints)
-{
-  lanelet::ConstLanelets candidate_lanelets;
-
-  // Find lanes within the convex hull of footprints
-  const auto footprint_hull = createHullFromFootprints(vehicle_footprints);
-  for (const auto & route_lanelet : route_lanelets) {
-    const auto poly = route_lanelet.polygon2d().basicPolygon();
-    if (!boost::geometry::disjoint(poly, footprint_hull)) {
-      candidate_lanelets.push_back(route_lanelet);
-    }
-  }
-
-  return candidate_lanelets;
-}
 }  // namespace
 
 namespace lane_departure_checker
@@ -136,13 +130,18 @@ Output LaneDepartureChecker::update(const Input & input)
   output.vehicle_passing_areas = createVehiclePassingAreas(output.vehicle_footprints);
   output.processing_time_map["createVehiclePassingAreas"] = stop_watch.toc(true);
 
-  output.candidate_lanelets = getCandidateLanelets(input.route_lanelets, output.vehicle_footprints);
+  updateRouteLaneletIndex(input.route, input.route_lanelets);
+  const auto candidate_lanelet_indices = getCandidateLanelets(output.vehicle_footprints);
+  for (const auto idx : candidate_lanelet_indices) {
+    output.candidate_lanelets.push_back(route_lanelets_.at(idx).lanelet);
+  }
   output.processing_time_map["getCandidateLanelets"] = stop_watch.toc(true);
 
-  output.will_leave_lane = willLeaveLane(output.candidate_lanelets, output.vehicle_footprints);
+  output.will_leave_lane = willLeaveLane(candidate_lanelet_indices, output.vehicle_footprints);
   output.processing_time_map["willLeaveLane"] = stop_watch.toc(true);
 
-  output.is_out_of_lane = isOutOfLane(output.candidate_lanelets, output.vehicle_footprints.front());
+  output.is_out_of_lane =
+    isOutOfLane(candidate_lanelet_indices, output.vehicle_footprints.front());
   output.processing_time_map["isOutOfLane"] = stop_watch.toc(true);
 
   return output;
@@ -254,9 +253,59 @@ std::vector<LinearRing2d> LaneDepartureChecker::createVehiclePassingAreas(
   return areas;
 }
 
+void LaneDepartureChecker::updateRouteLaneletIndex(
+  const autoware_planning_msgs::msg::Route::ConstSharedPtr & route,
+  const lanelet::ConstLanelets & route_lanelets)
+{
+  // the route lanelets are only updated with the route
+  if (route == indexed_route_ && route_lanelets.size() == route_lanelets_.size()) {
+    return;
+  }
+
+  indexed_route_ = route;
+  route_lanelets_.clear();
+  route_lanelets_.reserve(route_lanelets.size());
+  std::vector<std::pair<Box2d, size_t>> boxes;
+  boxes.reserve(route_lanelets.size());
+  for (const auto & route_lanelet : route_lanelets) {
+    auto polygon = route_lanelet.polygon2d().basicPolygon();
+    const auto box = calcBoundingBox(polygon);
+    boxes.emplace_back(box, route_lanelets_.size());
+    route_lanelets_.push_back(RouteLanelet{route_lanelet, std::move(polygon), box});
+  }
+
+  // bulk loading packs the tree better than the insertion one by one
+  route_lanelet_rtree_ = RouteLaneletRtree(boxes.begin(), boxes.end());
+}
+
+std::vector<size_t> LaneDepartureChecker::getCandidateLanelets(
+  const std::vector<LinearRing2d> & vehicle_footprints) const
+{
+  // Find lanes within the convex hull of footprints
+  const auto footprint_hull = createHullFromFootprints(vehicle_footprints);
+  Box2d hull_box;
+  boost::geometry::envelope(footprint_hull, hull_box);
+
+  std::vector<std::pair<Box2d, size_t>> hits;
+  route_lanelet_rtree_.query(
+    boost::geometry::index::intersects(hull_box), std::back_inserter(hits));
+
+  std::vector<size_t> candidate_lanelets;
+  for (const auto & hit : hits) {
+    if (!boost::geometry::disjoint(route_lanelets_.at(hit.second).polygon, footprint_hull)) {
+      candidate_lanelets.push_back(hit.second);
+    }
+  }
+
+  // same order as the route
+  std::sort(candidate_lanelets.begin(), candidate_lanelets.end());
+
+  return candidate_lanelets;
+}
+
 bool LaneDepartureChecker::willLeaveLane(
-  const lanelet::ConstLanelets & candidate_lanelets,
-  const std::vector<LinearRing2d> & vehicle_footprints)
+  const std::vector<size_t> & candidate_lanelets,
+  const std::vector<LinearRing2d> & vehicle_footprints) const
 {
   for (const auto & vehicle_footprint : vehicle_footprints) {
     if (isOutOfLane(candidate_lanelets, vehicle_footprint)) {
@@ -268,7 +317,7 @@ bool LaneDepartureChecker::willLeaveLane(
 }
 
 bool LaneDepartureChecker::isOutOfLane(
-  const lanelet::ConstLanelets & candidate_lanelets, const LinearRing2d & vehicle_footprint)
+  const std::vector<size_t> & candidate_lanelets, const LinearRing2d & vehicle_footprint) const
 {
   for (const auto & point : vehicle_footprint) {
     if (!isInAnyLane(candidate_lanelets, point)) {
@@ -278,4 +327,19 @@ bool LaneDepartureChecker::isOutOfLane(
 
   return false;
 }
+
+bool LaneDepartureChecker::isInAnyLane(
+  const std::vector<size_t> & candidate_lanelets, const Point2d & point) const
+{
+  for (const auto idx : candidate_lanelets) {
+    const auto & route_lanelet = route_lanelets_.at(idx);
+    if (
+      isInBox(route_lanelet.box, point) &&
+      boost::geometry::within(point, route_lanelet.polygon)) {
+      return true;
+    }
+  }
+
+  return false;
+}
 }  // namespace lane_departure_checker
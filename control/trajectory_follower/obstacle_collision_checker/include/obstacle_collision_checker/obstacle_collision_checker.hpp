@@ -15,6 +15,8 @@
 #ifndef OBSTACLE_COLLISION_CHECKER__OBSTACLE_COLLISION_CHECKER_HPP_
 #define OBSTACLE_COLLISION_CHECKER__OBSTACLE_COLLISION_CHECKER_HPP_
 
+#include "obstacle_collision_checker/util/point_grid.hpp"
+
 #include <autoware_utils/geometry/boost_geometry.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
@@ -78,6 +80,16 @@ private:
   Param param_;
   vehicle_info_util::VehicleInfo vehicle_info_;
 
+  // Obstacle pointcloud in map frame, rebuilt only when a new message or transform comes
+  sensor_msgs::msg::PointCloud2::ConstSharedPtr indexed_pointcloud_msg_;
+  geometry_msgs::msg::Transform indexed_transform_;
+  pcl::PointCloud<pcl::PointXYZ> obstacle_pointcloud_;
+  PointGrid obstacle_grid_;
+
+  void updateObstacleGrid(
+    const sensor_msgs::msg::PointCloud2::ConstSharedPtr & pointcloud_msg,
+    const geometry_msgs::msg::Transform & transform);
+
   //! This function assumes the input trajectory is sampled dense enough
   static autoware_planning_msgs::msg::Trajectory resampleTrajectory(
     const autoware_planning_msgs::msg::Trajectory & trajectory, const double interval);
@@ -96,12 +108,14 @@ private:
     const LinearRing2d & area1, const LinearRing2d & area2);
 
   static bool willCollide(
-    const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
+    const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud, const PointGrid & obstacle_grid,
+    const autoware_planning_msgs::msg::Trajectory & trajectory, const double search_radius,
     const std::vector<LinearRing2d> & vehicle_footprints);
 
   static bool hasCollision(
-    const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
-    const LinearRing2d & vehicle_footprint);
+    const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud, const PointGrid & obstacle_grid,
+    const autoware_planning_msgs::msg::Trajectory & trajectory, const double search_radius,
+    const LinearRing2d & vehicle_footprint, std::vector<size_t> & candidate_indices);
 };
 }  // namespace obstacle_collision_checker
 
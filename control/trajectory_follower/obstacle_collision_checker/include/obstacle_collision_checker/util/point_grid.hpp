@@ -0,0 +1,85 @@
+// Copyright 2020 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OBSTACLE_COLLISION_CHECKER__UTIL__POINT_GRID_HPP_
+#define OBSTACLE_COLLISION_CHECKER__UTIL__POINT_GRID_HPP_
+
+#include <autoware_utils/geometry/boost_geometry.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace obstacle_collision_checker
+{
+/**
+ * @brief xy grid of the indices of a pointcloud, built once per pointcloud message
+ */
+class PointGrid
+{
+public:
+  PointGrid() = default;
+
+  PointGrid(const pcl::PointCloud<pcl::PointXYZ> & points, const double cell_size)
+  : cell_size_(cell_size)
+  {
+    for (size_t i = 0; i < points.size(); ++i) {
+      const auto & p = points.at(i);
+      if (!std::isfinite(p.x) || !std::isfinite(p.y)) {
+        continue;
+      }
+      cells_[getKey(getCell(p.x), getCell(p.y))].push_back(i);
+    }
+  }
+
+  /**
+   * @brief indices of the points in the cells overlapping the box
+   */
+  void query(const autoware_utils::Box2d & box, std::vector<size_t> & indices) const
+  {
+    indices.clear();
+    if (cells_.empty()) {
+      return;
+    }
+    const int64_t min_cell_x = getCell(box.min_corner().x());
+    const int64_t min_cell_y = getCell(box.min_corner().y());
+    const int64_t max_cell_x = getCell(box.max_corner().x());
+    const int64_t max_cell_y = getCell(box.max_corner().y());
+    for (int64_t cell_x = min_cell_x; cell_x <= max_cell_x; ++cell_x) {
+      for (int64_t cell_y = min_cell_y; cell_y <= max_cell_y; ++cell_y) {
+        const auto itr = cells_.find(getKey(cell_x, cell_y));
+        if (itr != cells_.end()) {
+          indices.insert(indices.end(), itr->second.begin(), itr->second.end());
+        }
+      }
+    }
+  }
+
+private:
+  int64_t getCell(const double x) const { return static_cast<int64_t>(std::floor(x / cell_size_)); }
+  static uint64_t getKey(const int64_t cell_x, const int64_t cell_y)
+  {
+    return (static_cast<uint64_t>(cell_x) << 32) ^ (static_cast<uint64_t>(cell_y) & 0xffffffff);
+  }
+
+  double cell_size_ = 1.0;
+  std::unordered_map<uint64_t, std::vector<size_t>> cells_;
+};
+}  // namespace obstacle_collision_checker
+
+#endif  // OBSTACLE_COLLISION_CHECKER__UTIL__POINT_GRID_HPP_
@@ -49,21 +49,18 @@ pcl::PointCloud<pcl::PointXYZ> getTransformedPointCloud(
   return transformed_pointcloud;
 }
 
-pcl::PointCloud<pcl::PointXYZ> filterPointCloudByTrajectory(
-  const pcl::PointCloud<pcl::PointXYZ> & pointcloud,
-  const autoware_planning_msgs::msg::Trajectory & trajectory, const double radius)
+bool isNearTrajectory(
+  const pcl::PointXYZ & point, const autoware_planning_msgs::msg::Trajectory & trajectory,
+  const double radius)
 {
-  pcl::PointCloud<pcl::PointXYZ> filtered_pointcloud;
   for (const auto & trajectory_point : trajectory.points) {
-    for (const auto & point : pointcloud.points) {
-      const double dx = trajectory_point.pose.position.x - point.x;
-      const double dy = trajectory_point.pose.position.y - point.y;
-      if (std::hypot(dx, dy) < radius) {
-        filtered_pointcloud.points.push_back(point);
-      }
+    const double dx = trajectory_point.pose.position.x - point.x;
+    const double dy = trajectory_point.pose.position.y - point.y;
+    if (std::hypot(dx, dy) < radius) {
+      return true;
     }
   }
-  return filtered_pointcloud;
+  return false;
 }
 
 double calcBrakingDistance(
@@ -98,11 +95,9 @@ Output ObstacleCollisionChecker::update(const Input & input)
     resampleTrajectory(*input.predicted_trajectory, param_.resample_interval), braking_distance);
   output.processing_time_map["resampleTrajectory"] = stop_watch.toc(true);
 
-  // resample pointcloud
-  const auto obstacle_pointcloud =
-    getTransformedPointCloud(*input.obstacle_pointcloud, input.obstacle_transform->transform);
-  const auto filtered_obstacle_pointcloud = filterPointCloudByTrajectory(
-    obstacle_pointcloud, output.resampled_trajectory, param_.search_radius);
+  // index pointcloud
+  updateObstacleGrid(input.obstacle_pointcloud, input.obstacle_transform->transform);
+  output.processing_time_map["updateObstacleGrid"] = stop_watch.toc(true);
 
   output.vehicle_footprints =
     createVehicleFootprints(output.resampled_trajectory, param_, vehicle_info_);
@@ -111,12 +106,29 @@ Output ObstacleCollisionChecker::update(const Input & input)
   output.vehicle_passing_areas = createVehiclePassingAreas(output.vehicle_footprints);
   output.processing_time_map["createVehiclePassingAreas"] = stop_watch.toc(true);
 
-  output.will_collide = willCollide(filtered_obstacle_pointcloud, output.vehicle_passing_areas);
+  output.will_collide = willCollide(
+    obstacle_pointcloud_, obstacle_grid_, output.resampled_trajectory, param_.search_radius,
+    output.vehicle_passing_areas);
   output.processing_time_map["willCollide"] = stop_watch.toc(true);
 
   return output;
 }
 
+void ObstacleCollisionChecker::updateObstacleGrid(
+  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & pointcloud_msg,
+  const geometry_msgs::msg::Transform & transform)
+{
+  if (pointcloud_msg == indexed_pointcloud_msg_ && transform == indexed_transform_) {
+    return;
+  }
+
+  constexpr double grid_cell_size = 1.0;
+  obstacle_pointcloud_ = getTransformedPointCloud(*pointcloud_msg, transform);
+  obstacle_grid_ = PointGrid(obstacle_pointcloud_, grid_cell_size);
+  indexed_pointcloud_msg_ = pointcloud_msg;
+  indexed_transform_ = transform;
+}
+
 autoware_planning_msgs::msg::Trajectory ObstacleCollisionChecker::resampleTrajectory(
   const autoware_planning_msgs::msg::Trajectory & trajectory, const double interval)
 {
@@ -229,11 +241,15 @@ LinearRing2d ObstacleCollisionChecker::createHullFromFootprints(
 }
 
 bool ObstacleCollisionChecker::willCollide(
-  const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
+  const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud, const PointGrid & obstacle_grid,
+  const autoware_planning_msgs::msg::Trajectory & trajectory, const double search_radius,
   const std::vector<LinearRing2d> & vehicle_footprints)
 {
+  std::vector<size_t> candidate_indices;
   for (const auto & vehicle_footprint : vehicle_footprints) {
-    if (hasCollision(obstacle_pointcloud, vehicle_footprint)) {
+    if (hasCollision(
+          obstacle_pointcloud, obstacle_grid, trajectory, search_radius, vehicle_footprint,
+          candidate_indices)) {
       RCLCPP_WARN(
         rclcpp::get_logger("obstacle_collision_checker"), "ObstacleCollisionChecker::willCollide");
       return true;
@@ -244,16 +260,28 @@ bool ObstacleCollisionChecker::willCollide(
 }
 
 bool ObstacleCollisionChecker::hasCollision(
-  const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
-  const LinearRing2d & vehicle_footprint)
+  const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud, const PointGrid & obstacle_grid,
+  const autoware_planning_msgs::msg::Trajectory & trajectory, const double search_radius,
+  const LinearRing2d & vehicle_footprint, std::vector<size_t> & candidate_indices)
 {
-  for (const auto & point : obstacle_pointcloud) {
-    if (boost::geometry::within(autoware_utils::Point2d{point.x, point.y}, vehicle_footprint)) {
-      RCLCPP_WARN(
-        rclcpp::get_logger("obstacle_collision_checker"),
-        "[ObstacleCollisionChecker] Collide to Point x: %f y: %f", point.x, point.y);
-      return true;
+  // only the points in the cells overlapping the footprint can be within it
+  autoware_utils::Box2d footprint_box;
+  boost::geometry::envelope(vehicle_footprint, footprint_box);
+  obstacle_grid.query(footprint_box, candidate_indices);
+
+  for (const size_t index : candidate_indices) {
+    const auto & point = obstacle_pointcloud.at(index);
+    if (!boost::geometry::within(autoware_utils::Point2d{point.x, point.y}, vehicle_footprint)) {
+      continue;
+    }
+    // the points far from the trajectory are ignored, as the search radius filter used to
+    if (!isNearTrajectory(point, trajectory, search_radius)) {
+      continue;
     }
+    RCLCPP_WARN(
+      rclcpp::get_logger("obstacle_collision_checker"),
+      "[ObstacleCollisionChecker] Collide to Point x: %f y: %f", point.x, point.y);
+    return true;
   }
 
   return false;
@@ -17,6 +17,7 @@
 
 #include "vehicle_cmd_gate/vehicle_cmd_filter.hpp"
 
+#include <autoware_utils/system/realtime.hpp>
 #include <diagnostic_updater/diagnostic_updater.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <std_srvs/srv/trigger.hpp>
@@ -37,6 +38,7 @@
 #include <autoware_vehicle_msgs/msg/vehicle_command.hpp>
 #include <geometry_msgs/msg/twist_stamped.hpp>
 
+#include <limits>
 #include <memory>
 
 struct Commands
@@ -168,6 +170,10 @@ private:
 
   void checkExternalEmergencyStop(diagnostic_updater::DiagnosticStatusWrapper & stat);
 
+  // Real-time mode
+  autoware_utils::DeadlineMonitor control_cmd_deadline_monitor_{
+    std::numeric_limits<double>::max()};
+
   // Algorithm
   autoware_control_msgs::msg::ControlCommand prev_control_cmd_;
   autoware_control_msgs::msg::ControlCommand createStopControlCmd() const;
@@ -0,0 +1,229 @@
+# Copyright 2021 Tier IV, Inc. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+
+from ament_index_python.packages import get_package_share_directory
+import launch
+from launch.actions import DeclareLaunchArgument
+from launch.actions import OpaqueFunction
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+import yaml
+
+
+def load_parameters(path):
+    if not path:
+        return {}
+    with open(path, "r") as f:
+        return yaml.safe_load(f)["/**"]["ros__parameters"]
+
+
+def launch_setup(context, *args, **kwargs):
+    def config(name):
+        return LaunchConfiguration(name).perform(context)
+
+    # the nodes exchange the commands by the intra-process communication
+    extra_arguments = [{"use_intra_process_comms": True}]
+    vehicle_info_param = load_parameters(config("vehicle_info_param_file"))
+
+    mpc_follower = ComposableNode(
+        package="mpc_follower",
+        plugin="MPCFollower",
+        name="mpc_follower",
+        namespace="/control/trajectory_follower",
+        remappings=[
+            ("~/input/reference_trajectory", "/planning/scenario_planning/trajectory"),
+            ("~/input/current_velocity", "/localization/twist"),
+            ("~/input/current_steering", "/vehicle/status/steering"),
+            ("~/output/control_raw", "lateral/control_cmd"),
+            ("~/output/predicted_trajectory", "predicted_trajectory"),
+        ],
+        parameters=[load_parameters(config("mpc_follower_param_path")), vehicle_info_param],
+        extra_arguments=extra_arguments,
+    )
+    velocity_controller = ComposableNode(
+        package="velocity_controller",
+        plugin="VelocityController",
+        name="velocity_controller",
+        namespace="/control/trajectory_follower",
+        remappings=[
+            ("~/current_velocity", "/localization/twist"),
+            ("~/control_cmd", "longitudinal/control_cmd"),
+            ("~/current_trajectory", "/planning/scenario_planning/trajectory"),
+        ],
+        parameters=[
+            load_parameters(config("velocity_controller_param_path")),
+            vehicle_info_param,
+        ],
+        extra_arguments=extra_arguments,
+    )
+    latlon_muxer = ComposableNode(
+        package="latlon_muxer",
+        plugin="LatLonMuxer",
+        name="latlon_muxer",
+        namespace="/control/trajectory_follower",
+        remappings=[
+            ("input/lateral/control_cmd", "lateral/control_cmd"),
+            ("input/longitudinal/control_cmd", "longitudinal/control_cmd"),
+            ("output/control_cmd", "control_cmd"),
+        ],
+        parameters=[
+            {
+                "timeout_thr_sec": 0.5,
+                "wait_for_both_commands": True,
+            }
+        ],
+        extra_arguments=extra_arguments,
+    )
+    shift_decider = ComposableNode(
+        package="shift_decider",
+        plugin="ShiftDecider",
+        name="shift_decider",
+        namespace="/control",
+        remappings=[
+            ("input/control_cmd", "/control/trajectory_follower/control_cmd"),
+            ("output/shift_cmd", "/control/shift_decider/shift_cmd"),
+        ],
+        extra_arguments=extra_arguments,
+    )
+    vehicle_cmd_gate = ComposableNode(
+        package="vehicle_cmd_gate",
+        plugin="VehicleCmdGate",
+        name="vehicle_cmd_gate",
+        namespace="/control",
+        remappings=[
+            ("input/emergency_state", "/system/emergency/emergency_state"),
+            ("input/steering", "/vehicle/status/steering"),
+            ("input/auto/control_cmd", "/control/trajectory_follower/control_cmd"),
+            ("input/auto/turn_signal_cmd", "/planning/turn_signal_decider/turn_signal_cmd"),
+            ("input/auto/shift_cmd", "/control/shift_decider/shift_cmd"),
+            ("input/external/control_cmd", "/external/selected/control_cmd"),
+            ("input/external/turn_signal_cmd", "/external/selected/turn_signal_cmd"),
+            ("input/external/shift_cmd", "/external/selected/shift_cmd"),
+            ("input/external_emergency_stop_heartbeat", "/external/selected/heartbeat"),
+            ("input/gate_mode", "/control/gate_mode_cmd"),
+            ("input/emergency/control_cmd", "/system/emergency/control_cmd"),
+            ("input/emergency/turn_signal_cmd", "/system/emergency/turn_signal_cmd"),
+            ("input/emergency/shift_cmd", "/system/emergency/shift_cmd"),
+            ("output/vehicle_cmd", "/control/vehicle_cmd"),
+            ("output/control_cmd", "/control/control_cmd"),
+            ("output/shift_cmd", "/control/shift_cmd"),
+            ("output/turn_signal_cmd", "/control/turn_signal_cmd"),
+            ("output/gate_mode", "/control/current_gate_mode"),
+            ("output/engage", "/api/autoware/get/engage"),
+            ("output/external_emergency", "/api/autoware/get/emergency"),
+            ("~/service/engage", "/api/autoware/set/engage"),
+            ("~/service/external_emergency", "/api/autoware/set/emergency"),
+            # TODO(Takagi, Isamu): deprecated
+            ("input/engage", "/autoware/engage"),
+            ("~/service/external_emergency_stop", "~/external_emergency_stop"),
+            ("~/service/clear_external_emergency_stop", "~/clear_external_emergency_stop"),
+        ],
+        parameters=[
+            load_parameters(config("vehicle_cmd_gate_param_path")),
+            vehicle_info_param,
+            {
+                "use_emergency_handling": config("use_emergency_handling") == "true",
+                "use_external_emergency_stop": config("use_external_emergency_stop") == "true",
+                "use_start_request": config("use_start_request") == "true",
+            },
+        ],
+        extra_arguments=extra_arguments,
+    )
+    raw_vehicle_cmd_converter = ComposableNode(
+        package="raw_vehicle_cmd_converter",
+        plugin="raw_vehicle_cmd_converter::RawVehicleCommandConverterNode",
+        name="raw_vehicle_cmd_converter",
+        namespace="/vehicle",
+        parameters=[
+            load_parameters(config("converter_param_path")),
+            {
+                "csv_path_accel_map": config("csv_path_accel_map"),
+                "csv_path_brake_map": config("csv_path_brake_map"),
+                "csv_path_steer_map": config("csv_path_steer_map"),
+            },
+        ],
+        extra_arguments=extra_arguments,
+    )
+
+    # a single threaded executor runs the callbacks of the chain one after another, the thread is
+    # pinned to the given cpus and scheduled with SCHED_FIFO (chrt needs CAP_SYS_NICE)
+    prefix = []
+    if config("cpu_affinity"):
+        prefix.append("taskset -c " + config("cpu_affinity"))
+    if int(config("rt_priority")) > 0:
+        prefix.append("chrt -f " + config("rt_priority"))
+
+    container = ComposableNodeContainer(
+        name="control_container",
+        namespace="/control",
+        package="rclcpp_components",
+        executable="component_container",
+        composable_node_descriptions=[
+            mpc_follower,
+            velocity_controller,
+            latlon_muxer,
+            shift_decider,
+            vehicle_cmd_gate,
+            raw_vehicle_cmd_converter,
+        ],
+        prefix=" ".join(prefix) if prefix else None,
+        output="screen",
+    )
+    return [container]
+
+
+def generate_launch_description():
+    launch_arguments = []
+
+    def add_launch_arg(name: str, default_value=None, description=""):
+        launch_arguments.append(
+            DeclareLaunchArgument(name, default_value=default_value, description=description)
+        )
+
+    def share_path(package, *path):
+        return os.path.join(get_package_share_directory(package), *path)
+
+    add_launch_arg(
+        "vehicle_info_param_file", "", "vehicle info parameters, not set when they are global"
+    )
+    add_launch_arg(
+        "mpc_follower_param_path", share_path("mpc_follower", "config", "mpc_follower.param.yaml")
+    )
+    add_launch_arg(
+        "velocity_controller_param_path",
+        share_path("velocity_controller", "config", "velocity_controller.param.yaml"),
+    )
+    add_launch_arg(
+        "vehicle_cmd_gate_param_path",
+        share_path("vehicle_cmd_gate", "config", "vehicle_cmd_gate.param.yaml"),
+    )
+    add_launch_arg("use_emergency_handling", "false")
+    add_launch_arg("use_external_emergency_stop", "true")
+    add_launch_arg("use_start_request", "false")
+    add_launch_arg(
+        "converter_param_path",
+        share_path("raw_vehicle_cmd_converter", "config", "converter.param.yaml"),
+    )
+    for map_name in ["accel_map", "brake_map", "steer_map"]:
+        add_launch_arg(
+            "csv_path_" + map_name,
+            share_path("raw_vehicle_cmd_converter", "data", "default", map_name + ".csv"),
+        )
+    add_launch_arg("cpu_affinity", "", "cpu list of the container, e.g. 2 or 2,3")
+    add_launch_arg("rt_priority", "0", "SCHED_FIFO priority of the container, 0 to disable")
+
+    return launch.LaunchDescription(launch_arguments + [OpaqueFunction(function=launch_setup)])
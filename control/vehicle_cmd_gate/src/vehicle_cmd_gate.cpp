@@ -57,21 +57,29 @@ VehicleCmdGate::VehicleCmdGate(const rclcpp::NodeOptions & node_options)
   rclcpp::QoS durable_qos{1};
   durable_qos.transient_local();
 
+  // the intra-process communication only supports the volatile durability. the control command,
+  // which is on the path to the actuation, is volatile in that case, and the other latched topics
+  // go through the middleware
+  const bool use_intra_process = get_node_options().use_intra_process_comms();
+  const auto control_cmd_qos = use_intra_process ? rclcpp::QoS{1} : durable_qos;
+  rclcpp::PublisherOptions durable_pub_options;
+  durable_pub_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+
   // Publisher
   vehicle_cmd_pub_ = this->create_publisher<autoware_vehicle_msgs::msg::VehicleCommand>(
-    "output/vehicle_cmd", durable_qos);
+    "output/vehicle_cmd", durable_qos, durable_pub_options);
   control_cmd_pub_ = this->create_publisher<autoware_control_msgs::msg::ControlCommandStamped>(
-    "output/control_cmd", durable_qos);
+    "output/control_cmd", control_cmd_qos);
   shift_cmd_pub_ = this->create_publisher<autoware_vehicle_msgs::msg::ShiftStamped>(
-    "output/shift_cmd", durable_qos);
+    "output/shift_cmd", durable_qos, durable_pub_options);
   turn_signal_cmd_pub_ = this->create_publisher<autoware_vehicle_msgs::msg::TurnSignal>(
-    "output/turn_signal_cmd", durable_qos);
-  gate_mode_pub_ =
-    this->create_publisher<autoware_control_msgs::msg::GateMode>("output/gate_mode", durable_qos);
-  engage_pub_ =
-    this->create_publisher<autoware_vehicle_msgs::msg::Engage>("output/engage", durable_qos);
+    "output/turn_signal_cmd", durable_qos, durable_pub_options);
+  gate_mode_pub_ = this->create_publisher<autoware_control_msgs::msg::GateMode>(
+    "output/gate_mode", durable_qos, durable_pub_options);
+  engage_pub_ = this->create_publisher<autoware_vehicle_msgs::msg::Engage>(
+    "output/engage", durable_qos, durable_pub_options);
   pub_external_emergency_ = this->create_publisher<autoware_external_api_msgs::msg::Emergency>(
-    "output/external_emergency", durable_qos);
+    "output/external_emergency", durable_qos, durable_pub_options);
 
   // Subscriber
   emergency_state_sub_ =
@@ -167,6 +175,23 @@ VehicleCmdGate::VehicleCmdGate(const rclcpp::NodeOptions & node_options)
   });
   updater_.add("emergency_stop_operation", this, &VehicleCmdGate::checkExternalEmergencyStop);
 
+  // Real-time mode
+  if (declare_parameter("use_realtime_mode", false)) {
+    const int realtime_priority = declare_parameter("realtime_priority", 80);
+    const int prefault_heap_size_mb = declare_parameter("prefault_heap_size_mb", 64);
+    if (!autoware_utils::lockMemory(static_cast<size_t>(prefault_heap_size_mb) << 20)) {
+      RCLCPP_WARN(get_logger(), "failed to lock the memory, CAP_IPC_LOCK is required.");
+    }
+    if (!autoware_utils::setRealtimePriority(realtime_priority)) {
+      RCLCPP_WARN(get_logger(), "failed to set SCHED_FIFO, CAP_SYS_NICE is required.");
+    }
+    control_cmd_deadline_monitor_.setDeadline(
+      declare_parameter("control_cmd_callback_deadline", 0.005));
+    updater_.add("control_cmd_callback_deadline", [this](auto & stat) {
+      control_cmd_deadline_monitor_.diagnose(stat);
+    });
+  }
+
   // Start Request
   const auto use_start_request = declare_parameter("use_start_request", false);
   start_request_ = std::make_unique<StartRequest>(this, use_start_request);
@@ -204,7 +229,9 @@ void VehicleCmdGate::onAutoCtrlCmd(
   auto_commands_.control = *msg;
 
   if (current_gate_mode_.data == autoware_control_msgs::msg::GateMode::AUTO) {
+    control_cmd_deadline_monitor_.start();
     publishControlCommands(auto_commands_);
+    control_cmd_deadline_monitor_.stop();
   }
 }
 void VehicleCmdGate::onAutoTurnSignalCmd(autoware_vehicle_msgs::msg::TurnSignal::ConstSharedPtr msg)
@@ -223,7 +250,9 @@ void VehicleCmdGate::onRemoteCtrlCmd(
   remote_commands_.control = *msg;
 
   if (current_gate_mode_.data == autoware_control_msgs::msg::GateMode::EXTERNAL) {
+    control_cmd_deadline_monitor_.start();
     publishControlCommands(remote_commands_);
+    control_cmd_deadline_monitor_.stop();
   }
 }
 void VehicleCmdGate::onRemoteTurnSignalCmd(
@@ -243,7 +272,9 @@ void VehicleCmdGate::onEmergencyCtrlCmd(
   emergency_commands_.control = *msg;
 
   if (use_emergency_handling_ && is_system_emergency_) {
+    control_cmd_deadline_monitor_.start();
     publishControlCommands(emergency_commands_);
+    control_cmd_deadline_monitor_.stop();
   }
 }
 void VehicleCmdGate::onEmergencyTurnSignalCmd(
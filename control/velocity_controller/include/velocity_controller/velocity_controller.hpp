@@ -21,6 +21,7 @@
 #include "velocity_controller/velocity_controller_utils.hpp"
 
 #include <autoware_utils/autoware_utils.hpp>
+#include <diagnostic_updater/diagnostic_updater.hpp>
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Geometry>
 #include <rclcpp/rclcpp.hpp>
@@ -76,16 +77,23 @@ private:
   rclcpp::Publisher<autoware_debug_msgs::msg::Float32MultiArrayStamped>::SharedPtr pub_debug_;
   rclcpp::TimerBase::SharedPtr timer_control_;
 
+  // real-time mode
+  autoware_utils::DeadlineMonitor timer_deadline_monitor_;
+  std::unique_ptr<diagnostic_updater::Updater> updater_;
+
   autoware_utils::SelfPoseListener self_pose_listener_{this};
 
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
   rcl_interfaces::msg::SetParametersResult paramCallback(
     const std::vector<rclcpp::Parameter> & parameters);
 
-  // pointers for ros topic
-  std::shared_ptr<geometry_msgs::msg::TwistStamped> current_vel_ptr_{nullptr};
-  std::shared_ptr<geometry_msgs::msg::TwistStamped> prev_vel_ptr_{nullptr};
-  std::shared_ptr<autoware_planning_msgs::msg::Trajectory> trajectory_ptr_{nullptr};
+  // pointers for ros topic, the received messages are kept without a copy
+  geometry_msgs::msg::TwistStamped::ConstSharedPtr current_vel_ptr_{nullptr};
+  geometry_msgs::msg::TwistStamped::ConstSharedPtr prev_vel_ptr_{nullptr};
+  autoware_planning_msgs::msg::Trajectory::ConstSharedPtr trajectory_ptr_{nullptr};
+
+  // arc length of trajectory_ptr_, built once per trajectory for the queries of every cycle
+  autoware_utils::ArcLengthTable trajectory_arc_length_table_;
 
   // vehicle info
   double wheel_base_;
@@ -289,7 +297,9 @@ private:
 
   /**
    * @brief interpolate trajectory point that is nearest to vehicle
+   * @param [in] traj reference trajectory, from which trajectory_arc_length_table_ is built
    * @param [in] point vehicle position
+   * @param [in] nearest_idx nearest index on trajectory to vehicle, where the search starts
    */
   autoware_planning_msgs::msg::TrajectoryPoint calcInterpolatedTargetValue(
     const autoware_planning_msgs::msg::Trajectory & traj, const geometry_msgs::msg::Point & point,
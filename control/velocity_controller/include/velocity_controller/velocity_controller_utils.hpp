@@ -47,6 +47,15 @@ bool isValidTrajectory(const Trajectory & traj);
  */
 double calcStopDistance(const Point & current_pos, const Trajectory & traj);
 
+/**
+ * @brief calculate distance to stopline with the arc length table of the trajectory
+ * @param [in] arc_length_table table updated with traj
+ * @param [in] hint_idx index near current_pos where the nearest segment is searched from
+ */
+double calcStopDistance(
+  const Point & current_pos, const Trajectory & traj,
+  const autoware_utils::ArcLengthTable & arc_length_table, const size_t hint_idx);
+
 /**
  * @brief calculate pitch angle from estimated current pose
  */
@@ -106,25 +115,19 @@ T lerpXYZ(const T & p_from, const T & p_to, const double ratio)
 Quaternion lerpOrientation(const Quaternion & o_from, const Quaternion & o_to, const double ratio);
 
 /**
- * @brief apply linear interpolation to trajectory point that is nearest to a certain point
+ * @brief apply linear interpolation to trajectory point on a segment
  * @param [in] points trajectory points
- * @param [in] point Interpolated point is nearest to this point.
+ * @param [in] seg_idx index of the segment from seg_idx to seg_idx + 1
+ * @param [in] interpolate_ratio ratio on the segment
  */
 template <class T>
-TrajectoryPoint lerpTrajectoryPoint(const T & points, const Point & point)
+TrajectoryPoint lerpTrajectoryPoint(
+  const T & points, const size_t seg_idx, const double interpolate_ratio)
 {
   TrajectoryPoint interpolated_point;
 
-  const size_t nearest_seg_idx = autoware_utils::findNearestSegmentIndex(points, point);
-
-  const double len_to_interpolated =
-    autoware_utils::calcLongitudinalOffsetToSegment(points, nearest_seg_idx, point);
-  const double len_segment =
-    autoware_utils::calcSignedArcLength(points, nearest_seg_idx, nearest_seg_idx + 1);
-  const double interpolate_ratio = std::clamp(len_to_interpolated / len_segment, 0.0, 1.0);
-
   {
-    const size_t i = nearest_seg_idx;
+    const size_t i = seg_idx;
 
     interpolated_point.pose.position =
       lerpXYZ(points.at(i).pose.position, points.at(i + 1).pose.position, interpolate_ratio);
@@ -143,6 +146,49 @@ TrajectoryPoint lerpTrajectoryPoint(const T & points, const Point & point)
   return interpolated_point;
 }
 
+/**
+ * @brief apply linear interpolation to trajectory point that is nearest to a certain point
+ * @param [in] points trajectory points
+ * @param [in] point Interpolated point is nearest to this point.
+ */
+template <class T>
+TrajectoryPoint lerpTrajectoryPoint(const T & points, const Point & point)
+{
+  const size_t nearest_seg_idx = autoware_utils::findNearestSegmentIndex(points, point);
+
+  const double len_to_interpolated =
+    autoware_utils::calcLongitudinalOffsetToSegment(points, nearest_seg_idx, point);
+  const double len_segment =
+    autoware_utils::calcSignedArcLength(points, nearest_seg_idx, nearest_seg_idx + 1);
+  const double interpolate_ratio = std::clamp(len_to_interpolated / len_segment, 0.0, 1.0);
+
+  return lerpTrajectoryPoint(points, nearest_seg_idx, interpolate_ratio);
+}
+
+/**
+ * @brief apply linear interpolation to trajectory point that is nearest to a certain point, with
+ * the arc length table of the points
+ * @param [in] points trajectory points
+ * @param [in] arc_length_table table updated with points
+ * @param [in] point Interpolated point is nearest to this point.
+ * @param [in] hint_idx index near point where the nearest segment is searched from
+ */
+template <class T>
+TrajectoryPoint lerpTrajectoryPoint(
+  const T & points, const autoware_utils::ArcLengthTable & arc_length_table, const Point & point,
+  const size_t hint_idx)
+{
+  const autoware_utils::Point2d point_2d(point.x, point.y);
+  const size_t nearest_seg_idx = arc_length_table.findNearestSegmentIndex(point_2d, hint_idx);
+
+  const double len_to_interpolated =
+    arc_length_table.calcLongitudinalOffsetToSegment(nearest_seg_idx, point_2d);
+  const double len_segment = arc_length_table.getSegmentLength(nearest_seg_idx);
+  const double interpolate_ratio = std::clamp(len_to_interpolated / len_segment, 0.0, 1.0);
+
+  return lerpTrajectoryPoint(points, nearest_seg_idx, interpolate_ratio);
+}
+
 /**
  * @brief limit variable whose differential is within a certain value
  * @param [in] input_val current value
@@ -158,7 +158,12 @@ VelocityController::VelocityController(const rclcpp::NodeOptions & node_options)
 
   // Timer
   {
-    auto timer_callback = std::bind(&VelocityController::callbackTimerControl, this);
+    timer_deadline_monitor_.setDeadline(1.0 / control_rate_);
+    auto timer_callback = [this]() {
+      timer_deadline_monitor_.start();
+      callbackTimerControl();
+      timer_deadline_monitor_.stop();
+    };
     auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
       std::chrono::duration<double>(1.0 / control_rate_));
     timer_control_ = std::make_shared<rclcpp::GenericTimer<decltype(timer_callback)>>(
@@ -167,6 +172,22 @@ VelocityController::VelocityController(const rclcpp::NodeOptions & node_options)
     this->get_node_timers_interface()->add_timer(timer_control_, nullptr);
   }
 
+  // real-time mode
+  if (declare_parameter("use_realtime_mode", false)) {
+    const int realtime_priority = declare_parameter("realtime_priority", 80);
+    const int prefault_heap_size_mb = declare_parameter("prefault_heap_size_mb", 64);
+    if (!autoware_utils::lockMemory(static_cast<size_t>(prefault_heap_size_mb) << 20)) {
+      RCLCPP_WARN(get_logger(), "failed to lock the memory, CAP_IPC_LOCK is required.");
+    }
+    if (!autoware_utils::setRealtimePriority(realtime_priority)) {
+      RCLCPP_WARN(get_logger(), "failed to set SCHED_FIFO, CAP_SYS_NICE is required.");
+    }
+    updater_ = std::make_unique<diagnostic_updater::Updater>(this);
+    updater_->setHardwareID("velocity_controller");
+    updater_->add(
+      "control_timer_deadline", [this](auto & stat) { timer_deadline_monitor_.diagnose(stat); });
+  }
+
   // set parameter callback
   set_param_res_ =
     this->add_on_set_parameters_callback(std::bind(&VelocityController::paramCallback, this, _1));
@@ -184,7 +205,7 @@ void VelocityController::callbackCurrentVelocity(
   if (current_vel_ptr_) {
     prev_vel_ptr_ = current_vel_ptr_;
   }
-  current_vel_ptr_ = std::make_shared<geometry_msgs::msg::TwistStamped>(*msg);
+  current_vel_ptr_ = msg;
 }
 
 void VelocityController::callbackTrajectory(
@@ -201,7 +222,8 @@ void VelocityController::callbackTrajectory(
     return;
   }
 
-  trajectory_ptr_ = std::make_shared<autoware_planning_msgs::msg::Trajectory>(*msg);
+  trajectory_ptr_ = msg;
+  trajectory_arc_length_table_.update(msg->points);
 }
 
 rcl_interfaces::msg::SetParametersResult VelocityController::paramCallback(
@@ -392,8 +414,9 @@ VelocityController::ControlData VelocityController::getControlData(
   prev_shift_ = control_data.shift;
 
   // distance to stopline
-  control_data.stop_dist =
-    velocity_controller_utils::calcStopDistance(current_pose.position, *trajectory_ptr_);
+  control_data.stop_dist = velocity_controller_utils::calcStopDistance(
+    current_pose.position, *trajectory_ptr_, trajectory_arc_length_table_,
+    control_data.nearest_idx);
 
   // pitch
   const double raw_pitch = velocity_controller_utils::getPitchByPose(current_pose.orientation);
@@ -440,7 +463,11 @@ VelocityController::ControlState VelocityController::updateControlState(
   if (
     std::fabs(current_vel) > p.stopped_state_entry_vel ||
     std::fabs(current_acc) > p.stopped_state_entry_acc) {
-    last_running_time_ = std::make_shared<rclcpp::Time>(this->now());
+    if (last_running_time_) {
+      *last_running_time_ = this->now();
+    } else {
+      last_running_time_ = std::make_shared<rclcpp::Time>(this->now());
+    }
   }
   const bool stopped_condition =
     last_running_time_ ? (this->now() - *last_running_time_).seconds() > 0.5 : false;
@@ -764,19 +791,23 @@ autoware_planning_msgs::msg::TrajectoryPoint VelocityController::calcInterpolate
 
   // If the current position is not within the reference trajectory, enable the edge value.
   // Else, apply linear interpolation
+  const autoware_utils::Point2d point_2d(point.x, point.y);
   if (nearest_idx == 0) {
-    if (autoware_utils::calcSignedArcLength(traj.points, point, 0) > 0) {
+    if (trajectory_arc_length_table_.calcSignedArcLength(point_2d, 0, nearest_idx) > 0) {
       return traj.points.at(0);
     }
   }
   if (nearest_idx == traj.points.size() - 1) {
-    if (autoware_utils::calcSignedArcLength(traj.points, point, traj.points.size() - 1) < 0) {
+    if (
+      trajectory_arc_length_table_.calcSignedArcLength(
+        point_2d, traj.points.size() - 1, nearest_idx) < 0) {
       return traj.points.at(traj.points.size() - 1);
     }
   }
 
   // apply linear interpolation
-  return velocity_controller_utils::lerpTrajectoryPoint(traj.points, point);
+  return velocity_controller_utils::lerpTrajectoryPoint(
+    traj.points, trajectory_arc_length_table_, point, nearest_idx);
 }
 
 double VelocityController::predictedVelocityInTargetPoint(
@@ -54,6 +54,17 @@ double calcStopDistance(const Point & current_pos, const Trajectory & traj)
   return autoware_utils::calcSignedArcLength(traj.points, current_pos, *stop_idx_opt);
 }
 
+double calcStopDistance(
+  const Point & current_pos, const Trajectory & traj,
+  const autoware_utils::ArcLengthTable & arc_length_table, const size_t hint_idx)
+{
+  const boost::optional<size_t> stop_idx_opt = autoware_utils::searchZeroVelocityIndex(traj.points);
+  const size_t stop_idx = stop_idx_opt ? *stop_idx_opt : traj.points.size() - 1;
+
+  const autoware_utils::Point2d current_pos_2d(current_pos.x, current_pos.y);
+  return arc_length_table.calcSignedArcLength(current_pos_2d, stop_idx, hint_idx);
+}
+
 double getPitchByPose(const Quaternion & quaternion)
 {
   const Eigen::Quaterniond q(quaternion.w, quaternion.x, quaternion.y, quaternion.z);
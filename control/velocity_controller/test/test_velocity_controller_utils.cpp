@@ -90,6 +90,10 @@ TEST(test_velocity_controller_utils, calcStopDistance)
   point.twist.linear.x = 0.0;
   traj.points.push_back(point);
   EXPECT_EQ(vcu::calcStopDistance(current_pos, traj), 3.0);
+  // same with the arc length table of the trajectory
+  const autoware_utils::ArcLengthTable arc_length_table(traj.points);
+  EXPECT_DOUBLE_EQ(vcu::calcStopDistance(current_pos, traj, arc_length_table, 0), 3.0);
+  EXPECT_DOUBLE_EQ(vcu::calcStopDistance(current_pos, traj, arc_length_table, 5), 3.0);
 }
 
 TEST(test_velocity_controller_utils, getPitchByPose)
@@ -419,6 +423,18 @@ TEST(test_velocity_controller_utils, lerpTrajectoryPoint)
   EXPECT_NEAR(result.pose.position.y, 0.0, abs_err);
   EXPECT_NEAR(result.twist.linear.x, 15.0, abs_err);
   EXPECT_NEAR(result.accel.linear.x, 15.0, abs_err);
+
+  // Same with the arc length table, from any hint
+  const autoware_utils::ArcLengthTable arc_length_table(points);
+  point.x = 1.5;
+  point.y = 1.25;
+  for (size_t hint_idx = 0; hint_idx < points.size(); ++hint_idx) {
+    result = vcu::lerpTrajectoryPoint(points, arc_length_table, point, hint_idx);
+    EXPECT_NEAR(result.pose.position.x, point.x, abs_err);
+    EXPECT_NEAR(result.pose.position.y, 1.0, abs_err);
+    EXPECT_NEAR(result.twist.linear.x, 35.0, abs_err);
+    EXPECT_NEAR(result.accel.linear.x, 35.0, abs_err);
+  }
 }
 
 TEST(test_velocity_controller, applyDiffLimitFilter)
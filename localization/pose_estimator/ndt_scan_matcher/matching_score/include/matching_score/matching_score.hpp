@@ -17,6 +17,8 @@
 
 #include <pcl/search/kdtree.h>
 
+#include <Eigen/Core>
+
 #include <vector>
 
 template <class PointType>
@@ -39,6 +41,17 @@ public:
   double calcMatchingScore(
     const boost::shared_ptr<pcl::PointCloud<PointType> const> & pointcloud_ptr);
 
+  /** \brief Score of pointcloud_ptr transformed by each of the candidate poses, in one parallel
+   * pass over all (pose, point) pairs against the same target tree. Unlike calcMatchingScore()
+   * it does not store the per-point distances.
+   * \param pointcloud_ptr the source points in the sensor frame
+   * \param poses the candidate poses (source to target)
+   * \param num_threads the number of OpenMP threads
+   */
+  std::vector<double> calcMatchingScores(
+    const boost::shared_ptr<pcl::PointCloud<PointType> const> & pointcloud_ptr,
+    const std::vector<Eigen::Matrix4f> & poses, const int num_threads = 1) const;
+
   void setFermikT(const double fermi_kT) { fermi_kT_ = fermi_kT; }
 
   double getFermikT() const { return fermi_kT_; }
@@ -55,7 +68,7 @@ public:
 private:
   std::vector<PointWithDistance<PointType>> convertPointWithDistance(
     const boost::shared_ptr<pcl::PointCloud<PointType> const> & pointcloud_ptr);
-  double calcFermiDistributionFunction(const double x, const double kT, const double mu);
+  static double calcFermiDistributionFunction(const double x, const double kT, const double mu);
   boost::shared_ptr<pcl::search::KdTree<PointType>> tree_ptr_;
   std::vector<PointWithDistance<PointType>> point_with_distance_array_;
 
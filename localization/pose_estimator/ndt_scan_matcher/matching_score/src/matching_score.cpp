@@ -16,6 +16,15 @@
 
 #include <pcl/point_types.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
 template <class PointType>
 MatchingScore<PointType>::MatchingScore() : fermi_kT_(0.05), fermi_mu_(0.25)
 {
@@ -25,10 +34,12 @@ template <class PointType>
 void MatchingScore<PointType>::setInputTarget(
   const boost::shared_ptr<pcl::PointCloud<PointType> const> & pointcloud_ptr)
 {
-  static size_t points_size = 0;
-  if (points_size != pointcloud_ptr->points.size()) {
+  if (!tree_ptr_) {
+    tree_ptr_.reset(new pcl::search::KdTree<PointType>);
+  }
+  // the tree may be shared with the NDT target (setSearchMethodTarget), do not rebuild it then
+  if (tree_ptr_->getInputCloud() != pointcloud_ptr) {
     tree_ptr_->setInputCloud(pointcloud_ptr);
-    points_size = pointcloud_ptr->points.size();
   }
 }
 
@@ -56,6 +67,64 @@ double MatchingScore<PointType>::calcMatchingScore(
   return score;
 }
 
+template <class PointType>
+std::vector<double> MatchingScore<PointType>::calcMatchingScores(
+  const boost::shared_ptr<pcl::PointCloud<PointType> const> & pointcloud_ptr,
+  const std::vector<Eigen::Matrix4f> & poses, const int num_threads) const
+{
+  std::vector<double> scores(poses.size(), 0.0);
+  if (!tree_ptr_ || pointcloud_ptr->points.empty() || poses.empty()) {
+    return scores;
+  }
+
+  const auto & points = pointcloud_ptr->points;
+  const int64_t num_points = static_cast<int64_t>(points.size());
+  const int64_t num_pairs = num_points * static_cast<int64_t>(poses.size());
+  const int threads = std::max(num_threads, 1);
+  const double s0 = calcFermiDistributionFunction(0, fermi_kT_, fermi_mu_);  // to normalize to 1
+
+  // one row of per-pose sums per thread, so that threads never write the same value
+  std::vector<double> partial_sums(threads * poses.size(), 0.0);
+#pragma omp parallel num_threads(threads)
+  {
+#ifdef _OPENMP
+    double * sums = partial_sums.data() + omp_get_thread_num() * poses.size();
+#else
+    double * sums = partial_sums.data();
+#endif
+    std::vector<int> nn_indices(1);
+    std::vector<float> nn_dists(1);
+#pragma omp for schedule(static)
+    for (int64_t pair = 0; pair < num_pairs; ++pair) {
+      const size_t pose_index = static_cast<size_t>(pair / num_points);
+      const auto & point = points[pair % num_points];
+      const Eigen::Matrix4f & pose = poses[pose_index];
+      PointType transformed_point = point;
+      transformed_point.x =
+        pose(0, 0) * point.x + pose(0, 1) * point.y + pose(0, 2) * point.z + pose(0, 3);
+      transformed_point.y =
+        pose(1, 0) * point.x + pose(1, 1) * point.y + pose(1, 2) * point.z + pose(1, 3);
+      transformed_point.z =
+        pose(2, 0) * point.x + pose(2, 1) * point.y + pose(2, 2) * point.z + pose(2, 3);
+      if (tree_ptr_->nearestKSearch(transformed_point, 1, nn_indices, nn_dists) == 0) {
+        continue;
+      }
+      sums[pose_index] +=
+        calcFermiDistributionFunction(std::sqrt(nn_dists[0]), fermi_kT_, fermi_mu_) / s0;
+    }
+  }
+
+  for (int t = 0; t < threads; ++t) {
+    for (size_t i = 0; i < poses.size(); ++i) {
+      scores[i] += partial_sums[t * poses.size() + i];
+    }
+  }
+  for (auto & score : scores) {
+    score /= static_cast<double>(num_points);
+  }
+  return scores;
+}
+
 template <class PointType>
 double MatchingScore<PointType>::calcFermiDistributionFunction(
   const double x, const double kT, const double mu)
@@ -20,6 +20,7 @@
 #include <pcl/point_types.h>
 #include <pcl/search/kdtree.h>
 
+#include <memory>
 #include <vector>
 
 template <class PointSource, class PointTarget>
@@ -53,6 +54,10 @@ public:
   virtual Eigen::Matrix<double, 6, 6> getHessian() const = 0;
 
   virtual boost::shared_ptr<pcl::search::KdTree<PointTarget>> getSearchMethodTarget() const = 0;
+
+  /** \brief Copy of this instance including its target voxel grid, so that several alignments
+   * can run concurrently without rebuilding the grid from the map. */
+  virtual std::shared_ptr<NormalDistributionsTransformBase> clone() const = 0;
 };
 
 #include "ndt/impl/base.hpp"
@@ -17,6 +17,7 @@
 
 #include "ndt/omp.hpp"
 
+#include <memory>
 #include <vector>
 
 template <class PointSource, class PointTarget>
@@ -146,8 +147,8 @@ template <class PointSource, class PointTarget>
 Eigen::Matrix<double, 6, 6> NormalDistributionsTransformOMP<PointSource, PointTarget>::getHessian()
   const
 {
-  // return ndt_ptr_->getHessian();
-  return Eigen::Matrix<double, 6, 6>();
+  // not provided by this implementation
+  return Eigen::Matrix<double, 6, 6>::Zero();
 }
 
 template <class PointSource, class PointTarget>
@@ -183,4 +184,14 @@ NormalDistributionsTransformOMP<PointSource, PointTarget>::getNeighborhoodSearch
   return ndt_ptr_->getNeighborhoodSearchMethod();
 }
 
+template <class PointSource, class PointTarget>
+std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>>
+NormalDistributionsTransformOMP<PointSource, PointTarget>::clone() const
+{
+  using NDT = pclomp::NormalDistributionsTransform<PointSource, PointTarget>;
+  auto clone_ptr = std::make_shared<NormalDistributionsTransformOMP>();
+  clone_ptr->ndt_ptr_.reset(new NDT(*ndt_ptr_));
+  return clone_ptr;
+}
+
 #endif  // NORMAL_DISTRIBUTIONS_TRANSFORM_OMP_HPP
@@ -17,6 +17,7 @@
 
 #include "ndt/pcl_generic.hpp"
 
+#include <memory>
 #include <vector>
 
 template <class PointSource, class PointTarget>
@@ -148,8 +149,8 @@ template <class PointSource, class PointTarget>
 Eigen::Matrix<double, 6, 6>
 NormalDistributionsTransformPCLGeneric<PointSource, PointTarget>::getHessian() const
 {
-  // return ndt_ptr_->getHessian();
-  return Eigen::Matrix<double, 6, 6>();
+  // not provided by this implementation
+  return Eigen::Matrix<double, 6, 6>::Zero();
 }
 
 template <class PointSource, class PointTarget>
@@ -159,4 +160,14 @@ NormalDistributionsTransformPCLGeneric<PointSource, PointTarget>::getSearchMetho
   return ndt_ptr_->getSearchMethodTarget();
 }
 
+template <class PointSource, class PointTarget>
+std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>>
+NormalDistributionsTransformPCLGeneric<PointSource, PointTarget>::clone() const
+{
+  using NDT = pcl::NormalDistributionsTransform<PointSource, PointTarget>;
+  auto clone_ptr = std::make_shared<NormalDistributionsTransformPCLGeneric>();
+  clone_ptr->ndt_ptr_.reset(new NDT(*ndt_ptr_));
+  return clone_ptr;
+}
+
 #endif  // NORMAL_DISTRIBUTIONS_TRANSFORM_PCL_GENERIC_HPP
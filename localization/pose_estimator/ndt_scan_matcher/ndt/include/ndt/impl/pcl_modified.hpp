@@ -17,6 +17,7 @@
 
 #include "ndt/pcl_modified.hpp"
 
+#include <memory>
 #include <vector>
 
 template <class PointSource, class PointTarget>
@@ -159,4 +160,14 @@ NormalDistributionsTransformPCLModified<PointSource, PointTarget>::getSearchMeth
   return ndt_ptr_->getSearchMethodTarget();
 }
 
+template <class PointSource, class PointTarget>
+std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>>
+NormalDistributionsTransformPCLModified<PointSource, PointTarget>::clone() const
+{
+  using NDT = pcl::NormalDistributionsTransformModified<PointSource, PointTarget>;
+  auto clone_ptr = std::make_shared<NormalDistributionsTransformPCLModified>();
+  clone_ptr->ndt_ptr_.reset(new NDT(*ndt_ptr_));
+  return clone_ptr;
+}
+
 #endif  // NORMAL_DISTRIBUTIONS_TRANSFORM_PCL_MODIFIED_HPP
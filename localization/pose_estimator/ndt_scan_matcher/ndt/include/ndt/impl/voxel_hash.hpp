@@ -0,0 +1,299 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NORMAL_DISTRIBUTIONS_TRANSFORM_VOXEL_HASH_HPP
+#define NORMAL_DISTRIBUTIONS_TRANSFORM_VOXEL_HASH_HPP
+
+#include "ndt/voxel_hash.hpp"
+
+#include <pcl/common/transforms.h>
+
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+template <class PointSource, class PointTarget>
+NormalDistributionsTransformVoxelHash<
+  PointSource, PointTarget>::NormalDistributionsTransformVoxelHash()
+: resolution_(1.0f)
+{
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::align(
+  pcl::PointCloud<PointSource> & output, const Eigen::Matrix4f & guess)
+{
+  solver_.align(guess);
+  if (source_ptr_) {
+    pcl::transformPointCloud(*source_ptr_, output, solver_.getFinalTransformation());
+  }
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setInputTarget(
+  const boost::shared_ptr<pcl::PointCloud<PointTarget>> & map_ptr)
+{
+  target_ptr_ = map_ptr;
+  {
+    std::lock_guard<std::mutex> lock(target_tree_mtx_);
+    target_tree_ptr_.reset();
+  }
+  buildTargetGrid();
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setInputSource(
+  const boost::shared_ptr<pcl::PointCloud<PointSource>> & scan_ptr)
+{
+  source_ptr_ = scan_ptr;
+  std::vector<Eigen::Vector3f> points;
+  points.reserve(scan_ptr->points.size());
+  for (const auto & p : scan_ptr->points) {
+    points.emplace_back(p.x, p.y, p.z);
+  }
+  solver_.setSource(points);
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setMaximumIterations(
+  int max_iter)
+{
+  solver_.setMaximumIterations(max_iter);
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setResolution(float res)
+{
+  if (resolution_ == res) {
+    return;
+  }
+  resolution_ = res;
+  buildTargetGrid();
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setStepSize(
+  double step_size)
+{
+  solver_.setStepSize(step_size);
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setTransformationEpsilon(
+  double trans_eps)
+{
+  solver_.setTransformationEpsilon(trans_eps);
+}
+
+template <class PointSource, class PointTarget>
+int NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getMaximumIterations()
+{
+  return solver_.getMaximumIterations();
+}
+
+template <class PointSource, class PointTarget>
+int NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getFinalNumIteration() const
+{
+  return solver_.getFinalNumIteration();
+}
+
+template <class PointSource, class PointTarget>
+float NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getResolution() const
+{
+  return resolution_;
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getStepSize() const
+{
+  return solver_.getStepSize();
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getTransformationEpsilon()
+{
+  return solver_.getTransformationEpsilon();
+}
+
+template <class PointSource, class PointTarget>
+double
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getTransformationProbability()
+  const
+{
+  return solver_.getTransformationProbability();
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getFitnessScore()
+{
+  // same definition as pcl::Registration::getFitnessScore()
+  const auto tree_ptr = getSearchMethodTarget();
+  if (!tree_ptr || !source_ptr_) {
+    return std::numeric_limits<double>::max();
+  }
+  pcl::PointCloud<PointSource> output;
+  pcl::transformPointCloud(*source_ptr_, output, solver_.getFinalTransformation());
+
+  std::vector<int> indices(1);
+  std::vector<float> sqr_distances(1);
+  double fitness_score = 0.0;
+  int nr = 0;
+  for (const auto & p : output.points) {
+    PointTarget q;
+    q.x = p.x;
+    q.y = p.y;
+    q.z = p.z;
+    if (tree_ptr->nearestKSearch(q, 1, indices, sqr_distances) == 1) {
+      fitness_score += sqr_distances[0];
+      ++nr;
+    }
+  }
+  return nr > 0 ? fitness_score / nr : std::numeric_limits<double>::max();
+}
+
+template <class PointSource, class PointTarget>
+boost::shared_ptr<const pcl::PointCloud<PointTarget>>
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getInputTarget() const
+{
+  return target_ptr_;
+}
+
+template <class PointSource, class PointTarget>
+boost::shared_ptr<const pcl::PointCloud<PointSource>>
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getInputSource() const
+{
+  return source_ptr_;
+}
+
+template <class PointSource, class PointTarget>
+Eigen::Matrix4f
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getFinalTransformation() const
+{
+  return solver_.getFinalTransformation();
+}
+
+template <class PointSource, class PointTarget>
+std::vector<Eigen::Matrix4f>
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getFinalTransformationArray()
+  const
+{
+  return solver_.getFinalTransformationArray();
+}
+
+template <class PointSource, class PointTarget>
+Eigen::Matrix<double, 6, 6>
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getHessian() const
+{
+  return solver_.getHessian();
+}
+
+template <class PointSource, class PointTarget>
+boost::shared_ptr<pcl::search::KdTree<PointTarget>>
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getSearchMethodTarget() const
+{
+  std::lock_guard<std::mutex> lock(target_tree_mtx_);
+  if (!target_tree_ptr_ && target_ptr_) {
+    target_tree_ptr_.reset(new pcl::search::KdTree<PointTarget>);
+    target_tree_ptr_->setInputCloud(target_ptr_);
+  }
+  return target_tree_ptr_;
+}
+
+template <class PointSource, class PointTarget>
+std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>>
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::clone() const
+{
+  // the target grid is immutable and shared with the clone
+  auto clone_ptr = std::make_shared<NormalDistributionsTransformVoxelHash>();
+  clone_ptr->solver_ = solver_;
+  clone_ptr->resolution_ = resolution_;
+  clone_ptr->target_grid_cache_path_ = target_grid_cache_path_;
+  clone_ptr->target_ptr_ = target_ptr_;
+  clone_ptr->source_ptr_ = source_ptr_;
+  {
+    std::lock_guard<std::mutex> lock(target_tree_mtx_);
+    clone_ptr->target_tree_ptr_ = target_tree_ptr_;
+  }
+  return clone_ptr;
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setNumThreads(int n)
+{
+  solver_.setNumThreads(n);
+}
+
+template <class PointSource, class PointTarget>
+bool NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setUseGpu(bool use_gpu)
+{
+  return solver_.setUseGpu(use_gpu);
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setTargetGridCachePath(
+  const std::string & path)
+{
+  target_grid_cache_path_ = path;
+}
+
+template <class PointSource, class PointTarget>
+int NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getNumThreads() const
+{
+  return solver_.getNumThreads();
+}
+
+template <class PointSource, class PointTarget>
+bool NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getUseGpu() const
+{
+  return solver_.getUseGpu();
+}
+
+template <class PointSource, class PointTarget>
+const std::string &
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getTargetGridCachePath() const
+{
+  return target_grid_cache_path_;
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::buildTargetGrid()
+{
+  if (!target_ptr_) {
+    return;
+  }
+  std::vector<Eigen::Vector3f> points;
+  points.reserve(target_ptr_->points.size());
+  for (const auto & p : target_ptr_->points) {
+    points.emplace_back(p.x, p.y, p.z);
+  }
+  auto grid_ptr = std::make_shared<ndt::voxel_hash::TargetGrid>();
+  if (target_grid_cache_path_.empty()) {
+    grid_ptr->build(points, resolution_);
+    solver_.setTarget(grid_ptr);
+    return;
+  }
+
+  // hashing the points is much cheaper than the covariance of every voxel
+  const uint64_t fingerprint = ndt::voxel_hash::TargetGrid::computeFingerprint(points);
+  if (!grid_ptr->load(
+        target_grid_cache_path_, resolution_, grid_ptr->getMinPointsPerVoxel(), fingerprint)) {
+    grid_ptr->build(points, resolution_);
+    grid_ptr->save(target_grid_cache_path_, fingerprint);
+  }
+  solver_.setTarget(grid_ptr);
+}
+
+#endif  // NORMAL_DISTRIBUTIONS_TRANSFORM_VOXEL_HASH_HPP
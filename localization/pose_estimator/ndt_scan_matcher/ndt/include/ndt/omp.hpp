@@ -22,6 +22,7 @@
 #include <pcl/point_types.h>
 #include <pclomp/ndt_omp.h>
 
+#include <memory>
 #include <vector>
 
 template <class PointSource, class PointTarget>
@@ -57,6 +58,9 @@ public:
 
   boost::shared_ptr<pcl::search::KdTree<PointTarget>> getSearchMethodTarget() const override;
 
+  std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> clone()
+    const override;
+
   // only OMP Impl
   void setNumThreads(int n);
   void setNeighborhoodSearchMethod(pclomp::NeighborSearchMethod method);
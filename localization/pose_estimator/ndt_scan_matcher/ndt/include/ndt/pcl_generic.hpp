@@ -22,6 +22,7 @@
 #include <pcl/point_types.h>
 #include <pcl/registration/ndt.h>
 
+#include <memory>
 #include <vector>
 
 template <class PointSource, class PointTarget>
@@ -57,6 +58,9 @@ public:
 
   boost::shared_ptr<pcl::search::KdTree<PointTarget>> getSearchMethodTarget() const override;
 
+  std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> clone()
+    const override;
+
 private:
   boost::shared_ptr<pcl::NormalDistributionsTransform<PointSource, PointTarget>> ndt_ptr_;
 };
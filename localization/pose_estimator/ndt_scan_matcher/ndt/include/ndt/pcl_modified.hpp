@@ -23,6 +23,7 @@
 #include <pcl/io/pcd_io.h>
 #include <pcl/point_types.h>
 
+#include <memory>
 #include <vector>
 
 template <class PointSource, class PointTarget>
@@ -58,6 +59,9 @@ public:
 
   boost::shared_ptr<pcl::search::KdTree<PointTarget>> getSearchMethodTarget() const override;
 
+  std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> clone()
+    const override;
+
 private:
   boost::shared_ptr<pcl::NormalDistributionsTransformModified<PointSource, PointTarget>> ndt_ptr_;
 };
@@ -0,0 +1,101 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NORMAL_DISTRIBUTIONS_TRANSFORM_VOXEL_HASH_H
+#define NORMAL_DISTRIBUTIONS_TRANSFORM_VOXEL_HASH_H
+
+#include "ndt/base.hpp"
+#include "ndt/voxel_hash/solver.hpp"
+#include "ndt/voxel_hash/target_grid.hpp"
+
+#include <pcl/io/io.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl/point_types.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** \brief NDT with the target voxels in a hashed structure of arrays and a DIRECT7 neighbour
+ * lookup (see ndt::voxel_hash). The score, gradient and Hessian are evaluated with OpenMP or,
+ * when built with CUDA, on the GPU.
+ */
+template <class PointSource, class PointTarget>
+class NormalDistributionsTransformVoxelHash
+: public NormalDistributionsTransformBase<PointSource, PointTarget>
+{
+public:
+  NormalDistributionsTransformVoxelHash();
+  ~NormalDistributionsTransformVoxelHash() = default;
+
+  void align(pcl::PointCloud<PointSource> & output, const Eigen::Matrix4f & guess) override;
+  void setInputTarget(const boost::shared_ptr<pcl::PointCloud<PointTarget>> & map_ptr) override;
+  void setInputSource(const boost::shared_ptr<pcl::PointCloud<PointSource>> & scan_ptr) override;
+
+  void setMaximumIterations(int max_iter) override;
+  void setResolution(float res) override;
+  void setStepSize(double step_size) override;
+  void setTransformationEpsilon(double trans_eps) override;
+
+  int getMaximumIterations() override;
+  int getFinalNumIteration() const override;
+  float getResolution() const override;
+  double getStepSize() const override;
+  double getTransformationEpsilon() override;
+  double getTransformationProbability() const override;
+  double getFitnessScore() override;
+  boost::shared_ptr<const pcl::PointCloud<PointTarget>> getInputTarget() const override;
+  boost::shared_ptr<const pcl::PointCloud<PointSource>> getInputSource() const override;
+  Eigen::Matrix4f getFinalTransformation() const override;
+  std::vector<Eigen::Matrix4f> getFinalTransformationArray() const override;
+
+  Eigen::Matrix<double, 6, 6> getHessian() const override;
+
+  /** \brief KD-tree of the target points. It is not needed for the alignment, so it is only
+   * built on the first call. */
+  boost::shared_ptr<pcl::search::KdTree<PointTarget>> getSearchMethodTarget() const override;
+
+  std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> clone()
+    const override;
+
+  // only VoxelHash Impl
+  void setNumThreads(int n);
+  /** \brief Returns false if the package was built without CUDA, the CPU is used then. */
+  bool setUseGpu(bool use_gpu);
+  /** \brief Load the target grid from path instead of building it, if the file was saved for
+   * the same resolution and target points. Otherwise the grid is built and saved there.
+   * An empty path disables the cache. */
+  void setTargetGridCachePath(const std::string & path);
+
+  int getNumThreads() const;
+  bool getUseGpu() const;
+  const std::string & getTargetGridCachePath() const;
+
+private:
+  void buildTargetGrid();
+
+  ndt::voxel_hash::Solver solver_;
+  float resolution_;
+  std::string target_grid_cache_path_;
+  boost::shared_ptr<pcl::PointCloud<PointTarget>> target_ptr_;
+  boost::shared_ptr<pcl::PointCloud<PointSource>> source_ptr_;
+
+  mutable std::mutex target_tree_mtx_;
+  mutable boost::shared_ptr<pcl::search::KdTree<PointTarget>> target_tree_ptr_;
+};
+
+#include "ndt/impl/voxel_hash.hpp"
+
+#endif
@@ -0,0 +1,248 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NDT__VOXEL_HASH__DERIVATIVES_HPP_
+#define NDT__VOXEL_HASH__DERIVATIVES_HPP_
+
+// Per-point NDT score, gradient and Hessian terms [Magnusson 2009], written without Eigen so
+// that the same code runs in the OpenMP loop on the CPU and in the CUDA kernel.
+
+#include <cmath>
+#include <cstdint>
+
+#ifdef __CUDACC__
+#define NDT_VOXEL_HASH_HOST_DEVICE __host__ __device__
+#else
+#define NDT_VOXEL_HASH_HOST_DEVICE
+#endif
+
+namespace ndt
+{
+namespace voxel_hash
+{
+/** \brief Non-owning view of a TargetGrid, with one array per component (structure of arrays).
+ * Voxels are found through an open addressing hash table of keys_capacity slots. */
+struct GridView
+{
+  const float * mean_x;
+  const float * mean_y;
+  const float * mean_z;
+  // upper triangle of the inverse covariance: xx, xy, xz, yy, yz, zz
+  const float * icov[6];
+  const uint64_t * keys;
+  const int32_t * slots;
+  uint64_t keys_mask;
+  float inverse_resolution;
+};
+
+/** \brief Derivatives of the rotation with respect to roll, pitch and yaw, eq. 6.19 and 6.21
+ * [Magnusson 2009]. Depends only on the pose, so it is computed once per evaluation. */
+struct AngleDerivatives
+{
+  double j_ang[8][3];
+  double h_ang[15][3];
+};
+
+/** \brief Pose of one evaluation: the rotation R = Rx(roll) * Ry(pitch) * Rz(yaw) in row-major
+ * order, the translation and the angle derivatives. */
+struct PoseCoefficients
+{
+  double rotation[9];
+  double translation[3];
+  AngleDerivatives angle;
+};
+
+/** \brief Sum of the per-point terms. Only the upper triangle of the Hessian is accumulated. */
+struct Derivatives
+{
+  double score;
+  double gradient[6];
+  double hessian[21];
+};
+
+NDT_VOXEL_HASH_HOST_DEVICE inline int upperTriangleIndex(const int i, const int j)
+{
+  // row-major index of (i, j), i <= j, in the upper triangle of a 6x6 matrix
+  return i * 6 - i * (i - 1) / 2 + (j - i);
+}
+
+NDT_VOXEL_HASH_HOST_DEVICE inline uint64_t toVoxelKey(
+  const int64_t ix, const int64_t iy, const int64_t iz)
+{
+  // 21 bits per axis, which covers +-100 km with a 0.1 m resolution
+  const uint64_t mask = (uint64_t{1} << 21) - 1;
+  return ((static_cast<uint64_t>(ix) & mask) << 42) | ((static_cast<uint64_t>(iy) & mask) << 21) |
+         (static_cast<uint64_t>(iz) & mask);
+}
+
+NDT_VOXEL_HASH_HOST_DEVICE inline uint64_t hashVoxelKey(const uint64_t key)
+{
+  uint64_t h = key * 0x9E3779B97F4A7C15ULL;
+  return h ^ (h >> 32);
+}
+
+/** \brief Return the voxel index of key, or -1 if the voxel has no valid distribution. */
+NDT_VOXEL_HASH_HOST_DEVICE inline int32_t findVoxel(const GridView & grid, const uint64_t key)
+{
+  for (uint64_t slot = hashVoxelKey(key) & grid.keys_mask;; slot = (slot + 1) & grid.keys_mask) {
+    const int32_t index = grid.slots[slot];
+    if (index < 0 || grid.keys[slot] == key) {
+      return index;
+    }
+  }
+}
+
+/** \brief Point gradient (eq. 6.18) and the non-zero part of the point Hessian (eq. 6.20)
+ * [Magnusson 2009] of the source point x. point_hessian holds the vectors a, b, c, d, e, f. */
+NDT_VOXEL_HASH_HOST_DEVICE inline void computePointDerivatives(
+  const double x[3], const AngleDerivatives & angle, const bool compute_hessian,
+  double point_gradient[3][6], double point_hessian[6][3])
+{
+  auto dot = [x](const double * v) { return x[0] * v[0] + x[1] * v[1] + x[2] * v[2]; };
+
+  for (int r = 0; r < 3; ++r) {
+    for (int c = 0; c < 6; ++c) {
+      point_gradient[r][c] = (r == c) ? 1.0 : 0.0;
+    }
+  }
+  point_gradient[1][3] = dot(angle.j_ang[0]);
+  point_gradient[2][3] = dot(angle.j_ang[1]);
+  point_gradient[0][4] = dot(angle.j_ang[2]);
+  point_gradient[1][4] = dot(angle.j_ang[3]);
+  point_gradient[2][4] = dot(angle.j_ang[4]);
+  point_gradient[0][5] = dot(angle.j_ang[5]);
+  point_gradient[1][5] = dot(angle.j_ang[6]);
+  point_gradient[2][5] = dot(angle.j_ang[7]);
+
+  if (!compute_hessian) {
+    return;
+  }
+  const double(*h)[3] = angle.h_ang;
+  const double values[6][3] = {
+    {0.0, dot(h[0]), dot(h[1])},          {0.0, dot(h[2]), dot(h[3])},
+    {0.0, dot(h[4]), dot(h[5])},          {dot(h[6]), dot(h[7]), dot(h[8])},
+    {dot(h[9]), dot(h[10]), dot(h[11])}, {dot(h[12]), dot(h[13]), dot(h[14])}};
+  for (int v = 0; v < 6; ++v) {
+    for (int k = 0; k < 3; ++k) {
+      point_hessian[v][k] = values[v][k];
+    }
+  }
+}
+
+/** \brief Add the terms of one point and one voxel, eq. 6.9, 6.12 and 6.13 [Magnusson 2009].
+ * x_trans is the transformed point minus the voxel mean. Returns false if the point
+ * contributes nothing. */
+NDT_VOXEL_HASH_HOST_DEVICE inline bool updateDerivatives(
+  const double x_trans[3], const double icov[3][3], const double point_gradient[3][6],
+  const double point_hessian[6][3], const double gauss_d1, const double gauss_d2,
+  const bool compute_hessian, Derivatives & derivatives)
+{
+  double icov_x[3];
+  for (int r = 0; r < 3; ++r) {
+    icov_x[r] = icov[r][0] * x_trans[0] + icov[r][1] * x_trans[1] + icov[r][2] * x_trans[2];
+  }
+  const double x_icov_x = x_trans[0] * icov_x[0] + x_trans[1] * icov_x[1] + x_trans[2] * icov_x[2];
+
+  double e_x_cov_x = exp(-gauss_d2 * x_icov_x / 2);
+  const double score_inc = -gauss_d1 * e_x_cov_x;
+  e_x_cov_x = gauss_d2 * e_x_cov_x;
+  // Reject rounding errors and non-finite values
+  if (e_x_cov_x > 1 || e_x_cov_x < 0 || e_x_cov_x != e_x_cov_x) {
+    return false;
+  }
+  e_x_cov_x *= gauss_d1;
+  derivatives.score += score_inc;
+
+  // icov * point_gradient, column by column, and x_trans' * icov * point_gradient
+  double icov_dxd_pi[6][3];
+  double x_icov_dxd_pi[6];
+  for (int i = 0; i < 6; ++i) {
+    for (int r = 0; r < 3; ++r) {
+      icov_dxd_pi[i][r] = icov[r][0] * point_gradient[0][i] + icov[r][1] * point_gradient[1][i] +
+                          icov[r][2] * point_gradient[2][i];
+    }
+    x_icov_dxd_pi[i] = x_trans[0] * icov_dxd_pi[i][0] + x_trans[1] * icov_dxd_pi[i][1] +
+                       x_trans[2] * icov_dxd_pi[i][2];
+    derivatives.gradient[i] += x_icov_dxd_pi[i] * e_x_cov_x;
+  }
+  if (!compute_hessian) {
+    return true;
+  }
+
+  // point Hessian block (i, j) for i, j >= 3, see computePointDerivatives
+  const int hessian_vector[3][3] = {{0, 1, 2}, {1, 3, 4}, {2, 4, 5}};
+  for (int i = 0; i < 6; ++i) {
+    for (int j = i; j < 6; ++j) {
+      double value = -gauss_d2 * x_icov_dxd_pi[i] * x_icov_dxd_pi[j] +
+                     point_gradient[0][j] * icov_dxd_pi[i][0] +
+                     point_gradient[1][j] * icov_dxd_pi[i][1] +
+                     point_gradient[2][j] * icov_dxd_pi[i][2];
+      if (i >= 3) {
+        const double * ph = point_hessian[hessian_vector[i - 3][j - 3]];
+        value += icov_x[0] * ph[0] + icov_x[1] * ph[1] + icov_x[2] * ph[2];
+      }
+      derivatives.hessian[upperTriangleIndex(i, j)] += e_x_cov_x * value;
+    }
+  }
+  return true;
+}
+
+/** \brief Add the terms of source point (x, y, z) against the voxel containing its transformed
+ * position and the 6 face neighbours of that voxel (DIRECT7). */
+NDT_VOXEL_HASH_HOST_DEVICE inline void accumulatePoint(
+  const GridView & grid, const PoseCoefficients & pose, const float px, const float py,
+  const float pz, const double gauss_d1, const double gauss_d2, const bool compute_hessian,
+  Derivatives & derivatives)
+{
+  const double x[3] = {px, py, pz};
+  const double * R = pose.rotation;
+  double x_trans[3];
+  for (int r = 0; r < 3; ++r) {
+    x_trans[r] = R[3 * r] * x[0] + R[3 * r + 1] * x[1] + R[3 * r + 2] * x[2] + pose.translation[r];
+  }
+  const auto ix = static_cast<int64_t>(floor(x_trans[0] * grid.inverse_resolution));
+  const auto iy = static_cast<int64_t>(floor(x_trans[1] * grid.inverse_resolution));
+  const auto iz = static_cast<int64_t>(floor(x_trans[2] * grid.inverse_resolution));
+
+  double point_gradient[3][6];
+  double point_hessian[6][3];
+  bool has_point_derivatives = false;
+
+  const int offsets[7][3] = {{0, 0, 0},  {-1, 0, 0}, {1, 0, 0}, {0, -1, 0},
+                             {0, 1, 0},  {0, 0, -1}, {0, 0, 1}};
+  for (int n = 0; n < 7; ++n) {
+    const int32_t v =
+      findVoxel(grid, toVoxelKey(ix + offsets[n][0], iy + offsets[n][1], iz + offsets[n][2]));
+    if (v < 0) {
+      continue;
+    }
+    if (!has_point_derivatives) {
+      computePointDerivatives(x, pose.angle, compute_hessian, point_gradient, point_hessian);
+      has_point_derivatives = true;
+    }
+    const double diff[3] = {
+      x_trans[0] - grid.mean_x[v], x_trans[1] - grid.mean_y[v], x_trans[2] - grid.mean_z[v]};
+    const double icov[3][3] = {
+      {grid.icov[0][v], grid.icov[1][v], grid.icov[2][v]},
+      {grid.icov[1][v], grid.icov[3][v], grid.icov[4][v]},
+      {grid.icov[2][v], grid.icov[4][v], grid.icov[5][v]}};
+    updateDerivatives(
+      diff, icov, point_gradient, point_hessian, gauss_d1, gauss_d2, compute_hessian,
+      derivatives);
+  }
+}
+}  // namespace voxel_hash
+}  // namespace ndt
+
+#endif  // NDT__VOXEL_HASH__DERIVATIVES_HPP_
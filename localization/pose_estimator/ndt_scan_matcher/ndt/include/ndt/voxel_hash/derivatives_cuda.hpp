@@ -0,0 +1,55 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NDT__VOXEL_HASH__DERIVATIVES_CUDA_HPP_
+#define NDT__VOXEL_HASH__DERIVATIVES_CUDA_HPP_
+
+#include "ndt/voxel_hash/derivatives.hpp"
+#include "ndt/voxel_hash/target_grid.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace ndt
+{
+namespace voxel_hash
+{
+/** \brief Computes the sum of accumulatePoint() over the source points on the GPU. The target
+ * grid and the source points stay on the device between evaluations, so that one evaluation
+ * only uploads the pose and downloads one partial sum per warp.
+ * Only defined when the package is built with CUDA (NDT_USE_CUDA).
+ */
+class DerivativesCuda
+{
+public:
+  DerivativesCuda();
+  ~DerivativesCuda();
+  DerivativesCuda(const DerivativesCuda &) = delete;
+  DerivativesCuda & operator=(const DerivativesCuda &) = delete;
+
+  void setTarget(const TargetGrid & grid);
+  void setSource(const float * x, const float * y, const float * z, const size_t num_points);
+
+  Derivatives compute(
+    const PoseCoefficients & pose, const double gauss_d1, const double gauss_d2,
+    const bool compute_hessian);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace voxel_hash
+}  // namespace ndt
+
+#endif  // NDT__VOXEL_HASH__DERIVATIVES_CUDA_HPP_
@@ -0,0 +1,116 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NDT__VOXEL_HASH__SOLVER_HPP_
+#define NDT__VOXEL_HASH__SOLVER_HPP_
+
+#include "ndt/voxel_hash/derivatives.hpp"
+#include "ndt/voxel_hash/target_grid.hpp"
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace ndt
+{
+namespace voxel_hash
+{
+class DerivativesCuda;
+
+/** \brief Newton optimization of the NDT score [Magnusson 2009] against a TargetGrid.
+ * The target grid is immutable and shared between copies of the solver, so copies are cheap
+ * and can align concurrently.
+ */
+class Solver
+{
+public:
+  Solver();
+  ~Solver();
+  Solver(const Solver & other);
+  Solver & operator=(const Solver & other);
+
+  void setTarget(const std::shared_ptr<const TargetGrid> & grid);
+  void setSource(const std::vector<Eigen::Vector3f> & points);
+
+  void setStepSize(const double step_size) { step_size_ = step_size; }
+  void setTransformationEpsilon(const double epsilon) { transformation_epsilon_ = epsilon; }
+  void setMaximumIterations(const int max_iterations) { max_iterations_ = max_iterations; }
+  void setOutlierRatio(const double outlier_ratio) { outlier_ratio_ = outlier_ratio; }
+  void setNumThreads(const int num_threads) { num_threads_ = std::max(num_threads, 1); }
+  /** \brief Evaluate the derivatives on the GPU. Returns false, and keeps using the CPU, if the
+   * package was built without CUDA. */
+  bool setUseGpu(const bool use_gpu);
+
+  const std::shared_ptr<const TargetGrid> & getTarget() const { return target_; }
+  double getStepSize() const { return step_size_; }
+  double getTransformationEpsilon() const { return transformation_epsilon_; }
+  int getMaximumIterations() const { return max_iterations_; }
+  double getOutlierRatio() const { return outlier_ratio_; }
+  int getNumThreads() const { return num_threads_; }
+  bool getUseGpu() const { return static_cast<bool>(cuda_); }
+
+  void align(const Eigen::Matrix4f & guess);
+
+  const Eigen::Matrix4f & getFinalTransformation() const { return final_transformation_; }
+  const std::vector<Eigen::Matrix4f> & getFinalTransformationArray() const
+  {
+    return transformation_array_;
+  }
+  int getFinalNumIteration() const { return nr_iterations_; }
+  double getTransformationProbability() const { return trans_probability_; }
+  const Eigen::Matrix<double, 6, 6> & getHessian() const { return hessian_; }
+  bool hasConverged() const { return converged_; }
+
+  /** \brief Score of the pose p = (x, y, z, roll, pitch, yaw), with its gradient and, if
+   * compute_hessian is true, its Hessian. */
+  double computeDerivatives(
+    const Eigen::Matrix<double, 6, 1> & p, Eigen::Matrix<double, 6, 1> & score_gradient,
+    Eigen::Matrix<double, 6, 6> & hessian, const bool compute_hessian);
+
+private:
+  Derivatives computeDerivativesCpu(
+    const PoseCoefficients & pose, const double gauss_d1, const double gauss_d2,
+    const bool compute_hessian) const;
+  void updateGaussianParameters();
+
+  std::shared_ptr<const TargetGrid> target_;
+  std::vector<float> source_x_, source_y_, source_z_;
+
+  double step_size_{0.1};
+  double transformation_epsilon_{0.1};
+  int max_iterations_{35};
+  double outlier_ratio_{0.55};
+  int num_threads_{1};
+  double gauss_d1_{0.0};
+  double gauss_d2_{0.0};
+
+  Eigen::Matrix4f final_transformation_{Eigen::Matrix4f::Identity()};
+  std::vector<Eigen::Matrix4f> transformation_array_;
+  Eigen::Matrix<double, 6, 6> hessian_{Eigen::Matrix<double, 6, 6>::Zero()};
+  int nr_iterations_{0};
+  double trans_probability_{0.0};
+  bool converged_{false};
+
+  // never shared between solvers; a shared_ptr so that the type is only needed with CUDA
+  std::shared_ptr<DerivativesCuda> cuda_;
+
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+}  // namespace voxel_hash
+}  // namespace ndt
+
+#endif  // NDT__VOXEL_HASH__SOLVER_HPP_
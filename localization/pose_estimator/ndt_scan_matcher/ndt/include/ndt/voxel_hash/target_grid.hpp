@@ -0,0 +1,89 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NDT__VOXEL_HASH__TARGET_GRID_HPP_
+#define NDT__VOXEL_HASH__TARGET_GRID_HPP_
+
+#include "ndt/voxel_hash/derivatives.hpp"
+
+#include <Eigen/Core>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ndt
+{
+namespace voxel_hash
+{
+/** \brief Normal distributions of the target voxels, stored as flat arrays and indexed by a
+ * hash of the voxel coordinates, instead of PCL leaves reached through a KD-tree.
+ * Voxel statistics follow pcl::VoxelGridCovariance, so that the score of an alignment matches
+ * the other implementations.
+ */
+class TargetGrid
+{
+public:
+  /** \brief Build the grid. Voxels with less than min_points_per_voxel points or a degenerate
+   * covariance are dropped.
+   */
+  void build(
+    const std::vector<Eigen::Vector3f> & points, const float resolution,
+    const int min_points_per_voxel = 6);
+
+  /** \brief Write the grid to path, with the fingerprint of the points it was built from.
+   * The file is written next to path and renamed into place, so that a node loading it
+   * concurrently never sees a partial file.
+   */
+  bool save(const std::string & path, const uint64_t points_fingerprint) const;
+
+  /** \brief Read a grid written by save(). Returns false, leaving the grid unchanged, if the
+   * file is missing or invalid or was built with other parameters or from other points.
+   */
+  bool load(
+    const std::string & path, const float resolution, const int min_points_per_voxel,
+    const uint64_t points_fingerprint);
+
+  /** \brief Hash of the coordinates of points, identifying the map a saved grid belongs to. */
+  static uint64_t computeFingerprint(const std::vector<Eigen::Vector3f> & points);
+
+  size_t size() const { return mean_x_.size(); }
+  float getResolution() const { return resolution_; }
+  int getMinPointsPerVoxel() const { return min_points_per_voxel_; }
+  GridView getView() const;
+
+  // raw arrays, used to upload the grid to the GPU
+  const std::vector<float> & getMeanX() const { return mean_x_; }
+  const std::vector<float> & getMeanY() const { return mean_y_; }
+  const std::vector<float> & getMeanZ() const { return mean_z_; }
+  const std::vector<float> & getInverseCovariance(const int element) const
+  {
+    return icov_[element];
+  }
+  const std::vector<uint64_t> & getKeys() const { return keys_; }
+  const std::vector<int32_t> & getSlots() const { return slots_; }
+
+private:
+  float resolution_{1.0f};
+  int min_points_per_voxel_{6};
+  std::vector<float> mean_x_, mean_y_, mean_z_;
+  std::vector<float> icov_[6];
+  std::vector<uint64_t> keys_;
+  std::vector<int32_t> slots_;
+};
+}  // namespace voxel_hash
+}  // namespace ndt
+
+#endif  // NDT__VOXEL_HASH__TARGET_GRID_HPP_
@@ -1,4 +1,4 @@
-// Copyright 2020 Autoware Foundation
+// Copyright 2021 Tier IV, Inc.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,11 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-/**
- * @file top2.cpp
- * @brief dummy top executable to provide nothing
- */
+#include "ndt/voxel_hash.hpp"
 
-#include <stdio.h>
+#include "ndt/impl/voxel_hash.hpp"
 
-int main(int argc, char ** argv) { return 0; }
+template class NormalDistributionsTransformVoxelHash<pcl::PointXYZ, pcl::PointXYZ>;
+template class NormalDistributionsTransformVoxelHash<pcl::PointXYZI, pcl::PointXYZI>;
@@ -0,0 +1,209 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ndt/voxel_hash/derivatives_cuda.hpp"
+
+#include <cuda_runtime.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ndt
+{
+namespace voxel_hash
+{
+namespace
+{
+constexpr int BLOCK_SIZE = 256;
+constexpr int WARP_SIZE = 32;
+constexpr int NUM_VALUES = 1 + 6 + 21;
+
+void checkCuda(const cudaError_t error)
+{
+  if (error != cudaSuccess) {
+    throw std::runtime_error(
+      std::string("ndt voxel_hash CUDA error: ") + cudaGetErrorString(error));
+  }
+}
+
+template <typename T>
+void uploadVector(const std::vector<T> & host, T *& device)
+{
+  checkCuda(cudaFree(device));
+  device = nullptr;
+  if (host.empty()) {
+    return;
+  }
+  checkCuda(cudaMalloc(&device, sizeof(T) * host.size()));
+  checkCuda(cudaMemcpy(device, host.data(), sizeof(T) * host.size(), cudaMemcpyHostToDevice));
+}
+
+void uploadArray(const float * host, const size_t size, float *& device)
+{
+  checkCuda(cudaFree(device));
+  device = nullptr;
+  if (size == 0) {
+    return;
+  }
+  checkCuda(cudaMalloc(&device, sizeof(float) * size));
+  checkCuda(cudaMemcpy(device, host, sizeof(float) * size, cudaMemcpyHostToDevice));
+}
+
+__global__ void derivativesKernel(
+  const GridView grid, const PoseCoefficients pose, const float * x, const float * y,
+  const float * z, const int num_points, const double gauss_d1, const double gauss_d2,
+  const bool compute_hessian, double * warp_sums)
+{
+  const int i = blockIdx.x * blockDim.x + threadIdx.x;
+  Derivatives derivatives = {};
+  if (i < num_points) {
+    accumulatePoint(
+      grid, pose, x[i], y[i], z[i], gauss_d1, gauss_d2, compute_hessian, derivatives);
+  }
+
+  // reduce each value within the warp, lane 0 writes the sum of its warp
+  double values[NUM_VALUES];
+  values[0] = derivatives.score;
+  for (int k = 0; k < 6; ++k) {
+    values[1 + k] = derivatives.gradient[k];
+  }
+  for (int k = 0; k < 21; ++k) {
+    values[7 + k] = derivatives.hessian[k];
+  }
+  for (int k = 0; k < NUM_VALUES; ++k) {
+    for (int offset = WARP_SIZE / 2; offset > 0; offset /= 2) {
+      values[k] += __shfl_down_sync(0xffffffff, values[k], offset);
+    }
+  }
+  if (threadIdx.x % WARP_SIZE == 0) {
+    double * out = warp_sums + (i / WARP_SIZE) * NUM_VALUES;
+    for (int k = 0; k < NUM_VALUES; ++k) {
+      out[k] = values[k];
+    }
+  }
+}
+}  // namespace
+
+struct DerivativesCuda::Impl
+{
+  GridView grid{};
+  float * mean[3]{nullptr, nullptr, nullptr};
+  float * icov[6]{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+  uint64_t * keys{nullptr};
+  int32_t * slots{nullptr};
+  bool has_target{false};
+
+  float * source[3]{nullptr, nullptr, nullptr};
+  int num_points{0};
+
+  double * warp_sums{nullptr};
+  std::vector<double> host_warp_sums;
+
+  ~Impl()
+  {
+    for (auto * p : mean) {
+      cudaFree(p);
+    }
+    for (auto * p : icov) {
+      cudaFree(p);
+    }
+    for (auto * p : source) {
+      cudaFree(p);
+    }
+    cudaFree(keys);
+    cudaFree(slots);
+    cudaFree(warp_sums);
+  }
+};
+
+DerivativesCuda::DerivativesCuda() : impl_(new Impl) {}
+
+DerivativesCuda::~DerivativesCuda() = default;
+
+void DerivativesCuda::setTarget(const TargetGrid & grid)
+{
+  uploadVector(grid.getMeanX(), impl_->mean[0]);
+  uploadVector(grid.getMeanY(), impl_->mean[1]);
+  uploadVector(grid.getMeanZ(), impl_->mean[2]);
+  for (int i = 0; i < 6; ++i) {
+    uploadVector(grid.getInverseCovariance(i), impl_->icov[i]);
+  }
+  uploadVector(grid.getKeys(), impl_->keys);
+  uploadVector(grid.getSlots(), impl_->slots);
+
+  // same view as TargetGrid::getView(), pointing to device memory
+  GridView & view = impl_->grid;
+  view = grid.getView();
+  view.mean_x = impl_->mean[0];
+  view.mean_y = impl_->mean[1];
+  view.mean_z = impl_->mean[2];
+  for (int i = 0; i < 6; ++i) {
+    view.icov[i] = impl_->icov[i];
+  }
+  view.keys = impl_->keys;
+  view.slots = impl_->slots;
+  impl_->has_target = grid.size() > 0;
+}
+
+void DerivativesCuda::setSource(
+  const float * x, const float * y, const float * z, const size_t num_points)
+{
+  uploadArray(x, num_points, impl_->source[0]);
+  uploadArray(y, num_points, impl_->source[1]);
+  uploadArray(z, num_points, impl_->source[2]);
+  impl_->num_points = static_cast<int>(num_points);
+
+  const int num_blocks = (impl_->num_points + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  const size_t num_warps = static_cast<size_t>(num_blocks) * (BLOCK_SIZE / WARP_SIZE);
+  checkCuda(cudaFree(impl_->warp_sums));
+  impl_->warp_sums = nullptr;
+  if (num_warps > 0) {
+    checkCuda(cudaMalloc(&impl_->warp_sums, sizeof(double) * NUM_VALUES * num_warps));
+  }
+  impl_->host_warp_sums.resize(NUM_VALUES * num_warps);
+}
+
+Derivatives DerivativesCuda::compute(
+  const PoseCoefficients & pose, const double gauss_d1, const double gauss_d2,
+  const bool compute_hessian)
+{
+  Derivatives derivatives = {};
+  if (!impl_->has_target || impl_->num_points == 0) {
+    return derivatives;
+  }
+
+  const int num_blocks = (impl_->num_points + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  derivativesKernel<<<num_blocks, BLOCK_SIZE>>>(
+    impl_->grid, pose, impl_->source[0], impl_->source[1], impl_->source[2], impl_->num_points,
+    gauss_d1, gauss_d2, compute_hessian, impl_->warp_sums);
+  checkCuda(cudaGetLastError());
+  checkCuda(cudaMemcpy(
+    impl_->host_warp_sums.data(), impl_->warp_sums, sizeof(double) * impl_->host_warp_sums.size(),
+    cudaMemcpyDeviceToHost));
+
+  for (size_t w = 0; w < impl_->host_warp_sums.size(); w += NUM_VALUES) {
+    const double * values = impl_->host_warp_sums.data() + w;
+    derivatives.score += values[0];
+    for (int k = 0; k < 6; ++k) {
+      derivatives.gradient[k] += values[1 + k];
+    }
+    for (int k = 0; k < 21; ++k) {
+      derivatives.hessian[k] += values[7 + k];
+    }
+  }
+  return derivatives;
+}
+}  // namespace voxel_hash
+}  // namespace ndt
@@ -0,0 +1,344 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ndt/voxel_hash/solver.hpp"
+
+#include "ndt/voxel_hash/derivatives_cuda.hpp"
+
+#include <Eigen/Geometry>
+#include <Eigen/SVD>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace ndt
+{
+namespace voxel_hash
+{
+namespace
+{
+void setVector(double v[3], const double a, const double b, const double c)
+{
+  v[0] = a;
+  v[1] = b;
+  v[2] = c;
+}
+
+/** \brief Rotation, translation and angle derivatives of p, eq. 6.17, 6.19 and 6.21
+ * [Magnusson 2009], in the order used by pcl::NormalDistributionsTransform. */
+PoseCoefficients computePoseCoefficients(const Eigen::Matrix<double, 6, 1> & p)
+{
+  // Simplified math for near 0 angles
+  auto cosine = [](const double a) { return std::fabs(a) < 10e-5 ? 1.0 : std::cos(a); };
+  auto sine = [](const double a) { return std::fabs(a) < 10e-5 ? 0.0 : std::sin(a); };
+  const double cx = cosine(p(3)), sx = sine(p(3));
+  const double cy = cosine(p(4)), sy = sine(p(4));
+  const double cz = cosine(p(5)), sz = sine(p(5));
+
+  PoseCoefficients pose;
+  // R = Rx(roll) * Ry(pitch) * Rz(yaw)
+  const double rotation[9] = {cy * cz,
+                              -cy * sz,
+                              sy,
+                              cx * sz + sx * sy * cz,
+                              cx * cz - sx * sy * sz,
+                              -sx * cy,
+                              sx * sz - cx * sy * cz,
+                              sx * cz + cx * sy * sz,
+                              cx * cy};
+  std::copy(rotation, rotation + 9, pose.rotation);
+  setVector(pose.translation, p(0), p(1), p(2));
+
+  auto & j = pose.angle.j_ang;
+  setVector(j[0], -sx * sz + cx * sy * cz, -sx * cz - cx * sy * sz, -cx * cy);
+  setVector(j[1], cx * sz + sx * sy * cz, cx * cz - sx * sy * sz, -sx * cy);
+  setVector(j[2], -sy * cz, sy * sz, cy);
+  setVector(j[3], sx * cy * cz, -sx * cy * sz, sx * sy);
+  setVector(j[4], -cx * cy * cz, cx * cy * sz, -cx * sy);
+  setVector(j[5], -cy * sz, -cy * cz, 0);
+  setVector(j[6], cx * cz - sx * sy * sz, -cx * sz - sx * sy * cz, 0);
+  setVector(j[7], sx * cz + cx * sy * sz, cx * sy * cz - sx * sz, 0);
+
+  auto & h = pose.angle.h_ang;
+  setVector(h[0], -cx * sz - sx * sy * cz, -cx * cz + sx * sy * sz, sx * cy);
+  setVector(h[1], -sx * sz + cx * sy * cz, -cx * sy * sz - sx * cz, -cx * cy);
+  setVector(h[2], cx * cy * cz, -cx * cy * sz, cx * sy);
+  setVector(h[3], sx * cy * cz, -sx * cy * sz, sx * sy);
+  setVector(h[4], -sx * cz - cx * sy * sz, sx * sz - cx * sy * cz, 0);
+  setVector(h[5], cx * cz - sx * sy * sz, -sx * sy * cz - cx * sz, 0);
+  setVector(h[6], -cy * cz, cy * sz, sy);
+  setVector(h[7], -sx * sy * cz, sx * sy * sz, sx * cy);
+  setVector(h[8], cx * sy * cz, -cx * sy * sz, -cx * cy);
+  setVector(h[9], sy * sz, sy * cz, 0);
+  setVector(h[10], -sx * cy * sz, -sx * cy * cz, 0);
+  setVector(h[11], cx * cy * sz, cx * cy * cz, 0);
+  setVector(h[12], -cy * cz, cy * sz, 0);
+  setVector(h[13], -cx * sz - sx * sy * cz, -cx * cz + sx * sy * sz, 0);
+  setVector(h[14], -sx * sz + cx * sy * cz, -cx * sy * sz - sx * cz, 0);
+  return pose;
+}
+
+Eigen::Matrix4f toTransformation(const Eigen::Matrix<double, 6, 1> & p)
+{
+  return (Eigen::Translation<float, 3>(
+            static_cast<float>(p(0)), static_cast<float>(p(1)), static_cast<float>(p(2))) *
+          Eigen::AngleAxis<float>(static_cast<float>(p(3)), Eigen::Vector3f::UnitX()) *
+          Eigen::AngleAxis<float>(static_cast<float>(p(4)), Eigen::Vector3f::UnitY()) *
+          Eigen::AngleAxis<float>(static_cast<float>(p(5)), Eigen::Vector3f::UnitZ()))
+    .matrix();
+}
+
+void addDerivatives(const Derivatives & src, Derivatives & dst)
+{
+  dst.score += src.score;
+  for (int i = 0; i < 6; ++i) {
+    dst.gradient[i] += src.gradient[i];
+  }
+  for (int i = 0; i < 21; ++i) {
+    dst.hessian[i] += src.hessian[i];
+  }
+}
+}  // namespace
+
+Solver::Solver() = default;
+Solver::~Solver() = default;
+
+Solver::Solver(const Solver & other) { *this = other; }
+
+Solver & Solver::operator=(const Solver & other)
+{
+  if (this == &other) {
+    return *this;
+  }
+  target_ = other.target_;
+  source_x_ = other.source_x_;
+  source_y_ = other.source_y_;
+  source_z_ = other.source_z_;
+  step_size_ = other.step_size_;
+  transformation_epsilon_ = other.transformation_epsilon_;
+  max_iterations_ = other.max_iterations_;
+  outlier_ratio_ = other.outlier_ratio_;
+  num_threads_ = other.num_threads_;
+  gauss_d1_ = other.gauss_d1_;
+  gauss_d2_ = other.gauss_d2_;
+  final_transformation_ = other.final_transformation_;
+  transformation_array_ = other.transformation_array_;
+  hessian_ = other.hessian_;
+  nr_iterations_ = other.nr_iterations_;
+  trans_probability_ = other.trans_probability_;
+  converged_ = other.converged_;
+  // device buffers are not shared, each copy uploads its own
+  cuda_.reset();
+  setUseGpu(other.getUseGpu());
+  return *this;
+}
+
+void Solver::setTarget(const std::shared_ptr<const TargetGrid> & grid)
+{
+  target_ = grid;
+#ifdef NDT_USE_CUDA
+  if (cuda_ && target_) {
+    cuda_->setTarget(*target_);
+  }
+#endif
+}
+
+void Solver::setSource(const std::vector<Eigen::Vector3f> & points)
+{
+  source_x_.resize(points.size());
+  source_y_.resize(points.size());
+  source_z_.resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    source_x_[i] = points[i].x();
+    source_y_[i] = points[i].y();
+    source_z_[i] = points[i].z();
+  }
+#ifdef NDT_USE_CUDA
+  if (cuda_) {
+    cuda_->setSource(source_x_.data(), source_y_.data(), source_z_.data(), source_x_.size());
+  }
+#endif
+}
+
+bool Solver::setUseGpu(const bool use_gpu)
+{
+  if (!use_gpu) {
+    cuda_.reset();
+    return true;
+  }
+#ifdef NDT_USE_CUDA
+  if (!cuda_) {
+    cuda_ = std::make_shared<DerivativesCuda>();
+    if (target_) {
+      cuda_->setTarget(*target_);
+    }
+    cuda_->setSource(source_x_.data(), source_y_.data(), source_z_.data(), source_x_.size());
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void Solver::updateGaussianParameters()
+{
+  // Initializes the gaussian fitting parameters (eq. 6.8) [Magnusson 2009]
+  const double resolution = target_->getResolution();
+  const double gauss_c1 = 10 * (1 - outlier_ratio_);
+  const double gauss_c2 = outlier_ratio_ / std::pow(resolution, 3);
+  const double gauss_d3 = -std::log(gauss_c2);
+  gauss_d1_ = -std::log(gauss_c1 + gauss_c2) - gauss_d3;
+  gauss_d2_ =
+    -2 * std::log((-std::log(gauss_c1 * std::exp(-0.5) + gauss_c2) - gauss_d3) / gauss_d1_);
+}
+
+Derivatives Solver::computeDerivativesCpu(
+  const PoseCoefficients & pose, const double gauss_d1, const double gauss_d2,
+  const bool compute_hessian) const
+{
+  const GridView grid = target_->getView();
+  const int num_points = static_cast<int>(source_x_.size());
+
+  // one accumulator per thread, summed in a fixed order so that the result does not depend on
+  // the scheduling
+  std::vector<Derivatives> partial_derivatives(num_threads_, Derivatives{});
+#pragma omp parallel for num_threads(num_threads_) schedule(guided, 8)
+  for (int i = 0; i < num_points; ++i) {
+#ifdef _OPENMP
+    Derivatives & derivatives = partial_derivatives[omp_get_thread_num()];
+#else
+    Derivatives & derivatives = partial_derivatives[0];
+#endif
+    accumulatePoint(
+      grid, pose, source_x_[i], source_y_[i], source_z_[i], gauss_d1, gauss_d2, compute_hessian,
+      derivatives);
+  }
+
+  Derivatives derivatives{};
+  for (const auto & partial : partial_derivatives) {
+    addDerivatives(partial, derivatives);
+  }
+  return derivatives;
+}
+
+double Solver::computeDerivatives(
+  const Eigen::Matrix<double, 6, 1> & p, Eigen::Matrix<double, 6, 1> & score_gradient,
+  Eigen::Matrix<double, 6, 6> & hessian, const bool compute_hessian)
+{
+  const PoseCoefficients pose = computePoseCoefficients(p);
+#ifdef NDT_USE_CUDA
+  const Derivatives derivatives =
+    cuda_ ? cuda_->compute(pose, gauss_d1_, gauss_d2_, compute_hessian)
+          : computeDerivativesCpu(pose, gauss_d1_, gauss_d2_, compute_hessian);
+#else
+  const Derivatives derivatives =
+    computeDerivativesCpu(pose, gauss_d1_, gauss_d2_, compute_hessian);
+#endif
+
+  for (int i = 0; i < 6; ++i) {
+    score_gradient(i) = derivatives.gradient[i];
+  }
+  if (compute_hessian) {
+    for (int i = 0; i < 6; ++i) {
+      for (int j = i; j < 6; ++j) {
+        hessian(i, j) = hessian(j, i) = derivatives.hessian[upperTriangleIndex(i, j)];
+      }
+    }
+  }
+  return derivatives.score;
+}
+
+void Solver::align(const Eigen::Matrix4f & guess)
+{
+  nr_iterations_ = 0;
+  converged_ = false;
+  final_transformation_ = guess;
+  transformation_array_.clear();
+  trans_probability_ = 0.0;
+  if (!target_ || target_->size() == 0 || source_x_.empty()) {
+    return;
+  }
+  updateGaussianParameters();
+
+  // Convert initial guess matrix to 6 element transformation vector
+  Eigen::Transform<float, 3, Eigen::Affine, Eigen::ColMajor> eig_transformation;
+  eig_transformation.matrix() = guess;
+  const Eigen::Vector3f init_translation = eig_transformation.translation();
+  const Eigen::Vector3f init_rotation = eig_transformation.rotation().eulerAngles(0, 1, 2);
+  Eigen::Matrix<double, 6, 1> p;
+  p << init_translation(0), init_translation(1), init_translation(2), init_rotation(0),
+    init_rotation(1), init_rotation(2);
+
+  transformation_array_.push_back(final_transformation_);
+
+  Eigen::Matrix<double, 6, 1> score_gradient;
+  Eigen::Matrix<double, 6, 6> hessian;
+  double score = computeDerivatives(p, score_gradient, hessian, true);
+
+  while (!converged_) {
+    // Solve for decent direction using newton method, line 23 in Algorithm 2 [Magnusson 2009]
+    Eigen::JacobiSVD<Eigen::Matrix<double, 6, 6>> sv(
+      hessian, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    // Negative for maximization as opposed to minimization
+    Eigen::Matrix<double, 6, 1> delta_p = sv.solve(-score_gradient);
+
+    const double delta_p_norm = delta_p.norm();
+    if (delta_p_norm == 0 || delta_p_norm != delta_p_norm) {
+      converged_ = delta_p_norm == delta_p_norm;
+      break;
+    }
+    delta_p.normalize();
+
+    // pcl::NormalDistributionsTransform starts its More-Thuente line search with an interval
+    // that is already converged whenever step_min < step_max, so its step is the Newton step
+    // clamped to [transformation_epsilon / 2, step_size]. The same step is taken here, so that
+    // the parameters tuned for the other implementations keep their meaning.
+    const double direction_gradient = score_gradient.dot(delta_p);
+    if (direction_gradient == 0) {
+      converged_ = true;
+      break;
+    }
+    if (direction_gradient < 0) {
+      // Not an ascent direction of the score
+      delta_p = -delta_p;
+    }
+    const double step_length =
+      std::max(std::min(delta_p_norm, step_size_), transformation_epsilon_ / 2);
+
+    p += delta_p * step_length;
+    score = computeDerivatives(p, score_gradient, hessian, true);
+    final_transformation_ = toTransformation(p);
+    transformation_array_.push_back(final_transformation_);
+
+    if (
+      nr_iterations_ > max_iterations_ ||
+      (nr_iterations_ && step_length < transformation_epsilon_)) {
+      converged_ = true;
+    }
+    nr_iterations_++;
+  }
+
+  // The relative differences within each scan registration are accurate but the normalization
+  // constants need to be modified for it to be globally accurate
+  trans_probability_ = score / static_cast<double>(source_x_.size());
+  hessian_ = hessian;
+}
+}  // namespace voxel_hash
+}  // namespace ndt
@@ -0,0 +1,276 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ndt/voxel_hash/target_grid.hpp"
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/LU>
+
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ndt
+{
+namespace voxel_hash
+{
+namespace
+{
+// same value as pcl::VoxelGridCovariance
+constexpr double MIN_COVARIANCE_EIGENVALUE_MULTIPLIER = 0.01;
+
+constexpr char MAGIC[8] = {'N', 'D', 'T', 'V', 'H', 'G', '0', '1'};
+
+/** \brief Start of a saved grid, followed by the voxel arrays and the hash table. */
+struct FileHeader
+{
+  char magic[8];
+  float resolution;
+  int32_t min_points_per_voxel;
+  uint64_t points_fingerprint;
+  uint64_t num_voxels;
+  uint64_t capacity;
+};
+
+template <class T>
+void writeArray(std::ofstream & ofs, const std::vector<T> & array)
+{
+  ofs.write(reinterpret_cast<const char *>(array.data()), sizeof(T) * array.size());
+}
+
+template <class T>
+void readArray(std::ifstream & ifs, std::vector<T> & array, const size_t size)
+{
+  array.resize(size);
+  ifs.read(reinterpret_cast<char *>(array.data()), sizeof(T) * size);
+}
+
+struct VoxelSum
+{
+  Eigen::Vector3d sum{Eigen::Vector3d::Zero()};
+  Eigen::Matrix3d sum_outer{Eigen::Matrix3d::Zero()};
+  int num_points{0};
+};
+}  // namespace
+
+void TargetGrid::build(
+  const std::vector<Eigen::Vector3f> & points, const float resolution,
+  const int min_points_per_voxel)
+{
+  resolution_ = resolution;
+  min_points_per_voxel_ = min_points_per_voxel;
+  const float inverse_resolution = 1.0f / resolution;
+
+  std::unordered_map<uint64_t, VoxelSum> sums;
+  sums.reserve(points.size() / 8);
+  for (const auto & p : points) {
+    if (!std::isfinite(p.x()) || !std::isfinite(p.y()) || !std::isfinite(p.z())) {
+      continue;
+    }
+    const auto ix = static_cast<int64_t>(std::floor(p.x() * inverse_resolution));
+    const auto iy = static_cast<int64_t>(std::floor(p.y() * inverse_resolution));
+    const auto iz = static_cast<int64_t>(std::floor(p.z() * inverse_resolution));
+    auto & voxel = sums[toVoxelKey(ix, iy, iz)];
+    const Eigen::Vector3d pd = p.cast<double>();
+    voxel.sum += pd;
+    voxel.sum_outer += pd * pd.transpose();
+    ++voxel.num_points;
+  }
+
+  mean_x_.clear();
+  mean_y_.clear();
+  mean_z_.clear();
+  for (auto & icov : icov_) {
+    icov.clear();
+  }
+  std::vector<uint64_t> voxel_keys;
+  voxel_keys.reserve(sums.size());
+
+  for (const auto & entry : sums) {
+    const VoxelSum & voxel = entry.second;
+    if (voxel.num_points < min_points_per_voxel) {
+      continue;
+    }
+    // sample covariance as computed by pcl::VoxelGridCovariance
+    const double n = voxel.num_points;
+    const Eigen::Vector3d mean = voxel.sum / n;
+    Eigen::Matrix3d cov = (voxel.sum_outer / n - mean * mean.transpose()) * ((n - 1.0) / n);
+
+    // inflate near-singular covariances, [Magnusson 2009]
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigensolver(cov);
+    Eigen::Vector3d eigen_values = eigensolver.eigenvalues();
+    if (eigen_values(0) < 0 || eigen_values(1) < 0 || eigen_values(2) <= 0) {
+      continue;
+    }
+    const double min_eigen_value = MIN_COVARIANCE_EIGENVALUE_MULTIPLIER * eigen_values(2);
+    if (eigen_values(0) < min_eigen_value) {
+      eigen_values(0) = min_eigen_value;
+      if (eigen_values(1) < min_eigen_value) {
+        eigen_values(1) = min_eigen_value;
+      }
+      const Eigen::Matrix3d & eigen_vectors = eigensolver.eigenvectors();
+      cov = eigen_vectors * eigen_values.asDiagonal() * eigen_vectors.transpose();
+    }
+    const Eigen::Matrix3d icov = cov.inverse();
+    if (!icov.allFinite()) {
+      continue;
+    }
+
+    voxel_keys.push_back(entry.first);
+    mean_x_.push_back(static_cast<float>(mean.x()));
+    mean_y_.push_back(static_cast<float>(mean.y()));
+    mean_z_.push_back(static_cast<float>(mean.z()));
+    icov_[0].push_back(static_cast<float>(icov(0, 0)));
+    icov_[1].push_back(static_cast<float>(icov(0, 1)));
+    icov_[2].push_back(static_cast<float>(icov(0, 2)));
+    icov_[3].push_back(static_cast<float>(icov(1, 1)));
+    icov_[4].push_back(static_cast<float>(icov(1, 2)));
+    icov_[5].push_back(static_cast<float>(icov(2, 2)));
+  }
+
+  // open addressing table with a load factor of at most 0.5
+  size_t capacity = 16;
+  while (capacity < 2 * voxel_keys.size()) {
+    capacity *= 2;
+  }
+  const uint64_t mask = capacity - 1;
+  keys_.assign(capacity, 0);
+  slots_.assign(capacity, -1);
+  for (size_t i = 0; i < voxel_keys.size(); ++i) {
+    uint64_t slot = hashVoxelKey(voxel_keys[i]) & mask;
+    while (slots_[slot] >= 0) {
+      slot = (slot + 1) & mask;
+    }
+    keys_[slot] = voxel_keys[i];
+    slots_[slot] = static_cast<int32_t>(i);
+  }
+}
+
+bool TargetGrid::save(const std::string & path, const uint64_t points_fingerprint) const
+{
+  const std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+      return false;
+    }
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.resolution = resolution_;
+    header.min_points_per_voxel = min_points_per_voxel_;
+    header.points_fingerprint = points_fingerprint;
+    header.num_voxels = mean_x_.size();
+    header.capacity = keys_.size();
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    writeArray(ofs, mean_x_);
+    writeArray(ofs, mean_y_);
+    writeArray(ofs, mean_z_);
+    for (const auto & icov : icov_) {
+      writeArray(ofs, icov);
+    }
+    writeArray(ofs, keys_);
+    writeArray(ofs, slots_);
+    if (!ofs) {
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+bool TargetGrid::load(
+  const std::string & path, const float resolution, const int min_points_per_voxel,
+  const uint64_t points_fingerprint)
+{
+  std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+  if (!ifs) {
+    return false;
+  }
+  const auto file_size = static_cast<uint64_t>(ifs.tellg());
+  ifs.seekg(0);
+
+  FileHeader header;
+  if (!ifs.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    return false;
+  }
+  const uint64_t expected_size =
+    sizeof(FileHeader) + (9 * sizeof(float)) * header.num_voxels +
+    (sizeof(uint64_t) + sizeof(int32_t)) * header.capacity;
+  const bool is_capacity_valid =
+    header.capacity >= 16 && (header.capacity & (header.capacity - 1)) == 0;
+  if (
+    std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.resolution != resolution ||
+    header.min_points_per_voxel != min_points_per_voxel ||
+    header.points_fingerprint != points_fingerprint || !is_capacity_valid ||
+    file_size != expected_size) {
+    return false;
+  }
+
+  TargetGrid grid;
+  grid.resolution_ = header.resolution;
+  grid.min_points_per_voxel_ = header.min_points_per_voxel;
+  readArray(ifs, grid.mean_x_, header.num_voxels);
+  readArray(ifs, grid.mean_y_, header.num_voxels);
+  readArray(ifs, grid.mean_z_, header.num_voxels);
+  for (auto & icov : grid.icov_) {
+    readArray(ifs, icov, header.num_voxels);
+  }
+  readArray(ifs, grid.keys_, header.capacity);
+  readArray(ifs, grid.slots_, header.capacity);
+  if (!ifs) {
+    return false;
+  }
+  *this = std::move(grid);
+  return true;
+}
+
+uint64_t TargetGrid::computeFingerprint(const std::vector<Eigen::Vector3f> & points)
+{
+  // FNV-1a over the coordinates, in the order of the points
+  uint64_t hash = 14695981039346656037ULL;
+  for (const auto & p : points) {
+    for (int i = 0; i < 3; ++i) {
+      uint32_t bits;
+      std::memcpy(&bits, &p[i], sizeof(bits));
+      hash = (hash ^ bits) * 1099511628211ULL;
+    }
+  }
+  return hash ^ points.size();
+}
+
+GridView TargetGrid::getView() const
+{
+  GridView view;
+  view.mean_x = mean_x_.data();
+  view.mean_y = mean_y_.data();
+  view.mean_z = mean_z_.data();
+  for (int i = 0; i < 6; ++i) {
+    view.icov[i] = icov_[i].data();
+  }
+  view.keys = keys_.data();
+  view.slots = slots_.data();
+  view.keys_mask = keys_.empty() ? 0 : keys_.size() - 1;
+  view.inverse_resolution = 1.0f / resolution_;
+  return view;
+}
+}  // namespace voxel_hash
+}  // namespace ndt
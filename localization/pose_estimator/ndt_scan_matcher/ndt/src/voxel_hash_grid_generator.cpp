@@ -0,0 +1,67 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Builds the voxel hash NDT target grid of a pointcloud map offline, so that
+// NormalDistributionsTransformVoxelHash::setTargetGridCachePath() finds it at startup.
+// The PCD files must be given in the order map_loader concatenates them.
+//
+// usage: ndt_voxel_hash_grid_generator <output> <resolution> <pcd> [<pcd> ...]
+
+#include "ndt/voxel_hash/target_grid.hpp"
+
+#include <pcl/io/pcd_io.h>
+#include <pcl/point_types.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char ** argv)
+{
+  if (argc < 4) {
+    std::cerr << "usage: " << argv[0] << " <output> <resolution> <pcd> [<pcd> ...]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string output_path = argv[1];
+  const float resolution = std::stof(argv[2]);
+  if (!(resolution > 0.0f)) {
+    std::cerr << "resolution must be positive" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<Eigen::Vector3f> points;
+  for (int i = 3; i < argc; ++i) {
+    pcl::PointCloud<pcl::PointXYZ> pcd;
+    if (pcl::io::loadPCDFile(argv[i], pcd) == -1) {
+      std::cerr << "failed to load " << argv[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+    points.reserve(points.size() + pcd.points.size());
+    for (const auto & p : pcd.points) {
+      points.emplace_back(p.x, p.y, p.z);
+    }
+  }
+
+  ndt::voxel_hash::TargetGrid grid;
+  grid.build(points, resolution);
+  if (!grid.save(output_path, ndt::voxel_hash::TargetGrid::computeFingerprint(points))) {
+    std::cerr << "failed to write " << output_path << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "wrote " << grid.size() << " voxels of " << points.size() << " points to "
+            << output_path << std::endl;
+  return EXIT_SUCCESS;
+}
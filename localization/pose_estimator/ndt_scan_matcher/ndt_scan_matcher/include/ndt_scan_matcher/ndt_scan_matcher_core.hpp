@@ -18,20 +18,26 @@
 #define FMT_HEADER_ONLY
 
 #include "ndt_scan_matcher/particle.hpp"
+#include "ndt_scan_matcher/pose_covariance.hpp"
+#include "ndt_scan_matcher/source_resolution_controller.hpp"
 
 #include <autoware_localization_srvs/srv/pose_with_covariance_stamped.hpp>
 #include <ndt/omp.hpp>
 #include <ndt/pcl_generic.hpp>
 #include <ndt/pcl_modified.hpp>
+#include <ndt/voxel_hash.hpp>
+#include <pointcloud_map_arena/pointcloud_map_arena.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_debug_msgs/msg/float32_stamped.hpp>
+#include <autoware_map_srvs/srv/get_differential_point_cloud_map.hpp>
 #include <autoware_debug_msgs/msg/int32_stamped.hpp>
 #include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
 #include <geometry_msgs/msg/twist_stamped.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
+#include <std_msgs/msg/string.hpp>
 #include <visualization_msgs/msg/marker_array.hpp>
 
 #include <fmt/format.h>
@@ -43,7 +49,10 @@
 #include <tf2_sensor_msgs/tf2_sensor_msgs.h>
 
 #include <array>
+#include <chrono>
+#include <condition_variable>
 #include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -51,7 +60,7 @@
 #include <thread>
 #include <vector>
 
-enum class NDTImplementType { PCL_GENERIC = 0, PCL_MODIFIED = 1, OMP = 2 };
+enum class NDTImplementType { PCL_GENERIC = 0, PCL_MODIFIED = 1, OMP = 2, VOXEL_HASH = 3 };
 
 template <typename PointSource, typename PointTarget>
 std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> getNDT(
@@ -70,6 +79,10 @@ std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> getN
     ndt_ptr.reset(new NormalDistributionsTransformOMP<PointSource, PointTarget>);
     return ndt_ptr;
   }
+  if (ndt_mode == NDTImplementType::VOXEL_HASH) {
+    ndt_ptr.reset(new NormalDistributionsTransformVoxelHash<PointSource, PointTarget>);
+    return ndt_ptr;
+  }
 
   const std::string s = fmt::format("Unknown NDT type {}", static_cast<int>(ndt_mode));
   throw std::runtime_error(s);
@@ -88,8 +101,28 @@ class NDTScanMatcher : public rclcpp::Node
     int num_threads;
   };
 
+  struct VoxelHashParams
+  {
+    VoxelHashParams() : num_threads(1), use_gpu(false) {}
+    int num_threads;
+    bool use_gpu;
+    std::string target_grid_cache_path;
+  };
+
+  // a scan in base_frame, ready for the alignment
+  struct SensorScan
+  {
+    rclcpp::Time stamp;
+    std::chrono::system_clock::time_point receive_time;
+    boost::shared_ptr<pcl::PointCloud<PointSource>> baselink_points_ptr;
+    // baselink_points_ptr itself unless use_latency_budget
+    boost::shared_ptr<pcl::PointCloud<PointSource>> source_points_ptr;
+    float source_voxel_size;
+  };
+
 public:
   NDTScanMatcher();
+  ~NDTScanMatcher();
 
 private:
   void serviceNDTAlign(
@@ -97,13 +130,36 @@ private:
     autoware_localization_srvs::srv::PoseWithCovarianceStamped::Response::SharedPtr res);
 
   void callbackMapPoints(sensor_msgs::msg::PointCloud2::ConstSharedPtr pointcloud2_msg_ptr);
+  void callbackMapSharedMemory(std_msgs::msg::String::ConstSharedPtr shared_memory_name_msg_ptr);
+  /** \brief Run map_update now, or on the map update thread if use_background_map_update. */
+  void scheduleMapUpdate(std::function<void()> map_update);
+  void updateMap(const boost::shared_ptr<pcl::PointCloud<PointTarget>> & map_points_ptr);
+  void mapUpdateThread();
+  /** \brief Ask pointcloud_map_loader for the tiles around position once it moved by
+   * dynamic_map_loading_update_distance. */
+  void requestDynamicMap(const geometry_msgs::msg::Point & position);
+  void callbackDynamicMap(
+    rclcpp::Client<autoware_map_srvs::srv::GetDifferentialPointCloudMap>::SharedFuture future);
   void callbackSensorPoints(sensor_msgs::msg::PointCloud2::ConstSharedPtr pointcloud2_msg_ptr);
+  /** \brief Transform the scan to base_frame and downsample it, the part of the scan matching
+   * that needs neither the map nor the initial pose. */
+  std::shared_ptr<const SensorScan> preprocessSensorPoints(
+    const sensor_msgs::msg::PointCloud2::ConstSharedPtr & pointcloud2_msg_ptr);
+  void alignSensorScan(const SensorScan & sensor_scan);
+  void alignmentThread();
   void callbackInitialPose(
     geometry_msgs::msg::PoseWithCovarianceStamped::ConstSharedPtr pose_conv_msg_ptr);
 
   geometry_msgs::msg::PoseWithCovarianceStamped alignUsingMonteCarlo(
     const std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> & ndt_ptr,
-    const geometry_msgs::msg::PoseWithCovarianceStamped & initial_pose_with_cov);
+    const geometry_msgs::msg::PoseWithCovarianceStamped & initial_pose_with_cov,
+    std::vector<Particle> & best_particles);
+
+  /** \brief NDT instances used by the initial pose search, cloned from ndt_ptr when its map
+   * changed. */
+  std::vector<std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>>>
+  getInitialPoseSearchNDTs(
+    const std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> & ndt_ptr);
 
   void updateTransforms();
 
@@ -117,6 +173,7 @@ private:
 
   rclcpp::Subscription<geometry_msgs::msg::PoseWithCovarianceStamped>::SharedPtr initial_pose_sub_;
   rclcpp::Subscription<sensor_msgs::msg::PointCloud2>::SharedPtr map_points_sub_;
+  rclcpp::Subscription<std_msgs::msg::String>::SharedPtr map_shared_memory_sub_;
   rclcpp::Subscription<sensor_msgs::msg::PointCloud2>::SharedPtr sensor_points_sub_;
 
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr sensor_aligned_pose_pub_;
@@ -128,6 +185,8 @@ private:
   rclcpp::Publisher<autoware_debug_msgs::msg::Float32Stamped>::SharedPtr exe_time_pub_;
   rclcpp::Publisher<autoware_debug_msgs::msg::Float32Stamped>::SharedPtr transform_probability_pub_;
   rclcpp::Publisher<autoware_debug_msgs::msg::Int32Stamped>::SharedPtr iteration_num_pub_;
+  rclcpp::Publisher<autoware_debug_msgs::msg::Float32Stamped>::SharedPtr source_voxel_size_pub_;
+  rclcpp::Publisher<autoware_debug_msgs::msg::Int32Stamped>::SharedPtr source_points_num_pub_;
   rclcpp::Publisher<autoware_debug_msgs::msg::Float32Stamped>::SharedPtr
     initial_to_result_distance_pub_;
   rclcpp::Publisher<autoware_debug_msgs::msg::Float32Stamped>::SharedPtr
@@ -140,6 +199,8 @@ private:
   rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnostics_pub_;
 
   rclcpp::Service<autoware_localization_srvs::srv::PoseWithCovarianceStamped>::SharedPtr service_;
+  rclcpp::Client<autoware_map_srvs::srv::GetDifferentialPointCloudMap>::SharedPtr
+    pcd_loader_client_;
 
   tf2_ros::Buffer tf2_buffer_;
   tf2_ros::TransformListener tf2_listener_;
@@ -158,9 +219,64 @@ private:
 
   std::deque<geometry_msgs::msg::PoseWithCovarianceStamped::ConstSharedPtr>
     initial_pose_msg_ptr_array_;
+  std::mutex initial_pose_mtx_;
   std::mutex ndt_map_mtx_;
 
   OMPParams omp_params_;
+  VoxelHashParams voxel_hash_params_;
+
+  // initial pose search
+  int initial_estimate_particles_num_;
+  int initial_pose_search_num_threads_;
+  double initial_pose_early_stop_score_;
+  int initial_pose_output_num_;
+  std::vector<std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>>>
+    initial_pose_search_ndt_ptrs_;
+  boost::shared_ptr<const pcl::PointCloud<PointTarget>> initial_pose_search_target_ptr_;
+
+  // read the map from the shared memory of pointcloud_map_loader instead of pointcloud_map
+  bool use_shared_memory_map_;
+
+  // load the map tiles around the vehicle instead of the whole map
+  bool use_dynamic_map_loading_;
+  double dynamic_map_loading_radius_;
+  double dynamic_map_loading_update_distance_;
+  std::map<std::string, boost::shared_ptr<pcl::PointCloud<PointTarget>>> dynamic_map_tiles_;
+  geometry_msgs::msg::Point last_dynamic_map_position_;
+  bool has_dynamic_map_position_;
+  bool is_dynamic_map_request_pending_;
+
+  // background map update
+  bool use_background_map_update_;
+  std::thread map_update_thread_;
+  std::mutex map_update_mtx_;
+  std::condition_variable map_update_cv_;
+  std::function<void()> pending_map_update_;
+  bool is_map_update_thread_stopped_;
+
+  // latency budget of the scan matching
+  bool use_latency_budget_;
+  int latency_budget_core_points_num_;
+  SourceResolutionController source_resolution_controller_;
+  std::mutex source_resolution_mtx_;
+
+  // preprocess the next scan while the alignment thread aligns the current one
+  bool use_pipelined_alignment_;
+  std::thread alignment_thread_;
+  std::mutex alignment_mtx_;
+  std::condition_variable alignment_cv_;
+  std::shared_ptr<const SensorScan> pending_sensor_scan_ptr_;
+  // scans replaced before their alignment, since the last aligned scan and in total
+  size_t dropped_scan_num_;
+  size_t total_dropped_scan_num_;
+  bool is_alignment_thread_stopped_;
+
+  // covariance of the output pose
+  std::array<double, 36> output_pose_covariance_;
+  bool use_hessian_covariance_;
+  double hessian_covariance_scale_;
+  bool scale_covariance_by_transform_probability_;
+  std::vector<Eigen::Vector2d> covariance_sampling_offsets_;
 
   std::thread diagnostic_thread_;
   std::map<std::string, std::string> key_value_stdmap_;
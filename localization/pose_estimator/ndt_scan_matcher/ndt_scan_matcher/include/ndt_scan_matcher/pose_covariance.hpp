@@ -0,0 +1,36 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NDT_SCAN_MATCHER__POSE_COVARIANCE_HPP_
+#define NDT_SCAN_MATCHER__POSE_COVARIANCE_HPP_
+
+#include "ndt_scan_matcher/matrix_type.hpp"
+
+#include <vector>
+
+/** \brief Covariance of the NDT pose, in the order x, y, z, roll, pitch, yaw of the NDT parameters
+ * and of the ROS message, from the Laplace approximation of the score around its maximum, i.e. the
+ * inverse of the negated Hessian. Directions the score does not constrain, e.g. along a tunnel,
+ * get a large variance. Returns false if the Hessian is not negative definite, which is also the
+ * case of the NDT implementations that do not provide it. */
+bool estimateCovarianceFromHessian(const Matrix6d & hessian, Matrix6d * covariance);
+
+/** \brief xy offsets, evenly spaced on a circle of the given radius, of the initial poses the
+ * alignment is restarted from to sample the xy covariance. */
+std::vector<Eigen::Vector2d> createSamplingOffsets(const int num, const double radius);
+
+/** \brief Sample covariance of the xy positions the alignment converged to. */
+Eigen::Matrix2d calcSampleCovariance(const std::vector<Eigen::Vector2d> & positions);
+
+#endif  // NDT_SCAN_MATCHER__POSE_COVARIANCE_HPP_
@@ -0,0 +1,59 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NDT_SCAN_MATCHER__SOURCE_RESOLUTION_CONTROLLER_HPP_
+#define NDT_SCAN_MATCHER__SOURCE_RESOLUTION_CONTROLLER_HPP_
+
+#include <boost/shared_ptr.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstddef>
+
+/** \brief Picks the voxel size of the NDT source points so that the alignment of one scan takes
+ * about target_time_ms. The alignment time is roughly proportional to the number of source points,
+ * which scales with the inverse square of the voxel size for the surface-like lidar scans.
+ */
+class SourceResolutionController
+{
+public:
+  SourceResolutionController(
+    const double target_time_ms = 50.0, const double min_voxel_size = 0.1,
+    const double max_voxel_size = 3.0);
+
+  float getVoxelSize() const { return static_cast<float>(voxel_size_); }
+  double getFilteredAlignTime() const { return filtered_align_time_ms_; }
+
+  /** \brief Update the voxel size from the alignment time of the last scan. */
+  void update(const double align_time_ms);
+
+private:
+  double target_time_ms_;
+  double min_voxel_size_;
+  double max_voxel_size_;
+  double voxel_size_;
+  double filtered_align_time_ms_;
+};
+
+/** \brief Replace the points in each voxel by their centroid. Returns a copy of the input if
+ * voxel_size is not positive. */
+boost::shared_ptr<pcl::PointCloud<pcl::PointXYZ>> downsampleSourcePoints(
+  const pcl::PointCloud<pcl::PointXYZ> & input, const float voxel_size);
+
+/** \brief The num points closest to the origin, i.e. the dense part of a scan in base_link. */
+boost::shared_ptr<pcl::PointCloud<pcl::PointXYZ>> extractNearestPoints(
+  const pcl::PointCloud<pcl::PointXYZ> & input, const size_t num);
+
+#endif  // NDT_SCAN_MATCHER__SOURCE_RESOLUTION_CONTROLLER_HPP_
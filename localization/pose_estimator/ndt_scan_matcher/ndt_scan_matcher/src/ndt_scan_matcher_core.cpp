@@ -28,9 +28,11 @@
 #include <tf2_eigen/tf2_eigen.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <functional>
 #include <iomanip>
+#include <stdexcept>
 #include <thread>
 
 autoware_debug_msgs::msg::Float32Stamped makeFloat32Stamped(
@@ -103,9 +105,25 @@ NDTScanMatcher::NDTScanMatcher()
   map_frame_("map"),
   converged_param_transform_probability_(4.5),
   inversion_vector_threshold_(-0.9),
-  oscillation_threshold_(10)
+  oscillation_threshold_(10),
+  use_shared_memory_map_(false),
+  use_dynamic_map_loading_(false),
+  dynamic_map_loading_radius_(150.0),
+  dynamic_map_loading_update_distance_(20.0),
+  has_dynamic_map_position_(false),
+  is_dynamic_map_request_pending_(false),
+  use_background_map_update_(false),
+  is_map_update_thread_stopped_(false),
+  use_latency_budget_(false),
+  latency_budget_core_points_num_(0),
+  use_pipelined_alignment_(false),
+  dropped_scan_num_(0),
+  total_dropped_scan_num_(0),
+  is_alignment_thread_stopped_(false)
 {
   key_value_stdmap_["state"] = "Initializing";
+  key_value_stdmap_["dropped_scan_num"] = "0";
+  key_value_stdmap_["total_dropped_scan_num"] = "0";
 
   int ndt_implement_type_tmp = this->declare_parameter("ndt_implement_type", 0);
   ndt_implement_type_ = static_cast<NDTImplementType>(ndt_implement_type_tmp);
@@ -135,6 +153,26 @@ NDTScanMatcher::NDTScanMatcher()
     ndt_ptr_ = ndt_omp_ptr;
   }
 
+  if (ndt_implement_type_ == NDTImplementType::VOXEL_HASH) {
+    using T = NormalDistributionsTransformVoxelHash<PointSource, PointTarget>;
+
+    std::shared_ptr<T> ndt_voxel_hash_ptr = std::dynamic_pointer_cast<T>(ndt_ptr_);
+    voxel_hash_params_.num_threads =
+      this->declare_parameter("voxel_hash_num_threads", voxel_hash_params_.num_threads);
+    voxel_hash_params_.num_threads = std::max(voxel_hash_params_.num_threads, 1);
+    ndt_voxel_hash_ptr->setNumThreads(voxel_hash_params_.num_threads);
+
+    voxel_hash_params_.use_gpu =
+      this->declare_parameter("voxel_hash_use_gpu", voxel_hash_params_.use_gpu);
+    if (!ndt_voxel_hash_ptr->setUseGpu(voxel_hash_params_.use_gpu)) {
+      RCLCPP_WARN(get_logger(), "ndt was built without CUDA, voxel_hash_use_gpu is ignored");
+      voxel_hash_params_.use_gpu = false;
+    }
+
+    voxel_hash_params_.target_grid_cache_path = this->declare_parameter(
+      "voxel_hash_target_grid_cache_path", voxel_hash_params_.target_grid_cache_path);
+  }
+
   int points_queue_size = this->declare_parameter("input_sensor_points_queue_size", 0);
   points_queue_size = std::max(points_queue_size, 0);
   RCLCPP_INFO(get_logger(), "points_queue_size: %d", points_queue_size);
@@ -164,12 +202,75 @@ NDTScanMatcher::NDTScanMatcher()
   converged_param_transform_probability_ = this->declare_parameter(
     "converged_param_transform_probability", converged_param_transform_probability_);
 
+  initial_estimate_particles_num_ = this->declare_parameter("initial_estimate_particles_num", 100);
+  initial_pose_search_num_threads_ =
+    std::max(this->declare_parameter("initial_pose_search_num_threads", 1), 1);
+  initial_pose_early_stop_score_ = this->declare_parameter("initial_pose_early_stop_score", 0.0);
+  initial_pose_output_num_ = std::max(this->declare_parameter("initial_pose_output_num", 1), 1);
+
+  use_background_map_update_ =
+    this->declare_parameter("use_background_map_update", use_background_map_update_);
+  if (use_background_map_update_) {
+    map_update_thread_ = std::thread(&NDTScanMatcher::mapUpdateThread, this);
+  }
+
+  use_latency_budget_ = this->declare_parameter("use_latency_budget", use_latency_budget_);
+  const double latency_budget_ms = this->declare_parameter("latency_budget_ms", 50.0);
+  const double source_voxel_size_min = this->declare_parameter("source_voxel_size_min", 0.1);
+  const double source_voxel_size_max = this->declare_parameter("source_voxel_size_max", 3.0);
+  source_resolution_controller_ =
+    SourceResolutionController(latency_budget_ms, source_voxel_size_min, source_voxel_size_max);
+  latency_budget_core_points_num_ = std::max(
+    this->declare_parameter("latency_budget_core_points_num", latency_budget_core_points_num_), 0);
+
+  use_pipelined_alignment_ =
+    this->declare_parameter("use_pipelined_alignment", use_pipelined_alignment_);
+
+  const std::vector<double> output_pose_covariance = this->declare_parameter(
+    "output_pose_covariance",
+    std::vector<double>{
+      0.025, 0.0, 0.0, 0.0, 0.0, 0.0,  // x
+      0.0, 0.025, 0.0, 0.0, 0.0, 0.0,  // y
+      0.0, 0.0, 0.025, 0.0, 0.0, 0.0,  // z
+      0.0, 0.0, 0.0, 0.000625, 0.0, 0.0,  // roll
+      0.0, 0.0, 0.0, 0.0, 0.000625, 0.0,  // pitch
+      0.0, 0.0, 0.0, 0.0, 0.0, 0.000625,  // yaw
+    });
+  if (output_pose_covariance.size() != output_pose_covariance_.size()) {
+    throw std::invalid_argument("output_pose_covariance must have 36 elements");
+  }
+  std::copy(
+    output_pose_covariance.begin(), output_pose_covariance.end(), output_pose_covariance_.begin());
+  use_hessian_covariance_ = this->declare_parameter("use_hessian_covariance", true);
+  hessian_covariance_scale_ = this->declare_parameter("hessian_covariance_scale", 1.0);
+  scale_covariance_by_transform_probability_ =
+    this->declare_parameter("scale_covariance_by_transform_probability", false);
+  covariance_sampling_offsets_ = createSamplingOffsets(
+    this->declare_parameter("covariance_sampling_num", 0),
+    this->declare_parameter("covariance_sampling_radius", 0.5));
+
   initial_pose_sub_ = this->create_subscription<geometry_msgs::msg::PoseWithCovarianceStamped>(
     "ekf_pose_with_covariance", 100,
     std::bind(&NDTScanMatcher::callbackInitialPose, this, std::placeholders::_1));
-  map_points_sub_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
-    "pointcloud_map", rclcpp::QoS{1}.transient_local(),
-    std::bind(&NDTScanMatcher::callbackMapPoints, this, std::placeholders::_1));
+  use_shared_memory_map_ = this->declare_parameter("use_shared_memory_map", use_shared_memory_map_);
+  use_dynamic_map_loading_ =
+    this->declare_parameter("use_dynamic_map_loading", use_dynamic_map_loading_);
+  dynamic_map_loading_radius_ =
+    this->declare_parameter("dynamic_map_loading_radius", dynamic_map_loading_radius_);
+  dynamic_map_loading_update_distance_ = this->declare_parameter(
+    "dynamic_map_loading_update_distance", dynamic_map_loading_update_distance_);
+  if (use_dynamic_map_loading_) {
+    pcd_loader_client_ = this->create_client<autoware_map_srvs::srv::GetDifferentialPointCloudMap>(
+      "pcd_loader_service");
+  } else if (use_shared_memory_map_) {
+    map_shared_memory_sub_ = this->create_subscription<std_msgs::msg::String>(
+      "pointcloud_map_shared_memory", rclcpp::QoS{1}.transient_local(),
+      std::bind(&NDTScanMatcher::callbackMapSharedMemory, this, std::placeholders::_1));
+  } else {
+    map_points_sub_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
+      "pointcloud_map", rclcpp::QoS{1}.transient_local(),
+      std::bind(&NDTScanMatcher::callbackMapPoints, this, std::placeholders::_1));
+  }
   sensor_points_sub_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
     "points_raw", rclcpp::SensorDataQoS().keep_last(points_queue_size),
     std::bind(&NDTScanMatcher::callbackSensorPoints, this, std::placeholders::_1));
@@ -189,6 +290,10 @@ NDTScanMatcher::NDTScanMatcher()
     this->create_publisher<autoware_debug_msgs::msg::Float32Stamped>("transform_probability", 10);
   iteration_num_pub_ =
     this->create_publisher<autoware_debug_msgs::msg::Int32Stamped>("iteration_num", 10);
+  source_voxel_size_pub_ =
+    this->create_publisher<autoware_debug_msgs::msg::Float32Stamped>("source_voxel_size", 10);
+  source_points_num_pub_ =
+    this->create_publisher<autoware_debug_msgs::msg::Int32Stamped>("source_points_num", 10);
   initial_to_result_distance_pub_ =
     this->create_publisher<autoware_debug_msgs::msg::Float32Stamped>(
       "initial_to_result_distance", 10);
@@ -210,10 +315,36 @@ NDTScanMatcher::NDTScanMatcher()
     std::bind(
       &NDTScanMatcher::serviceNDTAlign, this, std::placeholders::_1, std::placeholders::_2));
 
+  // started once the publishers exist
+  if (use_pipelined_alignment_) {
+    alignment_thread_ = std::thread(&NDTScanMatcher::alignmentThread, this);
+  }
+
   diagnostic_thread_ = std::thread(&NDTScanMatcher::timerDiagnostic, this);
   diagnostic_thread_.detach();
 }
 
+NDTScanMatcher::~NDTScanMatcher()
+{
+  {
+    std::lock_guard<std::mutex> lock(map_update_mtx_);
+    is_map_update_thread_stopped_ = true;
+  }
+  map_update_cv_.notify_one();
+  if (map_update_thread_.joinable()) {
+    map_update_thread_.join();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(alignment_mtx_);
+    is_alignment_thread_stopped_ = true;
+  }
+  alignment_cv_.notify_one();
+  if (alignment_thread_.joinable()) {
+    alignment_thread_.join();
+  }
+}
+
 void NDTScanMatcher::timerDiagnostic()
 {
   rclcpp::Rate rate(100);
@@ -247,6 +378,14 @@ void NDTScanMatcher::timerDiagnostic()
       diag_status_msg.level = diagnostic_msgs::msg::DiagnosticStatus::ERROR;
       diag_status_msg.message += "skipping_publish_num exceed limit. ";
     }
+    if (
+      key_value_stdmap_.count("dropped_scan_num") &&
+      std::stoi(key_value_stdmap_["dropped_scan_num"]) > 1) {
+      if (diag_status_msg.level < diagnostic_msgs::msg::DiagnosticStatus::WARN) {
+        diag_status_msg.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+      }
+      diag_status_msg.message += "dropped_scan_num > 1. ";
+    }
     // Ignore local optimal solution
     if (
       key_value_stdmap_.count("is_local_optimal_solution_oscillation") &&
@@ -276,6 +415,11 @@ void NDTScanMatcher::serviceNDTAlign(
   // transform pose_frame to map_frame
   const auto mapTF_initial_pose_msg = transform(req->pose_with_cov, *TF_pose_to_map_ptr);
 
+  // the response comes after this service returns, so a retry aligns against the new tiles
+  if (use_dynamic_map_loading_) {
+    requestDynamicMap(mapTF_initial_pose_msg.pose.pose.position);
+  }
+
   if (ndt_ptr_->getInputTarget() == nullptr) {
     res->success = false;
     res->seq = req->seq;
@@ -294,49 +438,205 @@ void NDTScanMatcher::serviceNDTAlign(
   std::lock_guard<std::mutex> lock(ndt_map_mtx_);
 
   key_value_stdmap_["state"] = "Aligning";
-  res->pose_with_cov = alignUsingMonteCarlo(ndt_ptr_, mapTF_initial_pose_msg);
+  std::vector<Particle> best_particles;
+  res->pose_with_cov = alignUsingMonteCarlo(ndt_ptr_, mapTF_initial_pose_msg, best_particles);
   key_value_stdmap_["state"] = "Sleeping";
   res->success = true;
   res->seq = req->seq;
   res->pose_with_cov.pose.covariance = req->pose_with_cov.pose.covariance;
+
+  for (const auto & particle : best_particles) {
+    auto candidate = res->pose_with_cov;
+    candidate.pose.pose = particle.result_pose;
+    res->pose_with_cov_candidates.push_back(candidate);
+    res->candidate_scores.push_back(particle.score);
+  }
 }
 
 void NDTScanMatcher::callbackInitialPose(
   const geometry_msgs::msg::PoseWithCovarianceStamped::ConstSharedPtr initial_pose_msg_ptr)
 {
-  // if rosbag restart, clear buffer
-  if (!initial_pose_msg_ptr_array_.empty()) {
-    const builtin_interfaces::msg::Time & t_front =
-      initial_pose_msg_ptr_array_.front()->header.stamp;
-    const builtin_interfaces::msg::Time & t_msg = initial_pose_msg_ptr->header.stamp;
-    if (t_front.sec > t_msg.sec || (t_front.sec == t_msg.sec && t_front.nanosec > t_msg.nanosec)) {
-      initial_pose_msg_ptr_array_.clear();
-    }
-  }
-
-  if (initial_pose_msg_ptr->header.frame_id == map_frame_) {
-    initial_pose_msg_ptr_array_.push_back(initial_pose_msg_ptr);
-  } else {
+  geometry_msgs::msg::PoseWithCovarianceStamped::ConstSharedPtr mapTF_initial_pose_msg_ptr =
+    initial_pose_msg_ptr;
+  if (initial_pose_msg_ptr->header.frame_id != map_frame_) {
     // get TF from pose_frame to map_frame
     auto TF_pose_to_map_ptr = std::make_shared<geometry_msgs::msg::TransformStamped>();
     getTransform(map_frame_, initial_pose_msg_ptr->header.frame_id, TF_pose_to_map_ptr);
 
     // transform pose_frame to map_frame
-    auto mapTF_initial_pose_msg_ptr =
-      std::make_shared<geometry_msgs::msg::PoseWithCovarianceStamped>();
-    // mapTF_initial_pose_msg_ptr->header.stamp = initial_pose_msg_ptr->header.stamp;
-    *mapTF_initial_pose_msg_ptr = transform(*initial_pose_msg_ptr, *TF_pose_to_map_ptr);
+    mapTF_initial_pose_msg_ptr = std::make_shared<geometry_msgs::msg::PoseWithCovarianceStamped>(
+      transform(*initial_pose_msg_ptr, *TF_pose_to_map_ptr));
+  }
+
+  {
+    // the alignment thread reads the buffer when use_pipelined_alignment
+    std::lock_guard<std::mutex> lock(initial_pose_mtx_);
+
+    // if rosbag restart, clear buffer
+    if (!initial_pose_msg_ptr_array_.empty()) {
+      const builtin_interfaces::msg::Time & t_front =
+        initial_pose_msg_ptr_array_.front()->header.stamp;
+      const builtin_interfaces::msg::Time & t_msg = initial_pose_msg_ptr->header.stamp;
+      if (
+        t_front.sec > t_msg.sec || (t_front.sec == t_msg.sec && t_front.nanosec > t_msg.nanosec)) {
+        initial_pose_msg_ptr_array_.clear();
+      }
+    }
     initial_pose_msg_ptr_array_.push_back(mapTF_initial_pose_msg_ptr);
   }
+
+  if (use_dynamic_map_loading_) {
+    requestDynamicMap(mapTF_initial_pose_msg_ptr->pose.pose.position);
+  }
 }
 
 void NDTScanMatcher::callbackMapPoints(
   sensor_msgs::msg::PointCloud2::ConstSharedPtr map_points_msg_ptr)
 {
-  const auto trans_epsilon = ndt_ptr_->getTransformationEpsilon();
-  const auto step_size = ndt_ptr_->getStepSize();
-  const auto resolution = ndt_ptr_->getResolution();
-  const auto max_iterations = ndt_ptr_->getMaximumIterations();
+  scheduleMapUpdate([this, map_points_msg_ptr]() {
+    boost::shared_ptr<pcl::PointCloud<PointTarget>> map_points_ptr(
+      new pcl::PointCloud<PointTarget>);
+    pcl::fromROSMsg(*map_points_msg_ptr, *map_points_ptr);
+    updateMap(map_points_ptr);
+  });
+}
+
+void NDTScanMatcher::callbackMapSharedMemory(
+  std_msgs::msg::String::ConstSharedPtr shared_memory_name_msg_ptr)
+{
+  const std::string shared_memory_name = shared_memory_name_msg_ptr->data;
+  scheduleMapUpdate([this, shared_memory_name]() {
+    boost::shared_ptr<pcl::PointCloud<PointTarget>> map_points_ptr(
+      new pcl::PointCloud<PointTarget>);
+    try {
+      // the points are copied straight from the mapping without deserializing a message
+      const pointcloud_map_arena::PointCloudMapArena arena(shared_memory_name);
+      map_points_ptr->points.reserve(arena.getNumPoints());
+      for (size_t i = 0; i < arena.getNumTiles(); ++i) {
+        for (const auto & p : arena.getTilePoints(i)) {
+          map_points_ptr->points.emplace_back(p.x, p.y, p.z);
+        }
+      }
+    } catch (const std::runtime_error & e) {
+      RCLCPP_ERROR(get_logger(), "%s", e.what());
+      return;
+    }
+    map_points_ptr->width = map_points_ptr->points.size();
+    map_points_ptr->height = 1;
+    updateMap(map_points_ptr);
+  });
+}
+
+void NDTScanMatcher::requestDynamicMap(const geometry_msgs::msg::Point & position)
+{
+  if (
+    is_dynamic_map_request_pending_ ||
+    (has_dynamic_map_position_ &&
+     norm(position, last_dynamic_map_position_) < dynamic_map_loading_update_distance_)) {
+    return;
+  }
+  if (!pcd_loader_client_->service_is_ready()) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      this->get_logger(), *this->get_clock(), 1000, "pcd_loader_service is not ready");
+    return;
+  }
+
+  using T = autoware_map_srvs::srv::GetDifferentialPointCloudMap;
+  auto request = std::make_shared<T::Request>();
+  request->position = position;
+  request->radius = dynamic_map_loading_radius_;
+  for (const auto & tile : dynamic_map_tiles_) {
+    request->cached_ids.push_back(tile.first);
+  }
+
+  is_dynamic_map_request_pending_ = true;
+  last_dynamic_map_position_ = position;
+  has_dynamic_map_position_ = true;
+  pcd_loader_client_->async_send_request(
+    request, std::bind(&NDTScanMatcher::callbackDynamicMap, this, std::placeholders::_1));
+}
+
+void NDTScanMatcher::callbackDynamicMap(
+  rclcpp::Client<autoware_map_srvs::srv::GetDifferentialPointCloudMap>::SharedFuture future)
+{
+  is_dynamic_map_request_pending_ = false;
+  const auto response = future.get();
+  if (response->new_ids.empty() && response->ids_to_remove.empty()) {
+    return;
+  }
+
+  // only the new tiles are deserialized, the others are kept from the previous requests
+  for (const auto & id : response->ids_to_remove) {
+    dynamic_map_tiles_.erase(id);
+  }
+  for (size_t i = 0; i < response->new_ids.size(); ++i) {
+    boost::shared_ptr<pcl::PointCloud<PointTarget>> tile_ptr(new pcl::PointCloud<PointTarget>);
+    pcl::fromROSMsg(response->new_pointclouds.at(i), *tile_ptr);
+    dynamic_map_tiles_[response->new_ids.at(i)] = tile_ptr;
+  }
+  RCLCPP_INFO(
+    get_logger(), "dynamic map: %zu tiles added, %zu removed, %zu loaded",
+    response->new_ids.size(), response->ids_to_remove.size(), dynamic_map_tiles_.size());
+
+  const auto tiles = dynamic_map_tiles_;
+  scheduleMapUpdate([this, tiles]() {
+    boost::shared_ptr<pcl::PointCloud<PointTarget>> map_points_ptr(
+      new pcl::PointCloud<PointTarget>);
+    for (const auto & tile : tiles) {
+      *map_points_ptr += *tile.second;
+    }
+    updateMap(map_points_ptr);
+  });
+}
+
+void NDTScanMatcher::scheduleMapUpdate(std::function<void()> map_update)
+{
+  if (!use_background_map_update_) {
+    map_update();
+    return;
+  }
+
+  // only the latest map is built if several arrive during one build
+  {
+    std::lock_guard<std::mutex> lock(map_update_mtx_);
+    pending_map_update_ = std::move(map_update);
+  }
+  map_update_cv_.notify_one();
+}
+
+void NDTScanMatcher::mapUpdateThread()
+{
+  while (true) {
+    std::function<void()> map_update;
+    {
+      std::unique_lock<std::mutex> lock(map_update_mtx_);
+      map_update_cv_.wait(
+        lock, [this] { return is_map_update_thread_stopped_ || pending_map_update_; });
+      if (is_map_update_thread_stopped_) {
+        return;
+      }
+      map_update = std::move(pending_map_update_);
+      pending_map_update_ = nullptr;
+    }
+    map_update();
+  }
+}
+
+void NDTScanMatcher::updateMap(
+  const boost::shared_ptr<pcl::PointCloud<PointTarget>> & map_points_ptr)
+{
+  // The new target is built without holding ndt_map_mtx_, so that scan matching keeps running
+  // on the current target until the swap below.
+  double trans_epsilon, step_size;
+  float resolution;
+  int max_iterations;
+  {
+    std::lock_guard<std::mutex> lock(ndt_map_mtx_);
+    trans_epsilon = ndt_ptr_->getTransformationEpsilon();
+    step_size = ndt_ptr_->getStepSize();
+    resolution = ndt_ptr_->getResolution();
+    max_iterations = ndt_ptr_->getMaximumIterations();
+  }
 
   using NDTBase = NormalDistributionsTransformBase<PointSource, PointTarget>;
   std::shared_ptr<NDTBase> new_ndt_ptr_ = getNDT<PointSource, PointTarget>(ndt_implement_type_);
@@ -344,11 +644,21 @@ void NDTScanMatcher::callbackMapPoints(
   if (ndt_implement_type_ == NDTImplementType::OMP) {
     using T = NormalDistributionsTransformOMP<PointSource, PointTarget>;
 
-    // FIXME(IshitaTakeshi) Not sure if this is safe
-    std::shared_ptr<T> ndt_omp_ptr = std::dynamic_pointer_cast<T>(ndt_ptr_);
+    std::shared_ptr<T> ndt_omp_ptr = std::dynamic_pointer_cast<T>(new_ndt_ptr_);
     ndt_omp_ptr->setNeighborhoodSearchMethod(omp_params_.search_method);
     ndt_omp_ptr->setNumThreads(omp_params_.num_threads);
-    new_ndt_ptr_ = ndt_omp_ptr;
+  }
+
+  if (ndt_implement_type_ == NDTImplementType::VOXEL_HASH) {
+    using T = NormalDistributionsTransformVoxelHash<PointSource, PointTarget>;
+
+    std::shared_ptr<T> ndt_voxel_hash_ptr = std::dynamic_pointer_cast<T>(new_ndt_ptr_);
+    ndt_voxel_hash_ptr->setNumThreads(voxel_hash_params_.num_threads);
+    ndt_voxel_hash_ptr->setUseGpu(voxel_hash_params_.use_gpu);
+    // a partial map would overwrite the cache of the whole one on every update
+    if (!use_dynamic_map_loading_) {
+      ndt_voxel_hash_ptr->setTargetGridCachePath(voxel_hash_params_.target_grid_cache_path);
+    }
   }
 
   new_ndt_ptr_->setTransformationEpsilon(trans_epsilon);
@@ -356,29 +666,71 @@ void NDTScanMatcher::callbackMapPoints(
   new_ndt_ptr_->setResolution(resolution);
   new_ndt_ptr_->setMaximumIterations(max_iterations);
 
-  boost::shared_ptr<pcl::PointCloud<PointTarget>> map_points_ptr(new pcl::PointCloud<PointTarget>);
-  pcl::fromROSMsg(*map_points_msg_ptr, *map_points_ptr);
   new_ndt_ptr_->setInputTarget(map_points_ptr);
-  // create Thread
-  // detach
   auto output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
   new_ndt_ptr_->align(*output_cloud, Eigen::Matrix4f::Identity());
 
   // swap
-  ndt_map_mtx_.lock();
+  std::lock_guard<std::mutex> lock(ndt_map_mtx_);
   ndt_ptr_ = new_ndt_ptr_;
-  ndt_map_mtx_.unlock();
 }
 
 void NDTScanMatcher::callbackSensorPoints(
   sensor_msgs::msg::PointCloud2::ConstSharedPtr sensor_points_sensorTF_msg_ptr)
 {
-  const auto exe_start_time = std::chrono::system_clock::now();
-  // mutex Map
-  std::lock_guard<std::mutex> lock(ndt_map_mtx_);
+  const auto sensor_scan_ptr = preprocessSensorPoints(sensor_points_sensorTF_msg_ptr);
+  if (!use_pipelined_alignment_) {
+    alignSensorScan(*sensor_scan_ptr);
+    return;
+  }
+
+  // only the newest scan waits for the alignment, so that the pose never lags the sensor by more
+  // than one alignment
+  {
+    std::lock_guard<std::mutex> lock(alignment_mtx_);
+    if (pending_sensor_scan_ptr_) {
+      // either of the two is never aligned
+      ++dropped_scan_num_;
+    }
+    if (!pending_sensor_scan_ptr_ || pending_sensor_scan_ptr_->stamp <= sensor_scan_ptr->stamp) {
+      pending_sensor_scan_ptr_ = sensor_scan_ptr;
+    }
+  }
+  alignment_cv_.notify_one();
+}
+
+void NDTScanMatcher::alignmentThread()
+{
+  while (true) {
+    std::shared_ptr<const SensorScan> sensor_scan_ptr;
+    {
+      std::unique_lock<std::mutex> lock(alignment_mtx_);
+      alignment_cv_.wait(
+        lock, [this] { return is_alignment_thread_stopped_ || pending_sensor_scan_ptr_; });
+      if (is_alignment_thread_stopped_) {
+        return;
+      }
+      sensor_scan_ptr = std::move(pending_sensor_scan_ptr_);
+      pending_sensor_scan_ptr_ = nullptr;
+
+      total_dropped_scan_num_ += dropped_scan_num_;
+      key_value_stdmap_["dropped_scan_num"] = std::to_string(dropped_scan_num_);
+      key_value_stdmap_["total_dropped_scan_num"] = std::to_string(total_dropped_scan_num_);
+      dropped_scan_num_ = 0;
+    }
+    // the sensor callback preprocesses the next scan meanwhile
+    alignSensorScan(*sensor_scan_ptr);
+  }
+}
+
+std::shared_ptr<const NDTScanMatcher::SensorScan> NDTScanMatcher::preprocessSensorPoints(
+  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & sensor_points_sensorTF_msg_ptr)
+{
+  auto sensor_scan_ptr = std::make_shared<SensorScan>();
+  sensor_scan_ptr->receive_time = std::chrono::system_clock::now();
+  sensor_scan_ptr->stamp = sensor_points_sensorTF_msg_ptr->header.stamp;
 
   const std::string & sensor_frame = sensor_points_sensorTF_msg_ptr->header.frame_id;
-  const rclcpp::Time sensor_ros_time = sensor_points_sensorTF_msg_ptr->header.stamp;
 
   boost::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_sensorTF_ptr(
     new pcl::PointCloud<PointSource>);
@@ -392,20 +744,50 @@ void NDTScanMatcher::callbackSensorPoints(
     new pcl::PointCloud<PointSource>);
   pcl::transformPointCloud(
     *sensor_points_sensorTF_ptr, *sensor_points_baselinkTF_ptr, base_to_sensor_matrix);
-  ndt_ptr_->setInputSource(sensor_points_baselinkTF_ptr);
 
-  // check
-  if (initial_pose_msg_ptr_array_.size() <= 1) {
-    RCLCPP_WARN_STREAM_THROTTLE(this->get_logger(), *this->get_clock(), 1, "No Pose!");
-    return;
+  // the voxel size chosen from the alignment time of the previous scans
+  float source_voxel_size = 0.0f;
+  if (use_latency_budget_) {
+    std::lock_guard<std::mutex> lock(source_resolution_mtx_);
+    source_voxel_size = source_resolution_controller_.getVoxelSize();
   }
+  sensor_scan_ptr->source_voxel_size = source_voxel_size;
+  sensor_scan_ptr->baselink_points_ptr = sensor_points_baselinkTF_ptr;
+  sensor_scan_ptr->source_points_ptr =
+    use_latency_budget_
+      ? downsampleSourcePoints(*sensor_points_baselinkTF_ptr, source_voxel_size)
+      : sensor_points_baselinkTF_ptr;
+  return sensor_scan_ptr;
+}
+
+void NDTScanMatcher::alignSensorScan(const SensorScan & sensor_scan)
+{
+  const auto exe_start_time = sensor_scan.receive_time;
+  const rclcpp::Time & sensor_ros_time = sensor_scan.stamp;
+  const auto & sensor_points_baselinkTF_ptr = sensor_scan.baselink_points_ptr;
+  const auto & source_points_ptr = sensor_scan.source_points_ptr;
+  const float source_voxel_size = sensor_scan.source_voxel_size;
+
+  // mutex Map
+  std::lock_guard<std::mutex> lock(ndt_map_mtx_);
+
+  ndt_ptr_->setInputSource(source_points_ptr);
+
   // searchNNPose using timestamp
   auto initial_pose_old_msg_ptr = std::make_shared<geometry_msgs::msg::PoseWithCovarianceStamped>();
   auto initial_pose_new_msg_ptr = std::make_shared<geometry_msgs::msg::PoseWithCovarianceStamped>();
-  getNearestTimeStampPose(
-    initial_pose_msg_ptr_array_, sensor_ros_time, initial_pose_old_msg_ptr,
-    initial_pose_new_msg_ptr);
-  popOldPose(initial_pose_msg_ptr_array_, sensor_ros_time);
+  {
+    std::lock_guard<std::mutex> initial_pose_lock(initial_pose_mtx_);
+    // check
+    if (initial_pose_msg_ptr_array_.size() <= 1) {
+      RCLCPP_WARN_STREAM_THROTTLE(this->get_logger(), *this->get_clock(), 1, "No Pose!");
+      return;
+    }
+    getNearestTimeStampPose(
+      initial_pose_msg_ptr_array_, sensor_ros_time, initial_pose_old_msg_ptr,
+      initial_pose_new_msg_ptr);
+    popOldPose(initial_pose_msg_ptr_array_, sensor_ros_time);
+  }
   // TODO(Tier IV): check pose_timestamp - sensor_ros_time
   const auto initial_pose_msg =
     interpolatePose(*initial_pose_old_msg_ptr, *initial_pose_new_msg_ptr, sensor_ros_time);
@@ -424,9 +806,30 @@ void NDTScanMatcher::callbackSensorPoints(
 
   auto output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
   key_value_stdmap_["state"] = "Aligning";
-  ndt_ptr_->align(*output_cloud, initial_pose_matrix);
+  const auto align_start_time = std::chrono::system_clock::now();
+  Eigen::Matrix4f guess_pose_matrix = initial_pose_matrix;
+  const size_t core_points_num = static_cast<size_t>(latency_budget_core_points_num_);
+  if (use_latency_budget_ && 0 < core_points_num && core_points_num < source_points_ptr->size()) {
+    // the dense points around the vehicle converge in a few cheap iterations,
+    // so that the alignment of all the points starts close to the optimum
+    ndt_ptr_->setInputSource(extractNearestPoints(*source_points_ptr, core_points_num));
+    ndt_ptr_->align(*output_cloud, guess_pose_matrix);
+    guess_pose_matrix = ndt_ptr_->getFinalTransformation();
+    ndt_ptr_->setInputSource(source_points_ptr);
+  }
+  ndt_ptr_->align(*output_cloud, guess_pose_matrix);
+  const auto align_end_time = std::chrono::system_clock::now();
   key_value_stdmap_["state"] = "Sleeping";
 
+  const double align_time =
+    std::chrono::duration_cast<std::chrono::microseconds>(align_end_time - align_start_time)
+      .count() /
+    1000.0;
+  if (use_latency_budget_) {
+    std::lock_guard<std::mutex> source_resolution_lock(source_resolution_mtx_);
+    source_resolution_controller_.update(align_time);
+  }
+
   const Eigen::Matrix4f result_pose_matrix = ndt_ptr_->getFinalTransformation();
   Eigen::Affine3d result_pose_affine;
   result_pose_affine.matrix() = result_pose_matrix.cast<double>();
@@ -451,6 +854,8 @@ void NDTScanMatcher::callbackSensorPoints(
 
   const int iteration_num = ndt_ptr_->getFinalNumIteration();
 
+  const Matrix6d hessian = ndt_ptr_->getHessian();
+
   /*****************************************************************************
   The reason the add 2 to the ndt_ptr_->getMaximumIterations() is that there are bugs in
   implementation of ndt.
@@ -492,14 +897,38 @@ void NDTScanMatcher::callbackSensorPoints(
   result_pose_with_cov_msg.header.frame_id = map_frame_;
   result_pose_with_cov_msg.pose.pose = result_pose_msg;
 
-  // TODO(Tier IV): temporary value
+  // output_pose_covariance_ is the floor of the estimated covariance
+  result_pose_with_cov_msg.pose.covariance = output_pose_covariance_;
   Eigen::Map<RowMatrixXd> covariance(&result_pose_with_cov_msg.pose.covariance[0], 6, 6);
-  covariance(0, 0) = 0.025;
-  covariance(1, 1) = 0.025;
-  covariance(2, 2) = 0.025;
-  covariance(3, 3) = 0.000625;
-  covariance(4, 4) = 0.000625;
-  covariance(5, 5) = 0.000625;
+  Matrix6d estimated_covariance = Matrix6d::Zero();
+  if (use_hessian_covariance_ && !estimateCovarianceFromHessian(hessian, &estimated_covariance)) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 10000,
+      "The NDT Hessian is not available or not negative definite, "
+      "publishing output_pose_covariance.");
+  }
+  if (is_converged && !covariance_sampling_offsets_.empty()) {
+    // restart the alignment around the result, the spread of the converged positions shows the
+    // directions the map does not constrain
+    std::vector<Eigen::Vector2d> sampled_positions{
+      result_pose_matrix.block<2, 1>(0, 3).cast<double>()};
+    for (const auto & offset : covariance_sampling_offsets_) {
+      Eigen::Matrix4f sampling_pose_matrix = result_pose_matrix;
+      sampling_pose_matrix.block<2, 1>(0, 3) += offset.cast<float>();
+      ndt_ptr_->align(*output_cloud, sampling_pose_matrix);
+      sampled_positions.push_back(
+        ndt_ptr_->getFinalTransformation().block<2, 1>(0, 3).cast<double>());
+    }
+    estimated_covariance.block<2, 4>(0, 2).setZero();
+    estimated_covariance.block<4, 2>(2, 0).setZero();
+    estimated_covariance.block<2, 2>(0, 0) = calcSampleCovariance(sampled_positions);
+  }
+  double covariance_scale = hessian_covariance_scale_;
+  if (scale_covariance_by_transform_probability_ && transform_probability > 0.0) {
+    covariance_scale *=
+      std::max(1.0, converged_param_transform_probability_ / transform_probability);
+  }
+  covariance += covariance_scale * estimated_covariance;
 
   if (is_converged) {
     ndt_pose_pub_->publish(result_pose_stamped_msg);
@@ -550,6 +979,10 @@ void NDTScanMatcher::callbackSensorPoints(
 
   iteration_num_pub_->publish(makeInt32Stamped(sensor_ros_time, iteration_num));
 
+  const int source_points_num = static_cast<int>(source_points_ptr->size());
+  source_voxel_size_pub_->publish(makeFloat32Stamped(sensor_ros_time, source_voxel_size));
+  source_points_num_pub_->publish(makeInt32Stamped(sensor_ros_time, source_points_num));
+
   const float initial_to_result_distance =
     norm(initial_pose_cov_msg.pose.pose.position, result_pose_with_cov_msg.pose.pose.position);
   initial_to_result_distance_pub_->publish(
@@ -567,6 +1000,10 @@ void NDTScanMatcher::callbackSensorPoints(
 
   key_value_stdmap_["transform_probability"] = std::to_string(transform_probability);
   key_value_stdmap_["iteration_num"] = std::to_string(iteration_num);
+  key_value_stdmap_["exe_time_ms"] = std::to_string(exe_time);
+  key_value_stdmap_["align_time_ms"] = std::to_string(align_time);
+  key_value_stdmap_["source_voxel_size"] = std::to_string(source_voxel_size);
+  key_value_stdmap_["source_points_num"] = std::to_string(source_points_num);
   key_value_stdmap_["skipping_publish_num"] = std::to_string(skipping_publish_num);
   if (is_local_optimal_solution_oscillation) {
     key_value_stdmap_["is_local_optimal_solution_oscillation"] = "1";
@@ -575,9 +1012,45 @@ void NDTScanMatcher::callbackSensorPoints(
   }
 }
 
+std::vector<std::shared_ptr<NormalDistributionsTransformBase<pcl::PointXYZ, pcl::PointXYZ>>>
+NDTScanMatcher::getInitialPoseSearchNDTs(
+  const std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> & ndt_ptr)
+{
+  if (initial_pose_search_num_threads_ <= 1) {
+    return {ndt_ptr};
+  }
+
+  // cloning copies the target voxel grid, which is much cheaper than building it again
+  if (initial_pose_search_target_ptr_ != ndt_ptr->getInputTarget()) {
+    initial_pose_search_ndt_ptrs_.clear();
+    for (int i = 0; i < initial_pose_search_num_threads_; ++i) {
+      auto clone_ptr = ndt_ptr->clone();
+      if (ndt_implement_type_ == NDTImplementType::OMP) {
+        // parallelize over particles instead of over points
+        using T = NormalDistributionsTransformOMP<PointSource, PointTarget>;
+        std::dynamic_pointer_cast<T>(clone_ptr)->setNumThreads(1);
+      }
+      if (ndt_implement_type_ == NDTImplementType::VOXEL_HASH) {
+        using T = NormalDistributionsTransformVoxelHash<PointSource, PointTarget>;
+        std::dynamic_pointer_cast<T>(clone_ptr)->setNumThreads(1);
+      }
+      initial_pose_search_ndt_ptrs_.push_back(clone_ptr);
+    }
+    initial_pose_search_target_ptr_ = ndt_ptr->getInputTarget();
+  }
+
+  const auto sensor_points_ptr =
+    boost::const_pointer_cast<pcl::PointCloud<PointSource>>(ndt_ptr->getInputSource());
+  for (const auto & clone_ptr : initial_pose_search_ndt_ptrs_) {
+    clone_ptr->setInputSource(sensor_points_ptr);
+  }
+  return initial_pose_search_ndt_ptrs_;
+}
+
 geometry_msgs::msg::PoseWithCovarianceStamped NDTScanMatcher::alignUsingMonteCarlo(
   const std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> & ndt_ptr,
-  const geometry_msgs::msg::PoseWithCovarianceStamped & initial_pose_with_cov)
+  const geometry_msgs::msg::PoseWithCovarianceStamped & initial_pose_with_cov,
+  std::vector<Particle> & best_particles)
 {
   if (ndt_ptr->getInputTarget() == nullptr || ndt_ptr->getInputSource() == nullptr) {
     RCLCPP_WARN(get_logger(), "No Map or Sensor PointCloud");
@@ -585,51 +1058,89 @@ geometry_msgs::msg::PoseWithCovarianceStamped NDTScanMatcher::alignUsingMonteCar
   }
 
   // generateParticle
-  const auto initial_poses = createRandomPoseArray(initial_pose_with_cov, 100);
+  const auto initial_poses = createRandomPoseArray(
+    initial_pose_with_cov, static_cast<size_t>(std::max(initial_estimate_particles_num_, 1)));
 
+  // each worker aligns particles with its own NDT instance until all particles are aligned
+  // or one of them beats initial_pose_early_stop_score_
+  const auto ndt_ptrs = getInitialPoseSearchNDTs(ndt_ptr);
   std::vector<Particle> particle_array;
-  auto output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
+  particle_array.reserve(initial_poses.size());
+  std::mutex particle_mtx;
+  std::atomic<size_t> next_particle_index{0};
+  std::atomic<bool> is_early_stopped{false};
+
+  auto align_particles = [&](NormalDistributionsTransformBase<PointSource, PointTarget> & ndt) {
+    pcl::PointCloud<PointSource> output_cloud;
+    while (!is_early_stopped) {
+      const size_t i = next_particle_index++;
+      if (i >= initial_poses.size()) {
+        return;
+      }
+      const auto & initial_pose = initial_poses[i];
 
-  for (unsigned int i = 0; i < initial_poses.size(); i++) {
-    const auto & initial_pose = initial_poses[i];
+      const Eigen::Affine3d initial_pose_affine = fromRosPoseToEigen(initial_pose);
+      const Eigen::Matrix4f initial_pose_matrix = initial_pose_affine.matrix().cast<float>();
 
-    const Eigen::Affine3d initial_pose_affine = fromRosPoseToEigen(initial_pose);
-    const Eigen::Matrix4f initial_pose_matrix = initial_pose_affine.matrix().cast<float>();
+      ndt.align(output_cloud, initial_pose_matrix);
 
-    ndt_ptr->align(*output_cloud, initial_pose_matrix);
+      const Eigen::Matrix4f result_pose_matrix = ndt.getFinalTransformation();
+      Eigen::Affine3d result_pose_affine;
+      result_pose_affine.matrix() = result_pose_matrix.cast<double>();
+      const geometry_msgs::msg::Pose result_pose = tf2::toMsg(result_pose_affine);
 
-    const Eigen::Matrix4f result_pose_matrix = ndt_ptr->getFinalTransformation();
-    Eigen::Affine3d result_pose_affine;
-    result_pose_affine.matrix() = result_pose_matrix.cast<double>();
-    const geometry_msgs::msg::Pose result_pose = tf2::toMsg(result_pose_affine);
+      const auto transform_probability = ndt.getTransformationProbability();
+      const auto num_iteration = ndt.getFinalNumIteration();
 
-    const auto transform_probability = ndt_ptr->getTransformationProbability();
-    const auto num_iteration = ndt_ptr->getFinalNumIteration();
+      Particle particle(initial_pose, result_pose, transform_probability, num_iteration);
+      if (
+        initial_pose_early_stop_score_ > 0.0 && particle.score >= initial_pose_early_stop_score_) {
+        is_early_stopped = true;
+      }
+      const auto marker_array = makeDebugMarkers(
+        this->now(), map_frame_, autoware_utils::createMarkerScale(0.3, 0.1, 0.1), particle, i);
 
-    Particle particle(initial_pose, result_pose, transform_probability, num_iteration);
-    particle_array.push_back(particle);
-    const auto marker_array = makeDebugMarkers(
-      this->now(), map_frame_, autoware_utils::createMarkerScale(0.3, 0.1, 0.1), particle, i);
-    ndt_monte_carlo_initial_pose_marker_pub_->publish(marker_array);
+      std::lock_guard<std::mutex> lock(particle_mtx);
+      particle_array.push_back(particle);
+      ndt_monte_carlo_initial_pose_marker_pub_->publish(marker_array);
+    }
+  };
 
-    auto sensor_points_mapTF_ptr = std::make_shared<pcl::PointCloud<PointSource>>();
-    const auto sensor_points_baselinkTF_ptr = ndt_ptr->getInputSource();
-    pcl::transformPointCloud(
-      *sensor_points_baselinkTF_ptr, *sensor_points_mapTF_ptr, result_pose_matrix);
-    sensor_msgs::msg::PointCloud2 sensor_points_mapTF_msg;
-    pcl::toROSMsg(*sensor_points_mapTF_ptr, sensor_points_mapTF_msg);
-    sensor_points_mapTF_msg.header.stamp = initial_pose_with_cov.header.stamp;
-    sensor_points_mapTF_msg.header.frame_id = map_frame_;
-    sensor_aligned_pose_pub_->publish(sensor_points_mapTF_msg);
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < ndt_ptrs.size(); ++i) {
+    workers.emplace_back(align_particles, std::ref(*ndt_ptrs[i]));
+  }
+  align_particles(*ndt_ptrs.front());
+  for (auto & worker : workers) {
+    worker.join();
+  }
+  if (is_early_stopped) {
+    RCLCPP_INFO(
+      get_logger(), "Initial pose search stopped after %zu of %zu particles",
+      particle_array.size(), initial_poses.size());
   }
 
-  auto best_particle_ptr = std::max_element(
+  std::sort(
     std::begin(particle_array), std::end(particle_array),
-    [](const Particle & lhs, const Particle & rhs) { return lhs.score < rhs.score; });
+    [](const Particle & lhs, const Particle & rhs) { return lhs.score > rhs.score; });
+  const auto & best_particle = particle_array.front();
+  const size_t output_num =
+    std::min(particle_array.size(), static_cast<size_t>(initial_pose_output_num_));
+  best_particles.assign(particle_array.begin(), particle_array.begin() + output_num);
+
+  Eigen::Affine3d best_pose_affine = fromRosPoseToEigen(best_particle.result_pose);
+  auto sensor_points_mapTF_ptr = std::make_shared<pcl::PointCloud<PointSource>>();
+  pcl::transformPointCloud(
+    *ndt_ptr->getInputSource(), *sensor_points_mapTF_ptr, best_pose_affine.matrix().cast<float>());
+  sensor_msgs::msg::PointCloud2 sensor_points_mapTF_msg;
+  pcl::toROSMsg(*sensor_points_mapTF_ptr, sensor_points_mapTF_msg);
+  sensor_points_mapTF_msg.header.stamp = initial_pose_with_cov.header.stamp;
+  sensor_points_mapTF_msg.header.frame_id = map_frame_;
+  sensor_aligned_pose_pub_->publish(sensor_points_mapTF_msg);
 
   geometry_msgs::msg::PoseWithCovarianceStamped result_pose_with_cov_msg;
   result_pose_with_cov_msg.header.frame_id = map_frame_;
-  result_pose_with_cov_msg.pose.pose = best_particle_ptr->result_pose;
+  result_pose_with_cov_msg.pose.pose = best_particle.result_pose;
   // ndt_pose_with_covariance_pub_->publish(result_pose_with_cov_msg);
 
   return result_pose_with_cov_msg;
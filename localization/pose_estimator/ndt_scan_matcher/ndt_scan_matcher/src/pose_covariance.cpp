@@ -0,0 +1,66 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ndt_scan_matcher/pose_covariance.hpp"
+
+#include <eigen3/Eigen/Eigenvalues>
+
+#include <cmath>
+#include <vector>
+
+bool estimateCovarianceFromHessian(const Matrix6d & hessian, Matrix6d * covariance)
+{
+  if (!hessian.allFinite()) {
+    return false;
+  }
+
+  // the information matrix of the pose
+  const Eigen::SelfAdjointEigenSolver<Matrix6d> solver(-hessian);
+  if (solver.info() != Eigen::Success || !(solver.eigenvalues().minCoeff() > 0.0)) {
+    return false;
+  }
+
+  *covariance = solver.eigenvectors() * solver.eigenvalues().cwiseInverse().asDiagonal() *
+                solver.eigenvectors().transpose();
+  return true;
+}
+
+std::vector<Eigen::Vector2d> createSamplingOffsets(const int num, const double radius)
+{
+  std::vector<Eigen::Vector2d> offsets;
+  for (int i = 0; i < num; ++i) {
+    const double angle = 2.0 * M_PI * i / num;
+    offsets.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+  }
+  return offsets;
+}
+
+Eigen::Matrix2d calcSampleCovariance(const std::vector<Eigen::Vector2d> & positions)
+{
+  if (positions.size() < 2) {
+    return Eigen::Matrix2d::Zero();
+  }
+
+  Eigen::Vector2d mean = Eigen::Vector2d::Zero();
+  for (const auto & position : positions) {
+    mean += position;
+  }
+  mean /= static_cast<double>(positions.size());
+
+  Eigen::Matrix2d covariance = Eigen::Matrix2d::Zero();
+  for (const auto & position : positions) {
+    covariance += (position - mean) * (position - mean).transpose();
+  }
+  return covariance / static_cast<double>(positions.size() - 1);
+}
@@ -0,0 +1,141 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ndt_scan_matcher/source_resolution_controller.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+// weight of the latest alignment time in the filtered time
+constexpr double ALIGN_TIME_FILTER_GAIN = 0.5;
+// keep the voxel size while the filtered time is in [LOWER, 1] * target
+constexpr double DEAD_BAND_LOWER_RATIO = 0.8;
+// limit the voxel size change per scan
+constexpr double MAX_SCALE_PER_UPDATE = 1.25;
+
+struct CentroidSum
+{
+  double x{0.0};
+  double y{0.0};
+  double z{0.0};
+  int num{0};
+};
+
+uint64_t toVoxelKey(const int64_t ix, const int64_t iy, const int64_t iz)
+{
+  constexpr int64_t mask = (1 << 21) - 1;
+  return (static_cast<uint64_t>(ix & mask) << 42) | (static_cast<uint64_t>(iy & mask) << 21) |
+         static_cast<uint64_t>(iz & mask);
+}
+}  // namespace
+
+SourceResolutionController::SourceResolutionController(
+  const double target_time_ms, const double min_voxel_size, const double max_voxel_size)
+: target_time_ms_(std::max(target_time_ms, 1e-3)),
+  min_voxel_size_(std::max(min_voxel_size, 1e-3)),
+  max_voxel_size_(std::max(max_voxel_size, min_voxel_size_)),
+  voxel_size_(min_voxel_size_),
+  filtered_align_time_ms_(-1.0)
+{
+}
+
+void SourceResolutionController::update(const double align_time_ms)
+{
+  if (filtered_align_time_ms_ < 0.0) {
+    filtered_align_time_ms_ = align_time_ms;
+  } else {
+    filtered_align_time_ms_ = ALIGN_TIME_FILTER_GAIN * align_time_ms +
+                              (1.0 - ALIGN_TIME_FILTER_GAIN) * filtered_align_time_ms_;
+  }
+
+  const double ratio = filtered_align_time_ms_ / target_time_ms_;
+  if (DEAD_BAND_LOWER_RATIO <= ratio && ratio <= 1.0) {
+    return;
+  }
+  const double scale =
+    std::min(std::max(std::sqrt(ratio), 1.0 / MAX_SCALE_PER_UPDATE), MAX_SCALE_PER_UPDATE);
+  voxel_size_ = std::min(std::max(voxel_size_ * scale, min_voxel_size_), max_voxel_size_);
+}
+
+boost::shared_ptr<pcl::PointCloud<pcl::PointXYZ>> downsampleSourcePoints(
+  const pcl::PointCloud<pcl::PointXYZ> & input, const float voxel_size)
+{
+  boost::shared_ptr<pcl::PointCloud<pcl::PointXYZ>> output(new pcl::PointCloud<pcl::PointXYZ>);
+  if (voxel_size <= 0.0f) {
+    *output = input;
+    return output;
+  }
+
+  // hashed instead of pcl::VoxelGrid, whose dense index overflows for fine voxels
+  const float inverse_voxel_size = 1.0f / voxel_size;
+  std::unordered_map<uint64_t, size_t> voxel_indices;
+  std::vector<CentroidSum> sums;
+  voxel_indices.reserve(input.size());
+  for (const auto & p : input.points) {
+    if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+      continue;
+    }
+    const uint64_t key = toVoxelKey(
+      static_cast<int64_t>(std::floor(p.x * inverse_voxel_size)),
+      static_cast<int64_t>(std::floor(p.y * inverse_voxel_size)),
+      static_cast<int64_t>(std::floor(p.z * inverse_voxel_size)));
+    const auto result = voxel_indices.emplace(key, sums.size());
+    if (result.second) {
+      sums.emplace_back();
+    }
+    CentroidSum & sum = sums[result.first->second];
+    sum.x += p.x;
+    sum.y += p.y;
+    sum.z += p.z;
+    ++sum.num;
+  }
+
+  output->points.reserve(sums.size());
+  for (const auto & sum : sums) {
+    output->points.emplace_back(
+      static_cast<float>(sum.x / sum.num), static_cast<float>(sum.y / sum.num),
+      static_cast<float>(sum.z / sum.num));
+  }
+  output->width = output->points.size();
+  output->height = 1;
+  output->is_dense = true;
+  output->header = input.header;
+  return output;
+}
+
+boost::shared_ptr<pcl::PointCloud<pcl::PointXYZ>> extractNearestPoints(
+  const pcl::PointCloud<pcl::PointXYZ> & input, const size_t num)
+{
+  boost::shared_ptr<pcl::PointCloud<pcl::PointXYZ>> output(
+    new pcl::PointCloud<pcl::PointXYZ>(input));
+  if (num < output->points.size()) {
+    const auto squared_range = [](const pcl::PointXYZ & p) {
+      return p.x * p.x + p.y * p.y + p.z * p.z;
+    };
+    std::nth_element(
+      output->points.begin(), output->points.begin() + num, output->points.end(),
+      [&squared_range](const pcl::PointXYZ & a, const pcl::PointXYZ & b) {
+        return squared_range(a) < squared_range(b);
+      });
+    output->points.resize(num);
+  }
+  output->width = output->points.size();
+  output->height = 1;
+  return output;
+}
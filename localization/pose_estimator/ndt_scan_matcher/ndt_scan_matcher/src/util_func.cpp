@@ -123,19 +123,23 @@ void getNearestTimeStampPose(
   geometry_msgs::msg::PoseWithCovarianceStamped::SharedPtr & output_old_pose_cov_msg_ptr,
   geometry_msgs::msg::PoseWithCovarianceStamped::SharedPtr & output_new_pose_cov_msg_ptr)
 {
-  for (const auto & pose_cov_msg_ptr : pose_cov_msg_ptr_array) {
-    output_new_pose_cov_msg_ptr =
-      std::const_pointer_cast<geometry_msgs::msg::PoseWithCovarianceStamped>(pose_cov_msg_ptr);
-    const rclcpp::Time pose_time_stamp = output_new_pose_cov_msg_ptr->header.stamp;
-    if (pose_time_stamp > time_stamp) {
-      // TODO(Tier IV): refactor
-      if (pose_time_stamp.seconds() == 0.0) {
-        output_old_pose_cov_msg_ptr = output_new_pose_cov_msg_ptr;
-      }
-      break;
-    }
-    output_old_pose_cov_msg_ptr = output_new_pose_cov_msg_ptr;
+  if (pose_cov_msg_ptr_array.empty()) {
+    return;
   }
+
+  // the poses are sorted by stamp, the first one after time_stamp bounds it from above
+  const auto new_itr = std::upper_bound(
+    pose_cov_msg_ptr_array.begin(), pose_cov_msg_ptr_array.end(), time_stamp,
+    [](const rclcpp::Time & t, const auto & pose_cov_msg_ptr) {
+      return t < rclcpp::Time(pose_cov_msg_ptr->header.stamp);
+    });
+  const auto old_itr = new_itr == pose_cov_msg_ptr_array.begin() ? new_itr : std::prev(new_itr);
+
+  output_old_pose_cov_msg_ptr =
+    std::const_pointer_cast<geometry_msgs::msg::PoseWithCovarianceStamped>(*old_itr);
+  output_new_pose_cov_msg_ptr =
+    std::const_pointer_cast<geometry_msgs::msg::PoseWithCovarianceStamped>(
+      new_itr == pose_cov_msg_ptr_array.end() ? pose_cov_msg_ptr_array.back() : *new_itr);
 }
 
 geometry_msgs::msg::PoseStamped interpolatePose(
@@ -150,30 +154,24 @@ geometry_msgs::msg::PoseStamped interpolatePose(
     return geometry_msgs::msg::PoseStamped();
   }
 
-  const auto twist = calcTwist(pose_a, pose_b);
-  const double dt = (time_stamp - pose_a_time_stamp).seconds();
-
-  const auto pose_a_rpy = getRPY(pose_a);
-
-  geometry_msgs::msg::Vector3 xyz;
-  geometry_msgs::msg::Vector3 rpy;
-  xyz.x = pose_a.pose.position.x + twist.linear.x * dt;
-  xyz.y = pose_a.pose.position.y + twist.linear.y * dt;
-  xyz.z = pose_a.pose.position.z + twist.linear.z * dt;
-  rpy.x = pose_a_rpy.x + twist.angular.x * dt;
-  rpy.y = pose_a_rpy.y + twist.angular.y * dt;
-  rpy.z = pose_a_rpy.z + twist.angular.z * dt;
+  const double dt_ab = (pose_b_time_stamp - pose_a_time_stamp).seconds();
+  const double ratio = dt_ab == 0.0 ? 0.0 : (time_stamp - pose_a_time_stamp).seconds() / dt_ab;
 
-  tf2::Quaternion tf_quaternion;
-  tf_quaternion.setRPY(rpy.x, rpy.y, rpy.z);
+  // interpolating the orientation on the sphere keeps it consistent across the yaw wrap-around
+  tf2::Quaternion quaternion_a, quaternion_b;
+  tf2::fromMsg(pose_a.pose.orientation, quaternion_a);
+  tf2::fromMsg(pose_b.pose.orientation, quaternion_b);
 
   geometry_msgs::msg::PoseStamped pose;
   pose.header = pose_a.header;
   pose.header.stamp = time_stamp;
-  pose.pose.position.x = xyz.x;
-  pose.pose.position.y = xyz.y;
-  pose.pose.position.z = xyz.z;
-  pose.pose.orientation = tf2::toMsg(tf_quaternion);
+  pose.pose.position.x =
+    pose_a.pose.position.x + (pose_b.pose.position.x - pose_a.pose.position.x) * ratio;
+  pose.pose.position.y =
+    pose_a.pose.position.y + (pose_b.pose.position.y - pose_a.pose.position.y) * ratio;
+  pose.pose.position.z =
+    pose_a.pose.position.z + (pose_b.pose.position.z - pose_a.pose.position.z) * ratio;
+  pose.pose.orientation = tf2::toMsg(quaternion_a.slerp(quaternion_b, ratio).normalized());
   return pose;
 }
 
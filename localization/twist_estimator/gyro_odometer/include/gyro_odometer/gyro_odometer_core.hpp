@@ -20,6 +20,7 @@
 #include <geometry_msgs/msg/twist_stamped.hpp>
 #include <geometry_msgs/msg/twist_with_covariance_stamped.hpp>
 #include <sensor_msgs/msg/imu.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
 
 #include <tf2/transform_datatypes.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
@@ -31,7 +32,7 @@
 class GyroOdometer : public rclcpp::Node
 {
 public:
-  GyroOdometer();
+  explicit GyroOdometer(const rclcpp::NodeOptions & node_options);
   ~GyroOdometer();
 
 private:
@@ -40,6 +41,9 @@ private:
   void callbackTwistWithCovariance(
     const geometry_msgs::msg::TwistWithCovarianceStamped::ConstSharedPtr twist_with_cov_msg_ptr);
   void callbackImu(const sensor_msgs::msg::Imu::ConstSharedPtr imu_msg_ptr);
+  // Looks up the transform only until it succeeds once after the last /tf_static update
+  geometry_msgs::msg::TransformStamped::ConstSharedPtr getStaticTransform(
+    const std::string & target_frame, const std::string & source_frame);
   bool getTransform(
     const std::string & target_frame, const std::string & source_frame,
     const geometry_msgs::msg::TransformStamped::SharedPtr transform_stamped_ptr);
@@ -56,6 +60,9 @@ private:
 
   tf2_ros::Buffer tf_buffer_;
   tf2_ros::TransformListener tf_listener_;
+  rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr tf_static_sub_;
+  rclcpp::Time tf_static_update_time_;
+  geometry_msgs::msg::TransformStamped::ConstSharedPtr tf_base2imu_ptr_;
 
   std::string output_frame_;
   geometry_msgs::msg::TwistWithCovarianceStamped::ConstSharedPtr twist_with_cov_msg_ptr_;
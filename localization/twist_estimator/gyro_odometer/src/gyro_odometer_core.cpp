@@ -15,13 +15,14 @@
 #include "gyro_odometer/gyro_odometer_core.hpp"
 
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
+#include <tf2_ros/qos.hpp>
 
 #include <cmath>
 #include <memory>
 #include <string>
 
-GyroOdometer::GyroOdometer()
-: Node("gyro_odometer"),
+GyroOdometer::GyroOdometer(const rclcpp::NodeOptions & node_options)
+: Node("gyro_odometer", node_options),
   tf_buffer_(this->get_clock()),
   tf_listener_(tf_buffer_),
   output_frame_(declare_parameter("base_link", "base_link"))
@@ -45,6 +46,15 @@ GyroOdometer::GyroOdometer()
   twist_with_covariance_pub_ = create_publisher<geometry_msgs::msg::TwistWithCovarianceStamped>(
     "twist_with_covariance", rclcpp::QoS{10});
 
+  // The static transforms can be updated while running, e.g. by calibration tools
+  tf_static_update_time_ = rclcpp::Time(0, 0, get_clock()->get_clock_type());
+  tf_static_sub_ = create_subscription<tf2_msgs::msg::TFMessage>(
+    "/tf_static", tf2_ros::StaticListenerQoS(),
+    [this](const tf2_msgs::msg::TFMessage::ConstSharedPtr) {
+      tf_base2imu_ptr_ = nullptr;
+      tf_static_update_time_ = this->now();
+    });
+
   // TODO(YamatoAndo) createTimer
 }
 
@@ -94,9 +104,8 @@ void GyroOdometer::callbackImu(const sensor_msgs::msg::Imu::ConstSharedPtr imu_m
     return;
   }
 
-  geometry_msgs::msg::TransformStamped::SharedPtr tf_base2imu_ptr =
-    std::make_shared<geometry_msgs::msg::TransformStamped>();
-  getTransform(output_frame_, imu_msg_ptr->header.frame_id, tf_base2imu_ptr);
+  const geometry_msgs::msg::TransformStamped::ConstSharedPtr tf_base2imu_ptr =
+    getStaticTransform(output_frame_, imu_msg_ptr->header.frame_id);
 
   geometry_msgs::msg::Vector3Stamped angular_velocity;
   angular_velocity.header = imu_msg_ptr->header;
@@ -142,6 +151,26 @@ void GyroOdometer::callbackImu(const sensor_msgs::msg::Imu::ConstSharedPtr imu_m
   twist_with_covariance_pub_->publish(twist_with_covariance);
 }
 
+geometry_msgs::msg::TransformStamped::ConstSharedPtr GyroOdometer::getStaticTransform(
+  const std::string & target_frame, const std::string & source_frame)
+{
+  if (
+    tf_base2imu_ptr_ && tf_base2imu_ptr_->header.frame_id == target_frame &&
+    tf_base2imu_ptr_->child_frame_id == source_frame) {
+    return tf_base2imu_ptr_;
+  }
+
+  const auto transform_stamped_ptr = std::make_shared<geometry_msgs::msg::TransformStamped>();
+  const bool is_succeeded = getTransform(target_frame, source_frame, transform_stamped_ptr);
+
+  // The listener may not have applied the last /tf_static to the buffer yet right after it
+  constexpr double tf_static_settle_time = 1.0;
+  if (is_succeeded && (this->now() - tf_static_update_time_).seconds() > tf_static_settle_time) {
+    tf_base2imu_ptr_ = transform_stamped_ptr;
+  }
+  return transform_stamped_ptr;
+}
+
 bool GyroOdometer::getTransform(
   const std::string & target_frame, const std::string & source_frame,
   const geometry_msgs::msg::TransformStamped::SharedPtr transform_stamped_ptr)
@@ -182,3 +211,6 @@ bool GyroOdometer::getTransform(
   }
   return true;
 }
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(GyroOdometer)
@@ -0,0 +1,119 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the lanelet queries of the planning modules on a synthetic map of straight road lanes,
+// scanning the lanelet layer and with LaneletQueryIndex.
+
+#include "lanelet2_extension/utility/query.hpp"
+
+#include <autoware_replay_benchmark/micro_benchmark.hpp>
+
+#include <lanelet2_core/utility/Utilities.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr double LANE_WIDTH = 3.5;
+constexpr double SEGMENT_LENGTH = 10.0;
+
+lanelet::LaneletMapPtr createRoadMap(const size_t num_lanes, const size_t num_segments)
+{
+  using lanelet::utils::getId;
+
+  // bounds are shared by the neighboring lanes, as in a real map
+  std::vector<std::vector<lanelet::LineString3d>> bounds(num_lanes + 1);
+  for (size_t j = 0; j <= num_lanes; ++j) {
+    lanelet::Point3d prev(getId(), 0.0, j * LANE_WIDTH, 0.0);
+    for (size_t i = 0; i < num_segments; ++i) {
+      const lanelet::Point3d next(getId(), (i + 1) * SEGMENT_LENGTH, j * LANE_WIDTH, 0.0);
+      bounds.at(j).push_back(lanelet::LineString3d(getId(), {prev, next}));  // NOLINT
+      prev = next;
+    }
+  }
+
+  const auto map = std::make_shared<lanelet::LaneletMap>();
+  for (size_t j = 0; j < num_lanes; ++j) {
+    for (size_t i = 0; i < num_segments; ++i) {
+      lanelet::Lanelet lanelet(getId(), bounds.at(j + 1).at(i), bounds.at(j).at(i));
+      lanelet.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Road;
+      map->add(lanelet);
+    }
+  }
+  return map;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  using autoware_replay_benchmark::doNotOptimize;
+  namespace query = lanelet::utils::query;
+  autoware_replay_benchmark::MicroBenchmark benchmark("lanelet2_extension", argc, argv);
+
+  const size_t num_lanes = 20;
+  const size_t num_segments = 100;
+  const lanelet::LaneletMapConstPtr map = createRoadMap(num_lanes, num_segments);
+  const std::string suffix = "/lanelets=" + std::to_string(num_lanes * num_segments);
+
+  std::vector<geometry_msgs::msg::Pose> poses(20);
+  for (size_t i = 0; i < poses.size(); ++i) {
+    poses.at(i).position.x = (i + 0.5) * num_segments * SEGMENT_LENGTH / poses.size();
+    poses.at(i).position.y = (i % num_lanes + 0.4) * LANE_WIDTH;
+  }
+
+  benchmark.run("LaneletQueryIndex/construct" + suffix, [&]() {
+    doNotOptimize(query::LaneletQueryIndex(map));
+  });
+  const query::LaneletQueryIndex index(map);
+
+  benchmark.run("roadLanelets/laneletLayer" + suffix, [&]() {
+    doNotOptimize(query::roadLanelets(query::laneletLayer(map)));
+  });
+  benchmark.run("roadLanelets/index" + suffix, [&]() {
+    doNotOptimize(query::roadLanelets(index).size());
+  });
+
+  const auto road_lanelets = query::roadLanelets(query::laneletLayer(map));
+  lanelet::ConstLanelet closest_lanelet;
+  benchmark.run("getClosestLanelet/lanelets" + suffix, [&]() {
+    for (const auto & pose : poses) {
+      doNotOptimize(query::getClosestLanelet(road_lanelets, pose, &closest_lanelet));
+    }
+  });
+  benchmark.run("getClosestLanelet/index" + suffix, [&]() {
+    for (const auto & pose : poses) {
+      doNotOptimize(query::getClosestLanelet(
+        index, pose, &closest_lanelet, lanelet::AttributeValueString::Road));
+    }
+  });
+
+  for (const double range : {10.0, 50.0}) {
+    const std::string range_suffix = suffix + "/range=" + std::to_string(static_cast<int>(range));
+    benchmark.run("getLaneletsWithinRange/lanelets" + range_suffix, [&]() {
+      for (const auto & pose : poses) {
+        doNotOptimize(query::getLaneletsWithinRange(road_lanelets, pose.position, range));
+      }
+    });
+    benchmark.run("getLaneletsWithinRange/index" + range_suffix, [&]() {
+      for (const auto & pose : poses) {
+        doNotOptimize(query::getLaneletsWithinRange(
+          index, pose.position, range, lanelet::AttributeValueString::Road));
+      }
+    });
+  }
+
+  return benchmark.finish();
+}
@@ -0,0 +1,74 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LANELET2_EXTENSION__IO__BINARY_MAP_CACHE_HPP_
+#define LANELET2_EXTENSION__IO__BINARY_MAP_CACHE_HPP_
+
+#include <autoware_lanelet2_msgs/msg/map_bin.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <string>
+
+namespace lanelet
+{
+namespace io_handlers
+{
+/**
+ * Binary cache of a projected Lanelet2 map with its overwritten centerlines, so that the OSM file
+ * is only parsed and projected once. The payload is the serialized map in the same format as
+ * the data of autoware_lanelet2_msgs::msg::MapBin, so it can be published without converting
+ * it. A cache is only valid for the OSM file, centerline resolution and boost archive version
+ * it was written with.
+ */
+class BinaryMapCache
+{
+public:
+  /**
+   * [write writes the data and versions of msg to cache_path. The file is written next to
+   * cache_path and renamed into place, so that a concurrent read never sees a partial file]
+   * @param cache_path             [path of the cache file]
+   * @param source_path            [path of the OSM file the map was parsed from]
+   * @param center_line_resolution [resolution of the overwritten centerlines]
+   * @param msg                    [map converted by toBinMsg]
+   * @return                       [false if the cache could not be written]
+   */
+  static bool write(
+    const std::string & cache_path, const std::string & source_path,
+    const double center_line_resolution, const autoware_lanelet2_msgs::msg::MapBin & msg);
+
+  /**
+   * [read fills the data and versions of msg from cache_path]
+   * @return [false if the cache is missing, invalid, or was written for another OSM file,
+   * another modification of it or another centerline resolution]
+   */
+  static bool read(
+    const std::string & cache_path, const std::string & source_path,
+    const double center_line_resolution, autoware_lanelet2_msgs::msg::MapBin * msg);
+
+  /**
+   * [load reads the cache and deserializes the map]
+   * @return [the map, or nullptr if the cache is not valid for source_path]
+   */
+  static LaneletMapPtr load(
+    const std::string & cache_path, const std::string & source_path,
+    const double center_line_resolution);
+
+  static constexpr const char * extension() { return ".ll2cache"; }
+};
+
+}  // namespace io_handlers
+}  // namespace lanelet
+
+#endif  // LANELET2_EXTENSION__IO__BINARY_MAP_CACHE_HPP_
@@ -24,12 +24,19 @@
 #include <geometry_msgs/msg/point.hpp>
 #include <geometry_msgs/msg/pose.hpp>
 
+#include <boost/geometry/index/rtree.hpp>
+
 #include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/geometry/BoundingBox.h>
 #include <lanelet2_core/primitives/Lanelet.h>
 #include <lanelet2_routing/RoutingGraph.h>
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace lanelet
@@ -47,12 +54,70 @@ namespace utils
 {
 namespace query
 {
+/**
+ * [LaneletQueryIndex holds the lanelets of a map grouped by subtype together with R-trees over
+ * their 2D bounding boxes. Build it once per map and pass it to the overloads below instead of
+ * filtering and scanning the lanelet layer on every query.]
+ */
+class LaneletQueryIndex
+{
+public:
+  explicit LaneletQueryIndex(const lanelet::LaneletMapConstPtr & ll_map);
+
+  /**
+   * [lanelets returns the lanelets of the map]
+   * @param  subtype [subtype of lanelets to be retrieved, or empty for all lanelets]
+   * @return         [lanelets with given subtype in the order of the lanelet layer]
+   */
+  const lanelet::ConstLanelets & lanelets(const std::string & subtype = "") const;
+
+  /**
+   * [getLaneletsWithinRange retrieves lanelets whose polygon is within range from search_point]
+   * @param  search_point [search point]
+   * @param  range        [distance from search_point]
+   * @param  subtype      [subtype of lanelets to be retrieved, or empty for all lanelets]
+   * @return              [lanelets within range in the order of the lanelet layer]
+   */
+  lanelet::ConstLanelets getLaneletsWithinRange(
+    const lanelet::BasicPoint2d & search_point, const double range,
+    const std::string & subtype = "") const;
+
+  /**
+   * [getClosestLanelet retrieves the lanelet closest to search_pose, same as the overload that
+   * takes lanelets]
+   * @param  search_pose         [search pose]
+   * @param  closest_lanelet_ptr [closest lanelet]
+   * @param  subtype             [subtype of lanelets to be searched, or empty for all lanelets]
+   * @return                     [true if a lanelet is found]
+   */
+  bool getClosestLanelet(
+    const geometry_msgs::msg::Pose & search_pose, lanelet::ConstLanelet * closest_lanelet_ptr,
+    const std::string & subtype = "") const;
+
+private:
+  using RTree = boost::geometry::index::rtree<
+    std::pair<lanelet::BoundingBox2d, size_t>, boost::geometry::index::quadratic<16>>;
+
+  struct SubtypeIndex
+  {
+    lanelet::ConstLanelets lanelets;
+    std::vector<lanelet::BasicPolygon2d> polygons;
+    RTree rtree;
+  };
+
+  SubtypeIndex all_;
+  std::map<std::string, SubtypeIndex> subtypes_;
+
+  const SubtypeIndex * findSubtypeIndex(const std::string & subtype) const;
+};
+
 /**
  * [laneletLayer converts laneletLayer into lanelet vector]
  * @param  ll_Map [input lanelet map]
  * @return        [all lanelets in the map]
  */
 lanelet::ConstLanelets laneletLayer(const lanelet::LaneletMapConstPtr & ll_Map);
+const lanelet::ConstLanelets & laneletLayer(const LaneletQueryIndex & index);
 
 /**
  * [subtypeLanelets extracts Lanelet that has given subtype attribute]
@@ -62,6 +127,8 @@ lanelet::ConstLanelets laneletLayer(const lanelet::LaneletMapConstPtr & ll_Map);
  * @return         [lanelets with given subtype]
  */
 lanelet::ConstLanelets subtypeLanelets(const lanelet::ConstLanelets lls, const char subtype[]);
+const lanelet::ConstLanelets & subtypeLanelets(
+  const LaneletQueryIndex & index, const char subtype[]);
 
 /**
  * [crosswalkLanelets extracts crosswalk lanelets]
@@ -69,7 +136,9 @@ lanelet::ConstLanelets subtypeLanelets(const lanelet::ConstLanelets lls, const c
  * @return     [crosswalk lanelets]
  */
 lanelet::ConstLanelets crosswalkLanelets(const lanelet::ConstLanelets lls);
+const lanelet::ConstLanelets & crosswalkLanelets(const LaneletQueryIndex & index);
 lanelet::ConstLanelets walkwayLanelets(const lanelet::ConstLanelets lls);
+const lanelet::ConstLanelets & walkwayLanelets(const LaneletQueryIndex & index);
 
 /**
  * [roadLanelets extracts road lanelets]
@@ -77,6 +146,7 @@ lanelet::ConstLanelets walkwayLanelets(const lanelet::ConstLanelets lls);
  * @return     [road lanelets]
  */
 lanelet::ConstLanelets roadLanelets(const lanelet::ConstLanelets lls);
+const lanelet::ConstLanelets & roadLanelets(const LaneletQueryIndex & index);
 
 /**
  * [shoulderLanelets extracts shoulder lanelets]
@@ -84,6 +154,7 @@ lanelet::ConstLanelets roadLanelets(const lanelet::ConstLanelets lls);
  * @return     [shoulder lanelets]
  */
 lanelet::ConstLanelets shoulderLanelets(const lanelet::ConstLanelets lls);
+const lanelet::ConstLanelets & shoulderLanelets(const LaneletQueryIndex & index);
 /**
  * [trafficLights extracts Traffic Light regulatory element from lanelets]
  * @param lanelets [input lanelets]
@@ -199,6 +270,12 @@ ConstLanelets getLaneletsWithinRange(
 ConstLanelets getLaneletsWithinRange(
   const lanelet::ConstLanelets & lanelets, const geometry_msgs::msg::Point & search_point,
   const double range);
+ConstLanelets getLaneletsWithinRange(
+  const LaneletQueryIndex & index, const lanelet::BasicPoint2d & search_point, const double range,
+  const std::string & subtype = "");
+ConstLanelets getLaneletsWithinRange(
+  const LaneletQueryIndex & index, const geometry_msgs::msg::Point & search_point,
+  const double range, const std::string & subtype = "");
 
 ConstLanelets getLaneChangeableNeighbors(
   const routing::RoutingGraphPtr & graph, const ConstLanelet & lanelet);
@@ -218,6 +295,9 @@ ConstLanelets getAllNeighbors(
 bool getClosestLanelet(
   const ConstLanelets & lanelets, const geometry_msgs::msg::Pose & search_pose,
   ConstLanelet * closest_lanelet_ptr);
+bool getClosestLanelet(
+  const LaneletQueryIndex & index, const geometry_msgs::msg::Pose & search_pose,
+  ConstLanelet * closest_lanelet_ptr, const std::string & subtype = "");
 
 /**
  * [getSucceedingLaneletSequences retrieves a sequence of lanelets after the given lanelet.
@@ -245,6 +325,45 @@ std::vector<lanelet::ConstLanelets> getPrecedingLaneletSequences(
   const routing::RoutingGraphPtr & graph, const lanelet::ConstLanelet & lanelet,
   const double length, const lanelet::ConstLanelets & exclude_lanelets = {});
 
+/**
+ * [LaneletSequenceCache memoizes getSucceedingLaneletSequences and getPrecedingLaneletSequences
+ * over a routing graph. Sequences are traversed on the first query of a lanelet and length and
+ * shared by the following queries, so that callers iterating over many objects on the same
+ * lanelets don't traverse the graph again. Construct a new cache when the graph changes.]
+ */
+class LaneletSequenceCache
+{
+public:
+  using LaneletSequencesConstPtr = std::shared_ptr<const std::vector<lanelet::ConstLanelets>>;
+
+  explicit LaneletSequenceCache(const routing::RoutingGraphPtr & graph);
+
+  /**
+   * [getSucceedingLaneletSequences same as the function which takes the graph]
+   * @return [shared sequences, which must not be modified]
+   */
+  LaneletSequencesConstPtr getSucceedingLaneletSequences(
+    const lanelet::ConstLanelet & lanelet, const double length);
+
+  /**
+   * [getPrecedingLaneletSequences same as the function which takes the graph]
+   * @return [shared sequences, which must not be modified]
+   */
+  LaneletSequencesConstPtr getPrecedingLaneletSequences(
+    const lanelet::ConstLanelet & lanelet, const double length,
+    const lanelet::ConstLanelets & exclude_lanelets = {});
+
+  void clear();
+
+private:
+  routing::RoutingGraphPtr graph_;
+
+  std::mutex mutex_;
+  std::map<std::pair<lanelet::Id, double>, LaneletSequencesConstPtr> succeeding_sequences_;
+  std::map<std::tuple<lanelet::Id, double, std::vector<lanelet::Id>>, LaneletSequencesConstPtr>
+    preceding_sequences_;
+};
+
 }  // namespace query
 }  // namespace utils
 }  // namespace lanelet
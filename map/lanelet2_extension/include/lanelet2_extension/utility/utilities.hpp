@@ -25,7 +25,13 @@
 #include <lanelet2_routing/Route.h>
 #include <lanelet2_routing/RoutingGraph.h>
 
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace lanelet
 {
@@ -78,6 +84,61 @@ bool isInLanelet(
   const geometry_msgs::msg::Pose & current_pose, const lanelet::ConstLanelet & lanelet,
   const double radius = 0.0);
 
+/**
+ * @brief Cache of the geometry derived from the lanelets of a map. Each entry is computed on first
+ * use and kept until overwriteLaneletsCenterline rewrites a map. Lanelets which are not the ones
+ * in the map, such as inverted or expanded lanelets, are computed on every call.
+ */
+class LaneletGeometryCache
+{
+public:
+  explicit LaneletGeometryCache(const lanelet::LaneletMapConstPtr & lanelet_map);
+
+  lanelet::ConstLineString3d generateFineCenterline(
+    const lanelet::ConstLanelet & lanelet_obj, const double resolution = 5.0);
+  lanelet::ConstLineString3d getCenterlineWithOffset(
+    const lanelet::ConstLanelet & lanelet_obj, const double offset,
+    const double resolution = 5.0);
+  lanelet::ConstLanelet getExpandedLanelet(
+    const lanelet::ConstLanelet & lanelet_obj, const double left_offset,
+    const double right_offset);
+
+  /**
+   * @brief accumulated 2D lengths of the centerline from its first point
+   */
+  std::shared_ptr<const std::vector<double>> getAccumulatedLengths(
+    const lanelet::ConstLanelet & lanelet_obj);
+  double getLaneletLength2d(const lanelet::ConstLanelet & lanelet_obj);
+
+  /**
+   * @brief same as lanelet::utils::getArcCoordinates, with the lengths of the preceding lanelets
+   * taken from the cache
+   */
+  lanelet::ArcCoordinates getArcCoordinates(
+    const lanelet::ConstLanelets & lanelet_sequence, const geometry_msgs::msg::Pose & pose);
+
+  /**
+   * @brief point on the centerline at arc length s, found by binary search of the accumulated
+   * lengths and clamped to the ends of the centerline
+   */
+  lanelet::BasicPoint3d getCenterlinePoint(
+    const lanelet::ConstLanelet & lanelet_obj, const double s);
+
+private:
+  lanelet::LaneletMapConstPtr lanelet_map_;
+
+  std::mutex mutex_;
+  uint64_t centerline_revision_;
+  std::map<std::pair<lanelet::Id, double>, lanelet::ConstLineString3d> fine_centerlines_;
+  std::map<std::tuple<lanelet::Id, double, double>, lanelet::ConstLineString3d>
+    offset_centerlines_;
+  std::map<std::tuple<lanelet::Id, double, double>, lanelet::ConstLanelet> expanded_lanelets_;
+  std::map<lanelet::Id, std::shared_ptr<const std::vector<double>>> accumulated_lengths_;
+
+  bool isCacheable(const lanelet::ConstLanelet & lanelet_obj) const;
+  void clearIfOutdated();
+};
+
 }  // namespace utils
 }  // namespace lanelet
 
@@ -0,0 +1,180 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lanelet2_extension/io/binary_map_cache.hpp"
+
+#include "lanelet2_extension/utility/message_conversion.hpp"
+
+#include <boost/archive/basic_archive.hpp>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace
+{
+constexpr char MAGIC[8] = {'L', 'L', '2', 'C', 'A', 'C', 'H', 'E'};
+constexpr uint32_t VERSION = 1;
+
+/** \brief Start of the cache file, followed by the versions and the serialized map. */
+struct FileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t boost_archive_version;
+  uint64_t source_size;
+  int64_t source_mtime_sec;
+  int64_t source_mtime_nsec;
+  double center_line_resolution;
+  uint64_t format_version_size;
+  uint64_t map_version_size;
+  uint64_t data_size;
+};
+
+// the serialized map can only be read by the same archive version
+uint32_t getBoostArchiveVersion()
+{
+  return static_cast<uint32_t>(boost::archive::BOOST_ARCHIVE_VERSION());
+}
+
+bool getSourceStamp(const std::string & source_path, FileHeader * header)
+{
+  struct stat st;
+  if (stat(source_path.c_str(), &st) != 0) {
+    return false;
+  }
+  header->source_size = static_cast<uint64_t>(st.st_size);
+  header->source_mtime_sec = static_cast<int64_t>(st.st_mtim.tv_sec);
+  header->source_mtime_nsec = static_cast<int64_t>(st.st_mtim.tv_nsec);
+  return true;
+}
+
+template <class T>
+bool readArray(std::ifstream & ifs, T * array, const uint64_t size)
+{
+  array->resize(size);
+  if (size == 0) {
+    return true;
+  }
+  return static_cast<bool>(
+    ifs.read(reinterpret_cast<char *>(&(*array)[0]), static_cast<std::streamsize>(size)));
+}
+}  // namespace
+
+namespace lanelet
+{
+namespace io_handlers
+{
+bool BinaryMapCache::write(
+  const std::string & cache_path, const std::string & source_path,
+  const double center_line_resolution, const autoware_lanelet2_msgs::msg::MapBin & msg)
+{
+  FileHeader header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.boost_archive_version = getBoostArchiveVersion();
+  if (!getSourceStamp(source_path, &header)) {
+    return false;
+  }
+  header.center_line_resolution = center_line_resolution;
+  header.format_version_size = msg.format_version.size();
+  header.map_version_size = msg.map_version.size();
+  header.data_size = msg.data.size();
+
+  const std::string tmp_path = cache_path + ".tmp." + std::to_string(getpid());
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+      return false;
+    }
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(msg.format_version.data(), msg.format_version.size());
+    ofs.write(msg.map_version.data(), msg.map_version.size());
+    ofs.write(reinterpret_cast<const char *>(msg.data.data()), msg.data.size());
+    if (!ofs) {
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  return std::rename(tmp_path.c_str(), cache_path.c_str()) == 0;
+}
+
+bool BinaryMapCache::read(
+  const std::string & cache_path, const std::string & source_path,
+  const double center_line_resolution, autoware_lanelet2_msgs::msg::MapBin * msg)
+{
+  if (msg == nullptr) {
+    return false;
+  }
+  std::ifstream ifs(cache_path, std::ios::binary | std::ios::ate);
+  if (!ifs) {
+    return false;
+  }
+  const auto file_size = static_cast<uint64_t>(ifs.tellg());
+  ifs.seekg(0);
+
+  FileHeader header;
+  FileHeader source_stamp{};
+  if (
+    !ifs.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+    !getSourceStamp(source_path, &source_stamp)) {
+    return false;
+  }
+  if (
+    std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+    header.boost_archive_version != getBoostArchiveVersion() ||
+    header.source_size != source_stamp.source_size ||
+    header.source_mtime_sec != source_stamp.source_mtime_sec ||
+    header.source_mtime_nsec != source_stamp.source_mtime_nsec ||
+    header.center_line_resolution != center_line_resolution ||
+    file_size != sizeof(header) + header.format_version_size + header.map_version_size +
+                   header.data_size) {
+    return false;
+  }
+
+  autoware_lanelet2_msgs::msg::MapBin cached_msg;
+  if (
+    !readArray(ifs, &cached_msg.format_version, header.format_version_size) ||
+    !readArray(ifs, &cached_msg.map_version, header.map_version_size) ||
+    !readArray(ifs, &cached_msg.data, header.data_size)) {
+    return false;
+  }
+  msg->format_version = std::move(cached_msg.format_version);
+  msg->map_version = std::move(cached_msg.map_version);
+  msg->data = std::move(cached_msg.data);
+  return true;
+}
+
+LaneletMapPtr BinaryMapCache::load(
+  const std::string & cache_path, const std::string & source_path,
+  const double center_line_resolution)
+{
+  autoware_lanelet2_msgs::msg::MapBin msg;
+  if (!read(cache_path, source_path, center_line_resolution, &msg)) {
+    return nullptr;
+  }
+  auto map = std::make_shared<LaneletMap>();
+  lanelet::utils::conversion::fromBinMsg(msg, map);
+  return map;
+}
+
+}  // namespace io_handlers
+}  // namespace lanelet
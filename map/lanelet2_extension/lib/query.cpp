@@ -21,15 +21,19 @@
 
 #include <Eigen/Eigen>
 
+#include <lanelet2_core/geometry/BoundingBox.h>
 #include <lanelet2_core/geometry/Lanelet.h>
 #include <lanelet2_routing/RoutingGraph.h>
 #include <tf2/utils.h>
 
-#include <deque>
+#include <algorithm>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <set>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 using lanelet::utils::to2D;
@@ -44,12 +48,151 @@ double getAngleDifference(const double angle1, const double angle2)
   return std::fabs(diff_angle);
 }
 
+// pick the lanelet whose centerline is aligned with search_pose among equally close candidates
+void selectLaneletByAngle(
+  const lanelet::ConstLanelets & candidate_lanelets, const geometry_msgs::msg::Pose & search_pose,
+  lanelet::ConstLanelet * closest_lanelet_ptr)
+{
+  const lanelet::BasicPoint2d search_point(search_pose.position.x, search_pose.position.y);
+  double min_angle = std::numeric_limits<double>::max();
+  double pose_yaw = tf2::getYaw(search_pose.orientation);
+  for (const auto & llt : candidate_lanelets) {
+    lanelet::ConstLineString3d segment =
+      lanelet::utils::getClosestSegment(search_point, llt.centerline());
+    double segment_angle = std::atan2(
+      segment.back().y() - segment.front().y(), segment.back().x() - segment.front().x());
+    double angle_diff = getAngleDifference(segment_angle, pose_yaw);
+    if (angle_diff < min_angle) {
+      min_angle = angle_diff;
+      *closest_lanelet_ptr = llt;
+    } else if ((segment_angle - pose_yaw) < 1e-04) {
+      min_angle = std::abs(segment_angle - pose_yaw);
+      *closest_lanelet_ptr = llt;
+    }
+  }
+}
+
 }  // namespace
 
 namespace lanelet
 {
 namespace utils
 {
+query::LaneletQueryIndex::LaneletQueryIndex(const lanelet::LaneletMapConstPtr & ll_map)
+{
+  const auto add = [](SubtypeIndex & index, const lanelet::ConstLanelet & llt) {
+    const auto box = lanelet::geometry::boundingBox2d(llt);
+    index.rtree.insert(std::make_pair(box, index.lanelets.size()));
+    index.lanelets.push_back(llt);
+    index.polygons.push_back(llt.polygon2d().basicPolygon());
+  };
+
+  for (const auto & llt : laneletLayer(ll_map)) {
+    add(all_, llt);
+    if (llt.hasAttribute(lanelet::AttributeName::Subtype)) {
+      add(subtypes_[llt.attribute(lanelet::AttributeName::Subtype).value()], llt);
+    }
+  }
+}
+
+const query::LaneletQueryIndex::SubtypeIndex * query::LaneletQueryIndex::findSubtypeIndex(
+  const std::string & subtype) const
+{
+  if (subtype.empty()) {
+    return &all_;
+  }
+  const auto itr = subtypes_.find(subtype);
+  return itr == subtypes_.end() ? nullptr : &itr->second;
+}
+
+const lanelet::ConstLanelets & query::LaneletQueryIndex::lanelets(const std::string & subtype) const
+{
+  static const lanelet::ConstLanelets empty_lanelets;
+  const auto index = findSubtypeIndex(subtype);
+  return index ? index->lanelets : empty_lanelets;
+}
+
+lanelet::ConstLanelets query::LaneletQueryIndex::getLaneletsWithinRange(
+  const lanelet::BasicPoint2d & search_point, const double range, const std::string & subtype) const
+{
+  lanelet::ConstLanelets near_lanelets;
+  const auto index = findSubtypeIndex(subtype);
+  if (!index) {
+    return near_lanelets;
+  }
+
+  const lanelet::BasicPoint2d offset(range, range);
+  const lanelet::BoundingBox2d search_box(search_point - offset, search_point + offset);
+  std::vector<std::pair<lanelet::BoundingBox2d, size_t>> candidates;
+  index->rtree.query(
+    boost::geometry::index::intersects(search_box), std::back_inserter(candidates));
+
+  // keep the order of the lanelet layer as the linear scan does
+  std::sort(candidates.begin(), candidates.end(), [](const auto & a, const auto & b) {
+    return a.second < b.second;
+  });
+  for (const auto & candidate : candidates) {
+    const double distance =
+      lanelet::geometry::distance(index->polygons.at(candidate.second), search_point);
+    if (distance <= range) {
+      near_lanelets.push_back(index->lanelets.at(candidate.second));
+    }
+  }
+  return near_lanelets;
+}
+
+bool query::LaneletQueryIndex::getClosestLanelet(
+  const geometry_msgs::msg::Pose & search_pose, lanelet::ConstLanelet * closest_lanelet_ptr,
+  const std::string & subtype) const
+{
+  if (closest_lanelet_ptr == nullptr) {
+    std::cerr << "argument closest_lanelet_ptr is null! Failed to find closest lanelet"
+              << std::endl;
+    return false;
+  }
+
+  const auto index = findSubtypeIndex(subtype);
+  if (!index || index->lanelets.empty()) {
+    return false;
+  }
+
+  const lanelet::BasicPoint2d search_point(search_pose.position.x, search_pose.position.y);
+
+  // visit lanelets in the order of the distance to their bounding box, which never exceeds the
+  // distance to the polygon, and stop once no farther lanelet can be as close as the closest one
+  std::vector<size_t> candidate_ids;
+  double min_distance = std::numeric_limits<double>::max();
+  for (auto itr = index->rtree.qbegin(
+         boost::geometry::index::nearest(search_point, static_cast<unsigned>(index->rtree.size())));
+       itr != index->rtree.qend(); ++itr) {
+    const double box_distance = boost::geometry::distance(itr->first, search_point);
+    if (box_distance > min_distance + std::numeric_limits<double>::epsilon()) {
+      break;
+    }
+
+    const double distance =
+      boost::geometry::distance(index->polygons.at(itr->second), search_point);
+    if (std::abs(distance - min_distance) <= std::numeric_limits<double>::epsilon()) {
+      candidate_ids.push_back(itr->second);
+    } else if (distance < min_distance) {
+      candidate_ids.clear();
+      candidate_ids.push_back(itr->second);
+      min_distance = distance;
+    }
+  }
+
+  // the order of the candidates matters for equally aligned ones
+  std::sort(candidate_ids.begin(), candidate_ids.end());
+  lanelet::ConstLanelets candidate_lanelets;
+  for (const auto id : candidate_ids) {
+    candidate_lanelets.push_back(index->lanelets.at(id));
+  }
+
+  selectLaneletByAngle(candidate_lanelets, search_pose, closest_lanelet_ptr);
+
+  return !candidate_lanelets.empty();
+}
+
 // returns all lanelets in laneletLayer - don't know how to convert
 // PrimitiveLayer<Lanelets> -> std::vector<Lanelets>
 lanelet::ConstLanelets query::laneletLayer(const lanelet::LaneletMapConstPtr & ll_map)
@@ -67,6 +210,11 @@ lanelet::ConstLanelets query::laneletLayer(const lanelet::LaneletMapConstPtr & l
   return lanelets;
 }
 
+const lanelet::ConstLanelets & query::laneletLayer(const LaneletQueryIndex & index)
+{
+  return index.lanelets();
+}
+
 lanelet::ConstLanelets query::subtypeLanelets(
   const lanelet::ConstLanelets lls, const char subtype[])
 {
@@ -86,6 +234,12 @@ lanelet::ConstLanelets query::subtypeLanelets(
   return subtype_lanelets;
 }
 
+const lanelet::ConstLanelets & query::subtypeLanelets(
+  const LaneletQueryIndex & index, const char subtype[])
+{
+  return index.lanelets(subtype);
+}
+
 lanelet::ConstLanelets query::crosswalkLanelets(const lanelet::ConstLanelets lls)
 {
   return query::subtypeLanelets(lls, lanelet::AttributeValueString::Crosswalk);
@@ -106,6 +260,26 @@ lanelet::ConstLanelets query::shoulderLanelets(const lanelet::ConstLanelets lls)
   return query::subtypeLanelets(lls, "road_shoulder");
 }
 
+const lanelet::ConstLanelets & query::crosswalkLanelets(const LaneletQueryIndex & index)
+{
+  return query::subtypeLanelets(index, lanelet::AttributeValueString::Crosswalk);
+}
+
+const lanelet::ConstLanelets & query::walkwayLanelets(const LaneletQueryIndex & index)
+{
+  return query::subtypeLanelets(index, lanelet::AttributeValueString::Walkway);
+}
+
+const lanelet::ConstLanelets & query::roadLanelets(const LaneletQueryIndex & index)
+{
+  return query::subtypeLanelets(index, lanelet::AttributeValueString::Road);
+}
+
+const lanelet::ConstLanelets & query::shoulderLanelets(const LaneletQueryIndex & index)
+{
+  return query::subtypeLanelets(index, "road_shoulder");
+}
+
 std::vector<lanelet::TrafficLightConstPtr> query::trafficLights(
   const lanelet::ConstLanelets lanelets)
 {
@@ -605,6 +779,21 @@ ConstLanelets query::getLaneletsWithinRange(
     lanelets, lanelet::BasicPoint2d(search_point.x, search_point.y), range);
 }
 
+ConstLanelets query::getLaneletsWithinRange(
+  const LaneletQueryIndex & index, const lanelet::BasicPoint2d & search_point, const double range,
+  const std::string & subtype)
+{
+  return index.getLaneletsWithinRange(search_point, range, subtype);
+}
+
+ConstLanelets query::getLaneletsWithinRange(
+  const LaneletQueryIndex & index, const geometry_msgs::msg::Point & search_point,
+  const double range, const std::string & subtype)
+{
+  return index.getLaneletsWithinRange(
+    lanelet::BasicPoint2d(search_point.x, search_point.y), range, subtype);
+}
+
 ConstLanelets query::getLaneChangeableNeighbors(
   const routing::RoutingGraphPtr & graph, const ConstLanelet & lanelet)
 {
@@ -720,89 +909,72 @@ bool query::getClosestLanelet(
   }
 
   // find by angle
-  {
-    double min_angle = std::numeric_limits<double>::max();
-    double pose_yaw = tf2::getYaw(search_pose.orientation);
-    for (const auto & llt : candidate_lanelets) {
-      lanelet::ConstLineString3d segment = getClosestSegment(search_point, llt.centerline());
-      double segment_angle = std::atan2(
-        segment.back().y() - segment.front().y(), segment.back().x() - segment.front().x());
-      double angle_diff = getAngleDifference(segment_angle, pose_yaw);
-      if (angle_diff < min_angle) {
-        min_angle = angle_diff;
-        *closest_lanelet_ptr = llt;
-      } else if ((segment_angle - pose_yaw) < 1e-04) {
-        min_angle = std::abs(segment_angle - pose_yaw);
-        *closest_lanelet_ptr = llt;
-      }
-    }
-  }
+  selectLaneletByAngle(candidate_lanelets, search_pose, closest_lanelet_ptr);
 
   return found;
 }
 
-std::vector<std::deque<lanelet::ConstLanelet>> getSucceedingLaneletSequencesRecursive(
+bool query::getClosestLanelet(
+  const LaneletQueryIndex & index, const geometry_msgs::msg::Pose & search_pose,
+  ConstLanelet * closest_lanelet_ptr, const std::string & subtype)
+{
+  return index.getClosestLanelet(search_pose, closest_lanelet_ptr, subtype);
+}
+
+// append the sequences which start with path to lanelet_sequences, extending path in place
+void getSucceedingLaneletSequencesRecursive(
   const routing::RoutingGraphPtr & graph, const lanelet::ConstLanelet & lanelet,
-  const double length)
+  const double length, lanelet::ConstLanelets * path,
+  std::vector<lanelet::ConstLanelets> * lanelet_sequences)
 {
-  std::vector<std::deque<lanelet::ConstLanelet>> succeeding_lanelet_sequences;
+  path->push_back(lanelet);
 
   const auto next_lanelets = graph->following(lanelet);
   const double lanelet_length = utils::getLaneletLength3d(lanelet);
 
   // end condition of the recursive function
   if (next_lanelets.empty() || lanelet_length >= length) {
-    succeeding_lanelet_sequences.push_back({lanelet});
-    return succeeding_lanelet_sequences;
-  }
-
-  for (const auto & next_lanelet : next_lanelets) {
-    // get lanelet sequence after next_lanelet
-    auto tmp_lanelet_sequences =
-      getSucceedingLaneletSequencesRecursive(graph, next_lanelet, length - lanelet_length);
-    for (auto & tmp_lanelet_sequence : tmp_lanelet_sequences) {
-      tmp_lanelet_sequence.push_front(lanelet);
-      succeeding_lanelet_sequences.push_back(tmp_lanelet_sequence);
+    lanelet_sequences->push_back(*path);
+  } else {
+    for (const auto & next_lanelet : next_lanelets) {
+      getSucceedingLaneletSequencesRecursive(
+        graph, next_lanelet, length - lanelet_length, path, lanelet_sequences);
     }
   }
-  return succeeding_lanelet_sequences;
+
+  path->pop_back();
 }
 
-std::vector<std::deque<lanelet::ConstLanelet>> getPrecedingLaneletSequencesRecursive(
+// same as above, path is stored from the last lanelet and reversed when it's appended
+void getPrecedingLaneletSequencesRecursive(
   const routing::RoutingGraphPtr & graph, const lanelet::ConstLanelet & lanelet,
-  const double length, const lanelet::ConstLanelets & exclude_lanelets)
+  const double length, const lanelet::ConstLanelets & exclude_lanelets,
+  lanelet::ConstLanelets * path, std::vector<lanelet::ConstLanelets> * lanelet_sequences)
 {
-  std::vector<std::deque<lanelet::ConstLanelet>> preceding_lanelet_sequences;
+  path->push_back(lanelet);
 
   const auto prev_lanelets = graph->previous(lanelet);
   const double lanelet_length = utils::getLaneletLength3d(lanelet);
 
   // end condition of the recursive function
-  if (prev_lanelets.empty() || lanelet_length >= length) {
-    preceding_lanelet_sequences.push_back({lanelet});
-    return preceding_lanelet_sequences;
-  }
-
-  for (const auto & prev_lanelet : prev_lanelets) {
-    if (lanelet::utils::contains(exclude_lanelets, prev_lanelet)) {
-      // if prev_lanelet is included in exclude_lanelets,
-      // remove prev_lanelet from preceding_lanelet_sequences
-      continue;
-    }
-
-    // get lanelet sequence after prev_lanelet
-    auto tmp_lanelet_sequences = getPrecedingLaneletSequencesRecursive(
-      graph, prev_lanelet, length - lanelet_length, exclude_lanelets);
-    for (auto & tmp_lanelet_sequence : tmp_lanelet_sequences) {
-      tmp_lanelet_sequence.push_back(lanelet);
-      preceding_lanelet_sequences.push_back(tmp_lanelet_sequence);
+  bool is_end = prev_lanelets.empty() || lanelet_length >= length;
+  if (!is_end) {
+    // the sequence ends here if all prev_lanelets are included in exclude_lanelets
+    is_end = true;
+    for (const auto & prev_lanelet : prev_lanelets) {
+      if (lanelet::utils::contains(exclude_lanelets, prev_lanelet)) {
+        continue;
+      }
+      is_end = false;
+      getPrecedingLaneletSequencesRecursive(
+        graph, prev_lanelet, length - lanelet_length, exclude_lanelets, path, lanelet_sequences);
     }
   }
-
-  if (preceding_lanelet_sequences.empty()) {
-    preceding_lanelet_sequences.push_back({lanelet});
+  if (is_end) {
+    lanelet_sequences->emplace_back(path->rbegin(), path->rend());
   }
-  return preceding_lanelet_sequences;
+
+  path->pop_back();
 }
 
 std::vector<lanelet::ConstLanelets> query::getSucceedingLaneletSequences(
@@ -810,13 +982,11 @@ std::vector<lanelet::ConstLanelets> query::getSucceedingLaneletSequences(
   const double length)
 {
   std::vector<ConstLanelets> lanelet_sequences_vec;
+  ConstLanelets path;
   const auto next_lanelets = graph->following(lanelet);
   for (const auto & next_lanelet : next_lanelets) {
-    const auto lanelet_sequences_deq =
-      getSucceedingLaneletSequencesRecursive(graph, next_lanelet, length);
-    for (const auto & lanelet_sequence : lanelet_sequences_deq) {
-      lanelet_sequences_vec.emplace_back(lanelet_sequence.begin(), lanelet_sequence.end());
-    }
+    getSucceedingLaneletSequencesRecursive(
+      graph, next_lanelet, length, &path, &lanelet_sequences_vec);
   }
   return lanelet_sequences_vec;
 }
@@ -826,6 +996,7 @@ std::vector<lanelet::ConstLanelets> query::getPrecedingLaneletSequences(
   const double length, const lanelet::ConstLanelets & exclude_lanelets)
 {
   std::vector<ConstLanelets> lanelet_sequences_vec;
+  ConstLanelets path;
   const auto prev_lanelets = graph->previous(lanelet);
   for (const auto & prev_lanelet : prev_lanelets) {
     if (lanelet::utils::contains(exclude_lanelets, prev_lanelet)) {
@@ -833,15 +1004,62 @@ std::vector<lanelet::ConstLanelets> query::getPrecedingLaneletSequences(
       // remove prev_lanelet from preceding_lanelet_sequences
       continue;
     }
-    // convert deque into vector
-    const auto lanelet_sequences_deq =
-      getPrecedingLaneletSequencesRecursive(graph, prev_lanelet, length, exclude_lanelets);
-    for (const auto & lanelet_sequence : lanelet_sequences_deq) {
-      lanelet_sequences_vec.emplace_back(lanelet_sequence.begin(), lanelet_sequence.end());
-    }
+    getPrecedingLaneletSequencesRecursive(
+      graph, prev_lanelet, length, exclude_lanelets, &path, &lanelet_sequences_vec);
   }
   return lanelet_sequences_vec;
 }
 
+query::LaneletSequenceCache::LaneletSequenceCache(const routing::RoutingGraphPtr & graph)
+: graph_(graph)
+{
+}
+
+query::LaneletSequenceCache::LaneletSequencesConstPtr
+query::LaneletSequenceCache::getSucceedingLaneletSequences(
+  const lanelet::ConstLanelet & lanelet, const double length)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto key = std::make_pair(lanelet.id(), length);
+  auto itr = succeeding_sequences_.find(key);
+  if (itr == succeeding_sequences_.end()) {
+    const auto sequences = std::make_shared<const std::vector<ConstLanelets>>(
+      query::getSucceedingLaneletSequences(graph_, lanelet, length));
+    itr = succeeding_sequences_.emplace(key, sequences).first;
+  }
+  return itr->second;
+}
+
+query::LaneletSequenceCache::LaneletSequencesConstPtr
+query::LaneletSequenceCache::getPrecedingLaneletSequences(
+  const lanelet::ConstLanelet & lanelet, const double length,
+  const lanelet::ConstLanelets & exclude_lanelets)
+{
+  // the order of exclude_lanelets doesn't change the result
+  std::vector<lanelet::Id> exclude_ids;
+  exclude_ids.reserve(exclude_lanelets.size());
+  for (const auto & exclude_lanelet : exclude_lanelets) {
+    exclude_ids.push_back(exclude_lanelet.id());
+  }
+  std::sort(exclude_ids.begin(), exclude_ids.end());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto key = std::make_tuple(lanelet.id(), length, std::move(exclude_ids));
+  auto itr = preceding_sequences_.find(key);
+  if (itr == preceding_sequences_.end()) {
+    const auto sequences = std::make_shared<const std::vector<ConstLanelets>>(
+      query::getPrecedingLaneletSequences(graph_, lanelet, length, exclude_lanelets));
+    itr = preceding_sequences_.emplace(key, sequences).first;
+  }
+  return itr->second;
+}
+
+void query::LaneletSequenceCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  succeeding_sequences_.clear();
+  preceding_sequences_.clear();
+}
+
 }  // namespace utils
 }  // namespace lanelet
@@ -26,8 +26,12 @@
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -37,6 +41,9 @@ namespace utils
 {
 namespace
 {
+// incremented whenever overwriteLaneletsCenterline rewrites a map, to invalidate the caches
+std::atomic<uint64_t> centerline_revision{0};
+
 [[maybe_unused]] bool exists(const std::vector<int> & array, const int element)
 {
   return std::find(array.begin(), array.end(), element) != array.end();
@@ -122,12 +129,11 @@ std::pair<size_t, size_t> findNearestIndexPair(
   }
 
   // Middle
-  for (std::size_t i = 1; i < N; ++i) {
-    if (
-      accumulated_lengths.at(i - 1) <= target_length &&
-      target_length <= accumulated_lengths.at(i)) {
-      return std::make_pair(i - 1, i);
-    }
+  const auto itr =
+    std::lower_bound(accumulated_lengths.begin() + 1, accumulated_lengths.end(), target_length);
+  if (itr != accumulated_lengths.end()) {
+    const auto i = static_cast<size_t>(std::distance(accumulated_lengths.begin(), itr));
+    return std::make_pair(i - 1, i);
   }
 
   // Throw an exception because this never happens
@@ -369,6 +375,7 @@ void overwriteLaneletsCenterline(
       lanelet_obj.setCenterline(fine_center_line);
     }
   }
+  ++centerline_revision;
 }
 
 lanelet::ConstLanelets getConflictingLanelets(
@@ -595,5 +602,172 @@ bool isInLanelet(
   return false;
 }
 
+LaneletGeometryCache::LaneletGeometryCache(const lanelet::LaneletMapConstPtr & lanelet_map)
+: lanelet_map_(lanelet_map), centerline_revision_(centerline_revision)
+{
+}
+
+bool LaneletGeometryCache::isCacheable(const lanelet::ConstLanelet & lanelet_obj) const
+{
+  // expanded lanelets keep the id of the original one, so compare the data as well
+  return lanelet_map_ && !lanelet_obj.inverted() &&
+         lanelet_map_->laneletLayer.exists(lanelet_obj.id()) &&
+         lanelet_map_->laneletLayer.get(lanelet_obj.id()).constData() == lanelet_obj.constData();
+}
+
+void LaneletGeometryCache::clearIfOutdated()
+{
+  const uint64_t revision = centerline_revision;
+  if (revision == centerline_revision_) {
+    return;
+  }
+  fine_centerlines_.clear();
+  offset_centerlines_.clear();
+  expanded_lanelets_.clear();
+  accumulated_lengths_.clear();
+  centerline_revision_ = revision;
+}
+
+lanelet::ConstLineString3d LaneletGeometryCache::generateFineCenterline(
+  const lanelet::ConstLanelet & lanelet_obj, const double resolution)
+{
+  if (!isCacheable(lanelet_obj)) {
+    return lanelet::utils::generateFineCenterline(lanelet_obj, resolution);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  clearIfOutdated();
+  const auto key = std::make_pair(lanelet_obj.id(), resolution);
+  auto itr = fine_centerlines_.find(key);
+  if (itr == fine_centerlines_.end()) {
+    itr = fine_centerlines_
+            .emplace(key, lanelet::utils::generateFineCenterline(lanelet_obj, resolution))
+            .first;
+  }
+  return itr->second;
+}
+
+lanelet::ConstLineString3d LaneletGeometryCache::getCenterlineWithOffset(
+  const lanelet::ConstLanelet & lanelet_obj, const double offset, const double resolution)
+{
+  if (!isCacheable(lanelet_obj)) {
+    return lanelet::utils::getCenterlineWithOffset(lanelet_obj, offset, resolution);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  clearIfOutdated();
+  const auto key = std::make_tuple(lanelet_obj.id(), offset, resolution);
+  auto itr = offset_centerlines_.find(key);
+  if (itr == offset_centerlines_.end()) {
+    itr = offset_centerlines_
+            .emplace(key, lanelet::utils::getCenterlineWithOffset(lanelet_obj, offset, resolution))
+            .first;
+  }
+  return itr->second;
+}
+
+lanelet::ConstLanelet LaneletGeometryCache::getExpandedLanelet(
+  const lanelet::ConstLanelet & lanelet_obj, const double left_offset, const double right_offset)
+{
+  if (!isCacheable(lanelet_obj)) {
+    return lanelet::utils::getExpandedLanelet(lanelet_obj, left_offset, right_offset);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  clearIfOutdated();
+  const auto key = std::make_tuple(lanelet_obj.id(), left_offset, right_offset);
+  auto itr = expanded_lanelets_.find(key);
+  if (itr == expanded_lanelets_.end()) {
+    itr = expanded_lanelets_
+            .emplace(
+              key, lanelet::utils::getExpandedLanelet(lanelet_obj, left_offset, right_offset))
+            .first;
+  }
+  return itr->second;
+}
+
+std::shared_ptr<const std::vector<double>> LaneletGeometryCache::getAccumulatedLengths(
+  const lanelet::ConstLanelet & lanelet_obj)
+{
+  const auto calcAccumulatedLengths = [](const lanelet::ConstLanelet & llt) {
+    const auto centerline = lanelet::utils::to2D(llt.centerline()).basicLineString();
+    auto accumulated_lengths = std::make_shared<std::vector<double>>();
+    accumulated_lengths->reserve(centerline.size());
+    double length = 0.0;
+    for (size_t i = 0; i < centerline.size(); ++i) {
+      if (i > 0) {
+        length += boost::geometry::distance(centerline.at(i - 1), centerline.at(i));
+      }
+      accumulated_lengths->push_back(length);
+    }
+    return accumulated_lengths;
+  };
+
+  if (!isCacheable(lanelet_obj)) {
+    return calcAccumulatedLengths(lanelet_obj);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  clearIfOutdated();
+  auto itr = accumulated_lengths_.find(lanelet_obj.id());
+  if (itr == accumulated_lengths_.end()) {
+    itr = accumulated_lengths_.emplace(lanelet_obj.id(), calcAccumulatedLengths(lanelet_obj)).first;
+  }
+  return itr->second;
+}
+
+double LaneletGeometryCache::getLaneletLength2d(const lanelet::ConstLanelet & lanelet_obj)
+{
+  const auto accumulated_lengths = getAccumulatedLengths(lanelet_obj);
+  return accumulated_lengths->empty() ? 0.0 : accumulated_lengths->back();
+}
+
+lanelet::ArcCoordinates LaneletGeometryCache::getArcCoordinates(
+  const lanelet::ConstLanelets & lanelet_sequence, const geometry_msgs::msg::Pose & pose)
+{
+  lanelet::ConstLanelet closest_lanelet;
+  lanelet::utils::query::getClosestLanelet(lanelet_sequence, pose, &closest_lanelet);
+
+  double length = 0;
+  lanelet::ArcCoordinates arc_coordinates;
+  for (const auto & llt : lanelet_sequence) {
+    if (llt == closest_lanelet) {
+      const auto & centerline_2d = lanelet::utils::to2D(llt.centerline());
+      const auto lanelet_point = lanelet::utils::conversion::toLaneletPoint(pose.position);
+      arc_coordinates = lanelet::geometry::toArcCoordinates(
+        centerline_2d, lanelet::utils::to2D(lanelet_point).basicPoint());
+      arc_coordinates.length += length;
+      break;
+    }
+    length += getLaneletLength2d(llt);
+  }
+  return arc_coordinates;
+}
+
+lanelet::BasicPoint3d LaneletGeometryCache::getCenterlinePoint(
+  const lanelet::ConstLanelet & lanelet_obj, const double s)
+{
+  const auto centerline = lanelet_obj.centerline();
+  if (centerline.empty()) {
+    return lanelet::BasicPoint3d::Zero();
+  }
+
+  const auto accumulated_lengths = getAccumulatedLengths(lanelet_obj);
+  if (centerline.size() < 2 || s <= 0.0) {
+    return centerline.front().basicPoint();
+  }
+  if (s >= accumulated_lengths->back()) {
+    return centerline.back().basicPoint();
+  }
+
+  const auto itr = std::upper_bound(accumulated_lengths->begin(), accumulated_lengths->end(), s);
+  const auto i = static_cast<size_t>(std::distance(accumulated_lengths->begin(), itr));
+  const lanelet::BasicPoint3d back_point = centerline[i - 1].basicPoint();
+  const lanelet::BasicPoint3d front_point = centerline[i].basicPoint();
+  const double segment_length = accumulated_lengths->at(i) - accumulated_lengths->at(i - 1);
+  const double ratio = (s - accumulated_lengths->at(i - 1)) / segment_length;
+  return back_point + (front_point - back_point) * ratio;
+}
+
 }  // namespace utils
 }  // namespace lanelet
@@ -0,0 +1,110 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lanelet2_extension/io/binary_map_cache.hpp"
+#include "lanelet2_extension/utility/message_conversion.hpp"
+#include "lanelet2_extension/utility/query.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using lanelet::Lanelet;
+using lanelet::LineString3d;
+using lanelet::Point3d;
+using lanelet::io_handlers::BinaryMapCache;
+using lanelet::utils::getId;
+
+class TestSuite : public ::testing::Test
+{
+public:
+  TestSuite() : single_lanelet_map_ptr(new lanelet::LaneletMap())
+  {
+    Point3d p1(getId(), 0., 0., 0.);
+    Point3d p2(getId(), 0., 1., 0.);
+    Point3d p3(getId(), 1., 0., 0.);
+    Point3d p4(getId(), 1., 1., 0.);
+    LineString3d ls_left(getId(), {p1, p2});   // NOLINT
+    LineString3d ls_right(getId(), {p3, p4});  // NOLINT
+    Lanelet lanelet(getId(), ls_left, ls_right);
+    single_lanelet_map_ptr->add(lanelet);
+
+    const std::string prefix = "/tmp/test_binary_map_cache_" + std::to_string(getpid());
+    source_path = prefix + ".osm";
+    cache_path = prefix + BinaryMapCache::extension();
+    std::ofstream(source_path) << "<osm/>";
+  }
+  ~TestSuite()
+  {
+    std::remove(source_path.c_str());
+    std::remove(cache_path.c_str());
+  }
+
+  lanelet::LaneletMapPtr single_lanelet_map_ptr;
+  std::string source_path;
+  std::string cache_path;
+};
+
+TEST_F(TestSuite, WriteAndRead)
+{
+  autoware_lanelet2_msgs::msg::MapBin bin_msg;
+  bin_msg.format_version = "1.0";
+  bin_msg.map_version = "test";
+  lanelet::utils::conversion::toBinMsg(single_lanelet_map_ptr, &bin_msg);
+  ASSERT_TRUE(BinaryMapCache::write(cache_path, source_path, 5.0, bin_msg));
+
+  autoware_lanelet2_msgs::msg::MapBin cached_msg;
+  ASSERT_TRUE(BinaryMapCache::read(cache_path, source_path, 5.0, &cached_msg));
+  EXPECT_EQ(bin_msg.format_version, cached_msg.format_version);
+  EXPECT_EQ(bin_msg.map_version, cached_msg.map_version);
+  EXPECT_EQ(bin_msg.data, cached_msg.data);
+
+  const auto cached_map = BinaryMapCache::load(cache_path, source_path, 5.0);
+  ASSERT_NE(nullptr, cached_map);
+  const auto original_lanelets = lanelet::utils::query::laneletLayer(single_lanelet_map_ptr);
+  const auto cached_lanelets = lanelet::utils::query::laneletLayer(cached_map);
+  ASSERT_EQ(original_lanelets.size(), cached_lanelets.size());
+  EXPECT_EQ(original_lanelets.front().id(), cached_lanelets.front().id());
+}
+
+TEST_F(TestSuite, RejectStaleCache)
+{
+  autoware_lanelet2_msgs::msg::MapBin bin_msg;
+  lanelet::utils::conversion::toBinMsg(single_lanelet_map_ptr, &bin_msg);
+  ASSERT_TRUE(BinaryMapCache::write(cache_path, source_path, 5.0, bin_msg));
+
+  autoware_lanelet2_msgs::msg::MapBin cached_msg;
+  EXPECT_FALSE(BinaryMapCache::read(cache_path, source_path, 1.0, &cached_msg))
+    << "cache of another centerline resolution was accepted";
+
+  std::ofstream(source_path, std::ios::app) << "<!-- edited -->";
+  EXPECT_FALSE(BinaryMapCache::read(cache_path, source_path, 5.0, &cached_msg))
+    << "cache of a modified map was accepted";
+  EXPECT_EQ(nullptr, BinaryMapCache::load(cache_path, source_path, 5.0));
+}
+
+TEST_F(TestSuite, MissingCache)
+{
+  autoware_lanelet2_msgs::msg::MapBin cached_msg;
+  EXPECT_FALSE(BinaryMapCache::read(cache_path, source_path, 5.0, &cached_msg));
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
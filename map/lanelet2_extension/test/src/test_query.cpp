@@ -124,6 +124,41 @@ TEST_F(TestSuite, QueryStopLine)
   ASSERT_EQ(1U, stop_lines2.size()) << "failed to retrieve stop lines from a lanelet";
 }
 
+TEST_F(TestSuite, QueryLaneletsWithIndex)
+{
+  const lanelet::utils::query::LaneletQueryIndex index(sample_map_ptr);
+  ASSERT_EQ(2U, lanelet::utils::query::laneletLayer(index).size())
+    << "failed to retrieve all lanelets";
+  ASSERT_EQ(1U, lanelet::utils::query::roadLanelets(index).size())
+    << "failed to retrieve road lanelets";
+  ASSERT_EQ(1U, lanelet::utils::query::crosswalkLanelets(index).size())
+    << "failed to retrieve crosswalk lanelets";
+  ASSERT_TRUE(lanelet::utils::query::shoulderLanelets(index).empty())
+    << "retrieved shoulder lanelets which don't exist";
+
+  const lanelet::BasicPoint2d near_point(2.0, 0.5);
+  ASSERT_EQ(2U, lanelet::utils::query::getLaneletsWithinRange(index, near_point, 1.5).size())
+    << "failed to retrieve lanelets within range";
+  ASSERT_EQ(
+    1U, lanelet::utils::query::getLaneletsWithinRange(
+          index, near_point, 1.5, lanelet::AttributeValueString::Road)
+          .size())
+    << "failed to retrieve road lanelets within range";
+  ASSERT_TRUE(lanelet::utils::query::getLaneletsWithinRange(index, near_point, 0.5).empty())
+    << "retrieved lanelets out of range";
+
+  geometry_msgs::msg::Pose search_pose;
+  search_pose.position.x = 2.0;
+  search_pose.position.y = 0.5;
+  search_pose.orientation.w = 1.0;
+  lanelet::ConstLanelet closest_lanelet;
+  ASSERT_TRUE(lanelet::utils::query::getClosestLanelet(
+    index, search_pose, &closest_lanelet, lanelet::AttributeValueString::Road))
+    << "failed to retrieve closest lanelet";
+  ASSERT_EQ(lanelet::utils::query::roadLanelets(index).front().id(), closest_lanelet.id())
+    << "retrieved wrong closest lanelet";
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
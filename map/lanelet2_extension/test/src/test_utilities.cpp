@@ -102,6 +102,35 @@ TEST_F(TestSuite, OverwriteLaneletsCenterline)
   }
 }
 
+TEST_F(TestSuite, LaneletGeometryCache)
+{
+  lanelet::utils::LaneletGeometryCache cache(sample_map_ptr);
+
+  const auto centerline = cache.generateFineCenterline(road_lanelet, 0.5);
+  ASSERT_EQ(3U, centerline.size()) << "failed to generate fine centerline";
+  ASSERT_EQ(centerline.id(), cache.generateFineCenterline(road_lanelet, 0.5).id())
+    << "fine centerline is not cached";
+
+  ASSERT_DOUBLE_EQ(1.0, cache.getLaneletLength2d(road_lanelet));
+  const auto point = cache.getCenterlinePoint(road_lanelet, 0.25);
+  ASSERT_DOUBLE_EQ(0.5, point.x());
+  ASSERT_DOUBLE_EQ(0.25, point.y());
+
+  geometry_msgs::msg::Pose pose;
+  pose.position.x = 0.5;
+  pose.position.y = 1.5;
+  pose.orientation.w = 1.0;
+  const lanelet::ConstLanelets lanelet_sequence{road_lanelet, next_lanelet, next_lanelet2};
+  const auto arc_coordinates = cache.getArcCoordinates(lanelet_sequence, pose);
+  const auto expected = lanelet::utils::getArcCoordinates(lanelet_sequence, pose);
+  ASSERT_DOUBLE_EQ(expected.length, arc_coordinates.length);
+  ASSERT_DOUBLE_EQ(expected.distance, arc_coordinates.distance);
+
+  lanelet::utils::overwriteLaneletsCenterline(sample_map_ptr, 0.5, true);
+  ASSERT_EQ(3U, cache.getAccumulatedLengths(road_lanelet)->size())
+    << "cache is not invalidated by overwriting centerlines";
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,96 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MAP_LOADER__DIFFERENTIAL_MAP_LOADER_MODULE_HPP_
+#define MAP_LOADER__DIFFERENTIAL_MAP_LOADER_MODULE_HPP_
+
+#include "map_loader/pointcloud_map_tile_index.hpp"
+
+#include <lanelet2_extension/utility/message_conversion.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <autoware_lanelet2_msgs/msg/map_bin.hpp>
+#include <autoware_map_srvs/srv/get_differential_point_cloud_map.hpp>
+#include <autoware_planning_msgs/msg/route.hpp>
+#include <geometry_msgs/msg/pose_stamped.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/** \brief Serves the PCD tiles around a position, as the difference to the tiles a client
+ * already has. The tiles around the ego pose and along the route ahead are kept loaded, so that
+ * most requests are answered without reading files.
+ */
+class DifferentialMapLoaderModule
+{
+  using GetDifferentialPointCloudMap = autoware_map_srvs::srv::GetDifferentialPointCloudMap;
+
+public:
+  DifferentialMapLoaderModule(rclcpp::Node * node, const PointCloudMapTileIndex & tile_index);
+  ~DifferentialMapLoaderModule();
+
+private:
+  void onGetDifferentialPointCloudMap(
+    const GetDifferentialPointCloudMap::Request::SharedPtr req,
+    GetDifferentialPointCloudMap::Response::SharedPtr res);
+  void onPose(const geometry_msgs::msg::PoseStamped::ConstSharedPtr msg);
+  void onRoute(const autoware_planning_msgs::msg::Route::ConstSharedPtr msg);
+  void onMapBin(const autoware_lanelet2_msgs::msg::MapBin::ConstSharedPtr msg);
+
+  /** \brief Centerline of the preferred lanes of the route. */
+  void updateRoutePoints();
+  /** \brief Tiles within keep_radius of the ego pose and of the route prefetch_distance ahead. */
+  std::set<std::string> getTilesToKeep(const geometry_msgs::msg::Point & position) const;
+
+  sensor_msgs::msg::PointCloud2::ConstSharedPtr getTile(const std::string & id);
+  sensor_msgs::msg::PointCloud2::ConstSharedPtr loadTile(const std::string & id) const;
+  void prefetchThread();
+
+  rclcpp::Logger logger_;
+  PointCloudMapTileIndex tile_index_;
+  double keep_radius_;
+  double prefetch_distance_;
+
+  rclcpp::Service<GetDifferentialPointCloudMap>::SharedPtr srv_get_differential_pointcloud_map_;
+  rclcpp::Subscription<geometry_msgs::msg::PoseStamped>::SharedPtr sub_pose_;
+  rclcpp::Subscription<autoware_planning_msgs::msg::Route>::SharedPtr sub_route_;
+  rclcpp::Subscription<autoware_lanelet2_msgs::msg::MapBin>::SharedPtr sub_map_bin_;
+
+  lanelet::LaneletMapPtr lanelet_map_ptr_;
+  autoware_planning_msgs::msg::Route::ConstSharedPtr route_ptr_;
+  std::vector<geometry_msgs::msg::Point> route_points_;
+  geometry_msgs::msg::Point last_keep_position_;
+  bool has_keep_position_;
+
+  // loaded tiles, guarded by cache_mutex_
+  std::mutex cache_mutex_;
+  std::unordered_map<std::string, sensor_msgs::msg::PointCloud2::ConstSharedPtr> cache_;
+
+  // tiles to load in the background
+  std::thread prefetch_thread_;
+  std::condition_variable prefetch_cv_;
+  std::deque<std::string> prefetch_queue_;
+  bool is_prefetch_thread_stopped_;
+};
+
+#endif  // MAP_LOADER__DIFFERENTIAL_MAP_LOADER_MODULE_HPP_
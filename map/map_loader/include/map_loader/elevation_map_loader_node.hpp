@@ -60,7 +60,9 @@ private:
   bool checkPointWithinLanelets(
     const pcl::PointXYZ & point, const lanelet::ConstLanelets & joint_lanelets);
   void publishElevationMap();
-  void inpaintElevationMap(const float radius);
+  void createElevationMapFromTiles();
+  grid_map::GridMap createElevationMapTile(const std::filesystem::path & pcd_path);
+  void inpaintElevationMap(grid_map::GridMap * elevation_map, const float radius);
   pcl::PointCloud<pcl::PointXYZ>::Ptr createPointcloudFromElevationMap();
   void saveElevationMap();
   float calculateDistancePointFromPlane(
@@ -79,6 +81,14 @@ private:
   bool use_elevation_map_file_;
   bool use_elevation_map_cloud_publisher_;
   pcl::shared_ptr<grid_map::GridMapPclLoader> grid_map_pcl_loader_;
+  std::string param_file_path_;
+
+  // Each PCD file is converted into a tile which is cached by the hash of the file, so that only
+  // the changed files are converted again
+  bool use_tile_cache_;
+  int tile_processing_threads_;
+  std::filesystem::path elevation_map_tile_directory_;
+  std::string vector_map_hash_;
 
   struct LaneFilter
   {
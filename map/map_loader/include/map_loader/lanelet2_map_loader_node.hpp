@@ -20,6 +20,7 @@
 #include <autoware_lanelet2_msgs/msg/map_bin.hpp>
 
 #include <memory>
+#include <string>
 
 class Lanelet2MapLoaderNode : public rclcpp::Node
 {
@@ -27,6 +28,11 @@ public:
   explicit Lanelet2MapLoaderNode(const rclcpp::NodeOptions & options);
 
 private:
+  /** \brief Parse and project the OSM file and serialize the map into map_bin_msg. */
+  bool loadMap(
+    const std::string & lanelet2_filename, const double center_line_resolution,
+    autoware_lanelet2_msgs::msg::MapBin * map_bin_msg);
+
   rclcpp::Publisher<autoware_lanelet2_msgs::msg::MapBin>::SharedPtr pub_map_bin_;
 };
 
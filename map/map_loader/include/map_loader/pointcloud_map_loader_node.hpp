@@ -31,10 +31,15 @@
 #ifndef MAP_LOADER__POINTCLOUD_MAP_LOADER_NODE_HPP_
 #define MAP_LOADER__POINTCLOUD_MAP_LOADER_NODE_HPP_
 
+#include "map_loader/differential_map_loader_module.hpp"
+
+#include <pointcloud_map_arena/pointcloud_map_arena.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
+#include <std_msgs/msg/string.hpp>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -45,8 +50,14 @@ public:
 
 private:
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr pub_pointcloud_map_;
+  rclcpp::Publisher<std_msgs::msg::String>::SharedPtr pub_pointcloud_map_shared_memory_;
+
+  std::unique_ptr<pointcloud_map_arena::PointCloudMapArenaWriter> arena_writer_;
+  std::unique_ptr<DifferentialMapLoaderModule> differential_map_loader_;
 
   sensor_msgs::msg::PointCloud2 loadPCDFiles(const std::vector<std::string> & pcd_paths);
+  std::unique_ptr<pointcloud_map_arena::PointCloudMapArenaWriter> loadPCDFilesToSharedMemory(
+    const std::vector<std::string> & pcd_paths, const std::string & shared_memory_name);
 };
 
 #endif  // MAP_LOADER__POINTCLOUD_MAP_LOADER_NODE_HPP_
@@ -0,0 +1,57 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MAP_LOADER__POINTCLOUD_MAP_TILE_INDEX_HPP_
+#define MAP_LOADER__POINTCLOUD_MAP_TILE_INDEX_HPP_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct PointCloudMapTile
+{
+  std::string id;  // file name of the PCD
+  std::string path;
+  double min_x;
+  double min_y;
+  double max_x;
+  double max_y;
+};
+
+/** \brief xy bounding boxes of the PCD files of a map. */
+class PointCloudMapTileIndex
+{
+public:
+  void addTile(const PointCloudMapTile & tile);
+
+  const std::vector<PointCloudMapTile> & getTiles() const { return tiles_; }
+  const PointCloudMapTile * findTile(const std::string & id) const;
+
+  /** \brief ids of the tiles whose bounding box is within radius of (x, y). */
+  std::vector<std::string> queryCircle(const double x, const double y, const double radius) const;
+
+  /** \brief Read the bounding boxes from metadata_path, written by save(). The tiles are the
+   * files of pcd_paths, and the ones missing from the metadata are read to compute their
+   * bounding box. Throws std::runtime_error if the metadata cannot be parsed. */
+  static PointCloudMapTileIndex load(
+    const std::string & metadata_path, const std::vector<std::string> & pcd_paths,
+    bool & is_metadata_complete);
+  void save(const std::string & metadata_path) const;
+
+private:
+  std::vector<PointCloudMapTile> tiles_;
+  std::unordered_map<std::string, size_t> id_to_index_;
+};
+
+#endif  // MAP_LOADER__POINTCLOUD_MAP_TILE_INDEX_HPP_
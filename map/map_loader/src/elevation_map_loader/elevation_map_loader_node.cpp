@@ -29,14 +29,20 @@
 #include <hash_library_vendor/md5.h>
 #include <lanelet2_core/geometry/Polygon.h>
 #include <pcl/filters/voxel_grid.h>
+#include <pcl/io/pcd_io.h>
 #include <pcl/pcl_base.h>
 #include <pcl/point_types.h>
 #include <pcl_conversions/pcl_conversions.h>
 #include <sensor_msgs/msg/point_cloud2.h>
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <fstream>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -115,7 +121,7 @@ ElevationMapLoaderNode::ElevationMapLoaderNode(const rclcpp::NodeOptions & optio
 : Node("elevation_map_loader", options)
 {
   layer_name_ = this->declare_parameter("map_layer_name", std::string("elevation"));
-  std::string param_file_path = this->declare_parameter("param_file_path", "path_default");
+  param_file_path_ = this->declare_parameter("param_file_path", "path_default");
   map_frame_ = this->declare_parameter("map_frame", "map");
   use_inpaint_ = this->declare_parameter("use_inpaint", true);
   inpaint_radius_ = this->declare_parameter("inpaint_radius", 0.3);
@@ -130,7 +136,10 @@ ElevationMapLoaderNode::ElevationMapLoaderNode(const rclcpp::NodeOptions & optio
   lane_filter_.voxel_size_z_ = declare_parameter("lane_filter_voxel_size_z", 0.04);
 
   grid_map_pcl_loader_ = pcl::make_shared<grid_map::GridMapPclLoader>(this->get_logger());
-  grid_map_pcl_loader_->loadParameters(param_file_path);
+  grid_map_pcl_loader_->loadParameters(param_file_path_);
+
+  use_tile_cache_ = this->declare_parameter("use_tile_cache", false);
+  tile_processing_threads_ = this->declare_parameter("tile_processing_threads", 4);
 
   rclcpp::QoS durable_qos{1};
   durable_qos.transient_local();
@@ -150,6 +159,7 @@ ElevationMapLoaderNode::ElevationMapLoaderNode(const rclcpp::NodeOptions & optio
   const std::string elevation_map_directory =
     this->declare_parameter("elevation_map_directory", "path_default");
   elevation_map_path_ = std::filesystem::path(elevation_map_directory) / elevation_map_hash;
+  elevation_map_tile_directory_ = std::filesystem::path(elevation_map_directory) / "tiles";
 
   use_elevation_map_file_ = false;
   struct stat info;
@@ -158,9 +168,14 @@ ElevationMapLoaderNode::ElevationMapLoaderNode(const rclcpp::NodeOptions & optio
     already_sub_vector_map_ = false;
     already_sub_pointcloud_map_ = false;
     using std::placeholders::_1;
-    sub_pointcloud_map_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
-      "input/pointcloud_map", durable_qos,
-      std::bind(&ElevationMapLoaderNode::onPointcloudMap, this, _1));
+    if (use_tile_cache_) {
+      // the tiles are converted from the PCD files, not from the published pointcloud map
+      already_sub_pointcloud_map_ = true;
+    } else {
+      sub_pointcloud_map_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
+        "input/pointcloud_map", durable_qos,
+        std::bind(&ElevationMapLoaderNode::onPointcloudMap, this, _1));
+    }
     sub_vector_map_ = this->create_subscription<autoware_lanelet2_msgs::msg::MapBin>(
       "input/vector_map", durable_qos, std::bind(&ElevationMapLoaderNode::onVectorMap, this, _1));
   } else if (info.st_mode & S_IFDIR) {
@@ -195,6 +210,7 @@ void ElevationMapLoaderNode::onVectorMap(
   lanelet::utils::conversion::fromBinMsg(*vector_map, lanelet_map_ptr);
   const lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr);
   lane_filter_.road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
+  vector_map_hash_ = getMd5Sum(std::string(vector_map->data.begin(), vector_map->data.end()));
 
   already_sub_vector_map_ = true;
   if (already_sub_pointcloud_map_) {
@@ -204,7 +220,10 @@ void ElevationMapLoaderNode::onVectorMap(
 
 void ElevationMapLoaderNode::publishElevationMap()
 {
-  if (!use_elevation_map_file_) {
+  if (!use_elevation_map_file_ && use_tile_cache_) {
+    createElevationMapFromTiles();
+    saveElevationMap();
+  } else if (!use_elevation_map_file_) {
     if (lane_filter_.use_lane_filter_) {
       // calculate convex hull
       const auto convex_hull = getConvexHull(map_pcl_ptr_);
@@ -221,7 +240,7 @@ void ElevationMapLoaderNode::publishElevationMap()
     createElevationMapFromPointcloud();
     elevation_map_ = grid_map_pcl_loader_->getGridMap();
     if (use_inpaint_) {
-      inpaintElevationMap(inpaint_radius_);
+      inpaintElevationMap(&elevation_map_, inpaint_radius_);
     }
     saveElevationMap();
   }
@@ -241,6 +260,111 @@ void ElevationMapLoaderNode::publishElevationMap()
   }
 }
 
+void ElevationMapLoaderNode::createElevationMapFromTiles()
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  // a tile depends on its PCD file and on everything else the conversion reads
+  std::ostringstream settings;
+  settings << layer_name_ << use_inpaint_ << inpaint_radius_ << lane_filter_.use_lane_filter_;
+  if (lane_filter_.use_lane_filter_) {
+    settings << lane_filter_.lane_margin_ << lane_filter_.lane_height_diff_thresh_
+             << lane_filter_.voxel_size_x_ << lane_filter_.voxel_size_y_
+             << lane_filter_.voxel_size_z_ << vector_map_hash_;
+  }
+  std::ifstream param_file(param_file_path_);
+  if (param_file) {
+    settings << param_file.rdbuf();
+  }
+  const auto settings_hash = getMd5Sum(settings.str());
+  std::filesystem::create_directories(elevation_map_tile_directory_);
+
+  std::vector<std::filesystem::path> pcd_paths;
+  std::vector<std::filesystem::path> tile_paths;
+  for (const auto & item : hash_json_.items()) {
+    pcd_paths.emplace_back(item.key());
+    tile_paths.push_back(
+      elevation_map_tile_directory_ / getMd5Sum(item.value().get<std::string>() + settings_hash));
+  }
+
+  // convert the tiles missing from the cache in parallel, each with its own loader
+  std::vector<grid_map::GridMap> tiles(pcd_paths.size());
+  std::atomic<size_t> next_tile{0};
+  std::atomic<size_t> num_converted_tiles{0};
+  const auto process_tiles = [&]() {
+    for (size_t i = next_tile++; i < tiles.size(); i = next_tile++) {
+      const auto & tile_path = tile_paths.at(i);
+      if (
+        std::filesystem::is_directory(tile_path) &&
+        grid_map::GridMapRosConverter::loadFromBag(tile_path, "elevation_map", tiles.at(i))) {
+        continue;
+      }
+      tiles.at(i) = createElevationMapTile(pcd_paths.at(i));
+      grid_map::GridMapRosConverter::saveToBag(tiles.at(i), tile_path, "elevation_map");
+      ++num_converted_tiles;
+    }
+  };
+  std::vector<std::thread> threads;
+  const auto num_threads = std::min<size_t>(std::max(tile_processing_threads_, 1), tiles.size());
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back(process_tiles);
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  elevation_map_ = grid_map::GridMap();
+  for (const auto & tile : tiles) {
+    if (!tile.exists(layer_name_)) {
+      continue;
+    }
+    if (elevation_map_.getLayers().empty()) {
+      elevation_map_ = tile;
+    } else {
+      elevation_map_.addDataFrom(tile, true, true, true);
+    }
+  }
+
+  RCLCPP_INFO(
+    this->get_logger(), "Converted %zu of %zu elevation map tiles", num_converted_tiles.load(),
+    tiles.size());
+  grid_map::grid_map_pcl::printTimeElapsedToRosInfoStream(
+    start, "Finish creating elevation map from tiles. Total time: ", this->get_logger());
+}
+
+grid_map::GridMap ElevationMapLoaderNode::createElevationMapTile(
+  const std::filesystem::path & pcd_path)
+{
+  grid_map::GridMap tile;
+  auto cloud = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
+  if (pcl::io::loadPCDFile(pcd_path.string(), *cloud) != 0 || cloud->points.empty()) {
+    RCLCPP_WARN(this->get_logger(), "Failed to load %s", pcd_path.c_str());
+    return tile;
+  }
+
+  if (lane_filter_.use_lane_filter_) {
+    const auto convex_hull = getConvexHull(cloud);
+    const auto intersected_lanelets =
+      getIntersectedLanelets(convex_hull, lane_filter_.road_lanelets_);
+    cloud = getLaneFilteredPointCloud(intersected_lanelets, cloud);
+    if (cloud->points.empty()) {
+      return tile;
+    }
+  }
+
+  grid_map::GridMapPclLoader grid_map_pcl_loader(this->get_logger());
+  grid_map_pcl_loader.loadParameters(param_file_path_);
+  grid_map_pcl_loader.setInputCloud(cloud);
+  grid_map_pcl_loader.preProcessInputCloud();
+  grid_map_pcl_loader.initializeGridMapGeometryFromInputCloud();
+  grid_map_pcl_loader.addLayerFromInputCloud(layer_name_);
+  tile = grid_map_pcl_loader.getGridMap();
+  if (use_inpaint_) {
+    inpaintElevationMap(&tile, inpaint_radius_);
+  }
+  return tile;
+}
+
 void ElevationMapLoaderNode::createElevationMapFromPointcloud()
 {
   const auto start = std::chrono::high_resolution_clock::now();
@@ -251,35 +375,36 @@ void ElevationMapLoaderNode::createElevationMapFromPointcloud()
     start, "Finish creating elevation map. Total time: ", this->get_logger());
 }
 
-void ElevationMapLoaderNode::inpaintElevationMap(const float radius)
+void ElevationMapLoaderNode::inpaintElevationMap(
+  grid_map::GridMap * elevation_map, const float radius)
 {
   // Convert elevation layer to OpenCV image to fill in holes.
   // Get the inpaint mask (nonzero pixels indicate where values need to be filled in).
-  elevation_map_.add("inpaint_mask", 0.0);
+  elevation_map->add("inpaint_mask", 0.0);
 
-  elevation_map_.setBasicLayers(std::vector<std::string>());
-  for (grid_map::GridMapIterator iterator(elevation_map_); !iterator.isPastEnd(); ++iterator) {
-    if (!elevation_map_.isValid(*iterator, layer_name_)) {
-      elevation_map_.at("inpaint_mask", *iterator) = 1.0;
+  elevation_map->setBasicLayers(std::vector<std::string>());
+  for (grid_map::GridMapIterator iterator(*elevation_map); !iterator.isPastEnd(); ++iterator) {
+    if (!elevation_map->isValid(*iterator, layer_name_)) {
+      elevation_map->at("inpaint_mask", *iterator) = 1.0;
     }
   }
   cv::Mat original_image;
   cv::Mat mask;
   cv::Mat filled_image;
-  const float min_value = elevation_map_.get(layer_name_).minCoeffOfFinites();
-  const float max_value = elevation_map_.get(layer_name_).maxCoeffOfFinites();
+  const float min_value = elevation_map->get(layer_name_).minCoeffOfFinites();
+  const float max_value = elevation_map->get(layer_name_).maxCoeffOfFinites();
 
   grid_map::GridMapCvConverter::toImage<unsigned char, 3>(
-    elevation_map_, layer_name_, CV_8UC3, min_value, max_value, original_image);
+    *elevation_map, layer_name_, CV_8UC3, min_value, max_value, original_image);
   grid_map::GridMapCvConverter::toImage<unsigned char, 1>(
-    elevation_map_, "inpaint_mask", CV_8UC1, mask);
+    *elevation_map, "inpaint_mask", CV_8UC1, mask);
 
-  const float radius_in_pixels = radius / elevation_map_.getResolution();
+  const float radius_in_pixels = radius / elevation_map->getResolution();
   cv::inpaint(original_image, mask, filled_image, radius_in_pixels, cv::INPAINT_NS);
 
   grid_map::GridMapCvConverter::addLayerFromImage<unsigned char, 3>(
-    filled_image, layer_name_, elevation_map_, min_value, max_value);
-  elevation_map_.erase("inpaint_mask");
+    filled_image, layer_name_, *elevation_map, min_value, max_value);
+  elevation_map->erase("inpaint_mask");
 }
 
 autoware_utils::LinearRing2d ElevationMapLoaderNode::getConvexHull(
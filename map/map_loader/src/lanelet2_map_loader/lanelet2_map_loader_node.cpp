@@ -34,6 +34,7 @@
 #include "map_loader/lanelet2_map_loader_node.hpp"
 
 #include <lanelet2_extension/io/autoware_osm_parser.hpp>
+#include <lanelet2_extension/io/binary_map_cache.hpp>
 #include <lanelet2_extension/projection/mgrs_projector.hpp>
 #include <lanelet2_extension/utility/message_conversion.hpp>
 #include <lanelet2_extension/utility/utilities.hpp>
@@ -49,6 +50,37 @@ Lanelet2MapLoaderNode::Lanelet2MapLoaderNode(const rclcpp::NodeOptions & options
 : Node("lanelet2_map_loader", options)
 {
   const auto lanelet2_filename = declare_parameter("lanelet2_map_path", "");
+  const auto center_line_resolution = this->declare_parameter("center_line_resolution", 5.0);
+  const auto lanelet2_map_cache_path = declare_parameter("lanelet2_map_cache_path", "");
+
+  autoware_lanelet2_msgs::msg::MapBin map_bin_msg;
+  if (
+    !lanelet2_map_cache_path.empty() &&
+    lanelet::io_handlers::BinaryMapCache::read(
+      lanelet2_map_cache_path, lanelet2_filename, center_line_resolution, &map_bin_msg)) {
+    RCLCPP_INFO_STREAM(this->get_logger(), "Loaded lanelet2 map cache " << lanelet2_map_cache_path);
+  } else if (!loadMap(lanelet2_filename, center_line_resolution, &map_bin_msg)) {
+    return;
+  } else if (
+    !lanelet2_map_cache_path.empty() &&
+    !lanelet::io_handlers::BinaryMapCache::write(
+      lanelet2_map_cache_path, lanelet2_filename, center_line_resolution, map_bin_msg)) {
+    RCLCPP_WARN_STREAM(
+      this->get_logger(), "Failed to write lanelet2 map cache " << lanelet2_map_cache_path);
+  }
+
+  pub_map_bin_ = this->create_publisher<autoware_lanelet2_msgs::msg::MapBin>(
+    "output/lanelet2_map", rclcpp::QoS{1}.transient_local());
+
+  map_bin_msg.header.stamp = this->now();
+  map_bin_msg.header.frame_id = "map";
+  pub_map_bin_->publish(map_bin_msg);
+}
+
+bool Lanelet2MapLoaderNode::loadMap(
+  const std::string & lanelet2_filename, const double center_line_resolution,
+  autoware_lanelet2_msgs::msg::MapBin * map_bin_msg)
+{
   lanelet::ErrorMessages errors{};
   lanelet::projection::MGRSProjector projector{};
   lanelet::LaneletMapPtr map = lanelet::load(lanelet2_filename, projector, &errors);
@@ -57,27 +89,15 @@ Lanelet2MapLoaderNode::Lanelet2MapLoaderNode(const rclcpp::NodeOptions & options
     RCLCPP_ERROR_STREAM(this->get_logger(), error);
   }
   if (!errors.empty()) {
-    return;
+    return false;
   }
 
-  const auto center_line_resolution = this->declare_parameter("center_line_resolution", 5.0);
   lanelet::utils::overwriteLaneletsCenterline(map, center_line_resolution, false);
 
-  std::string format_version{}, map_version{};
   lanelet::io_handlers::AutowareOsmParser::parseVersions(
-    lanelet2_filename, &format_version, &map_version);
-
-  pub_map_bin_ = this->create_publisher<autoware_lanelet2_msgs::msg::MapBin>(
-    "output/lanelet2_map", rclcpp::QoS{1}.transient_local());
-
-  autoware_lanelet2_msgs::msg::MapBin map_bin_msg;
-  map_bin_msg.header.stamp = this->now();
-  map_bin_msg.header.frame_id = "map";
-  map_bin_msg.format_version = format_version;
-  map_bin_msg.map_version = map_version;
-  lanelet::utils::conversion::toBinMsg(map, &map_bin_msg);
-
-  pub_map_bin_->publish(map_bin_msg);
+    lanelet2_filename, &map_bin_msg->format_version, &map_bin_msg->map_version);
+  lanelet::utils::conversion::toBinMsg(map, map_bin_msg);
+  return true;
 }
 
 #include <rclcpp_components/register_node_macro.hpp>
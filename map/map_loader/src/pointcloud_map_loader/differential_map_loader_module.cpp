@@ -0,0 +1,266 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "map_loader/differential_map_loader_module.hpp"
+
+#include <pcl/io/pcd_io.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+double calcDistance2d(const geometry_msgs::msg::Point & a, const geometry_msgs::msg::Point & b)
+{
+  return std::hypot(a.x - b.x, a.y - b.y);
+}
+}  // namespace
+
+DifferentialMapLoaderModule::DifferentialMapLoaderModule(
+  rclcpp::Node * node, const PointCloudMapTileIndex & tile_index)
+: logger_(node->get_logger().get_child("differential_map_loader")),
+  tile_index_(tile_index),
+  has_keep_position_(false),
+  is_prefetch_thread_stopped_(false)
+{
+  keep_radius_ = node->declare_parameter("differential_map_keep_radius", 300.0);
+  prefetch_distance_ = node->declare_parameter("differential_map_prefetch_distance", 500.0);
+
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+  srv_get_differential_pointcloud_map_ = node->create_service<GetDifferentialPointCloudMap>(
+    "service/get_differential_pointcloud_map",
+    std::bind(&DifferentialMapLoaderModule::onGetDifferentialPointCloudMap, this, _1, _2));
+  sub_pose_ = node->create_subscription<geometry_msgs::msg::PoseStamped>(
+    "input/pose", rclcpp::QoS{1}, std::bind(&DifferentialMapLoaderModule::onPose, this, _1));
+  sub_route_ = node->create_subscription<autoware_planning_msgs::msg::Route>(
+    "input/route", rclcpp::QoS{1}.transient_local(),
+    std::bind(&DifferentialMapLoaderModule::onRoute, this, _1));
+  sub_map_bin_ = node->create_subscription<autoware_lanelet2_msgs::msg::MapBin>(
+    "input/vector_map", rclcpp::QoS{1}.transient_local(),
+    std::bind(&DifferentialMapLoaderModule::onMapBin, this, _1));
+
+  prefetch_thread_ = std::thread(&DifferentialMapLoaderModule::prefetchThread, this);
+}
+
+DifferentialMapLoaderModule::~DifferentialMapLoaderModule()
+{
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    is_prefetch_thread_stopped_ = true;
+  }
+  prefetch_cv_.notify_one();
+  prefetch_thread_.join();
+}
+
+void DifferentialMapLoaderModule::onGetDifferentialPointCloudMap(
+  const GetDifferentialPointCloudMap::Request::SharedPtr req,
+  GetDifferentialPointCloudMap::Response::SharedPtr res)
+{
+  const auto ids = tile_index_.queryCircle(req->position.x, req->position.y, req->radius);
+  const std::set<std::string> ids_in_area(ids.begin(), ids.end());
+  const std::set<std::string> cached_ids(req->cached_ids.begin(), req->cached_ids.end());
+
+  for (const auto & id : ids) {
+    if (cached_ids.count(id)) {
+      continue;
+    }
+    const auto tile_ptr = getTile(id);
+    if (!tile_ptr) {
+      continue;
+    }
+    res->new_ids.push_back(id);
+    res->new_pointclouds.push_back(*tile_ptr);
+  }
+  for (const auto & id : cached_ids) {
+    if (!ids_in_area.count(id)) {
+      res->ids_to_remove.push_back(id);
+    }
+  }
+
+  RCLCPP_DEBUG(
+    logger_, "differential map: %zu new tiles, %zu tiles to remove", res->new_ids.size(),
+    res->ids_to_remove.size());
+}
+
+void DifferentialMapLoaderModule::onPose(const geometry_msgs::msg::PoseStamped::ConstSharedPtr msg)
+{
+  // the tiles are large compared to the distance driven between two poses
+  const auto & position = msg->pose.position;
+  if (has_keep_position_ && calcDistance2d(position, last_keep_position_) < 0.1 * keep_radius_) {
+    return;
+  }
+  last_keep_position_ = position;
+  has_keep_position_ = true;
+
+  const auto ids_to_keep = getTilesToKeep(position);
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    for (auto it = cache_.begin(); it != cache_.end();) {
+      it = ids_to_keep.count(it->first) ? std::next(it) : cache_.erase(it);
+    }
+    prefetch_queue_.clear();
+    for (const auto & id : ids_to_keep) {
+      if (!cache_.count(id)) {
+        prefetch_queue_.push_back(id);
+      }
+    }
+  }
+  prefetch_cv_.notify_one();
+}
+
+void DifferentialMapLoaderModule::onRoute(
+  const autoware_planning_msgs::msg::Route::ConstSharedPtr msg)
+{
+  route_ptr_ = msg;
+  updateRoutePoints();
+  has_keep_position_ = false;
+}
+
+void DifferentialMapLoaderModule::onMapBin(
+  const autoware_lanelet2_msgs::msg::MapBin::ConstSharedPtr msg)
+{
+  lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
+  lanelet::utils::conversion::fromBinMsg(*msg, lanelet_map_ptr_);
+  updateRoutePoints();
+  has_keep_position_ = false;
+}
+
+void DifferentialMapLoaderModule::updateRoutePoints()
+{
+  route_points_.clear();
+  if (!lanelet_map_ptr_ || !route_ptr_) {
+    return;
+  }
+  for (const auto & route_section : route_ptr_->route_sections) {
+    if (!lanelet_map_ptr_->laneletLayer.exists(route_section.preferred_lane_id)) {
+      continue;
+    }
+    const auto lanelet = lanelet_map_ptr_->laneletLayer.get(route_section.preferred_lane_id);
+    for (const auto & p : lanelet.centerline()) {
+      geometry_msgs::msg::Point point;
+      point.x = p.x();
+      point.y = p.y();
+      point.z = p.z();
+      route_points_.push_back(point);
+    }
+  }
+}
+
+std::set<std::string> DifferentialMapLoaderModule::getTilesToKeep(
+  const geometry_msgs::msg::Point & position) const
+{
+  std::set<std::string> ids;
+  const auto add_tiles_around = [this, &ids](const geometry_msgs::msg::Point & p) {
+    for (const auto & id : tile_index_.queryCircle(p.x, p.y, keep_radius_)) {
+      ids.insert(id);
+    }
+  };
+  add_tiles_around(position);
+  if (route_points_.empty()) {
+    return ids;
+  }
+
+  size_t nearest_index = 0;
+  double min_distance = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < route_points_.size(); ++i) {
+    const double distance = calcDistance2d(position, route_points_[i]);
+    if (distance < min_distance) {
+      min_distance = distance;
+      nearest_index = i;
+    }
+  }
+
+  // one query every half radius covers the route without gaps
+  double distance_ahead = 0.0;
+  double distance_from_query = std::numeric_limits<double>::max();
+  for (size_t i = nearest_index; i < route_points_.size(); ++i) {
+    if (i > nearest_index) {
+      const double step = calcDistance2d(route_points_[i - 1], route_points_[i]);
+      distance_ahead += step;
+      distance_from_query += step;
+    }
+    if (distance_ahead > prefetch_distance_) {
+      break;
+    }
+    if (distance_from_query >= 0.5 * keep_radius_) {
+      add_tiles_around(route_points_[i]);
+      distance_from_query = 0.0;
+    }
+  }
+  return ids;
+}
+
+sensor_msgs::msg::PointCloud2::ConstSharedPtr DifferentialMapLoaderModule::getTile(
+  const std::string & id)
+{
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    const auto it = cache_.find(id);
+    if (it != cache_.end()) {
+      return it->second;
+    }
+  }
+  const auto tile_ptr = loadTile(id);
+  if (tile_ptr) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    cache_.emplace(id, tile_ptr);
+  }
+  return tile_ptr;
+}
+
+sensor_msgs::msg::PointCloud2::ConstSharedPtr DifferentialMapLoaderModule::loadTile(
+  const std::string & id) const
+{
+  const auto tile = tile_index_.findTile(id);
+  if (tile == nullptr) {
+    return nullptr;
+  }
+  auto pointcloud_ptr = std::make_shared<sensor_msgs::msg::PointCloud2>();
+  if (pcl::io::loadPCDFile(tile->path, *pointcloud_ptr) == -1) {
+    RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << tile->path);
+    return nullptr;
+  }
+  pointcloud_ptr->header.frame_id = "map";
+  return pointcloud_ptr;
+}
+
+void DifferentialMapLoaderModule::prefetchThread()
+{
+  while (true) {
+    std::string id;
+    {
+      std::unique_lock<std::mutex> lock(cache_mutex_);
+      prefetch_cv_.wait(
+        lock, [this] { return is_prefetch_thread_stopped_ || !prefetch_queue_.empty(); });
+      if (is_prefetch_thread_stopped_) {
+        return;
+      }
+      id = prefetch_queue_.front();
+      prefetch_queue_.pop_front();
+      if (cache_.count(id)) {
+        continue;
+      }
+    }
+    getTile(id);
+  }
+}
@@ -35,6 +35,8 @@
 #include <pcl_conversions/pcl_conversions.h>
 #include <rcutils/filesystem.h>  // To be replaced by std::filesystem in C++17
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -88,6 +90,50 @@ PointCloudMapLoaderNode::PointCloudMapLoaderNode(const rclcpp::NodeOptions & opt
     }
   }
 
+  // the shared memory map is loaded once for all the nodes reading it,
+  // instead of being copied into every subscriber of output/pointcloud_map
+  const auto use_shared_memory_map = declare_parameter("use_shared_memory_map", false);
+  const auto shared_memory_map_name =
+    declare_parameter("shared_memory_map_name", std::string("/pointcloud_map"));
+  const auto publish_pointcloud_map = declare_parameter("publish_pointcloud_map", true);
+
+  if (use_shared_memory_map) {
+    pub_pointcloud_map_shared_memory_ = this->create_publisher<std_msgs::msg::String>(
+      "output/pointcloud_map_shared_memory", durable_qos);
+    try {
+      arena_writer_ = loadPCDFilesToSharedMemory(pcd_paths, shared_memory_map_name);
+    } catch (const std::runtime_error & e) {
+      RCLCPP_ERROR_STREAM(get_logger(), "Shared memory map was not created: " << e.what());
+    }
+    if (arena_writer_) {
+      std_msgs::msg::String shared_memory_msg;
+      shared_memory_msg.data = arena_writer_->getName();
+      pub_pointcloud_map_shared_memory_->publish(shared_memory_msg);
+    }
+  }
+
+  // the tiles around a position are served on request, without loading the whole map
+  const auto enable_differential_load = declare_parameter("enable_differential_load", false);
+  const auto pcd_metadata_path = declare_parameter("pcd_metadata_path", std::string(""));
+  if (enable_differential_load) {
+    try {
+      bool is_metadata_complete = false;
+      const auto tile_index =
+        PointCloudMapTileIndex::load(pcd_metadata_path, pcd_paths, is_metadata_complete);
+      if (!is_metadata_complete && !pcd_metadata_path.empty()) {
+        RCLCPP_INFO_STREAM(get_logger(), "Writing PCD tile metadata: " << pcd_metadata_path);
+        tile_index.save(pcd_metadata_path);
+      }
+      differential_map_loader_ = std::make_unique<DifferentialMapLoaderModule>(this, tile_index);
+    } catch (const std::runtime_error & e) {
+      RCLCPP_ERROR_STREAM(get_logger(), "Differential map loading is disabled: " << e.what());
+    }
+  }
+
+  if (!publish_pointcloud_map) {
+    return;
+  }
+
   const auto pcd = loadPCDFiles(pcd_paths);
 
   if (pcd.width == 0) {
@@ -124,5 +170,52 @@ sensor_msgs::msg::PointCloud2 PointCloudMapLoaderNode::loadPCDFiles(
   return whole_pcd;
 }
 
+std::unique_ptr<pointcloud_map_arena::PointCloudMapArenaWriter>
+PointCloudMapLoaderNode::loadPCDFilesToSharedMemory(
+  const std::vector<std::string> & pcd_paths, const std::string & shared_memory_name)
+{
+  // the headers give the size of the segment, so that each file is read only once
+  pcl::PCDReader reader;
+  std::vector<uint64_t> tile_capacities;
+  for (const auto & path : pcd_paths) {
+    pcl::PCLPointCloud2 header;
+    if (reader.readHeader(path, header) != 0) {
+      RCLCPP_ERROR_STREAM(get_logger(), "PCD header read failed: " << path);
+      tile_capacities.push_back(0);
+      continue;
+    }
+    tile_capacities.push_back(static_cast<uint64_t>(header.width) * header.height);
+  }
+
+  auto writer = std::make_unique<pointcloud_map_arena::PointCloudMapArenaWriter>(
+    shared_memory_name, tile_capacities, "map");
+
+  pcl::PointCloud<pcl::PointXYZ> tile;
+  for (size_t i = 0; i < pcd_paths.size(); ++i) {
+    const auto & path = pcd_paths[i];
+    writer->setTileName(i, path.substr(path.find_last_of('/') + 1));
+    if (tile_capacities[i] == 0) {
+      writer->setTileSize(i, 0);
+      continue;
+    }
+    if (pcl::io::loadPCDFile(path, tile) == -1) {
+      RCLCPP_ERROR_STREAM(get_logger(), "PCD load failed: " << path);
+      writer->setTileSize(i, 0);
+      continue;
+    }
+
+    const size_t size = std::min(static_cast<uint64_t>(tile.points.size()), tile_capacities[i]);
+    auto * points = writer->getTilePoints(i);
+    for (size_t j = 0; j < size; ++j) {
+      const auto & p = tile.points[j];
+      points[j] = pointcloud_map_arena::Point{p.x, p.y, p.z, 1.0f};
+    }
+    writer->setTileSize(i, size);
+  }
+  writer->finalize();
+
+  return writer;
+}
+
 #include <rclcpp_components/register_node_macro.hpp>
 RCLCPP_COMPONENTS_REGISTER_NODE(PointCloudMapLoaderNode)
@@ -0,0 +1,134 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "map_loader/pointcloud_map_tile_index.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <pcl/io/pcd_io.h>
+#include <pcl/point_types.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+bool computeBoundingBox(PointCloudMapTile & tile)
+{
+  pcl::PointCloud<pcl::PointXYZ> points;
+  if (pcl::io::loadPCDFile(tile.path, points) == -1) {
+    return false;
+  }
+  tile.min_x = tile.min_y = std::numeric_limits<double>::max();
+  tile.max_x = tile.max_y = std::numeric_limits<double>::lowest();
+  for (const auto & p : points.points) {
+    if (!std::isfinite(p.x) || !std::isfinite(p.y)) {
+      continue;
+    }
+    tile.min_x = std::min(tile.min_x, static_cast<double>(p.x));
+    tile.min_y = std::min(tile.min_y, static_cast<double>(p.y));
+    tile.max_x = std::max(tile.max_x, static_cast<double>(p.x));
+    tile.max_y = std::max(tile.max_y, static_cast<double>(p.y));
+  }
+  return tile.min_x <= tile.max_x;
+}
+}  // namespace
+
+void PointCloudMapTileIndex::addTile(const PointCloudMapTile & tile)
+{
+  const auto it = id_to_index_.find(tile.id);
+  if (it != id_to_index_.end()) {
+    tiles_[it->second] = tile;
+    return;
+  }
+  id_to_index_.emplace(tile.id, tiles_.size());
+  tiles_.push_back(tile);
+}
+
+const PointCloudMapTile * PointCloudMapTileIndex::findTile(const std::string & id) const
+{
+  const auto it = id_to_index_.find(id);
+  return it == id_to_index_.end() ? nullptr : &tiles_[it->second];
+}
+
+std::vector<std::string> PointCloudMapTileIndex::queryCircle(
+  const double x, const double y, const double radius) const
+{
+  std::vector<std::string> ids;
+  for (const auto & tile : tiles_) {
+    // distance from (x, y) to the closest point of the box
+    const double dx = std::max({tile.min_x - x, 0.0, x - tile.max_x});
+    const double dy = std::max({tile.min_y - y, 0.0, y - tile.max_y});
+    if (dx * dx + dy * dy <= radius * radius) {
+      ids.push_back(tile.id);
+    }
+  }
+  return ids;
+}
+
+PointCloudMapTileIndex PointCloudMapTileIndex::load(
+  const std::string & metadata_path, const std::vector<std::string> & pcd_paths,
+  bool & is_metadata_complete)
+{
+  nlohmann::json metadata = nlohmann::json::object();
+  if (!metadata_path.empty() && std::filesystem::exists(metadata_path)) {
+    std::ifstream ifs(metadata_path);
+    try {
+      ifs >> metadata;
+    } catch (const nlohmann::json::exception & e) {
+      throw std::runtime_error(
+        "invalid pointcloud map metadata " + metadata_path + ": " + e.what());
+    }
+  }
+
+  is_metadata_complete = true;
+  PointCloudMapTileIndex index;
+  for (const auto & path : pcd_paths) {
+    PointCloudMapTile tile;
+    tile.id = std::filesystem::path(path).filename().string();
+    tile.path = path;
+
+    const auto it = metadata.find(tile.id);
+    if (it != metadata.end() && it->is_array() && it->size() == 4) {
+      tile.min_x = (*it)[0].get<double>();
+      tile.min_y = (*it)[1].get<double>();
+      tile.max_x = (*it)[2].get<double>();
+      tile.max_y = (*it)[3].get<double>();
+    } else {
+      is_metadata_complete = false;
+      if (!computeBoundingBox(tile)) {
+        continue;
+      }
+    }
+    index.addTile(tile);
+  }
+  return index;
+}
+
+void PointCloudMapTileIndex::save(const std::string & metadata_path) const
+{
+  // {"<file name>": [min_x, min_y, max_x, max_y], ...}
+  nlohmann::json metadata = nlohmann::json::object();
+  for (const auto & tile : tiles_) {
+    metadata[tile.id] = {tile.min_x, tile.min_y, tile.max_x, tile.max_y};
+  }
+  std::ofstream ofs(metadata_path);
+  ofs << metadata.dump(2);
+}
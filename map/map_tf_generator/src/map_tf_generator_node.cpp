@@ -15,20 +15,18 @@
 #include <rclcpp/rclcpp.hpp>
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 
-#include <pcl/point_cloud.h>
-#include <pcl/point_types.h>
-#include <pcl_conversions/pcl_conversions.h>
 #include <tf2/LinearMath/Quaternion.h>
 #include <tf2_ros/static_transform_broadcaster.h>
 
+#include <cmath>
 #include <memory>
 #include <string>
 
 class MapTFGeneratorNode : public rclcpp::Node
 {
 public:
-  using PointCloud = pcl::PointCloud<pcl::PointXYZ>;
   explicit MapTFGeneratorNode(const rclcpp::NodeOptions & options)
   : Node("map_tf_generator", options)
   {
@@ -51,15 +49,24 @@ private:
 
   void onPointCloud(const sensor_msgs::msg::PointCloud2::ConstSharedPtr clouds_ros)
   {
-    PointCloud clouds;
-    pcl::fromROSMsg<pcl::PointXYZ>(*clouds_ros, clouds);
-
-    const unsigned int sum = clouds.points.size();
+    // average the points on the serialized buffer, to avoid another copy of the whole map
+    size_t sum = 0;
     double coordinate[3] = {0, 0, 0};
-    for (unsigned int i = 0; i < sum; i++) {
-      coordinate[0] += clouds.points[i].x;
-      coordinate[1] += clouds.points[i].y;
-      coordinate[2] += clouds.points[i].z;
+    sensor_msgs::PointCloud2ConstIterator<float> iter_x(*clouds_ros, "x");
+    sensor_msgs::PointCloud2ConstIterator<float> iter_y(*clouds_ros, "y");
+    sensor_msgs::PointCloud2ConstIterator<float> iter_z(*clouds_ros, "z");
+    for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+      if (!std::isfinite(*iter_x) || !std::isfinite(*iter_y) || !std::isfinite(*iter_z)) {
+        continue;
+      }
+      coordinate[0] += *iter_x;
+      coordinate[1] += *iter_y;
+      coordinate[2] += *iter_z;
+      ++sum;
+    }
+    if (sum == 0) {
+      RCLCPP_WARN(get_logger(), "pointcloud_map has no valid point, skip broadcasting tf");
+      return;
     }
     coordinate[0] = coordinate[0] / sum;
     coordinate[1] = coordinate[1] / sum;
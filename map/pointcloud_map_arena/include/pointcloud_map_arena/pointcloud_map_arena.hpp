@@ -0,0 +1,137 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_MAP_ARENA__POINTCLOUD_MAP_ARENA_HPP_
+#define POINTCLOUD_MAP_ARENA__POINTCLOUD_MAP_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pointcloud_map_arena
+{
+/** \brief A map point. The layout is the one of pcl::PointXYZ: x, y, z and one float of padding.
+ */
+struct Point
+{
+  float x;
+  float y;
+  float z;
+  float padding;
+};
+
+struct BoundingBox
+{
+  float min_x;
+  float min_y;
+  float min_z;
+  float max_x;
+  float max_y;
+  float max_z;
+
+  bool intersects(const BoundingBox & other) const;
+  bool contains(const Point & p) const;
+};
+
+/** \brief Points of the arena, valid as long as the PointCloudMapArena that returned them. */
+struct PointsView
+{
+  const Point * data;
+  size_t size;
+
+  const Point * begin() const { return data; }
+  const Point * end() const { return data + size; }
+};
+
+/** \brief A tile is the points of one map file. */
+struct TileInfo
+{
+  static constexpr size_t MAX_NAME_LENGTH = 128;
+
+  BoundingBox bounding_box;
+  uint64_t begin;     // index of the first point of the tile
+  uint64_t size;      // number of points
+  uint64_t capacity;  // number of points allocated for the tile
+  char name[MAX_NAME_LENGTH];
+};
+
+/** \brief Creates the shared memory segment of a map and fills it. The segment is removed when
+ * the writer is destroyed. Processes that mapped it keep a valid mapping until they unmap it.
+ */
+class PointCloudMapArenaWriter
+{
+public:
+  /** \brief Create the segment name (e.g. "/pointcloud_map") with tile_capacities.size() tiles,
+   * replacing any previous segment of the same name. Throws std::runtime_error on failure. */
+  PointCloudMapArenaWriter(
+    const std::string & name, const std::vector<uint64_t> & tile_capacities,
+    const std::string & frame_id);
+  ~PointCloudMapArenaWriter();
+  PointCloudMapArenaWriter(const PointCloudMapArenaWriter &) = delete;
+  PointCloudMapArenaWriter & operator=(const PointCloudMapArenaWriter &) = delete;
+
+  const std::string & getName() const { return name_; }
+  size_t getNumTiles() const;
+
+  /** \brief Storage of the capacity of tile i given to the constructor. */
+  Point * getTilePoints(const size_t i);
+  void setTileName(const size_t i, const std::string & tile_name);
+  /** \brief Number of points of tile i actually written, at most its capacity. */
+  void setTileSize(const size_t i, const uint64_t size);
+
+  /** \brief Compute the bounding boxes of the tiles and publish the arena to readers. Readers
+   * fail to open the segment before. */
+  void finalize();
+
+private:
+  std::string name_;
+  void * data_;
+  size_t data_size_;
+};
+
+/** \brief Read-only view of a map written by PointCloudMapArenaWriter. The points are not
+ * copied, they are read from the shared memory mapping.
+ */
+class PointCloudMapArena
+{
+public:
+  /** \brief Map the segment name. Throws std::runtime_error if it does not exist, is not
+   * finalized or was written by another version. */
+  explicit PointCloudMapArena(const std::string & name);
+  ~PointCloudMapArena();
+  PointCloudMapArena(const PointCloudMapArena &) = delete;
+  PointCloudMapArena & operator=(const PointCloudMapArena &) = delete;
+
+  const std::string & getName() const { return name_; }
+  std::string getFrameId() const;
+  uint64_t getNumPoints() const;
+
+  size_t getNumTiles() const;
+  const TileInfo & getTile(const size_t i) const;
+  PointsView getTilePoints(const size_t i) const;
+
+  /** \brief Indices of the tiles whose bounding box intersects box. */
+  std::vector<size_t> queryTiles(const BoundingBox & box) const;
+  /** \brief Copy of the points inside box. */
+  std::vector<Point> queryPoints(const BoundingBox & box) const;
+
+private:
+  std::string name_;
+  const void * data_;
+  size_t data_size_;
+};
+}  // namespace pointcloud_map_arena
+
+#endif  // POINTCLOUD_MAP_ARENA__POINTCLOUD_MAP_ARENA_HPP_
@@ -0,0 +1,286 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_map_arena/pointcloud_map_arena.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pointcloud_map_arena
+{
+namespace
+{
+constexpr char MAGIC[8] = {'P', 'C', 'M', 'A', 'R', 'E', 'N', 'A'};
+constexpr uint32_t VERSION = 1;
+
+/** \brief Start of the segment, followed by the tiles and the points. */
+struct Header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t is_finalized;
+  uint64_t num_tiles;
+  uint64_t num_points;
+  uint64_t tiles_offset;
+  uint64_t points_offset;
+  uint64_t total_size;
+  char frame_id[64];
+};
+
+size_t alignUp(const size_t size, const size_t alignment)
+{
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+std::runtime_error makeError(const std::string & message, const std::string & name)
+{
+  return std::runtime_error(message + " " + name + ": " + std::strerror(errno));
+}
+
+const Header & getHeader(const void * data) { return *static_cast<const Header *>(data); }
+
+const TileInfo * getTiles(const void * data)
+{
+  return reinterpret_cast<const TileInfo *>(
+    static_cast<const char *>(data) + getHeader(data).tiles_offset);
+}
+
+const Point * getPoints(const void * data)
+{
+  return reinterpret_cast<const Point *>(
+    static_cast<const char *>(data) + getHeader(data).points_offset);
+}
+}  // namespace
+
+bool BoundingBox::intersects(const BoundingBox & other) const
+{
+  return min_x <= other.max_x && other.min_x <= max_x && min_y <= other.max_y &&
+         other.min_y <= max_y && min_z <= other.max_z && other.min_z <= max_z;
+}
+
+bool BoundingBox::contains(const Point & p) const
+{
+  return min_x <= p.x && p.x <= max_x && min_y <= p.y && p.y <= max_y && min_z <= p.z &&
+         p.z <= max_z;
+}
+
+PointCloudMapArenaWriter::PointCloudMapArenaWriter(
+  const std::string & name, const std::vector<uint64_t> & tile_capacities,
+  const std::string & frame_id)
+: name_(name), data_(nullptr), data_size_(0)
+{
+  uint64_t num_points = 0;
+  for (const auto capacity : tile_capacities) {
+    num_points += capacity;
+  }
+  const size_t tiles_offset = alignUp(sizeof(Header), 64);
+  const size_t points_offset =
+    alignUp(tiles_offset + sizeof(TileInfo) * tile_capacities.size(), 64);
+  data_size_ = points_offset + sizeof(Point) * num_points;
+
+  // a segment left behind by a crashed writer is replaced
+  shm_unlink(name_.c_str());
+  const int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    throw makeError("failed to create the shared memory", name_);
+  }
+  if (ftruncate(fd, static_cast<off_t>(data_size_)) != 0) {
+    const auto error = makeError("failed to allocate the shared memory", name_);
+    close(fd);
+    shm_unlink(name_.c_str());
+    throw error;
+  }
+  void * data = mmap(nullptr, data_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    const auto error = makeError("failed to map the shared memory", name_);
+    close(fd);
+    shm_unlink(name_.c_str());
+    throw error;
+  }
+  close(fd);
+  data_ = data;
+
+  Header & header = *static_cast<Header *>(data_);
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.is_finalized = 0;
+  header.num_tiles = tile_capacities.size();
+  header.num_points = num_points;
+  header.tiles_offset = tiles_offset;
+  header.points_offset = points_offset;
+  header.total_size = data_size_;
+  std::strncpy(header.frame_id, frame_id.c_str(), sizeof(header.frame_id) - 1);
+  header.frame_id[sizeof(header.frame_id) - 1] = '\0';
+
+  TileInfo * tiles = const_cast<TileInfo *>(getTiles(data_));
+  uint64_t begin = 0;
+  for (size_t i = 0; i < tile_capacities.size(); ++i) {
+    tiles[i] = TileInfo{};
+    tiles[i].begin = begin;
+    tiles[i].size = tile_capacities[i];
+    tiles[i].capacity = tile_capacities[i];
+    begin += tile_capacities[i];
+  }
+}
+
+PointCloudMapArenaWriter::~PointCloudMapArenaWriter()
+{
+  munmap(data_, data_size_);
+  shm_unlink(name_.c_str());
+}
+
+size_t PointCloudMapArenaWriter::getNumTiles() const { return getHeader(data_).num_tiles; }
+
+Point * PointCloudMapArenaWriter::getTilePoints(const size_t i)
+{
+  return const_cast<Point *>(getPoints(data_)) + getTiles(data_)[i].begin;
+}
+
+void PointCloudMapArenaWriter::setTileName(const size_t i, const std::string & tile_name)
+{
+  TileInfo & tile = const_cast<TileInfo *>(getTiles(data_))[i];
+  std::strncpy(tile.name, tile_name.c_str(), TileInfo::MAX_NAME_LENGTH - 1);
+  tile.name[TileInfo::MAX_NAME_LENGTH - 1] = '\0';
+}
+
+void PointCloudMapArenaWriter::setTileSize(const size_t i, const uint64_t size)
+{
+  TileInfo & tile = const_cast<TileInfo *>(getTiles(data_))[i];
+  tile.size = std::min(size, tile.capacity);
+}
+
+void PointCloudMapArenaWriter::finalize()
+{
+  Header & header = *static_cast<Header *>(data_);
+  TileInfo * tiles = const_cast<TileInfo *>(getTiles(data_));
+  const Point * points = getPoints(data_);
+
+  header.num_points = 0;
+  for (size_t i = 0; i < header.num_tiles; ++i) {
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    BoundingBox box{inf, inf, inf, -inf, -inf, -inf};
+    for (uint64_t j = tiles[i].begin; j < tiles[i].begin + tiles[i].size; ++j) {
+      const Point & p = points[j];
+      if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+        continue;
+      }
+      box.min_x = std::min(box.min_x, p.x);
+      box.min_y = std::min(box.min_y, p.y);
+      box.min_z = std::min(box.min_z, p.z);
+      box.max_x = std::max(box.max_x, p.x);
+      box.max_y = std::max(box.max_y, p.y);
+      box.max_z = std::max(box.max_z, p.z);
+    }
+    tiles[i].bounding_box = box;
+    header.num_points += tiles[i].size;
+  }
+
+  // readers check is_finalized before reading anything else
+  std::atomic_thread_fence(std::memory_order_release);
+  header.is_finalized = 1;
+  msync(data_, data_size_, MS_ASYNC);
+}
+
+PointCloudMapArena::PointCloudMapArena(const std::string & name)
+: name_(name), data_(nullptr), data_size_(0)
+{
+  const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw makeError("failed to open the shared memory", name_);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+    close(fd);
+    throw std::runtime_error("invalid shared memory " + name_);
+  }
+  data_size_ = static_cast<size_t>(st.st_size);
+  void * data = mmap(nullptr, data_size_, PROT_READ, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    const auto error = makeError("failed to map the shared memory", name_);
+    close(fd);
+    throw error;
+  }
+  close(fd);
+  data_ = data;
+
+  const Header & header = getHeader(data_);
+  std::string error;
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+    error = "not a pointcloud map arena";
+  } else if (header.version != VERSION) {
+    error = "unsupported version " + std::to_string(header.version);
+  } else if (header.total_size != data_size_) {
+    error = "unexpected size";
+  } else if (!header.is_finalized) {
+    error = "not finalized";
+  }
+  if (!error.empty()) {
+    munmap(const_cast<void *>(data_), data_size_);
+    throw std::runtime_error("shared memory " + name_ + ": " + error);
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+}
+
+PointCloudMapArena::~PointCloudMapArena() { munmap(const_cast<void *>(data_), data_size_); }
+
+std::string PointCloudMapArena::getFrameId() const { return getHeader(data_).frame_id; }
+
+uint64_t PointCloudMapArena::getNumPoints() const { return getHeader(data_).num_points; }
+
+size_t PointCloudMapArena::getNumTiles() const { return getHeader(data_).num_tiles; }
+
+const TileInfo & PointCloudMapArena::getTile(const size_t i) const { return getTiles(data_)[i]; }
+
+PointsView PointCloudMapArena::getTilePoints(const size_t i) const
+{
+  const TileInfo & tile = getTile(i);
+  return PointsView{getPoints(data_) + tile.begin, tile.size};
+}
+
+std::vector<size_t> PointCloudMapArena::queryTiles(const BoundingBox & box) const
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < getNumTiles(); ++i) {
+    if (getTile(i).bounding_box.intersects(box)) {
+      indices.push_back(i);
+    }
+  }
+  return indices;
+}
+
+std::vector<Point> PointCloudMapArena::queryPoints(const BoundingBox & box) const
+{
+  std::vector<Point> points;
+  for (const size_t i : queryTiles(box)) {
+    for (const auto & p : getTilePoints(i)) {
+      if (box.contains(p)) {
+        points.push_back(p);
+      }
+    }
+  }
+  return points;
+}
+}  // namespace pointcloud_map_arena
@@ -0,0 +1,73 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef BEV_OPTICAL_FLOW__CUDA__BEV_RASTERIZER_HPP_
+#define BEV_OPTICAL_FLOW__CUDA__BEV_RASTERIZER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// This header does not depend on CUDA so that it can be included from regular translation
+// units. The implementation is only built when CUDA is found (BEV_OPTICAL_FLOW_USE_CUDA).
+
+namespace bev_optical_flow
+{
+namespace cuda
+{
+/** \brief Byte offsets of the float32 x/y/z fields in a point. */
+struct XYZOffsets
+{
+  uint32_t x;
+  uint32_t y;
+  uint32_t z;
+};
+
+/** \brief Same parameters as LidarToBEVImage. */
+struct BEVImageParams
+{
+  int image_size;
+  float grid_size;
+  float point_radius;
+  float z_min;
+  float z_max;
+  int depth_min;
+  int depth_max;
+};
+
+/** \brief BEV image rasterization running on the GPU. Device buffers are kept across calls. */
+class BEVRasterizerCuda
+{
+public:
+  BEVRasterizerCuda();
+  ~BEVRasterizerCuda();
+
+  /** \brief Draw the packed points (point_step bytes each) into image, a device CV_8UC1 image
+   * of image_size x image_size pixels with image_step bytes per row. As on the CPU, a pixel
+   * takes the depth of the last of its points.
+   */
+  void rasterize(
+    const uint8_t * points, const size_t num_points, const uint32_t point_step,
+    const XYZOffsets & offsets, const BEVImageParams & params, const float map2base_angle,
+    uint8_t * image, const size_t image_step);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace cuda
+}  // namespace bev_optical_flow
+
+#endif  // BEV_OPTICAL_FLOW__CUDA__BEV_RASTERIZER_HPP_
@@ -17,6 +17,7 @@
 
 #include "bev_optical_flow/utils.hpp"
 
+#include <autoware_utils/ros/debug_publisher.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_perception_msgs/msg/dynamic_object_with_feature_array.hpp>
@@ -37,23 +38,22 @@ public:
     const cv::Mat & image, double topic_rate, const cv::Point2f & vehicle_vel);
 
 private:
-  void publishOpticalFlowImage(const cv::Point2f & vehicle_vel);
-  void publishSceneFlowMarker(double topic_rate);
+  sensor_msgs::msg::Image createOpticalFlowImage(
+    const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & optical_flow_array,
+    const cv::Mat & image, const cv::Point2f & vehicle_vel) const;
+  void publishSceneFlowMarker(
+    const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & scene_flow_array,
+    double topic_rate);
   bool createMarker(
     const autoware_perception_msgs::msg::DynamicObjectWithFeature & scene_flow,
     visualization_msgs::msg::Marker & debug_marker,
-    visualization_msgs::msg::Marker & debug_text_marker, int idx, double topic_rate);
+    visualization_msgs::msg::Marker & debug_text_marker, int idx, double topic_rate) const;
 
   rclcpp::Logger logger_;
   rclcpp::Clock::SharedPtr clock_;
 
-  rclcpp::Publisher<sensor_msgs::msg::Image>::SharedPtr debug_image_pub_;
-  rclcpp::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr debug_marker_array_pub_;
-  rclcpp::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr debug_text_marker_array_pub_;
-
-  autoware_perception_msgs::msg::DynamicObjectWithFeatureArray optical_flow_array_;
-  autoware_perception_msgs::msg::DynamicObjectWithFeatureArray scene_flow_array_;
-  cv::Mat image_;
+  // the debug outputs are only made for the topics with a subscriber
+  autoware_utils::DebugPublisher debug_publisher_;
   std::shared_ptr<bev_optical_flow::Utils> utils_;
 };
 
@@ -21,6 +21,11 @@
 
 #include <opencv2/video/tracking.hpp>
 #include <rclcpp/rclcpp.hpp>
+#ifdef BEV_OPTICAL_FLOW_USE_CUDA
+#include <opencv2/core/cuda.hpp>
+#include <opencv2/cudaimgproc.hpp>
+#include <opencv2/cudaoptflow.hpp>
+#endif
 
 #include <autoware_perception_msgs/msg/dynamic_object_with_feature_array.hpp>
 #include <sensor_msgs/msg/point_cloud.hpp>
@@ -46,6 +51,17 @@ private:
     cv::Mat & current_image, cv::Mat & prev_image, std::vector<cv::Point2f> & prev_points,
     autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & flow_array_msg);
 
+  /** \brief Detect the corners of the current image, and when prev_points is not empty track
+   * them to the previous image into prev_points. */
+  void trackCorners(
+    const cv::Mat & current_image, std::vector<cv::Point2f> & current_points,
+    std::vector<cv::Point2f> & prev_points, std::vector<unsigned char> & status);
+#ifdef BEV_OPTICAL_FLOW_USE_CUDA
+  void trackCornersOnGpu(
+    std::vector<cv::Point2f> & current_points, std::vector<cv::Point2f> & prev_points,
+    std::vector<unsigned char> & status);
+#endif
+
   bool getSceneFlowArray(
     const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & optical_flow_array,
     autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & scene_flow_array);
@@ -65,9 +81,18 @@ private:
   int sparse_size_;
   int num_split_;
   bool debug_;
+  bool use_gpu_;
 
   cv::Mat prev_image_;
   std::vector<cv::Point2f> prev_points_;
+  // pyramid of the previous image, kept from the previous frame
+  std::vector<cv::Mat> prev_pyramid_;
+#ifdef BEV_OPTICAL_FLOW_USE_CUDA
+  cv::cuda::GpuMat gpu_image_;
+  cv::cuda::GpuMat gpu_prev_image_;
+  cv::Ptr<cv::cuda::CornersDetector> gpu_corners_detector_;
+  cv::Ptr<cv::cuda::SparsePyrLKOpticalFlow> gpu_optical_flow_;
+#endif
 
   cv::Mat image_;
   rclcpp::Time current_stamp_;
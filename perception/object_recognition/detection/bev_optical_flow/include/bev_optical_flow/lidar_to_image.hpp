@@ -15,9 +15,13 @@
 #ifndef BEV_OPTICAL_FLOW__LIDAR_TO_IMAGE_HPP_
 #define BEV_OPTICAL_FLOW__LIDAR_TO_IMAGE_HPP_
 
+#include "bev_optical_flow/cuda/bev_rasterizer.hpp"
 #include "bev_optical_flow/utils.hpp"
 
 #include <rclcpp/rclcpp.hpp>
+#ifdef BEV_OPTICAL_FLOW_USE_CUDA
+#include <opencv2/core/cuda.hpp>
+#endif
 
 #include <sensor_msgs/msg/image.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
@@ -37,10 +41,17 @@ class LidarToBEVImage
 public:
   explicit LidarToBEVImage(rclcpp::Node & node);
   void getBEVImage(const sensor_msgs::msg::PointCloud2::SharedPtr cloud_msg, cv::Mat & bev_image);
+#ifdef BEV_OPTICAL_FLOW_USE_CUDA
+  /** \brief Same image as getBEVImage, rasterized on the GPU into bev_image. */
+  void getBEVImage(
+    const sensor_msgs::msg::PointCloud2::SharedPtr cloud_msg, cv::cuda::GpuMat & bev_image);
+#endif
 
 private:
   double get_double_param(rclcpp::Node & node, std::string p, const double default_value);
-  float pointToPixel(const pcl::PointXYZ & point, cv::Point2d & px, float map2base_angle);
+  Eigen::Affine2f getBase2Image(const float map2base_angle) const;
+  float pointToPixel(
+    const pcl::PointXYZ & point, cv::Point2d & px, const Eigen::Affine2f & base2image) const;
 
   std::shared_ptr<bev_optical_flow::Utils> utils_;
 
@@ -54,6 +65,10 @@ private:
   float z_min_;
   int depth_max_;
   int depth_min_;
+
+#ifdef BEV_OPTICAL_FLOW_USE_CUDA
+  std::unique_ptr<cuda::BEVRasterizerCuda> gpu_rasterizer_;
+#endif
 };
 }  // namespace bev_optical_flow
 
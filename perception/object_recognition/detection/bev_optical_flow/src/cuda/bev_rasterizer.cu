@@ -0,0 +1,168 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "bev_optical_flow/cuda/bev_rasterizer.hpp"
+
+#include <cuda_runtime_api.h>
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#define CHECK_CUDA_ERROR(e) (checkCudaError(e, __FILE__, __LINE__))
+
+namespace bev_optical_flow
+{
+namespace cuda
+{
+namespace
+{
+constexpr int BLOCK_SIZE = 256;
+
+void checkCudaError(const cudaError_t e, const char * f, int n)
+{
+  if (e != cudaSuccess) {
+    std::stringstream s;
+    s << cudaGetErrorName(e) << " (" << e << ")@" << f << "#L" << n << ": "
+      << cudaGetErrorString(e);
+    throw std::runtime_error{s.str()};
+  }
+}
+
+/** \brief Device buffer that only grows, so it is reused across frames. */
+template <typename T>
+class DeviceBuffer
+{
+public:
+  ~DeviceBuffer() { cudaFree(data_); }
+
+  T * reserve(const size_t size)
+  {
+    if (size > capacity_) {
+      CHECK_CUDA_ERROR(cudaFree(data_));
+      data_ = nullptr;
+      CHECK_CUDA_ERROR(cudaMalloc(reinterpret_cast<void **>(&data_), sizeof(T) * size));
+      capacity_ = size;
+    }
+    return data_;
+  }
+
+  T * get() const { return data_; }
+
+private:
+  T * data_{nullptr};
+  size_t capacity_{0};
+};
+
+/** \brief Pixel and depth of each point, as LidarToBEVImage::pointToPixel, and the last point
+ * of each pixel. pixels is -1 for the points outside of the image. */
+__global__ void pointToPixelKernel(
+  const uint8_t * points, const size_t num_points, const uint32_t point_step,
+  const XYZOffsets offsets, const BEVImageParams params, const float cos_angle,
+  const float sin_angle, int * pixels, uint8_t * depths, int * last_points)
+{
+  const size_t i = blockIdx.x * static_cast<size_t>(blockDim.x) + threadIdx.x;
+  if (i >= num_points) {
+    return;
+  }
+  pixels[i] = -1;
+  float x, y, z;
+  memcpy(&x, points + i * point_step + offsets.x, sizeof(float));
+  memcpy(&y, points + i * point_step + offsets.y, sizeof(float));
+  memcpy(&z, points + i * point_step + offsets.z, sizeof(float));
+  if (
+    !isfinite(x) || !isfinite(y) || !isfinite(z) || x < -params.point_radius ||
+    params.point_radius < x || y < -params.point_radius || params.point_radius < y ||
+    z < params.z_min || params.z_max < z) {
+    return;
+  }
+
+  // rotation by pi + map2base_angle, then the image rows are along the base_link x axis
+  const float row = (cos_angle * x - sin_angle * y + params.point_radius) / params.grid_size;
+  const float col = (sin_angle * x + cos_angle * y + params.point_radius) / params.grid_size;
+  const int u = __double2int_rn(col);
+  const int v = __double2int_rn(row);
+  if (u < 0 || params.image_size <= u || v < 0 || params.image_size <= v) {
+    return;
+  }
+  const float intensity = (z + fabsf(params.z_min)) / (params.z_max - params.z_min);
+  const int depth = static_cast<int>(roundf((params.depth_max - params.depth_min) * intensity));
+  depths[i] = static_cast<uint8_t>(min(max(depth, 0), 255));
+  pixels[i] = v * params.image_size + u;
+  atomicMax(last_points + pixels[i], static_cast<int>(i));
+}
+
+__global__ void drawPixelKernel(
+  const size_t num_points, const int image_size, const int * pixels, const uint8_t * depths,
+  const int * last_points, uint8_t * image, const size_t image_step)
+{
+  const size_t i = blockIdx.x * static_cast<size_t>(blockDim.x) + threadIdx.x;
+  if (i >= num_points || pixels[i] < 0 || last_points[pixels[i]] != static_cast<int>(i)) {
+    return;
+  }
+  const int v = pixels[i] / image_size;
+  const int u = pixels[i] % image_size;
+  image[v * image_step + u] = depths[i];
+}
+
+int getGridSize(const size_t size)
+{
+  return static_cast<int>((size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+}
+}  // namespace
+
+struct BEVRasterizerCuda::Impl
+{
+  DeviceBuffer<uint8_t> points;
+  DeviceBuffer<int> pixels;
+  DeviceBuffer<uint8_t> depths;
+  DeviceBuffer<int> last_points;
+};
+
+BEVRasterizerCuda::BEVRasterizerCuda() : impl_(std::make_unique<Impl>()) {}
+
+BEVRasterizerCuda::~BEVRasterizerCuda() = default;
+
+void BEVRasterizerCuda::rasterize(
+  const uint8_t * points, const size_t num_points, const uint32_t point_step,
+  const XYZOffsets & offsets, const BEVImageParams & params, const float map2base_angle,
+  uint8_t * image, const size_t image_step)
+{
+  const size_t num_pixels = static_cast<size_t>(params.image_size) * params.image_size;
+  CHECK_CUDA_ERROR(cudaMemset2D(image, image_step, 0, params.image_size, params.image_size));
+  if (num_points == 0) {
+    return;
+  }
+
+  uint8_t * points_d = impl_->points.reserve(num_points * point_step);
+  int * pixels_d = impl_->pixels.reserve(num_points);
+  uint8_t * depths_d = impl_->depths.reserve(num_points);
+  int * last_points_d = impl_->last_points.reserve(num_pixels);
+  CHECK_CUDA_ERROR(
+    cudaMemcpy(points_d, points, num_points * point_step, cudaMemcpyHostToDevice));
+  // -1 in every int
+  CHECK_CUDA_ERROR(cudaMemset(last_points_d, 0xff, sizeof(int) * num_pixels));
+
+  const float angle = static_cast<float>(M_PI) + map2base_angle;
+  pointToPixelKernel<<<getGridSize(num_points), BLOCK_SIZE>>>(
+    points_d, num_points, point_step, offsets, params, cosf(angle), sinf(angle), pixels_d,
+    depths_d, last_points_d);
+  drawPixelKernel<<<getGridSize(num_points), BLOCK_SIZE>>>(
+    num_points, params.image_size, pixels_d, depths_d, last_points_d, image, image_step);
+  CHECK_CUDA_ERROR(cudaGetLastError());
+  CHECK_CUDA_ERROR(cudaDeviceSynchronize());
+}
+}  // namespace cuda
+}  // namespace bev_optical_flow
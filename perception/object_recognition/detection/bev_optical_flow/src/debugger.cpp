@@ -16,13 +16,9 @@
 
 #include <memory>
 
-Debugger::Debugger(rclcpp::Node & node) : logger_(node.get_logger()), clock_(node.get_clock())
+Debugger::Debugger(rclcpp::Node & node)
+: logger_(node.get_logger()), clock_(node.get_clock()), debug_publisher_(&node, "output")
 {
-  debug_image_pub_ = node.create_publisher<sensor_msgs::msg::Image>("output/debug_image", 1);
-  debug_marker_array_pub_ =
-    node.create_publisher<visualization_msgs::msg::MarkerArray>("output/debug_marker_line", 1);
-  debug_text_marker_array_pub_ =
-    node.create_publisher<visualization_msgs::msg::MarkerArray>("output/debug_text_marker", 1);
   utils_ = std::make_shared<bev_optical_flow::Utils>(node);
 }
 
@@ -71,22 +67,23 @@ bool Debugger::createMarker(
   return true;
 }
 
-void Debugger::publishOpticalFlowImage(const cv::Point2f & vehicle_vel)
+sensor_msgs::msg::Image Debugger::createOpticalFlowImage(
+  const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & optical_flow_array,
+  const cv::Mat & image, const cv::Point2f & vehicle_vel) const
 {
-  // publish messages
   cv::Mat debug_image;
-  cv::cvtColor(image_, debug_image, CV_GRAY2BGR);
+  cv::cvtColor(image, debug_image, CV_GRAY2BGR);
   cv::Point2f current_point(
-    static_cast<int>(image_.cols * 0.5), static_cast<int>(image_.rows * 0.5));
+    static_cast<int>(image.cols * 0.5), static_cast<int>(image.rows * 0.5));
   cv::Point2f prev_point = current_point - vehicle_vel;
   cv::line(debug_image, current_point, prev_point, cv::Scalar(0, 255, 0), 1, 8, 0);
   cv::circle(debug_image, current_point, 2, cv::Scalar(255, 0, 0), -1);
   cv::circle(debug_image, current_point, 20, cv::Scalar(255, 200, 100));
   cv::circle(
-    debug_image, current_point, static_cast<int>(image_.cols * 0.5), cv::Scalar(100, 100, 100));
+    debug_image, current_point, static_cast<int>(image.cols * 0.5), cv::Scalar(100, 100, 100));
 
-  for (size_t i = 0; i < optical_flow_array_.feature_objects.size(); i++) {
-    auto flow = optical_flow_array_.feature_objects.at(i);
+  for (size_t i = 0; i < optical_flow_array.feature_objects.size(); i++) {
+    const auto & flow = optical_flow_array.feature_objects.at(i);
     float pose_x = flow.object.state.pose_covariance.pose.position.x;
     float pose_y = flow.object.state.pose_covariance.pose.position.y;
     float twist_x = flow.object.state.twist_covariance.twist.linear.x;
@@ -97,30 +94,42 @@ void Debugger::publishOpticalFlowImage(const cv::Point2f & vehicle_vel)
     cv::circle(debug_image, current_px, 0, cv::Scalar(255, 100, 0), -1);
   }
 
-  sensor_msgs::msg::Image output_image_msg =
-    *cv_bridge::CvImage(optical_flow_array_.header, sensor_msgs::image_encodings::BGR8, debug_image)
-       .toImageMsg();
-  debug_image_pub_->publish(output_image_msg);
+  return *cv_bridge::CvImage(
+            optical_flow_array.header, sensor_msgs::image_encodings::BGR8, debug_image)
+            .toImageMsg();
 }
 
-void Debugger::publishSceneFlowMarker(double topic_rate)
+void Debugger::publishSceneFlowMarker(
+  const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & scene_flow_array,
+  double topic_rate)
 {
-  visualization_msgs::msg::MarkerArray debug_marker_array;
-  visualization_msgs::msg::MarkerArray debug_text_marker_array;
-  for (size_t i = 0; i < scene_flow_array_.feature_objects.size(); i++) {
-    auto scene_flow = scene_flow_array_.feature_objects.at(i);
+  using visualization_msgs::msg::MarkerArray;
+  const bool publish_line = debug_publisher_.hasSubscribers<MarkerArray>("debug_marker_line");
+  const bool publish_text = debug_publisher_.hasSubscribers<MarkerArray>("debug_text_marker");
+  if (!publish_line && !publish_text) {
+    return;
+  }
+
+  MarkerArray debug_marker_array;
+  MarkerArray debug_text_marker_array;
+  for (size_t i = 0; i < scene_flow_array.feature_objects.size(); i++) {
+    const auto & scene_flow = scene_flow_array.feature_objects.at(i);
     visualization_msgs::msg::Marker debug_marker;
     visualization_msgs::msg::Marker debug_text_marker;
     createMarker(scene_flow, debug_marker, debug_text_marker, i, topic_rate);
     // line marker
-    debug_marker.header = scene_flow_array_.header;
+    debug_marker.header = scene_flow_array.header;
     debug_marker_array.markers.push_back(debug_marker);
     // text marker
-    debug_text_marker.header = scene_flow_array_.header;
+    debug_text_marker.header = scene_flow_array.header;
     debug_text_marker_array.markers.push_back(debug_text_marker);
   }
-  debug_marker_array_pub_->publish(debug_marker_array);
-  debug_text_marker_array_pub_->publish(debug_text_marker_array);
+  if (publish_line) {
+    debug_publisher_.publish("debug_marker_line", debug_marker_array);
+  }
+  if (publish_text) {
+    debug_publisher_.publish("debug_text_marker", debug_text_marker_array);
+  }
 }
 
 bool Debugger::publishDebugVisualizations(
@@ -128,11 +137,10 @@ bool Debugger::publishDebugVisualizations(
   const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & scene_flow_array,
   const cv::Mat & image, double topic_rate, const cv::Point2f & vehicle_vel)
 {
-  optical_flow_array_ = optical_flow_array;
-  scene_flow_array_ = scene_flow_array;
-  image.copyTo(image_);
-
-  publishOpticalFlowImage(vehicle_vel);
-  publishSceneFlowMarker(topic_rate);
+  debug_publisher_.publishLazy<sensor_msgs::msg::Image>(
+    "debug_image", [this, &optical_flow_array, &image, &vehicle_vel]() {
+      return createOpticalFlowImage(optical_flow_array, image, vehicle_vel);
+    });
+  publishSceneFlowMarker(scene_flow_array, topic_rate);
   return true;
 }
@@ -20,6 +20,13 @@
 
 namespace bev_optical_flow
 {
+namespace
+{
+constexpr int LK_WINDOW_SIZE = 15;
+constexpr int LK_MAX_LEVEL = 2;
+constexpr int LK_MAX_ITERATIONS = 30;
+}  // namespace
+
 FlowCalculator::FlowCalculator(rclcpp::Node & node)
 : logger_(node.get_logger()), clock_(node.get_clock()), debugger_(node)
 {
@@ -32,9 +39,24 @@ FlowCalculator::FlowCalculator(rclcpp::Node & node)
   sparse_size_ = node.declare_parameter("sparse_size", 4);
   num_split_ = node.declare_parameter("num_split", 3);
   debug_ = node.declare_parameter("debug", false);
+  use_gpu_ = node.declare_parameter("use_gpu", false);
 
   utils_ = std::make_shared<bev_optical_flow::Utils>(node);
   lidar_to_image_ = std::make_shared<LidarToBEVImage>(node);
+
+#ifdef BEV_OPTICAL_FLOW_USE_CUDA
+  if (use_gpu_) {
+    gpu_corners_detector_ = cv::cuda::createGoodFeaturesToTrackDetector(
+      CV_8UC1, max_corners_, quality_level_, min_distance_, block_size_, true, harris_k_);
+    gpu_optical_flow_ = cv::cuda::SparsePyrLKOpticalFlow::create(
+      cv::Size(LK_WINDOW_SIZE, LK_WINDOW_SIZE), LK_MAX_LEVEL, LK_MAX_ITERATIONS);
+  }
+#else
+  if (use_gpu_) {
+    RCLCPP_WARN(logger_, "use_gpu is set but CUDA is not available, running on the CPU.");
+    use_gpu_ = false;
+  }
+#endif
 }
 
 bool FlowCalculator::isInitialized() { return setup_; }
@@ -47,20 +69,20 @@ bool FlowCalculator::calcOpticalFlow(
     current_image.copyTo(prev_image);
   }
 
+  const bool has_prev_points = !prev_points.empty();
   std::vector<cv::Point2f> current_points;
-  cv::goodFeaturesToTrack(
-    current_image, current_points, max_corners_, quality_level_, min_distance_, cv::Mat(),
-    block_size_, true, harris_k_);
-
-  cv::TermCriteria term_criteria(cv::TermCriteria::MAX_ITER + cv::TermCriteria::EPS, 30, 0.01);
-
-  if (!prev_points.empty()) {
-    std::vector<unsigned char> status;
-    std::vector<float> err;
-    cv::calcOpticalFlowPyrLK(
-      prev_image, current_image, current_points, prev_points, status, err, cv::Size(15, 15), 2,
-      term_criteria, 0, 0.01);
+  std::vector<unsigned char> status;
+#ifdef BEV_OPTICAL_FLOW_USE_CUDA
+  if (use_gpu_) {
+    trackCornersOnGpu(current_points, prev_points, status);
+  } else {
+    trackCorners(current_image, current_points, prev_points, status);
+  }
+#else
+  trackCorners(current_image, current_points, prev_points, status);
+#endif
 
+  if (has_prev_points) {
     for (size_t i = 0; i < current_points.size(); i++) {
       if (!status[i]) {
         continue;
@@ -85,6 +107,65 @@ bool FlowCalculator::calcOpticalFlow(
   return true;
 }
 
+void FlowCalculator::trackCorners(
+  const cv::Mat & current_image, std::vector<cv::Point2f> & current_points,
+  std::vector<cv::Point2f> & prev_points, std::vector<unsigned char> & status)
+{
+  cv::goodFeaturesToTrack(
+    current_image, current_points, max_corners_, quality_level_, min_distance_, cv::Mat(),
+    block_size_, true, harris_k_);
+
+  // the pyramid of the current image is the previous one of the next frame
+  const cv::Size window_size(LK_WINDOW_SIZE, LK_WINDOW_SIZE);
+  std::vector<cv::Mat> current_pyramid;
+  cv::buildOpticalFlowPyramid(current_image, current_pyramid, window_size, LK_MAX_LEVEL);
+  if (prev_pyramid_.empty()) {
+    prev_pyramid_ = current_pyramid;
+  }
+
+  if (!prev_points.empty()) {
+    cv::TermCriteria term_criteria(
+      cv::TermCriteria::MAX_ITER + cv::TermCriteria::EPS, LK_MAX_ITERATIONS, 0.01);
+    std::vector<float> err;
+    cv::calcOpticalFlowPyrLK(
+      prev_pyramid_, current_pyramid, current_points, prev_points, status, err, window_size,
+      LK_MAX_LEVEL, term_criteria, 0, 0.01);
+  }
+  prev_pyramid_ = std::move(current_pyramid);
+}
+
+#ifdef BEV_OPTICAL_FLOW_USE_CUDA
+void FlowCalculator::trackCornersOnGpu(
+  std::vector<cv::Point2f> & current_points, std::vector<cv::Point2f> & prev_points,
+  std::vector<unsigned char> & status)
+{
+  if (gpu_prev_image_.empty()) {
+    gpu_image_.copyTo(gpu_prev_image_);
+  }
+
+  cv::cuda::GpuMat gpu_current_points;
+  gpu_corners_detector_->detect(gpu_image_, gpu_current_points);
+  if (!gpu_current_points.empty()) {
+    gpu_current_points.download(current_points);
+  }
+
+  if (!prev_points.empty()) {
+    if (current_points.empty()) {
+      prev_points.clear();
+    } else {
+      cv::cuda::GpuMat gpu_prev_points;
+      cv::cuda::GpuMat gpu_status;
+      gpu_optical_flow_->calc(
+        gpu_prev_image_, gpu_image_, gpu_current_points, gpu_prev_points, gpu_status);
+      gpu_prev_points.download(prev_points);
+      gpu_status.download(status);
+    }
+  }
+  // the current image stays on the GPU as the previous image of the next frame
+  gpu_image_.swap(gpu_prev_image_);
+}
+#endif
+
 bool FlowCalculator::calcSceneFlow(
   const autoware_perception_msgs::msg::DynamicObjectWithFeature & optical_flow,
   autoware_perception_msgs::msg::DynamicObjectWithFeature & scene_flow)
@@ -131,7 +212,16 @@ void FlowCalculator::setup(const sensor_msgs::msg::PointCloud2::SharedPtr cloud_
   topic_rate_ = (cloud_stamp - prev_stamp_).seconds();
 
   cv::Mat image;
+#ifdef BEV_OPTICAL_FLOW_USE_CUDA
+  if (use_gpu_) {
+    lidar_to_image_->getBEVImage(cloud_msg, gpu_image_);
+    gpu_image_.download(image);
+  } else {
+    lidar_to_image_->getBEVImage(cloud_msg, image);
+  }
+#else
   lidar_to_image_->getBEVImage(cloud_msg, image);
+#endif
   vehicle_vel_ = utils_->getVehicleVel(cloud_msg->header.stamp, prev_stamp_);
 
   if (image.channels() > 1) {
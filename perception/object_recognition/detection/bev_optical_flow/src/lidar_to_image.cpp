@@ -14,6 +14,9 @@
 
 #include "bev_optical_flow/lidar_to_image.hpp"
 
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <cmath>
 #include <memory>
 #include <string>
 
@@ -43,12 +46,16 @@ double LidarToBEVImage::get_double_param(
   }
 }
 
-float LidarToBEVImage::pointToPixel(
-  const pcl::PointXYZ & point, cv::Point2d & px, float map2base_angle)
+Eigen::Affine2f LidarToBEVImage::getBase2Image(const float map2base_angle) const
 {
   // affine transform base_link coords to image coords
-  Eigen::Affine2f base2image = Eigen::Translation<float, 2>(point_radius_, point_radius_) *
-                               Eigen::Rotation2Df(M_PI + map2base_angle).toRotationMatrix();
+  return Eigen::Translation<float, 2>(point_radius_, point_radius_) *
+         Eigen::Rotation2Df(M_PI + map2base_angle).toRotationMatrix();
+}
+
+float LidarToBEVImage::pointToPixel(
+  const pcl::PointXYZ & point, cv::Point2d & px, const Eigen::Affine2f & base2image) const
+{
   Eigen::Vector2f transformed_p = (base2image * Eigen::Vector2f(point.x, point.y)) / grid_size_;
   px.x = transformed_p[1];
   px.y = transformed_p[0];
@@ -59,26 +66,73 @@ float LidarToBEVImage::pointToPixel(
 void LidarToBEVImage::getBEVImage(
   const sensor_msgs::msg::PointCloud2::SharedPtr cloud_msg, cv::Mat & bev_image)
 {
-  pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::fromROSMsg(*cloud_msg, *cloud);
   bev_image = cv::Mat::zeros(cv::Size(image_size_, image_size_), CV_8UC1);
 
-  float map2base_angle = utils_->getMap2BaseAngle(cloud_msg->header.stamp);
+  const Eigen::Affine2f base2image =
+    getBase2Image(utils_->getMap2BaseAngle(cloud_msg->header.stamp));
 
-  size_t size = cloud->points.size();
-  for (size_t i = 0; i < size; ++i) {
-    auto p = cloud->points.at(i);
+  for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(*cloud_msg, "x"),
+       iter_y(*cloud_msg, "y"), iter_z(*cloud_msg, "z");
+       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    const pcl::PointXYZ p(*iter_x, *iter_y, *iter_z);
     if (
-      p.x < -point_radius_ || point_radius_ < p.x || p.y < -point_radius_ || point_radius_ < p.y ||
-      p.z < z_min_ || z_max_ < p.z) {
+      !std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z) || p.x < -point_radius_ ||
+      point_radius_ < p.x || p.y < -point_radius_ || point_radius_ < p.y || p.z < z_min_ ||
+      z_max_ < p.z) {
       continue;
     }
     cv::Point2d px;
-    float depth = pointToPixel(p, px, map2base_angle);
-    // bev_image.at<unsigned char>(static_cast<int>(px.y),
-    // static_cast<int>(px.x)) = static_cast<int>(depth);
-    cv::circle(bev_image, px, 0, static_cast<int>(depth), -1);
+    float depth = pointToPixel(p, px, base2image);
+    // the pixel a point of radius 0 is drawn at
+    const cv::Point pixel(px);
+    if (pixel.x < 0 || image_size_ <= pixel.x || pixel.y < 0 || image_size_ <= pixel.y) {
+      continue;
+    }
+    bev_image.at<unsigned char>(pixel) = cv::saturate_cast<unsigned char>(static_cast<int>(depth));
+  }
+}
+
+#ifdef BEV_OPTICAL_FLOW_USE_CUDA
+void LidarToBEVImage::getBEVImage(
+  const sensor_msgs::msg::PointCloud2::SharedPtr cloud_msg, cv::cuda::GpuMat & bev_image)
+{
+  if (!gpu_rasterizer_) {
+    gpu_rasterizer_ = std::make_unique<cuda::BEVRasterizerCuda>();
+  }
+  bev_image.create(image_size_, image_size_, CV_8UC1);
+
+  cuda::XYZOffsets offsets{};
+  int found = 0;
+  for (const auto & field : cloud_msg->fields) {
+    if (field.datatype != sensor_msgs::msg::PointField::FLOAT32) {
+      continue;
+    }
+    if (field.name == "x") {
+      offsets.x = field.offset;
+      found |= 1;
+    } else if (field.name == "y") {
+      offsets.y = field.offset;
+      found |= 2;
+    } else if (field.name == "z") {
+      offsets.z = field.offset;
+      found |= 4;
+    }
   }
+  if (found != 7 || cloud_msg->row_step != cloud_msg->width * cloud_msg->point_step) {
+    // not packed xyz points, rasterized on the CPU
+    cv::Mat image;
+    getBEVImage(cloud_msg, image);
+    bev_image.upload(image);
+    return;
+  }
+  const size_t num_points = static_cast<size_t>(cloud_msg->width) * cloud_msg->height;
+
+  const cuda::BEVImageParams params{image_size_, grid_size_, point_radius_, z_min_,
+                                    z_max_,      depth_min_, depth_max_};
+  gpu_rasterizer_->rasterize(
+    cloud_msg->data.data(), num_points, cloud_msg->point_step, offsets, params,
+    utils_->getMap2BaseAngle(cloud_msg->header.stamp), bev_image.ptr<uint8_t>(), bev_image.step);
 }
+#endif
 
 }  // namespace bev_optical_flow
@@ -34,8 +34,10 @@
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <array>
 #include <deque>
 #include <memory>
+#include <utility>
 #include <vector>
 
 class TrackerHandler
@@ -51,6 +53,42 @@ public:
     const rclcpp::Time & time, autoware_perception_msgs::msg::DynamicObjectArray & output);
 };
 
+/** \brief Initial objects of one frame, shared by the trackers around them. The objects are
+ * sorted by x to search the ones near a tracker, and their cluster is converted to pcl and
+ * divided at each clustering level the first time a tracker asks for it. */
+class InitialObjectsCache
+{
+public:
+  static constexpr int DIVIDE_LEVEL_NUM = 5;
+
+  explicit InitialObjectsCache(
+    const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & objects);
+
+  const std_msgs::msg::Header & getHeader() const { return objects_.header; }
+  size_t size() const { return objects_.feature_objects.size(); }
+  const autoware_perception_msgs::msg::DynamicObjectWithFeature & getObject(const size_t i) const
+  {
+    return objects_.feature_objects.at(i);
+  }
+  /** \brief Indices of the objects within range of position in xy, in ascending order. */
+  std::vector<size_t> searchNearObjects(
+    const geometry_msgs::msg::Point & position, const double range) const;
+  const pcl::PointCloud<pcl::PointXYZ>::Ptr & getCluster(const size_t i);
+  /** \brief Cluster of object i divided with the tolerance of the level, which shrinks by
+   * iter_rate from the coarsest level 0. */
+  const std::vector<pcl::PointCloud<pcl::PointXYZ>> & getDividedClusters(
+    const size_t i, const int level);
+
+private:
+  const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & objects_;
+  std::vector<std::pair<double, size_t>> x_sorted_indices_;
+  std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> clusters_;
+  std::vector<std::vector<std::vector<pcl::PointCloud<pcl::PointXYZ>>>> divided_clusters_;
+  std::array<float, DIVIDE_LEVEL_NUM> divide_tolerances_;
+  std::array<float, DIVIDE_LEVEL_NUM> divide_voxel_sizes_;
+  euclidean_cluster::VoxelGridBasedEuclideanCluster divide_cluster_;
+};
+
 class DetectionByTracker : public rclcpp::Node
 {
 public:
@@ -75,18 +113,18 @@ private:
 
   void divideUnderSegmentedObjects(
     const autoware_perception_msgs::msg::DynamicObjectArray & tracked_objects,
-    const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & in_objects,
+    InitialObjectsCache & initial_objects,
     autoware_perception_msgs::msg::DynamicObjectArray & out_no_found_tracked_objects,
     autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & out_objects);
 
   float optimizeUnderSegmentedObject(
     const autoware_perception_msgs::msg::DynamicObject & target_object,
-    const sensor_msgs::msg::PointCloud2 & under_segmented_cluster,
+    InitialObjectsCache & initial_objects, const size_t under_segmented_object_index,
     autoware_perception_msgs::msg::DynamicObjectWithFeature & output);
 
   void mergeOverSegmentedObjects(
     const autoware_perception_msgs::msg::DynamicObjectArray & tracked_objects,
-    const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & in_objects,
+    InitialObjectsCache & initial_objects,
     autoware_perception_msgs::msg::DynamicObjectArray & out_no_found_tracked_objects,
     autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & out_objects);
 };
@@ -16,10 +16,12 @@
 
 #include "detection_by_tracker/utils.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #define EIGEN_MPL2_ONLY
@@ -80,10 +82,8 @@ void setClusterInObjectWithFeature(
   const std_msgs::msg::Header & header, const pcl::PointCloud<pcl::PointXYZ> & cluster,
   autoware_perception_msgs::msg::DynamicObjectWithFeature & feature_object)
 {
-  sensor_msgs::msg::PointCloud2 ros_pointcloud;
-  pcl::toROSMsg(cluster, ros_pointcloud);
-  ros_pointcloud.header = header;
-  feature_object.feature.cluster = ros_pointcloud;
+  pcl::toROSMsg(cluster, feature_object.feature.cluster);
+  feature_object.feature.cluster.header = header;
 }
 autoware_perception_msgs::msg::Shape extendShape(
   const autoware_perception_msgs::msg::Shape & shape, const float scale)
@@ -161,6 +161,77 @@ bool TrackerHandler::estimateDynamicObjects(
   return true;
 }
 
+InitialObjectsCache::InitialObjectsCache(
+  const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & objects)
+: objects_(objects),
+  clusters_(objects.feature_objects.size()),
+  divided_clusters_(objects.feature_objects.size()),
+  divide_cluster_(false, 4, 10000)
+{
+  x_sorted_indices_.reserve(objects.feature_objects.size());
+  for (size_t i = 0; i < objects.feature_objects.size(); ++i) {
+    x_sorted_indices_.emplace_back(
+      objects.feature_objects.at(i).object.state.pose_covariance.pose.position.x, i);
+  }
+  std::sort(x_sorted_indices_.begin(), x_sorted_indices_.end());
+
+  // the voxels are half of the tolerance, and both shrink at each level
+  constexpr float iter_rate = 0.8;
+  constexpr float initial_cluster_range = 0.7;
+  float cluster_range = initial_cluster_range;
+  float voxel_size = initial_cluster_range / 2.0f;
+  for (int level = 0; level < DIVIDE_LEVEL_NUM;
+       ++level, cluster_range *= iter_rate, voxel_size *= iter_rate) {
+    divide_tolerances_.at(level) = cluster_range;
+    divide_voxel_sizes_.at(level) = voxel_size;
+  }
+  divide_cluster_.setMinPointsNumberPerVoxel(0);
+}
+
+std::vector<size_t> InitialObjectsCache::searchNearObjects(
+  const geometry_msgs::msg::Point & position, const double range) const
+{
+  std::vector<size_t> indices;
+  const auto begin = std::lower_bound(
+    x_sorted_indices_.begin(), x_sorted_indices_.end(),
+    std::make_pair(position.x - range, size_t{0}));
+  for (auto itr = begin; itr != x_sorted_indices_.end() && itr->first <= position.x + range;
+       ++itr) {
+    const auto & object_position =
+      objects_.feature_objects.at(itr->second).object.state.pose_covariance.pose.position;
+    if (autoware_utils::calcDistance2d(position, object_position) <= range) {
+      indices.push_back(itr->second);
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+const pcl::PointCloud<pcl::PointXYZ>::Ptr & InitialObjectsCache::getCluster(const size_t i)
+{
+  auto & cluster = clusters_.at(i);
+  if (!cluster) {
+    cluster = pcl::PointCloud<pcl::PointXYZ>::Ptr(new pcl::PointCloud<pcl::PointXYZ>);
+    euclidean_cluster::convertClusterMsg2PointCloud(
+      objects_.feature_objects.at(i).feature.cluster, *cluster);
+  }
+  return cluster;
+}
+
+const std::vector<pcl::PointCloud<pcl::PointXYZ>> & InitialObjectsCache::getDividedClusters(
+  const size_t i, const int level)
+{
+  auto & levels = divided_clusters_.at(i);
+  while (static_cast<int>(levels.size()) <= level) {
+    std::vector<pcl::PointCloud<pcl::PointXYZ>> divided_clusters;
+    divide_cluster_.setTolerance(divide_tolerances_.at(levels.size()));
+    divide_cluster_.setVoxelLeafSize(divide_voxel_sizes_.at(levels.size()));
+    divide_cluster_.cluster(getCluster(i), divided_clusters);
+    levels.push_back(std::move(divided_clusters));
+  }
+  return levels.at(level);
+}
+
 DetectionByTracker::DetectionByTracker(const rclcpp::NodeOptions & node_options)
 : rclcpp::Node("detection_by_tracker", node_options),
   tf_buffer_(this->get_clock()),
@@ -202,16 +273,20 @@ void DetectionByTracker::onObjects(
     }
   }
 
+  // shared by merging and dividing
+  InitialObjectsCache initial_objects(*input_msg);
+
   // merge over segmented objects
   autoware_perception_msgs::msg::DynamicObjectWithFeatureArray merged_objects;
   autoware_perception_msgs::msg::DynamicObjectArray no_found_tracked_objects;
-  mergeOverSegmentedObjects(tracked_objects, *input_msg, no_found_tracked_objects, merged_objects);
+  mergeOverSegmentedObjects(
+    tracked_objects, initial_objects, no_found_tracked_objects, merged_objects);
 
   // divide under segmented objects
   autoware_perception_msgs::msg::DynamicObjectWithFeatureArray divided_objects;
   autoware_perception_msgs::msg::DynamicObjectArray temp_no_found_tracked_objects;
   divideUnderSegmentedObjects(
-    no_found_tracked_objects, *input_msg, temp_no_found_tracked_objects, divided_objects);
+    no_found_tracked_objects, initial_objects, temp_no_found_tracked_objects, divided_objects);
 
   // merge under/over segmented objects to build output objects
   for (const auto & merged_object : merged_objects.feature_objects) {
@@ -226,7 +301,7 @@ void DetectionByTracker::onObjects(
 
 void DetectionByTracker::divideUnderSegmentedObjects(
   const autoware_perception_msgs::msg::DynamicObjectArray & tracked_objects,
-  const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & in_objects,
+  InitialObjectsCache & initial_objects,
   autoware_perception_msgs::msg::DynamicObjectArray & out_no_found_tracked_objects,
   autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & out_objects)
 {
@@ -235,7 +310,7 @@ void DetectionByTracker::divideUnderSegmentedObjects(
   constexpr float max_search_range = 6.0;
   constexpr float min_score_threshold = 0.4;
 
-  out_objects.header = in_objects.header;
+  out_objects.header = initial_objects.getHeader();
   out_no_found_tracked_objects.header = tracked_objects.header;
 
   for (const auto & tracked_object : tracked_objects.objects) {
@@ -243,14 +318,10 @@ void DetectionByTracker::divideUnderSegmentedObjects(
       highest_score_divided_object = std::nullopt;
     float highest_score = 0.0;
 
-    for (const auto & initial_object : in_objects.feature_objects) {
-      // search near object
-      const float distance = autoware_utils::calcDistance2d(
-        tracked_object.state.pose_covariance.pose,
-        initial_object.object.state.pose_covariance.pose);
-      if (max_search_range < distance) {
-        continue;
-      }
+    // search near object
+    for (const size_t i : initial_objects.searchNearObjects(
+           tracked_object.state.pose_covariance.pose.position, max_search_range)) {
+      const auto & initial_object = initial_objects.getObject(i);
       // detect under segmented cluster
       const float recall = utils::get2dRecall(initial_object.object, tracked_object);
       const float precision = utils::get2dPrecision(initial_object.object, tracked_object);
@@ -261,8 +332,8 @@ void DetectionByTracker::divideUnderSegmentedObjects(
       }
       // optimize clustering
       autoware_perception_msgs::msg::DynamicObjectWithFeature divided_object;
-      float score = optimizeUnderSegmentedObject(
-        tracked_object, initial_object.feature.cluster, divided_object);
+      float score =
+        optimizeUnderSegmentedObject(tracked_object, initial_objects, i, divided_object);
       if (score < min_score_threshold) {
         continue;
       }
@@ -282,52 +353,41 @@ void DetectionByTracker::divideUnderSegmentedObjects(
 
 float DetectionByTracker::optimizeUnderSegmentedObject(
   const autoware_perception_msgs::msg::DynamicObject & target_object,
-  const sensor_msgs::msg::PointCloud2 & under_segmented_cluster,
+  InitialObjectsCache & initial_objects, const size_t under_segmented_object_index,
   autoware_perception_msgs::msg::DynamicObjectWithFeature & output)
 {
-  constexpr float iter_rate = 0.8;
-  constexpr int iter_max_count = 5;
-  constexpr float initial_cluster_range = 0.7;
-  float cluster_range = initial_cluster_range;
-  constexpr float initial_voxel_size = initial_cluster_range / 2.0f;
-  float voxel_size = initial_voxel_size;
-
-  // initialize clustering parameters
-  euclidean_cluster::VoxelGridBasedEuclideanCluster cluster(
-    false, 4, 10000, initial_cluster_range, initial_voxel_size, 0);
-
-  // convert to pcl
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_cluster(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::fromROSMsg(under_segmented_cluster, *pcl_cluster);
+  const auto & under_segmented_cluster =
+    initial_objects.getObject(under_segmented_object_index).feature.cluster;
 
   // iterate to find best fit divided object
   float highest_iou = 0.0;
   autoware_perception_msgs::msg::DynamicObjectWithFeature highest_iou_object;
-  for (int iter_count = 0; iter_count < iter_max_count;
-       ++iter_count, cluster_range *= iter_rate, voxel_size *= iter_rate) {
-    // divide under segmented cluster
-    std::vector<pcl::PointCloud<pcl::PointXYZ>> divided_clusters;
-    cluster.setTolerance(cluster_range);
-    cluster.setVoxelLeafSize(voxel_size);
-    cluster.cluster(pcl_cluster, divided_clusters);
+  for (int level = 0; level < InitialObjectsCache::DIVIDE_LEVEL_NUM; ++level) {
+    // divide under segmented cluster, shared with the other trackers around it
+    const auto & divided_clusters =
+      initial_objects.getDividedClusters(under_segmented_object_index, level);
 
     // find highest iou object in divided clusters
     float highest_iou_in_current_iter = 0.0f;
+    const pcl::PointCloud<pcl::PointXYZ> * highest_iou_cluster_in_current_iter = nullptr;
     autoware_perception_msgs::msg::DynamicObjectWithFeature highest_iou_object_in_current_iter;
     highest_iou_object_in_current_iter.object.semantic.type = target_object.semantic.type;
+    autoware_perception_msgs::msg::DynamicObject divided_object;
+    divided_object.semantic.type = target_object.semantic.type;
     for (const auto & divided_cluster : divided_clusters) {
       if (!shape_estimator_->estimateShapeAndPose(
-            highest_iou_object_in_current_iter.object.semantic.type, divided_cluster,
+            divided_object.semantic.type, divided_cluster,
             tf2::getYaw(target_object.state.pose_covariance.pose.orientation),
-            highest_iou_object_in_current_iter.object.shape,
-            highest_iou_object_in_current_iter.object.state.pose_covariance.pose)) {
+            divided_object.shape, divided_object.state.pose_covariance.pose)) {
         continue;
       }
-      const float iou = utils::get2dIoU(highest_iou_object_in_current_iter.object, target_object);
+      const float iou = utils::get2dIoU(divided_object, target_object);
       if (highest_iou_in_current_iter < iou) {
         highest_iou_in_current_iter = iou;
-        setClusterInObjectWithFeature(
-          under_segmented_cluster.header, divided_cluster, highest_iou_object_in_current_iter);
+        highest_iou_object_in_current_iter.object.shape = divided_object.shape;
+        highest_iou_object_in_current_iter.object.state.pose_covariance.pose =
+          divided_object.state.pose_covariance.pose;
+        highest_iou_cluster_in_current_iter = &divided_cluster;
       }
     }
 
@@ -337,6 +397,11 @@ float DetectionByTracker::optimizeUnderSegmentedObject(
     }
 
     // copy for next iteration
+    if (highest_iou_cluster_in_current_iter) {
+      setClusterInObjectWithFeature(
+        under_segmented_cluster.header, *highest_iou_cluster_in_current_iter,
+        highest_iou_object_in_current_iter);
+    }
     highest_iou = highest_iou_in_current_iter;
     highest_iou_object = highest_iou_object_in_current_iter;
   }
@@ -350,13 +415,13 @@ float DetectionByTracker::optimizeUnderSegmentedObject(
 
 void DetectionByTracker::mergeOverSegmentedObjects(
   const autoware_perception_msgs::msg::DynamicObjectArray & tracked_objects,
-  const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & in_objects,
+  InitialObjectsCache & initial_objects,
   autoware_perception_msgs::msg::DynamicObjectArray & out_no_found_tracked_objects,
   autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & out_objects)
 {
   constexpr float precision_threshold = 0.5;
   constexpr float max_search_range = 5.0;
-  out_objects.header = in_objects.header;
+  out_objects.header = initial_objects.getHeader();
   out_no_found_tracked_objects.header = tracked_objects.header;
 
   for (const auto & tracked_object : tracked_objects.objects) {
@@ -365,23 +430,15 @@ void DetectionByTracker::mergeOverSegmentedObjects(
     extended_tracked_object.shape = extendShape(tracked_object.shape, /*scale*/ 1.1);
 
     pcl::PointCloud<pcl::PointXYZ> pcl_merged_cluster;
-    for (const auto & initial_object : in_objects.feature_objects) {
-      const float distance = autoware_utils::calcDistance2d(
-        tracked_object.state.pose_covariance.pose,
-        initial_object.object.state.pose_covariance.pose);
-
-      if (max_search_range < distance) {
-        continue;
-      }
-
+    for (const size_t i : initial_objects.searchNearObjects(
+           tracked_object.state.pose_covariance.pose.position, max_search_range)) {
       // If there is an initial object in the tracker, it will be merged.
-      const float precision = utils::get2dPrecision(initial_object.object, extended_tracked_object);
+      const float precision =
+        utils::get2dPrecision(initial_objects.getObject(i).object, extended_tracked_object);
       if (precision < precision_threshold) {
         continue;
       }
-      pcl::PointCloud<pcl::PointXYZ> pcl_cluster;
-      pcl::fromROSMsg(initial_object.feature.cluster, pcl_cluster);
-      pcl_merged_cluster += pcl_cluster;
+      pcl_merged_cluster += *initial_objects.getCluster(i);
     }
 
     if (pcl_merged_cluster.points.empty()) {  // not found
@@ -401,7 +458,7 @@ void DetectionByTracker::mergeOverSegmentedObjects(
       out_no_found_tracked_objects.objects.push_back(tracked_object);
       continue;
     }
-    setClusterInObjectWithFeature(in_objects.header, pcl_merged_cluster, feature_object);
+    setClusterInObjectWithFeature(initial_objects.getHeader(), pcl_merged_cluster, feature_object);
     out_objects.feature_objects.push_back(feature_object);
   }
 }
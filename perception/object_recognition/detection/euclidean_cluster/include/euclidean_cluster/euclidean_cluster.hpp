@@ -29,9 +29,9 @@ public:
   EuclideanCluster();
   EuclideanCluster(bool use_height, int min_cluster_size, int max_cluster_size);
   EuclideanCluster(bool use_height, int min_cluster_size, int max_cluster_size, float tolerance);
-  bool cluster(
+  bool clusterIndices(
     const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
-    std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters) override;
+    ClusterIndices & clusters) override;
   void setTolerance(float tolerance) { tolerance_ = tolerance; }
 
 private:
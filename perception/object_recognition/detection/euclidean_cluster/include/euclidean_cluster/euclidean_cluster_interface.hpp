@@ -14,11 +14,14 @@
 
 #pragma once
 
+#include "euclidean_cluster/grid_clustering.hpp"
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 
+#include <utility>
 #include <vector>
 
 namespace euclidean_cluster
@@ -37,9 +40,31 @@ public:
   void setUseHeight(bool use_height) { use_height_ = use_height; }
   void setMinClusterSize(int size) { min_cluster_size_ = size; }
   void setMaxClusterSize(int size) { max_cluster_size_ = size; }
-  virtual bool cluster(
+  /** \brief Clusters as index ranges into pointcloud, sorted by decreasing size. */
+  virtual bool clusterIndices(
+    const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud, ClusterIndices & clusters) = 0;
+  /** \brief Same clusters as clusterIndices, copied into one pointcloud each. */
+  bool cluster(
     const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
-    std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters) = 0;
+    std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters)
+  {
+    ClusterIndices cluster_indices;
+    if (!clusterIndices(pointcloud, cluster_indices)) {
+      return false;
+    }
+    for (size_t i = 0; i < cluster_indices.size(); ++i) {
+      pcl::PointCloud<pcl::PointXYZ> cluster;
+      cluster.points.reserve(cluster_indices.clusterSize(i));
+      for (size_t j = cluster_indices.offsets[i]; j < cluster_indices.offsets[i + 1]; ++j) {
+        cluster.points.push_back(pointcloud->points[cluster_indices.indices[j]]);
+      }
+      cluster.width = cluster.points.size();
+      cluster.height = 1;
+      cluster.is_dense = false;
+      clusters.push_back(std::move(cluster));
+    }
+    return true;
+  }
 
 protected:
   bool use_height_ = true;
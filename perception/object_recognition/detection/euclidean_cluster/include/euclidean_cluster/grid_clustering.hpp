@@ -0,0 +1,50 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace euclidean_cluster
+{
+/** \brief Clusters as ranges of one index buffer: the points of cluster i are
+ * indices[offsets[i]] ... indices[offsets[i + 1] - 1]. */
+struct ClusterIndices
+{
+  std::vector<int> indices;
+  std::vector<size_t> offsets{0};
+
+  size_t size() const { return offsets.size() - 1; }
+  size_t clusterSize(const size_t i) const { return offsets.at(i + 1) - offsets.at(i); }
+  void clear()
+  {
+    indices.clear();
+    offsets.assign(1, 0);
+  }
+};
+
+/** \brief Same clusters as pcl::EuclideanClusterExtraction: the points closer than tolerance, in
+ * xy only unless use_height, are connected. The points are hashed into a grid of tolerance
+ * cells, and the pairs of neighbouring cells are merged with a concurrent union-find. The
+ * clusters are sorted by decreasing size, and the ones outside [min, max] points dropped. */
+void extractGridClusters(
+  const pcl::PointCloud<pcl::PointXYZ> & pointcloud, const float tolerance, const bool use_height,
+  const int min_cluster_size, const int max_cluster_size, ClusterIndices & clusters);
+
+}  // namespace euclidean_cluster
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include "euclidean_cluster/grid_clustering.hpp"
+
 #include <autoware_perception_msgs/msg/dynamic_object_with_feature_array.hpp>
 #include <geometry_msgs/msg/pose_stamped.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
@@ -31,6 +33,15 @@ void convertPointCloudClusters2Msg(
   const std_msgs::msg::Header & header,
   const std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters,
   autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & msg);
+/** \brief Writes the points of each cluster straight into its message. */
+void convertPointCloudClusters2Msg(
+  const std_msgs::msg::Header & header, const pcl::PointCloud<pcl::PointXYZ> & pointcloud,
+  const ClusterIndices & clusters,
+  autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & msg);
+/** \brief Reads the points of a cluster, copied at once when the message has the layout written
+ * by convertPointCloudClusters2Msg and field by field otherwise. */
+void convertClusterMsg2PointCloud(
+  const sensor_msgs::msg::PointCloud2 & cluster, pcl::PointCloud<pcl::PointXYZ> & pointcloud);
 void convertObjectMsg2SensorMsg(
   const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & input,
   sensor_msgs::msg::PointCloud2 & output);
@@ -14,9 +14,6 @@
 
 #include "euclidean_cluster/euclidean_cluster.hpp"
 
-#include <pcl/kdtree/kdtree.h>
-#include <pcl/segmentation/extract_clusters.h>
-
 namespace euclidean_cluster
 {
 EuclideanCluster::EuclideanCluster() {}
@@ -32,53 +29,11 @@ EuclideanCluster::EuclideanCluster(
 {
 }
 
-bool EuclideanCluster::cluster(
-  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
-  std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters)
+bool EuclideanCluster::clusterIndices(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud, ClusterIndices & clusters)
 {
-  // convert 2d pointcloud
-  pcl::PointCloud<pcl::PointXYZ>::ConstPtr pointcloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  if (!use_height_) {
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_2d_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-    for (const auto & point : pointcloud->points) {
-      pcl::PointXYZ point2d;
-      point2d.x = point.x;
-      point2d.y = point.y;
-      point2d.z = 0.0;
-      pointcloud_2d_ptr->push_back(point2d);
-    }
-    pointcloud_ptr = pointcloud_2d_ptr;
-  } else {
-    pointcloud_ptr = pointcloud;
-  }
-
-  // create tree
-  pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
-  tree->setInputCloud(pointcloud_ptr);
-
-  // clustering
-  std::vector<pcl::PointIndices> cluster_indices;
-  pcl::EuclideanClusterExtraction<pcl::PointXYZ> pcl_euclidean_cluster;
-  pcl_euclidean_cluster.setClusterTolerance(tolerance_);
-  pcl_euclidean_cluster.setMinClusterSize(min_cluster_size_);
-  pcl_euclidean_cluster.setMaxClusterSize(max_cluster_size_);
-  pcl_euclidean_cluster.setSearchMethod(tree);
-  pcl_euclidean_cluster.setInputCloud(pointcloud_ptr);
-  pcl_euclidean_cluster.extract(cluster_indices);
-
-  // build output
-  {
-    for (const auto & cluster : cluster_indices) {
-      pcl::PointCloud<pcl::PointXYZ>::Ptr cloud_cluster(new pcl::PointCloud<pcl::PointXYZ>);
-      for (const auto & point_idx : cluster.indices) {
-        cloud_cluster->points.push_back(pointcloud->points[point_idx]);
-      }
-      clusters.push_back(*cloud_cluster);
-      clusters.back().width = cloud_cluster->points.size();
-      clusters.back().height = 1;
-      clusters.back().is_dense = false;
-    }
-  }
+  extractGridClusters(
+    *pointcloud, tolerance_, use_height_, min_cluster_size_, max_cluster_size_, clusters);
   return true;
 }
 
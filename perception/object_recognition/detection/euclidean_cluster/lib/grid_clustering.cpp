@@ -0,0 +1,218 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "euclidean_cluster/grid_clustering.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace euclidean_cluster
+{
+namespace
+{
+// 21 bits per axis
+constexpr int64_t CELL_OFFSET = 1 << 20;
+constexpr uint64_t CELL_MASK = (1 << 21) - 1;
+
+uint64_t getCellKey(const int64_t x, const int64_t y, const int64_t z)
+{
+  return (static_cast<uint64_t>(x + CELL_OFFSET) & CELL_MASK) |
+         (static_cast<uint64_t>(y + CELL_OFFSET) & CELL_MASK) << 21 |
+         (static_cast<uint64_t>(z + CELL_OFFSET) & CELL_MASK) << 42;
+}
+
+/** \brief Union-find whose unite can be called from several threads. The root of a set is its
+ * smallest index, so that concurrent links cannot form a cycle. */
+class ConcurrentUnionFind
+{
+public:
+  explicit ConcurrentUnionFind(const size_t size) : parents_(new std::atomic<int>[size])
+  {
+    for (size_t i = 0; i < size; ++i) {
+      parents_[i].store(static_cast<int>(i), std::memory_order_relaxed);
+    }
+  }
+
+  int find(int i) const
+  {
+    int parent = parents_[i].load(std::memory_order_relaxed);
+    while (parent != i) {
+      // path halving, a lost race only leaves a longer path
+      const int grandparent = parents_[parent].load(std::memory_order_relaxed);
+      parents_[i].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+      i = grandparent;
+      parent = parents_[i].load(std::memory_order_relaxed);
+    }
+    return i;
+  }
+
+  void unite(int a, int b)
+  {
+    while (true) {
+      a = find(a);
+      b = find(b);
+      if (a == b) {
+        return;
+      }
+      if (a < b) {
+        std::swap(a, b);
+      }
+      // link the larger root below the smaller one, retry if it got linked meanwhile
+      int expected = a;
+      if (parents_[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
+
+private:
+  std::unique_ptr<std::atomic<int>[]> parents_;
+};
+}  // namespace
+
+void extractGridClusters(
+  const pcl::PointCloud<pcl::PointXYZ> & pointcloud, const float tolerance, const bool use_height,
+  const int min_cluster_size, const int max_cluster_size, ClusterIndices & clusters)
+{
+  clusters.clear();
+  const auto & points = pointcloud.points;
+  if (points.empty() || !(0.0f < tolerance)) {
+    return;
+  }
+  const float squared_tolerance = tolerance * tolerance;
+  const auto isConnected = [&points, squared_tolerance, use_height](const int i, const int j) {
+    const float dx = points[i].x - points[j].x;
+    const float dy = points[i].y - points[j].y;
+    const float dz = use_height ? points[i].z - points[j].z : 0.0f;
+    return dx * dx + dy * dy + dz * dz <= squared_tolerance;
+  };
+
+  // sort the finite points by cell, the cells are ranges of sorted_points
+  std::vector<std::pair<uint64_t, int>> sorted_points;
+  sorted_points.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto & p = points[i];
+    if (!std::isfinite(p.x) || !std::isfinite(p.y) || (use_height && !std::isfinite(p.z))) {
+      continue;
+    }
+    const auto x = static_cast<int64_t>(std::floor(p.x / tolerance));
+    const auto y = static_cast<int64_t>(std::floor(p.y / tolerance));
+    const auto z = use_height ? static_cast<int64_t>(std::floor(p.z / tolerance)) : 0;
+    sorted_points.emplace_back(getCellKey(x, y, z), static_cast<int>(i));
+  }
+  std::sort(sorted_points.begin(), sorted_points.end());
+
+  std::vector<size_t> cell_begins;
+  std::unordered_map<uint64_t, size_t> cell_indices;
+  for (size_t i = 0; i < sorted_points.size(); ++i) {
+    if (i == 0 || sorted_points[i].first != sorted_points[i - 1].first) {
+      cell_indices.emplace(sorted_points[i].first, cell_begins.size());
+      cell_begins.push_back(i);
+    }
+  }
+  cell_begins.push_back(sorted_points.size());
+  const int num_cells = static_cast<int>(cell_begins.size()) - 1;
+
+  // each pair of neighbouring cells is visited once, from the cell with the smaller key
+  std::vector<uint64_t> neighbor_key_offsets;
+  const int z_range = use_height ? 1 : 0;
+  for (int dz = -z_range; dz <= z_range; ++dz) {
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        if (std::make_tuple(dz, dy, dx) > std::make_tuple(0, 0, 0)) {
+          neighbor_key_offsets.push_back(getCellKey(dx, dy, dz) - getCellKey(0, 0, 0));
+        }
+      }
+    }
+  }
+
+  ConcurrentUnionFind union_find(points.size());
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int cell = 0; cell < num_cells; ++cell) {
+    const size_t begin = cell_begins[cell];
+    const size_t end = cell_begins[cell + 1];
+    const uint64_t key = sorted_points[begin].first;
+    for (size_t i = begin; i < end; ++i) {
+      for (size_t j = i + 1; j < end; ++j) {
+        if (isConnected(sorted_points[i].second, sorted_points[j].second)) {
+          union_find.unite(sorted_points[i].second, sorted_points[j].second);
+        }
+      }
+    }
+    for (const auto key_offset : neighbor_key_offsets) {
+      const auto neighbor_itr = cell_indices.find(key + key_offset);
+      if (neighbor_itr == cell_indices.end()) {
+        continue;
+      }
+      const size_t neighbor_begin = cell_begins[neighbor_itr->second];
+      const size_t neighbor_end = cell_begins[neighbor_itr->second + 1];
+      for (size_t i = begin; i < end; ++i) {
+        for (size_t j = neighbor_begin; j < neighbor_end; ++j) {
+          const int a = sorted_points[i].second;
+          const int b = sorted_points[j].second;
+          if (union_find.find(a) != union_find.find(b) && isConnected(a, b)) {
+            union_find.unite(a, b);
+          }
+        }
+      }
+    }
+  }
+
+  // group the points by root, a root is the smallest index of its cluster
+  std::vector<int> roots(points.size(), -1);
+  std::vector<int> root_sizes(points.size(), 0);
+  for (const auto & sorted_point : sorted_points) {
+    const int root = union_find.find(sorted_point.second);
+    roots[sorted_point.second] = root;
+    ++root_sizes[root];
+  }
+  std::vector<int> cluster_roots;
+  for (size_t i = 0; i < points.size(); ++i) {
+    const int size = root_sizes[i];
+    if (0 < size && min_cluster_size <= size && size <= max_cluster_size) {
+      cluster_roots.push_back(static_cast<int>(i));
+    }
+  }
+  std::stable_sort(cluster_roots.begin(), cluster_roots.end(), [&root_sizes](int a, int b) {
+    return root_sizes[a] > root_sizes[b];
+  });
+
+  // offsets of the clusters, then their points in increasing index order
+  std::vector<size_t> root_offsets(points.size());
+  for (const int root : cluster_roots) {
+    root_offsets[root] = clusters.offsets.back();
+    clusters.offsets.push_back(clusters.offsets.back() + root_sizes[root]);
+  }
+  clusters.indices.resize(clusters.offsets.back());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const int root = roots[i];
+    if (root < 0) {
+      continue;
+    }
+    const int size = root_sizes[root];
+    if (min_cluster_size <= size && size <= max_cluster_size) {
+      clusters.indices[root_offsets[root]++] = static_cast<int>(i);
+    }
+  }
+}
+
+}  // namespace euclidean_cluster
@@ -18,8 +18,64 @@
 #include <sensor_msgs/msg/point_field.hpp>
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 
+#include <cstring>
+#include <vector>
+
 namespace euclidean_cluster
 {
+namespace
+{
+bool hasPointXYZLayout(const sensor_msgs::msg::PointCloud2 & pointcloud)
+{
+  if (
+    pointcloud.is_bigendian || pointcloud.point_step != sizeof(pcl::PointXYZ) ||
+    pointcloud.row_step != pointcloud.point_step * pointcloud.width ||
+    pointcloud.data.size() != static_cast<size_t>(pointcloud.row_step) * pointcloud.height ||
+    pointcloud.fields.size() < 3) {
+    return false;
+  }
+  const char * field_names[] = {"x", "y", "z"};
+  for (size_t i = 0; i < 3; ++i) {
+    const auto & field = pointcloud.fields[i];
+    if (
+      field.name != field_names[i] || field.offset != 4 * i ||
+      field.datatype != sensor_msgs::msg::PointField::FLOAT32 || field.count != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// same layout as pcl::toROSMsg of a pcl::PointXYZ cloud
+std::vector<sensor_msgs::msg::PointField> createPointXYZFields()
+{
+  std::vector<sensor_msgs::msg::PointField> fields(3);
+  const char * field_names[] = {"x", "y", "z"};
+  for (size_t i = 0; i < fields.size(); ++i) {
+    fields[i].name = field_names[i];
+    fields[i].offset = 4 * i;
+    fields[i].datatype = sensor_msgs::msg::PointField::FLOAT32;
+    fields[i].count = 1;
+  }
+  return fields;
+}
+
+void initClusterMsg(
+  const std_msgs::msg::Header & header, const std::vector<sensor_msgs::msg::PointField> & fields,
+  const size_t size, sensor_msgs::msg::PointCloud2 & ros_pointcloud)
+{
+  ros_pointcloud.header = header;
+  ros_pointcloud.height = 1;
+  ros_pointcloud.width = size;
+  ros_pointcloud.fields = fields;
+  ros_pointcloud.is_bigendian = false;
+  ros_pointcloud.point_step = sizeof(pcl::PointXYZ);
+  ros_pointcloud.row_step = sizeof(pcl::PointXYZ) * size;
+  ros_pointcloud.is_dense = false;
+  ros_pointcloud.data.resize(ros_pointcloud.row_step);
+}
+}  // namespace
+
 geometry_msgs::msg::Point getCentroid(const sensor_msgs::msg::PointCloud2 & pointcloud)
 {
   geometry_msgs::msg::Point centroid;
@@ -45,17 +101,67 @@ void convertPointCloudClusters2Msg(
   const std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters,
   autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & msg)
 {
+  const auto fields = createPointXYZFields();
   msg.header = header;
-  for (const auto & cluster : clusters) {
-    sensor_msgs::msg::PointCloud2 ros_pointcloud;
-    autoware_perception_msgs::msg::DynamicObjectWithFeature feature_object;
-    pcl::toROSMsg(cluster, ros_pointcloud);
-    ros_pointcloud.header = header;
-    feature_object.feature.cluster = ros_pointcloud;
+  const size_t num_objects = msg.feature_objects.size();
+  msg.feature_objects.resize(num_objects + clusters.size());
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    auto & feature_object = msg.feature_objects[num_objects + i];
+    auto & ros_pointcloud = feature_object.feature.cluster;
+    initClusterMsg(header, fields, clusters[i].size(), ros_pointcloud);
+    std::memcpy(ros_pointcloud.data.data(), clusters[i].points.data(), ros_pointcloud.row_step);
     feature_object.object.state.pose_covariance.pose.position = getCentroid(ros_pointcloud);
-    msg.feature_objects.push_back(feature_object);
   }
 }
+
+void convertPointCloudClusters2Msg(
+  const std_msgs::msg::Header & header, const pcl::PointCloud<pcl::PointXYZ> & pointcloud,
+  const ClusterIndices & clusters,
+  autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & msg)
+{
+  const auto fields = createPointXYZFields();
+  msg.header = header;
+  msg.feature_objects.resize(clusters.size());
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    auto & feature_object = msg.feature_objects[i];
+    auto & ros_pointcloud = feature_object.feature.cluster;
+    const size_t size = clusters.clusterSize(i);
+    initClusterMsg(header, fields, size, ros_pointcloud);
+
+    auto & centroid = feature_object.object.state.pose_covariance.pose.position;
+    uint8_t * data = ros_pointcloud.data.data();
+    for (size_t j = clusters.offsets[i]; j < clusters.offsets[i + 1]; ++j) {
+      const auto & point = pointcloud.points[clusters.indices[j]];
+      std::memcpy(data, &point, sizeof(pcl::PointXYZ));
+      data += sizeof(pcl::PointXYZ);
+      centroid.x += point.x;
+      centroid.y += point.y;
+      centroid.z += point.z;
+    }
+    centroid.x /= static_cast<double>(size);
+    centroid.y /= static_cast<double>(size);
+    centroid.z /= static_cast<double>(size);
+  }
+}
+
+void convertClusterMsg2PointCloud(
+  const sensor_msgs::msg::PointCloud2 & cluster, pcl::PointCloud<pcl::PointXYZ> & pointcloud)
+{
+  if (!hasPointXYZLayout(cluster)) {
+    pcl::fromROSMsg(cluster, pointcloud);
+    return;
+  }
+
+  // the rows are contiguous, so the data is the array of the points
+  const size_t size = cluster.width * cluster.height;
+  pcl_conversions::toPCL(cluster.header, pointcloud.header);
+  pointcloud.resize(size);
+  pointcloud.width = cluster.width;
+  pointcloud.height = cluster.height;
+  pointcloud.is_dense = cluster.is_dense;
+  std::memcpy(pointcloud.points.data(), cluster.data.data(), size * sizeof(pcl::PointXYZ));
+}
+
 void convertObjectMsg2SensorMsg(
   const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & input,
   sensor_msgs::msg::PointCloud2 & output)
@@ -14,10 +14,7 @@
 
 #include "euclidean_cluster/voxel_grid_based_euclidean_cluster.hpp"
 
-#include <pcl/kdtree/kdtree.h>
-#include <pcl/segmentation/extract_clusters.h>
-
-#include <unordered_map>
+#include <vector>
 
 namespace euclidean_cluster
 {
@@ -39,9 +36,8 @@ VoxelGridBasedEuclideanCluster::VoxelGridBasedEuclideanCluster(
 {
 }
 
-bool VoxelGridBasedEuclideanCluster::cluster(
-  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
-  std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters)
+bool VoxelGridBasedEuclideanCluster::clusterIndices(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud, ClusterIndices & clusters)
 {
   // TODO(Saito) implement use_height is false version
 
@@ -53,61 +49,51 @@ bool VoxelGridBasedEuclideanCluster::cluster(
   voxel_grid_.setSaveLeafLayout(true);
   voxel_grid_.filter(*voxel_map_ptr);
 
-  // voxel is pressed 2d
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_2d_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  for (const auto & point : voxel_map_ptr->points) {
-    pcl::PointXYZ point2d;
-    point2d.x = point.x;
-    point2d.y = point.y;
-    point2d.z = 0.0;
-    pointcloud_2d_ptr->push_back(point2d);
-  }
-
-  // create tree
-  pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
-  tree->setInputCloud(pointcloud_2d_ptr);
-
-  // clustering
-  std::vector<pcl::PointIndices> cluster_indices;
-  pcl::EuclideanClusterExtraction<pcl::PointXYZ> pcl_euclidean_cluster;
-  pcl_euclidean_cluster.setClusterTolerance(tolerance_);
-  pcl_euclidean_cluster.setMinClusterSize(1);
-  pcl_euclidean_cluster.setMaxClusterSize(max_cluster_size_);
-  pcl_euclidean_cluster.setSearchMethod(tree);
-  pcl_euclidean_cluster.setInputCloud(pointcloud_2d_ptr);
-  pcl_euclidean_cluster.extract(cluster_indices);
+  // cluster the voxels in 2d
+  ClusterIndices voxel_clusters;
+  extractGridClusters(*voxel_map_ptr, tolerance_, false, 1, max_cluster_size_, voxel_clusters);
 
-  // create map to search cluster index from voxel grid index
-  std::unordered_map</* voxel grid index */ int, /* cluster index */ int> map;
-  for (size_t cluster_idx = 0; cluster_idx < cluster_indices.size(); ++cluster_idx) {
-    const auto & cluster = cluster_indices.at(cluster_idx);
-    for (const auto & point_idx : cluster.indices) {
-      map[point_idx] = cluster_idx;
+  // cluster index of each voxel, -1 if its cluster got too large
+  std::vector<int> voxel_to_cluster(voxel_map_ptr->points.size(), -1);
+  for (size_t cluster_idx = 0; cluster_idx < voxel_clusters.size(); ++cluster_idx) {
+    for (size_t i = voxel_clusters.offsets[cluster_idx];
+         i < voxel_clusters.offsets[cluster_idx + 1]; ++i) {
+      voxel_to_cluster[voxel_clusters.indices[i]] = static_cast<int>(cluster_idx);
     }
   }
 
-  // create vector of point cloud cluster. vector index is voxel grid index.
-  std::vector<pcl::PointCloud<pcl::PointXYZ>> temporary_clusters;  // no check about cluster size
-  temporary_clusters.resize(cluster_indices.size());
-  for (const auto & point : pointcloud->points) {
+  // cluster index of each point, counted per cluster before checking the cluster size
+  std::vector<int> point_to_cluster(pointcloud->points.size(), -1);
+  std::vector<int> cluster_sizes(voxel_clusters.size(), 0);
+  for (size_t i = 0; i < pointcloud->points.size(); ++i) {
+    const auto & point = pointcloud->points[i];
     const int index =
       voxel_grid_.getCentroidIndexAt(voxel_grid_.getGridCoordinates(point.x, point.y, point.z));
-    if (map.find(index) != map.end()) {
-      temporary_clusters.at(map[index]).points.push_back(point);
+    if (0 <= index && index < static_cast<int>(voxel_to_cluster.size())) {
+      point_to_cluster[i] = voxel_to_cluster[index];
+      if (0 <= point_to_cluster[i]) {
+        ++cluster_sizes[point_to_cluster[i]];
+      }
     }
   }
 
   // build output and check cluster size
-  {
-    for (const auto & cluster : temporary_clusters) {
-      if (!(min_cluster_size_ <= static_cast<int>(cluster.points.size()) &&
-            static_cast<int>(cluster.points.size()) <= max_cluster_size_)) {
-        continue;
-      }
-      clusters.push_back(cluster);
-      clusters.back().width = cluster.points.size();
-      clusters.back().height = 1;
-      clusters.back().is_dense = false;
+  clusters.clear();
+  std::vector<size_t> cluster_offsets(voxel_clusters.size());
+  for (size_t cluster_idx = 0; cluster_idx < voxel_clusters.size(); ++cluster_idx) {
+    const int size = cluster_sizes[cluster_idx];
+    if (size == 0 || !(min_cluster_size_ <= size && size <= max_cluster_size_)) {
+      cluster_sizes[cluster_idx] = 0;
+      continue;
+    }
+    cluster_offsets[cluster_idx] = clusters.offsets.back();
+    clusters.offsets.push_back(clusters.offsets.back() + size);
+  }
+  clusters.indices.resize(clusters.offsets.back());
+  for (size_t i = 0; i < point_to_cluster.size(); ++i) {
+    const int cluster_idx = point_to_cluster[i];
+    if (0 <= cluster_idx && 0 < cluster_sizes[cluster_idx]) {
+      clusters.indices[cluster_offsets[cluster_idx]++] = static_cast<int>(i);
     }
   }
 
@@ -53,12 +53,12 @@ void VoxelGridBasedEuclideanClusterNode::onPointCloud(
   pcl::fromROSMsg(*input_msg, *raw_pointcloud_ptr);
 
   // clustering
-  std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters;
-  cluster_->cluster(raw_pointcloud_ptr, clusters);
+  ClusterIndices clusters;
+  cluster_->clusterIndices(raw_pointcloud_ptr, clusters);
 
   // build output msg
   autoware_perception_msgs::msg::DynamicObjectWithFeatureArray output;
-  convertPointCloudClusters2Msg(input_msg->header, clusters, output);
+  convertPointCloudClusters2Msg(input_msg->header, *raw_pointcloud_ptr, clusters, output);
   cluster_pub_->publish(output);
 
   // build debug msg
@@ -46,7 +46,6 @@
 #ifndef LIDAR_APOLLO_INSTANCE_SEGMENTATION__CLUSTER2D_HPP_
 #define LIDAR_APOLLO_INSTANCE_SEGMENTATION__CLUSTER2D_HPP_
 
-#include "disjoint_set.hpp"
 #include "util.hpp"
 
 #include <autoware_perception_msgs/msg/dynamic_object_with_feature.hpp>
@@ -57,6 +56,8 @@
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -124,29 +125,19 @@ private:
   pcl::PointCloud<pcl::PointXYZI>::Ptr pc_ptr_;
   const std::vector<int> * valid_indices_in_pc_ = nullptr;
 
-  struct Node
-  {
-    Node * center_node;
-    Node * parent;
-    char node_rank;
-    char traversed;
-    bool is_center;
-    bool is_object;
-    int point_num;
-    int obstacle_id;
-
-    Node()
-    {
-      center_node = nullptr;
-      parent = nullptr;
-      node_rank = 0;
-      traversed = 0;
-      is_center = false;
-      is_object = false;
-      point_num = 0;
-      obstacle_id = -1;
-    }
-  };
+  // grids of the 2d map, flattened in row-major order and kept between the frames
+  std::vector<int> point_nums_;
+  std::vector<int> center_grids_;
+  std::vector<uint8_t> is_objects_;
+  std::vector<uint8_t> is_centers_;
+  std::vector<uint8_t> traversed_;
+  std::vector<int> center_representatives_;
+  std::vector<int> traverse_path_;
+  // union-find of the center grids, unite() is called from several threads
+  std::unique_ptr<std::atomic<int>[]> parents_;
+
+  int findRoot(int grid) const;
+  void unite(int grid1, int grid2);
 
   inline bool IsValidRowCol(int row, int col) const { return IsValidRow(row) && IsValidCol(col); }
 
@@ -156,7 +147,9 @@ private:
 
   inline int RowCol2Grid(int row, int col) const { return row * cols_ + col; }
 
-  void traverse(Node * x);
+  /** \brief Follow the center grids from grid until a traversed grid. The grids of a new cycle
+   * are centers, and all the traversed grids share the center representative of the cycle. */
+  void traverse(int grid);
 };
 
 #endif  // LIDAR_APOLLO_INSTANCE_SEGMENTATION__CLUSTER2D_HPP_
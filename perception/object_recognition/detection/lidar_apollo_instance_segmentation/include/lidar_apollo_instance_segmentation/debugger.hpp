@@ -14,9 +14,11 @@
 
 #pragma once
 
+#include <autoware_utils/ros/debug_publisher.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_perception_msgs/msg/dynamic_object_with_feature_array.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
 
 class Debugger
 {
@@ -27,5 +29,9 @@ public:
     const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & input);
 
 private:
-  rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr instance_pointcloud_pub_;
+  sensor_msgs::msg::PointCloud2 createColoredPointCloud(
+    const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & input) const;
+
+  // the colored pointcloud is only made while debug/instance_pointcloud has a subscriber
+  autoware_utils::DebugPublisher debug_publisher_;
 };
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "lidar_apollo_instance_segmentation/feature_generator_kernel.hpp"
 #include "lidar_apollo_instance_segmentation/feature_map.hpp"
 #include "util.hpp"
 
@@ -25,18 +26,33 @@
 class FeatureGenerator
 {
 private:
+  struct CudaDeleter
+  {
+    void operator()(void * p) const { cudaFree(p); }
+  };
+
   float min_height_;
   float max_height_;
   bool use_intensity_feature_;
   bool use_constant_feature_;
   std::shared_ptr<FeatureMapInterface> map_ptr_;
 
+  FeatureMapParams params_;
+  std::unique_ptr<char, CudaDeleter> points_d_;
+  size_t points_capacity_;
+  std::unique_ptr<TopPointKey, CudaDeleter> top_points_d_;
+  // feature map whose constant channels have been written
+  float * initialized_feature_map_d_;
+
 public:
   FeatureGenerator(
     const int width, const int height, const int range, const bool use_intensity_feature,
     const bool use_constant_feature);
   ~FeatureGenerator() {}
 
-  std::shared_ptr<FeatureMapInterface> generate(
-    const pcl::PointCloud<pcl::PointXYZI>::Ptr & pc_ptr);
+  /** \brief Write the feature map of pc_ptr to feature_map_d on stream, a device buffer of
+   * channels * height * width floats such as the input binding of the network. */
+  void generate(
+    const pcl::PointCloud<pcl::PointXYZI>::Ptr & pc_ptr, float * feature_map_d,
+    cudaStream_t stream);
 };
@@ -0,0 +1,54 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+
+// height and index of the highest point of a grid, the integer type of atomicMax
+using TopPointKey = unsigned long long;  // NOLINT
+
+/** \brief Size of the feature map and its channel indices, -1 for the channels it does not have.
+ * The constant channels are not written by the kernels. */
+struct FeatureMapParams
+{
+  int width;
+  int height;
+  float range;
+  float inv_res_x;
+  float inv_res_y;
+  float min_height;
+  float max_height;
+  int max_height_channel;
+  int mean_height_channel;
+  int count_channel;
+  int top_intensity_channel;
+  int mean_intensity_channel;
+  int nonempty_channel;
+};
+
+/**
+ * Write the features of the points to the feature map, as FeatureGenerator did on the CPU.
+ * @param points [num_points points of point_step bytes, float x, y, z at 0, 4, 8, on the device]
+ * @param intensity_offset [offset of the float intensity in a point]
+ * @param top_points [(height * width), highest point of each grid, work buffer]
+ * @param feature_map [(channels, height, width), such as the input binding of the network]
+ */
+cudaError_t generateFeatureMap_launch(
+  const char * points, const int num_points, const int point_step, const int intensity_offset,
+  const FeatureMapParams & params, TopPointKey * top_points, float * feature_map,
+  cudaStream_t stream);
@@ -43,13 +43,17 @@ enum class RUN_MODE { FLOAT32 = 0, FLOAT16 = 1, INT8 = 2 };
 class trtNet
 {
 public:
-  // Load from engine file
-  explicit trtNet(const std::string & engineFile);
+  // Load from engine file, and run on a stream of the priority. Lower numbers are higher
+  // priorities, clamped to the range of the device.
+  explicit trtNet(const std::string & engineFile, const int streamPriority = 0);
 
   ~trtNet()
   {
     // Release the stream and the buffers
     cudaStreamSynchronize(mTrtCudaStream);
+    if (mTrtGraphExec) {
+      cudaGraphExecDestroy(mTrtGraphExec);
+    }
     cudaStreamDestroy(mTrtCudaStream);
     for (auto & item : mTrtCudaBuffer) {
       cudaFree(item);
@@ -83,6 +87,13 @@ public:
   }
 
   void doInference(const void * inputData, void * outputData);
+  // run on the input already written to getInputBuffer() on getStream(), as a CUDA graph
+  // captured at the second call
+  void doInference(void * outputData);
+
+  inline void * getInputBuffer() { return mTrtCudaBuffer[0]; }
+
+  inline cudaStream_t getStream() { return mTrtCudaStream; }
 
   inline size_t getInputSize()
   {
@@ -97,13 +108,16 @@ public:
   }
 
 private:
-  void InitEngine();
+  void InitEngine(const int streamPriority);
+  bool captureGraph();
 
   nvinfer1::IExecutionContext * mTrtContext;
   nvinfer1::ICudaEngine * mTrtEngine;
   nvinfer1::IRuntime * mTrtRunTime;
   cudaStream_t mTrtCudaStream;
-  Profiler mTrtProfiler;
+  cudaGraphExec_t mTrtGraphExec;
+  bool mTrtUseGraph;
+  bool mTrtIsWarmedUp;
   RUN_MODE mTrtRunMode;
 
   std::vector<void *> mTrtCudaBuffer;
@@ -76,10 +76,13 @@ inline unsigned int getElementSize(nvinfer1::DataType t)
 
 namespace Tn
 {
-trtNet::trtNet(const std::string & engineFile)
+trtNet::trtNet(const std::string & engineFile, const int streamPriority)
 : mTrtContext(nullptr),
   mTrtEngine(nullptr),
   mTrtRunTime(nullptr),
+  mTrtGraphExec(nullptr),
+  mTrtUseGraph(true),
+  mTrtIsWarmedUp(false),
   mTrtRunMode(RUN_MODE::FLOAT32),
   mTrtInputCount(0)
 {
@@ -103,15 +106,15 @@ trtNet::trtNet(const std::string & engineFile)
   mTrtEngine = mTrtRunTime->deserializeCudaEngine(data.get(), length, nullptr);
   assert(mTrtEngine != nullptr);
 
-  InitEngine();
+  InitEngine(streamPriority);
 }
 
-void trtNet::InitEngine()
+void trtNet::InitEngine(const int streamPriority)
 {
   const int maxBatchSize = 1;
   mTrtContext = mTrtEngine->createExecutionContext();
+  // no profiler: it synchronizes the stream after each layer and prevents the graph capture
   assert(mTrtContext != nullptr);
-  mTrtContext->setProfiler(&mTrtProfiler);
 
   int nbBindings = mTrtEngine->getNbBindings();
 
@@ -128,7 +131,7 @@ void trtNet::InitEngine()
     }
   }
 
-  CUDA_CHECK(cudaStreamCreate(&mTrtCudaStream));
+  CUDA_CHECK(cudaStreamCreateWithPriority(&mTrtCudaStream, cudaStreamDefault, streamPriority));
 }
 
 void trtNet::doInference(const void * inputData, void * outputData)
@@ -149,4 +152,59 @@ void trtNet::doInference(const void * inputData, void * outputData)
       outputData, mTrtCudaBuffer[bindingIdx], size, cudaMemcpyDeviceToHost, mTrtCudaStream));
   }
 }
+
+bool trtNet::captureGraph()
+{
+  static const int batchSize = 1;
+  if (cudaStreamBeginCapture(mTrtCudaStream, cudaStreamCaptureModeThreadLocal) != cudaSuccess) {
+    cudaGetLastError();
+    return false;
+  }
+  const bool isEnqueued =
+    mTrtContext->enqueue(batchSize, &mTrtCudaBuffer[0], mTrtCudaStream, nullptr);
+  cudaGraph_t graph = nullptr;
+  const cudaError_t captureError = cudaStreamEndCapture(mTrtCudaStream, &graph);
+  if (!isEnqueued || captureError != cudaSuccess) {
+    if (graph) {
+      cudaGraphDestroy(graph);
+    }
+    cudaGetLastError();
+    std::cout << "Fail to capture the inference as a CUDA graph, enqueue it instead" << std::endl;
+    return false;
+  }
+  const cudaError_t instantiateError =
+    cudaGraphInstantiate(&mTrtGraphExec, graph, nullptr, nullptr, 0);
+  cudaGraphDestroy(graph);
+  if (instantiateError != cudaSuccess) {
+    mTrtGraphExec = nullptr;
+    cudaGetLastError();
+    return false;
+  }
+  return true;
+}
+
+void trtNet::doInference(void * outputData)
+{
+  static const int batchSize = 1;
+  assert(mTrtInputCount == 1);
+
+  // The shapes and the buffers are fixed, so once a first enqueue has initialized TensorRT, the
+  // inference is captured and launched as one CUDA graph instead of a launch per kernel
+  if (mTrtUseGraph && mTrtIsWarmedUp && !mTrtGraphExec) {
+    mTrtUseGraph = captureGraph();
+  }
+  if (mTrtGraphExec) {
+    CUDA_CHECK(cudaGraphLaunch(mTrtGraphExec, mTrtCudaStream));
+  } else {
+    mTrtContext->enqueue(batchSize, &mTrtCudaBuffer[0], mTrtCudaStream, nullptr);
+  }
+  mTrtIsWarmedUp = true;
+
+  for (size_t bindingIdx = mTrtInputCount; bindingIdx < mTrtBindBufferSize.size(); ++bindingIdx) {
+    auto size = mTrtBindBufferSize[bindingIdx];
+    CUDA_CHECK(cudaMemcpyAsync(
+      outputData, mTrtCudaBuffer[bindingIdx], size, cudaMemcpyDeviceToHost, mTrtCudaStream));
+  }
+  CUDA_CHECK(cudaStreamSynchronize(mTrtCudaStream));
+}
 }  // namespace Tn
@@ -49,6 +49,9 @@
 #include <pcl_conversions/pcl_conversions.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 
+#include <algorithm>
+#include <utility>
+
 geometry_msgs::msg::Quaternion getQuaternionFromRPY(const double r, const double p, const double y)
 {
   tf2::Quaternion q;
@@ -69,28 +72,70 @@ Cluster2D::Cluster2D(const int rows, const int cols, const float range)
   id_img_.assign(siz_, -1);
   pc_ptr_.reset();
   valid_indices_in_pc_ = nullptr;
+
+  point_nums_.resize(siz_);
+  center_grids_.resize(siz_);
+  is_objects_.resize(siz_);
+  is_centers_.resize(siz_);
+  traversed_.resize(siz_);
+  center_representatives_.resize(siz_);
+  parents_.reset(new std::atomic<int>[siz_]);
 }
 
-void Cluster2D::traverse(Node * x)
+int Cluster2D::findRoot(int grid) const
 {
-  std::vector<Node *> p;
-  p.clear();
+  int parent = parents_[grid].load(std::memory_order_relaxed);
+  while (parent != grid) {
+    // path halving, a lost race only leaves a longer path
+    const int grandparent = parents_[parent].load(std::memory_order_relaxed);
+    parents_[grid].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+    grid = grandparent;
+    parent = parents_[grid].load(std::memory_order_relaxed);
+  }
+  return grid;
+}
 
-  while (x->traversed == 0) {
-    p.push_back(x);
-    x->traversed = 2;
-    x = x->center_node;
+void Cluster2D::unite(int grid1, int grid2)
+{
+  while (true) {
+    grid1 = findRoot(grid1);
+    grid2 = findRoot(grid2);
+    if (grid1 == grid2) {
+      return;
+    }
+    // the smaller grid is the root, so that concurrent links cannot form a cycle
+    if (grid1 < grid2) {
+      std::swap(grid1, grid2);
+    }
+    int expected = grid1;
+    if (parents_[grid1].compare_exchange_strong(expected, grid2, std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+void Cluster2D::traverse(int grid)
+{
+  // traversed_: 0 not yet, 1 done, 2 on the current path
+  traverse_path_.clear();
+  while (traversed_[grid] == 0) {
+    traverse_path_.push_back(grid);
+    traversed_[grid] = 2;
+    grid = center_grids_[grid];
   }
-  if (x->traversed == 2) {
-    for (int i = static_cast<int>(p.size()) - 1; i >= 0 && p[i] != x; i--) {
-      p[i]->is_center = true;
+  if (traversed_[grid] == 2) {
+    // a new cycle, from grid to the end of the path
+    for (int i = static_cast<int>(traverse_path_.size()) - 1;
+         i >= 0 && traverse_path_[i] != grid; --i) {
+      is_centers_[traverse_path_[i]] = true;
     }
-    x->is_center = true;
+    is_centers_[grid] = true;
+    center_representatives_[grid] = grid;
   }
-  for (size_t i = 0; i < p.size(); i++) {
-    Node * y = p[i];
-    y->traversed = 1;
-    y->parent = x->parent;
+  const int representative = center_representatives_[grid];
+  for (const int path_grid : traverse_path_) {
+    traversed_[path_grid] = 1;
+    center_representatives_[path_grid] = representative;
   }
 }
 
@@ -105,10 +150,9 @@ void Cluster2D::cluster(
 
   pc_ptr_ = pc_ptr;
 
-  std::vector<std::vector<Node>> nodes(rows_, std::vector<Node>(cols_, Node()));
-
   valid_indices_in_pc_ = &(valid_indices.indices);
   point2grid_.assign(valid_indices_in_pc_->size(), -1);
+  std::fill(point_nums_.begin(), point_nums_.end(), 0);
 
   for (size_t i = 0; i < valid_indices_in_pc_->size(); ++i) {
     int point_id = valid_indices_in_pc_->at(i);
@@ -120,71 +164,70 @@ void Cluster2D::cluster(
     int pos_y = F2I(point.x, range_, inv_res_y_);  // row
     if (IsValidRowCol(pos_y, pos_x)) {
       point2grid_[i] = RowCol2Grid(pos_y, pos_x);
-      nodes[pos_y][pos_x].point_num++;
+      point_nums_[point2grid_[i]]++;
     }
   }
 
+#pragma omp parallel for
   for (int row = 0; row < rows_; ++row) {
     for (int col = 0; col < cols_; ++col) {
-      int grid = RowCol2Grid(row, col);
-      Node * node = &nodes[row][col];
-      DisjointSetMakeSet(node);
-      node->is_object = (use_all_grids_for_clustering || nodes[row][col].point_num > 0) &&
-                        (*(category_pt_data + grid) >= objectness_thresh);
+      const int grid = RowCol2Grid(row, col);
+      is_objects_[grid] = (use_all_grids_for_clustering || point_nums_[grid] > 0) &&
+                          (*(category_pt_data + grid) >= objectness_thresh);
       int center_row = std::round(row + instance_pt_x_data[grid] * scale_);
       int center_col = std::round(col + instance_pt_y_data[grid] * scale_);
       center_row = std::min(std::max(center_row, 0), rows_ - 1);
       center_col = std::min(std::max(center_col, 0), cols_ - 1);
-      node->center_node = &nodes[center_row][center_col];
+      center_grids_[grid] = RowCol2Grid(center_row, center_col);
+      is_centers_[grid] = false;
+      traversed_[grid] = 0;
+      parents_[grid].store(grid, std::memory_order_relaxed);
     }
   }
 
-  for (int row = 0; row < rows_; ++row) {
-    for (int col = 0; col < cols_; ++col) {
-      Node * node = &nodes[row][col];
-      if (node->is_object && node->traversed == 0) {
-        traverse(node);
-      }
+  // the paths are short and mostly shared, this pass stays sequential
+  for (int grid = 0; grid < siz_; ++grid) {
+    if (is_objects_[grid] && traversed_[grid] == 0) {
+      traverse(grid);
     }
   }
 
+  // connected components of the centers: the grids of a cycle and the 4-neighbouring centers
+#pragma omp parallel for schedule(dynamic, 8)
   for (int row = 0; row < rows_; ++row) {
     for (int col = 0; col < cols_; ++col) {
-      Node * node = &nodes[row][col];
-      if (!node->is_center) {
+      const int grid = RowCol2Grid(row, col);
+      if (!is_centers_[grid]) {
         continue;
       }
-      for (int row2 = row - 1; row2 <= row + 1; ++row2) {
-        for (int col2 = col - 1; col2 <= col + 1; ++col2) {
-          if ((row2 == row || col2 == col) && IsValidRowCol(row2, col2)) {
-            Node * node2 = &nodes[row2][col2];
-            if (node2->is_center) {
-              DisjointSetUnion(node, node2);
-            }
-          }
-        }
+      if (is_centers_[center_grids_[grid]]) {
+        unite(grid, center_grids_[grid]);
+      }
+      if (col + 1 < cols_ && is_centers_[grid + 1]) {
+        unite(grid, grid + 1);
+      }
+      if (row + 1 < rows_ && is_centers_[grid + cols_]) {
+        unite(grid, grid + cols_);
       }
     }
   }
 
+  // obstacle ids in the order of their first grid
   int count_obstacles = 0;
   obstacles_.clear();
   id_img_.assign(siz_, -1);
-  for (int row = 0; row < rows_; ++row) {
-    for (int col = 0; col < cols_; ++col) {
-      Node * node = &nodes[row][col];
-      if (!node->is_object) {
-        continue;
-      }
-      Node * root = DisjointSetFind(node);
-      if (root->obstacle_id < 0) {
-        root->obstacle_id = count_obstacles++;
-        obstacles_.push_back(Obstacle());
-      }
-      int grid = RowCol2Grid(row, col);
-      id_img_[grid] = root->obstacle_id;
-      obstacles_[root->obstacle_id].grids.push_back(grid);
+  std::vector<int> root_to_obstacle(siz_, -1);
+  for (int grid = 0; grid < siz_; ++grid) {
+    if (!is_objects_[grid]) {
+      continue;
+    }
+    const int root = findRoot(center_representatives_[grid]);
+    if (root_to_obstacle[root] < 0) {
+      root_to_obstacle[root] = count_obstacles++;
+      obstacles_.push_back(Obstacle());
     }
+    id_img_[grid] = root_to_obstacle[root];
+    obstacles_[id_img_[grid]].grids.push_back(grid);
   }
   filter(inferred_data);
   classify(inferred_data);
@@ -197,6 +240,7 @@ void Cluster2D::filter(const std::shared_ptr<float> & inferred_data)
   const float * heading_pt_y_data = inferred_data.get() + siz_ * 10;
   const float * height_pt_data = inferred_data.get() + siz_ * 11;
 
+#pragma omp parallel for schedule(dynamic)
   for (size_t obstacle_id = 0; obstacle_id < obstacles_.size(); obstacle_id++) {
     Obstacle * obs = &obstacles_[obstacle_id];
     double score = 0.0;
@@ -220,6 +264,7 @@ void Cluster2D::classify(const std::shared_ptr<float> & inferred_data)
 {
   const float * classify_pt_data = inferred_data.get() + siz_ * 4;
   int num_classes = 5;
+#pragma omp parallel for schedule(dynamic)
   for (size_t obs_id = 0; obs_id < obstacles_.size(); obs_id++) {
     Obstacle * obs = &obstacles_[obs_id];
 
@@ -20,14 +20,20 @@
 #include <pcl/point_types.h>
 #include <pcl_conversions/pcl_conversions.h>
 
-Debugger::Debugger(rclcpp::Node * node)
+Debugger::Debugger(rclcpp::Node * node) : debug_publisher_(node, "debug")
 {
-  instance_pointcloud_pub_ =
-    node->create_publisher<sensor_msgs::msg::PointCloud2>("debug/instance_pointcloud", 1);
+  debug_publisher_.setEnabled(node->declare_parameter("publish_debug", true));
 }
 
 void Debugger::publishColoredPointCloud(
   const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & input)
+{
+  debug_publisher_.publishLazy<sensor_msgs::msg::PointCloud2>(
+    "instance_pointcloud", [this, &input]() { return createColoredPointCloud(input); });
+}
+
+sensor_msgs::msg::PointCloud2 Debugger::createColoredPointCloud(
+  const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & input) const
 {
   pcl::PointCloud<pcl::PointXYZRGB> colored_pointcloud;
   for (size_t i = 0; i < input.feature_objects.size(); i++) {
@@ -94,5 +100,5 @@ void Debugger::publishColoredPointCloud(
   sensor_msgs::msg::PointCloud2 output_msg;
   pcl::toROSMsg(colored_pointcloud, output_msg);
   output_msg.header = input.header;
-  instance_pointcloud_pub_->publish(output_msg);
+  return output_msg;
 }
@@ -39,6 +39,8 @@ LidarApolloInstanceSegmentation::LidarApolloInstanceSegmentation(rclcpp::Node *
   use_constant_feature = node_->declare_parameter("use_constant_feature", true);
   target_frame_ = node_->declare_parameter("target_frame", "base_link");
   z_offset_ = node_->declare_parameter("z_offset", 2);
+  // lidar detection is on the critical path, ahead of the camera networks
+  const int stream_priority = node_->declare_parameter("stream_priority", -2);
 
   // load weight file
   std::ifstream fs(engine_file);
@@ -75,7 +77,7 @@ LidarApolloInstanceSegmentation::LidarApolloInstanceSegmentation(rclcpp::Node *
     builder->destroy();
     config->destroy();
   }
-  net_ptr_.reset(new Tn::trtNet(engine_file));
+  net_ptr_.reset(new Tn::trtNet(engine_file, stream_priority));
 
   // feature map generator: pre process
   feature_generator_ = std::make_shared<FeatureGenerator>(
@@ -134,13 +136,14 @@ bool LidarApolloInstanceSegmentation::detectDynamicObjects(
   pcl::PointCloud<pcl::PointXYZI>::Ptr pcl_pointcloud_raw_ptr(new pcl::PointCloud<pcl::PointXYZI>);
   pcl::fromROSMsg(transformed_cloud, *pcl_pointcloud_raw_ptr);
 
-  // generate feature map
-  std::shared_ptr<FeatureMapInterface> feature_map_ptr =
-    feature_generator_->generate(pcl_pointcloud_raw_ptr);
+  // generate feature map into the input of the network
+  feature_generator_->generate(
+    pcl_pointcloud_raw_ptr, static_cast<float *>(net_ptr_->getInputBuffer()),
+    net_ptr_->getStream());
 
   // inference
   std::shared_ptr<float> inferred_data(new float[net_ptr_->getOutputSize() / sizeof(float)]);
-  net_ptr_->doInference(feature_map_ptr->map_data.data(), inferred_data.get());
+  net_ptr_->doInference(inferred_data.get());
 
   // post process
   const float objectness_thresh = 0.5;
@@ -14,11 +14,19 @@
 
 #include "lidar_apollo_instance_segmentation/feature_generator.hpp"
 
-#include "lidar_apollo_instance_segmentation/log_table.hpp"
+#include <Utils.hpp>
+
+#include <cassert>
 
 namespace
 {
-inline float normalizeIntensity(float intensity) { return intensity / 255.0f; }
+int getChannel(const FeatureMapInterface & map, const float * channel_data)
+{
+  if (channel_data == nullptr) {
+    return -1;
+  }
+  return static_cast<int>((channel_data - map.map_data.data()) / (map.width * map.height));
+}
 }  // namespace
 
 FeatureGenerator::FeatureGenerator(
@@ -27,7 +35,9 @@ FeatureGenerator::FeatureGenerator(
 : min_height_(-5.0),
   max_height_(5.0),
   use_intensity_feature_(use_intensity_feature),
-  use_constant_feature_(use_constant_feature)
+  use_constant_feature_(use_constant_feature),
+  points_capacity_(0),
+  initialized_feature_map_d_(nullptr)
 {
   // select feature map type
   if (use_constant_feature && use_intensity_feature) {
@@ -40,56 +50,55 @@ FeatureGenerator::FeatureGenerator(
     map_ptr_ = std::make_shared<FeatureMap>(width, height, range);
   }
   map_ptr_->initializeMap(map_ptr_->map_data);
-}
-
-std::shared_ptr<FeatureMapInterface> FeatureGenerator::generate(
-  const pcl::PointCloud<pcl::PointXYZI>::Ptr & pc_ptr)
-{
-  const double epsilon = 1e-6;
   map_ptr_->resetMap(map_ptr_->map_data);
 
-  int size = map_ptr_->height * map_ptr_->width;
+  params_.width = map_ptr_->width;
+  params_.height = map_ptr_->height;
+  params_.range = map_ptr_->range;
+  params_.inv_res_x = 0.5 * map_ptr_->width / map_ptr_->range;
+  params_.inv_res_y = 0.5 * map_ptr_->height / map_ptr_->range;
+  params_.min_height = min_height_;
+  params_.max_height = max_height_;
+  params_.max_height_channel = getChannel(*map_ptr_, map_ptr_->max_height_data);
+  params_.mean_height_channel = getChannel(*map_ptr_, map_ptr_->mean_height_data);
+  params_.count_channel = getChannel(*map_ptr_, map_ptr_->count_data);
+  params_.top_intensity_channel = getChannel(*map_ptr_, map_ptr_->top_intensity_data);
+  params_.mean_intensity_channel = getChannel(*map_ptr_, map_ptr_->mean_intensity_data);
+  params_.nonempty_channel = getChannel(*map_ptr_, map_ptr_->nonempty_data);
 
-  const float inv_res_x = 0.5 * map_ptr_->width / map_ptr_->range;
-  const float inv_res_y = 0.5 * map_ptr_->height / map_ptr_->range;
-
-  for (size_t i = 0; i < pc_ptr->points.size(); ++i) {
-    if (pc_ptr->points[i].z <= min_height_ || max_height_ <= pc_ptr->points[i].z) {
-      continue;
-    }
-
-    const int pos_x = std::floor((map_ptr_->range - pc_ptr->points[i].y) * inv_res_x);  // x on grid
-    const int pos_y = std::floor((map_ptr_->range - pc_ptr->points[i].x) * inv_res_y);  // y on grid
-    if (pos_x < 0 || map_ptr_->width <= pos_x || pos_y < 0 || map_ptr_->height <= pos_y) {
-      continue;
-    }
-
-    const int idx = pos_y * map_ptr_->width + pos_x;
+  void * top_points_d = nullptr;
+  CUDA_CHECK(cudaMalloc(&top_points_d, sizeof(TopPointKey) * width * height));
+  top_points_d_.reset(static_cast<TopPointKey *>(top_points_d));
+}
 
-    if (map_ptr_->max_height_data[idx] < pc_ptr->points[i].z) {
-      map_ptr_->max_height_data[idx] = pc_ptr->points[i].z;
-      if (map_ptr_->top_intensity_data != nullptr) {
-        map_ptr_->top_intensity_data[idx] = normalizeIntensity(pc_ptr->points[i].intensity);
-      }
-    }
-    map_ptr_->mean_height_data[idx] += static_cast<float>(pc_ptr->points[i].z);
-    if (map_ptr_->mean_intensity_data != nullptr) {
-      map_ptr_->mean_intensity_data[idx] += normalizeIntensity(pc_ptr->points[i].intensity);
-    }
-    map_ptr_->count_data[idx] += 1.0f;
+void FeatureGenerator::generate(
+  const pcl::PointCloud<pcl::PointXYZI>::Ptr & pc_ptr, float * feature_map_d, cudaStream_t stream)
+{
+  // the constant channels are written once, the kernels overwrite the others
+  if (feature_map_d != initialized_feature_map_d_) {
+    CUDA_CHECK(cudaMemcpyAsync(
+      feature_map_d, map_ptr_->map_data.data(), sizeof(float) * map_ptr_->map_data.size(),
+      cudaMemcpyHostToDevice, stream));
+    initialized_feature_map_d_ = feature_map_d;
   }
 
-  for (int i = 0; i < size; ++i) {
-    if (map_ptr_->count_data[i] < epsilon) {
-      map_ptr_->max_height_data[i] = 0.0f;
-    } else {
-      map_ptr_->mean_height_data[i] /= map_ptr_->count_data[i];
-      if (map_ptr_->mean_intensity_data != nullptr) {
-        map_ptr_->mean_intensity_data[i] /= map_ptr_->count_data[i];
-      }
-      map_ptr_->nonempty_data[i] = 1.0f;
-    }
-    map_ptr_->count_data[i] = calcApproximateLog(map_ptr_->count_data[i]);
+  const size_t num_points = pc_ptr->points.size();
+  if (points_capacity_ < num_points) {
+    points_d_.reset();
+    void * points_d = nullptr;
+    CUDA_CHECK(cudaMalloc(&points_d, sizeof(pcl::PointXYZI) * num_points));
+    points_d_.reset(static_cast<char *>(points_d));
+    points_capacity_ = num_points;
+  }
+  if (num_points > 0) {
+    CUDA_CHECK(cudaMemcpyAsync(
+      points_d_.get(), pc_ptr->points.data(), sizeof(pcl::PointXYZI) * num_points,
+      cudaMemcpyHostToDevice, stream));
   }
-  return map_ptr_;
+  const pcl::PointXYZI point;
+  const int intensity_offset =
+    reinterpret_cast<const char *>(&point.intensity) - reinterpret_cast<const char *>(&point);
+  CUDA_CHECK(generateFeatureMap_launch(
+    points_d_.get(), static_cast<int>(num_points), sizeof(pcl::PointXYZI), intensity_offset,
+    params_, top_points_d_.get(), feature_map_d, stream));
 }
@@ -0,0 +1,142 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lidar_apollo_instance_segmentation/feature_generator_kernel.hpp"
+
+namespace
+{
+constexpr int THREADS_PER_BLOCK = 256;
+
+// unsigned order of the floats, for atomicMax
+__device__ uint32_t toOrderedBits(const float value)
+{
+  const uint32_t bits = __float_as_uint(value);
+  return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+__device__ float toFloat(const uint32_t ordered_bits)
+{
+  return __uint_as_float(
+    (ordered_bits & 0x80000000u) ? (ordered_bits & 0x7fffffffu) : ~ordered_bits);
+}
+
+__device__ const float * getPoint(const char * points, const int point_step, const int i)
+{
+  return reinterpret_cast<const float *>(points + static_cast<size_t>(i) * point_step);
+}
+
+// one thread per point
+__global__ void accumulateFeatures_kernel(
+  const char * points, const int num_points, const int point_step, const int intensity_offset,
+  const FeatureMapParams params, TopPointKey * top_points, float * feature_map)
+{
+  const int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= num_points) {
+    return;
+  }
+  const float * point = getPoint(points, point_step, i);
+  const float x = point[0];
+  const float y = point[1];
+  const float z = point[2];
+  if (z <= params.min_height || params.max_height <= z) {
+    return;
+  }
+  const int pos_x = floorf((params.range - y) * params.inv_res_x);  // x on grid
+  const int pos_y = floorf((params.range - x) * params.inv_res_y);  // y on grid
+  if (pos_x < 0 || params.width <= pos_x || pos_y < 0 || params.height <= pos_y) {
+    return;
+  }
+  const int size = params.width * params.height;
+  const int idx = pos_y * params.width + pos_x;
+
+  // highest point, the first one of equal heights like the sequential loop
+  const TopPointKey key = (static_cast<TopPointKey>(toOrderedBits(z)) << 32) |
+                          (0xffffffffu - static_cast<uint32_t>(i));
+  atomicMax(top_points + idx, key);
+  atomicAdd(feature_map + params.mean_height_channel * size + idx, z);
+  if (params.mean_intensity_channel >= 0) {
+    const float intensity = point[intensity_offset / sizeof(float)];
+    atomicAdd(feature_map + params.mean_intensity_channel * size + idx, intensity / 255.0f);
+  }
+  atomicAdd(feature_map + params.count_channel * size + idx, 1.0f);
+}
+
+// one thread per grid
+__global__ void finalizeFeatures_kernel(
+  const char * points, const int point_step, const int intensity_offset,
+  const FeatureMapParams params, const TopPointKey * top_points, float * feature_map)
+{
+  const int size = params.width * params.height;
+  const int idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= size) {
+    return;
+  }
+  float & count = feature_map[params.count_channel * size + idx];
+  if (count < 1e-6f) {
+    feature_map[params.max_height_channel * size + idx] = 0.0f;
+  } else {
+    const TopPointKey key = top_points[idx];
+    feature_map[params.max_height_channel * size + idx] = toFloat(key >> 32);
+    feature_map[params.mean_height_channel * size + idx] /= count;
+    if (params.top_intensity_channel >= 0) {
+      const int i = 0xffffffffu - static_cast<uint32_t>(key & 0xffffffffu);
+      const float * point = getPoint(points, point_step, i);
+      feature_map[params.top_intensity_channel * size + idx] =
+        point[intensity_offset / sizeof(float)] / 255.0f;
+    }
+    if (params.mean_intensity_channel >= 0) {
+      feature_map[params.mean_intensity_channel * size + idx] /= count;
+    }
+    feature_map[params.nonempty_channel * size + idx] = 1.0f;
+  }
+  // the counts are integers, where the former log table was exact
+  count = log1pf(count);
+}
+}  // namespace
+
+cudaError_t generateFeatureMap_launch(
+  const char * points, const int num_points, const int point_step, const int intensity_offset,
+  const FeatureMapParams & params, TopPointKey * top_points, float * feature_map,
+  cudaStream_t stream)
+{
+  const int size = params.width * params.height;
+  const int accumulated_channels[] = {
+    params.mean_height_channel, params.count_channel, params.top_intensity_channel,
+    params.mean_intensity_channel, params.nonempty_channel};
+  for (const int channel : accumulated_channels) {
+    if (channel < 0) {
+      continue;
+    }
+    const cudaError_t error =
+      cudaMemsetAsync(feature_map + channel * size, 0, sizeof(float) * size, stream);
+    if (error != cudaSuccess) {
+      return error;
+    }
+  }
+  const cudaError_t error = cudaMemsetAsync(top_points, 0, sizeof(TopPointKey) * size, stream);
+  if (error != cudaSuccess) {
+    return error;
+  }
+
+  if (num_points > 0) {
+    const int blocks = (num_points + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    accumulateFeatures_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      points, num_points, point_step, intensity_offset, params, top_points, feature_map);
+  }
+  const int blocks = (size + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+  finalizeFeatures_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    points, point_step, intensity_offset, params, top_points, feature_map);
+  return cudaGetLastError();
+}
@@ -18,7 +18,8 @@
 #include <config.hpp>
 #include <cuda_utils.hpp>
 #include <network_trt.hpp>
-#include <voxel_generator.hpp>
+#include <pointcloud_densification.hpp>
+#include <preprocess_kernel.hpp>
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
@@ -64,27 +65,39 @@ private:
 class CenterPointTRT
 {
 public:
+  /** \brief The preprocessing and the TensorRT networks run on a stream of stream_priority.
+   * Lower numbers are higher priorities, clamped to the range of the device. */
   explicit CenterPointTRT(
-    const NetworkParam & encoder_param, const NetworkParam & head_param, bool verbose);
+    const NetworkParam & encoder_param, const NetworkParam & head_param, bool verbose,
+    const int stream_priority = 0);
 
   ~CenterPointTRT();
 
-  std::vector<float> detect(const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg);
+  /** \brief Detect the objects in the sweeps of densification, in the current frame. */
+  std::vector<float> detect(const PointCloudDensification & densification);
 
 private:
   bool initPtr(bool use_encoder_trt, bool use_head_trt);
 
   bool loadTorchScript(torch::jit::script::Module & module, const std::string & model_path);
 
-  static at::Tensor createInputFeatures(
-    const at::Tensor & voxels, const at::Tensor & coords, const at::Tensor & voxel_num_points);
+  struct DeviceSweep
+  {
+    uint64_t id = 0;
+    bool is_valid = false;
+    size_t capacity = 0;
+    cuda::unique_ptr<char[]> points_d;
+  };
+
+  /** \brief Compute the encoder input features of the sweeps on the device. Only the sweeps
+   * that are not on the device yet are uploaded, the past ones stay there. */
+  void preprocess(const PointCloudDensification & densification);
 
-  static at::Tensor scatterPillarFeatures(
-    const at::Tensor & pillar_features, const at::Tensor & coordinates);
+  /** \brief Copy the data of pointcloud_msg through the pinned staging buffer. */
+  void uploadSweep(const sensor_msgs::msg::PointCloud2 & pointcloud_msg, DeviceSweep & sweep);
 
   at::Tensor generatePredictedBoxes();
 
-  std::unique_ptr<VoxelGeneratorTemplate> vg_ptr_ = nullptr;
   torch::jit::script::Module encoder_pt_;
   torch::jit::script::Module head_pt_;
   std::unique_ptr<VoxelEncoderTRT> encoder_trt_ptr_ = nullptr;
@@ -92,7 +105,18 @@ private:
   c10::Device device_ = torch::kCUDA;
   cudaStream_t stream_ = nullptr;
 
-  at::Tensor voxels_t_;
+  // persistent preprocessing buffers, the staging and sweep buffers grow with the input size
+  size_t staging_capacity_ = 0;
+  cuda::unique_ptr_host<char[]> staging_h_;
+  std::vector<DeviceSweep> device_sweeps_;  // ring indexed by the sweep id
+  cuda::unique_ptr_host<SweepInfo[]> sweeps_h_;
+  cuda::unique_ptr<SweepInfo[]> sweeps_d_;
+  cuda::unique_ptr<int[]> cell_to_voxel_d_;
+  cuda::unique_ptr<int[]> voxel_count_d_;
+  cuda::unique_ptr<float[]> voxels_d_;
+
+  at::Tensor input_features_t_;
+  at::Tensor spatial_features_t_;
   at::Tensor coordinates_t_;
   at::Tensor num_points_per_voxel_t_;
   at::Tensor output_pillar_feature_t_;
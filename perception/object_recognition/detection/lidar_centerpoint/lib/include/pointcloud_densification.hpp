@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 #ifndef POINTCLOUD_DENSIFICATION_HPP_
 #define POINTCLOUD_DENSIFICATION_HPP_
 
@@ -19,19 +20,45 @@
 #include <tf2_ros/transform_listener.h>
 #include <tf2_sensor_msgs/tf2_sensor_msgs.h>
 
+#include <cstdint>
 #include <list>
 #include <string>
 
 namespace centerpoint
 {
+struct PointCloudWithTransform
+{
+  sensor_msgs::msg::PointCloud2::ConstSharedPtr pointcloud_msg;
+  Eigen::Affine3f affine_past2base;
+  uint64_t id;  // increases with every enqueued pointcloud
+};
+
+/** \brief Keeps the latest pointclouds and their poses in base_frame_id. The past sweeps are not
+ * transformed here: each one is stored once with its pose, and the detector transforms its
+ * points to the current frame while voxelizing them.
+ */
 class PointCloudDensification
 {
 public:
   PointCloudDensification(
     std::string base_frame_id, unsigned int pointcloud_cache_size, rclcpp::Clock::SharedPtr clock);
 
-  sensor_msgs::msg::PointCloud2 stackPointCloud(
-    const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg);
+  /** \brief Add the current pointcloud and drop the oldest sweep beyond the cache size. */
+  void enqueuePointCloud(const sensor_msgs::msg::PointCloud2::ConstSharedPtr & pointcloud_msg);
+
+  /** \brief Sweeps from the current one to the oldest one. */
+  const std::list<PointCloudWithTransform> & getPointCloudCache() const
+  {
+    return pointcloud_cache_;
+  }
+  /** \brief Number of sweeps kept, the current one and the past ones. */
+  unsigned int getMaxNumSweeps() const { return pointcloud_cache_size_ + 1; }
+  const Eigen::Affine3f & getAffineBase2Current() const { return affine_base2current_; }
+  double getCurrentTimestamp() const { return current_timestamp_; }
+
+  /** \brief Concatenation of the sweeps transformed to the current frame, with the time lag in the
+   * intensity field. Only needed for debugging, the detector reads the sweeps directly. */
+  sensor_msgs::msg::PointCloud2 stackPointCloud() const;
 
 private:
   geometry_msgs::msg::TransformStamped getTransformStamped(
@@ -43,8 +70,10 @@ private:
   unsigned int pointcloud_cache_size_ = 0;
   tf2_ros::Buffer tf_buffer_;
   tf2_ros::TransformListener tf_listener_{tf_buffer_};
-  std::list<sensor_msgs::msg::PointCloud2> pointcloud_cache_;
-  std::list<Eigen::Matrix4f> matrix_past2base_cache_;
+  std::list<PointCloudWithTransform> pointcloud_cache_;
+  Eigen::Affine3f affine_base2current_{Eigen::Affine3f::Identity()};
+  double current_timestamp_{0.0};
+  uint64_t next_id_{0};
 };
 
 }  // namespace centerpoint
@@ -0,0 +1,86 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef PREPROCESS_KERNEL_HPP_
+#define PREPROCESS_KERNEL_HPP_
+
+#include <config.hpp>
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace centerpoint
+{
+// x, y, z, time lag, offsets to the voxel mean (3) and to the pillar center (2)
+constexpr int num_voxel_input_features = Config::num_point_features + Config::num_point_dims + 2;
+
+/** \brief Layout of the float fields of a PointCloud2 point. */
+struct PointFieldOffsets
+{
+  int x;
+  int y;
+  int z;
+};
+
+/** \brief PointCloud2 data of a sweep on the device, with its transform to the current frame. */
+struct SweepInfo
+{
+  const char * points;
+  uint64_t num_points;
+  uint32_t point_step;
+  PointFieldOffsets offsets;
+  float transform[12];  // row-major 3x4
+  float time_lag;
+};
+
+/**
+ * Transform the points of the sweeps to the current frame and assign them to voxels.
+ * @param sweeps [num_sweeps sweeps, on the device]
+ * @param max_num_points [largest num_points of the sweeps]
+ * @param cell_to_voxel [voxel index of each grid cell, (grid_size_z * grid_size_y * grid_size_x)]
+ * @param voxel_count [number of voxels found, may exceed max_num_voxels]
+ * @param voxels [(max_num_voxels, max_num_points_per_voxel, num_point_features)]
+ * @param coordinates [zyx grid coordinates, (max_num_voxels, num_point_dims)]
+ * @param num_points_per_voxel [(max_num_voxels)]
+ */
+cudaError_t generateVoxels_launch(
+  const SweepInfo * sweeps, const int num_sweeps, const size_t max_num_points, int * cell_to_voxel,
+  int * voxel_count, float * voxels, int * coordinates, int * num_points_per_voxel,
+  cudaStream_t stream);
+
+/**
+ * Compute the encoder input of each voxel as createInputFeatures did with libtorch. The padding
+ * points and the voxels beyond voxel_count are zero. num_points_per_voxel is clamped to
+ * max_num_points_per_voxel.
+ * @param features [(max_num_voxels, max_num_points_per_voxel, num_voxel_input_features)]
+ */
+cudaError_t generateFeatures_launch(
+  const float * voxels, int * num_points_per_voxel, const int * coordinates,
+  const int * voxel_count, float * features, cudaStream_t stream);
+
+/**
+ * Scatter the encoded voxel features to the BEV grid.
+ * @param pillar_features [(max_num_voxels, num_encoder_output_features)]
+ * @param spatial_features [(num_encoder_output_features, grid_size_y, grid_size_x)]
+ */
+cudaError_t scatterFeatures_launch(
+  const float * pillar_features, const int * coordinates, const int * voxel_count,
+  float * spatial_features, cudaStream_t stream);
+
+}  // namespace centerpoint
+
+#endif  // PREPROCESS_KERNEL_HPP_
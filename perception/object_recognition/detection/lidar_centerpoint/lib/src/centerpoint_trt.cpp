@@ -15,14 +15,18 @@
 #include <autoware_utils/math/constants.hpp>
 #include <centerpoint_trt.hpp>
 #include <heatmap_utils.hpp>
+#include <rclcpp/time.hpp>
 
 #include <ATen/cuda/CUDAContext.h>
 #include <NvOnnxParser.h>
 #include <c10/cuda/CUDAStream.h>
 #include <torch/script.h>
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -30,13 +34,10 @@
 
 namespace centerpoint
 {
-using torch::indexing::Slice;
-
 CenterPointTRT::CenterPointTRT(
-  const NetworkParam & encoder_param, const NetworkParam & head_param, const bool verbose)
+  const NetworkParam & encoder_param, const NetworkParam & head_param, const bool verbose,
+  const int stream_priority)
 {
-  vg_ptr_ = std::make_unique<VoxelGenerator>();
-
   if (encoder_param.use_trt()) {
     encoder_trt_ptr_ = std::make_unique<VoxelEncoderTRT>(verbose);
     encoder_trt_ptr_->init(
@@ -60,7 +61,7 @@ CenterPointTRT::CenterPointTRT(
 
   torch::set_num_threads(1);  // disable CPU parallelization
 
-  cudaStreamCreate(&stream_);
+  cudaStreamCreateWithPriority(&stream_, cudaStreamDefault, stream_priority);
 }
 
 CenterPointTRT::~CenterPointTRT()
@@ -73,6 +74,25 @@ CenterPointTRT::~CenterPointTRT()
 
 bool CenterPointTRT::initPtr(const bool use_encoder_trt, const bool use_head_trt)
 {
+  cell_to_voxel_d_ = cuda::make_unique<int[]>(
+    Config::grid_size_z * Config::grid_size_y * Config::grid_size_x);
+  voxel_count_d_ = cuda::make_unique<int[]>(1);
+  voxels_d_ = cuda::make_unique<float[]>(
+    Config::max_num_voxels * Config::max_num_points_per_voxel * Config::num_point_features);
+
+  // the torch encoder takes the coordinates and number of points as well
+  const auto int_options = torch::TensorOptions().device(device_).dtype(torch::kInt);
+  const auto float_options = torch::TensorOptions().device(device_).dtype(torch::kFloat);
+  coordinates_t_ = torch::zeros({Config::max_num_voxels, Config::num_point_dims}, int_options);
+  num_points_per_voxel_t_ = torch::zeros({Config::max_num_voxels}, int_options);
+  input_features_t_ = torch::zeros(
+    {Config::max_num_voxels, Config::max_num_points_per_voxel, num_voxel_input_features},
+    float_options);
+  spatial_features_t_ = torch::zeros(
+    {1 /*batch size*/, Config::num_encoder_output_features, Config::grid_size_y,
+     Config::grid_size_x},
+    float_options);
+
   if (use_encoder_trt) {
     output_pillar_feature_t_ = torch::zeros(
       {Config::max_num_voxels, Config::num_encoder_output_features},
@@ -108,36 +128,118 @@ bool CenterPointTRT::initPtr(const bool use_encoder_trt, const bool use_head_trt
   return true;
 }
 
-std::vector<float> CenterPointTRT::detect(
-  const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg)
+namespace
+{
+PointFieldOffsets getPointFieldOffsets(const sensor_msgs::msg::PointCloud2 & pointcloud_msg)
+{
+  PointFieldOffsets offsets{-1, -1, -1};
+  for (const auto & field : pointcloud_msg.fields) {
+    int * offset = field.name == "x"   ? &offsets.x
+                   : field.name == "y" ? &offsets.y
+                   : field.name == "z" ? &offsets.z
+                                       : nullptr;
+    if (offset) {
+      if (field.datatype != sensor_msgs::msg::PointField::FLOAT32 || field.offset % 4 != 0) {
+        throw std::runtime_error("field " + field.name + " must be an aligned float32");
+      }
+      *offset = static_cast<int>(field.offset);
+    }
+  }
+  if (offsets.x < 0 || offsets.y < 0 || offsets.z < 0) {
+    throw std::runtime_error("pointcloud must have the fields x, y and z");
+  }
+  if (pointcloud_msg.point_step % 4 != 0) {
+    throw std::runtime_error("point_step must be a multiple of 4");
+  }
+  return offsets;
+}
+}  // namespace
+
+void CenterPointTRT::uploadSweep(
+  const sensor_msgs::msg::PointCloud2 & pointcloud_msg, DeviceSweep & sweep)
+{
+  const size_t data_size =
+    static_cast<size_t>(pointcloud_msg.width) * pointcloud_msg.height * pointcloud_msg.point_step;
+  // a previous copy may still read the staging buffer
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(stream_));
+  if (data_size > staging_capacity_) {
+    // grow geometrically, so that the buffer is only reallocated a few times
+    staging_capacity_ = std::max(data_size, 2 * staging_capacity_);
+    staging_h_ = cuda::make_unique_host<char[]>(staging_capacity_);
+  }
+  if (data_size > sweep.capacity) {
+    sweep.capacity = std::max(data_size, 2 * sweep.capacity);
+    sweep.points_d = cuda::make_unique<char[]>(sweep.capacity);
+  }
+  if (data_size > 0) {
+    std::memcpy(staging_h_.get(), pointcloud_msg.data.data(), data_size);
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      sweep.points_d.get(), staging_h_.get(), data_size, cudaMemcpyHostToDevice, stream_));
+  }
+}
+
+void CenterPointTRT::preprocess(const PointCloudDensification & densification)
+{
+  const size_t max_num_sweeps = densification.getMaxNumSweeps();
+  if (device_sweeps_.size() != max_num_sweeps) {
+    device_sweeps_ = std::vector<DeviceSweep>(max_num_sweeps);
+    sweeps_h_ = cuda::make_unique_host<SweepInfo[]>(max_num_sweeps);
+    sweeps_d_ = cuda::make_unique<SweepInfo[]>(max_num_sweeps);
+  }
+
+  int num_sweeps = 0;
+  size_t max_num_points = 0;
+  const Eigen::Affine3f & affine_base2current = densification.getAffineBase2Current();
+  for (const auto & cached_sweep : densification.getPointCloudCache()) {
+    const auto & pointcloud_msg = *cached_sweep.pointcloud_msg;
+    DeviceSweep & device_sweep = device_sweeps_[cached_sweep.id % max_num_sweeps];
+    if (!device_sweep.is_valid || device_sweep.id != cached_sweep.id) {
+      uploadSweep(pointcloud_msg, device_sweep);
+      device_sweep.id = cached_sweep.id;
+      device_sweep.is_valid = true;
+    }
+
+    SweepInfo & sweep = sweeps_h_[num_sweeps++];
+    sweep.points = device_sweep.points_d.get();
+    sweep.num_points = static_cast<uint64_t>(pointcloud_msg.width) * pointcloud_msg.height;
+    sweep.point_step = pointcloud_msg.point_step;
+    sweep.offsets = getPointFieldOffsets(pointcloud_msg);
+    const Eigen::Matrix4f past2current =
+      (affine_base2current * cached_sweep.affine_past2base).matrix();
+    for (int row = 0; row < 3; ++row) {
+      for (int col = 0; col < 4; ++col) {
+        sweep.transform[row * 4 + col] = past2current(row, col);
+      }
+    }
+    sweep.time_lag = static_cast<float>(
+      densification.getCurrentTimestamp() -
+      rclcpp::Time(pointcloud_msg.header.stamp).seconds());
+    max_num_points = std::max(max_num_points, static_cast<size_t>(sweep.num_points));
+  }
+
+  if (num_sweeps > 0) {
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      sweeps_d_.get(), sweeps_h_.get(), sizeof(SweepInfo) * num_sweeps, cudaMemcpyHostToDevice,
+      stream_));
+  }
+  CHECK_CUDA_ERROR(generateVoxels_launch(
+    sweeps_d_.get(), num_sweeps, max_num_points, cell_to_voxel_d_.get(), voxel_count_d_.get(),
+    voxels_d_.get(), coordinates_t_.data_ptr<int>(), num_points_per_voxel_t_.data_ptr<int>(),
+    stream_));
+  CHECK_CUDA_ERROR(generateFeatures_launch(
+    voxels_d_.get(), num_points_per_voxel_t_.data_ptr<int>(), coordinates_t_.data_ptr<int>(),
+    voxel_count_d_.get(), input_features_t_.data_ptr<float>(), stream_));
+}
+
+std::vector<float> CenterPointTRT::detect(const PointCloudDensification & densification)
 {
-  voxels_t_ = torch::zeros(
-    {Config::max_num_voxels, Config::max_num_points_per_voxel, Config::num_point_features},
-    torch::TensorOptions().device(torch::kCPU).dtype(torch::kFloat));
-  coordinates_t_ = torch::zeros(
-    {Config::max_num_voxels, Config::num_point_dims},
-    torch::TensorOptions().device(torch::kCPU).dtype(torch::kInt));
-  num_points_per_voxel_t_ = torch::zeros(
-    {Config::max_num_voxels}, torch::TensorOptions().device(torch::kCPU).dtype(torch::kInt));
-
-  int num_voxels = vg_ptr_->pointsToVoxels(
-    input_pointcloud_msg, voxels_t_, coordinates_t_, num_points_per_voxel_t_);
-  // Note: unlike python implementation, no slicing by num_voxels
-  //       .s.t voxels_t_ = voxels_t_[:num_voxels].
-  //       w/ slicing more GPU memories are allocated
-
-  voxels_t_ = voxels_t_.to(device_);
-  coordinates_t_ = coordinates_t_.to(device_);
-  num_points_per_voxel_t_ = num_points_per_voxel_t_.to(device_);
-  at::Tensor input_features =
-    createInputFeatures(voxels_t_, coordinates_t_, num_points_per_voxel_t_);
-
-  // Note: num_voxels <= max_num_voxels, so input_features[num_voxels:] are invalid features.
-  input_features.index_put_({Slice(num_voxels)}, 0);
+  // stream_ is a blocking stream, so it is ordered with the torch operations on the default
+  // stream
+  preprocess(densification);
 
   if (encoder_trt_ptr_ && encoder_trt_ptr_->context_) {
     std::vector<void *> encoder_buffers{
-      input_features.data_ptr(), output_pillar_feature_t_.data_ptr()};
+      input_features_t_.data_ptr(), output_pillar_feature_t_.data_ptr()};
     encoder_trt_ptr_->context_->setBindingDimensions(
       0, nvinfer1::Dims3(
            Config::max_num_voxels, Config::max_num_points_per_voxel,
@@ -145,27 +247,28 @@ std::vector<float> CenterPointTRT::detect(
     encoder_trt_ptr_->context_->enqueueV2(encoder_buffers.data(), stream_, nullptr);
   } else {
     std::vector<torch::jit::IValue> batch_input_features;
-    batch_input_features.emplace_back(input_features);
+    batch_input_features.emplace_back(input_features_t_);
     batch_input_features.emplace_back(num_points_per_voxel_t_);
     batch_input_features.emplace_back(coordinates_t_);
     {
       torch::NoGradGuard no_grad;
-      output_pillar_feature_t_ = encoder_pt_.forward(batch_input_features).toTensor();
+      output_pillar_feature_t_ = encoder_pt_.forward(batch_input_features).toTensor().contiguous();
     }
   }
 
-  at::Tensor spatial_features =
-    scatterPillarFeatures(output_pillar_feature_t_, coordinates_t_.to(torch::kLong));
+  CHECK_CUDA_ERROR(scatterFeatures_launch(
+    output_pillar_feature_t_.data_ptr<float>(), coordinates_t_.data_ptr<int>(),
+    voxel_count_d_.get(), spatial_features_t_.data_ptr<float>(), stream_));
 
   if (head_trt_ptr_ && head_trt_ptr_->context_) {
-    std::vector<void *> head_buffers = {spatial_features.data_ptr(), output_heatmap_t_.data_ptr(),
-                                        output_offset_t_.data_ptr(), output_z_t_.data_ptr(),
-                                        output_dim_t_.data_ptr(),    output_rot_t_.data_ptr(),
-                                        output_vel_t_.data_ptr()};
+    std::vector<void *> head_buffers = {
+      spatial_features_t_.data_ptr(), output_heatmap_t_.data_ptr(), output_offset_t_.data_ptr(),
+      output_z_t_.data_ptr(),         output_dim_t_.data_ptr(),     output_rot_t_.data_ptr(),
+      output_vel_t_.data_ptr()};
     head_trt_ptr_->context_->enqueueV2(head_buffers.data(), stream_, nullptr);
   } else {
     std::vector<torch::jit::IValue> batch_spatial_features;
-    batch_spatial_features.emplace_back(spatial_features);
+    batch_spatial_features.emplace_back(spatial_features_t_);
 
     {
       torch::NoGradGuard no_grad;
@@ -186,61 +289,6 @@ std::vector<float> CenterPointTRT::detect(
   return boxes3d_vec;
 }
 
-at::Tensor CenterPointTRT::createInputFeatures(
-  const at::Tensor & voxels, const at::Tensor & coords, const at::Tensor & voxel_num_points)
-{
-  // voxels (float): (num_pillars, num_max_points, num_point_features)
-  // coordinates (int): (num_pillars, num_point_dims)
-  // voxel_num_points (int): (num_pillars,)
-
-  at::Tensor coords_f = coords.to(torch::kFloat);
-  at::Tensor voxel_num_points_f = voxel_num_points.to(torch::kFloat);
-
-  at::Tensor points_mean =
-    voxels.slice(/*dim=*/2, /*start=*/0, /*end=*/3).sum({1}, /*keepdim=*/true) /
-    voxel_num_points_f.view({-1, 1, 1});
-  at::Tensor cluster = voxels.slice(2, 0, 3) - points_mean;
-
-  // Note: unlike python implementation, batch_index isn't used in coords,
-  at::Tensor center_x =
-    voxels.slice(2, 0, 1) -
-    (coords_f.slice(1, 2, 3).unsqueeze(2) * Config::voxel_size_x + Config::offset_x);
-  at::Tensor center_y =
-    voxels.slice(2, 1, 2) -
-    (coords_f.slice(1, 1, 2).unsqueeze(2) * Config::voxel_size_y + Config::offset_y);
-  at::Tensor input_features = torch::cat({voxels, cluster, center_x, center_y}, /*dim=*/2);
-
-  // paddings_indicator
-  const size_t axis = 0;
-  const int voxel_cnt = input_features.sizes()[1];
-  at::Tensor actual_num = voxel_num_points.unsqueeze(axis + 1);
-  at::Tensor max_num =
-    torch::arange(
-      voxel_cnt, torch::TensorOptions().dtype(torch::kInt32).device(actual_num.device()))
-      .view({1, -1});
-  at::Tensor mask = actual_num.to(torch::kInt32) > max_num;
-  mask = mask.unsqueeze(-1).to(torch::kFloat);
-  input_features *= mask;
-
-  return input_features;  // (num_pillars, num_max_points, num_voxel_features)
-}
-
-at::Tensor CenterPointTRT::scatterPillarFeatures(
-  const at::Tensor & pillar_features, const at::Tensor & coordinates)
-{
-  // pillar_features (float): (num_pillars, num_encoder_output_features)
-  // coordinates (float): (num_pillars, num_point_dims)
-
-  at::Tensor spatial_feature = torch::zeros(
-    {Config::num_encoder_output_features, Config::grid_size_y * Config::grid_size_x},
-    torch::TensorOptions().dtype(pillar_features.dtype()).device(pillar_features.device()));
-  auto index = coordinates.select(1, 1) * Config::grid_size_x + coordinates.select(1, 2);
-  spatial_feature.index_put_({"...", index}, pillar_features.t());
-
-  return spatial_feature.view({1 /*batch size*/, -1, Config::grid_size_y, Config::grid_size_x})
-    .contiguous();
-}
-
 at::Tensor CenterPointTRT::generatePredictedBoxes()
 {
   // output_heatmap (float): (batch_size, num_class, H, W)
@@ -18,6 +18,7 @@
 #include <pcl_conversions/pcl_conversions.h>
 #include <tf2_eigen/tf2_eigen.h>
 
+#include <iterator>
 #include <string>
 #include <utility>
 
@@ -32,37 +33,41 @@ PointCloudDensification::PointCloudDensification(
 {
 }
 
-sensor_msgs::msg::PointCloud2 PointCloudDensification::stackPointCloud(
-  const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg)
+void PointCloudDensification::enqueuePointCloud(
+  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & pointcloud_msg)
 {
-  const double input_timestamp = rclcpp::Time(input_pointcloud_msg.header.stamp).seconds();
+  auto transform_frame2base = getTransformStamped(base_frame_id_, pointcloud_msg->header.frame_id);
+  Eigen::Affine3f affine_past2base;
+  affine_past2base.matrix() =
+    tf2::transformToEigen(transform_frame2base.transform).matrix().cast<float>();
 
-  auto transform_base2frame =
-    getTransformStamped(input_pointcloud_msg.header.frame_id, base_frame_id_);
-  Eigen::Matrix4f matrix_base2current =
-    tf2::transformToEigen(transform_base2frame.transform).matrix().cast<float>();
+  current_timestamp_ = rclcpp::Time(pointcloud_msg->header.stamp).seconds();
+  affine_base2current_ = affine_past2base.inverse();
 
+  pointcloud_cache_.push_front(PointCloudWithTransform{pointcloud_msg, affine_past2base, next_id_});
+  ++next_id_;
+  if (pointcloud_cache_.size() > getMaxNumSweeps()) {
+    pointcloud_cache_.pop_back();
+  }
+}
+
+sensor_msgs::msg::PointCloud2 PointCloudDensification::stackPointCloud() const
+{
   sensor_msgs::msg::PointCloud2 output_pointcloud_msg;
-  output_pointcloud_msg = input_pointcloud_msg;
+  if (pointcloud_cache_.empty()) {
+    return output_pointcloud_msg;
+  }
+  output_pointcloud_msg = *pointcloud_cache_.front().pointcloud_msg;
   setTimeLag(output_pointcloud_msg, 0);
 
   // concat the current frame and past frames
-  auto pc_msg_iter = pointcloud_cache_.begin();
-  auto matrix_iter = matrix_past2base_cache_.begin();
-  for (; pc_msg_iter != pointcloud_cache_.end(); pc_msg_iter++, matrix_iter++) {
-    sensor_msgs::msg::PointCloud2 cached_pointcloud_msg = *pc_msg_iter;
+  for (auto iter = std::next(pointcloud_cache_.begin()); iter != pointcloud_cache_.end(); ++iter) {
     sensor_msgs::msg::PointCloud2 transformed_pointcloud_msg;
-
-    Eigen::Affine3f affine_past2base;
-    affine_past2base.matrix() = *matrix_iter;
-    Eigen::Affine3f affine_base2current;
-    affine_base2current.matrix() = matrix_base2current;
-
     pcl_ros::transformPointCloud(
-      (affine_base2current * affine_past2base).matrix(), cached_pointcloud_msg,
+      (affine_base2current_ * iter->affine_past2base).matrix(), *iter->pointcloud_msg,
       transformed_pointcloud_msg);
     double diff_timestamp =
-      input_timestamp - rclcpp::Time(cached_pointcloud_msg.header.stamp).seconds();
+      current_timestamp_ - rclcpp::Time(iter->pointcloud_msg->header.stamp).seconds();
     setTimeLag(transformed_pointcloud_msg, static_cast<float>(diff_timestamp));
 
     sensor_msgs::msg::PointCloud2 tmp_pointcloud_msg = output_pointcloud_msg;
@@ -70,18 +75,6 @@ sensor_msgs::msg::PointCloud2 PointCloudDensification::stackPointCloud(
       tmp_pointcloud_msg, transformed_pointcloud_msg, output_pointcloud_msg);
   }
 
-  // add input pointcloud to cache
-  auto transform_frame2base =
-    getTransformStamped(base_frame_id_, input_pointcloud_msg.header.frame_id);
-  Eigen::Matrix4f matrix_past2base =
-    tf2::transformToEigen(transform_frame2base.transform).matrix().cast<float>();
-  pointcloud_cache_.push_front(input_pointcloud_msg);
-  matrix_past2base_cache_.push_front(matrix_past2base);
-  if (pointcloud_cache_.size() > pointcloud_cache_size_) {
-    pointcloud_cache_.pop_back();
-    matrix_past2base_cache_.pop_back();
-  }
-
   return output_pointcloud_msg;
 }
 
@@ -0,0 +1,247 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <preprocess_kernel.hpp>
+
+namespace centerpoint
+{
+namespace
+{
+constexpr int THREADS_PER_BLOCK = 256;
+constexpr int VOXELS_PER_BLOCK = 8;
+constexpr int NUM_CELLS = Config::grid_size_z * Config::grid_size_y * Config::grid_size_x;
+
+// cell_to_voxel states besides a voxel index
+constexpr int EMPTY_CELL = -1;
+constexpr int PENDING_CELL = -2;
+constexpr int DROPPED_CELL = -3;
+
+__device__ int getCellIndex(const SweepInfo & sweep, const size_t i, float4 * point, int3 * coord)
+{
+  const char * p = sweep.points + i * sweep.point_step;
+  const float x = *reinterpret_cast<const float *>(p + sweep.offsets.x);
+  const float y = *reinterpret_cast<const float *>(p + sweep.offsets.y);
+  const float z = *reinterpret_cast<const float *>(p + sweep.offsets.z);
+  const float * t = sweep.transform;
+  point->x = t[0] * x + t[1] * y + t[2] * z + t[3];
+  point->y = t[4] * x + t[5] * y + t[6] * z + t[7];
+  point->z = t[8] * x + t[9] * y + t[10] * z + t[11];
+  point->w = sweep.time_lag;
+
+  // same rounding as the former CPU voxel generator
+  coord->x =
+    static_cast<int>((point->x - Config::pointcloud_range_xmin) * (1 / Config::voxel_size_x));
+  coord->y =
+    static_cast<int>((point->y - Config::pointcloud_range_ymin) * (1 / Config::voxel_size_y));
+  coord->z =
+    static_cast<int>((point->z - Config::pointcloud_range_zmin) * (1 / Config::voxel_size_z));
+  if (
+    coord->x < 0 || coord->x >= Config::grid_size_x || coord->y < 0 ||
+    coord->y >= Config::grid_size_y || coord->z < 0 || coord->z >= Config::grid_size_z) {
+    return -1;
+  }
+  return (coord->z * Config::grid_size_y + coord->y) * Config::grid_size_x + coord->x;
+}
+
+// one thread per point, blockIdx.y is the sweep
+__global__ void assignVoxels_kernel(
+  const SweepInfo * sweeps, int * cell_to_voxel, int * voxel_count, int * coordinates)
+{
+  const SweepInfo & sweep = sweeps[blockIdx.y];
+  const size_t i = blockIdx.x * static_cast<size_t>(blockDim.x) + threadIdx.x;
+  if (i >= sweep.num_points) {
+    return;
+  }
+  float4 point;
+  int3 coord;
+  const int cell = getCellIndex(sweep, i, &point, &coord);
+  if (cell < 0 || atomicCAS(&cell_to_voxel[cell], EMPTY_CELL, PENDING_CELL) != EMPTY_CELL) {
+    return;
+  }
+  // the first point of a cell allocates its voxel
+  const int voxel = atomicAdd(voxel_count, 1);
+  if (voxel >= Config::max_num_voxels) {
+    cell_to_voxel[cell] = DROPPED_CELL;
+    return;
+  }
+  cell_to_voxel[cell] = voxel;
+  coordinates[voxel * Config::num_point_dims + 0] = coord.z;
+  coordinates[voxel * Config::num_point_dims + 1] = coord.y;
+  coordinates[voxel * Config::num_point_dims + 2] = coord.x;
+}
+
+__global__ void fillVoxels_kernel(
+  const SweepInfo * sweeps, const int * cell_to_voxel, float * voxels, int * num_points_per_voxel)
+{
+  const SweepInfo & sweep = sweeps[blockIdx.y];
+  const size_t i = blockIdx.x * static_cast<size_t>(blockDim.x) + threadIdx.x;
+  if (i >= sweep.num_points) {
+    return;
+  }
+  float4 point;
+  int3 coord;
+  const int cell = getCellIndex(sweep, i, &point, &coord);
+  if (cell < 0) {
+    return;
+  }
+  const int voxel = cell_to_voxel[cell];
+  if (voxel < 0) {
+    return;
+  }
+  const int slot = atomicAdd(&num_points_per_voxel[voxel], 1);
+  if (slot >= Config::max_num_points_per_voxel) {
+    return;
+  }
+  float * v = voxels +
+              (voxel * Config::max_num_points_per_voxel + slot) * Config::num_point_features;
+  v[0] = point.x;
+  v[1] = point.y;
+  v[2] = point.z;
+  v[3] = point.w;
+}
+
+// one warp per voxel, one lane per point slot
+__global__ void generateFeatures_kernel(
+  const float * voxels, int * num_points_per_voxel, const int * coordinates,
+  const int * voxel_count, float * features)
+{
+  const int voxel = blockIdx.x * VOXELS_PER_BLOCK + threadIdx.y;
+  const int slot = threadIdx.x;
+  const bool is_valid_voxel =
+    voxel < Config::max_num_voxels && voxel < min(*voxel_count, Config::max_num_voxels);
+
+  int num_points = 0;
+  if (is_valid_voxel) {
+    num_points = min(num_points_per_voxel[voxel], Config::max_num_points_per_voxel);
+  }
+  __syncthreads();
+  if (voxel >= Config::max_num_voxels) {
+    return;
+  }
+  if (slot == 0) {
+    num_points_per_voxel[voxel] = num_points;
+  }
+
+  const bool is_valid_point = slot < num_points;
+  float4 point = make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+  if (is_valid_point) {
+    const float * v = voxels +
+                      (voxel * Config::max_num_points_per_voxel + slot) *
+                        Config::num_point_features;
+    point = make_float4(v[0], v[1], v[2], v[3]);
+  }
+
+  float3 sum = make_float3(point.x, point.y, point.z);
+  for (int lane_mask = 16; lane_mask > 0; lane_mask /= 2) {
+    sum.x += __shfl_xor_sync(0xffffffff, sum.x, lane_mask);
+    sum.y += __shfl_xor_sync(0xffffffff, sum.y, lane_mask);
+    sum.z += __shfl_xor_sync(0xffffffff, sum.z, lane_mask);
+  }
+
+  float * f =
+    features + (voxel * Config::max_num_points_per_voxel + slot) * num_voxel_input_features;
+  if (!is_valid_point) {
+    for (int i = 0; i < num_voxel_input_features; ++i) {
+      f[i] = 0.0f;
+    }
+    return;
+  }
+  const float inverse_num_points = 1.0f / num_points;
+  const float center_x =
+    coordinates[voxel * Config::num_point_dims + 2] * Config::voxel_size_x + Config::offset_x;
+  const float center_y =
+    coordinates[voxel * Config::num_point_dims + 1] * Config::voxel_size_y + Config::offset_y;
+  f[0] = point.x;
+  f[1] = point.y;
+  f[2] = point.z;
+  f[3] = point.w;
+  f[4] = point.x - sum.x * inverse_num_points;
+  f[5] = point.y - sum.y * inverse_num_points;
+  f[6] = point.z - sum.z * inverse_num_points;
+  f[7] = point.x - center_x;
+  f[8] = point.y - center_y;
+}
+
+__global__ void scatterFeatures_kernel(
+  const float * pillar_features, const int * coordinates, const int * voxel_count,
+  float * spatial_features)
+{
+  const int i = blockIdx.x * blockDim.x + threadIdx.x;
+  const int voxel = i / Config::num_encoder_output_features;
+  const int feature = i % Config::num_encoder_output_features;
+  if (voxel >= min(*voxel_count, Config::max_num_voxels)) {
+    return;
+  }
+  const int y = coordinates[voxel * Config::num_point_dims + 1];
+  const int x = coordinates[voxel * Config::num_point_dims + 2];
+  spatial_features[(feature * Config::grid_size_y + y) * Config::grid_size_x + x] =
+    pillar_features[voxel * Config::num_encoder_output_features + feature];
+}
+}  // namespace
+
+cudaError_t generateVoxels_launch(
+  const SweepInfo * sweeps, const int num_sweeps, const size_t max_num_points, int * cell_to_voxel,
+  int * voxel_count, float * voxels, int * coordinates, int * num_points_per_voxel,
+  cudaStream_t stream)
+{
+  // all bytes 0xff is EMPTY_CELL
+  cudaMemsetAsync(cell_to_voxel, 0xff, sizeof(int) * NUM_CELLS, stream);
+  cudaMemsetAsync(voxel_count, 0, sizeof(int), stream);
+  cudaMemsetAsync(
+    coordinates, 0, sizeof(int) * Config::max_num_voxels * Config::num_point_dims, stream);
+  cudaMemsetAsync(num_points_per_voxel, 0, sizeof(int) * Config::max_num_voxels, stream);
+  if (num_sweeps == 0 || max_num_points == 0) {
+    return cudaGetLastError();
+  }
+
+  const dim3 blocks(
+    static_cast<unsigned int>((max_num_points + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK),
+    static_cast<unsigned int>(num_sweeps));
+  assignVoxels_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    sweeps, cell_to_voxel, voxel_count, coordinates);
+  fillVoxels_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    sweeps, cell_to_voxel, voxels, num_points_per_voxel);
+  return cudaGetLastError();
+}
+
+cudaError_t generateFeatures_launch(
+  const float * voxels, int * num_points_per_voxel, const int * coordinates,
+  const int * voxel_count, float * features, cudaStream_t stream)
+{
+  static_assert(Config::max_num_points_per_voxel == 32, "one lane per point of a voxel");
+  const dim3 threads(Config::max_num_points_per_voxel, VOXELS_PER_BLOCK);
+  const int blocks = (Config::max_num_voxels + VOXELS_PER_BLOCK - 1) / VOXELS_PER_BLOCK;
+  generateFeatures_kernel<<<blocks, threads, 0, stream>>>(
+    voxels, num_points_per_voxel, coordinates, voxel_count, features);
+  return cudaGetLastError();
+}
+
+cudaError_t scatterFeatures_launch(
+  const float * pillar_features, const int * coordinates, const int * voxel_count,
+  float * spatial_features, cudaStream_t stream)
+{
+  cudaMemsetAsync(
+    spatial_features, 0,
+    sizeof(float) * Config::num_encoder_output_features * Config::grid_size_y *
+      Config::grid_size_x,
+    stream);
+  const int num_threads = Config::max_num_voxels * Config::num_encoder_output_features;
+  const int blocks = (num_threads + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+  scatterFeatures_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    pillar_features, coordinates, voxel_count, spatial_features);
+  return cudaGetLastError();
+}
+
+}  // namespace centerpoint
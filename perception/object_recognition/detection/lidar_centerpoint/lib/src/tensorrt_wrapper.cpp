@@ -33,11 +33,13 @@ bool TensorRTWrapper::init(
     return false;
   }
 
-  bool success;
+  // an engine built by another GPU or TensorRT version fails to load, and is rebuilt
+  bool success = false;
   std::ifstream engine_file(engine_path);
   if (engine_file.is_open()) {
     success = loadEngine(engine_path);
-  } else {
+  }
+  if (!success) {
     success = parseONNX(onnx_path, engine_path, precision);
   }
   success &= createContext();
@@ -141,6 +143,10 @@ bool TensorRTWrapper::loadEngine(const std::string & engine_path)
   std::cout << "Loading from " << engine_path << std::endl;
   engine_ =
     unique_ptr<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(buffer.get(), size, nullptr));
+  if (!engine_) {
+    std::cout << "Fail to load engine: " << engine_path << std::endl;
+    return false;
+  }
   return true;
 }
 
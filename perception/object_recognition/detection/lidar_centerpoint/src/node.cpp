@@ -43,6 +43,7 @@ LidarCenterPointNode::LidarCenterPointNode(const rclcpp::NodeOptions & node_opti
   head_pt_path_ = this->declare_parameter("head_pt_path", "");
   class_names_ = this->declare_parameter<std::vector<std::string>>("class_names");
   rename_car_to_truck_and_bus_ = this->declare_parameter("rename_car_to_truck_and_bus", false);
+  const int stream_priority = this->declare_parameter("stream_priority", -2);
 
   NetworkParam encoder_param(
     encoder_onnx_path_, encoder_engine_path_, encoder_pt_path_, trt_precision_, use_encoder_trt_);
@@ -50,7 +51,8 @@ LidarCenterPointNode::LidarCenterPointNode(const rclcpp::NodeOptions & node_opti
     head_onnx_path_, head_engine_path_, head_pt_path_, trt_precision_, use_head_trt_);
   densification_ptr_ = std::make_unique<PointCloudDensification>(
     densification_base_frame_, densification_past_frames_, this->get_clock());
-  detector_ptr_ = std::make_unique<CenterPointTRT>(encoder_param, head_param, /*verbose=*/false);
+  detector_ptr_ = std::make_unique<CenterPointTRT>(
+    encoder_param, head_param, /*verbose=*/false, stream_priority);
 
   pointcloud_sub_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
     "~/input/pointcloud", rclcpp::SensorDataQoS{}.keep_last(1),
@@ -73,8 +75,8 @@ void LidarCenterPointNode::pointCloudCallback(
     return;
   }
 
-  auto stacked_pointcloud_msg = densification_ptr_->stackPointCloud(*input_pointcloud_msg);
-  std::vector<float> boxes3d_vec = detector_ptr_->detect(stacked_pointcloud_msg);
+  densification_ptr_->enqueuePointCloud(input_pointcloud_msg);
+  std::vector<float> boxes3d_vec = detector_ptr_->detect(*densification_ptr_);
 
   autoware_perception_msgs::msg::DynamicObjectWithFeatureArray output_msg;
   output_msg.header = input_pointcloud_msg->header;
@@ -135,7 +137,7 @@ void LidarCenterPointNode::pointCloudCallback(
     objects_pub_->publish(output_msg);
   }
   if (pointcloud_sub_count > 0) {
-    pointcloud_pub_->publish(stacked_pointcloud_msg);
+    pointcloud_pub_->publish(densification_ptr_->stackPointCloud());
   }
 }
 
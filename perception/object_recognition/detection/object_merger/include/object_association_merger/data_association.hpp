@@ -28,7 +28,7 @@ class DataAssociation
 {
 private:
   double getDistance(
-    const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1);
+    const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1) const;
   geometry_msgs::msg::Point getCentroid(const sensor_msgs::msg::PointCloud2 & pointcloud);
   Eigen::MatrixXi can_assign_matrix_;
   Eigen::MatrixXd max_dist_matrix_;
@@ -44,6 +44,20 @@ public:
   Eigen::MatrixXd calcScoreMatrix(
     const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & object0,
     const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & object1);
+  double calcScore(
+    const autoware_perception_msgs::msg::DynamicObject & object0,
+    const autoware_perception_msgs::msg::DynamicObject & object1) const;
+  /**
+   * @brief Same assignment as assign(calcScoreMatrix(objects1, objects0)), where
+   * direct_assignment maps objects0 to objects1. The objects are only scored against the ones
+   * found within the largest max distance in a grid, and each group of objects connected by a
+   * positive score is assigned separately.
+   */
+  void assignNearObjects(
+    const std::vector<autoware_perception_msgs::msg::DynamicObjectWithFeature> & objects0,
+    const std::vector<autoware_perception_msgs::msg::DynamicObjectWithFeature> & objects1,
+    std::unordered_map<int, int> & direct_assignment,
+    std::unordered_map<int, int> & reverse_assignment);
   virtual ~DataAssociation() {}
 };
 
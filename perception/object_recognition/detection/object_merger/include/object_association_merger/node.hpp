@@ -20,6 +20,7 @@
 
 #include <autoware_perception_msgs/msg/dynamic_object_with_feature_array.hpp>
 
+#include <message_filters/pass_through.h>
 #include <message_filters/subscriber.h>
 #include <message_filters/sync_policies/approximate_time.h>
 #include <message_filters/synchronizer.h>
@@ -28,6 +29,7 @@
 #include <tf2_ros/transform_listener.h>
 
 #include <memory>
+#include <vector>
 
 namespace object_association
 {
@@ -37,26 +39,39 @@ public:
   explicit ObjectAssociationMergerNode(const rclcpp::NodeOptions & node_options);
 
 private:
+  using ObjectArray = autoware_perception_msgs::msg::DynamicObjectWithFeatureArray;
+
   void objectsCallback(
-    const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray::ConstSharedPtr &
-      input_object0_msg,
-    const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray::ConstSharedPtr &
-      input_object1_msg);
+    const ObjectArray::ConstSharedPtr & input_object0_msg,
+    const ObjectArray::ConstSharedPtr & input_object1_msg,
+    const ObjectArray::ConstSharedPtr & input_object2_msg,
+    const ObjectArray::ConstSharedPtr & input_object3_msg,
+    const ObjectArray::ConstSharedPtr & input_object4_msg,
+    const ObjectArray::ConstSharedPtr & input_object5_msg,
+    const ObjectArray::ConstSharedPtr & input_object6_msg,
+    const ObjectArray::ConstSharedPtr & input_object7_msg);
+  /** \brief Associate objects with the merged objects and keep the most confident of each
+   * pair, followed by the objects which are not associated. */
+  void mergeObjects(
+    const std::vector<autoware_perception_msgs::msg::DynamicObjectWithFeature> & objects,
+    std::vector<autoware_perception_msgs::msg::DynamicObjectWithFeature> & merged_objects);
+  inline void dummyCallback(const ObjectArray::ConstSharedPtr input)
+  {
+    auto dummy = input;
+    passthrough_.add(dummy);
+  }
 
   tf2_ros::Buffer tf_buffer_;
   tf2_ros::TransformListener tf_listener_;
-  rclcpp::Publisher<autoware_perception_msgs::msg::DynamicObjectWithFeatureArray>::SharedPtr
-    merged_object_pub_;
-  message_filters::Subscriber<autoware_perception_msgs::msg::DynamicObjectWithFeatureArray>
-    object0_sub_;
-  message_filters::Subscriber<autoware_perception_msgs::msg::DynamicObjectWithFeatureArray>
-    object1_sub_;
+  rclcpp::Publisher<ObjectArray>::SharedPtr merged_object_pub_;
+  std::vector<std::shared_ptr<message_filters::Subscriber<ObjectArray>>> object_subs_;
+  message_filters::PassThrough<ObjectArray> passthrough_;
   typedef message_filters::sync_policies::ApproximateTime<
-    autoware_perception_msgs::msg::DynamicObjectWithFeatureArray,
-    autoware_perception_msgs::msg::DynamicObjectWithFeatureArray>
+    ObjectArray, ObjectArray, ObjectArray, ObjectArray, ObjectArray, ObjectArray, ObjectArray,
+    ObjectArray>
     SyncPolicy;
   typedef message_filters::Synchronizer<SyncPolicy> Sync;
-  Sync sync_;
+  std::shared_ptr<Sync> sync_ptr_;
   DataAssociation data_association_;
 };
 }  // namespace object_association
@@ -19,7 +19,11 @@
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 DataAssociation::DataAssociation() : score_threshold_(0.1)
@@ -309,43 +313,154 @@ Eigen::MatrixXd DataAssociation::calcScoreMatrix(
     Eigen::MatrixXd::Zero(object1.feature_objects.size(), object0.feature_objects.size());
   for (size_t object1_idx = 0; object1_idx < object1.feature_objects.size(); ++object1_idx) {
     for (size_t object0_idx = 0; object0_idx < object0.feature_objects.size(); ++object0_idx) {
-      double score = 0.0;
-      if (can_assign_matrix_(
-            object1.feature_objects.at(object1_idx).object.semantic.type,
-            object0.feature_objects.at(object0_idx).object.semantic.type)) {
-        const double max_dist = max_dist_matrix_(
-          object1.feature_objects.at(object1_idx).object.semantic.type,
-          object0.feature_objects.at(object0_idx).object.semantic.type);
-        const double max_area = max_area_matrix_(
-          object1.feature_objects.at(object1_idx).object.semantic.type,
-          object0.feature_objects.at(object0_idx).object.semantic.type);
-        const double min_area = min_area_matrix_(
-          object1.feature_objects.at(object1_idx).object.semantic.type,
-          object0.feature_objects.at(object0_idx).object.semantic.type);
-        const double dist = getDistance(
-          object0.feature_objects.at(object0_idx).object.state.pose_covariance.pose.position,
-          object1.feature_objects.at(object1_idx).object.state.pose_covariance.pose.position);
-        const double area0 = utils::getArea(object0.feature_objects.at(object0_idx).object.shape);
-        const double area1 = utils::getArea(object1.feature_objects.at(object1_idx).object.shape);
-        score = (max_dist - std::min(dist, max_dist)) / max_dist;
-        if (max_dist < dist) {
-          score = 0.0;
-        }
-        if (area0 < min_area || max_area < area0) {
-          score = 0.0;
+      score_matrix(object1_idx, object0_idx) = calcScore(
+        object0.feature_objects.at(object0_idx).object,
+        object1.feature_objects.at(object1_idx).object);
+    }
+  }
+  return score_matrix;
+}
+
+double DataAssociation::calcScore(
+  const autoware_perception_msgs::msg::DynamicObject & object0,
+  const autoware_perception_msgs::msg::DynamicObject & object1) const
+{
+  if (!can_assign_matrix_(object1.semantic.type, object0.semantic.type)) {
+    return 0.0;
+  }
+  const double max_dist = max_dist_matrix_(object1.semantic.type, object0.semantic.type);
+  const double max_area = max_area_matrix_(object1.semantic.type, object0.semantic.type);
+  const double min_area = min_area_matrix_(object1.semantic.type, object0.semantic.type);
+  const double dist = getDistance(
+    object0.state.pose_covariance.pose.position, object1.state.pose_covariance.pose.position);
+  const double area0 = utils::getArea(object0.shape);
+  const double area1 = utils::getArea(object1.shape);
+  double score = (max_dist - std::min(dist, max_dist)) / max_dist;
+  if (max_dist < dist) {
+    score = 0.0;
+  }
+  if (area0 < min_area || max_area < area0) {
+    score = 0.0;
+  }
+  if (area1 < min_area || max_area < area1) {
+    score = 0.0;
+  }
+  return score;
+}
+
+void DataAssociation::assignNearObjects(
+  const std::vector<autoware_perception_msgs::msg::DynamicObjectWithFeature> & objects0,
+  const std::vector<autoware_perception_msgs::msg::DynamicObjectWithFeature> & objects1,
+  std::unordered_map<int, int> & direct_assignment,
+  std::unordered_map<int, int> & reverse_assignment)
+{
+  direct_assignment.clear();
+  reverse_assignment.clear();
+
+  // the score is zero beyond max_dist, so the pairs are searched in cells of the largest one
+  const double cell_size = max_dist_matrix_.maxCoeff();
+  const auto getCell = [cell_size](const geometry_msgs::msg::Point & p) {
+    return std::make_pair(
+      static_cast<int>(std::floor(p.x / cell_size)), static_cast<int>(std::floor(p.y / cell_size)));
+  };
+  const auto getKey = [](const int x, const int y) {
+    return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y);
+  };
+  std::unordered_map<int64_t, std::vector<int>> grid;
+  for (size_t i = 0; i < objects1.size(); ++i) {
+    const auto cell = getCell(objects1.at(i).object.state.pose_covariance.pose.position);
+    grid[getKey(cell.first, cell.second)].push_back(static_cast<int>(i));
+  }
+
+  // pairs with a positive score, which connect the objects into groups:
+  // objects0 are the nodes [0, size0) and objects1 the nodes [size0, size0 + size1)
+  struct Pair
+  {
+    int object0_idx;
+    int object1_idx;
+    double score;
+  };
+  std::vector<Pair> pairs;
+  std::vector<int> parents(objects0.size() + objects1.size());
+  std::iota(parents.begin(), parents.end(), 0);
+  const auto find = [&parents](int i) {
+    while (parents.at(i) != i) {
+      parents.at(i) = parents.at(parents.at(i));
+      i = parents.at(i);
+    }
+    return i;
+  };
+  for (size_t i = 0; i < objects0.size(); ++i) {
+    const auto cell = getCell(objects0.at(i).object.state.pose_covariance.pose.position);
+    for (int dx = -1; dx <= 1; ++dx) {
+      for (int dy = -1; dy <= 1; ++dy) {
+        const auto itr = grid.find(getKey(cell.first + dx, cell.second + dy));
+        if (itr == grid.end()) {
+          continue;
         }
-        if (area1 < min_area || max_area < area1) {
-          score = 0.0;
+        for (const int j : itr->second) {
+          // same roles as in calcScoreMatrix(objects1, objects0)
+          const double score = calcScore(objects1.at(j).object, objects0.at(i).object);
+          if (score <= 0.0) {
+            continue;
+          }
+          pairs.push_back(Pair{static_cast<int>(i), j, score});
+          parents.at(find(objects0.size() + j)) = find(i);
         }
       }
-      score_matrix(object1_idx, object0_idx) = score;
     }
   }
-  return score_matrix;
+
+  // local indices of the objects in their group
+  std::unordered_map<int, int> root_to_group;
+  std::vector<std::vector<int>> group_objects0;
+  std::vector<std::vector<int>> group_objects1;
+  std::vector<int> local_indices(parents.size(), -1);
+  for (const auto & pair : pairs) {
+    const int object1_node = static_cast<int>(objects0.size()) + pair.object1_idx;
+    for (const int node : {pair.object0_idx, object1_node}) {
+      if (0 <= local_indices.at(node)) {
+        continue;
+      }
+      const auto group = root_to_group.emplace(find(node), group_objects0.size()).first->second;
+      if (group == static_cast<int>(group_objects0.size())) {
+        group_objects0.emplace_back();
+        group_objects1.emplace_back();
+      }
+      auto & group_objects =
+        node < static_cast<int>(objects0.size()) ? group_objects0 : group_objects1;
+      local_indices.at(node) = group_objects.at(group).size();
+      group_objects.at(group).push_back(node);
+    }
+  }
+
+  std::vector<Eigen::MatrixXd> score_matrices(group_objects0.size());
+  for (size_t group = 0; group < group_objects0.size(); ++group) {
+    score_matrices.at(group) =
+      Eigen::MatrixXd::Zero(group_objects0.at(group).size(), group_objects1.at(group).size());
+  }
+  for (const auto & pair : pairs) {
+    const int group = root_to_group.at(find(pair.object0_idx));
+    score_matrices.at(group)(
+      local_indices.at(pair.object0_idx),
+      local_indices.at(objects0.size() + pair.object1_idx)) = pair.score;
+  }
+
+  for (size_t group = 0; group < score_matrices.size(); ++group) {
+    std::unordered_map<int, int> group_direct_assignment;
+    std::unordered_map<int, int> group_reverse_assignment;
+    assign(score_matrices.at(group), group_direct_assignment, group_reverse_assignment);
+    for (const auto & assignment : group_direct_assignment) {
+      const int object0_idx = group_objects0.at(group).at(assignment.first);
+      const int object1_idx = group_objects1.at(group).at(assignment.second) - objects0.size();
+      direct_assignment.emplace(object0_idx, object1_idx);
+      reverse_assignment.emplace(object1_idx, object0_idx);
+    }
+  }
 }
 
 double DataAssociation::getDistance(
-  const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1)
+  const geometry_msgs::msg::Point & point0, const geometry_msgs::msg::Point & point1) const
 {
   const double diff_x = point1.x - point0.x;
   const double diff_y = point1.y - point0.y;
@@ -20,7 +20,10 @@
 #include <tf2/transform_datatypes.h>
 
 #include <chrono>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 // #include <tf2_sensor_msgs/msg/tf2_sensor_msgs.hpp>
 #include <object_association_merger/node.hpp>
 #define EIGEN_MPL2_ONLY
@@ -32,68 +35,100 @@ namespace object_association
 ObjectAssociationMergerNode::ObjectAssociationMergerNode(const rclcpp::NodeOptions & node_options)
 : rclcpp::Node("cluster_data_association_node", node_options),
   tf_buffer_(get_clock()),
-  tf_listener_(tf_buffer_),
-  object0_sub_(this, "input/object0", rclcpp::QoS{1}.get_rmw_qos_profile()),
-  object1_sub_(this, "input/object1", rclcpp::QoS{1}.get_rmw_qos_profile()),
-  sync_(SyncPolicy(10), object0_sub_, object1_sub_)
+  tf_listener_(tf_buffer_)
 {
-  using std::placeholders::_1;
-  using std::placeholders::_2;
-  sync_.registerCallback(std::bind(&ObjectAssociationMergerNode::objectsCallback, this, _1, _2));
+  int input_number = declare_parameter("input_number", 2);
+  if (input_number < 2) {
+    RCLCPP_WARN(
+      get_logger(), "minimum input_number is 2. current input_number is %d", input_number);
+    input_number = 2;
+  }
+  if (8 < input_number) {
+    RCLCPP_WARN(
+      get_logger(), "maximum input_number is 8. current input_number is %d", input_number);
+    input_number = 8;
+  }
+
+  for (int id = 0; id < input_number; ++id) {
+    object_subs_.push_back(std::make_shared<message_filters::Subscriber<ObjectArray>>(
+      this, "input/object" + std::to_string(id), rclcpp::QoS{1}.get_rmw_qos_profile()));
+  }
+  // add dummy callback to enable passthrough filter for the unused inputs
+  object_subs_.at(0)->registerCallback(
+    std::bind(&ObjectAssociationMergerNode::dummyCallback, this, std::placeholders::_1));
+  const auto getInput = [this](const int id) -> message_filters::SimpleFilter<ObjectArray> & {
+    if (id < static_cast<int>(object_subs_.size())) {
+      return *object_subs_.at(id);
+    }
+    return passthrough_;
+  };
+  sync_ptr_ = std::make_shared<Sync>(
+    SyncPolicy(10), getInput(0), getInput(1), getInput(2), getInput(3), getInput(4), getInput(5),
+    getInput(6), getInput(7));
+  sync_ptr_->registerCallback(std::bind(
+    &ObjectAssociationMergerNode::objectsCallback, this, std::placeholders::_1,
+    std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5,
+    std::placeholders::_6, std::placeholders::_7, std::placeholders::_8));
 
-  merged_object_pub_ =
-    create_publisher<autoware_perception_msgs::msg::DynamicObjectWithFeatureArray>(
-      "output/object", rclcpp::QoS{1});
+  merged_object_pub_ = create_publisher<ObjectArray>("output/object", rclcpp::QoS{1});
 }
 
 void ObjectAssociationMergerNode::objectsCallback(
-  const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray::ConstSharedPtr &
-    input_object0_msg,
-  const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray::ConstSharedPtr &
-    input_object1_msg)
+  const ObjectArray::ConstSharedPtr & input_object0_msg,
+  const ObjectArray::ConstSharedPtr & input_object1_msg,
+  const ObjectArray::ConstSharedPtr & input_object2_msg,
+  const ObjectArray::ConstSharedPtr & input_object3_msg,
+  const ObjectArray::ConstSharedPtr & input_object4_msg,
+  const ObjectArray::ConstSharedPtr & input_object5_msg,
+  const ObjectArray::ConstSharedPtr & input_object6_msg,
+  const ObjectArray::ConstSharedPtr & input_object7_msg)
 {
   // Guard
   if (merged_object_pub_->get_subscription_count() < 1) {
     return;
   }
 
+  const std::vector<ObjectArray::ConstSharedPtr> input_object_msgs = {
+    input_object0_msg, input_object1_msg, input_object2_msg, input_object3_msg,
+    input_object4_msg, input_object5_msg, input_object6_msg, input_object7_msg};
+
   // build output msg
-  autoware_perception_msgs::msg::DynamicObjectWithFeatureArray output_msg;
+  ObjectArray output_msg;
   output_msg.header = input_object0_msg->header;
 
+  // the inputs are merged in order, as a chain of two input mergers would
+  output_msg.feature_objects = input_object0_msg->feature_objects;
+  for (size_t id = 1; id < object_subs_.size(); ++id) {
+    mergeObjects(input_object_msgs.at(id)->feature_objects, output_msg.feature_objects);
+  }
+
+  // publish output msg
+  merged_object_pub_->publish(output_msg);
+}
+
+void ObjectAssociationMergerNode::mergeObjects(
+  const std::vector<autoware_perception_msgs::msg::DynamicObjectWithFeature> & objects,
+  std::vector<autoware_perception_msgs::msg::DynamicObjectWithFeature> & merged_objects)
+{
   /* global nearest neighbor */
   std::unordered_map<int, int> direct_assignment;
   std::unordered_map<int, int> reverse_assignment;
-  Eigen::MatrixXd score_matrix =
-    data_association_.calcScoreMatrix(*input_object1_msg, *input_object0_msg);
-  data_association_.assign(score_matrix, direct_assignment, reverse_assignment);
-  for (size_t object0_idx = 0; object0_idx < input_object0_msg->feature_objects.size();
-       ++object0_idx) {
-    if (direct_assignment.find(object0_idx) != direct_assignment.end()) {  // found
-      // The one with the higher score will be hired.
-      if (
-        input_object1_msg->feature_objects.at(direct_assignment.at(object0_idx))
-          .object.semantic.confidence <
-        input_object0_msg->feature_objects.at(object0_idx).object.semantic.confidence) {
-        output_msg.feature_objects.push_back(input_object0_msg->feature_objects.at(object0_idx));
-      } else {
-        output_msg.feature_objects.push_back(
-          input_object1_msg->feature_objects.at(direct_assignment.at(object0_idx)));
-      }
-    } else {  // not found
-      output_msg.feature_objects.push_back(input_object0_msg->feature_objects.at(object0_idx));
+  data_association_.assignNearObjects(
+    merged_objects, objects, direct_assignment, reverse_assignment);
+  for (const auto & assignment : direct_assignment) {
+    // The one with the higher score will be hired.
+    const auto & object = objects.at(assignment.second);
+    if (
+      merged_objects.at(assignment.first).object.semantic.confidence <=
+      object.object.semantic.confidence) {
+      merged_objects.at(assignment.first) = object;
     }
   }
-  for (size_t object1_idx = 0; object1_idx < input_object1_msg->feature_objects.size();
-       ++object1_idx) {
-    if (reverse_assignment.find(object1_idx) != reverse_assignment.end()) {  // found
-    } else {                                                                 // not found
-      output_msg.feature_objects.push_back(input_object1_msg->feature_objects.at(object1_idx));
+  for (size_t i = 0; i < objects.size(); ++i) {
+    if (reverse_assignment.find(i) == reverse_assignment.end()) {  // not found
+      merged_objects.push_back(objects.at(i));
     }
   }
-
-  // publish output msg
-  merged_object_pub_->publish(output_msg);
 }
 }  // namespace object_association
 
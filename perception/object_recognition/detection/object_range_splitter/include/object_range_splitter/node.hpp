@@ -30,7 +30,7 @@ public:
 
 private:
   void objectCallback(
-    const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray::ConstSharedPtr input_msg);
+    autoware_perception_msgs::msg::DynamicObjectWithFeatureArray::UniquePtr input_msg);
 
   rclcpp::Publisher<autoware_perception_msgs::msg::DynamicObjectWithFeatureArray>::SharedPtr
     long_range_object_pub_;
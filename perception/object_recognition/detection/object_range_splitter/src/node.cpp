@@ -14,6 +14,11 @@
 
 #include "object_range_splitter/node.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
+
 namespace object_range_splitter
 {
 ObjectRangeSplitterNode::ObjectRangeSplitterNode(const rclcpp::NodeOptions & node_options)
@@ -32,34 +37,37 @@ ObjectRangeSplitterNode::ObjectRangeSplitterNode(const rclcpp::NodeOptions & nod
 }
 
 void ObjectRangeSplitterNode::objectCallback(
-  const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray::ConstSharedPtr input_msg)
+  autoware_perception_msgs::msg::DynamicObjectWithFeatureArray::UniquePtr input_msg)
 {
+  const bool publish_long_range = long_range_object_pub_->get_subscription_count() > 0;
+  const bool publish_short_range = short_range_object_pub_->get_subscription_count() > 0;
   // Guard
-  if (
-    long_range_object_pub_->get_subscription_count() < 1 &&
-    short_range_object_pub_->get_subscription_count() < 1) {
+  if (!publish_long_range && !publish_short_range) {
     return;
   }
-  // build output msg
-  autoware_perception_msgs::msg::DynamicObjectWithFeatureArray output_long_range_object_msg,
-    output_short_range_object_msg;
-  output_long_range_object_msg.header = input_msg->header;
-  output_short_range_object_msg.header = input_msg->header;
 
-  // split
-  for (const auto & feature_object : input_msg->feature_objects) {
-    const auto & position = feature_object.object.state.pose_covariance.pose.position;
-    const auto object_sq_dist = position.x * position.x + position.y * position.y;
-    if (object_sq_dist < spilt_range_ * spilt_range_) {  // short range
-      output_short_range_object_msg.feature_objects.push_back(feature_object);
-    } else {  // long range
-      output_long_range_object_msg.feature_objects.push_back(feature_object);
-    }
-  }
+  // split in place, the objects with their clusters are moved instead of copied
+  auto & feature_objects = input_msg->feature_objects;
+  const auto long_range_begin = std::stable_partition(
+    feature_objects.begin(), feature_objects.end(), [this](const auto & feature_object) {
+      const auto & position = feature_object.object.state.pose_covariance.pose.position;
+      const auto object_sq_dist = position.x * position.x + position.y * position.y;
+      return object_sq_dist < spilt_range_ * spilt_range_;
+    });
 
-  // publish output msg
-  long_range_object_pub_->publish(output_long_range_object_msg);
-  short_range_object_pub_->publish(output_short_range_object_msg);
+  // publish output msg, handed over without copy to the subscribers in the same process
+  if (publish_long_range) {
+    auto output_long_range_object_msg =
+      std::make_unique<autoware_perception_msgs::msg::DynamicObjectWithFeatureArray>();
+    output_long_range_object_msg->header = input_msg->header;
+    output_long_range_object_msg->feature_objects.assign(
+      std::make_move_iterator(long_range_begin), std::make_move_iterator(feature_objects.end()));
+    long_range_object_pub_->publish(std::move(output_long_range_object_msg));
+  }
+  if (publish_short_range) {
+    feature_objects.erase(long_range_begin, feature_objects.end());
+    short_range_object_pub_->publish(std::move(input_msg));
+  }
 }
 }  // namespace object_range_splitter
 
@@ -23,14 +23,15 @@
 #include <pcl/point_types.h>
 #include <pcl_conversions/pcl_conversions.h>
 #include <sensor_msgs/msg/point_cloud2.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 #include <tf2/LinearMath/Transform.h>
 #include <tf2/convert.h>
 #include <tf2/transform_datatypes.h>
-#include <tf2_sensor_msgs/tf2_sensor_msgs.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
-#include <map>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -41,6 +42,123 @@
 
 namespace roi_cluster_fusion
 {
+namespace
+{
+struct ClusterPoints
+{
+  std::vector<Eigen::Vector3d> points;
+  Eigen::Vector3d min_point;
+  Eigen::Vector3d max_point;
+};
+
+ClusterPoints toClusterPoints(const sensor_msgs::msg::PointCloud2 & cluster)
+{
+  ClusterPoints cluster_points;
+  cluster_points.points.reserve(cluster.width * cluster.height);
+  cluster_points.min_point = Eigen::Vector3d::Constant(std::numeric_limits<double>::max());
+  cluster_points.max_point = Eigen::Vector3d::Constant(std::numeric_limits<double>::lowest());
+  for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(cluster, "x"), iter_y(cluster, "y"),
+       iter_z(cluster, "z");
+       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    const Eigen::Vector3d point(*iter_x, *iter_y, *iter_z);
+    cluster_points.min_point = cluster_points.min_point.cwiseMin(point);
+    cluster_points.max_point = cluster_points.max_point.cwiseMax(point);
+    cluster_points.points.push_back(point);
+  }
+  return cluster_points;
+}
+
+Eigen::Affine3d toAffine3d(const geometry_msgs::msg::Transform & transform)
+{
+  return Eigen::Translation3d(
+           transform.translation.x, transform.translation.y, transform.translation.z) *
+         Eigen::Quaterniond(
+           transform.rotation.w, transform.rotation.x, transform.rotation.y, transform.rotation.z);
+}
+
+/**
+ * @brief Whether some points of the cluster may be projected into the image, from the corners
+ * of its bounding box only. Conservative: the box of a cluster across the image plane is kept.
+ */
+bool isInImage(
+  const ClusterPoints & cluster_points, const Eigen::Affine3d & transform,
+  const Eigen::Matrix4d & projection, const int width, const int height)
+{
+  std::array<Eigen::Vector3d, 8> corners;
+  bool is_in_front = false;
+  bool is_behind = false;
+  for (size_t i = 0; i < corners.size(); ++i) {
+    const Eigen::Vector3d corner(
+      (i & 1) ? cluster_points.max_point.x() : cluster_points.min_point.x(),
+      (i & 2) ? cluster_points.max_point.y() : cluster_points.min_point.y(),
+      (i & 4) ? cluster_points.max_point.z() : cluster_points.min_point.z());
+    corners.at(i) = transform * corner;
+    (corners.at(i).z() > 0.0 ? is_in_front : is_behind) = true;
+  }
+  if (!is_in_front) {
+    return false;
+  }
+  if (is_behind) {
+    return true;
+  }
+
+  // the projection of the box is within the projection of its corners
+  Eigen::Vector2d min_uv = Eigen::Vector2d::Constant(std::numeric_limits<double>::max());
+  Eigen::Vector2d max_uv = Eigen::Vector2d::Constant(std::numeric_limits<double>::lowest());
+  for (const auto & corner : corners) {
+    const Eigen::Vector4d projected_corner = projection * corner.homogeneous();
+    const Eigen::Vector2d uv(
+      projected_corner.x() / projected_corner.z(), projected_corner.y() / projected_corner.z());
+    min_uv = min_uv.cwiseMin(uv);
+    max_uv = max_uv.cwiseMax(uv);
+  }
+  // a point is in the image if its coordinates truncate to [0, size - 1]
+  return -1.0 < max_uv.x() && min_uv.x() < width && -1.0 < max_uv.y() && min_uv.y() < height;
+}
+
+/**
+ * @brief Cluster rois bucketed by the image columns they cover, so that an image roi is only
+ * compared with the cluster rois which overlap it in x.
+ */
+class RoiColumnIndex
+{
+public:
+  explicit RoiColumnIndex(const uint32_t image_width)
+  : buckets_(std::max<uint32_t>(image_width, 1) / BUCKET_WIDTH + 1)
+  {
+  }
+
+  void insert(const size_t index, const sensor_msgs::msg::RegionOfInterest & roi)
+  {
+    for (size_t i = getBucket(roi.x_offset); i <= getBucket(roi.x_offset + roi.width); ++i) {
+      buckets_.at(i).push_back(index);
+    }
+  }
+
+  /** @brief Indices of the rois overlapping roi in x, in ascending order. */
+  std::vector<size_t> query(const sensor_msgs::msg::RegionOfInterest & roi) const
+  {
+    std::vector<size_t> indices;
+    for (size_t i = getBucket(roi.x_offset); i <= getBucket(roi.x_offset + roi.width); ++i) {
+      indices.insert(indices.end(), buckets_.at(i).begin(), buckets_.at(i).end());
+    }
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    return indices;
+  }
+
+private:
+  static constexpr uint32_t BUCKET_WIDTH = 32;
+
+  size_t getBucket(const uint64_t x) const
+  {
+    return std::min<size_t>(x / BUCKET_WIDTH, buckets_.size() - 1);
+  }
+
+  std::vector<std::vector<size_t>> buckets_;
+};
+}  // namespace
+
 Debugger::Debugger(rclcpp::Node * node, const int camera_num) : node_(node)
 {
   image_buffers_.resize(camera_num);
@@ -270,6 +388,16 @@ void RoiClusterFusionNodelet::fusionCallback(
     }
   }
 
+  // read the cluster points once for all the cameras
+  std::vector<ClusterPoints> cluster_points(input_cluster_msg->feature_objects.size());
+  for (size_t i = 0; i < input_cluster_msg->feature_objects.size(); ++i) {
+    const auto & cluster = input_cluster_msg->feature_objects.at(i).feature.cluster;
+    if (cluster.data.empty()) {
+      continue;
+    }
+    cluster_points.at(i) = toClusterPoints(cluster);
+  }
+
   // check camera info
   for (int id = 0; id < static_cast<int>(v_roi_sub_.size()); ++id) {
     // debug variable
@@ -302,63 +430,45 @@ void RoiClusterFusionNodelet::fusionCallback(
     }
 
     // build cluster roi
-    std::map<size_t, sensor_msgs::msg::RegionOfInterest> m_cluster_roi;
-    for (size_t i = 0; i < input_cluster_msg->feature_objects.size(); ++i) {
-      if (input_cluster_msg->feature_objects.at(i).feature.cluster.data.empty()) {
+    const Eigen::Affine3d transform = toAffine3d(transform_stamped.transform);
+    const int width = static_cast<int>(m_camera_info_.at(id).width);
+    const int height = static_cast<int>(m_camera_info_.at(id).height);
+    RoiColumnIndex cluster_roi_index(m_camera_info_.at(id).width);
+    std::vector<sensor_msgs::msg::RegionOfInterest> cluster_rois(cluster_points.size());
+    for (size_t i = 0; i < cluster_points.size(); ++i) {
+      if (cluster_points.at(i).points.empty()) {
+        continue;
+      }
+      if (!isInImage(cluster_points.at(i), transform, projection, width, height)) {
         continue;
       }
 
-      sensor_msgs::msg::PointCloud2 transformed_cluster;
-      tf2::doTransform(
-        input_cluster_msg->feature_objects.at(i).feature.cluster, transformed_cluster,
-        transform_stamped);
-
-      // for reduce calc cost
-      // Eigen::Vector3d centroid_point;
-      // centroid_point << 0, 0, 0;
-      // for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(transformed_cluster, "x"),
-      // iter_y(transformed_cluster,
-      // "y"), iter_z(transformed_cluster, "z");
-      //      iter_x != iter_x.end();
-      //      ++iter_x, ++iter_y, ++iter_z)
-      // {
-      //     centroid_point += Eigen::Vector3d(*iter_x, *iter_y, *iter_z);
-      // }
-      // centroid_point *= 1.0 / static_cast<double>(
-      //  input_cluster_msg->feature_objects.at(i).feature.cluster.data.size());
-      //     if (centroid_point.z() <= 0.0)
-      //         continue;
-
-      std::vector<Eigen::Vector2d> projected_points;
-      projected_points.reserve(transformed_cluster.data.size());
-      int min_x(m_camera_info_.at(id).width), min_y(m_camera_info_.at(id).height), max_x(0),
-        max_y(0);
-      for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(transformed_cluster, "x"),
-           iter_y(transformed_cluster, "y"), iter_z(transformed_cluster, "z");
-           iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
-        if (*iter_z <= 0.0) {
+      bool is_projected = false;
+      int min_x(width), min_y(height), max_x(0), max_y(0);
+      for (const auto & point : cluster_points.at(i).points) {
+        const Eigen::Vector3d transformed_point = transform * point;
+        if (transformed_point.z() <= 0.0) {
           continue;
         }
-        Eigen::Vector4d projected_point =
-          projection * Eigen::Vector4d(*iter_x, *iter_y, *iter_z, 1.0);
+        Eigen::Vector4d projected_point = projection * transformed_point.homogeneous();
         Eigen::Vector2d normalized_projected_point = Eigen::Vector2d(
           projected_point.x() / projected_point.z(), projected_point.y() / projected_point.z());
         if (
           0 <= static_cast<int>(normalized_projected_point.x()) &&
-          static_cast<int>(normalized_projected_point.x()) <=
-            static_cast<int>(m_camera_info_.at(id).width) - 1 &&
+          static_cast<int>(normalized_projected_point.x()) <= width - 1 &&
           0 <= static_cast<int>(normalized_projected_point.y()) &&
-          static_cast<int>(normalized_projected_point.y()) <=
-            static_cast<int>(m_camera_info_.at(id).height) - 1) {
+          static_cast<int>(normalized_projected_point.y()) <= height - 1) {
           min_x = std::min(static_cast<int>(normalized_projected_point.x()), min_x);
           min_y = std::min(static_cast<int>(normalized_projected_point.y()), min_y);
           max_x = std::max(static_cast<int>(normalized_projected_point.x()), max_x);
           max_y = std::max(static_cast<int>(normalized_projected_point.y()), max_y);
-          projected_points.push_back(normalized_projected_point);
-          debug_image_points.push_back(normalized_projected_point);
+          is_projected = true;
+          if (debugger_) {
+            debug_image_points.push_back(normalized_projected_point);
+          }
         }
       }
-      if (projected_points.empty()) {
+      if (!is_projected) {
         continue;
       }
 
@@ -368,7 +478,8 @@ void RoiClusterFusionNodelet::fusionCallback(
       roi.y_offset = min_y;
       roi.width = max_x - min_x;
       roi.height = max_y - min_y;
-      m_cluster_roi.insert(std::make_pair(i, roi));
+      cluster_rois.at(i) = roi;
+      cluster_roi_index.insert(i, roi);
       debug_pointcloud_rois.push_back(roi);
     }
 
@@ -394,23 +505,21 @@ void RoiClusterFusionNodelet::fusionCallback(
     for (size_t i = 0; i < input_roi_msg->feature_objects.size(); ++i) {
       int index = 0;
       double max_iou = 0.0;
-      for (auto m_cluster_roi_itr = m_cluster_roi.begin(); m_cluster_roi_itr != m_cluster_roi.end();
-           ++m_cluster_roi_itr) {
+      const auto & image_roi = input_roi_msg->feature_objects.at(i).feature.roi;
+      for (const size_t cluster_index : cluster_roi_index.query(image_roi)) {
+        const auto & cluster_roi = cluster_rois.at(cluster_index);
         double iou(0.0), iou_x(0.0), iou_y(0.0);
         if (use_iou_) {
-          iou =
-            calcIoU(m_cluster_roi_itr->second, input_roi_msg->feature_objects.at(i).feature.roi);
+          iou = calcIoU(cluster_roi, image_roi);
         }
         if (use_iou_x_) {
-          iou_x =
-            calcIoUX(m_cluster_roi_itr->second, input_roi_msg->feature_objects.at(i).feature.roi);
+          iou_x = calcIoUX(cluster_roi, image_roi);
         }
         if (use_iou_y_) {
-          iou_y =
-            calcIoUY(m_cluster_roi_itr->second, input_roi_msg->feature_objects.at(i).feature.roi);
+          iou_y = calcIoUY(cluster_roi, image_roi);
         }
         if (max_iou < iou + iou_x + iou_y) {
-          index = m_cluster_roi_itr->first;
+          index = cluster_index;
           max_iou = iou + iou_x + iou_y;
         }
       }
@@ -17,20 +17,34 @@
 
 #include "shape_estimation/model/model_interface.hpp"
 
+#include <Eigen/Core>
+
 #include <vector>
 
+enum class BoundingBoxFittingMethod {
+  L_SHAPE_SEARCH,  // closeness criterion of all the points, every angle_resolution
+  CONVEX_HULL,     // minimum area rectangle of the 2d convex hull
+};
+
 class BoundingBoxShapeModel : public ShapeEstimationModelInterface
 {
 private:
   bool fitLShape(
     const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle,
     autoware_perception_msgs::msg::Shape & shape_output, geometry_msgs::msg::Pose & pose_output);
+  float searchLShapeAngle(
+    const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle);
+  float searchMinAreaAngle(
+    const std::vector<Eigen::Vector2f> & hull, const float min_angle, const float max_angle);
   float calcClosenessCriterion(const std::vector<float> & C_1, const std::vector<float> & C_2);
 
 public:
   BoundingBoxShapeModel();
-  explicit BoundingBoxShapeModel(const boost::optional<float> & reference_yaw);
+  explicit BoundingBoxShapeModel(
+    const boost::optional<float> & reference_yaw,
+    const BoundingBoxFittingMethod fitting_method = BoundingBoxFittingMethod::L_SHAPE_SEARCH);
   boost::optional<float> reference_yaw_;
+  BoundingBoxFittingMethod fitting_method_;
 
   ~BoundingBoxShapeModel() {}
 
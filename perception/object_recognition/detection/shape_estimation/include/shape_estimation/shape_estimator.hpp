@@ -15,6 +15,8 @@
 #ifndef SHAPE_ESTIMATION__SHAPE_ESTIMATOR_HPP_
 #define SHAPE_ESTIMATION__SHAPE_ESTIMATOR_HPP_
 
+#include "shape_estimation/model/bounding_box.hpp"
+
 #include <autoware_perception_msgs/msg/semantic.hpp>
 #include <autoware_perception_msgs/msg/shape.hpp>
 #include <geometry_msgs/msg/pose.hpp>
@@ -43,9 +45,13 @@ private:
 
   bool use_corrector_;
   bool use_filter_;
+  BoundingBoxFittingMethod bounding_box_fitting_method_;
 
 public:
-  ShapeEstimator(bool use_corrector, bool use_filter);
+  ShapeEstimator(
+    bool use_corrector, bool use_filter,
+    BoundingBoxFittingMethod bounding_box_fitting_method =
+      BoundingBoxFittingMethod::L_SHAPE_SEARCH);
 
   virtual ~ShapeEstimator() = default;
 
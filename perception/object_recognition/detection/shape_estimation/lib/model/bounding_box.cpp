@@ -28,6 +28,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -37,10 +38,55 @@
 
 constexpr float epsilon = 0.001;
 
-BoundingBoxShapeModel::BoundingBoxShapeModel() : reference_yaw_(boost::none) {}
+namespace
+{
+float cross(const Eigen::Vector2f & o, const Eigen::Vector2f & a, const Eigen::Vector2f & b)
+{
+  return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
+}
 
-BoundingBoxShapeModel::BoundingBoxShapeModel(const boost::optional<float> & reference_yaw)
-: reference_yaw_(reference_yaw)
+/** \brief 2d convex hull (Andrew's monotone chain), counterclockwise. */
+std::vector<Eigen::Vector2f> calcConvexHull2d(const pcl::PointCloud<pcl::PointXYZ> & cluster)
+{
+  std::vector<Eigen::Vector2f> points;
+  points.reserve(cluster.size());
+  for (const auto & point : cluster) {
+    points.emplace_back(point.x, point.y);
+  }
+  std::sort(points.begin(), points.end(), [](const auto & a, const auto & b) {
+    return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y());
+  });
+  if (points.size() < 3) {
+    return points;
+  }
+
+  std::vector<Eigen::Vector2f> hull(2 * points.size());
+  size_t k = 0;
+  for (size_t i = 0; i < points.size(); ++i) {  // lower hull
+    while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0) {
+      --k;
+    }
+    hull[k++] = points[i];
+  }
+  for (size_t i = points.size() - 1, t = k + 1; i > 0; --i) {  // upper hull
+    while (k >= t && cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0) {
+      --k;
+    }
+    hull[k++] = points[i - 1];
+  }
+  hull.resize(k - 1);
+  return hull;
+}
+}  // namespace
+
+BoundingBoxShapeModel::BoundingBoxShapeModel()
+: reference_yaw_(boost::none), fitting_method_(BoundingBoxFittingMethod::L_SHAPE_SEARCH)
+{
+}
+
+BoundingBoxShapeModel::BoundingBoxShapeModel(
+  const boost::optional<float> & reference_yaw, const BoundingBoxFittingMethod fitting_method)
+: reference_yaw_(reference_yaw), fitting_method_(fitting_method)
 {
 }
 
@@ -71,37 +117,11 @@ bool BoundingBoxShapeModel::fitLShape(
     max_z = std::max(point.z, max_z);
   }
 
-  /*
-   * Paper : IV2017, Efficient L-Shape Fitting for Vehicle Detection Using Laser Scanners
-   * Authors : Xio Zhang, Wenda Xu, Chiyu Dong and John M. Dolan
-   */
-
-  // Paper : Algo.2 Search-Based Rectangle Fitting
-  std::vector<std::pair<float /*theta*/, float /*q*/>> Q;
-  constexpr float angle_resolution = M_PI / 180.0;
-  for (float theta = min_angle; theta <= max_angle + epsilon; theta += angle_resolution) {
-    Eigen::Vector2f e_1;
-    e_1 << std::cos(theta), std::sin(theta);  // col.3, Algo.2
-    Eigen::Vector2f e_2;
-    e_2 << -std::sin(theta), std::cos(theta);  // col.4, Algo.2
-    std::vector<float> C_1;                    // col.5, Algo.2
-    std::vector<float> C_2;                    // col.6, Algo.2
-    for (const auto & point : cluster) {
-      C_1.push_back(point.x * e_1.x() + point.y * e_1.y());
-      C_2.push_back(point.x * e_2.x() + point.y * e_2.y());
-    }
-    float q = calcClosenessCriterion(C_1, C_2);  // col.7, Algo.2
-    Q.push_back(std::make_pair(theta, q));       // col.8, Algo.2
-  }
-
-  float theta_star{0.0};  // col.10, Algo.2
-  float max_q = 0.0;
-  for (size_t i = 0; i < Q.size(); ++i) {
-    if (max_q < Q.at(i).second || i == 0) {
-      max_q = Q.at(i).second;
-      theta_star = Q.at(i).first;
-    }
-  }
+  // the extremes along any direction are hull vertices, so the box is computed from the hull
+  const auto hull = calcConvexHull2d(cluster);
+  const float theta_star = fitting_method_ == BoundingBoxFittingMethod::CONVEX_HULL
+                             ? searchMinAreaAngle(hull, min_angle, max_angle)
+                             : searchLShapeAngle(cluster, min_angle, max_angle);
   const float sin_theta_star = std::sin(theta_star);
   const float cos_theta_star = std::cos(theta_star);
 
@@ -111,9 +131,9 @@ bool BoundingBoxShapeModel::fitLShape(
   e_2_star << -sin_theta_star, cos_theta_star;
   std::vector<float> C_1_star;  // col.11, Algo.2
   std::vector<float> C_2_star;  // col.11, Algo.2
-  for (const auto & point : cluster) {
-    C_1_star.push_back(point.x * e_1_star.x() + point.y * e_1_star.y());
-    C_2_star.push_back(point.x * e_2_star.x() + point.y * e_2_star.y());
+  for (const auto & point : hull) {
+    C_1_star.push_back(point.dot(e_1_star));
+    C_2_star.push_back(point.dot(e_2_star));
   }
 
   // col.12, Algo.2
@@ -169,6 +189,87 @@ bool BoundingBoxShapeModel::fitLShape(
   return true;
 }
 
+float BoundingBoxShapeModel::searchLShapeAngle(
+  const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle)
+{
+  /*
+   * Paper : IV2017, Efficient L-Shape Fitting for Vehicle Detection Using Laser Scanners
+   * Authors : Xio Zhang, Wenda Xu, Chiyu Dong and John M. Dolan
+   */
+
+  // Paper : Algo.2 Search-Based Rectangle Fitting
+  std::vector<std::pair<float /*theta*/, float /*q*/>> Q;
+  constexpr float angle_resolution = M_PI / 180.0;
+  std::vector<float> C_1(cluster.size());  // col.5, Algo.2
+  std::vector<float> C_2(cluster.size());  // col.6, Algo.2
+  for (float theta = min_angle; theta <= max_angle + epsilon; theta += angle_resolution) {
+    Eigen::Vector2f e_1;
+    e_1 << std::cos(theta), std::sin(theta);  // col.3, Algo.2
+    Eigen::Vector2f e_2;
+    e_2 << -std::sin(theta), std::cos(theta);  // col.4, Algo.2
+    for (size_t i = 0; i < cluster.size(); ++i) {
+      const auto & point = cluster.points[i];
+      C_1[i] = point.x * e_1.x() + point.y * e_1.y();
+      C_2[i] = point.x * e_2.x() + point.y * e_2.y();
+    }
+    float q = calcClosenessCriterion(C_1, C_2);  // col.7, Algo.2
+    Q.push_back(std::make_pair(theta, q));       // col.8, Algo.2
+  }
+
+  float theta_star{0.0};  // col.10, Algo.2
+  float max_q = 0.0;
+  for (size_t i = 0; i < Q.size(); ++i) {
+    if (max_q < Q.at(i).second || i == 0) {
+      max_q = Q.at(i).second;
+      theta_star = Q.at(i).first;
+    }
+  }
+  return theta_star;
+}
+
+float BoundingBoxShapeModel::searchMinAreaAngle(
+  const std::vector<Eigen::Vector2f> & hull, const float min_angle, const float max_angle)
+{
+  // Between two edge directions the area is concave in theta (rotating calipers), so the
+  // minimum is at an edge direction or at a bound of the range.
+  std::vector<float> candidates{min_angle, max_angle};
+  for (size_t i = 0; i < hull.size(); ++i) {
+    const Eigen::Vector2f edge = hull[(i + 1) % hull.size()] - hull[i];
+    const float edge_angle = std::atan2(edge.y(), edge.x());
+    // the box is the same for the angles modulo pi/2
+    const float theta =
+      min_angle + std::fmod(std::fmod(edge_angle - min_angle, M_PI_2) + M_PI_2, M_PI_2);
+    if (theta <= max_angle) {
+      candidates.push_back(theta);
+    }
+  }
+
+  float theta_star = min_angle;
+  float min_area = std::numeric_limits<float>::max();
+  for (const float theta : candidates) {
+    const Eigen::Vector2f e_1(std::cos(theta), std::sin(theta));
+    const Eigen::Vector2f e_2(-std::sin(theta), std::cos(theta));
+    float min_c_1 = std::numeric_limits<float>::max();
+    float max_c_1 = std::numeric_limits<float>::lowest();
+    float min_c_2 = std::numeric_limits<float>::max();
+    float max_c_2 = std::numeric_limits<float>::lowest();
+    for (const auto & point : hull) {
+      const float c_1 = point.dot(e_1);
+      const float c_2 = point.dot(e_2);
+      min_c_1 = std::min(min_c_1, c_1);
+      max_c_1 = std::max(max_c_1, c_1);
+      min_c_2 = std::min(min_c_2, c_2);
+      max_c_2 = std::max(max_c_2, c_2);
+    }
+    const float area = (max_c_1 - min_c_1) * (max_c_2 - min_c_2);
+    if (area < min_area) {
+      min_area = area;
+      theta_star = theta;
+    }
+  }
+  return theta_star;
+}
+
 float BoundingBoxShapeModel::calcClosenessCriterion(
   const std::vector<float> & C_1, const std::vector<float> & C_2)
 {
@@ -21,8 +21,11 @@
 #include <iostream>
 #include <memory>
 
-ShapeEstimator::ShapeEstimator(bool use_corrector, bool use_filter)
-: use_corrector_(use_corrector), use_filter_(use_filter)
+ShapeEstimator::ShapeEstimator(
+  bool use_corrector, bool use_filter, BoundingBoxFittingMethod bounding_box_fitting_method)
+: use_corrector_(use_corrector),
+  use_filter_(use_filter),
+  bounding_box_fitting_method_(bounding_box_fitting_method)
 {
 }
 
@@ -69,13 +72,13 @@ bool ShapeEstimator::estimateShape(
     type == autoware_perception_msgs::msg::Semantic::CAR ||
     type == autoware_perception_msgs::msg::Semantic::TRUCK ||
     type == autoware_perception_msgs::msg::Semantic::BUS) {
-    model_ptr.reset(new BoundingBoxShapeModel(yaw));
+    model_ptr.reset(new BoundingBoxShapeModel(yaw, bounding_box_fitting_method_));
   } else if (type == autoware_perception_msgs::msg::Semantic::PEDESTRIAN) {
     model_ptr.reset(new CylinderShapeModel());
   } else if (type == autoware_perception_msgs::msg::Semantic::MOTORBIKE) {
-    model_ptr.reset(new BoundingBoxShapeModel(yaw));
+    model_ptr.reset(new BoundingBoxShapeModel(yaw, bounding_box_fitting_method_));
   } else if (type == autoware_perception_msgs::msg::Semantic::BICYCLE) {
-    model_ptr.reset(new BoundingBoxShapeModel(yaw));
+    model_ptr.reset(new BoundingBoxShapeModel(yaw, bounding_box_fitting_method_));
   } else {
     model_ptr.reset(new ConvexhullShapeModel());
   }
@@ -14,6 +14,7 @@
 
 #include "shape_estimation/shape_estimator.hpp"
 
+#include <euclidean_cluster/utils.hpp>
 #include <node.hpp>
 
 #include <tf2/LinearMath/Matrix3x3.h>
@@ -22,6 +23,8 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 using SemanticType = autoware_perception_msgs::msg::Semantic;
 
@@ -38,7 +41,17 @@ ShapeEstimationNode::ShapeEstimationNode(const rclcpp::NodeOptions & node_option
   bool use_corrector = declare_parameter("use_corrector", true);
   bool use_filter = declare_parameter("use_filter", true);
   use_vehicle_reference_yaw_ = declare_parameter("use_vehicle_reference_yaw", true);
-  estimator_ = std::make_unique<ShapeEstimator>(use_corrector, use_filter);
+  const auto bounding_box_fitting_method =
+    static_cast<std::string>(declare_parameter("bounding_box_fitting_method", "l_shape_search"));
+  BoundingBoxFittingMethod fitting_method = BoundingBoxFittingMethod::L_SHAPE_SEARCH;
+  if (bounding_box_fitting_method == "convex_hull") {
+    fitting_method = BoundingBoxFittingMethod::CONVEX_HULL;
+  } else if (bounding_box_fitting_method != "l_shape_search") {
+    RCLCPP_WARN(
+      get_logger(), "unknown bounding_box_fitting_method %s, use l_shape_search",
+      bounding_box_fitting_method.c_str());
+  }
+  estimator_ = std::make_unique<ShapeEstimator>(use_corrector, use_filter, fitting_method);
 }
 
 void ShapeEstimationNode::callback(
@@ -53,17 +66,22 @@ void ShapeEstimationNode::callback(
   autoware_perception_msgs::msg::DynamicObjectWithFeatureArray output_msg;
   output_msg.header = input_msg->header;
 
-  // Estimate shape for each object and pack msg
-  for (const auto & feature_object : input_msg->feature_objects) {
-    const auto & object = feature_object.object;
+  // Estimate shape for each object in parallel, the estimator keeps no state
+  const auto & feature_objects = input_msg->feature_objects;
+  std::vector<autoware_perception_msgs::msg::Shape> shapes(feature_objects.size());
+  std::vector<geometry_msgs::msg::Pose> poses(feature_objects.size());
+  std::vector<uint8_t> is_estimated(feature_objects.size(), false);
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < feature_objects.size(); ++i) {
+    const auto & object = feature_objects[i].object;
     const auto & type = object.semantic.type;
-    const auto & feature = feature_object.feature;
+    const auto & feature = feature_objects[i].feature;
     const bool is_vehicle =
       SemanticType::CAR == type || SemanticType::TRUCK == type || SemanticType::BUS == type;
 
     // convert ros to pcl
     pcl::PointCloud<pcl::PointXYZ>::Ptr cluster(new pcl::PointCloud<pcl::PointXYZ>);
-    pcl::fromROSMsg(feature.cluster, *cluster);
+    euclidean_cluster::convertClusterMsg2PointCloud(feature.cluster, *cluster);
 
     // check cluster data
     if (cluster->empty()) {
@@ -71,23 +89,22 @@ void ShapeEstimationNode::callback(
     }
 
     // estimate shape and pose
-    autoware_perception_msgs::msg::Shape shape;
-    geometry_msgs::msg::Pose pose;
     boost::optional<float> yaw = boost::none;
     if (use_vehicle_reference_yaw_ && is_vehicle) {
       yaw = tf2::getYaw(object.state.pose_covariance.pose.orientation);
     }
-    const bool estimated_success =
-      estimator_->estimateShapeAndPose(object.semantic.type, *cluster, yaw, shape, pose);
+    is_estimated[i] =
+      estimator_->estimateShapeAndPose(object.semantic.type, *cluster, yaw, shapes[i], poses[i]);
+  }
 
-    // If the shape estimation fails, ignore it.
-    if (!estimated_success) {
+  // Pack msg in the input order, the objects whose estimation failed are ignored
+  for (size_t i = 0; i < feature_objects.size(); ++i) {
+    if (!is_estimated[i]) {
       continue;
     }
-
-    output_msg.feature_objects.push_back(feature_object);
-    output_msg.feature_objects.back().object.shape = shape;
-    output_msg.feature_objects.back().object.state.pose_covariance.pose = pose;
+    output_msg.feature_objects.push_back(feature_objects[i]);
+    output_msg.feature_objects.back().object.shape = shapes[i];
+    output_msg.feature_objects.back().object.state.pose_covariance.pose = poses[i];
   }
 
   // Publish
@@ -43,26 +43,45 @@ class TensorrtYoloNodelet : public rclcpp::Node
 public:
   explicit TensorrtYoloNodelet(const rclcpp::NodeOptions & options);
   void connectCb();
-  void callback(const sensor_msgs::msg::Image::ConstSharedPtr image_msg);
+  void callback(const sensor_msgs::msg::Image::ConstSharedPtr image_msg, const size_t camera_index);
   bool readLabelFile(const std::string & filepath, std::vector<std::string> * labels);
 
 private:
-  std::mutex connect_mutex_;
+  struct Camera
+  {
+    std::string input_topic;
+    image_transport::Subscriber image_sub;
+    image_transport::Publisher image_pub;
+    rclcpp::Publisher<autoware_perception_msgs::msg::DynamicObjectWithFeatureArray>::SharedPtr
+      objects_pub;
+    // guarded by batch_mutex_
+    bool is_subscribed = false;
+    cv_bridge::CvImagePtr pending_image;
+  };
+
+  void onBatchTimer();
+  bool hasPendingImage() const;
+  // Infer the pending images of all cameras as one batch, releasing the lock before enqueueing
+  void inferPendingImages(std::unique_lock<std::mutex> & lock);
+  void publishDetections(
+    const size_t camera_index, const cv_bridge::CvImagePtr & in_image_ptr,
+    const float * out_scores, const float * out_boxes, const float * out_classes);
 
-  image_transport::Publisher image_pub_;
-  rclcpp::Publisher<autoware_perception_msgs::msg::DynamicObjectWithFeatureArray>::SharedPtr
-    objects_pub_;
+  std::mutex connect_mutex_;
 
-  image_transport::Subscriber image_sub_;
+  std::vector<Camera> cameras_;
 
   rclcpp::TimerBase::SharedPtr timer_;
 
+  // frames collected for the next batch
+  std::mutex batch_mutex_;
+  double batch_timeout_;
+  rclcpp::Time batch_start_time_;
+  rclcpp::TimerBase::SharedPtr batch_timer_;
+
   yolo::Config yolo_config_;
 
   std::vector<std::string> labels_;
-  std::unique_ptr<float[]> out_scores_;
-  std::unique_ptr<float[]> out_boxes_;
-  std::unique_ptr<float[]> out_classes_;
   std::unique_ptr<yolo::Net> net_ptr_;
 };
 
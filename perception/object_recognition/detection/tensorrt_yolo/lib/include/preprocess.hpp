@@ -0,0 +1,48 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef PREPROCESS_HPP_
+#define PREPROCESS_HPP_
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+
+namespace yolo
+{
+// Mapping from the source image to the network input: dst = src * scale + pad
+struct ImageTransform
+{
+  float scale_x;
+  float scale_y;
+  float pad_x;
+  float pad_y;
+};
+
+// Stretch the image to the network input, or fit it keeping the aspect ratio and pad the rest
+ImageTransform getImageTransform(
+  const int src_width, const int src_height, const int dst_width, const int dst_height,
+  const bool letterbox);
+
+// Resize a BGR8 image with bilinear interpolation, pad it and write it as normalized
+// RGB planes (CHW) in [0, 1]
+cudaError_t resizeAndNormalize_launch(
+  const uint8_t * src, const int src_width, const int src_height, const int src_step,
+  const ImageTransform & transform, const int dst_width, const int dst_height, float * dst,
+  cudaStream_t stream);
+
+}  // namespace yolo
+
+#endif  // PREPROCESS_HPP_
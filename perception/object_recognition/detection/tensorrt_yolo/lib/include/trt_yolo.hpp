@@ -41,14 +41,20 @@
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/opencv.hpp>
+#include <preprocess.hpp>
 #include <yolo_layer.hpp>
 
 #include <NvInfer.h>
 #include <cuda_runtime.h>
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace yolo
@@ -95,6 +101,15 @@ struct Config
   float ignore_thresh;
 };
 
+// Number of images that can be processed at the same time, each on its own stream with its
+// own optimization profile of the engine
+constexpr int MAX_IN_FLIGHT_IMAGES = 2;
+
+// Called with the results of an image, or with is_success false if the inference failed.
+// The boxes are (x, y, w, h) normalized by the size of the input image.
+using DetectionCallback = std::function<void(
+  bool is_success, const float * scores, const float * boxes, const float * classes)>;
+
 class Net
 {
 public:
@@ -115,6 +130,21 @@ public:
 
   bool detect(const cv::Mat & in_img, float * out_scores, float * out_boxes, float * out_classes);
 
+  // Enqueue the inference of a BGR8 image and return without waiting for it. The callback is
+  // called from a worker thread in the order the images were enqueued. Blocks while all the
+  // streams are busy.
+  bool detectAsync(const cv::Mat & in_img, DetectionCallback callback);
+
+  // Enqueue the images as one batch, up to the max batch size. The callback of each image is
+  // called with its own results.
+  bool detectAsync(const std::vector<cv::Mat> & in_imgs, std::vector<DetectionCallback> callbacks);
+
+  // Fit the image with its aspect ratio kept instead of stretching it to the input size
+  void setLetterbox(const bool letterbox) { letterbox_ = letterbox; }
+
+  // Get the number of images that can be in flight, one per optimization profile of the engine
+  int getNumInferenceSlots() const { return static_cast<int>(slots_.size()); }
+
   // Get (c, h, w) size of the fixed input
   std::vector<int> getInputDims() const;
 
@@ -129,21 +159,48 @@ public:
   int getInputSize() const;
 
 private:
+  // Buffers and execution context of one image in flight
+  struct InferenceSlot
+  {
+    unique_ptr<nvinfer1::IExecutionContext> context = nullptr;
+    cudaStream_t stream = nullptr;
+    int first_binding = 0;
+    std::vector<void *> bindings;
+    size_t image_capacity = 0;
+    cuda::unique_ptr_host<uint8_t[]> image_h = nullptr;
+    cuda::unique_ptr<uint8_t[]> image_d = nullptr;
+    cuda::unique_ptr<float[]> input_d = nullptr;
+    cuda::unique_ptr<float[]> out_scores_d = nullptr;
+    cuda::unique_ptr<float[]> out_boxes_d = nullptr;
+    cuda::unique_ptr<float[]> out_classes_d = nullptr;
+    cuda::unique_ptr_host<float[]> out_scores_h = nullptr;
+    cuda::unique_ptr_host<float[]> out_boxes_h = nullptr;
+    cuda::unique_ptr_host<float[]> out_classes_h = nullptr;
+    std::vector<cv::Size> image_sizes;
+    std::vector<ImageTransform> transforms;
+    std::vector<DetectionCallback> callbacks;
+  };
+
   unique_ptr<nvinfer1::IRuntime> runtime_ = nullptr;
   unique_ptr<nvinfer1::ICudaEngine> engine_ = nullptr;
-  unique_ptr<nvinfer1::IExecutionContext> context_ = nullptr;
-  cudaStream_t stream_ = nullptr;
-  cuda::unique_ptr<float[]> input_d_ = nullptr;
-  cuda::unique_ptr<float[]> out_scores_d_ = nullptr;
-  cuda::unique_ptr<float[]> out_boxes_d_ = nullptr;
-  cuda::unique_ptr<float[]> out_classes_d_ = nullptr;
+  bool letterbox_ = false;
+
+  std::vector<std::unique_ptr<InferenceSlot>> slots_;
+  std::mutex slots_mutex_;
+  std::condition_variable slots_cv_;
+  std::deque<size_t> free_slots_;
+  std::deque<size_t> in_flight_slots_;
+  bool is_stopped_ = false;
+  std::thread completion_thread_;
 
   void load(const std::string & path);
   bool prepare();
-  std::vector<float> preprocess(
-    const cv::Mat & in_img, const int c, const int h, const int w) const;
-  // Infer using pre-allocated GPU buffers {data, scores, boxes}
-  void infer(std::vector<void *> & buffers, const int batch_size);
+  size_t acquireSlot();
+  void releaseSlot(const size_t index);
+  // Enqueue the copies, the preprocessing and the inference of a batch on the slot stream
+  bool enqueue(InferenceSlot & slot, const std::vector<cv::Mat> & in_imgs);
+  // Wait for the slots in the order they were enqueued and call their callback
+  void completionThread();
 };
 
 }  // namespace yolo
@@ -0,0 +1,100 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <preprocess.hpp>
+
+#include <algorithm>
+
+namespace yolo
+{
+// gray, as in the darknet letterbox
+constexpr float PAD_VALUE = 0.5f;
+
+__global__ void resizeAndNormalizeKernel(
+  const uint8_t * src, const int src_width, const int src_height, const int src_step,
+  const ImageTransform transform, const int dst_width, const int dst_height, float * dst)
+{
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int y = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= dst_width || y >= dst_height) {
+    return;
+  }
+  const int channel_size = dst_width * dst_height;
+  float * dst_pixel = dst + y * dst_width + x;
+
+  // pixel centers are aligned as in cv::resize
+  const float src_x = (x + 0.5f - transform.pad_x) / transform.scale_x - 0.5f;
+  const float src_y = (y + 0.5f - transform.pad_y) / transform.scale_y - 0.5f;
+  if (src_x <= -1.0f || src_y <= -1.0f || src_x >= src_width || src_y >= src_height) {
+    for (int c = 0; c < 3; ++c) {
+      dst_pixel[c * channel_size] = PAD_VALUE;
+    }
+    return;
+  }
+
+  const float clamped_x = fminf(fmaxf(src_x, 0.0f), src_width - 1.0f);
+  const float clamped_y = fminf(fmaxf(src_y, 0.0f), src_height - 1.0f);
+  const int x0 = static_cast<int>(clamped_x);
+  const int y0 = static_cast<int>(clamped_y);
+  const int x1 = min(x0 + 1, src_width - 1);
+  const int y1 = min(y0 + 1, src_height - 1);
+  const float ax = clamped_x - x0;
+  const float ay = clamped_y - y0;
+
+  const uint8_t * p00 = src + y0 * src_step + x0 * 3;
+  const uint8_t * p01 = src + y0 * src_step + x1 * 3;
+  const uint8_t * p10 = src + y1 * src_step + x0 * 3;
+  const uint8_t * p11 = src + y1 * src_step + x1 * 3;
+  for (int c = 0; c < 3; ++c) {
+    const float top = p00[c] + (p01[c] - p00[c]) * ax;
+    const float bottom = p10[c] + (p11[c] - p10[c]) * ax;
+    // BGR to RGB
+    dst_pixel[(2 - c) * channel_size] = (top + (bottom - top) * ay) * (1.0f / 255.0f);
+  }
+}
+
+ImageTransform getImageTransform(
+  const int src_width, const int src_height, const int dst_width, const int dst_height,
+  const bool letterbox)
+{
+  ImageTransform transform;
+  transform.scale_x = static_cast<float>(dst_width) / src_width;
+  transform.scale_y = static_cast<float>(dst_height) / src_height;
+  transform.pad_x = 0.0f;
+  transform.pad_y = 0.0f;
+  if (letterbox) {
+    const float scale = std::min(transform.scale_x, transform.scale_y);
+    transform.scale_x = scale;
+    transform.scale_y = scale;
+    transform.pad_x = (dst_width - src_width * scale) * 0.5f;
+    transform.pad_y = (dst_height - src_height * scale) * 0.5f;
+  }
+  return transform;
+}
+
+cudaError_t resizeAndNormalize_launch(
+  const uint8_t * src, const int src_width, const int src_height, const int src_step,
+  const ImageTransform & transform, const int dst_width, const int dst_height, float * dst,
+  cudaStream_t stream)
+{
+  const dim3 threads(32, 8);
+  const dim3 blocks(
+    (dst_width + threads.x - 1) / threads.x, (dst_height + threads.y - 1) / threads.y);
+  resizeAndNormalizeKernel<<<blocks, threads, 0, stream>>>(
+    src, src_width, src_height, src_step, transform, dst_width, dst_height, dst);
+  return cudaGetLastError();
+}
+
+}  // namespace yolo
@@ -38,6 +38,7 @@
 #include <cuda_utils.hpp>
 #include <mish_plugin.hpp>
 #include <nms_plugin.hpp>
+#include <preprocess.hpp>
 #include <trt_yolo.hpp>
 #include <yolo_layer_plugin.hpp>
 
@@ -46,6 +47,7 @@
 #include <algorithm>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <memory>
 #include <numeric>
 #include <stdexcept>
@@ -76,44 +78,39 @@ bool Net::prepare()
   if (!engine_) {
     return false;
   }
-  context_ = unique_ptr<nvinfer1::IExecutionContext>(engine_->createExecutionContext());
-  if (!context_) {
-    return false;
+  const int num_profiles = engine_->getNbOptimizationProfiles();
+  const int num_bindings_per_profile = engine_->getNbBindings() / num_profiles;
+  const int max_batch_size = getMaxBatchSize();
+  const int max_detections = max_batch_size * getMaxDetections();
+  for (int i = 0; i < std::min(num_profiles, MAX_IN_FLIGHT_IMAGES); ++i) {
+    auto slot = std::make_unique<InferenceSlot>();
+    slot->context = unique_ptr<nvinfer1::IExecutionContext>(engine_->createExecutionContext());
+    if (!slot->context || !slot->context->setOptimizationProfile(i)) {
+      return false;
+    }
+    // each context only binds the tensors of its own profile
+    const int first_binding = i * num_bindings_per_profile;
+    slot->first_binding = first_binding;
+    CHECK_CUDA_ERROR(cudaStreamCreate(&slot->stream));
+    slot->input_d = cuda::make_unique<float[]>(max_batch_size * getInputSize());
+    slot->out_scores_d = cuda::make_unique<float[]>(max_detections);
+    slot->out_boxes_d = cuda::make_unique<float[]>(max_detections * 4);
+    slot->out_classes_d = cuda::make_unique<float[]>(max_detections);
+    slot->out_scores_h = cuda::make_unique_host<float[]>(max_detections);
+    slot->out_boxes_h = cuda::make_unique_host<float[]>(max_detections * 4);
+    slot->out_classes_h = cuda::make_unique_host<float[]>(max_detections);
+    slot->bindings.assign(engine_->getNbBindings(), nullptr);
+    slot->bindings[first_binding] = slot->input_d.get();
+    slot->bindings[first_binding + 1] = slot->out_scores_d.get();
+    slot->bindings[first_binding + 2] = slot->out_boxes_d.get();
+    slot->bindings[first_binding + 3] = slot->out_classes_d.get();
+    free_slots_.push_back(slots_.size());
+    slots_.push_back(std::move(slot));
   }
-  input_d_ = cuda::make_unique<float[]>(getMaxBatchSize() * getInputSize());
-  out_scores_d_ = cuda::make_unique<float[]>(getMaxBatchSize() * getMaxDetections());
-  out_boxes_d_ = cuda::make_unique<float[]>(getMaxBatchSize() * getMaxDetections() * 4);
-  out_classes_d_ = cuda::make_unique<float[]>(getMaxBatchSize() * getMaxDetections());
-  cudaStreamCreate(&stream_);
+  completion_thread_ = std::thread(&Net::completionThread, this);
   return true;
 }
 
-std::vector<float> Net::preprocess(
-  const cv::Mat & in_img, const int c, const int w, const int h) const
-{
-  cv::Mat rgb;
-  cv::cvtColor(in_img, rgb, cv::COLOR_BGR2RGB);
-
-  cv::resize(rgb, rgb, cv::Size(w, h));
-
-  cv::Mat img_float;
-  rgb.convertTo(img_float, CV_32FC3, 1 / 255.0);
-
-  // HWC TO CHW
-  std::vector<cv::Mat> input_channels(c);
-  cv::split(img_float, input_channels);
-
-  std::vector<float> result(h * w * c);
-  auto data = result.data();
-  int channel_length = h * w;
-  for (int i = 0; i < c; ++i) {
-    memcpy(data, input_channels[i].data, channel_length * sizeof(float));
-    data += channel_length;
-  }
-
-  return result;
-}
-
 Net::Net(const std::string & path, bool verbose)
 {
   Logger logger(verbose);
@@ -127,9 +124,20 @@ Net::Net(const std::string & path, bool verbose)
 
 Net::~Net()
 {
-  if (stream_) {
-    cudaStreamSynchronize(stream_);
-    cudaStreamDestroy(stream_);
+  {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    is_stopped_ = true;
+  }
+  slots_cv_.notify_all();
+  // the images in flight are completed before the thread exits
+  if (completion_thread_.joinable()) {
+    completion_thread_.join();
+  }
+  for (auto & slot : slots_) {
+    if (slot->stream) {
+      cudaStreamSynchronize(slot->stream);
+      cudaStreamDestroy(slot->stream);
+    }
   }
 }
 
@@ -226,18 +234,20 @@ Net::Net(
     network->markOutput(*output);
   }
 
-  // create profile
-  auto profile = builder->createOptimizationProfile();
-  profile->setDimensions(
-    network->getInput(0)->getName(), nvinfer1::OptProfileSelector::kMIN,
-    nvinfer1::Dims4{max_batch_size, input_channel, input_height, input_width});
-  profile->setDimensions(
-    network->getInput(0)->getName(), nvinfer1::OptProfileSelector::kOPT,
-    nvinfer1::Dims4{max_batch_size, input_channel, input_height, input_width});
-  profile->setDimensions(
-    network->getInput(0)->getName(), nvinfer1::OptProfileSelector::kMAX,
-    nvinfer1::Dims4{max_batch_size, input_channel, input_height, input_width});
-  config->addOptimizationProfile(profile);
+  // one profile per image in flight, execution contexts cannot share them
+  for (int i = 0; i < MAX_IN_FLIGHT_IMAGES; ++i) {
+    auto profile = builder->createOptimizationProfile();
+    profile->setDimensions(
+      network->getInput(0)->getName(), nvinfer1::OptProfileSelector::kMIN,
+      nvinfer1::Dims4{1, input_channel, input_height, input_width});
+    profile->setDimensions(
+      network->getInput(0)->getName(), nvinfer1::OptProfileSelector::kOPT,
+      nvinfer1::Dims4{max_batch_size, input_channel, input_height, input_width});
+    profile->setDimensions(
+      network->getInput(0)->getName(), nvinfer1::OptProfileSelector::kMAX,
+      nvinfer1::Dims4{max_batch_size, input_channel, input_height, input_width});
+    config->addOptimizationProfile(profile);
+  }
 
   std::unique_ptr<yolo::Int8EntropyCalibrator> calib{nullptr};
   if (int8) {
@@ -268,44 +278,184 @@ void Net::save(const std::string & path) const
   file.write(reinterpret_cast<const char *>(serialized->data()), serialized->size());
 }
 
-void Net::infer(std::vector<void *> & buffers, const int batch_size)
+bool Net::detect(const cv::Mat & in_img, float * out_scores, float * out_boxes, float * out_classes)
 {
-  if (!context_) {
-    throw std::runtime_error("Fail to create context");
-  }
-  auto input_dims = engine_->getBindingDimensions(0);
-  context_->setBindingDimensions(
-    0, nvinfer1::Dims4(batch_size, input_dims.d[1], input_dims.d[2], input_dims.d[3]));
-  context_->enqueueV2(buffers.data(), stream_, nullptr);
-  cudaStreamSynchronize(stream_);
+  std::promise<bool> result;
+  auto future = result.get_future();
+  const auto callback =
+    [&](const bool is_success, const float * scores, const float * boxes, const float * classes) {
+      if (is_success) {
+        std::copy(scores, scores + getMaxDetections(), out_scores);
+        std::copy(boxes, boxes + getMaxDetections() * 4, out_boxes);
+        std::copy(classes, classes + getMaxDetections(), out_classes);
+      }
+      result.set_value(is_success);
+    };
+  if (!detectAsync(in_img, callback)) {
+    return false;
+  }
+  return future.get();
 }
 
-bool Net::detect(const cv::Mat & in_img, float * out_scores, float * out_boxes, float * out_classes)
+bool Net::detectAsync(const cv::Mat & in_img, DetectionCallback callback)
 {
-  const auto input_dims = getInputDims();
-  const auto input = preprocess(in_img, input_dims.at(0), input_dims.at(2), input_dims.at(1));
-  CHECK_CUDA_ERROR(
-    cudaMemcpy(input_d_.get(), input.data(), input.size() * sizeof(float), cudaMemcpyHostToDevice));
-  std::vector<void *> buffers = {
-    input_d_.get(), out_scores_d_.get(), out_boxes_d_.get(), out_classes_d_.get()};
+  return detectAsync(std::vector<cv::Mat>{in_img}, std::vector<DetectionCallback>{callback});
+}
+
+bool Net::detectAsync(
+  const std::vector<cv::Mat> & in_imgs, std::vector<DetectionCallback> callbacks)
+{
+  if (
+    slots_.empty() || in_imgs.empty() || in_imgs.size() != callbacks.size() ||
+    static_cast<int>(in_imgs.size()) > getMaxBatchSize()) {
+    return false;
+  }
+  for (const auto & in_img : in_imgs) {
+    if (in_img.type() != CV_8UC3 || in_img.empty()) {
+      return false;
+    }
+  }
+  const size_t index = acquireSlot();
+  InferenceSlot & slot = *slots_[index];
+  bool is_enqueued = false;
   try {
-    infer(buffers, 1);
-  } catch (const std::runtime_error & e) {
+    is_enqueued = enqueue(slot, in_imgs);
+  } catch (...) {
+    releaseSlot(index);
+    throw;
+  }
+  if (!is_enqueued) {
+    releaseSlot(index);
     return false;
   }
+  slot.callbacks = std::move(callbacks);
+  {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    in_flight_slots_.push_back(index);
+  }
+  slots_cv_.notify_all();
+  return true;
+}
+
+size_t Net::acquireSlot()
+{
+  std::unique_lock<std::mutex> lock(slots_mutex_);
+  slots_cv_.wait(lock, [this] { return !free_slots_.empty(); });
+  const size_t index = free_slots_.front();
+  free_slots_.pop_front();
+  return index;
+}
+
+void Net::releaseSlot(const size_t index)
+{
+  {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    free_slots_.push_back(index);
+  }
+  slots_cv_.notify_all();
+}
+
+bool Net::enqueue(InferenceSlot & slot, const std::vector<cv::Mat> & in_imgs)
+{
+  const int batch_size = static_cast<int>(in_imgs.size());
+  std::vector<size_t> image_offsets;
+  size_t total_image_size = 0;
+  for (const auto & in_img : in_imgs) {
+    image_offsets.push_back(total_image_size);
+    total_image_size += in_img.total() * in_img.elemSize();
+  }
+  if (total_image_size > slot.image_capacity) {
+    slot.image_h = cuda::make_unique_host<uint8_t[]>(total_image_size);
+    slot.image_d = cuda::make_unique<uint8_t[]>(total_image_size);
+    slot.image_capacity = total_image_size;
+  }
+  // staging in page-locked memory makes the upload asynchronous, and removes the row padding
+  for (int i = 0; i < batch_size; ++i) {
+    const auto & in_img = in_imgs[i];
+    cv::Mat image_h(in_img.rows, in_img.cols, CV_8UC3, slot.image_h.get() + image_offsets[i]);
+    in_img.copyTo(image_h);
+  }
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    out_scores, out_scores_d_.get(), sizeof(float) * getMaxDetections(), cudaMemcpyDeviceToHost,
-    stream_));
+    slot.image_d.get(), slot.image_h.get(), total_image_size, cudaMemcpyHostToDevice,
+    slot.stream));
+
+  const auto input_dims = getInputDims();
+  const int input_width = input_dims.at(2);
+  const int input_height = input_dims.at(1);
+  slot.image_sizes.clear();
+  slot.transforms.clear();
+  for (int i = 0; i < batch_size; ++i) {
+    const auto & in_img = in_imgs[i];
+    slot.image_sizes.push_back(in_img.size());
+    slot.transforms.push_back(
+      getImageTransform(in_img.cols, in_img.rows, input_width, input_height, letterbox_));
+    CHECK_CUDA_ERROR(resizeAndNormalize_launch(
+      slot.image_d.get() + image_offsets[i], in_img.cols, in_img.rows, in_img.cols * 3,
+      slot.transforms.back(), input_width, input_height, slot.input_d.get() + i * getInputSize(),
+      slot.stream));
+  }
+
+  slot.context->setBindingDimensions(
+    slot.first_binding,
+    nvinfer1::Dims4(batch_size, input_dims.at(0), input_dims.at(1), input_dims.at(2)));
+  if (!slot.context->enqueueV2(slot.bindings.data(), slot.stream, nullptr)) {
+    return false;
+  }
+  const int num_detections = batch_size * getMaxDetections();
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    slot.out_scores_h.get(), slot.out_scores_d.get(), sizeof(float) * num_detections,
+    cudaMemcpyDeviceToHost, slot.stream));
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    out_boxes, out_boxes_d_.get(), sizeof(float) * 4 * getMaxDetections(), cudaMemcpyDeviceToHost,
-    stream_));
+    slot.out_boxes_h.get(), slot.out_boxes_d.get(), sizeof(float) * 4 * num_detections,
+    cudaMemcpyDeviceToHost, slot.stream));
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    out_classes, out_classes_d_.get(), sizeof(float) * getMaxDetections(), cudaMemcpyDeviceToHost,
-    stream_));
-  cudaStreamSynchronize(stream_);
+    slot.out_classes_h.get(), slot.out_classes_d.get(), sizeof(float) * num_detections,
+    cudaMemcpyDeviceToHost, slot.stream));
   return true;
 }
 
+void Net::completionThread()
+{
+  const auto input_dims = getInputDims();
+  const float input_width = input_dims.at(2);
+  const float input_height = input_dims.at(1);
+  const int max_detections = getMaxDetections();
+  while (true) {
+    size_t index;
+    {
+      std::unique_lock<std::mutex> lock(slots_mutex_);
+      slots_cv_.wait(lock, [this] { return is_stopped_ || !in_flight_slots_.empty(); });
+      if (in_flight_slots_.empty()) {
+        return;
+      }
+      index = in_flight_slots_.front();
+      in_flight_slots_.pop_front();
+    }
+    InferenceSlot & slot = *slots_[index];
+    const bool is_success = cudaStreamSynchronize(slot.stream) == cudaSuccess;
+    for (size_t b = 0; b < slot.callbacks.size(); ++b) {
+      const float * scores = slot.out_scores_h.get() + b * max_detections;
+      float * boxes = slot.out_boxes_h.get() + b * max_detections * 4;
+      const float * classes = slot.out_classes_h.get() + b * max_detections;
+      if (is_success) {
+        // from the network input back to the input image
+        const auto & t = slot.transforms[b];
+        const auto & image_size = slot.image_sizes[b];
+        for (int i = 0; i < max_detections; ++i) {
+          float * box = boxes + 4 * i;
+          box[0] = (box[0] * input_width - t.pad_x) / t.scale_x / image_size.width;
+          box[1] = (box[1] * input_height - t.pad_y) / t.scale_y / image_size.height;
+          box[2] = box[2] * input_width / t.scale_x / image_size.width;
+          box[3] = box[3] * input_height / t.scale_y / image_size.height;
+        }
+      }
+      slot.callbacks[b](is_success, scores, boxes, classes);
+    }
+    slot.callbacks.clear();
+    releaseSlot(index);
+  }
+}
+
 std::vector<int> Net::getInputDims() const
 {
   auto dims = engine_->getBindingDimensions(0);
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -63,6 +64,25 @@ TensorrtYoloNodelet::TensorrtYoloNodelet(const rclcpp::NodeOptions & options)
   yolo_config_.detections_per_im = declare_parameter("detections_per_im", 100);
   yolo_config_.use_darknet_layer = declare_parameter("use_darknet_layer", true);
   yolo_config_.ignore_thresh = declare_parameter("ignore_thresh", 0.5);
+  const bool letterbox = declare_parameter("letterbox", false);
+  const auto input_topics = declare_parameter("input_topics", std::vector<std::string>{});
+  const auto output_topics = declare_parameter("output_topics", std::vector<std::string>{});
+  batch_timeout_ = declare_parameter("batch_timeout", 0.01);
+
+  // one camera on the default topics, or frames of several cameras inferred as one batch
+  if (input_topics.empty()) {
+    cameras_.resize(1);
+    cameras_.front().input_topic = "in/image";
+  } else {
+    if (input_topics.size() != output_topics.size()) {
+      throw std::invalid_argument("input_topics and output_topics must have the same size");
+    }
+    cameras_.resize(input_topics.size());
+    for (size_t i = 0; i < input_topics.size(); ++i) {
+      cameras_[i].input_topic = input_topics[i];
+    }
+  }
+  const int batch_size = static_cast<int>(cameras_.size());
 
   if (!readLabelFile(label_file, &labels_)) {
     RCLCPP_ERROR(this->get_logger(), "Could not find label file");
@@ -72,22 +92,30 @@ TensorrtYoloNodelet::TensorrtYoloNodelet(const rclcpp::NodeOptions & options)
   if (fs.is_open()) {
     RCLCPP_INFO(this->get_logger(), "Found %s", engine_file.c_str());
     net_ptr_.reset(new yolo::Net(engine_file, false));
-    if (net_ptr_->getMaxBatchSize() != 1) {
+    if (net_ptr_->getMaxBatchSize() != batch_size) {
       RCLCPP_INFO(
-        this->get_logger(), "Max batch size %d should be 1. Rebuild engine from file",
-        net_ptr_->getMaxBatchSize());
-      net_ptr_.reset(
-        new yolo::Net(onnx_file, mode, 1, yolo_config_, calibration_images, calib_cache_file));
+        this->get_logger(), "Max batch size %d should be %d. Rebuild engine from file",
+        net_ptr_->getMaxBatchSize(), batch_size);
+      net_ptr_.reset(new yolo::Net(
+        onnx_file, mode, batch_size, yolo_config_, calibration_images, calib_cache_file));
+      net_ptr_->save(engine_file);
+    } else if (net_ptr_->getNumInferenceSlots() < yolo::MAX_IN_FLIGHT_IMAGES) {
+      RCLCPP_INFO(
+        this->get_logger(), "Engine has %d optimization profiles, %d are needed. Rebuild engine",
+        net_ptr_->getNumInferenceSlots(), yolo::MAX_IN_FLIGHT_IMAGES);
+      net_ptr_.reset(new yolo::Net(
+        onnx_file, mode, batch_size, yolo_config_, calibration_images, calib_cache_file));
       net_ptr_->save(engine_file);
     }
   } else {
     RCLCPP_INFO(
       this->get_logger(), "Could not find %s, try making TensorRT engine from onnx",
       engine_file.c_str());
-    net_ptr_.reset(
-      new yolo::Net(onnx_file, mode, 1, yolo_config_, calibration_images, calib_cache_file));
+    net_ptr_.reset(new yolo::Net(
+      onnx_file, mode, batch_size, yolo_config_, calibration_images, calib_cache_file));
     net_ptr_->save(engine_file);
   }
+  net_ptr_->setLetterbox(letterbox);
   auto timer_callback = std::bind(&TensorrtYoloNodelet::connectCb, this);
   const auto period_s = 0.1;
   const auto period_ns =
@@ -97,37 +125,50 @@ TensorrtYoloNodelet::TensorrtYoloNodelet(const rclcpp::NodeOptions & options)
     this->get_node_base_interface()->get_context());
   this->get_node_timers_interface()->add_timer(timer_, nullptr);
 
+  if (batch_size > 1) {
+    batch_timer_ = rclcpp::create_timer(
+      this, this->get_clock(), rclcpp::Duration::from_seconds(batch_timeout_ * 0.5),
+      std::bind(&TensorrtYoloNodelet::onBatchTimer, this));
+  }
+
   std::lock_guard<std::mutex> lock(connect_mutex_);
 
-  objects_pub_ =
-    this->create_publisher<autoware_perception_msgs::msg::DynamicObjectWithFeatureArray>(
-      "out/objects", 1);
-  image_pub_ = image_transport::create_publisher(this, "out/image");
-
-  out_scores_ =
-    std::make_unique<float[]>(net_ptr_->getMaxBatchSize() * net_ptr_->getMaxDetections());
-  out_boxes_ =
-    std::make_unique<float[]>(net_ptr_->getMaxBatchSize() * net_ptr_->getMaxDetections() * 4);
-  out_classes_ =
-    std::make_unique<float[]>(net_ptr_->getMaxBatchSize() * net_ptr_->getMaxDetections());
+  for (size_t i = 0; i < cameras_.size(); ++i) {
+    const std::string output_topic = input_topics.empty() ? "out/objects" : output_topics[i];
+    const std::string image_topic =
+      input_topics.empty() ? "out/image" : output_topics[i] + "/debug/image";
+    cameras_[i].objects_pub =
+      this->create_publisher<autoware_perception_msgs::msg::DynamicObjectWithFeatureArray>(
+        output_topic, 1);
+    cameras_[i].image_pub = image_transport::create_publisher(this, image_topic);
+  }
 }
 
 void TensorrtYoloNodelet::connectCb()
 {
   using std::placeholders::_1;
   std::lock_guard<std::mutex> lock(connect_mutex_);
-  if (objects_pub_->get_subscription_count() == 0 && image_pub_.getNumSubscribers() == 0) {
-    image_sub_.shutdown();
-  } else if (!image_sub_) {
-    image_sub_ = image_transport::create_subscription(
-      this, "in/image", std::bind(&TensorrtYoloNodelet::callback, this, _1), "raw");
+  for (size_t i = 0; i < cameras_.size(); ++i) {
+    auto & camera = cameras_[i];
+    if (
+      camera.objects_pub->get_subscription_count() == 0 &&
+      camera.image_pub.getNumSubscribers() == 0) {
+      camera.image_sub.shutdown();
+      std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+      camera.pending_image = nullptr;
+      camera.is_subscribed = false;
+    } else if (!camera.image_sub) {
+      camera.image_sub = image_transport::create_subscription(
+        this, camera.input_topic, std::bind(&TensorrtYoloNodelet::callback, this, _1, i), "raw");
+      std::lock_guard<std::mutex> batch_lock(batch_mutex_);
+      camera.is_subscribed = true;
+    }
   }
 }
 
-void TensorrtYoloNodelet::callback(const sensor_msgs::msg::Image::ConstSharedPtr in_image_msg)
+void TensorrtYoloNodelet::callback(
+  const sensor_msgs::msg::Image::ConstSharedPtr in_image_msg, const size_t camera_index)
 {
-  autoware_perception_msgs::msg::DynamicObjectWithFeatureArray out_objects;
-
   cv_bridge::CvImagePtr in_image_ptr;
   try {
     in_image_ptr = cv_bridge::toCvCopy(in_image_msg, sensor_msgs::image_encodings::BGR8);
@@ -135,24 +176,83 @@ void TensorrtYoloNodelet::callback(const sensor_msgs::msg::Image::ConstSharedPtr
     RCLCPP_ERROR(this->get_logger(), "cv_bridge exception: %s", e.what());
     return;
   }
-  if (!net_ptr_->detect(
-        in_image_ptr->image, out_scores_.get(), out_boxes_.get(), out_classes_.get())) {
+
+  std::unique_lock<std::mutex> lock(batch_mutex_);
+  if (!hasPendingImage()) {
+    batch_start_time_ = this->now();
+  }
+  // a camera faster than the others replaces its frame instead of delaying the batch
+  cameras_[camera_index].pending_image = in_image_ptr;
+  const bool is_batch_complete = std::all_of(
+    cameras_.begin(), cameras_.end(),
+    [](const Camera & camera) { return !camera.is_subscribed || camera.pending_image; });
+  if (is_batch_complete) {
+    inferPendingImages(lock);
+  }
+}
+
+void TensorrtYoloNodelet::onBatchTimer()
+{
+  std::unique_lock<std::mutex> lock(batch_mutex_);
+  if (hasPendingImage() && (this->now() - batch_start_time_).seconds() >= batch_timeout_) {
+    inferPendingImages(lock);
+  }
+}
+
+bool TensorrtYoloNodelet::hasPendingImage() const
+{
+  return std::any_of(cameras_.begin(), cameras_.end(), [](const Camera & camera) {
+    return static_cast<bool>(camera.pending_image);
+  });
+}
+
+void TensorrtYoloNodelet::inferPendingImages(std::unique_lock<std::mutex> & lock)
+{
+  std::vector<cv::Mat> images;
+  std::vector<yolo::DetectionCallback> callbacks;
+  for (size_t i = 0; i < cameras_.size(); ++i) {
+    const auto in_image_ptr = cameras_[i].pending_image;
+    if (!in_image_ptr) {
+      continue;
+    }
+    cameras_[i].pending_image = nullptr;
+    images.push_back(in_image_ptr->image);
+    // the images are published when their results land, while the next batch is processed
+    callbacks.push_back([this, i, in_image_ptr](
+                          const bool is_success, const float * scores, const float * boxes,
+                          const float * classes) {
+      if (!is_success) {
+        RCLCPP_WARN(this->get_logger(), "Fail to inference");
+        return;
+      }
+      publishDetections(i, in_image_ptr, scores, boxes, classes);
+    });
+  }
+  // the next batch is collected while waiting for a free stream
+  lock.unlock();
+  if (!net_ptr_->detectAsync(images, std::move(callbacks))) {
     RCLCPP_WARN(this->get_logger(), "Fail to inference");
-    return;
   }
+}
+
+void TensorrtYoloNodelet::publishDetections(
+  const size_t camera_index, const cv_bridge::CvImagePtr & in_image_ptr, const float * out_scores,
+  const float * out_boxes, const float * out_classes)
+{
+  autoware_perception_msgs::msg::DynamicObjectWithFeatureArray out_objects;
   const auto width = in_image_ptr->image.cols;
   const auto height = in_image_ptr->image.rows;
   for (int i = 0; i < yolo_config_.detections_per_im; ++i) {
-    if (out_scores_[i] < yolo_config_.ignore_thresh) {
+    if (out_scores[i] < yolo_config_.ignore_thresh) {
       break;
     }
     autoware_perception_msgs::msg::DynamicObjectWithFeature object;
-    object.feature.roi.x_offset = out_boxes_[4 * i] * width;
-    object.feature.roi.y_offset = out_boxes_[4 * i + 1] * height;
-    object.feature.roi.width = out_boxes_[4 * i + 2] * width;
-    object.feature.roi.height = out_boxes_[4 * i + 3] * height;
-    object.object.semantic.confidence = out_scores_[i];
-    const auto class_id = static_cast<int>(out_classes_[i]);
+    object.feature.roi.x_offset = out_boxes[4 * i] * width;
+    object.feature.roi.y_offset = out_boxes[4 * i + 1] * height;
+    object.feature.roi.width = out_boxes[4 * i + 2] * width;
+    object.feature.roi.height = out_boxes[4 * i + 3] * height;
+    object.object.semantic.confidence = out_scores[i];
+    const auto class_id = static_cast<int>(out_classes[i]);
     if (labels_[class_id] == "car") {
       object.object.semantic.type = autoware_perception_msgs::msg::Semantic::CAR;
     } else if (labels_[class_id] == "person") {
@@ -179,10 +279,11 @@ void TensorrtYoloNodelet::callback(const sensor_msgs::msg::Image::ConstSharedPtr
       in_image_ptr->image, cv::Point(left, top), cv::Point(right, bottom), cv::Scalar(0, 0, 255), 3,
       8, 0);
   }
-  image_pub_.publish(in_image_ptr->toImageMsg());
+  auto & camera = cameras_[camera_index];
+  camera.image_pub.publish(in_image_ptr->toImageMsg());
 
-  out_objects.header = in_image_msg->header;
-  objects_pub_->publish(out_objects);
+  out_objects.header = in_image_ptr->header;
+  camera.objects_pub->publish(out_objects);
 }
 
 bool TensorrtYoloNodelet::readLabelFile(
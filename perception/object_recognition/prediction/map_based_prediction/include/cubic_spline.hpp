@@ -83,7 +83,7 @@ public:
     }
   }
 
-  double calc(double t)
+  double calc(double t) const
   {
     if (t < x.front() || t > x.back()) {
       std::cout << "Dangerous" << std::endl;
@@ -95,7 +95,7 @@ public:
     return a[seg_id] + b[seg_id] * dx + c[seg_id] * dx * dx + d[seg_id] * dx * dx * dx;
   }
 
-  double calc(double t, double s)
+  double calc(double t, double s) const
   {
     if (t < 0 || t > s) {
       std::cout << "Dangerous" << std::endl;
@@ -107,7 +107,7 @@ public:
     return a[seg_id] + b[seg_id] * dx + c[seg_id] * dx * dx + d[seg_id] * dx * dx * dx;
   }
 
-  double calc_d(double t)
+  double calc_d(double t) const
   {
     if (t < x.front() || t > x.back()) {
       std::cout << "Dangerous" << std::endl;
@@ -119,7 +119,7 @@ public:
     return b[seg_id] + 2 * c[seg_id] * dx + 3 * d[seg_id] * dx * dx;
   }
 
-  double calc_d(double t, double s)
+  double calc_d(double t, double s) const
   {
     if (t < 0 || t > s) {
       std::cout << "Dangerous" << std::endl;
@@ -131,7 +131,7 @@ public:
     return b[seg_id] + 2 * c[seg_id] * dx + 3 * d[seg_id] * dx * dx;
   }
 
-  double calc_dd(double t)
+  double calc_dd(double t) const
   {
     if (t < x.front() || t > x.back()) {
       std::cout << "Dangerous" << std::endl;
@@ -143,7 +143,7 @@ public:
     return 2 * c[seg_id] + 6 * d[seg_id] * dx;
   }
 
-  double calc_dd(double t, double s)
+  double calc_dd(double t, double s) const
   {
     if (t < 0.0 || t > s) {
       std::cout << "Dangerous" << std::endl;
@@ -181,7 +181,7 @@ private:
     return B;
   }
 
-  int bisect(double t, int start, int end)
+  int bisect(double t, int start, int end) const
   {
     int mid = (start + end) / 2;
     if (t == x[mid] || end - start <= 1) {
@@ -210,14 +210,14 @@ public:
     max_s_value_ = *std::max_element(s.begin(), s.end());
   }
 
-  std::array<double, 2> calc_position(double s_t)
+  std::array<double, 2> calc_position(double s_t) const
   {
     double x = sx.calc(s_t, max_s_value_);
     double y = sy.calc(s_t, max_s_value_);
     return {{x, y}};
   }
 
-  double calc_curvature(double s_t)
+  double calc_curvature(double s_t) const
   {
     double dx = sx.calc_d(s_t, max_s_value_);
     double ddx = sx.calc_dd(s_t, max_s_value_);
@@ -226,7 +226,7 @@ public:
     return (ddy * dx - ddx * dy) / (dx * dx + dy * dy);
   }
 
-  double calc_yaw(double s_t)
+  double calc_yaw(double s_t) const
   {
     double dx = sx.calc_d(s_t, max_s_value_);
     double dy = sy.calc_d(s_t, max_s_value_);
@@ -21,12 +21,19 @@
 #include <geometry_msgs/msg/point.hpp>
 #include <geometry_msgs/msg/pose.hpp>
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 struct DynamicObjectWithLanes
 {
   autoware_perception_msgs::msg::DynamicObject object;
   std::vector<std::vector<geometry_msgs::msg::Pose>> lanes;
+  // lanelet ids each lane is made of, identifying the lane for the reference lane cache
+  std::vector<std::vector<int64_t>> lane_ids;
   std::vector<double> confidence;
 };
 
@@ -37,6 +44,7 @@ struct DynamicObjectWithLanesArray
 };
 
 class Spline2D;
+struct ReferenceLane;
 
 class MapBasedPrediction
 {
@@ -44,11 +52,21 @@ private:
   double interpolating_resolution_;
   double time_horizon_;
   double sampling_delta_time_;
+  double min_path_confidence_;
+
+  // splines of the lanes, kept for the objects of the next frames until the map changes
+  std::mutex reference_lanes_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<const ReferenceLane>> reference_lanes_;
+
+  std::shared_ptr<const ReferenceLane> getReferenceLane(
+    const std::vector<geometry_msgs::msg::Pose> & lane, const std::vector<int64_t> & lane_ids);
+  std::shared_ptr<const ReferenceLane> createReferenceLane(
+    const std::vector<geometry_msgs::msg::Pose> & lane) const;
 
   bool getPredictedPath(
     const double height, const double current_d_position, const double current_d_velocity,
     const double current_s_position, const double current_s_velocity,
-    const std_msgs::msg::Header & origin_header, Spline2D & spline2d,
+    const std_msgs::msg::Header & origin_header, const Spline2D & spline2d,
     autoware_perception_msgs::msg::PredictedPath & path);
 
   void getLinearPredictedPath(
@@ -57,10 +75,14 @@ private:
     autoware_perception_msgs::msg::PredictedPath & predicted_path);
 
   void normalizeLikelihood(std::vector<autoware_perception_msgs::msg::PredictedPath> & paths);
+  void removeUnlikelyPaths(std::vector<autoware_perception_msgs::msg::PredictedPath> & paths);
 
 public:
   MapBasedPrediction(
-    double interpolating_resolution, double time_horizon, double sampling_delta_time);
+    double interpolating_resolution, double time_horizon, double sampling_delta_time,
+    double min_path_confidence);
+
+  void clearReferenceLanes();
 
   bool doPrediction(
     const DynamicObjectWithLanesArray & in_objects,
@@ -36,6 +36,7 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -69,6 +70,15 @@ struct ObjectData
   geometry_msgs::msg::PoseStamped pose;
 };
 
+// Motion of an object over the history, from the oldest pose of the object buffer within
+// history_time_length
+struct ObjectMotion
+{
+  geometry_msgs::msg::Pose prev_pose;
+  double delta_time;
+  double yaw_rate;
+};
+
 enum class Maneuver {
   LANE_FOLLOW,
   LEFT_LANE_CHANGE,
@@ -85,7 +95,6 @@ private:
   double prediction_sampling_delta_time_;
   double min_velocity_for_map_based_prediction_;
   double interpolating_resolution_;
-  double debug_accumulated_time_;
   double dist_threshold_for_searching_lanelet_;
   double delta_yaw_threshold_for_searching_lanelet_;
   double sigma_lateral_offset_;
@@ -96,6 +105,7 @@ private:
   double dist_ratio_threshold_to_right_bound_;
   double diff_dist_threshold_to_left_bound_;
   double diff_dist_threshold_to_right_bound_;
+  double min_path_confidence_;
 
   rclcpp::Subscription<autoware_perception_msgs::msg::DynamicObjectArray>::SharedPtr sub_objects_;
   rclcpp::Subscription<autoware_lanelet2_msgs::msg::MapBin>::SharedPtr sub_map_;
@@ -112,13 +122,17 @@ private:
   std::shared_ptr<lanelet::traffic_rules::TrafficRules> traffic_rules_ptr_;
   std::shared_ptr<MapBasedPrediction> map_based_prediction_;
 
+  // centerline points of the lanelets, shared by the objects on the same lanes
+  std::mutex centerline_poses_mutex_;
+  std::unordered_map<lanelet::Id, std::vector<geometry_msgs::msg::Pose>> centerline_poses_;
+
   bool getSelfPose(geometry_msgs::msg::Pose & self_pose, const std_msgs::msg::Header & header);
   bool getSelfPoseInMap(geometry_msgs::msg::Pose & self_pose);
 
   double getObjectYaw(const autoware_perception_msgs::msg::DynamicObject & object);
   double calculateLikelihood(
     const std::vector<geometry_msgs::msg::Pose> & path,
-    const autoware_perception_msgs::msg::DynamicObject & object);
+    const autoware_perception_msgs::msg::DynamicObject & object, const ObjectMotion * motion);
 
   void addValidPath(
     const lanelet::routing::LaneletPaths & candidate_paths,
@@ -137,11 +151,18 @@ private:
     const autoware_perception_msgs::msg::DynamicObject & object,
     const lanelet::BasicPoint2d & search_point);
 
+  const std::vector<geometry_msgs::msg::Pose> & getCenterlinePoses(
+    const lanelet::ConstLanelet & lanelet);
+
   void removeInvalidObject(const double current_time);
+  bool getObjectMotion(
+    const autoware_perception_msgs::msg::DynamicObject & object, const double current_time,
+    ObjectMotion & motion);
+  bool isVehicle(const autoware_perception_msgs::msg::DynamicObject & object);
   bool updateObjectBuffer(
     const std_msgs::msg::Header & header,
     const autoware_perception_msgs::msg::DynamicObject & object,
-    lanelet::ConstLanelets & current_lanelets);
+    const lanelet::ConstLanelets & current_lanelets);
   void updatePossibleLanelets(
     const std::string object_id, const lanelet::routing::LaneletPaths & paths);
 
@@ -20,13 +20,42 @@
 
 #include <algorithm>
 #include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
+struct ReferenceLane
+{
+  explicit ReferenceLane(const Spline2D & spline2d) : spline2d(spline2d) {}
+
+  Spline2D spline2d;
+  // points of the spline every interpolating_resolution
+  std::vector<geometry_msgs::msg::Point> interpolated_points;
+};
+
+namespace
+{
+// number of lanes above which the cache is emptied, so that it does not grow with the map
+constexpr size_t MAX_REFERENCE_LANES = 10000;
+
+std::string toLaneKey(const std::vector<int64_t> & lane_ids)
+{
+  std::string key;
+  for (const auto id : lane_ids) {
+    key += std::to_string(id) + ",";
+  }
+  return key;
+}
+}  // namespace
+
 MapBasedPrediction::MapBasedPrediction(
-  double interpolating_resolution, double time_horizon, double sampling_delta_time)
+  double interpolating_resolution, double time_horizon, double sampling_delta_time,
+  double min_path_confidence)
 : interpolating_resolution_(interpolating_resolution),
   time_horizon_(time_horizon),
-  sampling_delta_time_(sampling_delta_time)
+  sampling_delta_time_(sampling_delta_time),
+  min_path_confidence_(min_path_confidence)
 {
 }
 
@@ -34,36 +63,24 @@ bool MapBasedPrediction::doPrediction(
   const DynamicObjectWithLanesArray & in_objects,
   std::vector<autoware_perception_msgs::msg::DynamicObject> & out_objects)
 {
-  for (auto & object_with_lanes : in_objects.objects) {
-    autoware_perception_msgs::msg::DynamicObject tmp_object;
+  // the objects are independent, each one fills its own output
+  const size_t output_offset = out_objects.size();
+  out_objects.resize(output_offset + in_objects.objects.size());
+#pragma omp parallel for schedule(dynamic)
+  for (size_t object_idx = 0; object_idx < in_objects.objects.size(); ++object_idx) {
+    const auto & object_with_lanes = in_objects.objects.at(object_idx);
+    autoware_perception_msgs::msg::DynamicObject & tmp_object =
+      out_objects.at(output_offset + object_idx);
     tmp_object = object_with_lanes.object;
     for (size_t path_id = 0; path_id < object_with_lanes.lanes.size(); ++path_id) {
-      std::vector<double> tmp_x;
-      std::vector<double> tmp_y;
-      std::vector<geometry_msgs::msg::Pose> path = object_with_lanes.lanes.at(path_id);
-      for (size_t i = 0; i < path.size(); i++) {
-        if (i > 0) {
-          double dist = autoware_utils::calcDistance2d(path.at(i), path.at(i - 1));
-          if (dist < interpolating_resolution_) {
-            continue;
-          }
-        }
-        tmp_x.push_back(path.at(i).position.x);
-        tmp_y.push_back(path.at(i).position.y);
-      }
-
-      // Generate Splined Trajectory Arc-Length Position and Yaw angle
-      Spline2D spline2d(tmp_x, tmp_y);
-      std::vector<geometry_msgs::msg::Point> interpolated_points;
-      std::vector<double> interpolated_yaws;
-      for (double s = 0.0; s < spline2d.s.back(); s += interpolating_resolution_) {
-        std::array<double, 2> point1 = spline2d.calc_position(s);
-        geometry_msgs::msg::Point g_point;
-        g_point.x = point1[0];
-        g_point.y = point1[1];
-        g_point.z = object_with_lanes.object.state.pose_covariance.pose.position.z;
-        interpolated_points.push_back(g_point);
-        interpolated_yaws.push_back(spline2d.calc_yaw(s));
+      const std::vector<int64_t> lane_ids = path_id < object_with_lanes.lane_ids.size()
+                                              ? object_with_lanes.lane_ids.at(path_id)
+                                              : std::vector<int64_t>{};
+      const auto reference_lane = getReferenceLane(object_with_lanes.lanes.at(path_id), lane_ids);
+      const Spline2D & spline2d = reference_lane->spline2d;
+      const auto & interpolated_points = reference_lane->interpolated_points;
+      if (interpolated_points.size() < 2) {
+        continue;
       }
 
       // calculate initial position in Frenet coordinate
@@ -128,11 +145,69 @@ bool MapBasedPrediction::doPrediction(
       tmp_object.state.predicted_paths.push_back(predicted_path);
     }
     normalizeLikelihood(tmp_object.state.predicted_paths);
-    out_objects.push_back(tmp_object);
+    removeUnlikelyPaths(tmp_object.state.predicted_paths);
   }
   return true;
 }
 
+void MapBasedPrediction::clearReferenceLanes()
+{
+  std::lock_guard<std::mutex> lock(reference_lanes_mutex_);
+  reference_lanes_.clear();
+}
+
+std::shared_ptr<const ReferenceLane> MapBasedPrediction::getReferenceLane(
+  const std::vector<geometry_msgs::msg::Pose> & lane, const std::vector<int64_t> & lane_ids)
+{
+  if (lane_ids.empty()) {
+    return createReferenceLane(lane);
+  }
+
+  const std::string key = toLaneKey(lane_ids);
+  {
+    std::lock_guard<std::mutex> lock(reference_lanes_mutex_);
+    const auto itr = reference_lanes_.find(key);
+    if (itr != reference_lanes_.end()) {
+      return itr->second;
+    }
+  }
+
+  const auto reference_lane = createReferenceLane(lane);
+  std::lock_guard<std::mutex> lock(reference_lanes_mutex_);
+  if (MAX_REFERENCE_LANES <= reference_lanes_.size()) {
+    reference_lanes_.clear();
+  }
+  reference_lanes_.emplace(key, reference_lane);
+  return reference_lane;
+}
+
+std::shared_ptr<const ReferenceLane> MapBasedPrediction::createReferenceLane(
+  const std::vector<geometry_msgs::msg::Pose> & lane) const
+{
+  std::vector<double> tmp_x;
+  std::vector<double> tmp_y;
+  for (size_t i = 0; i < lane.size(); i++) {
+    if (i > 0) {
+      double dist = autoware_utils::calcDistance2d(lane.at(i), lane.at(i - 1));
+      if (dist < interpolating_resolution_) {
+        continue;
+      }
+    }
+    tmp_x.push_back(lane.at(i).position.x);
+    tmp_y.push_back(lane.at(i).position.y);
+  }
+
+  // Generate Splined Trajectory Arc-Length Position
+  auto reference_lane = std::make_shared<ReferenceLane>(Spline2D(tmp_x, tmp_y));
+  const Spline2D & spline2d = reference_lane->spline2d;
+  for (double s = 0.0; s < spline2d.s.back(); s += interpolating_resolution_) {
+    std::array<double, 2> point1 = spline2d.calc_position(s);
+    reference_lane->interpolated_points.push_back(
+      autoware_utils::createPoint(point1[0], point1[1], 0.0));
+  }
+  return reference_lane;
+}
+
 bool MapBasedPrediction::doLinearPrediction(
   const autoware_perception_msgs::msg::DynamicObjectArray & in_objects,
   std::vector<autoware_perception_msgs::msg::DynamicObject> & out_objects)
@@ -165,10 +240,33 @@ void MapBasedPrediction::normalizeLikelihood(
   }
 }
 
+void MapBasedPrediction::removeUnlikelyPaths(
+  std::vector<autoware_perception_msgs::msg::PredictedPath> & paths)
+{
+  if (paths.size() <= 1) {
+    return;
+  }
+
+  // The most likely path is kept even if it is below the threshold
+  const auto max_itr = std::max_element(
+    paths.begin(), paths.end(),
+    [](const auto & a, const auto & b) { return a.confidence < b.confidence; });
+  const double threshold = std::min(min_path_confidence_, max_itr->confidence);
+
+  const auto remove_itr = std::remove_if(paths.begin(), paths.end(), [threshold](const auto & p) {
+    return p.confidence < threshold;
+  });
+  if (remove_itr == paths.end()) {
+    return;
+  }
+  paths.erase(remove_itr, paths.end());
+  normalizeLikelihood(paths);
+}
+
 bool MapBasedPrediction::getPredictedPath(
   const double height, const double current_d_position, const double current_d_velocity,
   const double current_s_position, const double current_s_velocity,
-  const std_msgs::msg::Header & origin_header, Spline2D & spline2d,
+  const std_msgs::msg::Header & origin_header, const Spline2D & spline2d,
   autoware_perception_msgs::msg::PredictedPath & path)
 {
   // Quintic polynomial for d
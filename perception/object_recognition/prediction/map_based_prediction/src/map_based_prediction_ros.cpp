@@ -32,6 +32,7 @@
 #include <deque>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -48,8 +49,7 @@ std::string toHexString(const unique_identifier_msgs::msg::UUID & id)
 
 MapBasedPredictionROS::MapBasedPredictionROS(const rclcpp::NodeOptions & node_options)
 : Node("map_based_prediction", node_options),
-  interpolating_resolution_(0.5),
-  debug_accumulated_time_(0.0)
+  interpolating_resolution_(0.5)
 {
   auto ret =
     rcutils_logging_set_logger_level(this->get_logger().get_name(), RCUTILS_LOG_SEVERITY_DEBUG);
@@ -77,9 +77,11 @@ MapBasedPredictionROS::MapBasedPredictionROS(const rclcpp::NodeOptions & node_op
   diff_dist_threshold_to_left_bound_ = declare_parameter("diff_dist_threshold_to_left_bound", 0.29);
   diff_dist_threshold_to_right_bound_ =
     declare_parameter("diff_dist_threshold_to_right_bound", -0.29);
+  min_path_confidence_ = declare_parameter("min_path_confidence", 0.1);
 
   map_based_prediction_ = std::make_shared<MapBasedPrediction>(
-    interpolating_resolution_, prediction_time_horizon_, prediction_sampling_delta_time_);
+    interpolating_resolution_, prediction_time_horizon_, prediction_sampling_delta_time_,
+    min_path_confidence_);
 
   sub_objects_ = this->create_subscription<autoware_perception_msgs::msg::DynamicObjectArray>(
     "/perception/object_recognition/tracking/objects", 1,
@@ -120,7 +122,7 @@ double MapBasedPredictionROS::getObjectYaw(
 
 double MapBasedPredictionROS::calculateLikelihood(
   const std::vector<geometry_msgs::msg::Pose> & path,
-  const autoware_perception_msgs::msg::DynamicObject & object)
+  const autoware_perception_msgs::msg::DynamicObject & object, const ObjectMotion * motion)
 {
   // We compute the confidence value based on the object current position and angle
   // Calculate path length
@@ -153,9 +155,44 @@ double MapBasedPredictionROS::calculateLikelihood(
   delta << abs_d, abs_norm_delta_yaw;
   Eigen::Matrix2d P_inv;
   P_inv << 1.0 / (sigma_d * sigma_d), 0.0, 0.0, 1.0 / (sigma_yaw * sigma_yaw);
+  double dist = delta.dot(P_inv * delta);
+
+  // Add the same distance for the state predicted from the motion history, as far ahead as the
+  // history looks back, so that the paths the object is drifting or turning away from get a
+  // lower confidence
+  if (motion) {
+    const auto & current_position = object.state.pose_covariance.pose.position;
+    const double current_d = autoware_utils::calcLateralOffset(path, current_position);
+    const double prev_d = autoware_utils::calcLateralOffset(path, motion->prev_pose.position);
+    const double lateral_velocity = (current_d - prev_d) / motion->delta_time;
+    const double future_d = current_d + lateral_velocity * motion->delta_time;
+    const double future_object_yaw = object_yaw + motion->yaw_rate * motion->delta_time;
+
+    // Lane angle at the future longitudinal position
+    const double future_s_position =
+      current_s_position +
+      std::fabs(object.state.twist_covariance.twist.linear.x) * motion->delta_time;
+    size_t future_segment_idx = nearest_segment_idx;
+    double segment_start_s = current_s_position - l;
+    while (future_segment_idx + 2 < path.size()) {
+      const double segment_length = autoware_utils::calcDistance2d(
+        path.at(future_segment_idx), path.at(future_segment_idx + 1));
+      if (future_s_position < segment_start_s + segment_length) {
+        break;
+      }
+      segment_start_s += segment_length;
+      ++future_segment_idx;
+    }
+    const double future_lane_yaw = tf2::getYaw(path.at(future_segment_idx).orientation);
+
+    Eigen::Vector2d future_delta;
+    future_delta << future_d,
+      autoware_utils::normalizeRadian(future_object_yaw - future_lane_yaw);
+    dist += future_delta.dot(P_inv * future_delta);
+  }
+
   const double MINIMUM_DISTANCE = 1e-6;
-  const double dist = std::max(delta.dot(P_inv * delta), MINIMUM_DISTANCE);
-  return 1.0 / dist;
+  return 1.0 / std::max(dist, MINIMUM_DISTANCE);
 }
 
 bool MapBasedPredictionROS::checkCloseLaneletCondition(
@@ -211,8 +248,6 @@ bool MapBasedPredictionROS::getClosestLanelets(
   const autoware_perception_msgs::msg::DynamicObject & object,
   const lanelet::LaneletMapPtr & lanelet_map_ptr_, lanelet::ConstLanelets & closest_lanelets)
 {
-  std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
-
   // obstacle point
   lanelet::BasicPoint2d search_point(
     object.state.pose_covariance.pose.position.x, object.state.pose_covariance.pose.position.y);
@@ -221,10 +256,6 @@ bool MapBasedPredictionROS::getClosestLanelets(
   std::vector<std::pair<double, lanelet::Lanelet>> surrounding_lanelets =
     lanelet::geometry::findNearest(lanelet_map_ptr_->laneletLayer, search_point, 10);
 
-  std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
-  std::chrono::nanoseconds time = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin);
-  debug_accumulated_time_ += time.count() / (1000.0 * 1000.0);
-
   // No Closest Lanelets
   if (surrounding_lanelets.empty()) {
     return false;
@@ -277,7 +308,7 @@ void MapBasedPredictionROS::removeInvalidObject(const double current_time)
     const double latest_object_time = rclcpp::Time(object_data.back().pose.header.stamp).seconds();
 
     // Delete Old Objects
-    if (current_time - latest_object_time > 2.0) {
+    if (current_time - latest_object_time > object_buffer_time_length_) {
       invalid_object_id.push_back(object_id);
       continue;
     }
@@ -285,7 +316,7 @@ void MapBasedPredictionROS::removeInvalidObject(const double current_time)
     // Delete old information
     while (!object_data.empty()) {
       const double post_object_time = rclcpp::Time(object_data.front().pose.header.stamp).seconds();
-      if (current_time - post_object_time > 2.0) {
+      if (current_time - post_object_time > object_buffer_time_length_) {
         // Delete Old Position
         object_data.pop_front();
       } else {
@@ -304,27 +335,54 @@ void MapBasedPredictionROS::removeInvalidObject(const double current_time)
   }
 }
 
-bool MapBasedPredictionROS::updateObjectBuffer(
-  const std_msgs::msg::Header & header, const autoware_perception_msgs::msg::DynamicObject & object,
-  lanelet::ConstLanelets & current_lanelets)
+bool MapBasedPredictionROS::getObjectMotion(
+  const autoware_perception_msgs::msg::DynamicObject & object, const double current_time,
+  ObjectMotion & motion)
 {
-  // Ignore non-vehicle object
-  if (
-    object.semantic.type != autoware_perception_msgs::msg::Semantic::CAR &&
-    object.semantic.type != autoware_perception_msgs::msg::Semantic::BUS &&
-    object.semantic.type != autoware_perception_msgs::msg::Semantic::TRUCK) {
+  const std::string object_id = toHexString(object.id);
+  const auto itr = object_buffer_.find(object_id);
+  if (itr == object_buffer_.end()) {
     return false;
   }
 
-  // Get the current Lanelet
-  std::string object_id = toHexString(object.id);
+  // The oldest pose within the history, the buffer being sorted by time
+  const std::deque<ObjectData> & object_info = itr->second;
+  const auto prev_itr = std::find_if(
+    object_info.begin(), object_info.end(), [this, current_time](const ObjectData & data) {
+      return current_time - rclcpp::Time(data.pose.header.stamp).seconds() <= history_time_length_;
+    });
+  if (prev_itr == object_info.end()) {
+    return false;
+  }
 
-  // Check whether the object is on the road
-  if (!getClosestLanelets(object, lanelet_map_ptr_, current_lanelets)) {
-    // This Object is not on the road
+  // A short history gives a noisy motion
+  const double MIN_HISTORY_TIME = 0.1;
+  const double delta_time = current_time - rclcpp::Time(prev_itr->pose.header.stamp).seconds();
+  if (delta_time < MIN_HISTORY_TIME) {
     return false;
   }
 
+  const double current_yaw = getObjectYaw(object);
+  const double prev_yaw = tf2::getYaw(prev_itr->pose.pose.orientation);
+  motion.prev_pose = prev_itr->pose.pose;
+  motion.delta_time = delta_time;
+  motion.yaw_rate = autoware_utils::normalizeRadian(current_yaw - prev_yaw) / delta_time;
+  return true;
+}
+
+bool MapBasedPredictionROS::isVehicle(const autoware_perception_msgs::msg::DynamicObject & object)
+{
+  return object.semantic.type == autoware_perception_msgs::msg::Semantic::CAR ||
+         object.semantic.type == autoware_perception_msgs::msg::Semantic::BUS ||
+         object.semantic.type == autoware_perception_msgs::msg::Semantic::TRUCK;
+}
+
+bool MapBasedPredictionROS::updateObjectBuffer(
+  const std_msgs::msg::Header & header, const autoware_perception_msgs::msg::DynamicObject & object,
+  const lanelet::ConstLanelets & current_lanelets)
+{
+  std::string object_id = toHexString(object.id);
+
   // Get current Pose
   geometry_msgs::msg::PoseStamped current_object_pose;
   current_object_pose.header = header;
@@ -439,7 +497,7 @@ Maneuver MapBasedPredictionROS::detectLaneChange(
   }
 
   // Object History Data
-  const std::deque<ObjectData> object_info = object_buffer_.at(object_id);
+  const std::deque<ObjectData> & object_info = object_buffer_.at(object_id);
 
   // Step2. Get the previous id
   int prev_id = static_cast<int>(object_info.size()) - 1;
@@ -527,6 +585,31 @@ Maneuver MapBasedPredictionROS::detectLaneChange(
   return Maneuver::LANE_FOLLOW;
 }
 
+const std::vector<geometry_msgs::msg::Pose> & MapBasedPredictionROS::getCenterlinePoses(
+  const lanelet::ConstLanelet & lanelet)
+{
+  {
+    std::lock_guard<std::mutex> lock(centerline_poses_mutex_);
+    const auto itr = centerline_poses_.find(lanelet.id());
+    if (itr != centerline_poses_.end()) {
+      return itr->second;
+    }
+  }
+
+  std::vector<geometry_msgs::msg::Pose> poses;
+  for (const auto & point : lanelet.centerline()) {
+    geometry_msgs::msg::Pose pose;
+    pose.position.x = point.x();
+    pose.position.y = point.y();
+    pose.position.z = point.z();
+    poses.push_back(pose);
+  }
+
+  // the elements of an unordered_map keep their address when it grows
+  std::lock_guard<std::mutex> lock(centerline_poses_mutex_);
+  return centerline_poses_.emplace(lanelet.id(), std::move(poses)).first->second;
+}
+
 void MapBasedPredictionROS::objectsCallback(
   const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr in_objects)
 {
@@ -571,10 +654,19 @@ void MapBasedPredictionROS::objectsCallback(
   objects_without_map.header = in_objects->header;
   DynamicObjectWithLanesArray prediction_input;
   prediction_input.header = in_objects->header;
-
-  for (const auto & object : in_objects->objects) {
-    std::string object_id = toHexString(object.id);
-    DynamicObjectWithLanes transformed_object;
+  std_msgs::msg::Header transformed_header = in_objects->header;
+  transformed_header.frame_id = "map";
+
+  // The objects only read the object buffer and the map while they are processed in
+  // parallel, the buffer is updated in between in the order of the objects.
+  const int num_objects = static_cast<int>(in_objects->objects.size());
+  std::vector<DynamicObjectWithLanes> transformed_objects(num_objects);
+  std::vector<lanelet::ConstLanelets> start_lanelets(num_objects);
+  std::vector<char> is_on_road(num_objects, false);
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < num_objects; ++i) {
+    const auto & object = in_objects->objects.at(i);
+    DynamicObjectWithLanes & transformed_object = transformed_objects.at(i);
     transformed_object.object = object;
     if (in_objects->header.frame_id != "map") {
       geometry_msgs::msg::PoseStamped pose_in_map;
@@ -584,19 +676,39 @@ void MapBasedPredictionROS::objectsCallback(
       transformed_object.object.state.pose_covariance.pose = pose_in_map.pose;
     }
 
-    std_msgs::msg::Header transformed_header = in_objects->header;
-    transformed_header.frame_id = "map";
-    lanelet::ConstLanelets start_lanelets;  // current lanelet
-    if (!updateObjectBuffer(transformed_header, transformed_object.object, start_lanelets)) {
-      objects_without_map.objects.push_back(transformed_object.object);
+    // Ignore non-vehicle object, and check whether the object is on the road
+    if (isVehicle(transformed_object.object)) {
+      is_on_road.at(i) =
+        getClosestLanelets(transformed_object.object, lanelet_map_ptr_, start_lanelets.at(i));
+    }
+  }
+
+  std::vector<int> map_based_indices;
+  for (int i = 0; i < num_objects; ++i) {
+    if (!is_on_road.at(i)) {
       continue;
     }
+    const auto & object = transformed_objects.at(i).object;
+    if (updateObjectBuffer(transformed_header, object, start_lanelets.at(i))) {
+      map_based_indices.push_back(i);
+    }
+  }
+
+  std::vector<lanelet::routing::LaneletPaths> lanelet_paths(num_objects);
+#pragma omp parallel for schedule(dynamic)
+  for (size_t k = 0; k < map_based_indices.size(); ++k) {
+    const int i = map_based_indices.at(k);
+    const auto & object = in_objects->objects.at(i);
+    DynamicObjectWithLanes & transformed_object = transformed_objects.at(i);
 
     // Obtain valid Paths
     const double delta_horizon = 1.0;
     const double obj_vel = object.state.twist_covariance.twist.linear.x;
-    lanelet::routing::LaneletPaths paths;
-    for (const auto & start_lanelet : start_lanelets) {
+    lanelet::routing::LaneletPaths & paths = lanelet_paths.at(i);
+    ObjectMotion motion;
+    const bool has_motion =
+      getObjectMotion(transformed_object.object, objects_detected_time, motion);
+    for (const auto & start_lanelet : start_lanelets.at(i)) {
       // Step1. Lane Change Detection
       // First: Right to Left Detection Result
       // Second: Left to Right Detection Result
@@ -645,45 +757,29 @@ void MapBasedPredictionROS::objectsCallback(
       }
     }
 
-    // If there is no valid path, we'll mark this object as map-less object
-    if (paths.empty()) {
-      objects_without_map.objects.push_back(transformed_object.object);
-      continue;
-    }
-
-    // Update Possible lanelet in the object buffer
-    updatePossibleLanelets(object_id, paths);
-
     std::vector<std::vector<geometry_msgs::msg::Pose>> tmp_paths;
+    std::vector<std::vector<int64_t>> tmp_paths_ids;
     std::vector<double> tmp_confidence;
     for (const auto & path : paths) {
       std::vector<geometry_msgs::msg::Pose> tmp_path;
+      std::vector<int64_t> tmp_path_ids;
 
       // Insert Positions. Note that we insert points from previous lanelet
       if (!path.empty()) {
         lanelet::ConstLanelets prev_lanelets = routing_graph_ptr_->previous(path.front());
         if (!prev_lanelets.empty()) {
-          lanelet::ConstLanelet prev_lanelet = prev_lanelets.front();
-          for (const auto & point : prev_lanelet.centerline()) {
-            geometry_msgs::msg::Pose tmp_pose;
-            tmp_pose.position.x = point.x();
-            tmp_pose.position.y = point.y();
-            tmp_pose.position.z = point.z();
-            tmp_path.push_back(tmp_pose);
-          }
+          tmp_path_ids.push_back(prev_lanelets.front().id());
+          const auto & prev_poses = getCenterlinePoses(prev_lanelets.front());
+          tmp_path.insert(tmp_path.end(), prev_poses.begin(), prev_poses.end());
         }
       }
 
       for (const auto & lanelet : path) {
-        for (const auto & point : lanelet.centerline()) {
-          geometry_msgs::msg::Pose tmp_pose;
-          tmp_pose.position.x = point.x();
-          tmp_pose.position.y = point.y();
-          tmp_pose.position.z = point.z();
-
+        tmp_path_ids.push_back(lanelet.id());
+        for (const auto & tmp_pose : getCenterlinePoses(lanelet)) {
           // Prevent from inserting same points
           if (!tmp_path.empty()) {
-            const auto prev_pose = tmp_path.back();
+            const auto & prev_pose = tmp_path.back();
             const double tmp_dist = autoware_utils::calcDistance2d(prev_pose, tmp_pose);
             if (tmp_dist < 1e-6) {
               continue;
@@ -712,19 +808,40 @@ void MapBasedPredictionROS::objectsCallback(
       //////////////////////////////////////////////////////////////////////
       // Calculate Confidence of each path(centerline) for this obstacle //
       ////////////////////////////////////////////////////////////////////
-      const double confidence = calculateLikelihood(tmp_path, transformed_object.object);
+      const double confidence = calculateLikelihood(
+        tmp_path, transformed_object.object, has_motion ? &motion : nullptr);
       // Ignore a path that has too low confidence
       if (confidence < 1e-6) {
         continue;
       }
 
       tmp_paths.push_back(tmp_path);
+      tmp_paths_ids.push_back(tmp_path_ids);
       tmp_confidence.push_back(confidence);
     }
 
     transformed_object.lanes = tmp_paths;
+    transformed_object.lane_ids = tmp_paths_ids;
     transformed_object.confidence = tmp_confidence;
-    prediction_input.objects.push_back(transformed_object);
+  }
+
+  std::vector<char> is_map_based(num_objects, false);
+  for (const int i : map_based_indices) {
+    // If there is no valid path, we'll mark this object as map-less object
+    if (lanelet_paths.at(i).empty()) {
+      continue;
+    }
+    is_map_based.at(i) = true;
+
+    // Update Possible lanelet in the object buffer
+    updatePossibleLanelets(toHexString(in_objects->objects.at(i).id), lanelet_paths.at(i));
+  }
+  for (int i = 0; i < num_objects; ++i) {
+    if (is_map_based.at(i)) {
+      prediction_input.objects.push_back(std::move(transformed_objects.at(i)));
+    } else {
+      objects_without_map.objects.push_back(transformed_objects.at(i).object);
+    }
   }
 
   std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
@@ -751,6 +868,15 @@ void MapBasedPredictionROS::mapCallback(
   lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
   lanelet::utils::conversion::fromBinMsg(
     *msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
+  // the centerlines are computed lazily by lanelet2, which is not safe from several threads
+  for (const auto & lanelet : lanelet_map_ptr_->laneletLayer) {
+    lanelet.centerline();
+  }
+  {
+    std::lock_guard<std::mutex> lock(centerline_poses_mutex_);
+    centerline_poses_.clear();
+  }
+  map_based_prediction_->clearReferenceLanes();
   RCLCPP_INFO(get_logger(), "Map is loaded");
 }
 
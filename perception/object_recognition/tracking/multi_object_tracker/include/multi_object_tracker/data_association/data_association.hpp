@@ -19,7 +19,6 @@
 #ifndef MULTI_OBJECT_TRACKER__DATA_ASSOCIATION__DATA_ASSOCIATION_HPP_
 #define MULTI_OBJECT_TRACKER__DATA_ASSOCIATION__DATA_ASSOCIATION_HPP_
 
-#include <list>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -27,6 +26,7 @@
 #define EIGEN_MPL2_ONLY
 #include "multi_object_tracker/data_association/solver/gnn_solver.hpp"
 #include "multi_object_tracker/tracker/tracker.hpp"
+#include "multi_object_tracker/utils/thread_pool.hpp"
 
 #include <Eigen/Core>
 #include <Eigen/Geometry>
@@ -42,20 +42,24 @@ private:
   Eigen::MatrixXd min_area_matrix_;
   Eigen::MatrixXd max_rad_matrix_;
   const double score_threshold_;
+  double max_gate_dist_;
   std::unique_ptr<gnn_solver::GnnSolverInterface> gnn_solver_ptr_;
+  // shared with the node, the rows of the score matrix are filled in parallel
+  std::shared_ptr<utils::ThreadPool> thread_pool_;
 
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
   DataAssociation(
     std::vector<int> can_assign_vector, std::vector<double> max_dist_vector,
     std::vector<double> max_area_vector, std::vector<double> min_area_vector,
-    std::vector<double> max_rad_vector);
+    std::vector<double> max_rad_vector, std::shared_ptr<utils::ThreadPool> thread_pool);
   void assign(
     const Eigen::MatrixXd & src, std::unordered_map<int, int> & direct_assignment,
     std::unordered_map<int, int> & reverse_assignment);
+  // only the pairs sharing a neighborhood of the largest distance gate are scored
   Eigen::MatrixXd calcScoreMatrix(
     const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & measurements,
-    const std::list<std::shared_ptr<Tracker>> & trackers);
+    const std::vector<std::shared_ptr<Tracker>> & trackers);
   virtual ~DataAssociation() {}
 };
 
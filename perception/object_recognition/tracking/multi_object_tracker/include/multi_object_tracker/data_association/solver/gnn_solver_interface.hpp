@@ -20,6 +20,13 @@
 
 namespace gnn_solver
 {
+struct ScoreEdge
+{
+  int row;
+  int col;
+  double score;
+};
+
 class GnnSolverInterface
 {
 public:
@@ -29,6 +36,14 @@ public:
   virtual void maximizeLinearAssignment(
     const std::vector<std::vector<double>> & cost, std::unordered_map<int, int> * direct_assignment,
     std::unordered_map<int, int> * reverse_assignment) = 0;
+
+  /** \brief Same assignment from the positive scores of a num_rows x num_cols matrix. The
+   * connected components of the edges are independent problems, solved in parallel as small
+   * dense matrices; the ones with a single row or column need no solver. */
+  void maximizeSparseLinearAssignment(
+    const int num_rows, const int num_cols, const std::vector<ScoreEdge> & edges,
+    std::unordered_map<int, int> * direct_assignment,
+    std::unordered_map<int, int> * reverse_assignment);
 };
 }  // namespace gnn_solver
 
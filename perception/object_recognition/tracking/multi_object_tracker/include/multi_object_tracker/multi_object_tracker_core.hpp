@@ -21,6 +21,7 @@
 
 #include "multi_object_tracker/data_association/data_association.hpp"
 #include "multi_object_tracker/tracker/model/tracker_base.hpp"
+#include "multi_object_tracker/utils/thread_pool.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -35,7 +36,6 @@
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
-#include <list>
 #include <memory>
 #include <string>
 #include <vector>
@@ -61,14 +61,18 @@ private:
   void onTimer();
 
   std::string world_frame_id_;  // tracking frame
-  std::list<std::shared_ptr<Tracker>> list_tracker_;
+  std::vector<std::shared_ptr<Tracker>> list_tracker_;
   std::unique_ptr<DataAssociation> data_association_;
+  // runs the loops over list_tracker_, which is indexed so that it splits into chunks
+  std::shared_ptr<utils::ThreadPool> thread_pool_;
+
+  void estimateTrackers(const rclcpp::Time & time);
 
   void checkTrackerLifeCycle(
-    std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time,
+    std::vector<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time,
     const geometry_msgs::msg::Transform & self_transform);
   void sanitizeTracker(
-    std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time);
+    std::vector<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time);
   std::shared_ptr<Tracker> createNewTracker(
     const autoware_perception_msgs::msg::DynamicObject & object, const rclcpp::Time & time) const;
 
@@ -32,6 +32,8 @@ class Tracker
 protected:
   unique_identifier_msgs::msg::UUID getUUID() const { return uuid_; }
   void setType(int type) { type_ = type; }
+  /** \brief To be called by predict, which changes the state behind the cached estimate. */
+  void clearEstimationCache() const { has_cached_object_ = false; }
 
 private:
   unique_identifier_msgs::msg::UUID uuid_;
@@ -41,6 +43,11 @@ private:
   int total_measurement_count_;
   rclcpp::Time last_update_with_measurement_time_;
 
+  // getEstimatedDynamicObject at cached_time_nanoseconds_
+  mutable bool has_cached_object_;
+  mutable int64_t cached_time_nanoseconds_;
+  mutable autoware_perception_msgs::msg::DynamicObject cached_object_;
+
 public:
   Tracker(const rclcpp::Time & time, const int type);
   virtual ~Tracker() {}
@@ -58,6 +65,10 @@ public:
   }
   virtual geometry_msgs::msg::PoseWithCovariance getPoseWithCovariance(
     const rclcpp::Time & time) const;
+  /** \brief getEstimatedDynamicObject, computed once per time until the next predict or
+   * measurement. */
+  const autoware_perception_msgs::msg::DynamicObject & getCachedEstimatedDynamicObject(
+    const rclcpp::Time & time) const;
 
   /*
    *　Pure virtual function
@@ -0,0 +1,80 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MULTI_OBJECT_TRACKER__UTILS__THREAD_POOL_HPP_
+#define MULTI_OBJECT_TRACKER__UTILS__THREAD_POOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils
+{
+/**
+ * @brief Workers started once with the node, which run the loops over the trackers of a frame in
+ * contiguous chunks together with the calling thread. Only one loop runs at a time.
+ */
+class ThreadPool
+{
+public:
+  /**
+   * @param num_threads number of threads of a loop including the calling thread, the hardware
+   * concurrency if 0
+   */
+  explicit ThreadPool(const size_t num_threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool & operator=(const ThreadPool &) = delete;
+
+  size_t getNumThreads() const { return workers_.size() + 1; }
+
+  /**
+   * @brief Run func(i) for i in [0, size) and wait for all of them. The chunks have at least
+   * min_chunk_size indices, so that a small loop runs on the calling thread only. The first
+   * exception thrown by func is rethrown.
+   */
+  void parallelFor(
+    const size_t size, const std::function<void(size_t)> & func, const size_t min_chunk_size = 32);
+
+private:
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable task_cv_;
+  std::condition_variable done_cv_;
+  bool is_stopped_ = false;
+  size_t generation_ = 0;
+  size_t num_active_workers_ = 0;
+
+  // loop being run, set while no worker is active
+  const std::function<void(size_t)> * func_ = nullptr;
+  size_t size_ = 0;
+  size_t chunk_size_ = 1;
+  size_t num_chunks_ = 0;
+  std::atomic<size_t> next_chunk_{0};
+  std::atomic<size_t> num_done_chunks_{0};
+  std::exception_ptr exception_;
+
+  void runWorker();
+  void runChunks();
+};
+}  // namespace utils
+
+#endif  // MULTI_OBJECT_TRACKER__UTILS__THREAD_POOL_HPP_
@@ -18,49 +18,19 @@
 #include "multi_object_tracker/utils/utils.hpp"
 
 #include <algorithm>
-#include <list>
+#include <cmath>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace
 {
-double getDistance(
-  const geometry_msgs::msg::Point & measurement, const geometry_msgs::msg::Point & tracker)
-{
-  const double diff_x = tracker.x - measurement.x;
-  const double diff_y = tracker.y - measurement.y;
-  // const double diff_z = tracker.z - measurement.z;
-  return std::sqrt(diff_x * diff_x + diff_y * diff_y);
-}
-
-double getMahalanobisDistance(
-  const geometry_msgs::msg::Point & measurement, const geometry_msgs::msg::Point & tracker,
-  const Eigen::Matrix2d & covariance)
-{
-  Eigen::Vector2d measurement_point;
-  measurement_point << measurement.x, measurement.y;
-  Eigen::Vector2d tracker_point;
-  tracker_point << tracker.x, tracker.y;
-  Eigen::MatrixXd mahalanobis_squared = (measurement_point - tracker_point).transpose() *
-                                        covariance.inverse() * (measurement_point - tracker_point);
-  return std::sqrt(mahalanobis_squared(0));
-}
-
-Eigen::Matrix2d getXYCovariance(const geometry_msgs::msg::PoseWithCovariance & pose_covariance)
-{
-  Eigen::Matrix2d covariance;
-  covariance << pose_covariance.covariance[0], pose_covariance.covariance[1],
-    pose_covariance.covariance[6], pose_covariance.covariance[7];
-  return covariance;
-}
-
 double getFormedYawAngle(
-  const geometry_msgs::msg::Quaternion & measurement_quat,
-  const geometry_msgs::msg::Quaternion & tracker_quat, const bool distinguish_front_or_back = true)
+  const double measurement_yaw, const double tracker_yaw,
+  const bool distinguish_front_or_back = true)
 {
-  const double measurement_yaw = autoware_utils::normalizeRadian(tf2::getYaw(measurement_quat));
-  const double tracker_yaw = autoware_utils::normalizeRadian(tf2::getYaw(tracker_quat));
   const double angle_range = distinguish_front_or_back ? M_PI : M_PI_2;
   const double angle_step = distinguish_front_or_back ? 2.0 * M_PI : M_PI;
   // Fixed measurement_yaw to be in the range of +-90 or 180 degrees of X_t(IDX::YAW)
@@ -73,13 +43,36 @@ double getFormedYawAngle(
   }
   return std::fabs(measurement_fixed_yaw - tracker_yaw);
 }
+
+/** \brief Poses of the trackers predicted to the measurement time, one array per value. */
+struct PredictedTrackerStates
+{
+  explicit PredictedTrackerStates(const size_t size)
+  : type(size), x(size), y(size), yaw(size), inv_cov_xx(size), inv_cov_xy(size), inv_cov_yy(size)
+  {
+  }
+
+  std::vector<int> type;
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> yaw;
+  // inverse of the xy position covariance
+  std::vector<double> inv_cov_xx;
+  std::vector<double> inv_cov_xy;
+  std::vector<double> inv_cov_yy;
+};
+
+uint64_t getCellKey(const int64_t cell_x, const int64_t cell_y)
+{
+  return (static_cast<uint64_t>(cell_x) << 32) ^ (static_cast<uint64_t>(cell_y) & 0xffffffff);
+}
 }  // namespace
 
 DataAssociation::DataAssociation(
   std::vector<int> can_assign_vector, std::vector<double> max_dist_vector,
   std::vector<double> max_area_vector, std::vector<double> min_area_vector,
-  std::vector<double> max_rad_vector)
-: score_threshold_(0.01)
+  std::vector<double> max_rad_vector, std::shared_ptr<utils::ThreadPool> thread_pool)
+: score_threshold_(0.01), thread_pool_(std::move(thread_pool))
 {
   {
     const int assign_label_num = static_cast<int>(std::sqrt(can_assign_vector.size()));
@@ -112,6 +105,16 @@ DataAssociation::DataAssociation(
     max_rad_matrix_ = max_rad_matrix_tmp.transpose();
   }
 
+  // no pair farther apart than the largest max_dist can be assigned
+  max_gate_dist_ = 0.0;
+  for (int row = 0; row < max_dist_matrix_.rows(); ++row) {
+    for (int col = 0; col < max_dist_matrix_.cols(); ++col) {
+      if (can_assign_matrix_(row, col)) {
+        max_gate_dist_ = std::max(max_gate_dist_, max_dist_matrix_(row, col));
+      }
+    }
+  }
+
   gnn_solver_ptr_ = std::make_unique<gnn_solver::MuSSP>();
 }
 
@@ -119,15 +122,18 @@ void DataAssociation::assign(
   const Eigen::MatrixXd & src, std::unordered_map<int, int> & direct_assignment,
   std::unordered_map<int, int> & reverse_assignment)
 {
-  std::vector<std::vector<double>> score(src.rows());
-  for (int row = 0; row < src.rows(); ++row) {
-    score.at(row).resize(src.cols());
-    for (int col = 0; col < src.cols(); ++col) {
-      score.at(row).at(col) = src(row, col);
+  // the gated pairs have a zero score and are left out of the problem
+  std::vector<gnn_solver::ScoreEdge> edges;
+  for (int col = 0; col < src.cols(); ++col) {
+    for (int row = 0; row < src.rows(); ++row) {
+      if (0.0 < src(row, col)) {
+        edges.push_back({row, col, src(row, col)});
+      }
     }
   }
   // Solve
-  gnn_solver_ptr_->maximizeLinearAssignment(score, &direct_assignment, &reverse_assignment);
+  gnn_solver_ptr_->maximizeSparseLinearAssignment(
+    src.rows(), src.cols(), edges, &direct_assignment, &reverse_assignment);
 
   for (auto itr = direct_assignment.begin(); itr != direct_assignment.end();) {
     if (src(itr->first, itr->second) < score_threshold_) {
@@ -149,64 +155,118 @@ void DataAssociation::assign(
 
 Eigen::MatrixXd DataAssociation::calcScoreMatrix(
   const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray & measurements,
-  const std::list<std::shared_ptr<Tracker>> & trackers)
+  const std::vector<std::shared_ptr<Tracker>> & trackers)
 {
   Eigen::MatrixXd score_matrix =
     Eigen::MatrixXd::Zero(trackers.size(), measurements.feature_objects.size());
-  size_t tracker_idx = 0;
-  for (auto tracker_itr = trackers.begin(); tracker_itr != trackers.end();
-       ++tracker_itr, ++tracker_idx) {
-    for (size_t measurement_idx = 0; measurement_idx < measurements.feature_objects.size();
-         ++measurement_idx) {
-      double score = 0.0;
-      const geometry_msgs::msg::PoseWithCovariance tracker_pose_covariance =
-        (*tracker_itr)->getPoseWithCovariance(measurements.header.stamp);
-      const autoware_perception_msgs::msg::DynamicObject & measurement_object =
-        measurements.feature_objects.at(measurement_idx).object;
-      if (can_assign_matrix_((*tracker_itr)->getType(), measurement_object.semantic.type)) {
-        const double max_dist =
-          max_dist_matrix_((*tracker_itr)->getType(), measurement_object.semantic.type);
-        const double max_area =
-          max_area_matrix_((*tracker_itr)->getType(), measurement_object.semantic.type);
-        const double min_area =
-          min_area_matrix_((*tracker_itr)->getType(), measurement_object.semantic.type);
-        const double max_rad =
-          max_rad_matrix_((*tracker_itr)->getType(), measurement_object.semantic.type);
-        const double dist = getDistance(
-          measurement_object.state.pose_covariance.pose.position,
-          tracker_pose_covariance.pose.position);
-        const double area = utils::getArea(measurement_object.shape);
-        score = (max_dist - std::min(dist, max_dist)) / max_dist;
-
-        // dist gate
-        if (max_dist < dist) {
-          score = 0.0;
-          // area gate
-        } else if (area < min_area || max_area < area) {
-          score = 0.0;
-          // angle gate
-        } else if (std::fabs(max_rad) < M_PI) {
-          const double angle = getFormedYawAngle(
-            measurement_object.state.pose_covariance.pose.orientation,
-            tracker_pose_covariance.pose.orientation, false);
-          if (std::fabs(max_rad) < std::fabs(angle)) {
-            score = 0.0;
+  if (trackers.empty() || measurements.feature_objects.empty() || max_gate_dist_ <= 0.0) {
+    return score_matrix;
+  }
+
+  // predict every tracker once
+  PredictedTrackerStates trackers_state(trackers.size());
+  thread_pool_->parallelFor(trackers.size(), [&](const size_t tracker_idx) {
+    const auto & tracker = trackers.at(tracker_idx);
+    const geometry_msgs::msg::PoseWithCovariance tracker_pose_covariance =
+      tracker->getPoseWithCovariance(measurements.header.stamp);
+    const auto & covariance = tracker_pose_covariance.covariance;
+    // mahalanobis distance uses the symmetric part of the covariance
+    const double cov_xy = 0.5 * (covariance[1] + covariance[6]);
+    const double det = covariance[0] * covariance[7] - cov_xy * cov_xy;
+    trackers_state.type[tracker_idx] = tracker->getType();
+    trackers_state.x[tracker_idx] = tracker_pose_covariance.pose.position.x;
+    trackers_state.y[tracker_idx] = tracker_pose_covariance.pose.position.y;
+    trackers_state.yaw[tracker_idx] =
+      autoware_utils::normalizeRadian(tf2::getYaw(tracker_pose_covariance.pose.orientation));
+    trackers_state.inv_cov_xx[tracker_idx] = covariance[7] / det;
+    trackers_state.inv_cov_xy[tracker_idx] = -cov_xy / det;
+    trackers_state.inv_cov_yy[tracker_idx] = covariance[0] / det;
+  });
+
+  // bucket the measurements in cells of the largest gate, so that only the measurements of the
+  // 3x3 cells around a tracker can pass its distance gate
+  const size_t num_measurements = measurements.feature_objects.size();
+  std::vector<double> measurements_area(num_measurements);
+  std::vector<double> measurements_yaw(num_measurements);
+  std::unordered_map<uint64_t, std::vector<size_t>> grid;
+  for (size_t measurement_idx = 0; measurement_idx < num_measurements; ++measurement_idx) {
+    const auto & object = measurements.feature_objects.at(measurement_idx).object;
+    const auto & position = object.state.pose_covariance.pose.position;
+    measurements_area[measurement_idx] = utils::getArea(object.shape);
+    measurements_yaw[measurement_idx] =
+      autoware_utils::normalizeRadian(tf2::getYaw(object.state.pose_covariance.pose.orientation));
+    if (!std::isfinite(position.x) || !std::isfinite(position.y)) {
+      continue;
+    }
+    const auto cell_x = static_cast<int64_t>(std::floor(position.x / max_gate_dist_));
+    const auto cell_y = static_cast<int64_t>(std::floor(position.y / max_gate_dist_));
+    grid[getCellKey(cell_x, cell_y)].push_back(measurement_idx);
+  }
+
+  // each tracker writes only its own row
+  thread_pool_->parallelFor(trackers.size(), [&](const size_t tracker_idx) {
+    const double tracker_x = trackers_state.x[tracker_idx];
+    const double tracker_y = trackers_state.y[tracker_idx];
+    if (!std::isfinite(tracker_x) || !std::isfinite(tracker_y)) {
+      return;
+    }
+    const int tracker_type = trackers_state.type[tracker_idx];
+    const auto cell_x = static_cast<int64_t>(std::floor(tracker_x / max_gate_dist_));
+    const auto cell_y = static_cast<int64_t>(std::floor(tracker_y / max_gate_dist_));
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        const auto cell_itr = grid.find(getCellKey(cell_x + dx, cell_y + dy));
+        if (cell_itr == grid.end()) {
+          continue;
+        }
+        for (const size_t measurement_idx : cell_itr->second) {
+          const autoware_perception_msgs::msg::DynamicObject & measurement_object =
+            measurements.feature_objects.at(measurement_idx).object;
+          const int measurement_type = measurement_object.semantic.type;
+          if (!can_assign_matrix_(tracker_type, measurement_type)) {
+            continue;
           }
-          // mahalanobis dist gate
-        } else if (score < score_threshold_) {
-          double mahalanobis_dist = getMahalanobisDistance(
-            measurements.feature_objects.at(measurement_idx)
-              .object.state.pose_covariance.pose.position,
-            tracker_pose_covariance.pose.position, getXYCovariance(tracker_pose_covariance));
-
-          if (2.448 /*95%*/ <= mahalanobis_dist) {
+          const double max_dist = max_dist_matrix_(tracker_type, measurement_type);
+          const double max_area = max_area_matrix_(tracker_type, measurement_type);
+          const double min_area = min_area_matrix_(tracker_type, measurement_type);
+          const double max_rad = max_rad_matrix_(tracker_type, measurement_type);
+          const auto & measurement_position =
+            measurement_object.state.pose_covariance.pose.position;
+          const double diff_x = measurement_position.x - tracker_x;
+          const double diff_y = measurement_position.y - tracker_y;
+          const double dist = std::sqrt(diff_x * diff_x + diff_y * diff_y);
+          const double area = measurements_area[measurement_idx];
+          double score = (max_dist - std::min(dist, max_dist)) / max_dist;
+
+          // dist gate
+          if (max_dist < dist) {
+            score = 0.0;
+            // area gate
+          } else if (area < min_area || max_area < area) {
             score = 0.0;
+            // angle gate
+          } else if (std::fabs(max_rad) < M_PI) {
+            const double angle = getFormedYawAngle(
+              measurements_yaw[measurement_idx], trackers_state.yaw[tracker_idx], false);
+            if (std::fabs(max_rad) < std::fabs(angle)) {
+              score = 0.0;
+            }
+            // mahalanobis dist gate
+          } else if (score < score_threshold_) {
+            const double mahalanobis_dist = std::sqrt(
+              diff_x * diff_x * trackers_state.inv_cov_xx[tracker_idx] +
+              2.0 * diff_x * diff_y * trackers_state.inv_cov_xy[tracker_idx] +
+              diff_y * diff_y * trackers_state.inv_cov_yy[tracker_idx]);
+
+            if (2.448 /*95%*/ <= mahalanobis_dist) {
+              score = 0.0;
+            }
           }
+          score_matrix(tracker_idx, measurement_idx) = score;
         }
       }
-      score_matrix(tracker_idx, measurement_idx) = score;
     }
-  }
+  });
 
   return score_matrix;
 }
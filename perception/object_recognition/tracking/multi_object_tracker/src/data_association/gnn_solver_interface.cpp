@@ -0,0 +1,149 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "multi_object_tracker/data_association/solver/gnn_solver_interface.hpp"
+
+#include <functional>
+#include <future>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// components smaller than this are faster to solve than to hand over to a thread
+constexpr size_t MIN_PARALLEL_COMPONENT_EDGES = 64;
+
+int findRoot(std::vector<int> & parents, int node)
+{
+  while (parents.at(node) != node) {
+    parents.at(node) = parents.at(parents.at(node));
+    node = parents.at(node);
+  }
+  return node;
+}
+
+struct Component
+{
+  std::vector<int> rows;
+  std::vector<int> cols;
+  std::vector<gnn_solver::ScoreEdge> edges;
+};
+
+using Assignment = std::vector<std::pair<int, int>>;
+
+// pairs (row, col) of the best edge, enough when the component has a single row or column
+Assignment solveStar(const Component & component)
+{
+  const gnn_solver::ScoreEdge * best_edge = &component.edges.front();
+  for (const auto & edge : component.edges) {
+    if (best_edge->score < edge.score) {
+      best_edge = &edge;
+    }
+  }
+  return {{best_edge->row, best_edge->col}};
+}
+
+Assignment solveDense(gnn_solver::GnnSolverInterface * solver, const Component & component)
+{
+  // rows and cols of the component are renumbered from 0
+  std::unordered_map<int, int> local_rows;
+  std::unordered_map<int, int> local_cols;
+  for (size_t i = 0; i < component.rows.size(); ++i) {
+    local_rows.emplace(component.rows.at(i), i);
+  }
+  for (size_t i = 0; i < component.cols.size(); ++i) {
+    local_cols.emplace(component.cols.at(i), i);
+  }
+  std::vector<std::vector<double>> score(
+    component.rows.size(), std::vector<double>(component.cols.size(), 0.0));
+  for (const auto & edge : component.edges) {
+    score.at(local_rows.at(edge.row)).at(local_cols.at(edge.col)) = edge.score;
+  }
+
+  std::unordered_map<int, int> direct_assignment;
+  std::unordered_map<int, int> reverse_assignment;
+  solver->maximizeLinearAssignment(score, &direct_assignment, &reverse_assignment);
+
+  Assignment assignment;
+  for (const auto & pair : direct_assignment) {
+    assignment.emplace_back(component.rows.at(pair.first), component.cols.at(pair.second));
+  }
+  return assignment;
+}
+}  // namespace
+
+namespace gnn_solver
+{
+void GnnSolverInterface::maximizeSparseLinearAssignment(
+  const int num_rows, const int num_cols, const std::vector<ScoreEdge> & edges,
+  std::unordered_map<int, int> * direct_assignment,
+  std::unordered_map<int, int> * reverse_assignment)
+{
+  // union-find over the rows [0, num_rows) followed by the cols
+  std::vector<int> parents(num_rows + num_cols);
+  std::iota(parents.begin(), parents.end(), 0);
+  for (const auto & edge : edges) {
+    const int row_root = findRoot(parents, edge.row);
+    const int col_root = findRoot(parents, num_rows + edge.col);
+    if (row_root != col_root) {
+      parents.at(row_root) = col_root;
+    }
+  }
+
+  std::unordered_map<int, Component> components;
+  for (const auto & edge : edges) {
+    components[findRoot(parents, edge.row)].edges.push_back(edge);
+  }
+  std::vector<bool> is_added(num_rows + num_cols, false);
+  for (auto & root_and_component : components) {
+    Component & component = root_and_component.second;
+    for (const auto & edge : component.edges) {
+      if (!is_added.at(edge.row)) {
+        is_added.at(edge.row) = true;
+        component.rows.push_back(edge.row);
+      }
+      if (!is_added.at(num_rows + edge.col)) {
+        is_added.at(num_rows + edge.col) = true;
+        component.cols.push_back(edge.col);
+      }
+    }
+  }
+
+  std::vector<Assignment> assignments;
+  std::vector<std::future<Assignment>> futures;
+  for (const auto & root_and_component : components) {
+    const Component & component = root_and_component.second;
+    if (component.rows.size() == 1 || component.cols.size() == 1) {
+      assignments.push_back(solveStar(component));
+    } else if (component.edges.size() < MIN_PARALLEL_COMPONENT_EDGES) {
+      assignments.push_back(solveDense(this, component));
+    } else {
+      futures.push_back(std::async(std::launch::async, solveDense, this, std::cref(component)));
+    }
+  }
+  for (auto & future : futures) {
+    assignments.push_back(future.get());
+  }
+
+  for (const auto & assignment : assignments) {
+    for (const auto & pair : assignment) {
+      direct_assignment->emplace(pair.first, pair.second);
+      reverse_assignment->emplace(pair.second, pair.first);
+    }
+  }
+}
+}  // namespace gnn_solver
@@ -19,8 +19,10 @@
 #include <tf2_ros/create_timer_interface.h>
 #include <tf2_ros/create_timer_ros.h>
 
-#include <iterator>
-#include <list>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -29,6 +31,7 @@
 
 #define EIGEN_MPL2_ONLY
 #include "multi_object_tracker/multi_object_tracker_core.hpp"
+#include "multi_object_tracker/utils/thread_pool.hpp"
 #include "multi_object_tracker/utils/utils.hpp"
 
 #include <Eigen/Core>
@@ -121,8 +124,7 @@ bool isSpecificAlivePattern(
   const std::shared_ptr<const Tracker> & tracker, const rclcpp::Time & time,
   const geometry_msgs::msg::Transform & self_transform)
 {
-  autoware_perception_msgs::msg::DynamicObject object;
-  tracker->getEstimatedDynamicObject(time, object);
+  const auto & object = tracker->getCachedEstimatedDynamicObject(time);
 
   constexpr float min_detection_rate = 0.2;
   constexpr int min_measurement_count = 5;
@@ -155,6 +157,10 @@ bool isSpecificAlivePattern(
   return is_specific_alive_pattern;
 }
 
+uint64_t getCellKey(const int64_t cell_x, const int64_t cell_y)
+{
+  return (static_cast<uint64_t>(cell_x) << 32) ^ (static_cast<uint64_t>(cell_y) & 0xffffffff);
+}
 }  // namespace
 
 MultiObjectTracker::MultiObjectTracker(const rclcpp::NodeOptions & node_options)
@@ -199,8 +205,24 @@ MultiObjectTracker::MultiObjectTracker(const rclcpp::NodeOptions & node_options)
   const auto min_area_matrix = this->declare_parameter<std::vector<double>>("min_area_matrix");
   const auto max_rad_matrix = this->declare_parameter<std::vector<double>>("max_rad_matrix");
 
+  const auto num_threads = declare_parameter<int64_t>("num_threads", 0);
+  thread_pool_ =
+    std::make_shared<utils::ThreadPool>(static_cast<size_t>(std::max<int64_t>(0, num_threads)));
+
   data_association_ = std::make_unique<DataAssociation>(
-    can_assign_matrix, max_dist_matrix, max_area_matrix, min_area_matrix, max_rad_matrix);
+    can_assign_matrix, max_dist_matrix, max_area_matrix, min_area_matrix, max_rad_matrix,
+    thread_pool_);
+}
+
+/**
+ * @brief Predict every tracker at time once, so that the association, the life cycle check, the
+ * sanitization and the publication of a frame share the cached estimates.
+ */
+void MultiObjectTracker::estimateTrackers(const rclcpp::Time & time)
+{
+  thread_pool_->parallelFor(list_tracker_.size(), [this, &time](const size_t i) {
+    list_tracker_.at(i)->getCachedEstimatedDynamicObject(time);
+  });
 }
 
 void MultiObjectTracker::onMeasurement(
@@ -221,9 +243,10 @@ void MultiObjectTracker::onMeasurement(
   }
   /* tracker prediction */
   rclcpp::Time measurement_time = input_objects_msg->header.stamp;
-  for (auto itr = list_tracker_.begin(); itr != list_tracker_.end(); ++itr) {
-    (*itr)->predict(measurement_time);
-  }
+  thread_pool_->parallelFor(list_tracker_.size(), [this, &measurement_time](const size_t i) {
+    list_tracker_.at(i)->predict(measurement_time);
+  });
+  estimateTrackers(measurement_time);
 
   /* global nearest neighbor */
   std::unordered_map<int, int> direct_assignment, reverse_assignment;
@@ -232,19 +255,19 @@ void MultiObjectTracker::onMeasurement(
   data_association_->assign(score_matrix, direct_assignment, reverse_assignment);
 
   /* tracker measurement update */
-  int tracker_idx = 0;
-  for (auto tracker_itr = list_tracker_.begin(); tracker_itr != list_tracker_.end();
-       ++tracker_itr, ++tracker_idx) {
-    if (direct_assignment.find(tracker_idx) != direct_assignment.end()) {  // found
-      (*(tracker_itr))
-        ->updateWithMeasurement(
-          transformed_objects.feature_objects.at(direct_assignment.find(tracker_idx)->second)
-            .object,
+  thread_pool_->parallelFor(
+    list_tracker_.size(),
+    [this, &direct_assignment, &transformed_objects, &measurement_time](const size_t i) {
+      const auto assignment_itr = direct_assignment.find(i);
+      if (assignment_itr != direct_assignment.end()) {  // found
+        list_tracker_.at(i)->updateWithMeasurement(
+          transformed_objects.feature_objects.at(assignment_itr->second).object,
           measurement_time);
-    } else {  // not found
-      (*(tracker_itr))->updateWithoutMeasurement();
-    }
-  }
+      } else {  // not found
+        list_tracker_.at(i)->updateWithoutMeasurement();
+      }
+    });
+  estimateTrackers(measurement_time);
 
   /* life cycle check */
   checkTrackerLifeCycle(list_tracker_, measurement_time, *self_transform);
@@ -288,6 +311,7 @@ void MultiObjectTracker::onTimer()
     return;
   }
 
+  estimateTrackers(current_time);
   /* life cycle check */
   checkTrackerLifeCycle(list_tracker_, current_time, *self_transform);
   /* sanitize trackers */
@@ -298,56 +322,102 @@ void MultiObjectTracker::onTimer()
 }
 
 void MultiObjectTracker::checkTrackerLifeCycle(
-  std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time,
+  std::vector<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time,
   const geometry_msgs::msg::Transform & self_transform)
 {
   /* params */
   constexpr float max_elapsed_time = 1.0;
 
   /* delete tracker */
-  for (auto itr = list_tracker.begin(); itr != list_tracker.end(); ++itr) {
-    const bool is_old = max_elapsed_time < (*itr)->getElapsedTimeFromLastUpdate(time);
-    const bool is_specific_alive_pattern = isSpecificAlivePattern(*itr, time, self_transform);
-    if (is_old && !is_specific_alive_pattern) {
-      auto erase_itr = itr;
-      --itr;
-      list_tracker.erase(erase_itr);
-    }
-  }
+  const auto is_dead = [&time, &self_transform](
+                         const std::shared_ptr<Tracker> & tracker) {
+    const bool is_old = max_elapsed_time < tracker->getElapsedTimeFromLastUpdate(time);
+    return is_old && !isSpecificAlivePattern(tracker, time, self_transform);
+  };
+  list_tracker.erase(
+    std::remove_if(list_tracker.begin(), list_tracker.end(), is_dead), list_tracker.end());
 }
 
 void MultiObjectTracker::sanitizeTracker(
-  std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time)
+  std::vector<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time)
 {
   constexpr float min_iou = 0.1;
   constexpr double distance_threshold = 5.0;
+
+  std::vector<const autoware_perception_msgs::msg::DynamicObject *> objects(list_tracker.size());
+  for (size_t i = 0; i < list_tracker.size(); ++i) {
+    objects.at(i) = &list_tracker.at(i)->getCachedEstimatedDynamicObject(time);
+  }
+
+  // only the trackers of the 3x3 cells around a tracker can be within distance_threshold
+  std::vector<uint64_t> cell_keys(list_tracker.size());
+  std::unordered_map<uint64_t, std::vector<size_t>> grid;
+  std::vector<bool> is_removed(list_tracker.size(), false);
+  for (size_t i = 0; i < list_tracker.size(); ++i) {
+    const auto & position = objects.at(i)->state.pose_covariance.pose.position;
+    if (!std::isfinite(position.x) || !std::isfinite(position.y)) {
+      continue;
+    }
+    const auto cell_x = static_cast<int64_t>(std::floor(position.x / distance_threshold));
+    const auto cell_y = static_cast<int64_t>(std::floor(position.y / distance_threshold));
+    grid[getCellKey(cell_x, cell_y)].push_back(i);
+  }
+
   /* delete collision tracker */
-  for (auto itr1 = list_tracker.begin(); itr1 != list_tracker.end(); ++itr1) {
-    autoware_perception_msgs::msg::DynamicObject object1;
-    (*itr1)->getEstimatedDynamicObject(time, object1);
-    for (auto itr2 = std::next(itr1); itr2 != list_tracker.end(); ++itr2) {
-      autoware_perception_msgs::msg::DynamicObject object2;
-      (*itr2)->getEstimatedDynamicObject(time, object2);
-      const double distance = std::hypot(
-        object1.state.pose_covariance.pose.position.x -
-          object2.state.pose_covariance.pose.position.x,
-        object1.state.pose_covariance.pose.position.y -
-          object2.state.pose_covariance.pose.position.y);
+  // same order as comparing every pair of the list: a tracker is checked against the later ones
+  std::vector<size_t> neighbors;
+  for (size_t i = 0; i < list_tracker.size(); ++i) {
+    const auto & position1 = objects.at(i)->state.pose_covariance.pose.position;
+    if (is_removed.at(i) || !std::isfinite(position1.x) || !std::isfinite(position1.y)) {
+      continue;
+    }
+    const auto cell_x = static_cast<int64_t>(std::floor(position1.x / distance_threshold));
+    const auto cell_y = static_cast<int64_t>(std::floor(position1.y / distance_threshold));
+    neighbors.clear();
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        const auto cell_itr = grid.find(getCellKey(cell_x + dx, cell_y + dy));
+        if (cell_itr == grid.end()) {
+          continue;
+        }
+        for (const size_t j : cell_itr->second) {
+          if (i < j) {
+            neighbors.push_back(j);
+          }
+        }
+      }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+
+    for (const size_t j : neighbors) {
+      if (is_removed.at(j)) {
+        continue;
+      }
+      const auto & position2 = objects.at(j)->state.pose_covariance.pose.position;
+      const double distance = std::hypot(position1.x - position2.x, position1.y - position2.y);
       if (distance_threshold < distance) {
         continue;
       }
-      if (min_iou < utils::get2dIoU(object1, object2)) {
-        if ((*itr1)->getTotalMeasurementCount() < (*itr2)->getTotalMeasurementCount()) {
-          itr1 = list_tracker.erase(itr1);
-          --itr1;
+      if (min_iou < utils::get2dIoU(*objects.at(i), *objects.at(j))) {
+        if (
+          list_tracker.at(i)->getTotalMeasurementCount() <
+          list_tracker.at(j)->getTotalMeasurementCount()) {
+          is_removed.at(i) = true;
           break;
         } else {
-          itr2 = list_tracker.erase(itr2);
-          --itr2;
+          is_removed.at(j) = true;
         }
       }
     }
   }
+
+  size_t num_kept = 0;
+  for (size_t i = 0; i < list_tracker.size(); ++i) {
+    if (!is_removed.at(i)) {
+      list_tracker.at(num_kept++) = std::move(list_tracker.at(i));
+    }
+  }
+  list_tracker.resize(num_kept);
 }
 
 inline bool MultiObjectTracker::shouldTrackerPublish(
@@ -375,9 +445,7 @@ void MultiObjectTracker::publish(const rclcpp::Time & time) const
     if (!shouldTrackerPublish(*itr)) {
       continue;
     }
-    autoware_perception_msgs::msg::DynamicObject object;
-    (*itr)->getEstimatedDynamicObject(time, object);
-    output_msg.objects.push_back(object);
+    output_msg.objects.push_back((*itr)->getCachedEstimatedDynamicObject(time));
   }
 
   // Publish
@@ -132,6 +132,7 @@ BicycleTracker::BicycleTracker(
 
 bool BicycleTracker::predict(const rclcpp::Time & time)
 {
+  clearEstimationCache();
   const double dt = (time - last_update_time_).seconds();
   bool ret = predict(dt, ekf_);
   if (ret) {
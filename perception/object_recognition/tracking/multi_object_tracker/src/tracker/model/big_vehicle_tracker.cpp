@@ -130,6 +130,7 @@ BigVehicleTracker::BigVehicleTracker(
 
 bool BigVehicleTracker::predict(const rclcpp::Time & time)
 {
+  clearEstimationCache();
   const double dt = (time - last_update_time_).seconds();
   bool ret = predict(dt, ekf_);
   if (ret) {
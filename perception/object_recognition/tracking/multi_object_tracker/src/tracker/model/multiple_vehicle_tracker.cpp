@@ -30,6 +30,7 @@ MultipleVehicleTracker::MultipleVehicleTracker(
 
 bool MultipleVehicleTracker::predict(const rclcpp::Time & time)
 {
+  clearEstimationCache();
   big_vehicle_tracker_.predict(time);
   normal_vehicle_tracker_.predict(time);
   return true;
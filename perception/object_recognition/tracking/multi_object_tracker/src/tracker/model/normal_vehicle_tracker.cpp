@@ -130,6 +130,7 @@ NormalVehicleTracker::NormalVehicleTracker(
 
 bool NormalVehicleTracker::predict(const rclcpp::Time & time)
 {
+  clearEstimationCache();
   const double dt = (time - last_update_time_).seconds();
   bool ret = predict(dt, ekf_);
   if (ret) {
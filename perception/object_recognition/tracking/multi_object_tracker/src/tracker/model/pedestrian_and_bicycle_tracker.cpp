@@ -30,6 +30,7 @@ PedestrianAndBicycleTracker::PedestrianAndBicycleTracker(
 
 bool PedestrianAndBicycleTracker::predict(const rclcpp::Time & time)
 {
+  clearEstimationCache();
   pedestrian_tracker_.predict(time);
   bicycle_tracker_.predict(time);
   return true;
@@ -135,6 +135,7 @@ PedestrianTracker::PedestrianTracker(
 
 bool PedestrianTracker::predict(const rclcpp::Time & time)
 {
+  clearEstimationCache();
   const double dt = (time - last_update_time_).seconds();
   bool ret = predict(dt, ekf_);
   if (ret) {
@@ -26,7 +26,9 @@ Tracker::Tracker(const rclcpp::Time & time, const int type)
   no_measurement_count_(0),
   total_no_measurement_count_(0),
   total_measurement_count_(1),
-  last_update_with_measurement_time_(time)
+  last_update_with_measurement_time_(time),
+  has_cached_object_(false),
+  cached_time_nanoseconds_(0)
 {
   // Generate random number
   std::mt19937 gen(std::random_device{}());
@@ -41,6 +43,7 @@ bool Tracker::updateWithMeasurement(
   no_measurement_count_ = 0;
   ++total_measurement_count_;
   last_update_with_measurement_time_ = measurement_time;
+  clearEstimationCache();
   measure(object, measurement_time);
   return true;
 }
@@ -55,7 +58,16 @@ bool Tracker::updateWithoutMeasurement()
 geometry_msgs::msg::PoseWithCovariance Tracker::getPoseWithCovariance(
   const rclcpp::Time & time) const
 {
-  autoware_perception_msgs::msg::DynamicObject object;
-  getEstimatedDynamicObject(time, object);
-  return object.state.pose_covariance;
+  return getCachedEstimatedDynamicObject(time).state.pose_covariance;
+}
+
+const autoware_perception_msgs::msg::DynamicObject & Tracker::getCachedEstimatedDynamicObject(
+  const rclcpp::Time & time) const
+{
+  if (!has_cached_object_ || cached_time_nanoseconds_ != time.nanoseconds()) {
+    getEstimatedDynamicObject(time, cached_object_);
+    cached_time_nanoseconds_ = time.nanoseconds();
+    has_cached_object_ = true;
+  }
+  return cached_object_;
 }
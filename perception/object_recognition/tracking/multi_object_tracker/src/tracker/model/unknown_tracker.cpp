@@ -104,6 +104,7 @@ UnknownTracker::UnknownTracker(
 
 bool UnknownTracker::predict(const rclcpp::Time & time)
 {
+  clearEstimationCache();
   const double dt = (time - last_update_time_).seconds();
   bool ret = predict(dt, ekf_);
   if (ret) {
@@ -0,0 +1,140 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "multi_object_tracker/utils/thread_pool.hpp"
+
+#include <algorithm>
+
+namespace utils
+{
+ThreadPool::ThreadPool(const size_t num_threads)
+{
+  const size_t num_loop_threads =
+    num_threads != 0 ? num_threads : std::max(1U, std::thread::hardware_concurrency());
+  for (size_t i = 1; i < num_loop_threads; ++i) {
+    workers_.emplace_back(&ThreadPool::runWorker, this);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopped_ = true;
+  }
+  task_cv_.notify_all();
+  for (auto & worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::parallelFor(
+  const size_t size, const std::function<void(size_t)> & func, const size_t min_chunk_size)
+{
+  const size_t max_num_chunks = std::max<size_t>(1, size / std::max<size_t>(1, min_chunk_size));
+  const size_t num_chunks = std::min(max_num_chunks, getNumThreads());
+  if (num_chunks <= 1) {
+    for (size_t i = 0; i < size; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // a worker woken late for the previous loop may still be looking for a chunk
+    done_cv_.wait(lock, [this]() { return num_active_workers_ == 0; });
+    func_ = &func;
+    size_ = size;
+    chunk_size_ = (size + num_chunks - 1) / num_chunks;
+    num_chunks_ = num_chunks;
+    next_chunk_ = 0;
+    num_done_chunks_ = 0;
+    exception_ = nullptr;
+    ++generation_;
+  }
+  task_cv_.notify_all();
+
+  runChunks();
+
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() {
+      return num_done_chunks_ == num_chunks_ && num_active_workers_ == 0;
+    });
+    func_ = nullptr;
+    exception = exception_;
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void ThreadPool::runWorker()
+{
+  size_t generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_cv_.wait(
+        lock, [this, generation]() { return is_stopped_ || generation_ != generation; });
+      if (is_stopped_) {
+        return;
+      }
+      generation = generation_;
+      if (!func_) {
+        continue;
+      }
+      ++num_active_workers_;
+    }
+
+    runChunks();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --num_active_workers_;
+    }
+    done_cv_.notify_all();
+  }
+}
+
+void ThreadPool::runChunks()
+{
+  while (true) {
+    const size_t chunk = next_chunk_.fetch_add(1);
+    if (chunk >= num_chunks_) {
+      return;
+    }
+
+    const size_t begin = chunk * chunk_size_;
+    const size_t end = std::min(size_, begin + chunk_size_);
+    try {
+      for (size_t i = begin; i < end; ++i) {
+        (*func_)(i);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!exception_) {
+        exception_ = std::current_exception();
+      }
+    }
+
+    if (num_done_chunks_.fetch_add(1) + 1 == num_chunks_) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_cv_.notify_all();
+    }
+  }
+}
+}  // namespace utils
@@ -30,6 +30,20 @@ public:
   virtual bool getLampState(
     const cv::Mat & input_image,
     std::vector<autoware_perception_msgs::msg::LampState> & states) = 0;
+
+  // classify all the rois of a frame, one by one unless the classifier batches them
+  virtual bool getLampStates(
+    const std::vector<cv::Mat> & input_images,
+    std::vector<std::vector<autoware_perception_msgs::msg::LampState>> & states)
+  {
+    states.assign(input_images.size(), {});
+    for (size_t i = 0; i < input_images.size(); ++i) {
+      if (!getLampState(input_images.at(i), states.at(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
 };
 }  // namespace traffic_light
 
@@ -43,9 +43,13 @@ public:
   bool getLampState(
     const cv::Mat & input_image,
     std::vector<autoware_perception_msgs::msg::LampState> & states) override;
+  // the images are classified max_batch_size at a time
+  bool getLampStates(
+    const std::vector<cv::Mat> & input_images,
+    std::vector<std::vector<autoware_perception_msgs::msg::LampState>> & states) override;
 
 private:
-  void preProcess(cv::Mat & image, std::vector<float> & tensor, bool normalize = true);
+  void preProcess(const cv::Mat & image, float * tensor, bool normalize = true);
   bool postProcess(
     std::vector<float> & output_data_host,
     std::vector<autoware_perception_msgs::msg::LampState> & states);
@@ -53,7 +57,8 @@ private:
   void calcSoftmax(std::vector<float> & data, std::vector<float> & probs, int num_output);
   std::vector<size_t> argsort(std::vector<float> & tensor, int num_output);
   void outputDebugImage(
-    cv::Mat & debug_image, const std::vector<autoware_perception_msgs::msg::LampState> & states);
+    const cv::Mat & input_image,
+    const std::vector<autoware_perception_msgs::msg::LampState> & states);
 
 private:
   std::map<int, std::string> state2label_{
@@ -86,6 +91,13 @@ private:
   int input_c_;
   int input_h_;
   int input_w_;
+  int max_batch_size_;
+
+  // sized for max_batch_size_ images
+  std::vector<float> input_data_host_;
+  std::vector<float> output_data_host_;
+  Tn::UniquePtr<float[]> input_data_device_;
+  Tn::UniquePtr<float[]> output_data_device_;
 };
 
 }  // namespace traffic_light
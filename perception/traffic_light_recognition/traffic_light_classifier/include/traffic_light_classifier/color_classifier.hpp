@@ -26,6 +26,8 @@
 
 #include <cv_bridge/cv_bridge.h>
 
+#include <array>
+#include <cstdint>
 #include <vector>
 
 namespace traffic_light
@@ -61,11 +63,18 @@ public:
   bool getLampState(
     const cv::Mat & input_image,
     std::vector<autoware_perception_msgs::msg::LampState> & states) override;
+  // the rois clipped from the same image are converted to hsv together
+  bool getLampStates(
+    const std::vector<cv::Mat> & input_images,
+    std::vector<std::vector<autoware_perception_msgs::msg::LampState>> & states) override;
 
 private:
-  bool filterHSV(
-    const cv::Mat & input_image, cv::Mat & green_image, cv::Mat & yellow_image,
-    cv::Mat & red_image);
+  bool convertToHSV(const std::vector<cv::Mat> & input_images, std::vector<cv::Mat> & hsv_images);
+  void classify(
+    const cv::Mat & input_image, const cv::Mat & hsv_image,
+    std::vector<autoware_perception_msgs::msg::LampState> & states);
+  void publishDebugImage(const cv::Mat & input_image);
+  void updateColorTables();
   rcl_interfaces::msg::SetParametersResult parametersCallback(
     const std::vector<rclcpp::Parameter> & parameters);
 
@@ -75,18 +84,29 @@ private:
     Sat = 1,
     Val = 2,
   };
+  // bits of the colors in the mask of a pixel
+  enum ColorBit : uint8_t {
+    Green = 1,
+    Yellow = 2,
+    Red = 4,
+  };
   image_transport::Publisher image_pub_;
 
   rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr set_param_res_;
   rclcpp::Node * node_ptr_;
 
   HSVConfig hsv_config_;
-  cv::Scalar min_hsv_green_;
-  cv::Scalar max_hsv_green_;
-  cv::Scalar min_hsv_yellow_;
-  cv::Scalar max_hsv_yellow_;
-  cv::Scalar min_hsv_red_;
-  cv::Scalar max_hsv_red_;
+  // colors whose range contains a value of a channel, so that the mask of a pixel is the bitwise
+  // and of the tables of its channels
+  std::array<uint8_t, 256> hue_table_;
+  std::array<uint8_t, 256> sat_table_;
+  std::array<uint8_t, 256> val_table_;
+
+  // buffers reused over the rois
+  cv::Mat hsv_buffer_;
+  std::vector<uint8_t> mask_;
+  std::vector<uint8_t> eroded_mask_;
+  std::vector<uint8_t> filtered_mask_;
 };
 
 }  // namespace traffic_light
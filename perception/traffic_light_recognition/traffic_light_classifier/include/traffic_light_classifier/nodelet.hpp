@@ -37,6 +37,8 @@
 
 #include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #if ENABLE_GPU
 #include "traffic_light_classifier/cnn_classifier.hpp"
@@ -64,6 +66,17 @@ private:
   };
   void connectCb();
 
+  // the lamp states of a roi, reused while its appearance does not change
+  struct ClassifiedRoi
+  {
+    cv::Mat thumbnail;  // downscaled image of the roi when it was classified
+    std::vector<autoware_perception_msgs::msg::LampState> lamp_states;
+    int num_reused_frames;
+  };
+  bool findClassifiedRoi(
+    const int32_t id, const cv::Mat & thumbnail,
+    std::vector<autoware_perception_msgs::msg::LampState> & lamp_states);
+
   rclcpp::TimerBase::SharedPtr timer_;
   image_transport::SubscriberFilter image_sub_;
   message_filters::Subscriber<autoware_perception_msgs::msg::TrafficLightRoiArray> roi_sub_;
@@ -81,6 +94,11 @@ private:
   rclcpp::Publisher<autoware_perception_msgs::msg::TrafficLightStateArray>::SharedPtr
     tl_states_pub_;
   std::shared_ptr<ClassifierInterface> classifier_ptr_;
+
+  bool use_appearance_cache_;
+  double appearance_diff_thresh_;
+  int max_reused_frames_;
+  std::unordered_map<int32_t, ClassifiedRoi> classified_rois_;
 };
 
 }  // namespace traffic_light
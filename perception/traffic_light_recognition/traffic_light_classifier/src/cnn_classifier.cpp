@@ -19,6 +19,7 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,61 +40,94 @@ CNNClassifier::CNNClassifier(rclcpp::Node * node_ptr) : node_ptr_(node_ptr)
   input_c_ = node_ptr_->declare_parameter("input_c", 3);
   input_h_ = node_ptr_->declare_parameter("input_h", 224);
   input_w_ = node_ptr_->declare_parameter("input_w", 224);
+  max_batch_size_ = node_ptr_->declare_parameter("max_batch_size", 8);
 
   readLabelfile(label_file_path, labels_);
 
   std::string cache_dir =
     ament_index_cpp::get_package_share_directory("traffic_light_classifier") + "/data";
-  trt_ = std::make_shared<Tn::TrtCommon>(model_file_path, cache_dir, precision);
+  trt_ = std::make_shared<Tn::TrtCommon>(model_file_path, cache_dir, precision, max_batch_size_);
   trt_->setup();
+  if (!trt_->isInitialized()) {
+    return;
+  }
+
+  // models without a dynamic batch dimension are run with their own batch size
+  max_batch_size_ = trt_->getMaxBatchSize();
+  input_data_host_.resize(max_batch_size_ * trt_->getNumInput());
+  output_data_host_.resize(max_batch_size_ * trt_->getNumOutput());
+  input_data_device_ = Tn::make_unique<float[]>(input_data_host_.size());
+  output_data_device_ = Tn::make_unique<float[]>(output_data_host_.size());
 }
 
 bool CNNClassifier::getLampState(
   const cv::Mat & input_image, std::vector<autoware_perception_msgs::msg::LampState> & states)
+{
+  std::vector<std::vector<autoware_perception_msgs::msg::LampState>> batch_states;
+  if (!getLampStates({input_image}, batch_states)) {
+    return false;
+  }
+  states.insert(states.end(), batch_states.front().begin(), batch_states.front().end());
+  return true;
+}
+
+bool CNNClassifier::getLampStates(
+  const std::vector<cv::Mat> & input_images,
+  std::vector<std::vector<autoware_perception_msgs::msg::LampState>> & states)
 {
   if (!trt_->isInitialized()) {
     RCLCPP_WARN(node_ptr_->get_logger(), "failed to init tensorrt");
     return false;
   }
 
-  int num_input = trt_->getNumInput();
-  int num_output = trt_->getNumOutput();
-
-  std::vector<float> input_data_host(num_input);
-
-  cv::Mat image = input_image.clone();
-  preProcess(image, input_data_host, true);
-
-  auto input_data_device = Tn::make_unique<float[]>(num_input);
-  cudaMemcpy(
-    input_data_device.get(), input_data_host.data(), num_input * sizeof(float),
-    cudaMemcpyHostToDevice);
-
-  auto output_data_device = Tn::make_unique<float[]>(num_output);
-
-  // do inference
-  std::vector<void *> bindings = {input_data_device.get(), output_data_device.get()};
-
-  trt_->context_->executeV2(bindings.data());
-
-  std::vector<float> output_data_host(num_output);
-  cudaMemcpy(
-    output_data_host.data(), output_data_device.get(), num_output * sizeof(float),
-    cudaMemcpyDeviceToHost);
+  const int num_input = trt_->getNumInput();
+  const int num_output = trt_->getNumOutput();
+  states.assign(input_images.size(), {});
+
+  for (size_t batch_begin = 0; batch_begin < input_images.size();
+       batch_begin += max_batch_size_) {
+    const int batch_size =
+      std::min(static_cast<int>(input_images.size() - batch_begin), max_batch_size_);
+    if (!trt_->setBatchSize(batch_size)) {
+      RCLCPP_WARN(node_ptr_->get_logger(), "failed to set the batch size %d", batch_size);
+      return false;
+    }
 
-  postProcess(output_data_host, states);
+    for (int i = 0; i < batch_size; ++i) {
+      preProcess(
+        input_images.at(batch_begin + i), input_data_host_.data() + i * num_input, true);
+    }
+    cudaMemcpy(
+      input_data_device_.get(), input_data_host_.data(), batch_size * num_input * sizeof(float),
+      cudaMemcpyHostToDevice);
+
+    // do inference
+    std::vector<void *> bindings = {input_data_device_.get(), output_data_device_.get()};
+    trt_->context_->executeV2(bindings.data());
+
+    cudaMemcpy(
+      output_data_host_.data(), output_data_device_.get(),
+      batch_size * num_output * sizeof(float), cudaMemcpyDeviceToHost);
+
+    for (int i = 0; i < batch_size; ++i) {
+      const auto output_begin = output_data_host_.begin() + i * num_output;
+      std::vector<float> output_data(output_begin, output_begin + num_output);
+      postProcess(output_data, states.at(batch_begin + i));
+    }
+  }
 
   /* debug */
   if (0 < image_pub_.getNumSubscribers()) {
-    cv::Mat debug_image = input_image.clone();
-    outputDebugImage(debug_image, states);
+    for (size_t i = 0; i < input_images.size(); ++i) {
+      outputDebugImage(input_images.at(i), states.at(i));
+    }
   }
 
   return true;
 }
 
 void CNNClassifier::outputDebugImage(
-  cv::Mat & debug_image, const std::vector<autoware_perception_msgs::msg::LampState> & states)
+  const cv::Mat & input_image, const std::vector<autoware_perception_msgs::msg::LampState> & states)
 {
   float probability;
   std::string label;
@@ -109,9 +143,11 @@ void CNNClassifier::outputDebugImage(
 
   const int expand_w = 200;
   const int expand_h =
-    std::max(static_cast<int>((expand_w * debug_image.rows) / debug_image.cols), 1);
+    std::max(static_cast<int>((expand_w * input_image.rows) / input_image.cols), 1);
 
-  cv::resize(debug_image, debug_image, cv::Size(expand_w, expand_h));
+  // the resize writes a new image, the input is not copied
+  cv::Mat debug_image;
+  cv::resize(input_image, debug_image, cv::Size(expand_w, expand_h));
   cv::Mat text_img(cv::Size(expand_w, 50), CV_8UC3, cv::Scalar(0, 0, 0));
   std::string text = label + " " + std::to_string(probability);
   cv::putText(
@@ -123,31 +159,27 @@ void CNNClassifier::outputDebugImage(
   image_pub_.publish(debug_image_msg);
 }
 
-void CNNClassifier::preProcess(cv::Mat & image, std::vector<float> & input_tensor, bool normalize)
+void CNNClassifier::preProcess(const cv::Mat & image, float * input_tensor, bool normalize)
 {
   /* normalize */
   /* ((channel[0] / 255) - mean[0]) / std[0] */
 
   // cv::cvtColor(image, image, cv::COLOR_BGR2RGB, 3);
-  cv::resize(image, image, cv::Size(input_w_, input_h_));
-
-  const size_t strides_cv[3] = {
-    static_cast<size_t>(input_w_ * input_c_), static_cast<size_t>(input_c_), 1};
-  const size_t strides[3] = {
-    static_cast<size_t>(input_h_ * input_w_), static_cast<size_t>(input_w_), 1};
-
-  for (int i = 0; i < input_h_; i++) {
-    for (int j = 0; j < input_w_; j++) {
-      for (int k = 0; k < input_c_; k++) {
-        const size_t offset_cv = i * strides_cv[0] + j * strides_cv[1] + k * strides_cv[2];
-        const size_t offset = k * strides[0] + i * strides[1] + j * strides[2];
-        if (normalize) {
-          input_tensor[offset] =
-            ((static_cast<float>(image.data[offset_cv]) / 255) - mean_[k]) / std_[k];
-        } else {
-          input_tensor[offset] = static_cast<float>(image.data[offset_cv]);
-        }
-      }
+  cv::Mat resized_image;
+  cv::resize(image, resized_image, cv::Size(input_w_, input_h_));
+  resized_image.convertTo(resized_image, CV_32FC(input_c_), normalize ? 1.0 / 255 : 1.0);
+
+  // split the packed image straight into the planes of the tensor
+  const int plane_size = input_h_ * input_w_;
+  std::vector<cv::Mat> planes;
+  for (int k = 0; k < input_c_; k++) {
+    planes.emplace_back(input_h_, input_w_, CV_32FC1, input_tensor + k * plane_size);
+  }
+  cv::split(resized_image, planes);
+
+  if (normalize) {
+    for (int k = 0; k < input_c_; k++) {
+      planes.at(k).convertTo(planes.at(k), CV_32FC1, 1.0 / std_[k], -mean_[k] / std_[k]);
     }
   }
 }
@@ -45,6 +45,7 @@ ColorClassifier::ColorClassifier(rclcpp::Node * node_ptr) : node_ptr_(node_ptr)
   hsv_config_.red_max_h = node_ptr_->declare_parameter("red_max_h", 180);
   hsv_config_.red_max_s = node_ptr_->declare_parameter("red_max_s", 255);
   hsv_config_.red_max_v = node_ptr_->declare_parameter("red_max_v", 255);
+  updateColorTables();
 
   // set parameter callback
   set_param_res_ = node_ptr_->add_on_set_parameters_callback(
@@ -54,119 +55,165 @@ ColorClassifier::ColorClassifier(rclcpp::Node * node_ptr) : node_ptr_(node_ptr)
 bool ColorClassifier::getLampState(
   const cv::Mat & input_image, std::vector<autoware_perception_msgs::msg::LampState> & states)
 {
-  cv::Mat green_image;
-  cv::Mat yellow_image;
-  cv::Mat red_image;
-  filterHSV(input_image, green_image, yellow_image, red_image);
-  // binarize
-  cv::Mat green_bin_image;
-  cv::Mat yellow_bin_image;
-  cv::Mat red_bin_image;
-  const int bin_threshold = 127;
-  cv::threshold(green_image, green_bin_image, bin_threshold, 255, cv::THRESH_BINARY);
-  cv::threshold(yellow_image, yellow_bin_image, bin_threshold, 255, cv::THRESH_BINARY);
-  cv::threshold(red_image, red_bin_image, bin_threshold, 255, cv::THRESH_BINARY);
-  // filter noise
-  cv::Mat green_filtered_bin_image;
-  cv::Mat yellow_filtered_bin_image;
-  cv::Mat red_filtered_bin_image;
-  cv::Mat element4 = (cv::Mat_<uchar>(3, 3) << 0, 1, 0, 1, 1, 1, 0, 1, 0);
-  cv::erode(green_bin_image, green_filtered_bin_image, element4, cv::Point(-1, -1), 1);
-  cv::erode(yellow_bin_image, yellow_filtered_bin_image, element4, cv::Point(-1, -1), 1);
-  cv::erode(red_bin_image, red_filtered_bin_image, element4, cv::Point(-1, -1), 1);
-  cv::dilate(green_filtered_bin_image, green_filtered_bin_image, cv::Mat(), cv::Point(-1, -1), 1);
-  cv::dilate(yellow_filtered_bin_image, yellow_filtered_bin_image, cv::Mat(), cv::Point(-1, -1), 1);
-  cv::dilate(red_filtered_bin_image, red_filtered_bin_image, cv::Mat(), cv::Point(-1, -1), 1);
-
-  /* debug */
-#if 1
+  std::vector<cv::Mat> hsv_images;
+  if (!convertToHSV({input_image}, hsv_images)) {
+    return false;
+  }
+  classify(input_image, hsv_images.front(), states);
+  return true;
+}
+
+bool ColorClassifier::getLampStates(
+  const std::vector<cv::Mat> & input_images,
+  std::vector<std::vector<autoware_perception_msgs::msg::LampState>> & states)
+{
+  std::vector<cv::Mat> hsv_images;
+  if (!convertToHSV(input_images, hsv_images)) {
+    return false;
+  }
+  states.assign(input_images.size(), {});
+  for (size_t i = 0; i < input_images.size(); ++i) {
+    classify(input_images.at(i), hsv_images.at(i), states.at(i));
+  }
+  return true;
+}
+
+bool ColorClassifier::convertToHSV(
+  const std::vector<cv::Mat> & input_images, std::vector<cv::Mat> & hsv_images)
+{
+  hsv_images.clear();
+  if (input_images.empty()) {
+    return true;
+  }
+
+  // Rois of the same image and their union in it
+  std::vector<cv::Rect> rects;
+  cv::Rect union_rect;
+  size_t roi_area = 0;
+  bool is_same_image = true;
+  for (const auto & input_image : input_images) {
+    cv::Size whole_size;
+    cv::Point offset;
+    input_image.locateROI(whole_size, offset);
+    rects.emplace_back(offset, input_image.size());
+    union_rect = rects.size() == 1 ? rects.back() : (union_rect | rects.back());
+    roi_area += rects.back().area();
+    is_same_image &= input_image.datastart == input_images.front().datastart &&
+                     input_image.step == input_images.front().step &&
+                     input_image.type() == input_images.front().type();
+  }
+  // converted together unless the union is mostly out of the rois
+  const bool convert_union =
+    is_same_image && static_cast<size_t>(union_rect.area()) <= 2 * roi_area;
+  const size_t buffer_area = convert_union ? union_rect.area() : roi_area;
+
+  // a single buffer for the hsv images, which is allocated again only for a larger area
+  if (hsv_buffer_.total() < buffer_area) {
+    hsv_buffer_.create(1, static_cast<int>(buffer_area), CV_8UC3);
+  }
+
+  try {
+    if (convert_union) {
+      const auto & front_rect = rects.front();
+      cv::Mat union_image = input_images.front();
+      union_image.adjustROI(
+        front_rect.y - union_rect.y, union_rect.br().y - front_rect.br().y,
+        front_rect.x - union_rect.x, union_rect.br().x - front_rect.br().x);
+      cv::Mat hsv_union_image(union_rect.size(), CV_8UC3, hsv_buffer_.data);
+      cv::cvtColor(union_image, hsv_union_image, cv::COLOR_BGR2HSV);
+      for (const auto & rect : rects) {
+        hsv_images.push_back(hsv_union_image(rect - union_rect.tl()));
+      }
+    } else {
+      uint8_t * data = hsv_buffer_.data;
+      for (const auto & input_image : input_images) {
+        hsv_images.emplace_back(input_image.size(), CV_8UC3, data);
+        cv::cvtColor(input_image, hsv_images.back(), cv::COLOR_BGR2HSV);
+        data += input_image.total() * 3;
+      }
+    }
+  } catch (cv::Exception & e) {
+    RCLCPP_ERROR(node_ptr_->get_logger(), "failed to filter image by hsv value : %s", e.what());
+    return false;
+  }
+  return true;
+}
+
+void ColorClassifier::classify(
+  const cv::Mat & input_image, const cv::Mat & hsv_image,
+  std::vector<autoware_perception_msgs::msg::LampState> & states)
+{
+  const int rows = hsv_image.rows;
+  const int cols = hsv_image.cols;
+  const size_t num_pixels = hsv_image.total();
+  mask_.resize(num_pixels);
+  eroded_mask_.resize(num_pixels);
+  filtered_mask_.resize(num_pixels);
+
+  // Masks of the three colors in one pass
+  for (int y = 0; y < rows; ++y) {
+    const uint8_t * hsv = hsv_image.ptr<uint8_t>(y);
+    uint8_t * mask = mask_.data() + y * cols;
+    for (int x = 0; x < cols; ++x, hsv += 3) {
+      mask[x] = hue_table_[hsv[Hue]] & sat_table_[hsv[Sat]] & val_table_[hsv[Val]];
+    }
+  }
+
+  // Filter noise, as cv::erode with a cross and cv::dilate with a square on each binary mask,
+  // where the pixels out of the image are ignored
+  for (int y = 0; y < rows; ++y) {
+    for (int x = 0; x < cols; ++x) {
+      const size_t i = y * cols + x;
+      uint8_t bits = mask_[i];
+      if (0 < x) {
+        bits &= mask_[i - 1];
+      }
+      if (x + 1 < cols) {
+        bits &= mask_[i + 1];
+      }
+      if (0 < y) {
+        bits &= mask_[i - cols];
+      }
+      if (y + 1 < rows) {
+        bits &= mask_[i + cols];
+      }
+      eroded_mask_[i] = bits;
+    }
+  }
+  int green_pixel_num = 0;
+  int yellow_pixel_num = 0;
+  int red_pixel_num = 0;
+  for (int y = 0; y < rows; ++y) {
+    for (int x = 0; x < cols; ++x) {
+      uint8_t bits = 0;
+      for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, rows - 1); ++ny) {
+        for (int nx = std::max(x - 1, 0); nx <= std::min(x + 1, cols - 1); ++nx) {
+          bits |= eroded_mask_[ny * cols + nx];
+        }
+      }
+      filtered_mask_[y * cols + x] = bits;
+      green_pixel_num += (bits & Green) != 0;
+      yellow_pixel_num += (bits & Yellow) != 0;
+      red_pixel_num += (bits & Red) != 0;
+    }
+  }
+
   if (0 < image_pub_.getNumSubscribers()) {
-    cv::Mat debug_raw_image;
-    cv::Mat debug_green_image;
-    cv::Mat debug_yellow_image;
-    cv::Mat debug_red_image;
-    cv::hconcat(input_image, input_image, debug_raw_image);
-    cv::hconcat(debug_raw_image, input_image, debug_raw_image);
-    cv::hconcat(green_image, green_bin_image, debug_green_image);
-    cv::hconcat(debug_green_image, green_filtered_bin_image, debug_green_image);
-    cv::hconcat(yellow_image, yellow_bin_image, debug_yellow_image);
-    cv::hconcat(debug_yellow_image, yellow_filtered_bin_image, debug_yellow_image);
-    cv::hconcat(red_image, red_bin_image, debug_red_image);
-    cv::hconcat(debug_red_image, red_filtered_bin_image, debug_red_image);
-
-    cv::Mat debug_image;
-    cv::vconcat(debug_green_image, debug_yellow_image, debug_image);
-    cv::vconcat(debug_image, debug_red_image, debug_image);
-    cv::cvtColor(debug_image, debug_image, cv::COLOR_GRAY2RGB);
-    cv::vconcat(debug_raw_image, debug_image, debug_image);
-    const int width = input_image.cols;
-    const int height = input_image.rows;
-    cv::line(
-      debug_image, cv::Point(0, 0), cv::Point(debug_image.cols, 0), cv::Scalar(255, 255, 255), 1,
-      CV_AA, 0);
-    cv::line(
-      debug_image, cv::Point(0, height), cv::Point(debug_image.cols, height),
-      cv::Scalar(255, 255, 255), 1, CV_AA, 0);
-    cv::line(
-      debug_image, cv::Point(0, height * 2), cv::Point(debug_image.cols, height * 2),
-      cv::Scalar(255, 255, 255), 1, CV_AA, 0);
-    cv::line(
-      debug_image, cv::Point(0, height * 3), cv::Point(debug_image.cols, height * 3),
-      cv::Scalar(255, 255, 255), 1, CV_AA, 0);
-
-    cv::line(
-      debug_image, cv::Point(0, 0), cv::Point(0, debug_image.rows), cv::Scalar(255, 255, 255), 1,
-      CV_AA, 0);
-    cv::line(
-      debug_image, cv::Point(width, 0), cv::Point(width, debug_image.rows),
-      cv::Scalar(255, 255, 255), 1, CV_AA, 0);
-    cv::line(
-      debug_image, cv::Point(width * 2, 0), cv::Point(width * 2, debug_image.rows),
-      cv::Scalar(255, 255, 255), 1, CV_AA, 0);
-    cv::line(
-      debug_image, cv::Point(width * 3, 0), cv::Point(width * 3, debug_image.rows),
-      cv::Scalar(255, 255, 255), 1, CV_AA, 0);
-
-    cv::putText(
-      debug_image, "green", cv::Point(0, height * 1.5), cv::FONT_HERSHEY_SIMPLEX, 1.0,
-      cv::Scalar(255, 255, 255), 1, CV_AA);
-    cv::putText(
-      debug_image, "yellow", cv::Point(0, height * 2.5), cv::FONT_HERSHEY_SIMPLEX, 1.0,
-      cv::Scalar(255, 255, 255), 1, CV_AA);
-    cv::putText(
-      debug_image, "red", cv::Point(0, height * 3.5), cv::FONT_HERSHEY_SIMPLEX, 1.0,
-      cv::Scalar(255, 255, 255), 1, CV_AA);
-    const auto debug_image_msg =
-      cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", debug_image).toImageMsg();
-    image_pub_.publish(debug_image_msg);
+    publishDebugImage(input_image);
   }
-#endif
-  /* --- */
-
-  const int green_pixel_num = cv::countNonZero(green_filtered_bin_image);
-  const int yellow_pixel_num = cv::countNonZero(yellow_filtered_bin_image);
-  const int red_pixel_num = cv::countNonZero(red_filtered_bin_image);
-  const double green_ratio =
-    static_cast<double>(green_pixel_num) /
-    static_cast<double>(green_filtered_bin_image.rows * green_filtered_bin_image.cols);
-  const double yellow_ratio =
-    static_cast<double>(yellow_pixel_num) /
-    static_cast<double>(yellow_filtered_bin_image.rows * yellow_filtered_bin_image.cols);
-  const double red_ratio =
-    static_cast<double>(red_pixel_num) /
-    static_cast<double>(red_filtered_bin_image.rows * red_filtered_bin_image.cols);
-
-  if (yellow_ratio < green_ratio && red_ratio < green_ratio) {
+
+  // the ratios of the colors have the same denominator
+  if (yellow_pixel_num < green_pixel_num && red_pixel_num < green_pixel_num) {
     autoware_perception_msgs::msg::LampState state;
     state.type = autoware_perception_msgs::msg::LampState::GREEN;
     state.confidence = std::min(1.0, static_cast<double>(green_pixel_num) / (20.0 * 20.0));
     states.push_back(state);
-  } else if (green_ratio < yellow_ratio && red_ratio < yellow_ratio) {
+  } else if (green_pixel_num < yellow_pixel_num && red_pixel_num < yellow_pixel_num) {
     autoware_perception_msgs::msg::LampState state;
     state.type = autoware_perception_msgs::msg::LampState::YELLOW;
     state.confidence = std::min(1.0, static_cast<double>(yellow_pixel_num) / (20.0 * 20.0));
     states.push_back(state);
-  } else if (green_ratio < red_ratio && yellow_ratio < red_ratio) {
+  } else if (green_pixel_num < red_pixel_num && yellow_pixel_num < red_pixel_num) {
     autoware_perception_msgs::msg::LampState state;
     state.type = autoware_perception_msgs::msg::LampState::RED;
     state.confidence = std::min(1.0, static_cast<double>(red_pixel_num) / (20.0 * 20.0));
@@ -177,24 +224,109 @@ bool ColorClassifier::getLampState(
     state.confidence = 0.0;
     states.push_back(state);
   }
-  return true;
 }
 
-bool ColorClassifier::filterHSV(
-  const cv::Mat & input_image, cv::Mat & green_image, cv::Mat & yellow_image, cv::Mat & red_image)
+void ColorClassifier::publishDebugImage(const cv::Mat & input_image)
 {
-  cv::Mat hsv_image;
-  cv::cvtColor(input_image, hsv_image, cv::COLOR_BGR2HSV);
-  try {
-    cv::inRange(hsv_image, min_hsv_green_, max_hsv_green_, green_image);
-    cv::inRange(hsv_image, min_hsv_yellow_, max_hsv_yellow_, yellow_image);
-    cv::inRange(hsv_image, min_hsv_red_, max_hsv_red_, red_image);
-  } catch (cv::Exception & e) {
-    RCLCPP_ERROR(node_ptr_->get_logger(), "failed to filter image by hsv value : %s", e.what());
-    return false;
+  const int width = input_image.cols;
+  const int height = input_image.rows;
+  const cv::Mat mask(height, width, CV_8UC1, mask_.data());
+  const cv::Mat filtered_mask(height, width, CV_8UC1, filtered_mask_.data());
+  const auto toBinImage = [](const cv::Mat & mask, const uint8_t bit) {
+    cv::Mat bin_image;
+    cv::bitwise_and(mask, cv::Scalar(bit), bin_image);
+    cv::threshold(bin_image, bin_image, 0, 255, cv::THRESH_BINARY);
+    return bin_image;
+  };
+
+  // the masks are binary already
+  const cv::Mat green_image = toBinImage(mask, Green);
+  const cv::Mat yellow_image = toBinImage(mask, Yellow);
+  const cv::Mat red_image = toBinImage(mask, Red);
+  const cv::Mat & green_bin_image = green_image;
+  const cv::Mat & yellow_bin_image = yellow_image;
+  const cv::Mat & red_bin_image = red_image;
+  const cv::Mat green_filtered_bin_image = toBinImage(filtered_mask, Green);
+  const cv::Mat yellow_filtered_bin_image = toBinImage(filtered_mask, Yellow);
+  const cv::Mat red_filtered_bin_image = toBinImage(filtered_mask, Red);
+
+  cv::Mat debug_raw_image;
+  cv::Mat debug_green_image;
+  cv::Mat debug_yellow_image;
+  cv::Mat debug_red_image;
+  cv::hconcat(input_image, input_image, debug_raw_image);
+  cv::hconcat(debug_raw_image, input_image, debug_raw_image);
+  cv::hconcat(green_image, green_bin_image, debug_green_image);
+  cv::hconcat(debug_green_image, green_filtered_bin_image, debug_green_image);
+  cv::hconcat(yellow_image, yellow_bin_image, debug_yellow_image);
+  cv::hconcat(debug_yellow_image, yellow_filtered_bin_image, debug_yellow_image);
+  cv::hconcat(red_image, red_bin_image, debug_red_image);
+  cv::hconcat(debug_red_image, red_filtered_bin_image, debug_red_image);
+
+  cv::Mat debug_image;
+  cv::vconcat(debug_green_image, debug_yellow_image, debug_image);
+  cv::vconcat(debug_image, debug_red_image, debug_image);
+  cv::cvtColor(debug_image, debug_image, cv::COLOR_GRAY2RGB);
+  cv::vconcat(debug_raw_image, debug_image, debug_image);
+  cv::line(
+    debug_image, cv::Point(0, 0), cv::Point(debug_image.cols, 0), cv::Scalar(255, 255, 255), 1,
+    CV_AA, 0);
+  cv::line(
+    debug_image, cv::Point(0, height), cv::Point(debug_image.cols, height),
+    cv::Scalar(255, 255, 255), 1, CV_AA, 0);
+  cv::line(
+    debug_image, cv::Point(0, height * 2), cv::Point(debug_image.cols, height * 2),
+    cv::Scalar(255, 255, 255), 1, CV_AA, 0);
+  cv::line(
+    debug_image, cv::Point(0, height * 3), cv::Point(debug_image.cols, height * 3),
+    cv::Scalar(255, 255, 255), 1, CV_AA, 0);
+
+  cv::line(
+    debug_image, cv::Point(0, 0), cv::Point(0, debug_image.rows), cv::Scalar(255, 255, 255), 1,
+    CV_AA, 0);
+  cv::line(
+    debug_image, cv::Point(width, 0), cv::Point(width, debug_image.rows),
+    cv::Scalar(255, 255, 255), 1, CV_AA, 0);
+  cv::line(
+    debug_image, cv::Point(width * 2, 0), cv::Point(width * 2, debug_image.rows),
+    cv::Scalar(255, 255, 255), 1, CV_AA, 0);
+  cv::line(
+    debug_image, cv::Point(width * 3, 0), cv::Point(width * 3, debug_image.rows),
+    cv::Scalar(255, 255, 255), 1, CV_AA, 0);
+
+  cv::putText(
+    debug_image, "green", cv::Point(0, height * 1.5), cv::FONT_HERSHEY_SIMPLEX, 1.0,
+    cv::Scalar(255, 255, 255), 1, CV_AA);
+  cv::putText(
+    debug_image, "yellow", cv::Point(0, height * 2.5), cv::FONT_HERSHEY_SIMPLEX, 1.0,
+    cv::Scalar(255, 255, 255), 1, CV_AA);
+  cv::putText(
+    debug_image, "red", cv::Point(0, height * 3.5), cv::FONT_HERSHEY_SIMPLEX, 1.0,
+    cv::Scalar(255, 255, 255), 1, CV_AA);
+  const auto debug_image_msg =
+    cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", debug_image).toImageMsg();
+  image_pub_.publish(debug_image_msg);
+}
+
+void ColorClassifier::updateColorTables()
+{
+  const auto & c = hsv_config_;
+  for (int value = 0; value < 256; ++value) {
+    const auto getBit = [value](const int min, const int max, const uint8_t bit) {
+      return static_cast<uint8_t>(min <= value && value <= max ? bit : 0);
+    };
+    hue_table_[value] = getBit(c.green_min_h, c.green_max_h, Green) |
+                        getBit(c.yellow_min_h, c.yellow_max_h, Yellow) |
+                        getBit(c.red_min_h, c.red_max_h, Red);
+    sat_table_[value] = getBit(c.green_min_s, c.green_max_s, Green) |
+                        getBit(c.yellow_min_s, c.yellow_max_s, Yellow) |
+                        getBit(c.red_min_s, c.red_max_s, Red);
+    val_table_[value] = getBit(c.green_min_v, c.green_max_v, Green) |
+                        getBit(c.yellow_min_v, c.yellow_max_v, Yellow) |
+                        getBit(c.red_min_v, c.red_max_v, Red);
   }
-  return true;
 }
+
 rcl_interfaces::msg::SetParametersResult ColorClassifier::parametersCallback(
   const std::vector<rclcpp::Parameter> & parameters)
 {
@@ -228,16 +360,7 @@ rcl_interfaces::msg::SetParametersResult ColorClassifier::parametersCallback(
   update_param("red_max_s", hsv_config_.red_max_s);
   update_param("red_max_v", hsv_config_.red_max_v);
 
-  min_hsv_green_ =
-    cv::Scalar(hsv_config_.green_min_h, hsv_config_.green_min_s, hsv_config_.green_min_v);
-  max_hsv_green_ =
-    cv::Scalar(hsv_config_.green_max_h, hsv_config_.green_max_s, hsv_config_.green_max_v);
-  min_hsv_yellow_ =
-    cv::Scalar(hsv_config_.yellow_min_h, hsv_config_.yellow_min_s, hsv_config_.yellow_min_v);
-  max_hsv_yellow_ =
-    cv::Scalar(hsv_config_.yellow_max_h, hsv_config_.yellow_max_s, hsv_config_.yellow_max_v);
-  min_hsv_red_ = cv::Scalar(hsv_config_.red_min_h, hsv_config_.red_min_s, hsv_config_.red_min_v);
-  max_hsv_red_ = cv::Scalar(hsv_config_.red_max_h, hsv_config_.red_max_s, hsv_config_.red_max_v);
+  updateColorTables();
 
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
@@ -13,6 +13,8 @@
 // limitations under the License.
 #include "traffic_light_classifier/nodelet.hpp"
 
+#include <opencv2/imgproc/imgproc.hpp>
+
 #include <iostream>
 #include <memory>
 #include <utility>
@@ -20,6 +22,12 @@
 
 namespace traffic_light
 {
+namespace
+{
+// the size of the thumbnails compared to reuse the lamp states
+const cv::Size thumbnail_size(16, 16);
+}  // namespace
+
 TrafficLightClassifierNodelet::TrafficLightClassifierNodelet(const rclcpp::NodeOptions & options)
 : Node("traffic_light_classifier_node", options)
 {
@@ -36,6 +44,10 @@ TrafficLightClassifierNodelet::TrafficLightClassifierNodelet(const rclcpp::NodeO
       std::bind(&TrafficLightClassifierNodelet::imageRoiCallback, this, _1, _2));
   }
 
+  use_appearance_cache_ = this->declare_parameter("use_appearance_cache", true);
+  appearance_diff_thresh_ = this->declare_parameter("appearance_diff_thresh", 10.0);
+  max_reused_frames_ = this->declare_parameter("max_reused_frames", 10);
+
   tl_states_pub_ = this->create_publisher<autoware_perception_msgs::msg::TrafficLightStateArray>(
     "~/output/traffic_light_states", rclcpp::QoS{1});
 
@@ -96,27 +108,86 @@ void TrafficLightClassifierNodelet::imageRoiCallback(
 
   autoware_perception_msgs::msg::TrafficLightStateArray output_msg;
 
-  for (size_t i = 0; i < input_rois_msg->rois.size(); ++i) {
-    const sensor_msgs::msg::RegionOfInterest & roi = input_rois_msg->rois.at(i).roi;
-    cv::Mat clipped_image(
+  // only the rois whose appearance changed are classified
+  const size_t num_rois = input_rois_msg->rois.size();
+  std::vector<std::vector<autoware_perception_msgs::msg::LampState>> lamp_states(num_rois);
+  std::vector<cv::Mat> thumbnails(num_rois);
+  std::vector<size_t> classify_indices;
+  std::vector<cv::Mat> clipped_images;
+  for (size_t i = 0; i < num_rois; ++i) {
+    const auto & roi_msg = input_rois_msg->rois.at(i);
+    const sensor_msgs::msg::RegionOfInterest & roi = roi_msg.roi;
+    const cv::Mat clipped_image(
       cv_ptr->image, cv::Rect(roi.x_offset, roi.y_offset, roi.width, roi.height));
+    if (use_appearance_cache_) {
+      cv::resize(clipped_image, thumbnails.at(i), thumbnail_size, 0.0, 0.0, cv::INTER_AREA);
+      if (findClassifiedRoi(roi_msg.id, thumbnails.at(i), lamp_states.at(i))) {
+        continue;
+      }
+    }
+    classify_indices.push_back(i);
+    clipped_images.push_back(clipped_image);
+  }
+
+  // all the rois of the image are classified together
+  std::vector<std::vector<autoware_perception_msgs::msg::LampState>> classified_lamp_states;
+  if (
+    !clipped_images.empty() &&
+    !classifier_ptr_->getLampStates(clipped_images, classified_lamp_states)) {
+    RCLCPP_ERROR(this->get_logger(), "failed classify image, abort callback");
+    return;
+  }
 
-    std::vector<autoware_perception_msgs::msg::LampState> lamp_states;
+  std::unordered_map<int32_t, ClassifiedRoi> classified_rois;
+  for (size_t k = 0; k < classify_indices.size(); ++k) {
+    const size_t i = classify_indices.at(k);
+    lamp_states.at(i) = classified_lamp_states.at(k);
+    if (use_appearance_cache_) {
+      classified_rois_[input_rois_msg->rois.at(i).id] =
+        ClassifiedRoi{thumbnails.at(i), lamp_states.at(i), 0};
+    }
+  }
 
-    if (!classifier_ptr_->getLampState(clipped_image, lamp_states)) {
-      RCLCPP_ERROR(this->get_logger(), "failed classify image, abort callback");
-      return;
+  for (size_t i = 0; i < num_rois; ++i) {
+    const auto id = input_rois_msg->rois.at(i).id;
+    if (classified_rois_.count(id) > 0) {
+      classified_rois.emplace(id, std::move(classified_rois_.at(id)));
     }
+
     autoware_perception_msgs::msg::TrafficLightState tl_state;
-    tl_state.id = input_rois_msg->rois.at(i).id;
-    tl_state.lamp_states = lamp_states;
+    tl_state.id = id;
+    tl_state.lamp_states = lamp_states.at(i);
     output_msg.states.push_back(tl_state);
   }
+  // the rois that are not in this image are forgotten
+  classified_rois_.swap(classified_rois);
 
   output_msg.header = input_image_msg->header;
   tl_states_pub_->publish(output_msg);
 }
 
+bool TrafficLightClassifierNodelet::findClassifiedRoi(
+  const int32_t id, const cv::Mat & thumbnail,
+  std::vector<autoware_perception_msgs::msg::LampState> & lamp_states)
+{
+  const auto itr = classified_rois_.find(id);
+  if (itr == classified_rois_.end()) {
+    return false;
+  }
+  auto & classified_roi = itr->second;
+  // classify again from time to time, so that a slow change of the appearance is not missed
+  if (classified_roi.num_reused_frames >= max_reused_frames_) {
+    return false;
+  }
+  if (cv::norm(thumbnail, classified_roi.thumbnail, cv::NORM_INF) > appearance_diff_thresh_) {
+    return false;
+  }
+
+  lamp_states = classified_roi.lamp_states;
+  ++classified_roi.num_reused_frames;
+  return true;
+}
+
 }  // namespace traffic_light
 
 #include <rclcpp_components/register_node_macro.hpp>
@@ -14,11 +14,34 @@
 
 #include <trt_common.hpp>
 
+#include <algorithm>
+#include <cctype>
 #include <functional>
 #include <string>
 
 namespace Tn
 {
+namespace
+{
+// An engine only runs on the GPU model and the TensorRT version it was built with
+std::string getEngineCacheKey(const std::string & precision)
+{
+  int device = 0;
+  ::cudaDeviceProp prop;
+  std::string gpu_name = "unknown";
+  if (
+    ::cudaGetDevice(&device) == ::cudaSuccess &&
+    ::cudaGetDeviceProperties(&prop, device) == ::cudaSuccess) {
+    gpu_name = prop.name;
+  }
+  std::replace_if(
+    gpu_name.begin(), gpu_name.end(), [](const char c) { return !std::isalnum(c); }, '-');
+  return precision + "_trt" + std::to_string(NV_TENSORRT_MAJOR) + "." +
+         std::to_string(NV_TENSORRT_MINOR) + "." + std::to_string(NV_TENSORRT_PATCH) + "_" +
+         gpu_name;
+}
+}  // namespace
+
 void check_error(const ::cudaError_t e, decltype(__FILE__) f, decltype(__LINE__) n)
 {
   if (e != ::cudaSuccess) {
@@ -29,14 +52,15 @@ void check_error(const ::cudaError_t e, decltype(__FILE__) f, decltype(__LINE__)
   }
 }
 
-TrtCommon::TrtCommon(std::string model_path, std::string cache_dir, std::string precision)
+TrtCommon::TrtCommon(
+  std::string model_path, std::string cache_dir, std::string precision, const int max_batch_size)
 : model_file_path_(model_path),
   cache_dir_(cache_dir),
   precision_(precision),
   input_name_("input_0"),
   output_name_("output_0"),
   is_initialized_(false),
-  max_batch_size_(1)
+  max_batch_size_(max_batch_size)
 {
 }
 
@@ -49,11 +73,12 @@ void TrtCommon::setup()
     if (extension == ".engine") {
       loadEngine(model_file_path_);
     } else if (extension == ".onnx") {
-      std::string cache_engine_path = cache_dir_ + "/" + path.stem().string() + ".engine";
+      // engines built for another max batch size, precision, GPU or TensorRT are not reused
+      std::string cache_engine_path = cache_dir_ + "/" + path.stem().string() + "_" +
+                                      getEngineCacheKey(precision_) + "_batch" +
+                                      std::to_string(max_batch_size_) + ".engine";
       const boost::filesystem::path cache_path(cache_engine_path);
-      if (boost::filesystem::exists(cache_path)) {
-        loadEngine(cache_engine_path);
-      } else {
+      if (!boost::filesystem::exists(cache_path) || !loadEngine(cache_engine_path)) {
         logger_.log(nvinfer1::ILogger::Severity::kINFO, "start build engine");
         buildEngineFromOnnx(model_file_path_, cache_engine_path);
         logger_.log(nvinfer1::ILogger::Severity::kINFO, "end build engine");
@@ -82,7 +107,7 @@ bool TrtCommon::loadEngine(std::string engine_file_path)
   runtime_ = UniquePtr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(logger_));
   engine_ = UniquePtr<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(
     reinterpret_cast<const void *>(engine_str.data()), engine_str.size(), nullptr));
-  return true;
+  return engine_ != nullptr;
 }
 
 bool TrtCommon::buildEngineFromOnnx(std::string onnx_file_path, std::string output_engine_file_path)
@@ -102,6 +127,21 @@ bool TrtCommon::buildEngineFromOnnx(std::string onnx_file_path, std::string outp
   builder->setMaxBatchSize(max_batch_size_);
   config->setMaxWorkspaceSize(16 << 20);
 
+  // a dynamic batch dimension is bound to 1..max_batch_size, fixed ones are kept
+  const auto input = network->getInput(0);
+  const auto input_dims = input->getDimensions();
+  if (input_dims.d[0] == -1) {
+    auto profile = builder->createOptimizationProfile();
+    nvinfer1::Dims min_dims = input_dims;
+    nvinfer1::Dims max_dims = input_dims;
+    min_dims.d[0] = 1;
+    max_dims.d[0] = static_cast<int>(max_batch_size_);
+    profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMIN, min_dims);
+    profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kOPT, max_dims);
+    profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMAX, max_dims);
+    config->addOptimizationProfile(profile);
+  }
+
   if (precision_ == "fp16") {
     config->setFlag(nvinfer1::BuilderFlag::kFP16);
   } else if (precision_ == "int8") {
@@ -133,13 +173,37 @@ bool TrtCommon::isInitialized() { return is_initialized_; }
 int TrtCommon::getNumInput()
 {
   return std::accumulate(
-    input_dims_.d, input_dims_.d + input_dims_.nbDims, 1, std::multiplies<int>());
+    input_dims_.d + 1, input_dims_.d + input_dims_.nbDims, 1, std::multiplies<int>());
 }
 
 int TrtCommon::getNumOutput()
 {
   return std::accumulate(
-    output_dims_.d, output_dims_.d + output_dims_.nbDims, 1, std::multiplies<int>());
+    output_dims_.d + 1, output_dims_.d + output_dims_.nbDims, 1, std::multiplies<int>());
+}
+
+int TrtCommon::getMaxBatchSize()
+{
+  if (input_dims_.d[0] != -1) {
+    return std::max(input_dims_.d[0], 1);
+  }
+  const auto max_dims =
+    engine_->getProfileDimensions(getInputBindingIndex(), 0, nvinfer1::OptProfileSelector::kMAX);
+  return max_dims.d[0];
+}
+
+bool TrtCommon::setBatchSize(const int batch_size)
+{
+  if (batch_size < 1 || batch_size > getMaxBatchSize()) {
+    return false;
+  }
+  // a fixed batch always runs whole, the unused images are ignored by the caller
+  if (input_dims_.d[0] != -1) {
+    return true;
+  }
+  nvinfer1::Dims dims = input_dims_;
+  dims.d[0] = batch_size;
+  return context_->setBindingDimensions(getInputBindingIndex(), dims);
 }
 
 int TrtCommon::getInputBindingIndex() { return engine_->getBindingIndex(input_name_.c_str()); }
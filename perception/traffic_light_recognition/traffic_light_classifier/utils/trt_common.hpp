@@ -110,7 +110,9 @@ Tn::UniquePtr<T> make_unique()
 class TrtCommon
 {
 public:
-  TrtCommon(std::string model_path, std::string cache_dir, std::string precision);
+  TrtCommon(
+    std::string model_path, std::string cache_dir, std::string precision,
+    const int max_batch_size = 1);
   ~TrtCommon() {}
 
   bool loadEngine(std::string engine_file_path);
@@ -118,8 +120,12 @@ public:
   void setup();
 
   bool isInitialized();
+  // number of input and output values of one image of the batch
   int getNumInput();
   int getNumOutput();
+  // 1 unless the input of the model has a dynamic batch size
+  int getMaxBatchSize();
+  bool setBatchSize(const int batch_size);
   int getInputBindingIndex();
   int getOutputBindingIndex();
 
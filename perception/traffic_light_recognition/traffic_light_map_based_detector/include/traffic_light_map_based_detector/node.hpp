@@ -48,6 +48,7 @@
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_routing/RoutingGraph.h>
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+#include <tf2/LinearMath/Transform.h>
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
@@ -81,6 +82,12 @@ private:
     }
   };
 
+  struct RouteTrafficLight
+  {
+    double arc_length;  // [m] start of the route section whose lanelets refer to the light
+    lanelet::ConstLineString3d traffic_light;
+  };
+
 private:
   rclcpp::Subscription<autoware_lanelet2_msgs::msg::MapBin>::SharedPtr map_sub_;
   rclcpp::Subscription<sensor_msgs::msg::CameraInfo>::SharedPtr camera_info_sub_;
@@ -94,8 +101,12 @@ private:
 
   using TrafficLightSet = std::set<lanelet::ConstLineString3d, IdLessThan>;
 
-  std::shared_ptr<TrafficLightSet> all_traffic_lights_ptr_;
-  std::shared_ptr<TrafficLightSet> route_traffic_lights_ptr_;
+  std::shared_ptr<std::vector<lanelet::ConstLineString3d>> all_traffic_lights_ptr_;
+  // sorted by arc_length, a light appears once for each route section which refers to it
+  std::shared_ptr<std::vector<RouteTrafficLight>> route_traffic_lights_ptr_;
+  std::vector<lanelet::ConstLanelets> route_section_lanelets_;
+  std::vector<double> route_section_arc_lengths_;  // [m] start of each section and end of route
+  size_t route_section_hint_;
 
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
@@ -105,8 +116,12 @@ private:
   void mapCallback(const autoware_lanelet2_msgs::msg::MapBin::ConstSharedPtr input_msg);
   void cameraInfoCallback(const sensor_msgs::msg::CameraInfo::ConstSharedPtr input_msg);
   void routeCallback(const autoware_planning_msgs::msg::Route::ConstSharedPtr input_msg);
+  size_t findRouteSection(const geometry_msgs::msg::Pose & camera_pose);
+  std::vector<lanelet::ConstLineString3d> getRouteTrafficLightsAhead(
+    const geometry_msgs::msg::Pose & camera_pose, const double max_distance_range);
   void getVisibleTrafficLights(
-    const TrafficLightSet & all_traffic_lights, const geometry_msgs::msg::Pose & camera_pose,
+    const std::vector<lanelet::ConstLineString3d> & traffic_lights,
+    const geometry_msgs::msg::Pose & camera_pose,
     const image_geometry::PinholeCameraModel & pinhole_camera_model,
     std::vector<lanelet::ConstLineString3d> & visible_traffic_lights);
   bool isInDistanceRange(
@@ -114,14 +129,11 @@ private:
     const double max_distance_range) const;
   bool isInAngleRange(
     const double & tl_yaw, const double & camera_yaw, const double max_angle_range) const;
-  bool isInImageFrame(
-    const image_geometry::PinholeCameraModel & pinhole_camera_model,
-    const geometry_msgs::msg::Point & point) const;
-  bool getTrafficLightRoi(
+  void getTrafficLightRois(
     const geometry_msgs::msg::Pose & camera_pose,
     const image_geometry::PinholeCameraModel & pinhole_camera_model,
-    const lanelet::ConstLineString3d traffic_light, const Config & config,
-    autoware_perception_msgs::msg::TrafficLightRoi & tl_roi);
+    const std::vector<lanelet::ConstLineString3d> & traffic_lights, const Config & config,
+    std::vector<autoware_perception_msgs::msg::TrafficLightRoi> & tl_rois);
   void publishVisibleTrafficLights(
     const geometry_msgs::msg::PoseStamped camera_pose_stamped,
     const std::vector<lanelet::ConstLineString3d> & visible_traffic_lights,
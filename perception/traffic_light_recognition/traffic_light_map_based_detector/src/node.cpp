@@ -42,6 +42,7 @@
 
 #include <lanelet2_core/Exceptions.h>
 #include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/geometry/Lanelet.h>
 #include <lanelet2_core/geometry/Point.h>
 #include <lanelet2_projection/UTM.h>
 #include <lanelet2_routing/RoutingGraphContainer.h>
@@ -49,7 +50,10 @@
 #include <tf2/LinearMath/Matrix3x3.h>
 #include <tf2/LinearMath/Transform.h>
 
+#include <opencv2/calib3d.hpp>
+
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -60,19 +64,46 @@
 
 namespace
 {
-cv::Point2d calcRawImagePointFromPoint3D(
-  const image_geometry::PinholeCameraModel & pinhole_camera_model, const cv::Point3d & point3d)
+constexpr double max_distance_range = 200.0;
+
+tf2::Transform toTransform(const geometry_msgs::msg::Pose & pose)
 {
-  cv::Point2d rectified_image_point = pinhole_camera_model.project3dToPixel(point3d);
-  return pinhole_camera_model.unrectifyPoint(rectified_image_point);
+  return tf2::Transform(
+    tf2::Quaternion(pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w),
+    tf2::Vector3(pose.position.x, pose.position.y, pose.position.z));
 }
 
-cv::Point2d calcRawImagePointFromPoint3D(
+// same as unrectifyPoint(project3dToPixel(point3d)) of each point, with a single distortion call
+std::vector<cv::Point2d> calcRawImagePointsFromPoints3D(
   const image_geometry::PinholeCameraModel & pinhole_camera_model,
-  const geometry_msgs::msg::Point & point3d)
+  const std::vector<cv::Point3d> & points3d)
 {
-  return calcRawImagePointFromPoint3D(
-    pinhole_camera_model, cv::Point3d(point3d.x, point3d.y, point3d.z));
+  std::vector<cv::Point2d> image_points;
+  if (points3d.empty()) {
+    return image_points;
+  }
+
+  std::vector<cv::Point3d> rays;
+  image_points.reserve(points3d.size());
+  rays.reserve(points3d.size());
+  for (const auto & point3d : points3d) {
+    const cv::Point2d rectified_image_point = pinhole_camera_model.project3dToPixel(point3d);
+    image_points.push_back(rectified_image_point);
+    rays.push_back(pinhole_camera_model.projectPixelTo3dRay(rectified_image_point));
+  }
+
+  // rectified points are raw points if the camera has no distortion
+  if (cv::countNonZero(pinhole_camera_model.distortionCoeffs()) == 0) {
+    return image_points;
+  }
+
+  cv::Mat r_vec;
+  cv::Rodrigues(pinhole_camera_model.rotationMatrix().t(), r_vec);
+  const cv::Mat t_vec = cv::Mat_<double>::zeros(3, 1);
+  cv::projectPoints(
+    rays, r_vec, t_vec, pinhole_camera_model.intrinsicMatrix(),
+    pinhole_camera_model.distortionCoeffs(), image_points);
+  return image_points;
 }
 
 void roundInImageFrame(
@@ -91,7 +122,8 @@ namespace traffic_light
 MapBasedDetector::MapBasedDetector(const rclcpp::NodeOptions & node_options)
 : Node("traffic_light_map_based_detector", node_options),
   tf_buffer_(this->get_clock()),
-  tf_listener_(tf_buffer_)
+  tf_listener_(tf_buffer_),
+  route_section_hint_(0)
 {
   using std::placeholders::_1;
 
@@ -151,11 +183,11 @@ void MapBasedDetector::cameraInfoCallback(
    * camera
    */
   std::vector<lanelet::ConstLineString3d> visible_traffic_lights;
-  // If get a route, use only traffic lights on the route.
+  // If get a route, use only traffic lights on the route ahead of the camera.
   if (route_traffic_lights_ptr_ != nullptr) {
     getVisibleTrafficLights(
-      *route_traffic_lights_ptr_, camera_pose_stamped.pose, pinhole_camera_model,
-      visible_traffic_lights);
+      getRouteTrafficLightsAhead(camera_pose_stamped.pose, max_distance_range),
+      camera_pose_stamped.pose, pinhole_camera_model, visible_traffic_lights);
     // If don't get a route, use the traffic lights around ego vehicle.
   } else if (all_traffic_lights_ptr_ != nullptr) {
     getVisibleTrafficLights(
@@ -170,98 +202,87 @@ void MapBasedDetector::cameraInfoCallback(
    * Get the ROI from the lanelet and the intrinsic matrix of camera to determine where it appears
    * in image.
    */
-  for (const auto & traffic_light : visible_traffic_lights) {
-    autoware_perception_msgs::msg::TrafficLightRoi tl_roi;
-    if (!getTrafficLightRoi(
-          camera_pose_stamped.pose, pinhole_camera_model, traffic_light, config_, tl_roi)) {
-      continue;
-    }
-    output_msg.rois.push_back(tl_roi);
-  }
+  getTrafficLightRois(
+    camera_pose_stamped.pose, pinhole_camera_model, visible_traffic_lights, config_,
+    output_msg.rois);
   roi_pub_->publish(output_msg);
   publishVisibleTrafficLights(camera_pose_stamped, visible_traffic_lights, viz_pub_);
 }
 
-bool MapBasedDetector::getTrafficLightRoi(
+void MapBasedDetector::getTrafficLightRois(
   const geometry_msgs::msg::Pose & camera_pose,
   const image_geometry::PinholeCameraModel & pinhole_camera_model,
-  const lanelet::ConstLineString3d traffic_light, const Config & config,
-  autoware_perception_msgs::msg::TrafficLightRoi & tl_roi)
+  const std::vector<lanelet::ConstLineString3d> & traffic_lights, const Config & config,
+  std::vector<autoware_perception_msgs::msg::TrafficLightRoi> & tl_rois)
 {
-  const double tl_height = traffic_light.attributeOr("height", 0.0);
-  const auto & tl_left_down_point = traffic_light.front();
-  const auto & tl_right_down_point = traffic_light.back();
-
-  tf2::Transform tf_map2camera(
-    tf2::Quaternion(
-      camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
-      camera_pose.orientation.w),
-    tf2::Vector3(camera_pose.position.x, camera_pose.position.y, camera_pose.position.z));
-  // id
-  tl_roi.id = traffic_light.id();
-
-  // for roi.x_offset and roi.y_offset
-  {
-    tf2::Transform tf_map2tl(
-      tf2::Quaternion(0, 0, 0, 1),
-      tf2::Vector3(
-        tl_left_down_point.x(), tl_left_down_point.y(), tl_left_down_point.z() + tl_height));
-    tf2::Transform tf_camera2tl;
-    tf_camera2tl = tf_map2camera.inverse() * tf_map2tl;
+  const tf2::Transform tf_camera2map = toTransform(camera_pose).inverse();
+
+  // two corners of each light in camera coordinate, projected at once below
+  std::vector<lanelet::ConstLineString3d> projected_traffic_lights;
+  std::vector<cv::Point3d> corner_points;
+  for (const auto & traffic_light : traffic_lights) {
+    const double tl_height = traffic_light.attributeOr("height", 0.0);
+    const auto & tl_left_down_point = traffic_light.front();
+    const auto & tl_right_down_point = traffic_light.back();
+
+    // for roi.x_offset and roi.y_offset
+    const tf2::Vector3 camera2tl_top_left = tf_camera2map * tf2::Vector3(
+                                                              tl_left_down_point.x(),
+                                                              tl_left_down_point.y(),
+                                                              tl_left_down_point.z() + tl_height);
+    // for roi.width and roi.height
+    const tf2::Vector3 camera2tl_bottom_right =
+      tf_camera2map *
+      tf2::Vector3(tl_right_down_point.x(), tl_right_down_point.y(), tl_right_down_point.z());
+
     // max vibration
-    const double max_vibration_x =
-      std::sin(config.max_vibration_yaw * 0.5) * tf_camera2tl.getOrigin().z() +
-      config.max_vibration_width * 0.5;
-    const double max_vibration_y =
-      std::sin(config.max_vibration_pitch * 0.5) * tf_camera2tl.getOrigin().z() +
-      config.max_vibration_height * 0.5;
-    const double max_vibration_z = config.max_vibration_depth * 0.5;
+    const auto calcMaxVibration = [&config](const tf2::Vector3 & camera2tl) {
+      return tf2::Vector3(
+        std::sin(config.max_vibration_yaw * 0.5) * camera2tl.z() + config.max_vibration_width * 0.5,
+        std::sin(config.max_vibration_pitch * 0.5) * camera2tl.z() +
+          config.max_vibration_height * 0.5,
+        config.max_vibration_depth * 0.5);
+    };
+    const tf2::Vector3 top_left_vibration = calcMaxVibration(camera2tl_top_left);
+    const tf2::Vector3 bottom_right_vibration = calcMaxVibration(camera2tl_bottom_right);
+
     // target position in camera coordinate
-    geometry_msgs::msg::Point point3d;
-    point3d.x = tf_camera2tl.getOrigin().x() - max_vibration_x;
-    point3d.y = tf_camera2tl.getOrigin().y() - max_vibration_y;
-    point3d.z = tf_camera2tl.getOrigin().z() - max_vibration_z;
-    if (point3d.z <= 0.0) {
-      return false;
+    const cv::Point3d top_left_point(
+      camera2tl_top_left.x() - top_left_vibration.x(),
+      camera2tl_top_left.y() - top_left_vibration.y(),
+      camera2tl_top_left.z() - top_left_vibration.z());
+    const cv::Point3d bottom_right_point(
+      camera2tl_bottom_right.x() + bottom_right_vibration.x(),
+      camera2tl_bottom_right.y() + bottom_right_vibration.y(),
+      camera2tl_bottom_right.z() - bottom_right_vibration.z());
+    if (top_left_point.z <= 0.0 || bottom_right_point.z <= 0.0) {
+      continue;
     }
-    cv::Point2d point2d = calcRawImagePointFromPoint3D(pinhole_camera_model, point3d);
-    roundInImageFrame(pinhole_camera_model, point2d);
-    tl_roi.roi.x_offset = point2d.x;
-    tl_roi.roi.y_offset = point2d.y;
+    projected_traffic_lights.push_back(traffic_light);
+    corner_points.push_back(top_left_point);
+    corner_points.push_back(bottom_right_point);
   }
 
-  // for roi.width and roi.height
-  {
-    tf2::Transform tf_map2tl(
-      tf2::Quaternion(0, 0, 0, 1),
-      tf2::Vector3(tl_right_down_point.x(), tl_right_down_point.y(), tl_right_down_point.z()));
-    tf2::Transform tf_camera2tl;
-    tf_camera2tl = tf_map2camera.inverse() * tf_map2tl;
-    // max vibration
-    const double max_vibration_x =
-      std::sin(config.max_vibration_yaw * 0.5) * tf_camera2tl.getOrigin().z() +
-      config.max_vibration_width * 0.5;
-    const double max_vibration_y =
-      std::sin(config.max_vibration_pitch * 0.5) * tf_camera2tl.getOrigin().z() +
-      config.max_vibration_height * 0.5;
-    const double max_vibration_z = config.max_vibration_depth * 0.5;
-    // target position in camera coordinate
-    geometry_msgs::msg::Point point3d;
-    point3d.x = tf_camera2tl.getOrigin().x() + max_vibration_x;
-    point3d.y = tf_camera2tl.getOrigin().y() + max_vibration_y;
-    point3d.z = tf_camera2tl.getOrigin().z() - max_vibration_z;
-    if (point3d.z <= 0.0) {
-      return false;
-    }
-    cv::Point2d point2d = calcRawImagePointFromPoint3D(pinhole_camera_model, point3d);
-    roundInImageFrame(pinhole_camera_model, point2d);
-    tl_roi.roi.width = point2d.x - tl_roi.roi.x_offset;
-    tl_roi.roi.height = point2d.y - tl_roi.roi.y_offset;
+  const auto image_points = calcRawImagePointsFromPoints3D(pinhole_camera_model, corner_points);
+  for (size_t i = 0; i < projected_traffic_lights.size(); ++i) {
+    autoware_perception_msgs::msg::TrafficLightRoi tl_roi;
+    // id
+    tl_roi.id = projected_traffic_lights.at(i).id();
+
+    cv::Point2d top_left_point2d = image_points.at(2 * i);
+    roundInImageFrame(pinhole_camera_model, top_left_point2d);
+    tl_roi.roi.x_offset = top_left_point2d.x;
+    tl_roi.roi.y_offset = top_left_point2d.y;
+
+    cv::Point2d bottom_right_point2d = image_points.at(2 * i + 1);
+    roundInImageFrame(pinhole_camera_model, bottom_right_point2d);
+    tl_roi.roi.width = bottom_right_point2d.x - tl_roi.roi.x_offset;
+    tl_roi.roi.height = bottom_right_point2d.y - tl_roi.roi.y_offset;
     if (tl_roi.roi.width < 1 || tl_roi.roi.height < 1) {
-      return false;
+      continue;
     }
+    tl_rois.push_back(tl_roi);
   }
-  return true;
 }
 
 void MapBasedDetector::mapCallback(
@@ -273,7 +294,7 @@ void MapBasedDetector::mapCallback(
   lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
   std::vector<lanelet::AutowareTrafficLightConstPtr> all_lanelet_traffic_lights =
     lanelet::utils::query::autowareTrafficLights(all_lanelets);
-  all_traffic_lights_ptr_ = std::make_shared<MapBasedDetector::TrafficLightSet>();
+  MapBasedDetector::TrafficLightSet all_traffic_lights;
   for (auto tl_itr = all_lanelet_traffic_lights.begin(); tl_itr != all_lanelet_traffic_lights.end();
        ++tl_itr) {
     lanelet::AutowareTrafficLightConstPtr tl = *tl_itr;
@@ -283,9 +304,11 @@ void MapBasedDetector::mapCallback(
       if (!lsp.isLineString()) {  // traffic lights must be linestrings
         continue;
       }
-      all_traffic_lights_ptr_->insert(static_cast<lanelet::ConstLineString3d>(lsp));
+      all_traffic_lights.insert(static_cast<lanelet::ConstLineString3d>(lsp));
     }
   }
+  all_traffic_lights_ptr_ = std::make_shared<std::vector<lanelet::ConstLineString3d>>(
+    all_traffic_lights.begin(), all_traffic_lights.end());
 }
 
 void MapBasedDetector::routeCallback(
@@ -295,41 +318,136 @@ void MapBasedDetector::routeCallback(
     RCLCPP_WARN(get_logger(), "cannot set traffic light in route because don't receive map");
     return;
   }
-  lanelet::ConstLanelets route_lanelets;
+  // index the traffic lights by the arc length of the route sections which refer to them
+  std::vector<lanelet::ConstLanelets> route_section_lanelets;
+  std::vector<double> route_section_arc_lengths{0.0};
+  auto route_traffic_lights = std::make_shared<std::vector<RouteTrafficLight>>();
   for (const auto & route_section : input_msg->route_sections) {
+    lanelet::ConstLanelets section_lanelets;
+    double section_length = 0.0;
     for (const auto & lane_id : route_section.lane_ids) {
       try {
-        route_lanelets.push_back(lanelet_map_ptr_->laneletLayer.get(lane_id));
+        section_lanelets.push_back(lanelet_map_ptr_->laneletLayer.get(lane_id));
       } catch (const lanelet::NoSuchPrimitiveError & ex) {
         RCLCPP_ERROR(get_logger(), "%s", ex.what());
         return;
       }
+      if (lane_id == route_section.preferred_lane_id) {
+        section_length = lanelet::utils::getLaneletLength2d(section_lanelets.back());
+      }
+    }
+    if (section_lanelets.empty()) {
+      continue;
+    }
+    if (section_length == 0.0) {
+      section_length = lanelet::utils::getLaneletLength2d(section_lanelets.front());
+    }
+
+    MapBasedDetector::TrafficLightSet section_traffic_lights;
+    for (const auto & tl : lanelet::utils::query::autowareTrafficLights(section_lanelets)) {
+      auto lights = tl->trafficLights();
+      for (auto lsp : lights) {
+        if (!lsp.isLineString()) {  // traffic lights must be linestrings
+          continue;
+        }
+        section_traffic_lights.insert(static_cast<lanelet::ConstLineString3d>(lsp));
+      }
     }
+    for (const auto & traffic_light : section_traffic_lights) {
+      route_traffic_lights->push_back({route_section_arc_lengths.back(), traffic_light});
+    }
+
+    route_section_lanelets.push_back(section_lanelets);
+    route_section_arc_lengths.push_back(route_section_arc_lengths.back() + section_length);
   }
-  std::vector<lanelet::AutowareTrafficLightConstPtr> route_lanelet_traffic_lights =
-    lanelet::utils::query::autowareTrafficLights(route_lanelets);
-  route_traffic_lights_ptr_ = std::make_shared<MapBasedDetector::TrafficLightSet>();
-  for (auto tl_itr = route_lanelet_traffic_lights.begin();
-       tl_itr != route_lanelet_traffic_lights.end(); ++tl_itr) {
-    lanelet::AutowareTrafficLightConstPtr tl = *tl_itr;
 
-    auto lights = tl->trafficLights();
-    for (auto lsp : lights) {
-      if (!lsp.isLineString()) {  // traffic lights must be linestrings
-        continue;
+  route_section_lanelets_ = route_section_lanelets;
+  route_section_arc_lengths_ = route_section_arc_lengths;
+  route_section_hint_ = 0;
+  route_traffic_lights_ptr_ = route_traffic_lights;
+}
+
+size_t MapBasedDetector::findRouteSection(const geometry_msgs::msg::Pose & camera_pose)
+{
+  const lanelet::BasicPoint2d point(camera_pose.position.x, camera_pose.position.y);
+
+  // the camera mostly stays in the section of the previous frame or moves to the next ones
+  constexpr size_t search_window = 5;
+  const size_t window_end =
+    std::min(route_section_hint_ + search_window, route_section_lanelets_.size());
+  for (size_t i = route_section_hint_; i < window_end; ++i) {
+    for (const auto & lanelet : route_section_lanelets_.at(i)) {
+      if (lanelet::geometry::inside(lanelet, point)) {
+        route_section_hint_ = i;
+        return i;
       }
-      route_traffic_lights_ptr_->insert(static_cast<lanelet::ConstLineString3d>(lsp));
     }
   }
+
+  // otherwise take the closest section of the whole route
+  double min_distance = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < route_section_lanelets_.size(); ++i) {
+    for (const auto & lanelet : route_section_lanelets_.at(i)) {
+      const double distance = lanelet::geometry::distance2d(lanelet, point);
+      if (distance < min_distance) {
+        min_distance = distance;
+        route_section_hint_ = i;
+      }
+    }
+  }
+  return route_section_hint_;
+}
+
+std::vector<lanelet::ConstLineString3d> MapBasedDetector::getRouteTrafficLightsAhead(
+  const geometry_msgs::msg::Pose & camera_pose, const double max_distance_range)
+{
+  std::vector<lanelet::ConstLineString3d> traffic_lights;
+  if (route_section_lanelets_.empty()) {
+    return traffic_lights;
+  }
+
+  // the lights of the current section and of the sections within range after it
+  const size_t section = findRouteSection(camera_pose);
+  const double begin_arc_length = route_section_arc_lengths_.at(section);
+  const double end_arc_length = route_section_arc_lengths_.at(section + 1) + max_distance_range;
+  auto itr = std::lower_bound(
+    route_traffic_lights_ptr_->begin(), route_traffic_lights_ptr_->end(), begin_arc_length,
+    [](const RouteTrafficLight & traffic_light, const double arc_length) {
+      return traffic_light.arc_length < arc_length;
+    });
+
+  MapBasedDetector::TrafficLightSet added_traffic_lights;
+  for (; itr != route_traffic_lights_ptr_->end() && itr->arc_length <= end_arc_length; ++itr) {
+    if (added_traffic_lights.insert(itr->traffic_light).second) {
+      traffic_lights.push_back(itr->traffic_light);
+    }
+  }
+  return traffic_lights;
 }
 
 void MapBasedDetector::getVisibleTrafficLights(
-  const MapBasedDetector::TrafficLightSet & all_traffic_lights,
+  const std::vector<lanelet::ConstLineString3d> & traffic_lights,
   const geometry_msgs::msg::Pose & camera_pose,
   const image_geometry::PinholeCameraModel & pinhole_camera_model,
   std::vector<lanelet::ConstLineString3d> & visible_traffic_lights)
 {
-  for (const auto & traffic_light : all_traffic_lights) {
+  const tf2::Transform tf_map2camera = toTransform(camera_pose);
+  const tf2::Transform tf_camera2map = tf_map2camera.inverse();
+
+  // get direction of z axis
+  const tf2::Vector3 camera_z_dir = tf_map2camera.getBasis() * tf2::Vector3(0, 0, 1);
+  const double camera_yaw =
+    autoware_utils::normalizeRadian(std::atan2(camera_z_dir.y(), camera_z_dir.x()));
+  constexpr double max_angle_range = autoware_utils::deg2rad(40.0);
+
+  // frustum of the rectified image with a margin, since the distortion moves the points
+  const double image_width = pinhole_camera_model.cameraInfo().width;
+  const double image_height = pinhole_camera_model.cameraInfo().height;
+  constexpr double frustum_margin_ratio = 0.5;
+
+  std::vector<lanelet::ConstLineString3d> candidate_traffic_lights;
+  std::vector<cv::Point3d> camera2tl_points;
+  for (const auto & traffic_light : traffic_lights) {
     const auto & tl_left_down_point = traffic_light.front();
     const auto & tl_right_down_point = traffic_light.back();
     const double tl_height = traffic_light.attributeOr("height", 0.0);
@@ -339,7 +457,6 @@ void MapBasedDetector::getVisibleTrafficLights(
     tl_central_point.x = (tl_right_down_point.x() + tl_left_down_point.x()) / 2.0;
     tl_central_point.y = (tl_right_down_point.y() + tl_left_down_point.y()) / 2.0;
     tl_central_point.z = (tl_right_down_point.z() + tl_left_down_point.z() + tl_height) / 2.0;
-    constexpr double max_distance_range = 200.0;
     if (!isInDistanceRange(tl_central_point, camera_pose.position, max_distance_range)) {
       continue;
     }
@@ -350,40 +467,37 @@ void MapBasedDetector::getVisibleTrafficLights(
         tl_right_down_point.y() - tl_left_down_point.y(),
         tl_right_down_point.x() - tl_left_down_point.x()) +
       M_PI_2);
-    constexpr double max_angle_range = autoware_utils::deg2rad(40.0);
-
-    // get direction of z axis
-    tf2::Vector3 camera_z_dir(0, 0, 1);
-    tf2::Matrix3x3 camera_rotation_matrix(tf2::Quaternion(
-      camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
-      camera_pose.orientation.w));
-    camera_z_dir = camera_rotation_matrix * camera_z_dir;
-    double camera_yaw = std::atan2(camera_z_dir.y(), camera_z_dir.x());
-    camera_yaw = autoware_utils::normalizeRadian(camera_yaw);
     if (!isInAngleRange(tl_yaw, camera_yaw, max_angle_range)) {
       continue;
     }
 
-    // check within image frame
-    tf2::Transform tf_map2camera(
-      tf2::Quaternion(
-        camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
-        camera_pose.orientation.w),
-      tf2::Vector3(camera_pose.position.x, camera_pose.position.y, camera_pose.position.z));
-    tf2::Transform tf_map2tl(
-      tf2::Quaternion(0, 0, 0, 1),
-      tf2::Vector3(tl_central_point.x, tl_central_point.y, tl_central_point.z));
-    tf2::Transform tf_camera2tl;
-    tf_camera2tl = tf_map2camera.inverse() * tf_map2tl;
-
-    geometry_msgs::msg::Point camera2tl_point;
-    camera2tl_point.x = tf_camera2tl.getOrigin().x();
-    camera2tl_point.y = tf_camera2tl.getOrigin().y();
-    camera2tl_point.z = tf_camera2tl.getOrigin().z();
-    if (!isInImageFrame(pinhole_camera_model, camera2tl_point)) {
+    // check within camera frustum
+    const tf2::Vector3 camera2tl =
+      tf_camera2map * tf2::Vector3(tl_central_point.x, tl_central_point.y, tl_central_point.z);
+    if (camera2tl.z() <= 0.0) {
       continue;
     }
-    visible_traffic_lights.push_back(traffic_light);
+    const cv::Point3d camera2tl_point(camera2tl.x(), camera2tl.y(), camera2tl.z());
+    const cv::Point2d rectified_point2d = pinhole_camera_model.project3dToPixel(camera2tl_point);
+    if (
+      rectified_point2d.x < -image_width * frustum_margin_ratio ||
+      rectified_point2d.x > image_width * (1.0 + frustum_margin_ratio) ||
+      rectified_point2d.y < -image_height * frustum_margin_ratio ||
+      rectified_point2d.y > image_height * (1.0 + frustum_margin_ratio)) {
+      continue;
+    }
+    candidate_traffic_lights.push_back(traffic_light);
+    camera2tl_points.push_back(camera2tl_point);
+  }
+
+  // check within image frame
+  const auto point2ds = calcRawImagePointsFromPoints3D(pinhole_camera_model, camera2tl_points);
+  for (size_t i = 0; i < candidate_traffic_lights.size(); ++i) {
+    const auto & point2d = point2ds.at(i);
+    if (
+      0 <= point2d.x && point2d.x < image_width && 0 <= point2d.y && point2d.y < image_height) {
+      visible_traffic_lights.push_back(candidate_traffic_lights.at(i));
+    }
   }
 }
 
@@ -406,23 +520,6 @@ bool MapBasedDetector::isInAngleRange(
   return std::fabs(diff_angle) < max_angle_range;
 }
 
-bool MapBasedDetector::isInImageFrame(
-  const image_geometry::PinholeCameraModel & pinhole_camera_model,
-  const geometry_msgs::msg::Point & point) const
-{
-  if (point.z <= 0.0) {
-    return false;
-  }
-
-  cv::Point2d point2d = calcRawImagePointFromPoint3D(pinhole_camera_model, point);
-  if (0 <= point2d.x && point2d.x < pinhole_camera_model.cameraInfo().width) {
-    if (0 <= point2d.y && point2d.y < pinhole_camera_model.cameraInfo().height) {
-      return true;
-    }
-  }
-  return false;
-}
-
 void MapBasedDetector::publishVisibleTrafficLights(
   const geometry_msgs::msg::PoseStamped camera_pose_stamped,
   const std::vector<lanelet::ConstLineString3d> & visible_traffic_lights,
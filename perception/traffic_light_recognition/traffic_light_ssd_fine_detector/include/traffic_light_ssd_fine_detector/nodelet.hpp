@@ -15,10 +15,15 @@
 #ifndef TRAFFIC_LIGHT_SSD_FINE_DETECTOR__NODELET_HPP_
 #define TRAFFIC_LIGHT_SSD_FINE_DETECTOR__NODELET_HPP_
 
+#include "traffic_light_ssd_fine_detector/roi_tracker.hpp"
+
 #include <image_transport/image_transport.hpp>
 #include <image_transport/subscriber_filter.hpp>
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
+#include <cuda_utils.hpp>
+#include <postprocess.hpp>
+#include <preprocess.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <trt_ssd.hpp>
 
@@ -27,6 +32,8 @@
 #include <sensor_msgs/image_encodings.hpp>
 #include <sensor_msgs/msg/image.hpp>
 
+#include <boost/optional.hpp>
+
 #include <cv_bridge/cv_bridge.h>
 #include <message_filters/subscriber.h>
 #include <message_filters/sync_policies/approximate_time.h>
@@ -58,11 +65,16 @@ public:
       traffic_light_roi_msg);
 
 private:
-  bool cvMat2CnnInput(
-    const std::vector<cv::Mat> & in_imgs, const int num_rois, std::vector<float> & data);
-  bool cnnOutput2BoxDetection(
-    const float * scores, const float * boxes, const int tlr_id,
-    const std::vector<cv::Mat> & in_imgs, const int num_rois, std::vector<Detection> & detections);
+  // Grow the staging buffers of the image and of the per roi data when needed
+  void reserveBuffers(const size_t image_size, const int num_rois);
+  // Run the fine detector on the rough rois of detect_indices, and restart their tracks
+  bool detect(
+    const cv::Mat & original_image, const std::vector<cv::Rect> & rough_rois,
+    const std::vector<int> & detect_indices, const std::vector<int32_t> & ids,
+    std::vector<boost::optional<cv::Rect>> & fine_rois);
+  void cnnOutput2BoxDetection(
+    const ssd::TopDetection * top_detections, const std::vector<cv::Size> & roi_sizes,
+    std::vector<Detection> & detections);
   bool rosMsg2CvMat(const sensor_msgs::msg::Image::ConstSharedPtr image_msg, cv::Mat & image);
   bool fitInFrame(cv::Point & lt, cv::Point & rb, const cv::Size & size);
   void cvRect2TlRoiMsg(
@@ -106,6 +118,23 @@ private:
   std::vector<float> std_;
 
   std::unique_ptr<ssd::Net> net_ptr_;
+
+  bool use_roi_tracking_;
+  std::unique_ptr<RoiTracker> roi_tracker_;
+  rclcpp::Time prev_image_stamp_{0, 0, RCL_ROS_TIME};
+
+  // device buffers of the inference, sized for the max batch
+  cuda::unique_ptr<float[]> data_d_;
+  cuda::unique_ptr<float[]> scores_d_;
+  cuda::unique_ptr<float[]> boxes_d_;
+  size_t image_capacity_;
+  cuda::unique_ptr_host<uint8_t[]> image_h_;
+  cuda::unique_ptr<uint8_t[]> image_d_;
+  size_t rois_capacity_;
+  cuda::unique_ptr_host<ssd::Roi[]> rois_h_;
+  cuda::unique_ptr<ssd::Roi[]> rois_d_;
+  cuda::unique_ptr_host<ssd::TopDetection[]> detections_h_;
+  cuda::unique_ptr<ssd::TopDetection[]> detections_d_;
 };  // TrafficLightSSDFineDetectorNodelet
 
 }  // namespace traffic_light
@@ -0,0 +1,76 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRAFFIC_LIGHT_SSD_FINE_DETECTOR__ROI_TRACKER_HPP_
+#define TRAFFIC_LIGHT_SSD_FINE_DETECTOR__ROI_TRACKER_HPP_
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace traffic_light
+{
+/**
+ * @brief Tracks the fine rois of the traffic lights over the frames by template matching, so that
+ * the fine detector runs only for the new and the lost rois and every redetect_interval frames.
+ * The rough rois are projected from the map with the ego pose of each frame, so the motion of
+ * a rough roi is used as the motion of the traffic light in the image.
+ */
+class RoiTracker
+{
+public:
+  struct Param
+  {
+    double score_thresh;      // minimum normalized correlation of a tracked roi [-]
+    int redetect_interval;    // a roi is detected again after this number of tracked frames [-]
+    int search_margin;        // margin of the search window around the predicted roi [px]
+    double max_scale_change;  // a roi is detected again when its rough roi is scaled more [-]
+  };
+
+  explicit RoiTracker(const Param & param) : param_(param) {}
+
+  /**
+   * @brief find the fine roi of id in image, by the template of its last detection
+   * @return false if the roi has to be detected by the fine detector
+   */
+  bool track(
+    const cv::Mat & image, const int32_t id, const cv::Rect & rough_roi, cv::Rect & fine_roi);
+
+  // start the track of id from the fine roi found by the detector
+  void update(
+    const cv::Mat & image, const int32_t id, const cv::Rect & rough_roi, const cv::Rect & fine_roi);
+
+  void erase(const int32_t id) { tracks_.erase(id); }
+  // remove the tracks of the rois that are not in ids
+  void eraseExcept(const std::vector<int32_t> & ids);
+  void clear() { tracks_.clear(); }
+
+private:
+  struct Track
+  {
+    cv::Rect rough_roi;
+    cv::Rect fine_roi;
+    cv::Mat templ;  // gray image of the fine roi at the last detection
+    int num_tracked_frames;
+  };
+
+  Param param_;
+  std::unordered_map<int32_t, Track> tracks_;
+};
+
+}  // namespace traffic_light
+
+#endif  // TRAFFIC_LIGHT_SSD_FINE_DETECTOR__ROI_TRACKER_HPP_
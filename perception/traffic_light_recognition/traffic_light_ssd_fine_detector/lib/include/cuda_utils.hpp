@@ -70,6 +70,25 @@ cuda::unique_ptr<T> make_unique()
   CHECK_CUDA_ERROR(::cudaMalloc(reinterpret_cast<void **>(&p), sizeof(T)));
   return cuda::unique_ptr<T>{p};
 }
+
+struct host_deleter
+{
+  void operator()(void * p) const { CHECK_CUDA_ERROR(::cudaFreeHost(p)); }
+};
+template <typename T>
+using unique_ptr_host = std::unique_ptr<T, host_deleter>;
+
+// page-locked host memory, for asynchronous copies
+// auto array = cuda::make_unique_host<float[]>(n);
+template <typename T>
+typename std::enable_if<std::is_array<T>::value, cuda::unique_ptr_host<T>>::type make_unique_host(
+  const std::size_t n)
+{
+  using U = typename std::remove_extent<T>::type;
+  U * p;
+  CHECK_CUDA_ERROR(::cudaMallocHost(reinterpret_cast<void **>(&p), sizeof(U) * n));
+  return cuda::unique_ptr_host<T>{p};
+}
 }  // namespace cuda
 
 #endif  // CUDA_UTILS_HPP_
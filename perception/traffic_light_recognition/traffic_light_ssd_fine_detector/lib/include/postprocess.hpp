@@ -0,0 +1,41 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef POSTPROCESS_HPP_
+#define POSTPROCESS_HPP_
+
+#include <./cuda_runtime_api.h>
+
+namespace ssd
+{
+// Highest scoring box of a class, normalized by the size of the roi
+struct TopDetection
+{
+  float score;
+  float x_min;
+  float y_min;
+  float x_max;
+  float y_max;
+};
+
+// Pick the box with the highest score of class_id for each image of the batch, from scores of
+// [batch, num_detections, num_classes] and boxes of [batch, num_detections, 4]
+cudaError_t selectTopDetections_launch(
+  const float * scores, const float * boxes, const int batch_size, const int num_detections,
+  const int num_classes, const int class_id, TopDetection * detections, cudaStream_t stream);
+
+}  // namespace ssd
+
+#endif  // POSTPROCESS_HPP_
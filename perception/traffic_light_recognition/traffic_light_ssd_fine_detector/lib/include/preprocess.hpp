@@ -0,0 +1,43 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef PREPROCESS_HPP_
+#define PREPROCESS_HPP_
+
+#include <./cuda_runtime_api.h>
+
+#include <cstdint>
+
+namespace ssd
+{
+// Region of the image in pixels
+struct Roi
+{
+  int x;
+  int y;
+  int width;
+  int height;
+};
+
+// Crop the rois of an RGB8 image and resize them with bilinear interpolation into a batch of
+// normalized BGR planes (NCHW): (value / 255 - mean) / std
+cudaError_t cropResizeNormalize_launch(
+  const uint8_t * image, const int image_step, const Roi * rois, const int num_rois,
+  const int dst_width, const int dst_height, const float3 mean, const float3 std, float * dst,
+  cudaStream_t stream);
+
+}  // namespace ssd
+
+#endif  // PREPROCESS_HPP_
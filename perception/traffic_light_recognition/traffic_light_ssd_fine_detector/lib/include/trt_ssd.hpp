@@ -71,9 +71,19 @@ public:
   // Save model to path
   void save(const std::string & path);
 
+  // Run on a stream of the priority, lower numbers are higher priorities. The priority is clamped
+  // to the range of the device.
+  void setStreamPriority(const int priority);
+
   // Infer using pre-allocated GPU buffers {data, scores, boxes}
   void infer(std::vector<void *> & buffers, const int batch_size);
 
+  // Same as infer, without waiting for the stream
+  void enqueue(std::vector<void *> & buffers, const int batch_size);
+
+  // Stream the inference runs on, to order the pre and post processing with it
+  cudaStream_t getStream() const { return stream_; }
+
   // Get (c, h, w) size of the fixed input
   std::vector<int> getInputSize();
 
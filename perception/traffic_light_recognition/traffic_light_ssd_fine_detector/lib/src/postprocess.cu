@@ -0,0 +1,82 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <postprocess.hpp>
+
+namespace ssd
+{
+constexpr int THREADS_PER_BLOCK = 256;
+
+// one block per image, each thread scans a stride of the detections and the block reduces
+__global__ void selectTopDetectionsKernel(
+  const float * scores, const float * boxes, const int num_detections, const int num_classes,
+  const int class_id, TopDetection * detections)
+{
+  __shared__ float best_scores[THREADS_PER_BLOCK];
+  __shared__ int best_indices[THREADS_PER_BLOCK];
+
+  const float * image_scores = scores + blockIdx.x * num_detections * num_classes;
+  float best_score = -1.0f;
+  int best_index = -1;
+  for (int i = threadIdx.x; i < num_detections; i += blockDim.x) {
+    const float score = image_scores[i * num_classes + class_id];
+    if (best_index < 0 || score > best_score) {
+      best_score = score;
+      best_index = i;
+    }
+  }
+  best_scores[threadIdx.x] = best_score;
+  best_indices[threadIdx.x] = best_index;
+  __syncthreads();
+
+  for (int stride = blockDim.x / 2; stride > 0; stride /= 2) {
+    if (threadIdx.x < stride) {
+      const float other_score = best_scores[threadIdx.x + stride];
+      const int other_index = best_indices[threadIdx.x + stride];
+      // ties are resolved to the first detection, as std::max_element does
+      const bool is_better =
+        other_index >= 0 &&
+        (best_indices[threadIdx.x] < 0 || other_score > best_scores[threadIdx.x] ||
+         (other_score == best_scores[threadIdx.x] && other_index < best_indices[threadIdx.x]));
+      if (is_better) {
+        best_scores[threadIdx.x] = other_score;
+        best_indices[threadIdx.x] = other_index;
+      }
+    }
+    __syncthreads();
+  }
+
+  if (threadIdx.x == 0) {
+    TopDetection & detection = detections[blockIdx.x];
+    const int index = max(best_indices[0], 0);
+    const float * box = boxes + (blockIdx.x * num_detections + index) * 4;
+    detection.score = best_scores[0];
+    detection.x_min = box[0];
+    detection.y_min = box[1];
+    detection.x_max = box[2];
+    detection.y_max = box[3];
+  }
+}
+
+cudaError_t selectTopDetections_launch(
+  const float * scores, const float * boxes, const int batch_size, const int num_detections,
+  const int num_classes, const int class_id, TopDetection * detections, cudaStream_t stream)
+{
+  selectTopDetectionsKernel<<<batch_size, THREADS_PER_BLOCK, 0, stream>>>(
+    scores, boxes, num_detections, num_classes, class_id, detections);
+  return cudaGetLastError();
+}
+
+}  // namespace ssd
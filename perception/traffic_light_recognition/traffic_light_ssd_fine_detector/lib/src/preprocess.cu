@@ -0,0 +1,73 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <preprocess.hpp>
+
+namespace ssd
+{
+__global__ void cropResizeNormalizeKernel(
+  const uint8_t * image, const int image_step, const Roi * rois, const int dst_width,
+  const int dst_height, const float3 mean, const float3 std, float * dst)
+{
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int y = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= dst_width || y >= dst_height) {
+    return;
+  }
+  const Roi roi = rois[blockIdx.z];
+  const int channel_size = dst_width * dst_height;
+  float * dst_pixel = dst + blockIdx.z * 3 * channel_size + y * dst_width + x;
+
+  // pixel centers are aligned and the roi border is replicated, as in cv::resize
+  const float src_x = fminf(
+    fmaxf((x + 0.5f) * roi.width / dst_width - 0.5f, 0.0f), static_cast<float>(roi.width - 1));
+  const float src_y = fminf(
+    fmaxf((y + 0.5f) * roi.height / dst_height - 0.5f, 0.0f), static_cast<float>(roi.height - 1));
+  const int x0 = static_cast<int>(src_x);
+  const int y0 = static_cast<int>(src_y);
+  const int x1 = min(x0 + 1, roi.width - 1);
+  const int y1 = min(y0 + 1, roi.height - 1);
+  const float ax = src_x - x0;
+  const float ay = src_y - y0;
+
+  const uint8_t * row0 = image + (roi.y + y0) * image_step + roi.x * 3;
+  const uint8_t * row1 = image + (roi.y + y1) * image_step + roi.x * 3;
+  const float means[3] = {mean.x, mean.y, mean.z};
+  const float stds[3] = {std.x, std.y, std.z};
+  for (int c = 0; c < 3; ++c) {
+    // RGB to BGR
+    const int src_c = 2 - c;
+    const float top = row0[x0 * 3 + src_c] + (row0[x1 * 3 + src_c] - row0[x0 * 3 + src_c]) * ax;
+    const float bottom =
+      row1[x0 * 3 + src_c] + (row1[x1 * 3 + src_c] - row1[x0 * 3 + src_c]) * ax;
+    const float value = (top + (bottom - top) * ay) * (1.0f / 255.0f);
+    dst_pixel[c * channel_size] = (value - means[c]) / stds[c];
+  }
+}
+
+cudaError_t cropResizeNormalize_launch(
+  const uint8_t * image, const int image_step, const Roi * rois, const int num_rois,
+  const int dst_width, const int dst_height, const float3 mean, const float3 std, float * dst,
+  cudaStream_t stream)
+{
+  const dim3 threads(32, 8);
+  const dim3 blocks(
+    (dst_width + threads.x - 1) / threads.x, (dst_height + threads.y - 1) / threads.y, num_rois);
+  cropResizeNormalizeKernel<<<blocks, threads, 0, stream>>>(
+    image, image_step, rois, dst_width, dst_height, mean, std, dst);
+  return cudaGetLastError();
+}
+
+}  // namespace ssd
@@ -146,6 +146,16 @@ Net::Net(
     std::cout << "Fail to create context" << std::endl;
     return;
   }
+  cudaStreamCreate(&stream_);
+}
+
+void Net::setStreamPriority(const int priority)
+{
+  if (stream_) {
+    cudaStreamSynchronize(stream_);
+    cudaStreamDestroy(stream_);
+  }
+  cudaStreamCreateWithPriority(&stream_, cudaStreamDefault, priority);
 }
 
 void Net::save(const std::string & path)
@@ -157,6 +167,12 @@ void Net::save(const std::string & path)
 }
 
 void Net::infer(std::vector<void *> & buffers, const int batch_size)
+{
+  enqueue(buffers, batch_size);
+  cudaStreamSynchronize(stream_);
+}
+
+void Net::enqueue(std::vector<void *> & buffers, const int batch_size)
 {
   if (!context_) {
     throw std::runtime_error("Fail to create context");
@@ -164,8 +180,9 @@ void Net::infer(std::vector<void *> & buffers, const int batch_size)
   auto input_dims = engine_->getBindingDimensions(0);
   context_->setBindingDimensions(
     0, nvinfer1::Dims4(batch_size, input_dims.d[1], input_dims.d[2], input_dims.d[3]));
-  context_->enqueueV2(buffers.data(), stream_, nullptr);
-  cudaStreamSynchronize(stream_);
+  if (!context_->enqueueV2(buffers.data(), stream_, nullptr)) {
+    throw std::runtime_error("Fail to enqueue inference");
+  }
 }
 
 std::vector<int> Net::getInputSize()
@@ -16,7 +16,10 @@
 
 #include <ament_index_cpp/get_package_share_directory.hpp>
 #include <cuda_utils.hpp>
+#include <postprocess.hpp>
+#include <preprocess.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -24,6 +27,12 @@
 
 namespace traffic_light
 {
+namespace
+{
+// the tracks are not continued over a longer gap between the images
+constexpr double max_tracking_time_gap = 0.5;
+}  // namespace
+
 inline std::vector<float> toFloatVector(const std::vector<double> double_vector)
 {
   return std::vector<float>(double_vector.begin(), double_vector.end());
@@ -73,11 +82,21 @@ TrafficLightSSDFineDetectorNodelet::TrafficLightSSDFineDetectorNodelet(
     net_ptr_.reset(new ssd::Net(onnx_file, mode, max_batch_size));
     net_ptr_->save(engine_path);
   }
+  // below the lidar detectors, above the other camera networks
+  net_ptr_->setStreamPriority(this->declare_parameter("stream_priority", -1));
   is_approximate_sync_ = this->declare_parameter<bool>("approximate_sync", false);
   score_thresh_ = this->declare_parameter<double>("score_thresh", 0.7);
   mean_ = toFloatVector(this->declare_parameter("mean", std::vector<double>({0.5, 0.5, 0.5})));
   std_ = toFloatVector(this->declare_parameter("std", std::vector<double>({0.5, 0.5, 0.5})));
 
+  use_roi_tracking_ = this->declare_parameter("use_roi_tracking", true);
+  RoiTracker::Param tracker_param;
+  tracker_param.score_thresh = this->declare_parameter("tracking_score_thresh", 0.8);
+  tracker_param.redetect_interval = this->declare_parameter("tracking_redetect_interval", 10);
+  tracker_param.search_margin = this->declare_parameter("tracking_search_margin", 8);
+  tracker_param.max_scale_change = this->declare_parameter("tracking_max_scale_change", 0.1);
+  roi_tracker_.reset(new RoiTracker(tracker_param));
+
   auto timer_callback = std::bind(&TrafficLightSSDFineDetectorNodelet::connectCb, this);
   const auto period_s = 0.1;
   const auto period_ns =
@@ -106,6 +125,15 @@ TrafficLightSSDFineDetectorNodelet::TrafficLightSSDFineDetectorNodelet(
   height_ = net_ptr_->getInputSize()[2];
   detection_per_class_ = net_ptr_->getOutputScoreSize()[0];
   class_num_ = net_ptr_->getOutputScoreSize()[1];
+
+  // allocated once for the largest batch instead of on every callback
+  const int engine_batch_size = net_ptr_->getMaxBatchSize();
+  data_d_ = cuda::make_unique<float[]>(engine_batch_size * channel_ * width_ * height_);
+  scores_d_ = cuda::make_unique<float[]>(engine_batch_size * detection_per_class_ * class_num_);
+  boxes_d_ = cuda::make_unique<float[]>(engine_batch_size * detection_per_class_ * 4);
+  image_capacity_ = 0;
+  rois_capacity_ = 0;
+  reserveBuffers(0, engine_batch_size);
 }
 
 void TrafficLightSSDFineDetectorNodelet::connectCb()
@@ -134,77 +162,58 @@ void TrafficLightSSDFineDetectorNodelet::callback(
   cv::Mat original_image;
   autoware_perception_msgs::msg::TrafficLightRoiArray out_rois;
 
-  rosMsg2CvMat(in_image_msg, original_image);
-  int num_rois = in_roi_msg->rois.size();
-  int batch_count = 0;
-  const int batch_size = net_ptr_->getMaxBatchSize();
-  while (num_rois != 0) {
-    const int num_infer = (num_rois / batch_size > 0) ? batch_size : num_rois % batch_size;
-    auto data_d = cuda::make_unique<float[]>(num_infer * channel_ * width_ * height_);
-    auto scores_d = cuda::make_unique<float[]>(num_infer * detection_per_class_ * class_num_);
-    auto boxes_d = cuda::make_unique<float[]>(num_infer * detection_per_class_ * 4);
-    std::vector<void *> buffers = {data_d.get(), scores_d.get(), boxes_d.get()};
-    std::vector<cv::Point> lts, rbs;
-    std::vector<cv::Mat> cropped_imgs;
-
-    for (int i = 0; i < num_infer; ++i) {
-      int roi_index = i + batch_count * batch_size;
-      lts.push_back(cv::Point(
-        in_roi_msg->rois.at(roi_index).roi.x_offset, in_roi_msg->rois.at(roi_index).roi.y_offset));
-      rbs.push_back(cv::Point(
-        in_roi_msg->rois.at(roi_index).roi.x_offset + in_roi_msg->rois.at(roi_index).roi.width,
-        in_roi_msg->rois.at(roi_index).roi.y_offset + in_roi_msg->rois.at(roi_index).roi.height));
-      fitInFrame(lts.at(i), rbs.at(i), cv::Size(original_image.size()));
-      cropped_imgs.push_back(cv::Mat(original_image, cv::Rect(lts.at(i), rbs.at(i))));
-    }
-
-    std::vector<float> data(num_infer * channel_ * width_ * height_);
-    if (!cvMat2CnnInput(cropped_imgs, num_infer, data)) {
-      RCLCPP_ERROR(this->get_logger(), "Fail to preprocess image");
-      return;
-    }
-
-    cudaMemcpy(data_d.get(), data.data(), data.size() * sizeof(float), cudaMemcpyHostToDevice);
+  if (!rosMsg2CvMat(in_image_msg, original_image)) {
+    return;
+  }
+  const int num_rois = in_roi_msg->rois.size();
+  if (num_rois > 0 && tlr_id_ > class_num_ - 1) {
+    RCLCPP_ERROR(this->get_logger(), "Fail to postprocess image");
+    return;
+  }
 
-    try {
-      net_ptr_->infer(buffers, num_infer);
-    } catch (std::exception & e) {
-      RCLCPP_ERROR(this->get_logger(), "%s", e.what());
-      return;
-    }
+  const rclcpp::Time stamp = in_image_msg->header.stamp;
+  const double time_gap = (stamp - prev_image_stamp_).seconds();
+  if (!use_roi_tracking_ || time_gap < 0.0 || max_tracking_time_gap < time_gap) {
+    roi_tracker_->clear();
+  }
+  prev_image_stamp_ = stamp;
+
+  std::vector<int32_t> ids;
+  std::vector<cv::Rect> rough_rois;
+  for (const auto & tl_roi : in_roi_msg->rois) {
+    const auto & roi = tl_roi.roi;
+    cv::Point lt(roi.x_offset, roi.y_offset);
+    cv::Point rb(roi.x_offset + roi.width, roi.y_offset + roi.height);
+    fitInFrame(lt, rb, cv::Size(original_image.size()));
+    ids.push_back(tl_roi.id);
+    rough_rois.emplace_back(lt, rb);
+  }
+  roi_tracker_->eraseExcept(ids);
 
-    auto scores = std::make_unique<float[]>(num_infer * detection_per_class_ * class_num_);
-    auto boxes = std::make_unique<float[]>(num_infer * detection_per_class_ * 4);
-    cudaMemcpy(
-      scores.get(), scores_d.get(), sizeof(float) * num_infer * detection_per_class_ * class_num_,
-      cudaMemcpyDeviceToHost);
-    cudaMemcpy(
-      boxes.get(), boxes_d.get(), sizeof(float) * num_infer * detection_per_class_ * 4,
-      cudaMemcpyDeviceToHost);
-    // Get Output
-    std::vector<Detection> detections;
-    if (!cnnOutput2BoxDetection(
-          scores.get(), boxes.get(), tlr_id_, cropped_imgs, num_infer, detections)) {
-      RCLCPP_ERROR(this->get_logger(), "Fail to postprocess image");
-      return;
+  // the fine detector runs only for the rois that are not tracked
+  std::vector<boost::optional<cv::Rect>> fine_rois(num_rois);
+  std::vector<int> detect_indices;
+  for (int i = 0; i < num_rois; ++i) {
+    cv::Rect fine_roi;
+    if (
+      use_roi_tracking_ &&
+      roi_tracker_->track(original_image, ids.at(i), rough_rois.at(i), fine_roi)) {
+      fine_rois.at(i) = fine_roi;
+    } else {
+      detect_indices.push_back(i);
     }
+  }
+  const int num_detect = detect_indices.size();
+  if (num_detect > 0 && !detect(original_image, rough_rois, detect_indices, ids, fine_rois)) {
+    return;
+  }
 
-    for (int i = 0; i < num_infer; ++i) {
-      if (detections.at(i).prob > score_thresh_) {
-        cv::Point lt_roi =
-          cv::Point(lts.at(i).x + detections.at(i).x, lts.at(i).y + detections.at(i).y);
-        cv::Point rb_roi = cv::Point(
-          lts.at(i).x + detections.at(i).x + detections.at(i).w,
-          lts.at(i).y + detections.at(i).y + detections.at(i).h);
-        fitInFrame(lt_roi, rb_roi, cv::Size(original_image.size()));
-        autoware_perception_msgs::msg::TrafficLightRoi tl_roi;
-        cvRect2TlRoiMsg(
-          cv::Rect(lt_roi, rb_roi), in_roi_msg->rois.at(i + batch_count * batch_size).id, tl_roi);
-        out_rois.rois.push_back(tl_roi);
-      }
+  for (int i = 0; i < num_rois; ++i) {
+    if (fine_rois.at(i)) {
+      autoware_perception_msgs::msg::TrafficLightRoi tl_roi;
+      cvRect2TlRoiMsg(fine_rois.at(i).get(), ids.at(i), tl_roi);
+      out_rois.rois.push_back(tl_roi);
     }
-    num_rois -= num_infer;
-    ++batch_count;
   }
   out_rois.header = in_roi_msg->header;
   output_roi_pub_->publish(out_rois);
@@ -217,67 +226,120 @@ void TrafficLightSSDFineDetectorNodelet::callback(
   exe_time_pub_->publish(exe_time_msg);
 }
 
-bool TrafficLightSSDFineDetectorNodelet::cvMat2CnnInput(
-  const std::vector<cv::Mat> & in_imgs, const int num_rois, std::vector<float> & data)
+bool TrafficLightSSDFineDetectorNodelet::detect(
+  const cv::Mat & original_image, const std::vector<cv::Rect> & rough_rois,
+  const std::vector<int> & detect_indices, const std::vector<int32_t> & ids,
+  std::vector<boost::optional<cv::Rect>> & fine_rois)
 {
-  for (int i = 0; i < num_rois; ++i) {
-    // cv::Mat rgb;
-    // cv::cvtColor(in_imgs.at(i), rgb, CV_BGR2RGB);
-    cv::Mat resized;
-    cv::resize(in_imgs.at(i), resized, cv::Size(width_, height_));
-
-    cv::Mat pixels;
-    resized.convertTo(pixels, CV_32FC3, 1.0 / 255, 0);
-    std::vector<float> img;
-    if (pixels.isContinuous()) {
-      img.assign(
-        reinterpret_cast<const float *>(pixels.datastart),
-        reinterpret_cast<const float *>(pixels.dataend));
-    } else {
-      return false;
+  const int num_detect = detect_indices.size();
+  reserveBuffers(original_image.total() * original_image.elemSize(), num_detect);
+  for (int k = 0; k < num_detect; ++k) {
+    const auto & rough_roi = rough_rois.at(detect_indices.at(k));
+    rois_h_[k] = ssd::Roi{rough_roi.x, rough_roi.y, rough_roi.width, rough_roi.height};
+  }
+
+  // the image is uploaded once, and the rois are cropped from it on the device
+  const auto stream = net_ptr_->getStream();
+  cv::Mat image_h(original_image.size(), CV_8UC3, image_h_.get());
+  original_image.copyTo(image_h);
+  try {
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      image_d_.get(), image_h_.get(), original_image.total() * original_image.elemSize(),
+      cudaMemcpyHostToDevice, stream));
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      rois_d_.get(), rois_h_.get(), sizeof(ssd::Roi) * num_detect, cudaMemcpyHostToDevice,
+      stream));
+
+    const int batch_size = net_ptr_->getMaxBatchSize();
+    std::vector<void *> buffers = {data_d_.get(), scores_d_.get(), boxes_d_.get()};
+    for (int offset = 0; offset < num_detect; offset += batch_size) {
+      const int num_infer = std::min(batch_size, num_detect - offset);
+      CHECK_CUDA_ERROR(ssd::cropResizeNormalize_launch(
+        image_d_.get(), static_cast<int>(image_h.step), rois_d_.get() + offset, num_infer,
+        width_, height_, make_float3(mean_[0], mean_[1], mean_[2]),
+        make_float3(std_[0], std_[1], std_[2]), data_d_.get(), stream));
+      net_ptr_->enqueue(buffers, num_infer);
+      // only the best box of each roi is copied back
+      CHECK_CUDA_ERROR(ssd::selectTopDetections_launch(
+        scores_d_.get(), boxes_d_.get(), num_infer, detection_per_class_, class_num_, tlr_id_,
+        detections_d_.get() + offset, stream));
     }
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      detections_h_.get(), detections_d_.get(), sizeof(ssd::TopDetection) * num_detect,
+      cudaMemcpyDeviceToHost, stream));
+    CHECK_CUDA_ERROR(cudaStreamSynchronize(stream));
+  } catch (std::exception & e) {
+    RCLCPP_ERROR(this->get_logger(), "%s", e.what());
+    return false;
+  }
 
-    for (int c = 0; c < channel_; ++c) {
-      for (int j = 0, hw = width_ * height_; j < hw; ++j) {
-        data[i * channel_ * width_ * height_ + c * hw + j] =
-          (img[channel_ * j + 2 - c] - mean_[c]) / std_[c];
+  // Get Output
+  std::vector<Detection> detections;
+  std::vector<cv::Size> roi_sizes;
+  for (int k = 0; k < num_detect; ++k) {
+    roi_sizes.push_back(cv::Size(rois_h_[k].width, rois_h_[k].height));
+  }
+  cnnOutput2BoxDetection(detections_h_.get(), roi_sizes, detections);
+
+  for (int k = 0; k < num_detect; ++k) {
+    const int i = detect_indices.at(k);
+    if (detections.at(k).prob > score_thresh_) {
+      const auto & lt = rough_rois.at(i).tl();
+      cv::Point lt_roi = cv::Point(lt.x + detections.at(k).x, lt.y + detections.at(k).y);
+      cv::Point rb_roi = cv::Point(
+        lt.x + detections.at(k).x + detections.at(k).w,
+        lt.y + detections.at(k).y + detections.at(k).h);
+      fitInFrame(lt_roi, rb_roi, cv::Size(original_image.size()));
+      fine_rois.at(i) = cv::Rect(lt_roi, rb_roi);
+      if (use_roi_tracking_) {
+        roi_tracker_->update(original_image, ids.at(i), rough_rois.at(i), cv::Rect(lt_roi, rb_roi));
       }
+    } else {
+      roi_tracker_->erase(ids.at(i));
     }
   }
   return true;
 }
 
-bool TrafficLightSSDFineDetectorNodelet::cnnOutput2BoxDetection(
-  const float * scores, const float * boxes, const int tlr_id, const std::vector<cv::Mat> & in_imgs,
-  const int num_rois, std::vector<Detection> & detections)
+void TrafficLightSSDFineDetectorNodelet::reserveBuffers(
+  const size_t image_size, const int num_rois)
 {
-  if (tlr_id > class_num_ - 1) {
-    return false;
+  if (image_size > image_capacity_) {
+    image_h_ = cuda::make_unique_host<uint8_t[]>(image_size);
+    image_d_ = cuda::make_unique<uint8_t[]>(image_size);
+    image_capacity_ = image_size;
   }
-  for (int i = 0; i < num_rois; ++i) {
-    std::vector<float> tlr_scores;
+  const size_t required_rois = static_cast<size_t>(num_rois);
+  if (required_rois > rois_capacity_) {
+    rois_h_ = cuda::make_unique_host<ssd::Roi[]>(required_rois);
+    rois_d_ = cuda::make_unique<ssd::Roi[]>(required_rois);
+    detections_h_ = cuda::make_unique_host<ssd::TopDetection[]>(required_rois);
+    detections_d_ = cuda::make_unique<ssd::TopDetection[]>(required_rois);
+    rois_capacity_ = required_rois;
+  }
+}
+
+void TrafficLightSSDFineDetectorNodelet::cnnOutput2BoxDetection(
+  const ssd::TopDetection * top_detections, const std::vector<cv::Size> & roi_sizes,
+  std::vector<Detection> & detections)
+{
+  for (size_t i = 0; i < roi_sizes.size(); ++i) {
+    const auto & top_detection = top_detections[i];
     Detection det;
-    for (int j = 0; j < detection_per_class_; ++j) {
-      tlr_scores.push_back(scores[i * detection_per_class_ * class_num_ + tlr_id + j * class_num_]);
-    }
-    std::vector<float>::iterator iter = std::max_element(tlr_scores.begin(), tlr_scores.end());
-    size_t index = std::distance(tlr_scores.begin(), iter);
-    size_t box_index = i * detection_per_class_ * 4 + index * 4;
     cv::Point lt, rb;
-    lt.x = boxes[box_index] * in_imgs.at(i).cols;
-    lt.y = boxes[box_index + 1] * in_imgs.at(i).rows;
-    rb.x = boxes[box_index + 2] * in_imgs.at(i).cols;
-    rb.y = boxes[box_index + 3] * in_imgs.at(i).rows;
-    fitInFrame(lt, rb, cv::Size(in_imgs.at(i).cols, in_imgs.at(i).rows));
+    lt.x = top_detection.x_min * roi_sizes.at(i).width;
+    lt.y = top_detection.y_min * roi_sizes.at(i).height;
+    rb.x = top_detection.x_max * roi_sizes.at(i).width;
+    rb.y = top_detection.y_max * roi_sizes.at(i).height;
+    fitInFrame(lt, rb, roi_sizes.at(i));
     det.x = lt.x;
     det.y = lt.y;
     det.w = rb.x - lt.x;
     det.h = rb.y - lt.y;
 
-    det.prob = tlr_scores[index];
+    det.prob = top_detection.score;
     detections.push_back(det);
   }
-  return true;
 }
 
 bool TrafficLightSSDFineDetectorNodelet::rosMsg2CvMat(
@@ -0,0 +1,102 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "traffic_light_ssd_fine_detector/roi_tracker.hpp"
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace traffic_light
+{
+namespace
+{
+cv::Point center(const cv::Rect & rect)
+{
+  return cv::Point(rect.x + rect.width / 2, rect.y + rect.height / 2);
+}
+}  // namespace
+
+bool RoiTracker::track(
+  const cv::Mat & image, const int32_t id, const cv::Rect & rough_roi, cv::Rect & fine_roi)
+{
+  const auto itr = tracks_.find(id);
+  if (itr == tracks_.end()) {
+    return false;
+  }
+  auto & track = itr->second;
+  if (track.num_tracked_frames >= param_.redetect_interval) {
+    return false;
+  }
+
+  // the template is not scaled, the roi is detected again when the light gets much closer
+  const double scale = static_cast<double>(rough_roi.width) / std::max(track.rough_roi.width, 1);
+  if (std::abs(scale - 1.0) > param_.max_scale_change) {
+    return false;
+  }
+
+  const cv::Rect predicted_roi = track.fine_roi + (center(rough_roi) - center(track.rough_roi));
+  const int margin = param_.search_margin;
+  const cv::Rect search_roi =
+    cv::Rect(
+      predicted_roi.x - margin, predicted_roi.y - margin, predicted_roi.width + 2 * margin,
+      predicted_roi.height + 2 * margin) &
+    cv::Rect(0, 0, image.cols, image.rows);
+  if (search_roi.width < track.templ.cols || search_roi.height < track.templ.rows) {
+    return false;
+  }
+
+  cv::Mat search_image;
+  cv::cvtColor(image(search_roi), search_image, cv::COLOR_RGB2GRAY);
+  cv::Mat score;
+  cv::matchTemplate(search_image, track.templ, score, cv::TM_CCOEFF_NORMED);
+  double max_score;
+  cv::Point max_loc;
+  cv::minMaxLoc(score, nullptr, &max_score, nullptr, &max_loc);
+  // also false for the nan of a flat template
+  if (!(max_score >= param_.score_thresh)) {
+    return false;
+  }
+
+  fine_roi = cv::Rect(search_roi.tl() + max_loc, track.templ.size());
+  track.rough_roi = rough_roi;
+  track.fine_roi = fine_roi;
+  ++track.num_tracked_frames;
+  return true;
+}
+
+void RoiTracker::update(
+  const cv::Mat & image, const int32_t id, const cv::Rect & rough_roi, const cv::Rect & fine_roi)
+{
+  auto & track = tracks_[id];
+  track.rough_roi = rough_roi;
+  track.fine_roi = fine_roi;
+  cv::cvtColor(image(fine_roi), track.templ, cv::COLOR_RGB2GRAY);
+  track.num_tracked_frames = 0;
+}
+
+void RoiTracker::eraseExcept(const std::vector<int32_t> & ids)
+{
+  for (auto itr = tracks_.begin(); itr != tracks_.end();) {
+    if (std::find(ids.begin(), ids.end(), itr->first) == ids.end()) {
+      itr = tracks_.erase(itr);
+    } else {
+      ++itr;
+    }
+  }
+}
+
+}  // namespace traffic_light
@@ -25,7 +25,10 @@
 #include <visualization_msgs/msg/marker_array.hpp>
 
 #include <iomanip>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 class DynamicObjectVisualizer : public rclcpp::Node
@@ -43,6 +46,10 @@ private:
     const autoware_perception_msgs::msg::DynamicObjectWithFeatureArray::ConstSharedPtr input_msg);
   void dynamicObjectCallback(
     const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr input_msg);
+  /** \brief One marker per class for the shapes, the twists and the decimated paths, and the
+   * labels as ADD/MODIFY/DELETE against the markers published before. */
+  visualization_msgs::msg::MarkerArray createCompactMarkers(
+    const autoware_perception_msgs::msg::DynamicObjectArray & input_msg);
   bool calcBoundingBoxLineList(
     const autoware_perception_msgs::msg::Shape & shape,
     std::vector<geometry_msgs::msg::Point> & points);
@@ -58,7 +65,11 @@ private:
   bool calcPathLineList(
     const autoware_perception_msgs::msg::PredictedPath & path,
     std::vector<geometry_msgs::msg::Point> & points);
+  bool calcDecimatedPathLineList(
+    const autoware_perception_msgs::msg::PredictedPath & path,
+    std::vector<geometry_msgs::msg::Point> & points);
   bool getLabel(const autoware_perception_msgs::msg::Semantic & semantic, std::string & label);
+  std::string getLabelText(const autoware_perception_msgs::msg::DynamicObject & object);
   void getColor(
     const autoware_perception_msgs::msg::DynamicObject & object, std_msgs::msg::ColorRGBA & color);
   void initColorList(std::vector<std_msgs::msg::ColorRGBA> & colors);
@@ -67,6 +78,21 @@ private:
   bool only_known_objects_;
   std::vector<std_msgs::msg::ColorRGBA> colors_;
 
+  // compact mode
+  bool compact_mode_;
+  int compact_refresh_interval_;  // every n frames all the labels are sent again
+  double path_decimation_length_;
+  struct LabelMarker
+  {
+    int32_t id;
+    geometry_msgs::msg::Point position;
+    std::string text;
+  };
+  std::unordered_map<std::string, LabelMarker> label_markers_;  // key: uuid
+  int32_t next_label_marker_id_;
+  std::set<std::pair<std::string, int32_t>> class_markers_;  // ns and id of the class markers
+  int frame_count_;
+
   inline std::string uuid_to_string(unique_identifier_msgs::msg::UUID const & u)
   {
     std::stringstream ss;
@@ -12,8 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #define EIGEN_MPL2_ONLY
@@ -28,12 +32,41 @@
 
 using std::placeholders::_1;
 
+namespace
+{
+Eigen::Affine3d toAffine3d(const geometry_msgs::msg::Pose & pose)
+{
+  return Eigen::Translation3d(pose.position.x, pose.position.y, pose.position.z) *
+         Eigen::Quaterniond(
+           pose.orientation.w, pose.orientation.x, pose.orientation.y, pose.orientation.z);
+}
+
+void appendTransformedPoints(
+  const Eigen::Affine3d & transform, const std::vector<geometry_msgs::msg::Point> & points,
+  std::vector<geometry_msgs::msg::Point> & output)
+{
+  for (const auto & point : points) {
+    const Eigen::Vector3d transformed = transform * Eigen::Vector3d(point.x, point.y, point.z);
+    geometry_msgs::msg::Point transformed_point;
+    transformed_point.x = transformed.x();
+    transformed_point.y = transformed.y();
+    transformed_point.z = transformed.z();
+    output.push_back(transformed_point);
+  }
+}
+}  // namespace
+
 DynamicObjectVisualizer::DynamicObjectVisualizer(const rclcpp::NodeOptions & node_options)
 : rclcpp::Node("dynamic_object_visualizer", node_options)
 {
   with_feature_ = declare_parameter("with_feature", true);
   confidence_text_size_ = declare_parameter("confidence_text_size", 0.5);
   only_known_objects_ = declare_parameter("only_known_objects", true);
+  compact_mode_ = declare_parameter("compact_mode", false);
+  compact_refresh_interval_ = declare_parameter("compact_refresh_interval", 10);
+  path_decimation_length_ = declare_parameter("path_decimation_length", 2.0);
+  next_label_marker_id_ = 0;
+  frame_count_ = 0;
   if (with_feature_) {
     sub_with_feature_ =
       create_subscription<autoware_perception_msgs::msg::DynamicObjectWithFeatureArray>(
@@ -70,6 +103,10 @@ void DynamicObjectVisualizer::dynamicObjectCallback(
   if (this->count_subscribers(pub_->get_topic_name()) < 1) {
     return;
   }
+  if (compact_mode_) {
+    pub_->publish(createCompactMarkers(*input_msg));
+    return;
+  }
   visualization_msgs::msg::MarkerArray output;
   constexpr double line_width = 0.03;
   // shape
@@ -182,27 +219,9 @@ void DynamicObjectVisualizer::dynamicObjectCallback(
     marker.id = i;
     marker.type = visualization_msgs::msg::Marker::TEXT_VIEW_FACING;
     marker.ns = std::string("label");
-    std::string label;
-    if (!getLabel(input_msg->objects.at(i).semantic, label)) {
-      continue;
-    }
     marker.scale.x = 0.5;
     marker.scale.z = 0.5;
-
-    std::string id_str = uuid_to_string(input_msg->objects.at(i).id);
-
-    marker.text = label + ":" + id_str.substr(0, 4);
-    if (input_msg->objects.at(i).state.twist_reliable) {
-      double vel = std::sqrt(
-        input_msg->objects.at(i).state.twist_covariance.twist.linear.x *
-          input_msg->objects.at(i).state.twist_covariance.twist.linear.x +
-        input_msg->objects.at(i).state.twist_covariance.twist.linear.y *
-          input_msg->objects.at(i).state.twist_covariance.twist.linear.y +
-        input_msg->objects.at(i).state.twist_covariance.twist.linear.z *
-          input_msg->objects.at(i).state.twist_covariance.twist.linear.z);
-      marker.text =
-        marker.text + "\n" + std::to_string(static_cast<int>(vel * 3.6)) + std::string("[km/h]");
-    }
+    marker.text = getLabelText(input_msg->objects.at(i));
     marker.action = visualization_msgs::msg::Marker::MODIFY;
     marker.pose = input_msg->objects.at(i).state.pose_covariance.pose;
     marker.lifetime = rclcpp::Duration::from_seconds(0.2);
@@ -402,6 +421,180 @@ void DynamicObjectVisualizer::dynamicObjectCallback(
   pub_->publish(output);
 }
 
+visualization_msgs::msg::MarkerArray DynamicObjectVisualizer::createCompactMarkers(
+  const autoware_perception_msgs::msg::DynamicObjectArray & input_msg)
+{
+  using visualization_msgs::msg::Marker;
+  constexpr double line_width = 0.03;
+  constexpr double label_update_distance = 0.5;
+
+  // the labels are deltas, they are all sent again from time to time for late subscribers
+  const bool is_refresh_frame =
+    compact_refresh_interval_ <= 1 || frame_count_ % compact_refresh_interval_ == 0;
+  ++frame_count_;
+
+  std::map<std::pair<std::string, int32_t>, Marker> class_markers;
+  const auto get_class_marker = [this, &input_msg, &class_markers](
+                                  const std::string & ns, const int32_t type,
+                                  const std_msgs::msg::ColorRGBA & color) -> Marker & {
+    const auto result = class_markers.emplace(std::make_pair(ns, type), Marker{});
+    Marker & marker = result.first->second;
+    if (result.second) {
+      marker.header = input_msg.header;
+      marker.ns = ns;
+      marker.id = type;
+      marker.type = Marker::LINE_LIST;
+      marker.action = Marker::MODIFY;
+      initPose(marker.pose);
+      marker.scale.x = line_width;
+      marker.color = color;
+    }
+    return marker;
+  };
+  std_msgs::msg::ColorRGBA shape_color;
+  shape_color.a = 0.999;
+  shape_color.g = 1.0;
+  std_msgs::msg::ColorRGBA twist_color;
+  twist_color.a = 0.999;
+  twist_color.r = 1.0;
+
+  visualization_msgs::msg::MarkerArray output;
+  std::unordered_set<std::string> current_uuids;
+  std::vector<geometry_msgs::msg::Point> points;
+  for (const auto & object : input_msg.objects) {
+    if (
+      only_known_objects_ &&
+      object.semantic.type == autoware_perception_msgs::msg::Semantic::UNKNOWN) {
+      continue;
+    }
+    const int32_t type = object.semantic.type;
+    const auto & pose = object.state.pose_covariance.pose;
+    const Eigen::Affine3d object2frame = toAffine3d(pose);
+
+    // shape and orientation
+    using Shape = autoware_perception_msgs::msg::Shape;
+    points.clear();
+    if (object.shape.type == Shape::BOUNDING_BOX) {
+      calcBoundingBoxLineList(object.shape, points);
+    } else if (object.shape.type == Shape::CYLINDER) {
+      calcCylinderLineList(object.shape, points);
+    } else {
+      calcPolygonLineList(object.shape, points);
+    }
+    if (object.state.orientation_reliable) {
+      geometry_msgs::msg::Point point;
+      for (const double z : {object.shape.dimensions.z / 2.0, -object.shape.dimensions.z / 2.0}) {
+        point.x = 0.0;
+        point.z = z;
+        points.push_back(point);
+        point.x = object.shape.dimensions.x / 2.0;
+        points.push_back(point);
+      }
+    }
+    if (!points.empty()) {
+      auto & marker = get_class_marker("shape", type, shape_color);
+      appendTransformedPoints(object2frame, points, marker.points);
+    }
+
+    // twist
+    if (object.state.twist_reliable) {
+      points.clear();
+      points.emplace_back();
+      geometry_msgs::msg::Point point;
+      point.x = object.state.twist_covariance.twist.linear.x;
+      point.y = object.state.twist_covariance.twist.linear.y;
+      point.z = object.state.twist_covariance.twist.linear.z;
+      points.push_back(point);
+      auto & marker = get_class_marker("twist", type, twist_color);
+      appendTransformedPoints(object2frame, points, marker.points);
+    }
+
+    // path
+    for (const auto & path : object.state.predicted_paths) {
+      points.clear();
+      if (!calcDecimatedPathLineList(path, points) || points.empty()) {
+        continue;
+      }
+      std_msgs::msg::ColorRGBA path_color = colors_.at(type % colors_.size());
+      path_color.a = 0.999;
+      auto & marker = get_class_marker("path", type, path_color);
+      for (auto & point : points) {
+        point.z -= object.shape.dimensions.z / 2.0;
+        marker.points.push_back(point);
+      }
+    }
+
+    // label, only when it is new, changed or moved
+    const std::string uuid = uuid_to_string(object.id);
+    current_uuids.insert(uuid);
+    const std::string text = getLabelText(object);
+    auto label_itr = label_markers_.find(uuid);
+    const bool is_new_label = label_itr == label_markers_.end();
+    if (is_new_label) {
+      label_itr =
+        label_markers_.emplace(uuid, LabelMarker{next_label_marker_id_++, pose.position, text})
+          .first;
+    } else {
+      const auto & last_position = label_itr->second.position;
+      const bool is_moved = label_update_distance <
+                            std::hypot(
+                              pose.position.x - last_position.x, pose.position.y - last_position.y);
+      if (!is_refresh_frame && !is_moved && text == label_itr->second.text) {
+        continue;
+      }
+      label_itr->second.position = pose.position;
+      label_itr->second.text = text;
+    }
+    Marker marker;
+    marker.header = input_msg.header;
+    marker.ns = std::string("label");
+    marker.id = label_itr->second.id;
+    marker.type = Marker::TEXT_VIEW_FACING;
+    marker.action = is_new_label ? Marker::ADD : Marker::MODIFY;
+    marker.pose = pose;
+    marker.scale.x = 0.5;
+    marker.scale.z = 0.5;
+    marker.text = text;
+    marker.color.a = 0.999;
+    marker.color.r = 1.0;
+    marker.color.g = 1.0;
+    marker.color.b = 1.0;
+    output.markers.push_back(marker);
+  }
+
+  // delete the labels of the lost objects and the markers of the classes not seen anymore
+  for (auto itr = label_markers_.begin(); itr != label_markers_.end();) {
+    if (current_uuids.count(itr->first)) {
+      ++itr;
+      continue;
+    }
+    Marker marker;
+    marker.header = input_msg.header;
+    marker.ns = std::string("label");
+    marker.id = itr->second.id;
+    marker.action = Marker::DELETE;
+    output.markers.push_back(marker);
+    itr = label_markers_.erase(itr);
+  }
+  for (const auto & key : class_markers_) {
+    if (class_markers.count(key)) {
+      continue;
+    }
+    Marker marker;
+    marker.header = input_msg.header;
+    marker.ns = key.first;
+    marker.id = key.second;
+    marker.action = Marker::DELETE;
+    output.markers.push_back(marker);
+  }
+  class_markers_.clear();
+  for (auto & class_marker : class_markers) {
+    class_markers_.insert(class_marker.first);
+    output.markers.push_back(std::move(class_marker.second));
+  }
+  return output;
+}
+
 bool DynamicObjectVisualizer::calcBoundingBoxLineList(
   const autoware_perception_msgs::msg::Shape & shape,
   std::vector<geometry_msgs::msg::Point> & points)
@@ -668,6 +861,30 @@ bool DynamicObjectVisualizer::calcPathLineList(
   return true;
 }
 
+bool DynamicObjectVisualizer::calcDecimatedPathLineList(
+  const autoware_perception_msgs::msg::PredictedPath & paths,
+  std::vector<geometry_msgs::msg::Point> & points)
+{
+  if (paths.path.size() < 2) {
+    return false;
+  }
+  // a segment per path_decimation_length, ending at the last point of the path
+  geometry_msgs::msg::Point last_point = paths.path.front().pose.pose.position;
+  for (size_t i = 1; i < paths.path.size(); ++i) {
+    const auto & point = paths.path.at(i).pose.pose.position;
+    const bool is_last = i + 1 == paths.path.size();
+    if (
+      !is_last &&
+      std::hypot(point.x - last_point.x, point.y - last_point.y) < path_decimation_length_) {
+      continue;
+    }
+    points.push_back(last_point);
+    points.push_back(point);
+    last_point = point;
+  }
+  return true;
+}
+
 void DynamicObjectVisualizer::initPose(geometry_msgs::msg::Pose & pose)
 {
   pose.position.x = 0.0;
@@ -704,6 +921,20 @@ bool DynamicObjectVisualizer::getLabel(
   return true;
 }
 
+std::string DynamicObjectVisualizer::getLabelText(
+  const autoware_perception_msgs::msg::DynamicObject & object)
+{
+  std::string label;
+  getLabel(object.semantic, label);
+  std::string text = label + ":" + uuid_to_string(object.id).substr(0, 4);
+  if (object.state.twist_reliable) {
+    const auto & linear = object.state.twist_covariance.twist.linear;
+    const double vel = std::sqrt(linear.x * linear.x + linear.y * linear.y + linear.z * linear.z);
+    text = text + "\n" + std::to_string(static_cast<int>(vel * 3.6)) + std::string("[km/h]");
+  }
+  return text;
+}
+
 void DynamicObjectVisualizer::getColor(
   const autoware_perception_msgs::msg::DynamicObject & object, std_msgs::msg::ColorRGBA & color)
 {
@@ -15,7 +15,10 @@
 #ifndef MISSION_PLANNER__LANELET2_IMPL__MISSION_PLANNER_LANELET2_HPP_
 #define MISSION_PLANNER__LANELET2_IMPL__MISSION_PLANNER_LANELET2_HPP_
 
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 // ROS
@@ -31,6 +34,8 @@
 #include <autoware_lanelet2_msgs/msg/map_bin.hpp>
 
 // lanelet
+#include <lanelet2_extension/utility/query.hpp>
+
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_routing/RoutingGraph.h>
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
@@ -50,8 +55,14 @@ private:
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
-  lanelet::ConstLanelets road_lanelets_;
-  lanelet::ConstLanelets shoulder_lanelets_;
+  // queried on every route, so they are prepared once per map
+  std::shared_ptr<lanelet::utils::query::LaneletQueryIndex> lanelet_query_index_;
+  lanelet::ConstLineStrings3d parking_spaces_;
+  lanelet::ConstPolygons3d parking_lots_;
+
+  // route sections between the lanelets of consecutive checkpoints of the previous route, reused
+  // for the checkpoints which are not changed by the next one
+  std::map<std::pair<lanelet::Id, lanelet::Id>, RouteSections> route_sections_cache_;
 
   rclcpp::Subscription<autoware_lanelet2_msgs::msg::MapBin>::SharedPtr map_subscriber_;
 
@@ -65,9 +76,13 @@ private:
 
   // routing
   bool planPathBetweenCheckpoints(
+    const lanelet::ConstLanelet & start_lanelet, const lanelet::ConstLanelet & goal_lanelet,
+    lanelet::ConstLanelets * path_lanelets_ptr) const;
+  bool planRouteSectionsBetweenCheckpoints(
     const geometry_msgs::msg::PoseStamped & start_checkpoint,
     const geometry_msgs::msg::PoseStamped & goal_checkpoint,
-    lanelet::ConstLanelets * path_lanelets_ptr) const;
+    std::map<std::pair<lanelet::Id, lanelet::Id>, RouteSections> * route_sections_cache_ptr,
+    RouteSections * route_sections_ptr);
   lanelet::ConstLanelets getMainLanelets(
     const lanelet::ConstLanelets & path_lanelets, const RouteHandler & lanelet_sequence_finder);
   RouteSections createRouteSections(
@@ -29,8 +29,10 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 
 #include <limits>
+#include <map>
 #include <memory>
 #include <unordered_set>
+#include <utility>
 
 namespace
 {
@@ -137,9 +139,11 @@ void MissionPlannerLanelet2::mapCallback(
   lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
   lanelet::utils::conversion::fromBinMsg(
     *msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
-  lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
-  road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
-  shoulder_lanelets_ = lanelet::utils::query::shoulderLanelets(all_lanelets);
+  lanelet_query_index_ =
+    std::make_shared<lanelet::utils::query::LaneletQueryIndex>(lanelet_map_ptr_);
+  parking_spaces_ = lanelet::utils::query::getAllParkingSpaces(lanelet_map_ptr_);
+  parking_lots_ = lanelet::utils::query::getAllParkingLots(lanelet_map_ptr_);
+  route_sections_cache_.clear();
   is_graph_ready_ = true;
 }
 
@@ -194,9 +198,10 @@ void MissionPlannerLanelet2::visualizeRoute(const autoware_planning_msgs::msg::R
 
 bool MissionPlannerLanelet2::isGoalValid() const
 {
-  lanelet::Lanelet closest_lanelet;
+  lanelet::ConstLanelet closest_lanelet;
   if (!lanelet::utils::query::getClosestLanelet(
-        road_lanelets_, goal_pose_.pose, &closest_lanelet)) {
+        *lanelet_query_index_, goal_pose_.pose, &closest_lanelet,
+        lanelet::AttributeValueString::Road)) {
     return false;
   }
   const auto goal_lanelet_pt = lanelet::utils::conversion::toLaneletPoint(goal_pose_.pose.position);
@@ -215,21 +220,19 @@ bool MissionPlannerLanelet2::isGoalValid() const
   }
 
   // check if goal is in parking space
-  const auto parking_spaces = lanelet::utils::query::getAllParkingSpaces(lanelet_map_ptr_);
-  if (isInParkingSpace(parking_spaces, goal_lanelet_pt)) {
+  if (isInParkingSpace(parking_spaces_, goal_lanelet_pt)) {
     return true;
   }
 
   // check if goal is in parking lot
-  const auto parking_lots = lanelet::utils::query::getAllParkingLots(lanelet_map_ptr_);
-  if (isInParkingLot(parking_lots, goal_lanelet_pt)) {
+  if (isInParkingLot(parking_lots_, goal_lanelet_pt)) {
     return true;
   }
 
   // check if goal is in shoulder lanelet
-  lanelet::Lanelet closest_shoulder_lanelet;
+  lanelet::ConstLanelet closest_shoulder_lanelet;
   if (!lanelet::utils::query::getClosestLanelet(
-        shoulder_lanelets_, goal_pose_.pose, &closest_shoulder_lanelet)) {
+        *lanelet_query_index_, goal_pose_.pose, &closest_shoulder_lanelet, "road_shoulder")) {
     return false;
   }
   // check if goal pose is in shoulder lane
@@ -267,21 +270,18 @@ autoware_planning_msgs::msg::Route MissionPlannerLanelet2::planRoute()
     return route_msg;
   }
 
+  std::map<std::pair<lanelet::Id, lanelet::Id>, RouteSections> route_sections_cache;
   for (std::size_t i = 1; i < checkpoints_.size(); i++) {
     const auto start_checkpoint = checkpoints_.at(i - 1);
     const auto goal_checkpoint = checkpoints_.at(i);
-    lanelet::ConstLanelets path_lanelets;
-    if (!planPathBetweenCheckpoints(start_checkpoint, goal_checkpoint, &path_lanelets)) {
+    RouteSections local_route_sections;
+    if (!planRouteSectionsBetweenCheckpoints(
+          start_checkpoint, goal_checkpoint, &route_sections_cache, &local_route_sections)) {
       return route_msg;
     }
-
-    RouteHandler route_handler(lanelet_map_ptr_, routing_graph_ptr_, path_lanelets);
-    const auto main_lanelets = getMainLanelets(path_lanelets, route_handler);
-
-    // //  create routesections
-    const auto local_route_sections = createRouteSections(main_lanelets, route_handler);
     route_sections = combineConsecutiveRouteSections(route_sections, local_route_sections);
   }
+  route_sections_cache_ = std::move(route_sections_cache);
 
   if (isRouteLooped(route_sections)) {
     RCLCPP_WARN(
@@ -296,22 +296,52 @@ autoware_planning_msgs::msg::Route MissionPlannerLanelet2::planRoute()
   return route_msg;
 }
 
-bool MissionPlannerLanelet2::planPathBetweenCheckpoints(
+bool MissionPlannerLanelet2::planRouteSectionsBetweenCheckpoints(
   const geometry_msgs::msg::PoseStamped & start_checkpoint,
   const geometry_msgs::msg::PoseStamped & goal_checkpoint,
-  lanelet::ConstLanelets * path_lanelets_ptr) const
+  std::map<std::pair<lanelet::Id, lanelet::Id>, RouteSections> * route_sections_cache_ptr,
+  RouteSections * route_sections_ptr)
 {
-  lanelet::Lanelet start_lanelet;
+  lanelet::ConstLanelet start_lanelet;
   if (!lanelet::utils::query::getClosestLanelet(
-        road_lanelets_, start_checkpoint.pose, &start_lanelet)) {
+        *lanelet_query_index_, start_checkpoint.pose, &start_lanelet,
+        lanelet::AttributeValueString::Road)) {
     return false;
   }
-  lanelet::Lanelet goal_lanelet;
+  lanelet::ConstLanelet goal_lanelet;
   if (!lanelet::utils::query::getClosestLanelet(
-        road_lanelets_, goal_checkpoint.pose, &goal_lanelet)) {
+        *lanelet_query_index_, goal_checkpoint.pose, &goal_lanelet,
+        lanelet::AttributeValueString::Road)) {
     return false;
   }
 
+  // the route sections only depend on the start and goal lanelets
+  const auto key = std::make_pair(start_lanelet.id(), goal_lanelet.id());
+  const auto cached_route_sections = route_sections_cache_.find(key);
+  if (cached_route_sections != route_sections_cache_.end()) {
+    *route_sections_ptr = cached_route_sections->second;
+    route_sections_cache_ptr->emplace(key, *route_sections_ptr);
+    return true;
+  }
+
+  lanelet::ConstLanelets path_lanelets;
+  if (!planPathBetweenCheckpoints(start_lanelet, goal_lanelet, &path_lanelets)) {
+    return false;
+  }
+
+  RouteHandler route_handler(lanelet_map_ptr_, routing_graph_ptr_, path_lanelets);
+  const auto main_lanelets = getMainLanelets(path_lanelets, route_handler);
+
+  // //  create routesections
+  *route_sections_ptr = createRouteSections(main_lanelets, route_handler);
+  route_sections_cache_ptr->emplace(key, *route_sections_ptr);
+  return true;
+}
+
+bool MissionPlannerLanelet2::planPathBetweenCheckpoints(
+  const lanelet::ConstLanelet & start_lanelet, const lanelet::ConstLanelet & goal_lanelet,
+  lanelet::ConstLanelets * path_lanelets_ptr) const
+{
   // get all possible lanes that can be used to reach goal (including all possible lane change)
   lanelet::Optional<lanelet::routing::Route> optional_route =
     routing_graph_ptr_->getRoute(start_lanelet, goal_lanelet, 0);
@@ -57,9 +57,17 @@ public:
     PlanningErrorMonitorDebugNode & debug_marker);
 
 private:
+  struct CheckResult
+  {
+    bool is_valid{true};
+    std::string error_msg;
+  };
+
   static bool checkFinite(const TrajectoryPoint & p);
   static size_t getIndexAfterDistance(
     const Trajectory & traj, const size_t curr_id, const double distance);
+  void checkCurrentTrajectory();
+  static void summarizeCheckResult(const CheckResult & result, DiagnosticStatusWrapper & stat);
 
   // ROS
   rclcpp::Subscription<Trajectory>::SharedPtr traj_sub_;
@@ -68,6 +76,13 @@ private:
 
   Trajectory::ConstSharedPtr current_trajectory_;
 
+  // results of the checks of the last checked trajectory
+  Trajectory::ConstSharedPtr checked_trajectory_;
+  CheckResult point_value_result_;
+  CheckResult interval_result_;
+  CheckResult curvature_result_;
+  CheckResult relative_angle_result_;
+
   // Parameter
   double error_interval_;
   double error_curvature_;
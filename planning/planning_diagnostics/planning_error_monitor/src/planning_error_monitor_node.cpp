@@ -24,6 +24,7 @@ namespace planning_diagnostics
 {
 using autoware_utils::calcCurvature;
 using autoware_utils::calcDistance2d;
+using autoware_utils::calcSquaredDistance2d;
 using diagnostic_msgs::msg::DiagnosticStatus;
 
 PlanningErrorMonitorNode::PlanningErrorMonitorNode(const rclcpp::NodeOptions & node_options)
@@ -79,11 +80,8 @@ void PlanningErrorMonitorNode::onTrajectoryPointValueChecker(DiagnosticStatusWra
     return;
   }
 
-  std::string error_msg;
-  const auto diag_level = checkTrajectoryPointValue(*current_trajectory_, error_msg)
-                            ? DiagnosticStatus::OK
-                            : DiagnosticStatus::ERROR;
-  stat.summary(diag_level, error_msg);
+  checkCurrentTrajectory();
+  summarizeCheckResult(point_value_result_, stat);
 }
 
 void PlanningErrorMonitorNode::onTrajectoryIntervalChecker(DiagnosticStatusWrapper & stat)
@@ -92,12 +90,8 @@ void PlanningErrorMonitorNode::onTrajectoryIntervalChecker(DiagnosticStatusWrapp
     return;
   }
 
-  std::string error_msg;
-  const auto diag_level =
-    checkTrajectoryInterval(*current_trajectory_, error_interval_, error_msg, debug_marker_)
-      ? DiagnosticStatus::OK
-      : DiagnosticStatus::ERROR;
-  stat.summary(diag_level, error_msg);
+  checkCurrentTrajectory();
+  summarizeCheckResult(interval_result_, stat);
 }
 
 void PlanningErrorMonitorNode::onTrajectoryCurvatureChecker(DiagnosticStatusWrapper & stat)
@@ -106,12 +100,8 @@ void PlanningErrorMonitorNode::onTrajectoryCurvatureChecker(DiagnosticStatusWrap
     return;
   }
 
-  std::string error_msg;
-  const auto diag_level =
-    checkTrajectoryCurvature(*current_trajectory_, error_curvature_, error_msg, debug_marker_)
-      ? DiagnosticStatus::OK
-      : DiagnosticStatus::ERROR;
-  stat.summary(diag_level, error_msg);
+  checkCurrentTrajectory();
+  summarizeCheckResult(curvature_result_, stat);
 }
 
 void PlanningErrorMonitorNode::onTrajectoryRelativeAngleChecker(DiagnosticStatusWrapper & stat)
@@ -120,13 +110,35 @@ void PlanningErrorMonitorNode::onTrajectoryRelativeAngleChecker(DiagnosticStatus
     return;
   }
 
-  std::string error_msg;
-  const auto diag_level =
-    checkTrajectoryRelativeAngle(
-      *current_trajectory_, error_sharp_angle_, ignore_too_close_points_, error_msg, debug_marker_)
-      ? DiagnosticStatus::OK
-      : DiagnosticStatus::ERROR;
-  stat.summary(diag_level, error_msg);
+  checkCurrentTrajectory();
+  summarizeCheckResult(relative_angle_result_, stat);
+}
+
+void PlanningErrorMonitorNode::checkCurrentTrajectory()
+{
+  // the diagnostics are updated by the timer and by the updater itself, while each check only
+  // depends on the trajectory
+  if (current_trajectory_ == checked_trajectory_) {
+    return;
+  }
+  checked_trajectory_ = current_trajectory_;
+
+  const auto & traj = *current_trajectory_;
+  point_value_result_.is_valid = checkTrajectoryPointValue(traj, point_value_result_.error_msg);
+  interval_result_.is_valid =
+    checkTrajectoryInterval(traj, error_interval_, interval_result_.error_msg, debug_marker_);
+  curvature_result_.is_valid =
+    checkTrajectoryCurvature(traj, error_curvature_, curvature_result_.error_msg, debug_marker_);
+  relative_angle_result_.is_valid = checkTrajectoryRelativeAngle(
+    traj, error_sharp_angle_, ignore_too_close_points_, relative_angle_result_.error_msg,
+    debug_marker_);
+}
+
+void PlanningErrorMonitorNode::summarizeCheckResult(
+  const CheckResult & result, DiagnosticStatusWrapper & stat)
+{
+  const auto diag_level = result.is_valid ? DiagnosticStatus::OK : DiagnosticStatus::ERROR;
+  stat.summary(diag_level, result.error_msg);
 }
 
 bool PlanningErrorMonitorNode::checkTrajectoryPointValue(
@@ -218,14 +230,14 @@ bool PlanningErrorMonitorNode::checkTrajectoryRelativeAngle(
     const double y2 = p2.y - p1.y;
 
     // skip too close points case
-    if (std::hypot(x3, y3) < min_dist_threshold || std::hypot(x2, y2) < min_dist_threshold) {
+    const double min_dist_threshold_sq = min_dist_threshold * min_dist_threshold;
+    if (x3 * x3 + y3 * y3 < min_dist_threshold_sq || x2 * x2 + y2 * y2 < min_dist_threshold_sq) {
       continue;
     }
 
-    // calculate relative angle of vector p3 based on p1p2 vector
-    const double th = std::atan2(y2, x2);
-    const double th2 =
-      std::atan2(-x3 * std::sin(th) + y3 * std::cos(th), x3 * std::cos(th) + y3 * std::sin(th));
+    // calculate relative angle of vector p3 based on p1p2 vector, from their cross and dot
+    // products instead of rotating p3 by the angle of p1p2
+    const double th2 = std::atan2(x2 * y3 - y2 * x3, x2 * x3 + y2 * y3);
     if (std::abs(th2) > angle_threshold) {
       error_msg = "This Trajectory's relative angle has larger value than the expected value";
       // std::cout << error_msg << std::endl;
@@ -288,10 +300,9 @@ size_t PlanningErrorMonitorNode::getIndexAfterDistance(
   const TrajectoryPoint & curr_p = traj.points.at(curr_id);
 
   size_t target_id = curr_id;
-  double current_distance = 0.0;
+  const double distance_sq = distance * distance;
   for (size_t traj_id = curr_id + 1; traj_id < traj.points.size(); ++traj_id) {
-    current_distance = calcDistance2d(traj.points.at(traj_id), curr_p);
-    if (current_distance >= distance) {
+    if (calcSquaredDistance2d(traj.points.at(traj_id), curr_p) >= distance_sq) {
       target_id = traj_id;
       break;
     }
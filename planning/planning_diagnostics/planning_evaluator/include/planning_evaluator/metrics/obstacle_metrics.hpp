@@ -15,35 +15,47 @@
 #ifndef PLANNING_EVALUATOR__METRICS__OBSTACLE_METRICS_HPP_
 #define PLANNING_EVALUATOR__METRICS__OBSTACLE_METRICS_HPP_
 
+#include "autoware_utils/geometry/boost_geometry.hpp"
 #include "planning_evaluator/stat.hpp"
 
 #include "autoware_perception_msgs/msg/dynamic_object_array.hpp"
 #include "autoware_planning_msgs/msg/trajectory.hpp"
 
+#include <boost/geometry/index/rtree.hpp>
+
 namespace planning_diagnostics
 {
 namespace metrics
 {
 using autoware_perception_msgs::msg::DynamicObjectArray;
 using autoware_planning_msgs::msg::Trajectory;
+using ObstacleRtree = boost::geometry::index::rtree<
+  autoware_utils::Point2d, boost::geometry::index::rstar<16>>;
 
 /**
- * @brief calculate the distance to the closest obstacle at each point of the trajectory
+ * @brief create the spatial index of the obstacle positions, once for each set of obstacles
  * @param [in] obstacles obstacles
+ * @return rtree of the obstacle positions
+ */
+ObstacleRtree createObstacleRtree(const DynamicObjectArray & obstacles);
+
+/**
+ * @brief calculate the distance to the closest obstacle at each point of the trajectory
+ * @param [in] obstacles rtree of the obstacle positions
  * @param [in] traj trajectory
  * @return calculated statistics
  */
-Stat<double> calcDistanceToObstacle(const DynamicObjectArray & obstacles, const Trajectory & traj);
+Stat<double> calcDistanceToObstacle(const ObstacleRtree & obstacles, const Trajectory & traj);
 
 /**
  * @brief calculate the time to collision of the trajectory with the given obstacles
  * Assume that "now" corresponds to the first trajectory point
- * @param [in] obstacles obstacles
+ * @param [in] obstacles rtree of the obstacle positions
  * @param [in] traj trajectory
  * @return calculated statistics
  */
 Stat<double> calcTimeToCollision(
-  const DynamicObjectArray & obstacles, const Trajectory & traj, const double distance_threshold);
+  const ObstacleRtree & obstacles, const Trajectory & traj, const double distance_threshold);
 
 }  // namespace metrics
 }  // namespace planning_diagnostics
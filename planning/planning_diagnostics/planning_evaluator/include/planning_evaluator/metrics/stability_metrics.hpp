@@ -35,6 +35,8 @@ Stat<double> calcFrechetDistance(const Trajectory & traj1, const Trajectory & tr
 
 /**
  * @brief calculate the lateral distance between two trajectories
+ * The points of traj2 are projected in order on traj1, each from the projection of the previous
+ * point, which is linear in the number of points for trajectories that do not loop
  * @param [in] traj1 first trajectory
  * @param [in] traj2 second trajectory
  * @return calculated statistics
@@ -16,6 +16,7 @@
 #define PLANNING_EVALUATOR__METRICS_CALCULATOR_HPP_
 
 #include "planning_evaluator/metrics/metric.hpp"
+#include "planning_evaluator/metrics/obstacle_metrics.hpp"
 #include "planning_evaluator/parameters.hpp"
 #include "planning_evaluator/stat.hpp"
 
@@ -69,6 +70,11 @@ public:
   void setEgoPose(const geometry_msgs::msg::Pose & pose);
 
 private:
+  /**
+   * @brief update the lookahead of the previous trajectory from the current ego pose
+   */
+  void updatePreviousTrajectoryLookahead();
+
   /**
    * @brief trim a trajectory from the current ego pose to some fixed time or distance
    * @param [in] traj input trajectory to trim
@@ -84,7 +90,7 @@ private:
   Trajectory reference_trajectory_lookahead_;
   Trajectory previous_trajectory_;
   Trajectory previous_trajectory_lookahead_;
-  DynamicObjectArray dynamic_objects_;
+  metrics::ObstacleRtree obstacle_rtree_;
   geometry_msgs::msg::Pose ego_pose_;
 };  // class MetricsCalculator
 
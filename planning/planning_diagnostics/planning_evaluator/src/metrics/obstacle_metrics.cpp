@@ -15,12 +15,14 @@
 #include "planning_evaluator/metrics/obstacle_metrics.hpp"
 
 #include "autoware_utils/autoware_utils.hpp"
-#include "eigen3/Eigen/Core"
 
 #include "autoware_planning_msgs/msg/trajectory_point.hpp"
 
+#include <boost/geometry.hpp>
+
 #include <algorithm>
 #include <limits>
+#include <vector>
 
 namespace planning_diagnostics
 {
@@ -28,24 +30,51 @@ namespace metrics
 {
 using autoware_planning_msgs::msg::TrajectoryPoint;
 using autoware_utils::calcDistance2d;
+namespace bgi = boost::geometry::index;
+
+namespace
+{
+autoware_utils::Point2d toPoint2d(const TrajectoryPoint & p)
+{
+  return autoware_utils::Point2d(p.pose.position.x, p.pose.position.y);
+}
+
+// distance to the closest obstacle, max if there are no obstacles
+double calcDistanceToClosestObstacle(const ObstacleRtree & obstacles, const TrajectoryPoint & p)
+{
+  const auto point = toPoint2d(p);
+  const auto nearest = obstacles.qbegin(bgi::nearest(point, 1));
+  if (nearest == obstacles.qend()) {
+    return std::numeric_limits<double>::max();
+  }
+  return boost::geometry::distance(point, *nearest);
+}
+}  // namespace
 
-Stat<double> calcDistanceToObstacle(const DynamicObjectArray & obstacles, const Trajectory & traj)
+ObstacleRtree createObstacleRtree(const DynamicObjectArray & obstacles)
+{
+  std::vector<autoware_utils::Point2d> points;
+  points.reserve(obstacles.objects.size());
+  for (const auto & object : obstacles.objects) {
+    // TODO(Maxime CLEMENT): take into account the shape, not only the centroid
+    const auto & position = object.state.pose_covariance.pose.position;
+    points.emplace_back(position.x, position.y);
+  }
+  // packing construction
+  return ObstacleRtree(points.begin(), points.end());
+}
+
+Stat<double> calcDistanceToObstacle(const ObstacleRtree & obstacles, const Trajectory & traj)
 {
   Stat<double> stat;
   for (const TrajectoryPoint & p : traj.points) {
-    double min_dist = std::numeric_limits<double>::max();
-    for (const auto & object : obstacles.objects) {
-      // TODO(Maxime CLEMENT): take into account the shape, not only the centroid
-      const auto dist = calcDistance2d(object.state.pose_covariance.pose, p);
-      min_dist = std::min(min_dist, dist);
-    }
-    stat.add(min_dist);
+    stat.add(calcDistanceToClosestObstacle(obstacles, p));
   }
   return stat;
 }
 
 Stat<double> calcTimeToCollision(
-  const DynamicObjectArray & obstacles, const Trajectory & traj, const double distance_threshold)
+  const ObstacleRtree & obstacles, const Trajectory & traj, const double distance_threshold)
 {
   Stat<double> stat;
   /** TODO(Maxime CLEMENT):
@@ -62,13 +91,9 @@ Stat<double> calcTimeToCollision(
     if (p0.twist.linear.x != 0) {
       const double dt = traj_dist / std::abs(p0.twist.linear.x);
       t += dt;
-      for (auto obstacle : obstacles.objects) {
-        const double obst_dist = calcDistance2d(p, obstacle.state.pose_covariance.pose);
-        // TODO(Maxime CLEMENT): take shape into consideration
-        if (obst_dist <= distance_threshold) {
-          stat.add(t);
-          break;
-        }
+      // TODO(Maxime CLEMENT): take shape into consideration
+      if (calcDistanceToClosestObstacle(obstacles, p) <= distance_threshold) {
+        stat.add(t);
       }
     }
     if (stat.count() > 0) {
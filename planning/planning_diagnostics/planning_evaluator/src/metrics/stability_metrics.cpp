@@ -15,11 +15,12 @@
 #include "planning_evaluator/metrics/stability_metrics.hpp"
 
 #include "autoware_utils/autoware_utils.hpp"
-#include "eigen3/Eigen/Core"
 
 #include "autoware_planning_msgs/msg/trajectory_point.hpp"
 
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 namespace planning_diagnostics
 {
@@ -27,6 +28,57 @@ namespace metrics
 {
 using autoware_planning_msgs::msg::TrajectoryPoint;
 
+namespace
+{
+/**
+ * @brief index of the nearest point, searched from the index of the nearest point of the previous
+ * target. The targets taken in order along a similar trajectory move monotonically along the
+ * points, so that the search over all the targets is linear instead of quadratic.
+ */
+size_t findNearestIndexFrom(
+  const std::vector<TrajectoryPoint> & points, const geometry_msgs::msg::Point & target,
+  size_t idx)
+{
+  double min_dist = autoware_utils::calcSquaredDistance2d(points.at(idx), target);
+  while (idx + 1 < points.size()) {
+    const double dist = autoware_utils::calcSquaredDistance2d(points.at(idx + 1), target);
+    if (dist >= min_dist) {
+      break;
+    }
+    min_dist = dist;
+    ++idx;
+  }
+  while (idx > 0) {
+    const double dist = autoware_utils::calcSquaredDistance2d(points.at(idx - 1), target);
+    if (dist >= min_dist) {
+      break;
+    }
+    min_dist = dist;
+    --idx;
+  }
+  return idx;
+}
+
+/**
+ * @brief same as autoware_utils::findNearestSegmentIndex, from the index of the nearest point
+ */
+size_t getNearestSegmentIndex(
+  const std::vector<TrajectoryPoint> & points, const geometry_msgs::msg::Point & target,
+  const size_t nearest_idx)
+{
+  if (nearest_idx == 0) {
+    return 0;
+  }
+  if (nearest_idx == points.size() - 1) {
+    return points.size() - 2;
+  }
+  if (autoware_utils::calcLongitudinalOffsetToSegment(points, nearest_idx, target) <= 0) {
+    return nearest_idx - 1;
+  }
+  return nearest_idx;
+}
+}  // namespace
+
 Stat<double> calcFrechetDistance(const Trajectory & traj1, const Trajectory & traj2)
 {
   Stat<double> stat;
@@ -35,36 +87,50 @@ Stat<double> calcFrechetDistance(const Trajectory & traj1, const Trajectory & tr
     return stat;
   }
 
-  Eigen::MatrixXd ca = Eigen::MatrixXd::Zero(traj1.points.size(), traj2.points.size());
+  // only the previous row of the coupling matrix is needed to calculate a row
+  std::vector<double> prev_row(traj2.points.size());
+  std::vector<double> row(traj2.points.size());
 
   for (size_t i = 0; i < traj1.points.size(); ++i) {
     for (size_t j = 0; j < traj2.points.size(); ++j) {
       const double dist = autoware_utils::calcDistance2d(traj1.points[i], traj2.points[j]);
       if (i > 0 && j > 0) {
-        ca(i, j) = std::max(std::min(ca(i - 1, j), std::min(ca(i - 1, j - 1), ca(i, j - 1))), dist);
+        row[j] = std::max(std::min(prev_row[j], std::min(prev_row[j - 1], row[j - 1])), dist);
       } else if (i > 0 /*&& j == 0*/) {
-        ca(i, j) = std::max(ca(i - 1, 0), dist);
+        row[j] = std::max(prev_row[0], dist);
       } else if (j > 0 /*&& i == 0*/) {
-        ca(i, j) = std::max(ca(0, j - 1), dist);
+        row[j] = std::max(row[j - 1], dist);
       } else { /* i == j == 0 */
-        ca(i, j) = dist;
+        row[j] = dist;
       }
     }
+    std::swap(row, prev_row);
   }
-  stat.add(ca(traj1.points.size() - 1, traj2.points.size() - 1));
+  stat.add(prev_row.back());
   return stat;
 }
 
 Stat<double> calcLateralDistance(const Trajectory & traj1, const Trajectory & traj2)
 {
   Stat<double> stat;
-  if (traj1.points.empty()) {
+  if (traj1.points.empty() || traj2.points.empty()) {
     return stat;
   }
-  for (const auto point : traj2.points) {
+  if (traj1.points.size() == 1) {
+    for (const auto & point : traj2.points) {
+      stat.add(autoware_utils::calcDistance2d(traj1.points.front(), point));
+    }
+    return stat;
+  }
+
+  // the points of traj2 are projected in order, each search starts from the previous projection
+  size_t nearest_idx =
+    autoware_utils::findNearestIndex(traj1.points, autoware_utils::getPoint(traj2.points.front()));
+  for (const auto & point : traj2.points) {
     const auto p0 = autoware_utils::getPoint(point);
+    nearest_idx = findNearestIndexFrom(traj1.points, p0, nearest_idx);
     // find nearest segment
-    const size_t nearest_segment_idx = autoware_utils::findNearestSegmentIndex(traj1.points, p0);
+    const size_t nearest_segment_idx = getNearestSegmentIndex(traj1.points, p0, nearest_idx);
     double dist;
     // distance to segment
     if (
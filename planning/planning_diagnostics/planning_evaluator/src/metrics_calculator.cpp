@@ -50,24 +50,20 @@ Stat<double> MetricsCalculator::calculate(const Metric metric, const Trajectory
       return metrics::calcVelocityDeviation(reference_trajectory_, traj);
     case Metric::stability_frechet:
       return metrics::calcFrechetDistance(
-        getLookaheadTrajectory(
-          previous_trajectory_, parameters.trajectory.lookahead.max_dist_m,
-          parameters.trajectory.lookahead.max_time_s),
+        previous_trajectory_lookahead_,
         getLookaheadTrajectory(
           traj, parameters.trajectory.lookahead.max_dist_m,
           parameters.trajectory.lookahead.max_time_s));
     case Metric::stability:
       return metrics::calcLateralDistance(
-        getLookaheadTrajectory(
-          previous_trajectory_, parameters.trajectory.lookahead.max_dist_m,
-          parameters.trajectory.lookahead.max_time_s),
+        previous_trajectory_lookahead_,
         getLookaheadTrajectory(
           traj, parameters.trajectory.lookahead.max_dist_m,
           parameters.trajectory.lookahead.max_time_s));
     case Metric::obstacle_distance:
-      return metrics::calcDistanceToObstacle(dynamic_objects_, traj);
+      return metrics::calcDistanceToObstacle(obstacle_rtree_, traj);
     case Metric::obstacle_ttc:
-      return metrics::calcTimeToCollision(dynamic_objects_, traj, parameters.obstacle.dist_thr_m);
+      return metrics::calcTimeToCollision(obstacle_rtree_, traj, parameters.obstacle.dist_thr_m);
     default:
       throw std::runtime_error(
         "[MetricsCalculator][calculate()] unknown Metric " +
@@ -83,14 +79,27 @@ void MetricsCalculator::setReferenceTrajectory(const Trajectory & traj)
 void MetricsCalculator::setPreviousTrajectory(const Trajectory & traj)
 {
   previous_trajectory_ = traj;
+  updatePreviousTrajectoryLookahead();
 }
 
 void MetricsCalculator::setDynamicObjects(const DynamicObjectArray & objects)
 {
-  dynamic_objects_ = objects;
+  obstacle_rtree_ = metrics::createObstacleRtree(objects);
 }
 
-void MetricsCalculator::setEgoPose(const geometry_msgs::msg::Pose & pose) { ego_pose_ = pose; }
+void MetricsCalculator::setEgoPose(const geometry_msgs::msg::Pose & pose)
+{
+  ego_pose_ = pose;
+  updatePreviousTrajectoryLookahead();
+}
+
+void MetricsCalculator::updatePreviousTrajectoryLookahead()
+{
+  // calculated once per ego pose instead of once per stability metric
+  previous_trajectory_lookahead_ = getLookaheadTrajectory(
+    previous_trajectory_, parameters.trajectory.lookahead.max_dist_m,
+    parameters.trajectory.lookahead.max_time_s);
+}
 
 Trajectory MetricsCalculator::getLookaheadTrajectory(
   const Trajectory & traj, const double max_dist_m, const double max_time_s) const
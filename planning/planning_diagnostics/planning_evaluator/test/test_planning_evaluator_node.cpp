@@ -386,6 +386,12 @@ TEST_F(EvalTest, TestObstacleDistance)
   EXPECT_DOUBLE_EQ(publishTrajectoryAndGetMetric(t), 0.5);
   Trajectory t2 = makeTrajectory({{0.0, 0.0}, {1.0, 0.0}, {2.0, 0.0}});
   EXPECT_DOUBLE_EQ(publishTrajectoryAndGetMetric(t2), 1.0);  // (0.0 + 1.0 + 2.0) / 3
+
+  // distance to the closest of several obstacles
+  obj.state.pose_covariance.pose.position.x = 2.0;
+  objs.objects.push_back(obj);
+  publishObjects(objs);
+  EXPECT_DOUBLE_EQ(publishTrajectoryAndGetMetric(t2), 1.0 / 3);  // (0.0 + 1.0 + 0.0) / 3
 }
 
 TEST_F(EvalTest, TestObstacleTTC)
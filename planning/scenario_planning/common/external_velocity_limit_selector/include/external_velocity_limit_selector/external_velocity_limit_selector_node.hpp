@@ -15,15 +15,17 @@
 #ifndef EXTERNAL_VELOCITY_LIMIT_SELECTOR__EXTERNAL_VELOCITY_LIMIT_SELECTOR_NODE_HPP_
 #define EXTERNAL_VELOCITY_LIMIT_SELECTOR__EXTERNAL_VELOCITY_LIMIT_SELECTOR_NODE_HPP_
 
+#include <diagnostic_updater/diagnostic_updater.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_planning_msgs/msg/velocity_limit.hpp>
 #include <autoware_planning_msgs/msg/velocity_limit_clear_command.hpp>
 
-#include <deque>
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 using autoware_planning_msgs::msg::VelocityLimit;
 using autoware_planning_msgs::msg::VelocityLimitClearCommand;
@@ -51,6 +53,8 @@ public:
     double limit_max_acc;
     double limit_min_jerk;
     double limit_max_jerk;
+    // velocity limits from internal modules expire after this time, disabled if not positive
+    double timeout_internal;
   };
 
 private:
@@ -59,17 +63,44 @@ private:
   rclcpp::Subscription<VelocityLimitClearCommand>::SharedPtr sub_velocity_limit_clear_command_;
   rclcpp::Publisher<VelocityLimit>::SharedPtr pub_external_velocity_limit_;
 
+  rclcpp::TimerBase::SharedPtr timer_;
+  diagnostic_updater::Updater updater_;
+
   void publishVelocityLimit(const VelocityLimit & velocity_limit);
   void setVelocityLimitFromAPI(const VelocityLimit & velocity_limit);
   void setVelocityLimitFromInternal(const VelocityLimit & velocity_limit);
   void clearVelocityLimit(const std::string & sender);
   void updateVelocityLimit();
   VelocityLimit getCurrentVelocityLimit() { return hardest_limit_; }
+  void onTimer();
+  void checkBindingVelocityLimit(diagnostic_updater::DiagnosticStatusWrapper & stat);
 
   // Parameters
   NodeParam node_param_{};
   VelocityLimit hardest_limit_{};
-  std::unordered_map<std::string, VelocityLimit> velocity_limit_table_;
+  std::string binding_sender_;  //!< @brief sender of the max velocity of the hardest limit
+
+  struct VelocityLimitEntry
+  {
+    VelocityLimit velocity_limit;
+    // guarded against nan and inf
+    double max_velocity;
+    VelocityLimitConstraints constraints;
+    // seconds of the node clock, infinite if the limit doesn't expire
+    double expiry_time;
+  };
+  using IndexKey = std::pair<double, std::string>;
+
+  // The indices are ordered by the value and the sender, so that the hardest limit and the next
+  // expiring limit are found in O(log n) of the number of senders
+  std::unordered_map<std::string, VelocityLimitEntry> velocity_limit_table_;
+  std::set<IndexKey> max_velocity_index_;
+  std::set<IndexKey> max_jerk_index_;
+  std::set<IndexKey> expiry_index_;
+
+  void insertVelocityLimit(
+    const std::string & sender, const VelocityLimit & velocity_limit, const double expiry_time);
+  void eraseVelocityLimit(const std::string & sender);
 };
 
 #endif  // EXTERNAL_VELOCITY_LIMIT_SELECTOR__EXTERNAL_VELOCITY_LIMIT_SELECTOR_NODE_HPP_
@@ -14,62 +14,29 @@
 
 #include "external_velocity_limit_selector/external_velocity_limit_selector_node.hpp"
 
-#include <deque>
+#include <chrono>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <utility>
-#include <vector>
 
 namespace
 {
-VelocityLimit getHardestLimit(
-  const std::unordered_map<std::string, VelocityLimit> & velocity_limits,
+VelocityLimitConstraints getNormalConstraints(
   const ExternalVelocityLimitSelectorNode::NodeParam & node_param)
 {
-  VelocityLimit hardest_limit{};
-  hardest_limit.max_velocity = node_param.max_velocity;
-
   VelocityLimitConstraints normal_constraints{};
   normal_constraints.min_acceleration = node_param.normal_min_acc;
   normal_constraints.min_jerk = node_param.normal_min_jerk;
   normal_constraints.max_jerk = node_param.normal_max_jerk;
-
-  double hardest_max_velocity = node_param.max_velocity;
-  double hardest_max_jerk = 0.0;
-
-  for (const auto & limit : velocity_limits) {
-    // guard nan, inf
-    const auto max_velocity = std::isfinite(limit.second.max_velocity) ? limit.second.max_velocity
-                                                                       : node_param.max_velocity;
-
-    // find hardest max velocity
-    if (max_velocity < hardest_max_velocity) {
-      hardest_limit.stamp = limit.second.stamp;
-      hardest_limit.max_velocity = max_velocity;
-      hardest_max_velocity = max_velocity;
-    }
-
-    const auto constraints =
-      limit.second.use_constraints && std::isfinite(limit.second.constraints.max_jerk)
-        ? limit.second.constraints
-        : normal_constraints;
-
-    // find hardest jerk
-    if (hardest_max_jerk < constraints.max_jerk) {
-      hardest_limit.constraints = constraints;
-      hardest_limit.use_constraints = true;
-      hardest_max_jerk = constraints.max_jerk;
-    }
-  }
-
-  return hardest_limit;
+  return normal_constraints;
 }
 }  // namespace
 
 ExternalVelocityLimitSelectorNode::ExternalVelocityLimitSelectorNode(
   const rclcpp::NodeOptions & node_options)
-: Node("external_velocity_limit_selector", node_options)
+: Node("external_velocity_limit_selector", node_options), updater_(this)
 {
   using std::placeholders::_1;
   // Input
@@ -101,6 +68,19 @@ ExternalVelocityLimitSelectorNode::ExternalVelocityLimitSelectorNode(
     p.limit_max_acc = this->declare_parameter<double>("limit.max_acc", 2.5);
     p.limit_min_jerk = this->declare_parameter<double>("limit.min_jerk", -1.5);
     p.limit_max_jerk = this->declare_parameter<double>("limit.max_jerk", 1.5);
+    p.timeout_internal = this->declare_parameter<double>("timeout_internal", 0.0);
+  }
+
+  // Diagnostics
+  updater_.setHardwareID("external_velocity_limit_selector");
+  updater_.add(
+    "binding_velocity_limit", this, &ExternalVelocityLimitSelectorNode::checkBindingVelocityLimit);
+
+  // Timer
+  if (node_param_.timeout_internal > 0.0) {
+    using namespace std::chrono_literals;
+    timer_ = rclcpp::create_timer(
+      this, get_clock(), 100ms, std::bind(&ExternalVelocityLimitSelectorNode::onTimer, this));
   }
 }
 
@@ -147,13 +127,13 @@ void ExternalVelocityLimitSelectorNode::setVelocityLimitFromAPI(
 {
   const std::string sender = "api";
 
-  if (velocity_limit_table_.count(sender) == 0) {
-    velocity_limit_table_.emplace(sender, velocity_limit);
-  } else {
-    velocity_limit_table_.at(sender) = velocity_limit;
+  if (velocity_limit_table_.count(sender) != 0) {
     RCLCPP_DEBUG(get_logger(), "overwrite velocity limit. sender:%s", sender.c_str());
   }
 
+  // the velocity limit from api is kept until it is overwritten
+  insertVelocityLimit(sender, velocity_limit, std::numeric_limits<double>::infinity());
+
   updateVelocityLimit();
 }
 
@@ -162,13 +142,16 @@ void ExternalVelocityLimitSelectorNode::setVelocityLimitFromInternal(
 {
   const auto sender = velocity_limit.sender;
 
-  if (velocity_limit_table_.count(sender) == 0) {
-    velocity_limit_table_.emplace(sender, velocity_limit);
-  } else {
-    velocity_limit_table_.at(sender) = velocity_limit;
+  if (velocity_limit_table_.count(sender) != 0) {
     RCLCPP_DEBUG(get_logger(), "overwrite velocity limit. sender:%s", sender.c_str());
   }
 
+  // a sender which stopped without clearing its velocity limit doesn't keep it forever
+  const double expiry_time = node_param_.timeout_internal > 0.0
+                               ? this->now().seconds() + node_param_.timeout_internal
+                               : std::numeric_limits<double>::infinity();
+  insertVelocityLimit(sender, velocity_limit, expiry_time);
+
   updateVelocityLimit();
 }
 
@@ -179,11 +162,50 @@ void ExternalVelocityLimitSelectorNode::clearVelocityLimit(const std::string & s
     return;
   }
 
-  velocity_limit_table_.erase(sender);
+  eraseVelocityLimit(sender);
 
   updateVelocityLimit();
 }
 
+void ExternalVelocityLimitSelectorNode::insertVelocityLimit(
+  const std::string & sender, const VelocityLimit & velocity_limit, const double expiry_time)
+{
+  eraseVelocityLimit(sender);
+
+  VelocityLimitEntry entry{};
+  entry.velocity_limit = velocity_limit;
+
+  // guard nan, inf
+  entry.max_velocity = std::isfinite(velocity_limit.max_velocity) ? velocity_limit.max_velocity
+                                                                  : node_param_.max_velocity;
+  entry.constraints =
+    velocity_limit.use_constraints && std::isfinite(velocity_limit.constraints.max_jerk)
+      ? velocity_limit.constraints
+      : getNormalConstraints(node_param_);
+  entry.expiry_time = expiry_time;
+
+  max_velocity_index_.emplace(entry.max_velocity, sender);
+  max_jerk_index_.emplace(entry.constraints.max_jerk, sender);
+  if (std::isfinite(expiry_time)) {
+    expiry_index_.emplace(expiry_time, sender);
+  }
+  velocity_limit_table_.emplace(sender, entry);
+}
+
+void ExternalVelocityLimitSelectorNode::eraseVelocityLimit(const std::string & sender)
+{
+  const auto itr = velocity_limit_table_.find(sender);
+  if (itr == velocity_limit_table_.end()) {
+    return;
+  }
+
+  const auto & entry = itr->second;
+  max_velocity_index_.erase({entry.max_velocity, sender});
+  max_jerk_index_.erase({entry.constraints.max_jerk, sender});
+  expiry_index_.erase({entry.expiry_time, sender});
+  velocity_limit_table_.erase(itr);
+}
+
 void ExternalVelocityLimitSelectorNode::updateVelocityLimit()
 {
   if (velocity_limit_table_.empty()) {
@@ -192,6 +214,7 @@ void ExternalVelocityLimitSelectorNode::updateVelocityLimit()
     default_velocity_limit.max_velocity = node_param_.max_velocity;
 
     hardest_limit_ = default_velocity_limit;
+    binding_sender_.clear();
 
     RCLCPP_DEBUG(
       get_logger(),
@@ -200,7 +223,64 @@ void ExternalVelocityLimitSelectorNode::updateVelocityLimit()
     return;
   }
 
-  hardest_limit_ = getHardestLimit(velocity_limit_table_, node_param_);
+  VelocityLimit hardest_limit{};
+  hardest_limit.max_velocity = node_param_.max_velocity;
+  binding_sender_.clear();
+
+  // find hardest max velocity
+  const auto & min_max_velocity = *max_velocity_index_.begin();
+  if (min_max_velocity.first < node_param_.max_velocity) {
+    const auto & sender = min_max_velocity.second;
+    hardest_limit.stamp = velocity_limit_table_.at(sender).velocity_limit.stamp;
+    hardest_limit.max_velocity = min_max_velocity.first;
+    binding_sender_ = sender;
+  }
+
+  // find hardest jerk
+  const auto & max_max_jerk = *max_jerk_index_.rbegin();
+  if (0.0 < max_max_jerk.first) {
+    hardest_limit.constraints = velocity_limit_table_.at(max_max_jerk.second).constraints;
+    hardest_limit.use_constraints = true;
+  }
+
+  hardest_limit_ = hardest_limit;
+}
+
+void ExternalVelocityLimitSelectorNode::onTimer()
+{
+  const double now = this->now().seconds();
+
+  bool is_expired = false;
+  while (!expiry_index_.empty() && expiry_index_.begin()->first < now) {
+    const auto sender = expiry_index_.begin()->second;
+    RCLCPP_WARN(get_logger(), "velocity limit expired. sender:%s", sender.c_str());
+    eraseVelocityLimit(sender);
+    is_expired = true;
+  }
+
+  if (!is_expired) {
+    return;
+  }
+
+  updateVelocityLimit();
+
+  const auto velocity_limit = getCurrentVelocityLimit();
+  publishVelocityLimit(velocity_limit);
+}
+
+void ExternalVelocityLimitSelectorNode::checkBindingVelocityLimit(
+  diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  stat.add("number of senders", velocity_limit_table_.size());
+  stat.add("max velocity", hardest_limit_.max_velocity);
+
+  if (binding_sender_.empty()) {
+    stat.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "not limited");
+    return;
+  }
+
+  stat.add("binding sender", binding_sender_);
+  stat.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "limited by " + binding_sender_);
 }
 
 #include <rclcpp_components/register_node_macro.hpp>
@@ -0,0 +1,156 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Measures the time of one smoothing cycle of the optimization based smoothers for trajectories
+// of increasing length. The first cycle of a new smoother sets up the QP workspace, the following
+// ones only update its values, as when the node runs. The L2 and JerkFiltered smoothers are also
+// run with the banded ADMM solver, and compared to their OSQP solution.
+
+#include "motion_velocity_smoother/smoother/jerk_filtered_smoother.hpp"
+#include "motion_velocity_smoother/smoother/l2_pseudo_jerk_smoother.hpp"
+#include "motion_velocity_smoother/smoother/linf_pseudo_jerk_smoother.hpp"
+
+#include <autoware_replay_benchmark/micro_benchmark.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+using motion_velocity_smoother::SmootherBase;
+using motion_velocity_smoother::Trajectory;
+
+using autoware_replay_benchmark::MicroBenchmark;
+
+constexpr double INTERVAL_DIST = 1.0;
+constexpr double MAX_VEL = 10.0;
+
+// straight trajectory with a stop point at the end
+Trajectory createTrajectory(const size_t num_points)
+{
+  Trajectory trajectory;
+  trajectory.points.resize(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    auto & p = trajectory.points.at(i);
+    p.pose.position.x = i * INTERVAL_DIST;
+    p.pose.orientation.w = 1.0;
+    p.twist.linear.x = i + 1 < num_points ? MAX_VEL : 0.0;
+  }
+  return trajectory;
+}
+
+SmootherBase::BaseParam createBaseParam(
+  const size_t num_points, const SmootherBase::QPSolverType qp_solver_type)
+{
+  SmootherBase::BaseParam param;
+  param.qp_solver_type = qp_solver_type;
+  param.max_accel = 2.0;
+  param.min_decel = -3.0;
+  param.stop_decel = 0.0;
+  param.max_jerk = 0.3;
+  param.min_jerk = -0.1;
+  param.max_lateral_accel = 0.2;
+  param.min_curve_velocity = 1.38;
+  param.decel_distance_before_curve = 3.5;
+  param.decel_distance_after_curve = 0.0;
+  // the jerk filtered smoother resamples its input to about num_points points
+  param.resample_param.max_trajectory_length = num_points * INTERVAL_DIST;
+  param.resample_param.min_trajectory_length = 0.0;
+  param.resample_param.dense_resample_dt = INTERVAL_DIST / MAX_VEL;
+  param.resample_param.resample_time = num_points * param.resample_param.dense_resample_dt;
+  param.resample_param.dense_min_interval_distance = INTERVAL_DIST;
+  param.resample_param.sparse_resample_dt = param.resample_param.dense_resample_dt;
+  param.resample_param.sparse_min_interval_distance = INTERVAL_DIST;
+  return param;
+}
+
+// create_smoother returns a new smoother, so that the first cycle can be measured each time
+Trajectory runBenchmark(
+  MicroBenchmark & benchmark, const std::string & name,
+  const std::function<std::unique_ptr<SmootherBase>()> & create_smoother, const size_t num_points,
+  const SmootherBase::QPSolverType qp_solver_type = SmootherBase::QPSolverType::OSQP)
+{
+  const auto param = createBaseParam(num_points, qp_solver_type);
+  const auto input = createTrajectory(num_points);
+  Trajectory output;
+  std::vector<Trajectory> debug_trajectories;
+  const std::string suffix = "/N=" + std::to_string(num_points);
+
+  benchmark.run(name + "/first_cycle" + suffix, [&]() {
+    const auto smoother = create_smoother();
+    smoother->setParam(param);
+    smoother->apply(MAX_VEL, 0.0, input, output, debug_trajectories);
+  });
+
+  const auto smoother = create_smoother();
+  smoother->setParam(param);
+  bool is_succeeded = true;
+  benchmark.run(name + suffix, [&]() {
+    is_succeeded &= smoother->apply(MAX_VEL, 0.0, input, output, debug_trajectories);
+  });
+  if (!is_succeeded) {
+    std::fprintf(stderr, "%s%s failed\n", name.c_str(), suffix.c_str());
+  }
+  return output;
+}
+
+void printMaxVelocityDifference(const Trajectory & a, const Trajectory & b)
+{
+  double max_diff = 0.0;
+  for (size_t i = 0; i < std::min(a.points.size(), b.points.size()); ++i) {
+    max_diff = std::max(
+      max_diff, std::abs(a.points.at(i).twist.linear.x - b.points.at(i).twist.linear.x));
+  }
+  std::fprintf(stderr, "%-56s max velocity difference %.4f m/s\n", "", max_diff);
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  using motion_velocity_smoother::JerkFilteredSmoother;
+  using motion_velocity_smoother::L2PseudoJerkSmoother;
+  using motion_velocity_smoother::LinfPseudoJerkSmoother;
+  constexpr auto BANDED_ADMM = SmootherBase::QPSolverType::BANDED_ADMM;
+  const L2PseudoJerkSmoother::Param l2_param{100.0, 100000.0, 1000.0};
+  const LinfPseudoJerkSmoother::Param linf_param{200.0, 100000.0, 5000.0};
+  const JerkFilteredSmoother::Param jerk_filtered_param{10.0, 100000.0, 5000.0, 2000.0, 0.1};
+  const auto create_l2 = [&]() { return std::make_unique<L2PseudoJerkSmoother>(l2_param); };
+  const auto create_linf = [&]() { return std::make_unique<LinfPseudoJerkSmoother>(linf_param); };
+  const auto create_jerk_filtered = [&]() {
+    return std::make_unique<JerkFilteredSmoother>(jerk_filtered_param);
+  };
+
+  MicroBenchmark benchmark("motion_velocity_smoother", argc, argv);
+  for (const size_t num_points : {100, 200, 400, 800}) {
+    const auto l2_osqp = runBenchmark(benchmark, "L2", create_l2, num_points);
+    printMaxVelocityDifference(
+      l2_osqp, runBenchmark(benchmark, "L2/BandedADMM", create_l2, num_points, BANDED_ADMM));
+
+    runBenchmark(benchmark, "Linf", create_linf, num_points);
+
+    const auto jerk_filtered_osqp =
+      runBenchmark(benchmark, "JerkFiltered", create_jerk_filtered, num_points);
+    printMaxVelocityDifference(
+      jerk_filtered_osqp, runBenchmark(
+                            benchmark, "JerkFiltered/BandedADMM", create_jerk_filtered,
+                            num_points, BANDED_ADMM));
+  }
+  return benchmark.finish();
+}
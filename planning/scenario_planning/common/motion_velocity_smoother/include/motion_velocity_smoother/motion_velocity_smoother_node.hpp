@@ -22,6 +22,8 @@
 
 #include <autoware_utils/geometry/geometry.hpp>
 #include <autoware_utils/math/unit_conversion.hpp>
+#include <autoware_utils/ros/callback_timing_publisher.hpp>
+#include <autoware_utils/ros/latency_tracer.hpp>
 #include <autoware_utils/ros/self_pose_listener.hpp>
 #include <autoware_utils/system/stop_watch.hpp>
 #include <autoware_utils/trajectory/trajectory.hpp>
@@ -88,6 +90,8 @@ private:
   Trajectory prev_output_;                                 // previously published trajectory
   boost::optional<TrajectoryPoint> prev_closest_point_{};  // previous trajectory point
                                                            // closest to ego vehicle
+  Trajectory prev_smoother_input_;   // previous input of the smoother, from the closest point
+  Trajectory prev_smoother_output_;  // previous output of the smoother
 
   autoware_utils::SelfPoseListener self_pose_listener_{this};
 
@@ -122,6 +126,8 @@ private:
     double extract_behind_dist;           // backward waypoints distance from current position [m]
     double stop_dist_to_prohibit_engage;  // prevent to move toward close stop point
     double delta_yaw_threshold;           // for closest index calculation
+    bool enable_incremental_smoothing;    // reuse the previous velocity before a path change
+    double incremental_smoothing_margin;  // distance re-solved before the path change [m]
     resampling::ResampleParam post_resample_param;
     AlgorithmType algorithm_type;  // Option : JerkFiltered, Linf, L2
   } node_param_{};
@@ -158,14 +164,18 @@ private:
   // non-const methods
   void publishClosestState(const TrajectoryPoint & closest_point);
 
+  Trajectory calcTrajectoryVelocity(const Trajectory & input);
+
+  bool smoothVelocity(const Trajectory & input, Trajectory & traj_smoothed);
+
   // const methods
   bool checkData() const;
 
   AlgorithmType getAlgorithmType(const std::string & algorithm_name) const;
 
-  Trajectory calcTrajectoryVelocity(const Trajectory & input) const;
+  SmootherBase::QPSolverType getQPSolverType(const std::string & solver_name) const;
 
-  bool smoothVelocity(const Trajectory & input, Trajectory & traj_smoothed) const;
+  Trajectory extractReusableVelocity(const Trajectory & input) const;
 
   std::tuple<double, double, InitializeType> calcInitialMotion(
     const Trajectory & input_traj, const size_t input_closest, const Trajectory & prev_traj) const;
@@ -204,6 +214,8 @@ private:
 
   // debug
   autoware_utils::StopWatch<std::chrono::milliseconds> stop_watch_;
+  autoware_utils::LatencyTracer latency_tracer_{this};
+  autoware_utils::CallbackTimingPublisher callback_timing_publisher_{this};
   std::shared_ptr<rclcpp::Time> prev_time_;
   double prev_acc_;
   rclcpp::Publisher<Float32Stamped>::SharedPtr pub_dist_to_stopline_;
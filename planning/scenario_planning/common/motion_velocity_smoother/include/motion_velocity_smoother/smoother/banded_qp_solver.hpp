@@ -0,0 +1,112 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOTION_VELOCITY_SMOOTHER__SMOOTHER__BANDED_QP_SOLVER_HPP_
+#define MOTION_VELOCITY_SMOOTHER__SMOOTHER__BANDED_QP_SOLVER_HPP_
+
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/SparseCore>
+
+#include <string>
+#include <vector>
+
+namespace motion_velocity_smoother
+{
+/**
+ * @brief ADMM solver of min 0.5 x^T P x + q^T x s.t. l <= A x <= u, with the same iterations as
+ * OSQP, for the QPs of the smoothers. Their variables are blocks of one value for each point,
+ * e.g. [b0, ..., bN, a0, ..., aN, ...], and their costs and constraints only couple neighbouring
+ * points. The variables are reordered point by point, so the linear system of each iteration is
+ * banded and factorized in O(N) instead of a general sparse LDL^T.
+ */
+class BandedQPSolver
+{
+public:
+  struct Settings
+  {
+    int max_iter;
+    double eps_abs;
+    double eps_rel;
+    double rho;    // initial step size, adapted when the residuals are unbalanced
+    double sigma;  // regularization of the variables
+    double alpha;  // relaxation
+    int check_interval;
+  };
+
+  explicit BandedQPSolver(const Settings & settings);
+
+  /**
+   * @brief solve the problem, warm started from the previous solution
+   * @param P upper triangular part of the cost matrix
+   * @param block_num number of the variable blocks, the number of variables must be its multiple
+   * @param x solution, also set when not converged
+   * @return false when not converged in max_iter iterations or the factorization failed
+   */
+  bool solve(
+    const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+    const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u,
+    const size_t block_num, std::vector<double> & x);
+
+  void setSettings(const Settings & settings) { settings_ = settings; }
+  int getTakenIter() const { return taken_iter_; }
+  std::string getStatusMessage() const { return status_message_; }
+
+private:
+  using SparseMatrix = Eigen::SparseMatrix<double>;
+  using RowMajorSparseMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+  void scaleProblem();
+  // factorizes P + sigma I + A^T diag(rho) A
+  bool factorize();
+  void solveFactorized(Eigen::VectorXd & b) const;
+  // rho of each constraint from the current rho, larger for the equality constraints
+  void updateRhoVector();
+  double getBand(const size_t row, const size_t col) const
+  {
+    return band_[row * (bandwidth_ + 1) + row - col];
+  }
+  double & getBand(const size_t row, const size_t col)
+  {
+    return band_[row * (bandwidth_ + 1) + row - col];
+  }
+
+  Settings settings_;
+  int taken_iter_{0};
+  std::string status_message_;
+
+  // scaled problem, in the point by point order
+  SparseMatrix P_;  // full symmetric matrix
+  RowMajorSparseMatrix A_;
+  SparseMatrix At_;
+  Eigen::VectorXd q_;
+  Eigen::VectorXd l_;
+  Eigen::VectorXd u_;
+  Eigen::VectorXd D_;  // variable scaling
+  Eigen::VectorXd E_;  // constraint scaling
+  double c_{1.0};      // cost scaling
+
+  double rho_{0.1};
+  Eigen::VectorXd rho_vec_;
+  // lower band of the Cholesky factor, (bandwidth + 1) values for each row
+  std::vector<double> band_;
+  size_t bandwidth_{0};
+
+  // unscaled solution of the previous problem in the point by point order, for the warm start
+  size_t prev_block_num_{0};
+  Eigen::VectorXd prev_x_;
+  Eigen::VectorXd prev_y_;
+};
+}  // namespace motion_velocity_smoother
+
+#endif  // MOTION_VELOCITY_SMOOTHER__SMOOTHER__BANDED_QP_SOLVER_HPP_
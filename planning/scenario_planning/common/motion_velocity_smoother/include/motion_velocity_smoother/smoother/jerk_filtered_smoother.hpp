@@ -15,6 +15,7 @@
 #ifndef MOTION_VELOCITY_SMOOTHER__SMOOTHER__JERK_FILTERED_SMOOTHER_HPP_
 #define MOTION_VELOCITY_SMOOTHER__SMOOTHER__JERK_FILTERED_SMOOTHER_HPP_
 
+#include "motion_velocity_smoother/smoother/banded_qp_solver.hpp"
 #include "motion_velocity_smoother/smoother/smoother_base.hpp"
 
 #include <autoware_utils/geometry/geometry.hpp>
@@ -57,6 +58,7 @@ public:
 private:
   Param smoother_param_;
   osqp::OSQPInterface qp_solver_;
+  BandedQPSolver banded_qp_solver_;
   rclcpp::Logger logger_{rclcpp::get_logger("smoother").get_child("jerk_filtered_smoother")};
 
   Trajectory forwardJerkFilter(
@@ -15,6 +15,7 @@
 #ifndef MOTION_VELOCITY_SMOOTHER__SMOOTHER__L2_PSEUDO_JERK_SMOOTHER_HPP_
 #define MOTION_VELOCITY_SMOOTHER__SMOOTHER__L2_PSEUDO_JERK_SMOOTHER_HPP_
 
+#include "motion_velocity_smoother/smoother/banded_qp_solver.hpp"
 #include "motion_velocity_smoother/smoother/smoother_base.hpp"
 
 #include <autoware_utils/geometry/geometry.hpp>
@@ -55,6 +56,7 @@ public:
 private:
   Param smoother_param_;
   osqp::OSQPInterface qp_solver_;
+  BandedQPSolver banded_qp_solver_;
   rclcpp::Logger logger_{rclcpp::get_logger("smoother").get_child("l2_pseudo_jerk_smoother")};
 };
 }  // namespace motion_velocity_smoother
@@ -35,6 +35,11 @@ using autoware_planning_msgs::msg::Trajectory;
 class SmootherBase
 {
 public:
+  enum class QPSolverType {
+    OSQP = 0,
+    BANDED_ADMM = 1,  // BandedQPSolver, for the L2 and JerkFiltered smoothers
+  };
+
   struct BaseParam
   {
     double max_accel;   // max acceleration in planning [m/s2] > 0
@@ -47,6 +52,7 @@ public:
     double decel_distance_before_curve;  // distance before slow down for lateral acc at a curve
     double decel_distance_after_curve;   // distance after slow down for lateral acc at a curve
     resampling::ResampleParam resample_param;
+    QPSolverType qp_solver_type;
   };
 
   virtual ~SmootherBase() = default;
@@ -48,6 +48,10 @@ double calcArcLength(const Trajectory & trajectory, const int idx1, const int id
 
 std::vector<double> calcArclengthArray(const Trajectory & trajectory);
 
+// point at the arc length from the front, arclength is calcArclengthArray() of the trajectory
+TrajectoryPoint calcInterpolatedTrajectoryPoint(
+  const Trajectory & trajectory, const std::vector<double> & arclength, const double target_length);
+
 std::vector<double> calcTrajectoryIntervalDistance(const Trajectory & trajectory);
 
 boost::optional<std::vector<double>> calcTrajectoryCurvatureFrom3Points(
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <limits>
 #include <map>
 #include <memory>
@@ -157,6 +158,7 @@ rcl_interfaces::msg::SetParametersResult MotionVelocitySmootherNode::onParameter
     update_param("extract_behind_dist", p.extract_behind_dist);
     update_param("stop_dist_to_prohibit_engage", p.stop_dist_to_prohibit_engage);
     update_param("delta_yaw_threshold", p.delta_yaw_threshold);
+    update_param("incremental_smoothing_margin", p.incremental_smoothing_margin);
   }
 
   {
@@ -255,6 +257,8 @@ void MotionVelocitySmootherNode::initCommonParam()
   p.extract_behind_dist = declare_parameter("extract_behind_dist", 3.0);
   p.stop_dist_to_prohibit_engage = declare_parameter("stop_dist_to_prohibit_engage", 1.5);
   p.delta_yaw_threshold = declare_parameter("delta_yaw_threshold", M_PI / 3.0);
+  p.enable_incremental_smoothing = declare_parameter("enable_incremental_smoothing", false);
+  p.incremental_smoothing_margin = declare_parameter("incremental_smoothing_margin", 10.0);
   p.post_resample_param.max_trajectory_length =
     declare_parameter("post_max_trajectory_length", 300.0);
   p.post_resample_param.min_trajectory_length =
@@ -290,6 +294,7 @@ void MotionVelocitySmootherNode::initSmootherBaseParam()
   p.resample_param.sparse_resample_dt = declare_parameter("sparse_resample_dt", 0.5);
   p.resample_param.sparse_min_interval_distance =
     declare_parameter("sparse_min_interval_distance", 4.0);
+  p.qp_solver_type = getQPSolverType(declare_parameter("qp_solver_type", "OSQP"));
 }
 
 void MotionVelocitySmootherNode::initJerkFilteredSmootherParam()
@@ -429,9 +434,12 @@ bool MotionVelocitySmootherNode::checkData() const
 
 void MotionVelocitySmootherNode::onCurrentTrajectory(const Trajectory::ConstSharedPtr msg)
 {
+  autoware_utils::CallbackTimingPublisher::Scope scope(
+    &callback_timing_publisher_, "onCurrentTrajectory");
   base_traj_raw_ptr_ = msg;
 
   stop_watch_.tic();
+  latency_tracer_.onReceive(msg->header.stamp);
   RCLCPP_DEBUG(get_logger(), "========================= run start =========================");
 
   current_pose_ptr_ = self_pose_listener_.getCurrentPose();
@@ -487,6 +495,7 @@ void MotionVelocitySmootherNode::onCurrentTrajectory(const Trajectory::ConstShar
   // publish message
   output_resampled->header = base_traj_raw_ptr_->header;
   publishTrajectory(*output_resampled);
+  latency_tracer_.onPublish(output_resampled->header.stamp);
 
   // publish debug message
   publishStopDistance(output, *output_closest_idx);
@@ -504,7 +513,7 @@ void MotionVelocitySmootherNode::onCurrentTrajectory(const Trajectory::ConstShar
   RCLCPP_DEBUG(get_logger(), "========================== run() end ==========================\n\n");
 }
 
-Trajectory MotionVelocitySmootherNode::calcTrajectoryVelocity(const Trajectory & traj_input) const
+Trajectory MotionVelocitySmootherNode::calcTrajectoryVelocity(const Trajectory & traj_input)
 {
   Trajectory output{};  // velocity is optimized by qp solver
 
@@ -579,7 +588,7 @@ Trajectory MotionVelocitySmootherNode::calcTrajectoryVelocity(const Trajectory &
 }
 
 bool MotionVelocitySmootherNode::smoothVelocity(
-  const Trajectory & input, Trajectory & traj_smoothed) const
+  const Trajectory & input, Trajectory & traj_smoothed)
 {
   // Lateral acceleration limit
   const auto traj_lateral_acc_filtered = smoother_->applyLateralAccelerationFilter(input);
@@ -627,11 +636,44 @@ bool MotionVelocitySmootherNode::smoothVelocity(
     clipped.points.end(), traj_resampled->points.begin() + *traj_resampled_closest,
     traj_resampled->points.end());
 
+  // Only the points after the reused ones are optimized, from the last reused velocity
+  Trajectory reused;
+  if (node_param_.enable_incremental_smoothing && type == InitializeType::NORMAL) {
+    reused = extractReusableVelocity(clipped);
+  }
+  Trajectory smoother_input;
+  if (reused.points.empty()) {
+    smoother_input = clipped;
+  } else {
+    smoother_input.header = clipped.header;
+    smoother_input.points.assign(
+      clipped.points.begin() + reused.points.size() - 1, clipped.points.end());
+    initial_vel = reused.points.back().twist.linear.x;
+    initial_acc = reused.points.back().accel.linear.x;
+    reused.points.pop_back();
+    RCLCPP_DEBUG(
+      get_logger(), "smoothVelocity : reused %lu of %lu points", reused.points.size(),
+      clipped.points.size());
+  }
+
   std::vector<Trajectory> debug_trajectories;
-  if (!smoother_->apply(initial_vel, initial_acc, clipped, traj_smoothed, debug_trajectories)) {
+  const bool is_solved =
+    smoother_->apply(initial_vel, initial_acc, smoother_input, traj_smoothed, debug_trajectories);
+  if (!is_solved) {
     RCLCPP_WARN(get_logger(), "Fail to solve optimization.");
   }
 
+  traj_smoothed.points.insert(
+    traj_smoothed.points.begin(), reused.points.begin(), reused.points.end());
+  for (auto & debug_trajectory : debug_trajectories) {
+    debug_trajectory.points.insert(
+      debug_trajectory.points.begin(), reused.points.begin(), reused.points.end());
+  }
+
+  // a failed solution is not reused in the next cycle
+  prev_smoother_input_ = clipped;
+  prev_smoother_output_ = is_solved ? traj_smoothed : Trajectory{};
+
   traj_smoothed.points.insert(
     traj_smoothed.points.begin(), traj_resampled->points.begin(),
     traj_resampled->points.begin() + *traj_resampled_closest);
@@ -674,6 +716,68 @@ bool MotionVelocitySmootherNode::smoothVelocity(
   return true;
 }
 
+Trajectory MotionVelocitySmootherNode::extractReusableVelocity(const Trajectory & input) const
+{
+  constexpr double velocity_epsilon = 1.0e-3;  // [m/s]
+  constexpr double position_epsilon = 0.1;     // [m]
+
+  Trajectory reused;
+  reused.header = input.header;
+  if (
+    input.points.size() < 2 || prev_smoother_input_.points.size() < 2 ||
+    prev_smoother_output_.points.size() < 2) {
+    return reused;
+  }
+
+  // both previous trajectories start at the previous closest point
+  const auto prev_input_arclength = trajectory_utils::calcArclengthArray(prev_smoother_input_);
+  const auto prev_output_arclength = trajectory_utils::calcArclengthArray(prev_smoother_output_);
+  const auto input_arclength = trajectory_utils::calcArclengthArray(input);
+  const double offset = -autoware_utils::calcSignedArcLength(
+    prev_smoother_input_.points, input.points.front().pose.position, size_t{0});
+
+  // the first point where the velocity limit or the path is different from the previous input,
+  // the points beyond the previous input are all new
+  size_t change_idx = 0;
+  double max_velocity = 0.0;
+  for (; change_idx < input.points.size(); ++change_idx) {
+    const double prev_length = offset + input_arclength.at(change_idx);
+    if (prev_length < 0.0 || prev_length > prev_input_arclength.back()) {
+      break;
+    }
+    const auto & point = input.points.at(change_idx);
+    const auto prev_point = trajectory_utils::calcInterpolatedTrajectoryPoint(
+      prev_smoother_input_, prev_input_arclength, prev_length);
+    if (
+      std::abs(point.twist.linear.x - prev_point.twist.linear.x) > velocity_epsilon ||
+      autoware_utils::calcDistance2d(point, prev_point) > position_epsilon) {
+      break;
+    }
+    max_velocity = std::max(max_velocity, point.twist.linear.x);
+  }
+  if (change_idx == 0) {
+    return reused;
+  }
+
+  // the re-solved points must be long enough to decelerate for the change
+  const double min_decel = std::abs(smoother_->getMinDecel());
+  const double resolve_length =
+    max_velocity * max_velocity / (2.0 * min_decel) + node_param_.incremental_smoothing_margin;
+  const double reuse_length = input_arclength.at(change_idx - 1) - resolve_length;
+  for (size_t i = 0; i < change_idx && input_arclength.at(i) <= reuse_length; ++i) {
+    auto point = input.points.at(i);
+    const auto prev_point = trajectory_utils::calcInterpolatedTrajectoryPoint(
+      prev_smoother_output_, prev_output_arclength, offset + input_arclength.at(i));
+    point.twist.linear.x = prev_point.twist.linear.x;
+    point.accel.linear.x = prev_point.accel.linear.x;
+    reused.points.push_back(point);
+  }
+  if (reused.points.size() < 2) {
+    reused.points.clear();
+  }
+  return reused;
+}
+
 void MotionVelocitySmootherNode::insertBehindVelocity(
   const size_t output_closest, const InitializeType type, Trajectory & output) const
 {
@@ -972,6 +1076,19 @@ MotionVelocitySmootherNode::AlgorithmType MotionVelocitySmootherNode::getAlgorit
   return AlgorithmType::INVALID;
 }
 
+SmootherBase::QPSolverType MotionVelocitySmootherNode::getQPSolverType(
+  const std::string & solver_name) const
+{
+  if (solver_name == "OSQP") {
+    return SmootherBase::QPSolverType::OSQP;
+  }
+  if (solver_name == "BandedADMM") {
+    return SmootherBase::QPSolverType::BANDED_ADMM;
+  }
+
+  throw std::domain_error("[MotionVelocitySmootherNode] undesired qp solver is selected.");
+}
+
 double MotionVelocitySmootherNode::calcTravelDistance() const
 {
   const auto closest_point =
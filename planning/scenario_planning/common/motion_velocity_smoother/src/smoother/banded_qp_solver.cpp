@@ -0,0 +1,360 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "motion_velocity_smoother/smoother/banded_qp_solver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace motion_velocity_smoother
+{
+namespace
+{
+constexpr int SCALING_ITER = 10;
+constexpr double MIN_SCALING = 1.0e-4;
+constexpr double MAX_SCALING = 1.0e4;
+constexpr double RHO_MIN = 1.0e-6;
+constexpr double RHO_MAX = 1.0e6;
+constexpr double RHO_EQ_OVER_RHO_INEQ = 1.0e3;
+constexpr double RHO_ADAPTIVE_TOLERANCE = 5.0;
+constexpr double EQUALITY_TOLERANCE = 1.0e-4;
+constexpr double DIVISION_TOLERANCE = 1.0e-10;
+
+double limitScaling(const double norm)
+{
+  if (norm < MIN_SCALING) {
+    return 1.0;
+  }
+  return std::min(norm, MAX_SCALING);
+}
+
+template <typename Matrix>
+Eigen::VectorXd calcColumnInfNorm(const Matrix & matrix)
+{
+  Eigen::VectorXd norm = Eigen::VectorXd::Zero(matrix.cols());
+  for (int k = 0; k < matrix.outerSize(); ++k) {
+    for (typename Matrix::InnerIterator it(matrix, k); it; ++it) {
+      norm(it.col()) = std::max(norm(it.col()), std::abs(it.value()));
+    }
+  }
+  return norm;
+}
+
+Eigen::VectorXd calcRowInfNorm(const Eigen::SparseMatrix<double, Eigen::RowMajor> & matrix)
+{
+  Eigen::VectorXd norm = Eigen::VectorXd::Zero(matrix.rows());
+  for (int k = 0; k < matrix.outerSize(); ++k) {
+    for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(matrix, k); it; ++it) {
+      norm(k) = std::max(norm(k), std::abs(it.value()));
+    }
+  }
+  return norm;
+}
+
+double calcInfNorm(const Eigen::VectorXd & v)
+{
+  return v.size() == 0 ? 0.0 : v.lpNorm<Eigen::Infinity>();
+}
+}  // namespace
+
+BandedQPSolver::BandedQPSolver(const Settings & settings) : settings_{settings} {}
+
+bool BandedQPSolver::solve(
+  const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+  const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u,
+  const size_t block_num, std::vector<double> & x)
+{
+  const int n = static_cast<int>(P.cols());
+  const int m = static_cast<int>(A.rows());
+  const int point_num = n / static_cast<int>(block_num);
+  x.assign(n, 0.0);
+  taken_iter_ = 0;
+  const auto to_point_order = [&](const int idx) {
+    return (idx % point_num) * static_cast<int>(block_num) + idx / point_num;
+  };
+
+  // reorder the variables point by point
+  std::vector<Eigen::Triplet<double>> P_triplets;
+  P_triplets.reserve(2 * P.nonZeros());
+  for (int k = 0; k < P.outerSize(); ++k) {
+    for (SparseMatrix::InnerIterator it(P, k); it; ++it) {
+      const int row = to_point_order(it.row());
+      const int col = to_point_order(it.col());
+      P_triplets.emplace_back(row, col, it.value());
+      if (it.row() != it.col()) {
+        P_triplets.emplace_back(col, row, it.value());
+      }
+    }
+  }
+  P_.resize(n, n);
+  P_.setFromTriplets(P_triplets.begin(), P_triplets.end());
+
+  std::vector<Eigen::Triplet<double>> A_triplets;
+  A_triplets.reserve(A.nonZeros());
+  for (int k = 0; k < A.outerSize(); ++k) {
+    for (SparseMatrix::InnerIterator it(A, k); it; ++it) {
+      A_triplets.emplace_back(it.row(), to_point_order(it.col()), it.value());
+    }
+  }
+  A_.resize(m, n);
+  A_.setFromTriplets(A_triplets.begin(), A_triplets.end());
+
+  q_.resize(n);
+  for (int i = 0; i < n; ++i) {
+    q_(to_point_order(i)) = q.at(i);
+  }
+  l_ = Eigen::Map<const Eigen::VectorXd>(l.data(), m);
+  u_ = Eigen::Map<const Eigen::VectorXd>(u.data(), m);
+
+  scaleProblem();
+  At_ = A_.transpose();
+
+  // warm start from the previous solution. the trajectory length changes every cycle, then only
+  // the variables of the points in both problems are kept, the constraint order is unknown
+  Eigen::VectorXd xs = Eigen::VectorXd::Zero(n);
+  Eigen::VectorXd ys = Eigen::VectorXd::Zero(m);
+  if (prev_x_.size() == n && prev_y_.size() == m) {
+    xs = prev_x_.cwiseQuotient(D_);
+    ys = c_ * prev_y_.cwiseQuotient(E_);
+  } else if (prev_block_num_ == block_num) {
+    const int common_size = std::min(n, static_cast<int>(prev_x_.size()));
+    xs.head(common_size) = prev_x_.head(common_size).cwiseQuotient(D_.head(common_size));
+  }
+  Eigen::VectorXd zs = (A_ * xs).cwiseMax(l_).cwiseMin(u_);
+
+  rho_ = settings_.rho;
+  updateRhoVector();
+  if (!factorize()) {
+    status_message_ = "factorization failed";
+    return false;
+  }
+
+  const double sigma = settings_.sigma;
+  const double alpha = settings_.alpha;
+  const Eigen::VectorXd D_inv = D_.cwiseInverse();
+  const Eigen::VectorXd E_inv = E_.cwiseInverse();
+  bool is_converged = false;
+  Eigen::VectorXd rhs(n);
+  Eigen::VectorXd z_tilde(m);
+  Eigen::VectorXd z_relaxed(m);
+  for (taken_iter_ = 1; taken_iter_ <= settings_.max_iter; ++taken_iter_) {
+    rhs = sigma * xs - q_ + At_ * (rho_vec_.cwiseProduct(zs) - ys);
+    solveFactorized(rhs);
+    z_tilde = A_ * rhs;
+    xs = alpha * rhs + (1.0 - alpha) * xs;
+    z_relaxed = alpha * z_tilde + (1.0 - alpha) * zs;
+    const Eigen::VectorXd z_next =
+      (z_relaxed + ys.cwiseQuotient(rho_vec_)).cwiseMax(l_).cwiseMin(u_);
+    ys += rho_vec_.cwiseProduct(z_relaxed - z_next);
+    zs = z_next;
+
+    if (taken_iter_ % settings_.check_interval != 0 && taken_iter_ != settings_.max_iter) {
+      continue;
+    }
+
+    // residuals of the unscaled problem
+    const Eigen::VectorXd Ax = A_ * xs;
+    const Eigen::VectorXd Px = P_ * xs;
+    const Eigen::VectorXd Aty = At_ * ys;
+    const double prim_res = calcInfNorm(E_inv.cwiseProduct(Ax - zs));
+    const double prim_norm =
+      std::max(calcInfNorm(E_inv.cwiseProduct(Ax)), calcInfNorm(E_inv.cwiseProduct(zs)));
+    const double dual_res = calcInfNorm(D_inv.cwiseProduct(Px + q_ + Aty)) / c_;
+    const double dual_norm =
+      std::max(
+        {calcInfNorm(D_inv.cwiseProduct(Px)), calcInfNorm(D_inv.cwiseProduct(Aty)),
+         calcInfNorm(D_inv.cwiseProduct(q_))}) /
+      c_;
+    if (
+      prim_res <= settings_.eps_abs + settings_.eps_rel * prim_norm &&
+      dual_res <= settings_.eps_abs + settings_.eps_rel * dual_norm) {
+      is_converged = true;
+      break;
+    }
+
+    // balance the residuals, the factorization is only updated for a large change of rho
+    const double normalized_prim_res = prim_res / (prim_norm + DIVISION_TOLERANCE);
+    const double normalized_dual_res = dual_res / (dual_norm + DIVISION_TOLERANCE);
+    const double rho_ratio =
+      std::sqrt(normalized_prim_res / (normalized_dual_res + DIVISION_TOLERANCE));
+    const double rho_estimate = std::max(RHO_MIN, std::min(RHO_MAX, rho_ * rho_ratio));
+    if (
+      rho_estimate > rho_ * RHO_ADAPTIVE_TOLERANCE ||
+      rho_estimate < rho_ / RHO_ADAPTIVE_TOLERANCE) {
+      rho_ = rho_estimate;
+      updateRhoVector();
+      if (!factorize()) {
+        status_message_ = "factorization failed";
+        return false;
+      }
+    }
+  }
+  taken_iter_ = std::min(taken_iter_, settings_.max_iter);
+  status_message_ = is_converged ? "solved" : "maximum iterations reached";
+
+  // unscale and reorder the solution back
+  prev_block_num_ = block_num;
+  prev_x_ = D_.cwiseProduct(xs);
+  prev_y_ = E_.cwiseProduct(ys) / c_;
+  for (int i = 0; i < n; ++i) {
+    x.at(i) = prev_x_(to_point_order(i));
+  }
+  return is_converged;
+}
+
+void BandedQPSolver::scaleProblem()
+{
+  // Ruiz equilibration of the KKT matrix [P A^T; A 0] and scaling of the cost, as OSQP
+  const int n = static_cast<int>(P_.cols());
+  const int m = static_cast<int>(A_.rows());
+  D_ = Eigen::VectorXd::Ones(n);
+  E_ = Eigen::VectorXd::Ones(m);
+  c_ = 1.0;
+  for (int iter = 0; iter < SCALING_ITER; ++iter) {
+    const Eigen::VectorXd P_col_norm = calcColumnInfNorm(P_);
+    const Eigen::VectorXd A_col_norm = calcColumnInfNorm(A_);
+    const Eigen::VectorXd A_row_norm = calcRowInfNorm(A_);
+    Eigen::VectorXd D_temp(n);
+    for (int i = 0; i < n; ++i) {
+      D_temp(i) = 1.0 / std::sqrt(limitScaling(std::max(P_col_norm(i), A_col_norm(i))));
+    }
+    Eigen::VectorXd E_temp(m);
+    for (int i = 0; i < m; ++i) {
+      E_temp(i) = 1.0 / std::sqrt(limitScaling(A_row_norm(i)));
+    }
+
+    for (int k = 0; k < P_.outerSize(); ++k) {
+      for (SparseMatrix::InnerIterator it(P_, k); it; ++it) {
+        it.valueRef() *= D_temp(it.row()) * D_temp(it.col());
+      }
+    }
+    for (int k = 0; k < A_.outerSize(); ++k) {
+      for (RowMajorSparseMatrix::InnerIterator it(A_, k); it; ++it) {
+        it.valueRef() *= E_temp(it.row()) * D_temp(it.col());
+      }
+    }
+    q_ = D_temp.cwiseProduct(q_);
+    D_ = D_.cwiseProduct(D_temp);
+    E_ = E_.cwiseProduct(E_temp);
+
+    const double P_norm_mean = n == 0 ? 0.0 : calcColumnInfNorm(P_).mean();
+    const double gamma = 1.0 / limitScaling(std::max(P_norm_mean, calcInfNorm(q_)));
+    P_ *= gamma;
+    q_ *= gamma;
+    c_ *= gamma;
+  }
+  l_ = E_.cwiseProduct(l_);
+  u_ = E_.cwiseProduct(u_);
+}
+
+void BandedQPSolver::updateRhoVector()
+{
+  rho_vec_.resize(l_.size());
+  for (int i = 0; i < l_.size(); ++i) {
+    if (std::isinf(l_(i)) && std::isinf(u_(i))) {
+      rho_vec_(i) = RHO_MIN;
+    } else if (std::abs(u_(i) - l_(i)) < EQUALITY_TOLERANCE) {
+      rho_vec_(i) = RHO_EQ_OVER_RHO_INEQ * rho_;
+    } else {
+      rho_vec_(i) = rho_;
+    }
+  }
+}
+
+bool BandedQPSolver::factorize()
+{
+  const size_t n = static_cast<size_t>(P_.cols());
+  bandwidth_ = 0;
+  for (int k = 0; k < P_.outerSize(); ++k) {
+    for (SparseMatrix::InnerIterator it(P_, k); it; ++it) {
+      bandwidth_ = std::max(bandwidth_, static_cast<size_t>(std::abs(it.row() - it.col())));
+    }
+  }
+  for (int k = 0; k < A_.outerSize(); ++k) {
+    RowMajorSparseMatrix::InnerIterator it(A_, k);
+    if (!it) {
+      continue;
+    }
+    const auto min_col = it.col();
+    auto max_col = min_col;
+    for (; it; ++it) {
+      max_col = it.col();
+    }
+    bandwidth_ = std::max(bandwidth_, static_cast<size_t>(max_col - min_col));
+  }
+
+  // P + sigma I + A^T diag(rho) A in the lower band
+  band_.assign(n * (bandwidth_ + 1), 0.0);
+  for (int k = 0; k < P_.outerSize(); ++k) {
+    for (SparseMatrix::InnerIterator it(P_, k); it; ++it) {
+      if (it.row() >= it.col()) {
+        getBand(it.row(), it.col()) += it.value();
+      }
+    }
+  }
+  for (size_t i = 0; i < n; ++i) {
+    getBand(i, i) += settings_.sigma;
+  }
+  for (int k = 0; k < A_.outerSize(); ++k) {
+    for (RowMajorSparseMatrix::InnerIterator it1(A_, k); it1; ++it1) {
+      for (RowMajorSparseMatrix::InnerIterator it2(A_, k); it2 && it2.col() <= it1.col(); ++it2) {
+        getBand(it1.col(), it2.col()) += rho_vec_(k) * it1.value() * it2.value();
+      }
+    }
+  }
+
+  // banded Cholesky factorization in place
+  for (size_t i = 0; i < n; ++i) {
+    const size_t j_begin = i > bandwidth_ ? i - bandwidth_ : 0;
+    for (size_t j = j_begin; j <= i; ++j) {
+      double sum = getBand(i, j);
+      const size_t k_begin = std::max(j_begin, j > bandwidth_ ? j - bandwidth_ : 0);
+      for (size_t k = k_begin; k < j; ++k) {
+        sum -= getBand(i, k) * getBand(j, k);
+      }
+      if (i == j) {
+        if (sum <= 0.0) {
+          return false;
+        }
+        getBand(i, i) = std::sqrt(sum);
+      } else {
+        getBand(i, j) = sum / getBand(j, j);
+      }
+    }
+  }
+  return true;
+}
+
+void BandedQPSolver::solveFactorized(Eigen::VectorXd & b) const
+{
+  const size_t n = static_cast<size_t>(b.size());
+  for (size_t i = 0; i < n; ++i) {
+    const size_t k_begin = i > bandwidth_ ? i - bandwidth_ : 0;
+    for (size_t k = k_begin; k < i; ++k) {
+      b(i) -= getBand(i, k) * b(k);
+    }
+    b(i) /= getBand(i, i);
+  }
+  for (size_t i = n; i > 0; --i) {
+    const size_t row = i - 1;
+    const size_t k_end = std::min(n, row + bandwidth_ + 1);
+    for (size_t k = row + 1; k < k_end; ++k) {
+      b(row) -= getBand(k, row) * b(k);
+    }
+    b(row) /= getBand(row, row);
+  }
+}
+}  // namespace motion_velocity_smoother
@@ -16,7 +16,10 @@
 
 #include "motion_velocity_smoother/trajectory_utils.hpp"
 
+#include <osqp_interface/csc_matrix_conv.hpp>
+
 #include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/SparseCore>
 
 #include <algorithm>
 #include <chrono>
@@ -28,7 +31,8 @@
 namespace motion_velocity_smoother
 {
 JerkFilteredSmoother::JerkFilteredSmoother(const Param & smoother_param)
-: smoother_param_{smoother_param}
+: smoother_param_{smoother_param},
+  banded_qp_solver_{{20000, 1.0e-8, 1.0e-4, 0.1, 1.0e-6, 1.6, 25}}
 {
   qp_solver_.updateMaxIter(20000);
   qp_solver_.updateRhoInterval(0);  // 0 means automatic
@@ -160,13 +164,16 @@ bool JerkFilteredSmoother::apply(
   const uint32_t l_variables = 5 * N;
   const uint32_t l_constraints = 4 * N + 1;
 
-  // the matrix size depends on constraint numbers.
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(l_constraints, l_variables);
+  // the matrices are banded, so they are built as triplets instead of dense matrices.
+  // only the upper triangular part of P is given.
+  std::vector<Eigen::Triplet<double>> A_triplets;
+  A_triplets.reserve(10 * N);
 
   std::vector<double> lower_bound(l_constraints, 0.0);
   std::vector<double> upper_bound(l_constraints, 0.0);
 
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(l_variables, l_variables);
+  std::vector<Eigen::Triplet<double>> P_triplets;
+  P_triplets.reserve(6 * N);
   std::vector<double> q(l_variables, 0.0);
 
   /**************************************************************/
@@ -182,10 +189,10 @@ bool JerkFilteredSmoother::apply(
     const double ref_vel = v_max_arr.at(i);
     const double interval_dist = std::max(interval_dist_arr.at(i), 0.0001);
     const double w_x_ds_inv = (1.0 / interval_dist) * ref_vel;
-    P(IDX_A0 + i, IDX_A0 + i) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i, IDX_A0 + i + 1) -= smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i + 1, IDX_A0 + i) -= smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i + 1, IDX_A0 + i + 1) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+    const double w = smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+    P_triplets.emplace_back(IDX_A0 + i, IDX_A0 + i, w);
+    P_triplets.emplace_back(IDX_A0 + i, IDX_A0 + i + 1, -w);
+    P_triplets.emplace_back(IDX_A0 + i + 1, IDX_A0 + i + 1, w);
   }
 
   for (size_t i = 0; i < N; ++i) {
@@ -195,9 +202,9 @@ bool JerkFilteredSmoother::apply(
     if (i < N - 1) {
       q.at(IDX_B0 + i) *= std::max(interval_dist_arr.at(i), 0.0001);
     }
-    P(IDX_DELTA0 + i, IDX_DELTA0 + i) += over_v_weight;  // over velocity cost
-    P(IDX_SIGMA0 + i, IDX_SIGMA0 + i) += over_a_weight;  // over acceleration cost
-    P(IDX_GAMMA0 + i, IDX_GAMMA0 + i) += over_j_weight;  // over jerk cost
+    P_triplets.emplace_back(IDX_DELTA0 + i, IDX_DELTA0 + i, over_v_weight);  // over velocity
+    P_triplets.emplace_back(IDX_SIGMA0 + i, IDX_SIGMA0 + i, over_a_weight);  // over acceleration
+    P_triplets.emplace_back(IDX_GAMMA0 + i, IDX_GAMMA0 + i, over_j_weight);  // over jerk
   }
 
   /**************************************************************/
@@ -218,16 +225,16 @@ bool JerkFilteredSmoother::apply(
 
   // Soft Constraint Velocity Limit: 0 < b - delta < v_max^2
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_B0 + i) = 1.0;       // b_i
-    A(constr_idx, IDX_DELTA0 + i) = -1.0;  // -delta_i
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i, 1.0);       // b_i
+    A_triplets.emplace_back(constr_idx, IDX_DELTA0 + i, -1.0);  // -delta_i
     upper_bound[constr_idx] = v_max_arr.at(i) * v_max_arr.at(i);
     lower_bound[constr_idx] = 0.0;
   }
 
   // Soft Constraint Acceleration Limit: a_min < a - sigma < a_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_A0 + i) = 1.0;       // a_i
-    A(constr_idx, IDX_SIGMA0 + i) = -1.0;  // -sigma_i
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, 1.0);       // a_i
+    A_triplets.emplace_back(constr_idx, IDX_SIGMA0 + i, -1.0);  // -sigma_i
 
     constexpr double stop_vel = 1e-3;
     if (v_max_arr.at(i) < stop_vel) {
@@ -245,38 +252,53 @@ bool JerkFilteredSmoother::apply(
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
     const double ref_vel = std::max(v_max_arr.at(i), ZERO_VEL_THR_FOR_DT_CALC);
     const double ds = interval_dist_arr.at(i);
-    A(constr_idx, IDX_A0 + i) = -ref_vel;     // -a[i] * ref_vel
-    A(constr_idx, IDX_A0 + i + 1) = ref_vel;  //  a[i+1] * ref_vel
-    A(constr_idx, IDX_GAMMA0 + i) = -ds;      // -gamma[i] * ds
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, -ref_vel);     // -a[i] * ref_vel
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i + 1, ref_vel);  //  a[i+1] * ref_vel
+    A_triplets.emplace_back(constr_idx, IDX_GAMMA0 + i, -ds);      // -gamma[i] * ds
     upper_bound[constr_idx] = j_max * ds;     //  jerk_max * ds
     lower_bound[constr_idx] = j_min * ds;     //  jerk_min * ds
   }
 
   // b' = 2a ... (b(i+1) - b(i)) / ds = 2a(i)
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
-    A(constr_idx, IDX_B0 + i) = -1.0;                            // b(i)
-    A(constr_idx, IDX_B0 + i + 1) = 1.0;                         // b(i+1)
-    A(constr_idx, IDX_A0 + i) = -2.0 * interval_dist_arr.at(i);  // a(i) * ds
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i, -1.0);     // b(i)
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i + 1, 1.0);  // b(i+1)
+    A_triplets.emplace_back(
+      constr_idx, IDX_A0 + i, -2.0 * interval_dist_arr.at(i));  // a(i) * ds
     upper_bound[constr_idx] = 0.0;
     lower_bound[constr_idx] = 0.0;
   }
 
   // initial condition
   {
-    A(constr_idx, IDX_B0) = 1.0;  // b0
+    A_triplets.emplace_back(constr_idx, IDX_B0, 1.0);  // b0
     upper_bound[constr_idx] = v0 * v0;
     lower_bound[constr_idx] = v0 * v0;
     ++constr_idx;
 
-    A(constr_idx, IDX_A0) = 1.0;  // a0
+    A_triplets.emplace_back(constr_idx, IDX_A0, 1.0);  // a0
     upper_bound[constr_idx] = a0;
     lower_bound[constr_idx] = a0;
     ++constr_idx;
   }
 
   // execute optimization
-  const auto result = qp_solver_.optimize(P, A, q, lower_bound, upper_bound);
-  const std::vector<double> optval = std::get<0>(result);
+  Eigen::SparseMatrix<double> P(l_variables, l_variables);
+  P.setFromTriplets(P_triplets.begin(), P_triplets.end());
+  Eigen::SparseMatrix<double> A(l_constraints, l_variables);
+  A.setFromTriplets(A_triplets.begin(), A_triplets.end());
+  std::vector<double> optval;
+  bool is_solved = false;
+  if (base_param_.qp_solver_type == QPSolverType::BANDED_ADMM) {
+    constexpr size_t block_num = 5;  // b, a, delta, sigma, gamma
+    is_solved = banded_qp_solver_.solve(P, A, q, lower_bound, upper_bound, block_num, optval);
+  } else {
+    qp_solver_.updateProblem(
+      osqp::calCSCMatrixTrapezoidal(P), osqp::calCSCMatrix(A), q, lower_bound, upper_bound);
+    const auto result = qp_solver_.optimize();
+    optval = std::get<0>(result);
+    is_solved = std::get<3>(result) == 1;
+  }
 
   const auto tf1 = std::chrono::system_clock::now();
   const double dt_ms1 =
@@ -294,9 +316,11 @@ bool JerkFilteredSmoother::apply(
     output.points.at(i).accel.linear.x = a_stop_decel;
   }
 
-  const int status_val = std::get<3>(result);
-  if (status_val != 1) {
-    RCLCPP_ERROR(logger_, "optimization failed : %s", qp_solver_.getStatusMessage().c_str());
+  if (!is_solved) {
+    const auto status_message = base_param_.qp_solver_type == QPSolverType::BANDED_ADMM
+                                  ? banded_qp_solver_.getStatusMessage()
+                                  : qp_solver_.getStatusMessage();
+    RCLCPP_ERROR(logger_, "optimization failed : %s", status_message.c_str());
   }
 
   if (TMP_SHOW_DEBUG_INFO) {
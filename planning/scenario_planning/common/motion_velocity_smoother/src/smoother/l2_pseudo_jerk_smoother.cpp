@@ -16,7 +16,10 @@
 
 #include "motion_velocity_smoother/trajectory_utils.hpp"
 
+#include <osqp_interface/csc_matrix_conv.hpp>
+
 #include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/SparseCore>
 
 #include <algorithm>
 #include <chrono>
@@ -26,7 +29,7 @@
 namespace motion_velocity_smoother
 {
 L2PseudoJerkSmoother::L2PseudoJerkSmoother(const Param & smoother_param)
-: smoother_param_{smoother_param}
+: smoother_param_{smoother_param}, banded_qp_solver_{{4000, 1.0e-4, 1.0e-4, 0.1, 1.0e-6, 1.6, 25}}
 {
   qp_solver_.updateMaxIter(4000);
   qp_solver_.updateRhoInterval(0);  // 0 means automatic
@@ -78,13 +81,16 @@ bool L2PseudoJerkSmoother::apply(
   const uint32_t l_variables = 4 * N;
   const uint32_t l_constraints = 3 * N + 1;
 
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(
-    l_constraints, l_variables);  // the matrix size depends on constraint numbers.
+  // the matrices are banded, so they are built as triplets instead of dense matrices.
+  // only the upper triangular part of P is given.
+  std::vector<Eigen::Triplet<double>> A_triplets;
+  A_triplets.reserve(7 * N);
 
   std::vector<double> lower_bound(l_constraints, 0.0);
   std::vector<double> upper_bound(l_constraints, 0.0);
 
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(l_variables, l_variables);
+  std::vector<Eigen::Triplet<double>> P_triplets;
+  P_triplets.reserve(4 * N);
   std::vector<double> q(l_variables, 0.0);
 
   const double a_max = base_param_.max_accel;
@@ -102,18 +108,17 @@ bool L2PseudoJerkSmoother::apply(
   for (unsigned int i = N; i < 2 * N - 1; ++i) {
     unsigned int j = i - N;
     const double w_x_ds_inv = smooth_weight * (1.0 / std::max(interval_dist_arr.at(j), 0.0001));
-    P(i, i) += w_x_ds_inv * w_x_ds_inv;
-    P(i, i + 1) -= w_x_ds_inv * w_x_ds_inv;
-    P(i + 1, i) -= w_x_ds_inv * w_x_ds_inv;
-    P(i + 1, i + 1) += w_x_ds_inv * w_x_ds_inv;
+    P_triplets.emplace_back(i, i, w_x_ds_inv * w_x_ds_inv);
+    P_triplets.emplace_back(i, i + 1, -w_x_ds_inv * w_x_ds_inv);
+    P_triplets.emplace_back(i + 1, i + 1, w_x_ds_inv * w_x_ds_inv);
   }
 
   for (unsigned int i = 2 * N; i < 3 * N; ++i) {  // over velocity cost
-    P(i, i) += over_v_weight;
+    P_triplets.emplace_back(i, i, over_v_weight);
   }
 
   for (unsigned int i = 3 * N; i < 4 * N; ++i) {  // over acceleration cost
-    P(i, i) += over_a_weight;
+    P_triplets.emplace_back(i, i, over_a_weight);
   }
 
   /* design constraint matrix
@@ -126,8 +131,8 @@ bool L2PseudoJerkSmoother::apply(
   */
   for (unsigned int i = 0; i < N; ++i) {
     const int j = 2 * N + i;
-    A(i, i) = 1.0;   // b_i
-    A(i, j) = -1.0;  // -delta_i
+    A_triplets.emplace_back(i, i, 1.0);   // b_i
+    A_triplets.emplace_back(i, j, -1.0);  // -delta_i
     upper_bound[i] = v_max[i] * v_max[i];
     lower_bound[i] = 0.0;
   }
@@ -135,8 +140,8 @@ bool L2PseudoJerkSmoother::apply(
   // a_min < a - sigma < a_max
   for (unsigned int i = N; i < 2 * N; ++i) {
     const int j = 2 * N + i;
-    A(i, i) = 1.0;   // a_i
-    A(i, j) = -1.0;  // -sigma_i
+    A_triplets.emplace_back(i, i, 1.0);   // a_i
+    A_triplets.emplace_back(i, j, -1.0);  // -sigma_i
     if (i != N && v_max[i - N] < std::numeric_limits<double>::epsilon()) {
       upper_bound[i] = 0.0;
       lower_bound[i] = 0.0;
@@ -150,9 +155,9 @@ bool L2PseudoJerkSmoother::apply(
   for (unsigned int i = 2 * N; i < 3 * N - 1; ++i) {
     const unsigned int j = i - 2 * N;
     const double ds_inv = 1.0 / std::max(interval_dist_arr.at(j), 0.0001);
-    A(i, j) = -ds_inv;     // b(i)
-    A(i, j + 1) = ds_inv;  // b(i+1)
-    A(i, j + N) = -2.0;    // a(i)
+    A_triplets.emplace_back(i, j, -ds_inv);     // b(i)
+    A_triplets.emplace_back(i, j + 1, ds_inv);  // b(i+1)
+    A_triplets.emplace_back(i, j + N, -2.0);    // a(i)
     upper_bound[i] = 0.0;
     lower_bound[i] = 0.0;
   }
@@ -161,11 +166,11 @@ bool L2PseudoJerkSmoother::apply(
   const double v0 = initial_vel;
   {
     const unsigned int i = 3 * N - 1;
-    A(i, 0) = 1.0;  // b0
+    A_triplets.emplace_back(i, 0, 1.0);  // b0
     upper_bound[i] = v0 * v0;
     lower_bound[i] = v0 * v0;
 
-    A(i + 1, N) = 1.0;  // a0
+    A_triplets.emplace_back(i + 1, N, 1.0);  // a0
     upper_bound[i + 1] = initial_acc;
     lower_bound[i + 1] = initial_acc;
   }
@@ -176,11 +181,25 @@ bool L2PseudoJerkSmoother::apply(
 
   // execute optimization
   const auto ts2 = std::chrono::system_clock::now();
-  const auto result = qp_solver_.optimize(P, A, q, lower_bound, upper_bound);
+  Eigen::SparseMatrix<double> P(l_variables, l_variables);
+  P.setFromTriplets(P_triplets.begin(), P_triplets.end());
+  Eigen::SparseMatrix<double> A(l_constraints, l_variables);
+  A.setFromTriplets(A_triplets.begin(), A_triplets.end());
+  std::vector<double> optval;
+  bool is_solved = false;
+  if (base_param_.qp_solver_type == QPSolverType::BANDED_ADMM) {
+    constexpr size_t block_num = 4;  // b, a, delta, sigma
+    is_solved = banded_qp_solver_.solve(P, A, q, lower_bound, upper_bound, block_num, optval);
+  } else {
+    qp_solver_.updateProblem(
+      osqp::calCSCMatrixTrapezoidal(P), osqp::calCSCMatrix(A), q, lower_bound, upper_bound);
+    const auto result = qp_solver_.optimize();
+    optval = std::get<0>(result);
+    is_solved = std::get<3>(result) == 1;
+  }
 
   // [b0, b1, ..., bN, |  a0, a1, ..., aN, |
   //  delta0, delta1, ..., deltaN, | sigma0, sigma1, ..., sigmaN]
-  const std::vector<double> optval = std::get<0>(result);
 
   for (unsigned int i = 0; i < N; ++i) {
     double v = optval.at(i);
@@ -203,9 +222,11 @@ bool L2PseudoJerkSmoother::apply(
   //     v_max[i], optval.at(i + N), optval.at(i), optval.at(i + 2 * N), optval.at(i + 3 * N));
   // }
 
-  const int status_val = std::get<3>(result);
-  if (status_val != 1) {
-    RCLCPP_WARN(logger_, "optimization failed : %s", qp_solver_.getStatusMessage().c_str());
+  if (!is_solved) {
+    const auto status_message = base_param_.qp_solver_type == QPSolverType::BANDED_ADMM
+                                  ? banded_qp_solver_.getStatusMessage()
+                                  : qp_solver_.getStatusMessage();
+    RCLCPP_WARN(logger_, "optimization failed : %s", status_message.c_str());
   }
 
   const auto tf2 = std::chrono::system_clock::now();
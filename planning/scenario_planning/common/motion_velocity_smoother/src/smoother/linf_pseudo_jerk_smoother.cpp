@@ -16,7 +16,10 @@
 
 #include "motion_velocity_smoother/trajectory_utils.hpp"
 
+#include <osqp_interface/csc_matrix_conv.hpp>
+
 #include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/SparseCore>
 
 #include <algorithm>
 #include <chrono>
@@ -80,13 +83,16 @@ bool LinfPseudoJerkSmoother::apply(
   const size_t l_variables{4 * N + 1};
   const size_t l_constraints{3 * N + 1 + 2 * (N - 1)};
 
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(
-    l_constraints, l_variables);  // the matrix size depends on constraint numbers.
+  // the matrices are banded, so they are built as triplets instead of dense matrices.
+  // only the upper triangular part of P is given.
+  std::vector<Eigen::Triplet<double>> A_triplets;
+  A_triplets.reserve(13 * N);
 
   std::vector<double> lower_bound(l_constraints, 0.0);
   std::vector<double> upper_bound(l_constraints, 0.0);
 
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(l_variables, l_variables);
+  std::vector<Eigen::Triplet<double>> P_triplets;
+  P_triplets.reserve(2 * N);
   std::vector<double> q(l_variables, 0.0);
 
   const double a_max{base_param_.max_accel};
@@ -101,11 +107,11 @@ bool LinfPseudoJerkSmoother::apply(
   }
 
   for (unsigned int i = 2 * N; i < 3 * N; ++i) {  // over velocity cost
-    P(i, i) += over_v_weight;
+    P_triplets.emplace_back(i, i, over_v_weight);
   }
 
   for (unsigned int i = 3 * N; i < 4 * N; ++i) {  // over acceleration cost
-    P(i, i) += over_a_weight;
+    P_triplets.emplace_back(i, i, over_a_weight);
   }
 
   // pseudo jerk (Linf): minimize psi, subject to |a'|*curr_v < psi
@@ -121,8 +127,8 @@ bool LinfPseudoJerkSmoother::apply(
   */
   for (unsigned int i = 0; i < N; ++i) {
     const int j = 2 * N + i;
-    A(i, i) = 1.0;   // b_i
-    A(i, j) = -1.0;  // -delta_i
+    A_triplets.emplace_back(i, i, 1.0);   // b_i
+    A_triplets.emplace_back(i, j, -1.0);  // -delta_i
     upper_bound[i] = v_max[i] * v_max[i];
     lower_bound[i] = 0.0;
   }
@@ -130,8 +136,8 @@ bool LinfPseudoJerkSmoother::apply(
   // a_min < a - sigma < a_max
   for (unsigned int i = N; i < 2 * N; ++i) {
     const int j = 2 * N + i;
-    A(i, i) = 1.0;   // a_i
-    A(i, j) = -1.0;  // -sigma_i
+    A_triplets.emplace_back(i, i, 1.0);   // a_i
+    A_triplets.emplace_back(i, j, -1.0);  // -sigma_i
     if (i != N && v_max[i - N] < std::numeric_limits<double>::epsilon()) {
       upper_bound[i] = 0.0;
       lower_bound[i] = 0.0;
@@ -145,9 +151,9 @@ bool LinfPseudoJerkSmoother::apply(
   for (unsigned int i = 2 * N; i < 3 * N - 1; ++i) {
     const unsigned int j = i - 2 * N;
     const double ds_inv = 1.0 / std::max(interval_dist_arr.at(j), 0.0001);
-    A(i, j) = -ds_inv;
-    A(i, j + 1) = ds_inv;
-    A(i, j + N) = -2.0;
+    A_triplets.emplace_back(i, j, -ds_inv);
+    A_triplets.emplace_back(i, j + 1, ds_inv);
+    A_triplets.emplace_back(i, j + N, -2.0);
     upper_bound[i] = 0.0;
     lower_bound[i] = 0.0;
   }
@@ -156,11 +162,11 @@ bool LinfPseudoJerkSmoother::apply(
   const double v0 = initial_vel;
   {
     const unsigned int i = 3 * N - 1;
-    A(i, 0) = 1.0;  // b0
+    A_triplets.emplace_back(i, 0, 1.0);  // b0
     upper_bound[i] = v0 * v0;
     lower_bound[i] = v0 * v0;
 
-    A(i + 1, N) = 1.0;  // a0
+    A_triplets.emplace_back(i + 1, N, 1.0);  // a0
     upper_bound[i + 1] = initial_acc;
     lower_bound[i + 1] = initial_acc;
   }
@@ -172,15 +178,15 @@ bool LinfPseudoJerkSmoother::apply(
     const unsigned int j = i - (3 * N + 1);
     const double ds_inv = 1.0 / std::max(interval_dist_arr.at(j), 0.0001);
 
-    A(i, ia) = -ds_inv;
-    A(i, ia + 1) = ds_inv;
-    A(i, ip) = -1;
+    A_triplets.emplace_back(i, ia, -ds_inv);
+    A_triplets.emplace_back(i, ia + 1, ds_inv);
+    A_triplets.emplace_back(i, ip, -1);
     lower_bound[i] = -OSQP_INFTY;
     upper_bound[i] = 0;
 
-    A(i + N - 1, ia) = ds_inv;
-    A(i + N - 1, ia + 1) = -ds_inv;
-    A(i + N - 1, ip) = -1;
+    A_triplets.emplace_back(i + N - 1, ia, ds_inv);
+    A_triplets.emplace_back(i + N - 1, ia + 1, -ds_inv);
+    A_triplets.emplace_back(i + N - 1, ip, -1);
     lower_bound[i + N - 1] = -OSQP_INFTY;
     upper_bound[i + N - 1] = 0;
   }
@@ -191,7 +197,13 @@ bool LinfPseudoJerkSmoother::apply(
 
   // execute optimization
   const auto ts2 = std::chrono::system_clock::now();
-  const auto result = qp_solver_.optimize(P, A, q, lower_bound, upper_bound);
+  Eigen::SparseMatrix<double> P(l_variables, l_variables);
+  P.setFromTriplets(P_triplets.begin(), P_triplets.end());
+  Eigen::SparseMatrix<double> A(l_constraints, l_variables);
+  A.setFromTriplets(A_triplets.begin(), A_triplets.end());
+  qp_solver_.updateProblem(
+    osqp::calCSCMatrixTrapezoidal(P), osqp::calCSCMatrix(A), q, lower_bound, upper_bound);
+  const auto result = qp_solver_.optimize();
 
   // [b0, b1, ..., bN, |  a0, a1, ..., aN, |
   //  delta0, delta1, ..., deltaN, | sigma0, sigma1, ..., sigmaN]
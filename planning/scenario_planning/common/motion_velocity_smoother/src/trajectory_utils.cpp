@@ -19,6 +19,7 @@
 #include <interpolation/spline_interpolation.hpp>
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <tuple>
@@ -175,15 +176,49 @@ std::vector<double> calcArclengthArray(const Trajectory & trajectory)
   double dist = 0.0;
   arclength.clear();
   arclength.push_back(dist);
+  arclength.reserve(trajectory.points.size());
   for (unsigned int i = 1; i < trajectory.points.size(); ++i) {
-    const TrajectoryPoint tp = trajectory.points.at(i);
-    const TrajectoryPoint tp_prev = trajectory.points.at(i - 1);
+    const TrajectoryPoint & tp = trajectory.points.at(i);
+    const TrajectoryPoint & tp_prev = trajectory.points.at(i - 1);
     dist += autoware_utils::calcDistance2d(tp.pose, tp_prev.pose);
     arclength.push_back(dist);
   }
   return arclength;
 }
 
+TrajectoryPoint calcInterpolatedTrajectoryPoint(
+  const Trajectory & trajectory, const std::vector<double> & arclength, const double target_length)
+{
+  if (trajectory.points.empty()) {
+    return TrajectoryPoint{};
+  }
+  if (trajectory.points.size() == 1) {
+    return trajectory.points.front();
+  }
+
+  const auto it = std::upper_bound(arclength.begin(), arclength.end(), target_length);
+  const size_t segment_idx = std::min(
+    static_cast<size_t>(std::max<std::ptrdiff_t>(std::distance(arclength.begin(), it) - 1, 0)),
+    trajectory.points.size() - 2);
+  const auto & seg_pt = trajectory.points.at(segment_idx);
+  const auto & next_pt = trajectory.points.at(segment_idx + 1);
+  const double segment_length = arclength.at(segment_idx + 1) - arclength.at(segment_idx);
+  const double prop =
+    segment_length > 0.0
+      ? std::max(0.0, std::min(1.0, (target_length - arclength.at(segment_idx)) / segment_length))
+      : 0.0;
+
+  auto interpolate = [&prop](double x1, double x2) { return prop * x1 + (1.0 - prop) * x2; };
+
+  TrajectoryPoint traj_p = prop < 0.5 ? seg_pt : next_pt;
+  traj_p.twist.linear.x = interpolate(next_pt.twist.linear.x, seg_pt.twist.linear.x);
+  traj_p.accel.linear.x = interpolate(next_pt.accel.linear.x, seg_pt.accel.linear.x);
+  traj_p.pose.position.x = interpolate(next_pt.pose.position.x, seg_pt.pose.position.x);
+  traj_p.pose.position.y = interpolate(next_pt.pose.position.y, seg_pt.pose.position.y);
+  traj_p.pose.position.z = interpolate(next_pt.pose.position.z, seg_pt.pose.position.z);
+  return traj_p;
+}
+
 std::vector<double> calcTrajectoryIntervalDistance(const Trajectory & trajectory)
 {
   std::vector<double> intervals;
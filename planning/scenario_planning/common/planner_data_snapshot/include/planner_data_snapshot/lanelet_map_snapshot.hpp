@@ -0,0 +1,78 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PLANNER_DATA_SNAPSHOT__LANELET_MAP_SNAPSHOT_HPP_
+#define PLANNER_DATA_SNAPSHOT__LANELET_MAP_SNAPSHOT_HPP_
+
+#include <autoware_lanelet2_msgs/msg/map_bin.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_routing/RoutingGraph.h>
+#include <lanelet2_routing/RoutingGraphContainer.h>
+#include <lanelet2_traffic_rules/TrafficRules.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace planner_data_snapshot
+{
+/**
+ * @brief Lanelet map and its routing graphs, which must not be modified once built.
+ */
+struct LaneletMapSnapshot
+{
+  // incremented for every new map message loaded in the process
+  uint64_t version;
+
+  lanelet::LaneletMapPtr lanelet_map;
+  lanelet::traffic_rules::TrafficRulesPtr traffic_rules;  // for vehicles
+  lanelet::routing::RoutingGraphPtr routing_graph;        // for vehicles
+  // the routing graphs of vehicles and pedestrians
+  std::shared_ptr<const lanelet::routing::RoutingGraphContainer> overall_graphs;
+};
+
+/**
+ * @brief Process-wide store of the lanelet map snapshot, shared by the nodes composed in one
+ * container.
+ */
+class LaneletMapSnapshotStore
+{
+public:
+  static LaneletMapSnapshotStore & getInstance();
+
+  /**
+   * @brief snapshot of map_msg, built by the first caller and shared with the following ones
+   * @note the callers loading a new map wait for the one building it
+   */
+  std::shared_ptr<const LaneletMapSnapshot> load(
+    const autoware_lanelet2_msgs::msg::MapBin & map_msg);
+
+  // the last loaded snapshot, or nullptr before the first map
+  std::shared_ptr<const LaneletMapSnapshot> getLatest() const;
+
+  LaneletMapSnapshotStore(const LaneletMapSnapshotStore &) = delete;
+  LaneletMapSnapshotStore & operator=(const LaneletMapSnapshotStore &) = delete;
+
+private:
+  LaneletMapSnapshotStore() = default;
+
+  mutable std::mutex mutex_;
+  uint64_t latest_version_ = 0;
+  autoware_lanelet2_msgs::msg::MapBin latest_map_msg_;
+  std::shared_ptr<const LaneletMapSnapshot> latest_snapshot_;
+};
+}  // namespace planner_data_snapshot
+
+#endif  // PLANNER_DATA_SNAPSHOT__LANELET_MAP_SNAPSHOT_HPP_
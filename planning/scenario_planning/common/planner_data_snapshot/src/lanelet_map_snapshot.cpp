@@ -0,0 +1,86 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "planner_data_snapshot/lanelet_map_snapshot.hpp"
+
+#include <lanelet2_extension/utility/message_conversion.hpp>
+
+#include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+
+#include <memory>
+
+namespace planner_data_snapshot
+{
+namespace
+{
+bool isSameMap(
+  const autoware_lanelet2_msgs::msg::MapBin & a, const autoware_lanelet2_msgs::msg::MapBin & b)
+{
+  return a.header.stamp == b.header.stamp && a.header.frame_id == b.header.frame_id &&
+         a.format_version == b.format_version && a.map_version == b.map_version &&
+         a.data == b.data;
+}
+
+std::shared_ptr<const LaneletMapSnapshot> buildSnapshot(
+  const autoware_lanelet2_msgs::msg::MapBin & map_msg, const uint64_t version)
+{
+  auto snapshot = std::make_shared<LaneletMapSnapshot>();
+  snapshot->version = version;
+  snapshot->lanelet_map = std::make_shared<lanelet::LaneletMap>();
+  lanelet::utils::conversion::fromBinMsg(
+    map_msg, snapshot->lanelet_map, &snapshot->traffic_rules, &snapshot->routing_graph);
+
+  // the vehicle graph is the routing graph built from the same rules, so it is shared
+  const auto pedestrian_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+    lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
+  lanelet::routing::RoutingGraphConstPtr pedestrian_graph =
+    lanelet::routing::RoutingGraph::build(*snapshot->lanelet_map, *pedestrian_rules);
+  snapshot->overall_graphs = std::make_shared<const lanelet::routing::RoutingGraphContainer>(
+    lanelet::routing::RoutingGraphContainer({snapshot->routing_graph, pedestrian_graph}));
+
+  // The centerline is cached in the lanelet data on the first access. Calculate it here so that
+  // the readers do not write to the shared map.
+  for (const auto & lanelet : snapshot->lanelet_map->laneletLayer) {
+    lanelet.centerline();
+  }
+
+  return snapshot;
+}
+}  // namespace
+
+LaneletMapSnapshotStore & LaneletMapSnapshotStore::getInstance()
+{
+  static LaneletMapSnapshotStore store;
+  return store;
+}
+
+std::shared_ptr<const LaneletMapSnapshot> LaneletMapSnapshotStore::load(
+  const autoware_lanelet2_msgs::msg::MapBin & map_msg)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (latest_snapshot_ && isSameMap(latest_map_msg_, map_msg)) {
+    return latest_snapshot_;
+  }
+
+  latest_snapshot_ = buildSnapshot(map_msg, ++latest_version_);
+  latest_map_msg_ = map_msg;
+  return latest_snapshot_;
+}
+
+std::shared_ptr<const LaneletMapSnapshot> LaneletMapSnapshotStore::getLatest() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return latest_snapshot_;
+}
+}  // namespace planner_data_snapshot
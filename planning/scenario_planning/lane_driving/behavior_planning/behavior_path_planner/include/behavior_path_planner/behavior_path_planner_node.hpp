@@ -26,7 +26,10 @@
 #include "behavior_path_planner/scene_module/side_shift/side_shift_module.hpp"
 #include "behavior_path_planner/turn_signal_decider.hpp"
 
+#include <autoware_utils/ros/latency_tracer.hpp>
+#include <autoware_utils/ros/processing_time_publisher.hpp>
 #include <autoware_utils/ros/self_pose_listener.hpp>
+#include <autoware_utils/system/stop_watch.hpp>
 
 #include <autoware_lanelet2_msgs/msg/map_bin.hpp>
 #include <autoware_perception_msgs/msg/dynamic_object_array.hpp>
@@ -44,6 +47,7 @@
 #include <lanelet2_routing/RoutingGraph.h>
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -86,6 +90,7 @@ private:
   std::shared_ptr<PlannerData> planner_data_;
   std::shared_ptr<BehaviorTreeManager> bt_manager_;
   autoware_utils::SelfPoseListener self_pose_listener_{this};
+  autoware_utils::LatencyTracer latency_tracer_{this};
 
   std::string prev_ready_module_name_ = "NONE";
 
@@ -145,6 +150,11 @@ private:
    */
   void updateCurrentPose();
 
+  /**
+   * @brief update the geometry of the dynamic objects shared by the modules in this cycle
+   */
+  void updateObjectCache();
+
   // debug
 
 private:
@@ -152,6 +162,15 @@ private:
   rclcpp::Publisher<Path>::SharedPtr debug_path_publisher_;
   rclcpp::Publisher<MarkerArray>::SharedPtr debug_marker_publisher_;
   void publishDebugMarker(const std::vector<MarkerArray> & debug_markers);
+
+  autoware_utils::StopWatch<std::chrono::milliseconds> stop_watch_;
+  autoware_utils::ProcessingTimePublisher processing_time_publisher_{this};
+
+  /**
+   * @brief publish the processing time of each module and of the whole cycle
+   */
+  void publishProcessingTime(
+    const std::vector<std::shared_ptr<SceneModuleStatus>> & statuses, const double total_time_ms);
 };
 }  // namespace behavior_path_planner
 
@@ -39,6 +39,8 @@ struct BehaviorTreeManagerParam
   std::string bt_tree_config_path;
   int groot_zmq_publisher_port;
   int groot_zmq_server_port;
+  double planning_time_budget;       // [s] time of a tick after which candidates are not replanned
+  double candidate_planning_period;  // [s] period to replan the candidate waiting approval
 };
 
 class BehaviorTreeManager
@@ -16,6 +16,7 @@
 #define BEHAVIOR_PATH_PLANNER__DATA_MANAGER_HPP_
 
 #include "behavior_path_planner/parameters.hpp"
+#include "behavior_path_planner/predicted_object_cache.hpp"
 #include "behavior_path_planner/route_handler.hpp"
 
 #include <rclcpp/rclcpp.hpp>
@@ -62,6 +63,7 @@ struct PlannerData
   PoseStamped::ConstSharedPtr self_pose{};
   TwistStamped::ConstSharedPtr self_velocity{};
   DynamicObjectArray::ConstSharedPtr dynamic_object{};
+  std::shared_ptr<const PredictedObjectCache> object_cache{};  // of dynamic_object in this cycle
   PathWithLaneId::SharedPtr reference_path{std::make_shared<PathWithLaneId>()};
   PathWithLaneId::SharedPtr prev_output_path{std::make_shared<PathWithLaneId>()};
   BehaviorPathPlannerParameters parameters{};
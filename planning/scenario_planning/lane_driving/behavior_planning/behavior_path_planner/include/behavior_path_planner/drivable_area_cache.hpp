@@ -0,0 +1,78 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef BEHAVIOR_PATH_PLANNER__DRIVABLE_AREA_CACHE_HPP_
+#define BEHAVIOR_PATH_PLANNER__DRIVABLE_AREA_CACHE_HPP_
+
+#include <opencv2/core/core.hpp>
+
+#include <geometry_msgs/msg/pose.hpp>
+
+#include <lanelet2_core/Forward.h>
+#include <lanelet2_core/primitives/Polygon.h>
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace behavior_path_planner
+{
+/**
+ * @brief Map aligned tiles of the rasterized drivable lanes. A tile is rasterized the first time a
+ * drivable area overlaps it and is reused while the same lanes are drivable, so that the drivable
+ * area of a cycle is sampled from the tiles instead of filling the lane polygons again.
+ */
+class DrivableAreaCache
+{
+public:
+  using Polygons = std::vector<lanelet::BasicPolygon2d>;
+
+  /**
+   * @brief Image of the drivable area in the layout of util::generateDrivableArea, 0 for free and
+   * 100 for occupied. The cell (row, col) is at (width - row * resolution, height - col *
+   * resolution) in the grid frame.
+   * @param lane_ids key of the drivable lanes
+   * @param get_polygons polygons of the drivable lanes, called when the lanes are not cached
+   */
+  cv::Mat getImage(
+    const std::vector<lanelet::Id> & lane_ids, const std::function<Polygons()> & get_polygons,
+    const geometry_msgs::msg::Pose & grid_origin, const double width, const double height,
+    const double resolution);
+
+  void clear() { lane_rasters_.clear(); }
+
+private:
+  struct LaneRaster
+  {
+    std::vector<lanelet::Id> lane_ids;
+    double resolution;
+    Polygons polygons;
+    // empty Mat for a tile without lanes
+    std::unordered_map<uint64_t, cv::Mat> tiles;
+  };
+
+  LaneRaster & getLaneRaster(
+    const std::vector<lanelet::Id> & lane_ids, const std::function<Polygons()> & get_polygons,
+    const double resolution);
+  static const cv::Mat & getTile(LaneRaster & raster, const int64_t tile_x, const int64_t tile_y);
+
+  // the modules plan with a few lane sets in a cycle, most recently used first
+  std::list<LaneRaster> lane_rasters_;
+};
+}  // namespace behavior_path_planner
+
+#endif  // BEHAVIOR_PATH_PLANNER__DRIVABLE_AREA_CACHE_HPP_
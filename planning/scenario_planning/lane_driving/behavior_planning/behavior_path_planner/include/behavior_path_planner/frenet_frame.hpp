@@ -0,0 +1,98 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BEHAVIOR_PATH_PLANNER__FRENET_FRAME_HPP_
+#define BEHAVIOR_PATH_PLANNER__FRENET_FRAME_HPP_
+
+#include "behavior_path_planner/utilities.hpp"
+
+#include <autoware_utils/geometry/boost_geometry.hpp>
+
+#include <autoware_planning_msgs/msg/path_with_lane_id.hpp>
+#include <geometry_msgs/msg/point.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace behavior_path_planner
+{
+namespace util
+{
+/**
+ * @brief Projection of points on a linestring, built once for a path and queried for many points.
+ * The segments are indexed in a xy grid, so that a query only checks the segments around the
+ * point instead of the whole linestring.
+ */
+class FrenetFrame
+{
+public:
+  explicit FrenetFrame(const std::vector<Point> & linestring);
+  explicit FrenetFrame(const PathWithLaneId & path);
+
+  bool empty() const { return points_.empty(); }
+  double getLength() const { return lengths_.empty() ? 0.0 : lengths_.back(); }
+
+  /**
+   * @brief Same result as util::convertToFrenetCoordinate3d(), the length and distance of the
+   * closest point of the linestring. Returns false when the linestring is empty.
+   */
+  bool convertToFrenetCoordinate3d(
+    const Point & search_point_geom, FrenetCoordinate3d * frenet_coordinate) const;
+
+  /**
+   * @brief For a sequence of close points, e.g. the ego pose of consecutive cycles or the points of
+   * an object footprint. The closest point is first searched locally from the segment of the
+   * previous query and only checked against the grid around it.
+   * @param hint_segment_idx segment of the previous query, set to the segment of this one
+   */
+  bool convertToFrenetCoordinate3d(
+    const Point & search_point_geom, FrenetCoordinate3d * frenet_coordinate,
+    size_t * hint_segment_idx) const;
+
+private:
+  struct Projection
+  {
+    size_t segment_idx;
+    double length;
+    double distance;
+  };
+
+  Projection projectOnSegment(const autoware_utils::Point3d & point, const size_t idx) const;
+  // replaces best by the projection on the segment if it is closer
+  void updateProjection(
+    const autoware_utils::Point3d & point, const size_t idx, Projection * best) const;
+  void searchGrid(const autoware_utils::Point3d & point, Projection * best) const;
+  size_t getSegmentNum() const { return directions_.size(); }
+  int64_t getCellIndex(const double x) const;
+  static uint64_t getCellKey(const int64_t cell_x, const int64_t cell_y);
+
+  std::vector<autoware_utils::Point3d> points_;
+  // arc length from the front to each point
+  std::vector<double> lengths_;
+  // unit direction of each segment, zero for the segments of zero length
+  std::vector<Eigen::Vector3d> directions_;
+
+  double cell_size_;
+  int64_t min_cell_x_;
+  int64_t max_cell_x_;
+  int64_t min_cell_y_;
+  int64_t max_cell_y_;
+  // segments overlapping each cell
+  std::unordered_map<uint64_t, std::vector<size_t>> cells_;
+};
+}  // namespace util
+}  // namespace behavior_path_planner
+
+#endif  // BEHAVIOR_PATH_PLANNER__FRENET_FRAME_HPP_
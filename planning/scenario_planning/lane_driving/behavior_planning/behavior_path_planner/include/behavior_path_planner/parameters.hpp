@@ -32,6 +32,8 @@ struct BehaviorPathPlannerParameters
   double turn_light_on_threshold_dis_lat;
   double turn_light_on_threshold_dis_long;
   double turn_light_on_threshold_time;
+  double object_cache_time_resolution;
+  double object_cache_time_horizon;
 
   // vehicle info
   double wheel_base;
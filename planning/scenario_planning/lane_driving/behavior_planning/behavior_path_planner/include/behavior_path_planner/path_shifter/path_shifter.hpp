@@ -99,6 +99,15 @@ public:
     ShiftedPath * shift_path, const bool offset_back = true,
     const SHIFT_TYPE type = SHIFT_TYPE::SPLINE);
 
+  /**
+   * @brief  Generate a shifted path for each candidate set of shift points on the reference path,
+   *         sharing its arc lengths and normals. The shift points of this shifter are kept.
+   * @return False if the path is empty or any candidate has conflicts.
+   */
+  bool generateCandidates(
+    const std::vector<ShiftPointArray> & candidates, std::vector<ShiftedPath> * shifted_paths,
+    const bool offset_back = true, const SHIFT_TYPE type = SHIFT_TYPE::SPLINE);
+
   /**
    * @brief Remove behind shift points and add the removed offset to the base_offset_.
    * @details The previous offset information is stored in the base_offset_.
@@ -132,6 +141,33 @@ public:
     return 0.5 * lat * std::pow(4.0 * v / lon, 3);
   }
 
+  /**
+   * @brief  Calculate the shift length of the constant-jerk shifting at the arc length from its
+   *         start. The lateral jerk is +j, -j and +j on the first quarter, the middle half and the
+   *         last quarter of the shifting arc length.
+   */
+  static double calcSplineShiftLength(
+    const double arclength, const double shifting_arclength, const double delta_shift)
+  {
+    if (arclength <= 0.0) {
+      return 0.0;
+    }
+    if (arclength >= shifting_arclength) {
+      return delta_shift;
+    }
+    const double t = shifting_arclength / 4.0;
+    const double j = 0.5 * delta_shift / (t * t * t);
+    if (arclength < t) {
+      return j * std::pow(arclength, 3) / 6.0;
+    }
+    if (arclength < 3.0 * t) {
+      const double s = arclength - t;
+      return j * (std::pow(t, 3) / 6.0 + 0.5 * t * t * s + 0.5 * t * s * s - std::pow(s, 3) / 6.0);
+    }
+    // symmetric to the first quarter
+    return delta_shift - j * std::pow(shifting_arclength - arclength, 3) / 6.0;
+  }
+
   double getTotalShiftLength() const
   {
     double sum = base_offset_;
@@ -188,6 +224,11 @@ private:
   // The reference path along which the shift will be performed.
   PathWithLaneId reference_path_;
 
+  // Arc length and left normal of the reference path points, shared by all the shifting.
+  std::vector<double> reference_arclength_;
+  std::vector<double> reference_normal_x_;
+  std::vector<double> reference_normal_y_;
+
   // Shift points used for shifted-path generation.
   ShiftPointArray shift_points_;
 
@@ -212,7 +253,7 @@ private:
   /**
    * @brief Generate shifted path from reference_path_ and shift_points_ with linear shifting.
    */
-  void applyLinearShifter(ShiftedPath * shifted_path);
+  void applyLinearShifter(ShiftedPath * shifted_path) const;
 
   /**
    * @brief Generate shifted path from reference_path_ and shift_points_ with spline_based shifting.
@@ -220,7 +261,7 @@ private:
    *          dividing the shift interval into four parts and apply a cubic spline to them.
    *          The resultant shifting shape is closed to the Clothoid curve.
    */
-  void applySplineShifter(ShiftedPath * shifted_path, const bool offset_back);
+  void applySplineShifter(ShiftedPath * shifted_path, const bool offset_back) const;
 
   ////////////////////////////////////////
   // Helper Functions
@@ -231,7 +272,10 @@ private:
    */
   bool checkShiftPointsAlignment(const ShiftPointArray & shift_points) const;
 
-  void addLateralOffsetOnIndexPoint(ShiftedPath * point, double offset, size_t index) const;
+  /**
+   * @brief Move the points of the shifted path by its shift lengths along the reference normals.
+   */
+  void applyShiftLength(ShiftedPath * shifted_path) const;
 
   void shiftBaseLength(ShiftedPath * point, double offset) const;
 
@@ -0,0 +1,103 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BEHAVIOR_PATH_PLANNER__PREDICTED_OBJECT_CACHE_HPP_
+#define BEHAVIOR_PATH_PLANNER__PREDICTED_OBJECT_CACHE_HPP_
+
+#include <autoware_utils/geometry/boost_geometry.hpp>
+#include <rclcpp/duration.hpp>
+#include <rclcpp/time.hpp>
+
+#include <autoware_perception_msgs/msg/dynamic_object_array.hpp>
+#include <geometry_msgs/msg/point.hpp>
+
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/optional.hpp>
+
+#include <utility>
+#include <vector>
+
+namespace behavior_path_planner
+{
+/**
+ * @brief Geometry of the dynamic objects shared by the safety checks of the modules in a cycle.
+ * The polygon of each object and the positions of its predicted paths on a common time grid are
+ * computed once when the objects are received, instead of once per candidate path and module.
+ */
+class PredictedObjectCache
+{
+public:
+  using DynamicObjectArray = autoware_perception_msgs::msg::DynamicObjectArray;
+  using Point = geometry_msgs::msg::Point;
+  using PredictedPositions = std::vector<boost::optional<Point>>;
+
+  /**
+   * @param start_time time of the first step of the grid
+   * @param time_resolution interval of the steps of the grid [s]
+   * @param time_horizon duration of the grid [s]
+   */
+  PredictedObjectCache(
+    const DynamicObjectArray::ConstSharedPtr & objects, const rclcpp::Time & start_time,
+    const double time_resolution, const double time_horizon);
+
+  const DynamicObjectArray & getObjects() const { return *objects_; }
+
+  const rclcpp::Time & getStartTime() const { return start_time_; }
+
+  /**
+   * @brief polygon of the object, none if the shape is unknown
+   */
+  const boost::optional<autoware_utils::Polygon2d> & getPolygon(const size_t object_idx) const
+  {
+    return entries_.at(object_idx).polygon;
+  }
+
+  /**
+   * @brief index of the predicted path with the highest confidence, none without predicted paths
+   */
+  boost::optional<size_t> getMaxConfidencePathIndex(const size_t object_idx) const;
+
+  /**
+   * @brief Positions on the predicted path at the times from the start time. The times on the grid
+   * are read from the cache, the others are interpolated from the predicted path. A position is
+   * none outside the predicted path.
+   */
+  PredictedPositions getPredictedPositions(
+    const size_t object_idx, const size_t path_idx,
+    const std::vector<rclcpp::Duration> & times) const;
+
+  /**
+   * @brief indices of the objects whose polygon envelope intersects the box
+   */
+  std::vector<size_t> queryObjects(const autoware_utils::Box2d & box) const;
+
+private:
+  struct Entry
+  {
+    boost::optional<autoware_utils::Polygon2d> polygon;
+    // positions of each predicted path at the steps of the grid
+    std::vector<PredictedPositions> predicted_positions;
+  };
+  using BoxWithIndex = std::pair<autoware_utils::Box2d, size_t>;
+
+  DynamicObjectArray::ConstSharedPtr objects_;
+  rclcpp::Time start_time_;
+  double time_resolution_;
+  size_t num_steps_;
+  std::vector<Entry> entries_;
+  boost::geometry::index::rtree<BoxWithIndex, boost::geometry::index::rstar<16>> rtree_;
+};
+}  // namespace behavior_path_planner
+
+#endif  // BEHAVIOR_PATH_PLANNER__PREDICTED_OBJECT_CACHE_HPP_
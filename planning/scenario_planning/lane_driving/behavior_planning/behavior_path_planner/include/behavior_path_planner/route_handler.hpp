@@ -15,6 +15,7 @@
 #ifndef BEHAVIOR_PATH_PLANNER__ROUTE_HANDLER_HPP_
 #define BEHAVIOR_PATH_PLANNER__ROUTE_HANDLER_HPP_
 
+#include "behavior_path_planner/drivable_area_cache.hpp"
 #include "behavior_path_planner/parameters.hpp"
 #include "behavior_path_planner/path_shifter/path_shifter.hpp"
 
@@ -33,8 +34,16 @@
 #include <lanelet2_routing/RoutingGraphContainer.h>
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 
+#include <boost/optional.hpp>
+
+#include <deque>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace behavior_path_planner
@@ -200,6 +209,9 @@ public:
 
   lanelet::ConstPolygon3d getIntersectionAreaById(const lanelet::Id id) const;
 
+  // rasterized drivable lanes of the route, not a state of the route
+  DrivableAreaCache & getDrivableAreaCache() const { return *drivable_area_cache_; }
+
 private:
   // MUST
   lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
@@ -215,8 +227,31 @@ private:
   lanelet::ConstLanelets shoulder_lanelets_;
   Pose pull_over_goal_pose_;
 
+  // the next and previous lanes along the route, built with the route lanelets
+  std::unordered_set<lanelet::Id> route_lanelet_ids_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelet> next_route_lanelets_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelet> previous_route_lanelets_;
+  // the connected shoulder lanes, built with the map
+  std::unordered_set<lanelet::Id> shoulder_lanelet_ids_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelet> following_shoulder_lanelets_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelet> previous_shoulder_lanelets_;
+
+  // the modules ask for the same sequences and closest lanes several times in a cycle. the
+  // results only depend on the route, so they are kept until the route or the map changes.
+  struct QueryCache
+  {
+    std::map<std::pair<lanelet::Id, double>, lanelet::ConstLanelets> sequences_after;
+    std::map<std::pair<lanelet::Id, double>, lanelet::ConstLanelets> sequences_up_to;
+    // for the last few poses, none when no lane is found
+    std::deque<std::pair<Pose, boost::optional<lanelet::ConstLanelet>>> closest_lanelets;
+  };
+  mutable std::mutex query_cache_mutex_;
+  mutable QueryCache query_cache_;
+
   Route route_msg_;
 
+  std::shared_ptr<DrivableAreaCache> drivable_area_cache_{std::make_shared<DrivableAreaCache>()};
+
   rclcpp::Logger logger_{rclcpp::get_logger("behavior_path_planner").get_child("route_handler")};
 
   bool is_route_msg_ready_{false};
@@ -227,6 +262,8 @@ private:
 
   void setRouteLanelets();
 
+  void setShoulderLaneletConnections();
+
   // const methods
 
   // for lanelet
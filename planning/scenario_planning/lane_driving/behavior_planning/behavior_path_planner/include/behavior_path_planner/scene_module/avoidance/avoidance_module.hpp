@@ -80,6 +80,9 @@ private:
     const lanelet::ConstLanelets & lanelets, const PathWithLaneId & reference_path,
     DebugData & debug) const;
 
+  // path-relative geometry of the target objects by their uuid
+  mutable std::map<std::array<uint8_t, 16>, ObjectGeometryCache> object_geometry_cache_;
+
   ObjectDataArray registered_objects_;
   void updateRegisteredObject(const ObjectDataArray & objects);
   void CompensateDetectionLost(ObjectDataArray & objects) const;
@@ -98,6 +101,7 @@ private:
     const AvoidPointArray & base_points, const AvoidPointArray & added_points) const;
 
   // shift point generation: merger
+  mutable ShiftLineData shift_line_data_;  // reused so that the path-sized buffers stay allocated
   AvoidPointArray mergeShiftPoints(
     const AvoidPointArray & raw_shift_points, DebugData & debug) const;
   void generateTotalShiftLine(
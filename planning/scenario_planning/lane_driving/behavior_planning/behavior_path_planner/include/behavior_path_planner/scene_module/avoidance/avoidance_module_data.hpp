@@ -24,6 +24,8 @@
 #include <autoware_planning_msgs/msg/path_with_lane_id.hpp>
 #include <geometry_msgs/msg/pose_stamped.hpp>
 
+#include <array>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -155,6 +157,26 @@ struct ObjectData  // avoidance target
 };
 using ObjectDataArray = std::vector<ObjectData>;
 
+/*
+ * Path-relative geometry of an object, reused while the object does not move
+ */
+struct ObjectGeometryCache
+{
+  // object the geometry was calculated for
+  Pose pose;
+  geometry_msgs::msg::Vector3 dimensions;
+  uint8_t type;
+
+  // reference path pose closest to the object
+  Pose closest_path_pose;
+
+  // longitudinal distance from the CoM to the closest footprint point (<= 0), in Frenet coordinate
+  double footprint_longitudinal_offset;
+
+  double lateral;
+  double overhang_dist;
+};
+
 /*
  * Shift point with additional info for avoidance planning
  */
@@ -204,6 +226,11 @@ struct AvoidancePlanningData
   // If the point is behind ego_pose, the value is negative.
   std::vector<double> arclength_from_ego;
 
+  // arclength vector of the reference_path from its front point,
+  // and the arclength from the front point to ego_closest_path_index.
+  std::vector<double> arclength_from_front;
+  double arclength_from_front_to_ego_closest;
+
   // current driving lanelet
   lanelet::ConstLanelets current_lanelets;
 
@@ -55,14 +55,14 @@ std::vector<LaneChangePath> selectValidPaths(
 bool selectSafePath(
   const std::vector<LaneChangePath> & paths, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes,
-  const DynamicObjectArray::ConstSharedPtr & dynamic_objects, const Pose & current_pose,
+  const std::shared_ptr<const PredictedObjectCache> & object_cache, const Pose & current_pose,
   const Twist & current_twist, const double vehicle_width,
   const behavior_path_planner::LaneChangeParameters & ros_parameters,
   LaneChangePath * selected_path);
 bool isLaneChangePathSafe(
   const PathWithLaneId & path, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes,
-  const DynamicObjectArray::ConstSharedPtr & dynamic_objects, const Pose & current_pose,
+  const std::shared_ptr<const PredictedObjectCache> & object_cache, const Pose & current_pose,
   const Twist & current_twist, const double vehicle_width,
   const behavior_path_planner::LaneChangeParameters & ros_parameters, const bool use_buffer = true,
   const double acceleration = 0.0);
@@ -56,13 +56,13 @@ std::vector<PullOverPath> selectValidPaths(
 bool selectSafePath(
   const std::vector<PullOverPath> & paths, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes,
-  const DynamicObjectArray::ConstSharedPtr & dynamic_objects, const Pose & current_pose,
+  const std::shared_ptr<const PredictedObjectCache> & object_cache, const Pose & current_pose,
   const Twist & current_twist, const double vehicle_width,
   const behavior_path_planner::PullOverParameters & ros_parameters, PullOverPath * selected_path);
 bool isPullOverPathSafe(
   const PathWithLaneId & path, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes,
-  const DynamicObjectArray::ConstSharedPtr & dynamic_objects, const Pose & current_pose,
+  const std::shared_ptr<const PredictedObjectCache> & object_cache, const Pose & current_pose,
   const Twist & current_twist, const double vehicle_width,
   const behavior_path_planner::PullOverParameters & ros_parameters, const bool use_buffer = true,
   const double acceleration = 0.0);
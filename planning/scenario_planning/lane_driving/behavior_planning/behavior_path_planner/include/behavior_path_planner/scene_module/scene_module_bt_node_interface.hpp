@@ -32,6 +32,7 @@ struct SceneModuleStatus
   bool is_requested{false};
   bool is_waiting_approval{true};
   BT::NodeStatus status{BT::NodeStatus::IDLE};
+  double processing_time_ms{0.0};  // sum over the nodes of the module in the current tick
 };
 
 class SceneModuleBTNodeInterface : public BT::CoroActionNode
@@ -28,6 +28,7 @@
 
 #include <behaviortree_cpp_v3/basic_types.h>
 
+#include <chrono>
 #include <limits>
 #include <memory>
 #include <string>
@@ -108,7 +109,7 @@ public:
   {
     BehaviorModuleOutput out;
     out.path = util::generateCenterLinePath(planner_data_);
-    out.path_candidate = std::make_shared<PathWithLaneId>(planCandidate());
+    out.path_candidate = getCandidate();
     return out;
   }
 
@@ -165,6 +166,43 @@ public:
    */
   void setData(const std::shared_ptr<const PlannerData> & data) { planner_data_ = data; }
 
+  /**
+   * @brief set the end of the time budget of the current planning cycle
+   */
+  void setPlanningDeadline(const std::chrono::steady_clock::time_point & deadline)
+  {
+    planning_deadline_ = deadline;
+  }
+
+  /**
+   * @brief set the period to recompute the candidate path while waiting approval [s]
+   */
+  void setCandidatePlanningPeriod(const double period) { candidate_planning_period_ = period; }
+
+  /**
+   * @brief Candidate path for planWaitingApproval. It is only shown for the approval, so that
+   *        planCandidate() is recomputed at most once per candidate planning period, and not after
+   *        the planning cycle has run out of its time budget. The previous candidate is returned
+   *        in between.
+   */
+  PlanResult getCandidate()
+  {
+    const bool is_expired =
+      !prev_candidate_ ||
+      (clock_->now() - prev_candidate_time_).seconds() >= candidate_planning_period_;
+    const bool is_over_budget = std::chrono::steady_clock::now() > planning_deadline_;
+    if (!prev_candidate_ || (is_expired && !is_over_budget)) {
+      prev_candidate_ = std::make_shared<PathWithLaneId>(planCandidate());
+      prev_candidate_time_ = clock_->now();
+    }
+    return prev_candidate_;
+  }
+
+  /**
+   * @brief discard the previous candidate, so that the next approval request starts with a new one
+   */
+  void clearCandidate() { prev_candidate_.reset(); }
+
   void updateApproval()
   {
     approval_handler_.setCurrentApproval(planner_data_->approval.is_approved);
@@ -182,6 +220,12 @@ private:
   std::string name_;
   rclcpp::Logger logger_;
 
+  std::chrono::steady_clock::time_point planning_deadline_{
+    std::chrono::steady_clock::time_point::max()};
+  double candidate_planning_period_{0.0};
+  PlanResult prev_candidate_{};
+  rclcpp::Time prev_candidate_time_{};
+
 protected:
   MarkerArray debug_marker_;
   rclcpp::Clock::SharedPtr clock_;
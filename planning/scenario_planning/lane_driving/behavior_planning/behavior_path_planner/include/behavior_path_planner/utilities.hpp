@@ -16,6 +16,7 @@
 #define BEHAVIOR_PATH_PLANNER__UTILITIES_HPP_
 
 #include "behavior_path_planner/data_manager.hpp"
+#include "behavior_path_planner/predicted_object_cache.hpp"
 #include "behavior_path_planner/route_handler.hpp"
 
 #include <autoware_utils/autoware_utils.hpp>
@@ -33,6 +34,7 @@
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <boost/geometry/geometries/polygon.hpp>
 #include <boost/geometry/geometry.hpp>
+#include <boost/optional.hpp>
 
 #include <lanelet2_core/geometry/Lanelet.h>
 #include <lanelet2_routing/Route.h>
@@ -138,6 +140,7 @@ PredictedPath convertToPredictedPath(
   const PathWithLaneId & path, const Twist & vehicle_twist, const Pose & vehicle_pose,
   const double duration, const double resolution, const double acceleration);
 
+// linear search of the closest point, use FrenetFrame to project many points on the same path
 bool convertToFrenetCoordinate3d(
   const PathWithLaneId & path, const Point & search_point_geom,
   FrenetCoordinate3d * frenet_coordinate);
@@ -176,6 +179,13 @@ Point lerpByLength(const std::vector<Point> & array, const double length);
 
 bool lerpByTimeStamp(const PredictedPath & path, const rclcpp::Time & t, Pose * lerped_pt);
 
+/**
+ * @brief positions on the path at the times from the start time, none outside the path
+ */
+std::vector<boost::optional<Point>> samplePredictedPath(
+  const PredictedPath & path, const rclcpp::Time & start_time,
+  const std::vector<rclcpp::Duration> & times);
+
 bool lerpByDistance(
   const behavior_path_planner::PullOutPath & path, const double & s, Pose * lerped_pt,
   const lanelet::ConstLanelets & road_lanes);
@@ -198,6 +208,11 @@ double getDistanceBetweenPredictedPathAndObjectPolygon(
   const autoware_utils::LinearRing2d & vehicle_footprint, double distance_resolution,
   const lanelet::ConstLanelets & road_lanes);
 
+double getDistanceBetweenPredictedPathAndObjectPolygon(
+  const Polygon2d & object_polygon, const PullOutPath & ego_path,
+  const autoware_utils::LinearRing2d & vehicle_footprint, double distance_resolution,
+  const lanelet::ConstLanelets & road_lanes);
+
 /**
  * @brief Get index of the obstacles inside the lanelets with start and end length
  * @return Indices corresponding to the obstacle inside the lanelets
@@ -217,6 +232,20 @@ std::vector<size_t> filterObjectsByPath(
   const DynamicObjectArray & objects, const std::vector<size_t> & object_indices,
   const PathWithLaneId & ego_path, const double vehicle_width);
 
+/**
+ * @brief filterObjectsByLanelets with the polygons and the R-tree of the cache
+ */
+std::vector<size_t> filterObjectsByLanelets(
+  const PredictedObjectCache & objects, const lanelet::ConstLanelets & lanelets,
+  const double start_arc_length, const double end_arc_length);
+
+std::vector<size_t> filterObjectsByLanelets(
+  const PredictedObjectCache & objects, const lanelet::ConstLanelets & target_lanelets);
+
+std::vector<size_t> filterObjectsByPath(
+  const PredictedObjectCache & objects, const std::vector<size_t> & object_indices,
+  const PathWithLaneId & ego_path, const double vehicle_width);
+
 DynamicObjectArray filterObjectsByVelocity(const DynamicObjectArray & objects, double lim_v);
 
 DynamicObjectArray filterObjectsByVelocity(
@@ -294,6 +323,12 @@ std::vector<Polygon2d> getTargetLaneletPolygons(
 
 void shiftPose(Pose * pose, double shift_length);
 
+/**
+ * @brief compute the centerlines of the lanelets, which lanelet2 computes lazily without a lock,
+ * before the candidate paths on the lanelets are planned in parallel
+ */
+void prepareLaneletsForParallelUse(const lanelet::ConstLanelets & lanelets);
+
 }  // namespace util
 }  // namespace behavior_path_planner
 
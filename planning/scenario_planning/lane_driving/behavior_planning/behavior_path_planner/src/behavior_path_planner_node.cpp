@@ -25,6 +25,7 @@
 #include <autoware_utils/autoware_utils.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -159,6 +160,8 @@ BehaviorPathPlannerParameters BehaviorPathPlannerNode::getCommonParam()
   p.turn_light_on_threshold_dis_lat = declare_parameter("turn_light_on_threshold_dis_lat", 0.3);
   p.turn_light_on_threshold_dis_long = declare_parameter("turn_light_on_threshold_dis_long", 10.0);
   p.turn_light_on_threshold_time = declare_parameter("turn_light_on_threshold_time", 3.0);
+  p.object_cache_time_resolution = declare_parameter("object_cache_time_resolution", 0.5);
+  p.object_cache_time_horizon = declare_parameter("object_cache_time_horizon", 12.0);
 
   // vehicle info
   const auto vehicle_info = VehicleInfoUtil(*this).getVehicleInfo();
@@ -414,6 +417,8 @@ BehaviorTreeManagerParam BehaviorPathPlannerNode::getBehaviorTreeManagerParam()
   p.bt_tree_config_path = declare_parameter("bt_tree_config_path", "default");
   p.groot_zmq_publisher_port = declare_parameter("groot_zmq_publisher_port", 1666);
   p.groot_zmq_server_port = declare_parameter("groot_zmq_server_port", 1667);
+  p.planning_time_budget = declare_parameter("planning_time_budget", 0.08);
+  p.candidate_planning_period = declare_parameter("candidate_planning_period", 0.5);
   return p;
 }
 
@@ -444,9 +449,12 @@ void BehaviorPathPlannerNode::waitForData()
 void BehaviorPathPlannerNode::run()
 {
   RCLCPP_DEBUG(get_logger(), "----- BehaviorPathPlannerNode start -----");
+  stop_watch_.tic();
 
   // update planner data
   updateCurrentPose();
+  latency_tracer_.onReceive(planner_data_->self_pose->header.stamp);
+  updateObjectCache();
 
   // run behavior planner
   const auto output = bt_manager_->run(planner_data_);
@@ -461,6 +469,7 @@ void BehaviorPathPlannerNode::run()
 
   if (!clipped_path.points.empty()) {
     path_publisher_->publish(clipped_path);
+    latency_tracer_.onPublish(clipped_path.header.stamp);
   } else {
     RCLCPP_ERROR(get_logger(), "behavior path output is empty! Stop publish.");
   }
@@ -478,7 +487,11 @@ void BehaviorPathPlannerNode::run()
   // for remote operation
   publishModuleStatus(bt_manager_->getModulesStatus());
 
-  publishDebugMarker(bt_manager_->getDebugMarkers());
+  if (debug_marker_publisher_->get_subscription_count() > 0) {
+    publishDebugMarker(bt_manager_->getDebugMarkers());
+  }
+
+  publishProcessingTime(bt_manager_->getModulesStatus(), stop_watch_.toc());
 
   RCLCPP_DEBUG(get_logger(), "----- behavior path planner end -----\n\n");
 }
@@ -582,6 +595,17 @@ void BehaviorPathPlannerNode::publishModuleStatus(
   force_available_publisher_->publish(force_available);
 }
 
+void BehaviorPathPlannerNode::publishProcessingTime(
+  const std::vector<std::shared_ptr<SceneModuleStatus>> & statuses, const double total_time_ms)
+{
+  std::map<std::string, double> processing_time_map;
+  for (const auto & status : statuses) {
+    processing_time_map[status->module_name] = status->processing_time_ms;
+  }
+  processing_time_map["Total"] = total_time_ms;
+  processing_time_publisher_.publish(processing_time_map);
+}
+
 void BehaviorPathPlannerNode::publishDebugMarker(const std::vector<MarkerArray> & debug_markers)
 {
   MarkerArray msg{};
@@ -601,6 +625,15 @@ void BehaviorPathPlannerNode::onVelocity(const TwistStamped::ConstSharedPtr msg)
 {
   planner_data_->self_velocity = msg;
 }
+void BehaviorPathPlannerNode::updateObjectCache()
+{
+  // the safety checks sample the predicted paths from the ROS time of the cycle
+  const auto & p = planner_data_->parameters;
+  planner_data_->object_cache = std::make_shared<const PredictedObjectCache>(
+    planner_data_->dynamic_object, rclcpp::Clock{RCL_ROS_TIME}.now(),
+    p.object_cache_time_resolution, p.object_cache_time_horizon);
+}
+
 void BehaviorPathPlannerNode::onPerception(const DynamicObjectArray::ConstSharedPtr msg)
 {
   planner_data_->dynamic_object = msg;
@@ -19,6 +19,7 @@
 #include "behavior_path_planner/utilities.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <set>
 #include <string>
@@ -52,6 +53,7 @@ void BehaviorTreeManager::registerSceneModule(const std::shared_ptr<SceneModuleI
 {
   const std::string & name = module->name();
   const auto status = std::make_shared<SceneModuleStatus>(name);
+  module->setCandidatePlanningPeriod(bt_manager_param_.candidate_planning_period);
 
   // simple condition node for "isRequested" and "isReady"
   bt_factory_.registerSimpleCondition(name + "_Request", [module, status](BT::TreeNode &) {
@@ -90,9 +92,16 @@ BehaviorModuleOutput BehaviorTreeManager::run(const std::shared_ptr<PlannerData>
 {
   current_planner_data_ = data;
 
+  const auto start_time = std::chrono::steady_clock::now();
+  const auto deadline =
+    start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                   std::chrono::duration<double>(bt_manager_param_.planning_time_budget));
+
   // set planner_data & reset status
-  std::for_each(
-    scene_modules_.begin(), scene_modules_.end(), [&data](const auto & m) { m->setData(data); });
+  std::for_each(scene_modules_.begin(), scene_modules_.end(), [&data, &deadline](const auto & m) {
+    m->setData(data);
+    m->setPlanningDeadline(deadline);
+  });
   std::for_each(modules_status_.begin(), modules_status_.end(), [](const auto & s) {
     *s = SceneModuleStatus{s->module_name};
   });
@@ -104,6 +113,27 @@ BehaviorModuleOutput BehaviorTreeManager::run(const std::shared_ptr<PlannerData>
 
   const auto output = blackboard_->get<BehaviorModuleOutput>("output");
 
+  // a module requested again later starts from a new candidate
+  for (size_t i = 0; i < scene_modules_.size(); ++i) {
+    if (!modules_status_.at(i)->is_requested) {
+      scene_modules_.at(i)->clearCandidate();
+    }
+  }
+
+  const double elapsed_time =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  if (elapsed_time > bt_manager_param_.planning_time_budget) {
+    const auto slowest = std::max_element(
+      modules_status_.begin(), modules_status_.end(), [](const auto & a, const auto & b) {
+        return a->processing_time_ms < b->processing_time_ms;
+      });
+    RCLCPP_WARN_THROTTLE(
+      logger_, clock_, 1000,
+      "planning took %.1f [ms] over the budget of %.1f [ms], slowest module: %s (%.1f [ms])",
+      elapsed_time * 1e3, bt_manager_param_.planning_time_budget * 1e3,
+      (*slowest)->module_name.c_str(), (*slowest)->processing_time_ms);
+  }
+
   RCLCPP_DEBUG(logger_, "BehaviorPathPlanner::run end status = %s", BT::toStr(res).c_str());
 
   return output;
@@ -0,0 +1,207 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "behavior_path_planner/drivable_area_cache.hpp"
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <tf2/utils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr uint8_t free_space = 0;
+constexpr uint8_t occupied_space = 100;
+// cells of a side of a tile
+constexpr int tile_size = 256;
+// iterations of the closing of the drivable area
+constexpr int num_closing_iter = 10;  // TODO(Horibe) Think later.
+// the result of the closing at a cell depends on the cells within twice the iterations
+constexpr int tile_padding = 2 * num_closing_iter;
+constexpr size_t max_num_lane_rasters = 8;
+
+uint64_t getTileKey(const int64_t tile_x, const int64_t tile_y)
+{
+  return (static_cast<uint64_t>(tile_x) << 32) ^ (static_cast<uint64_t>(tile_y) & 0xffffffff);
+}
+
+int64_t getTileIndex(const double x, const double resolution)
+{
+  return static_cast<int64_t>(std::floor(x / (resolution * tile_size)));
+}
+}  // namespace
+
+namespace behavior_path_planner
+{
+cv::Mat DrivableAreaCache::getImage(
+  const std::vector<lanelet::Id> & lane_ids, const std::function<Polygons()> & get_polygons,
+  const geometry_msgs::msg::Pose & grid_origin, const double width, const double height,
+  const double resolution)
+{
+  auto & raster = getLaneRaster(lane_ids, get_polygons, resolution);
+
+  const int rows = static_cast<int>(width / resolution);
+  const int cols = static_cast<int>(height / resolution);
+  const double yaw = tf2::getYaw(grid_origin.orientation);
+  const double cos_yaw = std::cos(yaw);
+  const double sin_yaw = std::sin(yaw);
+
+  // tiles overlapping the grid
+  double min_x = std::numeric_limits<double>::max();
+  double min_y = std::numeric_limits<double>::max();
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  for (const double x : {0.0, width}) {
+    for (const double y : {0.0, height}) {
+      const double map_x = grid_origin.position.x + cos_yaw * x - sin_yaw * y;
+      const double map_y = grid_origin.position.y + sin_yaw * x + cos_yaw * y;
+      min_x = std::min(min_x, map_x);
+      min_y = std::min(min_y, map_y);
+      max_x = std::max(max_x, map_x);
+      max_y = std::max(max_y, map_y);
+    }
+  }
+  const int64_t min_tile_x = getTileIndex(min_x, resolution);
+  const int64_t min_tile_y = getTileIndex(min_y, resolution);
+  const int64_t max_tile_x = getTileIndex(max_x, resolution);
+  const int64_t max_tile_y = getTileIndex(max_y, resolution);
+
+  // the cell (row, col) of the mosaic is at (col, row) * resolution from its origin
+  cv::Mat mosaic(
+    static_cast<int>(max_tile_y - min_tile_y + 1) * tile_size,
+    static_cast<int>(max_tile_x - min_tile_x + 1) * tile_size, CV_8UC1,
+    cv::Scalar(occupied_space));
+  for (int64_t tile_x = min_tile_x; tile_x <= max_tile_x; ++tile_x) {
+    for (int64_t tile_y = min_tile_y; tile_y <= max_tile_y; ++tile_y) {
+      const auto & tile = getTile(raster, tile_x, tile_y);
+      if (tile.empty()) {
+        continue;
+      }
+      const cv::Rect roi(
+        static_cast<int>(tile_x - min_tile_x) * tile_size,
+        static_cast<int>(tile_y - min_tile_y) * tile_size, tile_size, tile_size);
+      tile.copyTo(mosaic(roi));
+    }
+  }
+
+  // cell of the mosaic for each cell of the grid
+  const double origin_x = min_tile_x * tile_size * resolution;
+  const double origin_y = min_tile_y * tile_size * resolution;
+  const double map_x = grid_origin.position.x + cos_yaw * width - sin_yaw * height;
+  const double map_y = grid_origin.position.y + sin_yaw * width + cos_yaw * height;
+  const cv::Matx23d grid_to_mosaic(
+    sin_yaw, -cos_yaw, (map_x - origin_x) / resolution, -cos_yaw, -sin_yaw,
+    (map_y - origin_y) / resolution);
+  cv::Mat image;
+  cv::warpAffine(
+    mosaic, image, grid_to_mosaic, cv::Size(cols, rows), cv::INTER_NEAREST | cv::WARP_INVERSE_MAP,
+    cv::BORDER_CONSTANT, cv::Scalar(occupied_space));
+  return image;
+}
+
+DrivableAreaCache::LaneRaster & DrivableAreaCache::getLaneRaster(
+  const std::vector<lanelet::Id> & lane_ids, const std::function<Polygons()> & get_polygons,
+  const double resolution)
+{
+  const auto itr = std::find_if(
+    lane_rasters_.begin(), lane_rasters_.end(), [&](const LaneRaster & raster) {
+      return raster.lane_ids == lane_ids && raster.resolution == resolution;
+    });
+  if (itr != lane_rasters_.end()) {
+    lane_rasters_.splice(lane_rasters_.begin(), lane_rasters_, itr);
+    return lane_rasters_.front();
+  }
+
+  LaneRaster raster;
+  raster.lane_ids = lane_ids;
+  raster.resolution = resolution;
+  raster.polygons = get_polygons();
+  lane_rasters_.push_front(std::move(raster));
+  if (lane_rasters_.size() > max_num_lane_rasters) {
+    lane_rasters_.pop_back();
+  }
+  return lane_rasters_.front();
+}
+
+const cv::Mat & DrivableAreaCache::getTile(
+  LaneRaster & raster, const int64_t tile_x, const int64_t tile_y)
+{
+  const auto key = getTileKey(tile_x, tile_y);
+  const auto itr = raster.tiles.find(key);
+  if (itr != raster.tiles.end()) {
+    return itr->second;
+  }
+
+  // first cell of the padded tile
+  const double resolution = raster.resolution;
+  const int64_t begin_x = tile_x * tile_size - tile_padding;
+  const int64_t begin_y = tile_y * tile_size - tile_padding;
+  const double min_x = begin_x * resolution;
+  const double min_y = begin_y * resolution;
+  const double max_x = (begin_x + tile_size + 2 * tile_padding) * resolution;
+  const double max_y = (begin_y + tile_size + 2 * tile_padding) * resolution;
+
+  std::vector<std::vector<cv::Point>> cv_polygons;
+  for (const auto & polygon : raster.polygons) {
+    if (polygon.empty()) {
+      continue;
+    }
+    double polygon_min_x = std::numeric_limits<double>::max();
+    double polygon_min_y = std::numeric_limits<double>::max();
+    double polygon_max_x = std::numeric_limits<double>::lowest();
+    double polygon_max_y = std::numeric_limits<double>::lowest();
+    for (const auto & p : polygon) {
+      polygon_min_x = std::min(polygon_min_x, p.x());
+      polygon_min_y = std::min(polygon_min_y, p.y());
+      polygon_max_x = std::max(polygon_max_x, p.x());
+      polygon_max_y = std::max(polygon_max_y, p.y());
+    }
+    if (
+      polygon_max_x < min_x || max_x < polygon_min_x || polygon_max_y < min_y ||
+      max_y < polygon_min_y) {
+      continue;
+    }
+
+    std::vector<cv::Point> cv_polygon;
+    for (const auto & p : polygon) {
+      cv_polygon.emplace_back(
+        static_cast<int>(std::lround(p.x() / resolution - begin_x)),
+        static_cast<int>(std::lround(p.y() / resolution - begin_y)));
+    }
+    cv_polygons.push_back(cv_polygon);
+  }
+
+  if (cv_polygons.empty()) {
+    return raster.tiles.emplace(key, cv::Mat()).first->second;
+  }
+
+  const int padded_size = tile_size + 2 * tile_padding;
+  cv::Mat padded_tile(padded_size, padded_size, CV_8UC1, cv::Scalar(occupied_space));
+  cv::fillPoly(padded_tile, cv_polygons, cv::Scalar(free_space));
+
+  // Closing
+  cv::Mat cv_erode, cv_dilate;
+  cv::erode(padded_tile, cv_erode, cv::Mat(), cv::Point(-1, -1), num_closing_iter);
+  cv::dilate(cv_erode, cv_dilate, cv::Mat(), cv::Point(-1, -1), num_closing_iter);
+
+  const cv::Rect roi(tile_padding, tile_padding, tile_size, tile_size);
+  return raster.tiles.emplace(key, cv_dilate(roi).clone()).first->second;
+}
+}  // namespace behavior_path_planner
@@ -0,0 +1,217 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "behavior_path_planner/frenet_frame.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace behavior_path_planner
+{
+namespace util
+{
+FrenetFrame::FrenetFrame(const PathWithLaneId & path) : FrenetFrame(convertToPointArray(path)) {}
+
+FrenetFrame::FrenetFrame(const std::vector<Point> & linestring)
+: cell_size_(1.0), min_cell_x_(0), max_cell_x_(0), min_cell_y_(0), max_cell_y_(0)
+{
+  if (linestring.empty()) {
+    return;
+  }
+
+  points_.reserve(linestring.size());
+  lengths_.reserve(linestring.size());
+  for (const auto & geom_pt : linestring) {
+    points_.push_back(autoware_utils::fromMsg(geom_pt));
+  }
+
+  // a single point is handled as a segment of zero length
+  lengths_.push_back(0.0);
+  const size_t segment_num = std::max(points_.size(), size_t{2}) - 1;
+  directions_.reserve(segment_num);
+  for (size_t i = 0; i < segment_num; ++i) {
+    const Eigen::Vector3d segment = points_.at(std::min(i + 1, points_.size() - 1)) - points_.at(i);
+    const double segment_length = segment.norm();
+    if (i + 1 < points_.size()) {
+      lengths_.push_back(lengths_.back() + segment_length);
+    }
+    directions_.push_back(
+      segment_length > 0.0 ? Eigen::Vector3d(segment / segment_length) : Eigen::Vector3d::Zero());
+  }
+
+  // about one segment per cell
+  cell_size_ = std::max(getLength() / static_cast<double>(segment_num), 1.0);
+  min_cell_x_ = min_cell_y_ = std::numeric_limits<int64_t>::max();
+  max_cell_x_ = max_cell_y_ = std::numeric_limits<int64_t>::lowest();
+  for (size_t i = 0; i < segment_num; ++i) {
+    const auto & p1 = points_.at(i);
+    const auto & p2 = points_.at(std::min(i + 1, points_.size() - 1));
+    const int64_t cell_x_begin = getCellIndex(std::min(p1.x(), p2.x()));
+    const int64_t cell_x_end = getCellIndex(std::max(p1.x(), p2.x()));
+    const int64_t cell_y_begin = getCellIndex(std::min(p1.y(), p2.y()));
+    const int64_t cell_y_end = getCellIndex(std::max(p1.y(), p2.y()));
+    for (int64_t cell_x = cell_x_begin; cell_x <= cell_x_end; ++cell_x) {
+      for (int64_t cell_y = cell_y_begin; cell_y <= cell_y_end; ++cell_y) {
+        cells_[getCellKey(cell_x, cell_y)].push_back(i);
+      }
+    }
+    min_cell_x_ = std::min(min_cell_x_, cell_x_begin);
+    max_cell_x_ = std::max(max_cell_x_, cell_x_end);
+    min_cell_y_ = std::min(min_cell_y_, cell_y_begin);
+    max_cell_y_ = std::max(max_cell_y_, cell_y_end);
+  }
+}
+
+bool FrenetFrame::convertToFrenetCoordinate3d(
+  const Point & search_point_geom, FrenetCoordinate3d * frenet_coordinate) const
+{
+  if (empty()) {
+    return false;
+  }
+
+  const auto search_pt = autoware_utils::fromMsg(search_point_geom);
+  Projection best{0, 0.0, std::numeric_limits<double>::max()};
+  searchGrid(search_pt, &best);
+
+  frenet_coordinate->length = best.length;
+  frenet_coordinate->distance = best.distance;
+  return true;
+}
+
+bool FrenetFrame::convertToFrenetCoordinate3d(
+  const Point & search_point_geom, FrenetCoordinate3d * frenet_coordinate,
+  size_t * hint_segment_idx) const
+{
+  if (empty()) {
+    return false;
+  }
+
+  const auto search_pt = autoware_utils::fromMsg(search_point_geom);
+  const size_t hint_idx = std::min(*hint_segment_idx, getSegmentNum() - 1);
+  Projection best = projectOnSegment(search_pt, hint_idx);
+
+  // descend to the local minimum around the hint, then the grid only has to confirm that no
+  // other part of the linestring is closer
+  for (size_t i = hint_idx + 1; i < getSegmentNum(); ++i) {
+    const auto projection = projectOnSegment(search_pt, i);
+    if (projection.distance >= best.distance) {
+      break;
+    }
+    best = projection;
+  }
+  for (size_t i = hint_idx; i > 0; --i) {
+    const auto projection = projectOnSegment(search_pt, i - 1);
+    if (projection.distance > best.distance) {
+      break;
+    }
+    best = projection;
+  }
+  searchGrid(search_pt, &best);
+
+  frenet_coordinate->length = best.length;
+  frenet_coordinate->distance = best.distance;
+  *hint_segment_idx = best.segment_idx;
+  return true;
+}
+
+FrenetFrame::Projection FrenetFrame::projectOnSegment(
+  const autoware_utils::Point3d & point, const size_t idx) const
+{
+  const auto & start = points_.at(idx);
+  const auto & direction = directions_.at(idx);
+  const double segment_length = idx + 1 < lengths_.size() ? lengths_.at(idx + 1) - lengths_.at(idx)
+                                                          : 0.0;
+
+  const Eigen::Vector3d start2point = point - start;
+  const double length = std::max(0.0, std::min(direction.dot(start2point), segment_length));
+  const Eigen::Vector3d closest2point = start2point - direction * length;
+  return Projection{idx, lengths_.at(idx) + length, closest2point.norm()};
+}
+
+void FrenetFrame::updateProjection(
+  const autoware_utils::Point3d & point, const size_t idx, Projection * best) const
+{
+  const auto projection = projectOnSegment(point, idx);
+  // the front most one for the points at the same distance, as the linear search
+  if (
+    projection.distance < best->distance ||
+    (projection.distance == best->distance && projection.segment_idx < best->segment_idx)) {
+    *best = projection;
+  }
+}
+
+void FrenetFrame::searchGrid(const autoware_utils::Point3d & point, Projection * best) const
+{
+  const int64_t center_x = getCellIndex(point.x());
+  const int64_t center_y = getCellIndex(point.y());
+  const auto covers_grid = [&](const int64_t r) {
+    return center_x - r <= min_cell_x_ && max_cell_x_ <= center_x + r &&
+           center_y - r <= min_cell_y_ && max_cell_y_ <= center_y + r;
+  };
+  const auto check_cell = [&](const int64_t cell_x, const int64_t cell_y) {
+    const auto it = cells_.find(getCellKey(cell_x, cell_y));
+    if (it == cells_.end()) {
+      return;
+    }
+    for (const auto idx : it->second) {
+      updateProjection(point, idx, best);
+    }
+  };
+
+  size_t checked_cell_num = 0;
+  for (int64_t r = 0;; ++r) {
+    // the cells of the ring r are at least (r - 1) * cell_size_ away from the point in xy, which
+    // is a lower bound of the 3d distance
+    if (best->distance <= static_cast<double>(r - 1) * cell_size_) {
+      return;
+    }
+    if (r > 0 && covers_grid(r - 1)) {
+      return;
+    }
+
+    // far from the linestring, checking all the segments is cheaper than the empty cells
+    checked_cell_num += r == 0 ? 1 : 8 * r;
+    if (checked_cell_num > getSegmentNum()) {
+      for (size_t i = 0; i < getSegmentNum(); ++i) {
+        updateProjection(point, i, best);
+      }
+      return;
+    }
+
+    if (r == 0) {
+      check_cell(center_x, center_y);
+      continue;
+    }
+    for (int64_t d = -r; d < r; ++d) {
+      check_cell(center_x + d, center_y - r);
+      check_cell(center_x + r, center_y + d);
+      check_cell(center_x - d, center_y + r);
+      check_cell(center_x - r, center_y - d);
+    }
+  }
+}
+
+int64_t FrenetFrame::getCellIndex(const double x) const
+{
+  return static_cast<int64_t>(std::floor(x / cell_size_));
+}
+
+uint64_t FrenetFrame::getCellKey(const int64_t cell_x, const int64_t cell_y)
+{
+  return (static_cast<uint64_t>(cell_x) << 32) ^ (static_cast<uint64_t>(cell_y) & 0xffffffff);
+}
+}  // namespace util
+}  // namespace behavior_path_planner
@@ -18,9 +18,9 @@
 #include "behavior_path_planner/utilities.hpp"
 
 #include <autoware_utils/autoware_utils.hpp>
-#include <interpolation/spline_interpolation.hpp>
 #include <lanelet2_extension/utility/utilities.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <string>
 #include <utility>
@@ -50,6 +50,15 @@ void PathShifter::setPath(const PathWithLaneId & path)
 {
   reference_path_ = path;
   is_index_aligned_ = false;  // shift_point index has to be updated for new path.
+
+  reference_arclength_ = util::calcPathArcLengthArray(reference_path_);
+  reference_normal_x_.resize(reference_path_.points.size());
+  reference_normal_y_.resize(reference_path_.points.size());
+  for (size_t i = 0; i < reference_path_.points.size(); ++i) {
+    const double yaw = tf2::getYaw(reference_path_.points.at(i).point.pose.orientation);
+    reference_normal_x_.at(i) = -std::sin(yaw);
+    reference_normal_y_.at(i) = std::cos(yaw);
+  }
 }
 void PathShifter::addShiftPoint(const ShiftPoint & point)
 {
@@ -75,11 +84,12 @@ bool PathShifter::generate(
   }
 
   shifted_path->path = reference_path_;
-  shifted_path->shift_length.resize(reference_path_.points.size(), 0.0);
+  shifted_path->shift_length.assign(reference_path_.points.size(), 0.0);
 
   if (shift_points_.empty()) {
     RCLCPP_DEBUG_STREAM(logger_, "shift_points_ is empty. Return reference with base offset.");
     shiftBaseLength(shifted_path, base_offset_);
+    applyShiftLength(shifted_path);
     return true;
   }
 
@@ -116,6 +126,7 @@ bool PathShifter::generate(
   // Calculate shifted path
   type == SHIFT_TYPE::SPLINE ? applySplineShifter(shifted_path, offset_back)
                              : applyLinearShifter(shifted_path);
+  applyShiftLength(shifted_path);
 
   // DEBUG
   RCLCPP_DEBUG_STREAM(
@@ -124,9 +135,32 @@ bool PathShifter::generate(
   return true;
 }
 
-void PathShifter::applyLinearShifter(ShiftedPath * shifted_path)
+bool PathShifter::generateCandidates(
+  const std::vector<ShiftPointArray> & candidates, std::vector<ShiftedPath> * shifted_paths,
+  const bool offset_back, const SHIFT_TYPE type)
+{
+  const auto shift_points = shift_points_;
+  const auto is_index_aligned = is_index_aligned_;
+
+  bool is_success = true;
+  shifted_paths->clear();
+  shifted_paths->reserve(candidates.size());
+  for (const auto & candidate : candidates) {
+    setShiftPoints(candidate);
+    ShiftedPath shifted_path;
+    is_success &= generate(&shifted_path, offset_back, type);
+    shifted_paths->push_back(std::move(shifted_path));
+  }
+
+  shift_points_ = shift_points;
+  is_index_aligned_ = is_index_aligned;
+  return is_success;
+}
+
+void PathShifter::applyLinearShifter(ShiftedPath * shifted_path) const
 {
-  const auto arclength_arr = util::calcPathArcLengthArray(reference_path_);
+  const auto & arclength_arr = reference_arclength_;
+  auto & shift_length = shifted_path->shift_length;
 
   shiftBaseLength(shifted_path, base_offset_);
 
@@ -134,33 +168,27 @@ void PathShifter::applyLinearShifter(ShiftedPath * shifted_path)
 
   // For all shift_points,
   for (const auto & shift_point : shift_points_) {
-    const auto current_shift = shifted_path->shift_length.at(shift_point.end_idx);
+    const auto current_shift = shift_length.at(shift_point.end_idx);
     const auto delta_shift = shift_point.length - current_shift;
     const auto shifting_arclength = std::max(
       arclength_arr.at(shift_point.end_idx) - arclength_arr.at(shift_point.start_idx), epsilon);
 
-    // For all path.points,
-    for (size_t i = 0; i < shifted_path->path.points.size(); ++i) {
-      // Set shift length.
-      double ith_shift_length;
-      if (i < shift_point.start_idx) {
-        ith_shift_length = 0.0;
-      } else if (shift_point.start_idx <= i && i <= shift_point.end_idx) {
+    // For all path.points after the shift start,
+    for (size_t i = shift_point.start_idx; i < shift_length.size(); ++i) {
+      if (i <= shift_point.end_idx) {
         auto dist_from_start = arclength_arr.at(i) - arclength_arr.at(shift_point.start_idx);
-        ith_shift_length = (dist_from_start / shifting_arclength) * delta_shift;
+        shift_length.at(i) += (dist_from_start / shifting_arclength) * delta_shift;
       } else {
-        ith_shift_length = delta_shift;
+        shift_length.at(i) += delta_shift;
       }
-
-      // Apply shifting.
-      addLateralOffsetOnIndexPoint(shifted_path, ith_shift_length, i);
     }
   }
 }
 
-void PathShifter::applySplineShifter(ShiftedPath * shifted_path, const bool offset_back)
+void PathShifter::applySplineShifter(ShiftedPath * shifted_path, const bool offset_back) const
 {
-  const auto arclength_arr = util::calcPathArcLengthArray(reference_path_);
+  const auto & arclength_arr = reference_arclength_;
+  auto & shift_length = shifted_path->shift_length;
 
   shiftBaseLength(shifted_path, base_offset_);
 
@@ -170,7 +198,7 @@ void PathShifter::applySplineShifter(ShiftedPath * shifted_path, const bool offs
   for (const auto & shift_point : shift_points_) {
     // calc delta shift at the sp.end_idx so that the sp.end_idx on the path will have
     // the desired shift length.
-    const auto current_shift = shifted_path->shift_length.at(shift_point.end_idx);
+    const auto current_shift = shift_length.at(shift_point.end_idx);
     const auto delta_shift = shift_point.length - current_shift;
 
     RCLCPP_DEBUG(logger_, "current_shift = %f, sp.length = %f", current_shift, shift_point.length);
@@ -179,49 +207,36 @@ void PathShifter::applySplineShifter(ShiftedPath * shifted_path, const bool offs
       RCLCPP_DEBUG(logger_, "delta shift is zero. skip for this shift point.");
     }
 
-    const auto shifting_arclength = std::max(
-      arclength_arr.at(shift_point.end_idx) - arclength_arr.at(shift_point.start_idx), epsilon);
-
-    // TODO(Watanabe) write docs.
-    // These points are defined to achieve the constant-jerk shifting (see the header description).
-    const std::vector<double> base_distance = {
-      0.0, shifting_arclength / 4.0, shifting_arclength * 3.0 / 4.0, shifting_arclength};
-    const auto base_length =
-      offset_back
-        ? std::vector<double>{0.0, delta_shift / 12.0, delta_shift * 11.0 / 12.0, delta_shift}
-        : std::vector<double>{delta_shift, delta_shift * 11.0 / 12.0, delta_shift / 12.0, 0.0};
+    const auto start_arclength = arclength_arr.at(shift_point.start_idx);
+    const auto shifting_arclength =
+      std::max(arclength_arr.at(shift_point.end_idx) - start_arclength, epsilon);
 
-    std::vector<double> query_distance, query_length;
+    // The constant-jerk shifting is evaluated at the arc length of each point (see the header
+    // description); with offset_back false, the shift is applied backward from the end point.
+    const auto calcShift = [&](const size_t i) {
+      const double shift = calcSplineShiftLength(
+        arclength_arr.at(i) - start_arclength, shifting_arclength, delta_shift);
+      return offset_back ? shift : delta_shift - shift;
+    };
 
     // For all path.points,
     // Note: start_idx is not included since shift = 0,
     //       end_idx is not included since shift is considered out of spline.
     for (size_t i = shift_point.start_idx + 1; i < shift_point.end_idx; ++i) {
-      const double dist_from_start = arclength_arr.at(i) - arclength_arr.at(shift_point.start_idx);
-      query_distance.push_back(dist_from_start);
-    }
-    if (!query_distance.empty()) {
-      query_length = interpolation::slerp(base_distance, base_length, query_distance);
-    }
-
-    // Apply shifting.
-    {
-      size_t i = shift_point.start_idx + 1;
-      for (const auto & itr : query_length) {
-        addLateralOffsetOnIndexPoint(shifted_path, itr, i);
-        ++i;
-      }
+      shift_length.at(i) += calcShift(i);
     }
 
     if (offset_back == true) {
       // Apply shifting after shift
-      for (size_t i = shift_point.end_idx; i < shifted_path->path.points.size(); ++i) {
-        addLateralOffsetOnIndexPoint(shifted_path, delta_shift, i);
+      for (size_t i = shift_point.end_idx; i < shift_length.size(); ++i) {
+        shift_length.at(i) += delta_shift;
       }
     } else {
       // Apply shifting before shift
+      const double front_shift =
+        calcShift(std::min(shift_point.start_idx + 1, shift_point.end_idx));
       for (size_t i = 0; i < shift_point.start_idx + 1; ++i) {
-        addLateralOffsetOnIndexPoint(shifted_path, query_length.front(), i);
+        shift_length.at(i) += front_shift;
       }
     }
   }
@@ -229,7 +244,7 @@ void PathShifter::applySplineShifter(ShiftedPath * shifted_path, const bool offs
 
 std::vector<double> PathShifter::calcLateralJerk()
 {
-  const auto arclength_arr = util::calcPathArcLengthArray(reference_path_);
+  const auto & arclength_arr = reference_arclength_;
 
   constexpr double epsilon = 1.0e-8;  // to avoid 0 division
 
@@ -273,22 +288,20 @@ bool PathShifter::calcShiftPointFromArcLength(
         << arclength_from_origin.back() << ", desired dist_to_end = " << dist_to_end);
   }
 
-  bool is_start_found = false;
-  bool is_end_found = false;
-  const auto getPathPointFromOrigin = [&](size_t idx_from_origin) {
-    return path.points.at(idx_from_origin + origin_idx).point.pose;
-  };
-  for (size_t i = 0; i < arclength_from_origin.size() - 1; ++i) {
-    if (!is_start_found && arclength_from_origin.at(i + 1) > dist_to_start) {
-      shift_point->start = getPathPointFromOrigin(i);
-      is_start_found = true;
-    }
-    if (!is_end_found && arclength_from_origin.at(i + 1) > dist_to_end) {
-      shift_point->end = getPathPointFromOrigin(i);
-      is_end_found = true;
-      break;
+  // The point is the one before the first point farther than the distance.
+  const auto findPathPointFromOrigin = [&](const double dist, Pose * pose) {
+    const auto itr =
+      std::upper_bound(arclength_from_origin.begin() + 1, arclength_from_origin.end(), dist);
+    if (itr == arclength_from_origin.end()) {
+      return false;
     }
-  }
+    const auto idx_from_origin = std::distance(arclength_from_origin.begin(), itr) - 1;
+    *pose = path.points.at(idx_from_origin + origin_idx).point.pose;
+    return true;
+  };
+  const bool is_start_found = findPathPointFromOrigin(dist_to_start, &shift_point->start);
+  const bool is_end_found =
+    is_start_found && findPathPointFromOrigin(dist_to_end, &shift_point->end);
 
   if (!is_start_found) {
     RCLCPP_ERROR_STREAM(
@@ -415,27 +428,25 @@ void PathShifter::removeBehindShiftPointAndSetBaseOffset(const Point & base_poin
   setBaseOffset(new_base_offset);
 }
 
-void PathShifter::addLateralOffsetOnIndexPoint(
-  ShiftedPath * path, double offset, size_t index) const
+void PathShifter::applyShiftLength(ShiftedPath * path) const
 {
-  if (fabs(offset) < 1.0e-8) {
-    return;
+  for (size_t i = 0; i < path->path.points.size(); ++i) {
+    const double offset = path->shift_length.at(i);
+    if (std::fabs(offset) < 1.0e-8) {
+      continue;
+    }
+    auto & p = path->path.points.at(i).point.pose;
+    p.position.x += reference_normal_x_.at(i) * offset;
+    p.position.y += reference_normal_y_.at(i) * offset;
   }
-
-  auto & p = path->path.points.at(index).point.pose;
-  double yaw = tf2::getYaw(p.orientation);
-  p.position.x -= std::sin(yaw) * offset;
-  p.position.y += std::cos(yaw) * offset;
-
-  path->shift_length.at(index) += offset;
 }
 
 void PathShifter::shiftBaseLength(ShiftedPath * path, double offset) const
 {
   constexpr double BASE_OFFSET_THR = 1.0e-4;
   if (std::abs(offset) > BASE_OFFSET_THR) {
-    for (size_t i = 0; i < path->path.points.size(); ++i) {
-      addLateralOffsetOnIndexPoint(path, offset, i);
+    for (auto & shift_length : path->shift_length) {
+      shift_length += offset;
     }
   }
 }
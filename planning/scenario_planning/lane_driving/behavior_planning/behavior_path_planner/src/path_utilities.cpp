@@ -98,17 +98,23 @@ PathWithLaneId resamplePathWithSpline(const PathWithLaneId & path, double interv
     return path;
   }
 
-  std::vector<double> base_x, base_y, base_z;
+  std::vector<std::vector<double>> base_xyz(3);
+  for (auto & base_values : base_xyz) {
+    base_values.reserve(path.points.size());
+  }
   for (const auto & p : path.points) {
     const auto & pos = p.point.pose.position;
-    base_x.push_back(pos.x);
-    base_y.push_back(pos.y);
-    base_z.push_back(pos.z);
+    base_xyz.at(0).push_back(pos.x);
+    base_xyz.at(1).push_back(pos.y);
+    base_xyz.at(2).push_back(pos.z);
   }
 
-  const auto resampled_x = interpolation::slerp(base_points, base_x, sampling_points);
-  const auto resampled_y = interpolation::slerp(base_points, base_y, sampling_points);
-  const auto resampled_z = interpolation::slerp(base_points, base_z, sampling_points);
+  std::vector<std::vector<double>> resampled_xyz;
+  interpolation::MultiChannelSpline(base_points, base_xyz)
+    .interpolate(sampling_points, resampled_xyz);
+  const auto & resampled_x = resampled_xyz.at(0);
+  const auto & resampled_y = resampled_xyz.at(1);
+  const auto & resampled_z = resampled_xyz.at(2);
 
   PathWithLaneId resampled_path{};
   resampled_path.header = path.header;
@@ -0,0 +1,124 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "behavior_path_planner/predicted_object_cache.hpp"
+
+#include "behavior_path_planner/utilities.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace behavior_path_planner
+{
+namespace
+{
+boost::optional<geometry_msgs::msg::Point> lerpPosition(
+  const autoware_perception_msgs::msg::PredictedPath & path, const rclcpp::Time & t)
+{
+  geometry_msgs::msg::Pose pose;
+  if (!util::lerpByTimeStamp(path, t, &pose)) {
+    return {};
+  }
+  return pose.position;
+}
+}  // namespace
+
+PredictedObjectCache::PredictedObjectCache(
+  const DynamicObjectArray::ConstSharedPtr & objects, const rclcpp::Time & start_time,
+  const double time_resolution, const double time_horizon)
+: objects_(objects),
+  start_time_(start_time),
+  time_resolution_(time_resolution),
+  num_steps_(static_cast<size_t>(std::floor(time_horizon / time_resolution)) + 1)
+{
+  std::vector<BoxWithIndex> boxes;
+  entries_.resize(objects_->objects.size());
+  for (size_t i = 0; i < objects_->objects.size(); ++i) {
+    const auto & object = objects_->objects.at(i);
+    auto & entry = entries_.at(i);
+
+    autoware_utils::Polygon2d polygon;
+    if (util::calcObjectPolygon(object, &polygon)) {
+      boxes.emplace_back(boost::geometry::return_envelope<autoware_utils::Box2d>(polygon), i);
+      entry.polygon = polygon;
+    }
+
+    for (const auto & path : object.state.predicted_paths) {
+      PredictedPositions positions;
+      positions.reserve(num_steps_);
+      for (size_t step = 0; step < num_steps_; ++step) {
+        positions.push_back(lerpPosition(
+          path, start_time_ + rclcpp::Duration::from_seconds(step * time_resolution_)));
+      }
+      entry.predicted_positions.push_back(std::move(positions));
+    }
+  }
+
+  // packing construction
+  rtree_ = decltype(rtree_)(boxes.begin(), boxes.end());
+}
+
+boost::optional<size_t> PredictedObjectCache::getMaxConfidencePathIndex(
+  const size_t object_idx) const
+{
+  const auto & paths = objects_->objects.at(object_idx).state.predicted_paths;
+  if (paths.empty()) {
+    return {};
+  }
+  const auto max_confidence_path = std::max_element(
+    paths.begin(), paths.end(),
+    [](const auto & path1, const auto & path2) { return path1.confidence < path2.confidence; });
+  return static_cast<size_t>(std::distance(paths.begin(), max_confidence_path));
+}
+
+PredictedObjectCache::PredictedPositions PredictedObjectCache::getPredictedPositions(
+  const size_t object_idx, const size_t path_idx,
+  const std::vector<rclcpp::Duration> & times) const
+{
+  constexpr double epsilon = 1e-6;
+  const auto & cached_positions = entries_.at(object_idx).predicted_positions.at(path_idx);
+  const auto & path = objects_->objects.at(object_idx).state.predicted_paths.at(path_idx);
+
+  PredictedPositions positions;
+  positions.reserve(times.size());
+  for (const auto & t : times) {
+    const double step = std::round(t.seconds() / time_resolution_);
+    const bool is_on_grid = step >= 0.0 && step < static_cast<double>(num_steps_) &&
+                            std::abs(step * time_resolution_ - t.seconds()) < epsilon;
+    if (is_on_grid) {
+      positions.push_back(cached_positions.at(static_cast<size_t>(step)));
+    } else {
+      positions.push_back(lerpPosition(path, start_time_ + t));
+    }
+  }
+  return positions;
+}
+
+std::vector<size_t> PredictedObjectCache::queryObjects(const autoware_utils::Box2d & box) const
+{
+  std::vector<BoxWithIndex> result;
+  rtree_.query(boost::geometry::index::intersects(box), std::back_inserter(result));
+
+  std::vector<size_t> indices;
+  for (const auto & r : result) {
+    indices.push_back(r.second);
+  }
+  // in the order of the objects, as the other filters
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+}  // namespace behavior_path_planner
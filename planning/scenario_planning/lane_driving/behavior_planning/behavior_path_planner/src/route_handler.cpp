@@ -19,6 +19,7 @@
 #include <lanelet2_extension/utility/message_conversion.hpp>
 #include <lanelet2_extension/utility/query.hpp>
 #include <lanelet2_extension/utility/utilities.hpp>
+#include <planner_data_snapshot/lanelet_map_snapshot.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <lanelet2_core/LaneletMap.h>
@@ -90,31 +91,56 @@ lanelet::ConstPoint3d get3DPointFrom2DArcLength(
   return lanelet::ConstPoint3d();
 }
 
+bool findFollowingShoulderLanelet(
+  const lanelet::ConstLanelets & shoulder_lanelets, const lanelet::ConstLanelet & lanelet,
+  lanelet::ConstLanelet * following_lanelet)
+{
+  const auto & back_pt = lanelet.centerline2d().back();
+  for (const auto & shoulder_lanelet : shoulder_lanelets) {
+    const auto & front_pt = shoulder_lanelet.centerline2d().front();
+    if (std::hypot(front_pt.x() - back_pt.x(), front_pt.y() - back_pt.y()) < 5) {
+      *following_lanelet = shoulder_lanelet;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool findPreviousShoulderLanelet(
+  const lanelet::ConstLanelets & shoulder_lanelets, const lanelet::ConstLanelet & lanelet,
+  lanelet::ConstLanelet * prev_lanelet)
+{
+  const auto & front_pt = lanelet.centerline2d().front();
+  for (const auto & shoulder_lanelet : shoulder_lanelets) {
+    const auto & back_pt = shoulder_lanelet.centerline2d().back();
+    if (std::hypot(front_pt.x() - back_pt.x(), front_pt.y() - back_pt.y()) < 5) {
+      *prev_lanelet = shoulder_lanelet;
+      return true;
+    }
+  }
+  return false;
+}
 }  // namespace
 
 namespace behavior_path_planner
 {
 using autoware_planning_msgs::msg::PathPointWithLaneId;
 
+// enough for the poses queried by the modules in a cycle
+constexpr size_t closest_lanelet_cache_size = 8;
+
 void RouteHandler::setMap(const MapBin & map_msg)
 {
-  lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
-  lanelet::utils::conversion::fromBinMsg(
-    map_msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
-
-  const auto traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
-    lanelet::Locations::Germany, lanelet::Participants::Vehicle);
-  const auto pedestrian_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
-    lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
-  lanelet::routing::RoutingGraphConstPtr vehicle_graph =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *traffic_rules);
-  lanelet::routing::RoutingGraphConstPtr pedestrian_graph =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *pedestrian_rules);
-  lanelet::routing::RoutingGraphContainer overall_graphs({vehicle_graph, pedestrian_graph});
-  overall_graphs_ptr_ =
-    std::make_shared<const lanelet::routing::RoutingGraphContainer>(overall_graphs);
+  drivable_area_cache_->clear();
+  // shared with the planners composed in this process
+  const auto snapshot = planner_data_snapshot::LaneletMapSnapshotStore::getInstance().load(map_msg);
+  lanelet_map_ptr_ = snapshot->lanelet_map;
+  traffic_rules_ptr_ = snapshot->traffic_rules;
+  routing_graph_ptr_ = snapshot->routing_graph;
+  overall_graphs_ptr_ = snapshot->overall_graphs;
   lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
   shoulder_lanelets_ = lanelet::utils::query::shoulderLanelets(all_lanelets);
+  setShoulderLaneletConnections();
 
   is_map_msg_ready_ = true;
   is_handler_ready_ = false;
@@ -127,6 +153,7 @@ void RouteHandler::setRoute(const Route & route_msg)
   if (!isRouteLooped(route_msg)) {
     route_msg_ = route_msg;
     is_route_msg_ready_ = true;
+    drivable_area_cache_->clear();
     is_handler_ready_ = false;
     setRouteLanelets();
   } else {
@@ -138,8 +165,29 @@ void RouteHandler::setRoute(const Route & route_msg)
 
 bool RouteHandler::isHandlerReady() const { return is_handler_ready_; }
 
+void RouteHandler::setShoulderLaneletConnections()
+{
+  shoulder_lanelet_ids_.clear();
+  following_shoulder_lanelets_.clear();
+  previous_shoulder_lanelets_.clear();
+  for (const auto & llt : shoulder_lanelets_) {
+    shoulder_lanelet_ids_.insert(llt.id());
+    lanelet::ConstLanelet connected_lanelet;
+    if (findFollowingShoulderLanelet(shoulder_lanelets_, llt, &connected_lanelet)) {
+      following_shoulder_lanelets_.emplace(llt.id(), connected_lanelet);
+    }
+    if (findPreviousShoulderLanelet(shoulder_lanelets_, llt, &connected_lanelet)) {
+      previous_shoulder_lanelets_.emplace(llt.id(), connected_lanelet);
+    }
+  }
+}
+
 void RouteHandler::setRouteLanelets()
 {
+  {
+    std::lock_guard<std::mutex> lock(query_cache_mutex_);
+    query_cache_ = QueryCache{};
+  }
   if (!is_route_msg_ready_ || !is_map_msg_ready_) {
     return;
   }
@@ -166,6 +214,31 @@ void RouteHandler::setRouteLanelets()
       start_lanelets_.push_back(llt);
     }
   }
+
+  route_lanelet_ids_.clear();
+  for (const auto & llt : route_lanelets_) {
+    route_lanelet_ids_.insert(llt.id());
+  }
+  next_route_lanelets_.clear();
+  previous_route_lanelets_.clear();
+  for (const auto & llt : route_lanelets_) {
+    if (!exists(goal_lanelets_, llt)) {
+      for (const auto & following_llt : routing_graph_ptr_->following(llt)) {
+        if (route_lanelet_ids_.count(following_llt.id())) {
+          next_route_lanelets_.emplace(llt.id(), following_llt);
+          break;
+        }
+      }
+    }
+    if (!exists(start_lanelets_, llt)) {
+      for (const auto & previous_llt : routing_graph_ptr_->previous(llt)) {
+        if (route_lanelet_ids_.count(previous_llt.id())) {
+          previous_route_lanelets_.emplace(llt.id(), previous_llt);
+          break;
+        }
+      }
+    }
+  }
   is_handler_ready_ = true;
 }
 
@@ -290,10 +363,19 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!route_lanelet_ids_.count(lanelet.id())) {
     return lanelet_sequence_forward;
   }
 
+  const auto key = std::make_pair(lanelet.id(), min_length);
+  {
+    std::lock_guard<std::mutex> lock(query_cache_mutex_);
+    const auto it = query_cache_.sequences_after.find(key);
+    if (it != query_cache_.sequences_after.end()) {
+      return it->second;
+    }
+  }
+
   double length = 0;
   lanelet::ConstLanelet current_lanelet = lanelet;
   while (rclcpp::ok() && length < min_length) {
@@ -306,6 +388,8 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
     length += boost::geometry::length(next_lanelet.centerline().basicLineString());
   }
 
+  std::lock_guard<std::mutex> lock(query_cache_mutex_);
+  query_cache_.sequences_after.emplace(key, lanelet_sequence_forward);
   return lanelet_sequence_forward;
 }
 
@@ -313,10 +397,19 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
   lanelet::ConstLanelets lanelet_sequence_backward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!route_lanelet_ids_.count(lanelet.id())) {
     return lanelet_sequence_backward;
   }
 
+  const auto key = std::make_pair(lanelet.id(), min_length);
+  {
+    std::lock_guard<std::mutex> lock(query_cache_mutex_);
+    const auto it = query_cache_.sequences_up_to.find(key);
+    if (it != query_cache_.sequences_up_to.end()) {
+      return it->second;
+    }
+  }
+
   lanelet::ConstLanelet current_lanelet = lanelet;
   double length = 0;
 
@@ -331,6 +424,9 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
   }
 
   std::reverse(lanelet_sequence_backward.begin(), lanelet_sequence_backward.end());
+
+  std::lock_guard<std::mutex> lock(query_cache_mutex_);
+  query_cache_.sequences_up_to.emplace(key, lanelet_sequence_backward);
   return lanelet_sequence_backward;
 }
 
@@ -352,7 +448,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequence(
   lanelet::ConstLanelets lanelet_sequence;
   lanelet::ConstLanelets lanelet_sequence_backward;
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!route_lanelet_ids_.count(lanelet.id())) {
     return lanelet_sequence;
   }
 
@@ -381,35 +477,22 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequence(
 bool RouteHandler::getFollowingShoulderLanelet(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * following_lanelet) const
 {
-  Pose back_pose;
-  back_pose.position.x = lanelet.centerline2d().back().x();
-  back_pose.position.y = lanelet.centerline2d().back().y();
-  back_pose.position.z = 0;
-
-  lanelet::ArcCoordinates arc_coordinates;
-  const auto & centerline_2d = to2D(lanelet.centerline());
-
-  for (const auto & shoulder_lanelet : shoulder_lanelets_) {
-    Pose front_pose;
-    front_pose.position.x = shoulder_lanelet.centerline2d().front().x();
-    front_pose.position.y = shoulder_lanelet.centerline2d().front().y();
-    front_pose.position.z = 0;
-    if (
-      std::hypot(
-        front_pose.position.x - back_pose.position.x,
-        front_pose.position.y - back_pose.position.y) < 5) {
-      *following_lanelet = shoulder_lanelet;
-      return true;
-    }
+  if (!shoulder_lanelet_ids_.count(lanelet.id())) {
+    return findFollowingShoulderLanelet(shoulder_lanelets_, lanelet, following_lanelet);
   }
-  return false;
+  const auto it = following_shoulder_lanelets_.find(lanelet.id());
+  if (it == following_shoulder_lanelets_.end()) {
+    return false;
+  }
+  *following_lanelet = it->second;
+  return true;
 }
 
 lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequenceAfter(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(shoulder_lanelets_, lanelet)) {
+  if (!shoulder_lanelet_ids_.count(lanelet.id())) {
     return lanelet_sequence_forward;
   }
 
@@ -431,35 +514,22 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequenceAfter(
 bool RouteHandler::getPreviousShoulderLanelet(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * prev_lanelet) const
 {
-  Pose front_pose;
-  front_pose.position.x = lanelet.centerline2d().front().x();
-  front_pose.position.y = lanelet.centerline2d().front().y();
-  front_pose.position.z = 0;
-
-  lanelet::ArcCoordinates arc_coordinates;
-  const auto & centerline_2d = to2D(lanelet.centerline());
-
-  for (const auto & shoulder_lanelet : shoulder_lanelets_) {
-    Pose back_pose;
-    back_pose.position.x = shoulder_lanelet.centerline2d().back().x();
-    back_pose.position.y = shoulder_lanelet.centerline2d().back().y();
-    back_pose.position.z = 0;
-    if (
-      std::hypot(
-        front_pose.position.x - back_pose.position.x,
-        front_pose.position.y - back_pose.position.y) < 5) {
-      *prev_lanelet = shoulder_lanelet;
-      return true;
-    }
+  if (!shoulder_lanelet_ids_.count(lanelet.id())) {
+    return findPreviousShoulderLanelet(shoulder_lanelets_, lanelet, prev_lanelet);
   }
-  return false;
+  const auto it = previous_shoulder_lanelets_.find(lanelet.id());
+  if (it == previous_shoulder_lanelets_.end()) {
+    return false;
+  }
+  *prev_lanelet = it->second;
+  return true;
 }
 
 lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequenceUpTo(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
   lanelet::ConstLanelets lanelet_sequence_backward;
-  if (!exists(shoulder_lanelets_, lanelet)) {
+  if (!shoulder_lanelet_ids_.count(lanelet.id())) {
     return lanelet_sequence_backward;
   }
 
@@ -486,7 +556,7 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequence(
   lanelet::ConstLanelets lanelet_sequence;
   lanelet::ConstLanelets lanelet_sequence_backward;
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(shoulder_lanelets_, lanelet)) {
+  if (!shoulder_lanelet_ids_.count(lanelet.id())) {
     return lanelet_sequence;
   }
 
@@ -516,18 +586,48 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequence(
 bool RouteHandler::getClosestLaneletWithinRoute(
   const Pose & search_pose, lanelet::ConstLanelet * closest_lanelet) const
 {
-  return lanelet::utils::query::getClosestLanelet(route_lanelets_, search_pose, closest_lanelet);
+  {
+    std::lock_guard<std::mutex> lock(query_cache_mutex_);
+    for (const auto & closest_lanelet_cache : query_cache_.closest_lanelets) {
+      if (closest_lanelet_cache.first == search_pose) {
+        if (!closest_lanelet_cache.second) {
+          return false;
+        }
+        *closest_lanelet = *closest_lanelet_cache.second;
+        return true;
+      }
+    }
+  }
+
+  lanelet::ConstLanelet lanelet;
+  boost::optional<lanelet::ConstLanelet> result;
+  if (lanelet::utils::query::getClosestLanelet(route_lanelets_, search_pose, &lanelet)) {
+    result = lanelet;
+    *closest_lanelet = lanelet;
+  }
+
+  std::lock_guard<std::mutex> lock(query_cache_mutex_);
+  query_cache_.closest_lanelets.emplace_back(search_pose, result);
+  if (query_cache_.closest_lanelets.size() > closest_lanelet_cache_size) {
+    query_cache_.closest_lanelets.pop_front();
+  }
+  return static_cast<bool>(result);
 }
 
 bool RouteHandler::getNextLaneletWithinRoute(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * next_lanelet) const
 {
-  if (exists(goal_lanelets_, lanelet)) {
+  const auto it = next_route_lanelets_.find(lanelet.id());
+  if (it != next_route_lanelets_.end()) {
+    *next_lanelet = it->second;
+    return true;
+  }
+  if (route_lanelet_ids_.count(lanelet.id()) || exists(goal_lanelets_, lanelet)) {
     return false;
   }
   lanelet::ConstLanelets following_lanelets = routing_graph_ptr_->following(lanelet);
   for (const auto & llt : following_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (route_lanelet_ids_.count(llt.id())) {
       *next_lanelet = llt;
       return true;
     }
@@ -538,12 +638,17 @@ bool RouteHandler::getNextLaneletWithinRoute(
 bool RouteHandler::getPreviousLaneletWithinRoute(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * prev_lanelet) const
 {
-  if (exists(start_lanelets_, lanelet)) {
+  const auto it = previous_route_lanelets_.find(lanelet.id());
+  if (it != previous_route_lanelets_.end()) {
+    *prev_lanelet = it->second;
+    return true;
+  }
+  if (route_lanelet_ids_.count(lanelet.id()) || exists(start_lanelets_, lanelet)) {
     return false;
   }
   lanelet::ConstLanelets previous_lanelets = routing_graph_ptr_->previous(lanelet);
   for (const auto & llt : previous_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (route_lanelet_ids_.count(llt.id())) {
       *prev_lanelet = llt;
       return true;
     }
@@ -557,7 +662,7 @@ bool RouteHandler::getRightLaneletWithinRoute(
   auto opt_right_lanelet = routing_graph_ptr_->right(lanelet);
   if (!!opt_right_lanelet) {
     *right_lanelet = opt_right_lanelet.get();
-    return exists(route_lanelets_, *right_lanelet);
+    return route_lanelet_ids_.count(right_lanelet->id()) > 0;
   } else {
     return false;
   }
@@ -568,7 +673,7 @@ bool RouteHandler::getLeftLaneletWithinRoute(
   auto opt_left_lanelet = routing_graph_ptr_->left(lanelet);
   if (!!opt_left_lanelet) {
     *left_lanelet = opt_left_lanelet.get();
-    return exists(route_lanelets_, *left_lanelet);
+    return route_lanelet_ids_.count(left_lanelet->id()) > 0;
   } else {
     return false;
   }
@@ -141,6 +141,9 @@ AvoidancePlanningData AvoidanceModule::calcAvoidancePlanningData(DebugData & deb
   data.arclength_from_ego = util::calcPathArcLengthArray(
     data.reference_path, 0, data.reference_path.points.size(),
     calcSignedArcLength(data.reference_path.points, getEgoPosition(), 0));
+  data.arclength_from_front = util::calcPathArcLengthArray(data.reference_path);
+  data.arclength_from_front_to_ego_closest =
+    calcSignedArcLength(data.reference_path.points, 0, data.ego_closest_path_index);
 
   // lanelet info
   data.current_lanelets = calcLaneAroundPose(
@@ -183,8 +186,33 @@ ObjectDataArray AvoidanceModule::calcAvoidanceTargetObjects(
       ? calcSignedArcLength(path_points, ego_pos, rh->getGoalPose().position)
       : std::numeric_limits<double>::max();
 
+  // The geometry of the object relative to the path is kept while neither the object nor the
+  // path around it moves, so that the footprint is projected only for the new or moved objects.
+  const auto isGeometryCacheValid = [](
+                                      const ObjectGeometryCache & cache, const DynamicObject & obj,
+                                      const Pose & path_pose) {
+    // TODO(Horibe) parametrize
+    constexpr double POS_THR = 0.1;
+    constexpr double YAW_THR = 0.05;
+    constexpr double SHAPE_THR = 0.1;
+    const auto & pose = obj.state.pose_covariance.pose;
+    const auto & dims = obj.shape.dimensions;
+    const auto yawDiff = [](const Pose & a, const Pose & b) {
+      return std::abs(
+        autoware_utils::normalizeRadian(tf2::getYaw(a.orientation) - tf2::getYaw(b.orientation)));
+    };
+    return cache.type == obj.semantic.type &&
+           calcDistance2d(cache.pose, pose) < POS_THR && yawDiff(cache.pose, pose) < YAW_THR &&
+           std::abs(cache.dimensions.x - dims.x) < SHAPE_THR &&
+           std::abs(cache.dimensions.y - dims.y) < SHAPE_THR &&
+           // the path points are resampled every time, so only the lateral offset is compared
+           std::abs(calcLateralDeviation(path_pose, cache.closest_path_pose.position)) < POS_THR &&
+           yawDiff(cache.closest_path_pose, path_pose) < YAW_THR;
+  };
+
   // for filtered objects
   ObjectDataArray target_objects;
+  std::map<std::array<uint8_t, 16>, ObjectGeometryCache> object_geometry_cache;
   for (const auto & i : lane_filtered_objects_index) {
     const auto & object = objects_candidate.objects.at(i);
     const auto & object_pos = object.state.pose_covariance.pose.position;
@@ -194,11 +222,42 @@ ObjectDataArray AvoidanceModule::calcAvoidanceTargetObjects(
       continue;
     }
 
+    const auto object_closest_index = findNearestIndex(path_points, object_pos);
+    const auto & object_closest_pose = path_points.at(object_closest_index).point.pose;
+
+    const auto cache_itr = object_geometry_cache_.find(object.id.uuid);
+    if (
+      cache_itr != object_geometry_cache_.end() &&
+      isGeometryCacheValid(cache_itr->second, object, object_closest_pose)) {
+      object_geometry_cache.emplace(cache_itr->first, cache_itr->second);
+    } else {
+      ObjectGeometryCache geometry;
+      geometry.pose = object.state.pose_covariance.pose;
+      geometry.dimensions = object.shape.dimensions;
+      geometry.type = object.semantic.type;
+      geometry.closest_path_pose = object_closest_pose;
+
+      // longitudinal distance from the CoM to the closest footprint point.
+      geometry.footprint_longitudinal_offset =
+        calcDistanceToClosestFootprintPoint(reference_path, object, object_pos);
+
+      // Calc lateral deviation from path to target object.
+      geometry.lateral = calcLateralDeviation(object_closest_pose, object_pos);
+
+      // Find the footprint point closest to the path.
+      geometry.overhang_dist = calcOverhangDistance(
+        ObjectData{object, geometry.lateral, 0.0, 0.0}, object_closest_pose);
+
+      object_geometry_cache.emplace(object.id.uuid, geometry);
+    }
+    const auto & geometry = object_geometry_cache.at(object.id.uuid);
+
     ObjectData object_data;
     object_data.object = object;
 
     // calc longitudinal distance from ego to closest target object footprint point.
-    object_data.longitudinal = calcDistanceToClosestFootprintPoint(reference_path, object, ego_pos);
+    object_data.longitudinal = calcSignedArcLength(path_points, ego_pos, object_pos) +
+                               geometry.footprint_longitudinal_offset;
 
     // object is behind ego or too far.
     if (object_data.longitudinal < -parameters_.object_check_backward_distance) {
@@ -217,9 +276,7 @@ ObjectDataArray AvoidanceModule::calcAvoidanceTargetObjects(
     }
 
     // Calc lateral deviation from path to target object.
-    const auto object_closest_index = findNearestIndex(path_points, object_pos);
-    const auto object_closest_pose = path_points.at(object_closest_index).point.pose;
-    object_data.lateral = calcLateralDeviation(object_closest_pose, object_pos);
+    object_data.lateral = geometry.lateral;
 
     // Object is on center line -> ignore.
     if (std::abs(object_data.lateral) < parameters_.threshold_distance_object_is_on_center) {
@@ -228,7 +285,7 @@ ObjectDataArray AvoidanceModule::calcAvoidanceTargetObjects(
     }
 
     // Find the footprint point closest to the path, set to object_data.overhang_distance.
-    object_data.overhang_dist = calcOverhangDistance(object_data, object_closest_pose);
+    object_data.overhang_dist = geometry.overhang_dist;
 
     DEBUG_PRINT(
       "set object_data: longitudinal = %f, lateral = %f, largest_overhang = %f",
@@ -238,6 +295,8 @@ ObjectDataArray AvoidanceModule::calcAvoidanceTargetObjects(
     target_objects.push_back(object_data);
   }
 
+  object_geometry_cache_.swap(object_geometry_cache);
+
   // debug
   {
     debug.current_lanelets = std::make_shared<lanelet::ConstLanelets>(current_lanes);
@@ -537,9 +596,8 @@ void AvoidanceModule::fillAdditionalInfoFromPoint(AvoidPointArray & shift_points
   }
 
   const auto & path = avoidance_data_.reference_path;
-  const auto arclength = util::calcPathArcLengthArray(path);
-  const auto dist_path_front_to_ego =
-    calcSignedArcLength(path.points, 0, avoidance_data_.ego_closest_path_index);
+  const auto & arclength = avoidance_data_.arclength_from_front;
+  const auto dist_path_front_to_ego = avoidance_data_.arclength_from_front_to_ego_closest;
 
   // calc longitudinal
   for (auto & sp : shift_points) {
@@ -553,9 +611,8 @@ void AvoidanceModule::fillAdditionalInfoFromPoint(AvoidPointArray & shift_points
 void AvoidanceModule::fillAdditionalInfoFromLongitudinal(AvoidPointArray & shift_points) const
 {
   const auto & path = avoidance_data_.reference_path;
-  const auto arclength = util::calcPathArcLengthArray(path);
-  const auto path_front_to_ego =
-    calcSignedArcLength(path.points, 0, avoidance_data_.ego_closest_path_index);
+  const auto & arclength = avoidance_data_.arclength_from_front;
+  const auto path_front_to_ego = avoidance_data_.arclength_from_front_to_ego_closest;
 
   for (auto & sp : shift_points) {
     sp.start_idx = findPathIndexFromArclength(arclength, sp.start_longitudinal + path_front_to_ego);
@@ -618,22 +675,35 @@ void AvoidanceModule::generateTotalShiftLine(
 
   auto & sl = shift_line_data;
 
-  sl.shift_line = std::vector<double>(N, 0.0);
-  sl.shift_line_grad = std::vector<double>(N, 0.0);
+  // assign() keeps the capacity of the buffers reused over the planning cycles.
+  sl.shift_line.assign(N, 0.0);
+  sl.shift_line_grad.assign(N, 0.0);
 
-  sl.pos_shift_line = std::vector<double>(N, 0.0);
-  sl.neg_shift_line = std::vector<double>(N, 0.0);
+  sl.pos_shift_line.assign(N, 0.0);
+  sl.neg_shift_line.assign(N, 0.0);
 
-  sl.pos_shift_line_grad = std::vector<double>(N, 0.0);
-  sl.neg_shift_line_grad = std::vector<double>(N, 0.0);
+  sl.pos_shift_line_grad.assign(N, 0.0);
+  sl.neg_shift_line_grad.assign(N, 0.0);
 
   // debug
-  sl.shift_line_history = std::vector<std::vector<double>>(avoid_points.size(), sl.shift_line);
+  sl.shift_line_history.clear();
+  if (parameters_.print_debug_info) {
+    sl.shift_line_history.resize(avoid_points.size(), sl.shift_line);
+  }
 
   // take minmax for same directional shift length
   for (size_t j = 0; j < avoid_points.size(); ++j) {
     const auto & ap = avoid_points.at(j);
-    for (size_t i = 0; i < N; ++i) {
+
+    // the interpolated shift is zero out of [start_longitudinal, end_longitudinal)
+    const auto begin_idx = static_cast<size_t>(std::distance(
+      arclengths.begin(),
+      std::lower_bound(arclengths.begin(), arclengths.end(), ap.start_longitudinal)));
+    const auto end_idx = static_cast<size_t>(std::distance(
+      arclengths.begin(),
+      std::lower_bound(arclengths.begin(), arclengths.end(), ap.end_longitudinal)));
+
+    for (size_t i = begin_idx; i < end_idx; ++i) {
       // calc current interpolated shift
       const auto i_shift = lerpShiftLengthOnArc(arclengths.at(i), ap);
 
@@ -650,7 +720,9 @@ void AvoidanceModule::generateTotalShiftLine(
       }
 
       // store for debug print
-      sl.shift_line_history.at(j).at(i) = i_shift;
+      if (parameters_.print_debug_info) {
+        sl.shift_line_history.at(j).at(i) = i_shift;
+      }
     }
   }
 
@@ -669,15 +741,19 @@ void AvoidanceModule::generateTotalShiftLine(
 
   // If the shift point does not have an associated object,
   // use previous value.
-  for (size_t i = 1; i < N; ++i) {
-    bool has_object = false;
-    for (const auto & ap : avoid_points) {
-      if (ap.start_idx < i && i < ap.end_idx) {
-        has_object = true;
-        break;
-      }
+  // The number of shift points strictly between their start and end index is counted on each
+  // path point by the sum of +1 at start_idx + 1 and -1 at end_idx.
+  std::vector<int> covered_count_diff(N + 1, 0);
+  for (const auto & ap : avoid_points) {
+    if (ap.start_idx + 1 < ap.end_idx) {
+      ++covered_count_diff.at(ap.start_idx + 1);
+      --covered_count_diff.at(std::min(ap.end_idx, N));
     }
-    if (!has_object) {
+  }
+  int covered_count = covered_count_diff.at(0);
+  for (size_t i = 1; i < N; ++i) {
+    covered_count += covered_count_diff.at(i);
+    if (covered_count == 0) {
       sl.shift_line.at(i) = sl.shift_line.at(i - 1);
     }
   }
@@ -716,8 +792,8 @@ AvoidPointArray AvoidanceModule::extractShiftPointsFromLine(ShiftLineData & shif
 
   // calculate forward and backward gradient of the shift length.
   // This will be used for grad-change-point check.
-  sl.forward_grad = std::vector<double>(N, 0.0);
-  sl.backward_grad = std::vector<double>(N, 0.0);
+  sl.forward_grad.assign(N, 0.0);
+  sl.backward_grad.assign(N, 0.0);
   for (size_t i = 0; i < N - 1; ++i) {
     sl.forward_grad.at(i) = getFwdGrad(i);
     sl.backward_grad.at(i) = getBwdGrad(i);
@@ -767,7 +843,7 @@ AvoidPointArray AvoidanceModule::mergeShiftPoints(
   const AvoidPointArray & raw_shift_points, DebugData & debug) const
 {
   // Generate shift line by merging raw_shift_points.
-  ShiftLineData shift_line_data;
+  auto & shift_line_data = shift_line_data_;
   generateTotalShiftLine(raw_shift_points, shift_line_data);
 
   // Re-generate shift points by detecting gradient-change point of the shift line.
@@ -789,7 +865,7 @@ AvoidPointArray AvoidanceModule::mergeShiftPoints(
   }
 
   // debug print
-  {
+  if (parameters_.print_debug_info) {
     const auto & arc = avoidance_data_.arclength_from_ego;
     const auto & closest = avoidance_data_.ego_closest_path_index;
     const auto & sl = shift_line_data.shift_line;
@@ -1884,7 +1960,7 @@ BehaviorModuleOutput AvoidanceModule::planWaitingApproval()
 {
   // we can execute the plan() since it handles the approval appropriately.
   BehaviorModuleOutput out = plan();
-  out.path_candidate = std::make_shared<PathWithLaneId>(planCandidate());
+  out.path_candidate = getCandidate();
   return out;
 }
 
@@ -2273,6 +2349,8 @@ void AvoidanceModule::initVariables()
   registered_raw_shift_points_ = {};
   current_raw_shift_points_ = {};
   original_unique_id = 0;
+
+  object_geometry_cache_.clear();
 }
 
 void AvoidanceModule::clipPathLength(PathWithLaneId & path) const
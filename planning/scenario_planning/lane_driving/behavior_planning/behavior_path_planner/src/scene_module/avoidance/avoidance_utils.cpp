@@ -81,12 +81,12 @@ size_t findPathIndexFromArclength(
     return 0;
   }
 
-  for (size_t i = 0; i < path_arclength_arr.size(); ++i) {
-    if (path_arclength_arr.at(i) > target_arc) {
-      return i;
-    }
-  }
-  return path_arclength_arr.size() - 1;
+  // the arclength is monotonically increasing: the first index beyond target_arc.
+  const auto itr =
+    std::upper_bound(path_arclength_arr.begin(), path_arclength_arr.end(), target_arc);
+  return std::min(
+    static_cast<size_t>(std::distance(path_arclength_arr.begin(), itr)),
+    path_arclength_arr.size() - 1);
 }
 
 std::vector<size_t> concatParentIds(
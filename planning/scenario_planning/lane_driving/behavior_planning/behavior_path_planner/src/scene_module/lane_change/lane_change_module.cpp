@@ -186,7 +186,7 @@ BehaviorModuleOutput LaneChangeModule::planWaitingApproval()
 {
   BehaviorModuleOutput out;
   out.path = std::make_shared<PathWithLaneId>(getReferencePath());
-  out.path_candidate = std::make_shared<PathWithLaneId>(planCandidate());
+  out.path_candidate = getCandidate();
   return out;
 }
 
@@ -351,7 +351,7 @@ std::pair<bool, bool> LaneChangeModule::getSafePath(
 
     // select safe path
     bool found_safe_path = lane_change_utils::selectSafePath(
-      valid_paths, current_lanes, check_lanes, planner_data_->dynamic_object, current_pose,
+      valid_paths, current_lanes, check_lanes, planner_data_->object_cache, current_pose,
       current_twist, common_parameters.vehicle_width, parameters_, &safe_path);
     return std::make_pair(true, found_safe_path);
   }
@@ -430,7 +430,7 @@ bool LaneChangeModule::isAbortConditionSatisfied() const
   const auto & route_handler = planner_data_->route_handler;
   const auto current_pose = planner_data_->self_pose->pose;
   const auto current_twist = planner_data_->self_velocity->twist;
-  const auto objects = planner_data_->dynamic_object;
+  const auto objects = planner_data_->object_cache;
   const auto common_parameters = planner_data_->parameters;
 
   const auto current_lanes = status_.current_lanes;
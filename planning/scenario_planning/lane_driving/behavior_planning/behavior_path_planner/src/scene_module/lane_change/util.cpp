@@ -20,13 +20,17 @@
 #include <lanelet2_extension/utility/utilities.hpp>
 #include <rclcpp/rclcpp.hpp>
 
+#include <boost/optional.hpp>
+
 #include <lanelet2_core/LaneletMap.h>
 #include <tf2/utils.h>
 #include <tf2_ros/transform_listener.h>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -34,8 +38,236 @@ namespace behavior_path_planner
 {
 namespace lane_change_utils
 {
+using autoware_perception_msgs::msg::DynamicObject;
 using autoware_perception_msgs::msg::PredictedPath;
 using autoware_planning_msgs::msg::PathPoint;
+using autoware_utils::Point2d;
+using autoware_utils::Polygon2d;
+using geometry_msgs::msg::Point;
+
+namespace
+{
+// an object with its poses at the time steps of the safety check. they do not depend on the lane
+// change path, so they are computed once for all the candidate paths.
+struct ObjectToCheck
+{
+  size_t object_idx;
+  // positions on each predicted path, none where the predicted path does not cover the time step
+  std::vector<std::vector<boost::optional<Point>>> predicted_positions;
+  // checked instead of the predicted paths for the target lane objects out of the target lanes
+  boost::optional<Polygon2d> polygon;
+  double threshold;
+};
+
+struct SafetyCheckObjects
+{
+  // time steps of the check from the start of the ego predicted path
+  std::vector<rclcpp::Duration> check_times;
+  // the current lane objects are filtered by each path when it is checked
+  std::vector<ObjectToCheck> current_lane_objects;
+  std::vector<ObjectToCheck> target_lane_objects;
+};
+
+std::vector<size_t> getPredictedPathsToCheck(
+  const PredictedObjectCache & objects, const size_t object_idx,
+  const LaneChangeParameters & ros_parameters)
+{
+  const auto & predicted_paths = objects.getObjects().objects.at(object_idx).state.predicted_paths;
+  if (ros_parameters.use_all_predicted_path || predicted_paths.empty()) {
+    std::vector<size_t> path_indices(predicted_paths.size());
+    std::iota(path_indices.begin(), path_indices.end(), 0);
+    return path_indices;
+  }
+  return {*objects.getMaxConfidencePathIndex(object_idx)};
+}
+
+std::vector<std::vector<boost::optional<Point>>> samplePredictedPaths(
+  const PredictedObjectCache & objects, const size_t object_idx,
+  const std::vector<rclcpp::Duration> & check_times, const LaneChangeParameters & ros_parameters)
+{
+  std::vector<std::vector<boost::optional<Point>>> positions;
+  for (const auto & path_idx : getPredictedPathsToCheck(objects, object_idx, ros_parameters)) {
+    positions.push_back(objects.getPredictedPositions(object_idx, path_idx, check_times));
+  }
+  return positions;
+}
+
+SafetyCheckObjects createSafetyCheckObjects(
+  const lanelet::ConstLanelets & current_lanes, const lanelet::ConstLanelets & target_lanes,
+  const PredictedObjectCache & object_cache, const Pose & current_pose,
+  const Twist & current_twist, const LaneChangeParameters & ros_parameters, const bool use_buffer)
+{
+  SafetyCheckObjects objects;
+
+  const auto arc = lanelet::utils::getArcCoordinates(current_lanes, current_pose);
+  constexpr double check_distance = 100.0;
+
+  // parameters
+  const double time_resolution = ros_parameters.prediction_time_resolution;
+  const double min_thresh = ros_parameters.min_stop_distance;
+  const double stop_time = ros_parameters.stop_time;
+  const double buffer = use_buffer ? ros_parameters.hysteresis_buffer_distance : 0.0;
+  const double ego_speed = util::l2Norm(current_twist.linear);
+
+  double check_start_time = 0.0;
+  const double check_end_time =
+    ros_parameters.lane_change_prepare_duration + ros_parameters.lane_changing_duration;
+  if (!ros_parameters.enable_collision_check_at_prepare_phase) {
+    check_start_time = ros_parameters.lane_change_prepare_duration;
+  }
+  const auto t_delta = rclcpp::Duration::from_seconds(time_resolution);
+  const auto t_end = rclcpp::Duration::from_seconds(check_end_time);
+  for (auto t = rclcpp::Duration::from_seconds(check_start_time); t < t_end; t = t + t_delta) {
+    objects.check_times.push_back(t);
+  }
+  const auto & dynamic_objects = object_cache.getObjects();
+
+  const auto calc_threshold = [&](const DynamicObject & obj) {
+    double thresh;
+    if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
+      thresh = ego_speed * stop_time;
+    } else {
+      thresh = util::l2Norm(obj.state.twist_covariance.twist.linear) * stop_time;
+    }
+    return std::max(thresh, min_thresh) + buffer;
+  };
+
+  // find objects in current lane
+  const auto current_lane_object_indices = util::filterObjectsByLanelets(
+    object_cache, current_lanes, arc.length, arc.length + check_distance);
+  for (const auto & i : current_lane_object_indices) {
+    const auto & obj = dynamic_objects.objects.at(i);
+    ObjectToCheck object;
+    object.object_idx = i;
+    object.predicted_positions =
+      samplePredictedPaths(object_cache, i, objects.check_times, ros_parameters);
+    object.threshold = calc_threshold(obj);
+    objects.current_lane_objects.push_back(object);
+  }
+
+  // find obstacle in lane change target lanes
+  // retrieve lanes that are merging target lanes as well
+  const auto target_lane_object_indices = util::filterObjectsByLanelets(object_cache, target_lanes);
+  for (const auto & i : target_lane_object_indices) {
+    const auto & obj = dynamic_objects.objects.at(i);
+    ObjectToCheck object;
+    object.object_idx = i;
+
+    bool is_object_in_target = false;
+    if (ros_parameters.use_predicted_path_outside_lanelet) {
+      is_object_in_target = true;
+    } else {
+      for (const auto & llt : target_lanes) {
+        if (lanelet::utils::isInLanelet(obj.state.pose_covariance.pose, llt)) {
+          is_object_in_target = true;
+        }
+      }
+    }
+
+    if (is_object_in_target) {
+      object.predicted_positions =
+        samplePredictedPaths(object_cache, i, objects.check_times, ros_parameters);
+      object.threshold = calc_threshold(obj);
+    } else {
+      object.polygon = object_cache.getPolygon(i);
+      double thresh = min_thresh;
+      if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
+        thresh = std::max(thresh, ego_speed * stop_time);
+      }
+      object.threshold = thresh + buffer;
+    }
+    objects.target_lane_objects.push_back(object);
+  }
+
+  return objects;
+}
+
+// true if the ego comes closer to the object than its threshold at one of the time steps
+bool isCloseToObject(
+  const ObjectToCheck & object, const std::vector<boost::optional<Point>> & ego_positions)
+{
+  for (const auto & object_positions : object.predicted_positions) {
+    for (size_t t = 0; t < ego_positions.size(); ++t) {
+      if (!object_positions.at(t) || !ego_positions.at(t)) {
+        continue;
+      }
+      if (autoware_utils::calcDistance3d(*object_positions.at(t), *ego_positions.at(t)) <
+          object.threshold) {
+        return true;
+      }
+    }
+  }
+  if (object.polygon) {
+    for (const auto & ego_position : ego_positions) {
+      if (!ego_position) {
+        continue;
+      }
+      const Point2d ego_point{ego_position->x, ego_position->y};
+      if (boost::geometry::distance(*object.polygon, ego_point) < object.threshold) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool isLaneChangePathSafe(
+  const PathWithLaneId & path, const lanelet::ConstLanelets & current_lanes,
+  const lanelet::ConstLanelets & target_lanes,
+  const std::shared_ptr<const PredictedObjectCache> & object_cache,
+  const boost::optional<SafetyCheckObjects> & objects, const Pose & current_pose,
+  const Twist & current_twist, const double vehicle_width,
+  const LaneChangeParameters & ros_parameters, const bool use_buffer, const double acceleration)
+{
+  if (path.points.empty()) {
+    return false;
+  }
+  if (target_lanes.empty() || current_lanes.empty()) {
+    return false;
+  }
+  if (object_cache == nullptr || !objects) {
+    return true;
+  }
+
+  const double time_resolution = ros_parameters.prediction_time_resolution;
+  const double lateral_buffer = use_buffer ? 0.5 : 0.0;
+  const double check_end_time =
+    ros_parameters.lane_change_prepare_duration + ros_parameters.lane_changing_duration;
+
+  // the ego positions at the time steps of the check
+  const auto vehicle_predicted_path = util::convertToPredictedPath(
+    path, current_twist, current_pose, check_end_time, time_resolution, acceleration);
+  const auto ego_positions = util::samplePredictedPath(
+    vehicle_predicted_path, rclcpp::Time(vehicle_predicted_path.path.front().header.stamp),
+    objects->check_times);
+
+  // Collision check for objects in current lane
+  std::vector<size_t> current_lane_object_indices_lanelet;
+  for (const auto & object : objects->current_lane_objects) {
+    current_lane_object_indices_lanelet.push_back(object.object_idx);
+  }
+  const auto current_lane_object_indices = util::filterObjectsByPath(
+    *object_cache, current_lane_object_indices_lanelet, path, vehicle_width / 2 + lateral_buffer);
+  for (const auto & object : objects->current_lane_objects) {
+    const bool is_on_path =
+      std::find(
+        current_lane_object_indices.begin(), current_lane_object_indices.end(),
+        object.object_idx) != current_lane_object_indices.end();
+    if (is_on_path && isCloseToObject(object, ego_positions)) {
+      return false;
+    }
+  }
+
+  // Collision check for objects in lane change target lane
+  for (const auto & object : objects->target_lane_objects) {
+    if (isCloseToObject(object, ego_positions)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+}  // namespace
 
 PathWithLaneId combineReferencePath(const PathWithLaneId path1, const PathWithLaneId path2)
 {
@@ -101,8 +333,20 @@ std::vector<LaneChangePath> getLaneChangePaths(
   const double target_distance =
     util::getArcLengthToTargetLanelet(original_lanelets, target_lanelets.front(), pose);
 
+  std::vector<double> accelerations;
   for (double acceleration = 0.0; acceleration >= -maximum_deceleration;
        acceleration -= acceleration_resolution) {
+    accelerations.push_back(acceleration);
+  }
+
+  util::prepareLaneletsForParallelUse(original_lanelets);
+  util::prepareLaneletsForParallelUse(target_lanelets);
+
+  // the candidates are independent, each one fills its own slot to keep their order
+  std::vector<boost::optional<LaneChangePath>> candidates(accelerations.size());
+#pragma omp parallel for schedule(dynamic)
+  for (size_t candidate_idx = 0; candidate_idx < accelerations.size(); ++candidate_idx) {
+    const double acceleration = accelerations.at(candidate_idx);
     PathWithLaneId reference_path{};
     const double v1 = v0 + acceleration * lane_change_prepare_duration;
     const double v2 = v1 + acceleration * lane_changing_duration;
@@ -246,9 +490,14 @@ std::vector<LaneChangePath> getLaneChangePaths(
     for (auto & pt : candidate_path.path.points) {
       pt.point.type = PathPoint::FIXED;
     }
-    candidate_paths.push_back(candidate_path);
+    candidates.at(candidate_idx) = candidate_path;
   }
 
+  for (const auto & candidate : candidates) {
+    if (candidate) {
+      candidate_paths.push_back(*candidate);
+    }
+  }
   return candidate_paths;
 }
 
@@ -274,25 +523,47 @@ std::vector<LaneChangePath> selectValidPaths(
 bool selectSafePath(
   const std::vector<LaneChangePath> & paths, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes,
-  const DynamicObjectArray::ConstSharedPtr & dynamic_objects, const Pose & current_pose,
+  const std::shared_ptr<const PredictedObjectCache> & object_cache, const Pose & current_pose,
   const Twist & current_twist, const double vehicle_width,
   const LaneChangeParameters & ros_parameters, LaneChangePath * selected_path)
 {
-  for (const auto & path : paths) {
+  if (paths.empty()) {
+    return false;
+  }
+
+  constexpr bool use_buffer = true;
+  boost::optional<SafetyCheckObjects> objects;
+  if (object_cache && !current_lanes.empty() && !target_lanes.empty()) {
+    objects = createSafetyCheckObjects(
+      current_lanes, target_lanes, *object_cache, current_pose, current_twist, ros_parameters,
+      use_buffer);
+  }
+
+  // the paths are in order of preference, the first safe one is selected. the paths after a
+  // safe one are not checked any more.
+  std::atomic<size_t> safe_path_idx{paths.size()};
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < paths.size(); ++i) {
+    if (i > safe_path_idx.load()) {
+      continue;
+    }
+    const auto & path = paths.at(i);
     if (isLaneChangePathSafe(
-          path.path, current_lanes, target_lanes, dynamic_objects, current_pose, current_twist,
-          vehicle_width, ros_parameters, true, path.acceleration)) {
-      *selected_path = path;
-      return true;
+          path.path, current_lanes, target_lanes, object_cache, objects, current_pose,
+          current_twist, vehicle_width, ros_parameters, use_buffer, path.acceleration)) {
+      size_t idx = safe_path_idx.load();
+      while (i < idx && !safe_path_idx.compare_exchange_weak(idx, i)) {
+      }
     }
   }
 
-  // set first path for force lane change if no valid path found
-  if (!paths.empty()) {
-    *selected_path = paths.front();
-    return false;
+  if (safe_path_idx < paths.size()) {
+    *selected_path = paths.at(safe_path_idx);
+    return true;
   }
 
+  // set first path for force lane change if no valid path found
+  *selected_path = paths.front();
   return false;
 }
 
@@ -332,153 +603,19 @@ bool hasEnoughDistance(
 bool isLaneChangePathSafe(
   const PathWithLaneId & path, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes,
-  const DynamicObjectArray::ConstSharedPtr & dynamic_objects, const Pose & current_pose,
+  const std::shared_ptr<const PredictedObjectCache> & object_cache, const Pose & current_pose,
   const Twist & current_twist, const double vehicle_width,
   const LaneChangeParameters & ros_parameters, const bool use_buffer, const double acceleration)
 {
-  if (path.points.empty()) {
-    return false;
-  }
-  if (target_lanes.empty() || current_lanes.empty()) {
-    return false;
-  }
-  if (dynamic_objects == nullptr) {
-    return true;
-  }
-  const auto arc = lanelet::utils::getArcCoordinates(current_lanes, current_pose);
-  constexpr double check_distance = 100.0;
-
-  // parameters
-  const double time_resolution = ros_parameters.prediction_time_resolution;
-  const double min_thresh = ros_parameters.min_stop_distance;
-  const double stop_time = ros_parameters.stop_time;
-
-  double buffer;
-  double lateral_buffer;
-  if (use_buffer) {
-    buffer = ros_parameters.hysteresis_buffer_distance;
-    lateral_buffer = 0.5;
-  } else {
-    buffer = 0.0;
-    lateral_buffer = 0.0;
-  }
-  double current_lane_check_start_time = 0.0;
-  const double current_lane_check_end_time =
-    ros_parameters.lane_change_prepare_duration + ros_parameters.lane_changing_duration;
-  double target_lane_check_start_time = 0.0;
-  const double target_lane_check_end_time =
-    ros_parameters.lane_change_prepare_duration + ros_parameters.lane_changing_duration;
-  if (!ros_parameters.enable_collision_check_at_prepare_phase) {
-    current_lane_check_start_time = ros_parameters.lane_change_prepare_duration;
-    target_lane_check_start_time = ros_parameters.lane_change_prepare_duration;
+  boost::optional<SafetyCheckObjects> objects;
+  if (object_cache && !current_lanes.empty() && !target_lanes.empty()) {
+    objects = createSafetyCheckObjects(
+      current_lanes, target_lanes, *object_cache, current_pose, current_twist, ros_parameters,
+      use_buffer);
   }
-
-  // find obstacle in lane change target lanes
-  // retrieve lanes that are merging target lanes as well
-  const auto target_lane_object_indices =
-    util::filterObjectsByLanelets(*dynamic_objects, target_lanes);
-
-  // find objects in current lane
-  const auto current_lane_object_indices_lanelet = util::filterObjectsByLanelets(
-    *dynamic_objects, current_lanes, arc.length, arc.length + check_distance);
-  const auto current_lane_object_indices = util::filterObjectsByPath(
-    *dynamic_objects, current_lane_object_indices_lanelet, path,
-    vehicle_width / 2 + lateral_buffer);
-
-  const auto & vehicle_predicted_path = util::convertToPredictedPath(
-    path, current_twist, current_pose, target_lane_check_end_time, time_resolution, acceleration);
-
-  // Collision check for objects in current lane
-  for (const auto & i : current_lane_object_indices) {
-    const auto & obj = dynamic_objects->objects.at(i);
-    std::vector<PredictedPath> predicted_paths;
-    if (ros_parameters.use_all_predicted_path) {
-      predicted_paths = obj.state.predicted_paths;
-    } else {
-      auto & max_confidence_path = *(std::max_element(
-        obj.state.predicted_paths.begin(), obj.state.predicted_paths.end(),
-        [](const auto & path1, const auto & path2) {
-          return path1.confidence > path2.confidence;
-        }));
-      predicted_paths.push_back(max_confidence_path);
-    }
-    for (const auto & obj_path : predicted_paths) {
-      double distance = util::getDistanceBetweenPredictedPaths(
-        obj_path, vehicle_predicted_path, current_lane_check_start_time,
-        current_lane_check_end_time, time_resolution);
-      double thresh;
-      if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
-        thresh = util::l2Norm(current_twist.linear) * stop_time;
-      } else {
-        thresh = util::l2Norm(obj.state.twist_covariance.twist.linear) * stop_time;
-      }
-      thresh = std::max(thresh, min_thresh);
-      thresh += buffer;
-      if (distance < thresh) {
-        return false;
-      }
-    }
-  }
-
-  // Collision check for objects in lane change target lane
-  for (const auto & i : target_lane_object_indices) {
-    const auto & obj = dynamic_objects->objects.at(i);
-    std::vector<PredictedPath> predicted_paths;
-    if (ros_parameters.use_all_predicted_path) {
-      predicted_paths = obj.state.predicted_paths;
-    } else {
-      auto & max_confidence_path = *(std::max_element(
-        obj.state.predicted_paths.begin(), obj.state.predicted_paths.end(),
-        [](const auto & path1, const auto & path2) {
-          return path1.confidence > path2.confidence;
-        }));
-      predicted_paths.push_back(max_confidence_path);
-    }
-
-    bool is_object_in_target = false;
-    if (ros_parameters.use_predicted_path_outside_lanelet) {
-      is_object_in_target = true;
-    } else {
-      for (const auto & llt : target_lanes) {
-        if (lanelet::utils::isInLanelet(obj.state.pose_covariance.pose, llt)) {
-          is_object_in_target = true;
-        }
-      }
-    }
-
-    if (is_object_in_target) {
-      for (const auto & obj_path : predicted_paths) {
-        const double distance = util::getDistanceBetweenPredictedPaths(
-          obj_path, vehicle_predicted_path, target_lane_check_start_time,
-          target_lane_check_end_time, time_resolution);
-        double thresh;
-        if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
-          thresh = util::l2Norm(current_twist.linear) * stop_time;
-        } else {
-          thresh = util::l2Norm(obj.state.twist_covariance.twist.linear) * stop_time;
-        }
-        thresh = std::max(thresh, min_thresh);
-        thresh += buffer;
-        if (distance < thresh) {
-          return false;
-        }
-      }
-    } else {
-      const double distance = util::getDistanceBetweenPredictedPathAndObject(
-        obj, vehicle_predicted_path, target_lane_check_start_time, target_lane_check_end_time,
-        time_resolution);
-      double thresh = min_thresh;
-      if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
-        thresh = std::max(thresh, util::l2Norm(current_twist.linear) * stop_time);
-      }
-      thresh += buffer;
-      if (distance < thresh) {
-        return false;
-      }
-    }
-  }
-
-  return true;
+  return isLaneChangePathSafe(
+    path, current_lanes, target_lanes, object_cache, objects, current_pose, current_twist,
+    vehicle_width, ros_parameters, use_buffer, acceleration);
 }
 
 bool isObjectFront(const Pose & ego_pose, const Pose & obj_pose)
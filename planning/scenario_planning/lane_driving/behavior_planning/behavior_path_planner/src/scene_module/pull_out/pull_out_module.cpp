@@ -215,10 +215,11 @@ BehaviorModuleOutput PullOutModule::planWaitingApproval()
   const auto current_lanes = getCurrentLanes();
   const auto shoulder_lanes = getPullOutLanes(current_lanes);
 
-  PathWithLaneId candidatePath;
+  // the path waiting approval is built on the candidate, so that it is planned every cycle
+  PathWithLaneId candidatePath = planCandidate();
+  out.path_candidate = std::make_shared<PathWithLaneId>(candidatePath);
   // Generate drivable area
   {
-    candidatePath = planCandidate();
     lanelet::ConstLanelets lanes;
     lanes.insert(lanes.end(), current_lanes.begin(), current_lanes.end());
     lanes.insert(lanes.end(), shoulder_lanes.begin(), shoulder_lanes.end());
@@ -234,8 +235,6 @@ BehaviorModuleOutput PullOutModule::planWaitingApproval()
   }
   out.path = std::make_shared<PathWithLaneId>(candidatePath);
 
-  out.path_candidate = std::make_shared<PathWithLaneId>(planCandidate());
-
   return out;
 }
 
@@ -441,7 +440,7 @@ std::pair<bool, bool> PullOutModule::getSafePath(
     }
     // select safe path
     bool found_safe_path = pull_out_utils::selectSafePath(
-      valid_paths, road_lanes, check_lanes, planner_data_->dynamic_object, current_pose,
+      valid_paths, road_lanes, check_lanes, planner_data_->object_cache, current_pose,
       current_twist, common_parameters.vehicle_width, parameters_, local_vehicle_footprint,
       &safe_path);
 
@@ -511,7 +510,7 @@ std::pair<bool, bool> PullOutModule::getSafeRetreatPath(
     }
     // select safe path
     bool found_safe_path = pull_out_utils::selectSafePath(
-      valid_paths, road_lanes, check_lanes, planner_data_->dynamic_object, current_pose,
+      valid_paths, road_lanes, check_lanes, planner_data_->object_cache, current_pose,
       current_twist, common_parameters.vehicle_width, parameters_, local_vehicle_footprint,
       &safe_path);
     safe_retreat_path.pull_out_path = safe_path;
@@ -591,7 +590,7 @@ bool PullOutModule::getBackDistance(
       }
       // select safe path
       bool found_safe_path = pull_out_utils::selectSafePath(
-        valid_paths, road_lanes, check_lanes, planner_data_->dynamic_object, current_pose,
+        valid_paths, road_lanes, check_lanes, planner_data_->object_cache, current_pose,
         current_twist, common_parameters.vehicle_width, parameters_, local_vehicle_footprint,
         &safe_path);
       if (found_safe_path) {
@@ -24,15 +24,18 @@
 #include <rclcpp/rclcpp.hpp>
 
 #include <boost/geometry/algorithms/dispatch/distance.hpp>
+#include <boost/optional.hpp>
 
 #include <lanelet2_core/LaneletMap.h>
 #include <tf2/utils.h>
 #include <tf2_ros/transform_listener.h>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace behavior_path_planner
@@ -101,63 +104,82 @@ std::vector<PullOutPath> getPullOutPaths(
   // maximum lateral jerk is set on retreat path
   double initial_lateral_jerk = is_retreat_path ? maximum_lateral_jerk : minimum_lateral_jerk;
 
+  const double distance_to_road_center =
+    lanelet::utils::getArcCoordinates(road_lanelets, pose).distance;
+
+  const double distance_to_shoulder_center =
+    lanelet::utils::getArcCoordinates(shoulder_lanelets, pose).distance;
+
+  // the path on the shoulder lane before the shift does not depend on the lateral jerk
+  PathWithLaneId reference_path1;
+  {
+    const auto arc_position = lanelet::utils::getArcCoordinates(shoulder_lanelets, pose);
+    const double s_start = arc_position.length - backward_path_length;
+    double s_end = arc_position.length + before_pull_out_straight_distance;
+    s_end = std::max(s_end, s_start + std::numeric_limits<double>::epsilon());
+    reference_path1 = route_handler.getCenterLinePath(shoulder_lanelets, s_start, s_end);
+  }
+  for (auto & point : reference_path1.points) {
+    point.point.twist.linear.x = std::min(point.point.twist.linear.x, minimum_pull_out_velocity);
+  }
+
+  // Apply shifting before shift
+  for (size_t i = 0; i < reference_path1.points.size(); ++i) {
+    {
+      if (fabs(distance_to_shoulder_center) < 1.0e-8) {
+        RCLCPP_WARN_STREAM(
+          rclcpp::get_logger("behavior_path_planner").get_child("pull_out").get_child("util"),
+          "no offset from current lane center.");
+      }
+
+      auto & p = reference_path1.points.at(i).point.pose;
+      double yaw = tf2::getYaw(p.orientation);
+      p.position.x -= std::sin(yaw) * distance_to_shoulder_center;
+      p.position.y += std::cos(yaw) * distance_to_shoulder_center;
+    }
+  }
+
+  if (reference_path1.points.empty()) {
+    RCLCPP_ERROR_STREAM(
+      rclcpp::get_logger("behavior_path_planner").get_child("pull_out").get_child("util"),
+      "reference path is empty!! something wrong...");
+    return candidate_paths;
+  }
+
+  const auto arc_position_goal =
+    lanelet::utils::getArcCoordinates(shoulder_lanelets, route_handler.getGoalPose());
+  const auto arc_position_ref1_back =
+    lanelet::utils::getArcCoordinates(road_lanelets, reference_path1.points.back().point.pose);
+
+  std::vector<double> lateral_jerks;
   for (double lateral_jerk = initial_lateral_jerk; lateral_jerk <= maximum_lateral_jerk;
        lateral_jerk += jerk_resolution) {
-    PathWithLaneId reference_path;
+    lateral_jerks.push_back(lateral_jerk);
+  }
+
+  // the candidates are planned in parallel, and kept in the order of the lateral jerk
+  util::prepareLaneletsForParallelUse(road_lanelets);
+  util::prepareLaneletsForParallelUse(shoulder_lanelets);
+  std::vector<boost::optional<PullOutPath>> candidate_path_per_jerk(lateral_jerks.size());
+#pragma omp parallel for schedule(dynamic)
+  for (size_t jerk_idx = 0; jerk_idx < lateral_jerks.size(); ++jerk_idx) {
+    const double lateral_jerk = lateral_jerks.at(jerk_idx);
     PathShifter path_shifter;
     ShiftedPath shifted_path;
     const double v1 = minimum_pull_out_velocity;
 
-    const double distance_to_road_center =
-      lanelet::utils::getArcCoordinates(road_lanelets, pose).distance;
-
-    const double distance_to_shoulder_center =
-      lanelet::utils::getArcCoordinates(shoulder_lanelets, pose).distance;
-
     double pull_out_distance =
       path_shifter.calcLongitudinalDistFromJerk(abs(distance_to_road_center), lateral_jerk, v1);
 
-    PathWithLaneId reference_path1;
-    {
-      const auto arc_position = lanelet::utils::getArcCoordinates(shoulder_lanelets, pose);
-      const double s_start = arc_position.length - backward_path_length;
-      double s_end = arc_position.length + before_pull_out_straight_distance;
-      s_end = std::max(s_end, s_start + std::numeric_limits<double>::epsilon());
-      reference_path1 = route_handler.getCenterLinePath(shoulder_lanelets, s_start, s_end);
-    }
-    for (auto & point : reference_path1.points) {
-      point.point.twist.linear.x = std::min(point.point.twist.linear.x, minimum_pull_out_velocity);
-    }
-
-    // Apply shifting before shift
-    for (size_t i = 0; i < reference_path1.points.size(); ++i) {
-      {
-        if (fabs(distance_to_shoulder_center) < 1.0e-8) {
-          RCLCPP_WARN_STREAM(
-            rclcpp::get_logger("behavior_path_planner").get_child("pull_out").get_child("util"),
-            "no offset from current lane center.");
-        }
-
-        auto & p = reference_path1.points.at(i).point.pose;
-        double yaw = tf2::getYaw(p.orientation);
-        p.position.x -= std::sin(yaw) * distance_to_shoulder_center;
-        p.position.y += std::cos(yaw) * distance_to_shoulder_center;
-      }
-    }
-
     PathWithLaneId reference_path2;
     {
-      const auto arc_position_goal =
-        lanelet::utils::getArcCoordinates(shoulder_lanelets, route_handler.getGoalPose());
-      const auto arc_position_ref1_back =
-        lanelet::utils::getArcCoordinates(road_lanelets, reference_path1.points.back().point.pose);
       double s_start = arc_position_ref1_back.length + pull_out_distance;
       double s_end = arc_position_goal.length;
       s_end = std::max(s_end, s_start + std::numeric_limits<double>::epsilon());
       reference_path2 = route_handler.getCenterLinePath(road_lanelets, s_start, s_end);
     }
 
-    if (reference_path1.points.empty() || reference_path2.points.empty()) {
+    if (reference_path2.points.empty()) {
       RCLCPP_ERROR_STREAM(
         rclcpp::get_logger("behavior_path_planner").get_child("pull_out").get_child("util"),
         "reference path is empty!! something wrong...");
@@ -170,9 +192,7 @@ std::vector<PullOutPath> getPullOutPaths(
     candidate_path.pull_out_length = pull_out_distance;
     PathWithLaneId target_lane_reference_path;
     {
-      const lanelet::ArcCoordinates pull_out_start_arc_position =
-        lanelet::utils::getArcCoordinates(road_lanelets, reference_path1.points.back().point.pose);
-      double s_start = pull_out_start_arc_position.length;
+      double s_start = arc_position_ref1_back.length;
       double s_end = s_start + pull_out_distance + forward_path_length;
       target_lane_reference_path = route_handler.getCenterLinePath(road_lanelets, s_start, s_end);
     }
@@ -245,9 +265,14 @@ std::vector<PullOutPath> getPullOutPaths(
       pt.point.type = PathPoint::FIXED;
     }
     // ROS_ERROR("candidate path is push backed");
-    candidate_paths.push_back(candidate_path);
+    candidate_path_per_jerk.at(jerk_idx) = std::move(candidate_path);
   }
 
+  for (auto & candidate_path : candidate_path_per_jerk) {
+    if (candidate_path) {
+      candidate_paths.push_back(std::move(*candidate_path));
+    }
+  }
   return candidate_paths;
 }
 
@@ -346,21 +371,37 @@ std::vector<PullOutPath> selectValidPaths(
 bool selectSafePath(
   const std::vector<PullOutPath> & paths, const lanelet::ConstLanelets & road_lanes,
   const lanelet::ConstLanelets & shoulder_lanes,
-  const DynamicObjectArray::ConstSharedPtr & dynamic_objects,
+  const std::shared_ptr<const PredictedObjectCache> & object_cache,
   [[maybe_unused]] const Pose & current_pose, [[maybe_unused]] const Twist & current_twist,
   [[maybe_unused]] const double vehicle_width, const PullOutParameters & ros_parameters,
   const autoware_utils::LinearRing2d & local_vehicle_footprint, PullOutPath * selected_path)
 {
   const bool use_dynamic_object = ros_parameters.use_dynamic_object;
-  for (const auto & path : paths) {
+
+  // the paths are in order of preference, the first safe one is selected. the paths after a
+  // safe one are not checked any more.
+  util::prepareLaneletsForParallelUse(road_lanes);
+  util::prepareLaneletsForParallelUse(shoulder_lanes);
+  std::atomic<size_t> safe_path_idx{paths.size()};
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < paths.size(); ++i) {
+    if (i > safe_path_idx.load()) {
+      continue;
+    }
     if (isPullOutPathSafe(
-          path, road_lanes, shoulder_lanes, dynamic_objects, ros_parameters,
+          paths.at(i), road_lanes, shoulder_lanes, object_cache, ros_parameters,
           local_vehicle_footprint, true, use_dynamic_object)) {
-      *selected_path = path;
-      return true;
+      size_t idx = safe_path_idx.load();
+      while (i < idx && !safe_path_idx.compare_exchange_weak(idx, i)) {
+      }
     }
   }
 
+  if (safe_path_idx < paths.size()) {
+    *selected_path = paths.at(safe_path_idx);
+    return true;
+  }
+
   // set first path for force pullover if no valid path found
   if (!paths.empty()) {
     *selected_path = paths.front();
@@ -406,7 +447,7 @@ bool hasEnoughDistance(
 bool isPullOutPathSafe(
   const behavior_path_planner::PullOutPath & path, const lanelet::ConstLanelets & road_lanes,
   const lanelet::ConstLanelets & shoulder_lanes,
-  const DynamicObjectArray::ConstSharedPtr & dynamic_objects,
+  const std::shared_ptr<const PredictedObjectCache> & object_cache,
   const PullOutParameters & ros_parameters,
   const autoware_utils::LinearRing2d & local_vehicle_footprint, const bool use_buffer,
   const bool use_dynamic_object)
@@ -419,7 +460,7 @@ bool isPullOutPathSafe(
   if (shoulder_lanes.empty() || road_lanes.empty()) {
     return false;
   }
-  if (dynamic_objects == nullptr) {
+  if (object_cache == nullptr) {
     return true;
   }
 
@@ -437,13 +478,14 @@ bool isPullOutPathSafe(
 
   // find obstacle in shoulder lanes
   const auto shoulder_lane_object_indices =
-    util::filterObjectsByLanelets(*dynamic_objects, shoulder_lanes);
+    util::filterObjectsByLanelets(*object_cache, shoulder_lanes);
 
   // Collision check for objects in shoulder lane
   if (use_dynamic_object) {
     for (const auto & i : shoulder_lane_object_indices) {
-      const auto & obj = dynamic_objects->objects.at(i);
-      std::vector<PredictedPath> predicted_paths;
+      const auto & obj = object_cache->getObjects().objects.at(i);
+      // the objects of the filter have a polygon
+      const auto & obj_polygon = *object_cache->getPolygon(i);
 
       bool is_object_in_shoulder = false;
       if (ros_parameters.use_predicted_path_outside_lanelet) {
@@ -458,7 +500,7 @@ bool isPullOutPathSafe(
       // TODO(sugahara) static object judge
       if (is_object_in_shoulder) {
         const double distance = util::getDistanceBetweenPredictedPathAndObjectPolygon(
-          obj, path, local_vehicle_footprint, 1, road_lanes);
+          obj_polygon, path, local_vehicle_footprint, 1, road_lanes);
 
         double thresh = min_thresh + buffer;
         if (distance < thresh) {
@@ -466,7 +508,7 @@ bool isPullOutPathSafe(
         }
       } else {
         const double distance = util::getDistanceBetweenPredictedPathAndObjectPolygon(
-          obj, path, local_vehicle_footprint, 1, road_lanes);
+          obj_polygon, path, local_vehicle_footprint, 1, road_lanes);
         double thresh = min_thresh + buffer;
         if (distance < thresh) {
           RCLCPP_WARN_STREAM(
@@ -177,7 +177,7 @@ BehaviorModuleOutput PullOverModule::planWaitingApproval()
 {
   BehaviorModuleOutput out;
   out.path = std::make_shared<PathWithLaneId>(getReferencePath());
-  out.path_candidate = std::make_shared<PathWithLaneId>(planCandidate());
+  out.path_candidate = getCandidate();
   return out;
 }
 
@@ -365,7 +365,7 @@ std::pair<bool, bool> PullOverModule::getSafePath(
     }
     // select safe path
     bool found_safe_path = pull_over_utils::selectSafePath(
-      valid_paths, current_lanes, check_lanes, planner_data_->dynamic_object, current_pose,
+      valid_paths, current_lanes, check_lanes, planner_data_->object_cache, current_pose,
       current_twist, common_parameters.vehicle_width, parameters_, &safe_path);
     return std::make_pair(true, found_safe_path);
   }
@@ -25,15 +25,19 @@
 #include <autoware_planning_msgs/msg/path_point.hpp>
 
 #include <boost/geometry/algorithms/dispatch/distance.hpp>
+#include <boost/optional.hpp>
 
 #include <lanelet2_core/LaneletMap.h>
 #include <tf2/utils.h>
 #include <tf2_ros/transform_listener.h>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace behavior_path_planner
@@ -42,6 +46,9 @@ namespace pull_over_utils
 {
 using autoware_perception_msgs::msg::PredictedPath;
 using autoware_planning_msgs::msg::PathPoint;
+using autoware_utils::Point2d;
+using autoware_utils::Polygon2d;
+using geometry_msgs::msg::Point;
 
 PathWithLaneId combineReferencePath(const PathWithLaneId path1, const PathWithLaneId path2)
 {
@@ -108,8 +115,26 @@ std::vector<PullOverPath> getPullOverPaths(
   double offset_from_current_pose =
     distance_to_shoulder_lane_boundary + common_parameter.vehicle_width / 2 + margin;
 
+  const auto arc_position_goal_on_original =
+    lanelet::utils::getArcCoordinates(original_lanelets, route_handler.getGoalPose());
+  const auto arc_position_pose = lanelet::utils::getArcCoordinates(original_lanelets, pose);
+  const auto arc_position_goal_on_target =
+    lanelet::utils::getArcCoordinates(target_lanelets, route_handler.getGoalPose());
+
+  std::vector<double> lateral_jerks;
   for (double lateral_jerk = 0.5; lateral_jerk <= maximum_lateral_jerk;
        lateral_jerk += jerk_resolution) {
+    lateral_jerks.push_back(lateral_jerk);
+  }
+
+  // the candidates are planned in parallel, and kept in the order of the lateral jerk
+  util::prepareLaneletsForParallelUse(original_lanelets);
+  util::prepareLaneletsForParallelUse(target_lanelets);
+  util::prepareLaneletsForParallelUse(route_handler.getShoulderLanelets());
+  std::vector<boost::optional<PullOverPath>> candidate_path_per_jerk(lateral_jerks.size());
+#pragma omp parallel for schedule(dynamic)
+  for (size_t jerk_idx = 0; jerk_idx < lateral_jerks.size(); ++jerk_idx) {
+    const double lateral_jerk = lateral_jerks.at(jerk_idx);
     PathShifter path_shifter;
     ShiftedPath shifted_path;
     PullOverPath candidate_path;
@@ -120,10 +145,7 @@ std::vector<PullOverPath> getPullOverPaths(
     // calculate straight distance before pull over
     double straight_distance;
     {
-      const auto arc_position_goal =
-        lanelet::utils::getArcCoordinates(original_lanelets, route_handler.getGoalPose());
-      const auto arc_position_pose = lanelet::utils::getArcCoordinates(original_lanelets, pose);
-      straight_distance = arc_position_goal.length - after_pull_over_straight_distance -
+      straight_distance = arc_position_goal_on_original.length - after_pull_over_straight_distance -
                           pull_over_distance - arc_position_pose.length;
       if (straight_distance < before_pull_over_straight_distance) {
         RCLCPP_ERROR_STREAM(
@@ -135,20 +157,17 @@ std::vector<PullOverPath> getPullOverPaths(
 
     PathWithLaneId reference_path2;
     {
-      const auto arc_position_goal =
-        lanelet::utils::getArcCoordinates(target_lanelets, route_handler.getGoalPose());
-      double s_start = arc_position_goal.length - after_pull_over_straight_distance;
-      double s_end = arc_position_goal.length;
+      double s_start = arc_position_goal_on_target.length - after_pull_over_straight_distance;
+      double s_end = arc_position_goal_on_target.length;
       s_end = std::max(s_end, s_start + std::numeric_limits<double>::epsilon());
       reference_path2 = route_handler.getCenterLinePath(target_lanelets, s_start, s_end);
     }
 
     PathWithLaneId reference_path1;
     {
-      const auto arc_position = lanelet::utils::getArcCoordinates(original_lanelets, pose);
       const auto arc_position_ref2_front = lanelet::utils::getArcCoordinates(
         original_lanelets, reference_path2.points.front().point.pose);
-      const double s_start = arc_position.length - backward_path_length;
+      const double s_start = arc_position_pose.length - backward_path_length;
       const double s_end = arc_position_ref2_front.length - pull_over_distance;
       reference_path1 = route_handler.getCenterLinePath(original_lanelets, s_start, s_end);
       // decelerate velocity linearly to minimum pull over velocity
@@ -284,9 +303,14 @@ std::vector<PullOverPath> getPullOverPaths(
       pt.point.type = PathPoint::FIXED;
     }
     // ROS_ERROR("candidate path is push backed");
-    candidate_paths.push_back(candidate_path);
+    candidate_path_per_jerk.at(jerk_idx) = std::move(candidate_path);
   }
 
+  for (auto & candidate_path : candidate_path_per_jerk) {
+    if (candidate_path) {
+      candidate_paths.push_back(std::move(*candidate_path));
+    }
+  }
   return candidate_paths;
 }
 
@@ -312,19 +336,35 @@ std::vector<PullOverPath> selectValidPaths(
 bool selectSafePath(
   const std::vector<PullOverPath> & paths, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes,
-  const DynamicObjectArray::ConstSharedPtr & dynamic_objects, const Pose & current_pose,
+  const std::shared_ptr<const PredictedObjectCache> & object_cache, const Pose & current_pose,
   const Twist & current_twist, const double vehicle_width,
   const PullOverParameters & ros_parameters, PullOverPath * selected_path)
 {
-  for (const auto & path : paths) {
+  // the paths are in order of preference, the first safe one is selected. the paths after a
+  // safe one are not checked any more.
+  util::prepareLaneletsForParallelUse(current_lanes);
+  util::prepareLaneletsForParallelUse(target_lanes);
+  std::atomic<size_t> safe_path_idx{paths.size()};
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < paths.size(); ++i) {
+    if (i > safe_path_idx.load()) {
+      continue;
+    }
+    const auto & path = paths.at(i);
     if (isPullOverPathSafe(
-          path.path, current_lanes, target_lanes, dynamic_objects, current_pose, current_twist,
+          path.path, current_lanes, target_lanes, object_cache, current_pose, current_twist,
           vehicle_width, ros_parameters, true, path.acceleration)) {
-      *selected_path = path;
-      return true;
+      size_t idx = safe_path_idx.load();
+      while (i < idx && !safe_path_idx.compare_exchange_weak(idx, i)) {
+      }
     }
   }
 
+  if (safe_path_idx < paths.size()) {
+    *selected_path = paths.at(safe_path_idx);
+    return true;
+  }
+
   // set first path for force pull over if no valid path found
   if (!paths.empty()) {
     *selected_path = paths.front();
@@ -367,10 +407,56 @@ bool hasEnoughDistance(
   return true;
 }
 
+namespace
+{
+std::vector<size_t> getPredictedPathsToCheck(
+  const PredictedObjectCache & objects, const size_t object_idx,
+  const PullOverParameters & ros_parameters)
+{
+  const auto & predicted_paths = objects.getObjects().objects.at(object_idx).state.predicted_paths;
+  if (ros_parameters.use_all_predicted_path || predicted_paths.empty()) {
+    std::vector<size_t> path_indices(predicted_paths.size());
+    std::iota(path_indices.begin(), path_indices.end(), 0);
+    return path_indices;
+  }
+  return {*objects.getMaxConfidencePathIndex(object_idx)};
+}
+
+// minimum distance between the positions of the ego and of the object at the same time steps
+double getDistanceBetweenPositions(
+  const std::vector<boost::optional<Point>> & object_positions,
+  const std::vector<boost::optional<Point>> & ego_positions)
+{
+  double min_distance = std::numeric_limits<double>::max();
+  for (size_t t = 0; t < ego_positions.size(); ++t) {
+    if (!object_positions.at(t) || !ego_positions.at(t)) {
+      continue;
+    }
+    min_distance = std::min(
+      min_distance, autoware_utils::calcDistance3d(*object_positions.at(t), *ego_positions.at(t)));
+  }
+  return min_distance;
+}
+
+double getDistanceToPolygon(
+  const Polygon2d & polygon, const std::vector<boost::optional<Point>> & ego_positions)
+{
+  double min_distance = std::numeric_limits<double>::max();
+  for (const auto & ego_position : ego_positions) {
+    if (!ego_position) {
+      continue;
+    }
+    const Point2d ego_point{ego_position->x, ego_position->y};
+    min_distance = std::min(min_distance, boost::geometry::distance(polygon, ego_point));
+  }
+  return min_distance;
+}
+}  // namespace
+
 bool isPullOverPathSafe(
   const PathWithLaneId & path, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes,
-  const DynamicObjectArray::ConstSharedPtr & dynamic_objects, const Pose & current_pose,
+  const std::shared_ptr<const PredictedObjectCache> & object_cache, const Pose & current_pose,
   const Twist & current_twist, const double vehicle_width,
   const PullOverParameters & ros_parameters, const bool use_buffer, const double acceleration)
 {
@@ -380,9 +466,10 @@ bool isPullOverPathSafe(
   if (target_lanes.empty() || current_lanes.empty()) {
     return false;
   }
-  if (dynamic_objects == nullptr) {
+  if (object_cache == nullptr) {
     return true;
   }
+  const auto & dynamic_objects = object_cache->getObjects();
   const auto arc = lanelet::utils::getArcCoordinates(current_lanes, current_pose);
   constexpr double check_distance = 100.0;
 
@@ -400,50 +487,43 @@ bool isPullOverPathSafe(
     buffer = 0.0;
     lateral_buffer = 0.0;
   }
-  double current_lane_check_start_time = 0.0;
-  const double current_lane_check_end_time =
-    ros_parameters.pull_over_prepare_duration + ros_parameters.pull_over_duration;
-  double target_lane_check_start_time = 0.0;
-  const double target_lane_check_end_time =
+  double check_start_time = 0.0;
+  const double check_end_time =
     ros_parameters.pull_over_prepare_duration + ros_parameters.pull_over_duration;
   if (!ros_parameters.enable_collision_check_at_prepare_phase) {
-    current_lane_check_start_time = ros_parameters.pull_over_prepare_duration;
-    target_lane_check_start_time = ros_parameters.pull_over_prepare_duration;
+    check_start_time = ros_parameters.pull_over_prepare_duration;
+  }
+  std::vector<rclcpp::Duration> check_times;
+  const auto t_delta = rclcpp::Duration::from_seconds(time_resolution);
+  const auto t_end = rclcpp::Duration::from_seconds(check_end_time);
+  for (auto t = rclcpp::Duration::from_seconds(check_start_time); t < t_end; t = t + t_delta) {
+    check_times.push_back(t);
   }
 
   // find obstacle in pull_over target lanes
   // retrieve lanes that are merging target lanes as well
   const auto target_lane_object_indices =
-    util::filterObjectsByLanelets(*dynamic_objects, target_lanes);
+    util::filterObjectsByLanelets(*object_cache, target_lanes);
 
   // find objects in current lane
   const auto current_lane_object_indices_lanelet = util::filterObjectsByLanelets(
-    *dynamic_objects, current_lanes, arc.length, arc.length + check_distance);
+    *object_cache, current_lanes, arc.length, arc.length + check_distance);
   const auto current_lane_object_indices = util::filterObjectsByPath(
-    *dynamic_objects, current_lane_object_indices_lanelet, path,
-    vehicle_width / 2 + lateral_buffer);
+    *object_cache, current_lane_object_indices_lanelet, path, vehicle_width / 2 + lateral_buffer);
 
+  // the ego positions at the time steps of the check
   const auto & vehicle_predicted_path = util::convertToPredictedPath(
-    path, current_twist, current_pose, target_lane_check_end_time, time_resolution, acceleration);
+    path, current_twist, current_pose, check_end_time, time_resolution, acceleration);
+  const auto ego_positions = util::samplePredictedPath(
+    vehicle_predicted_path, rclcpp::Time(vehicle_predicted_path.path.front().header.stamp),
+    check_times);
 
   // Collision check for objects in current lane
   for (const auto & i : current_lane_object_indices) {
-    const auto & obj = dynamic_objects->objects.at(i);
-    std::vector<PredictedPath> predicted_paths;
-    if (ros_parameters.use_all_predicted_path) {
-      predicted_paths = obj.state.predicted_paths;
-    } else {
-      auto & max_confidence_path = *(std::max_element(
-        obj.state.predicted_paths.begin(), obj.state.predicted_paths.end(),
-        [](const auto & path1, const auto & path2) {
-          return path1.confidence > path2.confidence;
-        }));
-      predicted_paths.push_back(max_confidence_path);
-    }
-    for (const auto & obj_path : predicted_paths) {
-      double distance = util::getDistanceBetweenPredictedPaths(
-        obj_path, vehicle_predicted_path, current_lane_check_start_time,
-        current_lane_check_end_time, time_resolution);
+    const auto & obj = dynamic_objects.objects.at(i);
+    for (const auto & path_idx : getPredictedPathsToCheck(*object_cache, i, ros_parameters)) {
+      const double distance = getDistanceBetweenPositions(
+        object_cache->getPredictedPositions(i, path_idx, check_times), ego_positions);
       double thresh;
       if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
         thresh = util::l2Norm(current_twist.linear) * stop_time;
@@ -460,18 +540,7 @@ bool isPullOverPathSafe(
 
   // Collision check for objects in pull over target lane
   for (const auto & i : target_lane_object_indices) {
-    const auto & obj = dynamic_objects->objects.at(i);
-    std::vector<PredictedPath> predicted_paths;
-    if (ros_parameters.use_all_predicted_path) {
-      predicted_paths = obj.state.predicted_paths;
-    } else {
-      auto & max_confidence_path = *(std::max_element(
-        obj.state.predicted_paths.begin(), obj.state.predicted_paths.end(),
-        [](const auto & path1, const auto & path2) {
-          return path1.confidence > path2.confidence;
-        }));
-      predicted_paths.push_back(max_confidence_path);
-    }
+    const auto & obj = dynamic_objects.objects.at(i);
 
     bool is_object_in_target = false;
     if (ros_parameters.use_predicted_path_outside_lanelet) {
@@ -485,10 +554,9 @@ bool isPullOverPathSafe(
     }
 
     if (is_object_in_target) {
-      for (const auto & obj_path : predicted_paths) {
-        const double distance = util::getDistanceBetweenPredictedPaths(
-          obj_path, vehicle_predicted_path, target_lane_check_start_time,
-          target_lane_check_end_time, time_resolution);
+      for (const auto & path_idx : getPredictedPathsToCheck(*object_cache, i, ros_parameters)) {
+        const double distance = getDistanceBetweenPositions(
+          object_cache->getPredictedPositions(i, path_idx, check_times), ego_positions);
         double thresh;
         if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
           thresh = util::l2Norm(current_twist.linear) * stop_time;
@@ -502,9 +570,8 @@ bool isPullOverPathSafe(
         }
       }
     } else {
-      const double distance = util::getDistanceBetweenPredictedPathAndObject(
-        obj, vehicle_predicted_path, target_lane_check_start_time, target_lane_check_end_time,
-        time_resolution);
+      // the objects of the filter have a polygon
+      const double distance = getDistanceToPolygon(*object_cache->getPolygon(i), ego_positions);
       double thresh = min_thresh;
       if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
         thresh = std::max(thresh, util::l2Norm(current_twist.linear) * stop_time);
@@ -14,17 +14,24 @@
 
 #include "behavior_path_planner/scene_module/scene_module_bt_node_interface.hpp"
 
+#include <autoware_utils/system/stop_watch.hpp>
+
+#include <chrono>
 #include <memory>
 #include <string>
 
 namespace behavior_path_planner
 {
+using StopWatch = autoware_utils::StopWatch<std::chrono::milliseconds>;
+
 BT::NodeStatus isExecutionRequested(
   const std::shared_ptr<const SceneModuleInterface> p,
   const std::shared_ptr<SceneModuleStatus> & status)
 {
+  StopWatch stop_watch;
   const auto ret = p->isExecutionRequested();
   status->is_requested = ret;
+  status->processing_time_ms += stop_watch.toc();
   RCLCPP_DEBUG_STREAM(p->getLogger(), "name = " << p->name() << ", result = " << ret);
   return ret ? BT::NodeStatus::SUCCESS : BT::NodeStatus::FAILURE;
 }
@@ -33,8 +40,10 @@ BT::NodeStatus isExecutionReady(
   const std::shared_ptr<const SceneModuleInterface> p,
   const std::shared_ptr<SceneModuleStatus> & status)
 {
+  StopWatch stop_watch;
   const auto ret = p->isExecutionReady();
   status->is_ready = ret;
+  status->processing_time_ms += stop_watch.toc();
   RCLCPP_DEBUG_STREAM(p->getLogger(), "name = " << p->name() << ", result = " << ret);
   return ret ? BT::NodeStatus::SUCCESS : BT::NodeStatus::FAILURE;
 }
@@ -53,6 +62,7 @@ BT::NodeStatus SceneModuleBTNodeInterface::tick()
     scene_module_->getLogger(), "bt::tick is called. module name: " << scene_module_->name());
   auto current_status = BT::NodeStatus::RUNNING;
 
+  StopWatch stop_watch;
   scene_module_->onEntry();
   scene_module_->updateApproval();
 
@@ -73,6 +83,7 @@ BT::NodeStatus SceneModuleBTNodeInterface::tick()
         scene_module_->getLogger(), "behavior module has failed with exception: " << e.what());
       // std::exit(EXIT_FAILURE);  // TODO(Horibe) do appropriate handing
     }
+    module_status_->processing_time_ms += stop_watch.toc();
     return BT::NodeStatus::SUCCESS;
   }
 
@@ -103,10 +114,14 @@ BT::NodeStatus SceneModuleBTNodeInterface::tick()
       break;
     }
 
+    // the time waiting for the next tick is not of this module
+    module_status_->processing_time_ms += stop_watch.toc();
     setStatusRunningAndYield();
+    stop_watch.tic();
   }
 
   scene_module_->onExit();
+  module_status_->processing_time_ms += stop_watch.toc();
   RCLCPP_DEBUG_STREAM(
     scene_module_->getLogger(), "on tick: return current status = " << BT::toStr(current_status));
 
@@ -123,10 +138,12 @@ BT::NodeStatus SceneModuleBTNodeInterface::planCandidate(BT::TreeNode & self)
 {
   RCLCPP_DEBUG_STREAM(
     scene_module_->getLogger(), "bt::planCandidate module name: " << scene_module_->name());
+  StopWatch stop_watch;
   auto res = self.setOutput<BehaviorModuleOutput>("output", scene_module_->planWaitingApproval());
   if (!res) {
     RCLCPP_ERROR_STREAM(scene_module_->getLogger(), "setOutput() failed : " << res.error());
   }
+  module_status_->processing_time_ms += stop_watch.toc();
 
   return BT::NodeStatus::SUCCESS;
 }
@@ -269,7 +269,7 @@ BehaviorModuleOutput SideShiftModule::planWaitingApproval()
 
   BehaviorModuleOutput output;
   output.path = std::make_shared<PathWithLaneId>(shifted_path.path);
-  output.path_candidate = std::make_shared<PathWithLaneId>(planCandidate());
+  output.path_candidate = getCandidate();
 
   prev_output_ = shifted_path;
 
@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -66,64 +67,35 @@ bool convertToFrenetCoordinate3d(
   }
 
   const auto search_pt = autoware_utils::fromMsg(search_point_geom);
-  bool found = false;
-  double min_distance = std::numeric_limits<double>::max();
-
-  // get frenet coordinate based on points
-  // this is done because linestring is not differentiable at vertices
-  {
-    double accumulated_length = 0;
-
-    for (std::size_t i = 0; i < linestring.size(); i++) {
-      const auto geom_pt = linestring.at(i);
-      const auto current_pt = autoware_utils::fromMsg(geom_pt);
-      const auto current2search_pt = (search_pt - current_pt);
-      // update accumulated length
-      if (i != 0) {
-        const auto p1 = autoware_utils::fromMsg(linestring.at(i - 1));
-        const auto p2 = current_pt;
-        accumulated_length += (p2 - p1).norm();
-      }
-      // update frenet coordinate
-
-      const double tmp_distance = current2search_pt.norm();
-      if (tmp_distance < min_distance) {
-        found = true;
-        min_distance = tmp_distance;
-        frenet_coordinate->distance = tmp_distance;
-        frenet_coordinate->length = accumulated_length;
-      }
-    }
-  }
+  double min_distance = (search_pt - autoware_utils::fromMsg(linestring.front())).norm();
+  frenet_coordinate->distance = min_distance;
+  frenet_coordinate->length = 0.0;
 
-  // get frenet coordinate based on lines
-  {
-    auto prev_geom_pt = linestring.front();
-    double accumulated_length = 0;
-    for (const auto & geom_pt : linestring) {
-      const auto start_pt = autoware_utils::fromMsg(prev_geom_pt);
-      const auto end_pt = autoware_utils::fromMsg(geom_pt);
-
-      const auto line_segment = end_pt - start_pt;
-      const double line_segment_length = line_segment.norm();
-      const auto direction = line_segment / line_segment_length;
-      const auto start2search_pt = (search_pt - start_pt);
-
-      double tmp_length = direction.dot(start2search_pt);
-      if (tmp_length >= 0 && tmp_length <= line_segment_length) {
-        double tmp_distance = direction.cross(start2search_pt).norm();
-        if (tmp_distance < min_distance) {
-          found = true;
-          min_distance = tmp_distance;
-          frenet_coordinate->distance = tmp_distance;
-          frenet_coordinate->length = accumulated_length + tmp_length;
-        }
-      }
-      accumulated_length += line_segment_length;
-      prev_geom_pt = geom_pt;
+  // the closest point of each segment, clamped to its end points since the linestring is not
+  // differentiable at the vertices
+  double accumulated_length = 0;
+  for (std::size_t i = 1; i < linestring.size(); i++) {
+    const auto start_pt = autoware_utils::fromMsg(linestring.at(i - 1));
+    const auto end_pt = autoware_utils::fromMsg(linestring.at(i));
+
+    const Eigen::Vector3d line_segment = end_pt - start_pt;
+    const Eigen::Vector3d start2search_pt = search_pt - start_pt;
+    const double line_segment_length = line_segment.norm();
+
+    const Eigen::Vector3d direction = line_segment_length > 0.0
+                                        ? Eigen::Vector3d(line_segment / line_segment_length)
+                                        : Eigen::Vector3d::Zero();
+    const double tmp_length =
+      std::max(0.0, std::min(direction.dot(start2search_pt), line_segment_length));
+    const double tmp_distance = (start2search_pt - direction * tmp_length).norm();
+    if (tmp_distance < min_distance) {
+      min_distance = tmp_distance;
+      frenet_coordinate->distance = tmp_distance;
+      frenet_coordinate->length = accumulated_length + tmp_length;
     }
+    accumulated_length += line_segment_length;
   }
-  return found;
+  return true;
 }
 
 std::vector<Point> convertToGeometryPointArray(const PathWithLaneId & path)
@@ -354,6 +326,23 @@ bool lerpByTimeStamp(const PredictedPath & path, const rclcpp::Time & t, Pose *
   return false;
 }
 
+std::vector<boost::optional<Point>> samplePredictedPath(
+  const PredictedPath & path, const rclcpp::Time & start_time,
+  const std::vector<rclcpp::Duration> & times)
+{
+  std::vector<boost::optional<Point>> positions;
+  positions.reserve(times.size());
+  for (const auto & t : times) {
+    Pose pose;
+    if (lerpByTimeStamp(path, start_time + t, &pose)) {
+      positions.emplace_back(pose.position);
+    } else {
+      positions.emplace_back();
+    }
+  }
+  return positions;
+}
+
 bool lerpByDistance(
   const behavior_path_planner::PullOutPath & path, const double & s, Pose * lerped_pt,
   const lanelet::ConstLanelets & road_lanes)
@@ -442,14 +431,22 @@ double getDistanceBetweenPredictedPathAndObjectPolygon(
   const autoware_utils::LinearRing2d & vehicle_footprint, double distance_resolution,
   const lanelet::ConstLanelets & road_lanes)
 {
-  double min_distance = std::numeric_limits<double>::max();
-
-  const auto ego_path_point_array = convertToGeometryPointArray(ego_path.path);
   Polygon2d obj_polygon;
   if (!calcObjectPolygon(object, &obj_polygon)) {
     // ROS_ERROR("calcObjectPolygon failed");
-    return min_distance;
+    return std::numeric_limits<double>::max();
   }
+  return getDistanceBetweenPredictedPathAndObjectPolygon(
+    obj_polygon, ego_path, vehicle_footprint, distance_resolution, road_lanes);
+}
+
+double getDistanceBetweenPredictedPathAndObjectPolygon(
+  const Polygon2d & obj_polygon, const PullOutPath & ego_path,
+  const autoware_utils::LinearRing2d & vehicle_footprint, double distance_resolution,
+  const lanelet::ConstLanelets & road_lanes)
+{
+  double min_distance = std::numeric_limits<double>::max();
+
   const auto s_start =
     lanelet::utils::getArcCoordinates(road_lanes, ego_path.path.points.front().point.pose).length;
   const auto s_end = lanelet::utils::getArcCoordinates(road_lanes, ego_path.shift_point.end).length;
@@ -673,6 +670,91 @@ std::vector<size_t> filterObjectsByPath(
   return indices;
 }
 
+std::vector<size_t> filterObjectsByLanelets(
+  const PredictedObjectCache & objects, const lanelet::ConstLanelets & target_lanelets,
+  const double start_arc_length, const double end_arc_length)
+{
+  std::vector<size_t> indices;
+  if (target_lanelets.empty()) {
+    return {};
+  }
+  const auto polygon =
+    lanelet::utils::getPolygonFromArcLength(target_lanelets, start_arc_length, end_arc_length);
+  const auto polygon2d = lanelet::utils::to2D(polygon).basicPolygon();
+  if (polygon2d.empty()) {
+    // no lanelet polygon
+    return {};
+  }
+  Polygon2d lanelet_polygon;
+  for (const auto & lanelet_point : polygon2d) {
+    lanelet_polygon.outer().emplace_back(lanelet_point.x(), lanelet_point.y());
+  }
+  lanelet_polygon.outer().push_back(lanelet_polygon.outer().front());
+
+  const auto envelope = boost::geometry::return_envelope<autoware_utils::Box2d>(lanelet_polygon);
+  for (const auto & i : objects.queryObjects(envelope)) {
+    // check the object does not intersect the lanelet
+    if (!boost::geometry::disjoint(lanelet_polygon, *objects.getPolygon(i))) {
+      indices.push_back(i);
+    }
+  }
+  return indices;
+}
+
+std::vector<size_t> filterObjectsByLanelets(
+  const PredictedObjectCache & objects, const lanelet::ConstLanelets & target_lanelets)
+{
+  std::set<size_t> indices;
+  for (const auto & llt : target_lanelets) {
+    // create lanelet polygon
+    const auto polygon2d = llt.polygon2d().basicPolygon();
+    if (polygon2d.empty()) {
+      // no lanelet polygon
+      continue;
+    }
+    Polygon2d lanelet_polygon;
+    for (const auto & lanelet_point : polygon2d) {
+      lanelet_polygon.outer().emplace_back(lanelet_point.x(), lanelet_point.y());
+    }
+    lanelet_polygon.outer().push_back(lanelet_polygon.outer().front());
+
+    const auto envelope = boost::geometry::return_envelope<autoware_utils::Box2d>(lanelet_polygon);
+    for (const auto & i : objects.queryObjects(envelope)) {
+      // check the object does not intersect the lanelet
+      if (indices.count(i) > 0) {
+        continue;
+      }
+      if (!boost::geometry::disjoint(lanelet_polygon, *objects.getPolygon(i))) {
+        indices.insert(i);
+      }
+    }
+  }
+  return {indices.begin(), indices.end()};
+}
+
+std::vector<size_t> filterObjectsByPath(
+  const PredictedObjectCache & objects, const std::vector<size_t> & object_indices,
+  const PathWithLaneId & ego_path, const double vehicle_width)
+{
+  LineString2d ego_path_line;
+  for (const auto & p : ego_path.points) {
+    boost::geometry::append(
+      ego_path_line, Point2d(p.point.pose.position.x, p.point.pose.position.y));
+  }
+
+  std::vector<size_t> indices;
+  for (const auto & i : object_indices) {
+    const auto & obj_polygon = objects.getPolygon(i);
+    if (!obj_polygon) {
+      continue;
+    }
+    if (boost::geometry::distance(*obj_polygon, ego_path_line) < vehicle_width) {
+      indices.push_back(i);
+    }
+  }
+  return indices;
+}
+
 PathWithLaneId removeOverlappingPoints(const PathWithLaneId & input_path)
 {
   PathWithLaneId filtered_path;
@@ -932,55 +1014,36 @@ OccupancyGrid generateDrivableArea(
 
   // occupancy_grid.data = image;
   {
-    constexpr uint8_t free_space = 0;
-    constexpr uint8_t occupied_space = 100;
-    // get transform
-    tf2::Stamped<tf2::Transform> tf_grid2map, tf_map2grid;
-    tf2::fromMsg(grid_origin, tf_grid2map);
-    tf_map2grid.setData(tf_grid2map.inverse());
-    const auto geom_tf_map2grid = tf2::toMsg(tf_map2grid);
-
-    // convert lane polygons into cv type
-    cv::Mat cv_image(
-      occupancy_grid.info.width, occupancy_grid.info.height, CV_8UC1, cv::Scalar(occupied_space));
+    std::vector<lanelet::Id> lane_ids;
     for (const auto & lane : drivable_lanes) {
-      lanelet::BasicPolygon2d lane_poly = lane.polygon2d().basicPolygon();
-
-      if (lane.hasAttribute("intersection_area")) {
-        const std::string area_id = lane.attributeOr("intersection_area", "none");
-        const auto intersection_area = route_handler.getIntersectionAreaById(atoi(area_id.c_str()));
-        const auto poly = lanelet::utils::to2D(intersection_area).basicPolygon();
-        std::vector<lanelet::BasicPolygon2d> lane_polys{};
-        if (boost::geometry::intersection(poly, lane_poly, lane_polys)) {
-          lane_poly = lane_polys.front();
+      lane_ids.push_back(lane.id());
+    }
+    const auto get_polygons = [&drivable_lanes, &route_handler]() {
+      DrivableAreaCache::Polygons polygons;
+      for (const auto & lane : drivable_lanes) {
+        lanelet::BasicPolygon2d lane_poly = lane.polygon2d().basicPolygon();
+
+        if (lane.hasAttribute("intersection_area")) {
+          const std::string area_id = lane.attributeOr("intersection_area", "none");
+          const auto intersection_area =
+            route_handler.getIntersectionAreaById(atoi(area_id.c_str()));
+          const auto poly = lanelet::utils::to2D(intersection_area).basicPolygon();
+          std::vector<lanelet::BasicPolygon2d> lane_polys{};
+          if (boost::geometry::intersection(poly, lane_poly, lane_polys)) {
+            lane_poly = lane_polys.front();
+          }
         }
+        polygons.push_back(lane_poly);
       }
+      return polygons;
+    };
 
-      // create drivable area using opencv
-      std::vector<std::vector<cv::Point>> cv_polygons;
-      std::vector<cv::Point> cv_polygon;
-      for (const auto & p : lane_poly) {
-        const double z = lane.polygon3d().basicPolygon().at(0).z();
-        Point geom_pt = autoware_utils::createPoint(p.x(), p.y(), z);
-        Point transformed_geom_pt;
-        tf2::doTransform(geom_pt, transformed_geom_pt, geom_tf_map2grid);
-        cv_polygon.push_back(toCVPoint(transformed_geom_pt, width, height, resolution));
-      }
-      cv_polygons.push_back(cv_polygon);
-      // fill in drivable area and copy to occupancy grid
-      cv::fillPoly(cv_image, cv_polygons, cv::Scalar(free_space));
-    }
-
-    // Closing
-    constexpr int num_iter = 10;  // TODO(Horibe) Think later.
-    cv::Mat cv_erode, cv_dilate;
-    cv::erode(cv_image, cv_erode, cv::Mat(), cv::Point(-1, -1), num_iter);
-    cv::dilate(cv_erode, cv_dilate, cv::Mat(), cv::Point(-1, -1), num_iter);
+    // the lanes are rasterized and closed once in map aligned tiles, and sampled into the grid
+    const auto cv_image = route_handler.getDrivableAreaCache().getImage(
+      lane_ids, get_polygons, grid_origin.pose, width, height, resolution);
 
-    // const auto & cv_image_reshaped = cv_dilate.reshape(1, 1);
-    imageToOccupancyGrid(cv_dilate, &occupancy_grid);
+    imageToOccupancyGrid(cv_image, &occupancy_grid);
     occupancy_grid.data[0] = 0;
-    // cv_image_reshaped.copyTo(occupancy_grid.data);
   }
 
   return occupancy_grid;
@@ -1401,5 +1464,12 @@ void shiftPose(Pose * pose, double shift_length)
   pose->position.y += std::cos(yaw) * shift_length;
 }
 
+void prepareLaneletsForParallelUse(const lanelet::ConstLanelets & lanelets)
+{
+  for (const auto & llt : lanelets) {
+    llt.centerline();
+  }
+}
+
 }  // namespace util
 }  // namespace behavior_path_planner
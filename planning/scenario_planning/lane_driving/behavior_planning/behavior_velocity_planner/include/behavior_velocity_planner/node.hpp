@@ -18,6 +18,7 @@
 #include "behavior_velocity_planner/planner_data.hpp"
 #include "behavior_velocity_planner/planner_manager.hpp"
 
+#include <autoware_utils/ros/latency_tracer.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_api_msgs/msg/crosswalk_status.hpp>
@@ -95,9 +96,22 @@ private:
   double forward_path_length_;
   double backward_path_length_;
 
+  // callback group of the sensor data converted before they are used, so that the conversion
+  // runs beside onTrigger on a multi-threaded executor
+  rclcpp::CallbackGroup::SharedPtr callback_group_sensor_;
+
+  // written by onNoGroundPointCloud, read by onTrigger with atomic operations
+  struct NoGroundPointCloud
+  {
+    pcl::PointCloud<pcl::PointXYZ>::ConstPtr pointcloud;
+    std::shared_ptr<const PointCloudGrid> grid;
+  };
+  std::shared_ptr<const NoGroundPointCloud> no_ground_pointcloud_;
+
   // member
   PlannerData planner_data_;
   BehaviorVelocityPlannerManager planner_manager_;
+  autoware_utils::LatencyTracer latency_tracer_{this};
 
   // function
   geometry_msgs::msg::PoseStamped getCurrentPose();
@@ -15,6 +15,8 @@
 #ifndef BEHAVIOR_VELOCITY_PLANNER__PLANNER_DATA_HPP_
 #define BEHAVIOR_VELOCITY_PLANNER__PLANNER_DATA_HPP_
 
+#include <utilization/pointcloud_grid.hpp>
+#include <utilization/predicted_path_index.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
 #include <autoware_api_msgs/msg/crosswalk_status.hpp>
@@ -68,7 +70,11 @@ struct PlannerData
   static constexpr double velocity_buffer_time_sec = 10.0;
   std::deque<geometry_msgs::msg::TwistStamped> velocity_buffer;
   autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr dynamic_objects;
+  // predicted paths of dynamic_objects, shared by the modules checking them against their areas
+  std::shared_ptr<const PredictedPathIndex> predicted_path_index;
   pcl::PointCloud<pcl::PointXYZ>::ConstPtr no_ground_pointcloud;
+  // no_ground_pointcloud in a grid, for the modules searching the points in their areas
+  std::shared_ptr<const PointCloudGrid> no_ground_pointcloud_grid;
   lanelet::LaneletMapPtr lanelet_map;
   // occupancy grid
   nav_msgs::msg::OccupancyGrid::ConstSharedPtr occupancy_grid;
@@ -31,6 +31,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace behavior_velocity_planner
 {
@@ -107,8 +108,8 @@ public:
 
   BlindSpotModule(
     const int64_t module_id, const int64_t lane_id, std::shared_ptr<const PlannerData> planner_data,
-    const PlannerParam & planner_param, const rclcpp::Logger logger,
-    const rclcpp::Clock::SharedPtr clock);
+    const autoware_planning_msgs::msg::PathWithLaneId & path, const PlannerParam & planner_param,
+    const rclcpp::Logger logger, const rclcpp::Clock::SharedPtr clock);
 
   /**
    * @brief plan go-stop velocity at traffic crossing with collision check between reference path
@@ -128,6 +129,13 @@ private:
   // Parameter
   PlannerParam planner_param_;
 
+  // half lanelets the blind spot areas are cut from, which only depend on their lane ids, the map
+  // and the parameters
+  std::vector<int64_t> blind_spot_lane_ids_;
+  lanelet::ConstLanelets blind_spot_lanelets_;
+  double blind_spot_lanelets_length_;
+  double intersection_length_;
+
   /**
    * @brief Check obstacle is in blind spot areas.
    * Condition1: Object's position is in broad blind spot area.
@@ -139,8 +147,6 @@ private:
    * @return true when an object is detected in blind spot
    */
   bool checkObstacleInBlindSpot(
-    lanelet::LaneletMapConstPtr lanelet_map_ptr,
-    lanelet::routing::RoutingGraphPtr routing_graph_ptr,
     const autoware_planning_msgs::msg::PathWithLaneId & path,
     const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr objects_ptr,
     const int closest_idx, const geometry_msgs::msg::Pose & stop_line_pose) const;
@@ -152,6 +158,16 @@ private:
    */
   lanelet::ConstLanelet generateHalfLanelet(const lanelet::ConstLanelet lanelet) const;
 
+  /**
+   * @brief Update the half lanelets of the blind spot areas if the lanelets of the path leading to
+   * the lane have changed
+   * @param lanelet_map_ptr lanelet map
+   * @param path path information associated with lane id
+   */
+  void updateBlindSpotLanelets(
+    lanelet::LaneletMapConstPtr lanelet_map_ptr,
+    const autoware_planning_msgs::msg::PathWithLaneId & path);
+
   /**
    * @brief Make blind spot areas. Narrow area is made from closest path point to stop line index.
    * Broad area is made from backward expanded point to stop line point
@@ -160,8 +176,6 @@ private:
    * @return Blind spot polygons
    */
   boost::optional<BlindSpotPolygons> generateBlindSpotPolygons(
-    lanelet::LaneletMapConstPtr lanelet_map_ptr,
-    lanelet::routing::RoutingGraphPtr routing_graph_ptr,
     const autoware_planning_msgs::msg::PathWithLaneId & path, const int closest_idx,
     const geometry_msgs::msg::Pose & pose) const;
 
@@ -183,16 +197,6 @@ private:
    */
   bool isTargetObjectType(const autoware_perception_msgs::msg::DynamicObject & object) const;
 
-  /**
-   * @brief Check if at least one of object's predicted position is in area
-   * @param object Dynamic object
-   * @param area Area defined by polygon
-   * @return True when at least one of object's predicted position is in area
-   */
-  bool isPredictedPathInArea(
-    const autoware_perception_msgs::msg::DynamicObject & object,
-    const lanelet::CompoundPolygon3d & area) const;
-
   /**
    * @brief Generate a stop line and insert it into the path.
    * A stop line is at an intersection point of straight path with vehicle path
@@ -242,14 +246,6 @@ private:
     lanelet::LaneletMapConstPtr lanelet_map_ptr,
     lanelet::routing::RoutingGraphPtr routing_graph_ptr, const int lane_id);
 
-  /**
-   * @brief Modify objects predicted path. remove path point if the time exceeds timer_thr.
-   * @param objects_ptr target objects
-   * @param time_thr    time threshold to cut path
-   */
-  void cutPredictPathWithDuration(
-    autoware_perception_msgs::msg::DynamicObjectArray * objects_ptr, const double time_thr) const;
-
   StateMachine state_machine_;  //! for state
 
   // Debug
@@ -35,6 +35,8 @@ public:
 
   const char * getModuleName() override { return "crosswalk"; }
 
+  bool canRunInParallel() const override { return true; }
+
 private:
   CrosswalkModule::PlannerParam crosswalk_planner_param_;
   WalkwayModule::PlannerParam walkway_planner_param_;
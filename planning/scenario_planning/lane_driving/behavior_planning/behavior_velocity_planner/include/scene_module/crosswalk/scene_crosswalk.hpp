@@ -68,23 +68,18 @@ private:
 
   bool checkSlowArea(
     const autoware_planning_msgs::msg::PathWithLaneId & input,
-    const boost::geometry::model::polygon<boost::geometry::model::d2::point_xy<double>> & polygon,
     const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr & objects_ptr,
     const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & no_ground_pointcloud_ptr,
     autoware_planning_msgs::msg::PathWithLaneId & output);
 
   bool checkStopArea(
     const autoware_planning_msgs::msg::PathWithLaneId & input,
-    const boost::geometry::model::polygon<boost::geometry::model::d2::point_xy<double>> & polygon,
     const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr & objects_ptr,
     const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & no_ground_pointcloud_ptr,
     autoware_planning_msgs::msg::PathWithLaneId & output, bool * insert_stop);
 
   bool createVehiclePathPolygonInCrosswalk(
-    const autoware_planning_msgs::msg::PathWithLaneId & input,
-    const boost::geometry::model::polygon<boost::geometry::model::d2::point_xy<double>> &
-      crosswalk_polygon,
-    const float extended_width,
+    const autoware_planning_msgs::msg::PathWithLaneId & input, const float extended_width,
     boost::geometry::model::polygon<boost::geometry::model::d2::point_xy<double>> & path_polygon);
   bool isTargetType(const autoware_perception_msgs::msg::DynamicObject & obj);
   bool isTargetExternalInputStatus(const int target_status);
@@ -94,6 +89,10 @@ private:
   lanelet::ConstLanelet crosswalk_;
   State state_;
 
+  // clockwise polygon of crosswalk_ and its bounding box
+  boost::geometry::model::polygon<boost::geometry::model::d2::point_xy<double>> crosswalk_polygon_;
+  boost::geometry::model::box<boost::geometry::model::d2::point_xy<double>> crosswalk_box_;
+
   // Parameter
   PlannerParam planner_param_;
 
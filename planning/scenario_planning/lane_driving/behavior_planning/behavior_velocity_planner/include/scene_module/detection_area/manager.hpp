@@ -33,6 +33,8 @@ public:
 
   const char * getModuleName() override { return "detection_area"; }
 
+  bool canRunInParallel() const override { return true; }
+
 private:
   DetectionAreaModule::PlannerParam planner_param_;
   void launchNewModules(const autoware_planning_msgs::msg::PathWithLaneId & path) override;
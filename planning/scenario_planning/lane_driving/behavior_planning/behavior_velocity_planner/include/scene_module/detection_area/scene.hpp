@@ -27,6 +27,7 @@
 #include <rclcpp/rclcpp.hpp>
 #include <scene_module/scene_module_interface.hpp>
 #include <utilization/boost_geometry_helper.hpp>
+#include <utilization/pointcloud_grid.hpp>
 
 #include <lanelet2_core/LaneletMap.h>
 #include <tf2/LinearMath/Transform.h>
@@ -96,6 +97,8 @@ private:
 
   // Key Feature
   const lanelet::autoware::DetectionArea & detection_area_reg_elem_;
+  // cells of the no ground pointcloud grid in each detection area
+  std::vector<PointCloudGrid::PolygonMask> detection_area_masks_;
 
   // State
   State state_;
@@ -143,14 +143,19 @@ private:
   // Parameter
   PlannerParam planner_param_;
 
+  // objective areas of the lane, which only depend on the map and the parameters
+  std::vector<lanelet::CompoundPolygon3d> conflicting_areas_;
+  std::vector<lanelet::CompoundPolygon3d> detection_areas_;
+  std::vector<int> detection_area_lanelet_ids_;
+  // detection_areas_ in 2D, and their envelopes to skip the far objects
+  std::vector<Polygon2d> detection_polygons_;
+  std::vector<boost::geometry::model::box<Point2d>> detection_boxes_;
+
   /**
    * @brief check collision for all lanelet area & dynamic objects (call checkPathCollision() as
    * actual collision check algorithm inside this function)
    * @param lanelet_map_ptr  lanelet map
    * @param path             ego-car lane
-   * @param detection_areas  collision check is performed for vehicles that exist in this area
-   * @param detection_area_lanelet_ids  angle check is performed for obstacles using this lanelet
-   * ids
    * @param objects_ptr      target objects
    * @param closest_idx      ego-car position index on the lane
    * @return true if collision is detected
@@ -158,8 +163,6 @@ private:
   bool checkCollision(
     lanelet::LaneletMapConstPtr lanelet_map_ptr,
     const autoware_planning_msgs::msg::PathWithLaneId & path,
-    const std::vector<lanelet::CompoundPolygon3d> & detection_areas,
-    const std::vector<int> & detection_area_lanelet_ids,
     const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr objects_ptr,
     const int closest_idx);
 
@@ -192,14 +195,6 @@ private:
     const autoware_planning_msgs::msg::PathWithLaneId & path, const int closest_idx,
     const int start_idx, const double extra_dist, const double ignore_dist) const;
 
-  /**
-   * @brief Modify objects predicted path. remove path point if the time exceeds timer_thr.
-   * @param objects_ptr target objects
-   * @param time_thr    time threshold to cut path
-   */
-  void cutPredictPathWithDuration(
-    autoware_perception_msgs::msg::DynamicObjectArray * objects_ptr, const double time_thr) const;
-
   /**
    * @brief Calculate time that is needed for ego-vehicle to cross the intersection. (to be updated)
    * @param path              ego-car lane
@@ -233,16 +228,6 @@ private:
    */
   Polygon2d toFootprintPolygon(const autoware_perception_msgs::msg::DynamicObject & object) const;
 
-  /**
-   * @brief convert predicted object to footprint polygon
-   * @param object detected object
-   * @param predicted_pose predicted object pose
-   * @return 2d polygon of the object footprint
-   */
-  Polygon2d toPredictedFootprintPolygon(
-    const autoware_perception_msgs::msg::DynamicObject & object,
-    const geometry_msgs::msg::PoseWithCovarianceStamped & predicted_pose) const;
-
   /**
    * @brief Whether target autoware_api_msgs::Intersection::status is valid or not
    * @param target_status target autoware_api_msgs::Intersection::status
@@ -129,6 +129,9 @@ private:
   // Parameter
   PlannerParam planner_param_;
 
+  // conflicting areas of the lane, which only depend on the map and the parameters
+  std::vector<lanelet::CompoundPolygon3d> conflicting_areas_;
+
   StateMachine state_machine_;  //! for state
 
   // Debug
@@ -120,14 +120,14 @@ private:
   /**
    * @brief Calculate the polygon of the path from the ego-car position to the end of the
    * no stopping lanelet (+ extra distance).
-   * @param path           ego-car lane
+   * @param interpolated_path  ego-car lane interpolated by splineInterpolate
    * @param ego_pose       ego-car pose
    * @param margin         margin from the end point of the ego-no stopping area lane
    * @param extra_dist     extra distance from the end point of the no stopping area lanelet
    * @return generated polygon
    */
   Polygon2d generateEgoNoStoppingAreaLanePolygon(
-    const autoware_planning_msgs::msg::PathWithLaneId & path,
+    const autoware_planning_msgs::msg::PathWithLaneId & interpolated_path,
     const geometry_msgs::msg::Pose & ego_pose, const double margin, const double extra_dist) const;
 
   /**
@@ -174,6 +174,9 @@ private:
 
   // Key Feature
   const lanelet::autoware::NoStoppingArea & no_stopping_area_reg_elem_;
+  // the no stopping areas in 2D and their envelopes, built at launch since they are map-static
+  std::vector<lanelet::BasicPolygon2d> area_polygons_;
+  std::vector<boost::geometry::model::box<Point2d>> area_boxes_;
   std::shared_ptr<const rclcpp::Time> last_obstacle_found_time_;
 
   // Parameter
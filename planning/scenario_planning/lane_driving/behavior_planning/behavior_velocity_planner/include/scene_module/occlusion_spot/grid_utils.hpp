@@ -65,6 +65,26 @@ struct OcclusionSpot
 bool isOcclusionSpotSquare(
   OcclusionSpotSquare & occlusion_spot, const grid_map::Matrix & grid_data,
   const grid_map::Index & cell, const int side_size, const grid_map::Size & grid_size);
+//!< @brief Summed area table of the UNKNOWN cells in a rectangle of the grid, so that the UNKNOWN
+// cells of any range inside it are counted in constant time
+class UnknownCellCounter
+{
+public:
+  UnknownCellCounter(
+    const grid_map::Matrix & grid_data, const grid_map::Index & min_index,
+    const grid_map::Index & max_index);
+  //!< @brief number of UNKNOWN cells in [min_x, max_x] x [min_y, max_y] of the rectangle
+  int count(const int min_x, const int max_x, const int min_y, const int max_y) const;
+
+private:
+  grid_map::Index min_index_;
+  // (x + 1, y + 1) is the number of UNKNOWN cells in [0, x] x [0, y] from min_index_
+  Eigen::MatrixXi table_;
+};
+//!< @brief Same as above, with the UNKNOWN cells of the square counted by unknown_cell_counter
+bool isOcclusionSpotSquare(
+  OcclusionSpotSquare & occlusion_spot, const UnknownCellCounter & unknown_cell_counter,
+  const grid_map::Index & cell, const int side_size, const grid_map::Size & grid_size);
 //!< @brief Find all occlusion spots inside the given lanelet
 void findOcclusionSpots(
   std::vector<grid_map::Position> & occlusion_spot_positions, const grid_map::GridMap & grid,
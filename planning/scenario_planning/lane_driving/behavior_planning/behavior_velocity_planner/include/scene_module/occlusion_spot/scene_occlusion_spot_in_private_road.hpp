@@ -68,6 +68,12 @@ private:
   autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr dynamic_objects_array_;
   rclcpp::Publisher<nav_msgs::msg::OccupancyGrid>::SharedPtr publisher_;
 
+  // the occupancy grid is published at a lower rate than the planning, so the denoised grid of
+  // the last message is reused until a new one arrives
+  nav_msgs::msg::OccupancyGrid::ConstSharedPtr occ_grid_ptr_;
+  nav_msgs::msg::OccupancyGrid denoised_occ_grid_;
+  grid_map::GridMap grid_map_;
+
   // Parameter
   PlannerParam param_;
 
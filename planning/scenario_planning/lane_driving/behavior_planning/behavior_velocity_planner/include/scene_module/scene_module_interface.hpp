@@ -96,6 +96,12 @@ public:
 
   virtual const char * getModuleName() = 0;
 
+  // true when the modules only insert points and limit the velocity of the input path, so that
+  // the manager can run at the same time as the neighbouring ones and its result merged after.
+  // the managers reading the velocity inserted by the preceding ones, e.g. to find a prior stop
+  // line, keep the default and run on the path modified by them.
+  virtual bool canRunInParallel() const { return false; }
+
   boost::optional<int> getFirstStopPathPointIndex() { return first_stop_path_point_index_; }
 
   void updateSceneModuleInstances(
@@ -118,6 +124,9 @@ public:
     autoware_v2x_msgs::msg::InfrastructureCommandArray infrastructure_command_array;
     infrastructure_command_array.stamp = clock_->now();
 
+    // the markers are only built when someone looks at them
+    const bool is_debug_subscribed = pub_debug_->get_subscription_count() > 0;
+
     first_stop_path_point_index_ = static_cast<int>(path->points.size()) - 1;
     for (const auto & scene_module : scene_modules_) {
       autoware_planning_msgs::msg::StopReason stop_reason;
@@ -133,8 +142,10 @@ public:
         first_stop_path_point_index_ = scene_module->getFirstStopPathPointIndex();
       }
 
-      for (const auto & marker : scene_module->createDebugMarkerArray().markers) {
-        debug_marker_array.markers.push_back(marker);
+      if (is_debug_subscribed) {
+        for (const auto & marker : scene_module->createDebugMarkerArray().markers) {
+          debug_marker_array.markers.push_back(marker);
+        }
       }
     }
 
@@ -142,7 +153,9 @@ public:
       pub_stop_reason_->publish(stop_reason_array);
     }
     pub_infrastructure_commands_->publish(infrastructure_command_array);
-    pub_debug_->publish(debug_marker_array);
+    if (is_debug_subscribed) {
+      pub_debug_->publish(debug_marker_array);
+    }
   }
 
 protected:
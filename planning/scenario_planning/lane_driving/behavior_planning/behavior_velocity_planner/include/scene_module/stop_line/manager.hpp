@@ -33,6 +33,8 @@ public:
 
   const char * getModuleName() override { return "stop_line"; }
 
+  bool canRunInParallel() const override { return true; }
+
 private:
   StopLineModule::PlannerParam planner_param_;
   void launchNewModules(const autoware_planning_msgs::msg::PathWithLaneId & path) override;
@@ -33,6 +33,8 @@ public:
 
   const char * getModuleName() override { return "traffic_light"; }
 
+  bool canRunInParallel() const override { return true; }
+
   void modifyPathVelocity(autoware_planning_msgs::msg::PathWithLaneId * path) override;
 
 private:
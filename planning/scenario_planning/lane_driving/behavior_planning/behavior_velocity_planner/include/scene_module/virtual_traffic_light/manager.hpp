@@ -33,6 +33,8 @@ public:
 
   const char * getModuleName() override { return "virtual_traffic_light"; }
 
+  bool canRunInParallel() const override { return true; }
+
 private:
   VirtualTrafficLightModule::PlannerParam planner_param_;
   void launchNewModules(const autoware_planning_msgs::msg::PathWithLaneId & path) override;
@@ -0,0 +1,81 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILIZATION__POINTCLOUD_GRID_HPP_
+#define UTILIZATION__POINTCLOUD_GRID_HPP_
+
+#include <utilization/boost_geometry_helper.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace behavior_velocity_planner
+{
+/**
+ * @brief Pointcloud bucketed in a xy grid, built once for each pointcloud message and shared by
+ * the scene modules searching the points in their areas.
+ */
+class PointCloudGrid
+{
+public:
+  static constexpr double default_cell_size = 1.0;
+
+  /**
+   * @brief Cells of the grid inside and on the boundary of a polygon. Computed when a module is
+   * launched for its static areas, so that only the points of the boundary cells are checked
+   * against the polygon.
+   */
+  class PolygonMask
+  {
+  public:
+    explicit PolygonMask(const Polygon2d & polygon, const double cell_size = default_cell_size);
+
+  private:
+    friend PointCloudGrid;
+
+    Polygon2d polygon_;
+    double cell_size_;
+    std::vector<uint64_t> inner_cells_;
+    std::vector<uint64_t> boundary_cells_;
+  };
+
+  explicit PointCloudGrid(
+    const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
+    const double cell_size = default_cell_size);
+
+  std::vector<pcl::PointXYZ> findPointsWithin(const PolygonMask & mask) const;
+  bool hasPointWithin(const PolygonMask & mask) const;
+
+private:
+  // calls visit for each point within the mask until it returns false
+  void visitPointsWithin(
+    const PolygonMask & mask, const std::function<bool(const pcl::PointXYZ &)> & visit) const;
+  static int64_t getCellIndex(const double x, const double cell_size);
+  static uint64_t getCellKey(const int64_t cell_x, const int64_t cell_y);
+
+  double cell_size_;
+  // sorted by cell
+  std::vector<pcl::PointXYZ> points_;
+  // range of the points of each cell
+  std::unordered_map<uint64_t, std::pair<size_t, size_t>> cells_;
+};
+}  // namespace behavior_velocity_planner
+
+#endif  // UTILIZATION__POINTCLOUD_GRID_HPP_
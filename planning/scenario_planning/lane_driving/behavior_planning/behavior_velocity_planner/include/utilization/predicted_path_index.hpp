@@ -0,0 +1,187 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILIZATION__PREDICTED_PATH_INDEX_HPP_
+#define UTILIZATION__PREDICTED_PATH_INDEX_HPP_
+
+#include <rclcpp/time.hpp>
+#include <utilization/boost_geometry_helper.hpp>
+
+#include <autoware_perception_msgs/msg/dynamic_object_array.hpp>
+
+#include <boost/geometry.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace behavior_velocity_planner
+{
+/**
+ * @brief Predicted paths of the dynamic objects, built once for each objects message and shared
+ * by the scene modules. The points and segments of the paths are bucketed in a xy grid with the
+ * time they are reached, so that a module only checks its polygon against the parts of the paths
+ * in the cells it touches.
+ */
+class PredictedPathIndex
+{
+public:
+  struct Key
+  {
+    size_t object_idx;
+    size_t path_idx;
+    // the point, or the first point of the segment
+    size_t point_idx;
+  };
+
+  explicit PredictedPathIndex(
+    const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr & objects,
+    const double cell_size = 10.0);
+
+  const autoware_perception_msgs::msg::DynamicObjectArray & getObjects() const
+  {
+    return *objects_;
+  }
+
+  const std::vector<geometry_msgs::msg::PoseWithCovarianceStamped> & getPath(const Key & key) const
+  {
+    return objects_->objects.at(key.object_idx).state.predicted_paths.at(key.path_idx).path;
+  }
+
+  // footprint of the object at the predicted point
+  const Polygon2d & getFootprint(const Key & key) const
+  {
+    return footprints_.at(key.object_idx).at(key.path_idx).at(key.point_idx);
+  }
+
+  /**
+   * @brief The segments of the predicted paths intersecting the polygon and whose first point is
+   * reached before max_time. Sorted by object, path and point.
+   */
+  template <class Polygon>
+  std::vector<Key> findSegments(const Polygon & polygon, const rclcpp::Time & max_time) const
+  {
+    return find(segment_grid_, polygon, max_time, [this, &polygon](const Key & key) {
+      const auto & path = getPath(key);
+      // unlike a linestring, a segment is tested without allocating its points
+      const Segment2d segment{
+        to_bg2d(path.at(key.point_idx)), to_bg2d(path.at(key.point_idx + 1))};
+      return boost::geometry::intersects(polygon, segment);
+    });
+  }
+
+  /**
+   * @brief The points of the predicted paths within the polygon and reached before max_time.
+   * Sorted by object, path and point.
+   */
+  template <class Polygon>
+  std::vector<Key> findPoints(const Polygon & polygon, const rclcpp::Time & max_time) const
+  {
+    return find(point_grid_, polygon, max_time, [this, &polygon](const Key & key) {
+      return boost::geometry::within(to_bg2d(getPath(key).at(key.point_idx)), polygon);
+    });
+  }
+
+private:
+  using Box2d = boost::geometry::model::box<Point2d>;
+
+  struct Entry
+  {
+    Key key;
+    // of the stamp, to compare the entries with the time limit of a search cheaply
+    int64_t time_ns;
+    Box2d box;
+  };
+
+  struct Grid
+  {
+    // in the order of the keys
+    std::vector<Entry> entries;
+    // entries overlapping each cell
+    std::unordered_map<uint64_t, std::vector<size_t>> cells;
+  };
+
+  void insert(const Entry & entry, Grid * grid) const;
+  int64_t getCellIndex(const double x) const;
+  static uint64_t getCellKey(const int64_t cell_x, const int64_t cell_y);
+
+  template <class Polygon, class Predicate>
+  std::vector<Key> find(
+    const Grid & grid, const Polygon & polygon, const rclcpp::Time & max_time,
+    const Predicate & is_hit) const
+  {
+    Box2d box;
+    boost::geometry::envelope(polygon, box);
+    const int64_t cell_x_begin = getCellIndex(box.min_corner().x());
+    const int64_t cell_x_end = getCellIndex(box.max_corner().x());
+    const int64_t cell_y_begin = getCellIndex(box.min_corner().y());
+    const int64_t cell_y_end = getCellIndex(box.max_corner().y());
+
+    // a polygon larger than the paths is cheaper to check against all the entries
+    std::vector<size_t> candidates;
+    const auto cell_num = (cell_x_end - cell_x_begin + 1) * (cell_y_end - cell_y_begin + 1);
+    if (static_cast<size_t>(cell_num) > grid.entries.size()) {
+      candidates.resize(grid.entries.size());
+      for (size_t i = 0; i < candidates.size(); ++i) {
+        candidates.at(i) = i;
+      }
+    } else {
+      for (int64_t cell_x = cell_x_begin; cell_x <= cell_x_end; ++cell_x) {
+        for (int64_t cell_y = cell_y_begin; cell_y <= cell_y_end; ++cell_y) {
+          const auto it = grid.cells.find(getCellKey(cell_x, cell_y));
+          if (it != grid.cells.end()) {
+            candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+          }
+        }
+      }
+      // an entry overlapping several cells is listed in each of them
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+
+    const int64_t max_time_ns = max_time.nanoseconds();
+    std::vector<Key> keys;
+    for (const auto idx : candidates) {
+      const auto & entry = grid.entries.at(idx);
+      if (
+        entry.time_ns < max_time_ns && boost::geometry::intersects(entry.box, box) &&
+        is_hit(entry.key)) {
+        keys.push_back(entry.key);
+      }
+    }
+    return keys;
+  }
+
+  autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr objects_;
+  double cell_size_;
+  Grid point_grid_;
+  Grid segment_grid_;
+  // [object][path][point]
+  std::vector<std::vector<std::vector<Polygon2d>>> footprints_;
+};
+
+inline bool operator<(const PredictedPathIndex::Key & a, const PredictedPathIndex::Key & b)
+{
+  if (a.object_idx != b.object_idx) {
+    return a.object_idx < b.object_idx;
+  }
+  if (a.path_idx != b.path_idx) {
+    return a.path_idx < b.path_idx;
+  }
+  return a.point_idx < b.point_idx;
+}
+}  // namespace behavior_velocity_planner
+
+#endif  // UTILIZATION__PREDICTED_PATH_INDEX_HPP_
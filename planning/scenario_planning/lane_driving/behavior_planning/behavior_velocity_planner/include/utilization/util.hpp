@@ -140,6 +140,15 @@ LineString2d extendLine(
   const lanelet::ConstPoint3d & lanelet_point1, const lanelet::ConstPoint3d & lanelet_point2,
   const double & length);
 
+// arc length from the front of the path to each point
+std::vector<double> calcArcLengths(const autoware_planning_msgs::msg::PathWithLaneId & path);
+
+// merges the points inserted in path into merged, both planned from the same input path, and
+// limits the velocity of each point to the lower one of the two paths
+void mergePathVelocity(
+  const autoware_planning_msgs::msg::PathWithLaneId & path,
+  autoware_planning_msgs::msg::PathWithLaneId * merged);
+
 template <class T>
 std::vector<T> concatVector(const std::vector<T> & vec1, const std::vector<T> & vec2)
 {
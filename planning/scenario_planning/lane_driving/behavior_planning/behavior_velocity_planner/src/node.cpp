@@ -14,7 +14,7 @@
 
 #include "behavior_velocity_planner/node.hpp"
 
-#include <lanelet2_extension/utility/message_conversion.hpp>
+#include <planner_data_snapshot/lanelet_map_snapshot.hpp>
 #include <utilization/path_utilization.hpp>
 
 #include <diagnostic_msgs/msg/diagnostic_status.hpp>
@@ -82,9 +82,14 @@ BehaviorVelocityPlannerNode::BehaviorVelocityPlannerNode(const rclcpp::NodeOptio
     this->create_subscription<autoware_perception_msgs::msg::DynamicObjectArray>(
       "~/input/dynamic_objects", 1,
       std::bind(&BehaviorVelocityPlannerNode::onDynamicObjects, this, _1));
+  callback_group_sensor_ =
+    this->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  auto sensor_subscription_option = rclcpp::SubscriptionOptions();
+  sensor_subscription_option.callback_group = callback_group_sensor_;
   sub_no_ground_pointcloud_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
     "~/input/no_ground_pointcloud", rclcpp::SensorDataQoS(),
-    std::bind(&BehaviorVelocityPlannerNode::onNoGroundPointCloud, this, _1));
+    std::bind(&BehaviorVelocityPlannerNode::onNoGroundPointCloud, this, _1),
+    sensor_subscription_option);
   sub_vehicle_velocity_ = this->create_subscription<geometry_msgs::msg::TwistStamped>(
     "~/input/vehicle_velocity", 1,
     std::bind(&BehaviorVelocityPlannerNode::onVehicleVelocity, this, _1));
@@ -196,6 +201,7 @@ void BehaviorVelocityPlannerNode::onDynamicObjects(
   const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr msg)
 {
   planner_data_.dynamic_objects = msg;
+  planner_data_.predicted_path_index = std::make_shared<const PredictedPathIndex>(msg);
 }
 
 void BehaviorVelocityPlannerNode::onNoGroundPointCloud(
@@ -217,7 +223,12 @@ void BehaviorVelocityPlannerNode::onNoGroundPointCloud(
   pcl::PointCloud<pcl::PointXYZ>::Ptr pc_transformed(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::transformPointCloud(pc, *pc_transformed, affine);
 
-  planner_data_.no_ground_pointcloud = pc_transformed;
+  // hand over the pointcloud to onTrigger, which may run at the same time
+  auto no_ground_pointcloud = std::make_shared<NoGroundPointCloud>();
+  no_ground_pointcloud->pointcloud = pc_transformed;
+  no_ground_pointcloud->grid = std::make_shared<const PointCloudGrid>(pc_transformed);
+  std::atomic_store(
+    &no_ground_pointcloud_, std::shared_ptr<const NoGroundPointCloud>(no_ground_pointcloud));
 }
 
 void BehaviorVelocityPlannerNode::onVehicleVelocity(
@@ -246,33 +257,12 @@ void BehaviorVelocityPlannerNode::onVehicleVelocity(
 void BehaviorVelocityPlannerNode::onLaneletMap(
   const autoware_lanelet2_msgs::msg::MapBin::ConstSharedPtr msg)
 {
-  // Load map
-  planner_data_.lanelet_map = std::make_shared<lanelet::LaneletMap>();
-  lanelet::utils::conversion::fromBinMsg(
-    *msg, planner_data_.lanelet_map, &planner_data_.traffic_rules, &planner_data_.routing_graph);
-
-  // Build graph
-  {
-    using lanelet::Locations;
-    using lanelet::Participants;
-    using lanelet::routing::RoutingGraph;
-    using lanelet::routing::RoutingGraphConstPtr;
-    using lanelet::routing::RoutingGraphContainer;
-    using lanelet::traffic_rules::TrafficRulesFactory;
-
-    const auto traffic_rules =
-      TrafficRulesFactory::create(Locations::Germany, Participants::Vehicle);
-    const auto pedestrian_rules =
-      TrafficRulesFactory::create(Locations::Germany, Participants::Pedestrian);
-
-    RoutingGraphConstPtr vehicle_graph =
-      RoutingGraph::build(*planner_data_.lanelet_map, *traffic_rules);
-    RoutingGraphConstPtr pedestrian_graph =
-      RoutingGraph::build(*planner_data_.lanelet_map, *pedestrian_rules);
-    RoutingGraphContainer overall_graphs({vehicle_graph, pedestrian_graph});
-
-    planner_data_.overall_graphs = std::make_shared<const RoutingGraphContainer>(overall_graphs);
-  }
+  // Load map, shared with the planners composed in this process
+  const auto snapshot = planner_data_snapshot::LaneletMapSnapshotStore::getInstance().load(*msg);
+  planner_data_.lanelet_map = snapshot->lanelet_map;
+  planner_data_.traffic_rules = snapshot->traffic_rules;
+  planner_data_.routing_graph = snapshot->routing_graph;
+  planner_data_.overall_graphs = snapshot->overall_graphs;
 }
 
 void BehaviorVelocityPlannerNode::onTrafficLightStates(
@@ -318,6 +308,8 @@ void BehaviorVelocityPlannerNode::onVirtualTrafficLightStates(
 void BehaviorVelocityPlannerNode::onTrigger(
   const autoware_planning_msgs::msg::PathWithLaneId::ConstSharedPtr input_path_msg)
 {
+  latency_tracer_.onReceive(input_path_msg->header.stamp);
+
   // Check ready
   try {
     planner_data_.current_pose =
@@ -327,6 +319,11 @@ void BehaviorVelocityPlannerNode::onTrigger(
     return;
   }
 
+  if (const auto no_ground_pointcloud = std::atomic_load(&no_ground_pointcloud_)) {
+    planner_data_.no_ground_pointcloud = no_ground_pointcloud->pointcloud;
+    planner_data_.no_ground_pointcloud_grid = no_ground_pointcloud->grid;
+  }
+
   if (!isDataReady()) {
     return;
   }
@@ -350,6 +347,7 @@ void BehaviorVelocityPlannerNode::onTrigger(
   output_path_msg.drivable_area = input_path_msg->drivable_area;
 
   path_pub_->publish(output_path_msg);
+  latency_tracer_.onPublish(output_path_msg.header.stamp);
   stop_reason_diag_pub_->publish(planner_manager_.getStopReasonDiag());
 
   if (debug_viz_pub_->get_subscription_count() > 0) {
@@ -14,15 +14,23 @@
 
 #include "behavior_velocity_planner/planner_manager.hpp"
 
+#include <utilization/util.hpp>
+
 #include <boost/format.hpp>
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace behavior_velocity_planner
 {
 namespace
 {
+// tolerance of the arc lengths of the same point on the paths of different managers
+constexpr double epsilon = 1e-3;
+
 std::string jsonDumpsPose(const geometry_msgs::msg::Pose & pose)
 {
   const std::string json_dumps_pose =
@@ -61,24 +69,62 @@ autoware_planning_msgs::msg::PathWithLaneId BehaviorVelocityPlannerManager::plan
 {
   autoware_planning_msgs::msg::PathWithLaneId output_path_msg = input_path_msg;
 
-  int first_stop_path_point_index = static_cast<int>(output_path_msg.points.size() - 1);
+  // the managers insert points, so the first stop is kept as the arc length on the output path
+  const auto input_arc_lengths = planning_utils::calcArcLengths(input_path_msg);
+  double first_stop_arc_length = input_arc_lengths.empty() ? 0.0 : input_arc_lengths.back();
   std::string stop_reason_msg("path_end");
 
-  for (const auto & scene_manager_ptr : scene_manager_ptrs_) {
-    scene_manager_ptr->updateSceneModuleInstances(planner_data, input_path_msg);
-    scene_manager_ptr->modifyPathVelocity(&output_path_msg);
-    boost::optional<int> firstStopPathPointIndex = scene_manager_ptr->getFirstStopPathPointIndex();
+  size_t begin_idx = 0;
+  while (begin_idx < scene_manager_ptrs_.size()) {
+    // the consecutive managers that can run in parallel plan on copies of the same path
+    size_t end_idx = begin_idx + 1;
+    while (end_idx < scene_manager_ptrs_.size() &&
+           scene_manager_ptrs_.at(begin_idx)->canRunInParallel() &&
+           scene_manager_ptrs_.at(end_idx)->canRunInParallel()) {
+      ++end_idx;
+    }
+
+    std::vector<autoware_planning_msgs::msg::PathWithLaneId> paths(
+      end_idx - begin_idx, output_path_msg);
+#pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < paths.size(); ++i) {
+      const auto & scene_manager_ptr = scene_manager_ptrs_.at(begin_idx + i);
+      scene_manager_ptr->updateSceneModuleInstances(planner_data, input_path_msg);
+      scene_manager_ptr->modifyPathVelocity(&paths.at(i));
+    }
+
+    // merged in the launch order, so that the result does not depend on the scheduling
+    for (size_t i = 0; i < paths.size(); ++i) {
+      const auto & scene_manager_ptr = scene_manager_ptrs_.at(begin_idx + i);
+      const boost::optional<int> firstStopPathPointIndex =
+        scene_manager_ptr->getFirstStopPathPointIndex();
+      if (firstStopPathPointIndex && !paths.at(i).points.empty()) {
+        const double stop_arc_length =
+          planning_utils::calcArcLengths(paths.at(i)).at(firstStopPathPointIndex.get());
+        if (stop_arc_length < first_stop_arc_length - epsilon) {
+          first_stop_arc_length = stop_arc_length;
+          stop_reason_msg = scene_manager_ptr->getModuleName();
+        }
+      }
 
-    if (firstStopPathPointIndex) {
-      if (firstStopPathPointIndex.get() < first_stop_path_point_index) {
-        first_stop_path_point_index = firstStopPathPointIndex.get();
-        stop_reason_msg = scene_manager_ptr->getModuleName();
+      if (paths.size() == 1) {
+        output_path_msg = paths.front();
+      } else {
+        planning_utils::mergePathVelocity(paths.at(i), &output_path_msg);
       }
     }
+    begin_idx = end_idx;
   }
 
-  stop_reason_diag_ = makeStopReasonDiag(
-    stop_reason_msg, output_path_msg.points[first_stop_path_point_index].point.pose);
+  if (!output_path_msg.points.empty()) {
+    const auto arc_lengths = planning_utils::calcArcLengths(output_path_msg);
+    const auto first_stop_itr = std::lower_bound(
+      arc_lengths.begin(), arc_lengths.end() - 1, first_stop_arc_length - epsilon);
+    const auto first_stop_path_point_index =
+      static_cast<size_t>(std::distance(arc_lengths.begin(), first_stop_itr));
+    stop_reason_diag_ = makeStopReasonDiag(
+      stop_reason_msg, output_path_msg.points.at(first_stop_path_point_index).point.pose);
+  }
 
   return output_path_msg;
 }
@@ -85,8 +85,8 @@ void BlindSpotModuleManager::launchNewModules(
     }
 
     registerModule(std::make_shared<BlindSpotModule>(
-      module_id, lane_id, planner_data_, planner_param_, logger_.get_child("blind_spot_module"),
-      clock_));
+      module_id, lane_id, planner_data_, path, planner_param_,
+      logger_.get_child("blind_spot_module"), clock_));
   }
 }
 
@@ -38,8 +38,8 @@ namespace bg = boost::geometry;
 
 BlindSpotModule::BlindSpotModule(
   const int64_t module_id, const int64_t lane_id, std::shared_ptr<const PlannerData> planner_data,
-  const PlannerParam & planner_param, const rclcpp::Logger logger,
-  const rclcpp::Clock::SharedPtr clock)
+  const autoware_planning_msgs::msg::PathWithLaneId & path, const PlannerParam & planner_param,
+  const rclcpp::Logger logger, const rclcpp::Clock::SharedPtr clock)
 : SceneModuleInterface(module_id, logger, clock),
   lane_id_(lane_id),
   turn_direction_(TurnDirection::INVALID)
@@ -54,6 +54,11 @@ BlindSpotModule::BlindSpotModule(
   }
   has_traffic_light_ =
     !(assigned_lanelet.regulatoryElementsAs<const lanelet::TrafficLight>().empty());
+  intersection_length_ = lanelet::utils::getLaneletLength3d(assigned_lanelet);
+  blind_spot_lanelets_length_ = 0.0;
+  if (turn_direction_ != TurnDirection::INVALID) {
+    updateBlindSpotLanelets(planner_data->lanelet_map, path);
+  }
 }
 
 bool BlindSpotModule::modifyPathVelocity(
@@ -127,8 +132,10 @@ bool BlindSpotModule::modifyPathVelocity(
   const auto objects_ptr = planner_data_->dynamic_objects;
 
   /* calculate dynamic collision around detection area */
-  bool has_obstacle = checkObstacleInBlindSpot(
-    lanelet_map_ptr, routing_graph_ptr, *path, objects_ptr, closest_idx, stop_line_pose);
+  if (turn_direction_ != TurnDirection::INVALID) {
+    updateBlindSpotLanelets(lanelet_map_ptr, *path);
+  }
+  bool has_obstacle = checkObstacleInBlindSpot(*path, objects_ptr, closest_idx, stop_line_pose);
   state_machine_.setStateWithMarginTime(
     has_obstacle ? State::STOP : State::GO, logger_.get_child("state_machine"), *clock_);
 
@@ -259,23 +266,6 @@ bool BlindSpotModule::generateStopLine(
   return true;
 }
 
-void BlindSpotModule::cutPredictPathWithDuration(
-  autoware_perception_msgs::msg::DynamicObjectArray * objects_ptr, const double time_thr) const
-{
-  const rclcpp::Time current_time = clock_->now();
-  for (auto & object : objects_ptr->objects) {                    // each objects
-    for (auto & predicted_path : object.state.predicted_paths) {  // each predicted paths
-      std::vector<geometry_msgs::msg::PoseWithCovarianceStamped> vp;
-      for (auto & predicted_pose : predicted_path.path) {  // each path points
-        if ((rclcpp::Time(predicted_pose.header.stamp) - current_time).seconds() < time_thr) {
-          vp.push_back(predicted_pose);
-        }
-      }
-      predicted_path.path = vp;
-    }
-  }
-}
-
 int BlindSpotModule::insertPoint(
   const int insert_idx_ip, const autoware_planning_msgs::msg::PathWithLaneId path_ip,
   autoware_planning_msgs::msg::PathWithLaneId * inout_path) const
@@ -308,7 +298,6 @@ int BlindSpotModule::insertPoint(
 }
 
 bool BlindSpotModule::checkObstacleInBlindSpot(
-  lanelet::LaneletMapConstPtr lanelet_map_ptr, lanelet::routing::RoutingGraphPtr routing_graph_ptr,
   const autoware_planning_msgs::msg::PathWithLaneId & path,
   const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr objects_ptr,
   const int closest_idx, const geometry_msgs::msg::Pose & stop_line_pose) const
@@ -319,26 +308,39 @@ bool BlindSpotModule::checkObstacleInBlindSpot(
     return false;
   }
 
-  const auto areas_opt = generateBlindSpotPolygons(
-    lanelet_map_ptr, routing_graph_ptr, path, closest_idx, stop_line_pose);
+  const auto areas_opt = generateBlindSpotPolygons(path, closest_idx, stop_line_pose);
   if (!!areas_opt) {
     debug_data_.detection_area_for_blind_spot = areas_opt.get().detection_area;
     debug_data_.conflict_area_for_blind_spot = areas_opt.get().conflict_area;
 
-    autoware_perception_msgs::msg::DynamicObjectArray objects = *objects_ptr;
-    cutPredictPathWithDuration(&objects, planner_param_.max_future_movement_time);
+    // the predicted points in the conflict area before max_future_movement_time
+    const auto conflict_area_points = planner_data_->predicted_path_index->findPoints(
+      lanelet::utils::to2D(areas_opt.get().conflict_area).basicPolygon(),
+      clock_->now() + rclcpp::Duration::from_seconds(planner_param_.max_future_movement_time));
+
+    // the detection area in 2D, and its envelope to skip the far objects
+    auto detection_polygon =
+      toBoostPoly(lanelet::utils::to2D(areas_opt.get().detection_area).basicPolygon());
+    bg::correct(detection_polygon);
+    const auto detection_box = bg::return_envelope<bg::model::box<Point2d>>(detection_polygon);
 
     // check objects in blind spot areas
     bool obstacle_detected = false;
-    for (const auto & object : objects.objects) {
+    for (size_t object_idx = 0; object_idx < objects_ptr->objects.size(); ++object_idx) {
+      const auto & object = objects_ptr->objects.at(object_idx);
       if (!isTargetObjectType(object)) {
         continue;
       }
 
-      bool exist_in_detection_area = bg::within(
-        to_bg2d(object.state.pose_covariance.pose.position),
-        lanelet::utils::to2D(areas_opt.get().detection_area));
-      bool exist_in_conflict_area = isPredictedPathInArea(object, areas_opt.get().conflict_area);
+      const auto object_point = to_bg2d(object.state.pose_covariance.pose.position);
+      bool exist_in_detection_area = bg::covered_by(object_point, detection_box) &&
+                                     bg::within(object_point, detection_polygon);
+      bool exist_in_conflict_area = std::binary_search(
+        conflict_area_points.cbegin(), conflict_area_points.cend(),
+        PredictedPathIndex::Key{object_idx, 0, 0},
+        [](const PredictedPathIndex::Key & a, const PredictedPathIndex::Key & b) {
+          return a.object_idx < b.object_idx;
+        });
       if (exist_in_detection_area && exist_in_conflict_area) {
         obstacle_detected = true;
         debug_data_.conflicting_targets.objects.push_back(object);
@@ -350,23 +352,6 @@ bool BlindSpotModule::checkObstacleInBlindSpot(
   }
 }
 
-bool BlindSpotModule::isPredictedPathInArea(
-  const autoware_perception_msgs::msg::DynamicObject & object,
-  const lanelet::CompoundPolygon3d & area) const
-{
-  bool exist_in_conflict_area = false;
-  for (const auto & predicted_path : object.state.predicted_paths) {
-    for (const auto & predicted_point : predicted_path.path) {
-      exist_in_conflict_area =
-        bg::within(to_bg2d(predicted_point.pose.pose.position), lanelet::utils::to2D(area));
-      if (exist_in_conflict_area) {
-        return true;
-      }
-    }
-  }
-  return false;
-}
-
 lanelet::ConstLanelet BlindSpotModule::generateHalfLanelet(
   const lanelet::ConstLanelet lanelet) const
 {
@@ -396,14 +381,11 @@ lanelet::ConstLanelet BlindSpotModule::generateHalfLanelet(
   return std::move(half_lanelet);
 }
 
-boost::optional<BlindSpotPolygons> BlindSpotModule::generateBlindSpotPolygons(
+void BlindSpotModule::updateBlindSpotLanelets(
   lanelet::LaneletMapConstPtr lanelet_map_ptr,
-  [[maybe_unused]] lanelet::routing::RoutingGraphPtr routing_graph_ptr,
-  const autoware_planning_msgs::msg::PathWithLaneId & path, const int closest_idx,
-  const geometry_msgs::msg::Pose & stop_line_pose) const
+  const autoware_planning_msgs::msg::PathWithLaneId & path)
 {
   std::vector<int64_t> lane_ids;
-  lanelet::ConstLanelets blind_spot_lanelets;
   /* get lane ids until intersection */
   for (const auto & point : path.points) {
     lane_ids.push_back(point.lane_ids.front());
@@ -417,10 +399,16 @@ boost::optional<BlindSpotPolygons> BlindSpotModule::generateBlindSpotPolygons(
   /* reverse lane ids */
   std::reverse(lane_ids.begin(), lane_ids.end());
 
+  if (lane_ids.empty() || lane_ids == blind_spot_lane_ids_) {
+    return;
+  }
+  blind_spot_lane_ids_ = lane_ids;
+  blind_spot_lanelets_.clear();
+
   /* add intersection lanelet */
   const auto first_lanelet = lanelet_map_ptr->laneletLayer.get(lane_ids.front());
   const auto first_half_lanelet = generateHalfLanelet(first_lanelet);
-  blind_spot_lanelets.push_back(first_half_lanelet);
+  blind_spot_lanelets_.push_back(first_half_lanelet);
 
   if (lane_ids.size() > 1) {
     for (size_t i = 0; i < lane_ids.size() - 1; ++i) {
@@ -431,26 +419,36 @@ boost::optional<BlindSpotPolygons> BlindSpotModule::generateBlindSpotPolygons(
         break;
       }
       const auto half_lanelet = generateHalfLanelet(next_lanelet);
-      blind_spot_lanelets.push_back(half_lanelet);
+      blind_spot_lanelets_.push_back(half_lanelet);
     }
     /* reset order of lanelets */
-    std::reverse(blind_spot_lanelets.begin(), blind_spot_lanelets.end());
+    std::reverse(blind_spot_lanelets_.begin(), blind_spot_lanelets_.end());
+  }
+
+  blind_spot_lanelets_length_ = lanelet::utils::getLaneletLength3d(blind_spot_lanelets_);
+}
+
+boost::optional<BlindSpotPolygons> BlindSpotModule::generateBlindSpotPolygons(
+  const autoware_planning_msgs::msg::PathWithLaneId & path, const int closest_idx,
+  const geometry_msgs::msg::Pose & stop_line_pose) const
+{
+  if (blind_spot_lanelets_.empty()) {
+    return boost::none;
   }
 
+  /* only the cut by the ego pose changes every cycle */
   const auto current_arc =
-    lanelet::utils::getArcCoordinates(blind_spot_lanelets, path.points[closest_idx].point.pose);
-  const auto stop_line_arc = lanelet::utils::getArcCoordinates(blind_spot_lanelets, stop_line_pose);
-  const auto total_length = lanelet::utils::getLaneletLength3d(blind_spot_lanelets);
-  const auto intersection_length =
-    lanelet::utils::getLaneletLength3d(lanelet_map_ptr->laneletLayer.get(lane_id_));
+    lanelet::utils::getArcCoordinates(blind_spot_lanelets_, path.points[closest_idx].point.pose);
+  const auto stop_line_arc =
+    lanelet::utils::getArcCoordinates(blind_spot_lanelets_, stop_line_pose);
   const auto detection_area_start_length =
-    total_length - intersection_length - planner_param_.backward_length;
+    blind_spot_lanelets_length_ - intersection_length_ - planner_param_.backward_length;
   if (
     detection_area_start_length < current_arc.length && current_arc.length < stop_line_arc.length) {
     const auto conflict_area = lanelet::utils::getPolygonFromArcLength(
-      blind_spot_lanelets, current_arc.length, stop_line_arc.length);
+      blind_spot_lanelets_, current_arc.length, stop_line_arc.length);
     const auto detection_area = lanelet::utils::getPolygonFromArcLength(
-      blind_spot_lanelets, detection_area_start_length, current_arc.length);
+      blind_spot_lanelets_, detection_area_start_length, current_arc.length);
 
     BlindSpotPolygons blind_spot_polygons;
     blind_spot_polygons.conflict_area = conflict_area;
@@ -16,6 +16,7 @@
 #include <scene_module/crosswalk/scene_crosswalk.hpp>
 #include <utilization/util.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -25,6 +26,16 @@ namespace bg = boost::geometry;
 using Point = bg::model::d2::point_xy<double>;
 using Polygon = bg::model::polygon<Point>;
 using Line = bg::model::linestring<Point>;
+using Box = bg::model::box<Point>;
+
+namespace
+{
+// the bounding box of the polygon rejects most of the points before the exact test
+bool isWithin(const Point & point, const Polygon & polygon, const Box & box)
+{
+  return bg::covered_by(point, box) && bg::within(point, polygon);
+}
+}  // namespace
 
 CrosswalkModule::CrosswalkModule(
   const int64_t module_id, const lanelet::ConstLanelet & crosswalk,
@@ -36,6 +47,17 @@ CrosswalkModule::CrosswalkModule(
   state_(State::APPROACH)
 {
   planner_param_ = planner_param;
+
+  // create polygon
+  lanelet::CompoundPolygon3d lanelet_polygon = crosswalk_.polygon3d();
+  for (const auto & lanelet_point : lanelet_polygon) {
+    crosswalk_polygon_.outer().push_back(bg::make<Point>(lanelet_point.x(), lanelet_point.y()));
+  }
+  crosswalk_polygon_.outer().push_back(crosswalk_polygon_.outer().front());
+  if (!isClockWise(crosswalk_polygon_)) {
+    crosswalk_polygon_ = inverseClockWise(crosswalk_polygon_);
+  }
+  bg::envelope(crosswalk_polygon_, crosswalk_box_);
 }
 
 bool CrosswalkModule::modifyPathVelocity(
@@ -50,18 +72,11 @@ bool CrosswalkModule::modifyPathVelocity(
 
   const auto input = *path;
 
-  // create polygon
-  lanelet::CompoundPolygon3d lanelet_polygon = crosswalk_.polygon3d();
-  Polygon polygon;
-  for (const auto & lanelet_point : lanelet_polygon) {
-    polygon.outer().push_back(bg::make<Point>(lanelet_point.x(), lanelet_point.y()));
-  }
-  polygon.outer().push_back(polygon.outer().front());
-  polygon = isClockWise(polygon) ? polygon : inverseClockWise(polygon);
-
   // check state
   geometry_msgs::msg::PoseStamped self_pose = planner_data_->current_pose;
-  if (bg::within(Point(self_pose.pose.position.x, self_pose.pose.position.y), polygon)) {
+  if (isWithin(
+        Point(self_pose.pose.position.x, self_pose.pose.position.y), crosswalk_polygon_,
+        crosswalk_box_)) {
     state_ = State::INSIDE;
   } else if (state_ == State::INSIDE) {
     state_ = State::GO_OUT;
@@ -73,13 +88,12 @@ bool CrosswalkModule::modifyPathVelocity(
     const auto no_ground_pointcloud_ptr = planner_data_->no_ground_pointcloud;
 
     autoware_planning_msgs::msg::PathWithLaneId slow_path, stop_path;
-    if (!checkSlowArea(input, polygon, objects_ptr, no_ground_pointcloud_ptr, slow_path)) {
+    if (!checkSlowArea(input, objects_ptr, no_ground_pointcloud_ptr, slow_path)) {
       return false;
     }
 
     bool insert_stop;
-    if (!checkStopArea(
-          slow_path, polygon, objects_ptr, no_ground_pointcloud_ptr, stop_path, &insert_stop)) {
+    if (!checkStopArea(slow_path, objects_ptr, no_ground_pointcloud_ptr, stop_path, &insert_stop)) {
       return false;
     }
     // stop_path = slow_path;
@@ -97,7 +111,7 @@ bool CrosswalkModule::modifyPathVelocity(
 }
 
 bool CrosswalkModule::checkStopArea(
-  const autoware_planning_msgs::msg::PathWithLaneId & input, const Polygon & crosswalk_polygon,
+  const autoware_planning_msgs::msg::PathWithLaneId & input,
   const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr & objects_ptr,
   [[maybe_unused]] const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & no_ground_pointcloud_ptr,
   autoware_planning_msgs::msg::PathWithLaneId & output, bool * insert_stop)
@@ -115,9 +129,11 @@ bool CrosswalkModule::checkStopArea(
 
   // create stop area
   Polygon stop_polygon;
-  if (!createVehiclePathPolygonInCrosswalk(output, crosswalk_polygon, 1.0, stop_polygon)) {
+  if (!createVehiclePathPolygonInCrosswalk(output, 1.0, stop_polygon)) {
     return false;
   }
+  Box stop_box;
+  bg::envelope(stop_polygon, stop_box);
 
   // -- debug code --
   std::vector<Eigen::Vector3d> points;
@@ -140,43 +156,40 @@ bool CrosswalkModule::checkStopArea(
   //   }
   // }
 
+  // the pedestrians whose predicted path crosses the stop area before the time margin
+  const auto stop_area_segments = planner_data_->predicted_path_index->findSegments(
+    stop_polygon, current_time + rclcpp::Duration::from_seconds(
+                                   planner_param_.stop_dynamic_object_prediction_time_margin));
+  const auto is_crossing_stop_area = [&stop_area_segments](const size_t object_idx) {
+    return std::binary_search(
+      stop_area_segments.cbegin(), stop_area_segments.cend(),
+      PredictedPathIndex::Key{object_idx, 0, 0},
+      [](const PredictedPathIndex::Key & a, const PredictedPathIndex::Key & b) {
+        return a.object_idx < b.object_idx;
+      });
+  };
+
   // check pedestrian
-  for (const auto & object : objects_ptr->objects) {
+  for (size_t object_idx = 0; object_idx < objects_ptr->objects.size(); ++object_idx) {
     if (object_found) {
       break;
     }
 
+    const auto & object = objects_ptr->objects.at(object_idx);
     if (isTargetType(object)) {
       Point point(
         object.state.pose_covariance.pose.position.x, object.state.pose_covariance.pose.position.y);
-      if (!bg::within(point, crosswalk_polygon)) {
+      if (!isWithin(point, crosswalk_polygon_, crosswalk_box_)) {
         continue;
       }
-      if (bg::within(point, stop_polygon)) {
+      if (isWithin(point, stop_polygon, stop_box)) {
         pedestrian_found = true;
         debug_data_.stop_factor_points.emplace_back(object.state.pose_covariance.pose.position);
         break;
       }
-      for (const auto & object_path : object.state.predicted_paths) {
-        for (size_t k = 0; k < object_path.path.size() - 1; ++k) {
-          if (
-            (rclcpp::Time(object_path.path.at(k).header.stamp) - current_time).seconds() <
-            planner_param_.stop_dynamic_object_prediction_time_margin) {
-            const auto op0 = object_path.path.at(k).pose.pose.position;
-            const auto op1 = object_path.path.at(k + 1).pose.pose.position;
-            const Line line{{op0.x, op0.y}, {op1.x, op1.y}};
-            std::vector<Point> line_collision_points;
-            bg::intersection(stop_polygon, line, line_collision_points);
-            if (!line_collision_points.empty()) {
-              pedestrian_found = true;
-            }
-            if (pedestrian_found) {
-              debug_data_.stop_factor_points.emplace_back(
-                object.state.pose_covariance.pose.position);
-              break;
-            }
-          }
-        }
+      if (is_crossing_stop_area(object_idx)) {
+        pedestrian_found = true;
+        debug_data_.stop_factor_points.emplace_back(object.state.pose_covariance.pose.position);
       }
     }
   }
@@ -204,7 +217,7 @@ bool CrosswalkModule::checkStopArea(
       }
     } else {
       if (!insertTargetVelocityPoint(
-            input, crosswalk_polygon,
+            input, crosswalk_polygon_,
             planner_param_.stop_line_distance + planner_param_.stop_margin, 0.0, *planner_data_,
             output, debug_data_, first_stop_path_point_index_)) {
         return false;
@@ -216,7 +229,7 @@ bool CrosswalkModule::checkStopArea(
 }
 
 bool CrosswalkModule::checkSlowArea(
-  const autoware_planning_msgs::msg::PathWithLaneId & input, const Polygon & crosswalk_polygon,
+  const autoware_planning_msgs::msg::PathWithLaneId & input,
   const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr & objects_ptr,
   [[maybe_unused]] const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & no_ground_pointcloud_ptr,
   autoware_planning_msgs::msg::PathWithLaneId & output)
@@ -230,9 +243,11 @@ bool CrosswalkModule::checkSlowArea(
   const bool external_go = isTargetExternalInputStatus(autoware_api_msgs::msg::CrosswalkStatus::GO);
 
   Polygon slowdown_polygon;
-  if (!createVehiclePathPolygonInCrosswalk(output, crosswalk_polygon, 4.0, slowdown_polygon)) {
+  if (!createVehiclePathPolygonInCrosswalk(output, 4.0, slowdown_polygon)) {
     return false;
   }
+  Box slowdown_box;
+  bg::envelope(slowdown_polygon, slowdown_box);
 
   // -- debug code --
   std::vector<Eigen::Vector3d> points;
@@ -250,10 +265,10 @@ bool CrosswalkModule::checkSlowArea(
     if (isTargetType(object)) {
       Point point(
         object.state.pose_covariance.pose.position.x, object.state.pose_covariance.pose.position.y);
-      if (!bg::within(point, crosswalk_polygon)) {
+      if (!isWithin(point, crosswalk_polygon_, crosswalk_box_)) {
         continue;
       }
-      if (bg::within(point, slowdown_polygon)) {
+      if (isWithin(point, slowdown_polygon, slowdown_box)) {
         pedestrian_found = true;
       }
     }
@@ -292,22 +307,21 @@ bool CrosswalkModule::checkSlowArea(
   return true;
 }
 bool CrosswalkModule::createVehiclePathPolygonInCrosswalk(
-  const autoware_planning_msgs::msg::PathWithLaneId & input, const Polygon & crosswalk_polygon,
-  const float extended_width, Polygon & path_polygon)
+  const autoware_planning_msgs::msg::PathWithLaneId & input, const float extended_width,
+  Polygon & path_polygon)
 {
   std::vector<Point> path_collision_points;
-  for (size_t i = 0; i < input.points.size() - 1; ++i) {
-    const auto p0 = input.points.at(i).point.pose.position;
-    const auto p1 = input.points.at(i + 1).point.pose.position;
-    const Line line{{p0.x, p0.y}, {p1.x, p1.y}};
-    std::vector<Point> line_collision_points;
-    bg::intersection(crosswalk_polygon, line, line_collision_points);
-    if (line_collision_points.empty()) {
+  for (size_t i = 0; i + 1 < input.points.size(); ++i) {
+    const auto & p0 = input.points.at(i).point.pose.position;
+    const auto & p1 = input.points.at(i + 1).point.pose.position;
+    // most of the segments are away from the crosswalk
+    const Box segment_box{
+      {std::min(p0.x, p1.x), std::min(p0.y, p1.y)}, {std::max(p0.x, p1.x), std::max(p0.y, p1.y)}};
+    if (bg::disjoint(segment_box, crosswalk_box_)) {
       continue;
     }
-    for (size_t j = 0; j < line_collision_points.size(); ++j) {
-      path_collision_points.push_back(line_collision_points.at(j));
-    }
+    // the points are appended to path_collision_points
+    bg::intersection(crosswalk_polygon_, Line{{p0.x, p0.y}, {p1.x, p1.y}}, path_collision_points);
   }
   if (path_collision_points.size() != 2) {
     RCLCPP_ERROR_THROTTLE(
@@ -353,7 +367,7 @@ bool CrosswalkModule::createVehiclePathPolygonInCrosswalk(
                              : inverseClockWise(candidate_path_polygon);
 
   std::vector<Polygon> path_polygons;
-  bg::intersection(crosswalk_polygon, candidate_path_polygon, path_polygons);
+  bg::intersection(crosswalk_polygon_, candidate_path_polygon, path_polygons);
 
   if (path_polygons.size() != 1) {
     RCLCPP_ERROR_THROTTLE(
@@ -267,6 +267,10 @@ DetectionAreaModule::DetectionAreaModule(
   state_(State::GO),
   planner_param_(planner_param)
 {
+  for (const auto & detection_area : detection_area_reg_elem_.detectionAreas()) {
+    detection_area_masks_.emplace_back(
+      toBoostPoly(lanelet::utils::to2D(detection_area).basicPolygon()));
+  }
 }
 
 LineString2d DetectionAreaModule::getStopLineGeometry2d() const
@@ -383,14 +387,11 @@ std::vector<geometry_msgs::msg::Point> DetectionAreaModule::getObstaclePoints()
 {
   std::vector<geometry_msgs::msg::Point> obstacle_points;
 
-  const auto detection_areas = detection_area_reg_elem_.detectionAreas();
-  const auto & points = *(planner_data_->no_ground_pointcloud);
+  const auto & grid = *(planner_data_->no_ground_pointcloud_grid);
 
-  for (const auto & detection_area : detection_areas) {
-    for (const auto p : points) {
-      if (bg::within(Point2d{p.x, p.y}, lanelet::utils::to2D(detection_area).basicPolygon())) {
-        obstacle_points.push_back(planning_utils::toRosPoint(p));
-      }
+  for (const auto & detection_area_mask : detection_area_masks_) {
+    for (const auto & p : grid.findPointsWithin(detection_area_mask)) {
+      obstacle_points.push_back(planning_utils::toRosPoint(p));
     }
   }
 
@@ -25,6 +25,7 @@
 #include <lanelet2_core/primitives/BasicRegulatoryElements.h>
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -65,6 +66,24 @@ IntersectionModule::IntersectionModule(
   has_traffic_light_ =
     !(assigned_lanelet.regulatoryElementsAs<const lanelet::TrafficLight>().empty());
   state_machine_.setMarginTime(planner_param_.state_transit_margin_time);
+
+  /* get detection area and conflicting area */
+  std::vector<lanelet::ConstLanelets> detection_area_lanelets;
+  std::vector<lanelet::ConstLanelets> conflicting_area_lanelets;
+  util::getObjectiveLanelets(
+    planner_data->lanelet_map, planner_data->routing_graph, lane_id_, planner_param_,
+    &conflicting_area_lanelets, &detection_area_lanelets, logger_);
+  conflicting_areas_ = util::getPolygon3dFromLaneletsVec(
+    conflicting_area_lanelets, planner_param_.detection_area_length);
+  detection_areas_ = util::getPolygon3dFromLaneletsVec(
+    detection_area_lanelets, planner_param_.detection_area_length);
+  detection_area_lanelet_ids_ = util::getLaneletIdsFromLaneletsVec(detection_area_lanelets);
+  for (const auto & detection_area : detection_areas_) {
+    detection_polygons_.push_back(
+      toBoostPoly(lanelet::utils::to2D(detection_area).basicPolygon()));
+    detection_boxes_.push_back(
+      bg::return_envelope<bg::model::box<Point2d>>(detection_polygons_.back()));
+  }
 }
 
 bool IntersectionModule::modifyPathVelocity(
@@ -91,36 +110,20 @@ bool IntersectionModule::modifyPathVelocity(
 
   /* get lanelet map */
   const auto lanelet_map_ptr = planner_data_->lanelet_map;
-  const auto routing_graph_ptr = planner_data_->routing_graph;
 
-  /* get detection area and conflicting area */
-  std::vector<lanelet::ConstLanelets> detection_area_lanelets;
-  std::vector<lanelet::ConstLanelets> conflicting_area_lanelets;
-
-  util::getObjectiveLanelets(
-    lanelet_map_ptr, routing_graph_ptr, lane_id_, planner_param_, &conflicting_area_lanelets,
-    &detection_area_lanelets, logger_);
-  std::vector<lanelet::CompoundPolygon3d> conflicting_areas = util::getPolygon3dFromLaneletsVec(
-    conflicting_area_lanelets, planner_param_.detection_area_length);
-  std::vector<lanelet::CompoundPolygon3d> detection_areas = util::getPolygon3dFromLaneletsVec(
-    detection_area_lanelets, planner_param_.detection_area_length);
-  std::vector<int> conflicting_area_lanelet_ids =
-    util::getLaneletIdsFromLaneletsVec(conflicting_area_lanelets);
-  std::vector<int> detection_area_lanelet_ids =
-    util::getLaneletIdsFromLaneletsVec(detection_area_lanelets);
-
-  if (detection_areas.empty()) {
+  /* detection area and conflicting area are computed at the launch of the module */
+  if (detection_areas_.empty()) {
     RCLCPP_DEBUG(logger_, "no detection area. skip computation.");
     return true;
   }
-  debug_data_.detection_area = detection_areas;
+  debug_data_.detection_area = detection_areas_;
 
   /* set stop-line and stop-judgement-line for base_link */
   int stop_line_idx = -1;
   int pass_judge_line_idx = -1;
   int first_idx_inside_lane = -1;
   if (!util::generateStopLine(
-        lane_id_, conflicting_areas, planner_data_, planner_param_, path, *path, &stop_line_idx,
+        lane_id_, conflicting_areas_, planner_data_, planner_param_, path, *path, &stop_line_idx,
         &pass_judge_line_idx, &first_idx_inside_lane, logger_.get_child("util"))) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(logger_, *clock_, 1000 /* ms */, "setStopLineIdx fail");
     RCLCPP_DEBUG(logger_, "===== plan end =====");
@@ -157,8 +160,7 @@ bool IntersectionModule::modifyPathVelocity(
   const auto objects_ptr = planner_data_->dynamic_objects;
 
   /* calculate dynamic collision around detection area */
-  bool has_collision = checkCollision(
-    lanelet_map_ptr, *path, detection_areas, detection_area_lanelet_ids, objects_ptr, closest_idx);
+  bool has_collision = checkCollision(lanelet_map_ptr, *path, objects_ptr, closest_idx);
   bool is_stuck = checkStuckVehicleInIntersection(
     lanelet_map_ptr, *path, closest_idx, stop_line_idx, objects_ptr);
   bool is_entry_prohibited = (has_collision || is_stuck);
@@ -205,28 +207,9 @@ bool IntersectionModule::modifyPathVelocity(
   return true;
 }
 
-void IntersectionModule::cutPredictPathWithDuration(
-  autoware_perception_msgs::msg::DynamicObjectArray * objects_ptr, const double time_thr) const
-{
-  const rclcpp::Time current_time = clock_->now();
-  for (auto & object : objects_ptr->objects) {                    // each objects
-    for (auto & predicted_path : object.state.predicted_paths) {  // each predicted paths
-      std::vector<geometry_msgs::msg::PoseWithCovarianceStamped> vp;
-      for (auto & predicted_pose : predicted_path.path) {  // each path points
-        if ((rclcpp::Time(predicted_pose.header.stamp) - current_time).seconds() < time_thr) {
-          vp.push_back(predicted_pose);
-        }
-      }
-      predicted_path.path = vp;
-    }
-  }
-}
-
 bool IntersectionModule::checkCollision(
   lanelet::LaneletMapConstPtr lanelet_map_ptr,
   const autoware_planning_msgs::msg::PathWithLaneId & path,
-  const std::vector<lanelet::CompoundPolygon3d> & detection_areas,
-  const std::vector<int> & detection_area_lanelet_ids,
   const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr objects_ptr,
   const int closest_idx)
 {
@@ -240,8 +223,9 @@ bool IntersectionModule::checkCollision(
   debug_data_.ego_lane_polygon = toGeomMsg(ego_poly);
 
   /* extract target objects */
-  autoware_perception_msgs::msg::DynamicObjectArray target_objects;
-  for (const auto & object : objects_ptr->objects) {
+  std::vector<size_t> target_object_indices;
+  for (size_t object_idx = 0; object_idx < objects_ptr->objects.size(); ++object_idx) {
+    const auto & object = objects_ptr->objects.at(object_idx);
     // ignore non-vehicle type objects, such as pedestrian.
     if (!isTargetCollisionVehicleType(object)) {
       continue;
@@ -257,18 +241,20 @@ bool IntersectionModule::checkCollision(
     // keep vehicle in detection_area
     const Point2d obj_point(
       object.state.pose_covariance.pose.position.x, object.state.pose_covariance.pose.position.y);
-    for (const auto & detection_area : detection_areas) {
-      const auto detection_poly = lanelet::utils::to2D(detection_area).basicPolygon();
-      const double dist_to_detection_area =
-        boost::geometry::distance(obj_point, toBoostPoly(detection_poly));
+    for (size_t i = 0; i < detection_polygons_.size(); ++i) {
+      // the distance to the envelope is a lower bound of the distance to the polygon
+      if (bg::distance(obj_point, detection_boxes_.at(i)) > planner_param_.detection_area_margin) {
+        continue;
+      }
+      const double dist_to_detection_area = bg::distance(obj_point, detection_polygons_.at(i));
       if (dist_to_detection_area > planner_param_.detection_area_margin) {
         // ignore the object far from detection area
         continue;
       }
       // check direction of objects
       const auto object_direction = getObjectPoseWithVelocityDirection(object.state);
-      if (checkAngleForTargetLanelets(object_direction, detection_area_lanelet_ids)) {
-        target_objects.objects.push_back(object);
+      if (checkAngleForTargetLanelets(object_direction, detection_area_lanelet_ids_)) {
+        target_object_indices.push_back(object_idx);
         break;
       }
     }
@@ -276,10 +262,20 @@ bool IntersectionModule::checkCollision(
 
   /* check collision between target_objects predicted path and ego lane */
 
-  // cut the predicted path at passing_time
+  // only the predicted path before passing_time, as the segments of the shared predicted path
+  // index in the ego lane
   const auto time_distance_array = calcIntersectionPassingTime(path, closest_idx, lane_id_);
   const double passing_time = time_distance_array.back().first;
-  cutPredictPathWithDuration(&target_objects, passing_time);
+  const rclcpp::Time passing_end_time =
+    clock_->now() + rclcpp::Duration::from_seconds(passing_time);
+  const auto & predicted_path_index = *planner_data_->predicted_path_index;
+  std::vector<PredictedPathIndex::Key> ego_lane_segments;
+  for (const auto & key : predicted_path_index.findSegments(ego_poly, passing_end_time)) {
+    const auto & next_point = predicted_path_index.getPath(key).at(key.point_idx + 1);
+    if (rclcpp::Time(next_point.header.stamp) < passing_end_time) {
+      ego_lane_segments.push_back(key);
+    }
+  }
 
   lanelet::ConstLanelets ego_lane_with_next_lane = getEgoLaneWithNextLane(lanelet_map_ptr, path);
   const auto closest_arc_coords = getArcCoordinates(
@@ -290,27 +286,28 @@ bool IntersectionModule::checkCollision(
 
   // check collision between predicted_path and ego_area
   bool collision_detected = false;
-  for (const auto & object : target_objects.objects) {
-    bool has_collision = false;
-    for (const auto & predicted_path : object.state.predicted_paths) {
+  for (const auto object_idx : target_object_indices) {
+    const auto & object = objects_ptr->objects.at(object_idx);
+    for (size_t path_idx = 0; path_idx < object.state.predicted_paths.size(); ++path_idx) {
+      const auto & predicted_path = object.state.predicted_paths.at(path_idx);
       if (predicted_path.confidence < planner_param_.min_predicted_path_confidence) {
         // ignore the predicted path with too low confidence
         continue;
       }
-      has_collision = bg::intersects(ego_poly, to_bg2d(predicted_path.path));
+      const auto path_segments = std::equal_range(
+        ego_lane_segments.cbegin(), ego_lane_segments.cend(),
+        PredictedPathIndex::Key{object_idx, path_idx, 0},
+        [](const PredictedPathIndex::Key & a, const PredictedPathIndex::Key & b) {
+          return a.object_idx < b.object_idx ||
+                 (a.object_idx == b.object_idx && a.path_idx < b.path_idx);
+        });
+      const bool has_collision = path_segments.first != path_segments.second;
       if (has_collision) {
-        const auto first_itr = std::adjacent_find(
-          predicted_path.path.cbegin(), predicted_path.path.cend(),
-          [&ego_poly](const auto & a, const auto & b) {
-            return bg::intersects(ego_poly, LineString2d{to_bg2d(a), to_bg2d(b)});
-          });
-        const auto last_itr = std::adjacent_find(
-          predicted_path.path.crbegin(), predicted_path.path.crend(),
-          [&ego_poly](const auto & a, const auto & b) {
-            return bg::intersects(ego_poly, LineString2d{to_bg2d(a), to_bg2d(b)});
-          });
+        // from the first point of the first segment to the last point of the last segment
+        const size_t first_idx = path_segments.first->point_idx;
+        const size_t last_idx = std::prev(path_segments.second)->point_idx + 1;
         const double ref_object_enter_time =
-          (rclcpp::Time((*first_itr).header.stamp) -
+          (rclcpp::Time(predicted_path.path.at(first_idx).header.stamp) -
            rclcpp::Time(predicted_path.path.front().header.stamp))
             .seconds();
         auto start_time_distance_itr = time_distance_array.begin();
@@ -323,9 +320,10 @@ bool IntersectionModule::checkCollision(
             continue;
           }
         }
-        const double ref_object_exit_time = (rclcpp::Time((*last_itr).header.stamp) -
-                                             rclcpp::Time(predicted_path.path.front().header.stamp))
-                                              .seconds();
+        const double ref_object_exit_time =
+          (rclcpp::Time(predicted_path.path.at(last_idx).header.stamp) -
+           rclcpp::Time(predicted_path.path.front().header.stamp))
+            .seconds();
         auto end_time_distance_itr = std::lower_bound(
           time_distance_array.begin(), time_distance_array.end(),
           ref_object_exit_time + planner_param_.collision_end_margin_time,
@@ -351,8 +349,9 @@ bool IntersectionModule::checkCollision(
 
         debug_data_.candidate_collision_ego_lane_polygon = toGeomMsg(polygon);
 
-        for (auto itr = first_itr; itr != last_itr.base(); ++itr) {
-          const auto footprint_polygon = toPredictedFootprintPolygon(object, *itr);
+        for (size_t point_idx = first_idx; point_idx <= last_idx; ++point_idx) {
+          const auto & footprint_polygon =
+            predicted_path_index.getFootprint({object_idx, path_idx, point_idx});
           debug_data_.candidate_collision_object_polygons.emplace_back(
             toGeomMsg(footprint_polygon));
           if (bg::intersects(polygon, footprint_polygon)) {
@@ -503,13 +502,6 @@ Polygon2d IntersectionModule::toFootprintPolygon(
   return obj_footprint;
 }
 
-Polygon2d IntersectionModule::toPredictedFootprintPolygon(
-  const autoware_perception_msgs::msg::DynamicObject & object,
-  const geometry_msgs::msg::PoseWithCovarianceStamped & predicted_pose) const
-{
-  return obj2polygon(predicted_pose.pose.pose, object.shape.dimensions);
-}
-
 bool IntersectionModule::isTargetCollisionVehicleType(
   const autoware_perception_msgs::msg::DynamicObject & object) const
 {
@@ -34,13 +34,22 @@ namespace bg = boost::geometry;
 
 MergeFromPrivateRoadModule::MergeFromPrivateRoadModule(
   const int64_t module_id, const int64_t lane_id,
-  [[maybe_unused]] std::shared_ptr<const PlannerData> planner_data,
-  const PlannerParam & planner_param, const rclcpp::Logger logger,
-  const rclcpp::Clock::SharedPtr clock)
+  std::shared_ptr<const PlannerData> planner_data, const PlannerParam & planner_param,
+  const rclcpp::Logger logger, const rclcpp::Clock::SharedPtr clock)
 : SceneModuleInterface(module_id, logger, clock), lane_id_(lane_id)
 {
   planner_param_ = planner_param;
   state_machine_.setState(State::STOP);
+
+  /* get detection area */
+  std::vector<lanelet::ConstLanelets> detection_area_lanelets;
+  std::vector<lanelet::ConstLanelets> conflicting_area_lanelets;
+  util::getObjectiveLanelets(
+    planner_data->lanelet_map, planner_data->routing_graph, lane_id_,
+    planner_param_.intersection_param, &conflicting_area_lanelets, &detection_area_lanelets,
+    logger_);
+  conflicting_areas_ = util::getPolygon3dFromLaneletsVec(
+    conflicting_area_lanelets, planner_param_.intersection_param.detection_area_length);
 }
 
 bool MergeFromPrivateRoadModule::modifyPathVelocity(
@@ -60,24 +69,12 @@ bool MergeFromPrivateRoadModule::modifyPathVelocity(
   /* get current pose */
   geometry_msgs::msg::PoseStamped current_pose = planner_data_->current_pose;
 
-  /* get lanelet map */
-  const auto lanelet_map_ptr = planner_data_->lanelet_map;
-  const auto routing_graph_ptr = planner_data_->routing_graph;
-
-  /* get detection area */
-  std::vector<lanelet::ConstLanelets> detection_area_lanelets;
-  std::vector<lanelet::ConstLanelets> conflicting_area_lanelets;
-
-  util::getObjectiveLanelets(
-    lanelet_map_ptr, routing_graph_ptr, lane_id_, planner_param_.intersection_param,
-    &conflicting_area_lanelets, &detection_area_lanelets, logger_);
-  std::vector<lanelet::CompoundPolygon3d> conflicting_areas = util::getPolygon3dFromLaneletsVec(
-    conflicting_area_lanelets, planner_param_.intersection_param.detection_area_length);
-  if (conflicting_areas.empty()) {
+  /* detection area is computed at the launch of the module */
+  if (conflicting_areas_.empty()) {
     RCLCPP_DEBUG(logger_, "no detection area. skip computation.");
     return true;
   }
-  debug_data_.detection_area = conflicting_areas;
+  debug_data_.detection_area = conflicting_areas_;
 
   /* set stop-line and stop-judgement-line for base_link */
   int stop_line_idx = -1;
@@ -86,7 +83,7 @@ bool MergeFromPrivateRoadModule::modifyPathVelocity(
   const auto private_path =
     extractPathNearExitOfPrivateRoad(*path, planner_data_->vehicle_info_.vehicle_length_m);
   if (!util::generateStopLine(
-        lane_id_, conflicting_areas, planner_data_, planner_param_.intersection_param, path,
+        lane_id_, conflicting_areas_, planner_data_, planner_param_.intersection_param, path,
         private_path, &stop_line_idx, &judge_line_idx, &first_idx_inside_lane,
         logger_.get_child("util"))) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(logger_, *clock_, 1000 /* ms */, "setStopLineIdx fail");
@@ -119,6 +119,12 @@ NoStoppingAreaModule::NoStoppingAreaModule(
 {
   state_machine_.setState(StateMachine::State::GO);
   state_machine_.setMarginTime(planner_param_.state_clear_time);
+
+  for (const auto & no_stopping_area : no_stopping_area_reg_elem_.noStoppingAreas()) {
+    area_polygons_.push_back(lanelet::utils::to2D(no_stopping_area).basicPolygon());
+    area_boxes_.push_back(
+      bg::return_envelope<bg::model::box<Point2d>>(toBoostPoly(area_polygons_.back())));
+  }
 }
 
 boost::optional<LineString2d> NoStoppingAreaModule::getStopLineGeometry2d(
@@ -143,13 +149,15 @@ boost::optional<LineString2d> NoStoppingAreaModule::getStopLineGeometry2d(
      *        ---------------
      **/
 
-    for (const auto & no_stopping_area : no_stopping_area_reg_elem_.noStoppingAreas()) {
-      const auto & area_poly = lanelet::utils::to2D(no_stopping_area).basicPolygon();
-      lanelet::BasicLineString2d path_line;
+    for (size_t area_idx = 0; area_idx < area_polygons_.size(); ++area_idx) {
+      const auto & area_poly = area_polygons_.at(area_idx);
       for (size_t i = 0; i < path.points.size() - 1; ++i) {
         const auto p0 = path.points.at(i).point.pose.position;
         const auto p1 = path.points.at(i + 1).point.pose.position;
         const LineString2d line{{p0.x, p0.y}, {p1.x, p1.y}};
+        if (bg::disjoint(area_boxes_.at(area_idx), Segment2d{line.front(), line.back()})) {
+          continue;
+        }
         std::vector<Point2d> collision_points;
         bg::intersection(area_poly, line, collision_points);
         if (collision_points.empty()) {
@@ -208,15 +216,21 @@ bool NoStoppingAreaModule::modifyPathVelocity(
   }
   const auto & vi = planner_data_->vehicle_info_;
   const double margin = planner_param_.stop_line_margin;
+  // both detect areas are generated on the same interpolated path
+  const double interpolation_interval = 0.5;
+  autoware_planning_msgs::msg::PathWithLaneId interpolated_path;
+  if (!splineInterpolate(*path, interpolation_interval, &interpolated_path, logger_)) {
+    return true;
+  }
   const double ego_space_in_front_of_stuck_vehicle =
     margin + vi.vehicle_length_m + planner_param_.stuck_vehicle_front_margin;
   const Polygon2d stuck_vehicle_detect_area = generateEgoNoStoppingAreaLanePolygon(
-    *path, current_pose.pose, ego_space_in_front_of_stuck_vehicle,
+    interpolated_path, current_pose.pose, ego_space_in_front_of_stuck_vehicle,
     planner_param_.detection_area_length);
   const double ego_space_in_front_of_stop_line =
     margin + planner_param_.stop_margin + vi.rear_overhang_m;
   const Polygon2d stop_line_detect_area = generateEgoNoStoppingAreaLanePolygon(
-    *path, current_pose.pose, ego_space_in_front_of_stop_line,
+    interpolated_path, current_pose.pose, ego_space_in_front_of_stop_line,
     planner_param_.detection_area_length);
   if (stuck_vehicle_detect_area.outer().empty() && stop_line_detect_area.outer().empty()) {
     return true;
@@ -276,6 +290,10 @@ bool NoStoppingAreaModule::checkStuckVehiclesInNoStoppingArea(
   const Polygon2d & poly,
   const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr & dynamic_obj_arr_ptr)
 {
+  if (poly.outer().empty()) {
+    return false;
+  }
+  const auto poly_box = bg::return_envelope<bg::model::box<Point2d>>(poly);
   // stuck points by dynamic objects
   for (const auto & object : dynamic_obj_arr_ptr->objects) {
     if (!isTargetStuckVehicleType(object)) {
@@ -287,7 +305,9 @@ bool NoStoppingAreaModule::checkStuckVehiclesInNoStoppingArea(
     }
     // check if the footprint is in the stuck detect area
     const Polygon2d obj_footprint = planning_utils::toFootprintPolygon(object);
-    const bool is_in_stuck_area = !bg::disjoint(obj_footprint, poly);
+    const bool is_in_stuck_area =
+      !bg::disjoint(bg::return_envelope<bg::model::box<Point2d>>(obj_footprint), poly_box) &&
+      !bg::disjoint(obj_footprint, poly);
     if (is_in_stuck_area) {
       RCLCPP_DEBUG(logger_, "stuck vehicle found.");
       for (const auto p : obj_footprint.outer()) {
@@ -305,6 +325,10 @@ bool NoStoppingAreaModule::checkStuckVehiclesInNoStoppingArea(
 bool NoStoppingAreaModule::checkStopLinesInNoStoppingArea(
   const autoware_planning_msgs::msg::PathWithLaneId & path, const Polygon2d & poly)
 {
+  if (poly.outer().empty()) {
+    return false;
+  }
+  const auto poly_box = bg::return_envelope<bg::model::box<Point2d>>(poly);
   const double stop_vel = std::numeric_limits<float>::min();
   // stuck points by stop line
   for (size_t i = 0; i < path.points.size() - 1; ++i) {
@@ -316,6 +340,9 @@ bool NoStoppingAreaModule::checkStopLinesInNoStoppingArea(
       continue;
     }
     const LineString2d line{{p0.x, p0.y}, {p1.x, p1.y}};
+    if (bg::disjoint(poly_box, Segment2d{line.front(), line.back()})) {
+      continue;
+    }
     std::vector<Point2d> collision_points;
     bg::intersection(poly, line, collision_points);
     if (!collision_points.empty()) {
@@ -331,18 +358,13 @@ bool NoStoppingAreaModule::checkStopLinesInNoStoppingArea(
 }
 
 Polygon2d NoStoppingAreaModule::generateEgoNoStoppingAreaLanePolygon(
-  const autoware_planning_msgs::msg::PathWithLaneId & path,
+  const autoware_planning_msgs::msg::PathWithLaneId & interpolated_path,
   const geometry_msgs::msg::Pose & ego_pose, const double margin, const double extra_dist) const
 {
   Polygon2d ego_area;  // open polygon
   double dist_from_start_sum = 0.0;
-  const double interpolation_interval = 0.5;
   bool is_in_area = false;
-  autoware_planning_msgs::msg::PathWithLaneId interpolated_path;
-  if (!splineInterpolate(path, interpolation_interval, &interpolated_path, logger_)) {
-    return ego_area;
-  }
-  auto & pp = interpolated_path.points;
+  const auto & pp = interpolated_path.points;
   /* calc closest index */
   int closest_idx = -1;
   if (!planning_utils::calcClosestIndex<autoware_planning_msgs::msg::PathWithLaneId>(
@@ -354,14 +376,19 @@ Polygon2d NoStoppingAreaModule::generateEgoNoStoppingAreaLanePolygon(
   size_t ego_area_start_idx = closest_idx + num_ignore_nearest;
   size_t ego_area_end_idx = ego_area_start_idx;
   // return if area size is not intentional
-  if (no_stopping_area_reg_elem_.noStoppingAreas().size() != 1) {
+  if (area_polygons_.size() != 1) {
     return ego_area;
   }
-  const auto no_stopping_area = no_stopping_area_reg_elem_.noStoppingAreas().front();
+  const auto & area_polygon = area_polygons_.front();
+  const auto & area_box = area_boxes_.front();
+  const auto isInArea = [&area_polygon, &area_box](const geometry_msgs::msg::Point & p) {
+    const Point2d point{p.x, p.y};
+    return bg::covered_by(point, area_box) && bg::within(point, area_polygon);
+  };
   for (size_t i = closest_idx + num_ignore_nearest; i < pp.size() - 1; ++i) {
     dist_from_start_sum += planning_utils::calcDist2d(pp.at(i), pp.at(i - 1));
     const auto & p = pp.at(i).point.pose.position;
-    if (bg::within(Point2d{p.x, p.y}, lanelet::utils::to2D(no_stopping_area).basicPolygon())) {
+    if (isInArea(p)) {
       is_in_area = true;
       break;
     }
@@ -382,7 +409,7 @@ Polygon2d NoStoppingAreaModule::generateEgoNoStoppingAreaLanePolygon(
   for (size_t i = ego_area_start_idx; i < pp.size() - 1; ++i) {
     dist_from_start_sum += planning_utils::calcDist2d(pp.at(i), pp.at(i - 1));
     const auto & p = pp.at(i).point.pose.position;
-    if (!bg::within(Point2d{p.x, p.y}, lanelet::utils::to2D(no_stopping_area).basicPolygon())) {
+    if (!isInArea(p)) {
       dist_from_area_sum += planning_utils::calcDist2d(pp.at(i), pp.at(i - 1));
     }
     if (dist_from_start_sum > extra_dist || dist_from_area_sum > margin) {
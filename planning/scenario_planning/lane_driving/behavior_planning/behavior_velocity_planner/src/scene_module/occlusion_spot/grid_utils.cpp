@@ -22,37 +22,39 @@ namespace behavior_velocity_planner
 {
 namespace grid_utils
 {
+namespace
+{
+/**
+ * @brief range of the square in the grid
+ *   (min_x,min_y)...(max_x,min_y)
+ *        .               .
+ *   (min_x,max_y)...(max_x,max_y)
+ */
+void getSquareRange(
+  const grid_map::Index & cell, const int side_size, const grid_map::Size & grid_size,
+  grid_map::Index * min_index, grid_map::Index * max_index)
+{
+  const int offset = side_size - 1;
+  // Ensure we stay inside the grid
+  *min_index = {std::max(0, cell.x()), std::max(0, cell.y() - offset)};
+  *max_index = {
+    std::min(grid_size.x() - 1, cell.x() + offset), std::min(grid_size.y() - 1, cell.y())};
+}
+}  // namespace
+
 bool isOcclusionSpotSquare(
   OcclusionSpotSquare & occlusion_spot, const grid_map::Matrix & grid_data,
   const grid_map::Index & cell, int side_size, const grid_map::Size & grid_size)
 {
-  // Calculate ranges to check
-  int min_x;
-  int max_x;
-  int min_y;
-  int max_y;
   // No occlusion_spot with size 0
   if (side_size == 0) {
     return false;
   }
-  /**
-   * @brief
-   *   (min_x,min_y)...(max_x,min_y)
-   *        .               .
-   *   (min_x,max_y)...(max_x,max_y)
-   */
-  const int offset = side_size - 1;
-  min_x = cell.x();
-  max_x = cell.x() + offset;
-  min_y = cell.y() - offset;
-  max_y = cell.y();
-  // Ensure we stay inside the grid
-  min_x = std::max(0, min_x);
-  max_x = std::min(grid_size.x() - 1, max_x);
-  min_y = std::max(0, min_y);
-  max_y = std::min(grid_size.y() - 1, max_y);
-  for (int x = min_x; x <= max_x; ++x) {
-    for (int y = min_y; y <= max_y; ++y) {
+  grid_map::Index min_index;
+  grid_map::Index max_index;
+  getSquareRange(cell, side_size, grid_size, &min_index, &max_index);
+  for (int x = min_index.x(); x <= max_index.x(); ++x) {
+    for (int y = min_index.y(); y <= max_index.y(); ++y) {
       // if the value is not unknown value return false
       if (grid_data(x, y) != grid_utils::occlusion_cost_value::UNKNOWN) {
         return false;
@@ -64,6 +66,57 @@ bool isOcclusionSpotSquare(
   return true;
 }
 
+UnknownCellCounter::UnknownCellCounter(
+  const grid_map::Matrix & grid_data, const grid_map::Index & min_index,
+  const grid_map::Index & max_index)
+: min_index_(min_index),
+  table_(Eigen::MatrixXi::Zero(
+    std::max(0, max_index.x() - min_index.x() + 1) + 1,
+    std::max(0, max_index.y() - min_index.y() + 1) + 1))
+{
+  for (int x = 1; x < table_.rows(); ++x) {
+    for (int y = 1; y < table_.cols(); ++y) {
+      const bool is_unknown = grid_data(min_index_.x() + x - 1, min_index_.y() + y - 1) ==
+                              grid_utils::occlusion_cost_value::UNKNOWN;
+      table_(x, y) = table_(x - 1, y) + table_(x, y - 1) - table_(x - 1, y - 1) +
+                     (is_unknown ? 1 : 0);
+    }
+  }
+}
+
+int UnknownCellCounter::count(
+  const int min_x, const int max_x, const int min_y, const int max_y) const
+{
+  const int x0 = min_x - min_index_.x();
+  const int x1 = max_x - min_index_.x() + 1;
+  const int y0 = min_y - min_index_.y();
+  const int y1 = max_y - min_index_.y() + 1;
+  return table_(x1, y1) - table_(x0, y1) - table_(x1, y0) + table_(x0, y0);
+}
+
+bool isOcclusionSpotSquare(
+  OcclusionSpotSquare & occlusion_spot, const UnknownCellCounter & unknown_cell_counter,
+  const grid_map::Index & cell, const int side_size, const grid_map::Size & grid_size)
+{
+  // No occlusion_spot with size 0
+  if (side_size == 0) {
+    return false;
+  }
+  grid_map::Index min_index;
+  grid_map::Index max_index;
+  getSquareRange(cell, side_size, grid_size, &min_index, &max_index);
+  const int cell_num =
+    (max_index.x() - min_index.x() + 1) * (max_index.y() - min_index.y() + 1);
+  if (
+    unknown_cell_counter.count(min_index.x(), max_index.x(), min_index.y(), max_index.y()) !=
+    cell_num) {
+    return false;
+  }
+  occlusion_spot.side_size = side_size;
+  occlusion_spot.index = cell;
+  return true;
+}
+
 void findOcclusionSpots(
   std::vector<grid_map::Position> & occlusion_spot_positions, const grid_map::GridMap & grid,
   const lanelet::BasicPolygon2d & polygon, double min_size)
@@ -74,10 +127,32 @@ void findOcclusionSpots(
   for (const auto & point : polygon) {
     grid_polygon.addVertex({point.x(), point.y()});
   }
+  std::vector<grid_map::Index> cells;
   for (grid_map::PolygonIterator iterator(grid, grid_polygon); !iterator.isPastEnd(); ++iterator) {
+    cells.push_back(*iterator);
+  }
+  if (cells.empty() || min_occlusion_spot_size == 0) {
+    return;
+  }
+
+  // the summed area table only covers the squares of the cells in the polygon
+  grid_map::Index min_index = cells.front();
+  grid_map::Index max_index = cells.front();
+  for (const auto & cell : cells) {
+    grid_map::Index square_min_index;
+    grid_map::Index square_max_index;
+    getSquareRange(
+      cell, min_occlusion_spot_size, grid.getSize(), &square_min_index, &square_max_index);
+    min_index = min_index.min(square_min_index);
+    max_index = max_index.max(square_max_index);
+  }
+  const UnknownCellCounter unknown_cell_counter(grid_data, min_index, max_index);
+
+  for (const auto & cell : cells) {
     OcclusionSpotSquare occlusion_spot_square;
     if (isOcclusionSpotSquare(
-          occlusion_spot_square, grid_data, *iterator, min_occlusion_spot_size, grid.getSize())) {
+          occlusion_spot_square, unknown_cell_counter, cell, min_occlusion_spot_size,
+          grid.getSize())) {
       if (!grid.getPosition(occlusion_spot_square.index, occlusion_spot_square.position)) {
         continue;
       }
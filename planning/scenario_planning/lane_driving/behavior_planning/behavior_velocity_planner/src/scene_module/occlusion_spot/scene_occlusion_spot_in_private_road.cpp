@@ -82,11 +82,14 @@ bool OcclusionSpotInPrivateModule::modifyPathVelocity(
   if (interp_path.points.size() < 4) {
     return true;
   }
-  nav_msgs::msg::OccupancyGrid occ_grid = *occ_grid_ptr;
-  grid_map::GridMap grid_map;
-  grid_utils::denoiseOccupancyGridCV(occ_grid, grid_map, param_.grid);
-  if (param_.show_debug_grid) {
-    publisher_->publish(occ_grid);
+  if (occ_grid_ptr != occ_grid_ptr_) {
+    occ_grid_ptr_ = occ_grid_ptr;
+    denoised_occ_grid_ = *occ_grid_ptr;
+    grid_map_ = grid_map::GridMap();
+    grid_utils::denoiseOccupancyGridCV(denoised_occ_grid_, grid_map_, param_.grid);
+  }
+  if (param_.show_debug_grid && publisher_->get_subscription_count() > 0) {
+    publisher_->publish(denoised_occ_grid_);
   }
   std::vector<occlusion_spot_utils::PossibleCollisionInfo> possible_collisions;
   const double offset_from_ego_to_target =
@@ -95,7 +98,7 @@ bool OcclusionSpotInPrivateModule::modifyPathVelocity(
   RCLCPP_DEBUG_STREAM_THROTTLE(
     logger_, *clock_, 3000, "offset_from_ego_to_target : " << offset_from_ego_to_target);
   occlusion_spot_utils::generatePossibleCollisions(
-    possible_collisions, interp_path, grid_map, offset_from_ego_to_closest,
+    possible_collisions, interp_path, grid_map_, offset_from_ego_to_closest,
     offset_from_closest_to_target, param_, debug_data_.sidewalks);
   RCLCPP_DEBUG_STREAM_THROTTLE(
     logger_, *clock_, 3000, "num possible collision:" << possible_collisions.size());
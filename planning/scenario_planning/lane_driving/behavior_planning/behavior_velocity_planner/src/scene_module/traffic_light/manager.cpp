@@ -87,6 +87,7 @@ void TrafficLightModuleManager::modifyPathVelocity(
   stop_reason_array.header.stamp = path->header.stamp;
   first_stop_path_point_index_ = static_cast<int>(path->points.size() - 1);
   first_ref_stop_path_point_index_ = static_cast<int>(path->points.size() - 1);
+  const bool is_debug_subscribed = pub_debug_->get_subscription_count() > 0;
   for (const auto & scene_module : scene_modules_) {
     autoware_planning_msgs::msg::StopReason stop_reason;
     std::shared_ptr<TrafficLightModule> traffic_light_scene_module(
@@ -108,14 +109,18 @@ void TrafficLightModuleManager::modifyPathVelocity(
         tl_state = traffic_light_scene_module->getTrafficLightState();
       }
     }
-    for (const auto & marker : traffic_light_scene_module->createDebugMarkerArray().markers) {
-      debug_marker_array.markers.push_back(marker);
+    if (is_debug_subscribed) {
+      for (const auto & marker : traffic_light_scene_module->createDebugMarkerArray().markers) {
+        debug_marker_array.markers.push_back(marker);
+      }
     }
   }
   if (!stop_reason_array.stop_reasons.empty()) {
     pub_stop_reason_->publish(stop_reason_array);
   }
-  pub_debug_->publish(debug_marker_array);
+  if (is_debug_subscribed) {
+    pub_debug_->publish(debug_marker_array);
+  }
   pub_tl_state_->publish(tl_state);
 }
 
@@ -0,0 +1,156 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utilization/pointcloud_grid.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace behavior_velocity_planner
+{
+namespace bg = boost::geometry;
+
+PointCloudGrid::PolygonMask::PolygonMask(const Polygon2d & polygon, const double cell_size)
+: polygon_(polygon), cell_size_(cell_size)
+{
+  if (polygon_.outer().size() < 3) {
+    return;
+  }
+  bg::correct(polygon_);
+
+  bg::model::box<Point2d> box;
+  bg::envelope(polygon_, box);
+  const int64_t cell_x_end = getCellIndex(box.max_corner().x(), cell_size_);
+  const int64_t cell_y_end = getCellIndex(box.max_corner().y(), cell_size_);
+  for (int64_t cell_x = getCellIndex(box.min_corner().x(), cell_size_); cell_x <= cell_x_end;
+       ++cell_x) {
+    for (int64_t cell_y = getCellIndex(box.min_corner().y(), cell_size_); cell_y <= cell_y_end;
+         ++cell_y) {
+      const double x0 = static_cast<double>(cell_x) * cell_size_;
+      const double y0 = static_cast<double>(cell_y) * cell_size_;
+      const double x1 = x0 + cell_size_;
+      const double y1 = y0 + cell_size_;
+      const Polygon2d cell{{{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}}};
+      if (bg::within(cell, polygon_)) {
+        inner_cells_.push_back(getCellKey(cell_x, cell_y));
+      } else if (bg::intersects(cell, polygon_)) {
+        boundary_cells_.push_back(getCellKey(cell_x, cell_y));
+      }
+    }
+  }
+}
+
+PointCloudGrid::PointCloudGrid(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud, const double cell_size)
+: cell_size_(cell_size)
+{
+  // count the points of each cell, then place them in the range of their cell
+  std::vector<uint64_t> keys;
+  keys.reserve(pointcloud->size());
+  for (const auto & p : pointcloud->points) {
+    if (!std::isfinite(p.x) || !std::isfinite(p.y)) {
+      keys.push_back(0);
+      continue;
+    }
+    const uint64_t key =
+      getCellKey(getCellIndex(p.x, cell_size_), getCellIndex(p.y, cell_size_));
+    keys.push_back(key);
+    ++cells_[key].second;
+  }
+
+  size_t begin_idx = 0;
+  for (auto & cell : cells_) {
+    const size_t point_num = cell.second.second;
+    cell.second = {begin_idx, begin_idx};
+    begin_idx += point_num;
+  }
+
+  points_.resize(begin_idx);
+  for (size_t i = 0; i < pointcloud->size(); ++i) {
+    const auto & p = pointcloud->points.at(i);
+    if (!std::isfinite(p.x) || !std::isfinite(p.y)) {
+      continue;
+    }
+    points_.at(cells_.at(keys.at(i)).second++) = p;
+  }
+}
+
+std::vector<pcl::PointXYZ> PointCloudGrid::findPointsWithin(const PolygonMask & mask) const
+{
+  std::vector<pcl::PointXYZ> points;
+  visitPointsWithin(mask, [&points](const pcl::PointXYZ & p) {
+    points.push_back(p);
+    return true;
+  });
+  return points;
+}
+
+bool PointCloudGrid::hasPointWithin(const PolygonMask & mask) const
+{
+  bool has_point = false;
+  visitPointsWithin(mask, [&has_point](const pcl::PointXYZ &) {
+    has_point = true;
+    return false;
+  });
+  return has_point;
+}
+
+void PointCloudGrid::visitPointsWithin(
+  const PolygonMask & mask, const std::function<bool(const pcl::PointXYZ &)> & visit) const
+{
+  // the cells of a mask made for another grid do not match
+  if (mask.cell_size_ != cell_size_) {
+    for (const auto & p : points_) {
+      if (bg::within(Point2d{p.x, p.y}, mask.polygon_) && !visit(p)) {
+        return;
+      }
+    }
+    return;
+  }
+
+  for (const auto key : mask.inner_cells_) {
+    const auto it = cells_.find(key);
+    if (it == cells_.end()) {
+      continue;
+    }
+    for (size_t i = it->second.first; i < it->second.second; ++i) {
+      if (!visit(points_.at(i))) {
+        return;
+      }
+    }
+  }
+  for (const auto key : mask.boundary_cells_) {
+    const auto it = cells_.find(key);
+    if (it == cells_.end()) {
+      continue;
+    }
+    for (size_t i = it->second.first; i < it->second.second; ++i) {
+      const auto & p = points_.at(i);
+      if (bg::within(Point2d{p.x, p.y}, mask.polygon_) && !visit(p)) {
+        return;
+      }
+    }
+  }
+}
+
+int64_t PointCloudGrid::getCellIndex(const double x, const double cell_size)
+{
+  return static_cast<int64_t>(std::floor(x / cell_size));
+}
+
+uint64_t PointCloudGrid::getCellKey(const int64_t cell_x, const int64_t cell_y)
+{
+  return (static_cast<uint64_t>(cell_x) << 32) ^ (static_cast<uint64_t>(cell_y) & 0xffffffff);
+}
+}  // namespace behavior_velocity_planner
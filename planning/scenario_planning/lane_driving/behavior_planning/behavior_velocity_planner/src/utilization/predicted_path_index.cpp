@@ -0,0 +1,77 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utilization/predicted_path_index.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace behavior_velocity_planner
+{
+PredictedPathIndex::PredictedPathIndex(
+  const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr & objects,
+  const double cell_size)
+: objects_(objects), cell_size_(cell_size)
+{
+  footprints_.resize(objects_->objects.size());
+  for (size_t object_idx = 0; object_idx < objects_->objects.size(); ++object_idx) {
+    const auto & object = objects_->objects.at(object_idx);
+    footprints_.at(object_idx).resize(object.state.predicted_paths.size());
+    for (size_t path_idx = 0; path_idx < object.state.predicted_paths.size(); ++path_idx) {
+      const auto & path = object.state.predicted_paths.at(path_idx).path;
+      auto & footprints = footprints_.at(object_idx).at(path_idx);
+      footprints.reserve(path.size());
+      for (size_t point_idx = 0; point_idx < path.size(); ++point_idx) {
+        const Key key{object_idx, path_idx, point_idx};
+        const auto point = to_bg2d(path.at(point_idx));
+        const int64_t time_ns = rclcpp::Time(path.at(point_idx).header.stamp).nanoseconds();
+        footprints.push_back(obj2polygon(path.at(point_idx).pose.pose, object.shape.dimensions));
+        insert(Entry{key, time_ns, Box2d{point, point}}, &point_grid_);
+
+        if (point_idx + 1 < path.size()) {
+          const auto next_point = to_bg2d(path.at(point_idx + 1));
+          const Box2d box{
+            {std::min(point.x(), next_point.x()), std::min(point.y(), next_point.y())},
+            {std::max(point.x(), next_point.x()), std::max(point.y(), next_point.y())}};
+          insert(Entry{key, time_ns, box}, &segment_grid_);
+        }
+      }
+    }
+  }
+}
+
+void PredictedPathIndex::insert(const Entry & entry, Grid * grid) const
+{
+  const int64_t cell_x_end = getCellIndex(entry.box.max_corner().x());
+  const int64_t cell_y_end = getCellIndex(entry.box.max_corner().y());
+  for (int64_t cell_x = getCellIndex(entry.box.min_corner().x()); cell_x <= cell_x_end; ++cell_x) {
+    for (int64_t cell_y = getCellIndex(entry.box.min_corner().y()); cell_y <= cell_y_end;
+         ++cell_y) {
+      grid->cells[getCellKey(cell_x, cell_y)].push_back(grid->entries.size());
+    }
+  }
+  grid->entries.push_back(entry);
+}
+
+int64_t PredictedPathIndex::getCellIndex(const double x) const
+{
+  return static_cast<int64_t>(std::floor(x / cell_size_));
+}
+
+uint64_t PredictedPathIndex::getCellKey(const int64_t cell_x, const int64_t cell_y)
+{
+  return (static_cast<uint64_t>(cell_x) << 32) ^ (static_cast<uint64_t>(cell_y) & 0xffffffff);
+}
+}  // namespace behavior_velocity_planner
@@ -295,5 +295,64 @@ LineString2d extendLine(
   return {
     {(p1 - length * t).x(), (p1 - length * t).y()}, {(p2 + length * t).x(), (p2 + length * t).y()}};
 }
+
+std::vector<double> calcArcLengths(const autoware_planning_msgs::msg::PathWithLaneId & path)
+{
+  std::vector<double> arc_lengths;
+  arc_lengths.reserve(path.points.size());
+  for (size_t i = 0; i < path.points.size(); ++i) {
+    arc_lengths.push_back(
+      i == 0 ? 0.0 : arc_lengths.back() + calcDist2d(path.points.at(i - 1), path.points.at(i)));
+  }
+  return arc_lengths;
+}
+
+void mergePathVelocity(
+  const autoware_planning_msgs::msg::PathWithLaneId & path,
+  autoware_planning_msgs::msg::PathWithLaneId * merged)
+{
+  // the points of both paths at the same arc length are the same point of the input path
+  constexpr double epsilon = 1e-3;
+  const auto arc_lengths = calcArcLengths(path);
+  const auto merged_arc_lengths = calcArcLengths(*merged);
+  const auto getVelocity = [](const autoware_planning_msgs::msg::PathPointWithLaneId & p) {
+    return p.point.twist.linear.x;
+  };
+
+  // the velocity of a point holds until the next one, so a point only in one path is limited by
+  // the previous point of the other one
+  std::vector<autoware_planning_msgs::msg::PathPointWithLaneId> points;
+  points.reserve(path.points.size() + merged->points.size());
+  size_t i = 0;
+  size_t j = 0;
+  while (i < path.points.size() || j < merged->points.size()) {
+    const bool is_in_path =
+      i < path.points.size() &&
+      (j == merged->points.size() || arc_lengths.at(i) < merged_arc_lengths.at(j) + epsilon);
+    const bool is_in_merged =
+      j < merged->points.size() &&
+      (i == path.points.size() || merged_arc_lengths.at(j) < arc_lengths.at(i) + epsilon);
+
+    auto point = is_in_merged ? merged->points.at(j) : path.points.at(i);
+    if (is_in_path && is_in_merged) {
+      point.point.twist.linear.x = std::min(getVelocity(point), getVelocity(path.points.at(i)));
+    } else if (is_in_merged && i > 0) {
+      point.point.twist.linear.x =
+        std::min(getVelocity(point), getVelocity(path.points.at(i - 1)));
+    } else if (is_in_path && j > 0) {
+      point.point.twist.linear.x =
+        std::min(getVelocity(point), getVelocity(merged->points.at(j - 1)));
+    }
+    points.push_back(point);
+
+    if (is_in_path) {
+      ++i;
+    }
+    if (is_in_merged) {
+      ++j;
+    }
+  }
+  merged->points = points;
+}
 }  // namespace planning_utils
 }  // namespace behavior_velocity_planner
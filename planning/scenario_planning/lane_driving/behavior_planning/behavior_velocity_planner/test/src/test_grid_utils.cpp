@@ -207,6 +207,52 @@ TEST(isOcclusionSpotSquare, many_cells_occlusion_spot)
   }
 }
 
+TEST(isOcclusionSpotSquare, unknown_cell_counter)
+{
+  using behavior_velocity_planner::grid_utils::isOcclusionSpotSquare;
+  using behavior_velocity_planner::grid_utils::OcclusionSpotSquare;
+  using behavior_velocity_planner::grid_utils::UnknownCellCounter;
+  using behavior_velocity_planner::grid_utils::occlusion_cost_value::UNKNOWN;
+  // pseudo random unknown cells, the counted squares must give the same result as the scan
+  grid_map::GridMap grid = test::generateGrid(12, 10, 1.0);
+  for (int i = 0; i < grid.getSize().x(); ++i) {
+    for (int j = 0; j < grid.getSize().y(); ++j) {
+      if ((i * 7 + j * 13) % 5 != 0 && (i + j) % 7 != 0) {
+        grid.at("layer", grid_map::Index(i, j)) = UNKNOWN;
+      }
+    }
+  }
+  const grid_map::Index min_index(0, 0);
+  const grid_map::Index max_index(grid.getSize().x() - 1, grid.getSize().y() - 1);
+  const UnknownCellCounter unknown_cell_counter(grid["layer"], min_index, max_index);
+  for (int size = 0; size <= 4; ++size) {
+    for (int i = 0; i < grid.getSize().x(); ++i) {
+      for (int j = 0; j < grid.getSize().y(); ++j) {
+        OcclusionSpotSquare occlusion_spot;
+        const bool expected =
+          isOcclusionSpotSquare(occlusion_spot, grid["layer"], {i, j}, size, grid.getSize());
+        const bool found =
+          isOcclusionSpotSquare(occlusion_spot, unknown_cell_counter, {i, j}, size, grid.getSize());
+        ASSERT_EQ(found, expected) << "i: " << i << " j: " << j << " size: " << size;
+      }
+    }
+  }
+
+  // the table of a part of the grid counts the cells of this part only
+  const UnknownCellCounter partial_counter(grid["layer"], {3, 2}, {8, 6});
+  for (int min_x = 3; min_x <= 8; ++min_x) {
+    for (int min_y = 2; min_y <= 6; ++min_y) {
+      int expected = 0;
+      for (int x = min_x; x <= 8; ++x) {
+        for (int y = min_y; y <= 6; ++y) {
+          expected += grid.at("layer", grid_map::Index(x, y)) == UNKNOWN ? 1 : 0;
+        }
+      }
+      ASSERT_EQ(partial_counter.count(min_x, 8, min_y, 6), expected);
+    }
+  }
+}
+
 TEST(buildSlices, test_buffer_offset)
 {
   using behavior_velocity_planner::geometry::buildSlices;
@@ -0,0 +1,81 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utilization/pointcloud_grid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+using behavior_velocity_planner::Point2d;
+using behavior_velocity_planner::PointCloudGrid;
+using behavior_velocity_planner::Polygon2d;
+
+// points every 0.25 m in [-10, 10] x [-10, 10]
+pcl::PointCloud<pcl::PointXYZ>::ConstPtr generatePointCloud()
+{
+  auto pointcloud = std::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
+  for (int i = -40; i <= 40; ++i) {
+    for (int j = -40; j <= 40; ++j) {
+      pointcloud->push_back(pcl::PointXYZ(0.25f * i + 0.01f, 0.25f * j + 0.01f, 0.0f));
+    }
+  }
+  return pointcloud;
+}
+
+size_t countPointsWithin(
+  const pcl::PointCloud<pcl::PointXYZ> & pointcloud, const Polygon2d & polygon)
+{
+  size_t num = 0;
+  for (const auto & p : pointcloud) {
+    num += boost::geometry::within(Point2d{p.x, p.y}, polygon) ? 1 : 0;
+  }
+  return num;
+}
+}  // namespace
+
+TEST(pointcloud_grid, find_points_within)
+{
+  const auto pointcloud = generatePointCloud();
+  const PointCloudGrid grid(pointcloud);
+
+  // concave, with edges across the cells
+  Polygon2d polygon{{{-7.3, -6.1}, {-6.7, 5.6}, {0.4, 0.3}, {5.2, 8.9}, {8.1, -4.4}}};
+  boost::geometry::correct(polygon);
+  const size_t expected_num = countPointsWithin(*pointcloud, polygon);
+  ASSERT_GT(expected_num, 0U);
+
+  const PointCloudGrid::PolygonMask mask(polygon);
+  const auto points = grid.findPointsWithin(mask);
+  EXPECT_EQ(points.size(), expected_num);
+  for (const auto & p : points) {
+    EXPECT_TRUE(boost::geometry::within(Point2d{p.x, p.y}, polygon));
+  }
+  EXPECT_TRUE(grid.hasPointWithin(mask));
+
+  // a mask of another cell size checks all the points
+  EXPECT_EQ(grid.findPointsWithin(PointCloudGrid::PolygonMask(polygon, 2.0)).size(), expected_num);
+}
+
+TEST(pointcloud_grid, no_points_within)
+{
+  const PointCloudGrid grid(generatePointCloud());
+  const PointCloudGrid::PolygonMask mask(
+    Polygon2d{{{20.0, 20.0}, {30.0, 20.0}, {30.0, 30.0}, {20.0, 30.0}}});
+  EXPECT_TRUE(grid.findPointsWithin(mask).empty());
+  EXPECT_FALSE(grid.hasPointWithin(mask));
+}
@@ -0,0 +1,106 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utilization/predicted_path_index.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+using behavior_velocity_planner::Point2d;
+using behavior_velocity_planner::Polygon2d;
+using behavior_velocity_planner::PredictedPathIndex;
+
+// an object at each (x0, y0), moving along x at 1 m/s on a predicted path of a point per second
+autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr generateObjects(
+  const std::vector<Point2d> & origins, const int nb_points)
+{
+  auto objects = std::make_shared<autoware_perception_msgs::msg::DynamicObjectArray>();
+  for (const auto & origin : origins) {
+    autoware_perception_msgs::msg::DynamicObject object;
+    object.shape.dimensions.x = 1.0;
+    object.shape.dimensions.y = 1.0;
+    autoware_perception_msgs::msg::PredictedPath predicted_path;
+    for (int i = 0; i < nb_points; ++i) {
+      geometry_msgs::msg::PoseWithCovarianceStamped pose;
+      pose.header.stamp = rclcpp::Time(i, 0);
+      pose.pose.pose.position.x = origin.x() + i;
+      pose.pose.pose.position.y = origin.y();
+      pose.pose.pose.orientation.w = 1.0;
+      predicted_path.path.push_back(pose);
+    }
+    object.state.predicted_paths.push_back(predicted_path);
+    objects->objects.push_back(object);
+  }
+  return objects;
+}
+
+rclcpp::Time toRosTime(const int32_t sec) { return rclcpp::Time(sec, 0, RCL_ROS_TIME); }
+
+Polygon2d generateSquare(const double x, const double y, const double size)
+{
+  return Polygon2d{{{x, y}, {x + size, y}, {x + size, y + size}, {x, y + size}}};
+}
+}  // namespace
+
+TEST(predicted_path_index, find_segments)
+{
+  const PredictedPathIndex index(generateObjects({{0.0, 0.0}, {0.0, 50.0}}, 30));
+
+  // the segments [4, 5] and [5, 6] of the first object only
+  const auto keys = index.findSegments(generateSquare(4.5, -0.5, 1.0), toRosTime(100));
+  ASSERT_EQ(keys.size(), 2U);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(keys.at(i).object_idx, 0U);
+    EXPECT_EQ(keys.at(i).path_idx, 0U);
+    EXPECT_EQ(keys.at(i).point_idx, 4U + i);
+  }
+
+  // the segment [5, 6] starts at 5 s
+  EXPECT_EQ(index.findSegments(generateSquare(4.5, -0.5, 1.0), toRosTime(5)).size(), 1U);
+  EXPECT_TRUE(index.findSegments(generateSquare(4.5, -0.5, 1.0), toRosTime(4)).empty());
+}
+
+TEST(predicted_path_index, find_points)
+{
+  const PredictedPathIndex index(generateObjects({{0.0, 0.0}, {0.0, 50.0}}, 30));
+
+  const auto keys = index.findPoints(generateSquare(9.5, 49.0, 2.0), toRosTime(100));
+  ASSERT_EQ(keys.size(), 2U);
+  EXPECT_EQ(keys.front().object_idx, 1U);
+  EXPECT_EQ(keys.front().point_idx, 10U);
+  EXPECT_EQ(keys.back().point_idx, 11U);
+  EXPECT_TRUE(index.findPoints(generateSquare(9.5, 20.0, 2.0), toRosTime(100)).empty());
+}
+
+TEST(predicted_path_index, large_polygon)
+{
+  // the polygon covers more cells than the entries
+  const PredictedPathIndex index(generateObjects({{0.0, 0.0}, {0.0, 50.0}}, 3));
+  EXPECT_EQ(
+    index.findPoints(generateSquare(-500.0, -500.0, 1000.0), toRosTime(100)).size(), 6U);
+  EXPECT_EQ(
+    index.findSegments(generateSquare(-500.0, -500.0, 1000.0), toRosTime(100)).size(), 4U);
+}
+
+TEST(predicted_path_index, footprint)
+{
+  const PredictedPathIndex index(generateObjects({{0.0, 0.0}}, 3));
+  const auto & footprint = index.getFootprint({0, 0, 2});
+  EXPECT_TRUE(boost::geometry::within(Point2d(2.0, 0.0), footprint));
+  EXPECT_FALSE(boost::geometry::within(Point2d(0.0, 0.0), footprint));
+}
@@ -19,6 +19,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 TEST(to_footprint_polygon, nominal)
 {
   using behavior_velocity_planner::planning_utils::toFootprintPolygon;
@@ -38,3 +40,84 @@ TEST(is_ahead_of, nominal)
   is_ahead = isAheadOf(target, origin);
   EXPECT_TRUE(is_ahead);
 }
+
+TEST(calc_arc_lengths, nominal)
+{
+  using behavior_velocity_planner::planning_utils::calcArcLengths;
+  const auto path = test::generatePath(0.0, 0.0, 3.0, 4.0, 3);
+  const auto arc_lengths = calcArcLengths(path);
+  ASSERT_EQ(arc_lengths.size(), 3U);
+  EXPECT_DOUBLE_EQ(arc_lengths.at(0), 0.0);
+  EXPECT_DOUBLE_EQ(arc_lengths.at(1), 2.5);
+  EXPECT_DOUBLE_EQ(arc_lengths.at(2), 5.0);
+}
+
+TEST(merge_path_velocity, nominal)
+{
+  using behavior_velocity_planner::planning_utils::mergePathVelocity;
+  auto input = test::generatePath(0.0, 0.0, 4.0, 0.0, 5);
+  test::addConstantVelocity(input, 10.0);
+
+  // slow down from x = 1.5
+  auto path1 = input;
+  autoware_planning_msgs::msg::PathPointWithLaneId point1 = path1.points.at(1);
+  point1.point.pose.position.x = 1.5;
+  path1.points.insert(path1.points.begin() + 2, point1);
+  for (size_t i = 2; i < path1.points.size(); ++i) {
+    path1.points.at(i).point.twist.linear.x = 5.0;
+  }
+
+  // stop at x = 3.0
+  auto path2 = input;
+  for (size_t i = 3; i < path2.points.size(); ++i) {
+    path2.points.at(i).point.twist.linear.x = 0.0;
+  }
+
+  auto merged = input;
+  mergePathVelocity(path1, &merged);
+  mergePathVelocity(path2, &merged);
+
+  const std::vector<double> expected_x = {0.0, 1.0, 1.5, 2.0, 3.0, 4.0};
+  const std::vector<double> expected_v = {10.0, 10.0, 5.0, 5.0, 0.0, 0.0};
+  ASSERT_EQ(merged.points.size(), expected_x.size());
+  for (size_t i = 0; i < merged.points.size(); ++i) {
+    EXPECT_DOUBLE_EQ(merged.points.at(i).point.pose.position.x, expected_x.at(i));
+    EXPECT_DOUBLE_EQ(merged.points.at(i).point.twist.linear.x, expected_v.at(i));
+  }
+}
+
+TEST(merge_path_velocity, inserted_in_both)
+{
+  using behavior_velocity_planner::planning_utils::mergePathVelocity;
+  auto input = test::generatePath(0.0, 0.0, 2.0, 0.0, 3);
+  test::addConstantVelocity(input, 10.0);
+
+  // the point inserted by the first path limits the one inserted by the second path after it
+  auto path1 = input;
+  autoware_planning_msgs::msg::PathPointWithLaneId point1 = path1.points.at(0);
+  point1.point.pose.position.x = 0.5;
+  point1.point.twist.linear.x = 0.0;
+  path1.points.insert(path1.points.begin() + 1, point1);
+  for (size_t i = 2; i < path1.points.size(); ++i) {
+    path1.points.at(i).point.twist.linear.x = 0.0;
+  }
+
+  auto path2 = input;
+  autoware_planning_msgs::msg::PathPointWithLaneId point2 = path2.points.at(1);
+  point2.point.pose.position.x = 1.5;
+  point2.point.twist.linear.x = 3.0;
+  path2.points.insert(path2.points.begin() + 2, point2);
+  path2.points.back().point.twist.linear.x = 3.0;
+
+  auto merged = input;
+  mergePathVelocity(path1, &merged);
+  mergePathVelocity(path2, &merged);
+
+  const std::vector<double> expected_x = {0.0, 0.5, 1.0, 1.5, 2.0};
+  const std::vector<double> expected_v = {10.0, 0.0, 0.0, 0.0, 0.0};
+  ASSERT_EQ(merged.points.size(), expected_x.size());
+  for (size_t i = 0; i < merged.points.size(); ++i) {
+    EXPECT_DOUBLE_EQ(merged.points.at(i).point.pose.position.x, expected_x.at(i));
+    EXPECT_DOUBLE_EQ(merged.points.at(i).point.twist.linear.x, expected_v.at(i));
+  }
+}
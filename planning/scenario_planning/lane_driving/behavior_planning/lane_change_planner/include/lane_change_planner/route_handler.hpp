@@ -34,6 +34,8 @@
 
 #include <limits>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace lane_change_planner
@@ -70,6 +72,11 @@ private:
   lanelet::ConstLanelets start_lanelets_;
   lanelet::ConstLanelets goal_lanelets_;
 
+  // the next and previous lanes along the route, built with the route lanelets
+  std::unordered_set<lanelet::Id> route_lanelet_ids_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelet> next_route_lanelets_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelet> previous_route_lanelets_;
+
   const rclcpp::Logger logger_;
 
   void setRouteLanelets();
@@ -24,6 +24,8 @@
 
 #include <autoware_planning_msgs/msg/path_with_lane_id.hpp>
 
+#include <boost/optional.hpp>
+
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_core/geometry/Lanelet.h>
 #include <lanelet2_core/primitives/LaneletSequence.h>
@@ -33,6 +35,7 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -244,15 +247,12 @@ void RouteHandler::mapCallback(const autoware_lanelet2_msgs::msg::MapBin::ConstS
   lanelet::utils::conversion::fromBinMsg(
     *map_msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
 
-  const auto traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
-    lanelet::Locations::Germany, lanelet::Participants::Vehicle);
+  // the vehicle graph is the routing graph built from the same rules, so it is shared
   const auto pedestrian_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
     lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
-  lanelet::routing::RoutingGraphConstPtr vehicle_graph =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *traffic_rules);
   lanelet::routing::RoutingGraphConstPtr pedestrian_graph =
     lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *pedestrian_rules);
-  lanelet::routing::RoutingGraphContainer overall_graphs({vehicle_graph, pedestrian_graph});
+  lanelet::routing::RoutingGraphContainer overall_graphs({routing_graph_ptr_, pedestrian_graph});
   overall_graphs_ptr_ =
     std::make_shared<const lanelet::routing::RoutingGraphContainer>(overall_graphs);
 
@@ -306,6 +306,31 @@ void RouteHandler::setRouteLanelets()
       start_lanelets_.push_back(llt);
     }
   }
+
+  route_lanelet_ids_.clear();
+  for (const auto & llt : route_lanelets_) {
+    route_lanelet_ids_.insert(llt.id());
+  }
+  next_route_lanelets_.clear();
+  previous_route_lanelets_.clear();
+  for (const auto & llt : route_lanelets_) {
+    if (!exists(goal_lanelets_, llt)) {
+      for (const auto & following_llt : routing_graph_ptr_->following(llt)) {
+        if (route_lanelet_ids_.count(following_llt.id())) {
+          next_route_lanelets_.emplace(llt.id(), following_llt);
+          break;
+        }
+      }
+    }
+    if (!exists(start_lanelets_, llt)) {
+      for (const auto & previous_llt : routing_graph_ptr_->previous(llt)) {
+        if (route_lanelet_ids_.count(previous_llt.id())) {
+          previous_route_lanelets_.emplace(llt.id(), previous_llt);
+          break;
+        }
+      }
+    }
+  }
   is_handler_ready_ = true;
 }
 
@@ -384,7 +409,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!route_lanelet_ids_.count(lanelet.id())) {
     return lanelet_sequence_forward;
   }
 
@@ -407,7 +432,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
   lanelet::ConstLanelets lanelet_sequence_backward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!route_lanelet_ids_.count(lanelet.id())) {
     return lanelet_sequence_backward;
   }
 
@@ -446,7 +471,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequence(
   lanelet::ConstLanelets lanelet_sequence;
   lanelet::ConstLanelets lanelet_sequence_backward;
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!route_lanelet_ids_.count(lanelet.id())) {
     return lanelet_sequence;
   }
 
@@ -481,12 +506,17 @@ bool RouteHandler::getClosestLaneletWithinRoute(
 bool RouteHandler::getNextLaneletWithinRoute(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * next_lanelet) const
 {
-  if (exists(goal_lanelets_, lanelet)) {
+  const auto it = next_route_lanelets_.find(lanelet.id());
+  if (it != next_route_lanelets_.end()) {
+    *next_lanelet = it->second;
+    return true;
+  }
+  if (route_lanelet_ids_.count(lanelet.id()) || exists(goal_lanelets_, lanelet)) {
     return false;
   }
   lanelet::ConstLanelets following_lanelets = routing_graph_ptr_->following(lanelet);
   for (const auto & llt : following_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (route_lanelet_ids_.count(llt.id())) {
       *next_lanelet = llt;
       return true;
     }
@@ -497,12 +527,17 @@ bool RouteHandler::getNextLaneletWithinRoute(
 bool RouteHandler::getPreviousLaneletWithinRoute(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * prev_lanelet) const
 {
-  if (exists(start_lanelets_, lanelet)) {
+  const auto it = previous_route_lanelets_.find(lanelet.id());
+  if (it != previous_route_lanelets_.end()) {
+    *prev_lanelet = it->second;
+    return true;
+  }
+  if (route_lanelet_ids_.count(lanelet.id()) || exists(start_lanelets_, lanelet)) {
     return false;
   }
   lanelet::ConstLanelets previous_lanelets = routing_graph_ptr_->previous(lanelet);
   for (const auto & llt : previous_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (route_lanelet_ids_.count(llt.id())) {
       *prev_lanelet = llt;
       return true;
     }
@@ -516,7 +551,7 @@ bool RouteHandler::getRightLaneletWithinRoute(
   auto opt_right_lanelet = routing_graph_ptr_->right(lanelet);
   if (!!opt_right_lanelet) {
     *right_lanelet = opt_right_lanelet.get();
-    return exists(route_lanelets_, *right_lanelet);
+    return route_lanelet_ids_.count(right_lanelet->id()) > 0;
   } else {
     return false;
   }
@@ -527,7 +562,7 @@ bool RouteHandler::getLeftLaneletWithinRoute(
   auto opt_left_lanelet = routing_graph_ptr_->left(lanelet);
   if (!!opt_left_lanelet) {
     *left_lanelet = opt_left_lanelet.get();
-    return exists(route_lanelets_, *left_lanelet);
+    return route_lanelet_ids_.count(left_lanelet->id()) > 0;
   } else {
     return false;
   }
@@ -844,8 +879,26 @@ std::vector<LaneChangePath> RouteHandler::getLaneChangePaths(
   const double target_distance =
     util::getArcLengthToTargetLanelet(original_lanelets, target_lanelets.front(), pose);
 
+  std::vector<double> accelerations;
   for (double acceleration = 0.0; acceleration >= -maximum_deceleration;
        acceleration -= acceleration_resolution) {
+    accelerations.push_back(acceleration);
+  }
+
+  // lanelet2 computes the centerlines lazily, so they are computed here before the candidates
+  // read them in parallel
+  for (const auto & llt : original_lanelets) {
+    llt.centerline();
+  }
+  for (const auto & llt : target_lanelets) {
+    llt.centerline();
+  }
+
+  // the candidates are independent, each one fills its own slot to keep their order
+  std::vector<boost::optional<LaneChangePath>> candidates(accelerations.size());
+#pragma omp parallel for schedule(dynamic)
+  for (size_t candidate_idx = 0; candidate_idx < accelerations.size(); ++candidate_idx) {
+    const double acceleration = accelerations.at(candidate_idx);
     PathWithLaneId reference_path;
     const double v1 = v0 + acceleration * lane_change_prepare_duration;
     const double v2 = v1 + acceleration * lane_changing_duration;
@@ -917,9 +970,14 @@ std::vector<LaneChangePath> RouteHandler::getLaneChangePaths(
     for (auto & pt : candidate_path.path.points) {
       pt.point.type = autoware_planning_msgs::msg::PathPoint::FIXED;
     }
-    candidate_paths.push_back(candidate_path);
+    candidates.at(candidate_idx) = candidate_path;
   }
 
+  for (const auto & candidate : candidates) {
+    if (candidate) {
+      candidate_paths.push_back(*candidate);
+    }
+  }
   return candidate_paths;
 }
 
@@ -18,7 +18,10 @@
 
 #include <lanelet2_extension/utility/utilities.hpp>
 
+#include <boost/optional.hpp>
+
 #include <algorithm>
+#include <atomic>
 #include <vector>
 
 namespace lane_change_planner
@@ -27,6 +30,259 @@ namespace state_machine
 {
 namespace common_functions
 {
+namespace
+{
+using autoware_perception_msgs::msg::DynamicObject;
+using autoware_perception_msgs::msg::PredictedPath;
+using geometry_msgs::msg::Point;
+
+// an object with its poses at the time steps of the safety check. they do not depend on the lane
+// change path, so they are computed once for all the candidate paths.
+struct ObjectToCheck
+{
+  size_t object_idx;
+  // positions on each predicted path, none where the predicted path does not cover the time step
+  std::vector<std::vector<boost::optional<Point>>> predicted_positions;
+  // checked instead of the predicted paths for the target lane objects out of the target lanes
+  boost::optional<util::Polygon> polygon;
+  double threshold;
+};
+
+struct SafetyCheckObjects
+{
+  // time steps of the check
+  std::vector<rclcpp::Time> check_times;
+  // the current lane objects are filtered by each path when it is checked
+  std::vector<ObjectToCheck> current_lane_objects;
+  std::vector<ObjectToCheck> target_lane_objects;
+};
+
+std::vector<PredictedPath> getPredictedPathsToCheck(
+  const DynamicObject & object, const LaneChangerParameters & ros_parameters)
+{
+  if (ros_parameters.use_all_predicted_path || object.state.predicted_paths.empty()) {
+    return object.state.predicted_paths;
+  }
+  const auto & max_confidence_path = *(std::max_element(
+    object.state.predicted_paths.begin(), object.state.predicted_paths.end(),
+    [](const auto & path1, const auto & path2) { return path1.confidence > path2.confidence; }));
+  return {max_confidence_path};
+}
+
+std::vector<boost::optional<Point>> samplePredictedPath(
+  const PredictedPath & predicted_path, const std::vector<rclcpp::Time> & check_times,
+  const rclcpp::Logger & logger, const rclcpp::Clock::SharedPtr & clock)
+{
+  std::vector<boost::optional<Point>> positions;
+  positions.reserve(check_times.size());
+  for (const auto & t : check_times) {
+    geometry_msgs::msg::Pose pose;
+    if (util::lerpByTimeStamp(predicted_path, t, &pose, logger, clock)) {
+      positions.emplace_back(pose.position);
+    } else {
+      positions.emplace_back();
+    }
+  }
+  return positions;
+}
+
+std::vector<std::vector<boost::optional<Point>>> samplePredictedPaths(
+  const DynamicObject & object, const std::vector<rclcpp::Time> & check_times,
+  const LaneChangerParameters & ros_parameters, const rclcpp::Logger & logger,
+  const rclcpp::Clock::SharedPtr & clock)
+{
+  std::vector<std::vector<boost::optional<Point>>> positions;
+  for (const auto & predicted_path : getPredictedPathsToCheck(object, ros_parameters)) {
+    positions.push_back(samplePredictedPath(predicted_path, check_times, logger, clock));
+  }
+  return positions;
+}
+
+SafetyCheckObjects createSafetyCheckObjects(
+  const lanelet::ConstLanelets & current_lanes, const lanelet::ConstLanelets & target_lanes,
+  const autoware_perception_msgs::msg::DynamicObjectArray & dynamic_objects,
+  const geometry_msgs::msg::Pose & current_pose, const geometry_msgs::msg::Twist & current_twist,
+  const LaneChangerParameters & ros_parameters, const bool use_buffer,
+  const rclcpp::Logger & logger, const rclcpp::Clock::SharedPtr & clock)
+{
+  SafetyCheckObjects objects;
+
+  const auto arc = lanelet::utils::getArcCoordinates(current_lanes, current_pose);
+  constexpr double check_distance = 100.0;
+
+  // parameters
+  const double time_resolution = ros_parameters.prediction_time_resolution;
+  const double min_thresh = ros_parameters.min_stop_distance;
+  const double stop_time = ros_parameters.stop_time;
+  const double buffer = use_buffer ? ros_parameters.hysteresis_buffer_distance : 0.0;
+  const double ego_speed = util::l2Norm(current_twist.linear);
+
+  double check_start_time = 0.0;
+  const double check_end_time =
+    ros_parameters.lane_change_prepare_duration + ros_parameters.lane_changing_duration;
+  if (!ros_parameters.enable_collision_check_at_prepare_phase) {
+    check_start_time = ros_parameters.lane_change_prepare_duration;
+  }
+  const auto now = clock->now();
+  const auto t_delta = rclcpp::Duration::from_seconds(time_resolution);
+  const auto t_end = now + rclcpp::Duration::from_seconds(check_end_time);
+  for (auto t = now + rclcpp::Duration::from_seconds(check_start_time); t < t_end; t += t_delta) {
+    objects.check_times.push_back(t);
+  }
+
+  const auto calc_threshold = [&](const DynamicObject & obj) {
+    double thresh;
+    if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
+      thresh = ego_speed * stop_time;
+    } else {
+      thresh = util::l2Norm(obj.state.twist_covariance.twist.linear) * stop_time;
+    }
+    return std::max(thresh, min_thresh) + buffer;
+  };
+
+  // find objects in current lane
+  const auto current_lane_object_indices = util::filterObjectsByLanelets(
+    dynamic_objects, current_lanes, arc.length, arc.length + check_distance, logger);
+  for (const auto & i : current_lane_object_indices) {
+    const auto & obj = dynamic_objects.objects.at(i);
+    ObjectToCheck object;
+    object.object_idx = i;
+    object.predicted_positions =
+      samplePredictedPaths(obj, objects.check_times, ros_parameters, logger, clock);
+    object.threshold = calc_threshold(obj);
+    objects.current_lane_objects.push_back(object);
+  }
+
+  // find obstacle in lane change target lanes
+  // retrieve lanes that are merging target lanes as well
+  const auto target_lane_object_indices =
+    util::filterObjectsByLanelets(dynamic_objects, target_lanes, logger);
+  for (const auto & i : target_lane_object_indices) {
+    const auto & obj = dynamic_objects.objects.at(i);
+    ObjectToCheck object;
+    object.object_idx = i;
+
+    bool is_object_in_target = false;
+    if (ros_parameters.use_predicted_path_outside_lanelet) {
+      is_object_in_target = true;
+    } else {
+      for (const auto & llt : target_lanes) {
+        if (lanelet::utils::isInLanelet(obj.state.pose_covariance.pose, llt)) {
+          is_object_in_target = true;
+        }
+      }
+    }
+
+    if (is_object_in_target) {
+      object.predicted_positions =
+        samplePredictedPaths(obj, objects.check_times, ros_parameters, logger, clock);
+      object.threshold = calc_threshold(obj);
+    } else {
+      util::Polygon polygon;
+      if (util::calcObjectPolygon(obj, &polygon, logger)) {
+        object.polygon = polygon;
+      }
+      double thresh = min_thresh;
+      if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
+        thresh = std::max(thresh, ego_speed * stop_time);
+      }
+      object.threshold = thresh + buffer;
+    }
+    objects.target_lane_objects.push_back(object);
+  }
+
+  return objects;
+}
+
+// true if the ego comes closer to the object than its threshold at one of the time steps
+bool isCloseToObject(
+  const ObjectToCheck & object, const std::vector<boost::optional<Point>> & ego_positions)
+{
+  for (const auto & object_positions : object.predicted_positions) {
+    for (size_t t = 0; t < ego_positions.size(); ++t) {
+      if (!object_positions.at(t) || !ego_positions.at(t)) {
+        continue;
+      }
+      if (util::getDistance3d(*object_positions.at(t), *ego_positions.at(t)) < object.threshold) {
+        return true;
+      }
+    }
+  }
+  if (object.polygon) {
+    for (const auto & ego_position : ego_positions) {
+      if (!ego_position) {
+        continue;
+      }
+      const auto ego_point = boost::geometry::make<util::Point>(ego_position->x, ego_position->y);
+      if (boost::geometry::distance(*object.polygon, ego_point) < object.threshold) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool isLaneChangePathSafe(
+  const autoware_planning_msgs::msg::PathWithLaneId & path,
+  const lanelet::ConstLanelets & current_lanes, const lanelet::ConstLanelets & target_lanes,
+  const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr & dynamic_objects,
+  const boost::optional<SafetyCheckObjects> & objects,
+  const geometry_msgs::msg::Pose & current_pose, const geometry_msgs::msg::Twist & current_twist,
+  const LaneChangerParameters & ros_parameters, const bool use_buffer, const double acceleration,
+  const rclcpp::Logger & logger, const rclcpp::Clock::SharedPtr & clock)
+{
+  if (path.points.empty()) {
+    return false;
+  }
+  if (target_lanes.empty() || current_lanes.empty()) {
+    return false;
+  }
+  if (dynamic_objects == nullptr || !objects) {
+    return true;
+  }
+
+  const double time_resolution = ros_parameters.prediction_time_resolution;
+  const double vehicle_width = ros_parameters.vehicle_width;
+  const double lateral_buffer = use_buffer ? 0.5 : 0.0;
+  const double check_end_time =
+    ros_parameters.lane_change_prepare_duration + ros_parameters.lane_changing_duration;
+
+  // the ego positions at the time steps of the check
+  const auto vehicle_predicted_path = util::convertToPredictedPath(
+    path, current_twist, current_pose, check_end_time, time_resolution, acceleration, logger,
+    clock);
+  const auto ego_positions =
+    samplePredictedPath(vehicle_predicted_path, objects->check_times, logger, clock);
+
+  // Collision check for objects in current lane
+  std::vector<size_t> current_lane_object_indices_lanelet;
+  for (const auto & object : objects->current_lane_objects) {
+    current_lane_object_indices_lanelet.push_back(object.object_idx);
+  }
+  const auto current_lane_object_indices = util::filterObjectsByPath(
+    *dynamic_objects, current_lane_object_indices_lanelet, path, vehicle_width / 2 + lateral_buffer,
+    logger);
+  for (const auto & object : objects->current_lane_objects) {
+    const bool is_on_path =
+      std::find(
+        current_lane_object_indices.begin(), current_lane_object_indices.end(),
+        object.object_idx) != current_lane_object_indices.end();
+    if (is_on_path && isCloseToObject(object, ego_positions)) {
+      return false;
+    }
+  }
+
+  // Collision check for objects in lane change target lane
+  for (const auto & object : objects->target_lane_objects) {
+    if (isCloseToObject(object, ego_positions)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+}  // namespace
+
 std::vector<LaneChangePath> selectValidPaths(
   const std::vector<LaneChangePath> & paths, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes,
@@ -55,21 +311,43 @@ bool selectSafePath(
   const LaneChangerParameters & ros_parameters, LaneChangePath * selected_path,
   const rclcpp::Logger & logger, const rclcpp::Clock::SharedPtr & clock)
 {
-  for (const auto & path : paths) {
+  if (paths.empty()) {
+    return false;
+  }
+
+  constexpr bool use_buffer = true;
+  boost::optional<SafetyCheckObjects> objects;
+  if (dynamic_objects && !current_lanes.empty() && !target_lanes.empty()) {
+    objects = createSafetyCheckObjects(
+      current_lanes, target_lanes, *dynamic_objects, current_pose, current_twist, ros_parameters,
+      use_buffer, logger, clock);
+  }
+
+  // the paths are in order of preference, the first safe one is selected. the paths after a
+  // safe one are not checked any more.
+  std::atomic<size_t> safe_path_idx{paths.size()};
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < paths.size(); ++i) {
+    if (i > safe_path_idx.load()) {
+      continue;
+    }
+    const auto & path = paths.at(i);
     if (isLaneChangePathSafe(
-          path.path, current_lanes, target_lanes, dynamic_objects, current_pose, current_twist,
-          ros_parameters, true, path.acceleration, logger, clock)) {
-      *selected_path = path;
-      return true;
+          path.path, current_lanes, target_lanes, dynamic_objects, objects, current_pose,
+          current_twist, ros_parameters, use_buffer, path.acceleration, logger, clock)) {
+      size_t idx = safe_path_idx.load();
+      while (i < idx && !safe_path_idx.compare_exchange_weak(idx, i)) {
+      }
     }
   }
 
-  // set first path for force lane change if no valid path found
-  if (!paths.empty()) {
-    *selected_path = paths.front();
-    return false;
+  if (safe_path_idx < paths.size()) {
+    *selected_path = paths.at(safe_path_idx);
+    return true;
   }
 
+  // set first path for force lane change if no valid path found
+  *selected_path = paths.front();
   return false;
 }
 
@@ -115,150 +393,15 @@ bool isLaneChangePathSafe(
   const LaneChangerParameters & ros_parameters, const bool use_buffer, const double acceleration,
   const rclcpp::Logger & logger, const rclcpp::Clock::SharedPtr & clock)
 {
-  if (path.points.empty()) {
-    return false;
-  }
-  if (target_lanes.empty() || current_lanes.empty()) {
-    return false;
-  }
-  if (dynamic_objects == nullptr) {
-    return true;
-  }
-  const auto arc = lanelet::utils::getArcCoordinates(current_lanes, current_pose);
-  constexpr double check_distance = 100.0;
-
-  // parameters
-  const double time_resolution = ros_parameters.prediction_time_resolution;
-  const double min_thresh = ros_parameters.min_stop_distance;
-  const double stop_time = ros_parameters.stop_time;
-  const double vehicle_width = ros_parameters.vehicle_width;
-  double buffer;
-  double lateral_buffer;
-  if (use_buffer) {
-    buffer = ros_parameters.hysteresis_buffer_distance;
-    lateral_buffer = 0.5;
-  } else {
-    buffer = 0.0;
-    lateral_buffer = 0.0;
-  }
-  double current_lane_check_start_time = 0.0;
-  const double current_lane_check_end_time =
-    ros_parameters.lane_change_prepare_duration + ros_parameters.lane_changing_duration;
-  double target_lane_check_start_time = 0.0;
-  const double target_lane_check_end_time =
-    ros_parameters.lane_change_prepare_duration + ros_parameters.lane_changing_duration;
-  if (!ros_parameters.enable_collision_check_at_prepare_phase) {
-    current_lane_check_start_time = ros_parameters.lane_change_prepare_duration;
-    target_lane_check_start_time = ros_parameters.lane_change_prepare_duration;
-  }
-
-  // find obstacle in lane change target lanes
-  // retrieve lanes that are merging target lanes as well
-  const auto target_lane_object_indices =
-    util::filterObjectsByLanelets(*dynamic_objects, target_lanes, logger);
-
-  // find objects in current lane
-  const auto current_lane_object_indices_lanelet = util::filterObjectsByLanelets(
-    *dynamic_objects, current_lanes, arc.length, arc.length + check_distance, logger);
-  const auto current_lane_object_indices = util::filterObjectsByPath(
-    *dynamic_objects, current_lane_object_indices_lanelet, path, vehicle_width / 2 + lateral_buffer,
-    logger);
-
-  const auto & vehicle_predicted_path = util::convertToPredictedPath(
-    path, current_twist, current_pose, target_lane_check_end_time, time_resolution, acceleration,
-    logger, clock);
-
-  // Collision check for objects in current lane
-  for (const auto & i : current_lane_object_indices) {
-    const auto & obj = dynamic_objects->objects.at(i);
-    std::vector<autoware_perception_msgs::msg::PredictedPath> predicted_paths;
-    if (ros_parameters.use_all_predicted_path) {
-      predicted_paths = obj.state.predicted_paths;
-    } else {
-      auto & max_confidence_path = *(std::max_element(
-        obj.state.predicted_paths.begin(), obj.state.predicted_paths.end(),
-        [](const auto & path1, const auto & path2) {
-          return path1.confidence > path2.confidence;
-        }));
-      predicted_paths.push_back(max_confidence_path);
-    }
-    for (const auto & obj_path : predicted_paths) {
-      double distance = util::getDistanceBetweenPredictedPaths(
-        obj_path, vehicle_predicted_path, current_lane_check_start_time,
-        current_lane_check_end_time, time_resolution, logger, clock);
-      double thresh;
-      if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
-        thresh = util::l2Norm(current_twist.linear) * stop_time;
-      } else {
-        thresh = util::l2Norm(obj.state.twist_covariance.twist.linear) * stop_time;
-      }
-      thresh = std::max(thresh, min_thresh);
-      thresh += buffer;
-      if (distance < thresh) {
-        return false;
-      }
-    }
+  boost::optional<SafetyCheckObjects> objects;
+  if (dynamic_objects && !current_lanes.empty() && !target_lanes.empty()) {
+    objects = createSafetyCheckObjects(
+      current_lanes, target_lanes, *dynamic_objects, current_pose, current_twist, ros_parameters,
+      use_buffer, logger, clock);
   }
-
-  // Collision check for objects in lane change target lane
-  for (const auto & i : target_lane_object_indices) {
-    const auto & obj = dynamic_objects->objects.at(i);
-    std::vector<autoware_perception_msgs::msg::PredictedPath> predicted_paths;
-    if (ros_parameters.use_all_predicted_path) {
-      predicted_paths = obj.state.predicted_paths;
-    } else {
-      auto & max_confidence_path = *(std::max_element(
-        obj.state.predicted_paths.begin(), obj.state.predicted_paths.end(),
-        [](const auto & path1, const auto & path2) {
-          return path1.confidence > path2.confidence;
-        }));
-      predicted_paths.push_back(max_confidence_path);
-    }
-
-    bool is_object_in_target = false;
-    if (ros_parameters.use_predicted_path_outside_lanelet) {
-      is_object_in_target = true;
-    } else {
-      for (const auto & llt : target_lanes) {
-        if (lanelet::utils::isInLanelet(obj.state.pose_covariance.pose, llt)) {
-          is_object_in_target = true;
-        }
-      }
-    }
-
-    if (is_object_in_target) {
-      for (const auto & obj_path : predicted_paths) {
-        const double distance = util::getDistanceBetweenPredictedPaths(
-          obj_path, vehicle_predicted_path, target_lane_check_start_time,
-          target_lane_check_end_time, time_resolution, logger, clock);
-        double thresh;
-        if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
-          thresh = util::l2Norm(current_twist.linear) * stop_time;
-        } else {
-          thresh = util::l2Norm(obj.state.twist_covariance.twist.linear) * stop_time;
-        }
-        thresh = std::max(thresh, min_thresh);
-        thresh += buffer;
-        if (distance < thresh) {
-          return false;
-        }
-      }
-    } else {
-      const double distance = util::getDistanceBetweenPredictedPathAndObject(
-        obj, vehicle_predicted_path, target_lane_check_start_time, target_lane_check_end_time,
-        time_resolution, logger, clock);
-      double thresh = min_thresh;
-      if (isObjectFront(current_pose, obj.state.pose_covariance.pose)) {
-        thresh = std::max(thresh, util::l2Norm(current_twist.linear) * stop_time);
-      }
-      thresh += buffer;
-      if (distance < thresh) {
-        return false;
-      }
-    }
-  }
-
-  return true;
+  return isLaneChangePathSafe(
+    path, current_lanes, target_lanes, dynamic_objects, objects, current_pose, current_twist,
+    ros_parameters, use_buffer, acceleration, logger, clock);
 }
 
 bool isObjectFront(
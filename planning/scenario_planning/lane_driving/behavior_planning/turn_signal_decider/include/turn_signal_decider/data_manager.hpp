@@ -27,10 +27,20 @@
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <limits>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace turn_signal_decider
 {
+// attributes of a lanelet read for the turn signals, parsed once per lanelet
+struct LaneAttributes
+{
+  uint8_t turn_direction = autoware_vehicle_msgs::msg::TurnSignal::NONE;
+  double turn_signal_distance = std::numeric_limits<double>::max();
+};
+
 class DataManager
 {
 private:
@@ -50,9 +60,15 @@ private:
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
-  lanelet::ConstLanelets path_lanes_;
   geometry_msgs::msg::PoseStamped vehicle_pose_;
 
+  // indices updated with the path and the map, so that the timer does not search them
+  std::vector<double> path_arc_lengths_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelet> path_lanes_;
+  std::unordered_map<lanelet::Id, LaneAttributes> lane_attributes_;
+
+  void updatePathLanes();
+
   // condition checks
   bool isPathValid() const;
   bool isPoseValid() const;
@@ -66,9 +82,12 @@ public:
   void onVehiclePoseUpdate();
 
   // getters
-  autoware_planning_msgs::msg::PathWithLaneId getPath() const;
+  const autoware_planning_msgs::msg::PathWithLaneId & getPath() const;
+  // accumulated distance from the first point of the path to each point
+  const std::vector<double> & getPathArcLengths() const;
   lanelet::LaneletMapPtr getMapPtr() const;
   lanelet::ConstLanelet getLaneFromId(const lanelet::Id & id) const;
+  LaneAttributes getLaneAttributes(const lanelet::Id & id) const;
   lanelet::routing::RoutingGraphPtr getRoutingGraphPtr() const;
   geometry_msgs::msg::PoseStamped getVehiclePoseStamped() const;
 
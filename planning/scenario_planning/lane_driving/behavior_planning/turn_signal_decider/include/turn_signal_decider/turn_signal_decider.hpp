@@ -22,7 +22,9 @@
 
 #include <autoware_vehicle_msgs/msg/turn_signal.hpp>
 
+#include <map>
 #include <string>
+#include <utility>
 
 namespace turn_signal_decider
 {
@@ -64,6 +66,13 @@ private:
   // other
   lanelet::routing::RelationType getRelation(
     const lanelet::ConstLanelet & prev_lane, const lanelet::ConstLanelet & next_lane) const;
+  lanelet::routing::RelationType searchRelation(
+    const lanelet::ConstLanelet & prev_lane, const lanelet::ConstLanelet & next_lane) const;
+
+  // relations between the lanes of the path, valid for the routing graph they were searched in
+  mutable std::map<std::pair<lanelet::Id, lanelet::Id>, lanelet::routing::RelationType>
+    relation_cache_;
+  mutable lanelet::routing::RoutingGraphPtr relation_cache_graph_ptr_;
 
 public:
   explicit TurnSignalDecider(const rclcpp::NodeOptions & node_options);
@@ -17,34 +17,51 @@
 #include <lanelet2_extension/utility/message_conversion.hpp>
 #include <lanelet2_extension/utility/utilities.hpp>
 
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 using autoware_planning_msgs::msg::PathWithLaneId;
 
 namespace
 {
-bool exists(const lanelet::ConstLanelets & lanes, const lanelet::Id & id)
+double getDistance3d(const geometry_msgs::msg::Point & p1, const geometry_msgs::msg::Point & p2)
 {
-  for (const auto & lane : lanes) {
-    if (lane.id() == id) {
-      return true;
-    }
-  }
-  return false;
+  return std::sqrt(std::pow(p1.x - p2.x, 2) + std::pow(p1.y - p2.y, 2) + std::pow(p1.z - p2.z, 2));
 }
-lanelet::ConstLanelets pathToLanes(
-  const PathWithLaneId & path, const lanelet::LaneletMapPtr & lanelet_map_ptr)
+
+std::vector<double> calcArcLengths(const PathWithLaneId & path)
 {
-  lanelet::ConstLanelets lanes;
+  std::vector<double> arc_lengths;
+  if (path.points.empty()) {
+    return arc_lengths;
+  }
+  arc_lengths.reserve(path.points.size());
+  double accumulated_distance = 0;
+  auto prev_point = path.points.front();
   for (const auto & path_point : path.points) {
-    for (const auto & id : path_point.lane_ids) {
-      if (!exists(lanes, id)) {
-        lanes.push_back(lanelet_map_ptr->laneletLayer.get(id));
-      }
-    }
+    accumulated_distance +=
+      getDistance3d(prev_point.point.pose.position, path_point.point.pose.position);
+    prev_point = path_point;
+    arc_lengths.push_back(accumulated_distance);
   }
-  return lanes;
+  return arc_lengths;
+}
+
+LaneAttributes readLaneAttributes(const lanelet::ConstLanelet & lane)
+{
+  LaneAttributes attributes;
+  const auto turn_direction = lane.attributeOr("turn_direction", std::string("none"));
+  if (turn_direction == "left") {
+    attributes.turn_direction = autoware_vehicle_msgs::msg::TurnSignal::LEFT;
+  } else if (turn_direction == "right") {
+    attributes.turn_direction = autoware_vehicle_msgs::msg::TurnSignal::RIGHT;
+  }
+  attributes.turn_signal_distance =
+    lane.attributeOr("turn_signal_distance", std::numeric_limits<double>::max());
+  return attributes;
 }
 }  // namespace
 
@@ -64,9 +81,10 @@ DataManager::DataManager(rclcpp::Node * node)
 void DataManager::onPathWithLaneId(PathWithLaneId::SharedPtr msg)
 {
   path_ = *msg;
+  path_arc_lengths_ = calcArcLengths(path_);
   is_path_ready_ = true;
   if (is_map_ready_) {
-    path_lanes_ = pathToLanes(path_, lanelet_map_ptr_);
+    updatePathLanes();
   }
 }
 
@@ -76,9 +94,28 @@ void DataManager::onLaneletMap(autoware_lanelet2_msgs::msg::MapBin::SharedPtr ma
   lanelet::utils::conversion::fromBinMsg(
     *map_msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
   is_map_ready_ = true;
+  lane_attributes_.clear();
 
   if (is_path_ready_) {
-    path_lanes_ = pathToLanes(path_, lanelet_map_ptr_);
+    updatePathLanes();
+  }
+}
+
+void DataManager::updatePathLanes()
+{
+  path_lanes_.clear();
+  for (const auto & path_point : path_.points) {
+    for (const auto & id : path_point.lane_ids) {
+      if (path_lanes_.count(id) != 0) {
+        continue;
+      }
+      const auto lane = lanelet_map_ptr_->laneletLayer.get(id);
+      path_lanes_.emplace(id, lane);
+      // the attributes do not change until the next map
+      if (lane_attributes_.count(id) == 0) {
+        lane_attributes_.emplace(id, readLaneAttributes(lane));
+      }
+    }
   }
 }
 
@@ -228,20 +265,29 @@ bool DataManager::isDataReady() const
   }
 }
 
-autoware_planning_msgs::msg::PathWithLaneId DataManager::getPath() const { return path_; }
+const autoware_planning_msgs::msg::PathWithLaneId & DataManager::getPath() const { return path_; }
+
+const std::vector<double> & DataManager::getPathArcLengths() const { return path_arc_lengths_; }
 
 lanelet::LaneletMapPtr DataManager::getMapPtr() const { return lanelet_map_ptr_; }
 
 lanelet::ConstLanelet DataManager::getLaneFromId(const lanelet::Id & id) const
 {
-  for (const auto & lane : path_lanes_) {
-    if (lane.id() == id) {
-      return lane;
-    }
+  const auto itr = path_lanes_.find(id);
+  if (itr != path_lanes_.end()) {
+    return itr->second;
   }
   return lanelet::Lanelet();
 }
 
+LaneAttributes DataManager::getLaneAttributes(const lanelet::Id & id) const
+{
+  if (path_lanes_.count(id) == 0) {
+    return LaneAttributes{};
+  }
+  return lane_attributes_.at(id);
+}
+
 lanelet::routing::RoutingGraphPtr DataManager::getRoutingGraphPtr() const
 {
   return routing_graph_ptr_;
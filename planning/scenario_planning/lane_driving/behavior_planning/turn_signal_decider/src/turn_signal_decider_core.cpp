@@ -14,10 +14,13 @@
 
 #include "turn_signal_decider/turn_signal_decider.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 using autoware_planning_msgs::msg::PathWithLaneId;
 using autoware_vehicle_msgs::msg::TurnSignal;
@@ -26,9 +29,13 @@ using std::placeholders::_1;
 
 namespace
 {
-double getDistance3d(const geometry_msgs::msg::Point & p1, const geometry_msgs::msg::Point & p2)
+// index of the first point which is not behind the vehicle front
+size_t findFirstPointAhead(const std::vector<double> & arc_lengths, const double front_length)
 {
-  return std::sqrt(std::pow(p1.x - p2.x, 2) + std::pow(p1.y - p2.y, 2) + std::pow(p1.z - p2.z, 2));
+  const auto itr = std::partition_point(
+    arc_lengths.begin(), arc_lengths.end(),
+    [front_length](const double arc_length) { return arc_length - front_length < 0.0; });
+  return static_cast<size_t>(std::distance(arc_lengths.begin(), itr));
 }
 }  // namespace
 
@@ -88,7 +95,7 @@ void TurnSignalDecider::onTurnSignalTimer()
   }
 
   // setup
-  const auto path = data_.getPath();
+  const auto & path = data_.getPath();
   FrenetCoordinate3d vehicle_pose_frenet;
   if (!convertToFrenetCoordinate3d(
         path, data_.getVehiclePoseStamped().pose.position, &vehicle_pose_frenet)) {
@@ -126,6 +133,26 @@ lanelet::routing::RelationType TurnSignalDecider::getRelation(
   if (prev_lane == next_lane) {
     return lanelet::routing::RelationType::None;
   }
+
+  // the relations only depend on the routing graph, and the same lanes are checked every cycle
+  if (relation_cache_graph_ptr_ != routing_graph_ptr) {
+    relation_cache_.clear();
+    relation_cache_graph_ptr_ = routing_graph_ptr;
+  }
+  const auto key = std::make_pair(prev_lane.id(), next_lane.id());
+  const auto cached_relation = relation_cache_.find(key);
+  if (cached_relation != relation_cache_.end()) {
+    return cached_relation->second;
+  }
+  const auto relation_type = searchRelation(prev_lane, next_lane);
+  relation_cache_.emplace(key, relation_type);
+  return relation_type;
+}
+
+lanelet::routing::RelationType TurnSignalDecider::searchRelation(
+  const lanelet::ConstLanelet & prev_lane, const lanelet::ConstLanelet & next_lane) const
+{
+  const auto routing_graph_ptr = data_.getRoutingGraphPtr();
   const auto & relation = routing_graph_ptr->routingRelation(prev_lane, next_lane);
   if (relation) {
     return relation.get();
@@ -168,19 +195,14 @@ bool TurnSignalDecider::isChangingLane(
     return false;
   }
 
-  double accumulated_distance = 0;
+  // the points behind the vehicle front are skipped with the arc lengths of the path
+  const auto & arc_lengths = data_.getPathArcLengths();
+  const double front_length = vehicle_pose_frenet.length + parameters_.base_link2front;
 
-  auto prev_point = path.points.front();
   auto prev_lane_id = path.points.front().lane_ids.front();
-  for (const auto & path_point : path.points) {
-    accumulated_distance +=
-      getDistance3d(prev_point.point.pose.position, path_point.point.pose.position);
-    prev_point = path_point;
-    const double distance_from_vehicle_front =
-      accumulated_distance - vehicle_pose_frenet.length - parameters_.base_link2front;
-    if (distance_from_vehicle_front < 0.0) {
-      continue;
-    }
+  for (size_t i = findFirstPointAhead(arc_lengths, front_length); i < path.points.size(); ++i) {
+    const auto & path_point = path.points.at(i);
+    const double distance_from_vehicle_front = arc_lengths.at(i) - front_length;
     for (const auto & lane_id : path_point.lane_ids) {
       if (lane_id == prev_lane_id) {
         continue;
@@ -224,40 +246,28 @@ bool TurnSignalDecider::isTurning(
     return false;
   }
 
-  double accumulated_distance = 0;
+  // the points behind the vehicle front are skipped with the arc lengths of the path
+  const auto & arc_lengths = data_.getPathArcLengths();
+  const double front_length = vehicle_pose_frenet.length + parameters_.base_link2front;
 
-  auto prev_point = path.points.front();
   auto prev_lane_id = lanelet::InvalId;
-  for (const auto & path_point : path.points) {
-    accumulated_distance +=
-      getDistance3d(prev_point.point.pose.position, path_point.point.pose.position);
-    prev_point = path_point;
-    const double distance_from_vehicle_front =
-      accumulated_distance - vehicle_pose_frenet.length - parameters_.base_link2front;
-    if (distance_from_vehicle_front < 0.0) {
-      continue;
-    }
+  for (size_t i = findFirstPointAhead(arc_lengths, front_length); i < path.points.size(); ++i) {
+    const auto & path_point = path.points.at(i);
+    const double distance_from_vehicle_front = arc_lengths.at(i) - front_length;
     for (const auto & lane_id : path_point.lane_ids) {
       if (lane_id == prev_lane_id) {
         continue;
       }
       prev_lane_id = lane_id;
 
-      const auto & lane = data_.getLaneFromId(lane_id);
-      if (
-        lane.attributeOr("turn_signal_distance", std::numeric_limits<double>::max()) <
-        distance_from_vehicle_front) {
+      const auto lane_attributes = data_.getLaneAttributes(lane_id);
+      if (lane_attributes.turn_signal_distance < distance_from_vehicle_front) {
         if (1 < path_point.lane_ids.size() && lane_id == path_point.lane_ids.back()) {
           continue;
         }
       }
-      if (lane.attributeOr("turn_direction", std::string("none")) == "left") {
-        signal_state_ptr->data = TurnSignal::LEFT;
-        *distance_ptr = distance_from_vehicle_front;
-        return true;
-      }
-      if (lane.attributeOr("turn_direction", std::string("none")) == "right") {
-        signal_state_ptr->data = TurnSignal::RIGHT;
+      if (lane_attributes.turn_direction != TurnSignal::NONE) {
+        signal_state_ptr->data = lane_attributes.turn_direction;
         *distance_ptr = distance_from_vehicle_front;
         return true;
       }
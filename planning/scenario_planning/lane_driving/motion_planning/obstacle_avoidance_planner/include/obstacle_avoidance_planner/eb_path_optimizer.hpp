@@ -148,6 +148,7 @@ struct TrajectoryParam
   double center_line_width;
   double acceleration_for_non_deceleration_range;
   double max_dist_for_extending_end_point;
+  double max_dist_for_incremental_replan;
 };
 
 struct Trajectories
@@ -253,6 +254,10 @@ private:
 
   std::unique_ptr<MPTOptimizer> mpt_optimizer_ptr_;
 
+  // state at the last optimization of the whole horizon
+  std::unique_ptr<geometry_msgs::msg::Pose> prev_full_optimized_ego_pose_ptr_;
+  std::vector<autoware_perception_msgs::msg::DynamicObject> prev_avoiding_objects_;
+
   void initializeSolver();
 
   Eigen::MatrixXd makePMatrix();
@@ -388,10 +393,6 @@ private:
     const geometry_msgs::msg::Vector3 & vehicle_shape,
     const geometry_msgs::msg::Pose & origin) const;
 
-  Rectangle getAbsShapeRectangle(
-    const Rectangle & rel_shape_rectangle_points, const geometry_msgs::msg::Point & offset_point,
-    const geometry_msgs::msg::Pose & origin) const;
-
   std::vector<geometry_msgs::msg::Point> getPaddedInterpolatedPoints(
     const std::vector<geometry_msgs::msg::Point> & interpolated_points, const int farthest_idx);
 
@@ -446,6 +447,14 @@ private:
     const std::vector<ConstrainRectangle> & constrain_rectangles, const int farthest_idx,
     const OptMode & opt_mode);
 
+  bool isAvoidingObjectChanged(
+    const std::vector<autoware_perception_msgs::msg::DynamicObject> & avoiding_objects) const;
+
+  boost::optional<Trajectories> getIncrementalTrajectories(
+    const geometry_msgs::msg::Pose & ego_pose,
+    const std::vector<autoware_planning_msgs::msg::PathPoint> & path_points,
+    const Trajectories & prev_trajs, DebugData * debug_data);
+
   FOAData getFOAData(
     const std::vector<ConstrainRectangle> & rectangles,
     const std::vector<geometry_msgs::msg::Point> & interpolated_points, const int farthest_idx);
@@ -43,6 +43,7 @@
 #include "obstacle_avoidance_planner/vehicle_model/vehicle_model_interface.hpp"
 
 #include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/Sparse>
 
 #include <autoware_planning_msgs/msg/path_point.hpp>
 #include <autoware_planning_msgs/msg/trajectory_point.hpp>
@@ -114,8 +115,8 @@ struct MPTMatrix
   Eigen::MatrixXd Aex;
   Eigen::MatrixXd Bex;
   Eigen::MatrixXd Wex;
-  Eigen::MatrixXd Cex;
-  Eigen::MatrixXd Qex;
+  Eigen::SparseMatrix<double> Cex;  // block diagonal
+  Eigen::SparseMatrix<double> Qex;  // block diagonal
   Eigen::MatrixXd R1ex;
   Eigen::MatrixXd R2ex;
   Eigen::MatrixXd Uref_ex;
@@ -123,13 +124,13 @@ struct MPTMatrix
 
 struct ObjectiveMatrix
 {
-  Eigen::MatrixXd hessian;
+  Eigen::SparseMatrix<double> hessian;  // upper triangle
   std::vector<double> gradient;
 };
 
 struct ConstraintMatrix
 {
-  Eigen::MatrixXd linear;
+  Eigen::SparseMatrix<double> linear;
   std::vector<double> lower_bound;
   std::vector<double> upper_bound;
 };
@@ -35,6 +35,7 @@
 #include <tf2/utils.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <limits>
 #include <memory>
@@ -136,6 +137,16 @@ boost::optional<Trajectories> EBPathOptimizer::generateOptimizedTrajectory(
     rclcpp::get_logger("EBPathOptimizer"), is_showing_debug_info_,
     "Processing driveable area time: = %f [ms]", elapsed_ms1);
 
+  // prev_trajs is reset on path shape changes, so only the optimized horizon is extended while the
+  // avoided objects stay the same
+  if (prev_trajs && !isAvoidingObjectChanged(debug_data->avoiding_objects)) {
+    const auto incremental_trajs =
+      getIncrementalTrajectories(ego_pose, path.points, *prev_trajs, debug_data);
+    if (incremental_trajs) {
+      return incremental_trajs;
+    }
+  }
+
   // get candidate points for optimization
   CandidatePoints candidate_points = getCandidatePoints(
     ego_pose, path.points, prev_trajs, cv_maps.drivable_area, path.drivable_area.info, debug_data);
@@ -176,6 +187,9 @@ boost::optional<Trajectories> EBPathOptimizer::generateOptimizedTrajectory(
     rclcpp::get_logger("EBPathOptimizer"), is_showing_debug_info_,
     "Extending trajectory time: = %f [ms]", elapsed_ms2);
 
+  prev_full_optimized_ego_pose_ptr_ = std::make_unique<geometry_msgs::msg::Pose>(ego_pose);
+  prev_avoiding_objects_ = debug_data->avoiding_objects;
+
   Trajectories traj;
   traj.smoothed_trajectory = opt_traj_points.get();
   traj.mpt_ref_points = mpt_trajs.get().ref_points;
@@ -185,6 +199,79 @@ boost::optional<Trajectories> EBPathOptimizer::generateOptimizedTrajectory(
   return traj;
 }
 
+bool EBPathOptimizer::isAvoidingObjectChanged(
+  const std::vector<autoware_perception_msgs::msg::DynamicObject> & avoiding_objects) const
+{
+  // avoided objects are almost stopped, so a larger shift is a new detection
+  constexpr double max_object_shift = 0.5;
+  if (avoiding_objects.size() != prev_avoiding_objects_.size()) {
+    return true;
+  }
+  for (const auto & object : avoiding_objects) {
+    const auto prev_object = std::find_if(
+      prev_avoiding_objects_.begin(), prev_avoiding_objects_.end(),
+      [&object](const auto & prev) { return prev.id == object.id; });
+    if (
+      prev_object == prev_avoiding_objects_.end() ||
+      util::calculate2DDistance(
+        prev_object->state.pose_covariance.pose.position,
+        object.state.pose_covariance.pose.position) > max_object_shift) {
+      return true;
+    }
+  }
+  return false;
+}
+
+boost::optional<Trajectories> EBPathOptimizer::getIncrementalTrajectories(
+  const geometry_msgs::msg::Pose & ego_pose,
+  const std::vector<autoware_planning_msgs::msg::PathPoint> & path_points,
+  const Trajectories & prev_trajs, DebugData * debug_data)
+{
+  if (
+    !prev_full_optimized_ego_pose_ptr_ ||
+    util::calculate2DDistance(ego_pose.position, prev_full_optimized_ego_pose_ptr_->position) >=
+      traj_param_.max_dist_for_incremental_replan) {
+    // also when the distance is 0, which disables the incremental replanning
+    return boost::none;
+  }
+  const auto & prev_mpt_points = prev_trajs.model_predictive_trajectory;
+  if (prev_mpt_points.empty() || prev_mpt_points.size() != prev_trajs.mpt_ref_points.size()) {
+    return boost::none;
+  }
+
+  // the previous model predictive trajectory from behind the ego is kept as it is
+  const int default_idx = -1;
+  const int nearest_idx = util::getNearestIdx(
+    prev_mpt_points, ego_pose, default_idx, traj_param_.delta_yaw_threshold_for_closest_point);
+  if (nearest_idx == default_idx) {
+    return boost::none;
+  }
+  const int begin_idx = std::max(
+    static_cast<int>(
+      nearest_idx -
+      traj_param_.backward_fixing_distance / traj_param_.delta_arc_length_for_mpt_points),
+    0);
+  if (
+    static_cast<int>(prev_mpt_points.size()) - begin_idx <=
+    traj_param_.num_fix_points_for_extending) {
+    return boost::none;
+  }
+
+  Trajectories traj;
+  traj.smoothed_trajectory = prev_trajs.smoothed_trajectory;
+  traj.mpt_ref_points.assign(
+    prev_trajs.mpt_ref_points.begin() + begin_idx, prev_trajs.mpt_ref_points.end());
+  traj.model_predictive_trajectory.assign(
+    prev_mpt_points.begin() + begin_idx, prev_mpt_points.end());
+  traj.extended_trajectory =
+    getExtendedOptimizedTrajectory(path_points, traj.model_predictive_trajectory, debug_data);
+  debug_data->smoothed_points = traj.smoothed_trajectory;
+  RCLCPP_INFO_EXPRESSION(
+    rclcpp::get_logger("EBPathOptimizer"), is_showing_debug_info_,
+    "Extended the previous trajectory without optimizing it again");
+  return traj;
+}
+
 boost::optional<std::vector<autoware_planning_msgs::msg::TrajectoryPoint>>
 EBPathOptimizer::getOptimizedTrajectory(
   [[maybe_unused]] const bool enable_avoidance, const autoware_planning_msgs::msg::Path & path,
@@ -945,37 +1032,6 @@ void EBPathOptimizer::updateConstrain(
   }
 }
 
-Rectangle EBPathOptimizer::getAbsShapeRectangle(
-  const Rectangle & rel_shape_rectangle_points, const geometry_msgs::msg::Point & offset_point,
-  const geometry_msgs::msg::Pose & origin) const
-{
-  geometry_msgs::msg::Point abs_target_point =
-    util::transformToAbsoluteCoordinate2D(offset_point, origin);
-
-  geometry_msgs::msg::Point abs_top_left;
-  abs_top_left.x = (rel_shape_rectangle_points.top_left.x + abs_target_point.x);
-  abs_top_left.y = (rel_shape_rectangle_points.top_left.y + abs_target_point.y);
-
-  geometry_msgs::msg::Point abs_top_right;
-  abs_top_right.x = (rel_shape_rectangle_points.top_right.x + abs_target_point.x);
-  abs_top_right.y = (rel_shape_rectangle_points.top_right.y + abs_target_point.y);
-
-  geometry_msgs::msg::Point abs_bottom_left;
-  abs_bottom_left.x = (rel_shape_rectangle_points.bottom_left.x + abs_target_point.x);
-  abs_bottom_left.y = (rel_shape_rectangle_points.bottom_left.y + abs_target_point.y);
-
-  geometry_msgs::msg::Point abs_bottom_right;
-  abs_bottom_right.x = (rel_shape_rectangle_points.bottom_right.x + abs_target_point.x);
-  abs_bottom_right.y = (rel_shape_rectangle_points.bottom_right.y + abs_target_point.y);
-
-  Rectangle abs_shape_rectangle_points;
-  abs_shape_rectangle_points.top_left = abs_top_left;
-  abs_shape_rectangle_points.top_right = abs_top_right;
-  abs_shape_rectangle_points.bottom_left = abs_bottom_left;
-  abs_shape_rectangle_points.bottom_right = abs_bottom_right;
-  return abs_shape_rectangle_points;
-}
-
 geometry_msgs::msg::Pose EBPathOptimizer::getOriginPose(
   const std::vector<geometry_msgs::msg::Point> & interpolated_points, const int interpolated_idx,
   const std::vector<autoware_planning_msgs::msg::PathPoint> & path_points)
@@ -1147,7 +1203,7 @@ OccupancyMaps EBPathOptimizer::getOccupancyMaps(
   const geometry_msgs::msg::Point & origin_point_in_image, const cv::Mat & clearance_map,
   const cv::Mat & only_objects_clearance_map, const nav_msgs::msg::MapMetaData & map_info) const
 {
-  Rectangle rel_shape_rectangles = getRelShapeRectangle(*keep_space_shape_ptr_, origin_pose);
+  const Rectangle rel_shape_rectangles = getRelShapeRectangle(*keep_space_shape_ptr_, origin_pose);
   const float clearance = std::max(
     clearance_map.ptr<float>(
       static_cast<int>(origin_point_in_image.y))[static_cast<int>(origin_point_in_image.x)] *
@@ -1156,104 +1212,84 @@ OccupancyMaps EBPathOptimizer::getOccupancyMaps(
   const float y_constrain_search_range = clearance - 0.5 * keep_space_shape_ptr_->y;
   const float x_constrain_search_range =
     std::fmin(constrain_param_.max_x_constrain_search_range, y_constrain_search_range);
-  std::vector<std::vector<int>> object_occupancy_map(
-    occupancy_points.size(), std::vector<int>(occupancy_points.front().size(), 0));
-  std::vector<std::vector<int>> road_occupancy_map(
-    occupancy_points.size(), std::vector<int>(occupancy_points.front().size(), 0));
+  const int x_side_length = occupancy_points.size();
+  const int y_side_length = occupancy_points.front().size();
+  OccupancyMaps occupancy_maps;
+  occupancy_maps.object_occupancy_map.assign(x_side_length, std::vector<int>(y_side_length, 0));
+  occupancy_maps.road_occupancy_map.assign(x_side_length, std::vector<int>(y_side_length, 0));
+
+  // same arithmetic as util::transformToAbsoluteCoordinate2D and util::transformMapToImage for
+  // the four corners of the shape, without the messages
+  const double cos_yaw = 1 - 2 * origin_pose.orientation.z * origin_pose.orientation.z;
+  const double sin_yaw = 2 * origin_pose.orientation.w * origin_pose.orientation.z;
+  const auto & grid_origin = map_info.origin;
+  const double grid_cos_yaw = 1 - 2 * grid_origin.orientation.z * grid_origin.orientation.z;
+  const double grid_sin_yaw = 2 * grid_origin.orientation.w * grid_origin.orientation.z;
+  const double map_y_height = map_info.height;
+  const double map_x_width = map_info.width;
+  const double scale = 1 / map_info.resolution;
+  const std::array<geometry_msgs::msg::Point, 4> rel_corners = {
+    rel_shape_rectangles.top_left, rel_shape_rectangles.top_right,
+    rel_shape_rectangles.bottom_left, rel_shape_rectangles.bottom_right};
+  // image cell of a corner, none outside the image
+  const auto get_corner_image_point =
+    [&](const geometry_msgs::msg::Point & rel_corner, const double abs_x, const double abs_y) {
+      const double tmp_x = rel_corner.x + abs_x - grid_origin.position.x;
+      const double tmp_y = rel_corner.y + abs_y - grid_origin.position.y;
+      const double relative_x = tmp_x * grid_cos_yaw + tmp_y * grid_sin_yaw;
+      const double relative_y = -tmp_x * grid_sin_yaw + tmp_y * grid_cos_yaw;
+      const double image_x = map_y_height - relative_y * scale;
+      const double image_y = map_x_width - relative_x * scale;
+      boost::optional<cv::Point> image_point;
+      if (
+        image_x >= 0 && image_x < static_cast<int>(map_y_height) && image_y >= 0 &&
+        image_y < static_cast<int>(map_x_width)) {
+        image_point = cv::Point(static_cast<int>(image_x), static_cast<int>(image_y));
+      }
+      return image_point;
+    };
+
+  std::array<boost::optional<cv::Point>, 4> corner_image_points;
   int x_idx_in_occupancy_map = 0;
   int y_idx_in_occupancy_map = 0;
   for (float x = -1 * x_constrain_search_range; x <= x_constrain_search_range + epsilon_;
        x += map_info.resolution * constrain_param_.coef_x_constrain_search_resolution) {
+    const int x_idx = x_side_length - x_idx_in_occupancy_map - 1;
     for (float y = -1 * y_constrain_search_range; y <= y_constrain_search_range + epsilon_;
          y += map_info.resolution * constrain_param_.coef_y_constrain_search_resolution) {
-      geometry_msgs::msg::Point rel_target_point;
-      rel_target_point.x = x;
-      rel_target_point.y = y;
-      Rectangle abs_shape_rectangles =
-        getAbsShapeRectangle(rel_shape_rectangles, rel_target_point, origin_pose);
-      float top_left_clearance = std::numeric_limits<float>::lowest();
-      float top_left_objects_clearance = std::numeric_limits<float>::lowest();
-      geometry_msgs::msg::Point top_left_image;
-      if (util::transformMapToImage(abs_shape_rectangles.top_left, map_info, top_left_image)) {
-        top_left_clearance = clearance_map.ptr<float>(static_cast<int>(
-                               top_left_image.y))[static_cast<int>(top_left_image.x)] *
-                             map_info.resolution;
-        top_left_objects_clearance = only_objects_clearance_map.ptr<float>(static_cast<int>(
-                                       top_left_image.y))[static_cast<int>(top_left_image.x)] *
-                                     map_info.resolution;
-      }
-
-      float top_right_clearance = std::numeric_limits<float>::lowest();
-      float top_right_objects_clearance = std::numeric_limits<float>::lowest();
-      geometry_msgs::msg::Point top_right_image;
-      if (util::transformMapToImage(abs_shape_rectangles.top_right, map_info, top_right_image)) {
-        top_right_clearance = clearance_map.ptr<float>(static_cast<int>(
-                                top_right_image.y))[static_cast<int>(top_right_image.x)] *
-                              map_info.resolution;
-        top_right_objects_clearance = only_objects_clearance_map.ptr<float>(static_cast<int>(
-                                        top_right_image.y))[static_cast<int>(top_right_image.x)] *
-                                      map_info.resolution;
-      }
-      float bottom_left_clearance = std::numeric_limits<float>::lowest();
-      float bottom_left_objects_clearance = std::numeric_limits<float>::lowest();
-      geometry_msgs::msg::Point bottom_left_image;
-      if (util::transformMapToImage(
-            abs_shape_rectangles.bottom_left, map_info, bottom_left_image)) {
-        bottom_left_clearance = clearance_map.ptr<float>(static_cast<int>(
-                                  bottom_left_image.y))[static_cast<int>(bottom_left_image.x)] *
-                                map_info.resolution;
-        bottom_left_objects_clearance =
-          only_objects_clearance_map.ptr<float>(
-            static_cast<int>(bottom_left_image.y))[static_cast<int>(bottom_left_image.x)] *
-          map_info.resolution;
-      }
-      float bottom_right_clearance = std::numeric_limits<float>::lowest();
-      float bottom_right_objects_clearance = std::numeric_limits<float>::lowest();
-      geometry_msgs::msg::Point bottom_right_image;
-      if (util::transformMapToImage(
-            abs_shape_rectangles.bottom_right, map_info, bottom_right_image)) {
-        bottom_right_clearance = clearance_map.ptr<float>(static_cast<int>(
-                                   bottom_right_image.y))[static_cast<int>(bottom_right_image.x)] *
-                                 map_info.resolution;
-        bottom_right_objects_clearance =
-          only_objects_clearance_map.ptr<float>(
-            static_cast<int>(bottom_right_image.y))[static_cast<int>(bottom_right_image.x)] *
-          map_info.resolution;
-      }
-
-      const int x_idx = occupancy_points.size() - x_idx_in_occupancy_map - 1;
-      const int y_idx = occupancy_points.front().size() - y_idx_in_occupancy_map - 1;
-      if (
-        x_idx < 0 || x_idx >= static_cast<int>(occupancy_points.size()) || y_idx < 0 ||
-        y_idx >= static_cast<int>(occupancy_points.front().size())) {
+      const int y_idx = y_side_length - y_idx_in_occupancy_map - 1;
+      if (x_idx < 0 || x_idx >= x_side_length || y_idx < 0 || y_idx >= y_side_length) {
         continue;
       }
-      if (
-        top_left_clearance < constrain_param_.clearance_from_road ||
-        top_right_clearance < constrain_param_.clearance_from_road ||
-        bottom_right_clearance < constrain_param_.clearance_from_road ||
-        bottom_left_clearance < constrain_param_.clearance_from_road ||
-        top_left_objects_clearance < constrain_param_.clearance_from_object ||
-        top_right_objects_clearance < constrain_param_.clearance_from_object ||
-        bottom_right_objects_clearance < constrain_param_.clearance_from_object ||
-        bottom_left_objects_clearance < constrain_param_.clearance_from_object) {
-        object_occupancy_map[x_idx][y_idx] = 1;
+      const double abs_x = x * cos_yaw - y * sin_yaw + origin_pose.position.x;
+      const double abs_y = x * sin_yaw + y * cos_yaw + origin_pose.position.y;
+
+      // a corner outside the image has no clearance
+      bool is_road_occupied = false;
+      for (size_t i = 0; i < rel_corners.size(); ++i) {
+        corner_image_points[i] = get_corner_image_point(rel_corners[i], abs_x, abs_y);
+        const auto & p = corner_image_points[i];
+        if (
+          !p || clearance_map.ptr<float>(p->y)[p->x] * map_info.resolution <
+                  constrain_param_.clearance_from_road) {
+          is_road_occupied = true;
+          break;
+        }
       }
-      if (
-        top_left_clearance < constrain_param_.clearance_from_road ||
-        top_right_clearance < constrain_param_.clearance_from_road ||
-        bottom_right_clearance < constrain_param_.clearance_from_road ||
-        bottom_left_clearance < constrain_param_.clearance_from_road) {
-        road_occupancy_map[x_idx][y_idx] = 1;
+      bool is_object_occupied = is_road_occupied;
+      for (size_t i = 0; i < rel_corners.size() && !is_object_occupied; ++i) {
+        const auto & p = corner_image_points[i];
+        is_object_occupied = only_objects_clearance_map.ptr<float>(p->y)[p->x] *
+                               map_info.resolution <
+                             constrain_param_.clearance_from_object;
       }
+      occupancy_maps.object_occupancy_map[x_idx][y_idx] = is_object_occupied ? 1 : 0;
+      occupancy_maps.road_occupancy_map[x_idx][y_idx] = is_road_occupied ? 1 : 0;
       y_idx_in_occupancy_map++;
     }
     x_idx_in_occupancy_map++;
     y_idx_in_occupancy_map = 0;
   }
-  OccupancyMaps occupancy_maps;
-  occupancy_maps.object_occupancy_map = object_occupancy_map;
-  occupancy_maps.road_occupancy_map = road_occupancy_map;
   return occupancy_maps;
 }
 
@@ -21,6 +21,7 @@
 #include "obstacle_avoidance_planner/vehicle_model/vehicle_model_bicycle_kinematics_no_delay.hpp"
 
 #include <opencv2/core.hpp>
+#include <osqp_interface/csc_matrix_conv.hpp>
 #include <osqp_interface/osqp_interface.hpp>
 
 #include <nav_msgs/msg/map_meta_data.hpp>
@@ -35,6 +36,20 @@
 #include <memory>
 #include <vector>
 
+namespace
+{
+void addBlockTriplets(
+  const int row, const int col, const Eigen::MatrixXd & block,
+  std::vector<Eigen::Triplet<double>> * triplets)
+{
+  for (int i = 0; i < block.rows(); ++i) {
+    for (int j = 0; j < block.cols(); ++j) {
+      triplets->emplace_back(row + i, col + j, block(i, j));
+    }
+  }
+}
+}  // namespace
+
 MPTOptimizer::MPTOptimizer(
   const bool is_showing_debug_info, const QPParam & qp_param, const TrajectoryParam & traj_param,
   const ConstrainParam & constraint_param, const VehicleParam & vehicle_param,
@@ -330,8 +345,11 @@ boost::optional<MPTMatrix> MPTOptimizer::generateMPTMatrix(
   Eigen::MatrixXd Aex = Eigen::MatrixXd::Zero(DIM_X * N, DIM_X);      // state transition
   Eigen::MatrixXd Bex = Eigen::MatrixXd::Zero(DIM_X * N, DIM_U * N);  // control input
   Eigen::MatrixXd Wex = Eigen::MatrixXd::Zero(DIM_X * N, 1);
-  Eigen::MatrixXd Cex = Eigen::MatrixXd::Zero(DIM_Y * N, DIM_X * N);
-  Eigen::MatrixXd Qex = Eigen::MatrixXd::Zero(DIM_Y * N, DIM_Y * N);
+  // the blocks of the block diagonal Cex and Qex, a dense Cex * Bex would cost O(N^3)
+  std::vector<Eigen::Triplet<double>> Cex_triplets;
+  std::vector<Eigen::Triplet<double>> Qex_triplets;
+  Cex_triplets.reserve(DIM_Y * DIM_X * N);
+  Qex_triplets.reserve(DIM_Y * DIM_Y * N);
   Eigen::MatrixXd R1ex = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U * N);
   Eigen::MatrixXd R2ex = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U * N);
   Eigen::MatrixXd Uref_ex = Eigen::MatrixXd::Zero(DIM_U * N, 1);
@@ -405,8 +423,8 @@ boost::optional<MPTMatrix> MPTOptimizer::generateMPTMatrix(
       Wex.block(idx_x_i, 0, DIM_X, 1) = Ad * Wex.block(idx_x_i_prev, 0, DIM_X, 1) + Wd;
     }
     Bex.block(idx_x_i, idx_u_i, DIM_X, DIM_U) = Bd;
-    Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X) = Cd;
-    Qex.block(idx_y_i, idx_y_i, DIM_Y, DIM_Y) = Q_adaptive;
+    addBlockTriplets(idx_y_i, idx_x_i, Cd, &Cex_triplets);
+    addBlockTriplets(idx_y_i, idx_y_i, Q_adaptive, &Qex_triplets);
     R1ex.block(idx_u_i, idx_u_i, DIM_U, DIM_U) = R_adaptive;
 
     /* get reference input (feed-forward) */
@@ -423,14 +441,16 @@ boost::optional<MPTMatrix> MPTOptimizer::generateMPTMatrix(
   m.Aex = Aex;
   m.Bex = Bex;
   m.Wex = Wex;
-  m.Cex = Cex;
-  m.Qex = Qex;
+  m.Cex.resize(DIM_Y * N, DIM_X * N);
+  m.Cex.setFromTriplets(Cex_triplets.begin(), Cex_triplets.end());
+  m.Qex.resize(DIM_Y * N, DIM_Y * N);
+  m.Qex.setFromTriplets(Qex_triplets.begin(), Qex_triplets.end());
   m.R1ex = R1ex;
   m.R2ex = R2ex;
   m.Uref_ex = Uref_ex;
   if (
-    m.Aex.array().isNaN().any() || m.Bex.array().isNaN().any() || m.Cex.array().isNaN().any() ||
-    m.Wex.array().isNaN().any() || m.Qex.array().isNaN().any() || m.R1ex.array().isNaN().any() ||
+    m.Aex.array().isNaN().any() || m.Bex.array().isNaN().any() || m.Cex.coeffs().isNaN().any() ||
+    m.Wex.array().isNaN().any() || m.Qex.coeffs().isNaN().any() || m.R1ex.array().isNaN().any() ||
     m.R2ex.array().isNaN().any() || m.Uref_ex.array().isNaN().any()) {
     RCLCPP_WARN(rclcpp::get_logger("MPTOptimizer"), "[Avoidance] MPT matrix includes NaN.");
     return boost::none;
@@ -526,10 +546,14 @@ boost::optional<Eigen::VectorXd> MPTOptimizer::executeOptimization(
   ConstraintMatrix const_m =
     getConstraintMatrix(enable_avoidance, x0, m, maps, ref_points, path_points, debug_data);
 
-  osqp_solver_ptr_ = std::make_unique<osqp::OSQPInterface>(
-    obj_m.hessian, const_m.linear, obj_m.gradient, const_m.lower_bound, const_m.upper_bound,
-    1.0e-3);
-  osqp_solver_ptr_->updateEpsRel(1.0e-3);
+  // the workspace is kept across cycles to warm start while the problem structure is unchanged
+  if (!osqp_solver_ptr_) {
+    osqp_solver_ptr_ = std::make_unique<osqp::OSQPInterface>(1.0e-3);
+    osqp_solver_ptr_->updateEpsRel(1.0e-3);
+  }
+  osqp_solver_ptr_->updateProblem(
+    osqp::calCSCMatrixTrapezoidal(obj_m.hessian), osqp::calCSCMatrix(const_m.linear),
+    obj_m.gradient, const_m.lower_bound, const_m.upper_bound);
   const auto result = osqp_solver_ptr_->optimize();
 
   int solution_status = std::get<3>(result);
@@ -861,30 +885,31 @@ ObjectiveMatrix MPTOptimizer::getObjectiveMatrix(
   const Eigen::MatrixXd CB = m.Cex * m.Bex;
   const Eigen::MatrixXd QCB = m.Qex * CB;
   // Eigen::MatrixXd H = CB.transpose() * QCB + m.R1ex + m.R2ex;
-  // This calculation is heavy. looking for a good way.
+  // Only the upper triangle is computed, the solver does not read the lower one
   Eigen::MatrixXd H = Eigen::MatrixXd::Zero(DIM_U_N, DIM_U_N);
   H.triangularView<Eigen::Upper>() = CB.transpose() * QCB;
   H.triangularView<Eigen::Upper>() += m.R1ex + m.R2ex;
-  H.triangularView<Eigen::Lower>() = H.transpose();
   Eigen::VectorXd f =
     (m.Cex * (m.Aex * x0 + m.Wex)).transpose() * QCB - m.Uref_ex.transpose() * m.R1ex;
   addSteerWeightF(&f);
 
   constexpr int num_lat_constraint = 3;
   const int num_objective_variables = DIM_U_N * (1 + num_lat_constraint);
-  Eigen::MatrixXd extend_h = Eigen::MatrixXd::Zero(DIM_U_N, DIM_U_N);
   Eigen::VectorXd extend_f = Eigen::VectorXd::Ones(DIM_U_N);
-  Eigen::MatrixXd concat_h =
-    Eigen::MatrixXd::Zero(num_objective_variables, num_objective_variables);
+  // the slack variables have no quadratic cost, only the block of the inputs is stored
+  std::vector<Eigen::Triplet<double>> concat_h_triplets;
+  concat_h_triplets.reserve(DIM_U_N * (DIM_U_N + 1) / 2);
+  for (int j = 0; j < DIM_U_N; ++j) {
+    for (int i = 0; i <= j; ++i) {
+      concat_h_triplets.emplace_back(i, j, H(i, j));
+    }
+  }
   Eigen::VectorXd concat_f = Eigen::VectorXd::Zero(num_objective_variables);
-  concat_h.block(0, 0, DIM_U_N, DIM_U_N) = H;
-  concat_h.block(DIM_U_N, DIM_U_N, DIM_U_N, DIM_U_N) = extend_h;
-  concat_h.block(DIM_U_N * 2, DIM_U_N * 2, DIM_U_N, DIM_U_N) = extend_h;
-  concat_h.block(DIM_U_N * 3, DIM_U_N * 3, DIM_U_N, DIM_U_N) = extend_h;
   concat_f << f, mpt_param_ptr_->base_point_weight * extend_f,
     mpt_param_ptr_->top_point_weight * extend_f, mpt_param_ptr_->mid_point_weight * extend_f;
   ObjectiveMatrix obj_matrix;
-  obj_matrix.hessian = concat_h;
+  obj_matrix.hessian.resize(num_objective_variables, num_objective_variables);
+  obj_matrix.hessian.setFromTriplets(concat_h_triplets.begin(), concat_h_triplets.end());
   obj_matrix.gradient = {concat_f.data(), concat_f.data() + concat_f.rows()};
 
   return obj_matrix;
@@ -911,174 +936,98 @@ ConstraintMatrix MPTOptimizer::getConstraintMatrix(
 
   const auto bounds = getReferenceBounds(enable_avoidance, ref_points, maps, debug_data);
 
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(3 * N_ref * N_point + N_ref, N_dec);
-  Eigen::VectorXd lb = Eigen::VectorXd::Constant(3 * N_ref * N_point + N_ref, -osqp::INF);
-  Eigen::VectorXd ub = Eigen::VectorXd::Constant(3 * N_ref * N_point + N_ref, osqp::INF);
-
-  // Define constraint matrices and vectors
-  // Gap from reference point around vehicle base_link
-  {
-    // C := [I | O | O]
-    Eigen::MatrixXd C = Eigen::MatrixXd::Zero(N_ref, N_ref * N_state);
-    for (size_t i = 0; i < N_ref; ++i) {
-      C(i, N_state * i) = 1;
-    }
-    // bias := Cast * (Aex * x0 + Wex)
-    Eigen::VectorXd bias = C * (m.Aex * x0 + m.Wex);
-    // A_blk := [C * Bex | I | O | O
-    //          -C * Bex | I | O | O
-    //               O   | I | O | O]
-    Eigen::MatrixXd A_blk = Eigen::MatrixXd::Zero(3 * N_ref, N_dec);
-    A_blk.block(0, 0, N_ref, N_ref) = C * m.Bex;
-    A_blk.block(0, N_ref, N_ref, N_ref) = Eigen::MatrixXd::Identity(N_ref, N_ref);
-    A_blk.block(N_ref, 0, N_ref, N_ref) = -C * m.Bex;
-    A_blk.block(N_ref, N_ref, N_ref, N_ref) = Eigen::MatrixXd::Identity(N_ref, N_ref);
-    A_blk.block(2 * N_ref, N_ref, N_ref, N_ref) = Eigen::MatrixXd::Identity(N_ref, N_ref);
-    // lb_blk := [-bias + bounds.lb
-    //             bias - bounds.ub
-    //             0]
-    Eigen::VectorXd lb_blk = Eigen::VectorXd::Zero(3 * N_ref);
+  const size_t N_row = 3 * N_ref * N_point + N_ref;
+  std::vector<Eigen::Triplet<double>> triplets;
+  Eigen::VectorXd lb = Eigen::VectorXd::Constant(N_row, -osqp::INF);
+  Eigen::VectorXd ub = Eigen::VectorXd::Constant(N_row, osqp::INF);
+
+  // The rows of C select the state of a single point, C := diag([Cast_0, ..., Cast_N-1]), so the
+  // products with Aex, Bex and Wex are computed row by row instead of as dense matrices.
+  // Xex without input := Aex * x0 + Wex
+  const Eigen::VectorXd X0 = m.Aex * x0 + m.Wex;
+  // Cast_i * Bex, whose block row i is zero after the input i
+  const auto calcCastBex = [&](const Eigen::RowVectorXd & Cast, const size_t i) {
+    const Eigen::RowVectorXd CB_i = Cast * m.Bex.block(N_state * i, 0, N_state, i + 1);
+    return CB_i;
+  };
+  // Cast_i * (Aex * x0 + Wex)
+  const auto calcBias = [&](const Eigen::RowVectorXd & Cast, const size_t i) {
+    return Cast.dot(X0.segment(N_state * i, N_state));
+  };
+
+  // Gap from reference point around vehicle base_link, top and middle, as one block each
+  // A_blk := [C * Bex | I
+  //          -C * Bex | I
+  //               O   | I]
+  // lb_blk := [-bias + bounds.lb
+  //             bias - bounds.ub
+  //             0]
+  for (size_t k = 0; k < N_point; ++k) {
+    const size_t row = 3 * N_ref * k;
+    const size_t col_slack = N_ref * (k + 1);
     for (size_t i = 0; i < N_ref; ++i) {
-      if (i == N_ref - 1) {
-        lb_blk(i) = -bias(i) + bounds[i].c0.lb;
-        lb_blk(N_ref + i) = bias(i) - bounds[i].c0.ub;
+      const size_t ref_idx = i == N_ref - 1 ? i : i + 1;
+      // base_link: C := [I | O | O], bias := Cast * (Aex * x0 + Wex)
+      // top and middle: C := [diag(cos(alpha)) | diag(l*cos(alpha)) | O],
+      //                 bias := Cast * (Aex * x0 + Wex) - l * sin(alpha)
+      Eigen::RowVectorXd Cast = Eigen::RowVectorXd::Zero(N_state);
+      double bias_offset = 0.0;
+      Bounds::SingleBounds bound = bounds[ref_idx].c0;
+      if (k == 0) {
+        Cast(0) = 1;
       } else {
-        lb_blk(i) = -bias(i) + bounds[i + 1].c0.lb;
-        lb_blk(N_ref + i) = bias(i) - bounds[i + 1].c0.ub;
+        const double alpha = k == 1 ? ref_points[ref_idx].delta_yaw_from_p1
+                                    : ref_points[ref_idx].delta_yaw_from_p2;
+        Cast(0) = std::cos(alpha);
+        Cast(1) = dist_vec[k] * std::cos(alpha);
+        bias_offset = dist_vec[k] * std::sin(alpha);
+        bound = k == 1 ? bounds[ref_idx].c1 : bounds[ref_idx].c2;
       }
-    }
-    // Assign
-    A.block(0, 0, 3 * N_ref, N_dec) = A_blk;
-    lb.segment(0, 3 * N_ref) = lb_blk;
-  }
 
-  // Gap from reference point around vehicle top
-  {
-    // C := diag([cos(alpha1) | l1*cos(alpha1) | 0])
-    Eigen::MatrixXd C = Eigen::MatrixXd::Zero(N_ref, N_ref * N_state);
-    for (size_t i = 0; i < N_ref; ++i) {
-      Eigen::MatrixXd Cast = Eigen::MatrixXd::Zero(1, N_state);
-      if (i == N_ref - 1) {
-        Cast(0, 0) = std::cos(ref_points[i].delta_yaw_from_p1);
-        Cast(0, 1) = dist_vec[1] * std::cos(ref_points[i].delta_yaw_from_p1);
-      } else {
-        Cast(0, 0) = std::cos(ref_points[i + 1].delta_yaw_from_p1);
-        Cast(0, 1) = dist_vec[1] * std::cos(ref_points[i + 1].delta_yaw_from_p1);
-      }
-      C.block(i, N_state * i, 1, N_state) = Cast;
-    }
-    // bias := Cast * (Aex * x0 + Wex) - l1 * sin(alpha1)
-    Eigen::VectorXd bias = C * (m.Aex * x0 + m.Wex);
-    for (size_t i = 0; i < N_ref; ++i) {
-      if (i == N_ref - 1) {
-        bias(i) -= dist_vec[1] * std::sin(ref_points[i].delta_yaw_from_p1);
-      } else {
-        bias(i) -= dist_vec[1] * std::sin(ref_points[i + 1].delta_yaw_from_p1);
-      }
-    }
-    // A_blk := [C * Bex | O | I | O
-    //          -C * Bex | O | I | O
-    //               O   | O | I | O]
-    Eigen::MatrixXd A_blk = Eigen::MatrixXd::Zero(3 * N_ref, N_dec);
-    A_blk.block(0, 0, N_ref, N_ref) = C * m.Bex;
-    A_blk.block(0, 2 * N_ref, N_ref, N_ref) = Eigen::MatrixXd::Identity(N_ref, N_ref);
-    A_blk.block(N_ref, 0, N_ref, N_ref) = -C * m.Bex;
-    A_blk.block(N_ref, 2 * N_ref, N_ref, N_ref) = Eigen::MatrixXd::Identity(N_ref, N_ref);
-    A_blk.block(2 * N_ref, 2 * N_ref, N_ref, N_ref) = Eigen::MatrixXd::Identity(N_ref, N_ref);
-    // lb_blk := [-bias + bounds.lb
-    //             bias - bounds.ub
-    //             0]
-    Eigen::VectorXd lb_blk = Eigen::VectorXd::Zero(3 * N_ref);
-    for (size_t i = 0; i < N_ref; ++i) {
-      if (i == N_ref - 1) {
-        lb_blk(i) = -bias(i) + bounds[i].c1.lb;
-        lb_blk(N_ref + i) = bias(i) - bounds[i].c1.ub;
-      } else {
-        lb_blk(i) = -bias(i) + bounds[i + 1].c1.lb;
-        lb_blk(N_ref + i) = bias(i) - bounds[i + 1].c1.ub;
-      }
-    }
-    // Assign
-    A.block(3 * N_ref, 0, 3 * N_ref, N_dec) = A_blk;
-    lb.segment(3 * N_ref, 3 * N_ref) = lb_blk;
-  }
-  // Gap from reference point around vehicle middle
-  {
-    // C := [diag(cos(alpha2)) | diag(l2*cos(alpha2)) | O]
-    Eigen::MatrixXd C = Eigen::MatrixXd::Zero(N_ref, N_ref * N_state);
-    for (size_t i = 0; i < N_ref; ++i) {
-      Eigen::MatrixXd Cast = Eigen::MatrixXd::Zero(1, N_state);
-      if (i == N_ref - 1) {
-        Cast(0, 0) = std::cos(ref_points[i].delta_yaw_from_p2);
-        Cast(0, 1) = dist_vec[2] * std::cos(ref_points[i].delta_yaw_from_p2);
-      } else {
-        Cast(0, 0) = std::cos(ref_points[i + 1].delta_yaw_from_p2);
-        Cast(0, 1) = dist_vec[2] * std::cos(ref_points[i + 1].delta_yaw_from_p2);
+      const Eigen::RowVectorXd CB_i = calcCastBex(Cast, i);
+      for (size_t j = 0; j <= i; ++j) {
+        triplets.emplace_back(row + i, j, CB_i(j));
+        triplets.emplace_back(row + N_ref + i, j, -CB_i(j));
       }
-      C.block(i, N_state * i, 1, N_state) = Cast;
+      triplets.emplace_back(row + i, col_slack + i, 1.0);
+      triplets.emplace_back(row + N_ref + i, col_slack + i, 1.0);
+      triplets.emplace_back(row + 2 * N_ref + i, col_slack + i, 1.0);
+
+      const double bias = calcBias(Cast, i) - bias_offset;
+      lb(row + i) = -bias + bound.lb;
+      lb(row + N_ref + i) = bias - bound.ub;
+      lb(row + 2 * N_ref + i) = 0.0;
     }
-    // bias := Cast * (Aex * x0 + Wex) - l2 * sin(alpha2)
-    Eigen::VectorXd bias = C * (m.Aex * x0 + m.Wex);
-    for (size_t i = 0; i < N_ref; ++i) {
-      if (i == N_ref - 1) {
-        bias(i) -= dist_vec[2] * std::sin(ref_points[i].delta_yaw_from_p2);
-      } else {
-        bias(i) -= dist_vec[2] * std::sin(ref_points[i + 1].delta_yaw_from_p2);
-      }
-    }
-    // A_blk := [C * Bex | O | O | I
-    //          -C * Bex | O | O | I
-    //               O   | O | O | I]
-    Eigen::MatrixXd A_blk = Eigen::MatrixXd::Zero(3 * N_ref, N_dec);
-    A_blk.block(0, 0, N_ref, N_ref) = C * m.Bex;
-    A_blk.block(0, 3 * N_ref, N_ref, N_ref) = Eigen::MatrixXd::Identity(N_ref, N_ref);
-    A_blk.block(N_ref, 0, N_ref, N_ref) = -C * m.Bex;
-    A_blk.block(N_ref, 3 * N_ref, N_ref, N_ref) = Eigen::MatrixXd::Identity(N_ref, N_ref);
-    A_blk.block(2 * N_ref, 3 * N_ref, N_ref, N_ref) = Eigen::MatrixXd::Identity(N_ref, N_ref);
-    // lb_blk := [-bias + bounds.lb
-    //             bias - bounds.ub
-    //             0]
-    Eigen::VectorXd lb_blk = Eigen::VectorXd::Zero(3 * N_ref);
-    for (size_t i = 0; i < N_ref; ++i) {
-      if (i == N_ref - 1) {
-        lb_blk(i) = -bias(i) + bounds[i].c2.lb;
-        lb_blk(N_ref + i) = bias(i) - bounds[i].c2.ub;
-      } else {
-        lb_blk(i) = -bias(i) + bounds[i + 1].c2.lb;
-        lb_blk(N_ref + i) = bias(i) - bounds[i + 1].c2.ub;
-      }
-    }
-    // Assign
-    A.block(2 * 3 * N_ref, 0, 3 * N_ref, N_dec) = A_blk;
-    lb.segment(2 * 3 * N_ref, 3 * N_ref) = lb_blk;
   }
 
   // Fixed points constraint
   {
     // C := [I | O | O]
-    Eigen::MatrixXd C = Eigen::MatrixXd::Zero(N_ref, N_ref * N_state);
+    Eigen::RowVectorXd Cast = Eigen::RowVectorXd::Zero(N_state);
+    Cast(0) = 1;
+    const size_t row = 3 * N_point * N_ref;
     for (size_t i = 0; i < N_ref; ++i) {
-      C(i, N_state * i) = 1;
-    }
-    // bias := Cast * (Aex * x0 + Wex)
-    Eigen::VectorXd bias = C * (m.Aex * x0 + m.Wex);
+      const Eigen::RowVectorXd CB_i = calcCastBex(Cast, i);
+      for (size_t j = 0; j <= i; ++j) {
+        triplets.emplace_back(row + i, j, CB_i(j));
+      }
 
-    // Assign
-    A.block(3 * N_point * N_ref, 0, N_ref, N_ref) = C * m.Bex;
-    for (size_t i = 0; i < N_ref; ++i) {
+      // bias := Cast * (Aex * x0 + Wex)
+      const double bias = calcBias(Cast, i);
       if (ref_points[i + 1].fix_state && i + 1 < N_ref) {
-        lb(3 * N_point * N_ref + i) = ref_points[i + 1].fix_state.get()(0) - bias(i);
-        ub(3 * N_point * N_ref + i) = ref_points[i + 1].fix_state.get()(0) - bias(i);
+        lb(row + i) = ref_points[i + 1].fix_state.get()(0) - bias;
+        ub(row + i) = ref_points[i + 1].fix_state.get()(0) - bias;
       } else if (i == ref_points.size() - 1 && mpt_param_ptr_->is_hard_fixing_terminal_point) {
-        lb(3 * N_point * N_ref + i) = -bias(i);
-        ub(3 * N_point * N_ref + i) = -bias(i);
+        lb(row + i) = -bias;
+        ub(row + i) = -bias;
       }
     }
   }
 
   ConstraintMatrix constraint_matrix;
 
-  constraint_matrix.linear = A;
+  constraint_matrix.linear.resize(N_row, N_dec);
+  constraint_matrix.linear.setFromTriplets(triplets.begin(), triplets.end());
 
   for (int i = 0; i < lb.size(); ++i) {
     constraint_matrix.lower_bound.push_back(lb(i));
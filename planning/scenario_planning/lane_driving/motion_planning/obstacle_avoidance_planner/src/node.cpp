@@ -47,6 +47,46 @@
 #include <string>
 #include <vector>
 
+namespace
+{
+// distance from the point to the segment from the point at seg_idx to the next one
+double calcDistanceToSegment(
+  const std::vector<autoware_planning_msgs::msg::PathPoint> & points, const size_t seg_idx,
+  const geometry_msgs::msg::Point & point)
+{
+  const auto & p1 = points.at(seg_idx).pose.position;
+  if (seg_idx + 1 >= points.size()) {
+    return util::calculate2DDistance(p1, point);
+  }
+  const auto & p2 = points.at(seg_idx + 1).pose.position;
+  const double seg_x = p2.x - p1.x;
+  const double seg_y = p2.y - p1.y;
+  const double squared_seg_length = seg_x * seg_x + seg_y * seg_y;
+  if (squared_seg_length < 1e-6) {
+    return util::calculate2DDistance(p1, point);
+  }
+  const double ratio = std::max(
+    0.0,
+    std::min(1.0, ((point.x - p1.x) * seg_x + (point.y - p1.y) * seg_y) / squared_seg_length));
+  geometry_msgs::msg::Point projected_point;
+  projected_point.x = p1.x + ratio * seg_x;
+  projected_point.y = p1.y + ratio * seg_y;
+  return util::calculate2DDistance(projected_point, point);
+}
+
+// the upstream planner publishes the same path until its input changes
+bool isSamePath(
+  const std::vector<autoware_planning_msgs::msg::PathPoint> & points,
+  const std::vector<autoware_planning_msgs::msg::PathPoint> & prev_points)
+{
+  return std::equal(
+    points.begin(), points.end(), prev_points.begin(), prev_points.end(),
+    [](const auto & a, const auto & b) {
+      return a.pose.position.x == b.pose.position.x && a.pose.position.y == b.pose.position.y;
+    });
+}
+}  // namespace
+
 ObstacleAvoidancePlanner::ObstacleAvoidancePlanner(const rclcpp::NodeOptions & node_options)
 : Node("obstacle_avoidance_planner", node_options), min_num_points_for_getting_yaw_(2)
 {
@@ -73,6 +113,7 @@ ObstacleAvoidancePlanner::ObstacleAvoidancePlanner(const rclcpp::NodeOptions & n
     create_publisher<nav_msgs::msg::OccupancyGrid>("~/debug/object_clearance_map", durable_qos);
   debug_area_with_objects_pub_ =
     create_publisher<nav_msgs::msg::OccupancyGrid>("~/debug/area_with_objects", durable_qos);
+  latency_tracer_ptr_ = std::make_unique<autoware_utils::LatencyTracer>(this);
 
   path_sub_ = create_subscription<autoware_planning_msgs::msg::Path>(
     "~/input/path", rclcpp::QoS{1},
@@ -180,6 +221,8 @@ ObstacleAvoidancePlanner::ObstacleAvoidancePlanner(const rclcpp::NodeOptions & n
   min_delta_time_sec_for_replan_ = declare_parameter("min_delta_time_sec_for_replan", 1.0);
   distance_for_path_shape_change_detection_ =
     declare_parameter("distance_for_path_shape_change_detection", 2.0);
+  traj_param_->max_dist_for_incremental_replan =
+    declare_parameter("max_dist_for_incremental_replan", 0.0);
 
   // vehicle param
   const auto vehicle_info = vehicle_info_util::VehicleInfoUtil(*this).getVehicleInfo();
@@ -305,6 +348,7 @@ rcl_interfaces::msg::SetParametersResult ObstacleAvoidancePlanner::paramCallback
 void ObstacleAvoidancePlanner::pathCallback(const autoware_planning_msgs::msg::Path::SharedPtr msg)
 {
   std::lock_guard<std::mutex> lock(mutex_);
+  latency_tracer_ptr_->onReceive(msg->header.stamp);
   current_ego_pose_ptr_ = getCurrentEgoPose();
   if (
     msg->points.empty() || msg->drivable_area.data.empty() || !current_ego_pose_ptr_ ||
@@ -313,6 +357,7 @@ void ObstacleAvoidancePlanner::pathCallback(const autoware_planning_msgs::msg::P
   }
   autoware_planning_msgs::msg::Trajectory output_trajectory_msg = generateTrajectory(*msg);
   trajectory_pub_->publish(output_trajectory_msg);
+  latency_tracer_ptr_->onPublish(output_trajectory_msg.header.stamp);
 }
 
 void ObstacleAvoidancePlanner::twistCallback(const geometry_msgs::msg::TwistStamped::SharedPtr msg)
@@ -509,6 +554,9 @@ bool ObstacleAvoidancePlanner::isPathShapeChanged(
   if (!prev_path_points) {
     return true;
   }
+  if (isSamePath(path_points, *prev_path_points)) {
+    return false;
+  }
   const int default_nearest_prev_path_idx = 0;
   const int nearest_prev_path_idx = util::getNearestIdx(
     *prev_path_points, ego_pose, default_nearest_prev_path_idx,
@@ -518,21 +566,19 @@ bool ObstacleAvoidancePlanner::isPathShapeChanged(
     path_points, ego_pose, default_nearest_path_idx,
     traj_param_->delta_yaw_threshold_for_closest_point);
 
-  const auto prev_first = prev_path_points->begin() + nearest_prev_path_idx;
-  const auto prev_last = prev_path_points->end();
-  std::vector<autoware_planning_msgs::msg::PathPoint> truncated_prev_points(prev_first, prev_last);
-
-  const auto first = path_points.begin() + nearest_path_idx;
-  const auto last = path_points.end();
-  std::vector<autoware_planning_msgs::msg::PathPoint> truncated_points(first, last);
-
-  for (const auto & prev_point : truncated_prev_points) {
-    double min_dist = std::numeric_limits<double>::max();
-    for (const auto & point : truncated_points) {
-      const double dist = util::calculate2DDistance(point.pose.position, prev_point.pose.position);
-      if (dist < min_dist) {
-        min_dist = dist;
+  // Both paths go forward from the ego, so the segment of the path nearest to each point of the
+  // previous path is found by walking the segments forward from the one of the previous point.
+  size_t seg_idx = nearest_path_idx;
+  for (size_t i = nearest_prev_path_idx; i < prev_path_points->size(); ++i) {
+    const auto & prev_point = prev_path_points->at(i).pose.position;
+    double min_dist = calcDistanceToSegment(path_points, seg_idx, prev_point);
+    while (seg_idx + 2 < path_points.size()) {
+      const double next_dist = calcDistanceToSegment(path_points, seg_idx + 1, prev_point);
+      if (next_dist > min_dist) {
+        break;
       }
+      min_dist = next_dist;
+      ++seg_idx;
     }
     if (min_dist > distance_for_path_shape_change_detection_) {
       return true;
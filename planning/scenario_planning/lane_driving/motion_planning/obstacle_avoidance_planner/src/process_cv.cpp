@@ -481,11 +481,16 @@ bool arePointsInsideDriveableArea(
 
 cv::Mat getDrivableAreaInCV(const nav_msgs::msg::OccupancyGrid & occupancy_grid)
 {
-  cv::Mat drivable_area = cv::Mat(occupancy_grid.info.width, occupancy_grid.info.height, CV_8UC1);
-
-  drivable_area.forEach<unsigned char>([&](unsigned char & value, const int * position) -> void {
-    getOccupancyGridValue(occupancy_grid, position[0], position[1], value);
-  });
+  // same as getOccupancyGridValue for each cell, on the whole image at once
+  const cv::Mat grid(
+    occupancy_grid.info.height, occupancy_grid.info.width, CV_8SC1,
+    const_cast<int8_t *>(occupancy_grid.data.data()));
+  cv::Mat free_area;
+  cv::compare(grid, 0, free_area, cv::CMP_LE);
+  cv::Mat flipped_free_area;
+  cv::flip(free_area, flipped_free_area, -1);
+  cv::Mat drivable_area;
+  cv::transpose(flipped_free_area, drivable_area);
   return drivable_area;
 }
 
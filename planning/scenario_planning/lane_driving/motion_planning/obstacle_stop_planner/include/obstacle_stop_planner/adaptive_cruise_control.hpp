@@ -15,6 +15,8 @@
 #ifndef OBSTACLE_STOP_PLANNER__ADAPTIVE_CRUISE_CONTROL_HPP_
 #define OBSTACLE_STOP_PLANNER__ADAPTIVE_CRUISE_CONTROL_HPP_
 
+#include "obstacle_stop_planner/obstacle_velocity_tracker.hpp"
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_debug_msgs/msg/float32_multi_array_stamped.hpp>
@@ -26,6 +28,7 @@
 #include <pcl_conversions/pcl_conversions.h>
 #include <tf2/utils.h>
 
+#include <memory>
 #include <vector>
 
 namespace motion_planning
@@ -58,12 +61,13 @@ private:
 
   rclcpp::Time prev_collision_point_time_;
   pcl::PointXYZ prev_collision_point_;
+  std::unique_ptr<ObstacleVelocityTracker> velocity_tracker_;
+  double tracked_longitudinal_position_ = 0.0;
   double prev_target_vehicle_time_ = 0.0;
   double prev_target_vehicle_dist_ = 0.0;
   double prev_target_velocity_ = 0.0;
   bool prev_collision_point_valid_ = false;
   bool prev_obstacle_velocity_judge_to_start_acc_ = false;
-  std::vector<geometry_msgs::msg::TwistStamped> est_vel_que_;
   double prev_upper_velocity_ = 0.0;
 
   struct Param
@@ -87,10 +91,6 @@ private:
     // point cloud
     double valid_est_vel_diff_time;
 
-    //!< @brief Time width of information used for speed estimation in speed estimation using a
-    // point cloud
-    double valid_vel_que_time;
-
     //!< @brief Maximum value of valid speed estimation results in speed estimation using a point
     // cloud
     double valid_est_vel_max;
@@ -171,7 +171,6 @@ private:
   };
   Param param_;
 
-  double getMedianVel(const std::vector<geometry_msgs::msg::TwistStamped> vel_que);
   double lowpass_filter(const double current_value, const double prev_value, const double gain);
   void calcDistanceToNearestPointOnPath(
     const autoware_planning_msgs::msg::Trajectory & trajectory, const int nearest_point_idx,
@@ -182,7 +181,8 @@ private:
   bool estimatePointVelocityFromObject(
     const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr object_ptr,
     const double traj_yaw, const pcl::PointXYZ & nearest_collision_point, double * velocity);
-  bool estimatePointVelocityFromPcl(
+  bool estimatePointVelocity(
+    const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr object_ptr,
     const double traj_yaw, const pcl::PointXYZ & nearest_collision_point,
     const rclcpp::Time & nearest_collision_point_time, double * velocity);
   double estimateRoughPointVelocity(double current_vel);
@@ -200,7 +200,6 @@ private:
     const geometry_msgs::msg::Pose self_pose, const double current_vel, const double target_vel,
     const double dist_to_collision_point,
     autoware_planning_msgs::msg::Trajectory * output_trajectory);
-  void registerQueToVelocity(const double vel, const rclcpp::Time & vel_time);
 
   /* Debug */
   mutable autoware_debug_msgs::msg::Float32MultiArrayStamped debug_values_;
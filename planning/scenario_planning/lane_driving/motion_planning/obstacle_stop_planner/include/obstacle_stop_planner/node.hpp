@@ -170,9 +170,13 @@ private:
   rclcpp::Subscription<DynamicObjectArray>::SharedPtr dynamic_object_sub_;
   rclcpp::Subscription<ExpandStopRange>::SharedPtr expand_stop_range_sub_;
   rclcpp::Publisher<Trajectory>::SharedPtr path_pub_;
+  // the pointcloud is filtered in its own group, beside pathCallback on a multi-threaded executor
+  rclcpp::CallbackGroup::SharedPtr callback_group_pointcloud_;
   rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticStatus>::SharedPtr stop_reason_diag_pub_;
   rclcpp::Publisher<VelocityLimitClearCommand>::SharedPtr pub_clear_velocity_limit_;
   rclcpp::Publisher<VelocityLimit>::SharedPtr pub_velocity_limit_;
+  autoware_utils::LatencyTracer latency_tracer_{this};
+  autoware_utils::CallbackTimingPublisher callback_timing_publisher_{this};
 
   std::unique_ptr<motion_planning::AdaptiveCruiseController> acc_controller_;
   std::shared_ptr<ObstacleStopPlannerDebugNode> debug_ptr_;
@@ -180,7 +184,8 @@ private:
   boost::optional<SlowDownSection> latest_slow_down_section_{};
   tf2_ros::Buffer tf_buffer_{get_clock()};
   tf2_ros::TransformListener tf_listener_{tf_buffer_};
-  sensor_msgs::msg::PointCloud2::SharedPtr obstacle_ros_pointcloud_ptr_{nullptr};
+  // written by obstacle_pointcloud_sub_, read by pathCallback with atomic operations
+  sensor_msgs::msg::PointCloud2::ConstSharedPtr obstacle_ros_pointcloud_ptr_{nullptr};
   DynamicObjectArray::ConstSharedPtr object_ptr_{nullptr};
   rclcpp::Time last_detection_time_;
 
@@ -205,16 +210,10 @@ private:
   void externalExpandStopRangeCallback(const ExpandStopRange::ConstSharedPtr input_msg);
 
 private:
-  bool withinPolygon(
-    const std::vector<cv::Point2d> & cv_polygon, const double radius, const Point2d & prev_point,
-    const Point2d & next_point, pcl::PointCloud<pcl::PointXYZ>::Ptr candidate_points_ptr,
-    pcl::PointCloud<pcl::PointXYZ>::Ptr within_points_ptr);
-
-  bool convexHull(
-    const std::vector<cv::Point2d> & pointcloud, std::vector<cv::Point2d> & polygon_points);
-
   void searchObstacle(
-    const Trajectory & decimate_trajectory, Trajectory & output, PlannerData & planner_data);
+    const Trajectory & decimate_trajectory,
+    const sensor_msgs::msg::PointCloud2::ConstSharedPtr & obstacle_ros_pointcloud_ptr,
+    Trajectory & output, PlannerData & planner_data);
 
   void insertVelocity(Trajectory & trajectory, PlannerData & planner_data);
 
@@ -229,11 +228,6 @@ private:
     const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_points_ptr,
     pcl::PointCloud<pcl::PointXYZ>::Ptr output_points_ptr);
 
-  void createOneStepPolygon(
-    const geometry_msgs::msg::Pose & base_step_pose,
-    const geometry_msgs::msg::Pose & next_step_pose, std::vector<cv::Point2d> & polygon,
-    const double expand_width = 0.0);
-
   bool getSelfPose(
     const std_msgs::msg::Header & header, const tf2_ros::Buffer & tf_buffer,
     geometry_msgs::msg::Pose & self_pose);
@@ -0,0 +1,98 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OBSTACLE_STOP_PLANNER__OBSTACLE_VELOCITY_TRACKER_HPP_
+#define OBSTACLE_STOP_PLANNER__OBSTACLE_VELOCITY_TRACKER_HPP_
+
+#include <eigen3/Eigen/Core>
+
+#include <cstdint>
+
+namespace motion_planning
+{
+/**
+ * @brief Constant acceleration Kalman filter of the longitudinal position of the forward obstacle,
+ * updated by the position of the nearest point and by the velocity of the tracked object.
+ */
+class ObstacleVelocityTracker
+{
+public:
+  struct Param
+  {
+    //!< @brief standard deviation of the jerk of the obstacle, the process noise [m/sss]
+    double jerk_stddev;
+
+    //!< @brief standard deviation of the measured position [m]
+    double position_stddev;
+
+    //!< @brief standard deviation of the measured velocity [m/s]
+    double velocity_stddev;
+
+    //!< @brief measurements farther than this many standard deviations are rejected [-]
+    double gate_sigma;
+
+    //!< @brief the track is restarted after a longer gap between measurements [s]
+    double max_time_gap;
+  };
+
+  explicit ObstacleVelocityTracker(const Param & param);
+
+  void reset();
+
+  /**
+   * @brief predict the state to stamp_ns, or restart the track if the stamp goes back in time or
+   * is too far from the last measurement
+   * @return false if the track was restarted
+   */
+  bool predict(const int64_t stamp_ns);
+
+  /**
+   * @brief update by a position, restarting the track from it if it is out of the gate
+   * @return false if the track was restarted
+   */
+  bool updatePosition(const double position);
+
+  /**
+   * @brief update by a velocity, ignored if it is out of the gate
+   * @return false if the velocity was ignored
+   */
+  bool updateVelocity(const double velocity);
+
+  bool isInitialized() const { return is_initialized_; }
+  // true once the velocity has been observed, by a velocity or by a second position
+  bool isVelocityValid() const { return is_velocity_valid_; }
+  double getPosition() const { return x_(0); }
+  double getVelocity() const { return x_(1); }
+  double getAcceleration() const { return x_(2); }
+
+private:
+  using Vector3d = Eigen::Matrix<double, 3, 1>;
+  using Matrix3d = Eigen::Matrix<double, 3, 3>;
+
+  Param param_;
+
+  bool is_initialized_ = false;
+  bool is_velocity_valid_ = false;
+  bool is_position_observed_ = false;
+  int64_t stamp_ns_ = 0;
+  Vector3d x_;  // position, velocity, acceleration
+  Matrix3d P_;
+
+  void initialize(const Vector3d & x, const Matrix3d & P);
+  bool update(const int idx, const double measurement, const double variance);
+};
+
+}  // namespace motion_planning
+
+#endif  // OBSTACLE_STOP_PLANNER__OBSTACLE_VELOCITY_TRACKER_HPP_
@@ -170,7 +170,6 @@ AdaptiveCruiseController::AdaptiveCruiseController(
     node_->declare_parameter(acc_ns + "object_polygon_width_margin", 0.5);
   param_.valid_est_vel_diff_time =
     node_->declare_parameter(acc_ns + "valid_estimated_vel_diff_time", 1.0);
-  param_.valid_vel_que_time = node_->declare_parameter(acc_ns + "valid_vel_que_time", 0.5);
   param_.valid_est_vel_max = node_->declare_parameter(acc_ns + "valid_estimated_vel_max", 20.0);
   param_.valid_est_vel_min = node_->declare_parameter(acc_ns + "valid_estimated_vel_min", -20.0);
   param_.thresh_vel_to_stop = node_->declare_parameter(acc_ns + "thresh_vel_to_stop", 0.5);
@@ -178,6 +177,16 @@ AdaptiveCruiseController::AdaptiveCruiseController(
     node_->declare_parameter(acc_ns + "use_rough_velocity_estimation", false);
   param_.rough_velocity_rate = node_->declare_parameter(acc_ns + "rough_velocity_rate", 0.9);
 
+  /* parameter for tracking of obstacle velocity */
+  ObstacleVelocityTracker::Param tracker_param;
+  tracker_param.jerk_stddev = node_->declare_parameter(acc_ns + "tracker_jerk_stddev", 1.0);
+  tracker_param.position_stddev = node_->declare_parameter(acc_ns + "tracker_position_stddev", 0.2);
+  tracker_param.velocity_stddev =
+    node_->declare_parameter(acc_ns + "tracker_object_velocity_stddev", 0.5);
+  tracker_param.gate_sigma = node_->declare_parameter(acc_ns + "tracker_gate_sigma", 4.0);
+  tracker_param.max_time_gap = param_.valid_est_vel_diff_time;
+  velocity_tracker_ = std::make_unique<ObstacleVelocityTracker>(tracker_param);
+
   /* publisher */
   pub_debug_ = node_->create_publisher<autoware_debug_msgs::msg::Float32MultiArrayStamped>(
     "~/debug_values", 1);
@@ -213,16 +222,10 @@ void AdaptiveCruiseController::insertAdaptiveCruiseVelocity(
   /*
    * estimate velocity of collision point
    */
-  if (param_.use_pcl_to_est_vel) {
-    if (estimatePointVelocityFromPcl(
-          traj_yaw, nearest_collision_point, nearest_collision_point_time, &point_velocity)) {
-      success_estimate_vel = true;
-    }
-  }
-
-  if (param_.use_object_to_est_vel) {
-    if (estimatePointVelocityFromObject(
-          object_ptr, traj_yaw, nearest_collision_point, &point_velocity)) {
+  if (param_.use_pcl_to_est_vel || param_.use_object_to_est_vel) {
+    if (estimatePointVelocity(
+          object_ptr, traj_yaw, nearest_collision_point, nearest_collision_point_time,
+          &point_velocity)) {
       success_estimate_vel = true;
     }
   }
@@ -369,55 +372,62 @@ bool AdaptiveCruiseController::estimatePointVelocityFromObject(
   }
 }
 
-bool AdaptiveCruiseController::estimatePointVelocityFromPcl(
+bool AdaptiveCruiseController::estimatePointVelocity(
+  const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr object_ptr,
   const double traj_yaw, const pcl::PointXYZ & nearest_collision_point,
   const rclcpp::Time & nearest_collision_point_time, double * velocity)
 {
-  geometry_msgs::msg::Point nearest_collision_p_ros;
-  nearest_collision_p_ros.x = nearest_collision_point.x;
-  nearest_collision_p_ros.y = nearest_collision_point.y;
-  nearest_collision_p_ros.z = nearest_collision_point.z;
-
-  /* estimate velocity */
-  const double p_dt = nearest_collision_point_time.seconds() - prev_collision_point_time_.seconds();
-
-  // if get same pointcloud with previous step,
-  // skip estimate process
-  if (std::fabs(p_dt) > std::numeric_limits<double>::epsilon()) {
-    // valid time check
-    if (p_dt < 0 || param_.valid_est_vel_diff_time < p_dt) {
-      prev_collision_point_time_ = nearest_collision_point_time;
-      prev_collision_point_ = nearest_collision_point;
-      prev_collision_point_valid_ = true;
-      return false;
+  // the same pointcloud as the previous step has nothing new to the tracker
+  const bool is_new_point =
+    !prev_collision_point_valid_ ||
+    nearest_collision_point_time.nanoseconds() != prev_collision_point_time_.nanoseconds();
+  if (is_new_point) {
+    const bool was_tracking = velocity_tracker_->isInitialized();
+    const bool is_continuous =
+      velocity_tracker_->predict(nearest_collision_point_time.nanoseconds()) && was_tracking;
+
+    if (param_.use_pcl_to_est_vel) {
+      // the position is accumulated along the trajectory yaw of each step, so that the tracked
+      // velocity is the one along the trajectory
+      if (is_continuous) {
+        tracked_longitudinal_position_ +=
+          (nearest_collision_point.x - prev_collision_point_.x) * std::cos(traj_yaw) +
+          (nearest_collision_point.y - prev_collision_point_.y) * std::sin(traj_yaw);
+      } else {
+        tracked_longitudinal_position_ = 0.0;
+      }
+      // a point out of the gate restarts the track from it
+      velocity_tracker_->updatePosition(tracked_longitudinal_position_);
     }
-    const double p_dx = nearest_collision_point.x - prev_collision_point_.x;
-    const double p_dy = nearest_collision_point.y - prev_collision_point_.y;
-    const double p_dist = std::hypot(p_dx, p_dy);
-    const double p_yaw = std::atan2(p_dy, p_dx);
-    const double p_vel = p_dist / p_dt;
-    const double est_velocity = p_vel * std::cos(p_yaw - traj_yaw);
-    // valid velocity check
-    if (est_velocity <= param_.valid_est_vel_min || param_.valid_est_vel_max <= est_velocity) {
-      prev_collision_point_time_ = nearest_collision_point_time;
-      prev_collision_point_ = nearest_collision_point;
-      prev_collision_point_valid_ = true;
-      est_vel_que_.clear();
-      return false;
+
+    // the objects are detected from the same pointcloud, so their velocity is applied at its time
+    double object_velocity;
+    if (
+      param_.use_object_to_est_vel && object_ptr &&
+      estimatePointVelocityFromObject(
+        object_ptr, traj_yaw, nearest_collision_point, &object_velocity)) {
+      velocity_tracker_->updateVelocity(object_velocity);
     }
 
-    // append new velocity and remove old velocity from que
-    registerQueToVelocity(est_velocity, nearest_collision_point_time);
+    prev_collision_point_time_ = nearest_collision_point_time;
+    prev_collision_point_ = nearest_collision_point;
+    prev_collision_point_valid_ = true;
   }
 
-  // calc average(median) velocity from que
-  *velocity = getMedianVel(est_vel_que_);
-  debug_values_.data.at(DBGVAL::ESTIMATED_VEL_PCL) = *velocity;
+  if (!velocity_tracker_->isVelocityValid()) {
+    return false;
+  }
+
+  // valid velocity check
+  const double est_velocity = velocity_tracker_->getVelocity();
+  if (est_velocity <= param_.valid_est_vel_min || param_.valid_est_vel_max <= est_velocity) {
+    velocity_tracker_->reset();
+    return false;
+  }
 
-  prev_collision_point_time_ = nearest_collision_point_time;
-  prev_collision_point_ = nearest_collision_point;
+  *velocity = est_velocity;
+  debug_values_.data.at(DBGVAL::ESTIMATED_VEL_PCL) = *velocity;
   prev_target_velocity_ = *velocity;
-  prev_collision_point_valid_ = true;
   return true;
 }
 
@@ -636,58 +646,6 @@ void AdaptiveCruiseController::insertMaxVelocityToPath(
   }
 }
 
-void AdaptiveCruiseController::registerQueToVelocity(
-  const double vel, const rclcpp::Time & vel_time)
-{
-  // remove old msg from que
-  std::vector<int> delete_idxs;
-  for (size_t i = 0; i < est_vel_que_.size(); i++) {
-    if (node_->now().seconds() - est_vel_que_.at(i).header.stamp.sec > param_.valid_vel_que_time) {
-      delete_idxs.push_back(i);
-    }
-  }
-  for (int delete_idx = delete_idxs.size() - 1; 0 <= delete_idx; --delete_idx) {
-    est_vel_que_.erase(est_vel_que_.begin() + delete_idxs.at(delete_idx));
-  }
-
-  // append new que
-  geometry_msgs::msg::TwistStamped new_vel;
-  new_vel.header.stamp = vel_time;
-  new_vel.twist.linear.x = vel;
-  est_vel_que_.emplace_back(new_vel);
-}
-
-double AdaptiveCruiseController::getMedianVel(
-  const std::vector<geometry_msgs::msg::TwistStamped> vel_que)
-{
-  if (vel_que.size() == 0) {
-    RCLCPP_WARN_STREAM(node_->get_logger(), "size of vel que is 0. Something has wrong.");
-    return 0.0;
-  }
-
-  std::vector<double> raw_vel_que;
-  for (const auto vel : vel_que) {
-    raw_vel_que.emplace_back(vel.twist.linear.x);
-  }
-
-  double med_vel;
-  if (raw_vel_que.size() % 2 == 0) {
-    size_t med1 = (raw_vel_que.size()) / 2 - 1;
-    size_t med2 = (raw_vel_que.size()) / 2;
-    std::nth_element(raw_vel_que.begin(), raw_vel_que.begin() + med1, raw_vel_que.end());
-    const double vel1 = raw_vel_que[med1];
-    std::nth_element(raw_vel_que.begin(), raw_vel_que.begin() + med2, raw_vel_que.end());
-    const double vel2 = raw_vel_que[med2];
-    med_vel = (vel1 + vel2) / 2;
-  } else {
-    size_t med = (raw_vel_que.size() - 1) / 2;
-    std::nth_element(raw_vel_que.begin(), raw_vel_que.begin() + med, raw_vel_que.end());
-    med_vel = raw_vel_que[med];
-  }
-
-  return med_vel;
-}
-
 double AdaptiveCruiseController::lowpass_filter(
   const double current_value, const double prev_value, const double gain)
 {
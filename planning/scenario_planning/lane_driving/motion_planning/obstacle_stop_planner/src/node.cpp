@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <map>
 #include <memory>
@@ -40,6 +41,8 @@ using autoware_utils::calcSignedArcLength;
 using autoware_utils::createPoint;
 using autoware_utils::findNearestIndex;
 using autoware_utils::getRPY;
+using autoware_utils::PointGrid2d;
+using autoware_utils::SweptFootprint;
 
 namespace
 {
@@ -415,6 +418,35 @@ diagnostic_msgs::msg::DiagnosticStatus makeStopReasonDiag(
   stop_reason_diag.values.push_back(stop_reason_diag_kv);
   return stop_reason_diag;
 }
+
+/**
+ * @brief Keep the points within radius of the vehicle center at either end of the step
+ */
+void filterByRadius(
+  const pcl::PointCloud<pcl::PointXYZ> & points, const double radius, const Point2d & prev_point,
+  const Point2d & next_point, std::vector<size_t> & indices)
+{
+  indices.erase(
+    std::remove_if(
+      indices.begin(), indices.end(),
+      [&](const size_t index) {
+        const Point2d point(points.at(index).x, points.at(index).y);
+        return bg::distance(prev_point, point) >= radius &&
+               bg::distance(next_point, point) >= radius;
+      }),
+    indices.end());
+}
+
+std::vector<Eigen::Vector3d> toDebugPolygon(
+  const autoware_utils::LinearRing2d & ring, const double z)
+{
+  // without the closing point
+  std::vector<Eigen::Vector3d> polygon;
+  for (size_t i = 0; i + 1 < ring.size(); ++i) {
+    polygon.emplace_back(ring.at(i).x(), ring.at(i).y(), z);
+  }
+  return polygon;
+}
 }  // namespace
 
 ObstacleStopPlannerNode::ObstacleStopPlannerNode(const rclcpp::NodeOptions & node_options)
@@ -499,9 +531,14 @@ ObstacleStopPlannerNode::ObstacleStopPlannerNode(const rclcpp::NodeOptions & nod
   pub_velocity_limit_ = this->create_publisher<VelocityLimit>("~/output/max_velocity", 1);
 
   // Subscribers
+  callback_group_pointcloud_ =
+    this->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  auto pointcloud_subscription_option = rclcpp::SubscriptionOptions();
+  pointcloud_subscription_option.callback_group = callback_group_pointcloud_;
   obstacle_pointcloud_sub_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
     "~/input/pointcloud", rclcpp::SensorDataQoS(),
-    std::bind(&ObstacleStopPlannerNode::obstaclePointcloudCallback, this, std::placeholders::_1));
+    std::bind(&ObstacleStopPlannerNode::obstaclePointcloudCallback, this, std::placeholders::_1),
+    pointcloud_subscription_option);
   path_sub_ = this->create_subscription<Trajectory>(
     "~/input/trajectory", 1,
     std::bind(&ObstacleStopPlannerNode::pathCallback, this, std::placeholders::_1));
@@ -520,7 +557,9 @@ ObstacleStopPlannerNode::ObstacleStopPlannerNode(const rclcpp::NodeOptions & nod
 void ObstacleStopPlannerNode::obstaclePointcloudCallback(
   const sensor_msgs::msg::PointCloud2::ConstSharedPtr input_msg)
 {
-  obstacle_ros_pointcloud_ptr_ = std::make_shared<sensor_msgs::msg::PointCloud2>();
+  autoware_utils::CallbackTimingPublisher::Scope scope(
+    &callback_timing_publisher_, "obstaclePointcloudCallback");
+  auto obstacle_ros_pointcloud_ptr = std::make_shared<sensor_msgs::msg::PointCloud2>();
   pcl::VoxelGrid<pcl::PointXYZ> filter;
   pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::PointCloud<pcl::PointXYZ>::Ptr no_height_pointcloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
@@ -535,13 +574,20 @@ void ObstacleStopPlannerNode::obstaclePointcloudCallback(
   filter.setInputCloud(no_height_pointcloud_ptr);
   filter.setLeafSize(0.05f, 0.05f, 100000.0f);
   filter.filter(*no_height_filtered_pointcloud_ptr);
-  pcl::toROSMsg(*no_height_filtered_pointcloud_ptr, *obstacle_ros_pointcloud_ptr_);
-  obstacle_ros_pointcloud_ptr_->header = input_msg->header;
+  pcl::toROSMsg(*no_height_filtered_pointcloud_ptr, *obstacle_ros_pointcloud_ptr);
+  obstacle_ros_pointcloud_ptr->header = input_msg->header;
+  std::atomic_store(
+    &obstacle_ros_pointcloud_ptr_,
+    sensor_msgs::msg::PointCloud2::ConstSharedPtr(obstacle_ros_pointcloud_ptr));
 }
 
 void ObstacleStopPlannerNode::pathCallback(const Trajectory::ConstSharedPtr input_msg)
 {
-  if (!obstacle_ros_pointcloud_ptr_) {
+  autoware_utils::CallbackTimingPublisher::Scope scope(&callback_timing_publisher_, "pathCallback");
+  latency_tracer_.onReceive(input_msg->header.stamp);
+
+  const auto obstacle_ros_pointcloud_ptr = std::atomic_load(&obstacle_ros_pointcloud_ptr_);
+  if (!obstacle_ros_pointcloud_ptr) {
     RCLCPP_WARN_THROTTLE(
       get_logger(), *get_clock(), std::chrono::milliseconds(1000).count(),
       "waiting for obstacle pointcloud...");
@@ -575,7 +621,7 @@ void ObstacleStopPlannerNode::pathCallback(const Trajectory::ConstSharedPtr inpu
     extend_trajectory, stop_param_.step_length, planner_data.decimate_trajectory_index_map);
 
   // search obstacles within slow-down/collision area
-  searchObstacle(decimate_trajectory, output_trajectory, planner_data);
+  searchObstacle(decimate_trajectory, obstacle_ros_pointcloud_ptr, output_trajectory, planner_data);
   // insert slow-down-section/stop-point
   insertVelocity(output_trajectory, planner_data);
 
@@ -587,22 +633,44 @@ void ObstacleStopPlannerNode::pathCallback(const Trajectory::ConstSharedPtr inpu
   }
 
   path_pub_->publish(output_trajectory);
+  latency_tracer_.onPublish(output_trajectory.header.stamp);
   publishDebugData(planner_data);
 }
 
 void ObstacleStopPlannerNode::searchObstacle(
-  const Trajectory & decimate_trajectory, Trajectory & output, PlannerData & planner_data)
+  const Trajectory & decimate_trajectory,
+  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & obstacle_ros_pointcloud_ptr,
+  Trajectory & output, PlannerData & planner_data)
 {
   // search candidate obstacle pointcloud
   pcl::PointCloud<pcl::PointXYZ>::Ptr slow_down_pointcloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::PointCloud<pcl::PointXYZ>::Ptr obstacle_candidate_pointcloud_ptr(
     new pcl::PointCloud<pcl::PointXYZ>);
   if (!searchPointcloudNearTrajectory(
-        decimate_trajectory, obstacle_ros_pointcloud_ptr_, obstacle_candidate_pointcloud_ptr)) {
+        decimate_trajectory, obstacle_ros_pointcloud_ptr, obstacle_candidate_pointcloud_ptr)) {
     return;
   }
-
-  for (size_t i = 0; i < decimate_trajectory.points.size() - 1; ++i) {
+  slow_down_pointcloud_ptr->header = obstacle_candidate_pointcloud_ptr->header;
+
+  // the candidates of a step are the ones in the cells overlapping its polygon
+  constexpr double grid_cell_size = 1.0;
+  const PointGrid2d candidate_grid(*obstacle_candidate_pointcloud_ptr, grid_cell_size);
+  std::vector<geometry_msgs::msg::Pose> poses;
+  for (const auto & point : decimate_trajectory.points) {
+    poses.push_back(point.pose);
+  }
+  const auto create_footprint = [this, &poses](const double expand_width) {
+    const auto & vi = vehicle_info_;
+    const double width = vi.vehicle_width_m / 2.0 + expand_width;
+    return SweptFootprint(poses, -vi.rear_overhang_m, vi.max_longitudinal_offset_m, -width, width);
+  };
+  const auto slow_down_footprint = create_footprint(slow_down_param_.expand_slow_down_range);
+  const auto vehicle_footprint = create_footprint(stop_param_.expand_stop_range);
+  std::vector<size_t> within_indices;
+  // the collision points are searched among the points found in the slow down ranges so far
+  std::vector<bool> is_slow_down_point(obstacle_candidate_pointcloud_ptr->size(), false);
+
+  for (size_t i = 0; i < vehicle_footprint.size(); ++i) {
     // create one step circle center for vehicle
     const auto & p_front = decimate_trajectory.points.at(i).pose;
     const auto & p_back = decimate_trajectory.points.at(i + 1).pose;
@@ -612,18 +680,22 @@ void ObstacleStopPlannerNode::searchObstacle(
     const Point2d next_center_point(next_center_pose.position.x, next_center_pose.position.y);
 
     if (node_param_.enable_slow_down) {
-      std::vector<cv::Point2d> one_step_move_slow_down_range_polygon;
-      // create one step polygon for slow_down range
-      createOneStepPolygon(
-        p_front, p_back, one_step_move_slow_down_range_polygon,
-        slow_down_param_.expand_slow_down_range);
-      debug_ptr_->pushPolygon(
-        one_step_move_slow_down_range_polygon, p_front.position.z, PolygonType::SlowDownRange);
-
-      planner_data.found_slow_down_points = withinPolygon(
-        one_step_move_slow_down_range_polygon, slow_down_param_.slow_down_search_radius,
-        prev_center_point, next_center_point, obstacle_candidate_pointcloud_ptr,
-        slow_down_pointcloud_ptr);
+      // one step polygon for slow_down range
+      const auto one_step_move_slow_down_range_polygon =
+        toDebugPolygon(slow_down_footprint.getStepPolygon(i), p_front.position.z);
+      debug_ptr_->pushPolygon(one_step_move_slow_down_range_polygon, PolygonType::SlowDownRange);
+
+      slow_down_footprint.findPointsInStep(i, candidate_grid, within_indices);
+      filterByRadius(
+        *obstacle_candidate_pointcloud_ptr, slow_down_param_.slow_down_search_radius,
+        prev_center_point, next_center_point, within_indices);
+      planner_data.found_slow_down_points = !within_indices.empty();
+      for (const size_t index : within_indices) {
+        if (!is_slow_down_point.at(index)) {
+          is_slow_down_point.at(index) = true;
+          slow_down_pointcloud_ptr->push_back(obstacle_candidate_pointcloud_ptr->at(index));
+        }
+      }
 
       const auto found_first_slow_down_points =
         planner_data.found_slow_down_points && !planner_data.slow_down_require;
@@ -640,40 +712,44 @@ void ObstacleStopPlannerNode::searchObstacle(
           &planner_data.lateral_deviation);
 
         debug_ptr_->pushObstaclePoint(planner_data.nearest_slow_down_point, PointType::SlowDown);
-        debug_ptr_->pushPolygon(
-          one_step_move_slow_down_range_polygon, p_front.position.z, PolygonType::SlowDown);
+        debug_ptr_->pushPolygon(one_step_move_slow_down_range_polygon, PolygonType::SlowDown);
       }
-
-    } else {
-      slow_down_pointcloud_ptr = obstacle_candidate_pointcloud_ptr;
     }
 
     {
-      std::vector<cv::Point2d> one_step_move_vehicle_polygon;
-      // create one step polygon for vehicle
-      createOneStepPolygon(
-        p_front, p_back, one_step_move_vehicle_polygon, stop_param_.expand_stop_range);
-      debug_ptr_->pushPolygon(
-        one_step_move_vehicle_polygon, decimate_trajectory.points.at(i).pose.position.z,
-        PolygonType::Vehicle);
-
-      pcl::PointCloud<pcl::PointXYZ>::Ptr collision_pointcloud_ptr(
-        new pcl::PointCloud<pcl::PointXYZ>);
-      collision_pointcloud_ptr->header = obstacle_candidate_pointcloud_ptr->header;
-
-      planner_data.found_collision_points = withinPolygon(
-        one_step_move_vehicle_polygon, stop_param_.stop_search_radius, prev_center_point,
-        next_center_point, slow_down_pointcloud_ptr, collision_pointcloud_ptr);
+      // one step polygon for vehicle
+      const auto one_step_move_vehicle_polygon =
+        toDebugPolygon(vehicle_footprint.getStepPolygon(i), p_front.position.z);
+      debug_ptr_->pushPolygon(one_step_move_vehicle_polygon, PolygonType::Vehicle);
+
+      vehicle_footprint.findPointsInStep(i, candidate_grid, within_indices);
+      if (node_param_.enable_slow_down) {
+        within_indices.erase(
+          std::remove_if(
+            within_indices.begin(), within_indices.end(),
+            [&is_slow_down_point](const size_t index) { return !is_slow_down_point.at(index); }),
+          within_indices.end());
+      }
+      filterByRadius(
+        *obstacle_candidate_pointcloud_ptr, stop_param_.stop_search_radius, prev_center_point,
+        next_center_point, within_indices);
+      planner_data.found_collision_points = !within_indices.empty();
 
       if (planner_data.found_collision_points) {
+        pcl::PointCloud<pcl::PointXYZ>::Ptr collision_pointcloud_ptr(
+          new pcl::PointCloud<pcl::PointXYZ>);
+        collision_pointcloud_ptr->header = obstacle_candidate_pointcloud_ptr->header;
+        for (const size_t index : within_indices) {
+          collision_pointcloud_ptr->push_back(obstacle_candidate_pointcloud_ptr->at(index));
+        }
+
         planner_data.decimate_trajectory_collision_index = i;
         getNearestPoint(
           *collision_pointcloud_ptr, p_front, &planner_data.nearest_collision_point,
           &planner_data.nearest_collision_point_time);
 
         debug_ptr_->pushObstaclePoint(planner_data.nearest_collision_point, PointType::Stop);
-        debug_ptr_->pushPolygon(
-          one_step_move_vehicle_polygon, p_front.position.z, PolygonType::Collision);
+        debug_ptr_->pushPolygon(one_step_move_vehicle_polygon, PolygonType::Collision);
 
         planner_data.stop_require = planner_data.found_collision_points;
         acc_controller_->insertAdaptiveCruiseVelocity(
@@ -783,30 +859,6 @@ void ObstacleStopPlannerNode::insertVelocity(Trajectory & output, PlannerData &
   stop_reason_diag_pub_->publish(planner_data.stop_reason_diag);
 }
 
-bool ObstacleStopPlannerNode::withinPolygon(
-  const std::vector<cv::Point2d> & cv_polygon, const double radius, const Point2d & prev_point,
-  const Point2d & next_point, pcl::PointCloud<pcl::PointXYZ>::Ptr candidate_points_ptr,
-  pcl::PointCloud<pcl::PointXYZ>::Ptr within_points_ptr)
-{
-  Polygon2d boost_polygon;
-  bool find_within_points = false;
-  for (const auto & point : cv_polygon) {
-    boost_polygon.outer().push_back(bg::make<Point2d>(point.x, point.y));
-  }
-  boost_polygon.outer().push_back(bg::make<Point2d>(cv_polygon.front().x, cv_polygon.front().y));
-
-  for (size_t j = 0; j < candidate_points_ptr->size(); ++j) {
-    Point2d point(candidate_points_ptr->at(j).x, candidate_points_ptr->at(j).y);
-    if (bg::distance(prev_point, point) < radius || bg::distance(next_point, point) < radius) {
-      if (bg::within(point, boost_polygon)) {
-        within_points_ptr->push_back(candidate_points_ptr->at(j));
-        find_within_points = true;
-      }
-    }
-  }
-  return find_within_points;
-}
-
 void ObstacleStopPlannerNode::externalExpandStopRangeCallback(
   const ExpandStopRange::ConstSharedPtr input_msg)
 {
@@ -1212,91 +1264,29 @@ bool ObstacleStopPlannerNode::searchPointcloudNearTrajectory(
                                  ? slow_down_param_.slow_down_search_radius
                                  : stop_param_.stop_search_radius;
   const double squared_radius = search_radius * search_radius;
+  const PointGrid2d grid(*transformed_points_ptr, search_radius);
+  std::vector<bool> is_candidate(transformed_points_ptr->size(), false);
+  std::vector<size_t> indices;
   for (const auto & trajectory_point : trajectory.points) {
     const auto center_pose = getVehicleCenterFromBase(trajectory_point.pose);
-    for (const auto & point : transformed_points_ptr->points) {
+    grid.query(
+      center_pose.position.x - search_radius, center_pose.position.y - search_radius,
+      center_pose.position.x + search_radius, center_pose.position.y + search_radius, indices);
+    for (const size_t index : indices) {
+      const auto & point = transformed_points_ptr->at(index);
       const double x = center_pose.position.x - point.x;
       const double y = center_pose.position.y - point.y;
       const double squared_distance = x * x + y * y;
       if (squared_distance < squared_radius) {
-        output_points_ptr->points.push_back(point);
+        is_candidate.at(index) = true;
       }
     }
   }
-  return true;
-}
-
-void ObstacleStopPlannerNode::createOneStepPolygon(
-  const geometry_msgs::msg::Pose & base_step_pose, const geometry_msgs::msg::Pose & next_step_pose,
-  std::vector<cv::Point2d> & polygon, const double expand_width)
-{
-  std::vector<cv::Point2d> one_step_move_vehicle_corner_points;
-
-  const auto & i = vehicle_info_;
-  const auto & front_m = i.max_longitudinal_offset_m;
-  const auto & width_m = i.vehicle_width_m / 2.0 + expand_width;
-  const auto & back_m = i.rear_overhang_m;
-  // start step
-  {
-    const auto yaw = getRPY(base_step_pose).z;
-    one_step_move_vehicle_corner_points.push_back(cv::Point2d(
-      base_step_pose.position.x + std::cos(yaw) * front_m - std::sin(yaw) * width_m,
-      base_step_pose.position.y + std::sin(yaw) * front_m + std::cos(yaw) * width_m));
-    one_step_move_vehicle_corner_points.push_back(cv::Point2d(
-      base_step_pose.position.x + std::cos(yaw) * front_m - std::sin(yaw) * -width_m,
-      base_step_pose.position.y + std::sin(yaw) * front_m + std::cos(yaw) * -width_m));
-    one_step_move_vehicle_corner_points.push_back(cv::Point2d(
-      base_step_pose.position.x + std::cos(yaw) * -back_m - std::sin(yaw) * -width_m,
-      base_step_pose.position.y + std::sin(yaw) * -back_m + std::cos(yaw) * -width_m));
-    one_step_move_vehicle_corner_points.push_back(cv::Point2d(
-      base_step_pose.position.x + std::cos(yaw) * -back_m - std::sin(yaw) * width_m,
-      base_step_pose.position.y + std::sin(yaw) * -back_m + std::cos(yaw) * width_m));
-  }
-  // next step
-  {
-    const auto yaw = getRPY(next_step_pose).z;
-    one_step_move_vehicle_corner_points.push_back(cv::Point2d(
-      next_step_pose.position.x + std::cos(yaw) * front_m - std::sin(yaw) * width_m,
-      next_step_pose.position.y + std::sin(yaw) * front_m + std::cos(yaw) * width_m));
-    one_step_move_vehicle_corner_points.push_back(cv::Point2d(
-      next_step_pose.position.x + std::cos(yaw) * front_m - std::sin(yaw) * -width_m,
-      next_step_pose.position.y + std::sin(yaw) * front_m + std::cos(yaw) * -width_m));
-    one_step_move_vehicle_corner_points.push_back(cv::Point2d(
-      next_step_pose.position.x + std::cos(yaw) * -back_m - std::sin(yaw) * -width_m,
-      next_step_pose.position.y + std::sin(yaw) * -back_m + std::cos(yaw) * -width_m));
-    one_step_move_vehicle_corner_points.push_back(cv::Point2d(
-      next_step_pose.position.x + std::cos(yaw) * -back_m - std::sin(yaw) * width_m,
-      next_step_pose.position.y + std::sin(yaw) * -back_m + std::cos(yaw) * width_m));
-  }
-  convexHull(one_step_move_vehicle_corner_points, polygon);
-}
-
-bool ObstacleStopPlannerNode::convexHull(
-  const std::vector<cv::Point2d> & pointcloud, std::vector<cv::Point2d> & polygon_points)
-{
-  cv::Point2d centroid;
-  centroid.x = 0;
-  centroid.y = 0;
-  for (const auto & point : pointcloud) {
-    centroid.x += point.x;
-    centroid.y += point.y;
-  }
-  centroid.x = centroid.x / static_cast<double>(pointcloud.size());
-  centroid.y = centroid.y / static_cast<double>(pointcloud.size());
-
-  std::vector<cv::Point> normalized_pointcloud;
-  std::vector<cv::Point> normalized_polygon_points;
-  for (size_t i = 0; i < pointcloud.size(); ++i) {
-    normalized_pointcloud.push_back(cv::Point(
-      (pointcloud.at(i).x - centroid.x) * 1000.0, (pointcloud.at(i).y - centroid.y) * 1000.0));
-  }
-  cv::convexHull(normalized_pointcloud, normalized_polygon_points);
-
-  for (size_t i = 0; i < normalized_polygon_points.size(); ++i) {
-    cv::Point2d polygon_point;
-    polygon_point.x = (normalized_polygon_points.at(i).x / 1000.0 + centroid.x);
-    polygon_point.y = (normalized_polygon_points.at(i).y / 1000.0 + centroid.y);
-    polygon_points.push_back(polygon_point);
+  // each point once, even when it is near several trajectory points
+  for (size_t i = 0; i < transformed_points_ptr->size(); ++i) {
+    if (is_candidate.at(i)) {
+      output_points_ptr->push_back(transformed_points_ptr->at(i));
+    }
   }
   return true;
 }
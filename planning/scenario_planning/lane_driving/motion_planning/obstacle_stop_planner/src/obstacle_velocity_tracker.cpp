@@ -0,0 +1,135 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "obstacle_stop_planner/obstacle_velocity_tracker.hpp"
+
+#include <cmath>
+
+namespace
+{
+// uncertainty of the states a new track has not observed yet
+constexpr double unobserved_position_stddev = 100.0;
+constexpr double unobserved_velocity_stddev = 10.0;
+constexpr double unobserved_acceleration_stddev = 3.0;
+}  // namespace
+
+namespace motion_planning
+{
+ObstacleVelocityTracker::ObstacleVelocityTracker(const Param & param) : param_(param) { reset(); }
+
+void ObstacleVelocityTracker::reset()
+{
+  is_initialized_ = false;
+  is_velocity_valid_ = false;
+  is_position_observed_ = false;
+  x_.setZero();
+  P_.setZero();
+}
+
+void ObstacleVelocityTracker::initialize(const Vector3d & x, const Matrix3d & P)
+{
+  is_initialized_ = true;
+  x_ = x;
+  P_ = P;
+}
+
+bool ObstacleVelocityTracker::predict(const int64_t stamp_ns)
+{
+  const int64_t dt_ns = stamp_ns - stamp_ns_;
+  stamp_ns_ = stamp_ns;
+  if (!is_initialized_ || dt_ns == 0) {
+    return true;
+  }
+
+  const double dt = dt_ns * 1e-9;
+  if (dt < 0.0 || param_.max_time_gap < dt) {
+    reset();
+    return false;
+  }
+
+  Matrix3d F;
+  F << 1.0, dt, 0.5 * dt * dt, 0.0, 1.0, dt, 0.0, 0.0, 1.0;
+
+  // white jerk integrated over dt
+  const double dt2 = dt * dt;
+  const double dt3 = dt2 * dt;
+  Matrix3d Q;
+  Q << dt3 * dt2 / 20.0, dt2 * dt2 / 8.0, dt3 / 6.0, dt2 * dt2 / 8.0, dt3 / 3.0, dt2 / 2.0,
+    dt3 / 6.0, dt2 / 2.0, dt;
+  Q *= param_.jerk_stddev * param_.jerk_stddev;
+
+  x_ = F * x_;
+  P_ = F * P_ * F.transpose() + Q;
+  return true;
+}
+
+bool ObstacleVelocityTracker::update(const int idx, const double measurement, const double variance)
+{
+  const double innovation = measurement - x_(idx);
+  const double innovation_variance = P_(idx, idx) + variance;
+  if (innovation * innovation > param_.gate_sigma * param_.gate_sigma * innovation_variance) {
+    return false;
+  }
+
+  const Vector3d gain = P_.col(idx) / innovation_variance;
+  x_ += gain * innovation;
+  P_ -= gain * P_.row(idx);
+  P_ = 0.5 * (P_ + P_.transpose()).eval();
+  return true;
+}
+
+bool ObstacleVelocityTracker::updatePosition(const double position)
+{
+  const double variance = param_.position_stddev * param_.position_stddev;
+  if (is_initialized_ && update(0, position, variance)) {
+    is_velocity_valid_ |= is_position_observed_;
+    is_position_observed_ = true;
+    return true;
+  }
+
+  // the nearest point has jumped to another obstacle
+  const bool was_initialized = is_initialized_;
+  reset();
+  initialize(
+    Vector3d(position, 0.0, 0.0),
+    Vector3d(
+      variance, unobserved_velocity_stddev * unobserved_velocity_stddev,
+      unobserved_acceleration_stddev * unobserved_acceleration_stddev)
+      .asDiagonal());
+  is_position_observed_ = true;
+  return !was_initialized;
+}
+
+bool ObstacleVelocityTracker::updateVelocity(const double velocity)
+{
+  const double variance = param_.velocity_stddev * param_.velocity_stddev;
+  if (!is_initialized_) {
+    initialize(
+      Vector3d(0.0, velocity, 0.0),
+      Vector3d(
+        unobserved_position_stddev * unobserved_position_stddev, variance,
+        unobserved_acceleration_stddev * unobserved_acceleration_stddev)
+        .asDiagonal());
+    is_velocity_valid_ = true;
+    return true;
+  }
+
+  if (!update(1, velocity, variance)) {
+    return false;
+  }
+  is_velocity_valid_ = true;
+  return true;
+}
+
+}  // namespace motion_planning
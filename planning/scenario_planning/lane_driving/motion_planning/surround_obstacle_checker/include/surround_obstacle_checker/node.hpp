@@ -17,6 +17,7 @@
 
 #include "surround_obstacle_checker/debug_marker.hpp"
 
+#include <autoware_utils/geometry/point_grid.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
@@ -35,6 +36,8 @@
 #include <boost/geometry/geometries/linestring.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
 #include <pcl_conversions/pcl_conversions.h>
 #include <tf2/utils.h>
 #include <tf2_ros/buffer.h>
@@ -61,11 +64,13 @@ private:
     const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr input_msg);
   void currentVelocityCallback(const geometry_msgs::msg::TwistStamped::ConstSharedPtr input_msg);
   void insertStopVelocity(const size_t closest_idx, autoware_planning_msgs::msg::Trajectory * traj);
-  bool convertPose(
-    const geometry_msgs::msg::Pose & pose, const std::string & source, const std::string & target,
-    const rclcpp::Time & time, geometry_msgs::msg::Pose & conv_pose);
+  bool lookupTransform(
+    const std::string & source, const std::string & target, const rclcpp::Time & time,
+    tf2::Transform & src2tgt);
   bool getPose(
     const std::string & source, const std::string & target, geometry_msgs::msg::Pose & pose);
+  double getSearchDistance() const;
+  bool updatePointCloudGrid();
   void getNearestObstacle(double * min_dist_to_obj, geometry_msgs::msg::Point * nearest_obj_point);
   void getNearestObstacleByPointCloud(
     double * min_dist_to_obj, geometry_msgs::msg::Point * nearest_obj_point);
@@ -105,6 +110,10 @@ private:
   geometry_msgs::msg::TwistStamped::ConstSharedPtr current_velocity_ptr_;
   sensor_msgs::msg::PointCloud2::ConstSharedPtr pointcloud_ptr_;
   autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr object_ptr_;
+  // pointcloud in base_link and its grid, built once per pointcloud while the vehicle is stopped
+  sensor_msgs::msg::PointCloud2::ConstSharedPtr grid_pointcloud_ptr_;
+  pcl::PointCloud<pcl::PointXYZ> pointcloud_base_link_;
+  std::unique_ptr<autoware_utils::PointGrid2d> pointcloud_grid_;
   vehicle_info_util::VehicleInfo vehicle_info_;
   Polygon2d self_poly_;
   bool use_pointcloud_;
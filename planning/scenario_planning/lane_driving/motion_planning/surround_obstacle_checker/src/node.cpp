@@ -14,6 +14,8 @@
 
 #include "surround_obstacle_checker/node.hpp"
 
+#include <autoware_utils/geometry/swept_footprint.hpp>
+
 #include <pcl/common/transforms.h>
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
@@ -21,10 +23,12 @@
 #include <tf2_eigen/tf2_eigen.h>
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #define EIGEN_MPL2_ONLY
 #include <Eigen/Core>
@@ -104,17 +108,19 @@ void SurroundObstacleCheckerNode::pathCallback(
   // get closest idx
   const size_t closest_idx = getClosestIdx(*input_msg, current_pose);
 
-  // get nearest object
+  // check current stop status (stop or not)
+  const auto is_stopped = checkStop(input_msg->points.at(closest_idx));
+
+  // get nearest object, which only matters while the vehicle is stopped
   double min_dist_to_obj = std::numeric_limits<double>::max();
   geometry_msgs::msg::Point nearest_obj_point;
-  getNearestObstacle(&min_dist_to_obj, &nearest_obj_point);
+  if (is_stopped) {
+    getNearestObstacle(&min_dist_to_obj, &nearest_obj_point);
+  }
 
   // check current obstacle status (exist or not)
   const auto is_obstacle_found = isObstacleFound(min_dist_to_obj);
 
-  // check current stop status (stop or not)
-  const auto is_stopped = checkStop(input_msg->points.at(closest_idx));
-
   const auto is_stop_required = isStopRequired(is_obstacle_found, is_stopped);
 
   // insert stop velocity
@@ -190,11 +196,10 @@ bool SurroundObstacleCheckerNode::getPose(
   return true;
 }
 
-bool SurroundObstacleCheckerNode::convertPose(
-  const geometry_msgs::msg::Pose & pose, const std::string & source, const std::string & target,
-  const rclcpp::Time & time, geometry_msgs::msg::Pose & conv_pose)
+bool SurroundObstacleCheckerNode::lookupTransform(
+  const std::string & source, const std::string & target, const rclcpp::Time & time,
+  tf2::Transform & src2tgt)
 {
-  tf2::Transform src2tgt;
   try {
     // get transform from source to target
     geometry_msgs::msg::TransformStamped ros_src2tgt =
@@ -206,11 +211,6 @@ bool SurroundObstacleCheckerNode::convertPose(
       "cannot get tf from " << source << " to " << target);
     return false;
   }
-
-  tf2::Transform src2obj;
-  tf2::fromMsg(pose, src2obj);
-  tf2::Transform tgt2obj = src2tgt.inverse() * src2obj;
-  tf2::toMsg(tgt2obj, conv_pose);
   return true;
 }
 
@@ -243,9 +243,18 @@ void SurroundObstacleCheckerNode::getNearestObstacle(
   }
 }
 
-void SurroundObstacleCheckerNode::getNearestObstacleByPointCloud(
-  double * min_dist_to_obj, geometry_msgs::msg::Point * nearest_obj_point)
+double SurroundObstacleCheckerNode::getSearchDistance() const
 {
+  // an obstacle farther than both distances is handled as no obstacle in any state
+  return std::max(surround_check_distance_, surround_check_recover_distance_);
+}
+
+bool SurroundObstacleCheckerNode::updatePointCloudGrid()
+{
+  if (pointcloud_grid_ && grid_pointcloud_ptr_ == pointcloud_ptr_) {
+    return true;
+  }
+
   // wait to transform pointcloud
   geometry_msgs::msg::TransformStamped transform_stamped;
   try {
@@ -256,27 +265,57 @@ void SurroundObstacleCheckerNode::getNearestObstacleByPointCloud(
     RCLCPP_WARN_STREAM_THROTTLE(
       get_logger(), *this->get_clock(), 500 /* ms */,
       "failed to get base_link to " << pointcloud_ptr_->header.frame_id << " transform.");
-    return;
+    return false;
   }
 
   Eigen::Affine3f isometry = tf2::transformToEigen(transform_stamped.transform).cast<float>();
-  pcl::PointCloud<pcl::PointXYZ> pcl;
-  pcl::fromROSMsg(*pointcloud_ptr_, pcl);
-  pcl::transformPointCloud(pcl, pcl, isometry);
-  for (const auto & p : pcl) {
-    // create boost point
-    Point2d boost_p(p.x, p.y);
+  pcl::fromROSMsg(*pointcloud_ptr_, pointcloud_base_link_);
+  pcl::transformPointCloud(pointcloud_base_link_, pointcloud_base_link_, isometry);
+  pointcloud_grid_ =
+    std::make_unique<autoware_utils::PointGrid2d>(pointcloud_base_link_, getSearchDistance());
+  grid_pointcloud_ptr_ = pointcloud_ptr_;
+  return true;
+}
 
-    // calc distance
-    const double dist_to_obj = boost::geometry::distance(self_poly_, boost_p);
+void SurroundObstacleCheckerNode::getNearestObstacleByPointCloud(
+  double * min_dist_to_obj, geometry_msgs::msg::Point * nearest_obj_point)
+{
+  if (!updatePointCloudGrid()) {
+    return;
+  }
+
+  // the self polygon is a box in base_link, whose distance is computed without boost polygons
+  const autoware_utils::OrientedBox2d self_box(
+    geometry_msgs::msg::Pose{}, vehicle_info_.min_longitudinal_offset_m,
+    vehicle_info_.max_longitudinal_offset_m, vehicle_info_.min_lateral_offset_m,
+    vehicle_info_.max_lateral_offset_m);
+
+  // only the points of the cells around the vehicle can be within the search distance
+  const double search_distance = getSearchDistance();
+  std::vector<size_t> indices;
+  pointcloud_grid_->query(
+    vehicle_info_.min_longitudinal_offset_m - search_distance,
+    vehicle_info_.min_lateral_offset_m - search_distance,
+    vehicle_info_.max_longitudinal_offset_m + search_distance,
+    vehicle_info_.max_lateral_offset_m + search_distance, indices);
+
+  double min_squared_dist = *min_dist_to_obj * *min_dist_to_obj;
+  for (const size_t index : indices) {
+    const auto & p = pointcloud_base_link_.at(index);
+    const double squared_dist_to_obj = self_box.calcSquaredDistance(p.x, p.y);
 
     // get minimum distance to obj
-    if (dist_to_obj < *min_dist_to_obj) {
-      *min_dist_to_obj = dist_to_obj;
+    if (squared_dist_to_obj < min_squared_dist) {
+      min_squared_dist = squared_dist_to_obj;
+      *min_dist_to_obj = std::sqrt(squared_dist_to_obj);
       nearest_obj_point->x = p.x;
       nearest_obj_point->y = p.y;
       nearest_obj_point->z = p.z;
     }
+    // no point can be nearer than one inside the vehicle
+    if (min_squared_dist == 0.0) {
+      break;
+    }
   }
 }
 
@@ -285,12 +324,40 @@ void SurroundObstacleCheckerNode::getNearestObstacleByDynamicObject(
 {
   const auto obj_frame = object_ptr_->header.frame_id;
   const auto obj_time = object_ptr_->header.stamp;
+
+  // the transform is the same for all the objects
+  tf2::Transform src2baselink;
+  if (!lookupTransform(obj_frame, "base_link", obj_time, src2baselink)) {
+    return;
+  }
+  const tf2::Transform baselink2src = src2baselink.inverse();
+
+  const autoware_utils::OrientedBox2d self_box(
+    geometry_msgs::msg::Pose{}, vehicle_info_.min_longitudinal_offset_m,
+    vehicle_info_.max_longitudinal_offset_m, vehicle_info_.min_lateral_offset_m,
+    vehicle_info_.max_lateral_offset_m);
+  const double search_distance = getSearchDistance();
+
   for (const auto & obj : object_ptr_->objects) {
     // change frame of obj_pose to base_link
+    tf2::Transform src2obj;
+    tf2::fromMsg(obj.state.pose_covariance.pose, src2obj);
     geometry_msgs::msg::Pose pose_baselink;
-    if (!convertPose(
-          obj.state.pose_covariance.pose, obj_frame, "base_link", obj_time, pose_baselink)) {
-      return;
+    tf2::toMsg(baselink2src * src2obj, pose_baselink);
+
+    // skip the objects whose bounding circle is out of the search distance, without polygons
+    double radius = 0.0;
+    if (obj.shape.type == autoware_perception_msgs::msg::Shape::POLYGON) {
+      for (const auto & point : obj.shape.footprint.points) {
+        radius = std::max(radius, std::hypot(point.x, point.y));
+      }
+    } else {
+      radius = std::hypot(obj.shape.dimensions.x / 2.0, obj.shape.dimensions.y / 2.0);
+    }
+    const double dist_to_center = std::sqrt(
+      self_box.calcSquaredDistance(pose_baselink.position.x, pose_baselink.position.y));
+    if (dist_to_center - radius > std::min(search_distance, *min_dist_to_obj)) {
+      continue;
     }
 
     // create obj polygon
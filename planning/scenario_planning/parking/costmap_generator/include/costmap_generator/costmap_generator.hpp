@@ -104,6 +104,11 @@ private:
 
   grid_map::GridMap costmap_;
 
+  // way area rasterized once in a grid larger than the costmap, and only again when the costmap
+  // goes out of it or the map changes
+  grid_map::GridMap wayarea_cache_;
+  bool is_wayarea_cache_valid_;
+
   rclcpp::Publisher<grid_map_msgs::msg::GridMap>::SharedPtr pub_costmap_;
   rclcpp::Publisher<nav_msgs::msg::OccupancyGrid>::SharedPtr pub_occupancy_grid_;
 
@@ -186,8 +191,11 @@ private:
   /// \brief calculate cost from lanelet2 map
   grid_map::Matrix generateWayAreaCostmap();
 
-  /// \brief calculate cost for final output
-  grid_map::Matrix generateCombinedCostmap();
+  /// \brief rasterize the way area around the costmap in wayarea_cache_
+  void updateWayAreaCache();
+
+  /// \brief calculate cost for final output, in the combined layer of costmap_
+  void generateCombinedCostmap();
 };
 
 #endif  // COSTMAP_GENERATOR__COSTMAP_GENERATOR_HPP_
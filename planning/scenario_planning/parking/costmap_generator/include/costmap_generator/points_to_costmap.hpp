@@ -50,6 +50,7 @@
 
 #include <pcl_conversions/pcl_conversions.h>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -72,6 +73,12 @@ public:
     const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points);
 
 private:
+  enum class CellState : uint8_t {
+    NoPoint,                // the cost is cleared
+    OutOfHeightRangePoint,  // the cost is kept
+    InHeightRangePoint      // the cost is set
+  };
+
   double grid_length_x_;
   double grid_length_y_;
   double grid_resolution_;
@@ -95,26 +102,25 @@ private:
   grid_map::Index fetchGridIndexFromPoint(const pcl::PointXYZ & point);
 
   /// \brief Assign pointcloud to appropriate cell in gridmap
+  /// \param[in] maximum_height_thres: Maximum height threshold for pointcloud data
+  /// \param[in] minimum_height_thres: Minimum height threshold for pointcloud data
   /// \param[in] in_sensor_points: subscribed pointcloud
-  /// \param[out] grid-x-length x grid-y-length size grid stuffed with point's height in
-  /// corresponding grid cell
-  std::vector<std::vector<std::vector<double>>> assignPoints2GridCell(
+  /// \param[out] grid-x-length x grid-y-length size grid, x major, with the state of the points in
+  /// each cell
+  std::vector<CellState> assignPoints2GridCell(
+    const double maximum_height_thres, const double minimum_lidar_height_thres,
     const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points);
 
   /// \brief calculate costmap from subscribed pointcloud
-  /// \param[in] maximum_height_thres: Maximum height threshold for pointcloud data
-  /// \param[in] minimum_height_thres: Minimum height threshold for pointcloud data
   /// \param[in] grid_min_value: Minimum cost for costmap
   /// \param[in] grid_max_value: Maximum cost fot costmap
   /// \param[in] gridmap: costmap based on gridmap
   /// \param[in] gridmap_layer_name: gridmap layer name for gridmap
-  /// \param[in] grid_vec: grid-x-length x grid-y-length size grid stuffed with point's height in
-  /// corresponding grid cell \param[out] calculated costmap in grid_map::Matrix format
+  /// \param[in] cell_states: state of the points in each cell, from assignPoints2GridCell
+  /// \param[out] calculated costmap in grid_map::Matrix format
   grid_map::Matrix calculateCostmap(
-    const double maximum_height_thres, const double minimum_lidar_height_thres,
     const double grid_min_value, const double grid_max_value, const grid_map::GridMap & gridmap,
-    const std::string & gridmap_layer_name,
-    const std::vector<std::vector<std::vector<double>>> grid_vec);
+    const std::string & gridmap_layer_name, const std::vector<CellState> & cell_states);
 };
 
 #endif  // COSTMAP_GENERATOR__POINTS_TO_COSTMAP_HPP_
@@ -54,6 +54,7 @@
 #include <tf2/utils.h>
 #include <tf2_eigen/tf2_eigen.h>
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
@@ -109,7 +110,10 @@ pcl::PointCloud<pcl::PointXYZ> getTransformedPointCloud(
 }  // namespace
 
 CostmapGenerator::CostmapGenerator(const rclcpp::NodeOptions & node_options)
-: Node("costmap_generator", node_options), tf_buffer_(this->get_clock()), tf_listener_(tf_buffer_)
+: Node("costmap_generator", node_options),
+  is_wayarea_cache_valid_(false),
+  tf_buffer_(this->get_clock()),
+  tf_listener_(tf_buffer_)
 {
   // Parameters
   costmap_frame_ = this->declare_parameter<std::string>("costmap_frame", "map");
@@ -221,9 +225,11 @@ void CostmapGenerator::onLaneletMapBin(
   lanelet::utils::conversion::fromBinMsg(*msg, lanelet_map_);
 
   if (use_wayarea_) {
+    area_points_.clear();
     loadRoadAreasFromLaneletMap(lanelet_map_, &area_points_);
     loadParkingAreasFromLaneletMap(lanelet_map_, &area_points_);
   }
+  is_wayarea_cache_valid_ = false;
 }
 
 void CostmapGenerator::onObjects(
@@ -268,15 +274,30 @@ void CostmapGenerator::onTimer()
     costmap_[LayerName::wayarea] = generateWayAreaCostmap();
   }
 
-  if (use_objects_ && objects_) {
-    costmap_[LayerName::objects] = generateObjectsCostmap(objects_);
+  // the objects and the points are independent of each other
+  const bool update_objects = use_objects_ && objects_;
+  const bool update_points = use_points_ && points_;
+  grid_map::Matrix objects_costmap;
+  grid_map::Matrix points_costmap;
+#pragma omp parallel sections
+  {
+#pragma omp section
+    if (update_objects) {
+      objects_costmap = generateObjectsCostmap(objects_);
+    }
+#pragma omp section
+    if (update_points) {
+      points_costmap = generatePointsCostmap(points_);
+    }
   }
-
-  if (use_points_ && points_) {
-    costmap_[LayerName::points] = generatePointsCostmap(points_);
+  if (update_objects) {
+    costmap_[LayerName::objects] = std::move(objects_costmap);
+  }
+  if (update_points) {
+    costmap_[LayerName::points] = std::move(points_costmap);
   }
 
-  costmap_[LayerName::combined] = generateCombinedCostmap();
+  generateCombinedCostmap();
 
   publishCostmap(costmap_);
 }
@@ -355,32 +376,68 @@ grid_map::Matrix CostmapGenerator::generateObjectsCostmap(
 
 grid_map::Matrix CostmapGenerator::generateWayAreaCostmap()
 {
-  grid_map::GridMap lanelet2_costmap = costmap_;
+  // the way area is static only in the map frame
+  if (costmap_frame_ != map_frame_) {
+    grid_map::GridMap lanelet2_costmap = costmap_;
+    if (!area_points_.empty()) {
+      object_map::FillPolygonAreas(
+        lanelet2_costmap, area_points_, LayerName::wayarea, grid_max_value_, grid_min_value_,
+        grid_min_value_, grid_max_value_, costmap_frame_, map_frame_, tf_buffer_);
+    }
+    return lanelet2_costmap[LayerName::wayarea];
+  }
+
+  const grid_map::Length margin = 0.5 * (wayarea_cache_.getLength() - costmap_.getLength());
+  const grid_map::Position offset = costmap_.getPosition() - wayarea_cache_.getPosition();
+  if (
+    !is_wayarea_cache_valid_ || std::abs(offset.x()) > margin.x() ||
+    std::abs(offset.y()) > margin.y()) {
+    updateWayAreaCache();
+  }
+
+  // the cells of the costmap are not aligned with the cache, take the closest one
+  grid_map::Matrix wayarea_costmap = costmap_[LayerName::wayarea];
+  const auto & wayarea_cache_data = wayarea_cache_[LayerName::wayarea];
+  for (grid_map::GridMapIterator itr(costmap_); !itr.isPastEnd(); ++itr) {
+    grid_map::Position position;
+    grid_map::Index cache_index;
+    const grid_map::Index index = *itr;
+    costmap_.getPosition(index, position);
+    wayarea_costmap(index.x(), index.y()) = wayarea_cache_.getIndex(position, cache_index)
+                                              ? wayarea_cache_data(cache_index.x(), cache_index.y())
+                                              : grid_max_value_;
+  }
+  return wayarea_costmap;
+}
+
+void CostmapGenerator::updateWayAreaCache()
+{
+  // the costmap can move by its own size before the cache is updated again
+  wayarea_cache_ = grid_map::GridMap();
+  wayarea_cache_.setFrameId(costmap_frame_);
+  wayarea_cache_.setGeometry(
+    3.0 * costmap_.getLength(), costmap_.getResolution(), costmap_.getPosition());
+  wayarea_cache_.add(LayerName::wayarea, grid_max_value_);
   if (!area_points_.empty()) {
     object_map::FillPolygonAreas(
-      lanelet2_costmap, area_points_, LayerName::wayarea, grid_max_value_, grid_min_value_,
+      wayarea_cache_, area_points_, LayerName::wayarea, grid_max_value_, grid_min_value_,
       grid_min_value_, grid_max_value_, costmap_frame_, map_frame_, tf_buffer_);
   }
-  return lanelet2_costmap[LayerName::wayarea];
+  is_wayarea_cache_valid_ = true;
 }
 
-grid_map::Matrix CostmapGenerator::generateCombinedCostmap()
+void CostmapGenerator::generateCombinedCostmap()
 {
   // assuming combined_costmap is calculated by element wise max operation
-  grid_map::GridMap combined_costmap = costmap_;
-
-  combined_costmap[LayerName::combined].setConstant(grid_min_value_);
+  auto & combined_costmap = costmap_[LayerName::combined];
 
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::points]);
+  combined_costmap.setConstant(grid_min_value_);
 
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::wayarea]);
+  combined_costmap = combined_costmap.cwiseMax(costmap_[LayerName::points]);
 
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::objects]);
+  combined_costmap = combined_costmap.cwiseMax(costmap_[LayerName::wayarea]);
 
-  return combined_costmap[LayerName::combined];
+  combined_costmap = combined_costmap.cwiseMax(costmap_[LayerName::objects]);
 }
 
 void CostmapGenerator::publishCostmap(const grid_map::GridMap & costmap)
@@ -75,7 +75,8 @@ void FillPolygonAreas(
     out_grid_map, in_grid_layer_name, CV_8UC1, in_layer_min_value, in_layer_max_value,
     original_image);
 
-  cv::Mat merged_filled_image = original_image.clone();
+  // the polygons are drawn in a single mask instead of an image for each of them
+  cv::Mat polygon_mask = cv::Mat::zeros(original_image.size(), CV_8UC1);
 
   geometry_msgs::msg::TransformStamped transform;
   transform = in_tf_buffer.lookupTransform(
@@ -88,6 +89,7 @@ void FillPolygonAreas(
 
   for (const auto & points : in_area_points) {
     std::vector<cv::Point> cv_polygon;
+    cv::Rect2d bounding_box;
 
     for (const auto & p : points) {
       // transform to GridMap coordinate
@@ -103,17 +105,23 @@ void FillPolygonAreas(
       const double cv_y = (out_grid_map.getLength().x() - origin_x_offset - transformed_point.x) /
                           out_grid_map.getResolution();
       cv_polygon.emplace_back(cv_x, cv_y);
+      bounding_box |= cv::Rect2d(cv_x, cv_y, 1.0, 1.0);
     }
 
-    cv::Mat filled_image = original_image.clone();
+    // most of the polygons of the map are out of the grid
+    if ((bounding_box & cv::Rect2d(0, 0, polygon_mask.cols, polygon_mask.rows)).empty()) {
+      continue;
+    }
 
     std::vector<std::vector<cv::Point>> cv_polygons;
     cv_polygons.push_back(cv_polygon);
-    cv::fillPoly(filled_image, cv_polygons, cv::Scalar(in_fill_color));
-
-    merged_filled_image &= filled_image;
+    cv::fillPoly(polygon_mask, cv_polygons, cv::Scalar(255));
   }
 
+  // same as filling each polygon in a copy of the original image and merging them with and
+  cv::Mat merged_filled_image = original_image.clone();
+  cv::bitwise_and(original_image, cv::Scalar(in_fill_color), merged_filled_image, polygon_mask);
+
   // convert to ROS msg
   grid_map::GridMapCvConverter::addLayerFromImage<unsigned char, 1>(
     merged_filled_image, in_grid_layer_name, out_grid_map, in_layer_min_value, in_layer_max_value);
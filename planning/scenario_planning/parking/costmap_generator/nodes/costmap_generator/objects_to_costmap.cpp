@@ -157,7 +157,10 @@ grid_map::Matrix ObjectsToCostmap::makeCostmapFromObjects(
   const double size_of_expansion_kernel,
   const autoware_perception_msgs::msg::DynamicObjectArray::ConstSharedPtr in_objects)
 {
-  grid_map::GridMap objects_costmap = costmap;
+  // only the geometry of the costmap, not to copy its layers
+  grid_map::GridMap objects_costmap;
+  objects_costmap.setFrameId(costmap.getFrameId());
+  objects_costmap.setGeometry(costmap.getLength(), costmap.getResolution(), costmap.getPosition());
   objects_costmap.add(OBJECTS_COSTMAP_LAYER_, 0);
   objects_costmap.add(BLURRED_OBJECTS_COSTMAP_LAYER_, 0);
 
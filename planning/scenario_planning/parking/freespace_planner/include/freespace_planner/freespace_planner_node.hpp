@@ -60,6 +60,7 @@ using autoware_planning_msgs::msg::Trajectory;
 using freespace_planning_algorithms::AbstractPlanningAlgorithm;
 using freespace_planning_algorithms::AstarParam;
 using freespace_planning_algorithms::PlannerCommonParam;
+using geometry_msgs::msg::Pose;
 using geometry_msgs::msg::PoseArray;
 using geometry_msgs::msg::PoseStamped;
 using geometry_msgs::msg::TransformStamped;
@@ -77,6 +78,11 @@ struct NodeParam
   double th_course_out_distance_m;
   bool replan_when_obstacle_found;
   bool replan_when_course_out;
+
+  // goal candidates planned in parallel, combinations of the offsets from the route goal
+  std::vector<double> goal_candidate_longitudinal_offsets;  // along the goal direction [m]
+  std::vector<double> goal_candidate_yaw_offsets;           // [deg]
+  std::string goal_candidate_selection;  // "first" found or "shortest" of all the plans
 };
 
 class FreespacePlannerNode : public rclcpp::Node
@@ -107,6 +113,8 @@ private:
 
   // variables
   std::unique_ptr<AbstractPlanningAlgorithm> algo_;
+  // one planner for each goal candidate, all of them have the same costmap
+  std::vector<std::unique_ptr<AbstractPlanningAlgorithm>> goal_candidate_algos_;
   PoseStamped current_pose_;
   PoseStamped goal_pose_;
 
@@ -139,8 +147,14 @@ private:
   void reset();
   bool isPlanRequired();
   void planTrajectory();
+  std::vector<Pose> createGoalCandidates(const Pose & goal_pose) const;
+  // returns the planner of the selected plan, nullptr when no plan is found
+  const AbstractPlanningAlgorithm * planToGoalCandidates(
+    const Pose & start_pose, const std::vector<Pose> & goal_poses,
+    const freespace_planning_algorithms::VehicleShape & vehicle_shape);
   void updateTargetIndex();
   void initializePlanningAlgorithm();
+  std::unique_ptr<AbstractPlanningAlgorithm> createPlanningAlgorithm() const;
 
   TransformStamped getTransform(const std::string & from, const std::string & to);
 };
@@ -32,8 +32,14 @@
 
 #include <autoware_utils/autoware_utils.hpp>
 
+#include <tf2/utils.h>
+
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <deque>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -176,6 +182,16 @@ Trajectory createTrajectory(
   return trajectory;
 }
 
+double calcWaypointsLength(const PlannerWaypoints & planner_waypoints)
+{
+  double length = 0.0;
+  const auto & waypoints = planner_waypoints.waypoints;
+  for (size_t i = 1; i < waypoints.size(); ++i) {
+    length += autoware_utils::calcDistance2d(waypoints.at(i - 1).pose, waypoints.at(i).pose);
+  }
+  return length;
+}
+
 Trajectory createStopTrajectory(const PoseStamped & current_pose)
 {
   PlannerWaypoints waypoints;
@@ -224,6 +240,15 @@ FreespacePlannerNode::FreespacePlannerNode(const rclcpp::NodeOptions & node_opti
     p.th_course_out_distance_m = declare_parameter("th_course_out_distance_m", 3.0);
     p.replan_when_obstacle_found = declare_parameter("replan_when_obstacle_found", true);
     p.replan_when_course_out = declare_parameter("replan_when_course_out", true);
+    p.goal_candidate_longitudinal_offsets = declare_parameter(
+      "goal_candidates.longitudinal_offsets", std::vector<double>{0.0});
+    p.goal_candidate_yaw_offsets =
+      declare_parameter("goal_candidates.yaw_offsets", std::vector<double>{0.0});
+    p.goal_candidate_selection = declare_parameter("goal_candidates.selection", "first");
+    if (p.goal_candidate_selection != "first" && p.goal_candidate_selection != "shortest") {
+      throw std::runtime_error(
+        "No such goal candidate selection named " + p.goal_candidate_selection + " exists.");
+    }
     declare_parameter<bool>("is_completed", false);
   }
 
@@ -305,6 +330,12 @@ void FreespacePlannerNode::getAstarParam()
   p.only_behind_solutions = declare_parameter("astar.only_behind_solutions", false);
   p.use_back = declare_parameter("astar.use_back", true);
   p.distance_heuristic_weight = declare_parameter("astar.distance_heuristic_weight", 1.0);
+  p.use_reeds_shepp_table = declare_parameter("astar.use_reeds_shepp_table", false);
+  p.reeds_shepp_table_max_distance =
+    declare_parameter("astar.reeds_shepp_table_max_distance", 20.0);
+  p.reeds_shepp_table_resolution = declare_parameter("astar.reeds_shepp_table_resolution", 0.5);
+  p.reeds_shepp_table_theta_size = declare_parameter("astar.reeds_shepp_table_theta_size", 72);
+  p.reeds_shepp_table_path = declare_parameter("astar.reeds_shepp_table_path", "");
 }
 
 void FreespacePlannerNode::onRoute(const Route::ConstSharedPtr msg)
@@ -350,6 +381,7 @@ bool FreespacePlannerNode::isPlanRequired()
   }
 
   if (node_param_.replan_when_obstacle_found) {
+    algo_->setVehicleShape(planner_common_param_.vehicle_shape);
     algo_->setMap(*occupancy_grid_);
 
     const size_t nearest_index_partial =
@@ -468,10 +500,6 @@ void FreespacePlannerNode::planTrajectory()
   extended_vehicle_shape.width += margin;
   extended_vehicle_shape.base2back += margin / 2;
 
-  // Provide robot shape and map for the planner
-  algo_->setVehicleShape(extended_vehicle_shape);
-  algo_->setMap(*occupancy_grid_);
-
   // Calculate poses in costmap frame
   const auto current_pose_in_costmap_frame = transformPose(
     current_pose_.pose,
@@ -482,15 +510,17 @@ void FreespacePlannerNode::planTrajectory()
 
   // execute planning
   const rclcpp::Time start = get_clock()->now();
-  const bool result = algo_->makePlan(current_pose_in_costmap_frame, goal_pose_in_costmap_frame);
+  const auto result_algo = planToGoalCandidates(
+    current_pose_in_costmap_frame, createGoalCandidates(goal_pose_in_costmap_frame),
+    extended_vehicle_shape);
   const rclcpp::Time end = get_clock()->now();
 
   RCLCPP_INFO(get_logger(), "Freespace planning: %f [s]", (end - start).seconds());
 
-  if (result) {
+  if (result_algo) {
     RCLCPP_INFO(get_logger(), "Found goal!");
-    trajectory_ =
-      createTrajectory(current_pose_, algo_->getWaypoints(), node_param_.waypoints_velocity);
+    trajectory_ = createTrajectory(
+      current_pose_, result_algo->getWaypoints(), node_param_.waypoints_velocity);
     reversing_indices_ = getReversingIndices(trajectory_);
     prev_target_index_ = 0;
     target_index_ =
@@ -502,6 +532,72 @@ void FreespacePlannerNode::planTrajectory()
   }
 }
 
+std::vector<Pose> FreespacePlannerNode::createGoalCandidates(const Pose & goal_pose) const
+{
+  // the route goal is the first candidate
+  std::vector<Pose> goal_poses{goal_pose};
+  const double goal_yaw = tf2::getYaw(goal_pose.orientation);
+  for (const double longitudinal_offset : node_param_.goal_candidate_longitudinal_offsets) {
+    for (const double yaw_offset : node_param_.goal_candidate_yaw_offsets) {
+      if (longitudinal_offset == 0.0 && yaw_offset == 0.0) {
+        continue;
+      }
+      Pose pose = goal_pose;
+      pose.position.x += longitudinal_offset * std::cos(goal_yaw);
+      pose.position.y += longitudinal_offset * std::sin(goal_yaw);
+      pose.orientation =
+        autoware_utils::createQuaternionFromYaw(goal_yaw + autoware_utils::deg2rad(yaw_offset));
+      goal_poses.push_back(pose);
+    }
+  }
+  return goal_poses;
+}
+
+const AbstractPlanningAlgorithm * FreespacePlannerNode::planToGoalCandidates(
+  const Pose & start_pose, const std::vector<Pose> & goal_poses,
+  const freespace_planning_algorithms::VehicleShape & vehicle_shape)
+{
+  if (goal_poses.size() == 1) {
+    algo_->setVehicleShape(vehicle_shape);
+    algo_->setMap(*occupancy_grid_);
+    return algo_->makePlan(start_pose, goal_poses.front()) ? algo_.get() : nullptr;
+  }
+
+  while (goal_candidate_algos_.size() < goal_poses.size()) {
+    goal_candidate_algos_.push_back(createPlanningAlgorithm());
+  }
+
+  // the other planners stop once a plan is found when the first one is selected
+  const bool is_first_selected = node_param_.goal_candidate_selection == "first";
+  const auto cancel_flag = std::make_shared<std::atomic<bool>>(false);
+  std::vector<double> lengths(goal_poses.size(), std::numeric_limits<double>::max());
+  std::atomic<int> first_index(-1);
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < goal_poses.size(); ++i) {
+    auto & algo = goal_candidate_algos_.at(i);
+    algo->setCancelFlag(is_first_selected ? cancel_flag : nullptr);
+    algo->setVehicleShape(vehicle_shape);
+    algo->setMap(*occupancy_grid_);
+    if (!algo->makePlan(start_pose, goal_poses.at(i))) {
+      continue;
+    }
+    lengths.at(i) = calcWaypointsLength(algo->getWaypoints());
+    int expected_index = -1;
+    first_index.compare_exchange_strong(expected_index, static_cast<int>(i));
+    *cancel_flag = true;
+  }
+
+  if (first_index < 0) {
+    return nullptr;
+  }
+  const size_t selected_index =
+    is_first_selected
+      ? static_cast<size_t>(first_index)
+      : std::distance(lengths.begin(), std::min_element(lengths.begin(), lengths.end()));
+  RCLCPP_INFO(get_logger(), "Selected goal candidate %zu", selected_index);
+  return goal_candidate_algos_.at(selected_index).get();
+}
+
 void FreespacePlannerNode::reset()
 {
   trajectory_ = Trajectory();
@@ -524,13 +620,20 @@ TransformStamped FreespacePlannerNode::getTransform(
 }
 
 void FreespacePlannerNode::initializePlanningAlgorithm()
+{
+  // the planner is reset by setMap(), so it is reused for the next plans
+  if (!algo_) {
+    algo_ = createPlanningAlgorithm();
+  }
+}
+
+std::unique_ptr<AbstractPlanningAlgorithm> FreespacePlannerNode::createPlanningAlgorithm() const
 {
   if (node_param_.planning_algorithm == "astar") {
-    algo_.reset(new AstarSearch(planner_common_param_, astar_param_));
-  } else {
-    throw std::runtime_error(
-      "No such algorithm named " + node_param_.planning_algorithm + " exists.");
+    return std::make_unique<AstarSearch>(planner_common_param_, astar_param_);
   }
+  throw std::runtime_error(
+    "No such algorithm named " + node_param_.planning_algorithm + " exists.");
 }
 }  // namespace freespace_planner
 
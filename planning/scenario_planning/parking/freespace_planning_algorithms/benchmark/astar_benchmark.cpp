@@ -0,0 +1,139 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Plans the parking maneuvers of the unit tests with A*, on the costmap of the tests (30 m) and
+// on a costmap of the size the costmap_generator publishes (70 m).
+
+#include "freespace_planning_algorithms/astar_search.hpp"
+
+#include <autoware_replay_benchmark/micro_benchmark.hpp>
+
+#include <tf2/utils.h>
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+namespace fpa = freespace_planning_algorithms;
+
+geometry_msgs::msg::Pose createPose(const double x, const double y, const double yaw)
+{
+  geometry_msgs::msg::Pose pose;
+  tf2::Quaternion quat;
+  quat.setRPY(0, 0, yaw);
+  tf2::convert(quat, pose.orientation);
+  pose.position.x = x;
+  pose.position.y = y;
+  return pose;
+}
+
+// empty costmap surrounded by obstacles of the padding width
+nav_msgs::msg::OccupancyGrid createCostmap(
+  const int width, const int height, const double resolution, const int padding)
+{
+  nav_msgs::msg::OccupancyGrid costmap;
+  costmap.info.width = width;
+  costmap.info.height = height;
+  costmap.info.resolution = resolution;
+  costmap.data.resize(width * height, 0);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const bool is_edge =
+        x < padding || y < padding || x >= width - padding || y >= height - padding;
+      costmap.data.at(y * width + x) = is_edge ? 100 : 0;
+    }
+  }
+  return costmap;
+}
+
+fpa::AstarSearch createAstar(const double maximum_turning_radius, const int turning_radius_size)
+{
+  // same as the unit tests
+  fpa::PlannerCommonParam planner_common_param;
+  planner_common_param.time_limit = 10000.0;
+  planner_common_param.vehicle_shape = fpa::VehicleShape{5.5, 2.75, 1.5};
+  planner_common_param.minimum_turning_radius = 9.0;
+  planner_common_param.maximum_turning_radius = maximum_turning_radius;
+  planner_common_param.turning_radius_size = turning_radius_size;
+  planner_common_param.theta_size = 144;
+  planner_common_param.curve_weight = 1.2;
+  planner_common_param.reverse_weight = 2.0;
+  planner_common_param.lateral_goal_range = 0.5;
+  planner_common_param.longitudinal_goal_range = 2.0;
+  planner_common_param.angle_goal_range = 6.0;
+  planner_common_param.obstacle_threshold = 100;
+
+  fpa::AstarParam astar_param;
+  astar_param.only_behind_solutions = false;
+  astar_param.use_back = true;
+  astar_param.distance_heuristic_weight = 1.0;
+  return fpa::AstarSearch(planner_common_param, astar_param);
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  using autoware_replay_benchmark::doNotOptimize;
+  autoware_replay_benchmark::MicroBenchmark benchmark("freespace_planning_algorithms", argc, argv);
+
+  const auto small_costmap = createCostmap(150, 150, 0.2, 10);
+  auto wall_costmap = small_costmap;
+  for (int y = 0; y < 80; ++y) {
+    for (int x = 70; x < 75; ++x) {
+      wall_costmap.data.at(y * 150 + x) = 100;
+    }
+  }
+  const auto large_costmap = createCostmap(350, 350, 0.2, 10);
+
+  auto astar = createAstar(9.0, 1);
+  benchmark.run("setMap/150x150", [&]() { astar.setMap(small_costmap); });
+  benchmark.run("setMap/350x350", [&]() { astar.setMap(large_costmap); });
+
+  struct Scenario
+  {
+    std::string name;
+    const nav_msgs::msg::OccupancyGrid * costmap;
+    std::array<double, 3> start;
+    std::array<double, 3> goal;
+    double maximum_turning_radius;
+    int turning_radius_size;
+  };
+  const std::vector<Scenario> scenarios{
+    {"makePlan/single_curvature/150x150", &small_costmap, {6., 4., 0.5 * M_PI},
+     {26., 4., 0.5 * M_PI}, 9.0, 1},
+    {"makePlan/multi_curvature/150x150", &small_costmap, {6., 4., 0.5 * M_PI},
+     {26., 4., 0.5 * M_PI}, 14.0, 3},
+    {"makePlan/wall/150x150", &wall_costmap, {6., 6., 0.5 * M_PI}, {24., 6., -0.5 * M_PI}, 9.0, 1},
+    {"makePlan/single_curvature/350x350", &large_costmap, {10., 10., 0.5 * M_PI},
+     {40., 10., 0.5 * M_PI}, 9.0, 1},
+  };
+
+  for (const auto & scenario : scenarios) {
+    auto scenario_astar =
+      createAstar(scenario.maximum_turning_radius, scenario.turning_radius_size);
+    scenario_astar.setMap(*scenario.costmap);
+    const auto start = createPose(scenario.start[0], scenario.start[1], scenario.start[2]);
+    const auto goal = createPose(scenario.goal[0], scenario.goal[1], scenario.goal[2]);
+    if (!scenario_astar.makePlan(start, goal)) {
+      std::fprintf(stderr, "%s failed to plan\n", scenario.name.c_str());
+    }
+    benchmark.run(scenario.name, [&]() { doNotOptimize(scenario_astar.makePlan(start, goal)); });
+  }
+
+  return benchmark.finish();
+}
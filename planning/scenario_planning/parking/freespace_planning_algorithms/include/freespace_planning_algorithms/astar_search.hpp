@@ -17,13 +17,16 @@
 
 #include "freespace_planning_algorithms/abstract_algorithm.hpp"
 #include "freespace_planning_algorithms/reeds_shepp.hpp"
+#include "freespace_planning_algorithms/reeds_shepp_distance_table.hpp"
 
 #include <nav_msgs/msg/path.hpp>
 #include <std_msgs/msg/header.hpp>
 
 #include <cmath>
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <string>
 #include <tuple>
@@ -41,28 +44,47 @@ struct AstarParam
 
   // search configs
   double distance_heuristic_weight;  // obstacle threshold on grid [0,255]
+
+  // reeds shepp distance table configs
+  bool use_reeds_shepp_table = false;            // interpolate the precomputed distances
+  double reeds_shepp_table_max_distance = 20.0;  // range of the table [m]
+  double reeds_shepp_table_resolution = 0.5;     // xy resolution of the table [m]
+  int reeds_shepp_table_theta_size = 72;         // yaw size of the table [-]
+  std::string reeds_shepp_table_path;            // cache file of the table, not used when empty
 };
 
 struct AstarNode
 {
-  NodeStatus status = NodeStatus::None;  // node status
   double x;                              // x
   double y;                              // y
   double theta;                          // theta
   double gc = 0;                         // actual cost
   double hc = 0;                         // heuristic cost
-  bool is_back;                          // true if the current direction of the vehicle is back
   AstarNode * parent = nullptr;          // parent node
+  uint32_t open_list_index = 0;          // position in the open list while the node is open
+  NodeStatus status = NodeStatus::None;  // node status
+  bool is_back;                          // true if the current direction of the vehicle is back
 
   double cost() const { return gc + hc; }
 };
 
-struct NodeComparison
+// binary heap of the open nodes, which keeps the position of each node in the heap so that the
+// cost of an open node is updated in place instead of pushing it again
+class AstarOpenList
 {
-  bool operator()(const AstarNode * lhs, const AstarNode * rhs)
-  {
-    return lhs->cost() > rhs->cost();
-  }
+public:
+  bool empty() const { return heap_.empty(); }
+  void clear() { heap_.clear(); }
+  // push the node, or move it after its cost is changed if it is already in the open list
+  void push(AstarNode * node);
+  AstarNode * pop();
+
+private:
+  void siftUp(size_t index);
+  void siftDown(size_t index);
+  void set(size_t index, AstarNode * node);
+
+  std::vector<AstarNode *> heap_;
 };
 
 struct NodeUpdate
@@ -120,24 +142,37 @@ private:
   void setPath(const AstarNode & goal);
   bool setStartNode();
   bool setGoalNode();
+  void computeHolonomicDistanceTable(const IndexXYT & goal_index);
   double estimateCost(const geometry_msgs::msg::Pose & pose);
   bool isGoal(const AstarNode & node);
 
-  AstarNode * getNodeRef(const IndexXYT & index) { return &nodes_[index.y][index.x][index.theta]; }
+  AstarNode * getNodeRef(const IndexXYT & index)
+  {
+    return &nodes_
+      [(static_cast<size_t>(index.y) * costmap_.info.width + index.x) *
+         planner_common_param_.theta_size +
+       index.theta];
+  }
 
   // Algorithm specific param
   AstarParam astar_param_;
 
   // hybrid astar variables
   TransitionTable transition_table_;
-  std::vector<std::vector<std::vector<AstarNode>>> nodes_;
-  std::priority_queue<AstarNode *, std::vector<AstarNode *>, NodeComparison> openlist_;
+  // nodes of all the (y, x, theta) indexes in a single array
+  std::vector<AstarNode> nodes_;
+  AstarOpenList openlist_;
+
+  // shortest distance from each cell to the goal around the obstacles, without the kinematic
+  // constraints, as a heuristic in addition to the distance metric
+  std::vector<double> holonomic_distance_table_;
 
   // goal node, which may helpful in testing and debugging
   AstarNode * goal_node_;
 
   // distance metric option (removed when the reeds_shepp gets stable)
   bool use_reeds_shepp_;
+  std::shared_ptr<const ReedsSheppDistanceTable> reeds_shepp_table_;
 };
 }  // namespace freespace_planning_algorithms
 
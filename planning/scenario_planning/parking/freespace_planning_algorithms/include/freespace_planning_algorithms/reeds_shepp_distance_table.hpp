@@ -0,0 +1,74 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef FREESPACE_PLANNING_ALGORITHMS__REEDS_SHEPP_DISTANCE_TABLE_HPP_
+#define FREESPACE_PLANNING_ALGORITHMS__REEDS_SHEPP_DISTANCE_TABLE_HPP_
+
+#include "freespace_planning_algorithms/reeds_shepp.hpp"
+
+#include <string>
+#include <vector>
+
+namespace freespace_planning_algorithms
+{
+/**
+ * @brief Reeds-Shepp distances precomputed on a (x, y, yaw) grid of the goal relative to the start,
+ * so that the heuristic of the search is a trilinear interpolation instead of evaluating all the
+ * path types. The goals out of the table are left to ReedsSheppStateSpace.
+ */
+class ReedsSheppDistanceTable
+{
+public:
+  struct Param
+  {
+    double turning_radius;  // [m]
+    double max_distance;    // range of the table in x and y from the start [m]
+    double xy_resolution;   // [m]
+    int theta_size;         // discretized yaw size [-]
+  };
+
+  /**
+   * @brief Load the table from the file when it is generated with the same param, else generate
+   * it at the first start and save it to the file for the next one
+   * @param file_path cache of the table, not used when empty
+   */
+  explicit ReedsSheppDistanceTable(const Param & param, const std::string & file_path = "");
+
+  /**
+   * @brief Interpolated Reeds-Shepp distance from s0 to s1
+   * @return false when s1 is out of the range of the table from s0
+   */
+  bool distance(
+    const ReedsSheppStateSpace::StateXYT & s0, const ReedsSheppStateSpace::StateXYT & s1,
+    double * distance) const;
+
+  bool isLoaded() const { return is_loaded_; }
+
+private:
+  void generate();
+  bool load(const std::string & file_path);
+  bool save(const std::string & file_path) const;
+  size_t getIndex(const int x, const int y, const int theta) const
+  {
+    return (static_cast<size_t>(theta) * xy_size_ + y) * xy_size_ + x;
+  }
+
+  Param param_;
+  int xy_size_;
+  // whether the table is read from the file instead of generated
+  bool is_loaded_;
+  std::vector<float> distances_;
+};
+}  // namespace freespace_planning_algorithms
+
+#endif  // FREESPACE_PLANNING_ALGORITHMS__REEDS_SHEPP_DISTANCE_TABLE_HPP_
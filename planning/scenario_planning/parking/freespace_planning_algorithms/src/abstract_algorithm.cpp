@@ -16,6 +16,10 @@
 
 #include <autoware_utils/autoware_utils.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <utility>
 #include <vector>
 
 namespace freespace_planning_algorithms
@@ -90,30 +94,76 @@ geometry_msgs::msg::Pose local2global(
 void AbstractPlanningAlgorithm::setMap(const nav_msgs::msg::OccupancyGrid & costmap)
 {
   costmap_ = costmap;
-  const auto height = costmap_.info.height;
-  const auto width = costmap_.info.width;
-
-  // Initialize status
-  std::vector<std::vector<bool>> is_obstacle_table;
-  is_obstacle_table.resize(height);
-  for (uint32_t i = 0; i < height; i++) {
-    is_obstacle_table.at(i).resize(width);
-    for (uint32_t j = 0; j < width; j++) {
-      const int cost = costmap_.data[i * width + j];
+  const int height = costmap_.info.height;
+  const int width = costmap_.info.width;
+
+  // construct footprint table
+  footprint_table_.clear();
+  obstacle_map_padding_ = 0;
+  for (int i = 0; i < planner_common_param_.theta_size; i++) {
+    std::vector<IndexXY> indexes_2d;
+    computeCollisionIndexes(i, indexes_2d);
+    footprint_table_.push_back(computeFootprint(indexes_2d));
+
+    const auto & footprint = footprint_table_.back();
+    obstacle_map_padding_ = std::max(
+      {obstacle_map_padding_, std::abs(footprint.min.x), std::abs(footprint.max.x),
+       std::abs(footprint.min.y), std::abs(footprint.max.y)});
+  }
 
+  // construct obstacle map, one more word for the masks read across two words
+  const int padded_width = width + 2 * obstacle_map_padding_;
+  const int padded_height = height + 2 * obstacle_map_padding_;
+  obstacle_map_row_words_ = (padded_width + 63) / 64 + 1;
+  obstacle_map_.assign(padded_height * obstacle_map_row_words_, ~uint64_t{0});
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+      const int cost = costmap_.data[i * width + j];
       if (cost < 0 || planner_common_param_.obstacle_threshold <= cost) {
-        is_obstacle_table[i][j] = true;
+        continue;
       }
+      const int x = j + obstacle_map_padding_;
+      const int y = i + obstacle_map_padding_;
+      obstacle_map_[y * obstacle_map_row_words_ + (x >> 6)] &= ~(uint64_t{1} << (x & 63));
     }
   }
-  is_obstacle_table_ = is_obstacle_table;
+}
 
-  // construct collision indexes table
-  for (int i = 0; i < planner_common_param_.theta_size; i++) {
-    std::vector<IndexXY> indexes_2d;
-    computeCollisionIndexes(i, indexes_2d);
-    coll_indexes_table_.push_back(indexes_2d);
+AbstractPlanningAlgorithm::Footprint AbstractPlanningAlgorithm::computeFootprint(
+  const std::vector<IndexXY> & indexes_2d)
+{
+  Footprint footprint{{0, 0}, {0, 0}, {}};
+  if (indexes_2d.empty()) {
+    return footprint;
+  }
+
+  // range of the cells on each row
+  std::map<int, FootprintRow> rows;
+  std::map<int, int> max_xs;
+  for (const auto & index : indexes_2d) {
+    auto & row = rows.emplace(index.y, FootprintRow{index.y, index.x, {}}).first->second;
+    row.min_x = std::min(row.min_x, index.x);
+    auto & max_x = max_xs.emplace(index.y, index.x).first->second;
+    max_x = std::max(max_x, index.x);
+  }
+  footprint.min = {rows.begin()->second.min_x, rows.begin()->first};
+  footprint.max = {max_xs.begin()->second, rows.rbegin()->first};
+  for (auto & row : rows) {
+    const int max_x = max_xs.at(row.first);
+    row.second.mask.resize((max_x - row.second.min_x) / 64 + 1, 0);
+    footprint.min.x = std::min(footprint.min.x, row.second.min_x);
+    footprint.max.x = std::max(footprint.max.x, max_x);
+  }
+
+  for (const auto & index : indexes_2d) {
+    auto & row = rows.at(index.y);
+    const int bit = index.x - row.min_x;
+    row.mask[bit / 64] |= uint64_t{1} << (bit % 64);
   }
+  for (auto & row : rows) {
+    footprint.rows.push_back(std::move(row.second));
+  }
+  return footprint;
 }
 
 void AbstractPlanningAlgorithm::computeCollisionIndexes(
@@ -151,16 +201,33 @@ void AbstractPlanningAlgorithm::computeCollisionIndexes(
 
 bool AbstractPlanningAlgorithm::detectCollision(const IndexXYT & base_index)
 {
-  const auto & coll_indexes_2d = coll_indexes_table_[base_index.theta];
-  for (const auto & coll_index_2d : coll_indexes_2d) {
-    int idx_theta = 0;  // whatever. Yaw is nothing to do with collision detection between grids.
-    IndexXYT coll_index{coll_index_2d.x, coll_index_2d.y, idx_theta};
-    // must slide to current base position
-    coll_index.x += base_index.x;
-    coll_index.y += base_index.y;
-
-    if (isOutOfRange(coll_index) || isObs(coll_index)) {
-      return true;
+  const auto & footprint = footprint_table_[base_index.theta];
+
+  // out of the padding, some cells of the footprint are out of the costmap
+  const int padding = obstacle_map_padding_;
+  if (
+    base_index.x + footprint.min.x < -padding ||
+    static_cast<int>(costmap_.info.width) + padding <= base_index.x + footprint.max.x ||
+    base_index.y + footprint.min.y < -padding ||
+    static_cast<int>(costmap_.info.height) + padding <= base_index.y + footprint.max.y) {
+    return true;
+  }
+
+  // compare 64 cells of the row at once, the padding holds the cells out of the costmap
+  for (const auto & row : footprint.rows) {
+    const uint64_t * obstacle_row =
+      &obstacle_map_[(base_index.y + row.y + padding) * obstacle_map_row_words_];
+    const int min_x = base_index.x + row.min_x + padding;
+    for (size_t i = 0; i < row.mask.size(); ++i) {
+      const int x = min_x + 64 * static_cast<int>(i);
+      const int shift = x & 63;
+      uint64_t obstacles = obstacle_row[x >> 6] >> shift;
+      if (shift > 0) {
+        obstacles |= obstacle_row[(x >> 6) + 1] << (64 - shift);
+      }
+      if (obstacles & row.mask[i]) {
+        return true;
+      }
     }
   }
   return false;
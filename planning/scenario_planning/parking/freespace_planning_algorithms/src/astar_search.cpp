@@ -19,17 +19,25 @@
 #include <tf2/utils.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
 #include <vector>
 
 namespace freespace_planning_algorithms
 {
+ReedsSheppStateSpace::StateXYT toStateXYT(const geometry_msgs::msg::Pose & pose)
+{
+  return {pose.position.x, pose.position.y, tf2::getYaw(pose.orientation)};
+}
+
 double calcReedsSheppDistance(
   const geometry_msgs::msg::Pose & p1, const geometry_msgs::msg::Pose & p2, double radius)
 {
   auto rs_space = ReedsSheppStateSpace(radius);
-  ReedsSheppStateSpace::StateXYT pose0{p1.position.x, p1.position.y, tf2::getYaw(p1.orientation)};
-  ReedsSheppStateSpace::StateXYT pose1{p2.position.x, p2.position.y, tf2::getYaw(p2.orientation)};
-  return rs_space.distance(pose0, pose1);
+  return rs_space.distance(toStateXYT(p1), toStateXYT(p2));
 }
 
 void setYaw(geometry_msgs::msg::Quaternion * orientation, const double yaw)
@@ -66,6 +74,71 @@ geometry_msgs::msg::Pose node2pose(const AstarNode & node)
   return pose_local;
 }
 
+void AstarOpenList::push(AstarNode * node)
+{
+  if (node->status != NodeStatus::Open) {
+    node->status = NodeStatus::Open;
+    set(heap_.size(), node);
+  }
+  siftUp(node->open_list_index);
+  siftDown(node->open_list_index);
+}
+
+AstarNode * AstarOpenList::pop()
+{
+  AstarNode * top = heap_.front();
+  set(0, heap_.back());
+  heap_.pop_back();
+  if (!heap_.empty()) {
+    siftDown(0);
+  }
+  return top;
+}
+
+void AstarOpenList::siftUp(size_t index)
+{
+  AstarNode * node = heap_[index];
+  while (index > 0) {
+    const size_t parent = (index - 1) / 2;
+    if (heap_[parent]->cost() <= node->cost()) {
+      break;
+    }
+    set(index, heap_[parent]);
+    index = parent;
+  }
+  set(index, node);
+}
+
+void AstarOpenList::siftDown(size_t index)
+{
+  AstarNode * node = heap_[index];
+  while (true) {
+    size_t child = 2 * index + 1;
+    if (child >= heap_.size()) {
+      break;
+    }
+    if (child + 1 < heap_.size() && heap_[child + 1]->cost() < heap_[child]->cost()) {
+      ++child;
+    }
+    if (node->cost() <= heap_[child]->cost()) {
+      break;
+    }
+    set(index, heap_[child]);
+    index = child;
+  }
+  set(index, node);
+}
+
+void AstarOpenList::set(size_t index, AstarNode * node)
+{
+  if (index == heap_.size()) {
+    heap_.push_back(node);
+  } else {
+    heap_[index] = node;
+  }
+  node->open_list_index = static_cast<uint32_t>(index);
+}
+
 AstarSearch::TransitionTable createTransitionTable(
   const double minimum_turning_radius, const double maximum_turning_radius,
   const int turning_radius_size, const double theta_size, const bool use_back)
@@ -124,6 +197,17 @@ AstarSearch::AstarSearch(
     planner_common_param_.minimum_turning_radius, planner_common_param_.maximum_turning_radius,
     planner_common_param_.turning_radius_size, planner_common_param_.theta_size,
     astar_param_.use_back);
+
+  if (astar_param_.use_reeds_shepp_table) {
+    const double radius = (planner_common_param_.minimum_turning_radius +
+                           planner_common_param_.maximum_turning_radius) *
+                          0.5;
+    reeds_shepp_table_ = std::make_shared<const ReedsSheppDistanceTable>(
+      ReedsSheppDistanceTable::Param{
+        radius, astar_param_.reeds_shepp_table_max_distance,
+        astar_param_.reeds_shepp_table_resolution, astar_param_.reeds_shepp_table_theta_size},
+      astar_param_.reeds_shepp_table_path);
+  }
 }
 
 void AstarSearch::setMap(const nav_msgs::msg::OccupancyGrid & costmap)
@@ -134,14 +218,9 @@ void AstarSearch::setMap(const nav_msgs::msg::OccupancyGrid & costmap)
   const auto width = costmap_.info.width;
 
   // Initialize nodes
-  nodes_.clear();
-  nodes_.resize(height);
-  for (uint32_t i = 0; i < height; i++) {
-    nodes_[i].resize(width);
-    for (uint32_t j = 0; j < width; j++) {
-      nodes_[i][j].resize(planner_common_param_.theta_size);
-    }
-  }
+  nodes_.assign(
+    static_cast<size_t>(height) * width * planner_common_param_.theta_size, AstarNode{});
+  openlist_.clear();
 }
 
 bool AstarSearch::makePlan(
@@ -150,11 +229,12 @@ bool AstarSearch::makePlan(
   start_pose_ = global2local(costmap_, start_pose);
   goal_pose_ = global2local(costmap_, goal_pose);
 
-  if (!setStartNode()) {
+  // the heuristic of the start node needs the goal
+  if (!setGoalNode()) {
     return false;
   }
 
-  if (!setGoalNode()) {
+  if (!setStartNode()) {
     return false;
   }
 
@@ -177,7 +257,6 @@ bool AstarSearch::setStartNode()
   start_node->gc = 0;
   start_node->hc = estimateCost(start_pose_);
   start_node->is_back = false;
-  start_node->status = NodeStatus::Open;
   start_node->parent = nullptr;
 
   // Push start node to openlist
@@ -194,9 +273,52 @@ bool AstarSearch::setGoalNode()
     return false;
   }
 
+  computeHolonomicDistanceTable(index);
+
   return true;
 }
 
+void AstarSearch::computeHolonomicDistanceTable(const IndexXYT & goal_index)
+{
+  const int height = costmap_.info.height;
+  const int width = costmap_.info.width;
+  const double resolution = costmap_.info.resolution;
+  holonomic_distance_table_.assign(
+    static_cast<size_t>(height) * width, std::numeric_limits<double>::infinity());
+
+  // dijkstra from the goal on the 8-connected free cells
+  using DistanceIndex = std::pair<double, int>;
+  std::priority_queue<DistanceIndex, std::vector<DistanceIndex>, std::greater<DistanceIndex>>
+    queue;
+  const int goal_cell = goal_index.y * width + goal_index.x;
+  holonomic_distance_table_[goal_cell] = 0.0;
+  queue.emplace(0.0, goal_cell);
+  while (!queue.empty()) {
+    const auto top = queue.top();
+    queue.pop();
+    if (top.first > holonomic_distance_table_[top.second]) {
+      continue;
+    }
+    const int x = top.second % width;
+    const int y = top.second / width;
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        const IndexXYT next_index{x + dx, y + dy, 0};
+        if ((dx == 0 && dy == 0) || isOutOfRange(next_index) || isObs(next_index)) {
+          continue;
+        }
+        const int next_cell = next_index.y * width + next_index.x;
+        const double distance =
+          top.first + (dx != 0 && dy != 0 ? M_SQRT2 * resolution : resolution);
+        if (distance < holonomic_distance_table_[next_cell]) {
+          holonomic_distance_table_[next_cell] = distance;
+          queue.emplace(distance, next_cell);
+        }
+      }
+    }
+  }
+}
+
 double AstarSearch::estimateCost(const geometry_msgs::msg::Pose & pose)
 {
   double total_cost = 0.0;
@@ -205,12 +327,31 @@ double AstarSearch::estimateCost(const geometry_msgs::msg::Pose & pose)
     double radius = (planner_common_param_.minimum_turning_radius +
                      planner_common_param_.maximum_turning_radius) *
                     0.5;
-    total_cost +=
-      calcReedsSheppDistance(pose, goal_pose_, radius) * astar_param_.distance_heuristic_weight;
+    double distance = 0.0;
+    const bool is_in_table =
+      reeds_shepp_table_ &&
+      reeds_shepp_table_->distance(toStateXYT(pose), toStateXYT(goal_pose_), &distance);
+    if (!is_in_table) {
+      distance = calcReedsSheppDistance(pose, goal_pose_, radius);
+    }
+    total_cost += distance * astar_param_.distance_heuristic_weight;
   } else {
     total_cost +=
       autoware_utils::calcDistance2d(pose, goal_pose_) * astar_param_.distance_heuristic_weight;
   }
+
+  // the distance metric ignores the obstacles, so the holonomic distance is larger behind them.
+  // The cells not connected to the goal keep the distance metric as the footprint is only
+  // checked at the nodes.
+  const auto index = pose2index(costmap_, pose, planner_common_param_.theta_size);
+  if (!isOutOfRange(index)) {
+    const double holonomic_distance =
+      holonomic_distance_table_[index.y * costmap_.info.width + index.x];
+    if (std::isfinite(holonomic_distance)) {
+      total_cost =
+        std::max(total_cost, holonomic_distance * astar_param_.distance_heuristic_weight);
+    }
+  }
   return total_cost;
 }
 
@@ -226,10 +367,12 @@ bool AstarSearch::search()
     if (msec > planner_common_param_.time_limit) {
       return false;
     }
+    if (cancel_flag_ && *cancel_flag_) {
+      return false;
+    }
 
     // Expand minimum cost node
-    AstarNode * current_node = openlist_.top();
-    openlist_.pop();
+    AstarNode * current_node = openlist_.pop();
     current_node->status = NodeStatus::Closed;
 
     if (isGoal(*current_node)) {
@@ -262,7 +405,6 @@ bool AstarSearch::search()
       AstarNode * next_node = getNodeRef(next_index);
       const double next_gc = current_node->gc + move_cost;
       if (next_node->status == NodeStatus::None || next_gc < next_node->gc) {
-        next_node->status = NodeStatus::Open;
         next_node->x = next_pose.position.x;
         next_node->y = next_pose.position.y;
         next_node->theta = tf2::getYaw(next_pose.orientation);
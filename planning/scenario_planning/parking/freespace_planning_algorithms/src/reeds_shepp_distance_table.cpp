@@ -0,0 +1,146 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "freespace_planning_algorithms/reeds_shepp_distance_table.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace freespace_planning_algorithms
+{
+namespace
+{
+constexpr char kMagic[8] = {'R', 'S', 'D', 'T', 'B', 'L', '0', '1'};
+
+double normalizeYaw(const double yaw)
+{
+  const double normalized = std::fmod(yaw + M_PI, 2.0 * M_PI);
+  return (normalized < 0.0 ? normalized + 2.0 * M_PI : normalized) - M_PI;
+}
+}  // namespace
+
+ReedsSheppDistanceTable::ReedsSheppDistanceTable(const Param & param, const std::string & file_path)
+: param_(param),
+  xy_size_(static_cast<int>(std::ceil(2.0 * param.max_distance / param.xy_resolution)) + 1),
+  is_loaded_(false)
+{
+  if (!file_path.empty() && load(file_path)) {
+    is_loaded_ = true;
+    return;
+  }
+  generate();
+  if (!file_path.empty()) {
+    save(file_path);
+  }
+}
+
+bool ReedsSheppDistanceTable::distance(
+  const ReedsSheppStateSpace::StateXYT & s0, const ReedsSheppStateSpace::StateXYT & s1,
+  double * distance) const
+{
+  // s1 in the frame of s0, as the table index
+  const double dx = s1.x - s0.x;
+  const double dy = s1.y - s0.y;
+  const double c = std::cos(s0.yaw);
+  const double s = std::sin(s0.yaw);
+  const double ix = (c * dx + s * dy + param_.max_distance) / param_.xy_resolution;
+  const double iy = (-s * dx + c * dy + param_.max_distance) / param_.xy_resolution;
+  if (ix < 0.0 || iy < 0.0 || ix > xy_size_ - 1 || iy > xy_size_ - 1) {
+    return false;
+  }
+  const double theta_resolution = 2.0 * M_PI / param_.theta_size;
+  const double it = (normalizeYaw(s1.yaw - s0.yaw) + M_PI) / theta_resolution;
+
+  const int x0 = std::min(static_cast<int>(ix), xy_size_ - 2);
+  const int y0 = std::min(static_cast<int>(iy), xy_size_ - 2);
+  const int t0 = static_cast<int>(it) % param_.theta_size;
+  const int t1 = (t0 + 1) % param_.theta_size;
+  const double rx = ix - x0;
+  const double ry = iy - y0;
+  const double rt = it - std::floor(it);
+
+  const auto bilinear = [&](const int t) {
+    const double d00 = distances_[getIndex(x0, y0, t)];
+    const double d10 = distances_[getIndex(x0 + 1, y0, t)];
+    const double d01 = distances_[getIndex(x0, y0 + 1, t)];
+    const double d11 = distances_[getIndex(x0 + 1, y0 + 1, t)];
+    return (1.0 - ry) * ((1.0 - rx) * d00 + rx * d10) + ry * ((1.0 - rx) * d01 + rx * d11);
+  };
+  *distance = (1.0 - rt) * bilinear(t0) + rt * bilinear(t1);
+  return true;
+}
+
+void ReedsSheppDistanceTable::generate()
+{
+  ReedsSheppStateSpace rs_space(param_.turning_radius);
+  const ReedsSheppStateSpace::StateXYT start{0.0, 0.0, 0.0};
+  const double theta_resolution = 2.0 * M_PI / param_.theta_size;
+
+  distances_.resize(static_cast<size_t>(param_.theta_size) * xy_size_ * xy_size_);
+  for (int t = 0; t < param_.theta_size; ++t) {
+    for (int y = 0; y < xy_size_; ++y) {
+      for (int x = 0; x < xy_size_; ++x) {
+        const ReedsSheppStateSpace::StateXYT goal{
+          x * param_.xy_resolution - param_.max_distance,
+          y * param_.xy_resolution - param_.max_distance, t * theta_resolution - M_PI};
+        distances_[getIndex(x, y, t)] = rs_space.distance(start, goal);
+      }
+    }
+  }
+}
+
+bool ReedsSheppDistanceTable::load(const std::string & file_path)
+{
+  std::ifstream ifs(file_path, std::ios::binary);
+  if (!ifs) {
+    return false;
+  }
+
+  // the table is only valid for the same param
+  char magic[sizeof(kMagic)];
+  Param param;
+  ifs.read(magic, sizeof(magic));
+  ifs.read(reinterpret_cast<char *>(&param), sizeof(param));
+  if (
+    !ifs || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+    param.turning_radius != param_.turning_radius || param.max_distance != param_.max_distance ||
+    param.xy_resolution != param_.xy_resolution || param.theta_size != param_.theta_size) {
+    return false;
+  }
+
+  distances_.resize(static_cast<size_t>(param_.theta_size) * xy_size_ * xy_size_);
+  ifs.read(
+    reinterpret_cast<char *>(distances_.data()),
+    static_cast<std::streamsize>(distances_.size() * sizeof(float)));
+  if (!ifs || ifs.peek() != std::ifstream::traits_type::eof()) {
+    distances_.clear();
+    return false;
+  }
+  return true;
+}
+
+bool ReedsSheppDistanceTable::save(const std::string & file_path) const
+{
+  std::ofstream ofs(file_path, std::ios::binary | std::ios::trunc);
+  ofs.write(kMagic, sizeof(kMagic));
+  ofs.write(reinterpret_cast<const char *>(&param_), sizeof(param_));
+  ofs.write(
+    reinterpret_cast<const char *>(distances_.data()),
+    static_cast<std::streamsize>(distances_.size() * sizeof(float)));
+  return static_cast<bool>(ofs);
+}
+}  // namespace freespace_planning_algorithms
@@ -20,6 +20,8 @@
 #include <tf2/utils.h>
 
 #include <array>
+#include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -74,9 +76,9 @@ nav_msgs::msg::OccupancyGrid construct_cost_map(
   return costmap_msg;
 }
 
-bool test_astar(
-  std::array<double, 3> start, std::array<double, 3> goal, std::string file_name,
-  double maximum_turning_radius = 9.0, int turning_radius_size = 1)
+fpa::AstarSearch construct_astar(
+  double maximum_turning_radius = 9.0, int turning_radius_size = 1,
+  bool use_reeds_shepp_table = false)
 {
   // set problem configuration
   fpa::VehicleShape shape{5.5, 2.75, 1.5};
@@ -110,11 +112,27 @@ bool test_astar(
   bool only_behind_solutions = false;
   bool use_back = true;
   double distance_heuristic_weight = 1.0;
-  fpa::AstarParam astar_param{only_behind_solutions, use_back, distance_heuristic_weight};
+  double reeds_shepp_table_max_distance = 20.0;
+  double reeds_shepp_table_resolution = 0.5;
+  int reeds_shepp_table_theta_size = 72;
+  std::string reeds_shepp_table_path = "";
+  fpa::AstarParam astar_param{
+    only_behind_solutions,          use_back,
+    distance_heuristic_weight,      use_reeds_shepp_table,
+    reeds_shepp_table_max_distance, reeds_shepp_table_resolution,
+    reeds_shepp_table_theta_size,   reeds_shepp_table_path};
 
-  auto astar = fpa::AstarSearch(planner_common_param, astar_param);
+  return fpa::AstarSearch(planner_common_param, astar_param);
+}
+
+bool test_astar(
+  std::array<double, 3> start, std::array<double, 3> goal, std::string file_name,
+  double maximum_turning_radius = 9.0, int turning_radius_size = 1,
+  const nav_msgs::msg::OccupancyGrid & costmap_msg = construct_cost_map(150, 150, 0.2, 10),
+  bool use_reeds_shepp_table = false)
+{
+  auto astar = construct_astar(maximum_turning_radius, turning_radius_size, use_reeds_shepp_table);
 
-  auto costmap_msg = construct_cost_map(150, 150, 0.2, 10);
   astar.setMap(costmap_msg);
 
   rclcpp::Clock clock{RCL_SYSTEM_TIME};
@@ -169,6 +187,94 @@ TEST(AstarSearchTestSuite, MultiCurvature)
   }
 }
 
+TEST(AstarSearchTestSuite, Wall)
+{
+  // wall from the bottom to the middle of the map between the start and the goal
+  auto costmap_msg = construct_cost_map(150, 150, 0.2, 10);
+  for (int y = 0; y < 80; y++) {
+    for (int x = 70; x < 75; x++) {
+      costmap_msg.data[y * 150 + x] = 100;
+    }
+  }
+  std::array<double, 3> start{6., 6., 0.5 * 3.1415};
+  std::array<double, 3> goal{24., 6., -0.5 * 3.1415};
+  EXPECT_TRUE(test_astar(start, goal, "/tmp/result_wall.txt", 9.0, 1, costmap_msg));
+}
+
+TEST(AstarSearchTestSuite, ReedsSheppTable)
+{
+  std::vector<double> goal_xs{8., 12., 16., 26.};
+  for (size_t i = 0; i < goal_xs.size(); i++) {
+    std::array<double, 3> start{6., 4., 0.5 * 3.1415};
+    std::array<double, 3> goal{goal_xs[i], 4., 0.5 * 3.1415};
+    std::string file_name = "/tmp/result_table" + std::to_string(i) + ".txt";
+    EXPECT_TRUE(test_astar(
+      start, goal, file_name, 9.0, 1, construct_cost_map(150, 150, 0.2, 10), true));
+  }
+}
+
+TEST(ReedsSheppDistanceTableTestSuite, Distance)
+{
+  const double radius = 9.0;
+  const fpa::ReedsSheppDistanceTable::Param param{radius, 10.0, 0.25, 72};
+  const std::string file_path = "/tmp/reeds_shepp_distance_table.bin";
+  std::remove(file_path.c_str());
+  const fpa::ReedsSheppDistanceTable table(param, file_path);
+  EXPECT_FALSE(table.isLoaded());
+
+  fpa::ReedsSheppStateSpace rs_space(radius);
+  const fpa::ReedsSheppStateSpace::StateXYT start{3.0, -2.0, 0.7};
+  for (double x = -8.0; x <= 8.0; x += 1.3) {
+    for (double y = -8.0; y <= 8.0; y += 1.7) {
+      for (double yaw = -3.0; yaw <= 3.0; yaw += 0.9) {
+        // (x, y) in the frame of the start
+        const fpa::ReedsSheppStateSpace::StateXYT goal{
+          start.x + std::cos(start.yaw) * x - std::sin(start.yaw) * y,
+          start.y + std::sin(start.yaw) * x + std::cos(start.yaw) * y, yaw};
+        double distance;
+        ASSERT_TRUE(table.distance(start, goal, &distance));
+        // the interpolation error is bounded by the resolution of the table
+        EXPECT_NEAR(distance, rs_space.distance(start, goal), 0.1 * radius);
+      }
+    }
+  }
+  double distance;
+  EXPECT_FALSE(table.distance(start, {start.x + 20.0, start.y, 0.0}, &distance));
+
+  // the saved table is loaded only with the same param
+  const fpa::ReedsSheppDistanceTable loaded_table(param, file_path);
+  EXPECT_TRUE(loaded_table.isLoaded());
+  double loaded_distance;
+  ASSERT_TRUE(loaded_table.distance(start, {5.0, 1.0, -1.0}, &loaded_distance));
+  ASSERT_TRUE(table.distance(start, {5.0, 1.0, -1.0}, &distance));
+  EXPECT_DOUBLE_EQ(loaded_distance, distance);
+  const fpa::ReedsSheppDistanceTable other_table({radius, 10.0, 0.5, 72}, file_path);
+  EXPECT_FALSE(other_table.isLoaded());
+  std::remove(file_path.c_str());
+}
+
+TEST(AstarSearchTestSuite, ObstacleOnTrajectory)
+{
+  auto astar = construct_astar();
+  astar.setMap(construct_cost_map(150, 150, 0.2, 10));
+
+  const auto has_obstacle = [&astar](std::array<double, 3> pose) {
+    geometry_msgs::msg::PoseArray trajectory;
+    trajectory.poses.push_back(construct_pose_msg(pose));
+    return astar.hasObstacleOnTrajectory(trajectory);
+  };
+  EXPECT_FALSE(has_obstacle({15., 15., 0.}));
+  EXPECT_FALSE(has_obstacle({15., 15., 0.25 * 3.1415}));
+  EXPECT_FALSE(has_obstacle({15., 3.6, 0.}));
+  // footprint on the obstacles around the map
+  EXPECT_TRUE(has_obstacle({15., 2.5, 0.}));
+  EXPECT_TRUE(has_obstacle({3., 15., 0.}));
+  // footprint out of the map
+  EXPECT_TRUE(has_obstacle({1., 15., 0.}));
+  EXPECT_TRUE(has_obstacle({-5., 15., 0.}));
+  EXPECT_TRUE(has_obstacle({15., 40., 0.5 * 3.1415}));
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
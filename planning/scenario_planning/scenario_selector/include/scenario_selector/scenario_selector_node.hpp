@@ -15,6 +15,7 @@
 #ifndef SCENARIO_SELECTOR__SCENARIO_SELECTOR_NODE_HPP_
 #define SCENARIO_SELECTOR__SCENARIO_SELECTOR_NODE_HPP_
 
+#include <autoware_utils/ros/latency_tracer.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_lanelet2_msgs/msg/map_bin.hpp>
@@ -30,9 +31,12 @@
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <boost/optional.hpp>
+
 #include <deque>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 class ScenarioSelectorNode : public rclcpp::Node
 {
@@ -49,6 +53,9 @@ public:
   void publishTrajectory(const autoware_planning_msgs::msg::Trajectory::ConstSharedPtr msg);
 
   void updateCurrentScenario();
+  bool isInParkingLot(
+    const boost::optional<lanelet::ConstLanelet> & nearest_lanelet,
+    const lanelet::Point3d & search_point);
   std::string selectScenarioByPosition();
   autoware_planning_msgs::msg::Trajectory::ConstSharedPtr getScenarioTrajectory(
     const std::string & scenario);
@@ -67,6 +74,7 @@ private:
   rclcpp::Subscription<autoware_planning_msgs::msg::Trajectory>::SharedPtr sub_parking_trajectory_;
   rclcpp::Publisher<autoware_planning_msgs::msg::Trajectory>::SharedPtr pub_trajectory_;
   rclcpp::Publisher<autoware_planning_msgs::msg::Scenario>::SharedPtr pub_scenario_;
+  autoware_utils::LatencyTracer latency_tracer_{this};
 
   autoware_planning_msgs::msg::Trajectory::ConstSharedPtr lane_driving_trajectory_;
   autoware_planning_msgs::msg::Trajectory::ConstSharedPtr parking_trajectory_;
@@ -81,6 +89,11 @@ private:
   std::shared_ptr<lanelet::routing::RoutingGraph> routing_graph_ptr_;
   std::shared_ptr<lanelet::traffic_rules::TrafficRules> traffic_rules_ptr_;
 
+  // extracted from the map once instead of on every scenario selection
+  lanelet::ConstPolygons3d parking_lots_;
+  std::unordered_map<lanelet::Id, boost::optional<lanelet::ConstPolygon3d>> linked_parking_lots_;
+  boost::optional<bool> is_goal_in_lane_;
+
   // Parameters
   double update_rate_;
   double th_max_message_delay_sec_;
@@ -37,31 +37,6 @@ void onData(const T & data, T * buffer)
   *buffer = data;
 }
 
-std::shared_ptr<lanelet::ConstPolygon3d> findNearestParkinglot(
-  const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr,
-  const lanelet::BasicPoint2d & search_point)
-{
-  std::vector<std::pair<double, lanelet::Lanelet>> nearest_lanelets =
-    lanelet::geometry::findNearest(lanelet_map_ptr->laneletLayer, search_point, 1);
-
-  if (nearest_lanelets.empty()) {
-    return {};
-  }
-
-  const auto nearest_lanelet = nearest_lanelets.front().second;
-  const auto all_parking_lots = lanelet::utils::query::getAllParkingLots(lanelet_map_ptr);
-
-  const auto linked_parking_lot = std::make_shared<lanelet::ConstPolygon3d>();
-  const auto result = lanelet::utils::query::getLinkedParkingLot(
-    nearest_lanelet, all_parking_lots, linked_parking_lot.get());
-
-  if (result) {
-    return linked_parking_lot;
-  } else {
-    return {};
-  }
-}
-
 geometry_msgs::msg::PoseStamped::ConstSharedPtr getCurrentPose(
   const tf2_ros::Buffer & tf_buffer, const rclcpp::Logger & logger)
 {
@@ -84,40 +59,34 @@ geometry_msgs::msg::PoseStamped::ConstSharedPtr getCurrentPose(
   return geometry_msgs::msg::PoseStamped::ConstSharedPtr(p);
 }
 
-bool isInLane(
-  const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr,
-  const geometry_msgs::msg::Pose & current_pose)
+lanelet::Point3d toLaneletPoint(const geometry_msgs::msg::Point & p)
 {
-  const auto & p = current_pose.position;
-  const lanelet::Point3d search_point(lanelet::InvalId, p.x, p.y, p.z);
+  return lanelet::Point3d(lanelet::InvalId, p.x, p.y, p.z);
+}
 
+boost::optional<lanelet::ConstLanelet> findNearestLanelet(
+  const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr,
+  const lanelet::Point3d & search_point)
+{
   std::vector<std::pair<double, lanelet::Lanelet>> nearest_lanelets =
     lanelet::geometry::findNearest(lanelet_map_ptr->laneletLayer, search_point.basicPoint2d(), 1);
 
   if (nearest_lanelets.empty()) {
-    return false;
+    return {};
   }
 
-  const auto nearest_lanelet = nearest_lanelets.front().second;
-
-  return lanelet::geometry::within(search_point, nearest_lanelet.polygon3d());
+  return lanelet::ConstLanelet(nearest_lanelets.front().second);
 }
 
-bool isInParkingLot(
-  const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr,
-  const geometry_msgs::msg::Pose & current_pose)
+bool isInLane(
+  const boost::optional<lanelet::ConstLanelet> & nearest_lanelet,
+  const lanelet::Point3d & search_point)
 {
-  const auto & p = current_pose.position;
-  const lanelet::Point3d search_point(lanelet::InvalId, p.x, p.y, p.z);
-
-  const auto nearest_parking_lot =
-    findNearestParkinglot(lanelet_map_ptr, search_point.basicPoint2d());
-
-  if (!nearest_parking_lot) {
+  if (!nearest_lanelet) {
     return false;
   }
 
-  return lanelet::geometry::within(search_point, nearest_parking_lot->basicPolygon());
+  return lanelet::geometry::within(search_point, nearest_lanelet->polygon3d());
 }
 
 bool isNearTrajectoryEnd(
@@ -163,11 +132,45 @@ autoware_planning_msgs::msg::Trajectory::ConstSharedPtr ScenarioSelectorNode::ge
   return lane_driving_trajectory_;
 }
 
+bool ScenarioSelectorNode::isInParkingLot(
+  const boost::optional<lanelet::ConstLanelet> & nearest_lanelet,
+  const lanelet::Point3d & search_point)
+{
+  if (!nearest_lanelet) {
+    return false;
+  }
+
+  // the parking lot linked to a lanelet is searched only the first time the ego is near it
+  auto linked_parking_lot = linked_parking_lots_.find(nearest_lanelet->id());
+  if (linked_parking_lot == linked_parking_lots_.end()) {
+    lanelet::ConstPolygon3d parking_lot;
+    boost::optional<lanelet::ConstPolygon3d> result;
+    if (lanelet::utils::query::getLinkedParkingLot(*nearest_lanelet, parking_lots_, &parking_lot)) {
+      result = parking_lot;
+    }
+    linked_parking_lot = linked_parking_lots_.emplace(nearest_lanelet->id(), result).first;
+  }
+
+  if (!linked_parking_lot->second) {
+    return false;
+  }
+
+  return lanelet::geometry::within(search_point, linked_parking_lot->second->basicPolygon());
+}
+
 std::string ScenarioSelectorNode::selectScenarioByPosition()
 {
-  const auto is_in_lane = isInLane(lanelet_map_ptr_, current_pose_->pose);
-  const auto is_goal_in_lane = isInLane(lanelet_map_ptr_, route_->goal_pose);
-  const auto is_in_parking_lot = isInParkingLot(lanelet_map_ptr_, current_pose_->pose);
+  const auto current_point = toLaneletPoint(current_pose_->pose.position);
+  const auto current_lanelet = findNearestLanelet(lanelet_map_ptr_, current_point);
+  const auto is_in_lane = isInLane(current_lanelet, current_point);
+  const auto is_in_parking_lot = isInParkingLot(current_lanelet, current_point);
+
+  // the goal doesn't move until the next route
+  if (!is_goal_in_lane_) {
+    const auto goal_point = toLaneletPoint(route_->goal_pose.position);
+    is_goal_in_lane_ = isInLane(findNearestLanelet(lanelet_map_ptr_, goal_point), goal_point);
+  }
+  const auto is_goal_in_lane = *is_goal_in_lane_;
 
   if (current_scenario_ == autoware_planning_msgs::msg::Scenario::EMPTY) {
     if (is_in_lane && is_goal_in_lane) {
@@ -222,11 +225,15 @@ void ScenarioSelectorNode::onMap(const autoware_lanelet2_msgs::msg::MapBin::Cons
   lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
   lanelet::utils::conversion::fromBinMsg(
     *msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
+  parking_lots_ = lanelet::utils::query::getAllParkingLots(lanelet_map_ptr_);
+  linked_parking_lots_.clear();
+  is_goal_in_lane_ = {};
 }
 
 void ScenarioSelectorNode::onRoute(const autoware_planning_msgs::msg::Route::ConstSharedPtr msg)
 {
   route_ = msg;
+  is_goal_in_lane_ = {};
   current_scenario_ = autoware_planning_msgs::msg::Scenario::EMPTY;
 }
 
@@ -301,10 +308,13 @@ void ScenarioSelectorNode::onParkingTrajectory(
 void ScenarioSelectorNode::publishTrajectory(
   const autoware_planning_msgs::msg::Trajectory::ConstSharedPtr msg)
 {
+  latency_tracer_.onReceive(msg->header.stamp);
+
   const auto now = this->now();
   const auto delay_sec = (now - msg->header.stamp).seconds();
   if (delay_sec <= th_max_message_delay_sec_) {
     pub_trajectory_->publish(*msg);
+    latency_tracer_.onPublish(msg->header.stamp);
   } else {
     RCLCPP_WARN_THROTTLE(
       this->get_logger(), *this->get_clock(), std::chrono::milliseconds(1000).count(),
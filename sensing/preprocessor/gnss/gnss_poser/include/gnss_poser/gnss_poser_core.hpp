@@ -23,6 +23,7 @@
 #include <geometry_msgs/msg/pose_stamped.hpp>
 #include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
 #include <sensor_msgs/msg/nav_sat_fix.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
 #include <ublox_msgs/msg/nav_pvt.hpp>
 
 #include <boost/circular_buffer.hpp>
@@ -61,7 +62,7 @@ private:
     const geometry_msgs::msg::TransformStamped::SharedPtr transform_stamped_ptr);
   bool getStaticTransform(
     const std::string & target_frame, const std::string & source_frame,
-    const geometry_msgs::msg::TransformStamped::SharedPtr transform_stamped_ptr,
+    geometry_msgs::msg::TransformStamped & transform_stamped,
     const builtin_interfaces::msg::Time & stamp);
   void publishTF(
     const std::string & frame_id, const std::string & child_frame_id,
@@ -70,6 +71,10 @@ private:
   tf2::BufferCore tf2_buffer_;
   tf2_ros::TransformListener tf2_listener_;
   tf2_ros::TransformBroadcaster tf2_broadcaster_;
+  rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr tf_static_sub_;
+  rclcpp::Time tf_static_update_time_;
+  // cached after the first lookup succeeded since the last /tf_static update
+  geometry_msgs::msg::TransformStamped::ConstSharedPtr tf_gnss_antenna2base_link_ptr_;
 
   rclcpp::Subscription<sensor_msgs::msg::NavSatFix>::SharedPtr nav_sat_fix_sub_;
   rclcpp::Subscription<ublox_msgs::msg::NavPVT>::SharedPtr nav_pvt_sub_;
@@ -14,6 +14,8 @@
 
 #include "gnss_poser/gnss_poser_core.hpp"
 
+#include <tf2_ros/qos.hpp>
+
 #include <algorithm>
 #include <memory>
 #include <string>
@@ -49,6 +51,15 @@ GNSSPoser::GNSSPoser(const rclcpp::NodeOptions & node_options)
     "gnss_pose_cov", rclcpp::QoS{1});
   fixed_pub_ =
     create_publisher<autoware_debug_msgs::msg::BoolStamped>("gnss_fixed", rclcpp::QoS{1});
+
+  // The static transforms can be updated while running, e.g. by calibration tools
+  tf_static_update_time_ = rclcpp::Time(0, 0, get_clock()->get_clock_type());
+  tf_static_sub_ = create_subscription<tf2_msgs::msg::TFMessage>(
+    "/tf_static", tf2_ros::StaticListenerQoS(),
+    [this](const tf2_msgs::msg::TFMessage::ConstSharedPtr) {
+      tf_gnss_antenna2base_link_ptr_ = nullptr;
+      tf_static_update_time_ = this->now();
+    });
 }
 
 void GNSSPoser::callbackNavSatFix(
@@ -104,11 +115,11 @@ void GNSSPoser::callbackNavSatFix(
   tf2::fromMsg(gnss_antenna_pose, tf_map2gnss_antenna);
 
   // get TF from base_link to gnss_antenna
-  auto tf_gnss_antenna2base_link_msg_ptr = std::make_shared<geometry_msgs::msg::TransformStamped>();
+  geometry_msgs::msg::TransformStamped tf_gnss_antenna2base_link_msg;
   getStaticTransform(
-    gnss_frame_, base_frame_, tf_gnss_antenna2base_link_msg_ptr, nav_sat_fix_msg_ptr->header.stamp);
+    gnss_frame_, base_frame_, tf_gnss_antenna2base_link_msg, nav_sat_fix_msg_ptr->header.stamp);
   tf2::Transform tf_gnss_antenna2base_link{};
-  tf2::fromMsg(tf_gnss_antenna2base_link_msg_ptr->transform, tf_gnss_antenna2base_link);
+  tf2::fromMsg(tf_gnss_antenna2base_link_msg.transform, tf_gnss_antenna2base_link);
 
   // transform pose from gnss_antenna(in map frame) to base_link(in map frame)
   tf2::Transform tf_map2base_link{};
@@ -283,25 +294,34 @@ bool GNSSPoser::getTransform(
 
 bool GNSSPoser::getStaticTransform(
   const std::string & target_frame, const std::string & source_frame,
-  const geometry_msgs::msg::TransformStamped::SharedPtr transform_stamped_ptr,
+  geometry_msgs::msg::TransformStamped & transform_stamped,
   const builtin_interfaces::msg::Time & stamp)
 {
   if (target_frame == source_frame) {
-    transform_stamped_ptr->header.stamp = stamp;
-    transform_stamped_ptr->header.frame_id = target_frame;
-    transform_stamped_ptr->child_frame_id = source_frame;
-    transform_stamped_ptr->transform.translation.x = 0.0;
-    transform_stamped_ptr->transform.translation.y = 0.0;
-    transform_stamped_ptr->transform.translation.z = 0.0;
-    transform_stamped_ptr->transform.rotation.x = 0.0;
-    transform_stamped_ptr->transform.rotation.y = 0.0;
-    transform_stamped_ptr->transform.rotation.z = 0.0;
-    transform_stamped_ptr->transform.rotation.w = 1.0;
+    transform_stamped.header.stamp = stamp;
+    transform_stamped.header.frame_id = target_frame;
+    transform_stamped.child_frame_id = source_frame;
+    transform_stamped.transform.translation.x = 0.0;
+    transform_stamped.transform.translation.y = 0.0;
+    transform_stamped.transform.translation.z = 0.0;
+    transform_stamped.transform.rotation.x = 0.0;
+    transform_stamped.transform.rotation.y = 0.0;
+    transform_stamped.transform.rotation.z = 0.0;
+    transform_stamped.transform.rotation.w = 1.0;
+    return true;
+  }
+
+  if (
+    tf_gnss_antenna2base_link_ptr_ &&
+    tf_gnss_antenna2base_link_ptr_->header.frame_id == target_frame &&
+    tf_gnss_antenna2base_link_ptr_->child_frame_id == source_frame) {
+    transform_stamped = *tf_gnss_antenna2base_link_ptr_;
+    transform_stamped.header.stamp = stamp;
     return true;
   }
 
   try {
-    *transform_stamped_ptr = tf2_buffer_.lookupTransform(
+    transform_stamped = tf2_buffer_.lookupTransform(
       target_frame, source_frame,
       tf2::TimePoint(std::chrono::seconds(stamp.sec) + std::chrono::nanoseconds(stamp.nanosec)));
   } catch (tf2::TransformException & ex) {
@@ -311,18 +331,25 @@ bool GNSSPoser::getStaticTransform(
       this->get_logger(), *this->get_clock(), std::chrono::milliseconds(1000).count(),
       "Please publish TF " << target_frame.c_str() << " to " << source_frame.c_str());
 
-    transform_stamped_ptr->header.stamp = stamp;
-    transform_stamped_ptr->header.frame_id = target_frame;
-    transform_stamped_ptr->child_frame_id = source_frame;
-    transform_stamped_ptr->transform.translation.x = 0.0;
-    transform_stamped_ptr->transform.translation.y = 0.0;
-    transform_stamped_ptr->transform.translation.z = 0.0;
-    transform_stamped_ptr->transform.rotation.x = 0.0;
-    transform_stamped_ptr->transform.rotation.y = 0.0;
-    transform_stamped_ptr->transform.rotation.z = 0.0;
-    transform_stamped_ptr->transform.rotation.w = 1.0;
+    transform_stamped.header.stamp = stamp;
+    transform_stamped.header.frame_id = target_frame;
+    transform_stamped.child_frame_id = source_frame;
+    transform_stamped.transform.translation.x = 0.0;
+    transform_stamped.transform.translation.y = 0.0;
+    transform_stamped.transform.translation.z = 0.0;
+    transform_stamped.transform.rotation.x = 0.0;
+    transform_stamped.transform.rotation.y = 0.0;
+    transform_stamped.transform.rotation.z = 0.0;
+    transform_stamped.transform.rotation.w = 1.0;
     return false;
   }
+
+  // The listener may not have applied the last /tf_static to the buffer yet right after it
+  constexpr double tf_static_settle_time = 1.0;
+  if ((this->now() - tf_static_update_time_).seconds() > tf_static_settle_time) {
+    tf_gnss_antenna2base_link_ptr_ =
+      std::make_shared<geometry_msgs::msg::TransformStamped>(transform_stamped);
+  }
   return true;
 }
 
@@ -15,6 +15,7 @@
 #ifndef IMAGE_TRANSPORT_DECOMPRESSOR__IMAGE_TRANSPORT_DECOMPRESSOR_HPP_
 #define IMAGE_TRANSPORT_DECOMPRESSOR__IMAGE_TRANSPORT_DECOMPRESSOR_HPP_
 
+#include <opencv2/core/core.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <sensor_msgs/msg/compressed_image.hpp>
@@ -38,6 +39,7 @@ private:
   rclcpp::Subscription<sensor_msgs::msg::CompressedImage>::SharedPtr compressed_image_sub_;
   rclcpp::Publisher<sensor_msgs::msg::Image>::SharedPtr raw_image_pub_;
   std::string encoding_;
+  cv::Mat decoded_image_;
 };
 
 }  // namespace image_preprocessor
@@ -53,13 +53,59 @@
 
 #include <sensor_msgs/image_encodings.hpp>
 
-#include <cv_bridge/cv_bridge.h>
-
-#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
-#include <vector>
+
+namespace
+{
+namespace enc = sensor_msgs::image_encodings;
+
+// conversion from the decoded colors to image_encoding, or -1 if they match already
+int getColorConversionCode(const std::string & image_encoding, const bool compressed_bgr_image)
+{
+  if (!enc::isColor(image_encoding)) {
+    return -1;
+  }
+  if (compressed_bgr_image) {
+    // if necessary convert colors from bgr to rgb
+    if (image_encoding == enc::RGB8 || image_encoding == enc::RGB16) {
+      return CV_BGR2RGB;
+    }
+    if (image_encoding == enc::RGBA8 || image_encoding == enc::RGBA16) {
+      return CV_BGR2RGBA;
+    }
+    if (image_encoding == enc::BGRA8 || image_encoding == enc::BGRA16) {
+      return CV_BGR2BGRA;
+    }
+  } else {
+    // if necessary convert colors from rgb to bgr
+    if (image_encoding == enc::BGR8 || image_encoding == enc::BGR16) {
+      return CV_RGB2BGR;
+    }
+    if (image_encoding == enc::BGRA8 || image_encoding == enc::BGRA16) {
+      return CV_RGB2BGRA;
+    }
+    if (image_encoding == enc::RGBA8 || image_encoding == enc::RGBA16) {
+      return CV_RGB2RGBA;
+    }
+  }
+  return -1;
+}
+
+int getConvertedChannels(const int color_conversion_code, const int channels)
+{
+  switch (color_conversion_code) {
+    case CV_BGR2RGBA:
+    case CV_BGR2BGRA:
+    case CV_RGB2BGRA:
+    case CV_RGB2RGBA:
+      return 4;
+    default:
+      return channels;
+  }
+}
+}  // namespace
 
 namespace image_preprocessor
 {
@@ -77,28 +123,30 @@ ImageTransportDecompressor::ImageTransportDecompressor(const rclcpp::NodeOptions
 void ImageTransportDecompressor::onCompressedImage(
   const sensor_msgs::msg::CompressedImage::ConstSharedPtr input_compressed_image_msg)
 {
-  cv_bridge::CvImagePtr cv_ptr(new cv_bridge::CvImage);
+  auto image_ptr = std::make_unique<sensor_msgs::msg::Image>();
   // Copy message header
-  cv_ptr->header = input_compressed_image_msg->header;
+  image_ptr->header = input_compressed_image_msg->header;
 
   // Decode color/mono image
+  int color_conversion_code = -1;
   try {
-    cv_ptr->image = cv::imdecode(cv::Mat(input_compressed_image_msg->data), cv::IMREAD_COLOR);
+    // the decode buffer is kept over the messages, which have the same size
+    cv::imdecode(cv::Mat(input_compressed_image_msg->data), cv::IMREAD_COLOR, &decoded_image_);
 
     // Assign image encoding string
     const size_t split_pos = input_compressed_image_msg->format.find(';');
     if (split_pos == std::string::npos) {
       // Older version of compressed_image_transport does not signal image format
-      switch (cv_ptr->image.channels()) {
+      switch (decoded_image_.channels()) {
         case 1:
-          cv_ptr->encoding = sensor_msgs::image_encodings::MONO8;
+          image_ptr->encoding = enc::MONO8;
           break;
         case 3:
-          cv_ptr->encoding = sensor_msgs::image_encodings::BGR8;
+          image_ptr->encoding = enc::BGR8;
           break;
         default:
           RCLCPP_ERROR(
-            get_logger(), "Unsupported number of channels: %i", cv_ptr->image.channels());
+            get_logger(), "Unsupported number of channels: %i", decoded_image_.channels());
           break;
       }
     } else {
@@ -113,67 +161,42 @@ void ImageTransportDecompressor::onCompressedImage(
         image_encoding = input_compressed_image_msg->format.substr(0, split_pos);
       }
 
-      cv_ptr->encoding = image_encoding;
-
-      if (sensor_msgs::image_encodings::isColor(image_encoding)) {
-        std::string compressed_encoding = input_compressed_image_msg->format.substr(split_pos);
-        bool compressed_bgr_image =
-          (compressed_encoding.find("compressed bgr") != std::string::npos);
-
-        // Revert color transformation
-        if (compressed_bgr_image) {
-          // if necessary convert colors from bgr to rgb
-          if (
-            (image_encoding == sensor_msgs::image_encodings::RGB8) ||
-            (image_encoding == sensor_msgs::image_encodings::RGB16)) {
-            cv::cvtColor(cv_ptr->image, cv_ptr->image, CV_BGR2RGB);
-          }
-
-          if (
-            (image_encoding == sensor_msgs::image_encodings::RGBA8) ||
-            (image_encoding == sensor_msgs::image_encodings::RGBA16)) {
-            cv::cvtColor(cv_ptr->image, cv_ptr->image, CV_BGR2RGBA);
-          }
-
-          if (
-            (image_encoding == sensor_msgs::image_encodings::BGRA8) ||
-            (image_encoding == sensor_msgs::image_encodings::BGRA16)) {
-            cv::cvtColor(cv_ptr->image, cv_ptr->image, CV_BGR2BGRA);
-          }
-        } else {
-          // if necessary convert colors from rgb to bgr
-          if (
-            (image_encoding == sensor_msgs::image_encodings::BGR8) ||
-            (image_encoding == sensor_msgs::image_encodings::BGR16)) {
-            cv::cvtColor(cv_ptr->image, cv_ptr->image, CV_RGB2BGR);
-          }
-
-          if (
-            (image_encoding == sensor_msgs::image_encodings::BGRA8) ||
-            (image_encoding == sensor_msgs::image_encodings::BGRA16)) {
-            cv::cvtColor(cv_ptr->image, cv_ptr->image, CV_RGB2BGRA);
-          }
-
-          if (
-            (image_encoding == sensor_msgs::image_encodings::RGBA8) ||
-            (image_encoding == sensor_msgs::image_encodings::RGBA16)) {
-            cv::cvtColor(cv_ptr->image, cv_ptr->image, CV_RGB2RGBA);
-          }
-        }
-      }
+      image_ptr->encoding = image_encoding;
+
+      const std::string compressed_encoding = input_compressed_image_msg->format.substr(split_pos);
+      const bool compressed_bgr_image =
+        (compressed_encoding.find("compressed bgr") != std::string::npos);
+      color_conversion_code = getColorConversionCode(image_encoding, compressed_bgr_image);
+    }
+
+    const int rows = decoded_image_.rows;
+    const int cols = decoded_image_.cols;
+    if ((rows <= 0) || (cols <= 0)) {
+      return;
+    }
+
+    // Write the image into the message directly instead of converting it by cv_bridge
+    const int type = CV_MAKETYPE(
+      decoded_image_.depth(),
+      getConvertedChannels(color_conversion_code, decoded_image_.channels()));
+    image_ptr->height = rows;
+    image_ptr->width = cols;
+    image_ptr->is_bigendian = false;
+    image_ptr->step = cols * CV_ELEM_SIZE(type);
+    image_ptr->data.resize(image_ptr->step * rows);
+    cv::Mat image(rows, cols, type, image_ptr->data.data(), image_ptr->step);
+    if (color_conversion_code < 0) {
+      decoded_image_.copyTo(image);
+    } else {
+      cv::cvtColor(decoded_image_, image, color_conversion_code);
     }
   } catch (cv::Exception & e) {
     RCLCPP_ERROR(get_logger(), "%s", e.what());
+    return;
   }
 
-  size_t rows = cv_ptr->image.rows;
-  size_t cols = cv_ptr->image.cols;
-
-  if ((rows > 0) && (cols > 0)) {
-    // Publish message to user callback
-    auto image_ptr = std::make_unique<sensor_msgs::msg::Image>(*cv_ptr->toImageMsg());
-    raw_image_pub_->publish(std::move(image_ptr));
-  }
+  // Publish message to user callback
+  raw_image_pub_->publish(std::move(image_ptr));
 }
 }  // namespace image_preprocessor
 
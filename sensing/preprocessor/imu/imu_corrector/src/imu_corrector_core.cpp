@@ -14,6 +14,9 @@
 
 #include "imu_corrector/imu_corrector_core.hpp"
 
+#include <memory>
+#include <utility>
+
 namespace imu_corrector
 {
 ImuCorrector::ImuCorrector(const rclcpp::NodeOptions & node_options)
@@ -31,15 +34,15 @@ ImuCorrector::ImuCorrector(const rclcpp::NodeOptions & node_options)
 
 void ImuCorrector::callbackImu(const sensor_msgs::msg::Imu::ConstSharedPtr imu_msg_ptr)
 {
-  sensor_msgs::msg::Imu imu_msg;
-  imu_msg = *imu_msg_ptr;
+  // Publishes the only copy by unique_ptr to pass it without another copy in a container
+  auto imu_msg = std::make_unique<sensor_msgs::msg::Imu>(*imu_msg_ptr);
 
-  imu_msg.angular_velocity.z += angular_velocity_offset_z_;
+  imu_msg->angular_velocity.z += angular_velocity_offset_z_;
 
-  imu_msg.angular_velocity_covariance[8] =
+  imu_msg->angular_velocity_covariance[8] =
     angular_velocity_stddev_zz_ * angular_velocity_stddev_zz_;
 
-  imu_pub_->publish(imu_msg);
+  imu_pub_->publish(std::move(imu_msg));
 }
 
 }  // namespace imu_corrector
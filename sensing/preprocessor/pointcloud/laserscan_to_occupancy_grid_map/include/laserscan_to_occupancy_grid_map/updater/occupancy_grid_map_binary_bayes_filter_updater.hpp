@@ -22,6 +22,8 @@
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Geometry>
 
+#include <vector>
+
 namespace costmap_2d
 {
 class OccupancyGridMapBBFUpdater : public OccupancyGridMapUpdaterInterface
@@ -29,20 +31,14 @@ class OccupancyGridMapBBFUpdater : public OccupancyGridMapUpdaterInterface
 public:
   enum Index : size_t { OCCUPIED = 0U, FREE = 1U };
   OccupancyGridMapBBFUpdater(
-    const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution)
-  : OccupancyGridMapUpdaterInterface(cells_size_x, cells_size_y, resolution)
-  {
-    probability_matrix_(Index::OCCUPIED, Index::OCCUPIED) = 0.95;
-    probability_matrix_(Index::FREE, Index::OCCUPIED) =
-      1.0 - probability_matrix_(OCCUPIED, OCCUPIED);
-    probability_matrix_(Index::FREE, Index::FREE) = 0.8;
-    probability_matrix_(Index::OCCUPIED, Index::FREE) = 1.0 - probability_matrix_(FREE, FREE);
-  }
+    const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution);
   bool update(const Costmap2D & oneshot_occupancy_grid_map) override;
 
 private:
   inline unsigned char applyBBF(const unsigned char & z, const unsigned char & o);
   Eigen::Matrix2f probability_matrix_;
+  // updated cost of each pair of the oneshot cost and the current cost, indexed by z * 256 + o
+  std::vector<unsigned char> bbf_table_;
 };
 
 }  // namespace costmap_2d
@@ -56,6 +56,7 @@
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 
 #include <algorithm>
+#include <vector>
 
 namespace costmap_2d
 {
@@ -200,6 +201,10 @@ void OccupancyGridMap::raytraceFreespace(const PointCloud2 & pointcloud, const P
   const double map_end_x = origin_x + size_x_ * resolution_;
   const double map_end_y = origin_y + size_y_ * resolution_;
 
+  // The rays from the same origin to the same end cell mark the same cells, and the points of the
+  // laserscan share few end cells at long range and on the map border. Trace each end cell once.
+  std::vector<unsigned int> end_indices;
+  end_indices.reserve(pointcloud.width * pointcloud.height);
   for (PointCloud2ConstIterator<float> iter_x(pointcloud, "x"), iter_y(pointcloud, "y");
        iter_x != iter_x.end(); ++iter_x, ++iter_y) {
     double wx = *iter_x;
@@ -243,8 +248,17 @@ void OccupancyGridMap::raytraceFreespace(const PointCloud2 & pointcloud, const P
       continue;
     }
 
-    constexpr unsigned int cell_raytrace_range = 10000;  // large number to ignore range threshold
-    MarkCell marker(costmap_, occupancy_cost_value::FREE_SPACE);
+    end_indices.push_back(getIndex(x1, y1));
+  }
+  std::sort(end_indices.begin(), end_indices.end());
+  end_indices.erase(std::unique(end_indices.begin(), end_indices.end()), end_indices.end());
+
+  constexpr unsigned int cell_raytrace_range = 10000;  // large number to ignore range threshold
+  MarkCell marker(costmap_, occupancy_cost_value::FREE_SPACE);
+  for (const auto index : end_indices) {
+    unsigned int x1{};
+    unsigned int y1{};
+    indexToCells(index, x1, y1);
     raytraceLine(marker, x0, y0, x1, y1, cell_raytrace_range);
   }
 }
@@ -45,14 +45,34 @@ inline unsigned char OccupancyGridMapBBFUpdater::applyBBF(
     static_cast<unsigned char>(254));
 }
 
+OccupancyGridMapBBFUpdater::OccupancyGridMapBBFUpdater(
+  const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution)
+: OccupancyGridMapUpdaterInterface(cells_size_x, cells_size_y, resolution)
+{
+  probability_matrix_(Index::OCCUPIED, Index::OCCUPIED) = 0.95;
+  probability_matrix_(Index::FREE, Index::OCCUPIED) = 1.0 - probability_matrix_(OCCUPIED, OCCUPIED);
+  probability_matrix_(Index::FREE, Index::FREE) = 0.8;
+  probability_matrix_(Index::OCCUPIED, Index::FREE) = 1.0 - probability_matrix_(FREE, FREE);
+
+  // the filter only depends on the two costs, so it is tabulated once for the whole grid
+  bbf_table_.resize(256 * 256);
+  for (unsigned int z = 0; z < 256; ++z) {
+    for (unsigned int o = 0; o < 256; ++o) {
+      bbf_table_[z * 256 + o] =
+        applyBBF(static_cast<unsigned char>(z), static_cast<unsigned char>(o));
+    }
+  }
+}
+
 bool OccupancyGridMapBBFUpdater::update(const Costmap2D & oneshot_occupancy_grid_map)
 {
   updateOrigin(oneshot_occupancy_grid_map.getOriginX(), oneshot_occupancy_grid_map.getOriginY());
-  for (unsigned int x = 0; x < getSizeInCellsX(); x++) {
-    for (unsigned int y = 0; y < getSizeInCellsY(); y++) {
-      unsigned int index = getIndex(x, y);
-      costmap_[index] = applyBBF(oneshot_occupancy_grid_map.getCost(x, y), costmap_[index]);
-    }
+  // both maps have the same size, so the cells are visited in memory order
+  const unsigned char * oneshot_costmap = oneshot_occupancy_grid_map.getCharMap();
+  const unsigned char * table = bbf_table_.data();
+  const unsigned int num_cells = getSizeInCellsX() * getSizeInCellsY();
+  for (unsigned int index = 0; index < num_cells; ++index) {
+    costmap_[index] = table[oneshot_costmap[index] * 256U + costmap_[index]];
   }
   return true;
 }
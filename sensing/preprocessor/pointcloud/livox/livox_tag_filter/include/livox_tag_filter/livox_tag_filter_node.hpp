@@ -19,6 +19,7 @@
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -32,11 +33,12 @@ public:
 private:
   // Parameter
   std::vector<std::int64_t> ignore_tags_;
+  std::array<bool, 256> is_ignored_tag_;  // indexed by the tag byte
 
   // Subscriber
   rclcpp::Subscription<sensor_msgs::msg::PointCloud2>::SharedPtr sub_pointcloud_;
 
-  void onPointCloud(const sensor_msgs::msg::PointCloud2::ConstSharedPtr msg);
+  void onPointCloud(sensor_msgs::msg::PointCloud2::UniquePtr msg);
 
   // Publisher
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr pub_pointcloud_;
@@ -14,26 +14,12 @@
 
 #include "livox_tag_filter/livox_tag_filter_node.hpp"
 
-#include <pcl_conversions/pcl_conversions.h>
-
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include <vector>
 
-struct LivoxPoint
-{
-  float x;
-  float y;
-  float z;
-  float intensity;
-  std::uint8_t tag;
-  std::uint8_t line;
-} EIGEN_ALIGN16;
-
-POINT_CLOUD_REGISTER_POINT_STRUCT(
-  LivoxPoint, (float, x, x)(float, y, y)(float, z, z)(float, intensity, intensity)(
-                std::uint8_t, tag, tag)(std::uint8_t, line, line))
-
 namespace livox_tag_filter
 {
 LivoxTagFilterNode::LivoxTagFilterNode(const rclcpp::NodeOptions & node_options)
@@ -42,6 +28,14 @@ LivoxTagFilterNode::LivoxTagFilterNode(const rclcpp::NodeOptions & node_options)
   // Parameter
   ignore_tags_ = this->declare_parameter("ignore_tags", std::vector<std::int64_t>{});
 
+  // a tag out of the range of a byte can't be ignored
+  is_ignored_tag_.fill(false);
+  for (const auto & ignore_tag : ignore_tags_) {
+    if (0 <= ignore_tag && ignore_tag < static_cast<std::int64_t>(is_ignored_tag_.size())) {
+      is_ignored_tag_.at(ignore_tag) = true;
+    }
+  }
+
   // Subscriber
   using std::placeholders::_1;
   sub_pointcloud_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
@@ -52,36 +46,51 @@ LivoxTagFilterNode::LivoxTagFilterNode(const rclcpp::NodeOptions & node_options)
     this->create_publisher<sensor_msgs::msg::PointCloud2>("output", rclcpp::SensorDataQoS());
 }
 
-void LivoxTagFilterNode::onPointCloud(const sensor_msgs::msg::PointCloud2::ConstSharedPtr msg)
+void LivoxTagFilterNode::onPointCloud(sensor_msgs::msg::PointCloud2::UniquePtr msg)
 {
-  pcl::PointCloud<LivoxPoint> points;
-  pcl::fromROSMsg(*msg, points);
+  const auto tag_field = std::find_if(
+    msg->fields.cbegin(), msg->fields.cend(),
+    [](const sensor_msgs::msg::PointField & field) { return field.name == "tag"; });
+  using sensor_msgs::msg::PointField;
+  const bool has_tag_byte =
+    tag_field != msg->fields.cend() &&
+    (tag_field->datatype == PointField::UINT8 || tag_field->datatype == PointField::INT8);
+  if (!has_tag_byte) {
+    RCLCPP_ERROR_THROTTLE(
+      this->get_logger(), *this->get_clock(), 5000 /* ms */,
+      "input pointcloud doesn't have a tag field of a byte");
+    return;
+  }
 
-  const auto isIgnored = [&](const LivoxPoint & p) {
-    for (const auto & ignore_tag : ignore_tags_) {
-      if (p.tag == ignore_tag) {
-        return true;
+  // Remove the ignored points by moving the others to the front of the data, with all their
+  // fields, in one pass over the rows
+  const size_t point_step = msg->point_step;
+  const size_t tag_offset = tag_field->offset;
+  std::uint8_t * const data = msg->data.data();
+  size_t num_points = 0;
+  for (size_t row = 0; row < msg->height; ++row) {
+    const std::uint8_t * point = data + row * msg->row_step;
+    for (size_t col = 0; col < msg->width; ++col, point += point_step) {
+      if (is_ignored_tag_[point[tag_offset]]) {
+        continue;
       }
-    }
 
-    return false;
-  };
-
-  pcl::PointCloud<LivoxPoint> tag_filtered_points;
-  for (const auto & p : points) {
-    if (isIgnored(p)) {
-      continue;
+      std::uint8_t * const dst = data + num_points * point_step;
+      if (dst != point) {
+        std::memmove(dst, point, point_step);
+      }
+      ++num_points;
     }
-
-    tag_filtered_points.push_back(p);
   }
 
-  // Publish ROS message
-  auto tag_filtered_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-  pcl::toROSMsg(tag_filtered_points, *tag_filtered_msg_ptr);
-  tag_filtered_msg_ptr->header = msg->header;
+  // the filtered points are unorganized
+  msg->data.resize(num_points * point_step);
+  msg->height = 1;
+  msg->width = static_cast<std::uint32_t>(num_points);
+  msg->row_step = static_cast<std::uint32_t>(num_points * point_step);
 
-  pub_pointcloud_->publish(std::move(tag_filtered_msg_ptr));
+  // Publish ROS message
+  pub_pointcloud_->publish(std::move(msg));
 }
 
 }  // namespace livox_tag_filter
@@ -18,7 +18,6 @@
 #include "pointcloud_preprocessor/filter.hpp"
 
 #include <grid_map_core/GridMap.hpp>
-#include <grid_map_cv/grid_map_cv.hpp>
 #include <grid_map_pcl/GridMapPclLoader.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -41,9 +40,31 @@ private:
   rclcpp::Subscription<grid_map_msgs::msg::GridMap>::SharedPtr sub_map_;
 
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr pub_filtered_cloud_;
-  grid_map::GridMap elevation_map_;
-  cv::Mat elevation_image_;
-  grid_map::Matrix elevation_map_data_;
+
+  /**
+   * @brief Elevation layer copied out of the circular buffer of grid_map, with the cells ordered
+   * by increasing x and then increasing y so that a position maps to a cell by one multiplication.
+   */
+  struct ElevationRaster
+  {
+    std::vector<float> values;
+    std::string frame_id;
+    float min_x = 0.0f;
+    float min_y = 0.0f;
+    float inv_resolution = 0.0f;
+    int size_x = 0;
+    int size_y = 0;
+
+    float at(const int cell_x, const int cell_y) const { return values[cell_y * size_x + cell_x]; }
+    /**
+     * @brief same as grid_map::GridMap::atPosition with INTER_LINEAR, which uses the nearest cell
+     * where the four cells around the position are not all inside the map
+     * @return false outside the map
+     */
+    bool interpolate(const float x, const float y, float & value) const;
+  };
+
+  ElevationRaster elevation_raster_;
   std::string layer_name_;
   std::string map_frame_;
   double height_diff_thresh_;
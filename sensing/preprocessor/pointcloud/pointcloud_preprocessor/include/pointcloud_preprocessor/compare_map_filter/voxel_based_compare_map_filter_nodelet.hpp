@@ -17,9 +17,12 @@
 
 #include "pointcloud_preprocessor/filter.hpp"
 
+#include <tier4_pcl_extensions/tiled_voxel_map.hpp>
+
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/search/pcl_search.h>
 
+#include <string>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -44,6 +47,18 @@ private:
   pcl::VoxelGrid<pcl::PointXYZ> voxel_grid_;
   bool set_map_in_voxel_grid_;
 
+  /** \brief Set to true to query a tiled voxel map index instead of pcl::VoxelGrid. */
+  bool use_tiled_map_index_;
+  /** \brief Index file shared with other processes. Empty to keep the index in memory only. */
+  std::string map_index_file_;
+  double map_tile_size_;
+  pcl::TiledVoxelMap tiled_map_;
+
+  /** \brief Load the index from map_index_file_ if it matches distance_threshold_. */
+  bool loadTiledMap();
+  /** \brief Load the index from map_index_file_ or build it from map and save it. */
+  void setupTiledMap(const pcl::PointCloud<pcl::PointXYZ> & map);
+
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
 
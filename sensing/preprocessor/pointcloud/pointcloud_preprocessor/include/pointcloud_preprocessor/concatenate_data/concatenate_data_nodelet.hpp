@@ -69,6 +69,8 @@
 #include <geometry_msgs/msg/twist_stamped.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
+#include <Eigen/Core>
+
 #include <message_filters/pass_through.h>
 #include <message_filters/subscriber.h>
 #include <message_filters/sync_policies/approximate_time.h>
@@ -142,10 +144,18 @@ private:
   std::vector<double> input_offset_;
   std::map<std::string, double> offset_map_;
 
+  /** \brief Set to true to concatenate all inputs into one preallocated output in a single
+   * pass instead of pairwise transform-and-concatenate. */
+  bool use_single_pass_concatenation_ = false;
+
   void transformPointCloud(const PointCloud2::ConstSharedPtr & in, PointCloud2::SharedPtr & out);
   void combineClouds(
     const PointCloud2::ConstSharedPtr & in1, const PointCloud2::ConstSharedPtr & in2,
     PointCloud2::SharedPtr & out);
+  Eigen::Matrix4f computeTransformToAdjustForOldTimestamp(
+    const rclcpp::Time & old_stamp, const rclcpp::Time & new_stamp);
+  bool lookupTransformToOutputFrame(const PointCloud2 & cloud, Eigen::Matrix4f & transform);
+  PointCloud2::UniquePtr concatenateCloudsSinglePass();
   void publish();
 
   void removeRADTFields(
@@ -55,10 +55,15 @@
 
 #include "pointcloud_preprocessor/filter.hpp"
 
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+#include "pointcloud_preprocessor/cuda/cuda_filters.hpp"
+#endif
+
 #include <geometry_msgs/msg/polygon_stamped.hpp>
 
 #include <pcl/filters/crop_box.h>
 
+#include <memory>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -71,11 +76,24 @@ protected:
 
   void publishCropBoxPolygon();
 
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+  /** \brief Run the crop box on the GPU. Returns false if the input is not supported. */
+  bool filterOnGpu(const PointCloud2ConstPtr & input, PointCloud2 & output);
+#endif
+
 private:
   /** \brief The PCL filter implementation used. */
   pcl::CropBox<pcl::PCLPointCloud2> impl_;
   rclcpp::Publisher<geometry_msgs::msg::PolygonStamped>::SharedPtr crop_box_polygon_pub_;
 
+  /** \brief Set to true to run the filter on the GPU when the package is built with CUDA. */
+  bool use_gpu_;
+
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+  std::unique_ptr<cuda::CropBoxFilterCuda> gpu_impl_;
+  std::vector<uint8_t> gpu_output_buffer_;
+#endif
+
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
 
@@ -0,0 +1,110 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__CUDA__CUDA_FILTERS_HPP_
+#define POINTCLOUD_PREPROCESSOR__CUDA__CUDA_FILTERS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// This header does not depend on CUDA so that it can be included from regular translation
+// units. The implementations are only built when CUDA is found (POINTCLOUD_PREPROCESSOR_USE_CUDA).
+
+namespace pointcloud_preprocessor
+{
+namespace cuda
+{
+/** \brief Byte offsets of the float32 x/y/z fields in a point. */
+struct XYZOffsets
+{
+  uint32_t x;
+  uint32_t y;
+  uint32_t z;
+};
+
+/** \brief Look up the float32 x/y/z offsets of a sensor_msgs PointCloud2 like message.
+ * \return false if any of the fields is missing or not float32
+ */
+template <typename PointCloud2T>
+bool getXYZOffsets(const PointCloud2T & cloud, XYZOffsets & offsets)
+{
+  using PointFieldT = typename decltype(cloud.fields)::value_type;
+  int found = 0;
+  for (const auto & field : cloud.fields) {
+    if (field.datatype != PointFieldT::FLOAT32) {
+      continue;
+    }
+    if (field.name == "x") {
+      offsets.x = field.offset;
+      found |= 1;
+    } else if (field.name == "y") {
+      offsets.y = field.offset;
+      found |= 2;
+    } else if (field.name == "z") {
+      offsets.z = field.offset;
+      found |= 4;
+    }
+  }
+  return found == 7;
+}
+
+/** \brief Crop box filter running on the GPU. Device buffers are kept across calls. */
+class CropBoxFilterCuda
+{
+public:
+  CropBoxFilterCuda();
+  ~CropBoxFilterCuda();
+
+  void setBox(const float min[3], const float max[3], const bool negative);
+
+  /** \brief Filter packed points (point_step bytes each) and copy the kept points, with all
+   * their fields and in input order, into output. Non-finite points are removed.
+   * \return the number of kept points
+   */
+  size_t filter(
+    const uint8_t * points, const size_t num_points, const uint32_t point_step,
+    const XYZOffsets & offsets, std::vector<uint8_t> & output);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/** \brief Voxel grid downsampler running on the GPU. Device buffers are kept across calls. */
+class VoxelGridDownsampleCuda
+{
+public:
+  VoxelGridDownsampleCuda();
+  ~VoxelGridDownsampleCuda();
+
+  void setLeafSize(const float lx, const float ly, const float lz);
+
+  /** \brief Compute the centroid of each voxel. output holds x, y, z of each centroid
+   * back to back. Non-finite points are skipped.
+   * \return the number of centroids
+   */
+  size_t filter(
+    const uint8_t * points, const size_t num_points, const uint32_t point_step,
+    const XYZOffsets & offsets, std::vector<float> & output);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace cuda
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__CUDA__CUDA_FILTERS_HPP_
@@ -28,6 +28,7 @@
 
 #include <deque>
 #include <string>
+#include <vector>
 
 namespace pointcloud_preprocessor
 {
@@ -51,6 +52,12 @@ private:
     const std::deque<TwistStamped> & twist_queue, const tf2::Transform & tf2_base_link_to_sensor,
     PointCloud2 & points);
 
+  /** \brief Undistort with one rigid transform per time slice. Returns false without modifying
+   * the points if the time stamps are not monotonic. */
+  bool undistortPointCloudByTimeSlice(
+    const std::deque<TwistStamped> & twist_queue, const tf2::Transform & tf2_base_link_to_sensor,
+    PointCloud2 & points);
+
   rclcpp::Subscription<PointCloud2>::SharedPtr input_points_sub_;
   rclcpp::Subscription<TwistStamped>::SharedPtr twist_sub_;
   rclcpp::Publisher<PointCloud2>::SharedPtr undistorted_points_pub_;
@@ -62,6 +69,13 @@ private:
 
   std::string base_link_frame_ = "base_link";
   std::string time_stamp_field_name_;
+  double time_slice_sec_;
+
+  // point buffers (structure of arrays) reused across frames by the time slice path
+  std::vector<float> x_buf_;
+  std::vector<float> y_buf_;
+  std::vector<float> z_buf_;
+  std::vector<double> time_stamp_buf_;
 };
 
 }  // namespace pointcloud_preprocessor
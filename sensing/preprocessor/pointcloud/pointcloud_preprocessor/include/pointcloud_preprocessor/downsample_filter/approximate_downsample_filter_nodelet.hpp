@@ -76,6 +76,9 @@ private:
   double voxel_size_y_;
   double voxel_size_z_;
 
+  /** \brief Nearest centroid voxel grid, kept to reuse its leaves across frames. */
+  pcl::VoxelGridNearestCentroid<pcl::PointXYZ> voxel_filter_;
+
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
   explicit ApproximateDownsampleFilterComponent(const rclcpp::NodeOptions & options);
@@ -53,9 +53,16 @@
 
 #include "pointcloud_preprocessor/filter.hpp"
 
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+#include "pointcloud_preprocessor/cuda/cuda_filters.hpp"
+#endif
+
+#include <tier4_pcl_extensions/voxel_grid_hash_map.hpp>
+
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/search/pcl_search.h>
 
+#include <memory>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -71,6 +78,23 @@ private:
   double voxel_size_y_;
   double voxel_size_z_;
 
+  /** \brief Set to true to use the hash map based voxel grid instead of pcl::VoxelGrid. */
+  bool use_hash_map_;
+
+  /** \brief Hash map based voxel grid, kept to reuse its capacity across frames. */
+  pcl::VoxelGridHashMap<pcl::PointXYZ> hash_map_filter_;
+
+  /** \brief Set to true to run the filter on the GPU when the package is built with CUDA. */
+  bool use_gpu_;
+
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+  std::unique_ptr<cuda::VoxelGridDownsampleCuda> gpu_impl_;
+  std::vector<float> gpu_output_buffer_;
+
+  /** \brief Run the voxel grid on the GPU. Returns false if the input is not supported. */
+  bool filterOnGpu(const PointCloud2ConstPtr & input, PointCloud2 & output);
+#endif
+
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
 
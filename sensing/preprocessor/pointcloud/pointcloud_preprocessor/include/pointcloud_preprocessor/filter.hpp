@@ -52,13 +52,23 @@
 #ifndef POINTCLOUD_PREPROCESSOR__FILTER_HPP_
 #define POINTCLOUD_PREPROCESSOR__FILTER_HPP_
 
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <autoware_utils/ros/debug_publisher.hpp>
+#include <autoware_utils/system/stop_watch.hpp>
+#include <diagnostic_updater/diagnostic_updater.hpp>
+
 // PCL includes
 #include <boost/thread/mutex.hpp>
 
+#include <Eigen/Core>
+
 #include <pcl/filters/filter.h>
 #include <sensor_msgs/msg/point_cloud2.h>
 // PCL includes
@@ -221,6 +231,29 @@ protected:
   std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
   std::shared_ptr<tf2_ros::TransformListener> tf_listener_;
 
+  /** \brief Set to true if the input and output frames are only connected by static transforms,
+   * e.g. between the sensors and base_link. Each transform is then looked up once instead of for
+   * every cloud (false by default). */
+  bool has_static_tf_only_ = false;
+
+  /** \brief Transforms looked up when has_static_tf_only_, by the target and source frames. */
+  using FramePair = std::pair<std::string, std::string>;
+  std::map<
+    FramePair, Eigen::Matrix4f, std::less<FramePair>,
+    Eigen::aligned_allocator<std::pair<const FramePair, Eigen::Matrix4f>>>
+    static_transforms_;
+
+  /** \brief Transform a cloud into the target frame, with the cached transform if
+   * has_static_tf_only_.
+   * \return false if the transform is not available
+   */
+  bool transformPointCloud(
+    const std::string & target_frame, const PointCloud2 & input, PointCloud2 & output);
+
+  /** \brief Diagnostics of the node, which has the latency and drop status of the filter. Child
+   * filters add their own tasks to it. */
+  diagnostic_updater::Updater updater_{this};
+
   inline bool isValid(
     const PointCloud2ConstPtr & cloud, const std::string & /*topic_name*/ = "input")
   {
@@ -265,6 +298,28 @@ private:
 
   void setupTF();
 
+  /** \brief Latency and drop accounting of every filter, from receiving the input to publishing
+   * the output. The latest values are published on ~/debug, and the counts and maximums since the
+   * last report as diagnostics. */
+  struct FilterStatistics
+  {
+    size_t received = 0;
+    size_t published = 0;
+    size_t lost = 0;
+    double max_latency_ms = 0.0;
+    double max_processing_time_ms = 0.0;
+  };
+
+  std::mutex statistics_mutex_;
+  FilterStatistics statistics_;
+  bool is_message_lost_supported_ = false;
+  autoware_utils::StopWatch<std::chrono::milliseconds> stop_watch_;
+  autoware_utils::DebugPublisher debug_publisher_{this, "~/debug"};
+
+  void onMessageLost(const rclcpp::QOSMessageLostInfo & info);
+  void recordPublished(const builtin_interfaces::msg::Time & input_stamp);
+  void checkFilterStatus(diagnostic_updater::DiagnosticStatusWrapper & stat);
+
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
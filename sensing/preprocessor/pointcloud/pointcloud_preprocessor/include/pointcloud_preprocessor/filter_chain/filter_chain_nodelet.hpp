@@ -0,0 +1,72 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__FILTER_CHAIN__FILTER_CHAIN_NODELET_HPP_
+#define POINTCLOUD_PREPROCESSOR__FILTER_CHAIN__FILTER_CHAIN_NODELET_HPP_
+
+#include "pointcloud_preprocessor/filter.hpp"
+#include "pointcloud_preprocessor/outlier_filter/ring_outlier_filter_nodelet.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+using PointCloudXYZIRADT = pcl::PointCloud<custom_pcl::PointXYZIRADT>;
+
+/** \brief @b FilterChainStage is one step of a FilterChainComponent. It modifies the shared
+ * point buffer in place, so no PointCloud2 conversion happens between stages.
+ */
+class FilterChainStage
+{
+public:
+  virtual ~FilterChainStage() = default;
+
+  /** \brief Filter the shared point buffer in place. */
+  virtual void apply(PointCloudXYZIRADT & cloud) = 0;
+};
+
+/** \brief @b FilterChainComponent runs an ordered list of filters on one in-memory point buffer.
+ * The input is converted once and only the final result (and optional taps) is serialized.
+ */
+class FilterChainComponent : public pointcloud_preprocessor::Filter
+{
+protected:
+  virtual void filter(
+    const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output);
+
+private:
+  /** \brief Ordered list of stage names. */
+  std::vector<std::string> stage_names_;
+
+  /** \brief Stages, in the same order as stage_names_. */
+  std::vector<std::unique_ptr<FilterChainStage>> stages_;
+
+  /** \brief Publishers of intermediate results, keyed by stage index. */
+  std::map<size_t, rclcpp::Publisher<PointCloud2>::SharedPtr> tap_pubs_;
+
+  /** \brief The shared point buffer, kept to reuse its capacity across frames. */
+  PointCloudXYZIRADT cloud_;
+
+  std::unique_ptr<FilterChainStage> createStage(const std::string & name);
+
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  explicit FilterChainComponent(const rclcpp::NodeOptions & options);
+};
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__FILTER_CHAIN__FILTER_CHAIN_NODELET_HPP_
@@ -73,6 +73,13 @@ private:
   double voxel_size_z_ = 0.1;
   bool debug_ = false;
   bool is_initialized_debug_message_ = false;
+  bool use_patch_mode_ = false;
+  std::vector<double> patch_zone_boundaries_;  // [m] radii of the zones from the inner one
+  std::vector<int64_t> patch_num_sectors_;     // number of sectors of each zone
+  int patch_max_iterations_ = 50;
+  int patch_min_points_ = 20;
+  double patch_max_elevation_ = 0.5;  // [m] patches whose centroid is higher are not ground
+  int num_threads_ = 1;
   Eigen::Vector3d unit_vec_ = Eigen::Vector3d::UnitZ();
 
   /*!
@@ -103,6 +110,21 @@ private:
   Eigen::Affine3d getPlaneAffine(
     const pcl::PointCloud<PointType> segment_ground_cloud, const Eigen::Vector3d & plane_normal);
 
+  /*!
+   * Remove the points near the plane fitted to the whole input
+   * @retval false no ground plane is found
+   */
+  bool filterByGlobalPlane(
+    const pcl::PointCloud<PointType>::Ptr & input, pcl::PointCloud<PointType> & no_ground_cloud,
+    pcl::PointCloud<PointType> & ground_cloud, geometry_msgs::msg::PoseArray & debug_pose_array);
+
+  /*!
+   * Remove the points near the planes fitted to each patch of the zones and sectors in parallel
+   */
+  void filterByPatches(
+    const pcl::PointCloud<PointType> & input, pcl::PointCloud<PointType> & no_ground_cloud,
+    pcl::PointCloud<PointType> & ground_cloud, geometry_msgs::msg::PoseArray & debug_pose_array);
+
   void applyRANSAC(
     const pcl::PointCloud<PointType>::Ptr & input, pcl::PointIndices::Ptr & output_inliers,
     pcl::ModelCoefficients::Ptr & output_coefficients);
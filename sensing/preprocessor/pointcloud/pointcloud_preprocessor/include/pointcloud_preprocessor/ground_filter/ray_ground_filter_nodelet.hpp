@@ -60,7 +60,6 @@
 // #include <pcl_ros/point_cloud.h>
 
 #include "pointcloud_preprocessor/filter.hpp"
-#include "pointcloud_preprocessor/ground_filter/gencolors.hpp"
 
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
@@ -91,10 +90,6 @@ class RayGroundFilterComponent : public pointcloud_preprocessor::Filter
 
     size_t radial_div;  // index of the radial division to which this point belongs to
 
-    size_t red;    // Red component  [0-255]
-    size_t green;  // Green Component[0-255]
-    size_t blue;   // Blue component [0-255]
-
     size_t original_index;  // index of this point in the source pointcloud
   };
   typedef std::vector<PointXYZRTColor> PointCloudXYZRTColor;
@@ -116,6 +111,7 @@ private:
     reclass_distance_threshold_;  // distance between points at which re classification will occur
 
   size_t radial_dividers_num_;
+  int num_threads_;  // number of threads used to process radial divisions in parallel
 
   size_t grid_width_;
   size_t grid_height_;
@@ -131,8 +127,6 @@ private:
   Polygon vehicle_footprint_;
   bool use_vehicle_footprint_;
 
-  std::vector<cv::Scalar> colors_;
-  const size_t color_num_ = 10;                          // different number of color to generate
   pcl::PointCloud<PointType_>::Ptr previous_cloud_ptr_;  // holds the previous groundless result of
                                                          // ground classification
 
@@ -148,47 +142,45 @@ private:
     const std::string & in_target_frame, const PointCloud2ConstPtr & in_cloud_ptr,
     const PointCloud2::SharedPtr & out_cloud_ptr);
 
+  // buffers reused between the pointclouds
+  PointCloudXYZRTColor unordered_points_;
+  PointCloudXYZRTColor radial_ordered_points_;
+  std::vector<size_t> radial_div_offsets_;
+  std::vector<size_t> radial_div_insert_positions_;
+  std::vector<char> ground_flags_;
+
   /*!
    *
    * @param[in] in_cloud Input Point Cloud to be organized in radial segments
-   * @param[out] out_organized_points Custom Point Cloud filled with XYZRTZColor data
-   * @param[out] out_radial_divided_indices Indices of the points in the original cloud for each
-   * radial segment
-   * @param[out] out_radial_ordered_clouds Vector of Points Clouds, each element will contain the
-   * points ordered
+   * @param[out] out_radial_ordered_points Points of all the radial segments, each segment ordered
+   * by radius
+   * @param[out] out_radial_div_offsets Offsets of the radial segments in
+   * out_radial_ordered_points, with the number of points as the last element
    */
   void ConvertXYZIToRTZColor(
-    const pcl::PointCloud<PointType_>::Ptr in_cloud, PointCloudXYZRTColor & out_organized_points,
-    std::vector<pcl::PointIndices> & out_radial_divided_indices,
-    std::vector<PointCloudXYZRTColor> & out_radial_ordered_clouds);
+    const pcl::PointCloud<PointType_>::Ptr in_cloud,
+    PointCloudXYZRTColor & out_radial_ordered_points, std::vector<size_t> & out_radial_div_offsets);
 
   /*!
    * Classifies Points in the PointCloud as Ground and Not Ground
-   * @param in_radial_ordered_clouds Vector of an Ordered PointsCloud ordered by radial distance
+   * @param in_radial_ordered_points Points of the radial segments ordered by radial distance
    * from the origin
-   * @param out_ground_indices Returns the indices of the points classified as ground in the
-   * original PointCloud
-   * @param out_no_ground_indices Returns the indices of the points classified as not ground in the
-   * original PointCloud
+   * @param in_radial_div_offsets Offsets of the radial segments in in_radial_ordered_points
+   * @param out_ground_flags Returns for each point of the original PointCloud whether it is
+   * classified as ground
    */
   void ClassifyPointCloud(
-    std::vector<PointCloudXYZRTColor> & in_radial_ordered_clouds,
-    pcl::PointIndices & out_ground_indices, pcl::PointIndices & out_no_ground_indices);
+    const PointCloudXYZRTColor & in_radial_ordered_points,
+    const std::vector<size_t> & in_radial_div_offsets, std::vector<char> & out_ground_flags);
 
   /*!
-   * Returns the resulting complementary PointCloud, one with the points kept and the other removed
-   * as indicated in the indices
-   * @param in_cloud_ptr Input PointCloud to which the extraction will be performed
-   * @param in_indices Indices of the points to be both removed and kept
-   * @param out_only_indices_cloud_ptr Resulting PointCloud with the indices kept
-   * @param out_removed_indices_cloud_ptr Resulting PointCloud with the indices removed
+   * Classifies the points of one radial segment, in the order of their radius
    */
-  void ExtractPointsIndices(
-    const pcl::PointCloud<PointType_>::Ptr in_cloud_ptr, const pcl::PointIndices & in_indices,
-    pcl::PointCloud<PointType_>::Ptr out_only_indices_cloud_ptr,
-    pcl::PointCloud<PointType_>::Ptr out_removed_indices_cloud_ptr);
+  void ClassifyRadialDivision(
+    const PointXYZRTColor * begin, const PointXYZRTColor * end,
+    std::vector<char> & out_ground_flags) const;
 
-  boost::optional<float> calcPointVehicleIntersection(const Point & point);
+  boost::optional<float> calcPointVehicleIntersection(const Point & point) const;
 
   void setVehicleFootprint(
     const double min_x, const double max_x, const double min_y, const double max_y);
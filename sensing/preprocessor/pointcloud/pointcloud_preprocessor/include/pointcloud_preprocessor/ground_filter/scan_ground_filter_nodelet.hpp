@@ -115,8 +115,16 @@ private:
     split_height_distance_;                 // useful for close points
   bool use_virtual_ground_point_;
   size_t radial_dividers_num_;
+  int num_threads_;  // number of threads used to process radial divisions in parallel
   VehicleInfo vehicle_info_;
 
+  // buffers reused across frames
+  PointCloudRefVector unordered_points_;
+  PointCloudRefVector radial_ordered_points_;  // points of all radial divisions, back to back
+  std::vector<size_t> radial_div_offsets_;     // start of each radial division, plus the end
+  std::vector<size_t> radial_div_insert_positions_;
+  std::vector<uint8_t> no_ground_flags_;       // 1 if the point of this original index is no ground
+
   /*!
    * Output transformed PointCloud from in_cloud_ptr->header.frame_id to in_target_frame
    * @param[in] in_target_frame Coordinate system to perform transform
@@ -130,14 +138,14 @@ private:
     const PointCloud2::SharedPtr & out_cloud_ptr);
 
   /*!
-   * Convert pcl::PointCloud to sorted PointCloudRefVector
+   * Convert pcl::PointCloud to sorted PointCloudRefVector using a counting sort by radial division
    * @param[in] in_cloud Input Point Cloud to be organized in radial segments
-   * @param[out] out_radial_ordered_points_manager Vector of Points Clouds,
-   *     each element will contain the points ordered
+   * @param[out] out_radial_ordered_points Points of all radial divisions, each ordered by radius
+   * @param[out] out_radial_div_offsets Offset of each radial division in out_radial_ordered_points
    */
   void convertPointcloud(
     const pcl::PointCloud<pcl::PointXYZ>::Ptr in_cloud,
-    std::vector<PointCloudRefVector> & out_radial_ordered_points_manager);
+    PointCloudRefVector & out_radial_ordered_points, std::vector<size_t> & out_radial_div_offsets);
 
   /*!
    * Output ground center of front wheels as the virtual ground point
@@ -147,14 +155,21 @@ private:
 
   /*!
    * Classifies Points in the PointCloud as Ground and Not Ground
-   * @param in_radial_ordered_clouds Vector of an Ordered PointsCloud
-   *     ordered by radial distance from the origin
+   * @param in_radial_ordered_points Points of all radial divisions, each ordered by radius
+   * @param in_radial_div_offsets Offset of each radial division in in_radial_ordered_points
    * @param out_no_ground_indices Returns the indices of the points
    *     classified as not ground in the original PointCloud
    */
   void classifyPointCloud(
-    std::vector<PointCloudRefVector> & in_radial_ordered_clouds,
-    pcl::PointIndices & out_no_ground_indices);
+    PointCloudRefVector & in_radial_ordered_points,
+    const std::vector<size_t> & in_radial_div_offsets, pcl::PointIndices & out_no_ground_indices);
+
+  /*!
+   * Classifies the points of one radial division, which is independent of the other divisions
+   * @param begin First point of the radial division
+   * @param end End of the radial division
+   */
+  void classifyRadialDivision(PointRef * begin, PointRef * end);
 
   /*!
    * Returns the resulting complementary PointCloud, one with the points kept
@@ -35,7 +35,6 @@
 namespace pointcloud_preprocessor
 {
 using diagnostic_updater::DiagnosticStatusWrapper;
-using diagnostic_updater::Updater;
 
 enum ReturnType : uint8_t {
   INVALID = 0,
@@ -65,13 +64,13 @@ protected:
 
 private:
   void onVisibilityChecker(DiagnosticStatusWrapper & stat);
-  Updater updater_{this};
   double visibility_ = 1.f;
   double weak_first_distance_ratio_;
   double general_distance_ratio_;
   int weak_first_local_noise_threshold_;
   double visibility_threshold_;
-  int vertical_bins_;
+  int vertical_bins_;    // the number of rings, extended to the rings in the input
+  int horizontal_bins_;  // the number of azimuth bins over 360 degrees
   float max_azimuth_diff_;
 
 public:
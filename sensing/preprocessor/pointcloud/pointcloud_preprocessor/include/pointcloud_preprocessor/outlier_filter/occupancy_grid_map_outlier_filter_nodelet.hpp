@@ -56,11 +56,15 @@ public:
     PclPointCloud & output, PclPointCloud & outlier);
 
 private:
+  template <class Grid>
+  void filterByGrid(
+    const Grid & grid, const PclPointCloud & input, const Pose & pose, PclPointCloud & output,
+    PclPointCloud & outlier);
+
   float search_radius_;
   float min_points_and_distance_ratio_;
   int min_points_;
   int max_points_;
-  pcl::search::Search<pcl::PointXY>::Ptr kd_tree_;
 };
 
 class OccupancyGridMapOutlierFilterComponent : public rclcpp::Node
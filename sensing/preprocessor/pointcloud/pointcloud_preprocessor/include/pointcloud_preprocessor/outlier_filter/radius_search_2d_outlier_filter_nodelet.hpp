@@ -19,11 +19,6 @@
 
 #include <pcl/common/impl/common.hpp>
 
-#include <pcl/filters/extract_indices.h>
-#include <pcl/filters/radius_outlier_removal.h>
-#include <pcl/filters/voxel_grid.h>
-#include <pcl/search/pcl_search.h>
-
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -37,10 +32,10 @@ protected:
 private:
   double search_radius_;
   size_t min_neighbors_;
+  int num_threads_;
 
-  // pcl::RadiusOutlierRemoval<pcl::PCLPointCloud2> radius_outlier_removal_;
-  pcl::search::Search<pcl::PointXY>::Ptr kd_tree_;
-  // pcl::ExtractIndices<pcl::PCLPointCloud2> extract_indices_;
+  // kept across messages to avoid reallocation
+  std::vector<char> is_inlier_;
 
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
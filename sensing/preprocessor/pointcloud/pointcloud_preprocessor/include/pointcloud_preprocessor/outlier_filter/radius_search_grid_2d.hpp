@@ -0,0 +1,64 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__OUTLIER_FILTER__RADIUS_SEARCH_GRID_2D_HPP_
+#define POINTCLOUD_PREPROCESSOR__OUTLIER_FILTER__RADIUS_SEARCH_GRID_2D_HPP_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+/**
+ * @brief 2D points bucketed in cells as large as the search radius, so that a radius search only
+ * visits the 3x3 cells around the query point and nothing has to be built but a sort.
+ */
+class RadiusSearchGrid2d
+{
+public:
+  explicit RadiusSearchGrid2d(const float search_radius);
+
+  void addPoints(const pcl::PointCloud<pcl::PointXYZ> & cloud);
+  void build();
+
+  /**
+   * @brief number of points within the radius including the query point itself, counted up to
+   * max_count. Safe to call from several threads after build().
+   */
+  int countPointsInRadius(const float x, const float y, const int max_count) const;
+
+private:
+  struct CellPoint
+  {
+    uint64_t key;
+    float x;
+    float y;
+  };
+
+  int32_t toCell(const float value) const;
+  static uint64_t toKey(const int32_t cell_x, const int32_t cell_y);
+
+  float inv_cell_size_;
+  float sq_search_radius_;
+  std::vector<CellPoint> points_;
+  std::unordered_map<uint64_t, std::pair<size_t, size_t>> cell_ranges_;
+};
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__OUTLIER_FILTER__RADIUS_SEARCH_GRID_2D_HPP_
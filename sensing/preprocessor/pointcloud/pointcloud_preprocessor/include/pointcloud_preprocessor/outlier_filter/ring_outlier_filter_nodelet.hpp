@@ -35,6 +35,9 @@ private:
   double object_length_threshold_;
   int num_points_threshold_;
 
+  /** \brief Point indices of each ring, reused across frames. */
+  std::vector<std::vector<size_t>> ring_indices_;
+
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
 
@@ -17,9 +17,8 @@
 
 #include "pointcloud_preprocessor/filter.hpp"
 
-#include <pcl/filters/voxel_grid.h>
-#include <pcl/search/pcl_search.h>
-
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -42,7 +41,9 @@ private:
   double voxel_size_z_;
   int voxel_points_threshold_;
 
-  pcl::VoxelGrid<pcl::PointXYZ> voxel_filter;
+  // kept across messages to avoid reallocation
+  std::vector<uint64_t> voxel_keys_;
+  std::unordered_map<uint64_t, int> voxel_point_counts_;
 
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -0,0 +1,90 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__PASSTHROUGH_FILTER__FIELD_RANGE_FILTER_HPP_
+#define POINTCLOUD_PREPROCESSOR__PASSTHROUGH_FILTER__FIELD_RANGE_FILTER_HPP_
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <sensor_msgs/msg/point_field.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+/**
+ * @brief Range of a field a point is kept in. As with pcl::PassThrough, a negative range keeps the
+ * points outside (min, max) instead of the points inside [min, max].
+ */
+struct FieldRange
+{
+  std::string field_name;
+  double min;
+  double max;
+  bool negative;
+};
+
+/**
+ * @brief Keeps the points whose fields are in all the ranges, reading the fields straight from the
+ * bytes of the PointCloud2. The offsets of the fields are looked up again only when the layout of
+ * the input changes, and the kept points are compacted without a branch per point.
+ */
+class FieldRangeFilter
+{
+public:
+  void setRanges(const std::vector<FieldRange> & ranges);
+  const std::vector<FieldRange> & getRanges() const { return ranges_; }
+
+  /** \brief Set whether the removed points are kept with NaN coordinates, keeping the width and
+   * height of the input. */
+  void setKeepOrganized(const bool keep_organized) { keep_organized_ = keep_organized; }
+  bool getKeepOrganized() const { return keep_organized_; }
+
+  /**
+   * @brief filter the points of input, or the points at indices if it is not empty
+   * @return false if a field of the ranges is missing in input
+   */
+  bool filter(
+    const sensor_msgs::msg::PointCloud2 & input, const std::vector<int> & indices,
+    sensor_msgs::msg::PointCloud2 & output);
+
+private:
+  struct FieldCondition
+  {
+    uint32_t offset;
+    uint8_t datatype;
+    double min;
+    double max;
+    bool negative;
+  };
+
+  std::vector<FieldRange> ranges_;
+  bool keep_organized_ = false;
+
+  // layout the conditions have been resolved for
+  std::vector<sensor_msgs::msg::PointField> layout_fields_;
+  uint32_t layout_point_step_ = 0;
+  bool is_layout_resolved_ = false;
+  bool is_layout_valid_ = false;
+  std::vector<FieldCondition> conditions_;
+  std::vector<uint32_t> xyz_offsets_;  // float32 coordinates, set to NaN for keep_organized
+
+  void resolveLayout(const sensor_msgs::msg::PointCloud2 & input);
+  bool isKept(const uint8_t * point) const;
+};
+
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__PASSTHROUGH_FILTER__FIELD_RANGE_FILTER_HPP_
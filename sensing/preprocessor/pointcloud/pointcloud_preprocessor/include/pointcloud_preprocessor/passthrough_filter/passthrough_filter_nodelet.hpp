@@ -52,9 +52,9 @@
 #define POINTCLOUD_PREPROCESSOR__PASSTHROUGH_FILTER__PASSTHROUGH_FILTER_NODELET_HPP_
 
 #include "pointcloud_preprocessor/filter.hpp"
+#include "pointcloud_preprocessor/passthrough_filter/field_range_filter.hpp"
 
-#include <pcl/search/pcl_search.h>
-
+#include <string>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -71,6 +71,15 @@ protected:
   /** \brief Parameter service callback */
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
+private:
+  /** \brief Keeps the points inside all the ranges of filter_field_names, in one pass. */
+  FieldRangeFilter impl_;
+
+  /** \brief Set the ranges of impl_ from the parameter arrays, false if their sizes differ. */
+  bool setRanges(
+    const std::vector<std::string> & field_names, const std::vector<double> & limits_min,
+    const std::vector<double> & limits_max, const std::vector<bool> & limits_negative);
+
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
   explicit PassThroughFilterComponent(const rclcpp::NodeOptions & options);
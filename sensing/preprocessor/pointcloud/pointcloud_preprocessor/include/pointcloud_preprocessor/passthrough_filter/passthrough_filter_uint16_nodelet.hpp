@@ -16,7 +16,7 @@
 #define POINTCLOUD_PREPROCESSOR__PASSTHROUGH_FILTER__PASSTHROUGH_FILTER_UINT16_NODELET_HPP_
 
 #include "pointcloud_preprocessor/filter.hpp"
-#include "pointcloud_preprocessor/passthrough_filter/passthrough_uint16.hpp"
+#include "pointcloud_preprocessor/passthrough_filter/field_range_filter.hpp"
 
 #include <pcl/search/pcl_search.h>
 
@@ -37,7 +37,7 @@ protected:
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
 private:
-  pcl::PassThroughUInt16<pcl::PCLPointCloud2> impl_;
+  FieldRangeFilter impl_;
 
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
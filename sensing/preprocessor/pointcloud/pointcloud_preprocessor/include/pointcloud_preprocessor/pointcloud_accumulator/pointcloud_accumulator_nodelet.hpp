@@ -17,8 +17,10 @@
 
 #include "pointcloud_preprocessor/filter.hpp"
 
-#include <boost/circular_buffer.hpp>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
 
+#include <deque>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -36,8 +38,20 @@ protected:
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
 private:
+  struct Sweep
+  {
+    rclcpp::Time stamp;
+    size_t size;
+    bool is_dense;
+  };
+
   double accumulation_time_sec_;
-  boost::circular_buffer<PointCloud2ConstPtr> pointcloud_buffer_;
+  size_t pointcloud_buffer_size_;
+
+  /** \brief accumulated sweeps from the oldest, their points are in points_ from points_begin_ */
+  std::deque<Sweep> sweeps_;
+  pcl::PointCloud<pcl::PointXYZ>::VectorType points_;
+  size_t points_begin_;
 
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -15,6 +15,8 @@
 #ifndef POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET2_MAP_FILTER_NODELET_HPP_
 #define POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET2_MAP_FILTER_NODELET_HPP_
 
+#include "pointcloud_preprocessor/vector_map_filter/road_raster_mask.hpp"
+
 #include <autoware_utils/geometry/boost_geometry.hpp>
 #include <lanelet2_extension/utility/message_conversion.hpp>
 #include <lanelet2_extension/utility/query.hpp>
@@ -62,6 +64,10 @@ private:
   float voxel_size_x_;
   float voxel_size_y_;
 
+  // filter by a raster of the road lanelets instead of the polygons, built on receiving the map
+  bool use_raster_mask_;
+  std::unique_ptr<RoadRasterMask> raster_mask_;
+
   void pointcloudCallback(const PointCloud2ConstPtr msg);
 
   void mapCallback(const autoware_lanelet2_msgs::msg::MapBin::ConstSharedPtr msg);
@@ -81,6 +87,9 @@ private:
 
   bool pointWithinLanelets(const Point2d & point, const lanelet::ConstLanelets & joint_lanelets);
 
+  pcl::PointCloud<pcl::PointXYZ> getRasterFilteredPointCloud(
+    const pcl::PointCloud<pcl::PointXYZ>::Ptr & cloud);
+
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
 
@@ -0,0 +1,55 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__ROAD_RASTER_MASK_HPP_
+#define POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__ROAD_RASTER_MASK_HPP_
+
+#include <lanelet2_core/primitives/Lanelet.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+/**
+ * @brief Binary raster of the area covered by lanelets, split into square tiles so that only the
+ * tiles around the lanelets are allocated. A cell is set if its center is inside a lanelet.
+ */
+class RoadRasterMask
+{
+public:
+  explicit RoadRasterMask(const double resolution);
+
+  void build(const lanelet::ConstLanelets & lanelets);
+  bool isInside(const double x, const double y) const;
+
+  double resolution() const { return resolution_; }
+  size_t numTiles() const { return tiles_.size(); }
+
+private:
+  static constexpr int64_t tile_bits = 8;
+  static constexpr int64_t tile_width = int64_t{1} << tile_bits;  // cells on a side of a tile
+
+  double resolution_;
+  std::unordered_map<uint64_t, std::vector<uint64_t>> tiles_;  // bits of the cells in a tile
+
+  static uint64_t toTileKey(const int64_t col, const int64_t row);
+  void fillRow(const int64_t row, const int64_t col_begin, const int64_t col_end);
+  void fillPolygon(const lanelet::BasicPolygon2d & polygon);
+};
+
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__ROAD_RASTER_MASK_HPP_
@@ -39,6 +39,9 @@ def generate_launch_description():
 
     tf_output_frame_param = DeclareLaunchArgument("tf_output_frame", default_value="base_link")
 
+    # the clouds are handed over between the components in the container without a copy
+    use_intra_process_param = DeclareLaunchArgument("use_intra_process", default_value="true")
+
     # set concat filter as a component
     concat_component = ComposableNode(
         package=pkg,
@@ -52,6 +55,7 @@ def generate_launch_description():
                 "approximate_sync": True,
             }
         ],
+        extra_arguments=[{"use_intra_process_comms": LaunchConfiguration("use_intra_process")}],
     )
 
     # set crop box filter as a component
@@ -85,6 +89,7 @@ def generate_launch_description():
                 "negative": False,
             }
         ],
+        extra_arguments=[{"use_intra_process_comms": LaunchConfiguration("use_intra_process")}],
     )
 
     # set container to run all required components in the same process
@@ -113,6 +118,7 @@ def generate_launch_description():
             input_points_raw_list_param,
             output_points_raw_param,
             tf_output_frame_param,
+            use_intra_process_param,
             container,
             log_info,
         ]
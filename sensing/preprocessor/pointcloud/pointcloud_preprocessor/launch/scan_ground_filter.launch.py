@@ -43,6 +43,9 @@ def generate_launch_description():
                     "split_height_distance": 0.2,
                 }
             ],
+            extra_arguments=[
+                {"use_intra_process_comms": LaunchConfiguration("use_intra_process")}
+            ],
         ),
     ]
 
@@ -67,6 +70,7 @@ def generate_launch_description():
             add_launch_arg("container", ""),
             add_launch_arg("input/pointcloud", "pointcloud"),
             add_launch_arg("output/pointcloud", "no_ground/pointcloud"),
+            add_launch_arg("use_intra_process", "true"),
             container,
             loader,
         ]
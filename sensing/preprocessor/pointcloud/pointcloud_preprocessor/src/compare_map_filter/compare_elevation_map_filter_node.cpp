@@ -15,7 +15,6 @@
 #include "pointcloud_preprocessor/compare_map_filter/compare_elevation_map_filter_node.hpp"
 
 #include <grid_map_core/GridMap.hpp>
-#include <grid_map_cv/GridMapCvConverter.hpp>
 #include <grid_map_pcl/GridMapPclLoader.hpp>
 #include <grid_map_pcl/helpers.hpp>
 #include <grid_map_ros/GridMapRosConverter.hpp>
@@ -25,13 +24,14 @@
 
 #include <glob.h>
 #include <pcl/io/pcd_io.h>
-#include <pcl/point_types.h>
-#include <pcl_conversions/pcl_conversions.h>
 #include <rcutils/filesystem.h>  // To be replaced by std::filesystem in C++17
 
+#include <cmath>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace pointcloud_preprocessor
 {
@@ -56,43 +56,124 @@ CompareElevationMapFilterComponent::CompareElevationMapFilterComponent(
 void CompareElevationMapFilterComponent::elevationMapCallback(
   const grid_map_msgs::msg::GridMap::ConstSharedPtr elevation_map)
 {
-  grid_map::GridMapRosConverter::fromMessage(*elevation_map, elevation_map_);
-  elevation_map_data_ = elevation_map_.get(layer_name_);
+  grid_map::GridMap map;
+  grid_map::GridMapRosConverter::fromMessage(*elevation_map, map);
+  if (!map.exists(layer_name_)) {
+    RCLCPP_ERROR(get_logger(), "Elevation map has no layer %s.", layer_name_.c_str());
+    return;
+  }
+  map.convertToDefaultStartIndex();
 
-  const float min_value = elevation_map_.get(layer_name_).minCoeffOfFinites();
-  const float max_value = elevation_map_.get(layer_name_).maxCoeffOfFinites();
-  grid_map::GridMapCvConverter::toImage<uint16_t, 1>(
-    elevation_map_, layer_name_, CV_16UC1, min_value, max_value, elevation_image_);
+  // grid_map indices grow toward -x and -y from the corner at the maximum position
+  const auto & data = map.get(layer_name_);
+  const auto & size = map.getSize();
+  ElevationRaster raster;
+  raster.frame_id = map.getFrameId();
+  raster.min_x = static_cast<float>(map.getPosition().x() - 0.5 * map.getLength().x());
+  raster.min_y = static_cast<float>(map.getPosition().y() - 0.5 * map.getLength().y());
+  raster.inv_resolution = static_cast<float>(1.0 / map.getResolution());
+  raster.size_x = size(0);
+  raster.size_y = size(1);
+  raster.values.resize(static_cast<size_t>(raster.size_x) * raster.size_y);
+  for (int cell_y = 0; cell_y < raster.size_y; ++cell_y) {
+    for (int cell_x = 0; cell_x < raster.size_x; ++cell_x) {
+      raster.values[cell_y * raster.size_x + cell_x] =
+        data(raster.size_x - 1 - cell_x, raster.size_y - 1 - cell_y);
+    }
+  }
+  elevation_raster_ = std::move(raster);
   subscribe();
 }
 
+bool CompareElevationMapFilterComponent::ElevationRaster::interpolate(
+  const float x, const float y, float & value) const
+{
+  const float rel_x = (x - min_x) * inv_resolution;
+  const float rel_y = (y - min_y) * inv_resolution;
+  if (!(0.0f <= rel_x && rel_x < size_x && 0.0f <= rel_y && rel_y < size_y)) {
+    return false;
+  }
+
+  // coordinates relative to the cell centers
+  const float center_x = rel_x - 0.5f;
+  const float center_y = rel_y - 0.5f;
+  const int cell_x = static_cast<int>(std::floor(center_x));
+  const int cell_y = static_cast<int>(std::floor(center_y));
+  if (cell_x < 0 || size_x <= cell_x + 1 || cell_y < 0 || size_y <= cell_y + 1) {
+    value = at(static_cast<int>(rel_x), static_cast<int>(rel_y));
+    return true;
+  }
+  const float ratio_x = center_x - cell_x;
+  const float ratio_y = center_y - cell_y;
+  const float bottom = (1.0f - ratio_x) * at(cell_x, cell_y) + ratio_x * at(cell_x + 1, cell_y);
+  const float top =
+    (1.0f - ratio_x) * at(cell_x, cell_y + 1) + ratio_x * at(cell_x + 1, cell_y + 1);
+  value = (1.0f - ratio_y) * bottom + ratio_y * top;
+  return true;
+}
+
 void CompareElevationMapFilterComponent::filter(
   const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
   PointCloud2 & output)
 {
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_input(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
-  std::string output_frame = map_frame_;
-
-  output_frame = elevation_map_.getFrameId();
-  elevation_map_.setTimestamp(input->header.stamp.nanosec);
-  pcl::fromROSMsg(*input, *pcl_input);
-  pcl_output->points.reserve(pcl_input->points.size());
-  for (const auto & point : pcl_input->points) {
-    if (elevation_map_.isInside(grid_map::Position(point.x, point.y))) {
-      float elevation_value = elevation_map_.atPosition(
-        layer_name_, grid_map::Position(point.x, point.y),
-        grid_map::InterpolationMethods::INTER_LINEAR);
-      const float height_diff = point.z - elevation_value;
-      if (height_diff > height_diff_thresh_) {
-        pcl_output->points.push_back(point);
+  const auto getFieldOffset = [&input](const std::string & name) {
+    for (const auto & field : input->fields) {
+      if (field.name == name && field.datatype == sensor_msgs::msg::PointField::FLOAT32) {
+        return static_cast<int>(field.offset);
+      }
+    }
+    return -1;
+  };
+  const int x_offset = getFieldOffset("x");
+  const int y_offset = getFieldOffset("y");
+  const int z_offset = getFieldOffset("z");
+  if (x_offset < 0 || y_offset < 0 || z_offset < 0) {
+    RCLCPP_ERROR_THROTTLE(
+      get_logger(), *get_clock(), 5000, "Input pointcloud needs x, y and z fields.");
+    return;
+  }
+
+  // output x, y and z, written straight into the preallocated buffer
+  output.fields.clear();
+  for (const auto & name : {"x", "y", "z"}) {
+    sensor_msgs::msg::PointField field;
+    field.name = name;
+    field.offset = static_cast<uint32_t>(output.fields.size() * sizeof(float));
+    field.datatype = sensor_msgs::msg::PointField::FLOAT32;
+    field.count = 1;
+    output.fields.push_back(field);
+  }
+  output.point_step = static_cast<uint32_t>(output.fields.size() * sizeof(float));
+
+  const size_t num_points = static_cast<size_t>(input->width) * input->height;
+  output.data.resize(num_points * output.point_step);
+  size_t num_output_points = 0;
+  for (size_t row = 0; row < input->height; ++row) {
+    const uint8_t * src = input->data.data() + row * input->row_step;
+    for (size_t col = 0; col < input->width; ++col, src += input->point_step) {
+      float point[3];
+      std::memcpy(&point[0], src + x_offset, sizeof(float));
+      std::memcpy(&point[1], src + y_offset, sizeof(float));
+      std::memcpy(&point[2], src + z_offset, sizeof(float));
+      float elevation;
+      if (
+        elevation_raster_.interpolate(point[0], point[1], elevation) &&
+        point[2] - elevation > height_diff_thresh_) {
+        std::memcpy(
+          output.data.data() + num_output_points * output.point_step, point, sizeof(point));
+        ++num_output_points;
       }
     }
   }
 
-  pcl::toROSMsg(*pcl_output, output);
+  output.data.resize(num_output_points * output.point_step);
   output.header.stamp = input->header.stamp;
-  output.header.frame_id = output_frame;
+  output.header.frame_id = elevation_raster_.frame_id;
+  output.height = 1;
+  output.width = static_cast<uint32_t>(num_output_points);
+  output.row_step = output.width * output.point_step;
+  output.is_bigendian = input->is_bigendian;
+  output.is_dense = input->is_dense;
 }
 }  // namespace pointcloud_preprocessor
 
@@ -18,6 +18,7 @@
 #include <pcl/search/kdtree.h>
 #include <pcl/segmentation/segment_differences.h>
 
+#include <string>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -28,8 +29,17 @@ VoxelBasedCompareMapFilterComponent::VoxelBasedCompareMapFilterComponent(
 {
   distance_threshold_ = static_cast<double>(declare_parameter("distance_threshold", 0.3));
 
+  use_tiled_map_index_ = static_cast<bool>(declare_parameter("use_tiled_map_index", false));
+  map_index_file_ = static_cast<std::string>(declare_parameter("map_index_file", ""));
+  map_tile_size_ = static_cast<double>(declare_parameter("map_tile_size", 100.0));
+
   set_map_in_voxel_grid_ = false;
 
+  // a shared index file lets the filter start without waiting for the whole map
+  if (use_tiled_map_index_) {
+    loadTiledMap();
+  }
+
   using std::placeholders::_1;
   sub_map_ = this->create_subscription<PointCloud2>(
     "map", rclcpp::QoS{1}.transient_local(),
@@ -44,6 +54,26 @@ void VoxelBasedCompareMapFilterComponent::filter(
   PointCloud2 & output)
 {
   boost::mutex::scoped_lock lock(mutex_);
+  if (use_tiled_map_index_) {
+    if (tiled_map_.empty()) {
+      output = *input;
+      return;
+    }
+    pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_input(new pcl::PointCloud<pcl::PointXYZ>);
+    pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
+    pcl::fromROSMsg(*input, *pcl_input);
+    pcl_output->points.reserve(pcl_input->points.size());
+    const float distance_threshold = static_cast<float>(distance_threshold_);
+    for (const auto & point : pcl_input->points) {
+      if (!tiled_map_.hasCentroidWithin(point, distance_threshold)) {
+        pcl_output->points.push_back(point);
+      }
+    }
+    pcl::toROSMsg(*pcl_output, output);
+    output.header = input->header;
+    return;
+  }
+
   if (voxel_map_ptr_ == NULL) {
     output = *input;
     return;
@@ -237,6 +267,16 @@ void VoxelBasedCompareMapFilterComponent::input_target_callback(const PointCloud
 {
   pcl::PointCloud<pcl::PointXYZ> map_pcl;
   pcl::fromROSMsg<pcl::PointXYZ>(*map, map_pcl);
+
+  if (use_tiled_map_index_) {
+    boost::mutex::scoped_lock lock(mutex_);
+    tf_input_frame_ = map_pcl.header.frame_id;
+    if (tiled_map_.empty()) {
+      setupTiledMap(map_pcl);
+    }
+    return;
+  }
+
   const auto map_pcl_ptr = boost::make_shared<const pcl::PointCloud<pcl::PointXYZ>>(map_pcl);
 
   boost::mutex::scoped_lock lock(mutex_);
@@ -249,6 +289,37 @@ void VoxelBasedCompareMapFilterComponent::input_target_callback(const PointCloud
   voxel_grid_.filter(*voxel_map_ptr_);
 }
 
+bool VoxelBasedCompareMapFilterComponent::loadTiledMap()
+{
+  if (map_index_file_.empty() || !tiled_map_.load(map_index_file_)) {
+    return false;
+  }
+  if (tiled_map_.getLeafSize() != static_cast<float>(distance_threshold_)) {
+    RCLCPP_WARN(
+      get_logger(), "Ignoring map index %s built with leaf size %f", map_index_file_.c_str(),
+      tiled_map_.getLeafSize());
+    tiled_map_.clear();
+    return false;
+  }
+  RCLCPP_INFO(
+    get_logger(), "Loaded map index %s (%zu voxels in %zu tiles)", map_index_file_.c_str(),
+    tiled_map_.size(), tiled_map_.getNumTiles());
+  return true;
+}
+
+void VoxelBasedCompareMapFilterComponent::setupTiledMap(
+  const pcl::PointCloud<pcl::PointXYZ> & map)
+{
+  // another process may have written the index while the map was being received
+  if (loadTiledMap()) {
+    return;
+  }
+  tiled_map_.build(map, distance_threshold_, map_tile_size_);
+  if (!map_index_file_.empty() && !tiled_map_.save(map_index_file_)) {
+    RCLCPP_WARN(get_logger(), "Failed to write map index to %s", map_index_file_.c_str());
+  }
+}
+
 rcl_interfaces::msg::SetParametersResult VoxelBasedCompareMapFilterComponent::paramCallback(
   const std::vector<rclcpp::Parameter> & p)
 {
@@ -260,6 +331,11 @@ rcl_interfaces::msg::SetParametersResult VoxelBasedCompareMapFilterComponent::pa
     if (set_map_in_voxel_grid_) {
       voxel_grid_.filter(*voxel_map_ptr_);
     }
+    if (use_tiled_map_index_) {
+      RCLCPP_WARN(
+        get_logger(), "The tiled map index keeps its leaf size of %f until it is rebuilt.",
+        tiled_map_.getLeafSize());
+    }
     RCLCPP_DEBUG(get_logger(), "Setting new distance threshold to: %f.", distance_threshold_);
   }
 
@@ -54,8 +54,10 @@
 #include <pcl_ros/transforms.hpp>
 
 #include <pcl_conversions/pcl_conversions.h>
+#include <tf2_eigen/tf2_eigen.h>
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -96,6 +98,15 @@ PointCloudConcatenateDataSynchronizerComponent::PointCloudConcatenateDataSynchro
       RCLCPP_ERROR(get_logger(), "The number of topics does not match the number of offsets.");
       return;
     }
+
+    use_single_pass_concatenation_ =
+      static_cast<bool>(declare_parameter("use_single_pass_concatenation", false));
+  }
+
+  // Set tf_listener, tf_buffer.
+  {
+    tf2_buffer_ = std::make_shared<tf2_ros::Buffer>(this->get_clock());
+    tf2_listener_ = std::make_shared<tf2_ros::TransformListener>(*tf2_buffer_);
   }
 
   // Initialize not_subscribed_topic_names_
@@ -197,6 +208,34 @@ void PointCloudConcatenateDataSynchronizerComponent::combineClouds(
   }
 
   const auto old_stamp = std::min(rclcpp::Time(in1->header.stamp), rclcpp::Time(in2->header.stamp));
+  const auto new_stamp = std::max(rclcpp::Time(in1->header.stamp), rclcpp::Time(in2->header.stamp));
+  const Eigen::Matrix4f rotation_matrix =
+    computeTransformToAdjustForOldTimestamp(old_stamp, new_stamp);
+
+  // TODO(YamatoAndo): if output_frame_ is not base_link, we must transform
+
+  if (rclcpp::Time(in1->header.stamp) > rclcpp::Time(in2->header.stamp)) {
+    sensor_msgs::msg::PointCloud2::SharedPtr in1_t(new sensor_msgs::msg::PointCloud2());
+    pcl_ros::transformPointCloud(rotation_matrix, *in1, *in1_t);
+    pcl::concatenatePointCloud(*in1_t, *in2, *out);
+    out->header.stamp = in2->header.stamp;
+  } else {
+    sensor_msgs::msg::PointCloud2::SharedPtr in2_t(new sensor_msgs::msg::PointCloud2());
+    pcl_ros::transformPointCloud(rotation_matrix, *in2, *in2_t);
+    pcl::concatenatePointCloud(*in1, *in2_t, *out);
+    out->header.stamp = in1->header.stamp;
+  }
+}
+
+Eigen::Matrix4f
+PointCloudConcatenateDataSynchronizerComponent::computeTransformToAdjustForOldTimestamp(
+  const rclcpp::Time & old_stamp, const rclcpp::Time & new_stamp)
+{
+  // return identity if no twist is available
+  if (twist_ptr_queue_.empty()) {
+    return Eigen::Matrix4f::Identity();
+  }
+
   auto old_twist_ptr_it = std::lower_bound(
     std::begin(twist_ptr_queue_), std::end(twist_ptr_queue_), old_stamp,
     [](const geometry_msgs::msg::TwistStamped::ConstSharedPtr & x_ptr, const rclcpp::Time & t) {
@@ -205,7 +244,6 @@ void PointCloudConcatenateDataSynchronizerComponent::combineClouds(
   old_twist_ptr_it =
     old_twist_ptr_it == twist_ptr_queue_.end() ? (twist_ptr_queue_.end() - 1) : old_twist_ptr_it;
 
-  const auto new_stamp = std::max(rclcpp::Time(in1->header.stamp), rclcpp::Time(in2->header.stamp));
   auto new_twist_ptr_it = std::lower_bound(
     std::begin(twist_ptr_queue_), std::end(twist_ptr_queue_), new_stamp,
     [](const geometry_msgs::msg::TwistStamped::ConstSharedPtr & x_ptr, const rclcpp::Time & t) {
@@ -242,21 +280,158 @@ void PointCloudConcatenateDataSynchronizerComponent::combineClouds(
   Eigen::AngleAxisf rotation_y(0, Eigen::Vector3f::UnitY());
   Eigen::AngleAxisf rotation_z(yaw, Eigen::Vector3f::UnitZ());
   Eigen::Translation3f translation(x, y, 0);
-  Eigen::Matrix4f rotation_matrix = (translation * rotation_z * rotation_y * rotation_x).matrix();
+  return (translation * rotation_z * rotation_y * rotation_x).matrix();
+}
 
-  // TODO(YamatoAndo): if output_frame_ is not base_link, we must transform
+bool PointCloudConcatenateDataSynchronizerComponent::lookupTransformToOutputFrame(
+  const PointCloud2 & cloud, Eigen::Matrix4f & transform)
+{
+  if (cloud.header.frame_id == output_frame_) {
+    transform = Eigen::Matrix4f::Identity();
+    return true;
+  }
 
-  if (rclcpp::Time(in1->header.stamp) > rclcpp::Time(in2->header.stamp)) {
-    sensor_msgs::msg::PointCloud2::SharedPtr in1_t(new sensor_msgs::msg::PointCloud2());
-    pcl_ros::transformPointCloud(rotation_matrix, *in1, *in1_t);
-    pcl::concatenatePointCloud(*in1_t, *in2, *out);
-    out->header.stamp = in2->header.stamp;
-  } else {
-    sensor_msgs::msg::PointCloud2::SharedPtr in2_t(new sensor_msgs::msg::PointCloud2());
-    pcl_ros::transformPointCloud(rotation_matrix, *in2, *in2_t);
-    pcl::concatenatePointCloud(*in1, *in2_t, *out);
-    out->header.stamp = in1->header.stamp;
+  try {
+    const auto transform_stamped = tf2_buffer_->lookupTransform(
+      output_frame_, cloud.header.frame_id, rclcpp::Time(cloud.header.stamp),
+      rclcpp::Duration::from_seconds(0.0));
+    transform = tf2::transformToEigen(transform_stamped.transform).matrix().cast<float>();
+  } catch (tf2::TransformException & ex) {
+    RCLCPP_ERROR(
+      this->get_logger(),
+      "[lookupTransformToOutputFrame] Error converting input dataset from %s to %s: %s",
+      cloud.header.frame_id.c_str(), output_frame_.c_str(), ex.what());
+    return false;
+  }
+  return true;
+}
+
+sensor_msgs::msg::PointCloud2::UniquePtr
+PointCloudConcatenateDataSynchronizerComponent::concatenateCloudsSinglePass()
+{
+  struct InputSlice
+  {
+    PointCloud2::ConstSharedPtr cloud;
+    Eigen::Matrix4f transform;
+    int x_offset;
+    int y_offset;
+    int z_offset;
+    int intensity_offset;
+  };
+
+  const auto getFloatFieldOffset = [](const PointCloud2 & cloud, const std::string & name) {
+    for (const auto & field : cloud.fields) {
+      if (field.name == name && field.datatype == sensor_msgs::msg::PointField::FLOAT32) {
+        return static_cast<int>(field.offset);
+      }
+    }
+    return -1;
+  };
+
+  std::vector<InputSlice, Eigen::aligned_allocator<InputSlice>> slices;
+  slices.reserve(cloud_stdmap_.size());
+  size_t total_points = 0;
+  bool has_intensity = true;
+  rclcpp::Time oldest_stamp;
+  for (const auto & e : cloud_stdmap_) {
+    if (e.second == nullptr) {
+      not_subscribed_topic_names_.insert(e.first);
+      continue;
+    }
+    const auto & cloud = *e.second;
+    const size_t num_points = static_cast<size_t>(cloud.width) * cloud.height;
+    if (num_points * cloud.point_step != cloud.data.size()) {
+      RCLCPP_WARN(
+        this->get_logger(), "Invalid PointCloud (data = %zu, width = %d, height = %d, step = %d)",
+        cloud.data.size(), cloud.width, cloud.height, cloud.point_step);
+      continue;
+    }
+
+    InputSlice slice;
+    slice.cloud = e.second;
+    slice.x_offset = getFloatFieldOffset(cloud, "x");
+    slice.y_offset = getFloatFieldOffset(cloud, "y");
+    slice.z_offset = getFloatFieldOffset(cloud, "z");
+    slice.intensity_offset = getFloatFieldOffset(cloud, "intensity");
+    if (slice.x_offset < 0 || slice.y_offset < 0 || slice.z_offset < 0) {
+      RCLCPP_WARN(
+        this->get_logger(), "Input cloud in %s has no float32 x/y/z fields, skipping.",
+        cloud.header.frame_id.c_str());
+      continue;
+    }
+    if (!lookupTransformToOutputFrame(cloud, slice.transform)) {
+      continue;
+    }
+
+    has_intensity &= slice.intensity_offset >= 0;
+    total_points += num_points;
+    const rclcpp::Time stamp(cloud.header.stamp);
+    if (slices.empty() || stamp < oldest_stamp) {
+      oldest_stamp = stamp;
+    }
+    slices.push_back(slice);
+  }
+
+  if (slices.empty()) {
+    return nullptr;
+  }
+
+  // Preallocate the whole output so that every input is written into its own slice
+  auto output = std::make_unique<PointCloud2>();
+  output->header.frame_id = output_frame_;
+  output->header.stamp = oldest_stamp;
+  output->height = 1;
+  output->width = static_cast<uint32_t>(total_points);
+  output->is_bigendian = false;
+  output->is_dense = std::all_of(
+    std::begin(slices), std::end(slices), [](const auto & s) { return s.cloud->is_dense; });
+
+  uint32_t point_step = 0;
+  const auto addField = [&output, &point_step](const std::string & name) {
+    sensor_msgs::msg::PointField field;
+    field.name = name;
+    field.offset = point_step;
+    field.datatype = sensor_msgs::msg::PointField::FLOAT32;
+    field.count = 1;
+    output->fields.push_back(field);
+    point_step += sizeof(float);
+  };
+  addField("x");
+  addField("y");
+  addField("z");
+  if (has_intensity) {
+    addField("intensity");
   }
+  output->point_step = point_step;
+  output->row_step = point_step * output->width;
+  output->data.resize(static_cast<size_t>(output->row_step));
+
+  uint8_t * dst = output->data.data();
+  for (const auto & slice : slices) {
+    // Combine the sensor-to-output transform and the ego-motion correction into one matrix
+    const rclcpp::Time stamp(slice.cloud->header.stamp);
+    const Eigen::Matrix4f transform =
+      computeTransformToAdjustForOldTimestamp(oldest_stamp, stamp) * slice.transform;
+
+    const auto & cloud = *slice.cloud;
+    const size_t num_points = static_cast<size_t>(cloud.width) * cloud.height;
+    const uint8_t * src = cloud.data.data();
+    for (size_t i = 0; i < num_points; ++i, src += cloud.point_step, dst += point_step) {
+      Eigen::Vector4f p;
+      std::memcpy(&p[0], src + slice.x_offset, sizeof(float));
+      std::memcpy(&p[1], src + slice.y_offset, sizeof(float));
+      std::memcpy(&p[2], src + slice.z_offset, sizeof(float));
+      p[3] = 1.0f;
+      // Eigen evaluates the 4x4 product with packet (SSE/NEON) instructions
+      const Eigen::Vector4f p_out = transform * p;
+      std::memcpy(dst, p_out.data(), 3 * sizeof(float));
+      if (has_intensity) {
+        std::memcpy(dst + 3 * sizeof(float), src + slice.intensity_offset, sizeof(float));
+      }
+    }
+  }
+
+  return output;
 }
 
 void PointCloudConcatenateDataSynchronizerComponent::publish()
@@ -264,6 +439,23 @@ void PointCloudConcatenateDataSynchronizerComponent::publish()
   sensor_msgs::msg::PointCloud2::SharedPtr concat_cloud_ptr_ = nullptr;
   not_subscribed_topic_names_.clear();
 
+  if (use_single_pass_concatenation_) {
+    auto output = concatenateCloudsSinglePass();
+    if (output) {
+      pub_output_->publish(std::move(output));
+    } else {
+      RCLCPP_WARN(this->get_logger(), "No valid input cloud, skipping pointcloud publish.");
+    }
+
+    updater_.force_update();
+
+    cloud_stdmap_ = cloud_stdmap_tmp_;
+    std::for_each(std::begin(cloud_stdmap_tmp_), std::end(cloud_stdmap_tmp_), [](auto & e) {
+      e.second = nullptr;
+    });
+    return;
+  }
+
   for (const auto & e : cloud_stdmap_) {
     if (e.second != nullptr) {
       sensor_msgs::msg::PointCloud2::SharedPtr transformed_cloud_ptr(
@@ -282,7 +474,8 @@ void PointCloudConcatenateDataSynchronizerComponent::publish()
   }
 
   if (concat_cloud_ptr_) {
-    auto output = std::make_unique<sensor_msgs::msg::PointCloud2>(*concat_cloud_ptr_);
+    // the concatenated cloud is only referenced here, so it is moved into the message
+    auto output = std::make_unique<sensor_msgs::msg::PointCloud2>(std::move(*concat_cloud_ptr_));
     pub_output_->publish(std::move(output));
   } else {
     RCLCPP_WARN(this->get_logger(), "concat_cloud_ptr_ is nullptr, skipping pointcloud publish.");
@@ -341,10 +534,13 @@ void PointCloudConcatenateDataSynchronizerComponent::cloud_callback(
 {
   std::lock_guard<std::mutex> lock(mutex_);
 
-  sensor_msgs::msg::PointCloud2 xyz_cloud;
-  removeRADTFields(*input_ptr, xyz_cloud);
-  sensor_msgs::msg::PointCloud2::ConstSharedPtr xyz_input_ptr(
-    new sensor_msgs::msg::PointCloud2(xyz_cloud));
+  // The single pass concatenation reads x/y/z/intensity in place, so no intermediate copy is needed
+  sensor_msgs::msg::PointCloud2::ConstSharedPtr xyz_input_ptr = input_ptr;
+  if (!use_single_pass_concatenation_) {
+    sensor_msgs::msg::PointCloud2 xyz_cloud;
+    removeRADTFields(*input_ptr, xyz_cloud);
+    xyz_input_ptr = std::make_shared<sensor_msgs::msg::PointCloud2>(xyz_cloud);
+  }
 
   const bool is_already_subscribed_this = (cloud_stdmap_[topic_name] != nullptr);
   const bool is_already_subscribed_tmp = std::any_of(
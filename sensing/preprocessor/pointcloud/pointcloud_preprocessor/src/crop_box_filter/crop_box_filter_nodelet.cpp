@@ -55,6 +55,21 @@
 
 namespace pointcloud_preprocessor
 {
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+namespace
+{
+void setBox(
+  cuda::CropBoxFilterCuda & gpu_impl, const pcl::CropBox<pcl::PCLPointCloud2> & cpu_impl)
+{
+  const Eigen::Vector4f min_point = cpu_impl.getMin();
+  const Eigen::Vector4f max_point = cpu_impl.getMax();
+  const float min[3] = {min_point(0), min_point(1), min_point(2)};
+  const float max[3] = {max_point(0), max_point(1), max_point(2)};
+  gpu_impl.setBox(min, max, cpu_impl.getNegative());
+}
+}  // namespace
+#endif
+
 CropBoxFilterComponent::CropBoxFilterComponent(const rclcpp::NodeOptions & options)
 : Filter("CropBoxFilter", options)
 {
@@ -74,8 +89,20 @@ CropBoxFilterComponent::CropBoxFilterComponent(const rclcpp::NodeOptions & optio
 
     impl_.setKeepOrganized(static_cast<bool>(declare_parameter("keep_organized", false)));
     impl_.setNegative(static_cast<bool>(declare_parameter("negative", false)));
+    use_gpu_ = static_cast<bool>(declare_parameter("use_gpu", false));
   }
 
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+  if (use_gpu_) {
+    gpu_impl_ = std::make_unique<cuda::CropBoxFilterCuda>();
+    setBox(*gpu_impl_, impl_);
+  }
+#else
+  if (use_gpu_) {
+    RCLCPP_WARN(get_logger(), "use_gpu is set but CUDA is not available, running on the CPU.");
+  }
+#endif
+
   // set additional publishers
   {
     crop_box_polygon_pub_ =
@@ -94,6 +121,14 @@ void CropBoxFilterComponent::filter(
   const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output)
 {
   boost::mutex::scoped_lock lock(mutex_);
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+  // keep_organized and indices are only supported by the CPU implementation
+  if (use_gpu_ && !indices && !impl_.getKeepOrganized() && filterOnGpu(input, output)) {
+    publishCropBoxPolygon();
+    return;
+  }
+#endif
+
   pcl::PCLPointCloud2::Ptr pcl_input(new pcl::PCLPointCloud2);
   pcl_conversions::toPCL(*(input), *(pcl_input));
   impl_.setInputCloud(pcl_input);
@@ -105,6 +140,32 @@ void CropBoxFilterComponent::filter(
   publishCropBoxPolygon();
 }
 
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+bool CropBoxFilterComponent::filterOnGpu(const PointCloud2ConstPtr & input, PointCloud2 & output)
+{
+  cuda::XYZOffsets offsets;
+  if (
+    !gpu_impl_ || !cuda::getXYZOffsets(*input, offsets) ||
+    input->row_step != input->width * input->point_step) {
+    return false;
+  }
+  const size_t num_points = static_cast<size_t>(input->width) * input->height;
+  const size_t num_output = gpu_impl_->filter(
+    input->data.data(), num_points, input->point_step, offsets, gpu_output_buffer_);
+
+  output.header = input->header;
+  output.fields = input->fields;
+  output.is_bigendian = input->is_bigendian;
+  output.point_step = input->point_step;
+  output.height = 1;
+  output.width = static_cast<uint32_t>(num_output);
+  output.row_step = output.width * output.point_step;
+  output.is_dense = true;
+  output.data.swap(gpu_output_buffer_);
+  return true;
+}
+#endif
+
 void CropBoxFilterComponent::publishCropBoxPolygon()
 {
   auto generatePoint = [](double x, double y, double z) {
@@ -218,6 +279,12 @@ rcl_interfaces::msg::SetParametersResult CropBoxFilterComponent::paramCallback(
     }
   }
 
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+  if (gpu_impl_) {
+    setBox(*gpu_impl_, impl_);
+  }
+#endif
+
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
   result.reason = "success";
@@ -0,0 +1,338 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/cuda/cuda_filters.hpp"
+
+#include <cuda_runtime_api.h>
+#include <thrust/copy.h>
+#include <thrust/device_ptr.h>
+#include <thrust/execution_policy.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/constant_iterator.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/reduce.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/tuple.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#define CHECK_CUDA_ERROR(e) (checkCudaError(e, __FILE__, __LINE__))
+
+namespace pointcloud_preprocessor
+{
+namespace cuda
+{
+namespace
+{
+constexpr int BLOCK_SIZE = 256;
+constexpr uint64_t INVALID_VOXEL_KEY = ~uint64_t{0};
+
+void checkCudaError(const cudaError_t e, const char * f, int n)
+{
+  if (e != cudaSuccess) {
+    std::stringstream s;
+    s << cudaGetErrorName(e) << " (" << e << ")@" << f << "#L" << n << ": "
+      << cudaGetErrorString(e);
+    throw std::runtime_error{s.str()};
+  }
+}
+
+/** \brief Device buffer that only grows, so it is reused across frames. */
+template <typename T>
+class DeviceBuffer
+{
+public:
+  ~DeviceBuffer() { cudaFree(data_); }
+
+  T * reserve(const size_t size)
+  {
+    if (size > capacity_) {
+      CHECK_CUDA_ERROR(cudaFree(data_));
+      data_ = nullptr;
+      CHECK_CUDA_ERROR(cudaMalloc(reinterpret_cast<void **>(&data_), sizeof(T) * size));
+      capacity_ = size;
+    }
+    return data_;
+  }
+
+  T * get() const { return data_; }
+
+private:
+  T * data_{nullptr};
+  size_t capacity_{0};
+};
+
+__device__ bool loadXYZ(const uint8_t * point, const XYZOffsets offsets, float3 & xyz)
+{
+  memcpy(&xyz.x, point + offsets.x, sizeof(float));
+  memcpy(&xyz.y, point + offsets.y, sizeof(float));
+  memcpy(&xyz.z, point + offsets.z, sizeof(float));
+  return isfinite(xyz.x) && isfinite(xyz.y) && isfinite(xyz.z);
+}
+
+__global__ void cropBoxMaskKernel(
+  const uint8_t * points, const size_t num_points, const uint32_t point_step,
+  const XYZOffsets offsets, const float3 min, const float3 max, const bool negative,
+  uint8_t * mask)
+{
+  const size_t i = blockIdx.x * static_cast<size_t>(blockDim.x) + threadIdx.x;
+  if (i >= num_points) {
+    return;
+  }
+  float3 p;
+  if (!loadXYZ(points + i * point_step, offsets, p)) {
+    mask[i] = 0;
+    return;
+  }
+  const bool inside = min.x <= p.x && p.x <= max.x && min.y <= p.y && p.y <= max.y &&
+                      min.z <= p.z && p.z <= max.z;
+  mask[i] = inside != negative;
+}
+
+__global__ void gatherPointsKernel(
+  const uint8_t * points, const uint32_t point_step, const uint32_t * indices,
+  const size_t num_indices, uint8_t * output)
+{
+  const size_t i = blockIdx.x * static_cast<size_t>(blockDim.x) + threadIdx.x;
+  if (i >= num_indices) {
+    return;
+  }
+  memcpy(
+    output + i * point_step, points + indices[i] * static_cast<size_t>(point_step), point_step);
+}
+
+__global__ void voxelKeyKernel(
+  const uint8_t * points, const size_t num_points, const uint32_t point_step,
+  const XYZOffsets offsets, const float3 inverse_leaf_size, float * x, float * y, float * z,
+  uint64_t * keys)
+{
+  const size_t i = blockIdx.x * static_cast<size_t>(blockDim.x) + threadIdx.x;
+  if (i >= num_points) {
+    return;
+  }
+  float3 p;
+  if (!loadXYZ(points + i * point_step, offsets, p)) {
+    keys[i] = INVALID_VOXEL_KEY;
+    x[i] = y[i] = z[i] = 0.0f;
+    return;
+  }
+  constexpr uint64_t mask = (uint64_t{1} << 21) - 1;
+  const auto ix = static_cast<int64_t>(floorf(p.x * inverse_leaf_size.x));
+  const auto iy = static_cast<int64_t>(floorf(p.y * inverse_leaf_size.y));
+  const auto iz = static_cast<int64_t>(floorf(p.z * inverse_leaf_size.z));
+  keys[i] = ((static_cast<uint64_t>(ix) & mask) << 42) |
+            ((static_cast<uint64_t>(iy) & mask) << 21) | (static_cast<uint64_t>(iz) & mask);
+  x[i] = p.x;
+  y[i] = p.y;
+  z[i] = p.z;
+}
+
+__global__ void centroidKernel(
+  const float * sum_x, const float * sum_y, const float * sum_z, const uint32_t * counts,
+  const size_t num_voxels, float * output)
+{
+  const size_t i = blockIdx.x * static_cast<size_t>(blockDim.x) + threadIdx.x;
+  if (i >= num_voxels) {
+    return;
+  }
+  output[3 * i] = sum_x[i] / counts[i];
+  output[3 * i + 1] = sum_y[i] / counts[i];
+  output[3 * i + 2] = sum_z[i] / counts[i];
+}
+
+struct TupleSum
+{
+  using Tuple = thrust::tuple<float, float, float, uint32_t>;
+  __host__ __device__ Tuple operator()(const Tuple & a, const Tuple & b) const
+  {
+    return Tuple{
+      thrust::get<0>(a) + thrust::get<0>(b), thrust::get<1>(a) + thrust::get<1>(b),
+      thrust::get<2>(a) + thrust::get<2>(b), thrust::get<3>(a) + thrust::get<3>(b)};
+  }
+};
+
+int gridSize(const size_t n) { return static_cast<int>((n + BLOCK_SIZE - 1) / BLOCK_SIZE); }
+}  // namespace
+
+struct CropBoxFilterCuda::Impl
+{
+  cudaStream_t stream{nullptr};
+  float3 min{-1.0f, -1.0f, -1.0f};
+  float3 max{1.0f, 1.0f, 1.0f};
+  bool negative{false};
+
+  DeviceBuffer<uint8_t> points;
+  DeviceBuffer<uint8_t> mask;
+  DeviceBuffer<uint32_t> indices;
+  DeviceBuffer<uint8_t> output;
+};
+
+CropBoxFilterCuda::CropBoxFilterCuda() : impl_(new Impl)
+{
+  CHECK_CUDA_ERROR(cudaStreamCreate(&impl_->stream));
+}
+
+CropBoxFilterCuda::~CropBoxFilterCuda() { cudaStreamDestroy(impl_->stream); }
+
+void CropBoxFilterCuda::setBox(const float min[3], const float max[3], const bool negative)
+{
+  impl_->min = make_float3(min[0], min[1], min[2]);
+  impl_->max = make_float3(max[0], max[1], max[2]);
+  impl_->negative = negative;
+}
+
+size_t CropBoxFilterCuda::filter(
+  const uint8_t * points, const size_t num_points, const uint32_t point_step,
+  const XYZOffsets & offsets, std::vector<uint8_t> & output)
+{
+  output.clear();
+  if (num_points == 0) {
+    return 0;
+  }
+  auto & s = *impl_;
+  uint8_t * d_points = s.points.reserve(num_points * point_step);
+  uint8_t * d_mask = s.mask.reserve(num_points);
+  uint32_t * d_indices = s.indices.reserve(num_points);
+  uint8_t * d_output = s.output.reserve(num_points * point_step);
+
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    d_points, points, num_points * point_step, cudaMemcpyHostToDevice, s.stream));
+  cropBoxMaskKernel<<<gridSize(num_points), BLOCK_SIZE, 0, s.stream>>>(
+    d_points, num_points, point_step, offsets, s.min, s.max, s.negative, d_mask);
+  CHECK_CUDA_ERROR(cudaGetLastError());
+
+  // stream compaction keeps the input order
+  const auto indices_end = thrust::copy_if(
+    thrust::cuda::par.on(s.stream), thrust::counting_iterator<uint32_t>(0),
+    thrust::counting_iterator<uint32_t>(static_cast<uint32_t>(num_points)),
+    thrust::device_pointer_cast(d_mask), thrust::device_pointer_cast(d_indices),
+    thrust::identity<uint8_t>());
+  const size_t num_output = indices_end - thrust::device_pointer_cast(d_indices);
+
+  if (num_output > 0) {
+    gatherPointsKernel<<<gridSize(num_output), BLOCK_SIZE, 0, s.stream>>>(
+      d_points, point_step, d_indices, num_output, d_output);
+    CHECK_CUDA_ERROR(cudaGetLastError());
+    output.resize(num_output * point_step);
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      output.data(), d_output, output.size(), cudaMemcpyDeviceToHost, s.stream));
+  }
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(s.stream));
+  return num_output;
+}
+
+struct VoxelGridDownsampleCuda::Impl
+{
+  cudaStream_t stream{nullptr};
+  float3 inverse_leaf_size{1.0f, 1.0f, 1.0f};
+
+  DeviceBuffer<uint8_t> points;
+  DeviceBuffer<float> x, y, z;
+  DeviceBuffer<uint64_t> keys;
+  DeviceBuffer<uint32_t> order;
+  DeviceBuffer<uint64_t> voxel_keys;
+  DeviceBuffer<float> sum_x, sum_y, sum_z;
+  DeviceBuffer<uint32_t> counts;
+  DeviceBuffer<float> output;
+};
+
+VoxelGridDownsampleCuda::VoxelGridDownsampleCuda() : impl_(new Impl)
+{
+  CHECK_CUDA_ERROR(cudaStreamCreate(&impl_->stream));
+}
+
+VoxelGridDownsampleCuda::~VoxelGridDownsampleCuda() { cudaStreamDestroy(impl_->stream); }
+
+void VoxelGridDownsampleCuda::setLeafSize(const float lx, const float ly, const float lz)
+{
+  impl_->inverse_leaf_size = make_float3(1.0f / lx, 1.0f / ly, 1.0f / lz);
+}
+
+size_t VoxelGridDownsampleCuda::filter(
+  const uint8_t * points, const size_t num_points, const uint32_t point_step,
+  const XYZOffsets & offsets, std::vector<float> & output)
+{
+  output.clear();
+  if (num_points == 0) {
+    return 0;
+  }
+  auto & s = *impl_;
+  uint8_t * d_points = s.points.reserve(num_points * point_step);
+  float * d_x = s.x.reserve(num_points);
+  float * d_y = s.y.reserve(num_points);
+  float * d_z = s.z.reserve(num_points);
+  uint64_t * d_keys = s.keys.reserve(num_points);
+  uint32_t * d_order = s.order.reserve(num_points);
+  uint64_t * d_voxel_keys = s.voxel_keys.reserve(num_points);
+  float * d_sum_x = s.sum_x.reserve(num_points);
+  float * d_sum_y = s.sum_y.reserve(num_points);
+  float * d_sum_z = s.sum_z.reserve(num_points);
+  uint32_t * d_counts = s.counts.reserve(num_points);
+  float * d_output = s.output.reserve(3 * num_points);
+
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    d_points, points, num_points * point_step, cudaMemcpyHostToDevice, s.stream));
+  voxelKeyKernel<<<gridSize(num_points), BLOCK_SIZE, 0, s.stream>>>(
+    d_points, num_points, point_step, offsets, s.inverse_leaf_size, d_x, d_y, d_z, d_keys);
+  CHECK_CUDA_ERROR(cudaGetLastError());
+
+  const auto policy = thrust::cuda::par.on(s.stream);
+  const auto keys = thrust::device_pointer_cast(d_keys);
+  const auto order = thrust::device_pointer_cast(d_order);
+  thrust::sequence(policy, order, order + num_points);
+  thrust::sort_by_key(policy, keys, keys + num_points, order);
+
+  const auto values = thrust::make_zip_iterator(thrust::make_tuple(
+    thrust::make_permutation_iterator(thrust::device_pointer_cast(d_x), order),
+    thrust::make_permutation_iterator(thrust::device_pointer_cast(d_y), order),
+    thrust::make_permutation_iterator(thrust::device_pointer_cast(d_z), order),
+    thrust::make_constant_iterator<uint32_t>(1)));
+  const auto sums = thrust::make_zip_iterator(thrust::make_tuple(
+    thrust::device_pointer_cast(d_sum_x), thrust::device_pointer_cast(d_sum_y),
+    thrust::device_pointer_cast(d_sum_z), thrust::device_pointer_cast(d_counts)));
+  const auto voxel_keys = thrust::device_pointer_cast(d_voxel_keys);
+  const auto ends = thrust::reduce_by_key(
+    policy, keys, keys + num_points, values, voxel_keys, sums, thrust::equal_to<uint64_t>(),
+    TupleSum());
+  size_t num_voxels = ends.first - voxel_keys;
+
+  // invalid points have the largest key, so they end up in the last voxel
+  uint64_t last_key = 0;
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    &last_key, d_voxel_keys + num_voxels - 1, sizeof(uint64_t), cudaMemcpyDeviceToHost,
+    s.stream));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(s.stream));
+  if (last_key == INVALID_VOXEL_KEY) {
+    --num_voxels;
+  }
+  if (num_voxels == 0) {
+    return 0;
+  }
+
+  centroidKernel<<<gridSize(num_voxels), BLOCK_SIZE, 0, s.stream>>>(
+    d_sum_x, d_sum_y, d_sum_z, d_counts, num_voxels, d_output);
+  CHECK_CUDA_ERROR(cudaGetLastError());
+  output.resize(3 * num_voxels);
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    output.data(), d_output, output.size() * sizeof(float), cudaMemcpyDeviceToHost, s.stream));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(s.stream));
+  return num_voxels;
+}
+}  // namespace cuda
+}  // namespace pointcloud_preprocessor
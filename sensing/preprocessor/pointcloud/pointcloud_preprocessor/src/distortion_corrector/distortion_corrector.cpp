@@ -14,6 +14,7 @@
 
 #include "pointcloud_preprocessor/distortion_corrector/distortion_corrector.hpp"
 
+#include <algorithm>
 #include <deque>
 #include <string>
 #include <utility>
@@ -26,6 +27,7 @@ DistortionCorrectorComponent::DistortionCorrectorComponent(const rclcpp::NodeOpt
 {
   // Parameter
   time_stamp_field_name_ = declare_parameter("time_stamp_field_name", "time_stamp");
+  time_slice_sec_ = declare_parameter("time_slice_sec", 0.0);
 
   // Publisher
   undistorted_points_pub_ =
@@ -125,6 +127,15 @@ bool DistortionCorrectorComponent::undistortPointCloud(
     return false;
   }
 
+  if (time_slice_sec_ > 0.0) {
+    if (undistortPointCloudByTimeSlice(twist_queue, tf2_base_link_to_sensor, points)) {
+      return true;
+    }
+    RCLCPP_DEBUG_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "Time stamps are not monotonic, fall back to per point undistortion.");
+  }
+
   sensor_msgs::PointCloud2Iterator<float> it_x(points, "x");
   sensor_msgs::PointCloud2Iterator<float> it_y(points, "y");
   sensor_msgs::PointCloud2Iterator<float> it_z(points, "z");
@@ -192,6 +203,128 @@ bool DistortionCorrectorComponent::undistortPointCloud(
   return true;
 }
 
+bool DistortionCorrectorComponent::undistortPointCloudByTimeSlice(
+  const std::deque<TwistStamped> & twist_queue, const tf2::Transform & tf2_base_link_to_sensor,
+  PointCloud2 & points)
+{
+  const size_t num_points = static_cast<size_t>(points.width) * points.height;
+
+  // gather the time stamps and reject clouds that are not ordered in time
+  time_stamp_buf_.resize(num_points);
+  {
+    sensor_msgs::PointCloud2ConstIterator<double> it_time_stamp(points, time_stamp_field_name_);
+    for (size_t i = 0; i < num_points; ++i, ++it_time_stamp) {
+      time_stamp_buf_[i] = *it_time_stamp;
+      if (i > 0 && time_stamp_buf_[i] < time_stamp_buf_[i - 1]) {
+        return false;
+      }
+    }
+  }
+
+  // gather x/y/z into contiguous arrays
+  x_buf_.resize(num_points);
+  y_buf_.resize(num_points);
+  z_buf_.resize(num_points);
+  {
+    sensor_msgs::PointCloud2ConstIterator<float> it_x(points, "x");
+    sensor_msgs::PointCloud2ConstIterator<float> it_y(points, "y");
+    sensor_msgs::PointCloud2ConstIterator<float> it_z(points, "z");
+    for (size_t i = 0; i < num_points; ++i, ++it_x, ++it_y, ++it_z) {
+      x_buf_[i] = *it_x;
+      y_buf_[i] = *it_y;
+      z_buf_[i] = *it_z;
+    }
+  }
+
+  float theta{0.0f};
+  float x{0.0f};
+  float y{0.0f};
+  double prev_time_stamp_sec{time_stamp_buf_.front()};
+
+  auto twist_it = std::lower_bound(
+    std::begin(twist_queue), std::end(twist_queue), time_stamp_buf_.front(),
+    [](const TwistStamped & x, const double t) {
+      return rclcpp::Time(x.header.stamp).seconds() < t;
+    });
+  twist_it = twist_it == std::end(twist_queue) ? std::end(twist_queue) - 1 : twist_it;
+
+  const tf2::Transform tf2_base_link_to_sensor_inv{tf2_base_link_to_sensor.inverse()};
+  for (size_t begin = 0; begin < num_points;) {
+    size_t end = begin + 1;
+    while (end < num_points && time_stamp_buf_[end] - time_stamp_buf_[begin] < time_slice_sec_) {
+      ++end;
+    }
+    // use the middle of the slice to halve the time error at its ends
+    const double slice_time_stamp_sec = 0.5 * (time_stamp_buf_[begin] + time_stamp_buf_[end - 1]);
+
+    for (;
+         (twist_it != std::end(twist_queue) - 1 &&
+          slice_time_stamp_sec > rclcpp::Time(twist_it->header.stamp).seconds());
+         ++twist_it) {
+    }
+
+    float v{static_cast<float>(twist_it->twist.linear.x)};
+    float w{static_cast<float>(twist_it->twist.angular.z)};
+
+    if (std::abs(slice_time_stamp_sec - rclcpp::Time(twist_it->header.stamp).seconds()) > 0.1) {
+      RCLCPP_WARN_STREAM_THROTTLE(
+        get_logger(), *get_clock(), 10000 /* ms */,
+        "Twist time_stamp is too late. Cloud not interpolate.");
+      v = 0.0f;
+      w = 0.0f;
+    }
+
+    const float time_offset = static_cast<float>(slice_time_stamp_sec - prev_time_stamp_sec);
+    theta += w * time_offset;
+    tf2::Quaternion baselink_quat{};
+    baselink_quat.setRPY(0.0, 0.0, theta);
+    const float dis = v * time_offset;
+    x += dis * std::cos(theta);
+    y += dis * std::sin(theta);
+    prev_time_stamp_sec = slice_time_stamp_sec;
+
+    tf2::Transform baselinkTF_odom{};
+    baselinkTF_odom.setOrigin(tf2::Vector3(x, y, 0.0));
+    baselinkTF_odom.setRotation(baselink_quat);
+
+    // one rigid transform for the whole slice, in the sensor frame
+    const tf2::Transform sensorTF_trans{
+      tf2_base_link_to_sensor * baselinkTF_odom * tf2_base_link_to_sensor_inv};
+    const tf2::Matrix3x3 & basis = sensorTF_trans.getBasis();
+    const tf2::Vector3 & origin = sensorTF_trans.getOrigin();
+    const float r00 = basis[0][0], r01 = basis[0][1], r02 = basis[0][2];
+    const float r10 = basis[1][0], r11 = basis[1][1], r12 = basis[1][2];
+    const float r20 = basis[2][0], r21 = basis[2][1], r22 = basis[2][2];
+    const float t0 = origin.getX(), t1 = origin.getY(), t2 = origin.getZ();
+
+    // branch-free loop over contiguous arrays so that the compiler vectorizes it
+    float * const px = x_buf_.data();
+    float * const py = y_buf_.data();
+    float * const pz = z_buf_.data();
+    for (size_t i = begin; i < end; ++i) {
+      const float sx = px[i];
+      const float sy = py[i];
+      const float sz = pz[i];
+      px[i] = r00 * sx + r01 * sy + r02 * sz + t0;
+      py[i] = r10 * sx + r11 * sy + r12 * sz + t1;
+      pz[i] = r20 * sx + r21 * sy + r22 * sz + t2;
+    }
+
+    begin = end;
+  }
+
+  // scatter x/y/z back into the message
+  sensor_msgs::PointCloud2Iterator<float> it_x(points, "x");
+  sensor_msgs::PointCloud2Iterator<float> it_y(points, "y");
+  sensor_msgs::PointCloud2Iterator<float> it_z(points, "z");
+  for (size_t i = 0; i < num_points; ++i, ++it_x, ++it_y, ++it_z) {
+    *it_x = x_buf_[i];
+    *it_y = y_buf_[i];
+    *it_z = z_buf_[i];
+  }
+  return true;
+}
+
 }  // namespace pointcloud_preprocessor
 
 #include <rclcpp_components/register_node_macro.hpp>
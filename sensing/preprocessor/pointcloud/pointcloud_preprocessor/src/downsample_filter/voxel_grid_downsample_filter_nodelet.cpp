@@ -67,8 +67,20 @@ VoxelGridDownsampleFilterComponent::VoxelGridDownsampleFilterComponent(
     voxel_size_x_ = static_cast<double>(declare_parameter("voxel_size_x", 0.3));
     voxel_size_y_ = static_cast<double>(declare_parameter("voxel_size_y", 0.3));
     voxel_size_z_ = static_cast<double>(declare_parameter("voxel_size_z", 0.1));
+    use_hash_map_ = static_cast<bool>(declare_parameter("use_hash_map", false));
+    use_gpu_ = static_cast<bool>(declare_parameter("use_gpu", false));
   }
 
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+  if (use_gpu_) {
+    gpu_impl_ = std::make_unique<cuda::VoxelGridDownsampleCuda>();
+  }
+#else
+  if (use_gpu_) {
+    RCLCPP_WARN(get_logger(), "use_gpu is set but CUDA is not available, running on the CPU.");
+  }
+#endif
+
   using std::placeholders::_1;
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&VoxelGridDownsampleFilterComponent::paramCallback, this, _1));
@@ -78,20 +90,62 @@ void VoxelGridDownsampleFilterComponent::filter(
   const PointCloud2ConstPtr & input, const IndicesPtr & /*indices*/, PointCloud2 & output)
 {
   boost::mutex::scoped_lock lock(mutex_);
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+  if (use_gpu_ && filterOnGpu(input, output)) {
+    return;
+  }
+#endif
+
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_input(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(*input, *pcl_input);
   pcl_output->points.reserve(pcl_input->points.size());
-  pcl::VoxelGrid<pcl::PointXYZ> filter;
-  filter.setInputCloud(pcl_input);
-  // filter.setSaveLeafLayout(true);
-  filter.setLeafSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
-  filter.filter(*pcl_output);
+  if (use_hash_map_) {
+    hash_map_filter_.setLeafSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
+    hash_map_filter_.filter(*pcl_input, *pcl_output);
+  } else {
+    pcl::VoxelGrid<pcl::PointXYZ> filter;
+    filter.setInputCloud(pcl_input);
+    // filter.setSaveLeafLayout(true);
+    filter.setLeafSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
+    filter.filter(*pcl_output);
+  }
 
   pcl::toROSMsg(*pcl_output, output);
   output.header = input->header;
 }
 
+#ifdef POINTCLOUD_PREPROCESSOR_USE_CUDA
+bool VoxelGridDownsampleFilterComponent::filterOnGpu(
+  const PointCloud2ConstPtr & input, PointCloud2 & output)
+{
+  cuda::XYZOffsets offsets;
+  if (
+    !gpu_impl_ || !cuda::getXYZOffsets(*input, offsets) ||
+    input->row_step != input->width * input->point_step) {
+    return false;
+  }
+  gpu_impl_->setLeafSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
+  const size_t num_points = static_cast<size_t>(input->width) * input->height;
+  const size_t num_output = gpu_impl_->filter(
+    input->data.data(), num_points, input->point_step, offsets, gpu_output_buffer_);
+
+  pcl::PointCloud<pcl::PointXYZ> pcl_output;
+  pcl_output.points.resize(num_output);
+  for (size_t i = 0; i < num_output; ++i) {
+    pcl_output.points[i].x = gpu_output_buffer_[3 * i];
+    pcl_output.points[i].y = gpu_output_buffer_[3 * i + 1];
+    pcl_output.points[i].z = gpu_output_buffer_[3 * i + 2];
+  }
+  pcl_output.width = static_cast<uint32_t>(num_output);
+  pcl_output.height = 1;
+
+  pcl::toROSMsg(pcl_output, output);
+  output.header = input->header;
+  return true;
+}
+#endif
+
 rcl_interfaces::msg::SetParametersResult VoxelGridDownsampleFilterComponent::paramCallback(
   const std::vector<rclcpp::Parameter> & p)
 {
@@ -52,9 +52,13 @@
 #include "pointcloud_preprocessor/filter.hpp"
 
 #include <pcl_ros/transforms.hpp>
+#include <tf2_eigen/tf2_eigen.h>
+
+#include <autoware_debug_msgs/msg/float64_stamped.hpp>
 
 #include <pcl/io/io.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -75,6 +79,7 @@ pointcloud_preprocessor::Filter::Filter(
     use_indices_ = static_cast<bool>(declare_parameter("use_indices", false));
     latched_indices_ = static_cast<bool>(declare_parameter("latched_indices", false));
     approximate_sync_ = static_cast<bool>(declare_parameter("approximate_sync", false));
+    has_static_tf_only_ = static_cast<bool>(declare_parameter("has_static_tf_only", false));
 
     RCLCPP_INFO_STREAM(
       this->get_logger(),
@@ -83,6 +88,7 @@ pointcloud_preprocessor::Filter::Filter(
         << " - approximate_sync : " << (approximate_sync_ ? "true" : "false") << std::endl
         << " - use_indices      : " << (use_indices_ ? "true" : "false") << std::endl
         << " - latched_indices  : " << (latched_indices_ ? "true" : "false") << std::endl
+        << " - has_static_tf_only : " << (has_static_tf_only_ ? "true" : "false") << std::endl
         << " - max_queue_size   : " << max_queue_size_);
   }
 
@@ -92,6 +98,12 @@ pointcloud_preprocessor::Filter::Filter(
       "output", rclcpp::SensorDataQoS().keep_last(max_queue_size_));
   }
 
+  // Set diagnostics
+  {
+    updater_.setHardwareID(filter_name);
+    updater_.add("filter_status", this, &Filter::checkFilterStatus);
+  }
+
   subscribe();
 
   // Set tf_listener, tf_buffer.
@@ -137,8 +149,19 @@ void pointcloud_preprocessor::Filter::subscribe()
     // CAN'T use auto-type here.
     std::function<void(const PointCloud2ConstPtr msg)> cb = std::bind(
       &Filter::input_indices_callback, this, std::placeholders::_1, PointIndicesConstPtr());
-    sub_input_ = create_subscription<PointCloud2>(
-      "input", rclcpp::SensorDataQoS().keep_last(max_queue_size_), cb);
+    // count the messages lost in the middleware, if the RMW reports them
+    rclcpp::SubscriptionOptions sub_options;
+    sub_options.event_callbacks.message_lost_callback =
+      std::bind(&Filter::onMessageLost, this, std::placeholders::_1);
+    try {
+      sub_input_ = create_subscription<PointCloud2>(
+        "input", rclcpp::SensorDataQoS().keep_last(max_queue_size_), cb, sub_options);
+      is_message_lost_supported_ = true;
+    } catch (const rclcpp::UnsupportedEventTypeException &) {
+      sub_input_ = create_subscription<PointCloud2>(
+        "input", rclcpp::SensorDataQoS().keep_last(max_queue_size_), cb);
+      is_message_lost_supported_ = false;
+    }
   }
 }
 
@@ -166,7 +189,6 @@ void pointcloud_preprocessor::Filter::computePublish(
   // Call the virtual method in the child
   filter(input, indices, output);
 
-  auto cloud_tf = std::make_unique<PointCloud2>(output);  // set the output by default
   // Check whether the user has given a different output TF frame
   if (!tf_output_frame_.empty() && output.header.frame_id != tf_output_frame_) {
     RCLCPP_DEBUG(
@@ -174,13 +196,13 @@ void pointcloud_preprocessor::Filter::computePublish(
       output.header.frame_id.c_str(), tf_output_frame_.c_str());
     // Convert the cloud into the different frame
     PointCloud2 cloud_transformed;
-    if (!pcl_ros::transformPointCloud(tf_output_frame_, output, cloud_transformed, *tf_buffer_)) {
+    if (!transformPointCloud(tf_output_frame_, output, cloud_transformed)) {
       RCLCPP_ERROR(
         this->get_logger(), "[computePublish] Error converting output dataset from %s to %s.",
         output.header.frame_id.c_str(), tf_output_frame_.c_str());
       return;
     }
-    cloud_tf.reset(new PointCloud2(cloud_transformed));
+    output = std::move(cloud_transformed);
   }
   if (tf_output_frame_.empty() && output.header.frame_id != tf_input_orig_frame_) {
     // no tf_output_frame given, transform the dataset to its original frame
@@ -189,21 +211,109 @@ void pointcloud_preprocessor::Filter::computePublish(
       output.header.frame_id.c_str(), tf_input_orig_frame_.c_str());
     // Convert the cloud into the different frame
     PointCloud2 cloud_transformed;
-    if (!pcl_ros::transformPointCloud(
-          tf_input_orig_frame_, output, cloud_transformed, *tf_buffer_)) {
+    if (!transformPointCloud(tf_input_orig_frame_, output, cloud_transformed)) {
       RCLCPP_ERROR(
         this->get_logger(), "[computePublish] Error converting output dataset from %s back to %s.",
         output.header.frame_id.c_str(), tf_input_orig_frame_.c_str());
       return;
     }
-    cloud_tf.reset(new PointCloud2(cloud_transformed));
+    output = std::move(cloud_transformed);
   }
 
+  // The cloud is moved rather than copied into the message, whose ownership the publisher takes
+  // over, so that subscriptions in the same process get it without a copy
+  auto cloud_tf = std::make_unique<PointCloud2>(std::move(output));
+
   // Copy timestamp to keep it
   cloud_tf->header.stamp = input->header.stamp;
 
-  // Publish a boost shared ptr
   pub_output_->publish(std::move(cloud_tf));
+
+  recordPublished(input->header.stamp);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+bool pointcloud_preprocessor::Filter::transformPointCloud(
+  const std::string & target_frame, const PointCloud2 & input, PointCloud2 & output)
+{
+  if (!has_static_tf_only_) {
+    return pcl_ros::transformPointCloud(target_frame, input, output, *tf_buffer_);
+  }
+
+  const auto key = std::make_pair(target_frame, input.header.frame_id);
+  auto static_transform = static_transforms_.find(key);
+  if (static_transform == static_transforms_.end()) {
+    try {
+      const auto transform_stamped =
+        tf_buffer_->lookupTransform(target_frame, input.header.frame_id, tf2::TimePointZero);
+      const Eigen::Matrix4f transform =
+        tf2::transformToEigen(transform_stamped.transform).matrix().cast<float>();
+      static_transform = static_transforms_.emplace(key, transform).first;
+    } catch (tf2::TransformException & ex) {
+      RCLCPP_ERROR(
+        this->get_logger(), "[transformPointCloud] Error looking up transform from %s to %s: %s",
+        input.header.frame_id.c_str(), target_frame.c_str(), ex.what());
+      return false;
+    }
+  }
+
+  pcl_ros::transformPointCloud(static_transform->second, input, output);
+  output.header.frame_id = target_frame;
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void pointcloud_preprocessor::Filter::onMessageLost(const rclcpp::QOSMessageLostInfo & info)
+{
+  std::lock_guard<std::mutex> lock(statistics_mutex_);
+  statistics_.lost += info.total_count_change;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void pointcloud_preprocessor::Filter::recordPublished(
+  const builtin_interfaces::msg::Time & input_stamp)
+{
+  const double processing_time_ms = stop_watch_.toc();
+  const double latency_ms = (this->now() - rclcpp::Time(input_stamp)).seconds() * 1e3;
+  {
+    std::lock_guard<std::mutex> lock(statistics_mutex_);
+    ++statistics_.published;
+    statistics_.max_latency_ms = std::max(statistics_.max_latency_ms, latency_ms);
+    statistics_.max_processing_time_ms =
+      std::max(statistics_.max_processing_time_ms, processing_time_ms);
+  }
+
+  debug_publisher_.publish<autoware_debug_msgs::msg::Float64Stamped>(
+    "processing_time_ms", processing_time_ms);
+  debug_publisher_.publish<autoware_debug_msgs::msg::Float64Stamped>("latency_ms", latency_ms);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void pointcloud_preprocessor::Filter::checkFilterStatus(
+  diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  FilterStatistics statistics;
+  {
+    std::lock_guard<std::mutex> lock(statistics_mutex_);
+    statistics = statistics_;
+    statistics_ = FilterStatistics();
+  }
+  // a message received right before the previous report may be published in this period
+  const size_t rejected =
+    statistics.received > statistics.published ? statistics.received - statistics.published : 0;
+
+  stat.add("received", statistics.received);
+  stat.add("published", statistics.published);
+  stat.add("rejected", rejected);
+  stat.add("lost", is_message_lost_supported_ ? std::to_string(statistics.lost) : "unsupported");
+  stat.addf("max_latency_ms", "%.3f", statistics.max_latency_ms);
+  stat.addf("max_processing_time_ms", "%.3f", statistics.max_processing_time_ms);
+
+  if (0 < rejected || 0 < statistics.lost) {
+    stat.summary(diagnostic_msgs::msg::DiagnosticStatus::WARN, "input messages were dropped");
+  } else {
+    stat.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "OK");
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -230,6 +340,12 @@ rcl_interfaces::msg::SetParametersResult pointcloud_preprocessor::Filter::filter
 void pointcloud_preprocessor::Filter::input_indices_callback(
   const PointCloud2ConstPtr cloud, const PointIndicesConstPtr indices)
 {
+  stop_watch_.tic();
+  {
+    std::lock_guard<std::mutex> lock(statistics_mutex_);
+    ++statistics_.received;
+  }
+
   // If cloud is given, check if it's valid
   if (!isValid(cloud)) {
     RCLCPP_ERROR(this->get_logger(), "[input_indices_callback] Invalid input!");
@@ -272,23 +388,27 @@ void pointcloud_preprocessor::Filter::input_indices_callback(
     // Convert the cloud into the different frame
     PointCloud2 cloud_transformed;
 
-    if (!tf_buffer_->canTransform(
-          tf_input_frame_, cloud->header.frame_id, this->now(),
-          rclcpp::Duration::from_seconds(1.0))) {
+    const bool is_transform_cached =
+      static_transforms_.count(std::make_pair(tf_input_frame_, cloud->header.frame_id)) > 0;
+    if (
+      !is_transform_cached &&
+      !tf_buffer_->canTransform(
+        tf_input_frame_, cloud->header.frame_id, this->now(),
+        rclcpp::Duration::from_seconds(1.0))) {
       RCLCPP_ERROR_STREAM(
         this->get_logger(), "[input_indices_callback] timeout tf: " << cloud->header.frame_id
                                                                     << "->" << tf_input_frame_);
       return;
     }
 
-    if (!pcl_ros::transformPointCloud(tf_input_frame_, *cloud, cloud_transformed, *tf_buffer_)) {
+    if (!transformPointCloud(tf_input_frame_, *cloud, cloud_transformed)) {
       RCLCPP_ERROR(
         this->get_logger(),
         "[input_indices_callback] Error converting input dataset from %s to %s.",
         cloud->header.frame_id.c_str(), tf_input_frame_.c_str());
       return;
     }
-    cloud_tf = std::make_shared<PointCloud2>(cloud_transformed);
+    cloud_tf = std::make_shared<PointCloud2>(std::move(cloud_transformed));
   } else {
     cloud_tf = cloud;
   }
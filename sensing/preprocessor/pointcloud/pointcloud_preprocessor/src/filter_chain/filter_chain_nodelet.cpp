@@ -0,0 +1,298 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/filter_chain/filter_chain_nodelet.hpp"
+
+#include <tier4_pcl_extensions/voxel_grid_hash_map.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+namespace
+{
+class CropBoxStage : public FilterChainStage
+{
+public:
+  CropBoxStage(rclcpp::Node & node, const std::string & ns)
+  {
+    min_x_ = static_cast<float>(node.declare_parameter(ns + ".min_x", -1.0));
+    min_y_ = static_cast<float>(node.declare_parameter(ns + ".min_y", -1.0));
+    min_z_ = static_cast<float>(node.declare_parameter(ns + ".min_z", -1.0));
+    max_x_ = static_cast<float>(node.declare_parameter(ns + ".max_x", 1.0));
+    max_y_ = static_cast<float>(node.declare_parameter(ns + ".max_y", 1.0));
+    max_z_ = static_cast<float>(node.declare_parameter(ns + ".max_z", 1.0));
+    negative_ = static_cast<bool>(node.declare_parameter(ns + ".negative", false));
+  }
+
+  void apply(PointCloudXYZIRADT & cloud) override
+  {
+    const auto is_removed = [this](const custom_pcl::PointXYZIRADT & p) {
+      const bool inside = min_x_ <= p.x && p.x <= max_x_ && min_y_ <= p.y && p.y <= max_y_ &&
+                          min_z_ <= p.z && p.z <= max_z_;
+      return inside == negative_;
+    };
+    auto & points = cloud.points;
+    points.erase(std::remove_if(points.begin(), points.end(), is_removed), points.end());
+  }
+
+private:
+  float min_x_, min_y_, min_z_;
+  float max_x_, max_y_, max_z_;
+  bool negative_;
+};
+
+/** \brief Several crop boxes in one pass over the points. A point is kept if it is inside every
+ * box whose negative flag is false and outside every other box, the same as cropping with one
+ * box after another. The bounds of a box are in the cloud frame rotated by its yaw.
+ */
+class MultiCropBoxStage : public FilterChainStage
+{
+public:
+  MultiCropBoxStage(rclcpp::Node & node, const std::string & ns)
+  {
+    const auto box_names = node.declare_parameter(ns + ".boxes", std::vector<std::string>{});
+    for (const auto & box_name : box_names) {
+      const auto box_ns = ns + "." + box_name;
+      Box box;
+      box.min_x = static_cast<float>(node.declare_parameter(box_ns + ".min_x", -1.0));
+      box.min_y = static_cast<float>(node.declare_parameter(box_ns + ".min_y", -1.0));
+      box.min_z = static_cast<float>(node.declare_parameter(box_ns + ".min_z", -1.0));
+      box.max_x = static_cast<float>(node.declare_parameter(box_ns + ".max_x", 1.0));
+      box.max_y = static_cast<float>(node.declare_parameter(box_ns + ".max_y", 1.0));
+      box.max_z = static_cast<float>(node.declare_parameter(box_ns + ".max_z", 1.0));
+      const double yaw = node.declare_parameter(box_ns + ".yaw", 0.0);
+      box.cos_yaw = static_cast<float>(std::cos(yaw));
+      box.sin_yaw = static_cast<float>(std::sin(yaw));
+      box.negative = static_cast<bool>(node.declare_parameter(box_ns + ".negative", false));
+      boxes_.push_back(box);
+    }
+  }
+
+  void apply(PointCloudXYZIRADT & cloud) override
+  {
+    const auto is_removed = [this](const custom_pcl::PointXYZIRADT & p) {
+      for (const auto & box : boxes_) {
+        const float x = box.cos_yaw * p.x + box.sin_yaw * p.y;
+        const float y = -box.sin_yaw * p.x + box.cos_yaw * p.y;
+        const bool inside = box.min_x <= x && x <= box.max_x && box.min_y <= y &&
+                            y <= box.max_y && box.min_z <= p.z && p.z <= box.max_z;
+        if (inside == box.negative) {
+          return true;
+        }
+      }
+      return false;
+    };
+    auto & points = cloud.points;
+    points.erase(std::remove_if(points.begin(), points.end(), is_removed), points.end());
+  }
+
+private:
+  struct Box
+  {
+    float min_x, min_y, min_z;
+    float max_x, max_y, max_z;
+    float cos_yaw, sin_yaw;
+    bool negative;
+  };
+
+  std::vector<Box> boxes_;
+};
+
+class RingOutlierStage : public FilterChainStage
+{
+public:
+  RingOutlierStage(rclcpp::Node & node, const std::string & ns)
+  {
+    distance_ratio_ = static_cast<double>(node.declare_parameter(ns + ".distance_ratio", 1.03));
+    object_length_threshold_ =
+      static_cast<double>(node.declare_parameter(ns + ".object_length_threshold", 0.1));
+    num_points_threshold_ =
+      static_cast<int>(node.declare_parameter(ns + ".num_points_threshold", 4));
+  }
+
+  void apply(PointCloudXYZIRADT & cloud) override
+  {
+    const auto & points = cloud.points;
+    for (auto & ring : ring_indices_) {
+      ring.clear();
+    }
+    for (size_t i = 0; i < points.size(); ++i) {
+      if (points[i].ring >= ring_indices_.size()) {
+        ring_indices_.resize(points[i].ring + 1);
+      }
+      ring_indices_[points[i].ring].push_back(i);
+    }
+
+    keep_.assign(points.size(), false);
+    for (const auto & ring : ring_indices_) {
+      if (ring.size() < 2) {
+        continue;
+      }
+      size_t walk_begin = 0;
+      for (size_t j = 0; j + 1 < ring.size(); ++j) {
+        const auto & p = points[ring[j]];
+        const auto & next = points[ring[j + 1]];
+        const float min_dist = std::min(p.distance, next.distance);
+        const float max_dist = std::max(p.distance, next.distance);
+        float azimuth_diff = next.azimuth - p.azimuth;
+        azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
+        if (max_dist < min_dist * distance_ratio_ && azimuth_diff < 100.f) {
+          continue;
+        }
+        keepWalk(points, ring, walk_begin, j + 1);
+        walk_begin = j + 1;
+      }
+      keepWalk(points, ring, walk_begin, ring.size());
+    }
+
+    size_t num_kept = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+      if (keep_[i]) {
+        cloud.points[num_kept++] = points[i];
+      }
+    }
+    cloud.points.resize(num_kept);
+  }
+
+private:
+  /** \brief Mark the walk [begin, end) of a ring as kept if it is long or dense enough. */
+  void keepWalk(
+    const PointCloudXYZIRADT::VectorType & points, const std::vector<size_t> & ring,
+    const size_t begin, const size_t end)
+  {
+    if (begin >= end) {
+      return;
+    }
+    const auto & front = points[ring[begin]];
+    const auto & back = points[ring[end - 1]];
+    const double dx = front.x - back.x;
+    const double dy = front.y - back.y;
+    const double dz = front.z - back.z;
+    if (
+      static_cast<int>(end - begin) > num_points_threshold_ ||
+      dx * dx + dy * dy + dz * dz >= object_length_threshold_ * object_length_threshold_) {
+      for (size_t j = begin; j < end; ++j) {
+        keep_[ring[j]] = true;
+      }
+    }
+  }
+
+  double distance_ratio_;
+  double object_length_threshold_;
+  int num_points_threshold_;
+
+  std::vector<std::vector<size_t>> ring_indices_;
+  std::vector<bool> keep_;
+};
+
+class VoxelGridDownsampleStage : public FilterChainStage
+{
+public:
+  VoxelGridDownsampleStage(rclcpp::Node & node, const std::string & ns)
+  {
+    const double voxel_size_x = node.declare_parameter(ns + ".voxel_size_x", 0.3);
+    const double voxel_size_y = node.declare_parameter(ns + ".voxel_size_y", 0.3);
+    const double voxel_size_z = node.declare_parameter(ns + ".voxel_size_z", 0.1);
+    impl_.setLeafSize(voxel_size_x, voxel_size_y, voxel_size_z);
+  }
+
+  void apply(PointCloudXYZIRADT & cloud) override
+  {
+    impl_.filter(cloud, output_);
+    cloud.points.swap(output_.points);
+  }
+
+private:
+  pcl::VoxelGridHashMap<custom_pcl::PointXYZIRADT> impl_;
+  PointCloudXYZIRADT output_;
+};
+}  // namespace
+
+FilterChainComponent::FilterChainComponent(const rclcpp::NodeOptions & options)
+: Filter("FilterChain", options)
+{
+  // set initial parameters
+  {
+    stage_names_ = declare_parameter("filters", std::vector<std::string>{});
+    const auto tap_names = declare_parameter("tap_filters", std::vector<std::string>{});
+
+    for (size_t i = 0; i < stage_names_.size(); ++i) {
+      const auto & name = stage_names_.at(i);
+      auto stage = createStage(name);
+      if (!stage) {
+        throw std::invalid_argument("[FilterChain] unknown filter type: " + name);
+      }
+      stages_.push_back(std::move(stage));
+
+      if (std::find(tap_names.begin(), tap_names.end(), name) != tap_names.end()) {
+        tap_pubs_[i] = this->create_publisher<PointCloud2>(
+          "~/debug/" + name + "/pointcloud", rclcpp::SensorDataQoS().keep_last(max_queue_size_));
+      }
+    }
+  }
+}
+
+std::unique_ptr<FilterChainStage> FilterChainComponent::createStage(const std::string & name)
+{
+  if (name == "crop_box") {
+    return std::make_unique<CropBoxStage>(*this, name);
+  }
+  if (name == "crop_boxes") {
+    return std::make_unique<MultiCropBoxStage>(*this, name);
+  }
+  if (name == "ring_outlier") {
+    return std::make_unique<RingOutlierStage>(*this, name);
+  }
+  if (name == "voxel_grid_downsample") {
+    return std::make_unique<VoxelGridDownsampleStage>(*this, name);
+  }
+  return nullptr;
+}
+
+void FilterChainComponent::filter(
+  const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
+  PointCloud2 & output)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  pcl::fromROSMsg(*input, cloud_);
+
+  for (size_t i = 0; i < stages_.size(); ++i) {
+    stages_.at(i)->apply(cloud_);
+
+    const auto tap = tap_pubs_.find(i);
+    if (tap != tap_pubs_.end() && tap->second->get_subscription_count() > 0) {
+      cloud_.width = static_cast<uint32_t>(cloud_.points.size());
+      cloud_.height = 1;
+      auto tap_msg = std::make_unique<PointCloud2>();
+      pcl::toROSMsg(cloud_, *tap_msg);
+      tap_msg->header = input->header;
+      tap->second->publish(std::move(tap_msg));
+    }
+  }
+
+  cloud_.width = static_cast<uint32_t>(cloud_.points.size());
+  cloud_.height = 1;
+  pcl::toROSMsg(cloud_, output);
+  output.header = input->header;
+}
+}  // namespace pointcloud_preprocessor
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(pointcloud_preprocessor::FilterChainComponent)
@@ -16,9 +16,12 @@
 
 #include <pcl_ros/transforms.hpp>
 
+#include <Eigen/Eigenvalues>
+
 #include <pcl/common/centroid.h>
 #include <tf2_eigen/tf2_eigen.h>
 
+#include <algorithm>
 #include <limits>
 #include <random>
 #include <string>
@@ -64,6 +67,82 @@ pointcloud_preprocessor::PlaneBasis getPlaneBasis(const Eigen::Vector3d & plane_
   return basis;
 }
 
+Eigen::Affine3d toPlaneAffine(const Eigen::Vector3d & centroid, const Eigen::Vector3d & normal)
+{
+  Eigen::Translation<double, 3> trans(centroid.x(), centroid.y(), centroid.z());
+  const pointcloud_preprocessor::PlaneBasis basis = getPlaneBasis(normal);
+  Eigen::Matrix3d rot;
+  rot << basis.e_x.x(), basis.e_y.x(), basis.e_z.x(), basis.e_x.y(), basis.e_y.y(), basis.e_z.y(),
+    basis.e_x.z(), basis.e_y.z(), basis.e_z.z();
+  return trans * rot;
+}
+
+/**
+ * @brief fit a plane to the points of the indices by RANSAC with a limited number of iterations,
+ * then refine it to the least squares plane of the inliers
+ */
+bool fitPatchPlane(
+  const pcl::PointCloud<pcl::PointXYZ> & cloud, const std::vector<int> & indices,
+  const int max_iterations, const double outlier_threshold, std::mt19937 & random,
+  Eigen::Vector3d & plane_normal, Eigen::Vector3d & plane_centroid)
+{
+  if (indices.size() < 3) {
+    return false;
+  }
+  const auto toVector = [&cloud](const int index) {
+    const auto & p = cloud.points[index];
+    return Eigen::Vector3d(p.x, p.y, p.z);
+  };
+
+  std::uniform_int_distribution<size_t> sample(0, indices.size() - 1);
+  size_t max_inliers = 0;
+  Eigen::Vector3d best_normal = Eigen::Vector3d::UnitZ();
+  double best_offset = 0.0;
+  for (int i = 0; i < max_iterations; ++i) {
+    const Eigen::Vector3d p0 = toVector(indices[sample(random)]);
+    const Eigen::Vector3d p1 = toVector(indices[sample(random)]);
+    const Eigen::Vector3d p2 = toVector(indices[sample(random)]);
+    Eigen::Vector3d normal = (p1 - p0).cross(p2 - p0);
+    const double norm = normal.norm();
+    if (norm < 1e-6) {
+      continue;
+    }
+    normal /= norm;
+    const double offset = -normal.dot(p0);
+    size_t num_inliers = 0;
+    for (const int index : indices) {
+      if (std::abs(normal.dot(toVector(index)) + offset) <= outlier_threshold) {
+        ++num_inliers;
+      }
+    }
+    if (max_inliers < num_inliers) {
+      max_inliers = num_inliers;
+      best_normal = normal;
+      best_offset = offset;
+    }
+  }
+  if (max_inliers < 3) {
+    return false;
+  }
+
+  Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+  Eigen::Matrix3d sum_squared = Eigen::Matrix3d::Zero();
+  for (const int index : indices) {
+    const Eigen::Vector3d p = toVector(index);
+    if (std::abs(best_normal.dot(p) + best_offset) <= outlier_threshold) {
+      sum += p;
+      sum_squared += p * p.transpose();
+    }
+  }
+  plane_centroid = sum / max_inliers;
+  const Eigen::Matrix3d covariance =
+    sum_squared / max_inliers - plane_centroid * plane_centroid.transpose();
+  const Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+  // the eigenvalues are sorted in increasing order
+  plane_normal = solver.eigenvectors().col(0);
+  return true;
+}
+
 geometry_msgs::msg::Pose getDebugPose(const Eigen::Affine3d & plane_affine)
 {
   geometry_msgs::msg::Pose debug_pose;
@@ -96,6 +175,23 @@ RANSACGroundFilterComponent::RANSACGroundFilterComponent(const rclcpp::NodeOptio
   voxel_size_z_ = declare_parameter("voxel_size_z", 0.04);
   height_threshold_ = declare_parameter("height_threshold", 0.01);
   debug_ = declare_parameter("debug", false);
+  use_patch_mode_ = declare_parameter("use_patch_mode", false);
+  patch_zone_boundaries_ = declare_parameter(
+    "patch_zone_boundaries", std::vector<double>{0.0, 10.0, 20.0, 40.0, 80.0});
+  patch_num_sectors_ =
+    declare_parameter("patch_num_sectors", std::vector<int64_t>{8, 16, 32, 32});
+  patch_max_iterations_ = declare_parameter("patch_max_iterations", 50);
+  patch_min_points_ = declare_parameter("patch_min_points", 20);
+  patch_max_elevation_ = declare_parameter("patch_max_elevation", 0.5);
+  num_threads_ = declare_parameter("num_threads", 1);
+
+  if (use_patch_mode_ && patch_zone_boundaries_.size() != patch_num_sectors_.size() + 1) {
+    RCLCPP_ERROR(
+      get_logger(),
+      "patch_zone_boundaries must have one more element than patch_num_sectors, "
+      "patch mode is disabled.");
+    use_patch_mode_ = false;
+  }
 
   if (unit_axis_ == "x") {
     unit_vec_ = Eigen::Vector3d::UnitX();
@@ -134,7 +230,17 @@ void RANSACGroundFilterComponent::publishDebugMessage(
   const geometry_msgs::msg::PoseArray & debug_pose_array,
   const pcl::PointCloud<PointType> & ground_cloud, const std_msgs::msg::Header & header)
 {
+  debug_pose_array_pub_->publish(debug_pose_array);
+
+  // color the ground points only if someone sees them
+  if (
+    debug_ground_cloud_pub_->get_subscription_count() +
+      debug_ground_cloud_pub_->get_intra_process_subscription_count() ==
+    0) {
+    return;
+  }
   pcl::PointCloud<pcl::PointXYZRGB>::Ptr colored_ground_ptr(new pcl::PointCloud<pcl::PointXYZRGB>);
+  colored_ground_ptr->points.reserve(ground_cloud.points.size());
   for (const auto & ground_point : ground_cloud.points) {
     pcl::PointXYZRGB p;
     p.x = ground_point.x;
@@ -149,7 +255,6 @@ void RANSACGroundFilterComponent::publishDebugMessage(
   ground_cloud_msg_ptr->header = header;
   pcl::toROSMsg(*colored_ground_ptr, *ground_cloud_msg_ptr);
   ground_cloud_msg_ptr->header.frame_id = base_frame_;
-  debug_pose_array_pub_->publish(debug_pose_array);
   debug_ground_cloud_pub_->publish(*ground_cloud_msg_ptr);
 }
 
@@ -203,12 +308,8 @@ Eigen::Affine3d RANSACGroundFilterComponent::getPlaneAffine(
   }
   pcl::PointXYZ centroid_point;
   centroid.get(centroid_point);
-  Eigen::Translation<double, 3> trans(centroid_point.x, centroid_point.y, centroid_point.z);
-  const pointcloud_preprocessor::PlaneBasis basis = getPlaneBasis(plane_normal);
-  Eigen::Matrix3d rot;
-  rot << basis.e_x.x(), basis.e_y.x(), basis.e_z.x(), basis.e_x.y(), basis.e_y.y(), basis.e_z.y(),
-    basis.e_x.z(), basis.e_y.z(), basis.e_z.z();
-  return trans * rot;
+  return toPlaneAffine(
+    Eigen::Vector3d(centroid_point.x, centroid_point.y, centroid_point.z), plane_normal);
 }
 
 void RANSACGroundFilterComponent::applyRANSAC(
@@ -241,11 +342,51 @@ void RANSACGroundFilterComponent::filter(
   pcl::PointCloud<PointType>::Ptr current_sensor_cloud_ptr(new pcl::PointCloud<PointType>);
   pcl::fromROSMsg(*input_transformed_ptr, *current_sensor_cloud_ptr);
 
+  pcl::PointCloud<PointType>::Ptr no_ground_cloud_ptr(new pcl::PointCloud<PointType>);
+  pcl::PointCloud<PointType>::Ptr ground_cloud_ptr(new pcl::PointCloud<PointType>);
+  geometry_msgs::msg::PoseArray debug_pose_array;
+  debug_pose_array.header.frame_id = base_frame_;
+  if (use_patch_mode_) {
+    filterByPatches(
+      *current_sensor_cloud_ptr, *no_ground_cloud_ptr, *ground_cloud_ptr, debug_pose_array);
+  } else if (!filterByGlobalPlane(
+               current_sensor_cloud_ptr, *no_ground_cloud_ptr, *ground_cloud_ptr,
+               debug_pose_array)) {
+    output = *input;
+    return;
+  }
+
+  sensor_msgs::msg::PointCloud2::SharedPtr no_ground_cloud_msg_ptr(
+    new sensor_msgs::msg::PointCloud2);
+  pcl::toROSMsg(*no_ground_cloud_ptr, *no_ground_cloud_msg_ptr);
+  no_ground_cloud_msg_ptr->header = input->header;
+  sensor_msgs::msg::PointCloud2::SharedPtr no_ground_cloud_transformed_msg_ptr(
+    new sensor_msgs::msg::PointCloud2);
+  if (!transformPointCloud(
+        base_frame_, no_ground_cloud_msg_ptr, no_ground_cloud_transformed_msg_ptr)) {
+    RCLCPP_ERROR_STREAM_THROTTLE(
+      this->get_logger(), *this->get_clock(), std::chrono::milliseconds(1000).count(),
+      "Failed transform from " << base_frame_ << " to "
+                               << no_ground_cloud_msg_ptr->header.frame_id);
+    return;
+  }
+  output = *no_ground_cloud_transformed_msg_ptr;
+
+  // output debug plane coords and ground pointcloud when debug flag is set
+  if (debug_) {
+    publishDebugMessage(debug_pose_array, *ground_cloud_ptr, input->header);
+  }
+}
+
+bool RANSACGroundFilterComponent::filterByGlobalPlane(
+  const pcl::PointCloud<PointType>::Ptr & input, pcl::PointCloud<PointType> & no_ground_cloud,
+  pcl::PointCloud<PointType> & ground_cloud, geometry_msgs::msg::PoseArray & debug_pose_array)
+{
   // downsample pointcloud to reduce ransac calculation cost
   pcl::PointCloud<PointType>::Ptr downsampled_cloud(new pcl::PointCloud<PointType>);
-  downsampled_cloud->points.reserve(current_sensor_cloud_ptr->points.size());
+  downsampled_cloud->points.reserve(input->points.size());
   pcl::VoxelGrid<PointType> filter;
-  filter.setInputCloud(current_sensor_cloud_ptr);
+  filter.setInputCloud(input);
   filter.setLeafSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
   filter.filter(*downsampled_cloud);
 
@@ -258,8 +399,7 @@ void RANSACGroundFilterComponent::filter(
     RCLCPP_WARN_THROTTLE(
       this->get_logger(), *this->get_clock(), std::chrono::milliseconds(1000).count(),
       "failed to find a plane");
-    output = *input;
-    return;
+    return false;
   }
 
   // filter too tilt plane to avoid mis-fitting (e.g. fitting to wall plane)
@@ -270,8 +410,7 @@ void RANSACGroundFilterComponent::filter(
       std::acos(plane_normal.dot(unit_vec_) / (plane_normal.norm() * unit_vec_.norm())) * 180 /
       M_PI);
     if (plane_slope > plane_slope_threshold_) {
-      output = *input;
-      return;
+      return false;
     }
   }
 
@@ -281,40 +420,101 @@ void RANSACGroundFilterComponent::filter(
   extractPointsIndices(
     downsampled_cloud, *inliers, segment_ground_cloud_ptr, segment_no_ground_cloud_ptr);
   const Eigen::Affine3d plane_affine = getPlaneAffine(*segment_ground_cloud_ptr, plane_normal);
-  pcl::PointCloud<PointType>::Ptr no_ground_cloud_ptr(new pcl::PointCloud<PointType>);
 
   // use not downsampled pointcloud for extract pointcloud that higher than height threshold
-  for (const auto & p : current_sensor_cloud_ptr->points) {
-    const Eigen::Vector3d transformed_point =
-      plane_affine.inverse() * Eigen::Vector3d(p.x, p.y, p.z);
+  const Eigen::Affine3d plane_affine_inverse = plane_affine.inverse();
+  for (const auto & p : input->points) {
+    const Eigen::Vector3d transformed_point = plane_affine_inverse * Eigen::Vector3d(p.x, p.y, p.z);
     if (std::abs(transformed_point.z()) > height_threshold_) {
-      no_ground_cloud_ptr->points.push_back(p);
+      no_ground_cloud.points.push_back(p);
     }
   }
 
-  sensor_msgs::msg::PointCloud2::SharedPtr no_ground_cloud_msg_ptr(
-    new sensor_msgs::msg::PointCloud2);
-  pcl::toROSMsg(*no_ground_cloud_ptr, *no_ground_cloud_msg_ptr);
-  no_ground_cloud_msg_ptr->header = input->header;
-  sensor_msgs::msg::PointCloud2::SharedPtr no_ground_cloud_transformed_msg_ptr(
-    new sensor_msgs::msg::PointCloud2);
-  if (!transformPointCloud(
-        base_frame_, no_ground_cloud_msg_ptr, no_ground_cloud_transformed_msg_ptr)) {
-    RCLCPP_ERROR_STREAM_THROTTLE(
-      this->get_logger(), *this->get_clock(), std::chrono::milliseconds(1000).count(),
-      "Failed transform from " << base_frame_ << " to "
-                               << no_ground_cloud_msg_ptr->header.frame_id);
-    return;
+  ground_cloud = *segment_ground_cloud_ptr;
+  debug_pose_array.poses.push_back(getDebugPose(plane_affine));
+  return true;
+}
+
+void RANSACGroundFilterComponent::filterByPatches(
+  const pcl::PointCloud<PointType> & input, pcl::PointCloud<PointType> & no_ground_cloud,
+  pcl::PointCloud<PointType> & ground_cloud, geometry_msgs::msg::PoseArray & debug_pose_array)
+{
+  // split the points into the sectors of the concentric zones around the base frame
+  const size_t num_zones = patch_num_sectors_.size();
+  std::vector<size_t> zone_offsets(num_zones + 1, 0);
+  for (size_t zone = 0; zone < num_zones; ++zone) {
+    zone_offsets[zone + 1] = zone_offsets[zone] + std::max<int64_t>(patch_num_sectors_[zone], 1);
+  }
+  std::vector<std::vector<int>> patch_indices(zone_offsets.back());
+  for (size_t i = 0; i < input.points.size(); ++i) {
+    const auto & p = input.points[i];
+    const double range = std::hypot(p.x, p.y);
+    const auto zone_itr =
+      std::upper_bound(patch_zone_boundaries_.begin(), patch_zone_boundaries_.end(), range);
+    if (zone_itr == patch_zone_boundaries_.begin() || zone_itr == patch_zone_boundaries_.end()) {
+      no_ground_cloud.points.push_back(p);
+      continue;
+    }
+    const size_t zone = std::distance(patch_zone_boundaries_.begin(), zone_itr) - 1;
+    const size_t num_sectors = zone_offsets[zone + 1] - zone_offsets[zone];
+    const double angle = std::atan2(p.y, p.x) + M_PI;
+    const size_t sector =
+      std::min(static_cast<size_t>(angle / (2.0 * M_PI) * num_sectors), num_sectors - 1);
+    patch_indices[zone_offsets[zone] + sector].push_back(i);
   }
-  output = *no_ground_cloud_transformed_msg_ptr;
 
-  // output debug plane coords and ground pointcloud when debug flag is set
-  if (debug_) {
-    const geometry_msgs::msg::Pose debug_pose = getDebugPose(plane_affine);
-    geometry_msgs::msg::PoseArray debug_pose_array;
-    debug_pose_array.header.frame_id = base_frame_;
-    debug_pose_array.poses.push_back(debug_pose);
-    publishDebugMessage(debug_pose_array, *segment_ground_cloud_ptr, input->header);
+  // fit the plane of each patch, and reject the walls and the tops of objects
+  const int num_patches = static_cast<int>(patch_indices.size());
+  std::vector<uint8_t> is_ground_patch(num_patches, false);
+  std::vector<Eigen::Vector3d> plane_normals(num_patches);
+  std::vector<Eigen::Vector3d> plane_centroids(num_patches);
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (int patch = 0; patch < num_patches; ++patch) {
+    const auto & indices = patch_indices[patch];
+    if (static_cast<int>(indices.size()) < std::max(patch_min_points_, 3)) {
+      continue;
+    }
+    std::mt19937 random(patch);
+    Eigen::Vector3d normal;
+    Eigen::Vector3d centroid;
+    if (!fitPatchPlane(
+          input, indices, patch_max_iterations_, outlier_threshold_, random, normal, centroid)) {
+      continue;
+    }
+    if (normal.dot(unit_vec_) < 0.0) {
+      normal = -normal;
+    }
+    const double plane_slope = std::acos(std::min(normal.dot(unit_vec_), 1.0)) * 180 / M_PI;
+    if (plane_slope > plane_slope_threshold_ || centroid.dot(unit_vec_) > patch_max_elevation_) {
+      continue;
+    }
+    plane_normals[patch] = normal;
+    plane_centroids[patch] = centroid;
+    is_ground_patch[patch] = true;
+  }
+
+  // extract the points higher than height threshold from the plane of each patch
+  for (int patch = 0; patch < num_patches; ++patch) {
+    const auto & indices = patch_indices[patch];
+    if (!is_ground_patch[patch]) {
+      for (const int index : indices) {
+        no_ground_cloud.points.push_back(input.points[index]);
+      }
+      continue;
+    }
+    const Eigen::Vector3d & normal = plane_normals[patch];
+    const Eigen::Vector3d & centroid = plane_centroids[patch];
+    for (const int index : indices) {
+      const auto & p = input.points[index];
+      if (std::abs(normal.dot(Eigen::Vector3d(p.x, p.y, p.z) - centroid)) > height_threshold_) {
+        no_ground_cloud.points.push_back(p);
+      } else {
+        ground_cloud.points.push_back(p);
+      }
+    }
+    if (debug_) {
+      debug_pose_array.poses.push_back(getDebugPose(toPlaneAffine(centroid, normal)));
+    }
   }
 }
 
@@ -353,6 +553,21 @@ rcl_interfaces::msg::SetParametersResult RANSACGroundFilterComponent::paramCallb
   if (get_param(p, "voxel_size_z", voxel_size_z_)) {
     RCLCPP_DEBUG(get_logger(), "Setting voxel_size_z to: %lf.", voxel_size_z_);
   }
+  if (get_param(p, "use_patch_mode", use_patch_mode_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting use_patch_mode to: %d.", use_patch_mode_);
+  }
+  if (get_param(p, "patch_max_iterations", patch_max_iterations_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting patch_max_iterations to: %d.", patch_max_iterations_);
+  }
+  if (get_param(p, "patch_min_points", patch_min_points_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting patch_min_points to: %d.", patch_min_points_);
+  }
+  if (get_param(p, "patch_max_elevation", patch_max_elevation_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting patch_max_elevation to: %lf.", patch_max_elevation_);
+  }
+  if (get_param(p, "num_threads", num_threads_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting num_threads to: %d.", num_threads_);
+  }
   if (get_param(p, "debug", debug_)) {
     RCLCPP_DEBUG(get_logger(), "Setting debug to: %d.", debug_);
   }
@@ -33,7 +33,9 @@
 
 #include <pcl_ros/transforms.hpp>
 
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -46,7 +48,6 @@ RayGroundFilterComponent::RayGroundFilterComponent(const rclcpp::NodeOptions & o
     grid_width_ = 1000;
     grid_height_ = 1000;
     grid_precision_ = 0.2;
-    ray_ground_filter::generateColors(colors_, color_num_);
 
     min_x_ = declare_parameter("min_x", -0.01);
     max_x_ = declare_parameter("max_x", 0.01);
@@ -65,6 +66,7 @@ RayGroundFilterComponent::RayGroundFilterComponent(const rclcpp::NodeOptions & o
     min_height_threshold_ = declare_parameter("min_height_threshold", 0.15);
     concentric_divider_distance_ = declare_parameter("concentric_divider_distance", 0.0);
     reclass_distance_threshold_ = declare_parameter("reclass_distance_threshold", 0.1);
+    num_threads_ = static_cast<int>(declare_parameter("num_threads", 1));
   }
 
   using std::placeholders::_1;
@@ -99,60 +101,60 @@ bool RayGroundFilterComponent::TransformPointCloud(
 }
 
 void RayGroundFilterComponent::ConvertXYZIToRTZColor(
-  const pcl::PointCloud<PointType_>::Ptr in_cloud, PointCloudXYZRTColor & out_organized_points,
-  std::vector<pcl::PointIndices> & out_radial_divided_indices,
-  std::vector<PointCloudXYZRTColor> & out_radial_ordered_clouds)
+  const pcl::PointCloud<PointType_>::Ptr in_cloud,
+  PointCloudXYZRTColor & out_radial_ordered_points, std::vector<size_t> & out_radial_div_offsets)
 {
-  out_organized_points.resize(in_cloud->points.size());
-  out_radial_divided_indices.clear();
-  out_radial_divided_indices.resize(radial_dividers_num_);
-  out_radial_ordered_clouds.resize(radial_dividers_num_);
-
-  for (size_t i = 0; i < in_cloud->points.size(); i++) {
-    PointXYZRTColor new_point;
-    auto radius = static_cast<float>(sqrt(
-      in_cloud->points[i].x * in_cloud->points[i].x +
-      in_cloud->points[i].y * in_cloud->points[i].y));
-    auto theta =
-      static_cast<float>(atan2(in_cloud->points[i].y, in_cloud->points[i].x)) * 180 / M_PI;
+  const size_t num_points = in_cloud->points.size();
+  unordered_points_.resize(num_points);
+  out_radial_ordered_points.resize(num_points);
+
+#pragma omp parallel for num_threads(num_threads_)
+  for (size_t i = 0; i < num_points; i++) {
+    const auto & point = in_cloud->points[i];
+    auto & new_point = unordered_points_[i];
+    auto radius = static_cast<float>(sqrt(point.x * point.x + point.y * point.y));
+    auto theta = static_cast<float>(atan2(point.y, point.x)) * 180 / M_PI;
     if (theta < 0) {
       theta += 360;
     }
     if (theta >= 360) {
       theta -= 360;
     }
-    auto radial_div = static_cast<size_t>(floor(theta / radial_divider_angle_));
 
-    new_point.point.x = in_cloud->points[i].x;
-    new_point.point.y = in_cloud->points[i].y;
-    new_point.point.z = in_cloud->points[i].z;
-    // new_point.ring = in_cloud->points[i].ring;
+    new_point.point = point;
     new_point.radius = radius;
     new_point.theta = theta;
-    new_point.radial_div = radial_div;
-    new_point.red = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[0]);
-    new_point.green = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[1]);
-    new_point.blue = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[2]);
+    new_point.radial_div = std::min(
+      static_cast<size_t>(floor(theta / radial_divider_angle_)), radial_dividers_num_ - 1);
     new_point.original_index = i;
+  }
 
-    out_organized_points[i] = new_point;
-
-    // radial divisions
-    out_radial_divided_indices[radial_div].indices.push_back(i);
-
-    out_radial_ordered_clouds[radial_div].push_back(new_point);
-  }  // end for
+  // radial divisions (counting sort)
+  out_radial_div_offsets.assign(radial_dividers_num_ + 1, 0);
+  for (const auto & point : unordered_points_) {
+    ++out_radial_div_offsets[point.radial_div + 1];
+  }
+  for (size_t i = 0; i < radial_dividers_num_; i++) {
+    out_radial_div_offsets[i + 1] += out_radial_div_offsets[i];
+  }
+  radial_div_insert_positions_.assign(
+    out_radial_div_offsets.begin(), out_radial_div_offsets.end() - 1);
+  for (const auto & point : unordered_points_) {
+    out_radial_ordered_points[radial_div_insert_positions_[point.radial_div]++] = point;
+  }
 
   // order radial points on each division
-#pragma omp for
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
   for (size_t i = 0; i < radial_dividers_num_; i++) {
     std::sort(
-      out_radial_ordered_clouds[i].begin(), out_radial_ordered_clouds[i].end(),
+      out_radial_ordered_points.begin() + out_radial_div_offsets[i],
+      out_radial_ordered_points.begin() + out_radial_div_offsets[i + 1],
       [](const PointXYZRTColor & a, const PointXYZRTColor & b) { return a.radius < b.radius; });
   }
 }
 
-boost::optional<float> RayGroundFilterComponent::calcPointVehicleIntersection(const Point & point)
+boost::optional<float> RayGroundFilterComponent::calcPointVehicleIntersection(
+  const Point & point) const
 {
   float distance_to_intersection_point = 0.0;
   if (base_frame_ != "base_link") {
@@ -181,97 +183,100 @@ void RayGroundFilterComponent::setVehicleFootprint(
 }
 
 void RayGroundFilterComponent::ClassifyPointCloud(
-  std::vector<PointCloudXYZRTColor> & in_radial_ordered_clouds,
-  pcl::PointIndices & out_ground_indices, pcl::PointIndices & out_no_ground_indices)
+  const PointCloudXYZRTColor & in_radial_ordered_points,
+  const std::vector<size_t> & in_radial_div_offsets, std::vector<char> & out_ground_flags)
+{
+  out_ground_flags.assign(in_radial_ordered_points.size(), 0);
+
+  // each radial division only depends on its own points
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (size_t i = 0; i < in_radial_div_offsets.size() - 1; i++) {
+    ClassifyRadialDivision(
+      in_radial_ordered_points.data() + in_radial_div_offsets[i],
+      in_radial_ordered_points.data() + in_radial_div_offsets[i + 1], out_ground_flags);
+  }
+}
+
+void RayGroundFilterComponent::ClassifyRadialDivision(
+  const PointXYZRTColor * begin, const PointXYZRTColor * end,
+  std::vector<char> & out_ground_flags) const
 {
-  out_ground_indices.indices.clear();
-  out_no_ground_indices.indices.clear();
-#pragma omp for
-  for (size_t i = 0; i < in_radial_ordered_clouds.size();
-       i++)  // sweep through each radial division
+  float prev_radius = 0.f;
+  float prev_height = 0.f;
+  bool prev_ground = false;
+  bool current_ground = false;
+  const size_t num_points = static_cast<size_t>(end - begin);
+  for (size_t j = 0; j < num_points; j++)  // loop through each point in the radial div
   {
-    float prev_radius = 0.f;
-    float prev_height = 0.f;
-    bool prev_ground = false;
-    bool current_ground = false;
-    for (size_t j = 0; j < in_radial_ordered_clouds[i].size();
-         j++)  // loop through each point in the radial div
-    {
-      double local_max_slope = local_max_slope_;
-      if (j == 0) {
-        local_max_slope = initial_max_slope_;
-        if (use_vehicle_footprint_) {
-          // calc intersection of vehicle footprint and initial point vector
-          const auto radius = calcPointVehicleIntersection(
-            Point{in_radial_ordered_clouds[i][j].point.x, in_radial_ordered_clouds[i][j].point.y});
-          if (radius) {
-            prev_radius = *radius;
-          } else {
-            // This case may happen if point was detected inside vehicle footprint for example
-            // RCLCPP_ERROR(
-            //   this->get_logger(),
-            //   "failed to find intersection of initial point line and vehicle footprint");
-            continue;
-          }
+    const auto & point = begin[j];
+    double local_max_slope = local_max_slope_;
+    if (j == 0) {
+      local_max_slope = initial_max_slope_;
+      if (use_vehicle_footprint_) {
+        // calc intersection of vehicle footprint and initial point vector
+        const auto radius = calcPointVehicleIntersection(Point{point.point.x, point.point.y});
+        if (radius) {
+          prev_radius = *radius;
+        } else {
+          // This case may happen if point was detected inside vehicle footprint for example
+          // RCLCPP_ERROR(
+          //   this->get_logger(),
+          //   "failed to find intersection of initial point line and vehicle footprint");
+          continue;
         }
       }
+    }
 
-      float points_distance = in_radial_ordered_clouds[i][j].radius - prev_radius;
-      float height_threshold = tan(DEG2RAD(local_max_slope)) * points_distance;
-      float current_height = in_radial_ordered_clouds[i][j].point.z;
-      float general_height_threshold =
-        tan(DEG2RAD(general_max_slope_)) * in_radial_ordered_clouds[i][j].radius;
+    float points_distance = point.radius - prev_radius;
+    float height_threshold = tan(DEG2RAD(local_max_slope)) * points_distance;
+    float current_height = point.point.z;
+    float general_height_threshold = tan(DEG2RAD(general_max_slope_)) * point.radius;
 
-      // for points which are very close causing the height threshold to be tiny,
-      // set a minimum value
-      if (height_threshold < min_height_threshold_) {
-        height_threshold = min_height_threshold_;
-      }
-      // only check points which radius is larger than the concentric_divider
-      if (points_distance < concentric_divider_distance_) {
-        current_ground = prev_ground;
-      } else {
-        // check current point height against the LOCAL threshold (previous point)
-        if (
-          current_height <= (prev_height + height_threshold) &&
-          current_height >= (prev_height - height_threshold)) {
-          // Check again using general geometry (radius from origin)
-          // if previous points wasn't ground
-          if (!prev_ground) {
-            if (
-              current_height <= general_height_threshold &&
-              current_height >= -general_height_threshold) {
-              current_ground = true;
-            } else {
-              current_ground = false;
-            }
-          } else {
-            current_ground = true;
-          }
-        } else {
-          // check if previous point is too far from previous one, if so classify again
+    // for points which are very close causing the height threshold to be tiny,
+    // set a minimum value
+    if (height_threshold < min_height_threshold_) {
+      height_threshold = min_height_threshold_;
+    }
+    // only check points which radius is larger than the concentric_divider
+    if (points_distance < concentric_divider_distance_) {
+      current_ground = prev_ground;
+    } else {
+      // check current point height against the LOCAL threshold (previous point)
+      if (
+        current_height <= (prev_height + height_threshold) &&
+        current_height >= (prev_height - height_threshold)) {
+        // Check again using general geometry (radius from origin)
+        // if previous points wasn't ground
+        if (!prev_ground) {
           if (
-            points_distance > reclass_distance_threshold_ &&
-            (current_height <= general_height_threshold &&
-             current_height >= -general_height_threshold)) {
+            current_height <= general_height_threshold &&
+            current_height >= -general_height_threshold) {
             current_ground = true;
           } else {
             current_ground = false;
           }
+        } else {
+          current_ground = true;
         }
-      }  // end larger than concentric_divider
-
-      if (current_ground) {
-        out_ground_indices.indices.push_back(in_radial_ordered_clouds[i][j].original_index);
-        prev_ground = true;
       } else {
-        out_no_ground_indices.indices.push_back(in_radial_ordered_clouds[i][j].original_index);
-        prev_ground = false;
+        // check if previous point is too far from previous one, if so classify again
+        if (
+          points_distance > reclass_distance_threshold_ &&
+          (current_height <= general_height_threshold &&
+           current_height >= -general_height_threshold)) {
+          current_ground = true;
+        } else {
+          current_ground = false;
+        }
       }
+    }  // end larger than concentric_divider
 
-      prev_radius = in_radial_ordered_clouds[i][j].radius;
-      prev_height = in_radial_ordered_clouds[i][j].point.z;
-    }
+    // each point is in a single division, so the divisions write distinct flags
+    out_ground_flags[point.original_index] = current_ground;
+    prev_ground = current_ground;
+
+    prev_radius = point.radius;
+    prev_height = point.point.z;
   }
 }
 
@@ -288,22 +293,6 @@ void RayGroundFilterComponent::ClassifyPointCloud(
 //   return (true);
 // }
 
-void RayGroundFilterComponent::ExtractPointsIndices(
-  const pcl::PointCloud<PointType_>::Ptr in_cloud_ptr, const pcl::PointIndices & in_indices,
-  pcl::PointCloud<PointType_>::Ptr out_only_indices_cloud_ptr,
-  pcl::PointCloud<PointType_>::Ptr out_removed_indices_cloud_ptr)
-{
-  pcl::ExtractIndices<PointType_> extract_ground;
-  extract_ground.setInputCloud(in_cloud_ptr);
-  extract_ground.setIndices(boost::make_shared<pcl::PointIndices>(in_indices));
-
-  extract_ground.setNegative(false);  // true removes the indices, false leaves only the indices
-  extract_ground.filter(*out_only_indices_cloud_ptr);
-
-  extract_ground.setNegative(true);  // true removes the indices, false leaves only the indices
-  extract_ground.filter(*out_removed_indices_cloud_ptr);
-}
-
 void RayGroundFilterComponent::filter(
   const PointCloud2::ConstSharedPtr & input, [[maybe_unused]] const IndicesPtr & indices,
   PointCloud2 & output)
@@ -322,25 +311,22 @@ void RayGroundFilterComponent::filter(
   pcl::PointCloud<PointType_>::Ptr current_sensor_cloud_ptr(new pcl::PointCloud<PointType_>);
   pcl::fromROSMsg(*input_transformed_ptr, *current_sensor_cloud_ptr);
 
-  PointCloudXYZRTColor organized_points;
-  std::vector<pcl::PointIndices> radial_division_indices;
-  std::vector<PointCloudXYZRTColor> radial_ordered_clouds;
-
   radial_dividers_num_ = ceil(360 / radial_divider_angle_);
 
-  ConvertXYZIToRTZColor(
-    current_sensor_cloud_ptr, organized_points, radial_division_indices, radial_ordered_clouds);
-
-  pcl::PointIndices ground_indices, no_ground_indices;
+  ConvertXYZIToRTZColor(current_sensor_cloud_ptr, radial_ordered_points_, radial_div_offsets_);
 
-  ClassifyPointCloud(radial_ordered_clouds, ground_indices, no_ground_indices);
+  ClassifyPointCloud(radial_ordered_points_, radial_div_offsets_, ground_flags_);
 
-  pcl::PointCloud<PointType_>::Ptr ground_cloud_ptr(new pcl::PointCloud<PointType_>);
+  // the points not classified as ground, in their original order
   pcl::PointCloud<PointType_>::Ptr no_ground_cloud_ptr(new pcl::PointCloud<PointType_>);
-  pcl::PointCloud<pcl::PointXYZRGB>::Ptr radials_cloud_ptr(new pcl::PointCloud<pcl::PointXYZRGB>);
-
-  ExtractPointsIndices(
-    current_sensor_cloud_ptr, ground_indices, ground_cloud_ptr, no_ground_cloud_ptr);
+  no_ground_cloud_ptr->header = current_sensor_cloud_ptr->header;
+  no_ground_cloud_ptr->reserve(current_sensor_cloud_ptr->size());
+  for (size_t i = 0; i < current_sensor_cloud_ptr->size(); i++) {
+    if (!ground_flags_[i]) {
+      no_ground_cloud_ptr->push_back(current_sensor_cloud_ptr->points[i]);
+    }
+  }
+  no_ground_cloud_ptr->is_dense = current_sensor_cloud_ptr->is_dense;
 
   sensor_msgs::msg::PointCloud2::SharedPtr no_ground_cloud_msg_ptr(
     new sensor_msgs::msg::PointCloud2);
@@ -358,7 +344,7 @@ void RayGroundFilterComponent::filter(
                                << no_ground_cloud_msg_ptr->header.frame_id);
     return;
   }
-  output = *no_ground_cloud_transformed_msg_ptr;
+  output = std::move(*no_ground_cloud_transformed_msg_ptr);
 }
 
 rcl_interfaces::msg::SetParametersResult RayGroundFilterComponent::paramCallback(
@@ -20,6 +20,7 @@
 #include <pcl_ros/transforms.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -43,6 +44,7 @@ ScanGroundFilterComponent::ScanGroundFilterComponent(const rclcpp::NodeOptions &
     split_points_distance_tolerance_ = declare_parameter("split_points_distance_tolerance", 0.2);
     split_height_distance_ = declare_parameter("split_height_distance", 0.2);
     use_virtual_ground_point_ = declare_parameter("use_virtual_ground_point", true);
+    num_threads_ = static_cast<int>(declare_parameter("num_threads", 1));
     radial_dividers_num_ = std::ceil(2.0 * M_PI / radial_divider_angle_rad_);
     vehicle_info_ = VehicleInfoUtil(*this).getVehicleInfo();
   }
@@ -78,15 +80,20 @@ bool ScanGroundFilterComponent::transformPointCloud(
 
 void ScanGroundFilterComponent::convertPointcloud(
   const pcl::PointCloud<pcl::PointXYZ>::Ptr in_cloud,
-  std::vector<PointCloudRefVector> & out_radial_ordered_points)
+  PointCloudRefVector & out_radial_ordered_points, std::vector<size_t> & out_radial_div_offsets)
 {
-  out_radial_ordered_points.resize(radial_dividers_num_);
-  PointRef current_point;
+  const size_t num_points = in_cloud->points.size();
+  unordered_points_.resize(num_points);
+  out_radial_ordered_points.resize(num_points);
+  out_radial_div_offsets.assign(radial_dividers_num_ + 1, 0);
 
-  for (size_t i = 0; i < in_cloud->points.size(); ++i) {
+  PointRef current_point;
+  for (size_t i = 0; i < num_points; ++i) {
     auto radius{static_cast<float>(std::hypot(in_cloud->points[i].x, in_cloud->points[i].y))};
     auto theta{normalizeRadian(std::atan2(in_cloud->points[i].x, in_cloud->points[i].y), 0.0)};
-    auto radial_div{static_cast<size_t>(std::floor(theta / radial_divider_angle_rad_))};
+    auto radial_div{std::min(
+      static_cast<size_t>(std::floor(theta / radial_divider_angle_rad_)),
+      radial_dividers_num_ - 1)};
 
     current_point.radius = radius;
     current_point.theta = theta;
@@ -95,14 +102,26 @@ void ScanGroundFilterComponent::convertPointcloud(
     current_point.orig_index = i;
     current_point.orig_point = &in_cloud->points[i];
 
-    // radial divisions
-    out_radial_ordered_points[radial_div].emplace_back(current_point);
+    unordered_points_[i] = current_point;
+    ++out_radial_div_offsets[radial_div + 1];
+  }
+
+  // radial divisions (counting sort)
+  for (size_t i = 0; i < radial_dividers_num_; ++i) {
+    out_radial_div_offsets[i + 1] += out_radial_div_offsets[i];
+  }
+  radial_div_insert_positions_.assign(
+    out_radial_div_offsets.begin(), out_radial_div_offsets.end() - 1);
+  for (const auto & point : unordered_points_) {
+    out_radial_ordered_points[radial_div_insert_positions_[point.radial_div]++] = point;
   }
 
   // sort by distance
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
   for (size_t i = 0; i < radial_dividers_num_; ++i) {
     std::sort(
-      out_radial_ordered_points[i].begin(), out_radial_ordered_points[i].end(),
+      out_radial_ordered_points.begin() + out_radial_div_offsets[i],
+      out_radial_ordered_points.begin() + out_radial_div_offsets[i + 1],
       [](const PointRef & a, const PointRef & b) { return a.radius < b.radius; });
   }
 }
@@ -115,114 +134,130 @@ void ScanGroundFilterComponent::calcVirtualGroundOrigin(pcl::PointXYZ & point)
 }
 
 void ScanGroundFilterComponent::classifyPointCloud(
-  std::vector<PointCloudRefVector> & in_radial_ordered_clouds,
-  pcl::PointIndices & out_no_ground_indices)
+  PointCloudRefVector & in_radial_ordered_points,
+  const std::vector<size_t> & in_radial_div_offsets, pcl::PointIndices & out_no_ground_indices)
 {
   out_no_ground_indices.indices.clear();
+  no_ground_flags_.assign(in_radial_ordered_points.size(), 0);
+
+  // each radial division only depends on its own points
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (size_t i = 0; i < in_radial_div_offsets.size() - 1; ++i) {
+    classifyRadialDivision(
+      in_radial_ordered_points.data() + in_radial_div_offsets[i],
+      in_radial_ordered_points.data() + in_radial_div_offsets[i + 1]);
+  }
+
+  for (size_t i = 0; i < no_ground_flags_.size(); ++i) {
+    if (no_ground_flags_[i]) {
+      out_no_ground_indices.indices.push_back(i);
+    }
+  }
+}
 
+void ScanGroundFilterComponent::classifyRadialDivision(PointRef * begin, PointRef * end)
+{
   const pcl::PointXYZ init_ground_point(0, 0, 0);
   pcl::PointXYZ virtual_ground_point(0, 0, 0);
   calcVirtualGroundOrigin(virtual_ground_point);
 
   // point classification algorithm
-  // sweep through each radial division
-  for (size_t i = 0; i < in_radial_ordered_clouds.size(); i++) {
-    float prev_gnd_radius = 0.0f;
-    float prev_gnd_slope = 0.0f;
-    float points_distance = 0.0f;
-    PointsCentroid ground_cluster, non_ground_cluster;
-    float local_slope = 0.0f;
-    PointLabel prev_point_label = PointLabel::INIT;
-    pcl::PointXYZ prev_gnd_point(0, 0, 0);
-    // loop through each point in the radial div
-    for (size_t j = 0; j < in_radial_ordered_clouds[i].size(); j++) {
-      const float global_slope_max_angle = global_slope_max_angle_rad_;
-      const float local_slope_max_angle = local_slope_max_angle_rad_;
-      auto * p = &in_radial_ordered_clouds[i][j];
-      auto * p_prev = &in_radial_ordered_clouds[i][j - 1];
-
-      if (j == 0) {
-        bool is_front_side = (p->orig_point->x > virtual_ground_point.x);
-        if (use_virtual_ground_point_ && is_front_side) {
-          prev_gnd_point = virtual_ground_point;
-        } else {
-          prev_gnd_point = init_ground_point;
-        }
-        prev_gnd_radius = std::hypot(prev_gnd_point.x, prev_gnd_point.y);
-        prev_gnd_slope = 0.0f;
-        ground_cluster.initialize();
-        non_ground_cluster.initialize();
-        points_distance = calcDistance3d(*p->orig_point, prev_gnd_point);
+  float prev_gnd_radius = 0.0f;
+  float prev_gnd_slope = 0.0f;
+  float points_distance = 0.0f;
+  PointsCentroid ground_cluster, non_ground_cluster;
+  float local_slope = 0.0f;
+  PointLabel prev_point_label = PointLabel::INIT;
+  pcl::PointXYZ prev_gnd_point(0, 0, 0);
+  // loop through each point in the radial div
+  const size_t num_points = static_cast<size_t>(end - begin);
+  for (size_t j = 0; j < num_points; j++) {
+    const float global_slope_max_angle = global_slope_max_angle_rad_;
+    const float local_slope_max_angle = local_slope_max_angle_rad_;
+    auto * p = begin + j;
+
+    if (j == 0) {
+      bool is_front_side = (p->orig_point->x > virtual_ground_point.x);
+      if (use_virtual_ground_point_ && is_front_side) {
+        prev_gnd_point = virtual_ground_point;
       } else {
-        points_distance = calcDistance3d(*p->orig_point, *p_prev->orig_point);
+        prev_gnd_point = init_ground_point;
       }
+      prev_gnd_radius = std::hypot(prev_gnd_point.x, prev_gnd_point.y);
+      prev_gnd_slope = 0.0f;
+      ground_cluster.initialize();
+      non_ground_cluster.initialize();
+      points_distance = calcDistance3d(*p->orig_point, prev_gnd_point);
+    } else {
+      const auto * p_prev = p - 1;
+      points_distance = calcDistance3d(*p->orig_point, *p_prev->orig_point);
+    }
 
-      float radius_distance_from_gnd = p->radius - prev_gnd_radius;
-      float height_from_gnd = p->orig_point->z - prev_gnd_point.z;
-      float height_from_obj = p->orig_point->z - non_ground_cluster.getAverageHeight();
-      bool calculate_slope = false;
-      bool is_point_close_to_prev =
-        (points_distance <
-         (p->radius * radial_divider_angle_rad_ + split_points_distance_tolerance_));
-
-      // check points which is far enough from previous point
-      if (
-        (prev_point_label == PointLabel::NON_GROUND) &&
-        (std::abs(height_from_obj) >= split_height_distance_)) {
-        calculate_slope = true;
-      } else if (is_point_close_to_prev && std::abs(height_from_gnd) < split_height_distance_) {
-        // close to the previous point, set point follow label
-        p->point_state = PointLabel::POINT_FOLLOW;
-        calculate_slope = false;
-      } else {
-        calculate_slope = true;
-      }
-      if (calculate_slope) {
-        // far from the previous point
-
-        float global_slope = std::atan2(p->orig_point->z, p->radius);
-        local_slope = std::atan2(height_from_gnd, radius_distance_from_gnd);
-
-        if (global_slope > global_slope_max_angle) {
-          // the point is outside of the global slope threshold
-          p->point_state = PointLabel::NON_GROUND;
-        } else if (local_slope - prev_gnd_slope > local_slope_max_angle) {
-          // the point is outside of the local slope threshold
-          p->point_state = PointLabel::NON_GROUND;
-        } else {
-          p->point_state = PointLabel::GROUND;
-        }
-      }
+    float radius_distance_from_gnd = p->radius - prev_gnd_radius;
+    float height_from_gnd = p->orig_point->z - prev_gnd_point.z;
+    float height_from_obj = p->orig_point->z - non_ground_cluster.getAverageHeight();
+    bool calculate_slope = false;
+    bool is_point_close_to_prev =
+      (points_distance <
+       (p->radius * radial_divider_angle_rad_ + split_points_distance_tolerance_));
+
+    // check points which is far enough from previous point
+    if (
+      (prev_point_label == PointLabel::NON_GROUND) &&
+      (std::abs(height_from_obj) >= split_height_distance_)) {
+      calculate_slope = true;
+    } else if (is_point_close_to_prev && std::abs(height_from_gnd) < split_height_distance_) {
+      // close to the previous point, set point follow label
+      p->point_state = PointLabel::POINT_FOLLOW;
+      calculate_slope = false;
+    } else {
+      calculate_slope = true;
+    }
+    if (calculate_slope) {
+      // far from the previous point
 
-      if (p->point_state == PointLabel::GROUND) {
-        ground_cluster.initialize();
-        non_ground_cluster.initialize();
-      }
-      if (p->point_state == PointLabel::NON_GROUND) {
-        out_no_ground_indices.indices.push_back(p->orig_index);
-      } else if (  // NOLINT
-        (prev_point_label == PointLabel::NON_GROUND) &&
-        (p->point_state == PointLabel::POINT_FOLLOW)) {
+      float global_slope = std::atan2(p->orig_point->z, p->radius);
+      local_slope = std::atan2(height_from_gnd, radius_distance_from_gnd);
+
+      if (global_slope > global_slope_max_angle) {
+        // the point is outside of the global slope threshold
+        p->point_state = PointLabel::NON_GROUND;
+      } else if (local_slope - prev_gnd_slope > local_slope_max_angle) {
+        // the point is outside of the local slope threshold
         p->point_state = PointLabel::NON_GROUND;
-        out_no_ground_indices.indices.push_back(p->orig_index);
-      } else if (  // NOLINT
-        (prev_point_label == PointLabel::GROUND) && (p->point_state == PointLabel::POINT_FOLLOW)) {
-        p->point_state = PointLabel::GROUND;
       } else {
+        p->point_state = PointLabel::GROUND;
       }
+    }
 
-      // update the ground state
-      prev_point_label = p->point_state;
-      if (p->point_state == PointLabel::GROUND) {
-        prev_gnd_radius = p->radius;
-        prev_gnd_point = pcl::PointXYZ(p->orig_point->x, p->orig_point->y, p->orig_point->z);
-        ground_cluster.addPoint(p->radius, p->orig_point->z);
-        prev_gnd_slope = ground_cluster.getAverageSlope();
-      }
-      // update the non ground state
-      if (p->point_state == PointLabel::NON_GROUND) {
-        non_ground_cluster.addPoint(p->radius, p->orig_point->z);
-      }
+    if (p->point_state == PointLabel::GROUND) {
+      ground_cluster.initialize();
+      non_ground_cluster.initialize();
+    }
+    if (p->point_state == PointLabel::NON_GROUND) {
+      no_ground_flags_[p->orig_index] = 1;
+    } else if (  // NOLINT
+      (prev_point_label == PointLabel::NON_GROUND) &&
+      (p->point_state == PointLabel::POINT_FOLLOW)) {
+      p->point_state = PointLabel::NON_GROUND;
+      no_ground_flags_[p->orig_index] = 1;
+    } else if (  // NOLINT
+      (prev_point_label == PointLabel::GROUND) && (p->point_state == PointLabel::POINT_FOLLOW)) {
+      p->point_state = PointLabel::GROUND;
+    } else {
+    }
+
+    // update the ground state
+    prev_point_label = p->point_state;
+    if (p->point_state == PointLabel::GROUND) {
+      prev_gnd_radius = p->radius;
+      prev_gnd_point = pcl::PointXYZ(p->orig_point->x, p->orig_point->y, p->orig_point->z);
+      ground_cluster.addPoint(p->radius, p->orig_point->z);
+      prev_gnd_slope = ground_cluster.getAverageSlope();
+    }
+    // update the non ground state
+    if (p->point_state == PointLabel::NON_GROUND) {
+      non_ground_cluster.addPoint(p->radius, p->orig_point->z);
     }
   }
 }
@@ -240,37 +275,37 @@ void ScanGroundFilterComponent::filter(
   const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
   PointCloud2 & output)
 {
-  auto input_transformed_ptr = std::make_shared<PointCloud2>();
-  bool succeeded = transformPointCloud(base_frame_, input, input_transformed_ptr);
+  // the input is used as it is if it is already in the base frame
+  PointCloud2ConstPtr input_transformed_ptr = input;
   sensor_frame_ = input->header.frame_id;
-  if (!succeeded) {
-    RCLCPP_ERROR_STREAM_THROTTLE(
-      get_logger(), *get_clock(), 10000,
-      "Failed transform from " << base_frame_ << " to " << input->header.frame_id);
-    return;
+  if (base_frame_ != input->header.frame_id) {
+    auto transformed_ptr = std::make_shared<PointCloud2>();
+    if (!transformPointCloud(base_frame_, input, transformed_ptr)) {
+      RCLCPP_ERROR_STREAM_THROTTLE(
+        get_logger(), *get_clock(), 10000,
+        "Failed transform from " << base_frame_ << " to " << input->header.frame_id);
+      return;
+    }
+    input_transformed_ptr = transformed_ptr;
   }
 
   pcl::PointCloud<pcl::PointXYZ>::Ptr current_sensor_cloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(*input_transformed_ptr, *current_sensor_cloud_ptr);
 
-  std::vector<PointCloudRefVector> radial_ordered_points;
-
-  convertPointcloud(current_sensor_cloud_ptr, radial_ordered_points);
+  convertPointcloud(current_sensor_cloud_ptr, radial_ordered_points_, radial_div_offsets_);
 
   pcl::PointIndices no_ground_indices;
   pcl::PointCloud<pcl::PointXYZ>::Ptr no_ground_cloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
   no_ground_cloud_ptr->points.reserve(current_sensor_cloud_ptr->points.size());
 
-  classifyPointCloud(radial_ordered_points, no_ground_indices);
+  classifyPointCloud(radial_ordered_points_, radial_div_offsets_, no_ground_indices);
 
   extractObjectPoints(current_sensor_cloud_ptr, no_ground_indices, no_ground_cloud_ptr);
 
-  auto no_ground_cloud_msg_ptr = std::make_shared<PointCloud2>();
-  pcl::toROSMsg(*no_ground_cloud_ptr, *no_ground_cloud_msg_ptr);
+  pcl::toROSMsg(*no_ground_cloud_ptr, output);
 
-  no_ground_cloud_msg_ptr->header.stamp = input->header.stamp;
-  no_ground_cloud_msg_ptr->header.frame_id = base_frame_;
-  output = *no_ground_cloud_msg_ptr;
+  output.header.stamp = input->header.stamp;
+  output.header.frame_id = base_frame_;
 }
 
 rcl_interfaces::msg::SetParametersResult ScanGroundFilterComponent::onParameter(
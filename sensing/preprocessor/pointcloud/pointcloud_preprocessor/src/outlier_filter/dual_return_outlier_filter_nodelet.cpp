@@ -16,14 +16,101 @@
 
 #include <std_msgs/msg/header.hpp>
 
-#include <pcl/kdtree/kdtree_flann.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/segmentation/segment_differences.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 
 #include <algorithm>
+#include <cstring>
+#include <numeric>
 #include <string>
 #include <vector>
 
+namespace
+{
+/**
+ * @brief indices of the points grouped by ring, keeping the order of the input in each ring
+ */
+struct RingIndices
+{
+  std::vector<uint32_t> offsets;  // begin of each ring in indices, and the end of the last ring
+  std::vector<uint32_t> indices;
+};
+
+RingIndices groupByRing(
+  const std::vector<uint16_t> & rings, const std::vector<uint8_t> & is_weak_first,
+  const bool weak_first, const uint32_t num_rings)
+{
+  RingIndices ring_indices;
+  ring_indices.offsets.assign(num_rings + 1, 0);
+  for (size_t i = 0; i < rings.size(); ++i) {
+    if (static_cast<bool>(is_weak_first[i]) == weak_first) {
+      ++ring_indices.offsets[rings[i] + 1];
+    }
+  }
+  std::partial_sum(
+    ring_indices.offsets.begin(), ring_indices.offsets.end(), ring_indices.offsets.begin());
+
+  ring_indices.indices.resize(ring_indices.offsets.back());
+  std::vector<uint32_t> next(ring_indices.offsets.begin(), ring_indices.offsets.end() - 1);
+  for (size_t i = 0; i < rings.size(); ++i) {
+    if (static_cast<bool>(is_weak_first[i]) == weak_first) {
+      ring_indices.indices[next[rings[i]]++] = i;
+    }
+  }
+  return ring_indices;
+}
+
+/**
+ * @brief whether each point of a ring is continuous to the next one, without branches so that
+ * the compiler can vectorize the loop over the contiguous buffers
+ */
+void checkContinuity(
+  const float * distances, const float * azimuths, const size_t size, const float distance_ratio,
+  const float max_azimuth_diff, uint8_t * is_continuous)
+{
+  for (size_t i = 0; i + 1 < size; ++i) {
+    const float min_dist = std::min(distances[i], distances[i + 1]);
+    const float max_dist = std::max(distances[i], distances[i + 1]);
+    float azimuth_diff = azimuths[i + 1] - azimuths[i];
+    azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
+    is_continuous[i] = (max_dist < min_dist * distance_ratio) & (azimuth_diff < max_azimuth_diff);
+  }
+  is_continuous[size - 1] = false;
+}
+
+bool hasField(const sensor_msgs::msg::PointCloud2 & cloud, const std::string & field_name)
+{
+  return std::any_of(cloud.fields.begin(), cloud.fields.end(), [&](const auto & field) {
+    return field.name == field_name;
+  });
+}
+
+/**
+ * @brief copy the points of the indices from the input as they are, with the fields of the input
+ */
+void extractPoints(
+  const sensor_msgs::msg::PointCloud2 & input, const std::vector<uint32_t> & indices,
+  sensor_msgs::msg::PointCloud2 & output)
+{
+  output.header = input.header;
+  output.fields = input.fields;
+  output.is_bigendian = input.is_bigendian;
+  output.point_step = input.point_step;
+  output.height = 1;
+  output.width = indices.size();
+  output.row_step = output.width * output.point_step;
+  output.is_dense = input.is_dense;
+  output.data.resize(output.row_step);
+
+  uint8_t * output_point = output.data.data();
+  for (const auto index : indices) {
+    const size_t offset =
+      (index / input.width) * input.row_step + (index % input.width) * input.point_step;
+    std::memcpy(output_point, input.data.data() + offset, input.point_step);
+    output_point += input.point_step;
+  }
+}
+}  // namespace
+
 namespace pointcloud_preprocessor
 {
 using diagnostic_msgs::msg::DiagnosticStatus;
@@ -35,6 +122,7 @@ DualReturnOutlierFilterComponent::DualReturnOutlierFilterComponent(
   // set initial parameters
   {
     vertical_bins_ = static_cast<int>(declare_parameter("vertical_bins", 128));
+    horizontal_bins_ = static_cast<int>(declare_parameter("horizontal_bins", 36));
     max_azimuth_diff_ = static_cast<float>(declare_parameter("max_azimuth_diff", 50.0));
     weak_first_distance_ratio_ =
       static_cast<double>(declare_parameter("weak_first_distance_ratio", 1.004));
@@ -87,139 +175,136 @@ void DualReturnOutlierFilterComponent::filter(
   PointCloud2 & output)
 {
   boost::mutex::scoped_lock lock(mutex_);
-  pcl::PointCloud<return_type_cloud::PointXYZIRADT>::Ptr pcl_input(
-    new pcl::PointCloud<return_type_cloud::PointXYZIRADT>);
-  pcl::fromROSMsg(*input, *pcl_input);
-  if (pcl_input->points.empty()) {
+  const size_t num_points = input->width * input->height;
+  if (num_points == 0) {
     return;
   }
+  for (const auto & field_name : {"ring", "azimuth", "distance", "return_type"}) {
+    if (!hasField(*input, field_name)) {
+      RCLCPP_ERROR(get_logger(), "Input pointcloud doesn't have the field %s.", field_name);
+      return;
+    }
+  }
 
-  uint32_t vertical_bins = vertical_bins_;
-  uint32_t horizontal_bins = 36;
-
-  pcl::PointCloud<return_type_cloud::PointXYZIRADT>::Ptr pcl_output(
-    new pcl::PointCloud<return_type_cloud::PointXYZIRADT>);
-  pcl_output->points.reserve(pcl_input->points.size());
-
-  std::vector<pcl::PointCloud<return_type_cloud::PointXYZIRADT>> pcl_input_ring_array;
-  std::vector<pcl::PointCloud<return_type_cloud::PointXYZIRADT>> weak_first_pcl_input_ring_array;
-
-  pcl::PointCloud<return_type_cloud::PointXYZIRADT>::Ptr noise_output(
-    new pcl::PointCloud<return_type_cloud::PointXYZIRADT>);
-  noise_output->points.reserve(pcl_input->points.size());
-  pcl_input_ring_array.resize(
-    vertical_bins);  // TODO(davidw): this is for Pandar 40 only, make dynamic
-  weak_first_pcl_input_ring_array.resize(vertical_bins);
-
-  // Split into 36 x 10 degree bins x 40 lines (TODO: change to dynamic)
-  for (const auto & p : pcl_input->points) {
-    if (p.return_type == ReturnType::DUAL_WEAK_FIRST) {
-      weak_first_pcl_input_ring_array.at(p.ring).push_back(p);
-    } else {
-      pcl_input_ring_array.at(p.ring).push_back(p);
+  // Read the fields used by the filter into contiguous arrays
+  std::vector<uint16_t> rings(num_points);
+  std::vector<float> azimuths(num_points);
+  std::vector<float> distances(num_points);
+  std::vector<uint8_t> is_weak_first(num_points);
+  uint32_t vertical_bins = std::max(vertical_bins_, 0);
+  {
+    sensor_msgs::PointCloud2ConstIterator<uint16_t> iter_ring(*input, "ring");
+    sensor_msgs::PointCloud2ConstIterator<float> iter_azimuth(*input, "azimuth");
+    sensor_msgs::PointCloud2ConstIterator<float> iter_distance(*input, "distance");
+    sensor_msgs::PointCloud2ConstIterator<uint8_t> iter_return_type(*input, "return_type");
+    for (size_t i = 0; i < num_points;
+         ++i, ++iter_ring, ++iter_azimuth, ++iter_distance, ++iter_return_type) {
+      rings[i] = *iter_ring;
+      azimuths[i] = *iter_azimuth;
+      distances[i] = *iter_distance;
+      is_weak_first[i] = *iter_return_type == ReturnType::DUAL_WEAK_FIRST;
+      // the rings of the sensor are all binned even if vertical_bins is too small
+      vertical_bins = std::max(vertical_bins, static_cast<uint32_t>(*iter_ring) + 1);
     }
   }
+  const uint32_t horizontal_bins = std::max(horizontal_bins_, 1);
+  const float azimuth_bin_width = 36000.f / horizontal_bins;
+
+  const RingIndices weak_first_ring_indices =
+    groupByRing(rings, is_weak_first, true, vertical_bins);
+  const RingIndices ring_indices = groupByRing(rings, is_weak_first, false, vertical_bins);
+
+  std::vector<uint32_t> output_indices;
+  std::vector<uint32_t> noise_indices;
+  output_indices.reserve(num_points);
+  noise_indices.reserve(num_points);
 
-  float max_azimuth_diff = max_azimuth_diff_;
   cv::Mat frequency_image(cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
 
-  for (const auto & weak_first_single_ring : weak_first_pcl_input_ring_array) {
-    if (weak_first_single_ring.points.size() < 2) {
-      continue;
+  // Contiguous buffers of a ring, reused over the rings
+  std::vector<float> ring_azimuths;
+  std::vector<float> ring_distances;
+  std::vector<uint8_t> is_continuous;
+  const auto splitRing = [&](
+                           const RingIndices & grouped_indices, const uint32_t ring_id,
+                           const float distance_ratio, std::vector<uint32_t> & segment,
+                           std::vector<uint32_t> & deleted) {
+    segment.clear();
+    deleted.clear();
+    const uint32_t * ring_begin =
+      grouped_indices.indices.data() + grouped_indices.offsets[ring_id];
+    const size_t ring_size =
+      grouped_indices.offsets[ring_id + 1] - grouped_indices.offsets[ring_id];
+    if (ring_size < 2) {
+      return;
+    }
+    ring_azimuths.resize(ring_size);
+    ring_distances.resize(ring_size);
+    is_continuous.resize(ring_size);
+    for (size_t i = 0; i < ring_size; ++i) {
+      ring_azimuths[i] = azimuths[ring_begin[i]];
+      ring_distances[i] = distances[ring_begin[i]];
     }
-    std::vector<uint> deleted_azimuths;
-    std::vector<float> deleted_distances;
-    pcl::PointCloud<return_type_cloud::PointXYZIRADT> temp_segment;
+    checkContinuity(
+      ring_distances.data(), ring_azimuths.data(), ring_size, distance_ratio, max_azimuth_diff_,
+      is_continuous.data());
 
     bool keep_next = false;
-    uint ring_id = weak_first_single_ring.points.front().ring;
-    for (auto iter = std::begin(weak_first_single_ring) + 1;
-         iter != std::end(weak_first_single_ring) - 1; ++iter) {
-      const float min_dist = std::min(iter->distance, (iter + 1)->distance);
-      const float max_dist = std::max(iter->distance, (iter + 1)->distance);
-      float azimuth_diff = (iter + 1)->azimuth - iter->azimuth;
-      azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
-
-      if (max_dist < min_dist * weak_first_distance_ratio_ && azimuth_diff < max_azimuth_diff) {
-        temp_segment.points.push_back(*iter);
+    for (size_t i = 1; i + 1 < ring_size; ++i) {
+      if (is_continuous[i]) {
+        segment.push_back(ring_begin[i]);
         keep_next = true;
       } else if (keep_next) {
-        temp_segment.points.push_back(*iter);
+        segment.push_back(ring_begin[i]);
         keep_next = false;
-        // Analyse segment points here
       } else {
-        // Log the deleted azimuth and its distance for analysis
-        deleted_azimuths.push_back(iter->azimuth < 0.f ? 0.f : iter->azimuth);
-        deleted_distances.push_back(iter->distance);
-        noise_output->points.push_back(*iter);
-      }
-    }
-    // Analyse last segment points here
-    std::vector<int> noise_frequency(horizontal_bins, 0);
-    uint current_deleted_index = 0;
-    uint current_temp_segment_index = 0;
-    for (uint i = 0; i < noise_frequency.size() - 1; i++) {
-      if (deleted_azimuths.size() == 0) {
-        continue;
-      }
-      while ((uint)deleted_azimuths[current_deleted_index] <
-               ((i + 1) * (36000 / horizontal_bins)) &&
-             current_deleted_index < (deleted_azimuths.size() - 1)) {
-        noise_frequency[i] = noise_frequency[i] + 1;
-        current_deleted_index++;
-      }
-      if (temp_segment.points.size() == 0) {
-        continue;
-      }
-      while ((temp_segment.points[current_temp_segment_index].azimuth < 0.f
-                ? 0.f
-                : temp_segment.points[current_temp_segment_index].azimuth) <
-               ((i + 1) * (36000 / horizontal_bins)) &&
-             current_temp_segment_index < (temp_segment.points.size() - 1)) {
-        if (noise_frequency[i] < weak_first_local_noise_threshold_) {
-          pcl_output->points.push_back(temp_segment.points[current_temp_segment_index]);
-        } else {
-          noise_frequency[i] = noise_frequency[i] + 1;
-          noise_output->points.push_back(temp_segment.points[current_temp_segment_index]);
-        }
-        current_temp_segment_index++;
-        frequency_image.at<uchar>(ring_id, i) = noise_frequency[i];
+        deleted.push_back(ring_begin[i]);
       }
     }
-  }
-
-  // Ring outlier filter for normal points
-  for (const auto & input_ring : pcl_input_ring_array) {
-    if (input_ring.size() < 2) {
+  };
+  const auto toAzimuthBin = [&](const uint32_t index) {
+    const float azimuth = azimuths[index] < 0.f ? 0.f : azimuths[index];
+    return std::min(static_cast<uint32_t>(azimuth / azimuth_bin_width), horizontal_bins - 1);
+  };
+
+  std::vector<uint32_t> segment;
+  std::vector<uint32_t> deleted;
+  std::vector<int> noise_frequency(horizontal_bins);
+  for (uint32_t ring_id = 0; ring_id < vertical_bins; ++ring_id) {
+    splitRing(
+      weak_first_ring_indices, ring_id, static_cast<float>(weak_first_distance_ratio_), segment,
+      deleted);
+    if (segment.empty() && deleted.empty()) {
       continue;
     }
-    pcl::PointCloud<return_type_cloud::PointXYZIRADT> temp_segment;
-    bool keep_next = false;
-    // uint ring_id = input_ring.points.front().ring;
-    for (auto iter = std::begin(input_ring) + 1; iter != std::end(input_ring) - 1; ++iter) {
-      const float min_dist = std::min(iter->distance, (iter + 1)->distance);
-      const float max_dist = std::max(iter->distance, (iter + 1)->distance);
-      float azimuth_diff = (iter + 1)->azimuth - iter->azimuth;
-      azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
-
-      if (max_dist < min_dist * general_distance_ratio_ && azimuth_diff < max_azimuth_diff) {
-        temp_segment.points.push_back(*iter);
-        keep_next = true;
-      } else if (keep_next) {
-        temp_segment.points.push_back(*iter);
-        keep_next = false;
-        // Analyse segment points here
+    // Noise frequency of each azimuth bin, the deleted points and then the segment points
+    std::fill(noise_frequency.begin(), noise_frequency.end(), 0);
+    for (const auto index : deleted) {
+      ++noise_frequency[toAzimuthBin(index)];
+      noise_indices.push_back(index);
+    }
+    for (const auto index : segment) {
+      const uint32_t bin = toAzimuthBin(index);
+      if (noise_frequency[bin] < weak_first_local_noise_threshold_) {
+        output_indices.push_back(index);
       } else {
-        // Log the deleted azimuth and its distance for analysis
-        // deleted_azimuths.push_back(iter->azimuth < 0.f ? 0.f : iter->azimuth);
-        // deleted_distances.push_back(iter->distance);
-        noise_output->points.push_back(*iter);
+        ++noise_frequency[bin];
+        noise_indices.push_back(index);
       }
     }
-    for (const auto & tmp_p : temp_segment.points) {
-      pcl_output->points.push_back(tmp_p);
+    for (uint32_t bin = 0; bin < horizontal_bins; ++bin) {
+      frequency_image.at<uchar>(ring_id, bin) = cv::saturate_cast<uchar>(noise_frequency[bin]);
     }
   }
+
+  // Ring outlier filter for normal points
+  for (uint32_t ring_id = 0; ring_id < vertical_bins; ++ring_id) {
+    splitRing(
+      ring_indices, ring_id, static_cast<float>(general_distance_ratio_), segment, deleted);
+    output_indices.insert(output_indices.end(), segment.begin(), segment.end());
+    noise_indices.insert(noise_indices.end(), deleted.begin(), deleted.end());
+  }
+
   // Threshold for diagnostics (tunable)
   cv::Mat binary_image;
   cv::inRange(frequency_image, weak_first_local_noise_threshold_, 255, binary_image);
@@ -243,13 +328,11 @@ void DualReturnOutlierFilterComponent::filter(
 
   // Publish noise points
   sensor_msgs::msg::PointCloud2 noise_output_msg;
-  pcl::toROSMsg(*noise_output, noise_output_msg);
-  noise_output_msg.header = input->header;
+  extractPoints(*input, noise_indices, noise_output_msg);
   noise_cloud_pub_->publish(noise_output_msg);
 
   // Publish filtered pointcloud
-  pcl::toROSMsg(*pcl_output, output);
-  output.header = input->header;
+  extractPoints(*input, output_indices, output);
 }
 
 rcl_interfaces::msg::SetParametersResult DualReturnOutlierFilterComponent::paramCallback(
@@ -273,6 +356,9 @@ rcl_interfaces::msg::SetParametersResult DualReturnOutlierFilterComponent::param
   if (get_param(p, "vertical_bins", vertical_bins_)) {
     RCLCPP_DEBUG(get_logger(), "Setting new vertical_bins to: %d.", vertical_bins_);
   }
+  if (get_param(p, "horizontal_bins", horizontal_bins_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new horizontal_bins to: %d.", horizontal_bins_);
+  }
   if (get_param(p, "max_azimuth_diff", max_azimuth_diff_)) {
     RCLCPP_DEBUG(get_logger(), "Setting new max_azimuth_diff to: %f.", max_azimuth_diff_);
   }
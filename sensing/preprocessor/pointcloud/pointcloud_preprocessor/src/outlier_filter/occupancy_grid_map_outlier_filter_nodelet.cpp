@@ -14,6 +14,8 @@
 
 #include "pointcloud_preprocessor/outlier_filter/occupancy_grid_map_outlier_filter_nodelet.hpp"
 
+#include "pointcloud_preprocessor/outlier_filter/radius_search_grid_2d.hpp"
+
 #include <autoware_utils/autoware_utils.hpp>
 #include <pcl_ros/transforms.hpp>
 
@@ -24,6 +26,7 @@
 #include <tf2_eigen/tf2_eigen.h>
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
@@ -105,71 +108,45 @@ RadiusSearch2dfilter::RadiusSearch2dfilter(rclcpp::Node & node)
     node.declare_parameter("radius_search_2d_filter.min_points_and_distance_ratio", 400.0f);
   min_points_ = node.declare_parameter("radius_search_2d_filter.min_points", 4);
   max_points_ = node.declare_parameter("radius_search_2d_filter.max_points", 70);
-  kd_tree_ = boost::make_shared<pcl::search::KdTree<pcl::PointXY>>(false);
 }
 
 void RadiusSearch2dfilter::filter(
   const PclPointCloud & input, const Pose & pose, PclPointCloud & output, PclPointCloud & outlier)
 {
-  const auto & xyz_cloud = input;
-  pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
-  xy_cloud->points.resize(xyz_cloud.points.size());
-  for (size_t i = 0; i < xyz_cloud.points.size(); ++i) {
-    xy_cloud->points[i].x = xyz_cloud.points[i].x;
-    xy_cloud->points[i].y = xyz_cloud.points[i].y;
-  }
-
-  std::vector<int> k_indices(xy_cloud->points.size());
-  std::vector<float> k_dists(xy_cloud->points.size());
-  kd_tree_->setInputCloud(xy_cloud);
-  for (size_t i = 0; i < xy_cloud->points.size(); ++i) {
-    const float distance =
-      std::hypot(xy_cloud->points[i].x - pose.position.x, xy_cloud->points[i].y - pose.position.y);
-    const int min_points_threshold = std::min(
-      std::max(static_cast<int>(min_points_and_distance_ratio_ / distance + 0.5f), min_points_),
-      max_points_);
-    const int points_num = kd_tree_->radiusSearch(i, search_radius_, k_indices, k_dists);
-
-    if (min_points_threshold <= points_num) {
-      output.points.push_back(xyz_cloud.points.at(i));
-    } else {
-      outlier.points.push_back(xyz_cloud.points.at(i));
-    }
-  }
+  RadiusSearchGrid2d grid(search_radius_);
+  grid.addPoints(input);
+  grid.build();
+  filterByGrid(grid, input, pose, output, outlier);
 }
 
 void RadiusSearch2dfilter::filter(
   const PclPointCloud & high_conf_input, const PclPointCloud & low_conf_input, const Pose & pose,
   PclPointCloud & output, PclPointCloud & outlier)
 {
-  const auto & high_conf_xyz_cloud = high_conf_input;
-  const auto & low_conf_xyz_cloud = low_conf_input;
-  pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
-  xy_cloud->points.resize(low_conf_xyz_cloud.points.size() + high_conf_xyz_cloud.points.size());
-  for (size_t i = 0; i < low_conf_xyz_cloud.points.size(); ++i) {
-    xy_cloud->points[i].x = low_conf_xyz_cloud.points[i].x;
-    xy_cloud->points[i].y = low_conf_xyz_cloud.points[i].y;
-  }
-  for (size_t i = low_conf_xyz_cloud.points.size(); i < xy_cloud->points.size(); ++i) {
-    xy_cloud->points[i].x = high_conf_xyz_cloud.points[i - low_conf_xyz_cloud.points.size()].x;
-    xy_cloud->points[i].y = high_conf_xyz_cloud.points[i - low_conf_xyz_cloud.points.size()].y;
-  }
+  RadiusSearchGrid2d grid(search_radius_);
+  grid.addPoints(low_conf_input);
+  grid.addPoints(high_conf_input);
+  grid.build();
+  filterByGrid(grid, low_conf_input, pose, output, outlier);
+}
 
-  std::vector<int> k_indices(xy_cloud->points.size());
-  std::vector<float> k_dists(xy_cloud->points.size());
-  kd_tree_->setInputCloud(xy_cloud);
-  for (size_t i = 0; i < low_conf_xyz_cloud.points.size(); ++i) {
-    const float distance =
-      std::hypot(xy_cloud->points[i].x - pose.position.x, xy_cloud->points[i].y - pose.position.y);
+template <class Grid>
+void RadiusSearch2dfilter::filterByGrid(
+  const Grid & grid, const PclPointCloud & input, const Pose & pose, PclPointCloud & output,
+  PclPointCloud & outlier)
+{
+  output.points.reserve(output.points.size() + input.points.size());
+  for (const auto & point : input.points) {
+    const float distance = std::hypot(point.x - pose.position.x, point.y - pose.position.y);
     const int min_points_threshold = std::min(
       std::max(static_cast<int>(min_points_and_distance_ratio_ / distance + 0.5f), min_points_),
       max_points_);
-    const int points_num = kd_tree_->radiusSearch(i, search_radius_, k_indices, k_dists);
+    const int points_num = grid.countPointsInRadius(point.x, point.y, min_points_threshold);
 
     if (min_points_threshold <= points_num) {
-      output.points.push_back(low_conf_xyz_cloud.points.at(i));
+      output.points.push_back(point);
     } else {
-      outlier.points.push_back(low_conf_xyz_cloud.points.at(i));
+      outlier.points.push_back(point);
     }
   }
 }
@@ -259,6 +236,9 @@ void OccupancyGridMapOutlierFilterComponent::filterByOccupancyGridMap(
   const OccupancyGrid & occupancy_grid_map, const PointCloud2 & pointcloud,
   PclPointCloud & high_confidence, PclPointCloud & low_confidence)
 {
+  const size_t num_points = pointcloud.width * pointcloud.height;
+  high_confidence.reserve(num_points);
+  low_confidence.reserve(num_points);
   for (sensor_msgs::PointCloud2ConstIterator<float> x(pointcloud, "x"), y(pointcloud, "y"),
        z(pointcloud, "z");
        x != x.end(); ++x, ++y, ++z) {
@@ -14,9 +14,7 @@
 
 #include "pointcloud_preprocessor/outlier_filter/radius_search_2d_outlier_filter_nodelet.hpp"
 
-#include <pcl/kdtree/kdtree_flann.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/segmentation/segment_differences.h>
+#include "pointcloud_preprocessor/outlier_filter/radius_search_grid_2d.hpp"
 
 #include <vector>
 
@@ -30,10 +28,9 @@ RadiusSearch2DOutlierFilterComponent::RadiusSearch2DOutlierFilterComponent(
   {
     min_neighbors_ = static_cast<size_t>(declare_parameter("min_neighbors", 5));
     search_radius_ = static_cast<double>(declare_parameter("search_radius", 0.2));
+    num_threads_ = static_cast<int>(declare_parameter("num_threads", 1));
   }
 
-  kd_tree_ = boost::make_shared<pcl::search::KdTree<pcl::PointXY>>(false);
-
   using std::placeholders::_1;
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&RadiusSearch2DOutlierFilterComponent::paramCallback, this, _1));
@@ -47,21 +44,25 @@ void RadiusSearch2DOutlierFilterComponent::filter(
   pcl::PointCloud<pcl::PointXYZ>::Ptr xyz_cloud(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(*input, *xyz_cloud);
 
-  pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
-  xy_cloud->points.resize(xyz_cloud->points.size());
-  for (size_t i = 0; i < xyz_cloud->points.size(); ++i) {
-    xy_cloud->points[i].x = xyz_cloud->points[i].x;
-    xy_cloud->points[i].y = xyz_cloud->points[i].y;
+  RadiusSearchGrid2d grid(static_cast<float>(search_radius_));
+  grid.addPoints(*xyz_cloud);
+  grid.build();
+
+  // only whether a point has min_neighbors_ neighbors matters, so the counting stops there
+  const auto & points = xyz_cloud->points;
+  const int min_neighbors = static_cast<int>(min_neighbors_);
+  is_inlier_.assign(points.size(), 0);
+#pragma omp parallel for num_threads(num_threads_)
+  for (size_t i = 0; i < points.size(); ++i) {
+    is_inlier_[i] =
+      min_neighbors <= grid.countPointsInRadius(points[i].x, points[i].y, min_neighbors);
   }
 
-  std::vector<int> k_indices(xy_cloud->points.size());
-  std::vector<float> k_sqr_distances(xy_cloud->points.size());
-  kd_tree_->setInputCloud(xy_cloud);
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
-  for (size_t i = 0; i < xy_cloud->points.size(); ++i) {
-    size_t k = kd_tree_->radiusSearch(i, search_radius_, k_indices, k_sqr_distances);
-    if (k >= min_neighbors_) {
-      pcl_output->points.push_back(xyz_cloud->points.at(i));
+  pcl_output->points.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (is_inlier_[i]) {
+      pcl_output->points.push_back(points[i]);
     }
   }
   pcl::toROSMsg(*pcl_output, output);
@@ -79,6 +80,9 @@ rcl_interfaces::msg::SetParametersResult RadiusSearch2DOutlierFilterComponent::p
   if (get_param(p, "search_radius", search_radius_)) {
     RCLCPP_DEBUG(get_logger(), "Setting new search radius to: %f.", search_radius_);
   }
+  if (get_param(p, "num_threads", num_threads_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new num threads to: %d.", num_threads_);
+  }
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
   result.reason = "success";
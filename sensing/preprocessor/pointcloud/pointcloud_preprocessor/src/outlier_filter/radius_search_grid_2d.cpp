@@ -0,0 +1,84 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/outlier_filter/radius_search_grid_2d.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace pointcloud_preprocessor
+{
+RadiusSearchGrid2d::RadiusSearchGrid2d(const float search_radius)
+: inv_cell_size_(1.0f / search_radius), sq_search_radius_(search_radius * search_radius)
+{
+}
+
+void RadiusSearchGrid2d::addPoints(const pcl::PointCloud<pcl::PointXYZ> & cloud)
+{
+  points_.reserve(points_.size() + cloud.points.size());
+  for (const auto & point : cloud.points) {
+    points_.push_back({toKey(toCell(point.x), toCell(point.y)), point.x, point.y});
+  }
+}
+
+void RadiusSearchGrid2d::build()
+{
+  std::sort(points_.begin(), points_.end(), [](const CellPoint & a, const CellPoint & b) {
+    return a.key < b.key;
+  });
+  cell_ranges_.clear();
+  for (size_t begin = 0; begin < points_.size();) {
+    size_t end = begin + 1;
+    while (end < points_.size() && points_[end].key == points_[begin].key) {
+      ++end;
+    }
+    cell_ranges_.emplace(points_[begin].key, std::make_pair(begin, end));
+    begin = end;
+  }
+}
+
+int RadiusSearchGrid2d::countPointsInRadius(const float x, const float y, const int max_count) const
+{
+  const int32_t cell_x = toCell(x);
+  const int32_t cell_y = toCell(y);
+  int count = 0;
+  for (int32_t dx = -1; dx <= 1; ++dx) {
+    for (int32_t dy = -1; dy <= 1; ++dy) {
+      const auto itr = cell_ranges_.find(toKey(cell_x + dx, cell_y + dy));
+      if (itr == cell_ranges_.end()) {
+        continue;
+      }
+      for (size_t i = itr->second.first; i < itr->second.second; ++i) {
+        const float diff_x = points_[i].x - x;
+        const float diff_y = points_[i].y - y;
+        if (diff_x * diff_x + diff_y * diff_y < sq_search_radius_ && max_count <= ++count) {
+          return count;
+        }
+      }
+    }
+  }
+  return count;
+}
+
+int32_t RadiusSearchGrid2d::toCell(const float value) const
+{
+  return static_cast<int32_t>(std::floor(value * inv_cell_size_));
+}
+
+uint64_t RadiusSearchGrid2d::toKey(const int32_t cell_x, const int32_t cell_y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(cell_x)) << 32) |
+         static_cast<uint32_t>(cell_y);
+}
+}  // namespace pointcloud_preprocessor
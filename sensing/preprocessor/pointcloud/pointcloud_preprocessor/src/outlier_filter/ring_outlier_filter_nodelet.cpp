@@ -19,6 +19,8 @@
 #include <pcl/segmentation/segment_differences.h>
 
 #include <algorithm>
+#include <cstring>
+#include <string>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -44,82 +46,125 @@ void RingOutlierFilterComponent::filter(
   PointCloud2 & output)
 {
   boost::mutex::scoped_lock lock(mutex_);
-  pcl::PointCloud<custom_pcl::PointXYZIRADT>::Ptr pcl_input(
-    new pcl::PointCloud<custom_pcl::PointXYZIRADT>);
-  pcl::fromROSMsg(*input, *pcl_input);
 
-  if (pcl_input->points.empty()) {
+  const auto getFieldOffset = [&input](const std::string & name, const uint8_t datatype) {
+    for (const auto & field : input->fields) {
+      if (field.name == name && field.datatype == datatype) {
+        return static_cast<int>(field.offset);
+      }
+    }
+    return -1;
+  };
+  using sensor_msgs::msg::PointField;
+  const int x_offset = getFieldOffset("x", PointField::FLOAT32);
+  const int y_offset = getFieldOffset("y", PointField::FLOAT32);
+  const int z_offset = getFieldOffset("z", PointField::FLOAT32);
+  const int intensity_offset = getFieldOffset("intensity", PointField::FLOAT32);
+  const int ring_offset = getFieldOffset("ring", PointField::UINT16);
+  const int azimuth_offset = getFieldOffset("azimuth", PointField::FLOAT32);
+  const int distance_offset = getFieldOffset("distance", PointField::FLOAT32);
+  if (
+    x_offset < 0 || y_offset < 0 || z_offset < 0 || intensity_offset < 0 || ring_offset < 0 ||
+    azimuth_offset < 0 || distance_offset < 0) {
+    RCLCPP_ERROR_THROTTLE(
+      get_logger(), *get_clock(), 5000,
+      "Input pointcloud needs x, y, z, intensity, ring, azimuth and distance fields.");
     return;
   }
-  std::vector<pcl::PointCloud<custom_pcl::PointXYZIRADT>> pcl_input_ring_array;
-  pcl_input_ring_array.resize(128);  // TODO(Yamato Ando)
-  for (const auto & p : pcl_input->points) {
-    pcl_input_ring_array.at(p.ring).push_back(p);
+
+  const size_t num_points = static_cast<size_t>(input->width) * input->height;
+  const uint8_t * const data = input->data.data();
+  const auto readFloat = [data, &input](const size_t index, const int offset) {
+    float value;
+    std::memcpy(&value, data + index * input->point_step + offset, sizeof(float));
+    return value;
+  };
+
+  // bucket point indices per ring, keeping the capacity of the scratch buffers
+  for (auto & ring : ring_indices_) {
+    ring.clear();
+  }
+  for (size_t i = 0; i < num_points; ++i) {
+    uint16_t ring;
+    std::memcpy(&ring, data + i * input->point_step + ring_offset, sizeof(uint16_t));
+    if (ring >= ring_indices_.size()) {
+      ring_indices_.resize(ring + 1);
+    }
+    ring_indices_[ring].push_back(i);
   }
 
-  pcl::PointCloud<custom_pcl::PointXYZI>::Ptr pcl_output(
-    new pcl::PointCloud<custom_pcl::PointXYZI>);
-  pcl_output->points.reserve(pcl_input->points.size());
+  // output x, y, z and intensity, written straight into the preallocated buffer
+  output.fields.clear();
+  for (const auto & name : {"x", "y", "z", "intensity"}) {
+    PointField field;
+    field.name = name;
+    field.offset = static_cast<uint32_t>(output.fields.size() * sizeof(float));
+    field.datatype = PointField::FLOAT32;
+    field.count = 1;
+    output.fields.push_back(field);
+  }
+  output.point_step = static_cast<uint32_t>(output.fields.size() * sizeof(float));
+  output.data.resize(num_points * output.point_step);
+
+  size_t num_output_points = 0;
+  const auto copyWalk = [&](
+                          const std::vector<size_t> & ring, const size_t begin, const size_t end) {
+    if (begin >= end) {
+      return;
+    }
+    const size_t front = ring[begin];
+    const size_t back = ring[end - 1];
+    const double dx = readFloat(front, x_offset) - readFloat(back, x_offset);
+    const double dy = readFloat(front, y_offset) - readFloat(back, y_offset);
+    const double dz = readFloat(front, z_offset) - readFloat(back, z_offset);
+    if (
+      static_cast<int>(end - begin) <= num_points_threshold_ &&
+      dx * dx + dy * dy + dz * dz < object_length_threshold_ * object_length_threshold_) {
+      return;
+    }
+    for (size_t j = begin; j < end; ++j) {
+      const uint8_t * src = data + ring[j] * input->point_step;
+      uint8_t * dst = output.data.data() + num_output_points * output.point_step;
+      std::memcpy(dst, src + x_offset, sizeof(float));
+      std::memcpy(dst + sizeof(float), src + y_offset, sizeof(float));
+      std::memcpy(dst + 2 * sizeof(float), src + z_offset, sizeof(float));
+      std::memcpy(dst + 3 * sizeof(float), src + intensity_offset, sizeof(float));
+      ++num_output_points;
+    }
+  };
 
-  pcl::PointCloud<custom_pcl::PointXYZI> pcl_tmp;
-  custom_pcl::PointXYZI p{};
-  for (const auto & ring_pointcloud : pcl_input_ring_array) {
-    if (ring_pointcloud.points.size() < 2) {
+  for (const auto & ring : ring_indices_) {
+    if (ring.size() < 2) {
       continue;
     }
 
-    for (auto iter = std::begin(ring_pointcloud.points);
-         iter != std::end(ring_pointcloud.points) - 1; ++iter) {
-      p.x = iter->x;
-      p.y = iter->y;
-      p.z = iter->z;
-      p.intensity = iter->intensity;
-      pcl_tmp.points.push_back(p);
-      // if(std::abs(iter->distance - (iter+1)->distance) <= std::sqrt(iter->distance) * 0.08) {
-      const float min_dist = std::min(iter->distance, (iter + 1)->distance);
-      const float max_dist = std::max(iter->distance, (iter + 1)->distance);
-      float azimuth_diff = (iter + 1)->azimuth - iter->azimuth;
+    // split the ring into walks where consecutive points are close in distance and azimuth
+    size_t walk_begin = 0;
+    for (size_t j = 0; j + 1 < ring.size(); ++j) {
+      const float distance = readFloat(ring[j], distance_offset);
+      const float next_distance = readFloat(ring[j + 1], distance_offset);
+      const float min_dist = std::min(distance, next_distance);
+      const float max_dist = std::max(distance, next_distance);
+      float azimuth_diff =
+        readFloat(ring[j + 1], azimuth_offset) - readFloat(ring[j], azimuth_offset);
       azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
 
       if (max_dist < min_dist * distance_ratio_ && azimuth_diff < 100.f) {
         continue;
       }
-      // same code
-      if (
-        static_cast<int>(pcl_tmp.points.size()) > num_points_threshold_ ||
-        (pcl_tmp.points.front().x - pcl_tmp.points.back().x) *
-              (pcl_tmp.points.front().x - pcl_tmp.points.back().x) +
-            (pcl_tmp.points.front().y - pcl_tmp.points.back().y) *
-              (pcl_tmp.points.front().y - pcl_tmp.points.back().y) +
-            (pcl_tmp.points.front().z - pcl_tmp.points.back().z) *
-              (pcl_tmp.points.front().z - pcl_tmp.points.back().z) >=
-          object_length_threshold_ * object_length_threshold_) {
-        for (const auto & tmp_p : pcl_tmp.points) {
-          pcl_output->points.push_back(tmp_p);
-        }
-      }
-      pcl_tmp.points.clear();
-    }
-
-    // same code
-    if (
-      static_cast<int>(pcl_tmp.points.size()) > num_points_threshold_ ||
-      (pcl_tmp.points.front().x - pcl_tmp.points.back().x) *
-            (pcl_tmp.points.front().x - pcl_tmp.points.back().x) +
-          (pcl_tmp.points.front().y - pcl_tmp.points.back().y) *
-            (pcl_tmp.points.front().y - pcl_tmp.points.back().y) +
-          (pcl_tmp.points.front().z - pcl_tmp.points.back().z) *
-            (pcl_tmp.points.front().z - pcl_tmp.points.back().z) >=
-        object_length_threshold_ * object_length_threshold_) {
-      for (const auto & tmp_p : pcl_tmp.points) {
-        pcl_output->points.push_back(tmp_p);
-      }
+      copyWalk(ring, walk_begin, j + 1);
+      walk_begin = j + 1;
     }
-    pcl_tmp.points.clear();
+    copyWalk(ring, walk_begin, ring.size());
   }
 
-  pcl::toROSMsg(*pcl_output, output);
+  output.data.resize(num_output_points * output.point_step);
   output.header = input->header;
+  output.height = 1;
+  output.width = static_cast<uint32_t>(num_output_points);
+  output.row_step = output.width * output.point_step;
+  output.is_bigendian = input->is_bigendian;
+  output.is_dense = input->is_dense;
 }
 
 rcl_interfaces::msg::SetParametersResult RingOutlierFilterComponent::paramCallback(
@@ -14,12 +14,24 @@
 
 #include "pointcloud_preprocessor/outlier_filter/voxel_grid_outlier_filter_nodelet.hpp"
 
-#include <pcl/kdtree/kdtree_flann.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/segmentation/segment_differences.h>
-
+#include <cmath>
+#include <limits>
 #include <vector>
 
+namespace
+{
+// 21 bits for each axis, which covers 200 km at a voxel size of 0.1 m
+uint64_t toVoxelKey(const int64_t voxel_x, const int64_t voxel_y, const int64_t voxel_z)
+{
+  constexpr uint64_t mask = (uint64_t{1} << 21) - 1;
+  return ((static_cast<uint64_t>(voxel_x) & mask) << 42) |
+         ((static_cast<uint64_t>(voxel_y) & mask) << 21) | (static_cast<uint64_t>(voxel_z) & mask);
+}
+
+// never a voxel key, which uses 63 bits
+constexpr uint64_t invalid_voxel_key = std::numeric_limits<uint64_t>::max();
+}  // namespace
+
 namespace pointcloud_preprocessor
 {
 VoxelGridOutlierFilterComponent::VoxelGridOutlierFilterComponent(
@@ -44,22 +56,37 @@ void VoxelGridOutlierFilterComponent::filter(
 {
   boost::mutex::scoped_lock lock(mutex_);
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_input(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_voxelized_input(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(*input, *pcl_input);
-  pcl_voxelized_input->points.reserve(pcl_input->points.size());
-  voxel_filter.setInputCloud(pcl_input);
-  voxel_filter.setSaveLeafLayout(true);
-  voxel_filter.setLeafSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
-  voxel_filter.setMinimumPointsNumberPerVoxel(voxel_points_threshold_);
-  voxel_filter.filter(*pcl_voxelized_input);
+  const auto & points = pcl_input->points;
+
+  // count the points in each voxel, the same voxels as pcl::VoxelGrid without the centroids
+  const double inv_voxel_size_x = 1.0 / voxel_size_x_;
+  const double inv_voxel_size_y = 1.0 / voxel_size_y_;
+  const double inv_voxel_size_z = 1.0 / voxel_size_z_;
+  voxel_keys_.resize(points.size());
+  voxel_point_counts_.clear();
+  voxel_point_counts_.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto & p = points[i];
+    // pcl::VoxelGrid drops the points with NaN coordinates
+    if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+      voxel_keys_[i] = invalid_voxel_key;
+      continue;
+    }
+    voxel_keys_[i] = toVoxelKey(
+      static_cast<int64_t>(std::floor(p.x * inv_voxel_size_x)),
+      static_cast<int64_t>(std::floor(p.y * inv_voxel_size_y)),
+      static_cast<int64_t>(std::floor(p.z * inv_voxel_size_z)));
+    ++voxel_point_counts_[voxel_keys_[i]];
+  }
 
-  pcl_output->points.reserve(pcl_input->points.size());
-  for (size_t i = 0; i < pcl_input->points.size(); ++i) {
-    const int index = voxel_filter.getCentroidIndexAt(voxel_filter.getGridCoordinates(
-      pcl_input->points.at(i).x, pcl_input->points.at(i).y, pcl_input->points.at(i).z));
-    if (index != -1) {  // not empty voxel
-      pcl_output->points.push_back(pcl_input->points.at(i));
+  pcl_output->points.reserve(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (
+      voxel_keys_[i] != invalid_voxel_key &&
+      voxel_point_counts_.at(voxel_keys_[i]) >= voxel_points_threshold_) {
+      pcl_output->points.push_back(points[i]);
     }
   }
 
@@ -0,0 +1,190 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/passthrough_filter/field_range_filter.hpp"
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+namespace
+{
+using sensor_msgs::msg::PointField;
+
+template <typename T>
+double readAs(const uint8_t * data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return static_cast<double>(value);
+}
+
+double readField(const uint8_t * data, const uint8_t datatype)
+{
+  switch (datatype) {
+    case PointField::INT8:
+      return readAs<int8_t>(data);
+    case PointField::UINT8:
+      return readAs<uint8_t>(data);
+    case PointField::INT16:
+      return readAs<int16_t>(data);
+    case PointField::UINT16:
+      return readAs<uint16_t>(data);
+    case PointField::INT32:
+      return readAs<int32_t>(data);
+    case PointField::UINT32:
+      return readAs<uint32_t>(data);
+    case PointField::FLOAT32:
+      return readAs<float>(data);
+    default:
+      return readAs<double>(data);
+  }
+}
+
+bool isSupportedDatatype(const uint8_t datatype)
+{
+  return PointField::INT8 <= datatype && datatype <= PointField::FLOAT64;
+}
+}  // namespace
+
+void FieldRangeFilter::setRanges(const std::vector<FieldRange> & ranges)
+{
+  ranges_ = ranges;
+  is_layout_resolved_ = false;
+}
+
+void FieldRangeFilter::resolveLayout(const sensor_msgs::msg::PointCloud2 & input)
+{
+  layout_fields_ = input.fields;
+  layout_point_step_ = input.point_step;
+  is_layout_resolved_ = true;
+  is_layout_valid_ = true;
+
+  const auto findField = [&input](const std::string & name) -> const PointField * {
+    for (const auto & field : input.fields) {
+      if (field.name == name) {
+        return &field;
+      }
+    }
+    return nullptr;
+  };
+
+  conditions_.clear();
+  for (const auto & range : ranges_) {
+    const auto field = findField(range.field_name);
+    if (!field || !isSupportedDatatype(field->datatype)) {
+      is_layout_valid_ = false;
+      return;
+    }
+    conditions_.push_back(
+      FieldCondition{field->offset, field->datatype, range.min, range.max, range.negative});
+  }
+
+  xyz_offsets_.clear();
+  for (const auto & name : {"x", "y", "z"}) {
+    const auto field = findField(name);
+    if (field && field->datatype == PointField::FLOAT32) {
+      xyz_offsets_.push_back(field->offset);
+    }
+  }
+}
+
+bool FieldRangeFilter::isKept(const uint8_t * point) const
+{
+  // bitwise operators so that the conditions don't branch
+  bool is_kept = true;
+  for (const auto & condition : conditions_) {
+    const double value = readField(point + condition.offset, condition.datatype);
+    const bool is_inside = condition.negative ? (condition.min < value) & (value < condition.max)
+                                              : (condition.min <= value) & (value <= condition.max);
+    // non-finite values are removed either way
+    is_kept &= (is_inside != condition.negative) & (value == value);
+  }
+  return is_kept;
+}
+
+bool FieldRangeFilter::filter(
+  const sensor_msgs::msg::PointCloud2 & input, const std::vector<int> & indices,
+  sensor_msgs::msg::PointCloud2 & output)
+{
+  if (
+    !is_layout_resolved_ || input.point_step != layout_point_step_ ||
+    input.fields != layout_fields_) {
+    resolveLayout(input);
+  }
+  if (!is_layout_valid_) {
+    return false;
+  }
+
+  const size_t point_step = input.point_step;
+  const size_t num_points = static_cast<size_t>(input.width) * input.height;
+  const uint8_t * const src = input.data.data();
+
+  output.header = input.header;
+  output.fields = input.fields;
+  output.is_bigendian = input.is_bigendian;
+  output.point_step = input.point_step;
+
+  if (keep_organized_) {
+    output.data = input.data;
+    bool is_dense = input.is_dense;
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for (size_t i = 0; i < num_points; ++i) {
+      uint8_t * point = output.data.data() + i * point_step;
+      if (isKept(point)) {
+        continue;
+      }
+      for (const auto offset : xyz_offsets_) {
+        std::memcpy(point + offset, &nan, sizeof(float));
+      }
+      is_dense = false;
+    }
+    output.width = input.width;
+    output.height = input.height;
+    output.row_step = input.row_step;
+    output.is_dense = is_dense;
+    return true;
+  }
+
+  // Every point is copied to the end of the kept ones, which moves on only if it is kept.
+  const size_t num_input_points = indices.empty() ? num_points : indices.size();
+  output.data.resize(num_input_points * point_step);
+  uint8_t * dst = output.data.data();
+  if (indices.empty()) {
+    for (size_t i = 0; i < num_points; ++i) {
+      const uint8_t * point = src + i * point_step;
+      std::memcpy(dst, point, point_step);
+      dst += point_step * isKept(point);
+    }
+  } else {
+    for (const int index : indices) {
+      const uint8_t * point = src + static_cast<size_t>(index) * point_step;
+      std::memcpy(dst, point, point_step);
+      dst += point_step * isKept(point);
+    }
+  }
+
+  const size_t num_output_points =
+    point_step == 0 ? 0 : static_cast<size_t>(dst - output.data.data()) / point_step;
+  output.data.resize(num_output_points * point_step);
+  output.width = static_cast<uint32_t>(num_output_points);
+  output.height = 1;
+  output.row_step = output.width * output.point_step;
+  output.is_dense = input.is_dense;
+  return true;
+}
+
+}  // namespace pointcloud_preprocessor
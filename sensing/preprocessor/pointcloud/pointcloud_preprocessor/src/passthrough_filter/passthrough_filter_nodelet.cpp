@@ -50,10 +50,7 @@
 
 #include "pointcloud_preprocessor/passthrough_filter/passthrough_filter_nodelet.hpp"
 
-#include <pcl/kdtree/kdtree_flann.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/segmentation/segment_differences.h>
-
+#include <string>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -61,30 +58,107 @@ namespace pointcloud_preprocessor
 PassThroughFilterComponent::PassThroughFilterComponent(const rclcpp::NodeOptions & options)
 : Filter("PassThroughFilter", options)
 {
+  // set initial parameters
+  {
+    const auto field_names = declare_parameter("filter_field_names", std::vector<std::string>{});
+    const auto limits_min = declare_parameter("filter_limits_min", std::vector<double>{});
+    const auto limits_max = declare_parameter("filter_limits_max", std::vector<double>{});
+    const auto limits_negative = declare_parameter("filter_limits_negative", std::vector<bool>{});
+    if (!setRanges(field_names, limits_min, limits_max, limits_negative)) {
+      RCLCPP_ERROR(
+        get_logger(), "The sizes of filter_field_names and filter_limits_* are not the same.");
+    }
+    impl_.setKeepOrganized(static_cast<bool>(declare_parameter("keep_organized", false)));
+  }
+
   using std::placeholders::_1;
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&PassThroughFilterComponent::paramCallback, this, _1));
 }
 
+bool PassThroughFilterComponent::setRanges(
+  const std::vector<std::string> & field_names, const std::vector<double> & limits_min,
+  const std::vector<double> & limits_max, const std::vector<bool> & limits_negative)
+{
+  // filter_limits_negative may be left empty for no negative range
+  if (
+    limits_min.size() != field_names.size() || limits_max.size() != field_names.size() ||
+    (!limits_negative.empty() && limits_negative.size() != field_names.size())) {
+    return false;
+  }
+
+  std::vector<FieldRange> ranges;
+  for (size_t i = 0; i < field_names.size(); ++i) {
+    const bool negative = !limits_negative.empty() && limits_negative.at(i);
+    ranges.push_back(FieldRange{field_names.at(i), limits_min.at(i), limits_max.at(i), negative});
+  }
+  impl_.setRanges(ranges);
+  return true;
+}
+
 void PassThroughFilterComponent::filter(
-  const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
-  PointCloud2 & output)
+  const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output)
 {
   boost::mutex::scoped_lock lock(mutex_);
-  output = *input;
+
+  if (impl_.getRanges().empty()) {
+    output = *input;
+    return;
+  }
+
+  const std::vector<int> no_indices;
+  if (!impl_.filter(*input, indices ? *indices : no_indices, output)) {
+    RCLCPP_ERROR_THROTTLE(
+      get_logger(), *get_clock(), 5000, "Input pointcloud lacks a field of filter_field_names.");
+  }
 }
 
 rcl_interfaces::msg::SetParametersResult PassThroughFilterComponent::paramCallback(
-  [[maybe_unused]] const std::vector<rclcpp::Parameter> & p)
+  const std::vector<rclcpp::Parameter> & p)
 {
   boost::mutex::scoped_lock lock(mutex_);
 
-  // write me
-
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
   result.reason = "success";
 
+  // Check the current values of the ranges
+  std::vector<std::string> field_names;
+  std::vector<double> limits_min;
+  std::vector<double> limits_max;
+  std::vector<bool> limits_negative;
+  for (const auto & range : impl_.getRanges()) {
+    field_names.push_back(range.field_name);
+    limits_min.push_back(range.min);
+    limits_max.push_back(range.max);
+    limits_negative.push_back(range.negative);
+  }
+  bool is_range_changed = get_param(p, "filter_field_names", field_names);
+  is_range_changed |= get_param(p, "filter_limits_min", limits_min);
+  is_range_changed |= get_param(p, "filter_limits_max", limits_max);
+  if (get_param(p, "filter_limits_negative", limits_negative)) {
+    is_range_changed = true;
+  } else if (limits_negative.size() != field_names.size()) {
+    limits_negative.clear();
+  }
+  if (is_range_changed) {
+    if (setRanges(field_names, limits_min, limits_max, limits_negative)) {
+      RCLCPP_DEBUG(get_logger(), "Setting %zu filter ranges.", field_names.size());
+    } else {
+      result.successful = false;
+      result.reason = "The sizes of filter_field_names and filter_limits_* are not the same.";
+    }
+  }
+
+  // Check the current value for keep_organized
+  bool keep_organized;
+  if (get_param(p, "keep_organized", keep_organized)) {
+    RCLCPP_DEBUG(
+      get_logger(), "Setting the filter keep_organized value to: %s.",
+      keep_organized ? "true" : "false");
+    impl_.setKeepOrganized(keep_organized);
+  }
+
   return result;
 }
 }  // namespace pointcloud_preprocessor
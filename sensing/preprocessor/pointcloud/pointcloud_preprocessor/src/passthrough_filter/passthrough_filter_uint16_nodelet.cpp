@@ -14,10 +14,6 @@
 
 #include "pointcloud_preprocessor/passthrough_filter/passthrough_filter_uint16_nodelet.hpp"
 
-#include <pcl/kdtree/kdtree_flann.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/segmentation/segment_differences.h>
-
 #include <string>
 #include <vector>
 
@@ -29,15 +25,13 @@ PassThroughFilterUInt16Component::PassThroughFilterUInt16Component(
 {
   // set initial parameters
   {
-    int filter_min = static_cast<int>(declare_parameter("filter_limit_min", 0));
-    int filter_max = static_cast<int>(declare_parameter("filter_limit_max", 127));
-    impl_.setFilterLimits(filter_min, filter_max);
-
-    impl_.setFilterFieldName(
-      static_cast<std::string>(declare_parameter("filter_field_name", "ring")));
+    FieldRange range;
+    range.min = static_cast<int>(declare_parameter("filter_limit_min", 0));
+    range.max = static_cast<int>(declare_parameter("filter_limit_max", 127));
+    range.field_name = static_cast<std::string>(declare_parameter("filter_field_name", "ring"));
+    range.negative = static_cast<bool>(declare_parameter("filter_limit_negative", false));
+    impl_.setRanges({range});
     impl_.setKeepOrganized(static_cast<bool>(declare_parameter("keep_organized", false)));
-    impl_.setFilterLimitsNegative(
-      static_cast<bool>(declare_parameter("filter_limit_negative", false)));
   }
 
   using std::placeholders::_1;
@@ -50,13 +44,12 @@ void PassThroughFilterUInt16Component::filter(
 {
   boost::mutex::scoped_lock lock(mutex_);
 
-  pcl::PCLPointCloud2::Ptr pcl_input(new pcl::PCLPointCloud2);
-  pcl_conversions::toPCL(*(input), *(pcl_input));
-  impl_.setInputCloud(pcl_input);
-  impl_.setIndices(indices);
-  pcl::PCLPointCloud2 pcl_output;
-  impl_.filter(pcl_output);
-  pcl_conversions::moveFromPCL(pcl_output, output);
+  const std::vector<int> no_indices;
+  if (!impl_.filter(*input, indices ? *indices : no_indices, output)) {
+    RCLCPP_ERROR_THROTTLE(
+      get_logger(), *get_clock(), 5000, "Input pointcloud has no field %s.",
+      impl_.getRanges().front().field_name.c_str());
+  }
 }
 
 rcl_interfaces::msg::SetParametersResult PassThroughFilterUInt16Component::paramCallback(
@@ -64,56 +57,47 @@ rcl_interfaces::msg::SetParametersResult PassThroughFilterUInt16Component::param
 {
   boost::mutex::scoped_lock lock(mutex_);
 
-  std::uint16_t filter_min, filter_max;
-  impl_.getFilterLimits(filter_min, filter_max);
+  FieldRange range = impl_.getRanges().front();
 
   // Check the current values for filter min-max
+  int filter_min;
   if (get_param(p, "filter_limit_min", filter_min)) {
     RCLCPP_DEBUG(
       get_logger(), "Setting the minimum filtering value a point will be considered from to: %d.",
       filter_min);
-    // Set the filter min-max if different
-    impl_.setFilterLimits(filter_min, filter_max);
+    range.min = filter_min;
   }
   // Check the current values for filter min-max
+  int filter_max;
   if (get_param(p, "filter_limit_max", filter_max)) {
     RCLCPP_DEBUG(
       get_logger(), "Setting the maximum filtering value a point will be considered from to: %d.",
       filter_max);
-    // Set the filter min-max if different
-    impl_.setFilterLimits(filter_min, filter_max);
+    range.max = filter_max;
   }
 
   // Check the current value for the filter field
-  std::string filter_field_name;
-  get_param(p, "filter_field_name", filter_field_name);
-  if (impl_.getFilterFieldName() != filter_field_name) {
-    // Set the filter field if different
-    impl_.setFilterFieldName(filter_field_name);
-    RCLCPP_DEBUG(get_logger(), "Setting the filter field name to: %s.", filter_field_name.c_str());
+  if (get_param(p, "filter_field_name", range.field_name)) {
+    RCLCPP_DEBUG(get_logger(), "Setting the filter field name to: %s.", range.field_name.c_str());
   }
 
   // Check the current value for keep_organized
   bool keep_organized;
-  get_param(p, "keep_organized", keep_organized);
-  if (impl_.getKeepOrganized() != keep_organized) {
+  if (
+    get_param(p, "keep_organized", keep_organized) &&
+    impl_.getKeepOrganized() != keep_organized) {
     RCLCPP_DEBUG(
       get_logger(), "Setting the filter keep_organized value to: %s.",
       keep_organized ? "true" : "false");
-    // Call the virtual method in the child
     impl_.setKeepOrganized(keep_organized);
   }
 
   // Check the current value for the negative flag
-  bool filter_limit_negative;
-  get_param(p, "filter_limit_negative", filter_limit_negative);
-  if (impl_.getFilterLimitsNegative() != filter_limit_negative) {
+  if (get_param(p, "filter_limit_negative", range.negative)) {
     RCLCPP_DEBUG(
-      get_logger(), "Setting the filter negative flag to: %s.",
-      filter_limit_negative ? "true" : "false");
-    // Call the virtual method in the child
-    impl_.setFilterLimitsNegative(filter_limit_negative);
+      get_logger(), "Setting the filter negative flag to: %s.", range.negative ? "true" : "false");
   }
+  impl_.setRanges({range});
 
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
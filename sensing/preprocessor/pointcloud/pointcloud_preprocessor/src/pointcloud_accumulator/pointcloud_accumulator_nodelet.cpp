@@ -14,6 +14,10 @@
 
 #include "pointcloud_preprocessor/pointcloud_accumulator/pointcloud_accumulator_nodelet.hpp"
 
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -24,9 +28,10 @@ PointcloudAccumulatorComponent::PointcloudAccumulatorComponent(const rclcpp::Nod
   // set initial parameters
   {
     accumulation_time_sec_ = static_cast<double>(declare_parameter("accumulation_time_sec", 2.0));
-    pointcloud_buffer_.set_capacity(
-      static_cast<size_t>(declare_parameter("pointcloud_buffer_size", 50)));
+    pointcloud_buffer_size_ =
+      static_cast<size_t>(declare_parameter("pointcloud_buffer_size", 50));
   }
+  points_begin_ = 0;
 
   using std::placeholders::_1;
   set_param_res_ = this->add_on_set_parameters_callback(
@@ -38,18 +43,40 @@ void PointcloudAccumulatorComponent::filter(
   PointCloud2 & output)
 {
   boost::mutex::scoped_lock lock(mutex_);
-  pointcloud_buffer_.push_front(input);
-  rclcpp::Time last_time = input->header.stamp;
-  pcl::PointCloud<pcl::PointXYZ> pcl_input;
-  pcl::PointCloud<pcl::PointXYZ> pcl_output;
-  for (size_t i = 0; i < pointcloud_buffer_.size(); i++) {
-    if (accumulation_time_sec_ < (last_time - pointcloud_buffer_.at(i)->header.stamp).seconds()) {
-      break;
-    }
-    pcl::fromROSMsg(*pointcloud_buffer_.at(i), pcl_input);
-    pcl_output += pcl_input;
+
+  // Append the new sweep to the arena, each sweep is converted only once
+  const size_t num_points = input->width * input->height;
+  points_.reserve(points_.size() + num_points);
+  for (sensor_msgs::PointCloud2ConstIterator<float> x(*input, "x"), y(*input, "y"), z(*input, "z");
+       x != x.end(); ++x, ++y, ++z) {
+    points_.emplace_back(*x, *y, *z);
+  }
+  sweeps_.push_back({input->header.stamp, num_points, static_cast<bool>(input->is_dense)});
+
+  // Drop the sweeps out of the buffer size or the accumulation time from the oldest
+  const rclcpp::Time last_time = input->header.stamp;
+  while (!sweeps_.empty() &&
+         (pointcloud_buffer_size_ < sweeps_.size() ||
+          accumulation_time_sec_ < (last_time - sweeps_.front().stamp).seconds())) {
+    points_begin_ += sweeps_.front().size;
+    sweeps_.pop_front();
+  }
+  // Move the remaining points to the front once the dropped points take half of the arena
+  if (points_.size() < points_begin_ * 2) {
+    points_.erase(points_.begin(), points_.begin() + points_begin_);
+    points_begin_ = 0;
   }
-  pcl::toROSMsg(pcl_output, output);
+
+  // Output the accumulated points with a single copy
+  const size_t num_output_points = points_.size() - points_begin_;
+  sensor_msgs::PointCloud2Modifier modifier(output);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(num_output_points);
+  // the fields of "xyz" have the same layout as pcl::PointXYZ
+  std::memcpy(
+    output.data.data(), points_.data() + points_begin_, num_output_points * sizeof(pcl::PointXYZ));
+  output.is_dense = std::all_of(
+    sweeps_.begin(), sweeps_.end(), [](const Sweep & sweep) { return sweep.is_dense; });
   output.header = input->header;
 }
 
@@ -63,7 +90,7 @@ rcl_interfaces::msg::SetParametersResult PointcloudAccumulatorComponent::paramCa
   }
   int pointcloud_buffer_size;
   if (get_param(p, "pointcloud_buffer_size", pointcloud_buffer_size)) {
-    pointcloud_buffer_.set_capacity((size_t)pointcloud_buffer_size);
+    pointcloud_buffer_size_ = static_cast<size_t>(pointcloud_buffer_size);
     RCLCPP_DEBUG(get_logger(), "Setting new buffer size to: %d.", pointcloud_buffer_size);
   }
 
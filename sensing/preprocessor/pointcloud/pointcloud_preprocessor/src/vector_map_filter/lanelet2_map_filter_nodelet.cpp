@@ -41,6 +41,10 @@ Lanelet2MapFilterComponent::Lanelet2MapFilterComponent(const rclcpp::NodeOptions
   {
     voxel_size_x_ = declare_parameter("voxel_size_x", 0.04);
     voxel_size_y_ = declare_parameter("voxel_size_y", 0.04);
+    use_raster_mask_ = declare_parameter("use_raster_mask", false);
+    if (use_raster_mask_) {
+      raster_mask_ = std::make_unique<RoadRasterMask>(declare_parameter("raster_resolution", 0.2));
+    }
   }
 
   // Set publisher
@@ -216,6 +220,20 @@ pcl::PointCloud<pcl::PointXYZ> Lanelet2MapFilterComponent::getLaneFilteredPointC
   return filtered_cloud;
 }
 
+pcl::PointCloud<pcl::PointXYZ> Lanelet2MapFilterComponent::getRasterFilteredPointCloud(
+  const pcl::PointCloud<pcl::PointXYZ>::Ptr & cloud)
+{
+  pcl::PointCloud<pcl::PointXYZ> filtered_cloud;
+  filtered_cloud.header = cloud->header;
+  filtered_cloud.points.reserve(cloud->points.size());
+  for (const auto & p : cloud->points) {
+    if (raster_mask_->isInside(p.x, p.y)) {
+      filtered_cloud.points.push_back(p);
+    }
+  }
+  return filtered_cloud;
+}
+
 void Lanelet2MapFilterComponent::pointcloudCallback(const PointCloud2ConstPtr cloud_msg)
 {
   if (!lanelet_map_ptr_) {
@@ -236,12 +254,19 @@ void Lanelet2MapFilterComponent::pointcloudCallback(const PointCloud2ConstPtr cl
   if (cloud->points.empty()) {
     return;
   }
-  // calculate convex hull
-  const auto convex_hull = getConvexHull(cloud);
-  // get intersected lanelets
-  lanelet::ConstLanelets intersected_lanelets = getIntersectedLanelets(convex_hull, road_lanelets_);
-  // filter pointcloud by lanelet
-  const auto filtered_cloud = getLaneFilteredPointCloud(intersected_lanelets, cloud);
+  pcl::PointCloud<pcl::PointXYZ> filtered_cloud;
+  if (use_raster_mask_) {
+    // filter pointcloud by the raster of lanelets, one lookup per point
+    filtered_cloud = getRasterFilteredPointCloud(cloud);
+  } else {
+    // calculate convex hull
+    const auto convex_hull = getConvexHull(cloud);
+    // get intersected lanelets
+    lanelet::ConstLanelets intersected_lanelets =
+      getIntersectedLanelets(convex_hull, road_lanelets_);
+    // filter pointcloud by lanelet
+    filtered_cloud = getLaneFilteredPointCloud(intersected_lanelets, cloud);
+  }
   // transform pointcloud to input frame
   PointCloud2Ptr output_cloud_ptr(new sensor_msgs::msg::PointCloud2);
   pcl::toROSMsg(filtered_cloud, *output_cloud_ptr);
@@ -265,6 +290,13 @@ void Lanelet2MapFilterComponent::mapCallback(
   lanelet::utils::conversion::fromBinMsg(*map_msg, lanelet_map_ptr_);
   const lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
   road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
+
+  if (use_raster_mask_) {
+    raster_mask_->build(road_lanelets_);
+    RCLCPP_INFO(
+      get_logger(), "built raster mask of %zu road lanelets in %zu tiles at %.3f m resolution",
+      road_lanelets_.size(), raster_mask_->numTiles(), raster_mask_->resolution());
+  }
 }
 
 }  // namespace pointcloud_preprocessor
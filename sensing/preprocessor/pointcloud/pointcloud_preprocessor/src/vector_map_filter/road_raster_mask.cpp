@@ -0,0 +1,105 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/vector_map_filter/road_raster_mask.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+RoadRasterMask::RoadRasterMask(const double resolution) : resolution_(resolution) {}
+
+uint64_t RoadRasterMask::toTileKey(const int64_t col, const int64_t row)
+{
+  // arithmetic shift keeps negative cells in negative tiles
+  const auto tile_x = static_cast<uint32_t>(static_cast<int32_t>(col >> tile_bits));
+  const auto tile_y = static_cast<uint32_t>(static_cast<int32_t>(row >> tile_bits));
+  return (static_cast<uint64_t>(tile_x) << 32) | tile_y;
+}
+
+void RoadRasterMask::build(const lanelet::ConstLanelets & lanelets)
+{
+  tiles_.clear();
+  for (const auto & lanelet : lanelets) {
+    fillPolygon(lanelet.polygon2d().basicPolygon());
+  }
+}
+
+bool RoadRasterMask::isInside(const double x, const double y) const
+{
+  if (!std::isfinite(x) || !std::isfinite(y)) {
+    return false;
+  }
+  const auto col = static_cast<int64_t>(std::floor(x / resolution_));
+  const auto row = static_cast<int64_t>(std::floor(y / resolution_));
+  const auto itr = tiles_.find(toTileKey(col, row));
+  if (itr == tiles_.end()) {
+    return false;
+  }
+  const auto index = (row & (tile_width - 1)) * tile_width + (col & (tile_width - 1));
+  return (itr->second[index >> 6] >> (index & 63)) & 1U;
+}
+
+void RoadRasterMask::fillRow(const int64_t row, const int64_t col_begin, const int64_t col_end)
+{
+  for (int64_t col = col_begin; col <= col_end; ++col) {
+    auto & tile = tiles_[toTileKey(col, row)];
+    if (tile.empty()) {
+      tile.resize(tile_width * tile_width / 64, 0);
+    }
+    const auto index = (row & (tile_width - 1)) * tile_width + (col & (tile_width - 1));
+    tile[index >> 6] |= uint64_t{1} << (index & 63);
+  }
+}
+
+void RoadRasterMask::fillPolygon(const lanelet::BasicPolygon2d & polygon)
+{
+  if (polygon.size() < 3) {
+    return;
+  }
+
+  double min_y = polygon.front().y();
+  double max_y = polygon.front().y();
+  for (const auto & p : polygon) {
+    min_y = std::min(min_y, p.y());
+    max_y = std::max(max_y, p.y());
+  }
+
+  // scan the centers of the rows and fill the cells whose centers are between the crossings of
+  // the edges, so that each cell is visited once instead of a point-in-polygon test per cell
+  const auto row_begin = static_cast<int64_t>(std::ceil(min_y / resolution_ - 0.5));
+  const auto row_end = static_cast<int64_t>(std::floor(max_y / resolution_ - 0.5));
+  std::vector<double> crossings;
+  for (int64_t row = row_begin; row <= row_end; ++row) {
+    const double y = (static_cast<double>(row) + 0.5) * resolution_;
+    crossings.clear();
+    for (size_t i = 0; i < polygon.size(); ++i) {
+      const auto & p1 = polygon.at(i);
+      const auto & p2 = polygon.at((i + 1) % polygon.size());
+      if ((p1.y() <= y) != (p2.y() <= y)) {
+        crossings.push_back(p1.x() + (y - p1.y()) * (p2.x() - p1.x()) / (p2.y() - p1.y()));
+      }
+    }
+    std::sort(crossings.begin(), crossings.end());
+    for (size_t i = 0; i + 1 < crossings.size(); i += 2) {
+      fillRow(
+        row, static_cast<int64_t>(std::ceil(crossings.at(i) / resolution_ - 0.5)),
+        static_cast<int64_t>(std::floor(crossings.at(i + 1) / resolution_ - 0.5)));
+    }
+  }
+}
+
+}  // namespace pointcloud_preprocessor
@@ -0,0 +1,123 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_PCL_EXTENSIONS__TILED_VOXEL_MAP_HPP_
+#define TIER4_PCL_EXTENSIONS__TILED_VOXEL_MAP_HPP_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pcl
+{
+/** \brief Read-only voxel centroid index of a point cloud map, split into square xy tiles.
+ * Each tile holds its voxel keys sorted, so a lookup is a binary search over the tiles followed
+ * by a binary search inside one tile.
+ * The index can be saved to a flat file and memory-mapped by several processes. Pages of a
+ * tile are then only read from disk when a query touches that tile, and the page cache is
+ * shared between the processes instead of each one holding its own copy of the map.
+ */
+class TiledVoxelMap
+{
+public:
+  TiledVoxelMap() = default;
+  ~TiledVoxelMap();
+  TiledVoxelMap(const TiledVoxelMap &) = delete;
+  TiledVoxelMap & operator=(const TiledVoxelMap &) = delete;
+
+  /** \brief Build the index in memory. Points with non-finite coordinates are skipped.
+   * \param map the map point cloud
+   * \param leaf_size voxel edge length [m]
+   * \param tile_size tile edge length [m], rounded to a multiple of leaf_size
+   */
+  void build(
+    const pcl::PointCloud<pcl::PointXYZ> & map, const float leaf_size, const float tile_size);
+
+  /** \brief Write the index to path. The file is written next to path and renamed into place,
+   * so that processes loading it concurrently never see a partial file.
+   */
+  bool save(const std::string & path) const;
+
+  /** \brief Memory-map an index written by save(). Returns false if the file is missing or
+   * invalid, in which case the index is left empty.
+   */
+  bool load(const std::string & path);
+
+  void clear();
+
+  bool empty() const { return num_voxels_ == 0; }
+  size_t size() const { return num_voxels_; }
+  size_t getNumTiles() const { return num_tiles_; }
+  float getLeafSize() const { return leaf_size_; }
+  float getTileSize() const { return leaf_size_ * voxels_per_tile_; }
+
+  /** \brief Return the centroid (x, y, z) of the voxel at the given grid coordinates,
+   * or nullptr if the voxel is empty.
+   */
+  const float * getCentroidAt(const int64_t ix, const int64_t iy, const int64_t iz) const;
+
+  /** \brief Return true if the centroid of the voxel containing point or of one of its 26
+   * neighbours is closer to point than distance.
+   */
+  bool hasCentroidWithin(const pcl::PointXYZ & point, const float distance) const;
+
+private:
+  struct Tile
+  {
+    uint64_t key;
+    uint64_t begin;
+    uint64_t end;
+  };
+
+  struct FileHeader
+  {
+    char magic[8];
+    float leaf_size;
+    int32_t voxels_per_tile;
+    uint64_t num_tiles;
+    uint64_t num_voxels;
+  };
+
+  static uint64_t toVoxelKey(const int64_t ix, const int64_t iy, const int64_t iz);
+  static uint64_t toTileKey(const int64_t tx, const int64_t ty);
+  int64_t toTileCoordinate(const int64_t i) const;
+  void setViews(const Tile * tiles, const uint64_t * keys, const float * centroids);
+
+  float leaf_size_{1.0f};
+  float inverse_leaf_size_{1.0f};
+  int64_t voxels_per_tile_{1};
+  size_t num_tiles_{0};
+  size_t num_voxels_{0};
+
+  // storage when the index is built in memory
+  std::vector<Tile> tiles_storage_;
+  std::vector<uint64_t> keys_storage_;
+  std::vector<float> centroids_storage_;
+
+  // storage when the index is memory-mapped
+  void * mapped_{nullptr};
+  size_t mapped_size_{0};
+
+  // views into either storage
+  const Tile * tiles_{nullptr};
+  const uint64_t * keys_{nullptr};
+  const float * centroids_{nullptr};
+};
+}  // namespace pcl
+
+#endif  // TIER4_PCL_EXTENSIONS__TILED_VOXEL_MAP_HPP_
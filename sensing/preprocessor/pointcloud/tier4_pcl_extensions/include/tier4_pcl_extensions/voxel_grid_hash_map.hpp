@@ -0,0 +1,201 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_PCL_EXTENSIONS__VOXEL_GRID_HASH_MAP_HPP_
+#define TIER4_PCL_EXTENSIONS__VOXEL_GRID_HASH_MAP_HPP_
+
+#include <pcl/point_cloud.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace pcl
+{
+/** \brief Open addressing hash table from voxel coordinates to the indices of the voxels, in the
+ * order they are inserted. The slots keep their capacity between calls and are invalidated in O(1)
+ * by reset(), so an instance should be reused across frames.
+ */
+class VoxelIndexHashTable
+{
+public:
+  /** \brief Remove all the voxels, making room for up to max_num_voxels of them. */
+  void reset(const size_t max_num_voxels)
+  {
+    // keep the load factor at or below 0.5
+    size_t capacity = slots_.empty() ? 1024 : slots_.size();
+    while (capacity < 2 * max_num_voxels) {
+      capacity *= 2;
+    }
+    if (capacity != slots_.size()) {
+      slots_.assign(capacity, Slot{});
+      generation_ = 0;
+    }
+    if (++generation_ == 0) {
+      // the generation wrapped around, so stale slots could look valid
+      slots_.assign(slots_.size(), Slot{});
+      generation_ = 1;
+    }
+    num_voxels_ = 0;
+  }
+
+  /** \brief Index of the voxel at key, which is size() - 1 if the voxel has just been inserted. */
+  uint32_t insert(const uint64_t key)
+  {
+    auto & slot = slots_[findSlot(key)];
+    if (slot.generation != generation_) {
+      slot.key = key;
+      slot.generation = generation_;
+      slot.voxel_index = num_voxels_++;
+    }
+    return slot.voxel_index;
+  }
+
+  /** \brief Index of the voxel at key, or false if there is none. */
+  bool find(const uint64_t key, uint32_t & voxel_index) const
+  {
+    if (slots_.empty()) {
+      return false;
+    }
+    const auto & slot = slots_[findSlot(key)];
+    voxel_index = slot.voxel_index;
+    return slot.generation == generation_;
+  }
+
+  /** \brief Number of voxels inserted since the last reset(). */
+  size_t size() const { return num_voxels_; }
+
+  /** \brief Key of the voxel at the given coordinates, which wrap around every 2^21 voxels. */
+  static uint64_t toKey(const int64_t ix, const int64_t iy, const int64_t iz)
+  {
+    constexpr uint64_t mask = (uint64_t{1} << 21) - 1;
+    return ((static_cast<uint64_t>(ix) & mask) << 42) | ((static_cast<uint64_t>(iy) & mask) << 21) |
+           (static_cast<uint64_t>(iz) & mask);
+  }
+
+private:
+  struct Slot
+  {
+    uint64_t key = 0;
+    uint32_t generation = 0;  // the slot is used only if it equals generation_
+    uint32_t voxel_index = 0;
+  };
+
+  /** \brief Slot of key, or the empty slot it would be inserted into. */
+  size_t findSlot(const uint64_t key) const
+  {
+    // linear probing
+    size_t slot_index = hash(key) & (slots_.size() - 1);
+    while (slots_[slot_index].generation == generation_ && slots_[slot_index].key != key) {
+      slot_index = (slot_index + 1) & (slots_.size() - 1);
+    }
+    return slot_index;
+  }
+
+  static size_t hash(const uint64_t key)
+  {
+    // 64 bit finalizer of MurmurHash3
+    uint64_t h = key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+  }
+
+  std::vector<Slot> slots_;
+  uint32_t generation_ = 0;
+  uint32_t num_voxels_ = 0;
+};
+
+/** \brief Voxel grid downsampler backed by an open addressing hash map keyed by voxel coordinates.
+ * Centroids are computed in one pass without sorting, and the hash map keeps its capacity
+ * between calls, so an instance should be reused across frames.
+ * Fields other than x/y/z are taken from the first point that falls into each voxel.
+ */
+template <typename PointT>
+class VoxelGridHashMap
+{
+public:
+  /** \brief Set the voxel grid leaf size. */
+  void setLeafSize(const float lx, const float ly, const float lz)
+  {
+    inverse_leaf_size_x_ = 1.0f / lx;
+    inverse_leaf_size_y_ = 1.0f / ly;
+    inverse_leaf_size_z_ = 1.0f / lz;
+  }
+
+  /** \brief Downsample input into output. Points with non-finite coordinates are skipped. */
+  void filter(const pcl::PointCloud<PointT> & input, pcl::PointCloud<PointT> & output)
+  {
+    table_.reset(input.points.size());
+    voxels_.clear();
+    voxels_.reserve(input.points.size());
+
+    for (size_t i = 0; i < input.points.size(); ++i) {
+      const auto & p = input.points[i];
+      if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+        continue;
+      }
+      const uint32_t voxel_index = table_.insert(VoxelIndexHashTable::toKey(
+        static_cast<int64_t>(std::floor(p.x * inverse_leaf_size_x_)),
+        static_cast<int64_t>(std::floor(p.y * inverse_leaf_size_y_)),
+        static_cast<int64_t>(std::floor(p.z * inverse_leaf_size_z_))));
+      if (voxel_index == voxels_.size()) {
+        voxels_.push_back(Voxel{p.x, p.y, p.z, 1, static_cast<uint32_t>(i)});
+        continue;
+      }
+      auto & voxel = voxels_[voxel_index];
+      voxel.sum_x += p.x;
+      voxel.sum_y += p.y;
+      voxel.sum_z += p.z;
+      ++voxel.num_points;
+    }
+
+    output.points.resize(voxels_.size());
+    for (size_t i = 0; i < voxels_.size(); ++i) {
+      const auto & voxel = voxels_[i];
+      auto & p = output.points[i];
+      p = input.points[voxel.first_point_index];
+      p.x = static_cast<float>(voxel.sum_x / voxel.num_points);
+      p.y = static_cast<float>(voxel.sum_y / voxel.num_points);
+      p.z = static_cast<float>(voxel.sum_z / voxel.num_points);
+    }
+    output.header = input.header;
+    output.width = static_cast<uint32_t>(output.points.size());
+    output.height = 1;
+    output.is_dense = true;
+  }
+
+private:
+  struct Voxel
+  {
+    double sum_x;
+    double sum_y;
+    double sum_z;
+    uint32_t num_points;
+    uint32_t first_point_index;
+  };
+
+  float inverse_leaf_size_x_ = 1.0f;
+  float inverse_leaf_size_y_ = 1.0f;
+  float inverse_leaf_size_z_ = 1.0f;
+
+  VoxelIndexHashTable table_;
+  std::vector<Voxel> voxels_;
+};
+}  // namespace pcl
+
+#endif  // TIER4_PCL_EXTENSIONS__VOXEL_GRID_HASH_MAP_HPP_
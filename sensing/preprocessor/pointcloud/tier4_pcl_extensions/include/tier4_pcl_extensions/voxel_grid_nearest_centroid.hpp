@@ -51,12 +51,15 @@
 #ifndef TIER4_PCL_EXTENSIONS__VOXEL_GRID_NEAREST_CENTROID_HPP_
 #define TIER4_PCL_EXTENSIONS__VOXEL_GRID_NEAREST_CENTROID_HPP_
 
+#include "tier4_pcl_extensions/voxel_grid_hash_map.hpp"
+
 #include <pcl/filters/boost.h>
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/kdtree/kdtree_flann.h>
 #include <pcl/point_types.h>
 
-#include <map>
+#include <cmath>
+#include <cstdint>
 #include <vector>
 
 namespace pcl
@@ -193,8 +196,6 @@ public:
 
     /** \brief Eigen values of voxel covariance matrix */
     // Eigen::Vector3d evals_;
-
-    PointCloud points;
   };
 
   /** \brief Pointer to VoxelGridNearestCentroid leaf structure */
@@ -215,7 +216,8 @@ public:
     leaves_(),
     voxel_centroids_(),
     voxel_centroids_leaf_indices_(),
-    kdtree_()
+    kdtree_(),
+    is_kdtree_built_(false)
   {
     downsample_all_data_ = false;
     save_leaf_layout_ = false;
@@ -272,7 +274,7 @@ public:
   /** \brief Filter cloud and initializes voxel structure.
    * \param[out] output cloud containing centroids of voxels containing a sufficient number of
    * points \param[in] searchable flag if voxel structure is searchable, if true then kdtree is
-   * built
+   * built by the first search
    */
   inline void filter(PointCloud & output, bool searchable = false)
   {
@@ -280,41 +282,31 @@ public:
     applyFilter(output);
 
     voxel_centroids_ = PointCloudPtr(new PointCloud(output));
-
-    if (searchable_ && voxel_centroids_->size() > 0) {
-      // Initiates kdtree of the centroids of voxels containing a sufficient number of points
-      kdtree_.setInputCloud(voxel_centroids_);
-    }
+    is_kdtree_built_ = false;
   }
 
   /** \brief Initializes voxel structure.
-   * \param[in] searchable flag if voxel structure is searchable, if true then kdtree is built
+   * \param[in] searchable flag if voxel structure is searchable, if true then kdtree is built by
+   * the first search
    */
   inline void filter(bool searchable = false)
   {
     searchable_ = searchable;
     voxel_centroids_ = PointCloudPtr(new PointCloud);
     applyFilter(*voxel_centroids_);
-
-    if (searchable_ && voxel_centroids_->size() > 0) {
-      // Initiates kdtree of the centroids of voxels containing a sufficient number of points
-      kdtree_.setInputCloud(voxel_centroids_);
-    }
+    is_kdtree_built_ = false;
   }
 
-  /** \brief Get the voxel containing point p.
-   * \param[in] index the index of the leaf structure node
+  /** \brief Get the voxel at index.
+   * \param[in] index the index of the leaf structure node, in the order of \ref getLeaves
    * \return const pointer to leaf structure
    */
   inline LeafConstPtr getLeaf(int index)
   {
-    typename std::map<size_t, Leaf>::iterator leaf_iter = leaves_.find(index);
-    if (leaf_iter != leaves_.end()) {
-      LeafConstPtr ret(&(leaf_iter->second));
-      return ret;
-    } else {
+    if (index < 0 || index >= static_cast<int>(leaves_.size())) {
       return NULL;
     }
+    return &leaves_[index];
   }
 
   /** \brief Get the voxel containing point p.
@@ -323,23 +315,13 @@ public:
    */
   inline LeafConstPtr getLeaf(PointT & p)
   {
-    // Generate index associated with p
-    int ijk0 = static_cast<int>(floor(p.x * inverse_leaf_size_[0]) - min_b_[0]);
-    int ijk1 = static_cast<int>(floor(p.y * inverse_leaf_size_[1]) - min_b_[1]);
-    int ijk2 = static_cast<int>(floor(p.z * inverse_leaf_size_[2]) - min_b_[2]);
-
-    // Compute the centroid leaf index
-    int idx = ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
-
-    // Find leaf associated with index
-    typename std::map<size_t, Leaf>::iterator leaf_iter = leaves_.find(idx);
-    if (leaf_iter != leaves_.end()) {
+    // Find leaf associated with p
+    std::uint32_t leaf_index;
+    if (leaf_table_.find(toLeafKey(p.x, p.y, p.z), leaf_index)) {
       // If such a leaf exists return the pointer to the leaf structure
-      LeafConstPtr ret(&(leaf_iter->second));
-      return ret;
-    } else {
-      return NULL;
+      return &leaves_[leaf_index];
     }
+    return NULL;
   }
 
   /** \brief Get the voxel containing point p.
@@ -348,23 +330,13 @@ public:
    */
   inline LeafConstPtr getLeaf(Eigen::Vector3f & p)
   {
-    // Generate index associated with p
-    int ijk0 = static_cast<int>(floor(p[0] * inverse_leaf_size_[0]) - min_b_[0]);
-    int ijk1 = static_cast<int>(floor(p[1] * inverse_leaf_size_[1]) - min_b_[1]);
-    int ijk2 = static_cast<int>(floor(p[2] * inverse_leaf_size_[2]) - min_b_[2]);
-
-    // Compute the centroid leaf index
-    int idx = ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
-
-    // Find leaf associated with index
-    typename std::map<size_t, Leaf>::iterator leaf_iter = leaves_.find(idx);
-    if (leaf_iter != leaves_.end()) {
+    // Find leaf associated with p
+    std::uint32_t leaf_index;
+    if (leaf_table_.find(toLeafKey(p[0], p[1], p[2]), leaf_index)) {
       // If such a leaf exists return the pointer to the leaf structure
-      LeafConstPtr ret(&(leaf_iter->second));
-      return ret;
-    } else {
-      return NULL;
+      return &leaves_[leaf_index];
     }
+    return NULL;
   }
 
   /** \brief Get the voxels surrounding point p, not including the voxel containing point p.
@@ -378,7 +350,7 @@ public:
   /** \brief Get the leaf structure map
    * \return a map containing all leaves
    */
-  inline const std::map<size_t, Leaf> & getLeaves() { return leaves_; }
+  inline const std::vector<Leaf> & getLeaves() { return leaves_; }
 
   /** \brief Get a pointcloud containing the voxel centroids
    * \note Only voxels containing a sufficient number of points are used.
@@ -406,11 +378,14 @@ public:
   {
     k_leaves.clear();
 
-    // Check if kdtree has been built
+    // Check if kdtree can be built
     if (!searchable_) {
       PCL_WARN("%s: Not Searchable", this->getClassName().c_str());
       return 0;
     }
+    if (!buildKdTree()) {
+      return 0;
+    }
 
     // Find k-nearest neighbors in the occupied voxel centroid cloud
     std::vector<int> k_indices;
@@ -458,11 +433,14 @@ public:
   {
     k_leaves.clear();
 
-    // Check if kdtree has been built
+    // Check if kdtree can be built
     if (!searchable_) {
       PCL_WARN("%s: Not Searchable", this->getClassName().c_str());
       return 0;
     }
+    if (!buildKdTree()) {
+      return 0;
+    }
 
     // Find neighbors within radius in the occupied voxel centroid cloud
     std::vector<int> k_indices;
@@ -497,6 +475,32 @@ public:
   }
 
 protected:
+  /** \brief Build the kdtree of \ref voxel_centroids_ if it has not been built since the last
+   * filter call.
+   * \return false if there is no voxel to search
+   */
+  bool buildKdTree()
+  {
+    if (!voxel_centroids_ || voxel_centroids_->empty()) {
+      return false;
+    }
+    if (!is_kdtree_built_) {
+      // Initiates kdtree of the centroids of voxels containing a sufficient number of points
+      kdtree_.setInputCloud(voxel_centroids_);
+      is_kdtree_built_ = true;
+    }
+    return true;
+  }
+
+  /** \brief Key of the leaf containing the point (x, y, z) in \ref leaf_table_ */
+  inline std::uint64_t toLeafKey(float x, float y, float z) const
+  {
+    return VoxelIndexHashTable::toKey(
+      static_cast<std::int64_t>(std::floor(x * inverse_leaf_size_[0])),
+      static_cast<std::int64_t>(std::floor(y * inverse_leaf_size_[1])),
+      static_cast<std::int64_t>(std::floor(z * inverse_leaf_size_[2])));
+  }
+
   /** \brief Filter cloud and initializes voxel structure.
    * \param[out] output cloud containing centroids of voxels containing a sufficient
    *                    number of points
@@ -514,8 +518,18 @@ protected:
   // double min_covar_eigvalue_mult_;
 
   /** \brief Voxel structure containing all leaf nodes (includes voxels with less than
-   *         a sufficient number of points). */
-  std::map<size_t, Leaf> leaves_;
+   *         a sufficient number of points), in the order they are found in the input. */
+  std::vector<Leaf> leaves_;
+
+  /** \brief Indices in \ref leaves_ by the coordinates of the leaves. */
+  VoxelIndexHashTable leaf_table_;
+
+  /** \brief Index of the leaf of each input point, for the nearest point search. */
+  std::vector<std::uint32_t> point_leaf_indices_;
+
+  /** \brief Index and squared distance of the input point nearest to each leaf centroid. */
+  std::vector<std::uint32_t> nearest_point_indices_;
+  std::vector<double> nearest_sqr_distances_;
 
   /** \brief Point cloud containing centroids of voxels containing atleast
    *         minimum number of points. */
@@ -527,6 +541,9 @@ protected:
 
   /** \brief KdTree generated using \ref voxel_centroids_ (used for searching). */
   KdTreeFLANN<PointT> kdtree_;
+
+  /** \brief Flag to determine if \ref kdtree_ has been built for the last filter call. */
+  bool is_kdtree_built_;
 };
 }  // namespace pcl
 
@@ -60,7 +60,6 @@
 #include <pcl/filters/boost.h>
 
 #include <limits>
-#include <map>
 #include <vector>
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -80,47 +79,10 @@ void pcl::VoxelGridNearestCentroid<PointT>::applyFilter(PointCloud & output)
   output.is_dense = true;  // we filter out invalid points
   output.points.clear();
 
-  Eigen::Vector4f min_p, max_p;
-  // Get the minimum and maximum dimensions
-  if (!filter_field_name_.empty()) {  // If we don't want to process the entire cloud...
-    getMinMax3D<PointT>(
-      input_, filter_field_name_, static_cast<float>(filter_limit_min_),
-      static_cast<float>(filter_limit_max_), min_p, max_p, filter_limit_negative_);
-  } else {
-    getMinMax3D<PointT>(*input_, min_p, max_p);
-  }
-
-  // Check that the leaf size is not too small, given the size of the data
-  std::int64_t dx = static_cast<std::int64_t>((max_p[0] - min_p[0]) * inverse_leaf_size_[0]) + 1;
-  std::int64_t dy = static_cast<std::int64_t>((max_p[1] - min_p[1]) * inverse_leaf_size_[1]) + 1;
-  std::int64_t dz = static_cast<std::int64_t>((max_p[2] - min_p[2]) * inverse_leaf_size_[2]) + 1;
-
-  if ((dx * dy * dz) > std::numeric_limits<std::int32_t>::max()) {
-    PCL_WARN(
-      "[pcl::%s::applyFilter] Leaf size is too small for the input dataset. Integer indices would "
-      "overflow.",  // NOLINT
-      getClassName().c_str());
-    output.clear();
-    return;
-  }
-
-  // Compute the minimum and maximum bounding box values
-  min_b_[0] = static_cast<int>(floor(min_p[0] * inverse_leaf_size_[0]));
-  max_b_[0] = static_cast<int>(floor(max_p[0] * inverse_leaf_size_[0]));
-  min_b_[1] = static_cast<int>(floor(min_p[1] * inverse_leaf_size_[1]));
-  max_b_[1] = static_cast<int>(floor(max_p[1] * inverse_leaf_size_[1]));
-  min_b_[2] = static_cast<int>(floor(min_p[2] * inverse_leaf_size_[2]));
-  max_b_[2] = static_cast<int>(floor(max_p[2] * inverse_leaf_size_[2]));
-
-  // Compute the number of divisions needed along all axis
-  div_b_ = max_b_ - min_b_ + Eigen::Vector4i::Ones();
-  div_b_[3] = 0;
-
-  // Clear the leaves
-  leaves_.clear();
-
-  // Set up the division multiplier
-  divb_mul_ = Eigen::Vector4i(1, div_b_[0], div_b_[0] * div_b_[1], 0);
+  // The leaves are found by hashing their coordinates, so there is no bounding box to compute and
+  // no leaf layout of it to save.
+  leaf_layout_.clear();
+  voxel_centroids_leaf_indices_.clear();
 
   int centroid_size = 4;
 
@@ -142,6 +104,7 @@ void pcl::VoxelGridNearestCentroid<PointT>::applyFilter(PointCloud & output)
 
   // If we don't want to process the entire cloud, but rather filter points far
   // away from the viewpoint first...
+  int distance_offset = -1;
   if (!filter_field_name_.empty()) {
     // Get the distance field index
     std::vector<pcl::PCLPointField> fields;
@@ -150,23 +113,33 @@ void pcl::VoxelGridNearestCentroid<PointT>::applyFilter(PointCloud & output)
       PCL_WARN(
         "[pcl::%s::applyFilter] Invalid filter field name. Index is %d.\n", getClassName().c_str(),
         distance_idx);
+      output.width = 0;
+      return;
     }
+    distance_offset = static_cast<int>(fields[distance_idx].offset);
+  }
 
-    // First pass: go over all points and insert them into the right leaf
-    for (size_t cp = 0; cp < input_->points.size(); ++cp) {
-      if (!input_->is_dense) {
-        // Check if the point is invalid
-        if (
-          !std::isfinite(input_->points[cp].x) || !std::isfinite(input_->points[cp].y) ||
-          !std::isfinite(input_->points[cp].z)) {
-          continue;
-        }
+  // First pass: go over all points and insert them into the right leaf
+  constexpr std::uint32_t no_leaf = std::numeric_limits<std::uint32_t>::max();
+  const size_t num_points = input_->points.size();
+  leaf_table_.reset(num_points);
+  point_leaf_indices_.resize(num_points);
+  for (size_t cp = 0; cp < num_points; ++cp) {
+    const PointT & point = input_->points[cp];
+    point_leaf_indices_[cp] = no_leaf;
+
+    if (!input_->is_dense) {
+      // Check if the point is invalid
+      if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+        continue;
       }
+    }
 
+    if (distance_offset >= 0) {
       // Get the distance value
-      const std::uint8_t * pt_data = reinterpret_cast<const std::uint8_t *>(&input_->points[cp]);
+      const std::uint8_t * pt_data = reinterpret_cast<const std::uint8_t *>(&point);
       float distance_value = 0;
-      memcpy(&distance_value, pt_data + fields[distance_idx].offset, sizeof(float));
+      memcpy(&distance_value, pt_data + distance_offset, sizeof(float));
 
       if (filter_limit_negative_) {
         // Use a threshold for cutting out points which inside the interval
@@ -179,161 +152,86 @@ void pcl::VoxelGridNearestCentroid<PointT>::applyFilter(PointCloud & output)
           continue;
         }
       }
+    }
 
-      int ijk0 = static_cast<int>(
-        floor(input_->points[cp].x * inverse_leaf_size_[0]) - static_cast<float>(min_b_[0]));
-      int ijk1 = static_cast<int>(
-        floor(input_->points[cp].y * inverse_leaf_size_[1]) - static_cast<float>(min_b_[1]));
-      int ijk2 = static_cast<int>(
-        floor(input_->points[cp].z * inverse_leaf_size_[2]) - static_cast<float>(min_b_[2]));
-
-      // Compute the centroid leaf index
-      int idx = ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
-
-      Leaf & leaf = leaves_[idx];
-      if (leaf.nr_points == 0) {
-        leaf.centroid.resize(centroid_size);
-        leaf.centroid.setZero();
-      }
-
-      // Eigen::Vector3d pt3d (input_->points[cp].x, input_->points[cp].y, input_->points[cp].z);
+    const size_t num_leaves = leaf_table_.size();
+    const std::uint32_t leaf_index = leaf_table_.insert(toLeafKey(point.x, point.y, point.z));
+    point_leaf_indices_[cp] = leaf_index;
 
-      // Do we need to process all the fields?
-      if (!downsample_all_data_) {
-        Eigen::Vector4f pt(input_->points[cp].x, input_->points[cp].y, input_->points[cp].z, 0);
-        leaf.centroid.template head<4>() += pt;
-      } else {
-        // Copy all the fields
-        Eigen::VectorXf centroid = Eigen::VectorXf::Zero(centroid_size);
-        // ---[ RGB special case
-        if (rgba_index >= 0) {
-          // fill r/g/b data
-          int rgb;
-          memcpy(
-            &rgb, reinterpret_cast<const char *>(&input_->points[cp]) + rgba_index, sizeof(int));
-          centroid[centroid_size - 3] = static_cast<float>((rgb >> 16) & 0x0000ff);
-          centroid[centroid_size - 2] = static_cast<float>((rgb >> 8) & 0x0000ff);
-          centroid[centroid_size - 1] = static_cast<float>((rgb)&0x0000ff);
-        }
-        pcl::for_each_type<FieldList>(
-          NdCopyPointEigenFunctor<PointT>(input_->points[cp], centroid));
-        leaf.centroid += centroid;
+    // The leaves of the previous calls are reused to keep the memory of their centroids
+    if (leaf_table_.size() != num_leaves) {
+      if (leaf_index == leaves_.size()) {
+        leaves_.emplace_back();
       }
-      ++leaf.nr_points;
+      Leaf & leaf = leaves_[leaf_index];
+      leaf.nr_points = 0;
+      leaf.centroid.resize(centroid_size);
+      leaf.centroid.setZero();
     }
-  } else {  // No distance filtering, process all data
-    // First pass: go over all points and insert them into the right leaf
-    for (size_t cp = 0; cp < input_->points.size(); ++cp) {
-      if (!input_->is_dense) {
-        // Check if the point is invalid
-        if (
-          !std::isfinite(input_->points[cp].x) || !std::isfinite(input_->points[cp].y) ||
-          !std::isfinite(input_->points[cp].z)) {
-          continue;
-        }
-      }
-
-      int ijk0 = static_cast<int>(
-        floor(input_->points[cp].x * inverse_leaf_size_[0]) - static_cast<float>(min_b_[0]));
-      int ijk1 = static_cast<int>(
-        floor(input_->points[cp].y * inverse_leaf_size_[1]) - static_cast<float>(min_b_[1]));
-      int ijk2 = static_cast<int>(
-        floor(input_->points[cp].z * inverse_leaf_size_[2]) - static_cast<float>(min_b_[2]));
-
-      // Compute the centroid leaf index
-      int idx = ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
-
-      Leaf & leaf = leaves_[idx];
-      if (leaf.nr_points == 0) {
-        leaf.centroid.resize(centroid_size);
-        leaf.centroid.setZero();
+    Leaf & leaf = leaves_[leaf_index];
+
+    // Do we need to process all the fields?
+    if (!downsample_all_data_) {
+      Eigen::Vector4f pt(point.x, point.y, point.z, 0);
+      leaf.centroid.template head<4>() += pt;
+    } else {
+      // Copy all the fields
+      Eigen::VectorXf centroid = Eigen::VectorXf::Zero(centroid_size);
+      // ---[ RGB special case
+      if (rgba_index >= 0) {
+        // Fill r/g/b data, assuming that the order is BGRA
+        int rgb;
+        memcpy(&rgb, reinterpret_cast<const char *>(&point) + rgba_index, sizeof(int));
+        centroid[centroid_size - 3] = static_cast<float>((rgb >> 16) & 0x0000ff);
+        centroid[centroid_size - 2] = static_cast<float>((rgb >> 8) & 0x0000ff);
+        centroid[centroid_size - 1] = static_cast<float>((rgb)&0x0000ff);
       }
+      pcl::for_each_type<FieldList>(NdCopyPointEigenFunctor<PointT>(point, centroid));
+      leaf.centroid += centroid;
+    }
+    ++leaf.nr_points;
+  }
+  leaves_.resize(leaf_table_.size());
 
-      // Do we need to process all the fields?
-      if (!downsample_all_data_) {
-        Eigen::Vector4f pt(input_->points[cp].x, input_->points[cp].y, input_->points[cp].z, 0);
-        leaf.centroid.template head<4>() += pt;
-      } else {
-        // Copy all the fields
-        Eigen::VectorXf centroid = Eigen::VectorXf::Zero(centroid_size);
-        // ---[ RGB special case
-        if (rgba_index >= 0) {
-          // Fill r/g/b data, assuming that the order is BGRA
-          int rgb;
-          memcpy(
-            &rgb, reinterpret_cast<const char *>(&input_->points[cp]) + rgba_index, sizeof(int));
-          centroid[centroid_size - 3] = static_cast<float>((rgb >> 16) & 0x0000ff);
-          centroid[centroid_size - 2] = static_cast<float>((rgb >> 8) & 0x0000ff);
-          centroid[centroid_size - 1] = static_cast<float>((rgb)&0x0000ff);
-        }
-        pcl::for_each_type<FieldList>(
-          NdCopyPointEigenFunctor<PointT>(input_->points[cp], centroid));
-        leaf.centroid += centroid;
-      }
-      leaf.points.push_back(input_->points[cp]);
-      ++leaf.nr_points;
+  // Second pass: normalize the centroids and find the point nearest to each of them
+  for (Leaf & leaf : leaves_) {
+    leaf.centroid /= static_cast<float>(leaf.nr_points);
+  }
+  nearest_point_indices_.resize(leaves_.size());
+  nearest_sqr_distances_.assign(leaves_.size(), std::numeric_limits<double>::max());
+  for (size_t cp = 0; cp < num_points; ++cp) {
+    const std::uint32_t leaf_index = point_leaf_indices_[cp];
+    if (leaf_index == no_leaf) {
+      continue;
+    }
+    const PointT & point = input_->points[cp];
+    const Eigen::VectorXf & centroid = leaves_[leaf_index].centroid;
+    const double dx = point.x - centroid[0];
+    const double dy = point.y - centroid[1];
+    const double dz = point.z - centroid[2];
+    const double dis = dx * dx + dy * dy + dz * dz;
+    if (dis < nearest_sqr_distances_[leaf_index]) {
+      nearest_sqr_distances_[leaf_index] = dis;
+      nearest_point_indices_[leaf_index] = static_cast<std::uint32_t>(cp);
     }
   }
 
-  // Second pass: go over all leaves and compute centroids and covariance matrices
+  // Third pass: output the nearest points of the leaves with enough points, in the order the
+  // leaves have been found
   output.points.reserve(leaves_.size());
   if (searchable_) {
     voxel_centroids_leaf_indices_.reserve(leaves_.size());
   }
-  int cp = 0;
-  if (save_leaf_layout_) {
-    leaf_layout_.resize(div_b_[0] * div_b_[1] * div_b_[2], -1);
-  }
-
-  // Eigen values and vectors calculated to prevent near singular matrices
-  // Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigensolver;
-  // Eigen::Matrix3d eigen_val;
-  // Eigen::Vector3d pt_sum;
-
-  // Eigen values less than a threshold of max eigen value are inflated to a set fraction of the
-  // max eigen value.
-  // double min_covar_eigvalue;
-
-  for (typename std::map<size_t, Leaf>::iterator it = leaves_.begin(); it != leaves_.end(); ++it) {
-    // Normalize the centroid
-    Leaf & leaf = it->second;
-
-    // Normalize the centroid
-    leaf.centroid /= static_cast<float>(leaf.nr_points);
-    // Point sum used for single pass covariance calculation
-    // pt_sum = leaf.mean_;
-    // Normalize mean
-    // leaf.mean_ /= leaf.nr_points;
-
-    // If the voxel contains sufficient points, its covariance is calculated and is added to the
-    // voxel centroids and output clouds.
-    // Points with less than the minimum points will have a can not be accurately approximated
-    // using a normal distribution.
-    if (leaf.nr_points >= min_points_per_voxel_) {
-      if (save_leaf_layout_) {
-        leaf_layout_[it->first] = cp++;
-      }
-
-      output.push_back(PointT());
-
-      // TODO(kenji.miyake) refactor
-      double dis_min = 1000000.0;
-      size_t i_min = 0;
-      for (size_t i = 0; i < leaf.points.size(); ++i) {
-        double dis = std::pow(leaf.points.at(i).x - leaf.centroid[0], 2.0) +
-                     std::pow(leaf.points.at(i).y - leaf.centroid[1], 2.0) +
-                     std::pow(leaf.points.at(i).z - leaf.centroid[2], 2.0);
-        if (dis < dis_min) {
-          dis_min = dis;
-          i_min = i;
-        }
-      }
-      output.points.back() = leaf.points.at(i_min);
+  for (size_t leaf_index = 0; leaf_index < leaves_.size(); ++leaf_index) {
+    // Leaves with too few points are not output
+    if (leaves_[leaf_index].nr_points < min_points_per_voxel_) {
+      continue;
+    }
+    output.points.push_back(input_->points[nearest_point_indices_[leaf_index]]);
 
-      // Stores the voxel indices for fast access searching
-      if (searchable_) {
-        voxel_centroids_leaf_indices_.push_back(static_cast<int>(it->first));
-      }
+    // Stores the voxel indices for fast access searching
+    if (searchable_) {
+      voxel_centroids_leaf_indices_.push_back(static_cast<int>(leaf_index));
     }
   }
   output.width = static_cast<std::uint32_t>(output.points.size());
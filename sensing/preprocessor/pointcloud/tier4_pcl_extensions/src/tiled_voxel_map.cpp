@@ -0,0 +1,273 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_pcl_extensions/tiled_voxel_map.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pcl
+{
+namespace
+{
+constexpr char MAGIC[8] = {'T', 'V', 'M', 'A', 'P', '0', '1', '\0'};
+
+int64_t floorDiv(const int64_t a, const int64_t b)
+{
+  const int64_t q = a / b;
+  return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+}  // namespace
+
+TiledVoxelMap::~TiledVoxelMap() { clear(); }
+
+void TiledVoxelMap::clear()
+{
+  if (mapped_ != nullptr) {
+    munmap(mapped_, mapped_size_);
+    mapped_ = nullptr;
+    mapped_size_ = 0;
+  }
+  tiles_storage_.clear();
+  keys_storage_.clear();
+  centroids_storage_.clear();
+  num_tiles_ = 0;
+  num_voxels_ = 0;
+  setViews(nullptr, nullptr, nullptr);
+}
+
+uint64_t TiledVoxelMap::toVoxelKey(const int64_t ix, const int64_t iy, const int64_t iz)
+{
+  // 21 bits per axis, which covers +-100 km with a 0.1 m leaf
+  constexpr uint64_t mask = (uint64_t{1} << 21) - 1;
+  return ((static_cast<uint64_t>(ix) & mask) << 42) | ((static_cast<uint64_t>(iy) & mask) << 21) |
+         (static_cast<uint64_t>(iz) & mask);
+}
+
+uint64_t TiledVoxelMap::toTileKey(const int64_t tx, const int64_t ty)
+{
+  // offset so that the unsigned order of the keys follows (tx, ty)
+  constexpr int64_t offset = int64_t{1} << 31;
+  return (static_cast<uint64_t>(tx + offset) << 32) |
+         (static_cast<uint64_t>(ty + offset) & 0xffffffffULL);
+}
+
+int64_t TiledVoxelMap::toTileCoordinate(const int64_t i) const
+{
+  return floorDiv(i, voxels_per_tile_);
+}
+
+void TiledVoxelMap::setViews(const Tile * tiles, const uint64_t * keys, const float * centroids)
+{
+  tiles_ = tiles;
+  keys_ = keys;
+  centroids_ = centroids;
+}
+
+void TiledVoxelMap::build(
+  const pcl::PointCloud<pcl::PointXYZ> & map, const float leaf_size, const float tile_size)
+{
+  clear();
+  leaf_size_ = leaf_size;
+  inverse_leaf_size_ = 1.0f / leaf_size;
+  voxels_per_tile_ = std::max<int64_t>(1, std::llround(tile_size / leaf_size));
+
+  struct Accumulator
+  {
+    uint64_t tile_key;
+    double sum_x, sum_y, sum_z;
+    uint32_t num_points;
+  };
+  std::unordered_map<uint64_t, Accumulator> voxels;
+  voxels.reserve(map.points.size() / 4);
+  for (const auto & p : map.points) {
+    if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+      continue;
+    }
+    const auto ix = static_cast<int64_t>(std::floor(p.x * inverse_leaf_size_));
+    const auto iy = static_cast<int64_t>(std::floor(p.y * inverse_leaf_size_));
+    const auto iz = static_cast<int64_t>(std::floor(p.z * inverse_leaf_size_));
+    auto & voxel = voxels[toVoxelKey(ix, iy, iz)];
+    if (voxel.num_points == 0) {
+      voxel.tile_key = toTileKey(toTileCoordinate(ix), toTileCoordinate(iy));
+    }
+    voxel.sum_x += p.x;
+    voxel.sum_y += p.y;
+    voxel.sum_z += p.z;
+    ++voxel.num_points;
+  }
+
+  // sort by (tile, voxel) so that each tile is a contiguous, sorted range of keys
+  std::vector<std::pair<uint64_t, const std::pair<const uint64_t, Accumulator> *>> order;
+  order.reserve(voxels.size());
+  for (const auto & voxel : voxels) {
+    order.emplace_back(voxel.second.tile_key, &voxel);
+  }
+  std::sort(order.begin(), order.end(), [](const auto & a, const auto & b) {
+    return a.first != b.first ? a.first < b.first : a.second->first < b.second->first;
+  });
+
+  keys_storage_.resize(order.size());
+  centroids_storage_.resize(3 * order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    const auto & voxel = order[i].second->second;
+    keys_storage_[i] = order[i].second->first;
+    centroids_storage_[3 * i] = static_cast<float>(voxel.sum_x / voxel.num_points);
+    centroids_storage_[3 * i + 1] = static_cast<float>(voxel.sum_y / voxel.num_points);
+    centroids_storage_[3 * i + 2] = static_cast<float>(voxel.sum_z / voxel.num_points);
+    if (tiles_storage_.empty() || tiles_storage_.back().key != order[i].first) {
+      tiles_storage_.push_back(Tile{order[i].first, i, i});
+    }
+    tiles_storage_.back().end = i + 1;
+  }
+
+  num_tiles_ = tiles_storage_.size();
+  num_voxels_ = keys_storage_.size();
+  setViews(tiles_storage_.data(), keys_storage_.data(), centroids_storage_.data());
+}
+
+bool TiledVoxelMap::save(const std::string & path) const
+{
+  const std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+      return false;
+    }
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.leaf_size = leaf_size_;
+    header.voxels_per_tile = static_cast<int32_t>(voxels_per_tile_);
+    header.num_tiles = num_tiles_;
+    header.num_voxels = num_voxels_;
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(reinterpret_cast<const char *>(tiles_), sizeof(Tile) * num_tiles_);
+    ofs.write(reinterpret_cast<const char *>(keys_), sizeof(uint64_t) * num_voxels_);
+    ofs.write(reinterpret_cast<const char *>(centroids_), sizeof(float) * 3 * num_voxels_);
+    if (!ofs) {
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+  return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+bool TiledVoxelMap::load(const std::string & path)
+{
+  clear();
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader)) {
+    close(fd);
+    return false;
+  }
+  const size_t size = static_cast<size_t>(st.st_size);
+  void * mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) {
+    return false;
+  }
+
+  FileHeader header;
+  std::memcpy(&header, mapped, sizeof(header));
+  const size_t expected_size = sizeof(FileHeader) + sizeof(Tile) * header.num_tiles +
+                               (sizeof(uint64_t) + 3 * sizeof(float)) * header.num_voxels;
+  if (
+    std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.leaf_size <= 0.0f ||
+    header.voxels_per_tile <= 0 || size != expected_size) {
+    munmap(mapped, size);
+    return false;
+  }
+
+  mapped_ = mapped;
+  mapped_size_ = size;
+  leaf_size_ = header.leaf_size;
+  inverse_leaf_size_ = 1.0f / header.leaf_size;
+  voxels_per_tile_ = header.voxels_per_tile;
+  num_tiles_ = header.num_tiles;
+  num_voxels_ = header.num_voxels;
+
+  // every section is 8 byte aligned, since the header and Tile are multiples of 8 bytes
+  const auto * base = static_cast<const uint8_t *>(mapped);
+  const auto * tiles = reinterpret_cast<const Tile *>(base + sizeof(FileHeader));
+  const auto * keys = reinterpret_cast<const uint64_t *>(tiles + num_tiles_);
+  const auto * centroids = reinterpret_cast<const float *>(keys + num_voxels_);
+  setViews(tiles, keys, centroids);
+  return true;
+}
+
+const float * TiledVoxelMap::getCentroidAt(
+  const int64_t ix, const int64_t iy, const int64_t iz) const
+{
+  const uint64_t tile_key = toTileKey(toTileCoordinate(ix), toTileCoordinate(iy));
+  const Tile * tiles_end = tiles_ + num_tiles_;
+  const Tile * tile = std::lower_bound(
+    tiles_, tiles_end, tile_key, [](const Tile & t, const uint64_t key) { return t.key < key; });
+  if (tile == tiles_end || tile->key != tile_key) {
+    return nullptr;
+  }
+
+  const uint64_t voxel_key = toVoxelKey(ix, iy, iz);
+  const uint64_t * keys_begin = keys_ + tile->begin;
+  const uint64_t * keys_end = keys_ + tile->end;
+  const uint64_t * it = std::lower_bound(keys_begin, keys_end, voxel_key);
+  if (it == keys_end || *it != voxel_key) {
+    return nullptr;
+  }
+  return centroids_ + 3 * (it - keys_);
+}
+
+bool TiledVoxelMap::hasCentroidWithin(const pcl::PointXYZ & point, const float distance) const
+{
+  if (empty()) {
+    return false;
+  }
+  const auto ix = static_cast<int64_t>(std::floor(point.x * inverse_leaf_size_));
+  const auto iy = static_cast<int64_t>(std::floor(point.y * inverse_leaf_size_));
+  const auto iz = static_cast<int64_t>(std::floor(point.z * inverse_leaf_size_));
+  const float sqr_distance_threshold = distance * distance;
+  for (int64_t dx = -1; dx <= 1; ++dx) {
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+      for (int64_t dz = -1; dz <= 1; ++dz) {
+        const float * centroid = getCentroidAt(ix + dx, iy + dy, iz + dz);
+        if (centroid == nullptr) {
+          continue;
+        }
+        const float dist_x = centroid[0] - point.x;
+        const float dist_y = centroid[1] - point.y;
+        const float dist_z = centroid[2] - point.z;
+        if (dist_x * dist_x + dist_y * dist_y + dist_z * dist_z < sqr_distance_threshold) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+}  // namespace pcl
@@ -0,0 +1,64 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Builds the tiled voxel index of a pointcloud map offline, for the map_index_file of
+// VoxelBasedCompareMapFilterComponent. leaf_size must be its distance_threshold.
+//
+// usage: tiled_voxel_map_generator <output> <leaf_size> <tile_size> <pcd> [<pcd> ...]
+
+#include "tier4_pcl_extensions/tiled_voxel_map.hpp"
+
+#include <pcl/io/pcd_io.h>
+#include <pcl/point_types.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char ** argv)
+{
+  if (argc < 5) {
+    std::cerr << "usage: " << argv[0] << " <output> <leaf_size> <tile_size> <pcd> [<pcd> ...]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string output_path = argv[1];
+  const float leaf_size = std::stof(argv[2]);
+  const float tile_size = std::stof(argv[3]);
+  if (!(leaf_size > 0.0f) || !(tile_size > 0.0f)) {
+    std::cerr << "leaf_size and tile_size must be positive" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  pcl::PointCloud<pcl::PointXYZ> map;
+  for (int i = 4; i < argc; ++i) {
+    pcl::PointCloud<pcl::PointXYZ> pcd;
+    if (pcl::io::loadPCDFile(argv[i], pcd) == -1) {
+      std::cerr << "failed to load " << argv[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+    map += pcd;
+  }
+
+  pcl::TiledVoxelMap tiled_map;
+  tiled_map.build(map, leaf_size, tile_size);
+  if (!tiled_map.save(output_path)) {
+    std::cerr << "failed to write " << output_path << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "wrote " << tiled_map.size() << " voxels in " << tiled_map.getNumTiles()
+            << " tiles to " << output_path << std::endl;
+  return EXIT_SUCCESS;
+}
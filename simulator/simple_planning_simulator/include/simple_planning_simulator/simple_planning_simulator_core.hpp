@@ -45,6 +45,7 @@
 #include <geometry_msgs/msg/pose_stamped.hpp>
 #include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
 #include <geometry_msgs/msg/twist_stamped.hpp>
+#include <rosgraph_msgs/msg/clock.hpp>
 
 #include <tf2/LinearMath/Quaternion.h>
 #include <tf2/utils.h>
@@ -52,6 +53,7 @@
 #include <tf2_ros/transform_broadcaster.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <chrono>
 #include <memory>
 #include <random>
 #include <string>
@@ -86,6 +88,8 @@ private:
   rclcpp::Publisher<autoware_vehicle_msgs::msg::ShiftStamped>::SharedPtr pub_shift_;
   rclcpp::Publisher<autoware_vehicle_msgs::msg::ControlMode>::SharedPtr pub_control_mode_;
   rclcpp::Publisher<geometry_msgs::msg::PoseWithCovarianceStamped>::SharedPtr pub_cov_;
+  rclcpp::Publisher<rosgraph_msgs::msg::Clock>::SharedPtr
+    pub_clock_;  //!< @brief /clock publisher in lockstep mode
 
   rclcpp::Subscription<autoware_vehicle_msgs::msg::VehicleCommand>::SharedPtr
     sub_vehicle_cmd_;  //!< @brief topic subscriber for vehicle_cmd
@@ -138,15 +142,21 @@ private:
   double sim_steering_gear_ratio_;  //!< @brief for steering wheel angle calculation
   double x_stddev_;  //!< @brief x standard deviation for dummy covariance in map coordinate
   double y_stddev_;  //!< @brief y standard deviation for dummy covariance in map coordinate
+  double lockstep_speed_up_;    //!< @brief upper limit of simulated time per wall time in lockstep
+  double lockstep_cmd_timeout_;  //!< @brief wall time[s] to step without vehicle_cmd in lockstep
 
   /* flags */
   bool is_initialized_ = false;                //!< @brief flag to check the initial position is set
   bool add_measurement_noise_;                 //!< @brief flag to add measurement noise
   bool simulator_engage_;                      //!< @brief flag to engage simulator
   bool use_trajectory_for_z_position_source_;  //!< @brief flag to get z position from trajectory
+  bool use_lockstep_;  //!< @brief flag to step simulated time with vehicle_cmd and publish /clock
 
   /* saved values */
   std::shared_ptr<rclcpp::Time> prev_update_time_ptr_;  //!< @brief previously updated time
+  rclcpp::Time sim_time_;  //!< @brief simulated time published to /clock in lockstep mode
+  std::chrono::steady_clock::time_point
+    last_step_wall_time_;  //!< @brief wall time of the last step in lockstep mode
 
   /* vehicle model */
   enum class VehicleModelType {
@@ -235,6 +245,17 @@ private:
    */
   void timerCallbackSimulation();
 
+  /**
+   * @brief wall timer callback for lockstep mode, advance simulated time by 1 / loop_rate when
+   * vehicle_cmd for the current time has arrived or lockstep_cmd_timeout has passed
+   */
+  void timerCallbackLockstep();
+
+  /**
+   * @brief get current time, simulated time in lockstep mode or ros time otherwise
+   */
+  rclcpp::Time getCurrentTime() const;
+
   /**
    * @brief set initial state of simulated vehicle
    * @param [in] pose initial position and orientation
@@ -33,7 +33,7 @@
  * @class simple_planning_simulator constant acceleration twist model
  * @brief calculate velocity & angular-velocity with constant acceleration
  */
-class SimModelConstantAccelTwist : public SimModelInterface
+class SimModelConstantAccelTwist : public SimModelBase<5 /* dim x */, 2 /* dim u */>
 {
 public:
   /**
@@ -109,7 +109,7 @@ private:
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+  State calcModel(const State & state, const Input & input) override;
 };
 
 #endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_CONSTANT_ACCELERATION_HPP_
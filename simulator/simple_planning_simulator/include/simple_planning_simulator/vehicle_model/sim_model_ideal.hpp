@@ -34,7 +34,7 @@
  * @class simple_planning_simulator ideal twist model
  * @brief calculate ideal twist dynamics
  */
-class SimModelIdealTwist : public SimModelInterface
+class SimModelIdealTwist : public SimModelBase<3 /* dim x */, 2 /* dim u */>
 {
 public:
   /**
@@ -99,14 +99,14 @@ private:
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+  State calcModel(const State & state, const Input & input) override;
 };
 
 /**
  * @class simple_planning_simulator ideal steering model
  * @brief calculate ideal steering dynamics
  */
-class SimModelIdealSteer : public SimModelInterface
+class SimModelIdealSteer : public SimModelBase<3 /* dim x */, 2 /* dim u */>
 {
 public:
   /**
@@ -174,14 +174,14 @@ private:
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+  State calcModel(const State & state, const Input & input) override;
 };
 
 /**
  * @class wf_simulator ideal acceleration and steering model
  * @brief calculate ideal steering dynamics
  */
-class SimModelIdealAccel : public SimModelInterface
+class SimModelIdealAccel : public SimModelBase<4 /* dim x */, 2 /* dim u */>
 {
 public:
   /**
@@ -250,7 +250,7 @@ private:
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+  State calcModel(const State & state, const Input & input) override;
 };
 
 #endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_IDEAL_HPP_
@@ -32,10 +32,8 @@
 class SimModelInterface
 {
 protected:
-  const int dim_x_;        //!< @brief dimension of state x
-  const int dim_u_;        //!< @brief dimension of input u
-  Eigen::VectorXd state_;  //!< @brief vehicle state vector
-  Eigen::VectorXd input_;  //!< @brief vehicle input vector
+  const int dim_x_;  //!< @brief dimension of state x
+  const int dim_u_;  //!< @brief dimension of input u
 
 public:
   /**
@@ -48,45 +46,31 @@ public:
   /**
    * @brief destructor
    */
-  ~SimModelInterface() = default;
+  virtual ~SimModelInterface() = default;
 
   /**
    * @brief get state vector of model
    * @param [out] state state vector
    */
-  void getState(Eigen::VectorXd & state);
+  virtual void getState(Eigen::VectorXd & state) = 0;
 
   /**
    * @brief get input vector of model
    * @param [out] input input vector
    */
-  void getInput(Eigen::VectorXd & input);
+  virtual void getInput(Eigen::VectorXd & input) = 0;
 
   /**
    * @brief set state vector of model
    * @param [in] state state vector
    */
-  void setState(const Eigen::VectorXd & state);
+  virtual void setState(const Eigen::VectorXd & state) = 0;
 
   /**
    * @brief set input vector of model
    * @param [in] input input vector
    */
-  void setInput(const Eigen::VectorXd & input);
-
-  /**
-   * @brief update vehicle states with Runge-Kutta methods
-   * @param [in] dt delta time [s]
-   * @param [in] input vehicle input
-   */
-  void updateRungeKutta(const double & dt, const Eigen::VectorXd & input);
-
-  /**
-   * @brief update vehicle states with Euler methods
-   * @param [in] dt delta time [s]
-   * @param [in] input vehicle input
-   */
-  void updateEuler(const double & dt, const Eigen::VectorXd & input);
+  virtual void setInput(const Eigen::VectorXd & input) = 0;
 
   /**
    * @brief update vehicle states
@@ -123,14 +107,64 @@ public:
    * @brief get vehicle steering angle
    */
   virtual double getSteer() = 0;
+};
+
+/**
+ * @class vehicle model with fixed dimensions
+ * @brief state and input are fixed-size vectors, so that an integration step does not allocate
+ */
+template <int DIM_X, int DIM_U>
+class SimModelBase : public SimModelInterface
+{
+public:
+  // unaligned, since std::make_shared does not respect the alignment of Eigen types in C++14
+  using State = Eigen::Matrix<double, DIM_X, 1, Eigen::DontAlign>;
+  using Input = Eigen::Matrix<double, DIM_U, 1, Eigen::DontAlign>;
+
+  SimModelBase() : SimModelInterface(DIM_X, DIM_U), state_(State::Zero()), input_(Input::Zero())
+  {
+  }
+
+  void getState(Eigen::VectorXd & state) override { state = state_; }
+  void getInput(Eigen::VectorXd & input) override { input = input_; }
+  void setState(const Eigen::VectorXd & state) override { state_ = state; }
+  void setInput(const Eigen::VectorXd & input) override { input_ = input; }
+
+protected:
+  State state_;  //!< @brief vehicle state vector
+  Input input_;  //!< @brief vehicle input vector
+
+  /**
+   * @brief update vehicle states with Runge-Kutta methods
+   * @param [in] dt delta time [s]
+   * @param [in] input vehicle input
+   */
+  void updateRungeKutta(const double & dt, const Input & input)
+  {
+    const State k1 = calcModel(state_, input);
+    const State k2 = calcModel(state_ + k1 * 0.5 * dt, input);
+    const State k3 = calcModel(state_ + k2 * 0.5 * dt, input);
+    const State k4 = calcModel(state_ + k3 * dt, input);
+
+    state_ += 1.0 / 6.0 * (k1 + 2.0 * k2 + 2.0 * k3 + k4) * dt;
+  }
+
+  /**
+   * @brief update vehicle states with Euler methods
+   * @param [in] dt delta time [s]
+   * @param [in] input vehicle input
+   */
+  void updateEuler(const double & dt, const Input & input)
+  {
+    state_ += calcModel(state_, input) * dt;
+  }
 
   /**
    * @brief calculate derivative of states with vehicle model
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  virtual Eigen::VectorXd calcModel(
-    const Eigen::VectorXd & state, const Eigen::VectorXd & input) = 0;
+  virtual State calcModel(const State & state, const Input & input) = 0;
 };
 
 #endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_INTERFACE_HPP_
@@ -29,15 +29,13 @@
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/LU>
 
-#include <deque>
 #include <iostream>
-#include <queue>
 
 /**
  * @class simple_planning_simulator time delay twist model
  * @brief calculate time delay twist dynamics
  */
-class SimModelTimeDelayTwist : public SimModelInterface
+class SimModelTimeDelayTwist : public SimModelBase<5 /* dim x */, 2 /* dim u */>
 {
 public:
   /**
@@ -83,8 +81,9 @@ private:
   const double wz_lim_;       //!< @brief angular velocity limit
   const double wz_rate_lim_;  //!< @brief angular acceleration limit
 
-  std::deque<double> vx_input_queue_;  //!< @brief buffer for velocity command
-  std::deque<double> wz_input_queue_;  //!< @brief buffer for angular velocity command
+  sim_model_util::DelayBuffer vx_input_queue_;  //!< @brief buffer for velocity command
+  sim_model_util::DelayBuffer wz_input_queue_;  //!< @brief buffer for angular velocity command
+
   const double vx_delay_;              //!< @brief time delay for velocity command [s]
   const double vx_time_constant_;      //!< @brief time constant for 1D model of velocity dynamics
   const double wz_delay_;              //!< @brief time delay for angular-velocity command [s]
@@ -139,10 +138,10 @@ private:
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+  State calcModel(const State & state, const Input & input) override;
 };
 
-class SimModelTimeDelaySteer : public SimModelInterface
+class SimModelTimeDelaySteer : public SimModelBase<5 /* dim x */, 2 /* dim u */>
 {
 public:
   /**
@@ -190,9 +189,10 @@ private:
   const double steer_rate_lim_;  //!< @brief steering angular velocity limit [rad/s]
   const double wheelbase_;       //!< @brief vehicle wheelbase length [m]
 
-  std::deque<double> vx_input_queue_;     //!< @brief buffer for velocity command
-  std::deque<double> steer_input_queue_;  //!< @brief buffer for steering command
-  const double vx_delay_;                 //!< @brief time delay for velocity command [s]
+  sim_model_util::DelayBuffer vx_input_queue_;     //!< @brief buffer for velocity command
+  sim_model_util::DelayBuffer steer_input_queue_;  //!< @brief buffer for steering command
+
+  const double vx_delay_;              //!< @brief time delay for velocity command [s]
   const double vx_time_constant_;      //!< @brief time constant for 1D model of velocity dynamics
   const double steer_delay_;           //!< @brief time delay for steering command [s]
   const double steer_time_constant_;   //!< @brief time constant for 1D model of steering dynamics
@@ -245,10 +245,10 @@ private:
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+  State calcModel(const State & state, const Input & input) override;
 };
 
-class SimModelTimeDelaySteerAccel : public SimModelInterface
+class SimModelTimeDelaySteerAccel : public SimModelBase<6 /* dim x */, 3 /* dim u */>
 {
 public:
   /**
@@ -298,11 +298,12 @@ private:
   const double steer_rate_lim_;  //!< @brief steering angular velocity limit [rad/s]
   const double wheelbase_;       //!< @brief vehicle wheelbase length [m]
 
-  std::deque<double> acc_input_queue_;    //!< @brief buffer for accel command
-  std::deque<double> steer_input_queue_;  //!< @brief buffer for steering command
-  const double acc_delay_;                //!< @brief time delay for accel command [s]
-  const double acc_time_constant_;        //!< @brief time constant for 1D model of accel dynamics
-  const double steer_delay_;              //!< @brief time delay for steering command [s]
+  sim_model_util::DelayBuffer acc_input_queue_;    //!< @brief buffer for accel command
+  sim_model_util::DelayBuffer steer_input_queue_;  //!< @brief buffer for steering command
+
+  const double acc_delay_;             //!< @brief time delay for accel command [s]
+  const double acc_time_constant_;     //!< @brief time constant for 1D model of accel dynamics
+  const double steer_delay_;           //!< @brief time delay for steering command [s]
   const double steer_time_constant_;   //!< @brief time constant for 1D model of steering dynamics
   const double deadzone_delta_steer_;  //!<@ brief deadzone value of steer
 
@@ -353,7 +354,7 @@ private:
    * @param [in] state current model state
    * @param [in] input input vector to model
    */
-  Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+  State calcModel(const State & state, const Input & input) override;
 };
 
 #endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_TIME_DELAY_HPP_
@@ -17,10 +17,37 @@
 
 #include <math.h>
 
+#include <cstddef>
+#include <vector>
+
 namespace sim_model_util
 {
 double getDummySteerCommandWithFriction(
   const double steer, const double steer_command, const double deadzone_delta_steer);
-}
+
+/**
+ * @brief Fixed-length ring buffer delaying a command by a number of steps. The storage is allocated
+ * once, so that pushing a command in each step does not allocate as a deque does.
+ */
+class DelayBuffer
+{
+public:
+  /**
+   * @brief fill the buffer with zero commands
+   * @param [in] num_steps delay in steps
+   */
+  void reset(const size_t num_steps);
+
+  /**
+   * @brief push the current command
+   * @return command pushed num_steps before, or the current command without delay
+   */
+  double push(const double command);
+
+private:
+  std::vector<double> buffer_;
+  size_t head_ = 0;
+};
+}  // namespace sim_model_util
 
 #endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_UTIL_HPP_
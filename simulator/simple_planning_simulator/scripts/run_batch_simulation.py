@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+
+# Copyright 2021 Tier IV, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Run scenario commands in parallel processes, each in its own ROS_DOMAIN_ID.
+
+Each non-empty line of the scenario file not starting with '#' is a shell command which runs one
+scenario headless and exits with 0 on success, e.g. a ros2 launch of the stack with
+simple_planning_simulator in lockstep mode.
+"""
+
+import argparse
+from concurrent.futures import ThreadPoolExecutor
+import os
+import queue
+import subprocess
+import sys
+import time
+
+
+def load_scenarios(path):
+    with open(path, "r") as f:
+        lines = [line.strip() for line in f]
+    return [line for line in lines if line and not line.startswith("#")]
+
+
+def run_scenario(command, domain_ids, timeout, log_dir):
+    # Borrow a domain id so that concurrent scenarios do not see each other's topics
+    domain_id = domain_ids.get()
+    env = dict(os.environ, ROS_DOMAIN_ID=str(domain_id))
+    start_time = time.time()
+    log_path = os.path.join(log_dir, "domain_{}_{}.log".format(domain_id, int(start_time)))
+    try:
+        with open(log_path, "w") as log:
+            process = subprocess.Popen(
+                command,
+                shell=True,
+                env=env,
+                stdout=log,
+                stderr=subprocess.STDOUT,
+                start_new_session=True,
+            )
+            try:
+                return_code = process.wait(timeout=timeout)
+            except subprocess.TimeoutExpired:
+                os.killpg(process.pid, 9)
+                process.wait()
+                return_code = None
+    finally:
+        domain_ids.put(domain_id)
+
+    return command, return_code, time.time() - start_time, log_path
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("scenario_file", help="file listing a scenario command per line")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(), help="parallel runs")
+    parser.add_argument("--timeout", type=float, default=600.0, help="timeout per scenario[s]")
+    parser.add_argument("--domain-id-offset", type=int, default=100, help="first ROS_DOMAIN_ID")
+    parser.add_argument("--log-dir", default="batch_simulation_log", help="output directory")
+    args = parser.parse_args()
+
+    scenarios = load_scenarios(args.scenario_file)
+    os.makedirs(args.log_dir, exist_ok=True)
+
+    domain_ids = queue.Queue()
+    for i in range(args.jobs):
+        domain_ids.put(args.domain_id_offset + i)
+
+    num_failed = 0
+    with ThreadPoolExecutor(max_workers=args.jobs) as executor:
+        futures = [
+            executor.submit(run_scenario, command, domain_ids, args.timeout, args.log_dir)
+            for command in scenarios
+        ]
+        for future in futures:
+            command, return_code, elapsed, log_path = future.result()
+            if return_code is None:
+                result = "TIMEOUT"
+            elif return_code == 0:
+                result = "OK"
+            else:
+                result = "FAILED({})".format(return_code)
+            if result != "OK":
+                num_failed += 1
+            print("[{}] {:.1f}[s] {} (log: {})".format(result, elapsed, command, log_path))
+
+    print("{} / {} scenarios succeeded".format(len(scenarios) - num_failed, len(scenarios)))
+    return 0 if num_failed == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
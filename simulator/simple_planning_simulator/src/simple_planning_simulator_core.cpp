@@ -37,6 +37,9 @@ Simulator::Simulator(const std::string & node_name, const rclcpp::NodeOptions &
   add_measurement_noise_ = declare_parameter("add_measurement_noise", false);
   use_trajectory_for_z_position_source_ =
     declare_parameter("use_trajectory_for_z_position_source", true);
+  use_lockstep_ = declare_parameter("use_lockstep", false);
+  lockstep_speed_up_ = declare_parameter("lockstep_speed_up", 10.0);
+  lockstep_cmd_timeout_ = declare_parameter("lockstep_cmd_timeout", 0.1);
 
   /* service */
   autoware_api_utils::ServiceProxyNodeInterface proxy(this);
@@ -95,7 +98,16 @@ Simulator::Simulator(const std::string & node_name, const rclcpp::NodeOptions &
     this->add_on_set_parameters_callback(std::bind(&Simulator::onParameter, this, _1));
 
   /* Timer */
-  {
+  if (use_lockstep_) {
+    // Simulated time is owned by this node, do not run it with use_sim_time
+    pub_clock_ = create_publisher<rosgraph_msgs::msg::Clock>("/clock", rclcpp::QoS{1});
+    sim_time_ = rclcpp::Time(0, 0, RCL_ROS_TIME);
+    last_step_wall_time_ = std::chrono::steady_clock::now();
+    const auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(dt / lockstep_speed_up_));
+    timer_simulation_ =
+      create_wall_timer(period, std::bind(&Simulator::timerCallbackLockstep, this));
+  } else {
     auto timer_callback = std::bind(&Simulator::timerCallbackSimulation, this);
     auto period =
       std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(dt));
@@ -263,6 +275,32 @@ void Simulator::serviceSetPose(
   response->status = autoware_api_utils::response_success();
 }
 
+rclcpp::Time Simulator::getCurrentTime() const
+{
+  return use_lockstep_ ? sim_time_ : get_clock()->now();
+}
+
+void Simulator::timerCallbackLockstep()
+{
+  // Wait for the controller to react to the current time, the vehicle does not move until then
+  const auto now = std::chrono::steady_clock::now();
+  const bool is_cmd_ready = current_vehicle_cmd_ptr_ &&
+                            rclcpp::Time(current_vehicle_cmd_ptr_->header.stamp) >= sim_time_;
+  const bool is_cmd_timeout =
+    std::chrono::duration<double>(now - last_step_wall_time_).count() > lockstep_cmd_timeout_;
+  if (is_initialized_ && !is_cmd_ready && !is_cmd_timeout) {
+    return;
+  }
+  last_step_wall_time_ = now;
+
+  sim_time_ += rclcpp::Duration::from_seconds(1.0 / loop_rate_);
+  rosgraph_msgs::msg::Clock clock_msg;
+  clock_msg.clock = sim_time_;
+  pub_clock_->publish(clock_msg);
+
+  timerCallbackSimulation();
+}
+
 void Simulator::timerCallbackSimulation()
 {
   if (!is_initialized_) {
@@ -271,13 +309,14 @@ void Simulator::timerCallbackSimulation()
     return;
   }
 
+  const auto current_time = getCurrentTime();
   if (prev_update_time_ptr_ == nullptr) {
-    prev_update_time_ptr_ = std::make_shared<rclcpp::Time>(get_clock()->now());
+    prev_update_time_ptr_ = std::make_shared<rclcpp::Time>(current_time);
   }
 
   /* calculate delta time */
-  const double dt = (get_clock()->now() - *prev_update_time_ptr_).seconds();
-  *prev_update_time_ptr_ = get_clock()->now();
+  const double dt = (current_time - *prev_update_time_ptr_).seconds();
+  *prev_update_time_ptr_ = current_time;
 
   if (simulator_engage_) {
     /* update vehicle dynamics when simulator_engage_ is true */
@@ -333,7 +372,7 @@ void Simulator::timerCallbackSimulation()
   /* publish steering */
   autoware_vehicle_msgs::msg::Steering steer_msg;
   steer_msg.header.frame_id = simulation_frame_id_;
-  steer_msg.header.stamp = get_clock()->now();
+  steer_msg.header.stamp = current_time;
   steer_msg.data = vehicle_model_ptr_->getSteer();
   if (add_measurement_noise_) {
     steer_msg.data += (*steer_norm_dist_ptr_)(*rand_engine_ptr_);
@@ -342,13 +381,13 @@ void Simulator::timerCallbackSimulation()
 
   /* float info publishers */
   autoware_debug_msgs::msg::Float32Stamped velocity_msg;
-  velocity_msg.stamp = this->now();
+  velocity_msg.stamp = current_time;
   velocity_msg.data = current_twist_.linear.x;
   pub_velocity_->publish(velocity_msg);
 
   autoware_vehicle_msgs::msg::TurnSignal turn_signal_msg;
   turn_signal_msg.header.frame_id = simulation_frame_id_;
-  turn_signal_msg.header.stamp = get_clock()->now();
+  turn_signal_msg.header.stamp = current_time;
   turn_signal_msg.data = autoware_vehicle_msgs::msg::TurnSignal::NONE;
   if (current_turn_signal_cmd_ptr_) {
     const auto cmd = current_turn_signal_cmd_ptr_->data;
@@ -364,7 +403,7 @@ void Simulator::timerCallbackSimulation()
 
   autoware_vehicle_msgs::msg::ShiftStamped shift_msg;
   shift_msg.header.frame_id = simulation_frame_id_;
-  shift_msg.header.stamp = get_clock()->now();
+  shift_msg.header.stamp = current_time;
   shift_msg.shift.data = current_twist_.linear.x >= 0.0
                            ? autoware_vehicle_msgs::msg::Shift::DRIVE
                            : autoware_vehicle_msgs::msg::Shift::REVERSE;
@@ -479,7 +518,7 @@ void Simulator::getTransformFromTF(
 
 void Simulator::publishTwist(const geometry_msgs::msg::Twist & twist)
 {
-  rclcpp::Time current_time = get_clock()->now();
+  rclcpp::Time current_time = getCurrentTime();
   geometry_msgs::msg::TwistStamped ts;
   ts.header.frame_id = simulation_frame_id_;
   ts.header.stamp = current_time;
@@ -489,7 +528,7 @@ void Simulator::publishTwist(const geometry_msgs::msg::Twist & twist)
 
 void Simulator::publishPoseWithCov(const geometry_msgs::msg::PoseWithCovariance & cov)
 {
-  rclcpp::Time current_time = get_clock()->now();
+  rclcpp::Time current_time = getCurrentTime();
   geometry_msgs::msg::PoseWithCovarianceStamped cs;
   cs.header.frame_id = map_frame_id_;
   cs.header.stamp = current_time;
@@ -505,7 +544,7 @@ void Simulator::publishPoseWithCov(const geometry_msgs::msg::PoseWithCovariance
 
 void Simulator::publishTF(const geometry_msgs::msg::Pose & pose)
 {
-  rclcpp::Time current_time = get_clock()->now();
+  rclcpp::Time current_time = getCurrentTime();
 
   // send odom transform
   geometry_msgs::msg::TransformStamped odom_trans;
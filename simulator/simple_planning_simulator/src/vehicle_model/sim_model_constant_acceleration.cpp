@@ -18,8 +18,7 @@
 
 SimModelConstantAccelTwist::SimModelConstantAccelTwist(
   double vx_lim, double wz_lim, double vx_rate, double wz_rate)
-: SimModelInterface(5 /* dim x */, 2 /* dim u */),
-  vx_lim_(vx_lim),
+: vx_lim_(vx_lim),
   wz_lim_(wz_lim),
   vx_rate_(vx_rate),
   wz_rate_(wz_rate)
@@ -33,8 +32,8 @@ double SimModelConstantAccelTwist::getVx() { return state_(IDX::VX); }
 double SimModelConstantAccelTwist::getWz() { return state_(IDX::WZ); }
 double SimModelConstantAccelTwist::getSteer() { return 0.0; }
 void SimModelConstantAccelTwist::update(const double & dt) { updateRungeKutta(dt, input_); }
-Eigen::VectorXd SimModelConstantAccelTwist::calcModel(
-  const Eigen::VectorXd & state, const Eigen::VectorXd & input)
+SimModelConstantAccelTwist::State SimModelConstantAccelTwist::calcModel(
+  const State & state, const Input & input)
 {
   const double vel = state(IDX::VX);
   const double angvel = state(IDX::WZ);
@@ -55,7 +54,7 @@ Eigen::VectorXd SimModelConstantAccelTwist::calcModel(
     wz_rate = -wz_rate_;
   }
 
-  Eigen::VectorXd d_state = Eigen::VectorXd::Zero(dim_x_);
+  State d_state = State::Zero();
   d_state(IDX::X) = vel * cos(yaw);
   d_state(IDX::Y) = vel * sin(yaw);
   d_state(IDX::YAW) = angvel;
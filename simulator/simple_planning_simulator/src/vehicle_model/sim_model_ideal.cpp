@@ -14,7 +14,7 @@
 
 #include "simple_planning_simulator/vehicle_model/sim_model_ideal.hpp"
 
-SimModelIdealTwist::SimModelIdealTwist() : SimModelInterface(3 /* dim x */, 2 /* dim u */) {}
+SimModelIdealTwist::SimModelIdealTwist() {}
 
 double SimModelIdealTwist::getX() { return state_(IDX::X); }
 double SimModelIdealTwist::getY() { return state_(IDX::Y); }
@@ -23,14 +23,13 @@ double SimModelIdealTwist::getVx() { return input_(IDX_U::VX_DES); }
 double SimModelIdealTwist::getWz() { return input_(IDX_U::WZ_DES); }
 double SimModelIdealTwist::getSteer() { return 0.0; }
 void SimModelIdealTwist::update(const double & dt) { updateRungeKutta(dt, input_); }
-Eigen::VectorXd SimModelIdealTwist::calcModel(
-  const Eigen::VectorXd & state, const Eigen::VectorXd & input)
+SimModelIdealTwist::State SimModelIdealTwist::calcModel(const State & state, const Input & input)
 {
   const double yaw = state(IDX::YAW);
   const double vx = input(IDX_U::VX_DES);
   const double wz = input(IDX_U::WZ_DES);
 
-  Eigen::VectorXd d_state = Eigen::VectorXd::Zero(dim_x_);
+  State d_state = State::Zero();
   d_state(IDX::X) = vx * cos(yaw);
   d_state(IDX::Y) = vx * sin(yaw);
   d_state(IDX::YAW) = wz;
@@ -39,7 +38,7 @@ Eigen::VectorXd SimModelIdealTwist::calcModel(
 }
 
 SimModelIdealSteer::SimModelIdealSteer(double wheelbase)
-: SimModelInterface(3 /* dim x */, 2 /* dim u */), wheelbase_(wheelbase)
+: wheelbase_(wheelbase)
 {
 }
 
@@ -53,14 +52,13 @@ double SimModelIdealSteer::getWz()
 }
 double SimModelIdealSteer::getSteer() { return input_(IDX_U::STEER_DES); }
 void SimModelIdealSteer::update(const double & dt) { updateRungeKutta(dt, input_); }
-Eigen::VectorXd SimModelIdealSteer::calcModel(
-  const Eigen::VectorXd & state, const Eigen::VectorXd & input)
+SimModelIdealSteer::State SimModelIdealSteer::calcModel(const State & state, const Input & input)
 {
   const double yaw = state(IDX::YAW);
   const double vx = input(IDX_U::VX_DES);
   const double steer = input(IDX_U::STEER_DES);
 
-  Eigen::VectorXd d_state = Eigen::VectorXd::Zero(dim_x_);
+  State d_state = State::Zero();
   d_state(IDX::X) = vx * cos(yaw);
   d_state(IDX::Y) = vx * sin(yaw);
   d_state(IDX::YAW) = vx * std::tan(steer) / wheelbase_;
@@ -69,7 +67,7 @@ Eigen::VectorXd SimModelIdealSteer::calcModel(
 }
 
 SimModelIdealAccel::SimModelIdealAccel(double wheelbase)
-: SimModelInterface(4 /* dim x */, 2 /* dim u */), wheelbase_(wheelbase)
+: wheelbase_(wheelbase)
 {
 }
 
@@ -90,15 +88,14 @@ void SimModelIdealAccel::update(const double & dt)
   }
 }
 
-Eigen::VectorXd SimModelIdealAccel::calcModel(
-  const Eigen::VectorXd & state, const Eigen::VectorXd & input)
+SimModelIdealAccel::State SimModelIdealAccel::calcModel(const State & state, const Input & input)
 {
   const double vx = state(IDX::VX);
   const double yaw = state(IDX::YAW);
   const double ax = input(IDX_U::AX_DES);
   const double steer = input(IDX_U::STEER_DES);
 
-  Eigen::VectorXd d_state = Eigen::VectorXd::Zero(dim_x_);
+  State d_state = State::Zero();
   d_state(IDX::X) = vx * cos(yaw);
   d_state(IDX::Y) = vx * sin(yaw);
   d_state(IDX::VX) = ax;
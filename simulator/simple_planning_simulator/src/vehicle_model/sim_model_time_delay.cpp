@@ -24,8 +24,7 @@
 SimModelTimeDelayTwist::SimModelTimeDelayTwist(
   double vx_lim, double wz_lim, double vx_rate_lim, double wz_rate_lim, double dt, double vx_delay,
   double vx_time_constant, double wz_delay, double wz_time_constant, double deadzone_delta_steer)
-: SimModelInterface(5 /* dim x */, 2 /* dim u */),
-  MIN_TIME_CONSTANT(0.03),
+: MIN_TIME_CONSTANT(0.03),
   vx_lim_(vx_lim),
   vx_rate_lim_(vx_rate_lim),
   wz_lim_(wz_lim),
@@ -55,31 +54,21 @@ double SimModelTimeDelayTwist::getWz() { return state_(IDX::WZ); }
 double SimModelTimeDelayTwist::getSteer() { return 0.0; }
 void SimModelTimeDelayTwist::update(const double & dt)
 {
-  Eigen::VectorXd delayed_input = Eigen::VectorXd::Zero(dim_u_);
+  Input delayed_input = Input::Zero();
 
-  vx_input_queue_.push_back(input_(IDX_U::VX_DES));
-  delayed_input(IDX_U::VX_DES) = vx_input_queue_.front();
-  vx_input_queue_.pop_front();
-  wz_input_queue_.push_back(input_(IDX_U::WZ_DES));
-  delayed_input(IDX_U::WZ_DES) = wz_input_queue_.front();
-  wz_input_queue_.pop_front();
+  delayed_input(IDX_U::VX_DES) = vx_input_queue_.push(input_(IDX_U::VX_DES));
+  delayed_input(IDX_U::WZ_DES) = wz_input_queue_.push(input_(IDX_U::WZ_DES));
   // do not use deadzone_delta_steer (Steer IF does not exist in this model)
   updateRungeKutta(dt, delayed_input);
 }
 void SimModelTimeDelayTwist::initializeInputQueue(const double & dt)
 {
-  size_t vx_input_queue_size = static_cast<size_t>(round(vx_delay_ / dt));
-  for (size_t i = 0; i < vx_input_queue_size; i++) {
-    vx_input_queue_.push_back(0.0);
-  }
-  size_t wz_input_queue_size = static_cast<size_t>(round(wz_delay_ / dt));
-  for (size_t i = 0; i < wz_input_queue_size; i++) {
-    wz_input_queue_.push_back(0.0);
-  }
+  vx_input_queue_.reset(static_cast<size_t>(round(vx_delay_ / dt)));
+  wz_input_queue_.reset(static_cast<size_t>(round(wz_delay_ / dt)));
 }
 
-Eigen::VectorXd SimModelTimeDelayTwist::calcModel(
-  const Eigen::VectorXd & state, const Eigen::VectorXd & input)
+SimModelTimeDelayTwist::State SimModelTimeDelayTwist::calcModel(
+  const State & state, const Input & input)
 {
   const double vx = state(IDX::VX);
   const double wz = state(IDX::WZ);
@@ -93,7 +82,7 @@ Eigen::VectorXd SimModelTimeDelayTwist::calcModel(
   vx_rate = std::min(vx_rate_lim_, std::max(-vx_rate_lim_, vx_rate));
   wz_rate = std::min(wz_rate_lim_, std::max(-wz_rate_lim_, wz_rate));
 
-  Eigen::VectorXd d_state = Eigen::VectorXd::Zero(dim_x_);
+  State d_state = State::Zero();
   d_state(IDX::X) = vx * cos(yaw);
   d_state(IDX::Y) = vx * sin(yaw);
   d_state(IDX::YAW) = wz;
@@ -112,8 +101,7 @@ SimModelTimeDelaySteer::SimModelTimeDelaySteer(
   double vx_lim, double steer_lim, double vx_rate_lim, double steer_rate_lim, double wheelbase,
   double dt, double vx_delay, double vx_time_constant, double steer_delay,
   double steer_time_constant, double deadzone_delta_steer)
-: SimModelInterface(5 /* dim x */, 2 /* dim u */),
-  MIN_TIME_CONSTANT(0.03),
+: MIN_TIME_CONSTANT(0.03),
   vx_lim_(vx_lim),
   vx_rate_lim_(vx_rate_lim),
   steer_lim_(steer_lim),
@@ -148,33 +136,23 @@ double SimModelTimeDelaySteer::getWz()
 double SimModelTimeDelaySteer::getSteer() { return state_(IDX::STEER); }
 void SimModelTimeDelaySteer::update(const double & dt)
 {
-  Eigen::VectorXd delayed_input = Eigen::VectorXd::Zero(dim_u_);
+  Input delayed_input = Input::Zero();
 
-  vx_input_queue_.push_back(input_(IDX_U::VX_DES));
-  delayed_input(IDX_U::VX_DES) = vx_input_queue_.front();
-  vx_input_queue_.pop_front();
-  steer_input_queue_.push_back(input_(IDX_U::STEER_DES));
-  const double raw_steer_command = steer_input_queue_.front();
+  delayed_input(IDX_U::VX_DES) = vx_input_queue_.push(input_(IDX_U::VX_DES));
+  const double raw_steer_command = steer_input_queue_.push(input_(IDX_U::STEER_DES));
   delayed_input(IDX_U::STEER_DES) = sim_model_util::getDummySteerCommandWithFriction(
     getSteer(), raw_steer_command, deadzone_delta_steer_);
-  steer_input_queue_.pop_front();
 
   updateRungeKutta(dt, delayed_input);
 }
 void SimModelTimeDelaySteer::initializeInputQueue(const double & dt)
 {
-  size_t vx_input_queue_size = static_cast<size_t>(round(vx_delay_ / dt));
-  for (size_t i = 0; i < vx_input_queue_size; i++) {
-    vx_input_queue_.push_back(0.0);
-  }
-  size_t steer_input_queue_size = static_cast<size_t>(round(steer_delay_ / dt));
-  for (size_t i = 0; i < steer_input_queue_size; i++) {
-    steer_input_queue_.push_back(0.0);
-  }
+  vx_input_queue_.reset(static_cast<size_t>(round(vx_delay_ / dt)));
+  steer_input_queue_.reset(static_cast<size_t>(round(steer_delay_ / dt)));
 }
 
-Eigen::VectorXd SimModelTimeDelaySteer::calcModel(
-  const Eigen::VectorXd & state, const Eigen::VectorXd & input)
+SimModelTimeDelaySteer::State SimModelTimeDelaySteer::calcModel(
+  const State & state, const Input & input)
 {
   const double vel = state(IDX::VX);
   const double yaw = state(IDX::YAW);
@@ -188,7 +166,7 @@ Eigen::VectorXd SimModelTimeDelaySteer::calcModel(
   vx_rate = std::min(vx_rate_lim_, std::max(-vx_rate_lim_, vx_rate));
   steer_rate = std::min(steer_rate_lim_, std::max(-steer_rate_lim_, steer_rate));
 
-  Eigen::VectorXd d_state = Eigen::VectorXd::Zero(dim_x_);
+  State d_state = State::Zero();
   d_state(IDX::X) = vel * cos(yaw);
   d_state(IDX::Y) = vel * sin(yaw);
   d_state(IDX::YAW) = vel * std::tan(steer) / wheelbase_;
@@ -202,8 +180,7 @@ SimModelTimeDelaySteerAccel::SimModelTimeDelaySteerAccel(
   double vx_lim, double steer_lim, double vx_rate_lim, double steer_rate_lim, double wheelbase,
   double dt, double acc_delay, double acc_time_constant, double steer_delay,
   double steer_time_constant, double deadzone_delta_steer)
-: SimModelInterface(6 /* dim x */, 3 /* dim u */),
-  MIN_TIME_CONSTANT(0.03),
+: MIN_TIME_CONSTANT(0.03),
   vx_lim_(vx_lim),
   vx_rate_lim_(vx_rate_lim),
   steer_lim_(steer_lim),
@@ -238,16 +215,12 @@ double SimModelTimeDelaySteerAccel::getWz()
 double SimModelTimeDelaySteerAccel::getSteer() { return state_(IDX::STEER); }
 void SimModelTimeDelaySteerAccel::update(const double & dt)
 {
-  Eigen::VectorXd delayed_input = Eigen::VectorXd::Zero(dim_u_);
+  Input delayed_input = Input::Zero();
 
-  acc_input_queue_.push_back(input_(IDX_U::ACCX_DES));
-  delayed_input(IDX_U::ACCX_DES) = acc_input_queue_.front();
-  acc_input_queue_.pop_front();
-  steer_input_queue_.push_back(input_(IDX_U::STEER_DES));
-  const double raw_steer_command = steer_input_queue_.front();
+  delayed_input(IDX_U::ACCX_DES) = acc_input_queue_.push(input_(IDX_U::ACCX_DES));
+  const double raw_steer_command = steer_input_queue_.push(input_(IDX_U::STEER_DES));
   delayed_input(IDX_U::STEER_DES) = sim_model_util::getDummySteerCommandWithFriction(
     getSteer(), raw_steer_command, deadzone_delta_steer_);
-  steer_input_queue_.pop_front();
   delayed_input(IDX_U::DRIVE_SHIFT) = input_(IDX_U::DRIVE_SHIFT);
 
   updateRungeKutta(dt, delayed_input);
@@ -270,18 +243,12 @@ void SimModelTimeDelaySteerAccel::update(const double & dt)
 
 void SimModelTimeDelaySteerAccel::initializeInputQueue(const double & dt)
 {
-  size_t vx_input_queue_size = static_cast<size_t>(round(acc_delay_ / dt));
-  for (size_t i = 0; i < vx_input_queue_size; i++) {
-    acc_input_queue_.push_back(0.0);
-  }
-  size_t steer_input_queue_size = static_cast<size_t>(round(steer_delay_ / dt));
-  for (size_t i = 0; i < steer_input_queue_size; i++) {
-    steer_input_queue_.push_back(0.0);
-  }
+  acc_input_queue_.reset(static_cast<size_t>(round(acc_delay_ / dt)));
+  steer_input_queue_.reset(static_cast<size_t>(round(steer_delay_ / dt)));
 }
 
-Eigen::VectorXd SimModelTimeDelaySteerAccel::calcModel(
-  const Eigen::VectorXd & state, const Eigen::VectorXd & input)
+SimModelTimeDelaySteerAccel::State SimModelTimeDelaySteerAccel::calcModel(
+  const State & state, const Input & input)
 {
   double vel = state(IDX::VX);
   double acc = state(IDX::ACCX);
@@ -306,7 +273,7 @@ Eigen::VectorXd SimModelTimeDelaySteerAccel::calcModel(
     vel = std::min(0.0, std::max(vel, -vx_lim_));
   }
 
-  Eigen::VectorXd d_state = Eigen::VectorXd::Zero(dim_x_);
+  State d_state = State::Zero();
   d_state(IDX::X) = vel * cos(yaw);
   d_state(IDX::Y) = vel * sin(yaw);
   d_state(IDX::YAW) = vel * std::tan(steer) / wheelbase_;
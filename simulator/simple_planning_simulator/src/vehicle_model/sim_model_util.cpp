@@ -27,4 +27,21 @@ double getDummySteerCommandWithFriction(
   return steer_command;
 }
 
+void DelayBuffer::reset(const size_t num_steps)
+{
+  buffer_.assign(num_steps, 0.0);
+  head_ = 0;
+}
+
+double DelayBuffer::push(const double command)
+{
+  if (buffer_.empty()) {
+    return command;
+  }
+  const double delayed_command = buffer_[head_];
+  buffer_[head_] = command;
+  head_ = (head_ + 1) % buffer_.size();
+  return delayed_command;
+}
+
 }  // namespace sim_model_util
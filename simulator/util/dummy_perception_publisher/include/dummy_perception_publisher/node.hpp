@@ -23,9 +23,6 @@
 #include <autoware_perception_msgs/msg/dynamic_object_with_feature_array.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
-#include <pcl/common/distances.h>
-#include <pcl/point_types.h>
-#include <pcl_conversions/pcl_conversions.h>
 #include <tf2/LinearMath/Transform.h>
 #include <tf2/convert.h>
 #include <tf2/transform_datatypes.h>
@@ -36,6 +33,13 @@
 #include <random>
 #include <vector>
 
+struct PointNoise
+{
+  double std_dev_x;
+  double std_dev_y;
+  double std_dev_z;
+};
+
 class DummyPerceptionPublisherNode : public rclcpp::Node
 {
 private:
@@ -52,12 +56,24 @@ private:
   bool enable_ray_tracing_;
   bool use_object_recognition_;
   std::mt19937 random_generator_;
+
+  // Spherical range image of the LiDAR at base_link, reused across frames
+  double horizontal_resolution_;
+  size_t num_horizontal_rays_;
+  std::vector<double> vertical_tans_;
+  std::vector<float> range_image_;
+  std::vector<int32_t> object_index_image_;
+  std::vector<size_t> occupied_cells_;
+  sensor_msgs::msg::PointCloud2 output_pointcloud_msg_;
+
   void timerCallback();
-  void createObjectPointcloud(
-    const double length, const double width, const double height, const double std_dev_x,
-    const double std_dev_y, const double std_dev_z,
-    const tf2::Transform & tf_base_link2moved_object,
-    pcl::PointCloud<pcl::PointXYZ>::Ptr & pointcloud_ptr);
+  void rasterizeObject(
+    const int32_t object_index, const double length, const double width, const double height,
+    const tf2::Transform & tf_base_link2moved_object);
+  void extractPointcloud(
+    const std::vector<PointNoise> & point_noises,
+    std::vector<autoware_perception_msgs::msg::DynamicObjectWithFeature> * feature_objects,
+    sensor_msgs::msg::PointCloud2 * pointcloud);
   void objectCallback(const dummy_perception_publisher::msg::Object::ConstSharedPtr msg);
 
 public:
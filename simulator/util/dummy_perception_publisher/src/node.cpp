@@ -14,10 +14,13 @@
 
 #include "dummy_perception_publisher/node.hpp"
 
-#include <pcl/filters/voxel_grid_occlusion_estimation.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 #include <tf2/LinearMath/Quaternion.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -25,6 +28,33 @@
 #include <utility>
 #include <vector>
 
+namespace
+{
+void initializeCluster(sensor_msgs::msg::PointCloud2 * cluster)
+{
+  sensor_msgs::PointCloud2Modifier modifier(*cluster);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(0);
+}
+
+// Grow the cloud by num_points and return the byte offset of the first new point
+size_t appendPoints(const size_t num_points, sensor_msgs::msg::PointCloud2 * pointcloud)
+{
+  sensor_msgs::PointCloud2Modifier modifier(*pointcloud);
+  const size_t offset = pointcloud->data.size();
+  modifier.resize(modifier.size() + num_points);
+  return offset;
+}
+
+void writePoint(const float x, const float y, const float z, uint8_t * data)
+{
+  // x, y and z are the first three float fields of "xyz"
+  std::memcpy(data, &x, sizeof(float));
+  std::memcpy(data + sizeof(float), &y, sizeof(float));
+  std::memcpy(data + 2 * sizeof(float), &z, sizeof(float));
+}
+}  // namespace
+
 DummyPerceptionPublisherNode::DummyPerceptionPublisherNode()
 : Node("dummy_perception_publisher"), tf_buffer_(this->get_clock()), tf_listener_(tf_buffer_)
 {
@@ -53,6 +83,25 @@ DummyPerceptionPublisherNode::DummyPerceptionPublisherNode()
   detection_successful_rate_ = this->declare_parameter("detection_successful_rate", 0.8);
   enable_ray_tracing_ = this->declare_parameter("enable_ray_tracing", true);
   use_object_recognition_ = this->declare_parameter("use_object_recognition", true);
+
+  // LiDAR model [deg]
+  const double horizontal_resolution = this->declare_parameter("horizontal_resolution", 0.1);
+  const double vertical_resolution = this->declare_parameter("vertical_resolution", 1.0);
+  const double vertical_min_angle = this->declare_parameter("vertical_min_angle", -15.0);
+  const double vertical_max_angle = this->declare_parameter("vertical_max_angle", 15.0);
+
+  const double epsilon = 0.001;
+  horizontal_resolution_ = horizontal_resolution / 180.0 * M_PI;
+  num_horizontal_rays_ = std::ceil(2.0 * M_PI / horizontal_resolution_);
+  for (double angle = vertical_min_angle; angle <= vertical_max_angle + epsilon;
+       angle += vertical_resolution) {
+    vertical_tans_.push_back(std::tan(angle / 180.0 * M_PI));
+  }
+  range_image_.assign(
+    num_horizontal_rays_ * vertical_tans_.size(), std::numeric_limits<float>::infinity());
+  object_index_image_.assign(range_image_.size(), -1);
+
+  initializeCluster(&output_pointcloud_msg_);
 }
 
 void DummyPerceptionPublisherNode::timerCallback()
@@ -60,7 +109,6 @@ void DummyPerceptionPublisherNode::timerCallback()
   // output msgs
   autoware_perception_msgs::msg::DynamicObjectWithFeatureArray output_dynamic_object_msg;
   geometry_msgs::msg::PoseStamped output_moved_object_pose;
-  sensor_msgs::msg::PointCloud2 output_pointcloud_msg;
   std_msgs::msg::Header header;
   rclcpp::Time current_time = this->now();
 
@@ -88,7 +136,10 @@ void DummyPerceptionPublisherNode::timerCallback()
     return;
   }
 
-  std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> v_pointcloud;
+  // keep the allocated buffer of the previous cycle
+  sensor_msgs::PointCloud2Modifier(output_pointcloud_msg_).resize(0);
+
+  std::vector<PointNoise> point_noises;
   std::vector<size_t> delete_idxs;
   static std::uniform_real_distribution<> detection_successful_random(0.0, 1.0);
   for (size_t i = 0; i < objects_.size(); ++i) {
@@ -118,14 +169,7 @@ void DummyPerceptionPublisherNode::timerCallback()
     tf2::fromMsg(objects_.at(i).initial_state.pose_covariance.pose, tf_map2object_origin);
     tf_map2moved_object = tf_map2object_origin * tf_object_origin2moved_object;
     tf2::toMsg(tf_map2moved_object, output_moved_object_pose.pose);
-
-    // pointcloud
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-    createObjectPointcloud(
-      objects_.at(i).shape.dimensions.x, objects_.at(i).shape.dimensions.y,
-      objects_.at(i).shape.dimensions.z, std_dev_x, std_dev_y, std_dev_z,
-      tf_base_link2map * tf_map2moved_object, pointcloud_ptr);
-    v_pointcloud.push_back(pointcloud_ptr);
+    const tf2::Transform tf_base_link2moved_object = tf_base_link2map * tf_map2moved_object;
 
     // dynamic object
     std::normal_distribution<> x_random(0.0, std_dev_x);
@@ -137,7 +181,7 @@ void DummyPerceptionPublisherNode::timerCallback()
       noised_quat, tf2::Vector3(x_random(random_generator_), y_random(random_generator_), 0.0));
     tf2::Transform tf_base_link2noised_moved_object;
     tf_base_link2noised_moved_object =
-      tf_base_link2map * tf_map2moved_object * tf_moved_object2noised_moved_object;
+      tf_base_link2moved_object * tf_moved_object2noised_moved_object;
     autoware_perception_msgs::msg::DynamicObjectWithFeature feature_object;
     feature_object.object.semantic = objects_.at(i).semantic;
     feature_object.object.state.pose_covariance = objects_.at(i).initial_state.pose_covariance;
@@ -147,12 +191,24 @@ void DummyPerceptionPublisherNode::timerCallback()
     feature_object.object.state.acceleration_reliable = false;
     tf2::toMsg(tf_base_link2noised_moved_object, feature_object.object.state.pose_covariance.pose);
     feature_object.object.shape = objects_.at(i).shape;
-    pcl::toROSMsg(*pointcloud_ptr, feature_object.feature.cluster);
+    initializeCluster(&feature_object.feature.cluster);
+    feature_object.feature.cluster.header.frame_id = "base_link";
+    feature_object.feature.cluster.header.stamp = current_time;
     output_dynamic_object_msg.feature_objects.push_back(feature_object);
+    point_noises.push_back({std_dev_x, std_dev_y, std_dev_z});
+
+    // pointcloud
+    rasterizeObject(
+      output_dynamic_object_msg.feature_objects.size() - 1, objects_.at(i).shape.dimensions.x,
+      objects_.at(i).shape.dimensions.y, objects_.at(i).shape.dimensions.z,
+      tf_base_link2moved_object);
+    if (!enable_ray_tracing_) {
+      // objects do not occlude each other
+      extractPointcloud(
+        point_noises, &output_dynamic_object_msg.feature_objects, &output_pointcloud_msg_);
+    }
 
     // check delete idx
-    tf2::Transform tf_base_link2moved_object;
-    tf_base_link2moved_object = tf_base_link2map * tf_map2moved_object;
     double dist = std::sqrt(
       tf_base_link2moved_object.getOrigin().x() * tf_base_link2moved_object.getOrigin().x() +
       tf_base_link2moved_object.getOrigin().y() * tf_base_link2moved_object.getOrigin().y());
@@ -165,48 +221,10 @@ void DummyPerceptionPublisherNode::timerCallback()
     objects_.erase(objects_.begin() + delete_idxs.at(delete_idx));
   }
 
-  // merge all pointcloud
-  pcl::PointCloud<pcl::PointXYZ>::Ptr merged_pointcloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  for (size_t i = 0; i < v_pointcloud.size(); ++i) {
-    for (size_t j = 0; j < v_pointcloud.at(i)->size(); ++j) {
-      merged_pointcloud_ptr->push_back(v_pointcloud.at(i)->at(j));
-    }
-  }
-  // no ground
-  pcl::toROSMsg(*merged_pointcloud_ptr, output_pointcloud_msg);
-
-  // ray tracing
+  // ray tracing: only the nearest object of each ray remains in the range image
   if (enable_ray_tracing_) {
-    pcl::PointCloud<pcl::PointXYZ>::Ptr ray_traced_merged_pointcloud_ptr(
-      new pcl::PointCloud<pcl::PointXYZ>);
-    pcl::VoxelGridOcclusionEstimation<pcl::PointXYZ> ray_tracing_filter;
-    ray_tracing_filter.setInputCloud(merged_pointcloud_ptr);
-    ray_tracing_filter.setLeafSize(0.25, 0.25, 0.25);
-    ray_tracing_filter.initializeVoxelGrid();
-    for (size_t i = 0; i < v_pointcloud.size(); ++i) {
-      pcl::PointCloud<pcl::PointXYZ>::Ptr ray_traced_pointcloud_ptr(
-        new pcl::PointCloud<pcl::PointXYZ>);
-      for (size_t j = 0; j < v_pointcloud.at(i)->size(); ++j) {
-        Eigen::Vector3i grid_coordinates = ray_tracing_filter.getGridCoordinates(
-          v_pointcloud.at(i)->at(j).x, v_pointcloud.at(i)->at(j).y, v_pointcloud.at(i)->at(j).z);
-        int grid_state;
-        if (ray_tracing_filter.occlusionEstimation(grid_state, grid_coordinates) != 0) {
-          RCLCPP_ERROR(get_logger(), "ray tracing failed");
-        }
-        if (grid_state == 1) {  // occluded
-          continue;
-        } else {  // not occluded
-          ray_traced_pointcloud_ptr->push_back(v_pointcloud.at(i)->at(j));
-          ray_traced_merged_pointcloud_ptr->push_back(v_pointcloud.at(i)->at(j));
-        }
-      }
-      pcl::toROSMsg(
-        *ray_traced_pointcloud_ptr,
-        output_dynamic_object_msg.feature_objects.at(i).feature.cluster);
-      output_dynamic_object_msg.feature_objects.at(i).feature.cluster.header.frame_id = "base_link";
-      output_dynamic_object_msg.feature_objects.at(i).feature.cluster.header.stamp = current_time;
-    }
-    pcl::toROSMsg(*ray_traced_merged_pointcloud_ptr, output_pointcloud_msg);
+    extractPointcloud(
+      point_noises, &output_dynamic_object_msg.feature_objects, &output_pointcloud_msg_);
   }
 
   // create output header
@@ -214,124 +232,147 @@ void DummyPerceptionPublisherNode::timerCallback()
   output_moved_object_pose.header.stamp = current_time;
   output_dynamic_object_msg.header.frame_id = "base_link";
   output_dynamic_object_msg.header.stamp = current_time;
-  output_pointcloud_msg.header.frame_id = "base_link";
-  output_pointcloud_msg.header.stamp = current_time;
+  output_pointcloud_msg_.header.frame_id = "base_link";
+  output_pointcloud_msg_.header.stamp = current_time;
 
   // publish
-  pointcloud_pub_->publish(output_pointcloud_msg);
+  pointcloud_pub_->publish(output_pointcloud_msg_);
   if (use_object_recognition_) {
     dynamic_object_pub_->publish(output_dynamic_object_msg);
   }
 }
 
-void DummyPerceptionPublisherNode::createObjectPointcloud(
-  const double length, const double width, const double height, const double std_dev_x,
-  const double std_dev_y, const double std_dev_z, const tf2::Transform & tf_base_link2moved_object,
-  pcl::PointCloud<pcl::PointXYZ>::Ptr & pointcloud_ptr)
+void DummyPerceptionPublisherNode::rasterizeObject(
+  const int32_t object_index, const double length, const double width, const double height,
+  const tf2::Transform & tf_base_link2moved_object)
 {
-  std::normal_distribution<> x_random(0.0, std_dev_x);
-  std::normal_distribution<> y_random(0.0, std_dev_y);
-  std::normal_distribution<> z_random(0.0, std_dev_z);
-  auto getBaseLinkTo2DPoint = [tf_base_link2moved_object](double x, double y) -> pcl::PointXYZ {
-    tf2::Transform tf_moved_object2point;
-    tf2::Transform tf_base_link2point;
-    geometry_msgs::msg::Transform ros_moved_object2point;
-    ros_moved_object2point.translation.x = x;
-    ros_moved_object2point.translation.y = y;
-    ros_moved_object2point.translation.z = 0.0;
-    ros_moved_object2point.rotation.x = 0;
-    ros_moved_object2point.rotation.y = 0;
-    ros_moved_object2point.rotation.z = 0;
-    ros_moved_object2point.rotation.w = 1;
-    tf2::fromMsg(ros_moved_object2point, tf_moved_object2point);
-    tf_base_link2point = tf_base_link2moved_object * tf_moved_object2point;
-    pcl::PointXYZ point;
-    point.x = tf_base_link2point.getOrigin().x();
-    point.y = tf_base_link2point.getOrigin().y();
-    point.z = tf_base_link2point.getOrigin().z();
-    return point;
-  };
-  const double epsilon = 0.001;
-  const double step = 0.05;
-  const double vertical_theta_step = (1.0 / 180.0) * M_PI;
-  const double vertical_min_theta = (-15.0 / 180.0) * M_PI;
-  const double vertical_max_theta = (15.0 / 180.0) * M_PI;
-  const double horizontal_theta_step = (0.1 / 180.0) * M_PI;
-  const double horizontal_min_theta = (-180.0 / 180.0) * M_PI;
-  const double horizontal_max_theta = (180.0 / 180.0) * M_PI;
-
+  const double half_length = length / 2.0;
+  const double half_width = width / 2.0;
   const double min_z = -1.0 * (height / 2.0) + tf_base_link2moved_object.getOrigin().z();
   const double max_z = 1.0 * (height / 2.0) + tf_base_link2moved_object.getOrigin().z();
-  pcl::PointCloud<pcl::PointXYZ> horizontal_candidate_pointcloud;
-  pcl::PointCloud<pcl::PointXYZ> horizontal_pointcloud;
-  {
-    const double y = -1.0 * (width / 2.0);
-    for (double x = -1.0 * (length / 2.0); x <= ((length / 2.0) + epsilon); x += step) {
-      horizontal_candidate_pointcloud.push_back(getBaseLinkTo2DPoint(x, y));
-    }
-  }
-  {
-    const double y = 1.0 * (width / 2.0);
-    for (double x = -1.0 * (length / 2.0); x <= ((length / 2.0) + epsilon); x += step) {
-      horizontal_candidate_pointcloud.push_back(getBaseLinkTo2DPoint(x, y));
-    }
+  const double epsilon = 0.001;
+
+  // sensor origin in the object frame
+  const tf2::Transform tf_moved_object2base_link = tf_base_link2moved_object.inverse();
+  const tf2::Vector3 & sensor = tf_moved_object2base_link.getOrigin();
+  if (std::abs(sensor.x()) <= half_length && std::abs(sensor.y()) <= half_width) {
+    return;
   }
-  {
-    const double x = -1.0 * (length / 2.0);
-    for (double y = -1.0 * (width / 2.0); y <= ((width / 2.0) + epsilon); y += step) {
-      horizontal_candidate_pointcloud.push_back(getBaseLinkTo2DPoint(x, y));
+
+  // azimuth range covered by the object, relative to its center so that it never wraps
+  const double center_azimuth = std::atan2(
+    tf_base_link2moved_object.getOrigin().y(), tf_base_link2moved_object.getOrigin().x());
+  double min_azimuth = std::numeric_limits<double>::max();
+  double max_azimuth = std::numeric_limits<double>::lowest();
+  for (const double x : {-half_length, half_length}) {
+    for (const double y : {-half_width, half_width}) {
+      const tf2::Vector3 corner = tf_base_link2moved_object * tf2::Vector3(x, y, 0.0);
+      const double azimuth =
+        std::remainder(std::atan2(corner.y(), corner.x()) - center_azimuth, 2.0 * M_PI);
+      min_azimuth = std::min(min_azimuth, azimuth);
+      max_azimuth = std::max(max_azimuth, azimuth);
     }
   }
-  {
-    const double x = 1.0 * (length / 2.0);
-    for (double y = -1.0 * (width / 2.0); y <= ((width / 2.0) + epsilon); y += step) {
-      horizontal_candidate_pointcloud.push_back(getBaseLinkTo2DPoint(x, y));
+  const int64_t begin_ray =
+    std::floor((center_azimuth + min_azimuth + M_PI) / horizontal_resolution_);
+  const int64_t end_ray =
+    std::floor((center_azimuth + max_azimuth + M_PI) / horizontal_resolution_);
+
+  const int64_t num_rays = num_horizontal_rays_;
+  const size_t num_vertical_rays = vertical_tans_.size();
+  const tf2::Matrix3x3 & rotation = tf_moved_object2base_link.getBasis();
+  for (int64_t ray = begin_ray; ray <= end_ray; ++ray) {
+    const size_t horizontal_index = ((ray % num_rays) + num_rays) % num_rays;
+    const double azimuth = -M_PI + (horizontal_index + 0.5) * horizontal_resolution_;
+    const tf2::Vector3 direction =
+      rotation * tf2::Vector3(std::cos(azimuth), std::sin(azimuth), 0.0);
+
+    // 2D slab intersection with the footprint in the object frame
+    double t_enter = 0.0;
+    double t_exit = std::numeric_limits<double>::max();
+    bool is_hit = true;
+    for (int axis = 0; axis < 2 && is_hit; ++axis) {
+      const double half_size = axis == 0 ? half_length : half_width;
+      const double origin = sensor[axis];
+      const double dir = direction[axis];
+      if (std::abs(dir) < std::numeric_limits<double>::epsilon()) {
+        is_hit = std::abs(origin) <= half_size;
+        continue;
+      }
+      const double t1 = (-half_size - origin) / dir;
+      const double t2 = (half_size - origin) / dir;
+      t_enter = std::max(t_enter, std::min(t1, t2));
+      t_exit = std::min(t_exit, std::max(t1, t2));
+      is_hit = t_enter <= t_exit;
     }
-  }
-  // 2D ray tracing
-  size_t ranges_size =
-    std::ceil((horizontal_max_theta - horizontal_min_theta) / horizontal_theta_step);
-  std::vector<double> horizontal_ray_traced_2d_pointcloud;
-  horizontal_ray_traced_2d_pointcloud.assign(ranges_size, std::numeric_limits<double>::infinity());
-  const int no_data = -1;
-  std::vector<int> horizontal_ray_traced_pointcloud_indices;
-  horizontal_ray_traced_pointcloud_indices.assign(ranges_size, no_data);
-  for (size_t i = 0; i < horizontal_candidate_pointcloud.points.size(); ++i) {
-    double angle =
-      std::atan2(horizontal_candidate_pointcloud.at(i).y, horizontal_candidate_pointcloud.at(i).x);
-    double range =
-      std::hypot(horizontal_candidate_pointcloud.at(i).y, horizontal_candidate_pointcloud.at(i).x);
-    if (angle < horizontal_min_theta || angle > horizontal_max_theta) {
+    if (!is_hit) {
       continue;
     }
-    int index = (angle - horizontal_min_theta) / horizontal_theta_step;
-    if (range < horizontal_ray_traced_2d_pointcloud[index]) {
-      horizontal_ray_traced_2d_pointcloud[index] = range;
-      horizontal_ray_traced_pointcloud_indices.at(index) = i;
+
+    // the nearest surface wins for each cell
+    const float range = t_enter;
+    for (size_t vertical_index = 0; vertical_index < num_vertical_rays; ++vertical_index) {
+      const double z = range * vertical_tans_.at(vertical_index);
+      if (z < min_z || max_z + epsilon < z) {
+        continue;
+      }
+      const size_t cell = horizontal_index * num_vertical_rays + vertical_index;
+      if (range_image_.at(cell) <= range) {
+        continue;
+      }
+      if (object_index_image_.at(cell) < 0) {
+        occupied_cells_.push_back(cell);
+      }
+      range_image_.at(cell) = range;
+      object_index_image_.at(cell) = object_index;
     }
   }
-  for (const auto & pointcloud_index : horizontal_ray_traced_pointcloud_indices) {
-    if (pointcloud_index != no_data) {
-      // generate vertical point
-      horizontal_pointcloud.push_back(horizontal_candidate_pointcloud.at(pointcloud_index));
-      const double distance = std::hypot(
-        horizontal_candidate_pointcloud.at(pointcloud_index).x,
-        horizontal_candidate_pointcloud.at(pointcloud_index).y);
-      for (double vertical_theta = vertical_min_theta;
-           vertical_theta <= vertical_max_theta + epsilon; vertical_theta += vertical_theta_step) {
-        const double z = distance * std::tan(vertical_theta);
-        if (min_z <= z && z <= max_z + epsilon) {
-          pcl::PointXYZ point;
-          point.x =
-            horizontal_candidate_pointcloud.at(pointcloud_index).x + x_random(random_generator_);
-          point.y =
-            horizontal_candidate_pointcloud.at(pointcloud_index).y + y_random(random_generator_);
-          point.z = z + z_random(random_generator_);
-          pointcloud_ptr->push_back(point);
-        }
-      }
+}
+
+void DummyPerceptionPublisherNode::extractPointcloud(
+  const std::vector<PointNoise> & point_noises,
+  std::vector<autoware_perception_msgs::msg::DynamicObjectWithFeature> * feature_objects,
+  sensor_msgs::msg::PointCloud2 * pointcloud)
+{
+  // reserve the points of every object at once
+  std::vector<size_t> num_points(feature_objects->size(), 0);
+  for (const auto cell : occupied_cells_) {
+    ++num_points.at(object_index_image_.at(cell));
+  }
+  std::vector<size_t> cluster_offsets(feature_objects->size(), 0);
+  for (size_t i = 0; i < feature_objects->size(); ++i) {
+    if (num_points.at(i) > 0) {
+      cluster_offsets.at(i) =
+        appendPoints(num_points.at(i), &feature_objects->at(i).feature.cluster);
     }
   }
+  size_t offset = appendPoints(occupied_cells_.size(), pointcloud);
+
+  std::normal_distribution<float> standard_random(0.0, 1.0);
+  const size_t num_vertical_rays = vertical_tans_.size();
+  for (const auto cell : occupied_cells_) {
+    const int32_t object_index = object_index_image_.at(cell);
+    const PointNoise & noise = point_noises.at(object_index);
+    const double azimuth = -M_PI + (cell / num_vertical_rays + 0.5) * horizontal_resolution_;
+    const double range = range_image_.at(cell);
+    const float x =
+      range * std::cos(azimuth) + noise.std_dev_x * standard_random(random_generator_);
+    const float y =
+      range * std::sin(azimuth) + noise.std_dev_y * standard_random(random_generator_);
+    const float z = range * vertical_tans_.at(cell % num_vertical_rays) +
+                    noise.std_dev_z * standard_random(random_generator_);
+
+    auto & cluster = feature_objects->at(object_index).feature.cluster;
+    writePoint(x, y, z, &cluster.data.at(cluster_offsets.at(object_index)));
+    cluster_offsets.at(object_index) += cluster.point_step;
+    writePoint(x, y, z, &pointcloud->data.at(offset));
+    offset += pointcloud->point_step;
+
+    // clear the cell for the next rasterization
+    range_image_.at(cell) = std::numeric_limits<float>::infinity();
+    object_index_image_.at(cell) = -1;
+  }
+  occupied_cells_.clear();
 }
 
 void DummyPerceptionPublisherNode::objectCallback(
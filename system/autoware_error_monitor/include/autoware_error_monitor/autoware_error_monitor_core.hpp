@@ -27,7 +27,6 @@
 
 #include <boost/optional.hpp>
 
-#include <deque>
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -39,15 +38,22 @@ struct DiagStamped
   diagnostic_msgs::msg::DiagnosticStatus status;
 };
 
-using DiagBuffer = std::deque<DiagStamped>;
+struct DiagState
+{
+  boost::optional<DiagStamped> latest_diag;
+  std::vector<diagnostic_msgs::msg::DiagnosticStatus> leaf_children;
+  bool is_timeout = false;
+};
 
 struct DiagConfig
 {
   std::string name;
-  std::string sf_at;
-  std::string lf_at;
-  std::string spf_at;
+  // Diag level where it becomes each fault, resolved at load time. "none" never matches.
+  int sf_at;
+  int lf_at;
+  int spf_at;
   bool auto_recovery;
+  size_t diag_id;  // index of diag_states_
 };
 
 using RequiredModules = std::vector<DiagConfig>;
@@ -104,8 +110,10 @@ private:
   void onControlMode(const autoware_vehicle_msgs::msg::ControlMode::ConstSharedPtr msg);
   void onDiagArray(const diagnostic_msgs::msg::DiagnosticArray::ConstSharedPtr msg);
 
-  const size_t diag_buffer_size_ = 100;
-  std::unordered_map<std::string, DiagBuffer> diag_buffer_map_;
+  // Only required diags are kept, indexed by the ids resolved in loadRequiredModules
+  std::unordered_map<std::string, size_t> diag_id_map_;
+  std::vector<DiagState> diag_states_;
+  bool is_hazard_status_dirty_ = true;
   diagnostic_msgs::msg::DiagnosticArray::ConstSharedPtr diag_array_;
   autoware_system_msgs::msg::AutowareState::ConstSharedPtr autoware_state_;
   autoware_control_msgs::msg::GateMode::ConstSharedPtr current_gate_mode_;
@@ -123,10 +131,13 @@ private:
     std_srvs::srv::Trigger::Response::SharedPtr response);
 
   // Algorithm
-  boost::optional<DiagStamped> getLatestDiag(const std::string & diag_name) const;
+  size_t getDiagId(const std::string & diag_name);
+  void updateLeafChildren(const std::vector<diagnostic_msgs::msg::DiagnosticStatus> & diagnostics);
+  void updateTimeout();
   int getHazardLevel(const DiagConfig & required_module, const int diag_level) const;
   void appendHazardDiag(
     const DiagConfig & required_module, const diagnostic_msgs::msg::DiagnosticStatus & diag,
+    const std::vector<diagnostic_msgs::msg::DiagnosticStatus> & leaf_children,
     autoware_system_msgs::msg::HazardStatus * hazard_status) const;
   autoware_system_msgs::msg::HazardStatus judgeHazardStatus() const;
   void updateHazardStatus();
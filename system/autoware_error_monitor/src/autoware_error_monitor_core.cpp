@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <regex>
 #include <set>
@@ -57,13 +58,19 @@ int str2level(const std::string & level_str)
   throw std::runtime_error(fmt::format("invalid level: {}", level_str));
 }
 
-bool isOverLevel(const int & diag_level, const std::string & failure_level_str)
+int str2failureLevel(const std::string & failure_level_str)
 {
+  // Never becomes the fault
   if (failure_level_str == "none") {
-    return false;
+    return std::numeric_limits<int>::max();
   }
 
-  return diag_level >= str2level(failure_level_str);
+  return str2level(failure_level_str);
+}
+
+bool isOverLevel(const int diag_level, const int failure_level)
+{
+  return diag_level >= failure_level;
 }
 
 std::vector<diagnostic_msgs::msg::DiagnosticStatus> & getTargetDiagnosticsRef(
@@ -304,12 +311,27 @@ void AutowareErrorMonitor::loadRequiredModules(const std::string & key)
     bool auto_recovery_approval{};
     std::istringstream(auto_recovery_approval_str) >> std::boolalpha >> auto_recovery_approval;
 
-    required_modules.push_back({param_module, sf_at, lf_at, spf_at, auto_recovery_approval});
+    required_modules.push_back(
+      {param_module, str2failureLevel(sf_at), str2failureLevel(lf_at), str2failureLevel(spf_at),
+       auto_recovery_approval, getDiagId(param_module)});
   }
 
   required_modules_map_.insert(std::make_pair(key, required_modules));
 }
 
+size_t AutowareErrorMonitor::getDiagId(const std::string & diag_name)
+{
+  const auto itr = diag_id_map_.find(diag_name);
+  if (itr != diag_id_map_.end()) {
+    return itr->second;
+  }
+
+  const size_t diag_id = diag_states_.size();
+  diag_id_map_.insert(std::make_pair(diag_name, diag_id));
+  diag_states_.emplace_back();
+  return diag_id;
+}
+
 void AutowareErrorMonitor::onDiagArray(
   const diagnostic_msgs::msg::DiagnosticArray::ConstSharedPtr msg)
 {
@@ -318,15 +340,69 @@ void AutowareErrorMonitor::onDiagArray(
   const auto & header = msg->header;
 
   for (const auto & diag : msg->status) {
-    if (diag_buffer_map_.count(diag.name) == 0) {
-      diag_buffer_map_.insert(std::make_pair(diag.name, DiagBuffer{}));
+    const auto itr = diag_id_map_.find(diag.name);
+    if (itr == diag_id_map_.end()) {
+      continue;
+    }
+
+    auto & diag_state = diag_states_.at(itr->second);
+    if (!diag_state.latest_diag || diag_state.latest_diag->status != diag) {
+      is_hazard_status_dirty_ = true;
+    }
+    diag_state.latest_diag = DiagStamped{header, diag};
+  }
+
+  if (params_.add_leaf_diagnostics) {
+    updateLeafChildren(msg->status);
+  }
+}
+
+void AutowareErrorMonitor::updateLeafChildren(
+  const std::vector<diagnostic_msgs::msg::DiagnosticStatus> & diagnostics)
+{
+  std::vector<std::vector<diagnostic_msgs::msg::DiagnosticStatus>> leaf_children_list(
+    diag_states_.size());
+
+  // Walk up the ancestors of each leaf once instead of filtering the whole array per module
+  const auto diag_name_set = diagnostics_filter::createDiagNameSet(diagnostics);
+  for (const auto & diag : diagnostics) {
+    if (!diagnostics_filter::isLeaf(diag_name_set, diag)) {
+      continue;
     }
 
-    auto & diag_buffer = diag_buffer_map_.at(diag.name);
-    diag_buffer.push_back(DiagStamped{header, diag});
+    auto name = diagnostics_filter::splitStringByLastSlash(diag.name);
+    while (name != "") {
+      const auto itr = diag_id_map_.find(name);
+      if (itr != diag_id_map_.end()) {
+        leaf_children_list.at(itr->second).push_back(diag);
+      }
 
-    while (diag_buffer.size() > diag_buffer_size_) {
-      diag_buffer.pop_front();
+      name = diagnostics_filter::splitStringByLastSlash(name);
+    }
+  }
+
+  for (size_t i = 0; i < diag_states_.size(); ++i) {
+    auto & leaf_children = diag_states_.at(i).leaf_children;
+    if (leaf_children != leaf_children_list.at(i)) {
+      leaf_children.swap(leaf_children_list.at(i));
+      is_hazard_status_dirty_ = true;
+    }
+  }
+}
+
+void AutowareErrorMonitor::updateTimeout()
+{
+  const auto now = this->now();
+  for (auto & diag_state : diag_states_) {
+    if (!diag_state.latest_diag) {
+      continue;
+    }
+
+    const auto time_diff = now - diag_state.latest_diag->header.stamp;
+    const bool is_timeout = time_diff.seconds() > params_.diag_timeout_sec;
+    if (is_timeout != diag_state.is_timeout) {
+      diag_state.is_timeout = is_timeout;
+      is_hazard_status_dirty_ = true;
     }
   }
 }
@@ -334,12 +410,18 @@ void AutowareErrorMonitor::onDiagArray(
 void AutowareErrorMonitor::onCurrentGateMode(
   const autoware_control_msgs::msg::GateMode::ConstSharedPtr msg)
 {
+  if (!current_gate_mode_ || current_gate_mode_->data != msg->data) {
+    is_hazard_status_dirty_ = true;
+  }
   current_gate_mode_ = msg;
 }
 
 void AutowareErrorMonitor::onAutowareState(
   const autoware_system_msgs::msg::AutowareState::ConstSharedPtr msg)
 {
+  if (!autoware_state_ || autoware_state_->state != msg->state) {
+    is_hazard_status_dirty_ = true;
+  }
   autoware_state_ = msg;
 }
 
@@ -389,26 +471,11 @@ void AutowareErrorMonitor::onTimer()
                     ? KeyName::autonomous_driving
                     : KeyName::external_control;
 
+  updateTimeout();
   updateHazardStatus();
   publishHazardStatus(hazard_status_);
 }
 
-boost::optional<DiagStamped> AutowareErrorMonitor::getLatestDiag(
-  const std::string & diag_name) const
-{
-  if (diag_buffer_map_.count(diag_name) == 0) {
-    return {};
-  }
-
-  const auto & diag_buffer = diag_buffer_map_.at(diag_name);
-
-  if (diag_buffer.empty()) {
-    return {};
-  }
-
-  return diag_buffer.back();
-}
-
 int AutowareErrorMonitor::getHazardLevel(
   const DiagConfig & required_module, const int diag_level) const
 {
@@ -429,6 +496,7 @@ int AutowareErrorMonitor::getHazardLevel(
 
 void AutowareErrorMonitor::appendHazardDiag(
   const DiagConfig & required_module, const diagnostic_msgs::msg::DiagnosticStatus & hazard_diag,
+  const std::vector<diagnostic_msgs::msg::DiagnosticStatus> & leaf_children,
   autoware_system_msgs::msg::HazardStatus * hazard_status) const
 {
   const auto hazard_level = getHazardLevel(required_module, hazard_diag.level);
@@ -437,10 +505,8 @@ void AutowareErrorMonitor::appendHazardDiag(
   target_diagnostics_ref.push_back(hazard_diag);
 
   if (params_.add_leaf_diagnostics) {
-    for (const auto & diag :
-         diagnostics_filter::extractLeafChildrenDiagnostics(hazard_diag, diag_array_->status)) {
-      target_diagnostics_ref.push_back(diag);
-    }
+    target_diagnostics_ref.insert(
+      target_diagnostics_ref.end(), leaf_children.begin(), leaf_children.end());
   }
 
   hazard_status->level = std::max(hazard_status->level, hazard_level);
@@ -453,20 +519,20 @@ autoware_system_msgs::msg::HazardStatus AutowareErrorMonitor::judgeHazardStatus(
 
   autoware_system_msgs::msg::HazardStatus hazard_status;
   for (const auto & required_module : required_modules_map_.at(current_mode_)) {
-    const auto & diag_name = required_module.name;
-    const auto latest_diag = getLatestDiag(diag_name);
+    const auto & diag_state = diag_states_.at(required_module.diag_id);
+    const auto & latest_diag = diag_state.latest_diag;
 
     // no diag found
     if (!latest_diag) {
       if (!params_.ignore_missing_diagnostics) {
         DiagnosticStatus missing_diag;
 
-        missing_diag.name = diag_name;
+        missing_diag.name = required_module.name;
         missing_diag.hardware_id = "autoware_error_monitor";
         missing_diag.level = DiagnosticStatus::STALE;
         missing_diag.message = "no diag found";
 
-        appendHazardDiag(required_module, missing_diag, &hazard_status);
+        appendHazardDiag(required_module, missing_diag, diag_state.leaf_children, &hazard_status);
       }
 
       continue;
@@ -474,19 +540,17 @@ autoware_system_msgs::msg::HazardStatus AutowareErrorMonitor::judgeHazardStatus(
 
     // diag level high
     {
-      appendHazardDiag(required_module, latest_diag->status, &hazard_status);
+      appendHazardDiag(
+        required_module, latest_diag->status, diag_state.leaf_children, &hazard_status);
     }
 
     // diag timeout
-    {
-      const auto time_diff = this->now() - latest_diag->header.stamp;
-      if (time_diff.seconds() > params_.diag_timeout_sec) {
-        DiagnosticStatus timeout_diag = latest_diag->status;
-        timeout_diag.level = DiagnosticStatus::STALE;
-        timeout_diag.message = "timeout";
+    if (diag_state.is_timeout) {
+      DiagnosticStatus timeout_diag = latest_diag->status;
+      timeout_diag.level = DiagnosticStatus::STALE;
+      timeout_diag.message = "timeout";
 
-        appendHazardDiag(required_module, timeout_diag, &hazard_status);
-      }
+      appendHazardDiag(required_module, timeout_diag, diag_state.leaf_children, &hazard_status);
     }
   }
 
@@ -502,14 +566,15 @@ void AutowareErrorMonitor::updateHazardStatus()
 {
   const bool prev_emergency_status = hazard_status_.emergency;
 
-  // Create hazard status based on diagnostics
-  if (!hazard_status_.emergency_holding) {
+  // Create hazard status based on diagnostics, only when any of its inputs has changed
+  if (!hazard_status_.emergency_holding && is_hazard_status_dirty_) {
     const auto current_hazard_status = judgeHazardStatus();
     hazard_status_.level = current_hazard_status.level;
     hazard_status_.diagnostics_nf = current_hazard_status.diagnostics_nf;
     hazard_status_.diagnostics_sf = current_hazard_status.diagnostics_sf;
     hazard_status_.diagnostics_lf = current_hazard_status.diagnostics_lf;
     hazard_status_.diagnostics_spf = current_hazard_status.diagnostics_spf;
+    is_hazard_status_dirty_ = false;
   }
 
   // Update emergency status
@@ -586,6 +651,7 @@ bool AutowareErrorMonitor::onClearEmergencyService(
   std_srvs::srv::Trigger::Response::SharedPtr response)
 {
   hazard_status_.emergency_holding = false;
+  is_hazard_status_dirty_ = true;
   updateHazardStatus();
   response->success = true;
   response->message = "Emergency Holding state was cleared.";
@@ -18,6 +18,8 @@
 #include "autoware_state_monitor/autoware_state.hpp"
 #include "autoware_state_monitor/config.hpp"
 #include "autoware_state_monitor/state_machine.hpp"
+#include "autoware_state_monitor/tf_monitor.hpp"
+#include "autoware_state_monitor/topic_monitor.hpp"
 
 #include <diagnostic_updater/diagnostic_updater.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -31,11 +33,10 @@
 #include <autoware_vehicle_msgs/msg/engage.hpp>
 #include <geometry_msgs/msg/pose_stamped.hpp>
 #include <geometry_msgs/msg/twist_stamped.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
 
 #include <tf2_ros/buffer.h>
-#include <tf2_ros/transform_listener.h>
 
-#include <deque>
 #include <map>
 #include <memory>
 #include <string>
@@ -57,9 +58,13 @@ private:
   std::vector<TfConfig> tf_configs_;
 
   // TF
+  // fed by the subscriptions of /tf and /tf_static, which also update tf_monitor_
   tf2_ros::Buffer tf_buffer_;
-  tf2_ros::TransformListener tf_listener_;
-  geometry_msgs::msg::PoseStamped::ConstSharedPtr current_pose_;
+  rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr sub_tf_;
+  rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr sub_tf_static_;
+  bool is_tf_updated_ = false;
+
+  void onTransforms(const tf2_msgs::msg::TFMessage::ConstSharedPtr msg, const bool is_static);
 
   // CallbackGroups
   rclcpp::CallbackGroup::SharedPtr callback_group_subscribers_;
@@ -80,14 +85,12 @@ private:
   void onTwist(const geometry_msgs::msg::TwistStamped::ConstSharedPtr msg);
 
   // Topic Buffer
-  void onTopic(
-    const std::shared_ptr<rclcpp::SerializedMessage> msg, const std::string & topic_name);
+  void onTopic(const std::shared_ptr<rclcpp::SerializedMessage> msg, const size_t topic_idx);
   void registerTopicCallback(
-    const std::string & topic_name, const std::string & topic_type, const bool transient_local,
-    const bool best_effort);
+    const size_t topic_idx, const std::string & topic_name, const std::string & topic_type,
+    const bool transient_local, const bool best_effort);
 
   std::map<std::string, rclcpp::GenericSubscription::SharedPtr> sub_topic_map_;
-  std::map<std::string, std::deque<rclcpp::Time>> topic_received_time_buffer_;
 
   // Service
   rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr srv_shutdown_;
@@ -114,9 +117,10 @@ private:
   rclcpp::TimerBase::SharedPtr timer_;
 
   // Stats
-  TopicStats getTopicStats() const;
+  std::shared_ptr<TopicMonitor> topic_monitor_;
+  std::shared_ptr<TfMonitor> tf_monitor_;
+
   ParamStats getParamStats() const;
-  TfStats getTfStats() const;
 
   // State Machine
   std::shared_ptr<StateMachine> state_machine_;
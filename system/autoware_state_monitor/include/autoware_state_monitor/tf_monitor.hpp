@@ -0,0 +1,81 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_STATE_MONITOR__TF_MONITOR_HPP_
+#define AUTOWARE_STATE_MONITOR__TF_MONITOR_HPP_
+
+#include "autoware_state_monitor/config.hpp"
+
+#include <rclcpp/time.hpp>
+
+#include <geometry_msgs/msg/transform_stamped.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Status of the monitored transforms, from the stamps of the transforms received on /tf and
+ * /tf_static instead of a lookup of each transform. The latest time of a transform is the oldest
+ * of the latest stamps of the dynamic links between its frames, as the latest transform of
+ * lookupTransform, and is found again only when a link has been received since the last check.
+ */
+class TfMonitor
+{
+public:
+  explicit TfMonitor(const std::vector<TfConfig> & tf_configs);
+
+  void onTransform(const geometry_msgs::msg::TransformStamped & transform, const bool is_static);
+
+  /**
+   * @brief check the timeouts at checked_time
+   * @return true if the lists of the stats have changed since the last check
+   */
+  bool update(const rclcpp::Time & checked_time);
+
+  const TfStats & getTfStats() const { return tf_stats_; }
+
+private:
+  enum class Status { NonReceived, Ok, Timeout };
+
+  struct Link
+  {
+    std::string parent_frame;
+    int64_t latest_stamp_ns;
+    bool is_static;
+  };
+
+  struct TfState
+  {
+    bool is_connected = false;
+    rclcpp::Time latest_time;
+    Status status = Status::NonReceived;
+  };
+
+  std::vector<TfConfig> tf_configs_;
+  std::vector<TfState> tf_states_;
+
+  std::unordered_map<std::string, Link> links_;  // key: child frame
+  bool is_link_changed_ = false;
+
+  TfStats tf_stats_;
+  bool is_status_changed_ = true;
+
+  bool findLatestCommonTime(
+    const std::string & from, const std::string & to, int64_t * latest_time_ns) const;
+  void updateTfStats();
+};
+
+#endif  // AUTOWARE_STATE_MONITOR__TF_MONITOR_HPP_
@@ -0,0 +1,77 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_STATE_MONITOR__TOPIC_MONITOR_HPP_
+#define AUTOWARE_STATE_MONITOR__TOPIC_MONITOR_HPP_
+
+#include "autoware_state_monitor/config.hpp"
+
+#include <rclcpp/time.hpp>
+
+#include <array>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Status of the monitored topics, updated when a message is received. The rate is measured
+ * over a fixed ring of the last received times, and the timeouts are found from a min-heap of the
+ * deadlines, so that a check only looks at the topics whose deadline has passed.
+ */
+class TopicMonitor
+{
+public:
+  explicit TopicMonitor(const std::vector<TopicConfig> & topic_configs);
+
+  void onTopicReceived(const size_t topic_idx, const rclcpp::Time & received_time);
+
+  /**
+   * @brief check the timeouts at checked_time
+   * @return true if the lists of the stats have changed since the last check
+   */
+  bool update(const rclcpp::Time & checked_time);
+
+  const TopicStats & getTopicStats() const { return topic_stats_; }
+
+private:
+  static constexpr size_t received_time_buffer_size = 10;
+
+  enum class Status { NonReceived, Ok, SlowRate, Timeout };
+
+  struct TopicState
+  {
+    std::array<rclcpp::Time, received_time_buffer_size> received_times;  // ring buffer
+    size_t num_received_times = 0;
+    size_t next_idx = 0;
+    double rate = 0.0;
+    Status status = Status::NonReceived;
+    bool has_deadline = false;
+  };
+
+  using Deadline = std::pair<rclcpp::Time, size_t>;  // pair<deadline, topic_idx>
+
+  std::vector<TopicConfig> topic_configs_;
+  std::vector<TopicState> topic_states_;
+  // at most one deadline per topic, pushed again when it has been extended by a new message
+  std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines_;
+
+  TopicStats topic_stats_;
+  bool is_status_changed_ = true;
+
+  const rclcpp::Time & getLastReceivedTime(const TopicState & state) const;
+  void updateTopicStats();
+};
+
+#endif  // AUTOWARE_STATE_MONITOR__TOPIC_MONITOR_HPP_
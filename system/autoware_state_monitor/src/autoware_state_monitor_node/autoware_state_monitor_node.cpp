@@ -15,8 +15,8 @@
 #include "autoware_state_monitor/autoware_state_monitor_node.hpp"
 
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
+#include <tf2_ros/qos.hpp>
 
-#include <deque>
 #include <memory>
 #include <string>
 #include <utility>
@@ -43,16 +43,6 @@ std::vector<Config> getConfigs(
   return configs;
 }
 
-double calcTopicRate(const std::deque<rclcpp::Time> & topic_received_time_buffer)
-{
-  assert(topic_received_time_buffer.size() >= 2);
-
-  const auto & buf = topic_received_time_buffer;
-  const auto time_diff = buf.back() - buf.front();
-
-  return static_cast<double>(buf.size() - 1) / time_diff.seconds();
-}
-
 geometry_msgs::msg::PoseStamped::SharedPtr getCurrentPose(const tf2_ros::Buffer & tf_buffer)
 {
   geometry_msgs::msg::TransformStamped tf_current_pose;
@@ -240,16 +230,28 @@ bool AutowareStateMonitorNode::onResetRouteService(
 void AutowareStateMonitorNode::onTimer()
 {
   // Prepare state input
-  state_input_.current_pose = getCurrentPose(tf_buffer_);
+  // the buffer has the same transforms until a new one is received
+  if (is_tf_updated_) {
+    state_input_.current_pose = getCurrentPose(tf_buffer_);
+    is_tf_updated_ = false;
+  }
   if (state_input_.current_pose == nullptr) {
     RCLCPP_WARN_THROTTLE(
       this->get_logger(), *this->get_clock(), 5000 /* ms */,
       "Fail lookupTransform base_link to map");
   }
 
-  state_input_.topic_stats = getTopicStats();
+  // the lists of the stats are copied only when a status has changed
+  const auto checked_time = this->now();
+  if (topic_monitor_->update(checked_time)) {
+    state_input_.topic_stats = topic_monitor_->getTopicStats();
+  }
+  state_input_.topic_stats.checked_time = checked_time;
   state_input_.param_stats = getParamStats();
-  state_input_.tf_stats = getTfStats();
+  if (tf_monitor_->update(checked_time)) {
+    state_input_.tf_stats = tf_monitor_->getTfStats();
+  }
+  state_input_.tf_stats.checked_time = checked_time;
   state_input_.current_time = this->now();
   // Update state
   const auto prev_autoware_state = state_machine_->getCurrentState();
@@ -292,31 +294,19 @@ void AutowareStateMonitorNode::onTimer()
 
 // TODO(jilaada): Use generic subscription base
 void AutowareStateMonitorNode::onTopic(
-  [[maybe_unused]] const std::shared_ptr<rclcpp::SerializedMessage> msg,
-  const std::string & topic_name)
+  [[maybe_unused]] const std::shared_ptr<rclcpp::SerializedMessage> msg, const size_t topic_idx)
 {
-  const auto now = this->now();
-
-  auto & buf = topic_received_time_buffer_.at(topic_name);
-  buf.push_back(now);
-
-  constexpr size_t topic_received_time_buffer_size = 10;
-  if (buf.size() > topic_received_time_buffer_size) {
-    buf.pop_front();
-  }
+  topic_monitor_->onTopicReceived(topic_idx, this->now());
 }
 
 void AutowareStateMonitorNode::registerTopicCallback(
-  const std::string & topic_name, const std::string & topic_type, const bool transient_local,
-  const bool best_effort)
+  const size_t topic_idx, const std::string & topic_name, const std::string & topic_type,
+  const bool transient_local, const bool best_effort)
 {
-  // Initialize buffer
-  topic_received_time_buffer_[topic_name] = {};
-
   // Register callback
   using Callback = std::function<void(const std::shared_ptr<rclcpp::SerializedMessage>)>;
   const auto callback = static_cast<Callback>(
-    std::bind(&AutowareStateMonitorNode::onTopic, this, std::placeholders::_1, topic_name));
+    std::bind(&AutowareStateMonitorNode::onTopic, this, std::placeholders::_1, topic_idx));
   auto qos = rclcpp::QoS{1};
   if (transient_local) {
     qos.transient_local();
@@ -332,46 +322,6 @@ void AutowareStateMonitorNode::registerTopicCallback(
     this->create_generic_subscription(topic_name, topic_type, qos, callback, subscriber_option);
 }
 
-TopicStats AutowareStateMonitorNode::getTopicStats() const
-{
-  TopicStats topic_stats;
-  topic_stats.checked_time = this->now();
-
-  for (const auto & topic_config : topic_configs_) {
-    // Alias
-    const auto & buf = topic_received_time_buffer_.at(topic_config.name);
-
-    // Check at least once received
-    if (buf.empty()) {
-      topic_stats.non_received_list.push_back(topic_config);
-      continue;
-    }
-
-    // Check timeout
-    const auto last_received_time = buf.back();
-    const auto time_diff = (topic_stats.checked_time - last_received_time).seconds();
-    const auto is_timeout = (topic_config.timeout != 0) && (time_diff > topic_config.timeout);
-    if (is_timeout) {
-      topic_stats.timeout_list.emplace_back(topic_config, last_received_time);
-      continue;
-    }
-
-    // Check topic rate
-    if (!is_timeout && buf.size() >= 2) {
-      const auto topic_rate = calcTopicRate(buf);
-      if (topic_config.warn_rate != 0 && topic_rate < topic_config.warn_rate) {
-        topic_stats.slow_rate_list.emplace_back(topic_config, topic_rate);
-        continue;
-      }
-    }
-
-    // No error
-    topic_stats.ok_list.push_back(topic_config);
-  }
-
-  return topic_stats;
-}
-
 ParamStats AutowareStateMonitorNode::getParamStats() const
 {
   ParamStats param_stats;
@@ -391,32 +341,20 @@ ParamStats AutowareStateMonitorNode::getParamStats() const
   return param_stats;
 }
 
-TfStats AutowareStateMonitorNode::getTfStats() const
+void AutowareStateMonitorNode::onTransforms(
+  const tf2_msgs::msg::TFMessage::ConstSharedPtr msg, const bool is_static)
 {
-  TfStats tf_stats;
-  tf_stats.checked_time = this->now();
-
-  for (const auto & tf_config : tf_configs_) {
+  const std::string authority = "Authority undetectable";
+  for (const auto & transform : msg->transforms) {
     try {
-      const auto transform =
-        tf_buffer_.lookupTransform(tf_config.from, tf_config.to, tf2::TimePointZero);
-
-      const auto last_received_time = transform.header.stamp;
-      const auto time_diff = (tf_stats.checked_time - last_received_time).seconds();
-      if (time_diff > tf_config.timeout) {
-        tf_stats.timeout_list.emplace_back(tf_config, last_received_time);
-        continue;
-      }
-    } catch (tf2::TransformException & ex) {
-      tf_stats.non_received_list.push_back(tf_config);
+      tf_buffer_.setTransform(transform, authority, is_static);
+    } catch (const tf2::TransformException & ex) {
+      RCLCPP_ERROR(this->get_logger(), "failed to set transform: %s", ex.what());
       continue;
     }
-
-    // No error
-    tf_stats.ok_list.push_back(tf_config);
+    tf_monitor_->onTransform(transform, is_static);
   }
-
-  return tf_stats;
+  is_tf_updated_ = true;
 }
 
 bool AutowareStateMonitorNode::isEngaged()
@@ -439,7 +377,6 @@ void AutowareStateMonitorNode::setDisengage()
 AutowareStateMonitorNode::AutowareStateMonitorNode()
 : Node("autoware_state_monitor"),
   tf_buffer_(this->get_clock()),
-  tf_listener_(tf_buffer_),
   updater_(this)
 {
   using std::placeholders::_1;
@@ -461,6 +398,8 @@ AutowareStateMonitorNode::AutowareStateMonitorNode()
   // Config
   topic_configs_ = getConfigs<TopicConfig>(this->get_node_parameters_interface(), "topic_configs");
   tf_configs_ = getConfigs<TfConfig>(this->get_node_parameters_interface(), "tf_configs");
+  topic_monitor_ = std::make_shared<TopicMonitor>(topic_configs_);
+  tf_monitor_ = std::make_shared<TfMonitor>(tf_configs_);
 
   // Callback Groups
   callback_group_subscribers_ =
@@ -471,11 +410,21 @@ AutowareStateMonitorNode::AutowareStateMonitorNode()
   subscriber_option.callback_group = callback_group_subscribers_;
 
   // Topic Callback
-  for (const auto & topic_config : topic_configs_) {
+  for (size_t topic_idx = 0; topic_idx < topic_configs_.size(); ++topic_idx) {
+    const auto & topic_config = topic_configs_.at(topic_idx);
     registerTopicCallback(
-      topic_config.name, topic_config.type, topic_config.transient_local, topic_config.best_effort);
+      topic_idx, topic_config.name, topic_config.type, topic_config.transient_local,
+      topic_config.best_effort);
   }
 
+  // TF
+  sub_tf_ = this->create_subscription<tf2_msgs::msg::TFMessage>(
+    "/tf", tf2_ros::DynamicListenerQoS(),
+    std::bind(&AutowareStateMonitorNode::onTransforms, this, _1, false), subscriber_option);
+  sub_tf_static_ = this->create_subscription<tf2_msgs::msg::TFMessage>(
+    "/tf_static", tf2_ros::StaticListenerQoS(),
+    std::bind(&AutowareStateMonitorNode::onTransforms, this, _1, true), subscriber_option);
+
   // Subscriber
   sub_autoware_engage_ = this->create_subscription<autoware_vehicle_msgs::msg::Engage>(
     "input/autoware_engage", 1, std::bind(&AutowareStateMonitorNode::onAutowareEngage, this, _1),
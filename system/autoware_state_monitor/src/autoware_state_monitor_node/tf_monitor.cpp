@@ -0,0 +1,174 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_state_monitor/tf_monitor.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// latest time of a chain without dynamic link
+constexpr int64_t static_time_ns = std::numeric_limits<int64_t>::max();
+
+// same frame id as tf2
+std::string stripSlash(const std::string & frame_id)
+{
+  if (!frame_id.empty() && frame_id.front() == '/') {
+    return frame_id.substr(1);
+  }
+  return frame_id;
+}
+}  // namespace
+
+TfMonitor::TfMonitor(const std::vector<TfConfig> & tf_configs)
+: tf_configs_(tf_configs), tf_states_(tf_configs.size())
+{
+  for (auto & tf_config : tf_configs_) {
+    tf_config.from = stripSlash(tf_config.from);
+    tf_config.to = stripSlash(tf_config.to);
+  }
+}
+
+void TfMonitor::onTransform(
+  const geometry_msgs::msg::TransformStamped & transform, const bool is_static)
+{
+  const int64_t stamp_ns = rclcpp::Time(transform.header.stamp).nanoseconds();
+  const auto child_frame = stripSlash(transform.child_frame_id);
+
+  auto itr = links_.find(child_frame);
+  if (itr == links_.end()) {
+    links_.emplace(child_frame, Link{stripSlash(transform.header.frame_id), stamp_ns, is_static});
+  } else {
+    auto & link = itr->second;
+    link.parent_frame = stripSlash(transform.header.frame_id);
+    // transforms received out of order don't make the latest one older
+    link.latest_stamp_ns = is_static ? stamp_ns : std::max(link.latest_stamp_ns, stamp_ns);
+    link.is_static = is_static;
+  }
+
+  is_link_changed_ = true;
+}
+
+bool TfMonitor::update(const rclcpp::Time & checked_time)
+{
+  tf_stats_.checked_time = checked_time;
+
+  for (size_t tf_idx = 0; tf_idx < tf_configs_.size(); ++tf_idx) {
+    const auto & tf_config = tf_configs_.at(tf_idx);
+    auto & state = tf_states_.at(tf_idx);
+
+    if (is_link_changed_) {
+      int64_t latest_time_ns = 0;
+      state.is_connected = findLatestCommonTime(tf_config.from, tf_config.to, &latest_time_ns);
+      // a chain of static links is stamped with zero by lookupTransform
+      state.latest_time = rclcpp::Time(
+        latest_time_ns == static_time_ns ? 0 : latest_time_ns, checked_time.get_clock_type());
+    }
+
+    auto status = Status::NonReceived;
+    if (state.is_connected) {
+      const auto time_diff = (checked_time - state.latest_time).seconds();
+      status = time_diff > tf_config.timeout ? Status::Timeout : Status::Ok;
+    }
+
+    if (status != state.status) {
+      state.status = status;
+      is_status_changed_ = true;
+    }
+  }
+  is_link_changed_ = false;
+
+  if (!is_status_changed_) {
+    return false;
+  }
+
+  updateTfStats();
+  is_status_changed_ = false;
+  return true;
+}
+
+bool TfMonitor::findLatestCommonTime(
+  const std::string & from, const std::string & to, int64_t * latest_time_ns) const
+{
+  // a frame has one parent, so that the frames are connected through their common ancestor
+  const size_t max_depth = links_.size() + 1;
+
+  // Ancestors of from, with the latest time of the links from from to them
+  std::vector<std::pair<const std::string *, int64_t>> from_ancestors;
+  const std::string * frame = &from;
+  int64_t time_ns = static_time_ns;
+  for (size_t depth = 0; depth < max_depth; ++depth) {
+    from_ancestors.emplace_back(frame, time_ns);
+    const auto itr = links_.find(*frame);
+    if (itr == links_.end()) {
+      break;
+    }
+    if (!itr->second.is_static) {
+      time_ns = std::min(time_ns, itr->second.latest_stamp_ns);
+    }
+    frame = &itr->second.parent_frame;
+  }
+
+  // Ancestors of to, up to the first one shared with from
+  frame = &to;
+  time_ns = static_time_ns;
+  for (size_t depth = 0; depth < max_depth; ++depth) {
+    const auto ancestor_itr = std::find_if(
+      from_ancestors.begin(), from_ancestors.end(),
+      [frame](const auto & ancestor) { return *ancestor.first == *frame; });
+    if (ancestor_itr != from_ancestors.end()) {
+      *latest_time_ns = std::min(time_ns, ancestor_itr->second);
+      return true;
+    }
+
+    const auto itr = links_.find(*frame);
+    if (itr == links_.end()) {
+      return false;
+    }
+    if (!itr->second.is_static) {
+      time_ns = std::min(time_ns, itr->second.latest_stamp_ns);
+    }
+    frame = &itr->second.parent_frame;
+  }
+
+  return false;
+}
+
+void TfMonitor::updateTfStats()
+{
+  tf_stats_.ok_list.clear();
+  tf_stats_.non_received_list.clear();
+  tf_stats_.timeout_list.clear();
+
+  for (size_t tf_idx = 0; tf_idx < tf_configs_.size(); ++tf_idx) {
+    const auto & tf_config = tf_configs_.at(tf_idx);
+    const auto & state = tf_states_.at(tf_idx);
+
+    switch (state.status) {
+      case Status::NonReceived:
+        tf_stats_.non_received_list.push_back(tf_config);
+        break;
+      case Status::Timeout:
+        tf_stats_.timeout_list.emplace_back(tf_config, state.latest_time);
+        break;
+      case Status::Ok:
+        tf_stats_.ok_list.push_back(tf_config);
+        break;
+    }
+  }
+}
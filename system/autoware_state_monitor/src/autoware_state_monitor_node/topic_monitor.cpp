@@ -0,0 +1,126 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_state_monitor/topic_monitor.hpp"
+
+#include <algorithm>
+#include <vector>
+
+constexpr size_t TopicMonitor::received_time_buffer_size;
+
+TopicMonitor::TopicMonitor(const std::vector<TopicConfig> & topic_configs)
+: topic_configs_(topic_configs), topic_states_(topic_configs.size())
+{
+}
+
+void TopicMonitor::onTopicReceived(const size_t topic_idx, const rclcpp::Time & received_time)
+{
+  const auto & topic_config = topic_configs_.at(topic_idx);
+  auto & state = topic_states_.at(topic_idx);
+
+  state.received_times[state.next_idx] = received_time;
+  state.next_idx = (state.next_idx + 1) % received_time_buffer_size;
+  state.num_received_times = std::min(state.num_received_times + 1, received_time_buffer_size);
+
+  // Rate over the ring, whose oldest time is the next to be overwritten once it is full
+  if (state.num_received_times >= 2) {
+    const auto & oldest_time = state.num_received_times < received_time_buffer_size
+                                 ? state.received_times.front()
+                                 : state.received_times[state.next_idx];
+    state.rate = static_cast<double>(state.num_received_times - 1) /
+                 (received_time - oldest_time).seconds();
+  }
+
+  // Check topic rate
+  const bool is_slow_rate = state.num_received_times >= 2 && topic_config.warn_rate != 0 &&
+                            state.rate < topic_config.warn_rate;
+  const auto status = is_slow_rate ? Status::SlowRate : Status::Ok;
+  // the measured rate of a slow topic is also reported
+  if (status != state.status || status == Status::SlowRate) {
+    state.status = status;
+    is_status_changed_ = true;
+  }
+
+  if (topic_config.timeout != 0 && !state.has_deadline) {
+    deadlines_.emplace(
+      received_time + rclcpp::Duration::from_seconds(topic_config.timeout), topic_idx);
+    state.has_deadline = true;
+  }
+}
+
+bool TopicMonitor::update(const rclcpp::Time & checked_time)
+{
+  topic_stats_.checked_time = checked_time;
+
+  // Check timeout
+  while (!deadlines_.empty() && deadlines_.top().first < checked_time) {
+    const auto topic_idx = deadlines_.top().second;
+    deadlines_.pop();
+
+    auto & state = topic_states_.at(topic_idx);
+    const auto deadline =
+      getLastReceivedTime(state) +
+      rclcpp::Duration::from_seconds(topic_configs_.at(topic_idx).timeout);
+    if (checked_time <= deadline) {
+      deadlines_.emplace(deadline, topic_idx);
+      continue;
+    }
+
+    state.status = Status::Timeout;
+    state.has_deadline = false;
+    is_status_changed_ = true;
+  }
+
+  if (!is_status_changed_) {
+    return false;
+  }
+
+  updateTopicStats();
+  is_status_changed_ = false;
+  return true;
+}
+
+const rclcpp::Time & TopicMonitor::getLastReceivedTime(const TopicState & state) const
+{
+  return state.received_times
+    [(state.next_idx + received_time_buffer_size - 1) % received_time_buffer_size];
+}
+
+void TopicMonitor::updateTopicStats()
+{
+  topic_stats_.ok_list.clear();
+  topic_stats_.non_received_list.clear();
+  topic_stats_.timeout_list.clear();
+  topic_stats_.slow_rate_list.clear();
+
+  for (size_t topic_idx = 0; topic_idx < topic_configs_.size(); ++topic_idx) {
+    const auto & topic_config = topic_configs_.at(topic_idx);
+    const auto & state = topic_states_.at(topic_idx);
+
+    switch (state.status) {
+      case Status::NonReceived:
+        topic_stats_.non_received_list.push_back(topic_config);
+        break;
+      case Status::Timeout:
+        topic_stats_.timeout_list.emplace_back(topic_config, getLastReceivedTime(state));
+        break;
+      case Status::SlowRate:
+        topic_stats_.slow_rate_list.emplace_back(topic_config, state.rate);
+        break;
+      case Status::Ok:
+        topic_stats_.ok_list.push_back(topic_config);
+        break;
+    }
+  }
+}
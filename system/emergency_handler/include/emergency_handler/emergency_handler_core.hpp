@@ -17,6 +17,7 @@
 
 // Core
 #include <memory>
+#include <mutex>
 #include <string>
 
 // Autoware
@@ -29,7 +30,7 @@
 #include <autoware_vehicle_msgs/msg/vehicle_command.hpp>
 
 // ROS2 core
-#include <autoware_utils/system/heartbeat_checker.hpp>
+#include <diagnostic_updater/diagnostic_updater.hpp>
 #include <rclcpp/create_timer.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -89,7 +90,10 @@ private:
   void publishControlCommands();
 
   // Timer
+  // The state is updated by the callbacks of the inputs, the timer only watches the heartbeat and
+  // the takeover request timeout in its own callback group, so that it isn't delayed by them
   rclcpp::TimerBase::SharedPtr timer_;
+  rclcpp::CallbackGroup::SharedPtr callback_group_watchdog_;
 
   // Parameters
   Param param_;
@@ -97,9 +101,20 @@ private:
   bool isDataReady();
   void onTimer();
 
+  // Shared by the callbacks of the inputs and the watchdog
+  std::mutex mutex_;
+
   // Heartbeat
-  std::shared_ptr<HeaderlessHeartbeatChecker<autoware_system_msgs::msg::HazardStatusStamped>>
-    heartbeat_hazard_status_;
+  rclcpp::Time stamp_hazard_status_;
+  bool isHeartbeatTimeout();
+
+  // Diagnostics
+  diagnostic_updater::Updater updater_;
+  double last_reaction_time_ = 0.0;  //!< @brief time from a fault to the MRM command [s]
+  double max_reaction_time_ = 0.0;   //!< @brief worst reaction time since the start [s]
+
+  void recordReactionTime(const rclcpp::Time & fault_time);
+  void checkReactionTime(diagnostic_updater::DiagnosticStatusWrapper & stat);
 
   // Algorithm
   autoware_system_msgs::msg::EmergencyState::_state_type emergency_state_{
@@ -108,6 +123,7 @@ private:
 
   void transitionTo(const int new_state);
   void updateEmergencyState();
+  void updateAndPublish(const rclcpp::Time & event_time);
   bool isStopped();
   bool isEmergency(const autoware_system_msgs::msg::HazardStatus & hazard_status);
   autoware_control_msgs::msg::ControlCommand selectAlternativeControlCommand();
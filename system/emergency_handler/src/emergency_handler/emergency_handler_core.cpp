@@ -14,11 +14,12 @@
 
 #include "emergency_handler/emergency_handler_core.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 
-EmergencyHandler::EmergencyHandler() : Node("emergency_handler")
+EmergencyHandler::EmergencyHandler() : Node("emergency_handler"), updater_(this)
 {
   // Parameter
   param_.update_rate = declare_parameter<int>("update_rate", 10);
@@ -42,11 +43,6 @@ EmergencyHandler::EmergencyHandler() : Node("emergency_handler")
   sub_control_mode_ = create_subscription<autoware_vehicle_msgs::msg::ControlMode>(
     "~/input/control_mode", rclcpp::QoS{1}, std::bind(&EmergencyHandler::onControlMode, this, _1));
 
-  // Heartbeat
-  heartbeat_hazard_status_ =
-    std::make_shared<HeaderlessHeartbeatChecker<autoware_system_msgs::msg::HazardStatusStamped>>(
-      *this, "~/input/hazard_status", param_.timeout_hazard_status);
-
   // Publisher
   pub_control_command_ = create_publisher<autoware_control_msgs::msg::ControlCommandStamped>(
     "~/output/control_command", rclcpp::QoS{1});
@@ -63,26 +59,37 @@ EmergencyHandler::EmergencyHandler() : Node("emergency_handler")
   prev_control_command_ = autoware_control_msgs::msg::ControlCommand::ConstSharedPtr(
     new autoware_control_msgs::msg::ControlCommand);
 
+  // Diagnostics
+  updater_.setHardwareID("emergency_handler");
+  updater_.add("emergency_reaction_time", this, &EmergencyHandler::checkReactionTime);
+
   // Timer
+  callback_group_watchdog_ = create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
   auto timer_callback = std::bind(&EmergencyHandler::onTimer, this);
   const auto update_period_ns = rclcpp::Rate(param_.update_rate).period();
 
   timer_ = std::make_shared<rclcpp::GenericTimer<decltype(timer_callback)>>(
     this->get_clock(), update_period_ns, std::move(timer_callback),
     this->get_node_base_interface()->get_context());
-  this->get_node_timers_interface()->add_timer(timer_, nullptr);
+  this->get_node_timers_interface()->add_timer(timer_, callback_group_watchdog_);
 }
 
 void EmergencyHandler::onHazardStatusStamped(
   const autoware_system_msgs::msg::HazardStatusStamped::ConstSharedPtr msg)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   hazard_status_stamped_ = msg;
+  stamp_hazard_status_ = this->now();
+
+  // react to the fault in this callback instead of the next timer period
+  updateAndPublish(msg->header.stamp);
 }
 
 // To be replaced by ControlCommand
 void EmergencyHandler::onPrevControlCommand(
   const autoware_vehicle_msgs::msg::VehicleCommand::ConstSharedPtr msg)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   const auto control_command = new autoware_control_msgs::msg::ControlCommand();
   *control_command = msg->control;
   prev_control_command_ =
@@ -91,13 +98,27 @@ void EmergencyHandler::onPrevControlCommand(
 
 void EmergencyHandler::onTwist(const geometry_msgs::msg::TwistStamped::ConstSharedPtr msg)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   twist_ = msg;
+
+  // the MRM succeeds as soon as the vehicle stops
+  using autoware_system_msgs::msg::EmergencyState;
+  if (emergency_state_ == EmergencyState::MRM_OPERATING && isStopped()) {
+    updateAndPublish(msg->header.stamp);
+  }
 }
 
 void EmergencyHandler::onControlMode(
   const autoware_vehicle_msgs::msg::ControlMode::ConstSharedPtr msg)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const bool is_changed = msg->data != control_mode_->data;
   control_mode_ = msg;
+
+  // the mode is published periodically, only a change can cause a transition
+  if (is_changed && isDataReady()) {
+    updateAndPublish(this->now());
+  }
 }
 
 autoware_vehicle_msgs::msg::TurnSignal EmergencyHandler::createTurnSignalMsg()
@@ -167,25 +188,73 @@ bool EmergencyHandler::isDataReady()
   return true;
 }
 
+bool EmergencyHandler::isHeartbeatTimeout()
+{
+  const auto time_from_last_heartbeat = this->now() - stamp_hazard_status_;
+  return time_from_last_heartbeat.seconds() > param_.timeout_hazard_status;
+}
+
 void EmergencyHandler::onTimer()
 {
+  using autoware_system_msgs::msg::EmergencyState;
+
+  std::lock_guard<std::mutex> lock(mutex_);
   if (!isDataReady()) {
     return;
   }
-  if (heartbeat_hazard_status_->isTimeout()) {
+  if (isHeartbeatTimeout()) {
     RCLCPP_WARN_THROTTLE(
       this->get_logger(), *this->get_clock(), std::chrono::milliseconds(1000).count(),
       "heartbeat_hazard_status is timeout");
-    emergency_state_ = autoware_system_msgs::msg::EmergencyState::MRM_OPERATING;
+    if (emergency_state_ == EmergencyState::NORMAL) {
+      recordReactionTime(
+        stamp_hazard_status_ + rclcpp::Duration::from_seconds(param_.timeout_hazard_status));
+    }
+    emergency_state_ = EmergencyState::MRM_OPERATING;
     publishControlCommands();
     return;
   }
 
+  // the takeover request times out without any input
+  if (emergency_state_ == EmergencyState::OVERRIDE_REQUESTING) {
+    updateAndPublish(this->now());
+  }
+}
+
+void EmergencyHandler::updateAndPublish(const rclcpp::Time & event_time)
+{
+  using autoware_system_msgs::msg::EmergencyState;
+
+  // the watchdog keeps the MRM while the hazard status is lost
+  if (isHeartbeatTimeout()) {
+    return;
+  }
+
+  const bool was_normal = emergency_state_ == EmergencyState::NORMAL;
+
   // Update Emergency State
   updateEmergencyState();
 
   // Publish control commands
   publishControlCommands();
+
+  if (was_normal && emergency_state_ != EmergencyState::NORMAL) {
+    recordReactionTime(event_time);
+  }
+}
+
+void EmergencyHandler::recordReactionTime(const rclcpp::Time & fault_time)
+{
+  last_reaction_time_ = (this->now() - fault_time).seconds();
+  max_reaction_time_ = std::max(max_reaction_time_, last_reaction_time_);
+}
+
+void EmergencyHandler::checkReactionTime(diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  stat.add("last_reaction_time", last_reaction_time_);
+  stat.add("max_reaction_time", max_reaction_time_);
+  stat.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "OK");
 }
 
 void EmergencyHandler::transitionTo(const int new_state)
@@ -22,7 +22,11 @@ int main(int argc, char ** argv)
 {
   rclcpp::init(argc, argv);
   auto node = std::make_shared<EmergencyHandler>();
-  rclcpp::spin(node);
+  // the heartbeat watchdog runs in its own callback group
+  rclcpp::executors::MultiThreadedExecutor executor;
+  executor.add_node(node);
+  executor.spin();
+  executor.remove_node(node);
   rclcpp::shutdown();
 
   return 0;
@@ -23,6 +23,7 @@
 #include <diagnostic_updater/diagnostic_updater.hpp>
 
 #include <climits>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -51,6 +52,47 @@ typedef struct cpu_freq_info
   cpu_freq_info(int index, const std::string & path) : index_(index), path_(path) {}
 } cpu_freq_info;
 
+/**
+ * @brief CPU time counters read from /proc/stat
+ */
+typedef struct cpu_stat
+{
+  std::string name_;     //!< @brief cpu name, all or index
+  uint64_t user_;        //!< @brief time spent in user mode including guest
+  uint64_t nice_;        //!< @brief time spent in user mode with low priority including guest
+  uint64_t system_;      //!< @brief time spent in system mode
+  uint64_t idle_;        //!< @brief time spent in the idle task
+  uint64_t iowait_;      //!< @brief time waiting for I/O to complete
+  uint64_t irq_;         //!< @brief time servicing interrupts
+  uint64_t softirq_;     //!< @brief time servicing softirqs
+  uint64_t steal_;       //!< @brief time stolen by other operating systems
+  uint64_t guest_;       //!< @brief time running a virtual CPU
+  uint64_t guest_nice_;  //!< @brief time running a niced guest
+
+  cpu_stat()
+  : name_(),
+    user_(0),
+    nice_(0),
+    system_(0),
+    idle_(0),
+    iowait_(0),
+    irq_(0),
+    softirq_(0),
+    steal_(0),
+    guest_(0),
+    guest_nice_(0)
+  {
+  }
+
+  /**
+   * @brief total time, guest time is already included in user and nice
+   */
+  uint64_t total() const
+  {
+    return user_ + nice_ + system_ + idle_ + iowait_ + irq_ + softirq_ + steal_;
+  }
+} cpu_stat;
+
 class CPUMonitorBase : public rclcpp::Node
 {
 public:
@@ -122,13 +164,21 @@ protected:
   virtual void checkFrequency(
     diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
 
+  /**
+   * @brief read CPU time counters of all CPUs from /proc/stat
+   * @param [out] stats list of counters, the first one is all CPUs
+   * @return true on success, errno is set on failure
+   */
+  bool readCpuStats(std::vector<cpu_stat> * stats);
+
   diagnostic_updater::Updater updater_;  //!< @brief Updater class which advertises to /diagnostics
 
   char hostname_[HOST_NAME_MAX + 1];  //!< @brief host name
   int num_cores_;                     //!< @brief number of cores
   std::vector<cpu_temp_info> temps_;  //!< @brief CPU list for temperature
   std::vector<cpu_freq_info> freqs_;  //!< @brief CPU list for frequency
-  bool mpstat_exists_;                //!< @brief flag if mpstat exists
+  std::map<std::string, cpu_stat>
+    prev_cpu_stats_;  //!< @brief counters of the previous cycle to calculate usage as a delta
 
   float temp_warn_;    //!< @brief CPU temperature(DegC) to generate warning
   float temp_error_;   //!< @brief CPU temperature(DegC) to generate error
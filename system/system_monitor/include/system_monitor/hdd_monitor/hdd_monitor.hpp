@@ -22,9 +22,14 @@
 
 #include <diagnostic_updater/diagnostic_updater.hpp>
 
+#include <sys/types.h>
+
 #include <climits>
+#include <cstdint>
 #include <map>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 /**
@@ -79,6 +84,27 @@ protected:
    */
   void getHDDParams();
 
+  /**
+   * @brief get mounted ext4 filesystems from /proc/mounts
+   * @param [out] mounts list of filesystem and mount point
+   * @return true on success, errno is set on failure
+   */
+  bool getExt4Mounts(std::vector<std::pair<std::string, std::string>> * mounts);
+
+  /**
+   * @brief get device numbers of block device files
+   * @param [in] pattern shell wildcard pattern of device files
+   * @param [out] devices set of device numbers
+   */
+  void getBlockDevices(const std::string & pattern, std::set<dev_t> * devices);
+
+  /**
+   * @brief get human-readable output for disk size, as `df -h` does
+   * @param [in] size_in_bytes size with bytes
+   * @return human-readable output
+   */
+  std::string toHumanReadable(const uint64_t size_in_bytes);
+
   diagnostic_updater::Updater updater_;  //!< @brief Updater class which advertises to /diagnostics
 
   char hostname_[HOST_NAME_MAX + 1];  //!< @brief host name
@@ -23,6 +23,7 @@
 #include <diagnostic_updater/diagnostic_updater.hpp>
 
 #include <climits>
+#include <cstdint>
 #include <map>
 #include <string>
 
@@ -52,12 +53,19 @@ protected:
   void checkUsage(
     diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
 
+  /**
+   * @brief read memory statistics from /proc/meminfo
+   * @param [out] meminfo map of name and value, values with unit are converted to bytes
+   * @return true on success, errno is set on failure
+   */
+  bool readMemInfo(std::map<std::string, uint64_t> * meminfo);
+
   /**
    * @brief get human-readable output for memory size
-   * @param [in] str size with bytes
+   * @param [in] size_in_bytes size with bytes
    * @return human-readable output
    */
-  std::string toHumanReadable(const std::string & str);
+  std::string toHumanReadable(const uint64_t size_in_bytes);
 
   diagnostic_updater::Updater updater_;  //!< @brief Updater class which advertises to /diagnostics
 
@@ -0,0 +1,149 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file node_monitor.h
+ * @brief Node monitor class
+ */
+
+#ifndef SYSTEM_MONITOR__NODE_MONITOR__NODE_MONITOR_HPP_
+#define SYSTEM_MONITOR__NODE_MONITOR__NODE_MONITOR_HPP_
+
+#include <diagnostic_updater/diagnostic_updater.hpp>
+
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+
+#include <sys/types.h>
+
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief node information reported by autoware_utils::CallbackTimingPublisher
+ */
+struct NodeInfo
+{
+  pid_t pid_;                //!< @brief process id
+  std::vector<pid_t> tids_;  //!< @brief ids of the threads which ran the callbacks
+  std::map<std::string, std::deque<double>>
+    durations_;  //!< @brief latest execution times of each callback (ms)
+  std::chrono::steady_clock::time_point stamp_;  //!< @brief time of the latest report
+
+  NodeInfo() : pid_(0), tids_(), durations_(), stamp_() {}
+};
+
+class NodeMonitor : public rclcpp::Node
+{
+public:
+  /**
+   * @brief constructor
+   * @param [in] options Options associated with this node.
+   */
+  explicit NodeMonitor(const rclcpp::NodeOptions & options);
+
+  /**
+   * @brief Update the diagnostic state.
+   */
+  void update();
+
+protected:
+  using DiagStatus = diagnostic_msgs::msg::DiagnosticStatus;
+
+  /**
+   * @brief callback of the callback timing topic
+   * @param [in] msg report of a node
+   */
+  void onCallbackTiming(const diagnostic_msgs::msg::DiagnosticStatus::ConstSharedPtr msg);
+
+  /**
+   * @brief check CPU usage and memory of nodes
+   * @param [out] stat diagnostic message passed directly to diagnostic publish calls
+   * @note NOLINT syntax is needed since diagnostic_updater asks for a non-const reference
+   * to pass diagnostic message updated in this function to diagnostic publish calls.
+   */
+  void checkUsage(
+    diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
+
+  /**
+   * @brief check execution time of callbacks of nodes
+   * @param [out] stat diagnostic message passed directly to diagnostic publish calls
+   * @note NOLINT syntax is needed since diagnostic_updater asks for a non-const reference
+   * to pass diagnostic message updated in this function to diagnostic publish calls.
+   */
+  void checkCallbackTime(
+    diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
+
+  /**
+   * @brief remove nodes which have not reported for node_timeout
+   */
+  void removeStaleNodes();
+
+  /**
+   * @brief read CPU time of a thread from /proc/<pid>/task/<tid>/stat
+   * @param [in] pid process id
+   * @param [in] tid thread id
+   * @param [out] time CPU time in user and kernel mode (clock ticks)
+   * @return true on success, false if the thread has exited
+   */
+  bool readThreadTime(pid_t pid, pid_t tid, uint64_t * time);
+
+  /**
+   * @brief read resident set size of a process from /proc/<pid>/statm
+   * @param [in] pid process id
+   * @param [out] rss resident set size (KiB)
+   * @return true on success, false if the process has exited
+   */
+  bool readResidentSize(pid_t pid, uint64_t * rss);
+
+  diagnostic_updater::Updater updater_;  //!< @brief Updater class which advertises to /diagnostics
+  rclcpp::Subscription<diagnostic_msgs::msg::DiagnosticStatus>::SharedPtr
+    sub_callback_timing_;  //!< @brief subscriber of the callback timing topic
+
+  char hostname_[HOST_NAME_MAX + 1];  //!< @brief host name
+
+  int window_size_;             //!< @brief number of execution times kept per callback
+  double node_timeout_;         //!< @brief time(s) to forget a node which stopped reporting
+  float cpu_usage_warn_;        //!< @brief CPU usage(%) of a node to generate warning
+  float cpu_usage_error_;       //!< @brief CPU usage(%) of a node to generate error
+  double callback_time_warn_;   //!< @brief 99th percentile(ms) of a callback to generate warning
+  double callback_time_error_;  //!< @brief 99th percentile(ms) of a callback to generate error
+
+  int64_t clock_ticks_;   //!< @brief clock ticks per second
+  int64_t page_size_kb_;  //!< @brief page size (KiB)
+
+  std::map<std::string, NodeInfo> nodes_;  //!< @brief nodes keyed by fully qualified name
+  std::map<std::pair<pid_t, pid_t>, uint64_t>
+    prev_thread_times_;  //!< @brief CPU time of threads in the previous cycle
+  std::chrono::steady_clock::time_point prev_time_;  //!< @brief time of the previous cycle
+
+  /**
+   * @brief CPU usage status messages
+   */
+  const std::map<int, const char *> usage_dict_ = {
+    {DiagStatus::OK, "OK"}, {DiagStatus::WARN, "high load"}, {DiagStatus::ERROR, "very high load"}};
+
+  /**
+   * @brief callback execution time status messages
+   */
+  const std::map<int, const char *> time_dict_ = {
+    {DiagStatus::OK, "OK"}, {DiagStatus::WARN, "slow"}, {DiagStatus::ERROR, "very slow"}};
+};
+
+#endif  // SYSTEM_MONITOR__NODE_MONITOR__NODE_MONITOR_HPP_
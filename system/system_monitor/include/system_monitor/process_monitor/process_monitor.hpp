@@ -24,13 +24,54 @@
 
 #include <diagnostic_updater/diagnostic_updater.hpp>
 
-#include <boost/process.hpp>
+#include <sys/types.h>
 
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
-namespace bp = boost::process;
+/**
+ * @brief process information read from /proc/<pid>
+ */
+struct ProcessInfo
+{
+  int pid_;               //!< @brief process id
+  uid_t uid_;             //!< @brief user id
+  char state_;            //!< @brief process state
+  int64_t priority_;      //!< @brief priority
+  int64_t nice_;          //!< @brief nice value
+  uint64_t virt_;         //!< @brief virtual memory size (KiB)
+  uint64_t res_;          //!< @brief resident set size (KiB)
+  uint64_t shr_;          //!< @brief shared memory size (KiB)
+  uint64_t start_time_;   //!< @brief start time after system boot (clock ticks)
+  uint64_t total_time_;   //!< @brief CPU time in user and kernel mode (clock ticks)
+  float cpu_;             //!< @brief CPU usage since the previous cycle (%)
+  float mem_;             //!< @brief memory usage (%)
+  std::string command_;   //!< @brief command name
+
+  ProcessInfo()
+  : pid_(0),
+    uid_(0),
+    state_('?'),
+    priority_(0),
+    nice_(0),
+    virt_(0),
+    res_(0),
+    shr_(0),
+    start_time_(0),
+    total_time_(0),
+    cpu_(0.0),
+    mem_(0.0),
+    command_()
+  {
+  }
+};
 
 class ProcessMonitor : public rclcpp::Node
 {
@@ -59,45 +100,59 @@ protected:
     diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
 
   /**
-   * @brief get task summary
-   * @param [out] stat diagnostic message passed directly to diagnostic publish calls
-   * @param [in] output top command output
-   * @note NOLINT syntax is needed since diagnostic_updater asks for a non-const reference
-   * to pass diagnostic message updated in this function to diagnostic publish calls.
+   * @brief read all processes from /proc and calculate CPU usage since the previous cycle
+   * @param [out] procs list of processes
+   * @return true on success, errno is set on failure
    */
-  void getTasksSummary(
-    diagnostic_updater::DiagnosticStatusWrapper & stat,
-    const std::string & output);  // NOLINT(runtime/references)
+  bool readProcesses(std::vector<ProcessInfo> * procs);
 
   /**
-   * @brief remove header
+   * @brief read a process from /proc/<pid>/stat and /proc/<pid>/statm
+   * @param [in] pid process id
+   * @param [out] proc process information
+   * @return true on success, false if the process has exited
+   */
+  bool readProcess(int pid, ProcessInfo * proc);
+
+  /**
+   * @brief get task summary
    * @param [out] stat diagnostic message passed directly to diagnostic publish calls
-   * @param [in] output top command output
+   * @param [in] procs list of processes
    * @note NOLINT syntax is needed since diagnostic_updater asks for a non-const reference
    * to pass diagnostic message updated in this function to diagnostic publish calls.
    */
-  void removeHeader(
+  void getTasksSummary(
     diagnostic_updater::DiagnosticStatusWrapper & stat,
-    std::string & output);  // NOLINT(runtime/references)
+    const std::vector<ProcessInfo> & procs);  // NOLINT(runtime/references)
 
   /**
    * @brief get high load processes
-   * @param [in] output top command output
+   * @param [in] procs list of processes
    */
-  void getHighLoadProcesses(const std::string & output);
+  void getHighLoadProcesses(const std::vector<ProcessInfo> & procs);
 
   /**
    * @brief get high memory processes
-   * @param [in] output top command output
+   * @param [in] procs list of processes
    */
-  void getHighMemoryProcesses(const std::string & output);
+  void getHighMemoryProcesses(const std::vector<ProcessInfo> & procs);
 
   /**
    * @brief get top-rated processes
    * @param [in] tasks list of diagnostics tasks for high load procs
-   * @param [in] output top command output
+   * @param [in] procs list of processes
+   * @param [in] order indices of processes sorted in descending order of rating
    */
-  void getTopratedProcesses(std::vector<std::shared_ptr<DiagTask>> * tasks, bp::pipe * p);
+  void getTopratedProcesses(
+    std::vector<std::shared_ptr<DiagTask>> * tasks, const std::vector<ProcessInfo> & procs,
+    const std::vector<size_t> & order);
+
+  /**
+   * @brief get user name of user id, cached as `top` does
+   * @param [in] uid user id
+   * @return user name, or user id if not found
+   */
+  std::string getUserName(uid_t uid);
 
   /**
    * @brief get top-rated processes
@@ -119,6 +174,15 @@ protected:
     load_tasks_;  //!< @brief list of diagnostics tasks for high load procs
   std::vector<std::shared_ptr<DiagTask>>
     memory_tasks_;  //!< @brief list of diagnostics tasks for high memory procs
+
+  int64_t clock_ticks_;     //!< @brief clock ticks per second
+  int64_t page_size_kb_;    //!< @brief page size (KiB)
+  uint64_t mem_total_kb_;   //!< @brief total physical memory (KiB)
+
+  std::unordered_map<int, std::pair<uint64_t, uint64_t>>
+    prev_times_;  //!< @brief start time and CPU time of processes in the previous cycle
+  std::chrono::steady_clock::time_point prev_time_;  //!< @brief time of the previous cycle
+  std::map<uid_t, std::string> user_names_;          //!< @brief cache of user names
 };
 
 #endif  // SYSTEM_MONITOR__PROCESS_MONITOR__PROCESS_MONITOR_HPP_
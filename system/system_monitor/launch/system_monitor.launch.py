@@ -86,6 +86,16 @@ def launch_setup(context, *args, **kwargs):
             process_monitor_config,
         ],
     )
+    with open(LaunchConfiguration("node_monitor_config_file").perform(context), "r") as f:
+        node_monitor_config = yaml.safe_load(f)["/**"]["ros__parameters"]
+    node_monitor = ComposableNode(
+        package="system_monitor",
+        plugin="NodeMonitor",
+        name="node_monitor",
+        parameters=[
+            node_monitor_config,
+        ],
+    )
     with open(LaunchConfiguration("gpu_monitor_config_file").perform(context), "r") as f:
         gpu_monitor_config = yaml.safe_load(f)["/**"]["ros__parameters"]
     gpu_monitor = ComposableNode(
@@ -110,6 +120,7 @@ def launch_setup(context, *args, **kwargs):
             net_monitor,
             ntp_monitor,
             process_monitor,
+            node_monitor,
             gpu_monitor,
         ],
         output="screen",
@@ -147,6 +158,10 @@ def generate_launch_description():
                 "process_monitor_config_file",
                 default_value=os.path.join(system_monitor_path, "process_monitor.param.yaml"),
             ),
+            DeclareLaunchArgument(
+                "node_monitor_config_file",
+                default_value=os.path.join(system_monitor_path, "node_monitor.param.yaml"),
+            ),
             DeclareLaunchArgument(
                 "gpu_monitor_config_file",
                 default_value=os.path.join(system_monitor_path, "gpu_monitor.param.yaml"),
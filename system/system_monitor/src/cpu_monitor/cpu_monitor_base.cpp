@@ -22,20 +22,19 @@
 #include "system_monitor/system_monitor_utility.hpp"
 
 #include <boost/filesystem.hpp>
-#include <boost/process.hpp>
-#include <boost/property_tree/json_parser.hpp>
-#include <boost/property_tree/ptree.hpp>
 #include <boost/thread.hpp>
 
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
 #include <regex>
 #include <string>
+#include <vector>
 
-namespace bp = boost::process;
 namespace fs = boost::filesystem;
-namespace pt = boost::property_tree;
 
 CPUMonitorBase::CPUMonitorBase(const std::string & node_name, const rclcpp::NodeOptions & options)
 : Node(node_name, options),
@@ -44,7 +43,6 @@ CPUMonitorBase::CPUMonitorBase(const std::string & node_name, const rclcpp::Node
   num_cores_(0),
   temps_(),
   freqs_(),
-  mpstat_exists_(false),
   temp_warn_(declare_parameter<float>("temp_warn", 90.0)),
   temp_error_(declare_parameter<float>("temp_error", 95.0)),
   usage_warn_(declare_parameter<float>("usage_warn", 0.90)),
@@ -54,9 +52,13 @@ CPUMonitorBase::CPUMonitorBase(const std::string & node_name, const rclcpp::Node
   gethostname(hostname_, sizeof(hostname_));
   num_cores_ = boost::thread::hardware_concurrency();
 
-  // Check if command exists
-  fs::path p = bp::search_path("mpstat");
-  mpstat_exists_ = (p.empty()) ? false : true;
+  // Take the first sample so that the first cycle already reports usage as a delta
+  std::vector<cpu_stat> stats;
+  if (readCpuStats(&stats)) {
+    for (const auto & cpu : stats) {
+      prev_cpu_stats_[cpu.name_] = cpu;
+    }
+  }
 
   updater_.setHardwareID(hostname_);
   updater_.add("CPU Temperature", this, &CPUMonitorBase::checkTemp);
@@ -119,98 +121,60 @@ void CPUMonitorBase::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & st
   // Remember start time to measure elapsed time
   const auto t_start = SystemMonitorUtility::startMeasurement();
 
-  if (!mpstat_exists_) {
-    stat.summary(DiagStatus::ERROR, "mpstat error");
-    stat.add(
-      "mpstat", "Command 'mpstat' not found, but can be installed with: sudo apt install sysstat");
+  // Get CPU time counters
+  std::vector<cpu_stat> stats;
+  if (!readCpuStats(&stats)) {
+    stat.summary(DiagStatus::ERROR, "stat error");
+    stat.add("stat", strerror(errno));
     return;
   }
 
-  // Get CPU Usage
-  bp::ipstream is_out;
-  bp::ipstream is_err;
-  bp::child c("mpstat -P ALL 1 1 -o JSON", bp::std_out > is_out, bp::std_err > is_err);
-  c.wait();
-
-  if (c.exit_code() != 0) {
-    std::ostringstream os;
-    is_err >> os.rdbuf();
-    stat.summary(DiagStatus::ERROR, "mpstat error");
-    stat.add("mpstat", os.str().c_str());
-    return;
-  }
-
-  std::string cpu_name;
-  float usr{0.0};
-  float nice{0.0};
-  float sys{0.0};
-  float idle{0.0};
-  float usage{0.0};
-  float total{0.0};
   int level = DiagStatus::OK;
   int whole_level = DiagStatus::OK;
 
-  pt::ptree pt;
-  try {
-    // Analyze JSON output
-    read_json(is_out, pt);
-
-    for (const pt::ptree::value_type & child1 : pt.get_child("sysstat.hosts")) {
-      const pt::ptree & hosts = child1.second;
-
-      for (const pt::ptree::value_type & child2 : hosts.get_child("statistics")) {
-        const pt::ptree & statistics = child2.second;
-
-        for (const pt::ptree::value_type & child3 : statistics.get_child("cpu-load")) {
-          const pt::ptree & cpu_load = child3.second;
-
-          if (boost::optional<std::string> v = cpu_load.get_optional<std::string>("cpu")) {
-            cpu_name = v.get();
-          }
-          if (boost::optional<float> v = cpu_load.get_optional<float>("usr")) {
-            usr = v.get();
-          }
-          if (boost::optional<float> v = cpu_load.get_optional<float>("nice")) {
-            nice = v.get();
-          }
-          if (boost::optional<float> v = cpu_load.get_optional<float>("sys")) {
-            sys = v.get();
-          }
-          if (boost::optional<float> v = cpu_load.get_optional<float>("idle")) {
-            idle = v.get();
-          }
-
-          total = usr + nice + sys;
-          usage = total * 1e-2;
-
-          level = DiagStatus::OK;
-          if (usage >= usage_error_) {
-            level = DiagStatus::ERROR;
-          } else if (usage >= usage_warn_) {
-            level = DiagStatus::WARN;
-          }
-
-          stat.add(fmt::format("CPU {}: status", cpu_name), load_dict_.at(level));
-          stat.addf(fmt::format("CPU {}: total", cpu_name), "%.2f%%", total);
-          stat.addf(fmt::format("CPU {}: usr", cpu_name), "%.2f%%", usr);
-          stat.addf(fmt::format("CPU {}: nice", cpu_name), "%.2f%%", nice);
-          stat.addf(fmt::format("CPU {}: sys", cpu_name), "%.2f%%", sys);
-          stat.addf(fmt::format("CPU {}: idle", cpu_name), "%.2f%%", idle);
-
-          if (usage_avg_ == true) {
-            if (cpu_name == "all") {
-              whole_level = level;
-            }
-          } else {
-            whole_level = std::max(whole_level, level);
-          }
-        }
+  for (const auto & curr : stats) {
+    // Counters since boot if there is no previous cycle, e.g. a CPU back online
+    cpu_stat prev;
+    const auto itr = prev_cpu_stats_.find(curr.name_);
+    if (itr != prev_cpu_stats_.end()) {
+      prev = itr->second;
+    }
+    prev_cpu_stats_[curr.name_] = curr;
+
+    const uint64_t total_time = curr.total() - prev.total();
+    const float scale = (total_time > 0) ? 1e2 / static_cast<float>(total_time) : 0.0;
+    // Exclude guest time from usr and nice as mpstat does
+    const uint64_t usr_time = (curr.user_ - curr.guest_) - (prev.user_ - prev.guest_);
+    const uint64_t nice_time = (curr.nice_ - curr.guest_nice_) - (prev.nice_ - prev.guest_nice_);
+    const float usr = scale * static_cast<float>(usr_time);
+    const float nice = scale * static_cast<float>(nice_time);
+    const float sys = scale * static_cast<float>(curr.system_ - prev.system_);
+    const float idle = scale * static_cast<float>(curr.idle_ - prev.idle_);
+
+    const float total = usr + nice + sys;
+    const float usage = total * 1e-2;
+
+    level = DiagStatus::OK;
+    if (usage >= usage_error_) {
+      level = DiagStatus::ERROR;
+    } else if (usage >= usage_warn_) {
+      level = DiagStatus::WARN;
+    }
+
+    stat.add(fmt::format("CPU {}: status", curr.name_), load_dict_.at(level));
+    stat.addf(fmt::format("CPU {}: total", curr.name_), "%.2f%%", total);
+    stat.addf(fmt::format("CPU {}: usr", curr.name_), "%.2f%%", usr);
+    stat.addf(fmt::format("CPU {}: nice", curr.name_), "%.2f%%", nice);
+    stat.addf(fmt::format("CPU {}: sys", curr.name_), "%.2f%%", sys);
+    stat.addf(fmt::format("CPU {}: idle", curr.name_), "%.2f%%", idle);
+
+    if (usage_avg_ == true) {
+      if (curr.name_ == "all") {
+        whole_level = level;
       }
+    } else {
+      whole_level = std::max(whole_level, level);
     }
-  } catch (const std::exception & e) {
-    stat.summary(DiagStatus::ERROR, "mpstat exception");
-    stat.add("mpstat", e.what());
-    return;
   }
 
   stat.summary(whole_level, load_dict_.at(whole_level));
@@ -296,6 +260,59 @@ void CPUMonitorBase::checkFrequency(diagnostic_updater::DiagnosticStatusWrapper
   SystemMonitorUtility::stopMeasurement(t_start, stat);
 }
 
+bool CPUMonitorBase::readCpuStats(std::vector<cpu_stat> * stats)
+{
+  if (stats == nullptr) {
+    return false;
+  }
+
+  stats->clear();
+
+  std::ifstream ifs("/proc/stat", std::ios::in);
+  if (!ifs) {
+    return false;
+  }
+
+  /*
+   Format of /proc/stat
+
+   cpu  user nice system idle iowait irq softirq steal guest guest_nice
+   cpu0 user nice system idle iowait irq softirq steal guest guest_nice
+   ...
+   intr ...
+  */
+  std::string line;
+  while (std::getline(ifs, line)) {
+    if (line.compare(0, 3, "cpu") != 0) {
+      break;
+    }
+
+    char name[32];
+    cpu_stat cpu;
+    // guest and guest_nice do not exist before Linux 2.6.24 and 2.6.33
+    const int ret = sscanf(
+      line.c_str(),
+      "%31s %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64
+      " %" SCNu64 " %" SCNu64 " %" SCNu64,
+      name, &cpu.user_, &cpu.nice_, &cpu.system_, &cpu.idle_, &cpu.iowait_, &cpu.irq_,
+      &cpu.softirq_, &cpu.steal_, &cpu.guest_, &cpu.guest_nice_);
+    if (ret < 5) {
+      errno = EINVAL;
+      return false;
+    }
+
+    // Name CPUs as mpstat did, all and index
+    cpu.name_ = (strcmp(name, "cpu") == 0) ? "all" : name + 3;
+    stats->push_back(cpu);
+  }
+
+  if (stats->empty()) {
+    errno = EINVAL;
+    return false;
+  }
+  return true;
+}
+
 void CPUMonitorBase::getTempNames()
 {
   RCLCPP_INFO(this->get_logger(), "CPUMonitorBase::getTempNames not implemented.");
@@ -23,20 +23,25 @@
 
 #include <hdd_reader/hdd_reader.hpp>
 
-#include <boost/algorithm/string.hpp>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
-#include <boost/process.hpp>
 #include <boost/serialization/vector.hpp>
 
 #include <fmt/format.h>
 
+#include <glob.h>
+#include <mntent.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
-namespace bp = boost::process;
-
 HDDMonitor::HDDMonitor(const rclcpp::NodeOptions & options)
 : Node("hdd_monitor", options),
   updater_(this),
@@ -211,48 +216,59 @@ void HDDMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
     return;
   }
 
+  // Get mounted ext4 filesystems
+  std::vector<std::pair<std::string, std::string>> mounts;
+  if (!getExt4Mounts(&mounts)) {
+    stat.summary(DiagStatus::ERROR, "mounts error");
+    stat.add("mounts", strerror(errno));
+    return;
+  }
+
   int hdd_index = 0;
   int whole_level = DiagStatus::OK;
   std::string error_str = "";
 
   for (auto itr = hdd_params_.begin(); itr != hdd_params_.end(); ++itr, ++hdd_index) {
-    // Get summary of disk space usage of ext4
-    bp::ipstream is_out;
-    bp::ipstream is_err;
-    // Invoke shell to use shell wildcard expansion
-    bp::child c(
-      "/bin/sh", "-c", fmt::format("df -Pht ext4 {}*", itr->first.c_str()), bp::std_out > is_out,
-      bp::std_err > is_err);
-    c.wait();
-
-    if (c.exit_code() != 0) {
-      std::ostringstream os;
-      is_err >> os.rdbuf();
-      error_str = "df error";
-      stat.add(fmt::format("HDD {}: status", hdd_index), "df error");
-      stat.add(fmt::format("HDD {}: name", hdd_index), itr->first.c_str());
-      stat.add(fmt::format("HDD {}: df", hdd_index), os.str().c_str());
-      continue;
-    }
+    // Get device numbers of the disk and its partitions, same as shell wildcard expansion
+    std::set<dev_t> devices;
+    getBlockDevices(fmt::format("{}*", itr->first), &devices);
 
-    int level = DiagStatus::OK;
-    std::string line;
-    int index = 0;
-    std::vector<std::string> list;
-    float usage;
+    bool is_found = false;
+    std::set<dev_t> reported;
 
-    while (std::getline(is_out, line) && !line.empty()) {
-      // Skip header
-      if (index <= 0) {
-        ++index;
+    for (const auto & mount : mounts) {
+      // Get summary of disk space usage of the filesystem mounted from the disk
+      struct stat mount_stat;
+      if (::stat(mount.second.c_str(), &mount_stat) != 0) {
+        continue;
+      }
+      if (devices.count(mount_stat.st_dev) == 0 || reported.count(mount_stat.st_dev) != 0) {
+        continue;
+      }
+      reported.insert(mount_stat.st_dev);
+      is_found = true;
+
+      struct statvfs buf;
+      if (statvfs(mount.second.c_str(), &buf) != 0) {
+        error_str = "statvfs error";
+        stat.add(fmt::format("HDD {}: status", hdd_index), "statvfs error");
+        stat.add(fmt::format("HDD {}: name", hdd_index), itr->first.c_str());
+        stat.add(fmt::format("HDD {}: statvfs", hdd_index), strerror(errno));
         continue;
       }
 
-      boost::split(list, line, boost::is_space(), boost::token_compress_on);
-
-      usage = std::atof(boost::trim_copy_if(list[4], boost::is_any_of("%")).c_str()) * 1e-2;
-
-      level = DiagStatus::OK;
+      // Calculate the values in the same way as `df -P`
+      const uint64_t size = static_cast<uint64_t>(buf.f_blocks) * buf.f_frsize;
+      const uint64_t used = static_cast<uint64_t>(buf.f_blocks - buf.f_bfree) * buf.f_frsize;
+      const uint64_t avail = static_cast<uint64_t>(buf.f_bavail) * buf.f_frsize;
+      const uint64_t nonroot_total = used + avail;
+      // Percentage is rounded up
+      const int use = (nonroot_total > 0)
+                        ? static_cast<int>((used * 100 + nonroot_total - 1) / nonroot_total)
+                        : 0;
+      const float usage = use * 1e-2;
+
+      int level = DiagStatus::OK;
       if (usage >= itr->second.usage_error_) {
         level = DiagStatus::ERROR;
       } else if (usage >= itr->second.usage_warn_) {
@@ -260,15 +276,20 @@ void HDDMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
       }
 
       stat.add(fmt::format("HDD {}: status", hdd_index), usage_dict_.at(level));
-      stat.add(fmt::format("HDD {}: filesystem", hdd_index), list[0].c_str());
-      stat.add(fmt::format("HDD {}: size", hdd_index), list[1].c_str());
-      stat.add(fmt::format("HDD {}: used", hdd_index), list[2].c_str());
-      stat.add(fmt::format("HDD {}: avail", hdd_index), list[3].c_str());
-      stat.add(fmt::format("HDD {}: use", hdd_index), list[4].c_str());
-      stat.add(fmt::format("HDD {}: mounted on", hdd_index), list[5].c_str());
+      stat.add(fmt::format("HDD {}: filesystem", hdd_index), mount.first.c_str());
+      stat.add(fmt::format("HDD {}: size", hdd_index), toHumanReadable(size));
+      stat.add(fmt::format("HDD {}: used", hdd_index), toHumanReadable(used));
+      stat.add(fmt::format("HDD {}: avail", hdd_index), toHumanReadable(avail));
+      stat.add(fmt::format("HDD {}: use", hdd_index), fmt::format("{}%", use));
+      stat.add(fmt::format("HDD {}: mounted on", hdd_index), mount.second.c_str());
 
       whole_level = std::max(whole_level, level);
-      ++index;
+    }
+
+    if (!is_found) {
+      error_str = "filesystem not found";
+      stat.add(fmt::format("HDD {}: status", hdd_index), "filesystem not found");
+      stat.add(fmt::format("HDD {}: name", hdd_index), itr->first.c_str());
     }
   }
 
@@ -282,6 +303,72 @@ void HDDMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
   SystemMonitorUtility::stopMeasurement(t_start, stat);
 }
 
+bool HDDMonitor::getExt4Mounts(std::vector<std::pair<std::string, std::string>> * mounts)
+{
+  if (mounts == nullptr) {
+    return false;
+  }
+
+  mounts->clear();
+
+  FILE * fp = setmntent("/proc/mounts", "r");
+  if (fp == nullptr) {
+    return false;
+  }
+
+  struct mntent ent;
+  char buf[4096];
+  while (getmntent_r(fp, &ent, buf, sizeof(buf)) != nullptr) {
+    if (strcmp(ent.mnt_type, "ext4") == 0) {
+      mounts->emplace_back(ent.mnt_fsname, ent.mnt_dir);
+    }
+  }
+
+  endmntent(fp);
+  return true;
+}
+
+void HDDMonitor::getBlockDevices(const std::string & pattern, std::set<dev_t> * devices)
+{
+  if (devices == nullptr) {
+    return;
+  }
+
+  devices->clear();
+
+  glob_t result;
+  if (glob(pattern.c_str(), 0, nullptr, &result) != 0) {
+    globfree(&result);
+    return;
+  }
+
+  for (size_t i = 0; i < result.gl_pathc; ++i) {
+    struct stat device_stat;
+    if (stat(result.gl_pathv[i], &device_stat) == 0 && S_ISBLK(device_stat.st_mode)) {
+      devices->insert(device_stat.st_rdev);
+    }
+  }
+
+  globfree(&result);
+}
+
+std::string HDDMonitor::toHumanReadable(const uint64_t size_in_bytes)
+{
+  const char * units[] = {"", "K", "M", "G", "T", "P"};
+  int count = 0;
+  double size = static_cast<double>(size_in_bytes);
+
+  while (size >= 1024 && count < 5) {
+    size /= 1024;
+    ++count;
+  }
+  // Round up as df does
+  if (size < 10 && count > 0) {
+    return fmt::format("{:.1f}{}", std::ceil(size * 10) / 10, units[count]);
+  }
+  return fmt::format("{:.0f}{}", std::ceil(size), units[count]);
+}
+
 void HDDMonitor::getHDDParams()
 {
   const auto num_disks = this->declare_parameter("num_disks", 0);
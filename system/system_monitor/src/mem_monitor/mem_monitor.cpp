@@ -21,14 +21,13 @@
 
 #include "system_monitor/system_monitor_utility.hpp"
 
-#include <boost/process.hpp>
-
 #include <fmt/format.h>
 
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
+#include <map>
 #include <string>
-#include <vector>
-
-namespace bp = boost::process;
 
 MemMonitor::MemMonitor(const rclcpp::NodeOptions & options)
 : Node("mem_monitor", options),
@@ -49,81 +48,111 @@ void MemMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
   const auto t_start = SystemMonitorUtility::startMeasurement();
 
   // Get total amount of free and used memory
-  bp::ipstream is_out;
-  bp::ipstream is_err;
-  bp::child c("free -tb", bp::std_out > is_out, bp::std_err > is_err);
-  c.wait();
-  if (c.exit_code() != 0) {
-    std::ostringstream os;
-    is_err >> os.rdbuf();
-    stat.summary(DiagStatus::ERROR, "free error");
-    stat.add("free", os.str().c_str());
+  std::map<std::string, uint64_t> meminfo;
+  if (!readMemInfo(&meminfo)) {
+    stat.summary(DiagStatus::ERROR, "meminfo error");
+    stat.add("meminfo", strerror(errno));
+    return;
+  }
+
+  // Calculate the values in the same way as `free -tb`
+  const uint64_t mem_total = meminfo["MemTotal"];
+  if (mem_total == 0) {
+    stat.summary(DiagStatus::ERROR, "meminfo error");
+    stat.add("meminfo", "MemTotal not found");
     return;
   }
 
+  const uint64_t mem_free = meminfo["MemFree"];
+  const uint64_t mem_shared = meminfo["Shmem"];
+  const uint64_t mem_buff_cache = meminfo["Buffers"] + meminfo["Cached"] + meminfo["SReclaimable"];
+  const uint64_t mem_available = meminfo["MemAvailable"];
+  const uint64_t mem_used = (mem_total > mem_free + mem_buff_cache)
+                              ? mem_total - mem_free - mem_buff_cache
+                              : mem_total - mem_free;
+  const uint64_t swap_total = meminfo["SwapTotal"];
+  const uint64_t swap_free = meminfo["SwapFree"];
+  const uint64_t swap_used = swap_total - swap_free;
+
   int level = DiagStatus::OK;
-  std::string line;
-  int index = 0;
-  std::vector<std::string> list;
-  float usage;
 
-  /*
-   Output example of `free -tb`
+  // available divided by total is available memory including calculation for buff/cache,
+  // so the subtraction of this from 1 gives real usage.
+  const float usage = 1.0f - static_cast<float>(mem_available) / static_cast<float>(mem_total);
 
-             list[0]     list[1]     list[2]     list[3]     list[4]     list[5]     list[6]
-   index 0 |               total        used        free      shared  buff/cache   available
-   index 1 | Mem:       32809744    12554780    13090376      292840     7164588    19622092
-   index 2 | Swap:      33554428     1767680    31786748
-   index 3 | Total:     66364172    14322460    44877124
-  */
-  while (std::getline(is_out, line) && !line.empty()) {
-    // Skip header
-    if (index <= 0) {
-      ++index;
-      continue;
-    }
+  if (usage >= usage_error_) {
+    level = DiagStatus::ERROR;
+  } else if (usage >= usage_warn_) {
+    level = DiagStatus::WARN;
+  }
+
+  // Physical memory
+  stat.addf("Mem: usage", "%.2f%%", usage * 1e+2);
+  stat.add("Mem: total", toHumanReadable(mem_total));
+  stat.add("Mem: used", toHumanReadable(mem_used));
+  stat.add("Mem: free", toHumanReadable(mem_free));
+  stat.add("Mem: shared", toHumanReadable(mem_shared));
+  stat.add("Mem: buff/cache", toHumanReadable(mem_buff_cache));
+  stat.add("Mem: available", toHumanReadable(mem_available));
+
+  // Swap
+  stat.add("Swap: total", toHumanReadable(swap_total));
+  stat.add("Swap: used", toHumanReadable(swap_used));
+  stat.add("Swap: free", toHumanReadable(swap_free));
+
+  // Total of physical memory and swap
+  stat.add("Total: total", toHumanReadable(mem_total + swap_total));
+  stat.add("Total: used", toHumanReadable(mem_used + swap_used));
+  stat.add("Total: free", toHumanReadable(mem_free + swap_free));
+
+  stat.summary(level, usage_dict_.at(level));
 
-    boost::split(list, line, boost::is_space(), boost::token_compress_on);
+  // Measure elapsed time since start time and report
+  SystemMonitorUtility::stopMeasurement(t_start, stat);
+}
 
-    // Physical memory
-    if (index == 1) {
-      // available divided by total is available memory including calculation for buff/cache,
-      // so the subtraction of this from 1 gives real usage.
-      usage = 1.0f - std::atof(list[6].c_str()) / std::atof(list[1].c_str());
+bool MemMonitor::readMemInfo(std::map<std::string, uint64_t> * meminfo)
+{
+  if (meminfo == nullptr) {
+    return false;
+  }
 
-      if (usage >= usage_error_) {
-        level = DiagStatus::ERROR;
-      } else if (usage >= usage_warn_) {
-        level = DiagStatus::WARN;
-      }
+  meminfo->clear();
 
-      stat.addf(fmt::format("{} usage", list[0]), "%.2f%%", usage * 1e+2);
-    }
+  std::ifstream ifs("/proc/meminfo", std::ios::in);
+  if (!ifs) {
+    return false;
+  }
 
-    stat.add(fmt::format("{} total", list[0]), toHumanReadable(list[1]));
-    stat.add(fmt::format("{} used", list[0]), toHumanReadable(list[2]));
-    stat.add(fmt::format("{} free", list[0]), toHumanReadable(list[3]));
+  /*
+   Format of /proc/meminfo
 
-    // Add an additional information for physical memory
-    if (index == 1) {
-      stat.add(fmt::format("{} shared", list[0]), toHumanReadable(list[4]));
-      stat.add(fmt::format("{} buff/cache", list[0]), toHumanReadable(list[5]));
-      stat.add(fmt::format("{} available", list[0]), toHumanReadable(list[6]));
+   MemTotal:       32809744 kB
+   MemFree:        13090376 kB
+   ...
+   HugePages_Total:       0
+  */
+  std::string line;
+  while (std::getline(ifs, line)) {
+    char name[64];
+    uint64_t value;
+    char unit[8] = "";
+    const int ret = sscanf(line.c_str(), "%63[^:]: %" SCNu64 " %7s", name, &value, unit);
+    if (ret < 2) {
+      continue;
     }
-    ++index;
+    // Values with unit are in kibibytes
+    (*meminfo)[name] = (strcmp(unit, "kB") == 0) ? value * 1024 : value;
   }
 
-  stat.summary(level, usage_dict_.at(level));
-
-  // Measure elapsed time since start time and report
-  SystemMonitorUtility::stopMeasurement(t_start, stat);
+  return true;
 }
 
-std::string MemMonitor::toHumanReadable(const std::string & str)
+std::string MemMonitor::toHumanReadable(const uint64_t size_in_bytes)
 {
   const char * units[] = {"B", "K", "M", "G", "T"};
   int count = 0;
-  double size = std::atol(str.c_str());
+  double size = static_cast<double>(size_in_bytes);
 
   while (size > 1024) {
     size /= 1024;
@@ -0,0 +1,272 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file node_monitor.cpp
+ * @brief Node monitor class
+ */
+
+#include "system_monitor/node_monitor/node_monitor.hpp"
+
+#include "system_monitor/system_monitor_utility.hpp"
+
+#include <fmt/format.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+NodeMonitor::NodeMonitor(const rclcpp::NodeOptions & options)
+: Node("node_monitor", options),
+  updater_(this),
+  window_size_(declare_parameter<int>("window_size", 1000)),
+  node_timeout_(declare_parameter<double>("node_timeout", 5.0)),
+  cpu_usage_warn_(declare_parameter<float>("cpu_usage_warn", 0.90)),
+  cpu_usage_error_(declare_parameter<float>("cpu_usage_error", 1.00)),
+  callback_time_warn_(declare_parameter<double>("callback_time_warn", 100.0)),
+  callback_time_error_(declare_parameter<double>("callback_time_error", 200.0)),
+  clock_ticks_(sysconf(_SC_CLK_TCK)),
+  page_size_kb_(sysconf(_SC_PAGESIZE) / 1024),
+  prev_time_(std::chrono::steady_clock::now())
+{
+  using std::placeholders::_1;
+
+  gethostname(hostname_, sizeof(hostname_));
+
+  sub_callback_timing_ = create_subscription<diagnostic_msgs::msg::DiagnosticStatus>(
+    "/system/callback_timing", rclcpp::QoS(100),
+    std::bind(&NodeMonitor::onCallbackTiming, this, _1));
+
+  updater_.setHardwareID(hostname_);
+  updater_.add("Node CPU Usage", this, &NodeMonitor::checkUsage);
+  updater_.add("Node Callback Time", this, &NodeMonitor::checkCallbackTime);
+}
+
+void NodeMonitor::update() { updater_.force_update(); }
+
+void NodeMonitor::onCallbackTiming(
+  const diagnostic_msgs::msg::DiagnosticStatus::ConstSharedPtr msg)
+{
+  auto & node = nodes_[msg->name];
+  node.stamp_ = std::chrono::steady_clock::now();
+
+  for (const auto & value : msg->values) {
+    std::istringstream iss(value.value);
+
+    if (value.key == "pid") {
+      iss >> node.pid_;
+    } else if (value.key == "tids") {
+      node.tids_.clear();
+      pid_t tid;
+      while (iss >> tid) {
+        node.tids_.push_back(tid);
+      }
+    } else {
+      // Keep the latest execution times of the callback
+      auto & durations = node.durations_[value.key];
+      double duration;
+      while (iss >> duration) {
+        durations.push_back(duration);
+      }
+      while (durations.size() > static_cast<size_t>(window_size_)) {
+        durations.pop_front();
+      }
+    }
+  }
+}
+
+void NodeMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  // Remember start time to measure elapsed time
+  const auto t_start = SystemMonitorUtility::startMeasurement();
+
+  removeStaleNodes();
+
+  const auto now = std::chrono::steady_clock::now();
+  const double elapsed_ticks =
+    std::chrono::duration<double>(now - prev_time_).count() * clock_ticks_;
+  prev_time_ = now;
+
+  std::map<std::pair<pid_t, pid_t>, uint64_t> curr_thread_times;
+  int whole_level = DiagStatus::OK;
+
+  for (const auto & node : nodes_) {
+    // Sum of CPU time of the threads which ran the callbacks of the node since the previous cycle
+    uint64_t time = 0;
+    for (const auto tid : node.second.tids_) {
+      uint64_t thread_time;
+      if (!readThreadTime(node.second.pid_, tid, &thread_time)) {
+        continue;
+      }
+      const auto key = std::make_pair(node.second.pid_, tid);
+      const auto itr = prev_thread_times_.find(key);
+      if (itr != prev_thread_times_.end() && itr->second <= thread_time) {
+        time += thread_time - itr->second;
+      }
+      curr_thread_times[key] = thread_time;
+    }
+    const float usage = (elapsed_ticks > 0) ? static_cast<float>(time / elapsed_ticks) : 0.0;
+
+    int level = DiagStatus::OK;
+    if (usage >= cpu_usage_error_) {
+      level = DiagStatus::ERROR;
+    } else if (usage >= cpu_usage_warn_) {
+      level = DiagStatus::WARN;
+    }
+
+    stat.add(fmt::format("{}: status", node.first), usage_dict_.at(level));
+    stat.add(fmt::format("{}: pid", node.first), node.second.pid_);
+    stat.add(fmt::format("{}: threads", node.first), node.second.tids_.size());
+    stat.addf(fmt::format("{}: cpu", node.first), "%.2f%%", usage * 1e2);
+
+    uint64_t rss;
+    if (readResidentSize(node.second.pid_, &rss)) {
+      stat.add(fmt::format("{}: process rss", node.first), fmt::format("{} KiB", rss));
+    }
+
+    whole_level = std::max(whole_level, level);
+  }
+
+  // Threads of removed nodes are dropped as well
+  prev_thread_times_.swap(curr_thread_times);
+
+  stat.summary(whole_level, usage_dict_.at(whole_level));
+
+  // Measure elapsed time since start time and report
+  SystemMonitorUtility::stopMeasurement(t_start, stat);
+}
+
+void NodeMonitor::checkCallbackTime(diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  // Remember start time to measure elapsed time
+  const auto t_start = SystemMonitorUtility::startMeasurement();
+
+  removeStaleNodes();
+
+  int whole_level = DiagStatus::OK;
+  std::vector<double> sorted;
+
+  for (const auto & node : nodes_) {
+    for (const auto & callback : node.second.durations_) {
+      if (callback.second.empty()) {
+        continue;
+      }
+
+      sorted.assign(callback.second.begin(), callback.second.end());
+      std::sort(sorted.begin(), sorted.end());
+      // Nearest-rank percentile
+      const auto percentile = [&sorted](const double p) {
+        const size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+        return sorted.at(std::max<size_t>(rank, 1) - 1);
+      };
+      const double p99 = percentile(0.99);
+
+      int level = DiagStatus::OK;
+      if (p99 >= callback_time_error_) {
+        level = DiagStatus::ERROR;
+      } else if (p99 >= callback_time_warn_) {
+        level = DiagStatus::WARN;
+      }
+
+      const auto name = fmt::format("{}/{}", node.first, callback.first);
+      stat.add(fmt::format("{}: status", name), time_dict_.at(level));
+      stat.add(fmt::format("{}: count", name), sorted.size());
+      stat.addf(fmt::format("{}: p50", name), "%.3f ms", percentile(0.50));
+      stat.addf(fmt::format("{}: p90", name), "%.3f ms", percentile(0.90));
+      stat.addf(fmt::format("{}: p99", name), "%.3f ms", p99);
+      stat.addf(fmt::format("{}: max", name), "%.3f ms", sorted.back());
+
+      whole_level = std::max(whole_level, level);
+    }
+  }
+
+  stat.summary(whole_level, time_dict_.at(whole_level));
+
+  // Measure elapsed time since start time and report
+  SystemMonitorUtility::stopMeasurement(t_start, stat);
+}
+
+void NodeMonitor::removeStaleNodes()
+{
+  const auto now = std::chrono::steady_clock::now();
+  for (auto itr = nodes_.begin(); itr != nodes_.end();) {
+    if (std::chrono::duration<double>(now - itr->second.stamp_).count() > node_timeout_) {
+      itr = nodes_.erase(itr);
+    } else {
+      ++itr;
+    }
+  }
+}
+
+bool NodeMonitor::readThreadTime(pid_t pid, pid_t tid, uint64_t * time)
+{
+  if (time == nullptr) {
+    return false;
+  }
+
+  std::ifstream ifs(fmt::format("/proc/{}/task/{}/stat", pid, tid), std::ios::in);
+  std::string line;
+  if (!ifs || !std::getline(ifs, line)) {
+    return false;
+  }
+
+  // comm may contain spaces and parentheses, see proc(5) for the fields after it
+  const auto comm_end = line.rfind(')');
+  if (comm_end == std::string::npos) {
+    return false;
+  }
+
+  uint64_t utime;
+  uint64_t stime;
+  const int ret = sscanf(
+    line.c_str() + comm_end + 1,
+    " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %" SCNu64 " %" SCNu64, &utime, &stime);
+  if (ret != 2) {
+    return false;
+  }
+
+  *time = utime + stime;
+  return true;
+}
+
+bool NodeMonitor::readResidentSize(pid_t pid, uint64_t * rss)
+{
+  if (rss == nullptr) {
+    return false;
+  }
+
+  // size resident shared text lib data dt, in pages
+  std::ifstream ifs(fmt::format("/proc/{}/statm", pid), std::ios::in);
+  uint64_t size;
+  uint64_t resident;
+  if (!ifs || !(ifs >> size >> resident)) {
+    return false;
+  }
+
+  *rss = resident * page_size_kb_;
+  return true;
+}
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(NodeMonitor)
@@ -23,15 +23,28 @@
 
 #include <fmt/format.h>
 
+#include <dirent.h>
+#include <pwd.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <memory>
-#include <regex>
+#include <numeric>
 #include <string>
 #include <vector>
 
 ProcessMonitor::ProcessMonitor(const rclcpp::NodeOptions & options)
 : Node("process_monitor", options),
   updater_(this),
-  num_of_procs_(declare_parameter<int>("num_of_procs", 5))
+  num_of_procs_(declare_parameter<int>("num_of_procs", 5)),
+  clock_ticks_(sysconf(_SC_CLK_TCK)),
+  page_size_kb_(sysconf(_SC_PAGESIZE) / 1024),
+  mem_total_kb_(static_cast<uint64_t>(sysconf(_SC_PHYS_PAGES)) * page_size_kb_)
 {
   int index;
 
@@ -50,6 +63,10 @@ ProcessMonitor::ProcessMonitor(const rclcpp::NodeOptions & options)
     memory_tasks_.push_back(task);
     updater_.add(*task);
   }
+
+  // Take the first sample so that the first cycle already reports CPU usage as a delta
+  std::vector<ProcessInfo> procs;
+  readProcesses(&procs);
 }
 
 void ProcessMonitor::update() { updater_.force_update(); }
@@ -59,243 +76,284 @@ void ProcessMonitor::monitorProcesses(diagnostic_updater::DiagnosticStatusWrappe
   // Remember start time to measure elapsed time
   const auto t_start = SystemMonitorUtility::startMeasurement();
 
-  bp::ipstream is_err;
-  bp::ipstream is_out;
-  std::ostringstream os;
-
   // Get processes
-  bp::child c("top -bn1 -o %CPU -w 128", bp::std_out > is_out, bp::std_err > is_err);
-  c.wait();
-  if (c.exit_code() != 0) {
-    is_err >> os.rdbuf();
-    stat.summary(DiagStatus::ERROR, "top error");
-    stat.add("top", os.str().c_str());
-    setErrorContent(&load_tasks_, "top error", "top", os.str().c_str());
-    setErrorContent(&memory_tasks_, "top error", "top", os.str().c_str());
+  std::vector<ProcessInfo> procs;
+  if (!readProcesses(&procs)) {
+    const std::string content = strerror(errno);
+    stat.summary(DiagStatus::ERROR, "proc error");
+    stat.add("proc", content);
+    setErrorContent(&load_tasks_, "proc error", "proc", content);
+    setErrorContent(&memory_tasks_, "proc error", "proc", content);
     return;
   }
 
-  is_out >> os.rdbuf();
-  std::string str = os.str();
-
   // Get task summary
-  getTasksSummary(stat, str);
-  // Remove header
-  removeHeader(stat, str);
+  getTasksSummary(stat, procs);
 
   // Get high load processes
-  getHighLoadProcesses(str);
+  getHighLoadProcesses(procs);
 
   // Get high memory processes
-  getHighMemoryProcesses(str);
+  getHighMemoryProcesses(procs);
 
   // Measure elapsed time since start time and report
   SystemMonitorUtility::stopMeasurement(t_start, stat);
 }
 
-void ProcessMonitor::getTasksSummary(
-  diagnostic_updater::DiagnosticStatusWrapper & stat, const std::string & output)
+bool ProcessMonitor::readProcesses(std::vector<ProcessInfo> * procs)
 {
-  bp::pipe p;
-  std::string line;
+  if (procs == nullptr) {
+    return false;
+  }
 
-  // Echo output for grep
-  {
-    bp::ipstream is_out;
-    bp::ipstream is_err;
-    bp::child c(fmt::format("echo {}", output), bp::std_out > p, bp::std_err > is_err);
-    c.wait();
-    if (c.exit_code() != 0) {
-      std::ostringstream os;
-      is_err >> os.rdbuf();
-      stat.summary(DiagStatus::ERROR, "echo error");
-      stat.add("echo", os.str().c_str());
-      return;
-    }
+  procs->clear();
+
+  DIR * dir = opendir("/proc");
+  if (dir == nullptr) {
+    return false;
   }
-  // Find matching pattern of summary
-  {
-    bp::ipstream is_out;
-    bp::child c("grep Tasks:", bp::std_out > is_out, bp::std_in < p);
-    c.wait();
-    // no matching line
-    if (c.exit_code() != 0) {
-      stat.summary(DiagStatus::ERROR, "matching pattern not found");
-      stat.add("name", "Tasks:");
-      return;
+
+  const auto now = std::chrono::steady_clock::now();
+  const double elapsed = std::chrono::duration<double>(now - prev_time_).count();
+  const double elapsed_ticks = elapsed * clock_ticks_;
+
+  std::unordered_map<int, std::pair<uint64_t, uint64_t>> curr_times;
+
+  struct dirent * ent;
+  while ((ent = readdir(dir)) != nullptr) {
+    // Only directories named with a process id
+    char * end;
+    const int64_t pid = std::strtol(ent->d_name, &end, 10);
+    if (*end != '\0' || pid <= 0) {
+      continue;
     }
 
-    std::getline(is_out, line);
-    std::cmatch match;
-    const std::regex filter(
-      "^Tasks: (\\d+) total,\\s+(\\d+) running,\\s+(\\d+) sleeping,\\s+(\\d+) stopped,\\s+(\\d+) "
-      "zombie");
-
-    if (std::regex_match(line.c_str(), match, filter)) {
-      stat.add("total", match[1].str());
-      stat.add("running", match[2].str());
-      stat.add("sleeping", match[3].str());
-      stat.add("stopped", match[4].str());
-      stat.add("zombie", match[5].str());
-      stat.summary(DiagStatus::OK, "OK");
-    } else {
-      stat.summary(DiagStatus::ERROR, "invalid format");
+    ProcessInfo proc;
+    // The process may have exited since readdir
+    if (!readProcess(static_cast<int>(pid), &proc)) {
+      continue;
+    }
+
+    // CPU usage since the previous cycle, or since the process started in this cycle
+    uint64_t prev_total_time = 0;
+    const auto itr = prev_times_.find(proc.pid_);
+    if (itr != prev_times_.end() && itr->second.first == proc.start_time_) {
+      prev_total_time = itr->second.second;
+    }
+    if (elapsed_ticks > 0) {
+      proc.cpu_ = static_cast<float>((proc.total_time_ - prev_total_time) * 1e2 / elapsed_ticks);
+    }
+    if (mem_total_kb_ > 0) {
+      proc.mem_ = static_cast<float>(proc.res_ * 1e2 / mem_total_kb_);
     }
+
+    curr_times[proc.pid_] = std::make_pair(proc.start_time_, proc.total_time_);
+    procs->push_back(proc);
   }
+
+  closedir(dir);
+
+  prev_times_.swap(curr_times);
+  prev_time_ = now;
+  return true;
 }
 
-void ProcessMonitor::removeHeader(
-  diagnostic_updater::DiagnosticStatusWrapper & stat, std::string & output)
+bool ProcessMonitor::readProcess(int pid, ProcessInfo * proc)
 {
-  bp::pipe p1;
-  bp::pipe p2;
-  std::ostringstream os;
-
-  // Echo output for sed
-  {
-    bp::ipstream is_err;
-    bp::child c(fmt::format("echo {}", output), bp::std_out > p1, bp::std_err > is_err);
-    c.wait();
-    if (c.exit_code() != 0) {
-      is_err >> os.rdbuf();
-      stat.summary(DiagStatus::ERROR, "echo error");
-      stat.add("echo", os.str().c_str());
-      return;
-    }
+  if (proc == nullptr) {
+    return false;
   }
-  // Remove %Cpu section
-  {
-    bp::ipstream is_err;
-    bp::child c("sed \"/^%Cpu/d\"", bp::std_out > p2, bp::std_err > is_err, bp::std_in < p1);
-    c.wait();
-    // no matching line
-    if (c.exit_code() != 0) {
-      stat.summary(DiagStatus::ERROR, "sed error");
-      stat.add("sed", "Failed to remove header");
-      return;
-    }
+
+  const std::string proc_dir = fmt::format("/proc/{}", pid);
+
+  // Owner of the directory is the real user id of the process
+  struct stat dir_stat;
+  if (stat(proc_dir.c_str(), &dir_stat) != 0) {
+    return false;
   }
-  // Remove header
-  {
-    bp::ipstream is_out;
-    bp::ipstream is_err;
-    bp::child c("sed \"1,6d\"", bp::std_out > is_out, bp::std_err > is_err, bp::std_in < p2);
-    c.wait();
-    // no matching line
-    if (c.exit_code() != 0) {
-      stat.summary(DiagStatus::ERROR, "sed error");
-      stat.add("sed", "Failed to remove header");
-      return;
-    }
-    // overwrite
-    is_out >> os.rdbuf();
-    output = os.str();
+
+  std::ifstream ifs_stat(proc_dir + "/stat", std::ios::in);
+  std::string line;
+  if (!ifs_stat || !std::getline(ifs_stat, line)) {
+    return false;
+  }
+
+  /*
+   Format of /proc/<pid>/stat, see proc(5)
+
+   pid (comm) state ppid pgrp session tty_nr tpgid flags minflt cminflt majflt cmajflt
+   utime stime cutime cstime priority nice num_threads itrealvalue starttime vsize rss ...
+  */
+  // comm may contain spaces and parentheses
+  const auto comm_begin = line.find('(');
+  const auto comm_end = line.rfind(')');
+  if (comm_begin == std::string::npos || comm_end == std::string::npos || comm_end < comm_begin) {
+    return false;
+  }
+
+  char state;
+  uint64_t utime;
+  uint64_t stime;
+  int64_t priority;
+  int64_t nice;
+  uint64_t start_time;
+  uint64_t vsize;
+  const int ret = sscanf(
+    line.c_str() + comm_end + 1,
+    " %c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %" SCNu64 " %" SCNu64 " %*d %*d %" SCNd64
+    " %" SCNd64 " %*d %*d %" SCNu64 " %" SCNu64,
+    &state, &utime, &stime, &priority, &nice, &start_time, &vsize);
+  if (ret != 7) {
+    return false;
   }
+
+  // size resident shared text lib data dt, in pages
+  std::ifstream ifs_statm(proc_dir + "/statm", std::ios::in);
+  uint64_t size;
+  uint64_t resident;
+  uint64_t shared;
+  if (!ifs_statm || !(ifs_statm >> size >> resident >> shared)) {
+    return false;
+  }
+
+  proc->pid_ = pid;
+  proc->uid_ = dir_stat.st_uid;
+  proc->state_ = state;
+  proc->priority_ = priority;
+  proc->nice_ = nice;
+  proc->virt_ = vsize / 1024;
+  proc->res_ = resident * page_size_kb_;
+  proc->shr_ = shared * page_size_kb_;
+  proc->start_time_ = start_time;
+  proc->total_time_ = utime + stime;
+  proc->command_ = line.substr(comm_begin + 1, comm_end - comm_begin - 1);
+  return true;
 }
 
-void ProcessMonitor::getHighLoadProcesses(const std::string & output)
+void ProcessMonitor::getTasksSummary(
+  diagnostic_updater::DiagnosticStatusWrapper & stat, const std::vector<ProcessInfo> & procs)
 {
-  bp::pipe p;
-  std::ostringstream os;
-
-  // Echo output for sed
-  bp::ipstream is_out;
-  bp::ipstream is_err;
-  bp::child c(fmt::format("echo {}", output), bp::std_out > p, bp::std_err > is_err);
-  c.wait();
-  if (c.exit_code() != 0) {
-    is_err >> os.rdbuf();
-    setErrorContent(&load_tasks_, "echo error", "echo", os.str().c_str());
-    return;
+  int running = 0;
+  int sleeping = 0;
+  int stopped = 0;
+  int zombie = 0;
+
+  // Count states in the same way as `top`
+  for (const auto & proc : procs) {
+    switch (proc.state_) {
+      case 'R':
+        ++running;
+        break;
+      case 'S':
+      case 'D':
+      case 'I':
+        ++sleeping;
+        break;
+      case 'T':
+      case 't':
+        ++stopped;
+        break;
+      case 'Z':
+        ++zombie;
+        break;
+      default:
+        break;
+    }
   }
 
+  stat.add("total", std::to_string(procs.size()));
+  stat.add("running", std::to_string(running));
+  stat.add("sleeping", std::to_string(sleeping));
+  stat.add("stopped", std::to_string(stopped));
+  stat.add("zombie", std::to_string(zombie));
+  stat.summary(DiagStatus::OK, "OK");
+}
+
+void ProcessMonitor::getHighLoadProcesses(const std::vector<ProcessInfo> & procs)
+{
+  // Sort by CPU usage
+  std::vector<size_t> order(procs.size());
+  std::iota(order.begin(), order.end(), 0);
+  const size_t num = std::min(order.size(), static_cast<size_t>(num_of_procs_));
+  std::partial_sort(
+    order.begin(), order.begin() + num, order.end(),
+    [&procs](const size_t a, const size_t b) { return procs.at(a).cpu_ > procs.at(b).cpu_; });
+  order.resize(num);
+
   // Get top-rated
-  getTopratedProcesses(&load_tasks_, &p);
+  getTopratedProcesses(&load_tasks_, procs, order);
 }
 
-void ProcessMonitor::getHighMemoryProcesses(const std::string & output)
+void ProcessMonitor::getHighMemoryProcesses(const std::vector<ProcessInfo> & procs)
 {
-  bp::pipe p1;
-  bp::pipe p2;
-  std::ostringstream os;
-
-  // Echo output for sed
-  {
-    bp::ipstream is_out;
-    bp::ipstream is_err;
-    bp::child c(fmt::format("echo {}", output), bp::std_out > p1, bp::std_err > is_err);
-    c.wait();
-    if (c.exit_code() != 0) {
-      is_err >> os.rdbuf();
-      setErrorContent(&memory_tasks_, "echo error", "echo", os.str().c_str());
-      return;
-    }
-  }
   // Sort by memory usage
-  {
-    bp::ipstream is_out;
-    bp::ipstream is_err;
-    bp::child c("sort -r -k 10", bp::std_out > p2, bp::std_err > is_err, bp::std_in < p1);
-    c.wait();
-    if (c.exit_code() != 0) {
-      is_err >> os.rdbuf();
-      setErrorContent(&memory_tasks_, "sort error", "sort", os.str().c_str());
-      return;
-    }
-  }
+  std::vector<size_t> order(procs.size());
+  std::iota(order.begin(), order.end(), 0);
+  const size_t num = std::min(order.size(), static_cast<size_t>(num_of_procs_));
+  std::partial_sort(
+    order.begin(), order.begin() + num, order.end(),
+    [&procs](const size_t a, const size_t b) { return procs.at(a).res_ > procs.at(b).res_; });
+  order.resize(num);
 
   // Get top-rated
-  getTopratedProcesses(&memory_tasks_, &p2);
+  getTopratedProcesses(&memory_tasks_, procs, order);
 }
 
 void ProcessMonitor::getTopratedProcesses(
-  std::vector<std::shared_ptr<DiagTask>> * tasks, bp::pipe * p)
+  std::vector<std::shared_ptr<DiagTask>> * tasks, const std::vector<ProcessInfo> & procs,
+  const std::vector<size_t> & order)
 {
-  if (tasks == nullptr || p == nullptr) {
-    return;
-  }
-
-  bp::ipstream is_out;
-  bp::ipstream is_err;
-  std::ostringstream os;
-
-  bp::child c(
-    fmt::format("sed -n \"1,{} p\"", num_of_procs_), bp::std_out > is_out, bp::std_err > is_err,
-    bp::std_in < *p);
-
-  c.wait();
-  // Failed to modify line
-  if (c.exit_code() != 0) {
-    is_err >> os.rdbuf();
-    setErrorContent(tasks, "sed error", "sed", os.str().c_str());
+  if (tasks == nullptr) {
     return;
   }
 
-  std::vector<std::string> list;
-  std::string line;
   int index = 0;
 
-  while (std::getline(is_out, line) && !line.empty()) {
-    boost::trim_left(line);
-    boost::split(list, line, boost::is_space(), boost::token_compress_on);
+  for (const auto i : order) {
+    const auto & proc = procs.at(i);
+
+    // CPU time in the format of `top`, minutes:seconds.hundredths
+    const uint64_t hundredths = proc.total_time_ * 100 / clock_ticks_;
 
     tasks->at(index)->setDiagnosticsStatus(DiagStatus::OK, "OK");
-    tasks->at(index)->setProcessId(list[0]);
-    tasks->at(index)->setUserName(list[1]);
-    tasks->at(index)->setPriority(list[2]);
-    tasks->at(index)->setNiceValue(list[3]);
-    tasks->at(index)->setVirtualImage(list[4]);
-    tasks->at(index)->setResidentSize(list[5]);
-    tasks->at(index)->setSharedMemSize(list[6]);
-    tasks->at(index)->setProcessStatus(list[7]);
-    tasks->at(index)->setCPUUsage(list[8]);
-    tasks->at(index)->setMemoryUsage(list[9]);
-    tasks->at(index)->setCPUTime(list[10]);
-    tasks->at(index)->setCommandName(list[11]);
+    tasks->at(index)->setProcessId(std::to_string(proc.pid_));
+    tasks->at(index)->setUserName(getUserName(proc.uid_));
+    // Real-time priority is shown as rt
+    tasks->at(index)->setPriority(
+      (proc.priority_ <= -100) ? "rt" : std::to_string(proc.priority_));
+    tasks->at(index)->setNiceValue(std::to_string(proc.nice_));
+    tasks->at(index)->setVirtualImage(std::to_string(proc.virt_));
+    tasks->at(index)->setResidentSize(std::to_string(proc.res_));
+    tasks->at(index)->setSharedMemSize(std::to_string(proc.shr_));
+    tasks->at(index)->setProcessStatus(std::string(1, proc.state_));
+    tasks->at(index)->setCPUUsage(fmt::format("{:.1f}", proc.cpu_));
+    tasks->at(index)->setMemoryUsage(fmt::format("{:.1f}", proc.mem_));
+    tasks->at(index)->setCPUTime(fmt::format(
+      "{}:{:02}.{:02}", hundredths / 6000, (hundredths / 100) % 60, hundredths % 100));
+    tasks->at(index)->setCommandName(proc.command_);
     ++index;
   }
 }
 
+std::string ProcessMonitor::getUserName(uid_t uid)
+{
+  const auto itr = user_names_.find(uid);
+  if (itr != user_names_.end()) {
+    return itr->second;
+  }
+
+  std::string name = std::to_string(uid);
+  struct passwd pwd;
+  struct passwd * result = nullptr;
+  char buf[1024];
+  if (getpwuid_r(uid, &pwd, buf, sizeof(buf), &result) == 0 && result != nullptr) {
+    name = pwd.pw_name;
+  }
+
+  user_names_[uid] = name;
+  return name;
+}
+
 void ProcessMonitor::setErrorContent(
   std::vector<std::shared_ptr<DiagTask>> * tasks, const std::string & message,
   const std::string & error_command, const std::string & content)
@@ -113,15 +113,12 @@ public:
     // Get directory of executable
     const fs::path exe_path(argv_[0]);
     exe_dir_ = exe_path.parent_path().generic_string();
-    // Get dummy executable path
-    df_ = exe_dir_ + "/df";
   }
 
 protected:
   std::unique_ptr<TestHDDMonitor> monitor_;
   rclcpp::Subscription<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr sub_;
   std::string exe_dir_;
-  std::string df_;
 
   void SetUp()
   {
@@ -131,18 +128,10 @@ protected:
     monitor_ = std::make_unique<TestHDDMonitor>("test_hdd_monitor", node_options);
     sub_ = monitor_->create_subscription<diagnostic_msgs::msg::DiagnosticArray>(
       "/diagnostics", 1000, std::bind(&TestHDDMonitor::diagCallback, monitor_.get(), _1));
-    // Remove dummy executable if exists
-    if (fs::exists(df_)) {
-      fs::remove(df_);
-    }
   }
 
   void TearDown()
   {
-    // Remove dummy executable if exists
-    if (fs::exists(df_)) {
-      fs::remove(df_);
-    }
     rclcpp::shutdown();
   }
 
@@ -678,31 +667,6 @@ TEST_F(HDDMonitorTestSuite, usageErrorTest)
   }
 }
 
-TEST_F(HDDMonitorTestSuite, usageDfErrorTest)
-{
-  // Symlink df1 to df
-  fs::create_symlink(exe_dir_ + "/df1", df_);
-
-  // Modify PATH temporarily
-  modifyPath();
-
-  // Publish topic
-  monitor_->update();
-
-  // Give time to publish
-  rclcpp::WallRate(2).sleep();
-  rclcpp::spin_some(monitor_->get_node_base_interface());
-
-  // Verify
-  DiagStatus status;
-  std::string value;
-
-  ASSERT_TRUE(monitor_->findDiagStatus("HDD Usage", status));
-  ASSERT_EQ(status.level, DiagStatus::ERROR);
-  ASSERT_STREQ(status.message.c_str(), "df error");
-  ASSERT_TRUE(findValue(status, "HDD 0: df", value));
-}
-
 int main(int argc, char ** argv)
 {
   argv_ = argv;
@@ -80,21 +80,12 @@ public:
     // Get directory of executable
     const fs::path exe_path(argv_[0]);
     exe_dir_ = exe_path.parent_path().generic_string();
-    // Get dummy executable path
-    top_ = exe_dir_ + "/top";
-    echo_ = exe_dir_ + "/echo";
-    sed_ = exe_dir_ + "/sed";
-    sort_ = exe_dir_ + "/sort";
   }
 
 protected:
   std::unique_ptr<TestProcessMonitor> monitor_;
   rclcpp::Subscription<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr sub_;
   std::string exe_dir_;
-  std::string top_;
-  std::string echo_;
-  std::string sed_;
-  std::string sort_;
 
   void SetUp()
   {
@@ -104,37 +95,10 @@ protected:
     monitor_ = std::make_unique<TestProcessMonitor>("test_process_monitor", node_options);
     sub_ = monitor_->create_subscription<diagnostic_msgs::msg::DiagnosticArray>(
       "/diagnostics", 1000, std::bind(&TestProcessMonitor::diagCallback, monitor_.get(), _1));
-
-    // Remove dummy executable if exists
-    if (fs::exists(top_)) {
-      fs::remove(top_);
-    }
-    if (fs::exists(echo_)) {
-      fs::remove(echo_);
-    }
-    if (fs::exists(sed_)) {
-      fs::remove(sed_);
-    }
-    if (fs::exists(sort_)) {
-      fs::remove(sort_);
-    }
   }
 
   void TearDown()
   {
-    // Remove dummy executable if exists
-    if (fs::exists(top_)) {
-      fs::remove(top_);
-    }
-    if (fs::exists(echo_)) {
-      fs::remove(echo_);
-    }
-    if (fs::exists(sed_)) {
-      fs::remove(sed_);
-    }
-    if (fs::exists(sort_)) {
-      fs::remove(sort_);
-    }
     rclcpp::shutdown();
   }
 
@@ -212,164 +176,6 @@ TEST_F(ProcessMonitorTestSuite, highMemProcTest)
   }
 }
 
-TEST_F(ProcessMonitorTestSuite, topErrorTest)
-{
-  // Symlink top1 to top
-  fs::create_symlink(exe_dir_ + "/top1", top_);
-
-  // Modify PATH temporarily
-  modifyPath();
-
-  // Publish topic
-  monitor_->update();
-
-  // Give time to publish
-  rclcpp::WallRate(2).sleep();
-  rclcpp::spin_some(monitor_->get_node_base_interface());
-
-  // Verify
-  DiagStatus status;
-  std::string value;
-
-  ASSERT_TRUE(monitor_->findDiagStatus("Tasks Summary", status));
-  ASSERT_EQ(status.level, DiagStatus::ERROR);
-  ASSERT_STREQ(status.message.c_str(), "top error");
-  ASSERT_TRUE(findValue(status, "top", value));
-  ASSERT_STREQ(value.c_str(), "");
-
-  for (int i = 0; i < monitor_->getNumOfProcs(); ++i) {
-    ASSERT_TRUE(monitor_->findDiagStatus(fmt::format("High-load Proc[{}]", i), status));
-    ASSERT_EQ(status.level, DiagStatus::ERROR);
-    ASSERT_STREQ(status.message.c_str(), "top error");
-
-    ASSERT_TRUE(monitor_->findDiagStatus(fmt::format("High-mem Proc[{}]", i), status));
-    ASSERT_EQ(status.level, DiagStatus::ERROR);
-    ASSERT_STREQ(status.message.c_str(), "top error");
-  }
-}
-
-TEST_F(ProcessMonitorTestSuite, matchingPatternNotFoundTest)
-{
-  // Symlink top2 to top
-  fs::create_symlink(exe_dir_ + "/top2", top_);
-
-  // Modify PATH temporarily
-  modifyPath();
-
-  // Publish topic
-  monitor_->update();
-
-  // Give time to publish
-  rclcpp::WallRate(2).sleep();
-  rclcpp::spin_some(monitor_->get_node_base_interface());
-
-  // Verify
-  DiagStatus status;
-  std::string value;
-
-  ASSERT_TRUE(monitor_->findDiagStatus("Tasks Summary", status));
-  ASSERT_EQ(status.level, DiagStatus::ERROR);
-  ASSERT_STREQ(status.message.c_str(), "matching pattern not found");
-}
-
-TEST_F(ProcessMonitorTestSuite, invalidFormatTest)
-{
-  // Symlink top3 to top
-  fs::create_symlink(exe_dir_ + "/top3", top_);
-
-  // Modify PATH temporarily
-  modifyPath();
-
-  // Publish topic
-  monitor_->update();
-
-  // Give time to publish
-  rclcpp::WallRate(2).sleep();
-  rclcpp::spin_some(monitor_->get_node_base_interface());
-
-  // Verify
-  DiagStatus status;
-  std::string value;
-
-  ASSERT_TRUE(monitor_->findDiagStatus("Tasks Summary", status));
-  ASSERT_EQ(status.level, DiagStatus::ERROR);
-  ASSERT_STREQ(status.message.c_str(), "invalid format");
-}
-
-TEST_F(ProcessMonitorTestSuite, echoErrorTest)
-{
-  // Symlink sed1 to sed
-  fs::create_symlink(exe_dir_ + "/echo1", echo_);
-
-  // Modify PATH temporarily
-  modifyPath();
-
-  // Publish topic
-  monitor_->update();
-
-  // Give time to publish
-  rclcpp::WallRate(2).sleep();
-  rclcpp::spin_some(monitor_->get_node_base_interface());
-
-  // Verify
-  DiagStatus status;
-  std::string value;
-
-  ASSERT_TRUE(monitor_->findDiagStatus("Tasks Summary", status));
-  ASSERT_EQ(status.level, DiagStatus::ERROR);
-  ASSERT_STREQ(status.message.c_str(), "echo error");
-}
-
-TEST_F(ProcessMonitorTestSuite, sedErrorTest)
-{
-  // Symlink sed1 to sed
-  fs::create_symlink(exe_dir_ + "/sed1", sed_);
-
-  // Modify PATH temporarily
-  modifyPath();
-
-  // Publish topic
-  monitor_->update();
-
-  // Give time to publish
-  rclcpp::WallRate(2).sleep();
-  rclcpp::spin_some(monitor_->get_node_base_interface());
-
-  // Verify
-  DiagStatus status;
-  std::string value;
-
-  ASSERT_TRUE(monitor_->findDiagStatus("Tasks Summary", status));
-  ASSERT_EQ(status.level, DiagStatus::ERROR);
-  ASSERT_STREQ(status.message.c_str(), "sed error");
-}
-
-TEST_F(ProcessMonitorTestSuite, sortErrorTest)
-{
-  // Symlink sort1 to sort
-  fs::create_symlink(exe_dir_ + "/sort1", sort_);
-
-  // Modify PATH temporarily
-  modifyPath();
-
-  // Publish topic
-  monitor_->update();
-
-  // Give time to publish
-  rclcpp::WallRate(2).sleep();
-  rclcpp::spin_some(monitor_->get_node_base_interface());
-
-  // Verify
-  DiagStatus status;
-  std::string value;
-
-  for (int i = 0; i < monitor_->getNumOfProcs(); ++i) {
-    ASSERT_TRUE(monitor_->findDiagStatus(fmt::format("High-mem Proc[{}]", i), status));
-    ASSERT_EQ(status.level, DiagStatus::ERROR);
-    ASSERT_STREQ(status.message.c_str(), "sort error");
-  }
-}
-
 int main(int argc, char ** argv)
 {
   argv_ = argv;
@@ -0,0 +1,56 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TOPIC_STATE_MONITOR__MULTI_TOPIC_STATE_MONITOR_CORE_HPP_
+#define TOPIC_STATE_MONITOR__MULTI_TOPIC_STATE_MONITOR_CORE_HPP_
+
+#include "topic_state_monitor/topic_state_monitor.hpp"
+#include "topic_state_monitor/topic_state_monitor_core.hpp"
+
+#include <diagnostic_updater/diagnostic_updater.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace topic_state_monitor
+{
+// Monitors many topics in one node, sharing a timer and a diagnostic updater
+class MultiTopicStateMonitorNode : public rclcpp::Node
+{
+public:
+  explicit MultiTopicStateMonitorNode(const rclcpp::NodeOptions & node_options);
+
+private:
+  // Parameter
+  NodeParam node_param_;
+  Param loadTopicParam(const std::string & key);
+
+  // Core
+  std::vector<std::unique_ptr<TopicStateMonitor>> topic_state_monitors_;
+
+  // Subscriber
+  std::vector<rclcpp::GenericSubscription::SharedPtr> sub_topics_;
+
+  // Timer
+  void onTimer();
+  rclcpp::TimerBase::SharedPtr timer_;
+
+  // Diagnostic Updater
+  diagnostic_updater::Updater updater_;
+};
+}  // namespace topic_state_monitor
+
+#endif  // TOPIC_STATE_MONITOR__MULTI_TOPIC_STATE_MONITOR_CORE_HPP_
@@ -15,10 +15,13 @@
 #ifndef TOPIC_STATE_MONITOR__TOPIC_STATE_MONITOR_HPP_
 #define TOPIC_STATE_MONITOR__TOPIC_STATE_MONITOR_HPP_
 
+#include <diagnostic_updater/diagnostic_updater.hpp>
 #include <rclcpp/rclcpp.hpp>
 
-#include <deque>
+#include <builtin_interfaces/msg/time.hpp>
+
 #include <string>
+#include <vector>
 
 namespace topic_state_monitor
 {
@@ -33,6 +36,9 @@ struct Param
   double error_rate;
   double timeout;
   int window_size;
+  bool has_header;  // the message starts with std_msgs/Header, used to measure latency
+  double warn_latency;
+  double error_latency;
 };
 
 enum class TopicStatus : int8_t {
@@ -41,6 +47,8 @@ enum class TopicStatus : int8_t {
   WarnRate,
   ErrorRate,
   Timeout,
+  WarnLatency,
+  ErrorLatency,
 };
 
 class TopicStateMonitor
@@ -48,12 +56,16 @@ class TopicStateMonitor
 public:
   explicit TopicStateMonitor(rclcpp::Node & node);
 
-  void setParam(const Param & param) { param_ = param; }
+  void setParam(const Param & param);
+  const Param & getParam() const { return param_; }
 
   rclcpp::Time getLastMessageTime() const { return last_message_time_; }
   double getTopicRate() const { return topic_rate_; }
+  double getLatency() const { return latency_; }
 
   void update();
+  void update(const builtin_interfaces::msg::Time & header_stamp);
+  void update(const rclcpp::SerializedMessage & msg);
   TopicStatus getTopicStatus() const;
 
 private:
@@ -61,9 +73,13 @@ private:
 
   static constexpr double max_rate = 100000.0;
 
-  std::deque<rclcpp::Time> time_buffer_;
+  // Ring buffer of receive times, its capacity is window_size
+  std::vector<rclcpp::Time> time_buffer_;
+  size_t time_buffer_head_ = 0;
+  size_t time_buffer_size_ = 0;
   rclcpp::Time last_message_time_ = rclcpp::Time(0);
   double topic_rate_ = TopicStateMonitor::max_rate;
+  double latency_ = 0.0;
 
   rclcpp::Clock::SharedPtr clock_;
 
@@ -72,7 +88,20 @@ private:
   bool isWarnRate() const;
   bool isErrorRate() const;
   bool isTimeout() const;
+  bool isWarnLatency() const;
+  bool isErrorLatency() const;
 };
+
+/**
+ * @brief read header.stamp from a serialized message without deserializing it
+ * @return false if the message is too short to have a header
+ */
+bool readHeaderStamp(
+  const rclcpp::SerializedMessage & msg, builtin_interfaces::msg::Time * header_stamp);
+
+void checkTopicStatus(
+  const TopicStateMonitor & topic_state_monitor, const rclcpp::Time & now,
+  diagnostic_updater::DiagnosticStatusWrapper & stat);
 }  // namespace topic_state_monitor
 
 #endif  // TOPIC_STATE_MONITOR__TOPIC_STATE_MONITOR_HPP_
@@ -0,0 +1,102 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "topic_state_monitor/multi_topic_state_monitor_core.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace topic_state_monitor
+{
+MultiTopicStateMonitorNode::MultiTopicStateMonitorNode(const rclcpp::NodeOptions & node_options)
+: Node("multi_topic_state_monitor", node_options), updater_(this)
+{
+  // Parameter
+  node_param_.update_rate = declare_parameter("update_rate", 10.0);
+  const auto topic_keys = declare_parameter<std::vector<std::string>>("topics");
+
+  updater_.setHardwareID("topic_state_monitor");
+
+  for (const auto & topic_key : topic_keys) {
+    const auto param = loadTopicParam(topic_key);
+
+    // Core
+    auto topic_state_monitor = std::make_unique<TopicStateMonitor>(*this);
+    topic_state_monitor->setParam(param);
+    auto * topic_state_monitor_ptr = topic_state_monitor.get();
+    topic_state_monitors_.push_back(std::move(topic_state_monitor));
+
+    // Subscriber, messages are kept serialized
+    rclcpp::QoS qos = rclcpp::QoS{1};
+    if (param.transient_local) {
+      qos.transient_local();
+    }
+    if (param.best_effort) {
+      qos.best_effort();
+    }
+    sub_topics_.push_back(this->create_generic_subscription(
+      param.topic, param.topic_type, qos,
+      [topic_state_monitor_ptr](std::shared_ptr<rclcpp::SerializedMessage> msg) {
+        topic_state_monitor_ptr->update(*msg);
+      }));
+
+    // Diagnostic Updater
+    updater_.add(
+      param.diag_name,
+      [this, topic_state_monitor_ptr](diagnostic_updater::DiagnosticStatusWrapper & stat) {
+        checkTopicStatus(*topic_state_monitor_ptr, this->now(), stat);
+      });
+  }
+
+  // Timer
+  auto timer_callback = std::bind(&MultiTopicStateMonitorNode::onTimer, this);
+  auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double>(1.0 / node_param_.update_rate));
+
+  timer_ = std::make_shared<rclcpp::GenericTimer<decltype(timer_callback)>>(
+    this->get_clock(), period, std::move(timer_callback),
+    this->get_node_base_interface()->get_context());
+  this->get_node_timers_interface()->add_timer(timer_, nullptr);
+}
+
+Param MultiTopicStateMonitorNode::loadTopicParam(const std::string & key)
+{
+  Param param;
+  param.topic = declare_parameter<std::string>(key + ".topic");
+  param.topic_type = declare_parameter<std::string>(key + ".topic_type");
+  param.transient_local = declare_parameter(key + ".transient_local", false);
+  param.best_effort = declare_parameter(key + ".best_effort", false);
+  param.diag_name = declare_parameter<std::string>(key + ".diag_name");
+  param.warn_rate = declare_parameter(key + ".warn_rate", 0.5);
+  param.error_rate = declare_parameter(key + ".error_rate", 0.1);
+  param.timeout = declare_parameter(key + ".timeout", 1.0);
+  param.window_size = declare_parameter(key + ".window_size", 10);
+  param.has_header = declare_parameter(key + ".has_header", false);
+  param.warn_latency = declare_parameter(key + ".warn_latency", 0.0);
+  param.error_latency = declare_parameter(key + ".error_latency", 0.0);
+  return param;
+}
+
+void MultiTopicStateMonitorNode::onTimer()
+{
+  // Publish diagnostics of all topics at once
+  updater_.force_update();
+}
+
+}  // namespace topic_state_monitor
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(topic_state_monitor::MultiTopicStateMonitorNode)
@@ -14,25 +14,56 @@
 
 #include "topic_state_monitor/topic_state_monitor.hpp"
 
+#include <algorithm>
+#include <string>
+
 namespace topic_state_monitor
 {
 TopicStateMonitor::TopicStateMonitor(rclcpp::Node & node) : clock_(node.get_clock()) {}
 
+void TopicStateMonitor::setParam(const Param & param)
+{
+  const auto capacity = static_cast<size_t>(std::max(param.window_size, 1));
+  if (capacity != time_buffer_.size()) {
+    time_buffer_.assign(capacity, rclcpp::Time(0, 0, clock_->get_clock_type()));
+    time_buffer_head_ = 0;
+    time_buffer_size_ = 0;
+  }
+
+  param_ = param;
+}
+
 void TopicStateMonitor::update()
 {
-  // Add data
+  // Add data, overwriting the oldest one when the buffer is full
   last_message_time_ = clock_->now();
-  time_buffer_.push_back(last_message_time_);
-
-  // Remove old data
-  while (static_cast<int>(time_buffer_.size()) > param_.window_size) {
-    time_buffer_.pop_front();
-  }
+  time_buffer_.at(time_buffer_head_) = last_message_time_;
+  time_buffer_head_ = (time_buffer_head_ + 1) % time_buffer_.size();
+  time_buffer_size_ = std::min(time_buffer_size_ + 1, time_buffer_.size());
 
   // Calc topic rate
   topic_rate_ = calcTopicRate();
 }
 
+void TopicStateMonitor::update(const builtin_interfaces::msg::Time & header_stamp)
+{
+  update();
+
+  // End-to-end latency from the stamp given by the publisher
+  latency_ = (last_message_time_ - rclcpp::Time(header_stamp, clock_->get_clock_type())).seconds();
+}
+
+void TopicStateMonitor::update(const rclcpp::SerializedMessage & msg)
+{
+  builtin_interfaces::msg::Time header_stamp;
+  if (param_.has_header && readHeaderStamp(msg, &header_stamp)) {
+    update(header_stamp);
+    return;
+  }
+
+  update();
+}
+
 TopicStatus TopicStateMonitor::getTopicStatus() const
 {
   if (isNotReceived()) {
@@ -44,9 +75,15 @@ TopicStatus TopicStateMonitor::getTopicStatus() const
   if (isErrorRate()) {
     return TopicStatus::ErrorRate;
   }
+  if (isErrorLatency()) {
+    return TopicStatus::ErrorLatency;
+  }
   if (isWarnRate()) {
     return TopicStatus::WarnRate;
   }
+  if (isWarnLatency()) {
+    return TopicStatus::WarnLatency;
+  }
   return TopicStatus::Ok;
 }
 
@@ -54,17 +91,19 @@ double TopicStateMonitor::calcTopicRate() const
 {
   // Output max_rate when topic rate can't be calculated.
   // In this case, it's assumed timeout is used instead.
-  if (time_buffer_.size() < 2) {
+  if (time_buffer_size_ < 2) {
     return TopicStateMonitor::max_rate;
   }
 
-  const auto time_diff = (time_buffer_.back() - time_buffer_.front()).seconds();
-  const auto num_intervals = time_buffer_.size() - 1;
+  const auto capacity = time_buffer_.size();
+  const auto oldest_idx = (time_buffer_head_ + capacity - time_buffer_size_) % capacity;
+  const auto time_diff = (last_message_time_ - time_buffer_.at(oldest_idx)).seconds();
+  const auto num_intervals = time_buffer_size_ - 1;
 
   return static_cast<double>(num_intervals) / time_diff;
 }
 
-bool TopicStateMonitor::isNotReceived() const { return time_buffer_.empty(); }
+bool TopicStateMonitor::isNotReceived() const { return time_buffer_size_ == 0; }
 
 bool TopicStateMonitor::isWarnRate() const
 {
@@ -90,8 +129,118 @@ bool TopicStateMonitor::isTimeout() const
     return false;
   }
 
-  const auto time_diff = (clock_->now() - time_buffer_.back()).seconds();
+  const auto time_diff = (clock_->now() - last_message_time_).seconds();
 
   return time_diff > param_.timeout;
 }
+
+bool TopicStateMonitor::isWarnLatency() const
+{
+  if (!param_.has_header || param_.warn_latency == 0.0) {
+    return false;
+  }
+
+  return getLatency() > param_.warn_latency;
+}
+
+bool TopicStateMonitor::isErrorLatency() const
+{
+  if (!param_.has_header || param_.error_latency == 0.0) {
+    return false;
+  }
+
+  return getLatency() > param_.error_latency;
+}
+
+bool readHeaderStamp(
+  const rclcpp::SerializedMessage & msg, builtin_interfaces::msg::Time * header_stamp)
+{
+  // CDR encapsulation (4 bytes) is followed by header.stamp (int32 sec, uint32 nanosec)
+  const auto & serialized_msg = msg.get_rcl_serialized_message();
+  if (serialized_msg.buffer_length < 12) {
+    return false;
+  }
+
+  const uint8_t * buffer = serialized_msg.buffer;
+  const bool is_little_endian = buffer[1] == 0x01;
+  const auto read_uint32 = [buffer, is_little_endian](const size_t offset) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      const auto byte = static_cast<uint32_t>(buffer[offset + (is_little_endian ? i : 3 - i)]);
+      value |= byte << (8 * i);
+    }
+    return value;
+  };
+
+  header_stamp->sec = static_cast<int32_t>(read_uint32(4));
+  header_stamp->nanosec = read_uint32(8);
+  return true;
+}
+
+void checkTopicStatus(
+  const TopicStateMonitor & topic_state_monitor, const rclcpp::Time & now,
+  diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  using diagnostic_msgs::msg::DiagnosticStatus;
+
+  // Get information
+  const auto & param = topic_state_monitor.getParam();
+  const auto topic_status = topic_state_monitor.getTopicStatus();
+  const auto last_message_time = topic_state_monitor.getLastMessageTime();
+  const auto topic_rate = topic_state_monitor.getTopicRate();
+
+  // Add topic name
+  stat.addf("topic", "%s", param.topic.c_str());
+
+  // Judge level
+  int8_t level = DiagnosticStatus::OK;
+  if (topic_status == TopicStatus::Ok) {
+    level = DiagnosticStatus::OK;
+    stat.add("status", "OK");
+  } else if (topic_status == TopicStatus::NotReceived) {
+    level = DiagnosticStatus::ERROR;
+    stat.add("status", "NotReceived");
+  } else if (topic_status == TopicStatus::WarnRate) {
+    level = DiagnosticStatus::WARN;
+    stat.add("status", "WarnRate");
+  } else if (topic_status == TopicStatus::ErrorRate) {
+    level = DiagnosticStatus::ERROR;
+    stat.add("status", "ErrorRate");
+  } else if (topic_status == TopicStatus::Timeout) {
+    level = DiagnosticStatus::ERROR;
+    stat.add("status", "Timeout");
+  } else if (topic_status == TopicStatus::WarnLatency) {
+    level = DiagnosticStatus::WARN;
+    stat.add("status", "WarnLatency");
+  } else if (topic_status == TopicStatus::ErrorLatency) {
+    level = DiagnosticStatus::ERROR;
+    stat.add("status", "ErrorLatency");
+  }
+
+  // Add key-value
+  stat.addf("warn_rate", "%.2f [Hz]", param.warn_rate);
+  stat.addf("error_rate", "%.2f [Hz]", param.error_rate);
+  stat.addf("timeout", "%.2f [s]", param.timeout);
+  stat.addf("measured_rate", "%.2f [Hz]", topic_rate);
+  if (param.has_header) {
+    stat.addf("warn_latency", "%.3f [s]", param.warn_latency);
+    stat.addf("error_latency", "%.3f [s]", param.error_latency);
+    stat.addf("measured_latency", "%.3f [s]", topic_state_monitor.getLatency());
+  }
+  stat.addf("now", "%.2f [s]", now.seconds());
+  stat.addf("last_message_time", "%.2f [s]", last_message_time.seconds());
+
+  // Create message
+  std::string msg;
+  if (level == DiagnosticStatus::OK) {
+    msg = "OK";
+  } else if (level == DiagnosticStatus::WARN) {
+    msg = "Warn";
+  } else if (level == DiagnosticStatus::ERROR) {
+    msg = "Error";
+  }
+
+  // Add summary
+  stat.summary(level, msg);
+}
 }  // namespace topic_state_monitor
@@ -51,6 +51,9 @@ TopicStateMonitorNode::TopicStateMonitorNode(const rclcpp::NodeOptions & node_op
   param_.error_rate = declare_parameter("error_rate", 0.1);
   param_.timeout = declare_parameter("timeout", 1.0);
   param_.window_size = declare_parameter("window_size", 10);
+  param_.has_header = declare_parameter("has_header", false);
+  param_.warn_latency = declare_parameter("warn_latency", 0.0);
+  param_.error_latency = declare_parameter("error_latency", 0.0);
 
   // Parameter Reconfigure
   set_param_res_ =
@@ -70,9 +73,7 @@ TopicStateMonitorNode::TopicStateMonitorNode(const rclcpp::NodeOptions & node_op
   }
   sub_topic_ = this->create_generic_subscription(
     param_.topic, param_.topic_type, qos,
-    [this]([[maybe_unused]] std::shared_ptr<rclcpp::SerializedMessage> msg) {
-      topic_state_monitor_->update();
-    });
+    [this](std::shared_ptr<rclcpp::SerializedMessage> msg) { topic_state_monitor_->update(*msg); });
 
   // Diagnostic Updater
   updater_.setHardwareID("topic_state_monitor");
@@ -101,6 +102,9 @@ rcl_interfaces::msg::SetParametersResult TopicStateMonitorNode::onParameter(
     update_param(parameters, "error_rate", param_.error_rate);
     update_param(parameters, "timeout", param_.timeout);
     update_param(parameters, "window_size", param_.window_size);
+    update_param(parameters, "warn_latency", param_.warn_latency);
+    update_param(parameters, "error_latency", param_.error_latency);
+    topic_state_monitor_->setParam(param_);
   } catch (const rclcpp::exceptions::InvalidParameterTypeException & e) {
     result.successful = false;
     result.reason = e.what();
@@ -117,55 +121,7 @@ void TopicStateMonitorNode::onTimer()
 
 void TopicStateMonitorNode::checkTopicStatus(diagnostic_updater::DiagnosticStatusWrapper & stat)
 {
-  using diagnostic_msgs::msg::DiagnosticStatus;
-
-  // Get information
-  const auto topic_status = topic_state_monitor_->getTopicStatus();
-  const auto last_message_time = topic_state_monitor_->getLastMessageTime();
-  const auto topic_rate = topic_state_monitor_->getTopicRate();
-
-  // Add topic name
-  stat.addf("topic", "%s", param_.topic.c_str());
-
-  // Judge level
-  int8_t level = DiagnosticStatus::OK;
-  if (topic_status == TopicStatus::Ok) {
-    level = DiagnosticStatus::OK;
-    stat.add("status", "OK");
-  } else if (topic_status == TopicStatus::NotReceived) {
-    level = DiagnosticStatus::ERROR;
-    stat.add("status", "NotReceived");
-  } else if (topic_status == TopicStatus::WarnRate) {
-    level = DiagnosticStatus::WARN;
-    stat.add("status", "WarnRate");
-  } else if (topic_status == TopicStatus::ErrorRate) {
-    level = DiagnosticStatus::ERROR;
-    stat.add("status", "ErrorRate");
-  } else if (topic_status == TopicStatus::Timeout) {
-    level = DiagnosticStatus::ERROR;
-    stat.add("status", "Timeout");
-  }
-
-  // Add key-value
-  stat.addf("warn_rate", "%.2f [Hz]", param_.warn_rate);
-  stat.addf("error_rate", "%.2f [Hz]", param_.error_rate);
-  stat.addf("timeout", "%.2f [s]", param_.timeout);
-  stat.addf("measured_rate", "%.2f [Hz]", topic_rate);
-  stat.addf("now", "%.2f [s]", this->now().seconds());
-  stat.addf("last_message_time", "%.2f [s]", last_message_time.seconds());
-
-  // Create message
-  std::string msg;
-  if (level == DiagnosticStatus::OK) {
-    msg = "OK";
-  } else if (level == DiagnosticStatus::WARN) {
-    msg = "Warn";
-  } else if (level == DiagnosticStatus::ERROR) {
-    msg = "Error";
-  }
-
-  // Add summary
-  stat.summary(level, msg);
+  topic_state_monitor::checkTopicStatus(*topic_state_monitor_, this->now(), stat);
 }
 
 }  // namespace topic_state_monitor
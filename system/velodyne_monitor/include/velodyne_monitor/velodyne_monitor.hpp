@@ -23,8 +23,10 @@
 #include <diagnostic_updater/diagnostic_updater.hpp>
 #include <rclcpp/rclcpp.hpp>
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -43,9 +45,29 @@ public:
    */
   VelodyneMonitor();
 
+  /**
+   * @brief destructor, waits for the pending requests
+   */
+  ~VelodyneMonitor();
+
 protected:
   using DiagStatus = diagnostic_msgs::msg::DiagnosticStatus;
 
+  /**
+   * @brief latest response of a JSON file
+   */
+  struct JsonResponse
+  {
+    bool received = false;                    //!< @brief flag of the JSON received
+    json::value value;                        //!< @brief values of the JSON
+    std::string err_msg = "no response yet";  //!< @brief error message if not received
+  };
+
+  /**
+   * @brief send the HTTP-GET requests of all the JSON files at once if none are pending
+   */
+  void onTimer();
+
   /**
    * @brief obtain JSON-formatted diagnostic status and check connection
    * @param [out] stat diagnostic message passed directly to diagnostic publish calls
@@ -74,15 +96,19 @@ protected:
     diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
 
   /**
-   * @brief send an HTTP-GET request
+   * @brief send an HTTP-GET request without waiting for the response
    * @param [in] path_query string containing the path, query
-   * @param [out] res an HTTP response
-   * @param [out] err_msg diagnostic message passed directly to diagnostic publish calls
-   * @return true on success, false on error
-   * @note NOLINT syntax is needed since diagnostic_updater asks for a non-const reference
-   * to pass diagnostic message updated in this function to diagnostic publish calls.
+   * @param [out] response latest response, updated when the request completes
+   * @return task completed after the response is updated
    */
-  bool requestGET(const std::string & path_query, http::http_response & res, std::string & err_msg);
+  pplx::task<void> requestGETAsync(const std::string & path_query, JsonResponse * response);
+
+  /**
+   * @brief get a copy of the latest response
+   * @param [in] response latest response
+   * @return copy of the latest response
+   */
+  JsonResponse getResponse(const JsonResponse & response);
 
   /**
    * @brief convert raw diagnostic data to usable temperature value
@@ -97,10 +123,19 @@ protected:
   json::value diag_json_;                        //!< @brief values of diag.json
   json::value status_json_;                      //!< @brief values of status.json
   json::value settings_json_;                    //!< @brief values of settings.json
-  bool diag_json_received_;                      //!< @brief flag of diag.json received
+
+  rclcpp::TimerBase::SharedPtr timer_;              //!< @brief timer to poll the sensor
+  std::mutex response_mutex_;                       //!< @brief mutex of the responses
+  JsonResponse info_response_;                      //!< @brief latest response of info.json
+  JsonResponse diag_response_;                      //!< @brief latest response of diag.json
+  JsonResponse settings_response_;                  //!< @brief latest response of settings.json
+  JsonResponse status_response_;                    //!< @brief latest response of status.json
+  std::atomic<int> num_pending_requests_;           //!< @brief number of requests not completed
+  std::vector<pplx::task<void>> pending_requests_;  //!< @brief tasks of the last requests
 
   std::string ip_address_;  //!< @brief Network IP address of sensor
   double timeout_;          //!< @brief timeout parameter
+  double polling_period_;   //!< @brief period to poll the sensor
   float temp_cold_warn_;    //!< @brief the cold temperature threshold to generate a warning
   float temp_cold_error_;   //!< @brief the cold temperature threshold to generate an error
   float temp_hot_warn_;     //!< @brief the hot temperature threshold to generate a warning
@@ -22,6 +22,7 @@
 #include <boost/algorithm/string/join.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
@@ -41,6 +42,8 @@ VelodyneMonitor::VelodyneMonitor() : Node("velodyne_monitor"), updater_(this)
   rpm_ratio_warn_ = declare_parameter("rpm_ratio_warn", 0.80);
   rpm_ratio_error_ = declare_parameter("rpm_ratio_error", 0.70);
 
+  polling_period_ = declare_parameter("polling_period", 1.0);
+
   updater_.add("velodyne_connection", this, &VelodyneMonitor::checkConnection);
   updater_.add("velodyne_temperature", this, &VelodyneMonitor::checkTemperature);
   updater_.add("velodyne_rpm", this, &VelodyneMonitor::checkMotorRpm);
@@ -53,27 +56,45 @@ VelodyneMonitor::VelodyneMonitor() : Node("velodyne_monitor"), updater_(this)
   client_.reset(new client::http_client("http://" + ip_address_, config));
 
   updater_.setHardwareID("velodyne");
+
+  // Polls the sensor in the background so that a slow sensor never blocks the executor
+  num_pending_requests_ = 0;
+  timer_ = create_wall_timer(
+    std::chrono::duration<double>(polling_period_), std::bind(&VelodyneMonitor::onTimer, this));
+  onTimer();
 }
 
-void VelodyneMonitor::checkConnection(diagnostic_updater::DiagnosticStatusWrapper & stat)
+VelodyneMonitor::~VelodyneMonitor()
 {
-  http::http_response res;
-  std::string err_msg = "";
+  // The continuations of the requests refer to this object
+  for (auto & task : pending_requests_) {
+    task.wait();
+  }
+}
 
-  // Sends an HTTP-GET request
-  if (!requestGET("/cgi/info.json", res, err_msg)) {
-    stat.summary(DiagStatus::ERROR, err_msg);
+void VelodyneMonitor::onTimer()
+{
+  // Skips polling while the previous requests are still waiting for the sensor
+  if (num_pending_requests_ > 0) {
     return;
   }
 
-  // Extracts the body of the request message into a json value
-  try {
-    info_json_ = res.extract_json().get();
-  } catch (const web::http::http_exception & ex) {
-    RCLCPP_WARN(get_logger(), "%s", ex.what());
-    stat.summary(DiagStatus::ERROR, ex.what());
+  // Sends all the requests at once instead of one by one
+  pending_requests_.clear();
+  pending_requests_.push_back(requestGETAsync("/cgi/info.json", &info_response_));
+  pending_requests_.push_back(requestGETAsync("/cgi/diag.json", &diag_response_));
+  pending_requests_.push_back(requestGETAsync("/cgi/settings.json", &settings_response_));
+  pending_requests_.push_back(requestGETAsync("/cgi/status.json", &status_response_));
+}
+
+void VelodyneMonitor::checkConnection(diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  const JsonResponse info = getResponse(info_response_);
+  if (!info.received) {
+    stat.summary(DiagStatus::ERROR, info.err_msg);
     return;
   }
+  info_json_ = info.value;
 
   updater_.setHardwareIDf(
     "%s: %s", info_json_["model"].as_string().c_str(), info_json_["serial"].as_string().c_str());
@@ -86,27 +107,13 @@ void VelodyneMonitor::checkTemperature(diagnostic_updater::DiagnosticStatusWrapp
   int level_top = DiagStatus::OK;
   int level_bot = DiagStatus::OK;
   std::vector<std::string> msg;
-  std::string err_msg = "";
-
-  http::http_response res;
-  diag_json_received_ = false;
-
-  // Sends an HTTP-GET request
-  if (!requestGET("/cgi/diag.json", res, err_msg)) {
-    stat.summary(DiagStatus::ERROR, err_msg);
-    return;
-  }
-
-  diag_json_received_ = true;
 
-  // Extracts the body of the request message into a json value
-  try {
-    diag_json_ = res.extract_json().get();
-  } catch (const web::http::http_exception & ex) {
-    RCLCPP_WARN(get_logger(), "%s", ex.what());
-    stat.summary(DiagStatus::ERROR, ex.what());
+  const JsonResponse diag = getResponse(diag_response_);
+  if (!diag.received) {
+    stat.summary(DiagStatus::ERROR, diag.err_msg);
     return;
   }
+  diag_json_ = diag.value;
 
   const float top_temp =
     convertTemperature(diag_json_["volt_temp"]["top"]["lm20_temp"].as_integer());
@@ -156,38 +163,20 @@ void VelodyneMonitor::checkTemperature(diagnostic_updater::DiagnosticStatusWrapp
 void VelodyneMonitor::checkMotorRpm(diagnostic_updater::DiagnosticStatusWrapper & stat)
 {
   int level = DiagStatus::OK;
-  http::http_response res;
-  std::string err_msg = "";
 
-  // Sends an HTTP-GET request
-  if (!requestGET("/cgi/settings.json", res, err_msg)) {
-    stat.summary(DiagStatus::ERROR, err_msg);
+  const JsonResponse settings = getResponse(settings_response_);
+  if (!settings.received) {
+    stat.summary(DiagStatus::ERROR, settings.err_msg);
     return;
   }
+  settings_json_ = settings.value;
 
-  // Extracts the body of the request message into a json value
-  try {
-    settings_json_ = res.extract_json().get();
-  } catch (const web::http::http_exception & ex) {
-    RCLCPP_WARN(get_logger(), "%s", ex.what());
-    stat.summary(DiagStatus::ERROR, ex.what());
-    return;
-  }
-
-  // Sends an HTTP-GET request
-  if (!requestGET("/cgi/status.json", res, err_msg)) {
-    stat.summary(DiagStatus::ERROR, err_msg);
-    return;
-  }
-
-  // Extracts the body of the request message into a json value
-  try {
-    status_json_ = res.extract_json().get();
-  } catch (const web::http::http_exception & ex) {
-    RCLCPP_WARN(get_logger(), "%s", ex.what());
-    stat.summary(DiagStatus::ERROR, ex.what());
+  const JsonResponse status = getResponse(status_response_);
+  if (!status.received) {
+    stat.summary(DiagStatus::ERROR, status.err_msg);
     return;
   }
+  status_json_ = status.value;
 
   const double setting = settings_json_["rpm"].as_double();
   const double rpm = status_json_["motor"]["rpm"].as_double();
@@ -206,23 +195,39 @@ void VelodyneMonitor::checkMotorRpm(diagnostic_updater::DiagnosticStatusWrapper
   stat.summary(level, rpm_dict_.at(level));
 }
 
-bool VelodyneMonitor::requestGET(
-  const std::string & path_query, http::http_response & res, std::string & err_msg)
+pplx::task<void> VelodyneMonitor::requestGETAsync(
+  const std::string & path_query, JsonResponse * response)
 {
-  // Asynchronously sends an HTTP request
-  try {
-    res = client_->request(http::methods::GET, path_query).get();
-  } catch (const std::exception & e) {
-    err_msg = e.what();
-    return false;
-  }
-
-  if (res.status_code() != web::http::status_codes::OK) {
-    err_msg = fmt::format("{}: {}", res.status_code(), res.reason_phrase().c_str());
-    return false;
-  }
+  ++num_pending_requests_;
+  return client_->request(http::methods::GET, path_query)
+    .then([](http::http_response res) {
+      if (res.status_code() != web::http::status_codes::OK) {
+        throw http::http_exception(
+          fmt::format("{}: {}", res.status_code(), res.reason_phrase().c_str()));
+      }
+      // Extracts the body of the request message into a json value
+      return res.extract_json();
+    })
+    .then([this, response](pplx::task<json::value> task) {
+      JsonResponse result;
+      try {
+        result.value = task.get();
+        result.received = true;
+      } catch (const std::exception & e) {
+        result.err_msg = e.what();
+      }
+      {
+        std::lock_guard<std::mutex> lock(response_mutex_);
+        *response = result;
+      }
+      --num_pending_requests_;
+    });
+}
 
-  return true;
+VelodyneMonitor::JsonResponse VelodyneMonitor::getResponse(const JsonResponse & response)
+{
+  std::lock_guard<std::mutex> lock(response_mutex_);
+  return response;
 }
 
 float VelodyneMonitor::convertTemperature(int raw)
@@ -37,11 +37,14 @@
 #include "std_msgs/msg/multi_array_dimension.hpp"
 #include "std_msgs/msg/string.hpp"
 
+#include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
 #include <memory>
 #include <queue>
 #include <string>
+#include <utility>
 #include <vector>
 
 using raw_vehicle_cmd_converter::AccelMap;
@@ -57,6 +60,37 @@ struct DataStamped
 };
 using DataStampedPtr = std::shared_ptr<DataStamped>;
 
+// running count, average and standard deviation of the data of a map cell
+struct CellStatistics
+{
+  void add(const double value)
+  {
+    ++count;
+    const double delta = value - average;
+    average += delta / static_cast<double>(count);
+    sum_squared_diff += delta * (value - average);
+  }
+  double getStandardDeviation() const
+  {
+    return count > 0 ? std::sqrt(sum_squared_diff / static_cast<double>(count)) : 0.0;
+  }
+  std::size_t count = 0;
+  double average = 0.0;
+  double sum_squared_diff = 0.0;
+};
+
+// record of map_update_log.bin: a cell of the updated accel/brake map and its new value
+#pragma pack(push, 1)
+struct MapUpdateRecord
+{
+  double stamp;
+  uint8_t is_accel_map;
+  uint8_t pedal_index;
+  uint8_t vel_index;
+  double value;
+};
+#pragma pack(pop)
+
 class AccelBrakeMapCalibrator : public rclcpp::Node
 {
 private:
@@ -87,9 +121,7 @@ private:
     update_map_dir_server_;
 
   rclcpp::TimerBase::SharedPtr timer_;
-  rclcpp::TimerBase::SharedPtr timer_output_csv_;
   void initTimer(double period_s);
-  void initOutputCSVTimer(double period_s);
 
   geometry_msgs::msg::TwistStamped::ConstSharedPtr twist_ptr_;
   std::vector<geometry_msgs::msg::TwistStamped::ConstSharedPtr> twist_vec_;
@@ -148,8 +180,6 @@ private:
   BrakeMap brake_map_;
 
   // for evaluation
-  AccelMap new_accel_map_;
-  BrakeMap new_brake_map_;
   std::vector<double> part_original_accel_mse_que_;
   std::vector<double> full_original_accel_mse_que_;
   std::vector<double> new_accel_mse_que_;
@@ -165,7 +195,7 @@ private:
   std::vector<std::vector<double>> brake_map_value_;
   std::vector<std::vector<double>> update_accel_map_value_;
   std::vector<std::vector<double>> update_brake_map_value_;
-  std::vector<std::vector<std::vector<double>>> map_value_data_;
+  std::vector<std::vector<CellStatistics>> map_value_statistics_;
   std::vector<double> accel_vel_index_;
   std::vector<double> brake_vel_index_;
   std::vector<double> accel_pedal_index_;
@@ -187,15 +217,17 @@ private:
   double map_offset_ = 0.0;
   double map_coef_ = 1.0;
   double covariance_;
+  std::vector<std::vector<double>> map_offset_vec_;
+  std::vector<std::vector<double>> covariance_vec_;
   const double forgetting_factor_ = 0.999;
   const double coef_update_skip_thresh_ = 0.1;
 
   // output log
   std::ofstream output_log_;
+  std::ofstream map_update_log_;
 
   bool getCurrentPitchFromTF(double * pitch);
   void timerCallback();
-  void timerCallbackOutputCSV();
   void executeUpdate(
     const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
     const int brake_pedal_index, const int brake_vel_index);
@@ -229,6 +261,11 @@ private:
   int nearestVelSearch();
   void takeConsistencyOfAccelMap();
   void takeConsistencyOfBrakeMap();
+  void takeConsistencyAroundCell(
+    const bool accel_map, const std::size_t pedal_index, const std::size_t vel_index);
+  void logMapUpdate(
+    const bool accel_map, const std::size_t pedal_index, const std::size_t vel_index);
+  void logWholeMap();
   bool updateAccelBrakeMap();
   void publishFloat32(const std::string publish_type, const double val);
   void publishUpdateSuggestFlag();
@@ -237,9 +274,9 @@ private:
   double calculateEstimatedAcc(
     const double throttle, const double brake, const double vel, AccelMap & accel_map,
     BrakeMap & brake_map);
-  double calculateAccelSquaredError(
-    const double throttle, const double brake, const double vel, AccelMap & accel_map,
-    BrakeMap & brake_map);
+  double calculateUpdatedMapEstimatedAcc(
+    const double throttle, const double brake, const double vel);
+  double calculateAccelSquaredError(const double estimated_acc);
   std::vector<double> getMapColumnFromUnifiedIndex(
     const std::vector<std::vector<double>> & accel_map_value,
     const std::vector<std::vector<double>> & brake_map_value, const std::size_t index);
@@ -312,6 +349,7 @@ private:
 
 public:
   explicit AccelBrakeMapCalibrator(const rclcpp::NodeOptions & node_options);
+  ~AccelBrakeMapCalibrator() override;
 };
 
 #endif  // ACCEL_BRAKE_MAP_CALIBRATOR__ACCEL_BRAKE_MAP_CALIBRATOR_NODE_HPP_
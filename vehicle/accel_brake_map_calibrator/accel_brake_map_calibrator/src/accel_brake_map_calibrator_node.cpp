@@ -19,13 +19,43 @@
 #include "rclcpp/logging.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <queue>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+namespace
+{
+// same interpolation as AccelMap/BrakeMap::getAcceleration, without copying the map
+double interpolateMapValue(
+  const std::vector<double> & vel_index, const std::vector<double> & pedal_index,
+  const std::vector<std::vector<double>> & map_value, double pedal, double vel)
+{
+  using raw_vehicle_cmd_converter::LinearInterpolate;
+
+  vel = std::min(std::max(vel, vel_index.front()), vel_index.back());
+  pedal = std::min(std::max(pedal, pedal_index.front()), pedal_index.back());
+  if (pedal_index.size() < 2) {
+    return LinearInterpolate::interpolateSorted(vel_index, map_value.front(), vel);
+  }
+
+  const auto itr = std::upper_bound(pedal_index.begin() + 1, pedal_index.end() - 1, pedal);
+  const std::size_t i = static_cast<std::size_t>(std::distance(pedal_index.begin(), itr));
+  const double prev_acc = LinearInterpolate::interpolateSorted(vel_index, map_value.at(i - 1), vel);
+  const double next_acc = LinearInterpolate::interpolateSorted(vel_index, map_value.at(i), vel);
+  const double pedal_diff = pedal_index.at(i) - pedal_index.at(i - 1);
+  if (pedal_diff <= 0.0) {
+    return next_acc;
+  }
+  const double ratio = (pedal - pedal_index.at(i - 1)) / pedal_diff;
+  return (1.0 - ratio) * prev_acc + ratio * next_acc;
+}
+}  // namespace
+
 AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & node_options)
 : Node("accel_brake_map_calibrator", node_options)
 {
@@ -93,17 +123,13 @@ AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & nod
 
     std::string csv_path_accel_map = csv_default_map_dir_ + "/accel_map.csv";
     std::string csv_path_brake_map = csv_default_map_dir_ + "/brake_map.csv";
-    if (
-      !accel_map_.readAccelMapFromCSV(csv_path_accel_map) ||
-      !new_accel_map_.readAccelMapFromCSV(csv_path_accel_map)) {
+    if (!accel_map_.readAccelMapFromCSV(csv_path_accel_map)) {
       RCLCPP_ERROR_STREAM(
         rclcpp::get_logger("accel_brake_map_calibrator"),
         "Cannot read accelmap. csv path = " << csv_path_accel_map.c_str() << ". stop calculation.");
       return;
     }
-    if (
-      !brake_map_.readBrakeMapFromCSV(csv_path_brake_map) ||
-      !new_brake_map_.readBrakeMapFromCSV(csv_path_brake_map)) {
+    if (!brake_map_.readBrakeMapFromCSV(csv_path_brake_map)) {
       RCLCPP_ERROR_STREAM(
         rclcpp::get_logger("accel_brake_map_calibrator"),
         "Cannot read brakemap. csv path = " << csv_path_brake_map.c_str() << ". stop calculation.");
@@ -116,6 +142,17 @@ AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & nod
   output_log_.open(output_log_file);
   addIndexToCSV(&output_log_);
 
+  // the updated cells are appended to the log instead of rewriting the csv files periodically
+  if (progress_file_output_) {
+    const std::string map_update_log_file = csv_calibrated_map_dir_ + "/map_update_log.bin";
+    map_update_log_.open(map_update_log_file, std::ios::binary | std::ios::app);
+    if (!map_update_log_.is_open()) {
+      RCLCPP_WARN(
+        rclcpp::get_logger("accel_brake_map_calibrator"), "Failed to open map update log : %s",
+        map_update_log_file.c_str());
+    }
+  }
+
   debug_values_.data.resize(num_debug_values_);
 
   // input map info
@@ -133,10 +170,16 @@ AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & nod
   for (auto & m : update_brake_map_value_) {
     m.resize(brake_map_value_.at(0).size());
   }
-  map_value_data_.resize(accel_map_value_.size() + brake_map_value_.size() - 1);
-  for (auto & m : map_value_data_) {
+  map_value_statistics_.resize(accel_map_value_.size() + brake_map_value_.size() - 1);
+  for (auto & m : map_value_statistics_) {
     m.resize(accel_map_value_.at(0).size());
   }
+  map_offset_vec_.assign(
+    accel_map_value_.size() + brake_map_value_.size() - 1,
+    std::vector<double>(accel_map_value_.at(0).size(), map_offset_));
+  covariance_vec_.assign(
+    accel_map_value_.size() + brake_map_value_.size() - 1,
+    std::vector<double>(accel_map_value_.at(0).size(), covariance_));
 
   std::copy(accel_map_value_.begin(), accel_map_value_.end(), update_accel_map_value_.begin());
   std::copy(brake_map_value_.begin(), brake_map_value_.end(), update_brake_map_value_.begin());
@@ -195,19 +238,13 @@ AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & nod
 
   // timer
   initTimer(1.0 / update_hz_);
-  initOutputCSVTimer(30.0);
 }
 
-void AccelBrakeMapCalibrator::initOutputCSVTimer(double period_s)
+AccelBrakeMapCalibrator::~AccelBrakeMapCalibrator()
 {
-  auto timer_output_csv_callback =
-    std::bind(&AccelBrakeMapCalibrator::timerCallbackOutputCSV, this);
-  const auto period_ns =
-    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(period_s));
-  timer_output_csv_ = std::make_shared<rclcpp::GenericTimer<decltype(timer_output_csv_callback)>>(
-    this->get_clock(), period_ns, std::move(timer_output_csv_callback),
-    this->get_node_base_interface()->get_context());
-  this->get_node_timers_interface()->add_timer(timer_output_csv_, nullptr);
+  // write accel/ brake map to file
+  writeMapToCSV(accel_vel_index_, accel_pedal_index_, update_accel_map_value_, output_accel_file_);
+  writeMapToCSV(brake_vel_index_, brake_pedal_index_, update_brake_map_value_, output_brake_file_);
 }
 
 void AccelBrakeMapCalibrator::initTimer(double period_s)
@@ -396,49 +433,6 @@ void AccelBrakeMapCalibrator::timerCallback()
   }
 }
 
-void AccelBrakeMapCalibrator::timerCallbackOutputCSV()
-{
-  // write accel/ brake map to file
-  const auto ros_time = std::to_string(this->now().seconds());
-  writeMapToCSV(accel_vel_index_, accel_pedal_index_, update_accel_map_value_, output_accel_file_);
-  writeMapToCSV(brake_vel_index_, brake_pedal_index_, update_brake_map_value_, output_brake_file_);
-  if (progress_file_output_) {
-    writeMapToCSV(
-      accel_vel_index_, accel_pedal_index_, update_accel_map_value_,
-      output_accel_file_ + "_" + ros_time);
-    writeMapToCSV(
-      brake_vel_index_, brake_pedal_index_, update_brake_map_value_,
-      output_brake_file_ + "_" + ros_time);
-    writeMapToCSV(
-      accel_vel_index_, accel_pedal_index_, accel_map_value_, output_accel_file_ + "_original");
-    writeMapToCSV(
-      brake_vel_index_, brake_pedal_index_, brake_map_value_, output_brake_file_ + "_original");
-  }
-
-  // update newest accel / brake map
-  // check file existence
-  std::ifstream af(output_accel_file_);
-  std::ifstream bf(output_brake_file_);
-  if (!af.is_open() || !bf.is_open()) {
-    RCLCPP_WARN(
-      rclcpp::get_logger("accel_brake_map_calibrator"), "Accel map or brake map does not exist");
-    return;
-  }
-
-  new_accel_map_ = AccelMap();
-  if (!new_accel_map_.readAccelMapFromCSV(output_accel_file_)) {
-    RCLCPP_WARN(
-      rclcpp::get_logger("accel_brake_map_calibrator"), "Cannot read accelmap. csv path = %s. ",
-      output_accel_file_.c_str());
-  }
-  new_brake_map_ = BrakeMap();
-  if (!new_brake_map_.readBrakeMapFromCSV(output_brake_file_)) {
-    RCLCPP_WARN(
-      rclcpp::get_logger("accel_brake_map_calibrator"), "Cannot read brakemap. csv path = %s. ",
-      output_brake_file_.c_str());
-  }
-}
-
 void AccelBrakeMapCalibrator::callbackTwist(
   const geometry_msgs::msg::TwistStamped::ConstSharedPtr msg)
 {
@@ -663,6 +657,88 @@ void AccelBrakeMapCalibrator::takeConsistencyOfAccelMap()
   }
 }
 
+void AccelBrakeMapCalibrator::takeConsistencyAroundCell(
+  const bool accel_map, const std::size_t pedal_index, const std::size_t vel_index)
+{
+  // Same rules as takeConsistencyOf(Accel|Brake)Map, but only from the cell whose value has been
+  // updated. Its predecessors are applied to it and the cells changed in turn are followed, in the
+  // order of the full sweep.
+  auto & map_value = accel_map ? update_accel_map_value_ : update_brake_map_value_;
+  const double bit = 1e-03;
+  const std::size_t last_ped_idx = map_value.size() - 1;
+  const std::size_t last_vel_idx = map_value.at(0).size() - 1;
+
+  std::set<std::pair<std::size_t, std::size_t>> cells{{pedal_index, vel_index}};
+  if (pedal_index > 0) {
+    cells.emplace(pedal_index - 1, vel_index);
+  }
+  if (vel_index > 0) {
+    cells.emplace(pedal_index, vel_index - 1);
+  }
+
+  while (!cells.empty()) {
+    const auto ped_idx = cells.begin()->first;
+    const auto vel_idx = cells.begin()->second;
+    cells.erase(cells.begin());
+    if (ped_idx >= last_ped_idx || vel_idx >= last_vel_idx) {
+      continue;
+    }
+
+    const double current_acc = map_value.at(ped_idx).at(vel_idx);
+    auto & next_ped_acc = map_value.at(ped_idx + 1).at(vel_idx);
+    auto & next_vel_acc = map_value.at(ped_idx).at(vel_idx + 1);
+
+    if (current_acc <= next_vel_acc) {
+      // the higher the velocity, the lower the acceleration
+      next_vel_acc = current_acc - bit;
+      logMapUpdate(accel_map, ped_idx, vel_idx + 1);
+      cells.emplace(ped_idx, vel_idx + 1);
+    }
+
+    if (accel_map && current_acc >= next_ped_acc) {
+      // the higher the accel pedal, the higher the acceleration
+      next_ped_acc = current_acc + bit;
+      logMapUpdate(accel_map, ped_idx + 1, vel_idx);
+      cells.emplace(ped_idx + 1, vel_idx);
+    } else if (!accel_map && current_acc <= next_ped_acc) {
+      // the higher the brake pedal, the lower the acceleration
+      next_ped_acc = current_acc - bit;
+      logMapUpdate(accel_map, ped_idx + 1, vel_idx);
+      cells.emplace(ped_idx + 1, vel_idx);
+    }
+  }
+}
+
+void AccelBrakeMapCalibrator::logMapUpdate(
+  const bool accel_map, const std::size_t pedal_index, const std::size_t vel_index)
+{
+  if (!map_update_log_.is_open()) {
+    return;
+  }
+  const auto & map_value = accel_map ? update_accel_map_value_ : update_brake_map_value_;
+  MapUpdateRecord record;
+  record.stamp = this->now().seconds();
+  record.is_accel_map = accel_map ? 1 : 0;
+  record.pedal_index = static_cast<uint8_t>(pedal_index);
+  record.vel_index = static_cast<uint8_t>(vel_index);
+  record.value = map_value.at(pedal_index).at(vel_index);
+  map_update_log_.write(reinterpret_cast<const char *>(&record), sizeof(record));
+}
+
+void AccelBrakeMapCalibrator::logWholeMap()
+{
+  for (std::size_t ped_idx = 0; ped_idx < update_accel_map_value_.size(); ped_idx++) {
+    for (std::size_t vel_idx = 0; vel_idx < update_accel_map_value_.at(0).size(); vel_idx++) {
+      logMapUpdate(true, ped_idx, vel_idx);
+    }
+  }
+  for (std::size_t ped_idx = 0; ped_idx < update_brake_map_value_.size(); ped_idx++) {
+    for (std::size_t vel_idx = 0; vel_idx < update_brake_map_value_.at(0).size(); vel_idx++) {
+      logMapUpdate(false, ped_idx, vel_idx);
+    }
+  }
+}
+
 void AccelBrakeMapCalibrator::takeConsistencyOfBrakeMap()
 {
   const double bit = 1e-03;
@@ -735,20 +811,30 @@ bool AccelBrakeMapCalibrator::updateAccelBrakeMap()
   // update map
   executeUpdate(accel_mode, accel_pedal_index, accel_vel_index, brake_pedal_index, brake_vel_index);
 
+  if (update_method_ == UPDATE_METHOD::UPDATE_OFFSET_TOTAL) {
+    // the whole map has been offset
+    takeConsistencyOfAccelMap();
+    takeConsistencyOfBrakeMap();
+    logWholeMap();
+    return true;
+  }
+
+  const std::size_t pedal_index = accel_mode ? accel_pedal_index : brake_pedal_index;
+  const std::size_t vel_index = accel_mode ? accel_vel_index : brake_vel_index;
+  logMapUpdate(accel_mode, pedal_index, vel_index);
+
   // when update 0 pedal index, update another map
-  if (accel_mode && accel_pedal_index == 0) {
-    // copy accel map value to brake map value
-    update_brake_map_value_.at(accel_pedal_index).at(accel_vel_index) =
-      update_accel_map_value_.at(accel_pedal_index).at(accel_vel_index);
-  } else if (!accel_mode && brake_pedal_index == 0) {
-    // copy brake map value to accel map value
-    update_accel_map_value_.at(brake_pedal_index).at(brake_vel_index) =
-      update_brake_map_value_.at(brake_pedal_index).at(brake_vel_index);
+  if (pedal_index == 0) {
+    auto & updated_map_value = accel_mode ? update_accel_map_value_ : update_brake_map_value_;
+    auto & other_map_value = accel_mode ? update_brake_map_value_ : update_accel_map_value_;
+    // copy accel (brake) map value to brake (accel) map value
+    other_map_value.at(pedal_index).at(vel_index) = updated_map_value.at(pedal_index).at(vel_index);
+    logMapUpdate(!accel_mode, pedal_index, vel_index);
+    takeConsistencyAroundCell(!accel_mode, pedal_index, vel_index);
   }
 
-  // take consistency of map
-  takeConsistencyOfAccelMap();
-  takeConsistencyOfBrakeMap();
+  // take consistency of map around the updated cell
+  takeConsistencyAroundCell(accel_mode, pedal_index, vel_index);
 
   return true;
 }
@@ -774,12 +860,10 @@ void AccelBrakeMapCalibrator::executeUpdate(
   }
 
   // add accel data to map
-  accel_mode ? map_value_data_.at(getUnifiedIndexFromAccelBrakeIndex(true, accel_pedal_index))
-                 .at(accel_vel_index)
-                 .emplace_back(measured_acc)
-             : map_value_data_.at(getUnifiedIndexFromAccelBrakeIndex(false, brake_pedal_index))
-                 .at(brake_vel_index)
-                 .emplace_back(measured_acc);
+  const int pedal_index = getUnifiedIndexFromAccelBrakeIndex(
+    accel_mode, accel_mode ? accel_pedal_index : brake_pedal_index);
+  const int vel_index = accel_mode ? accel_vel_index : brake_vel_index;
+  map_value_statistics_.at(pedal_index).at(vel_index).add(measured_acc);
 }
 
 bool AccelBrakeMapCalibrator::updateEachValOffset(
@@ -787,14 +871,6 @@ bool AccelBrakeMapCalibrator::updateEachValOffset(
   const int brake_pedal_index, const int brake_vel_index, const double measured_acc,
   const double map_acc)
 {
-  // pre-defined
-  static std::vector<std::vector<double>> map_offset_vec_(
-    accel_map_value_.size() + brake_map_value_.size() - 1,
-    std::vector<double>(accel_map_value_.at(0).size(), map_offset_));
-  static std::vector<std::vector<double>> covariance_vec_(
-    accel_map_value_.size() + brake_map_value_.size() - 1,
-    std::vector<double>(accel_map_value_.at(0).size(), covariance_));
-
   const int vel_idx = accel_mode ? accel_vel_index : brake_vel_index;
   int ped_idx = accel_mode ? accel_pedal_index : brake_pedal_index;
   ped_idx = getUnifiedIndexFromAccelBrakeIndex(accel_mode, ped_idx);
@@ -909,21 +985,19 @@ double AccelBrakeMapCalibrator::getPitchCompensatedAcceleration()
 
 void AccelBrakeMapCalibrator::executeEvaluation()
 {
-  const double full_orig_accel_sq_error = calculateAccelSquaredError(
+  const double original_estimated_acc = calculateEstimatedAcc(
     delayed_accel_pedal_ptr_->data, delayed_brake_pedal_ptr_->data, twist_ptr_->twist.linear.x,
     accel_map_, brake_map_);
+  const double full_orig_accel_sq_error = calculateAccelSquaredError(original_estimated_acc);
   pushDataToVec(full_orig_accel_sq_error, full_mse_que_size_, &full_original_accel_mse_que_);
   full_original_accel_rmse_ = getAverage(full_original_accel_mse_que_);
 
-  const double part_orig_accel_sq_error = calculateAccelSquaredError(
-    delayed_accel_pedal_ptr_->data, delayed_brake_pedal_ptr_->data, twist_ptr_->twist.linear.x,
-    accel_map_, brake_map_);
+  const double part_orig_accel_sq_error = calculateAccelSquaredError(original_estimated_acc);
   pushDataToVec(part_orig_accel_sq_error, part_mse_que_size_, &part_original_accel_mse_que_);
   part_original_accel_rmse_ = getAverage(part_original_accel_mse_que_);
 
-  const double new_accel_sq_error = calculateAccelSquaredError(
-    delayed_accel_pedal_ptr_->data, delayed_brake_pedal_ptr_->data, twist_ptr_->twist.linear.x,
-    new_accel_map_, new_brake_map_);
+  const double new_accel_sq_error = calculateAccelSquaredError(calculateUpdatedMapEstimatedAcc(
+    delayed_accel_pedal_ptr_->data, delayed_brake_pedal_ptr_->data, twist_ptr_->twist.linear.x));
   pushDataToVec(new_accel_sq_error, part_mse_que_size_, &new_accel_mse_que_);
   new_accel_rmse_ = getAverage(new_accel_mse_que_);
 }
@@ -944,11 +1018,21 @@ double AccelBrakeMapCalibrator::calculateEstimatedAcc(
   return estimated_acc;
 }
 
-double AccelBrakeMapCalibrator::calculateAccelSquaredError(
-  const double throttle, const double brake, const double vel, AccelMap & accel_map,
-  BrakeMap & brake_map)
+double AccelBrakeMapCalibrator::calculateUpdatedMapEstimatedAcc(
+  const double throttle, const double brake, const double vel)
+{
+  const double pedal = throttle - brake;
+
+  if (pedal > 0.0) {
+    return interpolateMapValue(
+      accel_vel_index_, accel_pedal_index_, update_accel_map_value_, pedal, vel);
+  }
+  return interpolateMapValue(
+    brake_vel_index_, brake_pedal_index_, update_brake_map_value_, -pedal, vel);
+}
+
+double AccelBrakeMapCalibrator::calculateAccelSquaredError(const double estimated_acc)
 {
-  const double estimated_acc = calculateEstimatedAcc(throttle, brake, vel, accel_map, brake_map);
   const double measured_acc = acceleration_ - getPitchCompensatedAcceleration();
   const double dif_acc = measured_acc - estimated_acc;
   return dif_acc * dif_acc;
@@ -1196,26 +1280,26 @@ void AccelBrakeMapCalibrator::publishCountMap()
 
   for (int i = 0; i < h; i++) {
     for (int j = 0; j < w; j++) {
-      const auto data_vec = map_value_data_.at(i).at(j);
-      if (data_vec.empty()) {
+      const auto & statistics = map_value_statistics_.at(i).at(j);
+      if (statistics.count == 0) {
         // input *UNKNOWN* value
         count_map.at(i * w + j) = -1;
         ave_map.at(i * w + j) = -1;
       } else {
         const auto count_rate =
-          MAX_OCC_VALUE * (static_cast<double>(data_vec.size()) / max_data_count_);
+          MAX_OCC_VALUE * (static_cast<double>(statistics.count) / max_data_count_);
         count_map.at(i * w + j) = static_cast<int8_t>(
           std::max(std::min(static_cast<int>(MAX_OCC_VALUE), static_cast<int>(count_rate)), 0));
         // calculate average
         {
-          const double average = getAverage(data_vec);
+          const double average = statistics.average;
           int8_t int_average = static_cast<uint8_t>(
             MAX_OCC_VALUE * ((average - min_accel_) / (max_accel_ - min_accel_)));
           ave_map.at(i * w + j) = std::max(std::min(MAX_OCC_VALUE, int_average), (int8_t)0);
         }
         // calculate standard deviation
         {
-          const double std_dev = getStandardDeviation(data_vec);
+          const double std_dev = statistics.getStandardDeviation();
           const double max_std_dev = 0.2;
           const double min_std_dev = 0.0;
           int8_t int_std_dev = static_cast<uint8_t>(
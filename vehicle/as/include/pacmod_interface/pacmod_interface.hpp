@@ -35,10 +35,7 @@
 #include <pacmod_msgs/msg/system_rpt_float.hpp>
 #include <pacmod_msgs/msg/system_rpt_int.hpp>
 #include <pacmod_msgs/msg/wheel_speed_rpt.hpp>
-
-#include <message_filters/subscriber.h>
-#include <message_filters/sync_policies/approximate_time.h>
-#include <message_filters/synchronizer.h>
+#include <std_msgs/msg/header.hpp>
 
 #include <algorithm>
 #include <cmath>
@@ -52,12 +49,6 @@ public:
   PacmodInterface();
 
 private:
-  typedef message_filters::sync_policies::ApproximateTime<
-    pacmod_msgs::msg::SystemRptFloat, pacmod_msgs::msg::WheelSpeedRpt,
-    pacmod_msgs::msg::SystemRptFloat, pacmod_msgs::msg::SystemRptFloat,
-    pacmod_msgs::msg::SystemRptInt, pacmod_msgs::msg::SystemRptInt, pacmod_msgs::msg::GlobalRpt>
-    PacmodFeedbacksSyncPolicy;
-
   /* subscribers */
   // From Autoware
   rclcpp::Subscription<autoware_control_msgs::msg::ControlCommandStamped>::SharedPtr
@@ -69,17 +60,14 @@ private:
     actuation_cmd_sub_;
   rclcpp::Subscription<autoware_vehicle_msgs::msg::VehicleCommand>::SharedPtr vehicle_cmd_sub_;
 
-  // From Pacmod
-  std::unique_ptr<message_filters::Subscriber<pacmod_msgs::msg::SystemRptFloat>>
-    steer_wheel_rpt_sub_;
-  std::unique_ptr<message_filters::Subscriber<pacmod_msgs::msg::WheelSpeedRpt>>
-    wheel_speed_rpt_sub_;
-  std::unique_ptr<message_filters::Subscriber<pacmod_msgs::msg::SystemRptFloat>> accel_rpt_sub_;
-  std::unique_ptr<message_filters::Subscriber<pacmod_msgs::msg::SystemRptFloat>> brake_rpt_sub_;
-  std::unique_ptr<message_filters::Subscriber<pacmod_msgs::msg::SystemRptInt>> shift_rpt_sub_;
-  std::unique_ptr<message_filters::Subscriber<pacmod_msgs::msg::SystemRptInt>> turn_rpt_sub_;
-  std::unique_ptr<message_filters::Subscriber<pacmod_msgs::msg::GlobalRpt>> global_rpt_sub_;
-  std::unique_ptr<message_filters::Synchronizer<PacmodFeedbacksSyncPolicy>> pacmod_feedbacks_sync_;
+  // From Pacmod, each report updates the status from the latest values of the others
+  rclcpp::Subscription<pacmod_msgs::msg::SystemRptFloat>::SharedPtr steer_wheel_rpt_sub_;
+  rclcpp::Subscription<pacmod_msgs::msg::WheelSpeedRpt>::SharedPtr wheel_speed_rpt_sub_;
+  rclcpp::Subscription<pacmod_msgs::msg::SystemRptFloat>::SharedPtr accel_rpt_sub_;
+  rclcpp::Subscription<pacmod_msgs::msg::SystemRptFloat>::SharedPtr brake_rpt_sub_;
+  rclcpp::Subscription<pacmod_msgs::msg::SystemRptInt>::SharedPtr shift_rpt_sub_;
+  rclcpp::Subscription<pacmod_msgs::msg::SystemRptInt>::SharedPtr turn_rpt_sub_;
+  rclcpp::Subscription<pacmod_msgs::msg::GlobalRpt>::SharedPtr global_rpt_sub_;
 
   /* publishers */
   // To Pacmod
@@ -105,7 +93,6 @@ private:
   /* ros param */
   std::string base_frame_id_;
   int command_timeout_ms_;  // vehicle_cmd timeout [ms]
-  bool is_pacmod_rpt_received_ = false;
   bool is_pacmod_enabled_ = false;
   bool is_clear_override_needed_ = false;
   bool prev_override_ = false;
@@ -157,6 +144,7 @@ private:
   rclcpp::Time control_command_received_time_;
   rclcpp::Time actuation_command_received_time_;
   rclcpp::Time last_shift_inout_matched_time_;
+  rclcpp::Time commands_published_time_;
 
   /* callbacks */
   void callbackActuationCmd(
@@ -167,16 +155,20 @@ private:
   void callbackShiftCmd(const autoware_vehicle_msgs::msg::ShiftStamped::ConstSharedPtr msg);
   void callbackTurnSignalCmd(const autoware_vehicle_msgs::msg::TurnSignal::ConstSharedPtr msg);
   void callbackEngage(const autoware_vehicle_msgs::msg::Engage::ConstSharedPtr msg);
-  void callbackPacmodRpt(
-    const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr steer_wheel_rpt,
-    const pacmod_msgs::msg::WheelSpeedRpt::ConstSharedPtr wheel_speed_rpt,
-    const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr accel_rpt,
-    const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr brake_rpt,
-    const pacmod_msgs::msg::SystemRptInt::ConstSharedPtr shift_rpt,
-    const pacmod_msgs::msg::SystemRptInt::ConstSharedPtr turn_rpt,
-    const pacmod_msgs::msg::GlobalRpt::ConstSharedPtr global_rpt);
+  void callbackSteerWheelRpt(const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr msg);
+  void callbackWheelSpeedRpt(const pacmod_msgs::msg::WheelSpeedRpt::ConstSharedPtr msg);
+  void callbackAccelRpt(const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr msg);
+  void callbackBrakeRpt(const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr msg);
+  void callbackShiftRpt(const pacmod_msgs::msg::SystemRptInt::ConstSharedPtr msg);
+  void callbackTurnRpt(const pacmod_msgs::msg::SystemRptInt::ConstSharedPtr msg);
+  void callbackGlobalRpt(const pacmod_msgs::msg::GlobalRpt::ConstSharedPtr msg);
+  void onTimer();
 
   /*  functions */
+  bool isPacmodRptReceived() const;
+  void updatePacmodEnabled();
+  double calculateCurrentSteer();
+  std_msgs::msg::Header createStatusHeader();
   void publishCommands();
   double calculateVehicleVelocity(
     const pacmod_msgs::msg::WheelSpeedRpt & wheel_speed_rpt,
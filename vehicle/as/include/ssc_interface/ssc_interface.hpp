@@ -19,13 +19,11 @@
 #include <rclcpp/rclcpp.hpp>
 
 #include <automotive_navigation_msgs/msg/module_state.hpp>
-#include <automotive_platform_msgs/msg/brake_feedback.hpp>
 #include <automotive_platform_msgs/msg/curvature_feedback.hpp>
 #include <automotive_platform_msgs/msg/gear_command.hpp>
 #include <automotive_platform_msgs/msg/gear_feedback.hpp>
 #include <automotive_platform_msgs/msg/speed_mode.hpp>
 #include <automotive_platform_msgs/msg/steer_mode.hpp>
-#include <automotive_platform_msgs/msg/throttle_feedback.hpp>
 #include <automotive_platform_msgs/msg/turn_signal_command.hpp>
 #include <automotive_platform_msgs/msg/velocity_accel_cov.hpp>
 #include <autoware_debug_msgs/msg/float32_stamped.hpp>
@@ -41,10 +39,6 @@
 #include <pacmod_msgs/msg/wheel_speed_rpt.hpp>
 #include <std_msgs/msg/header.hpp>
 
-#include <message_filters/subscriber.h>
-#include <message_filters/sync_policies/approximate_time.h>
-#include <message_filters/synchronizer.h>
-
 #include <memory>
 #include <string>
 
@@ -57,34 +51,20 @@ public:
   ~SSCInterface();
 
 private:
-  typedef message_filters::sync_policies::ApproximateTime<
-    automotive_platform_msgs::msg::VelocityAccelCov,
-    automotive_platform_msgs::msg::CurvatureFeedback,
-    automotive_platform_msgs::msg::ThrottleFeedback, automotive_platform_msgs::msg::BrakeFeedback,
-    automotive_platform_msgs::msg::GearFeedback, pacmod_msgs::msg::WheelSpeedRpt,
-    pacmod_msgs::msg::SystemRptFloat>
-    SSCFeedbacksSyncPolicy;
-
   // subscribers
   rclcpp::Subscription<autoware_vehicle_msgs::msg::VehicleCommand>::SharedPtr vehicle_cmd_sub_;
   rclcpp::Subscription<autoware_vehicle_msgs::msg::TurnSignal>::SharedPtr turn_signal_cmd_sub_;
   rclcpp::Subscription<autoware_vehicle_msgs::msg::Engage>::SharedPtr engage_sub_;
   rclcpp::Subscription<automotive_navigation_msgs::msg::ModuleState>::SharedPtr module_states_sub_;
 
-  std::unique_ptr<message_filters::Subscriber<automotive_platform_msgs::msg::VelocityAccelCov>>
+  // each feedback updates the status from the latest values of the others
+  rclcpp::Subscription<automotive_platform_msgs::msg::VelocityAccelCov>::SharedPtr
     velocity_accel_cov_sub_;
-  std::unique_ptr<message_filters::Subscriber<automotive_platform_msgs::msg::CurvatureFeedback>>
+  rclcpp::Subscription<automotive_platform_msgs::msg::CurvatureFeedback>::SharedPtr
     curvature_feedback_sub_;
-  std::unique_ptr<message_filters::Subscriber<automotive_platform_msgs::msg::ThrottleFeedback>>
-    throttle_feedback_sub_;
-  std::unique_ptr<message_filters::Subscriber<automotive_platform_msgs::msg::BrakeFeedback>>
-    brake_feedback_sub_;
-  std::unique_ptr<message_filters::Subscriber<automotive_platform_msgs::msg::GearFeedback>>
-    gear_feedback_sub_;
-  std::unique_ptr<message_filters::Subscriber<pacmod_msgs::msg::WheelSpeedRpt>> wheel_speed_sub_;
-  std::unique_ptr<message_filters::Subscriber<pacmod_msgs::msg::SystemRptFloat>>
-    steering_wheel_sub_;
-  std::unique_ptr<message_filters::Synchronizer<SSCFeedbacksSyncPolicy>> ssc_feedbacks_sync_;
+  rclcpp::Subscription<automotive_platform_msgs::msg::GearFeedback>::SharedPtr gear_feedback_sub_;
+  rclcpp::Subscription<pacmod_msgs::msg::WheelSpeedRpt>::SharedPtr wheel_speed_sub_;
+  rclcpp::Subscription<pacmod_msgs::msg::SystemRptFloat>::SharedPtr steering_wheel_sub_;
 
   // TEMP to support turn_signal
   rclcpp::Subscription<pacmod_msgs::msg::SystemRptInt>::SharedPtr pacmod_turn_sub_;
@@ -133,8 +113,8 @@ private:
   bool command_initialized_ = false;
   bool shift_cmd_initialized_ = false;
   bool turn_signal_cmd_initialized_ = false;
-  double adaptive_gear_ratio_;
   rclcpp::Time command_time_;
+  rclcpp::Time command_published_time_;
   autoware_vehicle_msgs::msg::VehicleCommand vehicle_cmd_;
   autoware_vehicle_msgs::msg::TurnSignal turn_signal_cmd_;
   automotive_navigation_msgs::msg::ModuleState module_states_;
@@ -142,6 +122,8 @@ private:
   pacmod_msgs::msg::WheelSpeedRpt::ConstSharedPtr wheel_speed_rpt_ptr_;
   automotive_platform_msgs::msg::VelocityAccelCov::ConstSharedPtr vel_acc_cov_ptr_;
   automotive_platform_msgs::msg::GearFeedback::ConstSharedPtr gear_feedback_ptr_;
+  automotive_platform_msgs::msg::CurvatureFeedback::ConstSharedPtr curvature_feedback_ptr_;
+  pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr steering_wheel_rpt_ptr_;
 
   // callbacks
   void callbackFromVehicleCmd(const autoware_vehicle_msgs::msg::VehicleCommand::ConstSharedPtr msg);
@@ -149,23 +131,26 @@ private:
   void callbackFromEngage(const autoware_vehicle_msgs::msg::Engage::ConstSharedPtr msg);
   void callbackFromSSCModuleStates(
     const automotive_navigation_msgs::msg::ModuleState::ConstSharedPtr msg);
-  void callbackFromSSCFeedbacks(
-    const automotive_platform_msgs::msg::VelocityAccelCov::ConstSharedPtr msg_velocity,
-    const automotive_platform_msgs::msg::CurvatureFeedback::ConstSharedPtr msg_curvature,
-    const automotive_platform_msgs::msg::ThrottleFeedback::ConstSharedPtr msg_throttle,
-    const automotive_platform_msgs::msg::BrakeFeedback::ConstSharedPtr msg_brake,
-    const automotive_platform_msgs::msg::GearFeedback::ConstSharedPtr msg_gear,
-    const pacmod_msgs::msg::WheelSpeedRpt::ConstSharedPtr msg_wheel_speed,
-    const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr msg_steering_wheel);
+  void callbackFromVelocityAccelCov(
+    const automotive_platform_msgs::msg::VelocityAccelCov::ConstSharedPtr msg);
+  void callbackFromCurvatureFeedback(
+    const automotive_platform_msgs::msg::CurvatureFeedback::ConstSharedPtr msg);
+  void callbackFromGearFeedback(
+    const automotive_platform_msgs::msg::GearFeedback::ConstSharedPtr msg);
+  void callbackFromWheelSpeedRpt(const pacmod_msgs::msg::WheelSpeedRpt::ConstSharedPtr msg);
+  void callbackFromSteeringWheelRpt(const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr msg);
   void callbackTurnSignal(const pacmod_msgs::msg::SystemRptInt::ConstSharedPtr turn);
+  void onTimer();
 
   // functions
   void publishCommand();
-  double calculateVehicleVelocity(
-    const pacmod_msgs::msg::WheelSpeedRpt & wheel_speed_rpt,
-    const automotive_platform_msgs::msg::VelocityAccelCov & vel_acc_cov,
-    const automotive_platform_msgs::msg::GearFeedback & gear_feedback,
-    const bool use_rear_wheel_speed);
+  void publishTwist(const builtin_interfaces::msg::Time & stamp);
+  void publishSteering(const builtin_interfaces::msg::Time & stamp);
+  bool isVelocityReceived() const;
+  bool isCurvatureReceived() const;
+  double calculateVehicleVelocity() const;
+  double calculateAdaptiveGearRatio() const;
+  double calculateCurvature() const;
   uint8_t toSSCShiftCmd(const autoware_vehicle_msgs::msg::Shift & shift);
   int32_t toAutowareTurnSignal(const pacmod_msgs::msg::SystemRptInt & turn) const;
 };
@@ -60,6 +60,7 @@ PacmodInterface::PacmodInterface()
   /* initialize */
   prev_steer_cmd_.header.stamp = this->now();
   prev_steer_cmd_.command = 0.0;
+  commands_published_time_ = this->now();
 
   /* subscribers */
   using std::placeholders::_1;
@@ -80,33 +81,27 @@ PacmodInterface::PacmodInterface()
     "/control/vehicle_cmd", 1, std::bind(&PacmodInterface::callbackVehicleCmd, this, _1));
 
   // From pacmod
-
-  steer_wheel_rpt_sub_ =
-    std::make_unique<message_filters::Subscriber<pacmod_msgs::msg::SystemRptFloat>>(
-      this, "/pacmod/parsed_tx/steer_rpt");
-  wheel_speed_rpt_sub_ =
-    std::make_unique<message_filters::Subscriber<pacmod_msgs::msg::WheelSpeedRpt>>(
-      this, "/pacmod/parsed_tx/wheel_speed_rpt");
-  accel_rpt_sub_ = std::make_unique<message_filters::Subscriber<pacmod_msgs::msg::SystemRptFloat>>(
-    this, "/pacmod/parsed_tx/accel_rpt");
-  brake_rpt_sub_ = std::make_unique<message_filters::Subscriber<pacmod_msgs::msg::SystemRptFloat>>(
-    this, "/pacmod/parsed_tx/brake_rpt");
-  shift_rpt_sub_ = std::make_unique<message_filters::Subscriber<pacmod_msgs::msg::SystemRptInt>>(
-    this, "/pacmod/parsed_tx/shift_rpt");
-  turn_rpt_sub_ = std::make_unique<message_filters::Subscriber<pacmod_msgs::msg::SystemRptInt>>(
-    this, "/pacmod/parsed_tx/turn_rpt");
-  global_rpt_sub_ = std::make_unique<message_filters::Subscriber<pacmod_msgs::msg::GlobalRpt>>(
-    this, "/pacmod/parsed_tx/global_rpt");
-
-  pacmod_feedbacks_sync_ =
-    std::make_unique<message_filters::Synchronizer<PacmodFeedbacksSyncPolicy>>(
-      PacmodFeedbacksSyncPolicy(10), *steer_wheel_rpt_sub_, *wheel_speed_rpt_sub_, *accel_rpt_sub_,
-      *brake_rpt_sub_, *shift_rpt_sub_, *turn_rpt_sub_, *global_rpt_sub_);
-
-  pacmod_feedbacks_sync_->registerCallback(std::bind(
-    &PacmodInterface::callbackPacmodRpt, this, std::placeholders::_1, std::placeholders::_2,
-    std::placeholders::_3, std::placeholders::_4, std::placeholders::_5, std::placeholders::_6,
-    std::placeholders::_7));
+  steer_wheel_rpt_sub_ = create_subscription<pacmod_msgs::msg::SystemRptFloat>(
+    "/pacmod/parsed_tx/steer_rpt", rclcpp::QoS{1},
+    std::bind(&PacmodInterface::callbackSteerWheelRpt, this, _1));
+  wheel_speed_rpt_sub_ = create_subscription<pacmod_msgs::msg::WheelSpeedRpt>(
+    "/pacmod/parsed_tx/wheel_speed_rpt", rclcpp::QoS{1},
+    std::bind(&PacmodInterface::callbackWheelSpeedRpt, this, _1));
+  accel_rpt_sub_ = create_subscription<pacmod_msgs::msg::SystemRptFloat>(
+    "/pacmod/parsed_tx/accel_rpt", rclcpp::QoS{1},
+    std::bind(&PacmodInterface::callbackAccelRpt, this, _1));
+  brake_rpt_sub_ = create_subscription<pacmod_msgs::msg::SystemRptFloat>(
+    "/pacmod/parsed_tx/brake_rpt", rclcpp::QoS{1},
+    std::bind(&PacmodInterface::callbackBrakeRpt, this, _1));
+  shift_rpt_sub_ = create_subscription<pacmod_msgs::msg::SystemRptInt>(
+    "/pacmod/parsed_tx/shift_rpt", rclcpp::QoS{1},
+    std::bind(&PacmodInterface::callbackShiftRpt, this, _1));
+  turn_rpt_sub_ = create_subscription<pacmod_msgs::msg::SystemRptInt>(
+    "/pacmod/parsed_tx/turn_rpt", rclcpp::QoS{1},
+    std::bind(&PacmodInterface::callbackTurnRpt, this, _1));
+  global_rpt_sub_ = create_subscription<pacmod_msgs::msg::GlobalRpt>(
+    "/pacmod/parsed_tx/global_rpt", rclcpp::QoS{1},
+    std::bind(&PacmodInterface::callbackGlobalRpt, this, _1));
 
   /* publisher */
   // To pacmod
@@ -137,8 +132,8 @@ PacmodInterface::PacmodInterface()
   actuation_status_pub_ = create_publisher<autoware_vehicle_msgs::msg::ActuationStatusStamped>(
     "/vehicle/status/actuation_status", 1);
 
-  // Timer
-  auto timer_callback = std::bind(&PacmodInterface::publishCommands, this);
+  // Timer, which sends the commands only when no actuation command has arrived for a period
+  auto timer_callback = std::bind(&PacmodInterface::onTimer, this);
   auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
     std::chrono::duration<double>(1.0 / loop_rate_));
   timer_ = std::make_shared<rclcpp::GenericTimer<decltype(timer_callback)>>(
@@ -152,6 +147,10 @@ void PacmodInterface::callbackActuationCmd(
 {
   actuation_command_received_time_ = this->now();
   actuation_cmd_ptr_ = msg;
+
+  // The actuation command is converted from the control command, so it is the last command of a
+  // control cycle. Send the commands now instead of waiting for the timer.
+  publishCommands();
 }
 
 void PacmodInterface::callbackVehicleCmd(
@@ -185,87 +184,18 @@ void PacmodInterface::callbackEngage(const autoware_vehicle_msgs::msg::Engage::C
   is_clear_override_needed_ = true;
 }
 
-void PacmodInterface::callbackPacmodRpt(
-  const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr steer_wheel_rpt,
-  const pacmod_msgs::msg::WheelSpeedRpt::ConstSharedPtr wheel_speed_rpt,
-  const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr accel_rpt,
-  const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr brake_rpt,
-  const pacmod_msgs::msg::SystemRptInt::ConstSharedPtr shift_rpt,
-  const pacmod_msgs::msg::SystemRptInt::ConstSharedPtr turn_rpt,
-  const pacmod_msgs::msg::GlobalRpt::ConstSharedPtr global_rpt)
+void PacmodInterface::callbackSteerWheelRpt(
+  const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr msg)
 {
-  is_pacmod_rpt_received_ = true;
-  steer_wheel_rpt_ptr_ = steer_wheel_rpt;
-  wheel_speed_rpt_ptr_ = wheel_speed_rpt;
-  accel_rpt_ptr_ = accel_rpt;
-  brake_rpt_ptr_ = brake_rpt;
-  shift_rpt_ptr_ = shift_rpt;
-  global_rpt_ptr_ = global_rpt;
-  turn_rpt_ptr_ = turn_rpt;
-
-  is_pacmod_enabled_ =
-    steer_wheel_rpt_ptr_->enabled && accel_rpt_ptr_->enabled && brake_rpt_ptr_->enabled;
-  RCLCPP_DEBUG(
-    get_logger(),
-    "enabled: is_pacmod_enabled_ %d, steer %d, accel %d, brake %d, shift %d, "
-    "global %d",
-    is_pacmod_enabled_, steer_wheel_rpt_ptr_->enabled, accel_rpt_ptr_->enabled,
-    brake_rpt_ptr_->enabled, shift_rpt_ptr_->enabled, global_rpt_ptr_->enabled);
-
-  const double current_velocity = calculateVehicleVelocity(
-    *wheel_speed_rpt_ptr_, *shift_rpt_ptr_);  // current vehicle speed > 0 [m/s]
-  const double current_steer_wheel =
-    steer_wheel_rpt_ptr_->output;  // current vehicle steering wheel angle [rad]
-  const double adaptive_gear_ratio =
-    calculateVariableGearRatio(current_velocity, current_steer_wheel);
-  const double current_steer = current_steer_wheel / adaptive_gear_ratio - steering_offset_;
-
-  std_msgs::msg::Header header;
-  header.frame_id = base_frame_id_;
-  header.stamp = get_clock()->now();
-
-  /* publish vehicle status control_mode */
-  {
-    autoware_vehicle_msgs::msg::ControlMode control_mode_msg;
-    control_mode_msg.header = header;
-
-    if (!global_rpt->enabled) {
-      control_mode_msg.data = autoware_vehicle_msgs::msg::ControlMode::MANUAL;
-    } else if (is_pacmod_enabled_) {
-      control_mode_msg.data = autoware_vehicle_msgs::msg::ControlMode::AUTO;
-    } else {
-      bool is_pedal_enable = (accel_rpt_ptr_->enabled && brake_rpt_ptr_->enabled);
-      bool is_steer_enable = steer_wheel_rpt_ptr_->enabled;
-      if (is_pedal_enable) {
-        control_mode_msg.data = autoware_vehicle_msgs::msg::ControlMode::AUTO_PEDAL_ONLY;
-      } else if (is_steer_enable) {
-        control_mode_msg.data = autoware_vehicle_msgs::msg::ControlMode::AUTO_STEER_ONLY;
-      } else {
-        RCLCPP_ERROR(
-          get_logger(), "global_rpt is enable, but steer & pedal is disabled. Set mode = MANUAL");
-        control_mode_msg.data = autoware_vehicle_msgs::msg::ControlMode::MANUAL;
-      }
-    }
-
-    control_mode_pub_->publish(control_mode_msg);
-  }
+  steer_wheel_rpt_ptr_ = msg;
+  updatePacmodEnabled();
 
-  /* publish vehicle status twist */
-  {
-    geometry_msgs::msg::TwistStamped twist;
-    twist.header = header;
-    twist.twist.linear.x = current_velocity;                                           // [m/s]
-    twist.twist.angular.z = current_velocity * std::tan(current_steer) / wheel_base_;  // [rad/s]
-    vehicle_twist_pub_->publish(twist);
+  if (!wheel_speed_rpt_ptr_ || !shift_rpt_ptr_ || !accel_rpt_ptr_ || !brake_rpt_ptr_) {
+    return;
   }
 
-  /* publish current shift */
-  {
-    autoware_vehicle_msgs::msg::ShiftStamped shift_msg;
-    shift_msg.header = header;
-    shift_msg.shift.data = toAutowareShiftCmd(*shift_rpt_ptr_);
-    shift_status_pub_->publish(shift_msg);
-  }
+  const auto header = createStatusHeader();
+  const double current_steer = calculateCurrentSteer();
 
   /* publish current status */
   {
@@ -284,27 +214,157 @@ void PacmodInterface::callbackPacmodRpt(
     actuation_status.status.steer_status = current_steer;
     actuation_status_pub_->publish(actuation_status);
   }
+}
+
+void PacmodInterface::callbackWheelSpeedRpt(
+  const pacmod_msgs::msg::WheelSpeedRpt::ConstSharedPtr msg)
+{
+  wheel_speed_rpt_ptr_ = msg;
+
+  if (!steer_wheel_rpt_ptr_ || !shift_rpt_ptr_) {
+    return;
+  }
+
+  /* publish vehicle status twist */
+  const double current_velocity = calculateVehicleVelocity(
+    *wheel_speed_rpt_ptr_, *shift_rpt_ptr_);  // current vehicle speed > 0 [m/s]
+  const double current_steer = calculateCurrentSteer();
+
+  geometry_msgs::msg::TwistStamped twist;
+  twist.header = createStatusHeader();
+  twist.twist.linear.x = current_velocity;                                           // [m/s]
+  twist.twist.angular.z = current_velocity * std::tan(current_steer) / wheel_base_;  // [rad/s]
+  vehicle_twist_pub_->publish(twist);
+}
+
+void PacmodInterface::callbackAccelRpt(const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr msg)
+{
+  accel_rpt_ptr_ = msg;
+  updatePacmodEnabled();
+}
+
+void PacmodInterface::callbackBrakeRpt(const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr msg)
+{
+  brake_rpt_ptr_ = msg;
+  updatePacmodEnabled();
+}
+
+void PacmodInterface::callbackShiftRpt(const pacmod_msgs::msg::SystemRptInt::ConstSharedPtr msg)
+{
+  shift_rpt_ptr_ = msg;
+
+  /* publish current shift */
+  autoware_vehicle_msgs::msg::ShiftStamped shift_msg;
+  shift_msg.header = createStatusHeader();
+  shift_msg.shift.data = toAutowareShiftCmd(*shift_rpt_ptr_);
+  shift_status_pub_->publish(shift_msg);
+}
+
+void PacmodInterface::callbackTurnRpt(const pacmod_msgs::msg::SystemRptInt::ConstSharedPtr msg)
+{
+  turn_rpt_ptr_ = msg;
 
   /* publish current turn signal */
-  {
-    autoware_vehicle_msgs::msg::TurnSignal turn_msg;
-    turn_msg.header = header;
-    turn_msg.data = toAutowareTurnSignal(*turn_rpt);
-    turn_signal_status_pub_->publish(turn_msg);
+  autoware_vehicle_msgs::msg::TurnSignal turn_msg;
+  turn_msg.header = createStatusHeader();
+  turn_msg.data = toAutowareTurnSignal(*turn_rpt_ptr_);
+  turn_signal_status_pub_->publish(turn_msg);
+}
+
+void PacmodInterface::callbackGlobalRpt(const pacmod_msgs::msg::GlobalRpt::ConstSharedPtr msg)
+{
+  global_rpt_ptr_ = msg;
+
+  if (!steer_wheel_rpt_ptr_ || !accel_rpt_ptr_ || !brake_rpt_ptr_) {
+    return;
   }
+
+  /* publish vehicle status control_mode */
+  autoware_vehicle_msgs::msg::ControlMode control_mode_msg;
+  control_mode_msg.header = createStatusHeader();
+
+  if (!global_rpt_ptr_->enabled) {
+    control_mode_msg.data = autoware_vehicle_msgs::msg::ControlMode::MANUAL;
+  } else if (is_pacmod_enabled_) {
+    control_mode_msg.data = autoware_vehicle_msgs::msg::ControlMode::AUTO;
+  } else {
+    bool is_pedal_enable = (accel_rpt_ptr_->enabled && brake_rpt_ptr_->enabled);
+    bool is_steer_enable = steer_wheel_rpt_ptr_->enabled;
+    if (is_pedal_enable) {
+      control_mode_msg.data = autoware_vehicle_msgs::msg::ControlMode::AUTO_PEDAL_ONLY;
+    } else if (is_steer_enable) {
+      control_mode_msg.data = autoware_vehicle_msgs::msg::ControlMode::AUTO_STEER_ONLY;
+    } else {
+      RCLCPP_ERROR(
+        get_logger(), "global_rpt is enable, but steer & pedal is disabled. Set mode = MANUAL");
+      control_mode_msg.data = autoware_vehicle_msgs::msg::ControlMode::MANUAL;
+    }
+  }
+
+  control_mode_pub_->publish(control_mode_msg);
+}
+
+void PacmodInterface::onTimer()
+{
+  const double period = 1.0 / loop_rate_;
+  if ((get_clock()->now() - commands_published_time_).seconds() < period) {
+    return;
+  }
+
+  // keep sending the commands, with the emergency brake on the command timeout
+  publishCommands();
+}
+
+bool PacmodInterface::isPacmodRptReceived() const
+{
+  return steer_wheel_rpt_ptr_ && wheel_speed_rpt_ptr_ && accel_rpt_ptr_ && brake_rpt_ptr_ &&
+         shift_rpt_ptr_ && turn_rpt_ptr_ && global_rpt_ptr_;
+}
+
+void PacmodInterface::updatePacmodEnabled()
+{
+  if (!steer_wheel_rpt_ptr_ || !accel_rpt_ptr_ || !brake_rpt_ptr_) {
+    return;
+  }
+
+  is_pacmod_enabled_ =
+    steer_wheel_rpt_ptr_->enabled && accel_rpt_ptr_->enabled && brake_rpt_ptr_->enabled;
+  RCLCPP_DEBUG(
+    get_logger(), "enabled: is_pacmod_enabled_ %d, steer %d, accel %d, brake %d",
+    is_pacmod_enabled_, steer_wheel_rpt_ptr_->enabled, accel_rpt_ptr_->enabled,
+    brake_rpt_ptr_->enabled);
+}
+
+double PacmodInterface::calculateCurrentSteer()
+{
+  const double current_velocity = calculateVehicleVelocity(*wheel_speed_rpt_ptr_, *shift_rpt_ptr_);
+  const double current_steer_wheel =
+    steer_wheel_rpt_ptr_->output;  // current vehicle steering wheel angle [rad]
+  const double adaptive_gear_ratio =
+    calculateVariableGearRatio(current_velocity, current_steer_wheel);
+  return current_steer_wheel / adaptive_gear_ratio - steering_offset_;
+}
+
+std_msgs::msg::Header PacmodInterface::createStatusHeader()
+{
+  std_msgs::msg::Header header;
+  header.frame_id = base_frame_id_;
+  header.stamp = get_clock()->now();
+  return header;
 }
 
 void PacmodInterface::publishCommands()
 {
   /* guard */
-  if (!actuation_cmd_ptr_ || !control_cmd_ptr_ || !is_pacmod_rpt_received_ || !shift_cmd_ptr_) {
+  if (!actuation_cmd_ptr_ || !control_cmd_ptr_ || !isPacmodRptReceived() || !shift_cmd_ptr_) {
     RCLCPP_INFO_THROTTLE(
       get_logger(), *get_clock(), std::chrono::milliseconds(1000).count(),
-      "vehicle_cmd = %d, pacmod_msgs = %d", actuation_cmd_ptr_ != nullptr, is_pacmod_rpt_received_);
+      "vehicle_cmd = %d, pacmod_msgs = %d", actuation_cmd_ptr_ != nullptr, isPacmodRptReceived());
     return;
   }
 
   const rclcpp::Time current_time = get_clock()->now();
+  commands_published_time_ = current_time;
 
   double desired_throttle = actuation_cmd_ptr_->actuation.accel_cmd + accel_pedal_offset_;
   double desired_brake = actuation_cmd_ptr_->actuation.brake_cmd + brake_pedal_offset_;
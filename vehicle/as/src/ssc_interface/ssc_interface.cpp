@@ -14,6 +14,8 @@
 
 #include <ssc_interface/ssc_interface.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
@@ -49,35 +51,21 @@ SSCInterface::SSCInterface() : Node("ssc_interface")
     "/vehicle/engage", rclcpp::QoS{1}, std::bind(&SSCInterface::callbackFromEngage, this, _1));
 
   // subscribers from SSC and PACMod
-  velocity_accel_cov_sub_ =
-    std::make_unique<message_filters::Subscriber<automotive_platform_msgs::msg::VelocityAccelCov>>(
-      this, "as/velocity_accel_cov");
-  curvature_feedback_sub_ =
-    std::make_unique<message_filters::Subscriber<automotive_platform_msgs::msg::CurvatureFeedback>>(
-      this, "as/curvature_feedback");
-  throttle_feedback_sub_ =
-    std::make_unique<message_filters::Subscriber<automotive_platform_msgs::msg::ThrottleFeedback>>(
-      this, "as/throttle_feedback");
-  brake_feedback_sub_ =
-    std::make_unique<message_filters::Subscriber<automotive_platform_msgs::msg::BrakeFeedback>>(
-      this, "as/brake_feedback");
-  gear_feedback_sub_ =
-    std::make_unique<message_filters::Subscriber<automotive_platform_msgs::msg::GearFeedback>>(
-      this, "as/gear_feedback");
-  wheel_speed_sub_ = std::make_unique<message_filters::Subscriber<pacmod_msgs::msg::WheelSpeedRpt>>(
-    this, "pacmod/parsed_tx/wheel_speed_rpt");
-  steering_wheel_sub_ =
-    std::make_unique<message_filters::Subscriber<pacmod_msgs::msg::SystemRptFloat>>(
-      this, "pacmod/parsed_tx/steer_rpt");
-
-  ssc_feedbacks_sync_ = std::make_unique<message_filters::Synchronizer<SSCFeedbacksSyncPolicy>>(
-    SSCFeedbacksSyncPolicy(10), *velocity_accel_cov_sub_, *curvature_feedback_sub_,
-    *throttle_feedback_sub_, *brake_feedback_sub_, *gear_feedback_sub_, *wheel_speed_sub_,
-    *steering_wheel_sub_);
-
-  ssc_feedbacks_sync_->registerCallback(std::bind(
-    &SSCInterface::callbackFromSSCFeedbacks, this, _1, std::placeholders::_2, std::placeholders::_3,
-    std::placeholders::_4, std::placeholders::_5, std::placeholders::_6, std::placeholders::_7));
+  velocity_accel_cov_sub_ = create_subscription<automotive_platform_msgs::msg::VelocityAccelCov>(
+    "as/velocity_accel_cov", rclcpp::QoS{1},
+    std::bind(&SSCInterface::callbackFromVelocityAccelCov, this, _1));
+  curvature_feedback_sub_ = create_subscription<automotive_platform_msgs::msg::CurvatureFeedback>(
+    "as/curvature_feedback", rclcpp::QoS{1},
+    std::bind(&SSCInterface::callbackFromCurvatureFeedback, this, _1));
+  gear_feedback_sub_ = create_subscription<automotive_platform_msgs::msg::GearFeedback>(
+    "as/gear_feedback", rclcpp::QoS{1},
+    std::bind(&SSCInterface::callbackFromGearFeedback, this, _1));
+  wheel_speed_sub_ = create_subscription<pacmod_msgs::msg::WheelSpeedRpt>(
+    "pacmod/parsed_tx/wheel_speed_rpt", rclcpp::QoS{1},
+    std::bind(&SSCInterface::callbackFromWheelSpeedRpt, this, _1));
+  steering_wheel_sub_ = create_subscription<pacmod_msgs::msg::SystemRptFloat>(
+    "pacmod/parsed_tx/steer_rpt", rclcpp::QoS{1},
+    std::bind(&SSCInterface::callbackFromSteeringWheelRpt, this, _1));
 
   module_states_sub_ = create_subscription<automotive_navigation_msgs::msg::ModuleState>(
     "as/module_states", rclcpp::QoS{1},
@@ -118,8 +106,9 @@ SSCInterface::SSCInterface() : Node("ssc_interface")
   gear_pub_ =
     create_publisher<automotive_platform_msgs::msg::GearCommand>("as/gear_select", durable_qos);
 
-  // Timer
-  auto timer_callback = std::bind(&SSCInterface::publishCommand, this);
+  // Timer, which sends the command only when no vehicle command has arrived for a period
+  command_published_time_ = get_clock()->now();
+  auto timer_callback = std::bind(&SSCInterface::onTimer, this);
   auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
     std::chrono::duration<double>(1.0 / loop_rate_));
   timer_ = std::make_shared<rclcpp::GenericTimer<decltype(timer_callback)>>(
@@ -136,6 +125,9 @@ void SSCInterface::callbackFromVehicleCmd(
   command_time_ = get_clock()->now();
   vehicle_cmd_ = *msg;
   command_initialized_ = true;
+
+  // send the command now instead of waiting for the timer
+  publishCommand();
 }
 void SSCInterface::callbackFromTurnSignalCmd(
   const autoware_vehicle_msgs::msg::TurnSignal::ConstSharedPtr msg)
@@ -156,38 +148,90 @@ void SSCInterface::callbackFromSSCModuleStates(
   }
 }
 
-void SSCInterface::callbackFromSSCFeedbacks(
-  const automotive_platform_msgs::msg::VelocityAccelCov::ConstSharedPtr msg_velocity,
-  const automotive_platform_msgs::msg::CurvatureFeedback::ConstSharedPtr msg_curvature,
-  const automotive_platform_msgs::msg::ThrottleFeedback::ConstSharedPtr msg_throttle,
-  const automotive_platform_msgs::msg::BrakeFeedback::ConstSharedPtr msg_brake,
-  const automotive_platform_msgs::msg::GearFeedback::ConstSharedPtr msg_gear,
-  const pacmod_msgs::msg::WheelSpeedRpt::ConstSharedPtr msg_wheel_speed,
-  const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr msg_steering_wheel)
+void SSCInterface::callbackFromVelocityAccelCov(
+  const automotive_platform_msgs::msg::VelocityAccelCov::ConstSharedPtr msg)
+{
+  vel_acc_cov_ptr_ = msg;
+  if (!use_rear_wheel_speed_) {
+    publishTwist(msg->header.stamp);
+  }
+}
+
+void SSCInterface::callbackFromCurvatureFeedback(
+  const automotive_platform_msgs::msg::CurvatureFeedback::ConstSharedPtr msg)
 {
+  curvature_feedback_ptr_ = msg;
+  if (!use_adaptive_gear_ratio_) {
+    publishSteering(msg->header.stamp);
+  }
+}
+
+void SSCInterface::callbackFromGearFeedback(
+  const automotive_platform_msgs::msg::GearFeedback::ConstSharedPtr msg)
+{
+  gear_feedback_ptr_ = msg;
+
+  // gearshift
+  autoware_vehicle_msgs::msg::ShiftStamped shift_msg;
+  shift_msg.header.frame_id = BASE_FRAME_ID;
+  shift_msg.header.stamp = msg->header.stamp;
+  if (msg->current_gear.gear == automotive_platform_msgs::msg::Gear::NONE) {
+    shift_msg.shift.data = autoware_vehicle_msgs::msg::Shift::NONE;
+  } else if (msg->current_gear.gear == automotive_platform_msgs::msg::Gear::PARK) {
+    shift_msg.shift.data = autoware_vehicle_msgs::msg::Shift::PARKING;
+  } else if (msg->current_gear.gear == automotive_platform_msgs::msg::Gear::REVERSE) {
+    shift_msg.shift.data = autoware_vehicle_msgs::msg::Shift::REVERSE;
+  } else if (msg->current_gear.gear == automotive_platform_msgs::msg::Gear::NEUTRAL) {
+    shift_msg.shift.data = autoware_vehicle_msgs::msg::Shift::NEUTRAL;
+  } else if (msg->current_gear.gear == automotive_platform_msgs::msg::Gear::DRIVE) {
+    shift_msg.shift.data = autoware_vehicle_msgs::msg::Shift::DRIVE;
+  }
+  current_shift_pub_->publish(shift_msg);
+}
+
+void SSCInterface::callbackFromWheelSpeedRpt(
+  const pacmod_msgs::msg::WheelSpeedRpt::ConstSharedPtr msg)
+{
+  wheel_speed_rpt_ptr_ = msg;
+  if (use_rear_wheel_speed_) {
+    publishTwist(msg->header.stamp);
+  }
+}
+
+void SSCInterface::callbackFromSteeringWheelRpt(
+  const pacmod_msgs::msg::SystemRptFloat::ConstSharedPtr msg)
+{
+  steering_wheel_rpt_ptr_ = msg;
+  if (use_adaptive_gear_ratio_) {
+    publishSteering(msg->header.stamp);
+  }
+}
+
+void SSCInterface::onTimer()
+{
+  const double period = 1.0 / loop_rate_;
+  if ((get_clock()->now() - command_published_time_).seconds() < period) {
+    return;
+  }
+
+  // keep sending the command, with the stop on the command timeout
+  publishCommand();
+}
+
+void SSCInterface::publishTwist(const builtin_interfaces::msg::Time & stamp)
+{
+  if (!isVelocityReceived() || !isCurvatureReceived()) {
+    return;
+  }
+
   std_msgs::msg::Header published_msgs_header;
   published_msgs_header.frame_id = BASE_FRAME_ID;
-  published_msgs_header.stamp = msg_velocity->header.stamp;
-
-  wheel_speed_rpt_ptr_ = msg_wheel_speed;
-  vel_acc_cov_ptr_ = msg_velocity;
-  gear_feedback_ptr_ = msg_gear;
+  published_msgs_header.stamp = stamp;
 
   // current speed
-  double speed = calculateVehicleVelocity(
-    *wheel_speed_rpt_ptr_, *vel_acc_cov_ptr_, *gear_feedback_ptr_, use_rear_wheel_speed_);
-
-  // update adaptive gear ratio (avoiding zero division)
-  adaptive_gear_ratio_ = std::max(
-    1e-5, agr_coef_a_ + agr_coef_b_ * speed * speed -
-            agr_coef_c_ * std::fabs(msg_steering_wheel->output));
+  const double speed = calculateVehicleVelocity();
   // current steering curvature
-  double curvature =
-    !use_adaptive_gear_ratio_
-      ? (msg_curvature->curvature)
-      : std::tan(msg_steering_wheel->output / adaptive_gear_ratio_ - steering_offset_) /
-          wheel_base_;
-  const double steering_angle = std::atan(curvature * wheel_base_);
+  const double curvature = calculateCurvature();
   // constexpr double tread = 1.64;  // spec sheet 1.63
   // double omega =
   //   (-msg_wheel_speed->rear_right_wheel_speed + msg_wheel_speed->rear_left_wheel_speed) *
@@ -200,32 +244,26 @@ void SSCInterface::callbackFromSSCFeedbacks(
   twist.twist.angular.z = curvature * speed;  // [rad/s]
   current_twist_pub_->publish(twist);
 
-  // gearshift
-  autoware_vehicle_msgs::msg::ShiftStamped shift_msg;
-  shift_msg.header = published_msgs_header;
-  if (msg_gear->current_gear.gear == automotive_platform_msgs::msg::Gear::NONE) {
-    shift_msg.shift.data = autoware_vehicle_msgs::msg::Shift::NONE;
-  } else if (msg_gear->current_gear.gear == automotive_platform_msgs::msg::Gear::PARK) {
-    shift_msg.shift.data = autoware_vehicle_msgs::msg::Shift::PARKING;
-  } else if (msg_gear->current_gear.gear == automotive_platform_msgs::msg::Gear::REVERSE) {
-    shift_msg.shift.data = autoware_vehicle_msgs::msg::Shift::REVERSE;
-  } else if (msg_gear->current_gear.gear == automotive_platform_msgs::msg::Gear::NEUTRAL) {
-    shift_msg.shift.data = autoware_vehicle_msgs::msg::Shift::NEUTRAL;
-  } else if (msg_gear->current_gear.gear == automotive_platform_msgs::msg::Gear::DRIVE) {
-    shift_msg.shift.data = autoware_vehicle_msgs::msg::Shift::DRIVE;
-  }
-  current_shift_pub_->publish(shift_msg);
-
   // control mode
   autoware_vehicle_msgs::msg::ControlMode mode;
   mode.header = published_msgs_header;
   mode.data = (module_states_.state == "active") ? autoware_vehicle_msgs::msg::ControlMode::AUTO
                                                  : autoware_vehicle_msgs::msg::ControlMode::MANUAL;
   control_mode_pub_->publish(mode);
+}
+
+void SSCInterface::publishSteering(const builtin_interfaces::msg::Time & stamp)
+{
+  if (!isCurvatureReceived()) {
+    return;
+  }
+
+  const double steering_angle = std::atan(calculateCurvature() * wheel_base_);
 
   // steering
   autoware_vehicle_msgs::msg::Steering steer;
-  steer.header = published_msgs_header;
+  steer.header.frame_id = BASE_FRAME_ID;
+  steer.header.stamp = stamp;
   steer.data = steering_angle - steering_offset_;
   current_steer_pub_->publish(steer);
 }
@@ -233,16 +271,20 @@ void SSCInterface::callbackFromSSCFeedbacks(
 void SSCInterface::publishCommand()
 {
   /* guard */
-  if (!command_initialized_ || !wheel_speed_rpt_ptr_ || !vel_acc_cov_ptr_ || !gear_feedback_ptr_) {
+  // the steering wheel angle is needed for the adaptive gear ratio
+  const bool is_steering_received = !use_adaptive_gear_ratio_ || isCurvatureReceived();
+  if (!command_initialized_ || !isVelocityReceived() || !is_steering_received) {
     RCLCPP_INFO_THROTTLE(
       get_logger(), *get_clock(), std::chrono::milliseconds(1000).count(),
-      "vehicle_cmd = %d, wheel_speed_rpt = %d, vel_acc_cov = %d, gear_feedback = %d",
+      "vehicle_cmd = %d, wheel_speed_rpt = %d, vel_acc_cov = %d, gear_feedback = %d, "
+      "steer_rpt = %d",
       command_initialized_, wheel_speed_rpt_ptr_ != nullptr, vel_acc_cov_ptr_ != nullptr,
-      gear_feedback_ptr_ != nullptr);
+      gear_feedback_ptr_ != nullptr, steering_wheel_rpt_ptr_ != nullptr);
     return;
   }
 
   rclcpp::Time stamp = get_clock()->now();
+  command_published_time_ = stamp;
 
   // Desired values
   // Driving mode (If autonomy mode should be active, mode = 1)
@@ -256,7 +298,7 @@ void SSCInterface::publishCommand()
   double desired_steering_angle = !use_adaptive_gear_ratio_
                                     ? vehicle_cmd_.control.steering_angle + steering_offset_
                                     : (vehicle_cmd_.control.steering_angle + steering_offset_) *
-                                        ssc_gear_ratio_ / adaptive_gear_ratio_;
+                                        ssc_gear_ratio_ / calculateAdaptiveGearRatio();
   double desired_curvature = std::tan(desired_steering_angle) / wheel_base_;
 
   // Turn signal
@@ -292,8 +334,7 @@ void SSCInterface::publishCommand()
   }
 
   /* check shift change */
-  double current_velocity = calculateVehicleVelocity(
-    *wheel_speed_rpt_ptr_, *vel_acc_cov_ptr_, *gear_feedback_ptr_, use_rear_wheel_speed_);
+  double current_velocity = calculateVehicleVelocity();
   uint8_t desired_shift = gear_feedback_ptr_->current_gear.gear;
   if (std::abs(current_velocity) < 0.1) {  // velocity is low -> the shift can be changed
     if (toSSCShiftCmd(vehicle_cmd_.shift) != gear_feedback_ptr_->current_gear.gear) {
@@ -344,23 +385,58 @@ void SSCInterface::publishCommand()
   gear_pub_->publish(gear_cmd);
 }
 
-double SSCInterface::calculateVehicleVelocity(
-  const pacmod_msgs::msg::WheelSpeedRpt & wheel_speed_rpt,
-  const automotive_platform_msgs::msg::VelocityAccelCov & vel_acc_cov,
-  const automotive_platform_msgs::msg::GearFeedback & gear_feedback,
-  const bool use_rear_wheel_speed)
+bool SSCInterface::isVelocityReceived() const
+{
+  const bool is_speed_received = use_rear_wheel_speed_ ? wheel_speed_rpt_ptr_ != nullptr
+                                                       : vel_acc_cov_ptr_ != nullptr;
+  return is_speed_received && gear_feedback_ptr_;
+}
+
+bool SSCInterface::isCurvatureReceived() const
+{
+  if (!use_adaptive_gear_ratio_) {
+    return curvature_feedback_ptr_ != nullptr;
+  }
+  // the adaptive gear ratio depends on the speed
+  return steering_wheel_rpt_ptr_ && isVelocityReceived();
+}
+
+double SSCInterface::calculateVehicleVelocity() const
 {
-  const auto rear_wheel_speed =
-    (wheel_speed_rpt.rear_left_wheel_speed + wheel_speed_rpt.rear_right_wheel_speed) *
-    tire_radius_ / 2.0;
-  double speed = !use_rear_wheel_speed ? vel_acc_cov.velocity : rear_wheel_speed;
+  double speed = 0.0;
+  if (use_rear_wheel_speed_) {
+    speed = (wheel_speed_rpt_ptr_->rear_left_wheel_speed +
+             wheel_speed_rpt_ptr_->rear_right_wheel_speed) *
+            tire_radius_ / 2.0;
+  } else {
+    speed = vel_acc_cov_ptr_->velocity;
+  }
   speed = std::abs(speed);
-  if (gear_feedback.current_gear.gear == automotive_platform_msgs::msg::Gear::REVERSE) {
+  if (gear_feedback_ptr_->current_gear.gear == automotive_platform_msgs::msg::Gear::REVERSE) {
     speed *= -1.0;
   }
   return speed;
 }
 
+double SSCInterface::calculateAdaptiveGearRatio() const
+{
+  const double speed = calculateVehicleVelocity();
+  // avoiding zero division
+  return std::max(
+    1e-5, agr_coef_a_ + agr_coef_b_ * speed * speed -
+            agr_coef_c_ * std::fabs(steering_wheel_rpt_ptr_->output));
+}
+
+double SSCInterface::calculateCurvature() const
+{
+  if (!use_adaptive_gear_ratio_) {
+    return curvature_feedback_ptr_->curvature;
+  }
+  const double steering_angle =
+    steering_wheel_rpt_ptr_->output / calculateAdaptiveGearRatio() - steering_offset_;
+  return std::tan(steering_angle) / wheel_base_;
+}
+
 uint8_t SSCInterface::toSSCShiftCmd(const autoware_vehicle_msgs::msg::Shift & shift)
 {
   using automotive_platform_msgs::msg::Gear;
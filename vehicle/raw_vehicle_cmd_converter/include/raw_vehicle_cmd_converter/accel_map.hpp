@@ -17,6 +17,7 @@
 
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
 #include "raw_vehicle_cmd_converter/interpolate.hpp"
+#include "raw_vehicle_cmd_converter/uniform_lookup_table.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -30,8 +31,12 @@ namespace raw_vehicle_cmd_converter
 class AccelMap
 {
 public:
-  bool readAccelMapFromCSV(std::string csv_path);
+  bool readAccelMapFromCSV(
+    std::string csv_path, const double acc_resolution = 0.01, const double vel_resolution = 0.1);
+  //! @brief look up the throttle in the table resampled from the map at load time
   bool getThrottle(double acc, double vel, double & throttle);
+  //! @brief calculate the throttle from the map itself. Used to build and validate the table.
+  bool calcThrottle(double acc, double vel, double & throttle) const;
   bool getAcceleration(double throttle, double vel, double & acc);
   std::vector<double> getVelIdx() { return vel_index_; }
   std::vector<double> getThrottleIdx() { return throttle_index_; }
@@ -44,6 +49,7 @@ private:
   std::vector<double> vel_index_;
   std::vector<double> throttle_index_;
   std::vector<std::vector<double>> accel_map_;
+  UniformLookupTable throttle_table_;
 };
 }  // namespace raw_vehicle_cmd_converter
 
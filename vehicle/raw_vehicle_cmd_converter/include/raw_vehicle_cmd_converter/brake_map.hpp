@@ -17,6 +17,7 @@
 
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
 #include "raw_vehicle_cmd_converter/interpolate.hpp"
+#include "raw_vehicle_cmd_converter/uniform_lookup_table.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -30,8 +31,12 @@ namespace raw_vehicle_cmd_converter
 class BrakeMap
 {
 public:
-  bool readBrakeMapFromCSV(std::string csv_path);
+  bool readBrakeMapFromCSV(
+    std::string csv_path, const double acc_resolution = 0.01, const double vel_resolution = 0.1);
+  //! @brief look up the brake in the table resampled from the map at load time
   bool getBrake(double acc, double vel, double & brake);
+  //! @brief calculate the brake from the map itself. Used to build and validate the table.
+  bool calcBrake(double acc, double vel, double & brake) const;
   bool getAcceleration(double brake, double vel, double & acc);
   std::vector<double> getVelIdx() { return vel_index_; }
   std::vector<double> getBrakeIdx() { return brake_index_; }
@@ -45,6 +50,7 @@ private:
   std::vector<double> brake_index_;
   std::vector<double> brake_index_rev_;
   std::vector<std::vector<double>> brake_map_;
+  UniformLookupTable brake_table_;
 };
 }  // namespace raw_vehicle_cmd_converter
 
@@ -27,6 +27,14 @@ public:
   static bool interpolate(
     const std::vector<double> & base_index, const std::vector<double> & base_value,
     const double & return_index, double & return_value);
+
+  /**
+   * @brief interpolate without the checks of interpolate(). base_index must be increasing and
+   * return_index must be within it.
+   */
+  static double interpolateSorted(
+    const std::vector<double> & base_index, const std::vector<double> & base_value,
+    const double return_index);
 };
 }  // namespace raw_vehicle_cmd_converter
 
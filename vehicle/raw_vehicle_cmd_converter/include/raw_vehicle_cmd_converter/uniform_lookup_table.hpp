@@ -0,0 +1,63 @@
+//  Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef RAW_VEHICLE_CMD_CONVERTER__UNIFORM_LOOKUP_TABLE_HPP_
+#define RAW_VEHICLE_CMD_CONVERTER__UNIFORM_LOOKUP_TABLE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace raw_vehicle_cmd_converter
+{
+/**
+ * @brief (acc, vel) => pedal table sampled on a uniform grid, looked up in O(1)
+ */
+class UniformLookupTable
+{
+public:
+  /**
+   * @brief sample calc_value(acc, vel) on a uniform grid covering the given ranges
+   */
+  void build(
+    const double acc_min, const double acc_max, const double acc_resolution, const double vel_min,
+    const double vel_max, const double vel_resolution,
+    const std::function<double(double, double)> & calc_value);
+
+  /**
+   * @brief bilinear interpolation of the sampled values. acc and vel are clamped to the grid.
+   */
+  double lookup(const double acc, const double vel) const;
+
+  bool empty() const { return values_.empty(); }
+
+private:
+  struct Axis
+  {
+    double min = 0.0;
+    double step = 0.0;
+    size_t size = 0;
+
+    void init(const double min_value, const double max_value, const double resolution);
+    double at(const size_t i) const { return min + step * static_cast<double>(i); }
+    void locate(const double x, size_t & i, double & ratio) const;
+  };
+
+  Axis acc_axis_;
+  Axis vel_axis_;
+  std::vector<double> values_;  // vel major: values_[vel_i * acc_axis_.size + acc_i]
+};
+}  // namespace raw_vehicle_cmd_converter
+
+#endif  // RAW_VEHICLE_CMD_CONVERTER__UNIFORM_LOOKUP_TABLE_HPP_
@@ -23,7 +23,8 @@ using namespace std::literals::chrono_literals;
 
 namespace raw_vehicle_cmd_converter
 {
-bool AccelMap::readAccelMapFromCSV(std::string csv_path)
+bool AccelMap::readAccelMapFromCSV(
+  std::string csv_path, const double acc_resolution, const double vel_resolution)
 {
   CSVLoader csv(csv_path);
   std::vector<std::vector<std::string>> table;
@@ -57,14 +58,30 @@ bool AccelMap::readAccelMapFromCSV(std::string csv_path)
     accel_map_.push_back(accs);
   }
 
+  if (accel_map_.empty()) {
+    RCLCPP_ERROR(logger_, "Cannot read %s. CSV file should have at least 2 rows", csv_path.c_str());
+    return false;
+  }
+
+  // resample the map into a (acc, vel) => throttle table
+  double min_acc = accel_map_.front().front();
+  double max_acc = min_acc;
+  for (const auto & accs : accel_map_) {
+    min_acc = std::min(min_acc, *std::min_element(accs.begin(), accs.end()));
+    max_acc = std::max(max_acc, *std::max_element(accs.begin(), accs.end()));
+  }
+  throttle_table_.build(
+    min_acc, max_acc, acc_resolution, vel_index_.front(), vel_index_.back(), vel_resolution,
+    [this](const double acc, const double vel) {
+      double throttle;
+      return calcThrottle(acc, vel, throttle) ? throttle : throttle_index_.front();
+    });
+
   return true;
 }
 
 bool AccelMap::getThrottle(double acc, double vel, double & throttle)
 {
-  LinearInterpolate linear_interp;
-  std::vector<double> accs_interpolated;
-
   if (vel < vel_index_.front()) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(
       logger_, clock_, 1000,
@@ -81,16 +98,36 @@ bool AccelMap::getThrottle(double acc, double vel, double & throttle)
     vel = vel_index_.back();
   }
 
+  // calculate throttle
+  // When the desired acceleration is smaller than the throttle area, return false => brake sequence
+  // When the desired acceleration is greater than the throttle area, return max throttle
+  // The boundaries of the throttle area are interpolated from the map so that the decision is exact
+  if (acc < LinearInterpolate::interpolateSorted(vel_index_, accel_map_.front(), vel)) {
+    return false;
+  } else if (LinearInterpolate::interpolateSorted(vel_index_, accel_map_.back(), vel) < acc) {
+    throttle = throttle_index_.back();
+    return true;
+  }
+  throttle = throttle_table_.lookup(acc, vel);
+
+  return true;
+}
+
+bool AccelMap::calcThrottle(double acc, double vel, double & throttle) const
+{
+  LinearInterpolate linear_interp;
+  std::vector<double> accs_interpolated;
+
+  vel = std::min(std::max(vel, vel_index_.front()), vel_index_.back());
+
   // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accs : accel_map_) {
+  for (const std::vector<double> & accs : accel_map_) {
     double acc_interpolated;
     linear_interp.interpolate(vel_index_, accs, vel, acc_interpolated);
     accs_interpolated.push_back(acc_interpolated);
   }
 
   // calculate throttle
-  // When the desired acceleration is smaller than the throttle area, return false => brake sequence
-  // When the desired acceleration is greater than the throttle area, return max throttle
   if (acc < accs_interpolated.front()) {
     return false;
   } else if (accs_interpolated.back() < acc) {
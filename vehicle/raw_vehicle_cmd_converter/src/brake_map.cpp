@@ -20,7 +20,8 @@
 
 namespace raw_vehicle_cmd_converter
 {
-bool BrakeMap::readBrakeMapFromCSV(std::string csv_path)
+bool BrakeMap::readBrakeMapFromCSV(
+  std::string csv_path, const double acc_resolution, const double vel_resolution)
 {
   CSVLoader csv(csv_path);
   std::vector<std::vector<std::string>> table;
@@ -55,17 +56,34 @@ bool BrakeMap::readBrakeMapFromCSV(std::string csv_path)
     brake_map_.push_back(accs);
   }
 
+  if (brake_map_.empty()) {
+    RCLCPP_ERROR(logger_, "Cannot read %s. CSV file should have at least 2 rows", csv_path.c_str());
+    return false;
+  }
+
   brake_index_rev_ = brake_index_;
   std::reverse(std::begin(brake_index_rev_), std::end(brake_index_rev_));
 
+  // resample the map into a (acc, vel) => brake table
+  double min_acc = brake_map_.front().front();
+  double max_acc = min_acc;
+  for (const auto & accs : brake_map_) {
+    min_acc = std::min(min_acc, *std::min_element(accs.begin(), accs.end()));
+    max_acc = std::max(max_acc, *std::max_element(accs.begin(), accs.end()));
+  }
+  brake_table_.build(
+    min_acc, max_acc, acc_resolution, vel_index_.front(), vel_index_.back(), vel_resolution,
+    [this](const double acc, const double vel) {
+      double brake;
+      calcBrake(acc, vel, brake);
+      return brake;
+    });
+
   return true;
 }
 
 bool BrakeMap::getBrake(double acc, double vel, double & brake)
 {
-  LinearInterpolate linear_interp;
-  std::vector<double> accs_interpolated;
-
   if (vel < vel_index_.front()) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(
       logger_, clock_, 1000,
@@ -82,22 +100,44 @@ bool BrakeMap::getBrake(double acc, double vel, double & brake)
     vel = vel_index_.back();
   }
 
+  // calculate brake
+  // When the desired acceleration is smaller than the brake area, return max brake on the map
+  // When the desired acceleration is greater than the brake area, return min brake on the map
+  // The boundaries of the brake area are interpolated from the map so that the decision is exact
+  const double min_acc = LinearInterpolate::interpolateSorted(vel_index_, brake_map_.back(), vel);
+  if (acc < min_acc) {
+    RCLCPP_WARN_SKIPFIRST_THROTTLE(
+      logger_, clock_, 1000,
+      "Exceeding the acc range. Desired acc: %f < min acc on map: %f. return max "
+      "value.",
+      acc, min_acc);
+    brake = brake_index_.back();
+    return true;
+  } else if (LinearInterpolate::interpolateSorted(vel_index_, brake_map_.front(), vel) < acc) {
+    brake = brake_index_.front();
+    return true;
+  }
+  brake = brake_table_.lookup(acc, vel);
+
+  return true;
+}
+
+bool BrakeMap::calcBrake(double acc, double vel, double & brake) const
+{
+  LinearInterpolate linear_interp;
+  std::vector<double> accs_interpolated;
+
+  vel = std::min(std::max(vel, vel_index_.front()), vel_index_.back());
+
   // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accs : brake_map_) {
+  for (const std::vector<double> & accs : brake_map_) {
     double acc_interpolated;
     linear_interp.interpolate(vel_index_, accs, vel, acc_interpolated);
     accs_interpolated.push_back(acc_interpolated);
   }
 
   // calculate brake
-  // When the desired acceleration is smaller than the brake area, return max brake on the map
-  // When the desired acceleration is greater than the brake area, return min brake on the map
   if (acc < accs_interpolated.back()) {
-    RCLCPP_WARN_SKIPFIRST_THROTTLE(
-      logger_, clock_, 1000,
-      "Exceeding the acc range. Desired acc: %f < min acc on map: %f. return max "
-      "value.",
-      acc, accs_interpolated.back());
     brake = brake_index_.back();
     return true;
   } else if (accs_interpolated.front() < acc) {
@@ -14,6 +14,8 @@
 
 #include "raw_vehicle_cmd_converter/interpolate.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 /*
@@ -99,4 +101,21 @@ bool LinearInterpolate::interpolate(
 
   return true;
 }
+
+double LinearInterpolate::interpolateSorted(
+  const std::vector<double> & base_index, const std::vector<double> & base_value,
+  const double return_index)
+{
+  if (base_index.size() < 2) {
+    return base_value.front();
+  }
+  const auto itr = std::upper_bound(base_index.begin() + 1, base_index.end() - 1, return_index);
+  const size_t i = static_cast<size_t>(std::distance(base_index.begin(), itr));
+  const double dist_base_return_index = base_index[i] - base_index[i - 1];
+  if (dist_base_return_index <= 0.0) {
+    return base_value[i];
+  }
+  const double ratio = (return_index - base_index[i - 1]) / dist_base_return_index;
+  return (1.0 - ratio) * base_value[i - 1] + ratio * base_value[i];
+}
 }  // namespace raw_vehicle_cmd_converter
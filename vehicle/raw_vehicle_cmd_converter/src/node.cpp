@@ -29,6 +29,8 @@ RawVehicleCommandConverterNode::RawVehicleCommandConverterNode(
   const auto csv_path_accel_map = declare_parameter("csv_path_accel_map", std::string("empty"));
   const auto csv_path_brake_map = declare_parameter("csv_path_brake_map", std::string("empty"));
   const auto csv_path_steer_map = declare_parameter("csv_path_steer_map", std::string("empty"));
+  const auto map_acc_resolution = declare_parameter("map_acc_resolution", 0.01);
+  const auto map_vel_resolution = declare_parameter("map_vel_resolution", 0.1);
   convert_accel_cmd_ = declare_parameter("convert_accel_cmd", true);
   convert_brake_cmd_ = declare_parameter("convert_brake_cmd", true);
   convert_steer_cmd_ = declare_parameter("convert_steer_cmd", true);
@@ -55,7 +57,8 @@ RawVehicleCommandConverterNode::RawVehicleCommandConverterNode(
     declare_parameter("steer_pid.invalid_integration_decay", 0.97)};
   ff_map_initialized_ = true;
   if (convert_accel_cmd_) {
-    if (!accel_map_.readAccelMapFromCSV(csv_path_accel_map)) {
+    if (!accel_map_.readAccelMapFromCSV(
+          csv_path_accel_map, map_acc_resolution, map_vel_resolution)) {
       RCLCPP_ERROR(
         get_logger(), "Cannot read accelmap. csv path = %s. stop calculation.",
         csv_path_accel_map.c_str());
@@ -63,7 +66,8 @@ RawVehicleCommandConverterNode::RawVehicleCommandConverterNode(
     }
   }
   if (convert_brake_cmd_) {
-    if (!brake_map_.readBrakeMapFromCSV(csv_path_brake_map)) {
+    if (!brake_map_.readBrakeMapFromCSV(
+          csv_path_brake_map, map_acc_resolution, map_vel_resolution)) {
       RCLCPP_ERROR(
         get_logger(), "Cannot read brakemap. csv path = %s. stop calculation.",
         csv_path_brake_map.c_str());
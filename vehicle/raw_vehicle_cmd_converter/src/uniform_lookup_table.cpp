@@ -0,0 +1,85 @@
+//  Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "raw_vehicle_cmd_converter/uniform_lookup_table.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace raw_vehicle_cmd_converter
+{
+void UniformLookupTable::Axis::init(
+  const double min_value, const double max_value, const double resolution)
+{
+  min = min_value;
+  const double range = max_value - min_value;
+  if (range <= 0.0 || resolution <= 0.0) {
+    step = 0.0;
+    size = 1;
+    return;
+  }
+  // the last sample is put on max_value
+  size = static_cast<size_t>(std::ceil(range / resolution)) + 1;
+  step = range / static_cast<double>(size - 1);
+}
+
+void UniformLookupTable::Axis::locate(const double x, size_t & i, double & ratio) const
+{
+  if (size < 2) {
+    i = 0;
+    ratio = 0.0;
+    return;
+  }
+  const double t = std::min(std::max((x - min) / step, 0.0), static_cast<double>(size - 1));
+  i = std::min(static_cast<size_t>(t), size - 2);
+  ratio = t - static_cast<double>(i);
+}
+
+void UniformLookupTable::build(
+  const double acc_min, const double acc_max, const double acc_resolution, const double vel_min,
+  const double vel_max, const double vel_resolution,
+  const std::function<double(double, double)> & calc_value)
+{
+  acc_axis_.init(acc_min, acc_max, acc_resolution);
+  vel_axis_.init(vel_min, vel_max, vel_resolution);
+
+  values_.clear();
+  values_.reserve(acc_axis_.size * vel_axis_.size);
+  for (size_t vel_i = 0; vel_i < vel_axis_.size; ++vel_i) {
+    for (size_t acc_i = 0; acc_i < acc_axis_.size; ++acc_i) {
+      values_.push_back(calc_value(acc_axis_.at(acc_i), vel_axis_.at(vel_i)));
+    }
+  }
+}
+
+double UniformLookupTable::lookup(const double acc, const double vel) const
+{
+  size_t acc_i, vel_i;
+  double acc_ratio, vel_ratio;
+  acc_axis_.locate(acc, acc_i, acc_ratio);
+  vel_axis_.locate(vel, vel_i, vel_ratio);
+
+  const size_t acc_next = std::min(acc_i + 1, acc_axis_.size - 1);
+  const size_t vel_next = std::min(vel_i + 1, vel_axis_.size - 1);
+  const auto value = [this](const size_t a, const size_t v) {
+    return values_[v * acc_axis_.size + a];
+  };
+
+  const double low = (1.0 - acc_ratio) * value(acc_i, vel_i) + acc_ratio * value(acc_next, vel_i);
+  const double high =
+    (1.0 - acc_ratio) * value(acc_i, vel_next) + acc_ratio * value(acc_next, vel_next);
+  return (1.0 - vel_ratio) * low + vel_ratio * high;
+}
+}  // namespace raw_vehicle_cmd_converter
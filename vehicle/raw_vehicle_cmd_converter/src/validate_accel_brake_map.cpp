@@ -0,0 +1,143 @@
+//  Copyright 2021 Tier IV, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+/*
+ * Report the error of the lookup tables resampled from the accel/brake maps, compared with the
+ * interpolation of the maps themselves.
+ *
+ * usage: validate_accel_brake_map <accel_map.csv> <brake_map.csv> [acc_resolution] [vel_resolution]
+ */
+
+#include "raw_vehicle_cmd_converter/accel_map.hpp"
+#include "raw_vehicle_cmd_converter/brake_map.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct ErrorStat
+{
+  size_t num_samples = 0;
+  size_t num_mismatches = 0;
+  double sum_error = 0.0;
+  double max_error = 0.0;
+  double max_error_acc = 0.0;
+  double max_error_vel = 0.0;
+};
+
+// sample (acc, vel) more densely than the tables
+ErrorStat evaluate(
+  const std::vector<double> & vel_index, const std::vector<std::vector<double>> & map,
+  const double acc_resolution, const double vel_resolution,
+  const std::function<bool(double, double, double &)> & lookup,
+  const std::function<bool(double, double, double &)> & calc)
+{
+  constexpr int samples_per_cell = 10;
+  double min_acc = map.front().front();
+  double max_acc = min_acc;
+  for (const auto & accs : map) {
+    min_acc = std::min(min_acc, *std::min_element(accs.begin(), accs.end()));
+    max_acc = std::max(max_acc, *std::max_element(accs.begin(), accs.end()));
+  }
+  const double acc_step = acc_resolution / samples_per_cell;
+  const double vel_step = vel_resolution / samples_per_cell;
+
+  ErrorStat stat;
+  for (double vel = vel_index.front(); vel <= vel_index.back(); vel += vel_step) {
+    for (double acc = min_acc; acc <= max_acc; acc += acc_step) {
+      double looked_up = 0.0;
+      double calculated = 0.0;
+      const bool is_looked_up = lookup(acc, vel, looked_up);
+      const bool is_calculated = calc(acc, vel, calculated);
+      ++stat.num_samples;
+      if (is_looked_up != is_calculated) {
+        ++stat.num_mismatches;
+        continue;
+      }
+      if (!is_calculated) {
+        continue;
+      }
+      const double error = std::abs(looked_up - calculated);
+      stat.sum_error += error;
+      if (stat.max_error < error) {
+        stat.max_error = error;
+        stat.max_error_acc = acc;
+        stat.max_error_vel = vel;
+      }
+    }
+  }
+  return stat;
+}
+
+void printStat(const std::string & name, const ErrorStat & stat)
+{
+  const double mean_error =
+    stat.num_samples > 0 ? stat.sum_error / static_cast<double>(stat.num_samples) : 0.0;
+  printf(
+    "[%s] samples: %lu, mean error: %f, max error: %f at acc: %f vel: %f, mismatches: %lu\n",
+    name.c_str(), stat.num_samples, mean_error, stat.max_error, stat.max_error_acc,
+    stat.max_error_vel, stat.num_mismatches);
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  using raw_vehicle_cmd_converter::AccelMap;
+  using raw_vehicle_cmd_converter::BrakeMap;
+
+  if (argc < 3) {
+    printf(
+      "usage: %s <accel_map.csv> <brake_map.csv> [acc_resolution] [vel_resolution]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  const double acc_resolution = argc > 3 ? std::stod(argv[3]) : 0.01;
+  const double vel_resolution = argc > 4 ? std::stod(argv[4]) : 0.1;
+
+  AccelMap accel_map;
+  if (!accel_map.readAccelMapFromCSV(argv[1], acc_resolution, vel_resolution)) {
+    return EXIT_FAILURE;
+  }
+  BrakeMap brake_map;
+  if (!brake_map.readBrakeMapFromCSV(argv[2], acc_resolution, vel_resolution)) {
+    return EXIT_FAILURE;
+  }
+
+  printf("acc resolution: %f [m/s^2], vel resolution: %f [m/s]\n", acc_resolution, vel_resolution);
+  printStat(
+    "accel", evaluate(
+               accel_map.getVelIdx(), accel_map.getAccelMap(), acc_resolution, vel_resolution,
+               [&accel_map](double acc, double vel, double & throttle) {
+                 return accel_map.getThrottle(acc, vel, throttle);
+               },
+               [&accel_map](double acc, double vel, double & throttle) {
+                 return accel_map.calcThrottle(acc, vel, throttle);
+               }));
+  printStat(
+    "brake", evaluate(
+               brake_map.getVelIdx(), brake_map.getBrakeMap(), acc_resolution, vel_resolution,
+               [&brake_map](double acc, double vel, double & brake) {
+                 return brake_map.getBrake(acc, vel, brake);
+               },
+               [&brake_map](double acc, double vel, double & brake) {
+                 return brake_map.calcBrake(acc, vel, brake);
+               }));
+
+  return EXIT_SUCCESS;
+}